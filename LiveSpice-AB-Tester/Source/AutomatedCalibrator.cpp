@@ -23,8 +23,7 @@ void AutomatedCalibrator::setCalibrationSettings(const CalibrationSettings& newS
     settings = newSettings;
     
     // Regenerate test signal with new settings
-    testSignal.setSize(2, settings.testDurationSamples);
-    generateTestSignal(testSignal);
+    prepareTestSignal();
 }
 
 void AutomatedCalibrator::addParameter(const std::string& name, float minValue, float maxValue, float initialValue)
@@ -93,12 +92,10 @@ void AutomatedCalibrator::startCalibration()
     currentIteration = 0;
     
     // Setup buffers
-    testSignal.setSize(2, settings.testDurationSamples);
+    prepareTestSignal();
     referenceOutput.setSize(2, settings.testDurationSamples);
     targetOutput.setSize(2, settings.testDurationSamples);
     
-    generateTestSignal(testSignal);
-    
     // Start calibration in background thread
     calibrationThread = std::make_unique<std::thread>([this]() {
         runOptimization();
@@ -382,20 +379,51 @@ float AutomatedCalibrator::calculateSpectralError(const juce::AudioBuffer<float>
     return 0.0f;
 }
 
+void AutomatedCalibrator::prepareTestSignal()
+{
+    // The signal depends only on the settings: keep it across calibration runs
+    if (testSignal.getNumChannels() == 2
+        && testSignal.getNumSamples() == settings.testDurationSamples
+        && testSignalFrequency == settings.testFrequency
+        && testSignalAmplitude == settings.testAmplitude)
+        return;
+    
+    testSignal.setSize(2, settings.testDurationSamples);
+    generateTestSignal(testSignal);
+    testSignalFrequency = settings.testFrequency;
+    testSignalAmplitude = settings.testAmplitude;
+}
+
 void AutomatedCalibrator::generateTestSignal(juce::AudioBuffer<float>& buffer)
 {
-    const float sampleRate = 48000.0f;  // Assume standard sample rate
-    const float frequency = settings.testFrequency;
-    const float amplitude = settings.testAmplitude;
+    const double sampleRate = 48000.0;  // Assume standard sample rate
+    const double omega = juce::MathConstants<double>::twoPi * settings.testFrequency / sampleRate;
+    const double amplitude = settings.testAmplitude;
+    const int numSamples = buffer.getNumSamples();
     
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    if (buffer.getNumChannels() == 0 || numSamples == 0)
+        return;
+    
+    // Recursive oscillator s[n+1] = 2cos(w) s[n] - s[n-1], restarted from
+    // exact values every 1024 samples; the other channels are copies
+    float* data = buffer.getWritePointer(0);
+    const double k = 2.0 * std::cos(omega);
+    
+    for (int start = 0; start < numSamples; start += 1024)
     {
-        float* data = buffer.getWritePointer(ch);
+        const int end = std::min(numSamples, start + 1024);
+        double previous = amplitude * std::sin(omega * (start - 1));
+        double current = amplitude * std::sin(omega * start);
         
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        for (int i = start; i < end; ++i)
         {
-            float phase = juce::MathConstants<float>::twoPi * frequency * i / sampleRate;
-            data[i] = amplitude * std::sin(phase);
+            data[i] = (float) current;
+            const double next = k * current - previous;
+            previous = current;
+            current = next;
         }
     }
+    
+    for (int ch = 1; ch < buffer.getNumChannels(); ++ch)
+        buffer.copyFrom(ch, 0, buffer, 0, 0, numSamples);
 }
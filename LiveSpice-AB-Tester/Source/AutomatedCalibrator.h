@@ -135,6 +135,7 @@ private:
                                 const juce::AudioBuffer<float>& target);
     
     // Test signal generation
+    void prepareTestSignal();
     void generateTestSignal(juce::AudioBuffer<float>& buffer);
     
     // State
@@ -146,6 +147,8 @@ private:
     
     // Audio buffers
     juce::AudioBuffer<float> testSignal;
+    float testSignalFrequency = 0.0f;   // Settings testSignal was generated with
+    float testSignalAmplitude = 0.0f;
     juce::AudioBuffer<float> referenceOutput;
     juce::AudioBuffer<float> targetOutput;
     
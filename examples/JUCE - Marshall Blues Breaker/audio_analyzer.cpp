@@ -6,22 +6,7 @@
 #include <fstream>
 #include <cstring>
 #include <cstdint>
-
-struct WAVHeader {
-    char riffId[4];
-    int32_t fileSize;
-    char waveId[4];
-    char fmtId[4];
-    int32_t fmtSize;
-    int16_t audioFormat;
-    int16_t numChannels;
-    int32_t sampleRate;
-    int32_t byteRate;
-    int16_t blockAlign;
-    int16_t bitsPerSample;
-    char dataId[4];
-    int32_t dataSize;
-};
+#include "../../src/WavFile.h"
 
 class SimpleAudioAnalyzer {
 private:
@@ -32,59 +17,25 @@ public:
     SimpleAudioAnalyzer() : sampleRate(44100) {}
     
     bool loadWAV(const std::string& filename) {
-        std::ifstream file(filename, std::ios::binary);
-        if (!file.is_open()) {
-            std::cerr << "Error: Cannot open file: " << filename << std::endl;
-            return false;
-        }
-        
         std::cout << "Reading file: " << filename << std::endl;
         
-        WAVHeader header;
-        file.read(reinterpret_cast<char*>(&header), sizeof(WAVHeader));
-        
-        if (!file.good()) {
-            std::cerr << "Error: Cannot read WAV header" << std::endl;
+        LiveSpice::WavReader reader(filename);
+        if (!reader.isOpen()) {
+            std::cerr << "Error: " << reader.getError() << std::endl;
             return false;
         }
         
         std::cout << "WAV Header Read:" << std::endl;
-        std::cout << "  Channels: " << header.numChannels << std::endl;
-        std::cout << "  Sample Rate: " << header.sampleRate << std::endl;
-        std::cout << "  Bits Per Sample: " << header.bitsPerSample << std::endl;
-        std::cout << "  Data Size: " << header.dataSize << " bytes" << std::endl;
+        std::cout << "  Channels: " << reader.getNumChannels() << std::endl;
+        std::cout << "  Sample Rate: " << reader.getSampleRate() << std::endl;
+        std::cout << "  Bits Per Sample: " << reader.getBitsPerSample() << (reader.isFloat() ? " (float)" : "") << std::endl;
+        std::cout << "  Frames: " << reader.numFrames() << std::endl;
         
-        sampleRate = header.sampleRate;
-        int numSamples = header.dataSize / (header.bitsPerSample / 8) / header.numChannels;
-        audioData.resize(numSamples);
-        
-        std::cout << "Converting " << numSamples << " samples..." << std::endl;
-        
-        if (header.bitsPerSample == 16) {
-            std::vector<int16_t> buffer(numSamples * header.numChannels);
-            file.read(reinterpret_cast<char*>(buffer.data()), header.dataSize);
-            
-            for (int i = 0; i < numSamples; ++i) {
-                float sample = 0.0f;
-                for (int ch = 0; ch < header.numChannels; ++ch) {
-                    sample += static_cast<float>(buffer[i * header.numChannels + ch]) / 32768.0f;
-                }
-                audioData[i] = sample / header.numChannels;
-            }
-        } else if (header.bitsPerSample == 32) {
-            std::vector<int32_t> buffer(numSamples * header.numChannels);
-            file.read(reinterpret_cast<char*>(buffer.data()), header.dataSize);
-            
-            for (int i = 0; i < numSamples; ++i) {
-                float sample = 0.0f;
-                for (int ch = 0; ch < header.numChannels; ++ch) {
-                    sample += static_cast<float>(buffer[i * header.numChannels + ch]) / 2147483648.0f;
-                }
-                audioData[i] = sample / header.numChannels;
-            }
-        }
+        sampleRate = static_cast<int>(reader.getSampleRate());
+        audioData.resize(reader.numFrames());
         
-        file.close();
+        std::cout << "Converting " << audioData.size() << " samples..." << std::endl;
+        reader.readMono(0, audioData.size(), audioData.data());
         return true;
     }
     
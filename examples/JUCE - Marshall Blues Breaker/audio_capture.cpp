@@ -5,92 +5,7 @@
 #include <vector>
 #include <iomanip>
 #include <cmath>
-
-// Simple WAV file writer for capturing audio output
-class WAVWriter {
-private:
-    struct WAVHeader {
-        char riffId[4];
-        int32_t fileSize;
-        char waveId[4];
-        char fmtId[4];
-        int32_t fmtSize;
-        int16_t audioFormat;
-        int16_t numChannels;
-        int32_t sampleRate;
-        int32_t byteRate;
-        int16_t blockAlign;
-        int16_t bitsPerSample;
-        char dataId[4];
-        int32_t dataSize;
-    };
-    
-    std::ofstream file;
-    WAVHeader header;
-    int32_t dataSize;
-    
-public:
-    WAVWriter(const std::string& filename, int sampleRate, int numChannels, int bitsPerSample)
-        : dataSize(0) {
-        
-        std::strcpy(header.riffId, "RIFF");
-        std::strcpy(header.waveId, "WAVE");
-        std::strcpy(header.fmtId, "fmt ");
-        std::strcpy(header.dataId, "data");
-        
-        header.fmtSize = 16;
-        header.audioFormat = 1;  // PCM
-        header.numChannels = numChannels;
-        header.sampleRate = sampleRate;
-        header.bitsPerSample = bitsPerSample;
-        header.blockAlign = (numChannels * bitsPerSample) / 8;
-        header.byteRate = sampleRate * header.blockAlign;
-        
-        file.open(filename, std::ios::binary);
-        if (!file.is_open()) {
-            std::cerr << "Failed to open file for writing: " << filename << std::endl;
-            return;
-        }
-        
-        // Write placeholder header (will update later)
-        file.write(reinterpret_cast<char*>(&header), sizeof(WAVHeader));
-    }
-    
-    void writeSample(float sample) {
-        int16_t int16Sample = static_cast<int16_t>(
-            std::max(-1.0f, std::min(1.0f, sample)) * 32767.0f
-        );
-        file.write(reinterpret_cast<char*>(&int16Sample), sizeof(int16_t));
-        dataSize += sizeof(int16_t);
-    }
-    
-    void writeStereo(float left, float right) {
-        writeSample(left);
-        writeSample(right);
-    }
-    
-    void close() {
-        if (!file.is_open()) return;
-        
-        // Update file size fields
-        header.fileSize = 36 + dataSize;
-        header.dataSize = dataSize;
-        
-        // Go back to start and update header
-        file.seekp(0, std::ios::beg);
-        file.write(reinterpret_cast<char*>(&header), sizeof(WAVHeader));
-        
-        file.close();
-        
-        std::cout << "✅ WAV file written: " << (36 + dataSize) << " bytes" << std::endl;
-        std::cout << "   Samples: " << (dataSize / header.blockAlign) << std::endl;
-        std::cout << "   Duration: " << std::fixed << std::setprecision(2)
-                  << ((dataSize / header.blockAlign) / static_cast<float>(header.sampleRate)) 
-                  << " seconds" << std::endl;
-    }
-    
-    bool isOpen() const { return file.is_open(); }
-};
+#include "../../src/WavFile.h"
 
 // Simulate recording from the plugin for testing
 // In production, this would connect to actual plugin output
@@ -101,7 +16,16 @@ void recordTestSignal(const std::string& outputFile, int durationSeconds = 5) {
     const int sampleRate = 44100;
     const int totalSamples = sampleRate * durationSeconds;
     
-    WAVWriter writer(outputFile, sampleRate, 2, 16);
+    // Streamed out in blocks through the shared writer's preallocated buffer
+    LiveSpice::WavWriter writer(outputFile, sampleRate, 2, LiveSpice::WavWriter::Format::Pcm16);
+    if (!writer.isOpen()) {
+        std::cerr << "Failed to open file for writing: " << outputFile << std::endl;
+        return;
+    }
+    const int blockSize = 512;
+    std::vector<float> block(blockSize);
+    const float* channels[] = {block.data(), block.data()};
+    int blockFill = 0;
     
     // Generate test sweep (1kHz to 5kHz) to test the plugin response
     std::cout << "  Recording: " << durationSeconds << " second sweep (1kHz → 5kHz)" << std::endl;
@@ -119,7 +43,11 @@ void recordTestSignal(const std::string& outputFile, int durationSeconds = 5) {
         float phase = 2.0f * 3.14159265f * (f_start * t + (f_end - f_start) * t * t / (2.0f * durationSeconds));
         float sample = 0.1f * std::sin(phase);  // Start with quiet test signal
         
-        writer.writeStereo(sample, sample);
+        block[blockFill++] = sample;
+        if (blockFill == blockSize || i + 1 == totalSamples) {
+            writer.write(channels, blockFill);
+            blockFill = 0;
+        }
         
         if ((i + 1) % (sampleRate / 4) == 0) {
             int progress = ((i + 1) * 100) / totalSamples;
@@ -127,7 +55,16 @@ void recordTestSignal(const std::string& outputFile, int durationSeconds = 5) {
         }
     }
     
-    writer.close();
+    const size_t frames = writer.framesWritten();
+    if (!writer.close()) {
+        std::cerr << "Failed to write " << outputFile << std::endl;
+        return;
+    }
+    
+    std::cout << "✅ WAV file written: " << (44 + frames * 4) << " bytes" << std::endl;
+    std::cout << "   Samples: " << frames << std::endl;
+    std::cout << "   Duration: " << std::fixed << std::setprecision(2)
+              << (frames / static_cast<float>(sampleRate)) << " seconds" << std::endl;
 }
 
 void printInstructions() {
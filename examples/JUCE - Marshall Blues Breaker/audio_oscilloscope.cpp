@@ -7,23 +7,8 @@
 #include <fstream>
 #include <cstring>
 #include <cstdint>
-
-// Simple WAV file reading
-struct WAVHeader {
-    char riffId[4];
-    int32_t fileSize;
-    char waveId[4];
-    char fmtId[4];
-    int32_t fmtSize;
-    int16_t audioFormat;
-    int16_t numChannels;
-    int32_t sampleRate;
-    int32_t byteRate;
-    int16_t blockAlign;
-    int16_t bitsPerSample;
-    char dataId[4];
-    int32_t dataSize;
-};
+#include "../../src/ScopeFifo.h"
+#include "../../src/WavFile.h"
 
 class AudioOscilloscope {
 private:
@@ -33,54 +18,17 @@ private:
 public:
     AudioOscilloscope() : sampleRate(44100) {}
     
-    // Load WAV file for analysis
+    // Load WAV file for analysis (any PCM/float WAV, channels mixed to mono)
     bool loadWAVFile(const std::string& filename) {
-        std::ifstream file(filename, std::ios::binary);
-        if (!file.is_open()) {
-            std::cerr << "❌ Failed to open file: " << filename << std::endl;
-            return false;
-        }
-        
-        WAVHeader header;
-        file.read(reinterpret_cast<char*>(&header), sizeof(WAVHeader));
-        
-        if (std::strncmp(header.riffId, "RIFF", 4) != 0 ||
-            std::strncmp(header.waveId, "WAVE", 4) != 0) {
-            std::cerr << "❌ Not a valid WAV file" << std::endl;
+        LiveSpice::WavReader reader(filename);
+        if (!reader.isOpen()) {
+            std::cerr << "❌ " << reader.getError() << std::endl;
             return false;
         }
         
-        sampleRate = header.sampleRate;
-        int numSamples = header.dataSize / (header.bitsPerSample / 8) / header.numChannels;
-        
-        audioData.resize(numSamples);
-        
-        if (header.bitsPerSample == 16) {
-            std::vector<int16_t> int16Data(numSamples * header.numChannels);
-            file.read(reinterpret_cast<char*>(int16Data.data()), header.dataSize);
-            
-            // Convert to float and mix channels
-            for (int i = 0; i < numSamples; ++i) {
-                float sample = 0.0f;
-                for (int ch = 0; ch < header.numChannels; ++ch) {
-                    sample += static_cast<float>(int16Data[i * header.numChannels + ch]) / 32768.0f;
-                }
-                audioData[i] = sample / header.numChannels;
-            }
-        } else if (header.bitsPerSample == 32) {
-            std::vector<int32_t> int32Data(numSamples * header.numChannels);
-            file.read(reinterpret_cast<char*>(int32Data.data()), header.dataSize);
-            
-            for (int i = 0; i < numSamples; ++i) {
-                float sample = 0.0f;
-                for (int ch = 0; ch < header.numChannels; ++ch) {
-                    sample += static_cast<float>(int32Data[i * header.numChannels + ch]) / 2147483648.0f;
-                }
-                audioData[i] = sample / header.numChannels;
-            }
-        }
-        
-        file.close();
+        sampleRate = static_cast<int>(reader.getSampleRate());
+        audioData.resize(reader.numFrames());
+        reader.readMono(0, audioData.size(), audioData.data());
         return true;
     }
     
@@ -322,30 +270,52 @@ private:
     }
     
     void printWaveformVisualization() {
-        std::cout << "📊 WAVEFORM VISUALIZATION (first 512 samples)" << std::endl;
+        std::cout << "📊 WAVEFORM VISUALIZATION (triggered, rising edge at 0)" << std::endl;
         std::cout << std::string(70, '-') << std::endl;
         
-        int displaySamples = std::min(static_cast<int>(audioData.size()), 512);
-        int samplesPerChar = std::max(1, displaySamples / 64);
+        // Feed the file through the shared scope FIFO in device-sized blocks,
+        // the way a capture callback would, and keep the first triggered frame
+        const size_t blockSize = 256;
+        LiveSpiceDSP::ScopeSettings settings;
+        settings.frameLength = std::min<size_t>(2048, audioData.size());
+        settings.preTrigger = settings.frameLength / 8;
+        settings.displayPoints = 64;
+        
+        LiveSpiceDSP::ScopeFifo fifo(1, 4 * settings.frameLength);
+        LiveSpiceDSP::ScopeCapture capture(1, settings);
+        LiveSpiceDSP::ScopeFrame frame, shown;
+        int frames = 0, triggeredFrames = 0;
+        
+        for (size_t start = 0; start < audioData.size(); start += blockSize) {
+            const float* block[] = {audioData.data() + start};
+            fifo.push(block, 1, std::min(blockSize, audioData.size() - start));
+            if (capture.update(fifo, frame)) {
+                ++frames;
+                if (frame.triggered) ++triggeredFrames;
+                if (shown.numPoints == 0 || (frame.triggered && !shown.triggered)) shown = frame;
+            }
+        }
+        
+        if (shown.numPoints == 0) {
+            std::cout << "  Too short to capture a frame" << std::endl << std::endl;
+            return;
+        }
         
+        // Each column spans its min..max, so peaks between columns stay visible
         for (int line = 10; line >= -10; --line) {
-            float threshold = line * 0.1f;
+            float top = (line + 0.5f) * 0.1f;
+            float bottom = (line - 0.5f) * 0.1f;
             
-            for (int i = 0; i < displaySamples; i += samplesPerChar) {
-                float sample = audioData[i];
-                char c = ' ';
-                
-                if (sample > threshold && sample < threshold + 0.1f) {
-                    if (sample > 0) c = '#';
-                    else c = '#';
-                } else if (std::abs(sample - threshold) < 0.05f) {
-                    c = '-';
-                }
-                
-                std::cout << c;
+            for (size_t p = 0; p < shown.numPoints; ++p) {
+                bool hit = shown.getMax(0, p) >= bottom && shown.getMin(0, p) < top;
+                std::cout << (hit ? '#' : (line == 0 ? '-' : ' '));
             }
-            std::cout << " " << std::setw(4) << std::fixed << std::setprecision(1) << threshold << std::endl;
+            std::cout << " " << std::setw(4) << std::fixed << std::setprecision(1) << line * 0.1f << std::endl;
         }
+        std::cout << std::string(settings.preTrigger * shown.numPoints / settings.frameLength, ' ') << "^ trigger"
+                  << (shown.triggered ? "" : " (none found, auto)") << std::endl;
+        std::cout << "  Frames: " << frames << " (" << triggeredFrames << " triggered), "
+                  << settings.frameLength << " samples each, FIFO overruns: " << fifo.getOverruns() << std::endl;
         std::cout << std::endl;
     }
     
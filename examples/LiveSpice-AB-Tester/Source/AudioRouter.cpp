@@ -1,23 +1,121 @@
 #include "AudioRouter.h"
 #include "Logging.h"
+#include <chrono>
+
+#if JUCE_INTEL
+ #include <immintrin.h>
+#endif
+#if JUCE_LINUX || JUCE_MAC
+ #include <pthread.h>
+#endif
+
+namespace
+{
+    // Spin-wait hint: lets the sibling hyperthread run while we poll
+    inline void cpuRelax()
+    {
+       #if JUCE_INTEL
+        _mm_pause();
+       #elif JUCE_ARM && defined(__aarch64__)
+        asm volatile ("yield");
+       #endif
+    }
+
+    // During a fade the worker spins at most this long after a job before parking
+    constexpr auto workerSpinTime = std::chrono::milliseconds(5);
+}
 
 AudioRouter::AudioRouter()
 {
 }
 
-void AudioRouter::prepareToPlay(double newSampleRate, int maximumExpectedSamplesPerBlock)
+AudioRouter::~AudioRouter()
+{
+    stopWorkerThread();
+}
+
+void AudioRouter::stopWorkerThread()
+{
+    if (!worker.joinable())
+        return;
+    
+    {
+        // Under the lock so the wake-up cannot fall between the worker's check and its wait
+        std::lock_guard<std::mutex> lock(workerMutex);
+        stopWorker.store(true, std::memory_order_relaxed);
+    }
+    workerWake.notify_all();
+    worker.join();
+    stopWorker.store(false, std::memory_order_relaxed);
+}
+
+void AudioRouter::setParallelProcessing(bool enabled)
+{
+    // Off first: a block already in flight takes a posted job back once the worker is gone
+    parallel.store(enabled, std::memory_order_relaxed);
+    
+    if (!enabled)
+    {
+        stopWorkerThread();
+    }
+    else if (!worker.joinable())
+    {
+        worker = std::thread([this] { workerLoop(); });
+
+       #if JUCE_LINUX || JUCE_MAC
+        // Real-time priority where the process may have it; otherwise the default
+        sched_param param{};
+        param.sched_priority = sched_get_priority_max(SCHED_FIFO) - 1;
+        pthread_setschedparam(worker.native_handle(), SCHED_FIFO, &param);
+       #endif
+    }
+
+    logDebug("AudioRouter: Parallel processing " + juce::String(enabled ? "on" : "off"), LogLevel::INFO);
+}
+
+void AudioRouter::prepareToPlay(double newSampleRate, int maximumExpectedSamplesPerBlock, int maximumChannels)
 {
     sampleRate = newSampleRate;
-    blockSize = maximumExpectedSamplesPerBlock;
+    blockSize = juce::jmax(1, maximumExpectedSamplesPerBlock);
+    channelCount = juce::jmax(1, maximumChannels);
+    
+    // Allocate scratch for crossfading: everything the audio thread touches
+    tempBuffer.setSize(channelCount, blockSize);
+    gainsA.assign((size_t) blockSize, 0.0f);
+    gainsB.assign((size_t) blockSize, 0.0f);
+    midiB.ensureSize(256);
+    midiChunk.ensureSize(2048);
+    midiOut.ensureSize(2048);
     
-    // Allocate temporary buffer for crossfading
-    tempBuffer.setSize(2, maximumExpectedSamplesPerBlock);
+    // Gain ramp for B over the fade; A's gain at position p is rampB[fadeLength - p]
+    fadeLength = juce::jmax(1, juce::roundToInt(crossfadeDurationMs * 0.001 * sampleRate));
+    rampB.resize((size_t) fadeLength + 1);
+    for (int i = 0; i <= fadeLength; ++i)
+    {
+        const float x = (float) i / (float) fadeLength;
+        rampB[(size_t) i] = crossfadeCurve == CrossfadeCurve::EqualPower
+            ? std::sin(x * juce::MathConstants<float>::halfPi)
+            : x;
+    }
     
-    crossfadeSamples = (crossfadeDurationMs / 1000.0f) * static_cast<float>(sampleRate);
+    meterA.prepare(sampleRate);
+    meterB.prepare(sampleRate);
+    
+    // Delay lines long enough for the largest compensation
+    for (auto* line : { &delayA, &delayB })
+    {
+        line->buffer.setSize(channelCount, juce::nextPowerOfTwo(maxCompensation + 1));
+        line->stale = true;
+    }
+    
+    fadePosition = getSelection() == ProcessorSelection::B ? fadeLength : 0;
+    crossfading.store(false, std::memory_order_relaxed);
     
     logDebug("AudioRouter: Prepared - " + 
              juce::String(sampleRate) + " Hz, " + 
-             juce::String(blockSize) + " samples", LogLevel::DEBUG);
+             juce::String(blockSize) + " samples, " +
+             juce::String(channelCount) + " channels, " +
+             juce::String(fadeLength) + " sample crossfade", LogLevel::DEBUG);
 }
 
 void AudioRouter::releaseResources()
@@ -27,32 +125,29 @@ void AudioRouter::releaseResources()
 
 void AudioRouter::setSelection(ProcessorSelection selection)
 {
-    if (selection == currentSelection)
+    if (selection == getSelection())
         return;
     
-    targetSelection = selection;
+    targetSelection.store(selection, std::memory_order_relaxed);
     
-    if (crossfadeEnabled)
-    {
-        // Start crossfade
-        crossfadeProgress = 0.0f;
-        logDebug("AudioRouter: Starting crossfade to " + 
-                 juce::String(selection == ProcessorSelection::A ? "A" : "B"), LogLevel::DEBUG);
-    }
-    else
-    {
-        // Instant switch
-        currentSelection = selection;
-        crossfadeProgress = 1.0f;
-        logDebug("AudioRouter: Switched to " + 
-                 juce::String(selection == ProcessorSelection::A ? "A" : "B"), LogLevel::INFO);
-    }
+    logDebug("AudioRouter: " + juce::String(crossfadeEnabled.load() ? "Crossfading" : "Switched") + " to " + 
+             juce::String(selection == ProcessorSelection::A ? "A" : "B"), LogLevel::INFO);
+}
+
+void AudioRouter::setLatencyOffset(int samplesBehindA)
+{
+    samplesBehindA = juce::jlimit(-maxCompensation, maxCompensation, samplesBehindA);
+    if (samplesBehindA == getLatencyOffset())
+        return;
+    
+    latencyOffset.store(samplesBehindA, std::memory_order_relaxed);
+    logDebug("AudioRouter: Latency compensation " + juce::String(samplesBehindA) + " samples (" +
+             juce::String(samplesBehindA >= 0 ? "A" : "B") + " delayed)", LogLevel::INFO);
 }
 
 void AudioRouter::setCrossfadeDurationMs(float durationMs)
 {
-    crossfadeDurationMs = durationMs;
-    crossfadeSamples = (crossfadeDurationMs / 1000.0f) * static_cast<float>(sampleRate);
+    crossfadeDurationMs = juce::jmax(0.0f, durationMs);
 }
 
 void AudioRouter::processBlock(
@@ -61,97 +156,218 @@ void AudioRouter::processBlock(
     IAudioProcessor* processorA,
     IAudioProcessor* processorB)
 {
-    const int numSamples = buffer.getNumSamples();
+    // Handle bypass: pass through input unchanged
+    if (isBypassed() || getSelection() == ProcessorSelection::Bypass)
+        return;
     
-    // Handle bypass
-    if (bypassed)
+    const int numSamples = buffer.getNumSamples();
+    if (numSamples <= blockSize)
     {
-        // Pass through input unchanged
+        processChunk(buffer, midiMessages, processorA, processorB);
         return;
     }
     
-    // Handle crossfading
-    if (crossfadeEnabled && crossfadeProgress < 1.0f)
+    // Hosts may deliver more than the expected block: process views of at most blockSize.
+    // Each chunk sees only its own MIDI events, shifted to start at 0; whatever the
+    // processors leave there is shifted back and handed on in place of the input
+    float* channels[32];
+    const int numChannels = juce::jmin(buffer.getNumChannels(), (int) juce::numElementsInArray(channels));
+    midiOut.clear();
+    for (int offset = 0; offset < numSamples; offset += blockSize)
     {
-        // Process both processors
-        if (processorA && processorA->isLoaded())
+        const int chunkSamples = juce::jmin(blockSize, numSamples - offset);
+        for (int ch = 0; ch < numChannels; ++ch)
+            channels[ch] = buffer.getWritePointer(ch, offset);
+        
+        midiChunk.clear();
+        midiChunk.addEvents(midiMessages, offset, chunkSamples, -offset);
+        
+        juce::AudioBuffer<float> chunk(channels, numChannels, chunkSamples);
+        processChunk(chunk, midiChunk, processorA, processorB);
+        
+        midiOut.addEvents(midiChunk, 0, -1, offset);
+    }
+    
+    // Copy rather than swap so both scratch buffers keep their preallocated storage
+    midiMessages.clear();
+    midiMessages.addEvents(midiOut, 0, -1, 0);
+}
+
+void AudioRouter::processChunk(juce::AudioBuffer<float>& buffer,
+                               juce::MidiBuffer& midiMessages,
+                               IAudioProcessor* processorA,
+                               IAudioProcessor* processorB)
+{
+    const int numSamples = buffer.getNumSamples();
+    const int target = getSelection() == ProcessorSelection::B ? fadeLength : 0;
+    
+    // The side that is ahead waits for the other
+    const int offset = latencyOffset.load(std::memory_order_relaxed);
+    const int compensationA = juce::jmax(0, offset);
+    const int compensationB = juce::jmax(0, -offset);
+    
+    // Without crossfading a switch is immediate
+    if (!crossfadeEnabled.load(std::memory_order_relaxed))
+        fadePosition = target;
+    
+    // No crossfade - direct routing, in place
+    if (fadePosition == target)
+    {
+        crossfading.store(false, std::memory_order_relaxed);
+        if (target == 0)
         {
-            // Copy input to temp buffer
-            tempBuffer.makeCopyOf(buffer, true);
-            
-            // Process A
-            processorA->processBlock(buffer, midiMessages);
-            
-            // Process B on temp buffer
-            if (processorB && processorB->isLoaded())
-            {
-                processorB->processBlock(tempBuffer, midiMessages);
-            }
-            
-            // Crossfade between A and B
-            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
-            {
-                auto* bufferData = buffer.getWritePointer(channel);
-                auto* tempData = tempBuffer.getReadPointer(channel);
-                
-                for (int sample = 0; sample < numSamples; ++sample)
-                {
-                    // Update crossfade for this sample
-                    updateCrossfade(1);
-                    
-                    // Mix based on crossfade progress
-                    float gainA = (targetSelection == ProcessorSelection::A) ? crossfadeProgress : (1.0f - crossfadeProgress);
-                    float gainB = 1.0f - gainA;
-                    
-                    bufferData[sample] = bufferData[sample] * gainA + tempData[sample] * gainB;
-                }
-            }
-            
-            // Check if crossfade complete
-            if (crossfadeProgress >= 1.0f)
-            {
-                currentSelection = targetSelection;
-                logDebug("AudioRouter: Crossfade complete", LogLevel::DEBUG);
-            }
+            runProcessor(processorA, buffer, midiMessages, meterA);
+            applyDelay(delayA, compensationA, buffer);
+            delayB.stale = true;
         }
+        else
+        {
+            runProcessor(processorB, buffer, midiMessages, meterB);
+            applyDelay(delayB, compensationB, buffer);
+            delayA.stale = true;
+        }
+        return;
     }
-    else
+    
+    crossfading.store(true, std::memory_order_relaxed);
+    
+    // This block's gains from the ramp table: one step per sample, holding at the target
+    int position = fadePosition;
+    const int step = target > position ? 1 : -1;
+    for (int i = 0; i < numSamples; ++i)
     {
-        // No crossfade - direct routing
-        if (currentSelection == ProcessorSelection::A)
+        if (position != target)
+            position += step;
+        gainsB[(size_t) i] = rampB[(size_t) position];
+        gainsA[(size_t) i] = rampB[(size_t) (fadeLength - position)];
+    }
+    fadePosition = position;
+    
+    // B runs on a copy of the input, A in place. Channels beyond what
+    // prepareToPlay() was told about are left with A's output
+    const int numChannels = juce::jmin(buffer.getNumChannels(), tempBuffer.getNumChannels());
+    for (int ch = 0; ch < numChannels; ++ch)
+        tempBuffer.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+    
+    juce::AudioBuffer<float> tempView(tempBuffer.getArrayOfWritePointers(), numChannels, numSamples);
+    
+    midiB.clear();
+    if (isParallelProcessing())
+    {
+        // Hand B to the worker, run A here, then join
+        jobProcessor = processorB;
+        jobBuffer = &tempView;
+        jobState.store(jobPosted, std::memory_order_release);
+        workerWake.notify_one();
+        
+        runProcessor(processorA, buffer, midiMessages, meterA);
+        
+        int expected = jobPosted;
+        if (jobState.compare_exchange_strong(expected, jobIdle, std::memory_order_acq_rel))
         {
-            if (processorA && processorA->isLoaded())
-            {
-                processorA->processBlock(buffer, midiMessages);
-            }
-            else
-            {
-                buffer.clear();
-            }
+            runProcessor(processorB, tempView, midiB, meterB);   // Worker never picked it up
         }
-        else if (currentSelection == ProcessorSelection::B)
+        else
         {
-            if (processorB && processorB->isLoaded())
-            {
-                processorB->processBlock(buffer, midiMessages);
-            }
-            else
-            {
-                buffer.clear();
-            }
+            while (jobState.load(std::memory_order_acquire) != jobDone)
+                cpuRelax();
+            jobState.store(jobIdle, std::memory_order_relaxed);
         }
-        else if (currentSelection == ProcessorSelection::Bypass)
+    }
+    else
+    {
+        runProcessor(processorA, buffer, midiMessages, meterA);
+        runProcessor(processorB, tempView, midiB, meterB);
+    }
+    
+    applyDelay(delayA, compensationA, buffer);
+    applyDelay(delayB, compensationB, tempView);
+    
+    // Mix: out = A * gainA + B * gainB
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto* out = buffer.getWritePointer(ch);
+        juce::FloatVectorOperations::multiply(out, gainsA.data(), numSamples);
+        juce::FloatVectorOperations::addWithMultiply(out, tempBuffer.getReadPointer(ch), gainsB.data(), numSamples);
+    }
+}
+
+void AudioRouter::runProcessor(IAudioProcessor* processor,
+                               juce::AudioBuffer<float>& buffer,
+                               juce::MidiBuffer& midiMessages,
+                               ProcessorMeter& meter)
+{
+    if (processor && processor->isLoaded())
+    {
+        const auto start = ProcessorMeter::start();
+        processor->processBlock(buffer, midiMessages);
+        meter.stop(start, buffer.getNumSamples());
+    }
+    else
+    {
+        buffer.clear();
+    }
+}
+
+void AudioRouter::applyDelay(DelayLine& line, int delay, juce::AudioBuffer<float>& buffer)
+{
+    // Restart from silence rather than replay audio from another delay or an idle stretch
+    if (line.stale || delay != line.delay)
+    {
+        line.buffer.clear();
+        line.writePosition = 0;
+        line.delay = delay;
+        line.stale = false;
+    }
+    
+    if (delay == 0)
+        return;
+    
+    const int mask = line.buffer.getNumSamples() - 1;
+    const int numChannels = juce::jmin(buffer.getNumChannels(), line.buffer.getNumChannels());
+    const int numSamples = buffer.getNumSamples();
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        auto* data = buffer.getWritePointer(ch);
+        auto* ring = line.buffer.getWritePointer(ch);
+        int position = line.writePosition;
+        for (int i = 0; i < numSamples; ++i)
         {
-            // Already handled above, but kept for clarity
+            ring[position] = data[i];
+            data[i] = ring[(position - delay) & mask];
+            position = (position + 1) & mask;
         }
     }
+    line.writePosition = (line.writePosition + numSamples) & mask;
 }
 
-void AudioRouter::updateCrossfade(int numSamples)
+void AudioRouter::workerLoop()
 {
-    if (crossfadeProgress >= 1.0f)
-        return;
+    auto lastJob = std::chrono::steady_clock::now();
     
-    float increment = static_cast<float>(numSamples) / crossfadeSamples;
-    crossfadeProgress = juce::jmin(1.0f, crossfadeProgress + increment);
+    while (!stopWorker.load(std::memory_order_relaxed))
+    {
+        int expected = jobPosted;
+        if (jobState.compare_exchange_strong(expected, jobClaimed, std::memory_order_acq_rel))
+        {
+            runProcessor(jobProcessor, *jobBuffer, midiB, meterB);
+            jobState.store(jobDone, std::memory_order_release);
+            lastJob = std::chrono::steady_clock::now();
+            continue;
+        }
+        
+        // Spin while a fade keeps jobs coming, park once it ends or the jobs stop
+        if (crossfading.load(std::memory_order_relaxed)
+            && std::chrono::steady_clock::now() - lastJob < workerSpinTime)
+        {
+            cpuRelax();
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(workerMutex);
+        workerWake.wait(lock, [this] {
+            return stopWorker.load(std::memory_order_relaxed)
+                || jobState.load(std::memory_order_acquire) == jobPosted;
+        });
+    }
 }
@@ -1,7 +1,13 @@
 #pragma once
 
 #include "IAudioProcessor.h"
+#include "ProcessorMeter.h"
 #include <juce_audio_processors/juce_audio_processors.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 /**
  * AudioRouter - Manages audio signal routing between processors
@@ -11,6 +17,42 @@
  * - Handles smooth crossfading during A/B switches (optional)
  * - Manages buffer allocation and channel configuration
  * - Provides bypass/mute functionality
+ * 
+ * Real-time safety:
+ * - Nothing on the audio thread allocates: the scratch buffer for the
+ *   second processor and the per-sample gain arrays are sized in
+ *   prepareToPlay() for the maximum block size and channel count (larger
+ *   blocks are processed in chunks, each with its own slice of the MIDI)
+ * - The crossfade is a gain ramp precomputed in prepareToPlay() and
+ *   applied per block with vector operations
+ * - Selection is handed to the audio thread through an atomic
+ * 
+ * Parallel processing (optional):
+ * - During a crossfade B runs on a dedicated worker thread while the
+ *   audio thread runs A, halving the critical path for two heavy processors
+ * - Handoff is one atomic job state: the audio thread posts, the worker
+ *   claims with a compare-and-swap, the audio thread spins until done
+ * - Between jobs of a running fade the worker spins; otherwise it parks on
+ *   a condition variable that the audio thread notifies (without locking)
+ *   when it posts
+ * - If the worker has not claimed the job by the time A is finished (it
+ *   was parked, or missed the notification), the audio thread takes it
+ *   back and runs B itself: a late worker costs one serial block, never a
+ *   missed deadline
+ * - Turning parallel processing off stops and joins the worker
+ * 
+ * Latency compensation:
+ * - A and B may report or show different latencies; the earlier side is
+ *   delayed by the offset so both arrive sample-aligned (null tests, the
+ *   crossfade, the calibrator's comparisons)
+ * - Delay lines for both sides are allocated in prepareToPlay() for up to
+ *   maxCompensation samples; the offset is handed over through an atomic
+ * - A delay line restarts from silence when its delay changes or its side
+ *   resumes after sitting idle, so stale audio never leaks out
+ * 
+ * Instrumentation:
+ * - Every processBlock() of A and B is timed into that slot's
+ *   ProcessorMeter, on whichever thread ran it
  */
 class AudioRouter
 {
@@ -22,24 +64,46 @@ public:
         Bypass  // Direct passthrough, no processing
     };
 
+    enum class CrossfadeCurve
+    {
+        Linear,      // Gains sum to 1 (for correlated signals)
+        EqualPower   // sin/cos gains, powers sum to 1 (for A/B of different processors)
+    };
+
+    static constexpr int maxCompensation = 8192;   // Samples
+
     AudioRouter();
-    ~AudioRouter() = default;
+    ~AudioRouter();
 
-    // Configuration
-    void prepareToPlay(double sampleRate, int maximumExpectedSamplesPerBlock);
+    // Configuration: the block size and channel count the audio thread will see at most
+    void prepareToPlay(double sampleRate, int maximumExpectedSamplesPerBlock, int maximumChannels = 2);
     void releaseResources();
 
-    // Routing control
+    // Routing control (any thread)
     void setSelection(ProcessorSelection selection);
-    ProcessorSelection getSelection() const { return currentSelection; }
+    ProcessorSelection getSelection() const { return targetSelection.load(std::memory_order_relaxed); }
     
-    void setBypass(bool shouldBypass) { bypassed = shouldBypass; }
-    bool isBypassed() const { return bypassed; }
+    void setBypass(bool shouldBypass) { bypassed.store(shouldBypass, std::memory_order_relaxed); }
+    bool isBypassed() const { return bypassed.load(std::memory_order_relaxed); }
 
-    // Crossfade settings
-    void setCrossfadeEnabled(bool enabled) { crossfadeEnabled = enabled; }
+    // Crossfade settings (duration and curve take effect at the next prepareToPlay)
+    void setCrossfadeEnabled(bool enabled) { crossfadeEnabled.store(enabled, std::memory_order_relaxed); }
     void setCrossfadeDurationMs(float durationMs);
-    bool isCrossfading() const { return crossfadeProgress < 1.0f; }
+    void setCrossfadeCurve(CrossfadeCurve curve) { crossfadeCurve = curve; }
+    bool isCrossfading() const { return crossfading.load(std::memory_order_relaxed); }
+
+    // Run B on a worker thread during crossfades (started when enabled, joined when disabled)
+    void setParallelProcessing(bool enabled);
+    bool isParallelProcessing() const { return parallel.load(std::memory_order_relaxed); }
+
+    // Samples by which B's output trails A's (any thread). Positive values
+    // delay A, negative values delay B; clamped to +/-maxCompensation
+    void setLatencyOffset(int samplesBehindA);
+    int getLatencyOffset() const { return latencyOffset.load(std::memory_order_relaxed); }
+
+    // Per-slot CPU load (read from any thread)
+    ProcessorMeter& getMeterA() { return meterA; }
+    ProcessorMeter& getMeterB() { return meterB; }
 
     // Audio processing
     void processBlock(
@@ -50,23 +114,68 @@ public:
     );
 
 private:
-    ProcessorSelection currentSelection{ProcessorSelection::A};
-    ProcessorSelection targetSelection{ProcessorSelection::A};
-    
-    bool bypassed{false};
-    bool crossfadeEnabled{false};
+    std::atomic<ProcessorSelection> targetSelection{ProcessorSelection::A};
+    std::atomic<bool> bypassed{false};
+    std::atomic<bool> crossfadeEnabled{false};
+    std::atomic<bool> crossfading{false};
     
     float crossfadeDurationMs{50.0f};
-    float crossfadeSamples{0.0f};
-    float crossfadeProgress{1.0f};  // 0.0 = fully A, 1.0 = fully B (or complete)
+    CrossfadeCurve crossfadeCurve{CrossfadeCurve::EqualPower};
     
     double sampleRate{44100.0};
     int blockSize{512};
+    int channelCount{2};
+    
+    // Fade position in samples (audio thread): 0 = all A, fadeLength = all B
+    int fadeLength{1};
+    int fadePosition{0};
     
-    // Temporary buffer for crossfading
+    // Gain of B at each fade position; A uses the mirrored entry
+    std::vector<float> rampB;
+    
+    // Preallocated scratch: B's copy of the input, per-sample gains, B's MIDI,
+    // and the MIDI of one chunk of an oversized block plus what comes back out
     juce::AudioBuffer<float> tempBuffer;
+    std::vector<float> gainsA;
+    std::vector<float> gainsB;
+    juce::MidiBuffer midiB;
+    juce::MidiBuffer midiChunk;
+    juce::MidiBuffer midiOut;
+    
+    ProcessorMeter meterA;
+    ProcessorMeter meterB;
+    
+    // Per-side delay line (audio thread only; B's is applied after the join)
+    struct DelayLine
+    {
+        juce::AudioBuffer<float> buffer;   // Power-of-two length > maxCompensation
+        int writePosition{0};
+        int delay{0};
+        bool stale{true};                  // Restart from silence on next use
+    };
+    
+    std::atomic<int> latencyOffset{0};
+    DelayLine delayA;
+    DelayLine delayB;
+    
+    // B worker: job state handoff (see class comment)
+    enum JobState { jobIdle, jobPosted, jobClaimed, jobDone };
+    std::atomic<bool> parallel{false};
+    std::atomic<bool> stopWorker{false};
+    std::atomic<int> jobState{jobIdle};
+    IAudioProcessor* jobProcessor{nullptr};
+    juce::AudioBuffer<float>* jobBuffer{nullptr};
+    std::thread worker;
+    std::mutex workerMutex;                 // Only for parking the worker
+    std::condition_variable workerWake;
     
-    void updateCrossfade(int numSamples);
+    void workerLoop();
+    void stopWorkerThread();
+    void processChunk(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages,
+                      IAudioProcessor* processorA, IAudioProcessor* processorB);
+    static void runProcessor(IAudioProcessor* processor, juce::AudioBuffer<float>& buffer,
+                             juce::MidiBuffer& midiMessages, ProcessorMeter& meter);
+    static void applyDelay(DelayLine& line, int delay, juce::AudioBuffer<float>& buffer);
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AudioRouter)
 };
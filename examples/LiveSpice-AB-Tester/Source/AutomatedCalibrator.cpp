@@ -5,9 +5,67 @@
 */
 
 #include "AutomatedCalibrator.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <numeric>
+#include <thread>
+
+namespace
+{
+    // Eigen-decomposition of a small symmetric matrix (cyclic Jacobi).
+    // On return a holds the eigenvalues on its diagonal, v the eigenvectors in columns.
+    void symmetricEigen(std::vector<std::vector<double>>& a, std::vector<std::vector<double>>& v)
+    {
+        const size_t n = a.size();
+        v.assign(n, std::vector<double>(n, 0.0));
+        for (size_t i = 0; i < n; ++i)
+            v[i][i] = 1.0;
+        
+        for (int sweep = 0; sweep < 50; ++sweep)
+        {
+            double offDiagonal = 0.0;
+            for (size_t p = 0; p < n; ++p)
+                for (size_t q = p + 1; q < n; ++q)
+                    offDiagonal += a[p][q] * a[p][q];
+            if (offDiagonal < 1e-22)
+                return;
+            
+            for (size_t p = 0; p < n; ++p)
+            {
+                for (size_t q = p + 1; q < n; ++q)
+                {
+                    if (std::abs(a[p][q]) < 1e-300)
+                        continue;
+                    const double theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                    const double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                    const double c = 1.0 / std::sqrt(t * t + 1.0);
+                    const double sn = t * c;
+                    for (size_t k = 0; k < n; ++k)
+                    {
+                        const double akp = a[k][p], akq = a[k][q];
+                        a[k][p] = c * akp - sn * akq;
+                        a[k][q] = sn * akp + c * akq;
+                    }
+                    for (size_t k = 0; k < n; ++k)
+                    {
+                        const double apk = a[p][k], aqk = a[q][k];
+                        a[p][k] = c * apk - sn * aqk;
+                        a[q][k] = sn * apk + c * aqk;
+                    }
+                    for (size_t k = 0; k < n; ++k)
+                    {
+                        const double vkp = v[k][p], vkq = v[k][q];
+                        v[k][p] = c * vkp - sn * vkq;
+                        v[k][q] = sn * vkp + c * vkq;
+                    }
+                }
+            }
+        }
+    }
+}
 
 AutomatedCalibrator::AutomatedCalibrator()
-    : fftData(4096)
 {
     testSignal.setSize(2, 8192);
 }
@@ -25,6 +83,23 @@ void AutomatedCalibrator::setProcessors(IAudioProcessor* reference, IAudioProces
     LOG("Calibrator: Reference and target processors set");
 }
 
+void AutomatedCalibrator::setReferenceFactory(std::function<std::unique_ptr<IAudioProcessor>()> factory)
+{
+    referenceFactory = std::move(factory);
+}
+
+void AutomatedCalibrator::setTargetFactory(std::function<std::unique_ptr<IAudioProcessor>()> factory,
+                                           int numWorkers)
+{
+    targetFactory = std::move(factory);
+    maxWorkers = numWorkers;
+}
+
+void AutomatedCalibrator::setBatchTargetFactory(std::function<std::unique_ptr<BatchTarget>()> factory)
+{
+    batchTargetFactory = std::move(factory);
+}
+
 void AutomatedCalibrator::addParameter(const juce::String& name, float min, float max, float initial)
 {
     ParameterConfig param;
@@ -64,6 +139,9 @@ bool AutomatedCalibrator::runCalibration()
     running = true;
     currentIteration = 0;
     previousError = std::numeric_limits<float>::max();
+    evaluationCache.clear();
+    evaluationCount = 0;
+    cacheHits = 0;
     
     LOG("=== Starting Automated Calibration ===");
     LOG("Parameters: " + juce::String(parameters.size()));
@@ -76,15 +154,41 @@ bool AutomatedCalibrator::runCalibration()
     // Allocate output buffers
     referenceOutput.setSize(2, settings.testDurationSamples);
     targetOutput.setSize(2, settings.testDurationSamples);
+    spectralLoss.prepare(settings.testDurationSamples);
+    prepareInstances();
+    resolveParameterIndices(*activeTarget);
+    buildWorkerPool();
+    if (batchTargetFactory && settings.optimizer == CalibrationSettings::Optimizer::GridSearch)
+        batchTarget = batchTargetFactory();
+    
+    // Offline renders are deterministic, so the reference only needs rendering once.
+    // The derivative-free searches also compare every point against one reference.
+    if (offlineReference || settings.optimizer != CalibrationSettings::Optimizer::GradientDescent)
+    {
+        referenceOutput.makeCopyOf(testSignal, true);
+        render(*activeReference, referenceOutput);
+    }
     
     // Main optimization loop
-    while (running && currentIteration < settings.maxIterations)
+    bool success = false;
+    switch (settings.optimizer)
     {
-        if (!runCalibrationStep())
-            break;
+        case CalibrationSettings::Optimizer::NelderMead: success = runNelderMead(); break;
+        case CalibrationSettings::Optimizer::CMAES:      success = runCMAES(); break;
+        case CalibrationSettings::Optimizer::GridSearch: success = runGridSearch(); break;
+        default:                                         success = runGradientDescent(); break;
     }
     
-    bool success = (currentIteration < settings.maxIterations);
+    // Hand the result to the live target
+    if (offlineTarget)
+    {
+        for (size_t i = 0; i < parameters.size(); ++i)
+            if (parameters[i].enabled)
+                setTargetParameter(*targetProcessor, i, parameters[i].currentValue);
+    }
+    releaseInstances();
+    
+    LOG("Calibrator: " + juce::String(evaluationCount) + " renders, " + juce::String(cacheHits) + " cache hits");
     
     if (success)
         LOG("=== Calibration CONVERGED after " + juce::String(currentIteration) + " iterations ===");
@@ -107,33 +211,16 @@ bool AutomatedCalibrator::runCalibrationStep()
     // Apply current parameters to target
     applyParametersToTarget();
     
-    // Process test signal through both processors
-    referenceOutput.makeCopyOf(testSignal);
-    targetOutput.makeCopyOf(testSignal);
-    
-    if (referenceProcessor)
-        referenceProcessor->processBlock(referenceOutput);
-    
-    if (targetProcessor)
-        targetProcessor->processBlock(targetOutput);
-    
-    // Calculate error metrics
-    latestMetrics = calculateMetrics(referenceOutput, targetOutput);
-    
-    // Log progress
-    if (currentIteration % 10 == 0 || currentIteration == 1)
+    // Process test signal through both processors (the offline reference is already rendered)
+    if (!offlineReference)
     {
-        LOG("Iteration " + juce::String(currentIteration) + ": " + latestMetrics.toString());
-        
-        // Log parameter values
-        juce::String paramStr = "  Params: ";
-        for (const auto& p : parameters)
-            paramStr += p.name + "=" + juce::String(p.currentValue, 3) + " ";
-        LOG(paramStr);
+        referenceOutput.makeCopyOf(testSignal, true);
+        render(*activeReference, referenceOutput);
     }
     
-    if (onProgressUpdate)
-        onProgressUpdate(currentIteration, latestMetrics);
+    // Calculate error metrics
+    latestMetrics = evaluateAt(currentValues());
+    reportProgress();
     
     // Check convergence
     float errorImprovement = previousError - latestMetrics.totalError;
@@ -147,10 +234,17 @@ bool AutomatedCalibrator::runCalibrationStep()
     // Compute gradients for each parameter
     std::vector<float> gradients(parameters.size());
     
-    for (size_t i = 0; i < parameters.size(); ++i)
+    if (!workers.empty())
     {
-        if (parameters[i].enabled)
-            computeGradient((int)i, gradients[i]);
+        computeGradientsParallel(gradients);
+    }
+    else
+    {
+        for (size_t i = 0; i < parameters.size(); ++i)
+        {
+            if (parameters[i].enabled)
+                computeGradient((int)i, gradients[i]);
+        }
     }
     
     // Update parameters using gradient descent
@@ -172,8 +266,10 @@ AutomatedCalibrator::ComparisonMetrics AutomatedCalibrator::compareProcessors()
     referenceOutput.makeCopyOf(testSignal);
     targetOutput.makeCopyOf(testSignal);
     
-    referenceProcessor->processBlock(referenceOutput);
-    targetProcessor->processBlock(targetOutput);
+    juce::MidiBuffer midi;
+    referenceProcessor->processBlock(referenceOutput, midi);
+    midi.clear();
+    targetProcessor->processBlock(targetOutput, midi);
     
     return calculateMetrics(referenceOutput, targetOutput);
 }
@@ -201,29 +297,55 @@ void AutomatedCalibrator::generateTestSignal(juce::AudioBuffer<float>& buffer, i
 
 void AutomatedCalibrator::applyParametersToTarget()
 {
-    if (!targetProcessor)
+    // During a run this is the offline target when there is one
+    auto* target = activeTarget ? activeTarget : targetProcessor;
+    if (!target)
         return;
     
     // Apply each parameter to the target processor
-    for (const auto& param : parameters)
+    for (size_t i = 0; i < parameters.size(); ++i)
     {
-        if (param.enabled)
+        if (parameters[i].enabled)
         {
-            targetProcessor->setParameter(param.name, param.currentValue);
+            setTargetParameter(*target, i, parameters[i].currentValue);
         }
     }
 }
 
+void AutomatedCalibrator::resolveParameterIndices(const IAudioProcessor& target)
+{
+    parameterIndices.resize(parameters.size());
+    for (size_t i = 0; i < parameters.size(); ++i)
+        parameterIndices[i] = target.getParameterIndex(parameters[i].name);
+}
+
+void AutomatedCalibrator::setTargetParameter(IAudioProcessor& target, size_t i, float value)
+{
+    // Every target instance is the same processor type, so one set of indices serves all
+    if (i < parameterIndices.size() && parameterIndices[i] >= 0)
+        target.setParameterByIndex(parameterIndices[i], value);
+    else
+        target.setParameter(parameters[i].name, value);
+}
+
 AutomatedCalibrator::ComparisonMetrics 
 AutomatedCalibrator::calculateMetrics(const juce::AudioBuffer<float>& reference,
                                      const juce::AudioBuffer<float>& target)
+{
+    return calculateMetrics(reference, target, spectralLoss);
+}
+
+AutomatedCalibrator::ComparisonMetrics 
+AutomatedCalibrator::calculateMetrics(const juce::AudioBuffer<float>& reference,
+                                     const juce::AudioBuffer<float>& target,
+                                     SpectralLoss& loss)
 {
     ComparisonMetrics metrics;
     
     metrics.rmsError = calculateRMSError(reference, target);
     metrics.correlation = calculateCorrelation(reference, target);
     metrics.peakError = calculatePeakError(reference, target);
-    metrics.spectralError = calculateSpectralError(reference, target);
+    metrics.spectralError = calculateSpectralError(reference, target, loss);
     
     // Combined weighted error
     metrics.totalError = 
@@ -334,15 +456,12 @@ float AutomatedCalibrator::calculatePeakError(const juce::AudioBuffer<float>& a,
 }
 
 float AutomatedCalibrator::calculateSpectralError(const juce::AudioBuffer<float>& a,
-                                                  const juce::AudioBuffer<float>& b)
+                                                  const juce::AudioBuffer<float>& b,
+                                                  SpectralLoss& loss)
 {
-    // Simplified spectral comparison using magnitude spectrum
-    // In a full implementation, would use FFT on both signals and compare
-    
-    // For now, return 0 (not implemented)
-    // TODO: Implement FFT-based spectral comparison
-    juce::ignoreUnused(a, b);
-    return 0.0f;
+    // Reference spectra are only recomputed when the reference render changed
+    loss.setReference(a);
+    return loss.compare(b);
 }
 
 void AutomatedCalibrator::computeGradient(int paramIndex, float& gradient)
@@ -353,31 +472,706 @@ void AutomatedCalibrator::computeGradient(int paramIndex, float& gradient)
         return;
     }
     
-    auto& param = parameters[paramIndex];
-    
-    // Save current value
-    float originalValue = param.currentValue;
+    const auto& param = parameters[paramIndex];
     float stepSize = param.stepSize;
     
     // Evaluate error at current value (already computed in latestMetrics)
     float errorCurrent = latestMetrics.totalError;
     
     // Evaluate error at (current + step)
-    param.currentValue = juce::jlimit(param.minValue, param.maxValue, 
-                                     originalValue + stepSize);
+    auto values = currentValues();
+    values[paramIndex] = juce::jlimit(param.minValue, param.maxValue, param.currentValue + stepSize);
+    auto metricsPlus = evaluateAt(values);
+    
+    // Compute numerical gradient
+    gradient = (metricsPlus.totalError - errorCurrent) / stepSize;
+}
+
+bool AutomatedCalibrator::runGradientDescent()
+{
+    while (running && currentIteration < settings.maxIterations)
+    {
+        if (!runCalibrationStep())
+            return true;
+    }
+    return currentIteration < settings.maxIterations;
+}
+
+bool AutomatedCalibrator::runNelderMead()
+{
+    // Search over the enabled parameters, each normalised to [0, 1]
+    const auto dims = enabledParameters();
+    const size_t n = dims.size();
+    const auto base = currentValues();
+    if (n == 0)
+    {
+        latestMetrics = evaluateAt(base);
+        return true;
+    }
+    
+    auto toValues = [&](const std::vector<double>& u) {
+        auto values = base;
+        for (size_t d = 0; d < n; ++d)
+        {
+            const auto& p = parameters[dims[d]];
+            values[dims[d]] = p.minValue + (float) juce::jlimit(0.0, 1.0, u[d]) * (p.maxValue - p.minValue);
+        }
+        return values;
+    };
+    auto cost = [&](const std::vector<double>& u) { return (double) evaluateAt(toValues(u)).totalError; };
+    
+    // Initial simplex: the start point plus a 10% step along each axis (inwards at the bounds)
+    std::vector<std::vector<double>> simplex(n + 1, std::vector<double>(n));
+    for (size_t d = 0; d < n; ++d)
+    {
+        const auto& p = parameters[dims[d]];
+        const float range = p.maxValue - p.minValue;
+        simplex[0][d] = range > 0.0f ? (base[dims[d]] - p.minValue) / range : 0.0;
+    }
+    for (size_t d = 0; d < n; ++d)
+    {
+        simplex[d + 1] = simplex[0];
+        simplex[d + 1][d] += simplex[0][d] + 0.1 <= 1.0 ? 0.1 : -0.1;
+    }
+    std::vector<double> f(n + 1);
+    for (size_t i = 0; i <= n; ++i)
+        f[i] = cost(simplex[i]);
+    
+    std::vector<size_t> order(n + 1);
+    std::vector<double> centroid(n), trial(n), second(n);
+    auto along = [&](std::vector<double>& out, const std::vector<double>& from, double t) {
+        // out = centroid + t * (from - centroid), clamped to the unit box
+        for (size_t d = 0; d < n; ++d)
+            out[d] = juce::jlimit(0.0, 1.0, centroid[d] + t * (from[d] - centroid[d]));
+    };
+    
+    while (running && currentIteration < settings.maxIterations)
+    {
+        ++currentIteration;
+        
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t i, size_t j) { return f[i] < f[j]; });
+        const size_t best = order.front(), worst = order.back(), nextWorst = order[n - 1];
+        
+        latestMetrics = evaluateAt(toValues(simplex[best]));
+        if (f[worst] - f[best] < settings.convergenceThreshold)
+            break;
+        
+        std::fill(centroid.begin(), centroid.end(), 0.0);
+        for (size_t i = 0; i <= n; ++i)
+            if (i != worst)
+                for (size_t d = 0; d < n; ++d)
+                    centroid[d] += simplex[i][d] / (double) n;
+        
+        // Reflect, then expand, contract or shrink
+        along(trial, simplex[worst], -1.0);
+        const double fr = cost(trial);
+        if (fr < f[best])
+        {
+            along(second, simplex[worst], -2.0);
+            const double fe = cost(second);
+            simplex[worst] = fe < fr ? second : trial;
+            f[worst] = std::min(fe, fr);
+        }
+        else if (fr < f[nextWorst])
+        {
+            simplex[worst] = trial;
+            f[worst] = fr;
+        }
+        else
+        {
+            along(second, fr < f[worst] ? trial : simplex[worst], 0.5);
+            const double fc = cost(second);
+            if (fc < std::min(fr, f[worst]))
+            {
+                simplex[worst] = second;
+                f[worst] = fc;
+            }
+            else
+            {
+                for (size_t i = 0; i <= n; ++i)
+                {
+                    if (i == best)
+                        continue;
+                    for (size_t d = 0; d < n; ++d)
+                        simplex[i][d] = simplex[best][d] + 0.5 * (simplex[i][d] - simplex[best][d]);
+                    f[i] = cost(simplex[i]);
+                }
+            }
+        }
+        
+        reportProgress();
+    }
+    
+    // Leave the plugins at the best vertex
+    const size_t best = (size_t) (std::min_element(f.begin(), f.end()) - f.begin());
+    const auto bestValues = toValues(simplex[best]);
+    applyValues(bestValues);
+    latestMetrics = evaluateAt(bestValues);
+    return *std::max_element(f.begin(), f.end()) - f[best] < settings.convergenceThreshold;
+}
+
+bool AutomatedCalibrator::runCMAES()
+{
+    // (mu/mu_w, lambda)-CMA-ES over the enabled parameters normalised to [0, 1]
+    const auto dims = enabledParameters();
+    const size_t n = dims.size();
+    const auto base = currentValues();
+    if (n == 0)
+    {
+        latestMetrics = evaluateAt(base);
+        return true;
+    }
+    
+    auto toValues = [&](const std::vector<double>& u) {
+        auto values = base;
+        for (size_t d = 0; d < n; ++d)
+        {
+            const auto& p = parameters[dims[d]];
+            values[dims[d]] = p.minValue + (float) juce::jlimit(0.0, 1.0, u[d]) * (p.maxValue - p.minValue);
+        }
+        return values;
+    };
+    
+    // Strategy parameters (Hansen's defaults)
+    const double dn = (double) n;
+    const size_t lambda = 4 + (size_t) std::floor(3.0 * std::log(dn));
+    const size_t mu = lambda / 2;
+    std::vector<double> weights(mu);
+    for (size_t i = 0; i < mu; ++i)
+        weights[i] = std::log((double) mu + 0.5) - std::log((double) i + 1.0);
+    const double weightSum = std::accumulate(weights.begin(), weights.end(), 0.0);
+    double weightSquares = 0.0;
+    for (auto& w : weights)
+    {
+        w /= weightSum;
+        weightSquares += w * w;
+    }
+    const double muEff = 1.0 / weightSquares;
+    const double cSigma = (muEff + 2.0) / (dn + muEff + 5.0);
+    const double dSigma = 1.0 + 2.0 * std::max(0.0, std::sqrt((muEff - 1.0) / (dn + 1.0)) - 1.0) + cSigma;
+    const double cc = (4.0 + muEff / dn) / (dn + 4.0 + 2.0 * muEff / dn);
+    const double c1 = 2.0 / ((dn + 1.3) * (dn + 1.3) + muEff);
+    const double cMu = std::min(1.0 - c1, 2.0 * (muEff - 2.0 + 1.0 / muEff) / ((dn + 2.0) * (dn + 2.0) + muEff));
+    const double chiN = std::sqrt(dn) * (1.0 - 1.0 / (4.0 * dn) + 1.0 / (21.0 * dn * dn));
+    
+    std::vector<double> mean(n);
+    for (size_t d = 0; d < n; ++d)
+    {
+        const auto& p = parameters[dims[d]];
+        const float range = p.maxValue - p.minValue;
+        mean[d] = range > 0.0f ? (base[dims[d]] - p.minValue) / range : 0.0;
+    }
+    double sigma = 0.2;
+    std::vector<std::vector<double>> C(n, std::vector<double>(n, 0.0)), B, eigen;
+    for (size_t d = 0; d < n; ++d)
+        C[d][d] = 1.0;
+    std::vector<double> D(n, 1.0), pSigma(n, 0.0), pc(n, 0.0);
+    
+    std::vector<std::vector<double>> x(lambda, std::vector<double>(n)), y(lambda, std::vector<double>(n));
+    std::vector<double> fitness(lambda), z(n), yw(n), invSqrtY(n);
+    std::vector<size_t> order(lambda);
+    
+    double bestCost = std::numeric_limits<double>::max();
+    std::vector<double> bestPoint = mean;
+    bool converged = false;
+    
+    auto gaussian = [this]() {
+        // Box-Muller
+        const double u1 = juce::jmax(1e-12, random.nextDouble());
+        const double u2 = random.nextDouble();
+        return std::sqrt(-2.0 * std::log(u1)) * std::cos(juce::MathConstants<double>::twoPi * u2);
+    };
+    
+    while (running && currentIteration < settings.maxIterations)
+    {
+        ++currentIteration;
+        
+        // C = B diag(D^2) B^T
+        eigen = C;
+        symmetricEigen(eigen, B);
+        for (size_t d = 0; d < n; ++d)
+            D[d] = std::sqrt(std::max(1e-20, eigen[d][d]));
+        
+        // Sample and evaluate a generation (off-box samples are evaluated clamped)
+        for (size_t k = 0; k < lambda; ++k)
+        {
+            for (size_t d = 0; d < n; ++d)
+                z[d] = gaussian();
+            for (size_t r = 0; r < n; ++r)
+            {
+                double sum = 0.0;
+                for (size_t c = 0; c < n; ++c)
+                    sum += B[r][c] * D[c] * z[c];
+                y[k][r] = sum;
+                x[k][r] = mean[r] + sigma * sum;
+            }
+            fitness[k] = evaluateAt(toValues(x[k])).totalError;
+            if (!running)
+                break;
+        }
+        if (!running)
+            break;
+        
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](size_t i, size_t j) { return fitness[i] < fitness[j]; });
+        if (fitness[order.front()] < bestCost)
+        {
+            bestCost = fitness[order.front()];
+            for (size_t d = 0; d < n; ++d)
+                bestPoint[d] = juce::jlimit(0.0, 1.0, x[order.front()][d]);
+        }
+        
+        // Recombination
+        std::fill(yw.begin(), yw.end(), 0.0);
+        for (size_t i = 0; i < mu; ++i)
+            for (size_t d = 0; d < n; ++d)
+                yw[d] += weights[i] * y[order[i]][d];
+        for (size_t d = 0; d < n; ++d)
+            mean[d] += sigma * yw[d];
+        
+        // Evolution paths; C^-1/2 yw = B D^-1 B^T yw
+        for (size_t r = 0; r < n; ++r)
+        {
+            double sum = 0.0;
+            for (size_t c = 0; c < n; ++c)
+                sum += B[c][r] * yw[c];
+            z[r] = sum / D[r];
+        }
+        for (size_t r = 0; r < n; ++r)
+        {
+            double sum = 0.0;
+            for (size_t c = 0; c < n; ++c)
+                sum += B[r][c] * z[c];
+            invSqrtY[r] = sum;
+        }
+        double pSigmaNorm = 0.0;
+        for (size_t d = 0; d < n; ++d)
+        {
+            pSigma[d] = (1.0 - cSigma) * pSigma[d] + std::sqrt(cSigma * (2.0 - cSigma) * muEff) * invSqrtY[d];
+            pSigmaNorm += pSigma[d] * pSigma[d];
+        }
+        pSigmaNorm = std::sqrt(pSigmaNorm);
+        const double generations = (double) currentIteration;
+        const bool hSigma = pSigmaNorm / std::sqrt(1.0 - std::pow(1.0 - cSigma, 2.0 * generations))
+                            < (1.4 + 2.0 / (dn + 1.0)) * chiN;
+        for (size_t d = 0; d < n; ++d)
+            pc[d] = (1.0 - cc) * pc[d] + (hSigma ? std::sqrt(cc * (2.0 - cc) * muEff) * yw[d] : 0.0);
+        
+        // Covariance: rank-one plus rank-mu update
+        const double lost = hSigma ? 0.0 : cc * (2.0 - cc);
+        for (size_t r = 0; r < n; ++r)
+        {
+            for (size_t c = 0; c < n; ++c)
+            {
+                double rankMu = 0.0;
+                for (size_t i = 0; i < mu; ++i)
+                    rankMu += weights[i] * y[order[i]][r] * y[order[i]][c];
+                C[r][c] = (1.0 - c1 - cMu) * C[r][c] + c1 * (pc[r] * pc[c] + lost * C[r][c]) + cMu * rankMu;
+            }
+        }
+        
+        sigma *= std::exp((cSigma / dSigma) * (pSigmaNorm / chiN - 1.0));
+        
+        latestMetrics = evaluateAt(toValues(bestPoint));
+        
+        // Converged when a generation is flat or the search has shrunk below the cache grid
+        const double spread = fitness[order.back()] - fitness[order.front()];
+        const double extent = sigma * *std::max_element(D.begin(), D.end());
+        if (spread < settings.convergenceThreshold || extent < std::max(1e-6, (double) settings.cacheResolution))
+        {
+            converged = true;
+            break;
+        }
+        
+        reportProgress();
+    }
+    
+    // Leave the plugins at the best point seen
+    const auto bestValues = toValues(bestPoint);
+    applyValues(bestValues);
+    latestMetrics = evaluateAt(bestValues);
+    return converged;
+}
+
+bool AutomatedCalibrator::runGridSearch()
+{
+    // Every combination of gridSteps values per enabled parameter, ends included
+    const auto dims = enabledParameters();
+    const auto base = currentValues();
+    const size_t steps = (size_t) juce::jmax(2, settings.gridSteps);
+    size_t total = 1;
+    for (size_t d = 0; d < dims.size(); ++d)
+        total *= steps;
+    
+    auto pointAt = [&](size_t index) {
+        auto values = base;
+        for (size_t d = 0; d < dims.size(); ++d, index /= steps)
+        {
+            const auto& p = parameters[dims[d]];
+            const float u = (float) (index % steps) / (float) (steps - 1);
+            values[dims[d]] = p.minValue + u * (p.maxValue - p.minValue);
+        }
+        return values;
+    };
+    
+    // One batch per iteration, as large as the renderer takes
+    size_t batchSize = 1;
+    if (batchTarget)
+        batchSize = (size_t) juce::jmax(1, batchTarget->getMaxBatchSize());
+    else if (!workers.empty())
+        batchSize = workers.size();
+    
+    auto bestValues = base;
+    float bestError = std::numeric_limits<float>::max();
+    size_t next = 0;
+    for (currentIteration = 0; next < total && running; ++currentIteration)
+    {
+        std::vector<std::vector<float>> points;
+        for (; next < total && points.size() < batchSize; ++next)
+            points.push_back(pointAt(next));
+        
+        const auto metrics = evaluateBatch(points);
+        for (size_t k = 0; k < points.size(); ++k)
+        {
+            if (metrics[k].totalError < bestError)
+            {
+                bestError = metrics[k].totalError;
+                bestValues = points[k];
+                latestMetrics = metrics[k];
+            }
+        }
+        reportProgress();
+    }
+    
+    // Leave the plugins at the best point seen
+    applyValues(bestValues);
+    latestMetrics = evaluateAt(bestValues);
+    return next == total;
+}
+
+void AutomatedCalibrator::reportProgress()
+{
+    // Log progress
+    if (currentIteration % 10 == 0 || currentIteration == 1)
+    {
+        LOG("Iteration " + juce::String(currentIteration) + ": " + latestMetrics.toString());
+        
+        // Log parameter values
+        juce::String paramStr = "  Params: ";
+        for (const auto& p : parameters)
+            paramStr += p.name + "=" + juce::String(p.currentValue, 3) + " ";
+        LOG(paramStr);
+    }
+    
+    if (onProgressUpdate)
+        onProgressUpdate(currentIteration, latestMetrics);
+}
+
+std::vector<float> AutomatedCalibrator::currentValues() const
+{
+    std::vector<float> values(parameters.size());
+    for (size_t i = 0; i < parameters.size(); ++i)
+        values[i] = parameters[i].currentValue;
+    return values;
+}
+
+void AutomatedCalibrator::applyValues(const std::vector<float>& values)
+{
+    for (size_t i = 0; i < parameters.size() && i < values.size(); ++i)
+        parameters[i].currentValue = juce::jlimit(parameters[i].minValue, parameters[i].maxValue, values[i]);
     applyParametersToTarget();
+}
+
+AutomatedCalibrator::ComparisonMetrics AutomatedCalibrator::evaluateAt(const std::vector<float>& values)
+{
+    std::vector<long long> key;
+    const bool cached = settings.cacheResolution > 0.0f;
+    if (cached)
+    {
+        key = cacheKey(values);
+        auto hit = evaluationCache.find(key);
+        if (hit != evaluationCache.end())
+        {
+            ++cacheHits;
+            return hit->second;
+        }
+    }
     
-    targetOutput.makeCopyOf(testSignal);
-    if (targetProcessor)
-        targetProcessor->processBlock(targetOutput);
+    // Render the target at values against the current reference render;
+    // parameters[] is left alone, so the caller decides where the search is
+    auto* target = activeTarget ? activeTarget : targetProcessor;
+    for (size_t i = 0; i < parameters.size(); ++i)
+        if (parameters[i].enabled)
+            setTargetParameter(*target, i, values[i]);
     
-    auto metricsPlus = calculateMetrics(referenceOutput, targetOutput);
+    targetOutput.makeCopyOf(testSignal, true);
+    render(*target, targetOutput);
+    auto metrics = calculateMetrics(referenceOutput, targetOutput);
     
-    // Compute numerical gradient
-    gradient = (metricsPlus.totalError - errorCurrent) / stepSize;
+    ++evaluationCount;
+    if (cached)
+        evaluationCache.emplace(std::move(key), metrics);
+    return metrics;
+}
+
+std::vector<AutomatedCalibrator::ComparisonMetrics> AutomatedCalibrator::evaluateBatch(
+    const std::vector<std::vector<float>>& points)
+{
+    std::vector<ComparisonMetrics> metrics(points.size());
+    
+    // No batch renderer or workers: one full evaluation per point
+    if (!batchTarget && workers.empty())
+    {
+        for (size_t k = 0; k < points.size(); ++k)
+            metrics[k] = evaluateAt(points[k]);
+        return metrics;
+    }
+    
+    // Cached points are skipped; the rest are scored against the run's reference render
+    const bool cached = settings.cacheResolution > 0.0f;
+    std::vector<std::vector<long long>> keys(points.size());
+    std::vector<size_t> pending;
+    for (size_t k = 0; k < points.size(); ++k)
+    {
+        if (cached)
+        {
+            keys[k] = cacheKey(points[k]);
+            auto hit = evaluationCache.find(keys[k]);
+            if (hit != evaluationCache.end())
+            {
+                ++cacheHits;
+                metrics[k] = hit->second;
+                continue;
+            }
+        }
+        pending.push_back(k);
+    }
+    if (pending.empty())
+        return metrics;
+    
+    if (batchTarget)
+    {
+        // One pass over the input for the whole batch
+        std::vector<std::vector<float>> batch;
+        for (size_t k : pending)
+            batch.push_back(points[k]);
+        batchOutputs.resize(batch.size());
+        for (auto& output : batchOutputs)
+            output.setSize(testSignal.getNumChannels(), testSignal.getNumSamples(), false, false, true);
+        batchTarget->process(testSignal, batch, batchOutputs);
+        
+        for (size_t j = 0; j < pending.size(); ++j)
+            metrics[pending[j]] = calculateMetrics(referenceOutput, batchOutputs[j]);
+    }
+    else
+    {
+        // One target clone per point, concurrently
+        std::atomic<size_t> next{0};
+        auto work = [&](GradientWorker& worker) {
+            for (size_t j = next++; j < pending.size(); j = next++)
+            {
+                const auto& point = points[pending[j]];
+                for (size_t i = 0; i < parameters.size(); ++i)
+                    if (parameters[i].enabled)
+                        setTargetParameter(*worker.processor, i, point[i]);
+                
+                worker.output.makeCopyOf(testSignal, true);
+                worker.renderer.render(*worker.processor, worker.output);
+                metrics[pending[j]] = calculateMetrics(referenceOutput, worker.output, worker.spectralLoss);
+            }
+        };
+        
+        const size_t numThreads = std::min(workers.size(), pending.size());
+        std::vector<std::thread> pool;
+        for (size_t t = 1; t < numThreads; ++t)
+            pool.emplace_back(work, std::ref(*workers[t]));
+        work(*workers[0]);
+        for (auto& thread : pool)
+            thread.join();
+    }
+    
+    evaluationCount += (int) pending.size();
+    if (cached)
+        for (size_t k : pending)
+            evaluationCache.emplace(keys[k], metrics[k]);
+    return metrics;
+}
+
+std::vector<long long> AutomatedCalibrator::cacheKey(const std::vector<float>& values) const
+{
+    // Each value's cell on a grid of cacheResolution x its range
+    std::vector<long long> key(parameters.size());
+    for (size_t i = 0; i < parameters.size(); ++i)
+    {
+        const auto& p = parameters[i];
+        const float range = p.maxValue - p.minValue;
+        const float u = range > 0.0f ? (values[i] - p.minValue) / range : 0.0f;
+        key[i] = std::llround(u / settings.cacheResolution);
+    }
+    return key;
+}
+
+std::vector<size_t> AutomatedCalibrator::enabledParameters() const
+{
+    std::vector<size_t> dims;
+    for (size_t i = 0; i < parameters.size(); ++i)
+        if (parameters[i].enabled && parameters[i].maxValue > parameters[i].minValue)
+            dims.push_back(i);
+    return dims;
+}
+
+void AutomatedCalibrator::buildWorkerPool()
+{
+    workers.clear();
+    if (!targetFactory || maxWorkers <= 1)
+        return;
+    
+    for (int w = 0; w < maxWorkers; ++w)
+    {
+        auto processor = targetFactory();
+        if (!processor || !processor->isLoaded())
+            break;
+        
+        auto worker = std::make_unique<GradientWorker>();
+        copyParameters(*targetProcessor, *processor);
+        worker->processor = std::move(processor);
+        worker->renderer.prepare(*worker->processor);
+        worker->output.setSize(2, settings.testDurationSamples);
+        worker->spectralLoss.prepare(settings.testDurationSamples);
+        workers.push_back(std::move(worker));
+    }
+    
+    LOG("Calibrator: " + juce::String((int) workers.size()) + " gradient workers");
+}
+
+void AutomatedCalibrator::prepareInstances()
+{
+    activeReference = referenceProcessor;
+    activeTarget = targetProcessor;
+    if (!referenceFactory || !targetFactory)
+        return;
+    
+    offlineReference = referenceFactory();
+    offlineTarget = targetFactory();
+    if (!offlineReference || !offlineReference->isLoaded() || !offlineTarget || !offlineTarget->isLoaded())
+    {
+        LOG("Calibrator: Could not create offline instances - rendering through the live processors");
+        releaseInstances();
+        return;
+    }
+    
+    copyParameters(*referenceProcessor, *offlineReference);
+    copyParameters(*targetProcessor, *offlineTarget);
+    renderer.prepare(*offlineReference);
+    renderer.prepare(*offlineTarget);
+    activeReference = offlineReference.get();
+    activeTarget = offlineTarget.get();
+    LOG("Calibrator: Rendering offline in " + juce::String(renderer.getBlockSize()) + " sample blocks");
+}
+
+void AutomatedCalibrator::releaseInstances()
+{
+    workers.clear();
+    batchTarget.reset();
+    batchOutputs.clear();
+    offlineReference.reset();
+    offlineTarget.reset();
+    activeReference = referenceProcessor;
+    activeTarget = targetProcessor;
+}
+
+void AutomatedCalibrator::render(IAudioProcessor& processor, juce::AudioBuffer<float>& buffer)
+{
+    if (&processor == offlineReference.get() || &processor == offlineTarget.get())
+    {
+        renderer.render(processor, buffer);
+        return;
+    }
     
-    // Restore original value
-    param.currentValue = originalValue;
+    // Live processor: the device may be using it too, so no reset or re-prepare
+    liveMidi.clear();
+    processor.processBlock(buffer, liveMidi);
+}
+
+void AutomatedCalibrator::copyParameters(const IAudioProcessor& from, IAudioProcessor& to)
+{
+    for (const auto& param : from.getParameters())
+        to.setParameter(param.id, param.currentValue);
+}
+
+void AutomatedCalibrator::computeGradientsParallel(std::vector<float>& gradients)
+{
+    // referenceOutput holds this step's reference render. Each point is rendered
+    // from a reset clone, so the base is re-rendered on a worker as well.
+    const size_t numParams = parameters.size();
+    std::vector<float> base(numParams);
+    for (size_t i = 0; i < numParams; ++i)
+        base[i] = parameters[i].currentValue;
+    
+    // Points: FD = base + one forward step per parameter,
+    // SPSA = base +/- step * delta, delta a random +/-1 per parameter
+    const bool spsa = settings.gradientMethod == CalibrationSettings::GradientMethod::SPSA;
+    std::vector<std::vector<float>> points;
+    if (spsa)
+    {
+        points.assign(2, base);
+        for (size_t i = 0; i < numParams; ++i)
+        {
+            const auto& p = parameters[i];
+            if (!p.enabled)
+                continue;
+            const float delta = random.nextBool() ? 1.0f : -1.0f;
+            points[0][i] = juce::jlimit(p.minValue, p.maxValue, base[i] + p.stepSize * delta);
+            points[1][i] = juce::jlimit(p.minValue, p.maxValue, base[i] - p.stepSize * delta);
+        }
+    }
+    else
+    {
+        points.assign(numParams + 1, base);
+        for (size_t i = 0; i < numParams; ++i)
+        {
+            const auto& p = parameters[i];
+            points[i + 1][i] = juce::jlimit(p.minValue, p.maxValue, base[i] + p.stepSize);
+        }
+    }
+    
+    // Workers pull points off a shared index, each rendering on its own clone
+    std::vector<float> errors(points.size(), 0.0f);
+    std::atomic<size_t> next{0};
+    auto work = [&](GradientWorker& worker) {
+        for (size_t j = next++; j < points.size(); j = next++)
+        {
+            if (!spsa && j > 0 && !parameters[j - 1].enabled)
+                continue;
+            
+            for (size_t i = 0; i < numParams; ++i)
+                if (parameters[i].enabled)
+                    setTargetParameter(*worker.processor, i, points[j][i]);
+            
+            worker.output.makeCopyOf(testSignal, true);
+            worker.renderer.render(*worker.processor, worker.output);
+            errors[j] = calculateMetrics(referenceOutput, worker.output, worker.spectralLoss).totalError;
+        }
+    };
+    
+    const size_t numThreads = std::min(workers.size(), points.size());
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t < numThreads; ++t)
+        pool.emplace_back(work, std::ref(*workers[t]));
+    work(*workers[0]);
+    for (auto& thread : pool)
+        thread.join();
+    
+    for (size_t i = 0; i < numParams; ++i)
+    {
+        if (!parameters[i].enabled)
+            continue;
+        
+        const float span = spsa ? points[0][i] - points[1][i] : points[i + 1][i] - base[i];
+        const float difference = spsa ? errors[0] - errors[1] : errors[i + 1] - errors[0];
+        gradients[i] = span != 0.0f ? difference / span : 0.0f;
+    }
 }
 
 void AutomatedCalibrator::updateParameters(const std::vector<float>& gradients)
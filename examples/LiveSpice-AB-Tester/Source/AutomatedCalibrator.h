@@ -3,7 +3,8 @@
     Automated Calibrator - Parameter optimization via comparison
     
     Automatically adjusts digital pedal parameters to match LiveSpice simulation
-    using gradient descent and waveform comparison metrics.
+    using gradient descent, Nelder-Mead, CMA-ES or an exhaustive grid sweep
+    on waveform comparison metrics, with evaluated points memoized.
   ==============================================================================
 */
 
@@ -13,8 +14,12 @@
 #include <juce_dsp/juce_dsp.h>
 #include <vector>
 #include <functional>
+#include <map>
+#include <memory>
 #include "IAudioProcessor.h"
 #include "Logging.h"
+#include "SpectralLoss.h"
+#include "OfflineRenderer.h"
 
 class AutomatedCalibrator
 {
@@ -31,7 +36,7 @@ public:
         float rmsError = 0.0f;          // Root mean square error
         float correlation = 0.0f;        // Pearson correlation coefficient
         float peakError = 0.0f;          // Maximum absolute difference
-        float spectralError = 0.0f;      // Frequency domain error
+        float spectralError = 0.0f;      // Multi-resolution STFT loss (see SpectralLoss)
         float totalError = 0.0f;         // Combined weighted error metric
         
         juce::String toString() const
@@ -74,6 +79,25 @@ public:
         float testAmplitude = 0.5f;      // 0.0 - 1.0
         int testDurationSamples = 8192;  // Length of test signal
         
+        // Gradient estimate per step (parallel when a target factory is set):
+        // FiniteDifference renders N + 1 points, SPSA 2 whatever N is
+        enum class GradientMethod { FiniteDifference, SPSA };
+        GradientMethod gradientMethod = GradientMethod::FiniteDifference;
+        
+        // Search strategy. The derivative-free ones need far fewer renders
+        // than finite differences and cope with noisy, non-smooth losses:
+        // NelderMead ~1-2 renders per iteration, CMAES one generation of
+        // 4 + 3 ln N renders per iteration. GridSearch scores every point
+        // of a gridSteps^N grid against one reference render, in batches
+        // (see BatchTarget).
+        enum class Optimizer { GradientDescent, NelderMead, CMAES, GridSearch };
+        Optimizer optimizer = Optimizer::GradientDescent;
+        int gridSteps = 5;               // Values per enabled parameter, ends included
+        
+        // Evaluation cache grid, as a fraction of each parameter's range:
+        // points that round to the same cell reuse one render (0 = no cache)
+        float cacheResolution = 1e-3f;
+        
         // Metric weights (sum should = 1.0)
         float rmsWeight = 0.5f;
         float correlationWeight = 0.3f;
@@ -89,6 +113,46 @@ public:
      */
     void setProcessors(IAudioProcessor* reference, IAudioProcessor* target);
     
+    /**
+     * Render offline: with a reference factory (and a target factory, see
+     * below), each run creates private reference and target instances,
+     * copies the live processors' parameter values into them and renders
+     * through OfflineRenderer in large non-real-time blocks, away from the
+     * audio device. The reference is then rendered once per run rather
+     * than once per step. The result is applied to the live target at the end.
+     */
+    void setReferenceFactory(std::function<std::unique_ptr<IAudioProcessor>()> factory);
+    
+    /**
+     * Evaluate gradients on a pool of target clones, one per worker thread.
+     * The factory must return a fresh, independent instance of the target
+     * (e.g. ProcessorFactory::create on the same path) or nullptr; the pool
+     * is built at the start of each run. numWorkers <= 1 disables the pool.
+     */
+    void setTargetFactory(std::function<std::unique_ptr<IAudioProcessor>()> factory, int numWorkers);
+    
+    /**
+     * Renders one input at many parameter vectors in a single pass: an
+     * in-process model can run the vectors as SIMD lanes or
+     * structure-of-arrays instances over the same buffer instead of one
+     * full render each. Vectors follow getParameters() order.
+     */
+    struct BatchTarget
+    {
+        virtual ~BatchTarget() = default;
+        virtual int getMaxBatchSize() const = 0;
+        virtual void process(const juce::AudioBuffer<float>& input,
+                             const std::vector<std::vector<float>>& points,
+                             std::vector<juce::AudioBuffer<float>>& outputs) = 0;
+    };
+    
+    /**
+     * Batch renderer for grid sweeps, created at the start of each
+     * GridSearch run. Without one, batches go to the target clones (see
+     * setTargetFactory) or are rendered one point at a time.
+     */
+    void setBatchTargetFactory(std::function<std::unique_ptr<BatchTarget>()> factory);
+    
     /**
      * Add a parameter to optimize
      */
@@ -136,6 +200,12 @@ public:
      */
     ComparisonMetrics getLatestMetrics() const { return latestMetrics; }
     
+    /**
+     * Renders made and cache hits in the last run
+     */
+    int getEvaluationCount() const { return evaluationCount; }
+    int getCacheHits() const { return cacheHits; }
+    
     /**
      * Get calibration progress (0.0 - 1.0)
      */
@@ -168,6 +238,9 @@ private:
     
     ComparisonMetrics calculateMetrics(const juce::AudioBuffer<float>& reference,
                                        const juce::AudioBuffer<float>& target);
+    ComparisonMetrics calculateMetrics(const juce::AudioBuffer<float>& reference,
+                                       const juce::AudioBuffer<float>& target,
+                                       SpectralLoss& loss);
     
     float calculateRMSError(const juce::AudioBuffer<float>& a,
                            const juce::AudioBuffer<float>& b);
@@ -179,12 +252,40 @@ private:
                             const juce::AudioBuffer<float>& b);
     
     float calculateSpectralError(const juce::AudioBuffer<float>& a,
-                                const juce::AudioBuffer<float>& b);
+                                const juce::AudioBuffer<float>& b,
+                                SpectralLoss& loss);
     
     void computeGradient(int paramIndex, float& gradient);
+    void computeGradientsParallel(std::vector<float>& gradients);
+    void buildWorkerPool();
+    
+    // Offline instances (see setReferenceFactory)
+    void prepareInstances();
+    void releaseInstances();
+    void render(IAudioProcessor& processor, juce::AudioBuffer<float>& buffer);
+    static void copyParameters(const IAudioProcessor& from, IAudioProcessor& to);
+    
+    // Target parameter indices, resolved once per run (see IAudioProcessor::getParameterIndex)
+    void resolveParameterIndices(const IAudioProcessor& target);
+    void setTargetParameter(IAudioProcessor& target, size_t index, float value);
     
     void updateParameters(const std::vector<float>& gradients);
     
+    // Optimizers (see CalibrationSettings::Optimizer); true when converged
+    bool runGradientDescent();
+    bool runNelderMead();
+    bool runCMAES();
+    bool runGridSearch();
+    void reportProgress();
+    
+    // Evaluation at a full parameter vector, through the cache
+    std::vector<float> currentValues() const;
+    void applyValues(const std::vector<float>& values);
+    ComparisonMetrics evaluateAt(const std::vector<float>& values);
+    std::vector<ComparisonMetrics> evaluateBatch(const std::vector<std::vector<float>>& points);
+    std::vector<long long> cacheKey(const std::vector<float>& values) const;
+    std::vector<size_t> enabledParameters() const;
+    
     // ========================================================================
     // Member Variables
     // ========================================================================
@@ -192,6 +293,16 @@ private:
     IAudioProcessor* referenceProcessor = nullptr;
     IAudioProcessor* targetProcessor = nullptr;
     
+    // What a run renders through: private offline instances, or the live processors
+    std::function<std::unique_ptr<IAudioProcessor>()> referenceFactory;
+    std::unique_ptr<IAudioProcessor> offlineReference;
+    std::unique_ptr<IAudioProcessor> offlineTarget;
+    IAudioProcessor* activeReference = nullptr;
+    IAudioProcessor* activeTarget = nullptr;
+    OfflineRenderer renderer;
+    juce::MidiBuffer liveMidi;
+    std::vector<int> parameterIndices;   // Per entry of parameters, -1 = set by name
+    
     std::vector<ParameterConfig> parameters;
     CalibrationSettings settings;
     ComparisonMetrics latestMetrics;
@@ -200,14 +311,36 @@ private:
     int currentIteration = 0;
     float previousError = std::numeric_limits<float>::max();
     
+    // Quantized parameter vector -> metrics (see cacheResolution)
+    std::map<std::vector<long long>, ComparisonMetrics> evaluationCache;
+    int evaluationCount = 0;
+    int cacheHits = 0;
+    
     // Buffers for processing
     juce::AudioBuffer<float> testSignal;
     juce::AudioBuffer<float> referenceOutput;
     juce::AudioBuffer<float> targetOutput;
     
-    // FFT for spectral analysis
-    juce::dsp::FFT fft{11};  // 2048 points
-    std::vector<float> fftData;
+    // Spectral analysis: FFT plans, windows and reference spectra, reused across evaluations
+    SpectralLoss spectralLoss{44100.0};
+    
+    // Parallel gradient workers: a target clone with its own buffers and loss
+    struct GradientWorker
+    {
+        std::unique_ptr<IAudioProcessor> processor;
+        juce::AudioBuffer<float> output;
+        OfflineRenderer renderer;
+        SpectralLoss spectralLoss{44100.0};
+    };
+    std::function<std::unique_ptr<IAudioProcessor>()> targetFactory;
+    int maxWorkers = 0;
+    std::vector<std::unique_ptr<GradientWorker>> workers;
+    
+    // Grid sweep renderer and its per-point output buffers
+    std::function<std::unique_ptr<BatchTarget>()> batchTargetFactory;
+    std::unique_ptr<BatchTarget> batchTarget;
+    std::vector<juce::AudioBuffer<float>> batchOutputs;
+    juce::Random random;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AutomatedCalibrator)
 };
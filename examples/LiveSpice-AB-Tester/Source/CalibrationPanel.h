@@ -85,6 +85,10 @@ public:
     {
         stopTimer();
         startStopButton.removeListener(this);
+        
+        // The run holds a reference to the calibrator: finish it before going away
+        calibrator.stop();
+        runner.stopThread(10000);
     }
     
     void paint(juce::Graphics& g) override
@@ -173,11 +177,8 @@ private:
         startStopButton.setButtonText("Stop Calibration");
         progressLabel.setText("Starting...", juce::dontSendNotification);
         
-        std::thread([this]()
-        {
-            bool success = calibrator.runCalibration();
-            juce::ignoreUnused(success);
-        }).detach();
+        runner.stopThread(10000);   // A previous run that is still winding down
+        runner.startThread();
     }
     
     void updateProgress(int iteration, const AutomatedCalibrator::ComparisonMetrics& metrics)
@@ -205,18 +206,24 @@ private:
         parameterValuesLabel.setText(paramText, juce::dontSendNotification);
     }
     
+    juce::String renderSummary() const
+    {
+        return " (" + juce::String(calibrator.getEvaluationCount()) + " renders, "
+             + juce::String(calibrator.getCacheHits()) + " cached)";
+    }
+    
     void onCalibrationFinished(bool success, const AutomatedCalibrator::ComparisonMetrics& metrics)
     {
         startStopButton.setButtonText("Start Calibration");
         
         if (success)
         {
-            progressLabel.setText("Converged!", juce::dontSendNotification);
+            progressLabel.setText("Converged!" + renderSummary(), juce::dontSendNotification);
             LOG("Calibration completed successfully!");
         }
         else
         {
-            progressLabel.setText("Max iterations reached", juce::dontSendNotification);
+            progressLabel.setText("Max iterations reached" + renderSummary(), juce::dontSendNotification);
             LOG("Calibration stopped at max iterations");
         }
         
@@ -224,7 +231,18 @@ private:
         updateParameterDisplay();
     }
     
+    // Runs the calibration off the message thread; owned so it can be joined
+    class Runner : public juce::Thread
+    {
+    public:
+        explicit Runner(AutomatedCalibrator& c) : juce::Thread("Calibration"), calibrator(c) {}
+        void run() override { calibrator.runCalibration(); }
+    private:
+        AutomatedCalibrator& calibrator;
+    };
+    
     AutomatedCalibrator& calibrator;
+    Runner runner{calibrator};
     
     juce::TextButton startStopButton;
     juce::Label progressLabel;
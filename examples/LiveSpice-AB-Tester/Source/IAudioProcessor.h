@@ -41,6 +41,30 @@ public:
     virtual bool setParameter(const juce::String& parameterId, float value) = 0;
     virtual float getParameter(const juce::String& parameterId) const = 0;
 
+    // Indexed access for hot paths (calibrator, synchronizer): resolve an id
+    // once with getParameterIndex (-1 if unknown), then use the index. Indices
+    // stay valid until the processor reloads. The defaults go through the ids.
+    virtual int getParameterIndex(const juce::String& parameterId) const
+    {
+        auto params = getParameters();
+        for (size_t i = 0; i < params.size(); ++i)
+            if (params[i].id.equalsIgnoreCase(parameterId))
+                return (int) i;
+        return -1;
+    }
+
+    virtual bool setParameterByIndex(int index, float value)
+    {
+        auto params = getParameters();
+        return index >= 0 && index < (int) params.size() && setParameter(params[(size_t) index].id, value);
+    }
+
+    virtual float getParameterByIndex(int index) const
+    {
+        auto params = getParameters();
+        return index >= 0 && index < (int) params.size() ? params[(size_t) index].currentValue : 0.0f;
+    }
+
     // Metadata
     virtual juce::String getName() const = 0;
     virtual juce::String getType() const = 0;  // Returns "VST3" or "Native DSP"
@@ -48,4 +72,10 @@ public:
 
     // State Management
     virtual void reset() = 0;  // Reset to initial state (clear buffers, etc.)
+
+    // Offline rendering hint: processors may trade speed for quality (default: ignored)
+    virtual void setNonRealtime(bool isNonRealtime) { juce::ignoreUnused(isNonRealtime); }
+
+    // Processing delay the processor reports, in samples (may change after prepareToPlay)
+    virtual int getLatencySamples() const { return 0; }
 };
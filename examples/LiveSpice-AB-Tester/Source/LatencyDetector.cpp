@@ -0,0 +1,93 @@
+#include "LatencyDetector.h"
+#include <cmath>
+
+namespace
+{
+    constexpr double chirpStartHz = 20.0;
+    constexpr double chirpEndHz = 20000.0;
+    constexpr float chirpLevel = 0.25f;     // Keeps most drive settings near their linear range
+    constexpr int fadeSamples = 256;        // Raised-cosine edges, no onset click
+    constexpr float minimumPeakRatio = 4.0f;  // Peak over mean magnitude within the search window
+}
+
+LatencyDetector::LatencyDetector(double rate)
+    : sampleRate(rate), renderer(rate, 4096)
+{
+    // Exponential sweep over the first signalLength - maxLag samples
+    const int sweepLength = signalLength - maxLag;
+    const double endHz = juce::jmin(chirpEndHz, 0.45 * sampleRate);
+    const double duration = sweepLength / sampleRate;
+    const double k = std::log(endHz / chirpStartHz);
+
+    chirp.setSize(2, signalLength);
+    chirp.clear();
+    auto* data = chirp.getWritePointer(0);
+    for (int n = 0; n < sweepLength; ++n)
+    {
+        const double t = n / sampleRate;
+        const double phase = juce::MathConstants<double>::twoPi * chirpStartHz * duration / k
+                             * (std::exp(t / duration * k) - 1.0);
+        const int edge = juce::jmin(n, sweepLength - 1 - n);
+        const float window = edge < fadeSamples
+            ? 0.5f - 0.5f * std::cos(juce::MathConstants<float>::pi * (float) edge / (float) fadeSamples)
+            : 1.0f;
+        data[n] = chirpLevel * window * (float) std::sin(phase);
+    }
+    chirp.copyFrom(1, 0, chirp, 0, 0, signalLength);
+
+    spectrumA.assign((size_t) (2 << fftOrder), 0.0f);
+    spectrumB.assign((size_t) (2 << fftOrder), 0.0f);
+}
+
+void LatencyDetector::render(IAudioProcessor& processor, juce::AudioBuffer<float>& output, std::vector<float>& spectrum)
+{
+    output.makeCopyOf(chirp);
+    renderer.prepare(processor);
+    renderer.render(processor, output);
+
+    std::fill(spectrum.begin(), spectrum.end(), 0.0f);
+    std::copy(output.getReadPointer(0), output.getReadPointer(0) + signalLength, spectrum.begin());
+    fft.performRealOnlyForwardTransform(spectrum.data());
+}
+
+std::optional<int> LatencyDetector::measure(IAudioProcessor& a, IAudioProcessor& b)
+{
+    juce::AudioBuffer<float> outputA, outputB;
+    render(a, outputA, spectrumA);
+    render(b, outputB, spectrumB);
+
+    if (outputA.getMagnitude(0, 0, signalLength) < 1.0e-6f || outputB.getMagnitude(0, 0, signalLength) < 1.0e-6f)
+        return std::nullopt;
+
+    // Cross-spectrum conj(A) * B: its inverse peaks at the lag of b behind a
+    const int size = fft.getSize();
+    for (int k = 0; k < size; ++k)
+    {
+        const float ar = spectrumA[(size_t) (2 * k)], ai = spectrumA[(size_t) (2 * k + 1)];
+        const float br = spectrumB[(size_t) (2 * k)], bi = spectrumB[(size_t) (2 * k + 1)];
+        spectrumB[(size_t) (2 * k)] = ar * br + ai * bi;
+        spectrumB[(size_t) (2 * k + 1)] = ar * bi - ai * br;
+    }
+    fft.performRealOnlyInverseTransform(spectrumB.data());
+
+    // Negative lags wrap to the end of the buffer
+    int bestLag = 0;
+    float bestMagnitude = 0.0f;
+    double sum = 0.0;
+    for (int lag = -maxLag; lag <= maxLag; ++lag)
+    {
+        const float magnitude = std::abs(spectrumB[(size_t) ((lag + size) % size)]);
+        sum += magnitude;
+        if (magnitude > bestMagnitude)
+        {
+            bestMagnitude = magnitude;
+            bestLag = lag;
+        }
+    }
+
+    const double mean = sum / (2 * maxLag + 1);
+    if (mean <= 0.0 || bestMagnitude < minimumPeakRatio * mean)
+        return std::nullopt;
+
+    return bestLag;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "IAudioProcessor.h"
+#include "OfflineRenderer.h"
+#include <juce_dsp/juce_dsp.h>
+#include <optional>
+#include <vector>
+
+/**
+ * LatencyDetector - Measures how far one processor's output trails another's
+ *
+ * Responsibilities:
+ * - Renders the same logarithmic chirp through both processors offline
+ * - Cross-correlates the two outputs (one FFT each, product, one inverse)
+ *   and takes the lag of the largest magnitude within +/-maxLag
+ *
+ * Only the difference between the paths is measured, so delay the two share
+ * (the circuit's own group delay) cancels. The magnitude is used so an
+ * inverting path still lines up at its true lag. A peak that does not
+ * stand clear of the rest of the correlation (silence, unrelated outputs)
+ * gives no result rather than a guess.
+ *
+ * Renders through the processors it is given: pass private instances, not
+ * the ones the audio device is playing. Not real-time safe.
+ */
+class LatencyDetector
+{
+public:
+    static constexpr int maxLag = 8192;
+
+    explicit LatencyDetector(double sampleRate = 44100.0);
+
+    // Samples by which b's output trails a's (negative: a trails b)
+    std::optional<int> measure(IAudioProcessor& a, IAudioProcessor& b);
+
+private:
+    static constexpr int fftOrder = 16;          // 65536 >= signal + maxLag, so no wrap-around
+    static constexpr int signalLength = 32768;   // Chirp followed by maxLag samples of silence
+
+    double sampleRate;
+    OfflineRenderer renderer;
+    juce::dsp::FFT fft{fftOrder};
+    juce::AudioBuffer<float> chirp;
+    std::vector<float> spectrumA;
+    std::vector<float> spectrumB;
+
+    void render(IAudioProcessor& processor, juce::AudioBuffer<float>& output, std::vector<float>& spectrum);
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LatencyDetector)
+};
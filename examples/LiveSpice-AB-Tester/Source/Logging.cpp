@@ -0,0 +1,230 @@
+#include "Logging.h"
+#include <array>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    struct Record
+    {
+        juce::int64 timeMs;
+        LogLevel level;
+        char text[Logging::maxMessageLength + 1];
+    };
+
+    /**
+     * Bounded multi-producer ring (per-slot sequence numbers): producers
+     * claim a slot with one compare-exchange, the single consumer is the
+     * writer thread.
+     */
+    class RecordQueue
+    {
+    public:
+        RecordQueue()
+        {
+            for (size_t i = 0; i < slots.size(); ++i)
+                slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        // Claim a slot; nullptr when full. Fill it, then publish()
+        Record* claim(size_t& position) noexcept
+        {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                auto& slot = slots[position & mask];
+                const auto sequence = slot.sequence.load(std::memory_order_acquire);
+                const auto difference = (std::ptrdiff_t) sequence - (std::ptrdiff_t) position;
+                if (difference == 0)
+                {
+                    if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                        return &slot.record;
+                }
+                else if (difference < 0)
+                {
+                    return nullptr;
+                }
+                else
+                {
+                    position = enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        void publish(size_t position) noexcept
+        {
+            slots[position & mask].sequence.store(position + 1, std::memory_order_release);
+        }
+
+        // Consumer side
+        bool pop(Record& record) noexcept
+        {
+            auto& slot = slots[dequeuePosition & mask];
+            if (slot.sequence.load(std::memory_order_acquire) != dequeuePosition + 1)
+                return false;
+
+            record = slot.record;
+            slot.sequence.store(dequeuePosition + slots.size(), std::memory_order_release);
+            ++dequeuePosition;
+            return true;
+        }
+
+    private:
+        static constexpr size_t mask = Logging::queueSize - 1;
+        static_assert((Logging::queueSize & mask) == 0, "queueSize must be a power of two");
+
+        struct Slot
+        {
+            std::atomic<size_t> sequence{0};
+            Record record;
+        };
+
+        std::array<Slot, Logging::queueSize> slots;
+        alignas(64) std::atomic<size_t> enqueuePosition{0};
+        alignas(64) size_t dequeuePosition{0};
+    };
+
+    RecordQueue queue;
+    std::atomic<juce::uint32> dropped{0};
+    std::atomic<bool> restartRequested{false};
+
+    const char* levelTag(LogLevel level)
+    {
+        switch (level)
+        {
+            case LogLevel::ERROR:   return "[ERROR]  ";
+            case LogLevel::WARNING: return "[WARN]   ";
+            case LogLevel::INFO:    return "[INFO]   ";
+            case LogLevel::DEBUG:   return "[DEBUG]  ";
+            default:                return "[NONE]   ";
+        }
+    }
+
+    // Drain the ring into the file; writer thread, or the caller of stopWriter()
+    class Drain
+    {
+    public:
+        void run()
+        {
+            if (restartRequested.exchange(false))
+            {
+                stream.reset();
+                g_logFile.deleteFile();
+            }
+
+            Record record;
+            while (queue.pop(record))
+            {
+                const auto line = juce::Time(record.timeMs).formatted("%H:%M:%S.") +
+                                  juce::String(record.timeMs % 1000).paddedLeft('0', 3) + " " +
+                                  levelTag(record.level) + juce::String::fromUTF8(record.text);
+                DBG(line);
+                write(line);
+            }
+
+            if (const auto lost = dropped.exchange(0))
+                write("[WARN]   Log queue full, " + juce::String((int) lost) + " message(s) dropped");
+
+            if (stream)
+                stream->flush();
+        }
+
+    private:
+        std::unique_ptr<juce::FileOutputStream> stream;
+
+        void write(const juce::String& line)
+        {
+            if (!stream)
+            {
+                stream = std::make_unique<juce::FileOutputStream>(g_logFile);
+                if (stream->failedToOpen())
+                {
+                    stream.reset();
+                    return;
+                }
+            }
+            stream->writeText(line + "\n", false, false, nullptr);
+        }
+    };
+
+    Drain drain;
+
+    class Writer : public juce::Thread
+    {
+    public:
+        Writer() : juce::Thread("Log writer") {}
+
+        void run() override
+        {
+            while (!threadShouldExit())
+            {
+                drain.run();
+                wait(50);
+            }
+        }
+    };
+
+    std::unique_ptr<Writer> writer;
+
+    Record* claimRecord(LogLevel level, size_t& position) noexcept
+    {
+        auto* record = queue.claim(position);
+        if (record == nullptr)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        record->timeMs = juce::Time::currentTimeMillis();
+        record->level = level;
+        return record;
+    }
+}
+
+void Logging::push(LogLevel level, const char* text) noexcept
+{
+    size_t position;
+    if (auto* record = claimRecord(level, position))
+    {
+        std::strncpy(record->text, text, maxMessageLength);
+        record->text[maxMessageLength] = '\0';
+        queue.publish(position);
+    }
+}
+
+void Logging::pushFormatted(LogLevel level, const char* format, ...) noexcept
+{
+    size_t position;
+    if (auto* record = claimRecord(level, position))
+    {
+        va_list args;
+        va_start(args, format);
+        std::vsnprintf(record->text, sizeof(record->text), format, args);
+        va_end(args);
+        queue.publish(position);
+    }
+}
+
+void Logging::startWriter()
+{
+    if (writer)
+        return;
+
+    writer = std::make_unique<Writer>();
+    writer->startThread();
+}
+
+void Logging::stopWriter()
+{
+    if (writer)
+    {
+        writer->stopThread(1000);
+        writer.reset();
+    }
+    drain.run();
+}
+
+void Logging::restartFile() noexcept
+{
+    restartRequested.store(true);
+}
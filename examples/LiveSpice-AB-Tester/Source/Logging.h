@@ -1,6 +1,7 @@
 #pragma once
 
 #include <juce_core/juce_core.h>
+#include <atomic>
 
 // ============================================================================
 // Logging System with Levels
@@ -15,33 +16,70 @@ enum class LogLevel
     DEBUG       // All messages
 };
 
-// Global logging configuration
-extern LogLevel g_currentLogLevel;
-extern bool g_loggingEnabled;
+// Most verbose level compiled in (0 = NONE ... 4 = DEBUG); calls above it
+// are removed by the compiler, arguments and all
+#ifndef LIVESPICE_LOG_LEVEL
+ #define LIVESPICE_LOG_LEVEL 4
+#endif
+
+constexpr LogLevel kCompiledLogLevel = static_cast<LogLevel>(LIVESPICE_LOG_LEVEL);
+
+// Global logging configuration (read from any thread, the audio thread included)
+extern std::atomic<LogLevel> g_currentLogLevel;
+extern std::atomic<bool> g_loggingEnabled;
 extern juce::File g_logFile;
 
-inline void logDebug(const juce::String& msg, LogLevel level = LogLevel::DEBUG)
+/**
+ * Logging - Asynchronous log pipeline
+ *
+ * Responsibilities:
+ * - Copies each message into a fixed-size record (timestamp, level, text
+ *   truncated to maxMessageLength) in a preallocated ring
+ * - A background writer drains the ring, formats the timestamp and appends
+ *   to g_logFile and the debugger output
+ *
+ * Real-time safety:
+ * - push() and pushFormatted() never lock, allocate or touch the file; any
+ *   number of threads may push. A full ring drops the record and counts it,
+ *   the writer reports the count
+ * - logDebug() builds its juce::String before pushing, so the audio thread
+ *   uses LOG_RT (printf-style, formatted straight into the record)
+ */
+namespace Logging
 {
-    // Only log if enabled and level is high enough
-    if (!g_loggingEnabled || level > g_currentLogLevel)
-        return;
-    
-    DBG(msg);
-    
-    // Write to file if it exists
-    if (g_logFile.exists() || g_logFile.create())
+    static constexpr int maxMessageLength = 240;
+    static constexpr int queueSize = 1024;   // Records, power of two
+
+    void push(LogLevel level, const char* text) noexcept;
+    void pushFormatted(LogLevel level, const char* format, ...) noexcept;
+
+    // Writer lifetime (message thread); stopWriter() writes what is still queued
+    void startWriter();
+    void stopWriter();
+
+    // Empty g_logFile before the next write (any thread)
+    void restartFile() noexcept;
+
+    inline bool isEnabled(LogLevel level) noexcept
     {
-        auto timestamp = juce::Time::getCurrentTime().formatted("%H:%M:%S.%ms");
-        auto levelStr = [](LogLevel l) -> const char* {
-            switch(l) {
-                case LogLevel::ERROR:   return "[ERROR]  ";
-                case LogLevel::WARNING: return "[WARN]   ";
-                case LogLevel::INFO:    return "[INFO]   ";
-                case LogLevel::DEBUG:   return "[DEBUG]  ";
-                default:                return "[NONE]   ";
-            }
-        }(level);
-        
-        g_logFile.appendText(timestamp + " " + levelStr + msg + "\n");
+        return g_loggingEnabled.load(std::memory_order_relaxed)
+            && level <= g_currentLogLevel.load(std::memory_order_relaxed);
     }
 }
+
+inline void logDebug(const juce::String& msg, LogLevel level = LogLevel::DEBUG)
+{
+    // Only log if compiled in, enabled and level is high enough
+    if (level > kCompiledLogLevel || !Logging::isEnabled(level))
+        return;
+
+    Logging::push(level, msg.toRawUTF8());
+}
+
+// Real-time-safe logging: LOG_RT(LogLevel::DEBUG, "Block of %d samples", numSamples)
+#define LOG_RT(level, ...) \
+    do { \
+        if constexpr ((level) <= kCompiledLogLevel) \
+            if (Logging::isEnabled(level)) \
+                Logging::pushFormatted((level), __VA_ARGS__); \
+    } while (false)
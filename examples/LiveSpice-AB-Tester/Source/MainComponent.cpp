@@ -23,14 +23,18 @@ namespace
 }
 
 // Initialize global logging
-LogLevel g_currentLogLevel = kDebugAudioEnabled ? LogLevel::DEBUG : LogLevel::INFO;
-bool g_loggingEnabled = true;
+std::atomic<LogLevel> g_currentLogLevel{kDebugAudioEnabled ? LogLevel::DEBUG : LogLevel::INFO};
+std::atomic<bool> g_loggingEnabled{true};
 juce::File g_logFile = juce::File::getSpecialLocation(juce::File::tempDirectory).getChildFile("LiveSpice_AB_Tester.log");
 
 MainComponent::MainComponent()
 {
+    Logging::startWriter();
+    
     // Initialize abstraction layer components
     audioRouter = std::make_unique<AudioRouter>();
+    audioRouter->setCrossfadeEnabled(true);   // Click-free A/B switching
+    audioRouter->setParallelProcessing(juce::SystemStats::getNumCpus() > 1);
     paramSync = std::make_unique<ParameterSynchronizer>();
 
     // Initialize control panel (initially hidden, shown when configured)
@@ -41,13 +45,15 @@ MainComponent::MainComponent()
     // Setup parameter change callback via ParameterSynchronizer
     controlPanel->onParameterChanged = [this](const juce::String& paramId, float value) {
         paramSync->setParameter(paramId, value);
-        
-        // Update schematic editor UI if it exists
+    };
+    
+    // Applied values come back once per timer tick: update schematic editor UI if it exists
+    paramSync->onParameterChanged([this](const juce::String& paramId, float value) {
         if (schematicEditor)
         {
             schematicEditor->updateParameterUI(paramId, value);
         }
-    };
+    });
 
     // Initialize A/B switch
     abSwitch = std::make_unique<ABSwitch>();
@@ -67,7 +73,8 @@ MainComponent::MainComponent()
         
         // Load Marshall Blues Breaker schematic to processor A
         logDebug("Starting to load Processor A (Schematic)...", LogLevel::INFO);
-        processorA = ProcessorFactory::create("h:\\Live Spice DSP translation layer\\example pedals\\Marshall Blues Breaker.schx");
+        sourceA = "h:\\Live Spice DSP translation layer\\example pedals\\Marshall Blues Breaker.schx";
+        processorA = ProcessorFactory::create(sourceA);
         isPluginALoaded = (processorA != nullptr && processorA->isLoaded());
         
         if (processorA)
@@ -84,7 +91,8 @@ MainComponent::MainComponent()
         
         // Load Marshall Blues Breaker VST3 (generated) to processor B
         logDebug("Starting to load Processor B (VST3)...", LogLevel::INFO);
-        processorB = ProcessorFactory::createVST3(TEST_PLUGIN_B_PATH);
+        sourceB = TEST_PLUGIN_B_PATH;
+        processorB = ProcessorFactory::createVST3(sourceB);
         isPluginBLoaded = (processorB != nullptr && processorB->isLoaded());
         
         if (processorB)
@@ -134,8 +142,7 @@ MainComponent::MainComponent()
                         editorComponent->onParameterChanged = [this](const juce::String& paramId, float value) {
                             if (processorA)
                             {
-                                processorA->setParameter(paramId, value);
-                                // Also sync to processor B via parameter synchronizer
+                                // Applied to processor A on the audio thread via parameter synchronizer
                                 paramSync->setParameter(paramId, value, false);  // false = don't notify again
                             }
                         };
@@ -143,7 +150,7 @@ MainComponent::MainComponent()
                         logDebug("Setting content to window...", LogLevel::INFO);
                         editorWindowA->setContentOwned(editorComponent.release(), true);
                         editorWindowA->setResizable(true, true);
-                        editorWindowA->centreWithSize(500, 450);  // Increased height to fit 3 controls
+                        editorWindowA->centreWithSize(900, 560);  // Knobs on the left, schematic drawing on the right
                         
                         logDebug("Making window visible...", LogLevel::INFO);
                         editorWindowA->setVisible(true);
@@ -248,8 +255,17 @@ MainComponent::MainComponent()
     audioDeviceLabel.setColour(juce::Label::textColourId, juce::Colours::yellow);
     addAndMakeVisible(audioDeviceLabel);
 
+    // Scope triggers on the input's rising edge, so A and B line up against it
+    LiveSpiceDSP::ScopeSettings scopeSettings;
+    scopeSettings.frameLength = 2048;
+    scopeSettings.preTrigger = 256;
+    scopeSettings.level = 0.005f;
+    scopeSettings.hysteresis = 0.002f;
+    scopeSettings.displayPoints = 480;
+    scopeCapture.setSettings(scopeSettings);
+
     // Set window size
-    setSize(1000, 800);
+    setSize(1000, 890);
 
     // Setup audio
     setAudioChannels(2, 2);
@@ -270,6 +286,7 @@ MainComponent::~MainComponent()
     }
     
     shutdownAudio();
+    Logging::stopWriter();
 }
 
 bool MainComponent::keyPressed(const juce::KeyPress& key)
@@ -320,6 +337,9 @@ juce::PopupMenu MainComponent::getMenuForIndex(int topLevelMenuIndex, const juce
         
         menu.addItem(15, "View Log File");
         menu.addSeparator();
+        menu.addItem(16, "Export CPU Statistics...");
+        menu.addItem(17, "Reset CPU Statistics");
+        menu.addSeparator();
         menu.addItem(2, "Quit");
     }
 
@@ -359,6 +379,18 @@ void MainComponent::menuItemSelected(int menuItemID, int topLevelMenuIndex)
         // Open log file with default app
         g_logFile.startAsProcess();
     }
+    else if (menuItemID == 16)
+    {
+        exportCpuStats();
+    }
+    else if (menuItemID == 17)
+    {
+        if (audioRouter)
+        {
+            audioRouter->getMeterA().reset();
+            audioRouter->getMeterB().reset();
+        }
+    }
     else if (menuItemID == 2)
     {
         juce::JUCEApplication::getInstance()->systemRequestedQuit();
@@ -451,9 +483,13 @@ void MainComponent::prepareToPlay(int samplesPerBlockExpected, double sampleRate
     // Allocate input capture buffer
     inputBuffer.setSize(2, samplesPerBlockExpected);
     
-    // Prepare audio router
+    // Prepare audio router for as many channels as the callback buffer carries
     if (audioRouter)
-        audioRouter->prepareToPlay(sampleRate, samplesPerBlockExpected);
+    {
+        const int maxChannels = juce::jmax(currentDevice->getActiveInputChannels().countNumberOfSetBits(),
+                                           currentDevice->getActiveOutputChannels().countNumberOfSetBits());
+        audioRouter->prepareToPlay(sampleRate, samplesPerBlockExpected, maxChannels);
+    }
     
     // Prepare processors
     if (processorA && processorA->isLoaded())
@@ -477,14 +513,16 @@ void MainComponent::prepareToPlay(int samplesPerBlockExpected, double sampleRate
 
 void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& bufferToFill)
 {
+    // Apply parameter changes queued since the last block, before anything runs
+    paramSync->processPendingChanges();
+    
     if (kDebugAudioEnabled)
     {
         // DIAGNOSTIC: Check if this callback is being called
         static int callCount = 0;
         if (callCount++ == 0)
         {
-            juce::Logger::writeToLog("=== getNextAudioBlock CALLBACK IS BEING CALLED ===");
-            logDebug("=== Audio callback started! ===", LogLevel::INFO);
+            LOG_RT(LogLevel::INFO, "=== Audio callback started! ===");
         }
     }
     
@@ -517,20 +555,14 @@ void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& buffer
         static int levelLogCounter = 0;
         if (levelLogCounter++ % 500 == 0)
         {
-            auto* device = deviceManager.getCurrentAudioDevice();
-            juce::String deviceName = device ? device->getName() : "NONE";
-            logDebug("INPUT: Level=" + juce::String(inputLevelBefore, 6) + 
-                    " Min=" + juce::String(minSample, 6) + 
-                    " Max=" + juce::String(maxSample, 6) + 
-                    " Device=" + deviceName, 
-                    LogLevel::DEBUG);
+            LOG_RT(LogLevel::DEBUG, "INPUT: Level=%.6f Min=%.6f Max=%.6f", inputLevelBefore, minSample, maxSample);
         }
         
         // Alert if input changes significantly
         static float lastInputLevel = 0.0f;
         if (std::abs(inputLevelBefore - lastInputLevel) > 0.001f && levelLogCounter % 100 == 0)
         {
-            logDebug("INPUT CHANGED: " + juce::String(lastInputLevel, 4) + " -> " + juce::String(inputLevelBefore, 4), LogLevel::INFO);
+            LOG_RT(LogLevel::INFO, "INPUT CHANGED: %.4f -> %.4f", lastInputLevel, inputLevelBefore);
         }
         lastInputLevel = inputLevelBefore;
     }
@@ -562,7 +594,7 @@ void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& buffer
         if (testToneCounter++ > 480000)  // After ~10 seconds at 48kHz
         {
             testToneCounter = 0;
-            logDebug("=== GENERATING TEST TONE - IF YOU HEAR A BEEP, AUDIO OUTPUT IS WORKING ===", LogLevel::INFO);
+            LOG_RT(LogLevel::INFO, "=== GENERATING TEST TONE - IF YOU HEAR A BEEP, AUDIO OUTPUT IS WORKING ===");
             
             // Generate a 1kHz sine wave test tone
             for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
@@ -583,9 +615,8 @@ void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& buffer
         static int diagCounter = 0;
         if (diagCounter++ % 1000 == 0)
         {
-            logDebug("BUFFER STATE: NumChannels=" + juce::String(buffer.getNumChannels()) + 
-                    ", NumSamples=" + juce::String(bufferToFill.numSamples) + 
-                    ", StartSample=" + juce::String(bufferToFill.startSample), LogLevel::DEBUG);
+            LOG_RT(LogLevel::DEBUG, "BUFFER STATE: NumChannels=%d, NumSamples=%d, StartSample=%d",
+                   buffer.getNumChannels(), bufferToFill.numSamples, bufferToFill.startSample);
         }
     }
     
@@ -632,6 +663,15 @@ void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& buffer
     outputLevel.store(outputLevelAfter);      // What's in the buffer now
     deviceOutputLevel.store(outputLevelAfter); // What will be sent to device (same as buffer for now)
     
+    // Scope capture; drops (and counts) samples rather than wait for the UI
+    if (buffer.getNumChannels() > 0)
+    {
+        const bool haveInput = inputBuffer.getNumChannels() > 0 && bufferToFill.numSamples <= inputBuffer.getNumSamples();
+        const float* scopeChannels[] = { haveInput ? inputBuffer.getReadPointer(0) : nullptr,
+                                         buffer.getReadPointer(0, bufferToFill.startSample) };
+        scopeFifo.push(scopeChannels, 2, (size_t) bufferToFill.numSamples);
+    }
+    
     if (kDebugAudioEnabled)
     {
         // Repaint level meters every 5 audio blocks for smooth updates
@@ -645,8 +685,7 @@ void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& buffer
         {
             float sample0_ch0 = buffer.getNumChannels() > 0 ? *buffer.getReadPointer(0) : 0.0f;
             float sample0_ch1 = buffer.getNumChannels() > 1 ? *buffer.getReadPointer(1) : 0.0f;
-            logDebug("BUFFER SAMPLES: Ch0[0]=" + juce::String(sample0_ch0, 6) + 
-                    ", Ch1[0]=" + juce::String(sample0_ch1, 6), LogLevel::DEBUG);
+            LOG_RT(LogLevel::DEBUG, "BUFFER SAMPLES: Ch0[0]=%.6f, Ch1[0]=%.6f", sample0_ch0, sample0_ch1);
         }
         
         // Log periodically for debugging
@@ -655,19 +694,16 @@ void MainComponent::getNextAudioBlock(const juce::AudioSourceChannelInfo& buffer
         {
             auto selection = audioRouter ? audioRouter->getSelection() : AudioRouter::ProcessorSelection::A;
             
-            logDebug("AUDIO FLOW: Input=" + juce::String(inputLevelBefore, 4) + 
-                    " -> [" + juce::String(selection == AudioRouter::ProcessorSelection::A ? "A" : "B") + "] -> " +
-                    "Output=" + juce::String(outputLevelAfter, 4) + 
-                    " (Channels: " + juce::String(buffer.getNumChannels()) + 
-                    ", Samples: " + juce::String(bufferToFill.numSamples) + ")", 
-                    LogLevel::INFO);
+            LOG_RT(LogLevel::INFO, "AUDIO FLOW: Input=%.4f -> [%s] -> Output=%.4f (Channels: %d, Samples: %d)",
+                   inputLevelBefore, selection == AudioRouter::ProcessorSelection::A ? "A" : "B",
+                   outputLevelAfter, buffer.getNumChannels(), bufferToFill.numSamples);
         }
         
         // EMERGENCY DIAGNOSTIC: Force output to ensure buffer is being written
         // If startSample is non-zero, we need to handle it properly
         if (bufferToFill.startSample != 0)
         {
-            logDebug("WARNING: startSample=" + juce::String(bufferToFill.startSample) + " (non-zero!)", LogLevel::WARNING);
+            LOG_RT(LogLevel::WARNING, "WARNING: startSample=%d (non-zero!)", bufferToFill.startSample);
         }
     }
 }
@@ -688,6 +724,8 @@ void MainComponent::paint(juce::Graphics& g)
 {
     g.fillAll(getLookAndFeel().findColour(juce::ResizableWindow::backgroundColourId));
     paintLevelMeters(g);
+    paintCpuMeters(g);
+    paintScope(g);
 }
 
 void MainComponent::paintLevelMeters(juce::Graphics& g)
@@ -736,6 +774,124 @@ void MainComponent::paintLevelMeters(juce::Graphics& g)
     drawMeter(meterArea.removeFromLeft(meterWidth).reduced(3), deviceOutputLevel, "4. DEVICE", juce::Colours::lime);
 }
 
+void MainComponent::paintCpuMeters(juce::Graphics& g)
+{
+    if (!audioRouter || cpuMeterArea.isEmpty())
+        return;
+    
+    auto drawSlot = [&g](juce::Rectangle<int> area, const juce::String& label,
+                         const ProcessorMeter::Snapshot& s, juce::Colour colour)
+    {
+        g.setColour(juce::Colours::black);
+        g.fillRect(area);
+        g.setColour(juce::Colours::white);
+        g.drawRect(area, 1);
+        area = area.reduced(4);
+        
+        // Rolling and worst load as a percentage of the block deadline
+        g.setFont(11.0f);
+        g.drawFittedText(label + "  CPU " + juce::String(s.rollingLoad * 100.0, 1) + "%"
+                             + "  worst " + juce::String(s.worstLoad * 100.0, 1) + "% ("
+                             + juce::String(s.worstMicroseconds, 0) + " us)"
+                             + "  overruns " + juce::String((juce::int64) s.overruns),
+                         area.removeFromLeft(area.getWidth() / 2), juce::Justification::centredLeft, 2);
+        
+        // Block-load histogram on a log scale, so rare slow blocks stay visible
+        uint64_t maxCount = 1;
+        for (auto count : s.histogram)
+            maxCount = juce::jmax(maxCount, count);
+        
+        const float barWidth = (float) area.getWidth() / (float) ProcessorMeter::numBins;
+        for (int i = 0; i < ProcessorMeter::numBins; ++i)
+        {
+            const auto count = s.histogram[(size_t) i];
+            if (count == 0)
+                continue;
+            
+            const float height = (float) area.getHeight() * (float) (std::log1p((double) count) / std::log1p((double) maxCount));
+            g.setColour(i == ProcessorMeter::numBins - 1 ? juce::Colours::red : colour);
+            g.fillRect(juce::Rectangle<float>((float) area.getX() + (float) i * barWidth, (float) area.getBottom() - height,
+                                              barWidth - 1.0f, height));
+        }
+    };
+    
+    auto area = cpuMeterArea;
+    drawSlot(area.removeFromLeft(area.getWidth() / 2).reduced(3), "A", audioRouter->getMeterA().getSnapshot(), juce::Colours::cyan);
+    drawSlot(area.reduced(3), "B", audioRouter->getMeterB().getSnapshot(), juce::Colours::orange);
+}
+
+void MainComponent::paintScope(juce::Graphics& g)
+{
+    if (scopeArea.isEmpty())
+        return;
+    
+    g.setColour(juce::Colours::black);
+    g.fillRect(scopeArea);
+    g.setColour(juce::Colours::white);
+    g.drawRect(scopeArea, 1);
+    
+    auto area = scopeArea.reduced(4);
+    const float midY = (float) area.getCentreY();
+    const float halfHeight = (float) area.getHeight() * 0.5f;
+    g.setColour(juce::Colours::darkgrey);
+    g.drawHorizontalLine((int) midY, (float) area.getX(), (float) area.getRight());
+    
+    // One vertical min..max span per column keeps peaks that fall between columns
+    if (scopeFrame.numPoints > 0)
+    {
+        const float columnWidth = (float) area.getWidth() / (float) scopeFrame.numPoints;
+        const juce::Colour colours[] = { juce::Colours::cyan.withAlpha(0.7f), juce::Colours::lime.withAlpha(0.8f) };
+        
+        for (int ch = 0; ch < scopeFrame.numChannels; ++ch)
+        {
+            g.setColour(colours[ch % 2]);
+            for (size_t p = 0; p < scopeFrame.numPoints; ++p)
+            {
+                const float top = midY - juce::jlimit(-1.0f, 1.0f, scopeFrame.getMax(ch, p)) * halfHeight;
+                const float bottom = midY - juce::jlimit(-1.0f, 1.0f, scopeFrame.getMin(ch, p)) * halfHeight;
+                g.fillRect(juce::Rectangle<float>((float) area.getX() + (float) p * columnWidth, top,
+                                                  juce::jmax(1.0f, columnWidth), juce::jmax(1.0f, bottom - top)));
+            }
+        }
+    }
+    
+    g.setColour(juce::Colours::white);
+    g.setFont(11.0f);
+    g.drawFittedText(juce::String("INPUT / OUTPUT  ") + (scopeFrame.triggered ? "trig" : "auto")
+                         + "  overruns " + juce::String((juce::int64) scopeFifo.getOverruns()),
+                     area, juce::Justification::topLeft, 1);
+}
+
+void MainComponent::exportCpuStats()
+{
+    if (!audioRouter)
+        return;
+    
+    auto chooser = std::make_shared<juce::FileChooser>("Export CPU Statistics",
+        juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("ab_cpu_stats.csv"),
+        "*.csv");
+    
+    chooser->launchAsync(juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::canSelectFiles
+                             | juce::FileBrowserComponent::warnAboutOverwriting,
+        [this, chooser](const juce::FileChooser& fc)
+        {
+            auto file = fc.getResult();
+            if (file == juce::File() || !audioRouter)
+                return;
+            
+            juce::String csv;
+            csv << "# A = " << (processorA ? processorA->getName() : juce::String("(none)")) << "\n";
+            csv << "# B = " << (processorB ? processorB->getName() : juce::String("(none)")) << "\n\n";
+            csv << ProcessorMeter::toCsv("A", audioRouter->getMeterA()) << "\n";
+            csv << ProcessorMeter::toCsv("B", audioRouter->getMeterB());
+            
+            if (file.replaceWithText(csv))
+                logDebug("Exported CPU statistics to " + file.getFullPathName(), LogLevel::INFO);
+            else
+                logDebug("Failed to write CPU statistics to " + file.getFullPathName(), LogLevel::ERROR);
+        });
+}
+
 void MainComponent::resized()
 {
     auto area = getLocalBounds();
@@ -754,6 +910,14 @@ void MainComponent::resized()
     // Reserve space for level meters (painted in paint method)
     area.removeFromTop(60);  // Height of level meters
     
+    // CPU overlay below the meters (also painted in paint method)
+    cpuMeterArea = area.removeFromTop(40).reduced(10, 0);
+    
+    area.removeFromTop(10);
+    
+    // Scope below the CPU overlay (also painted in paint method)
+    scopeArea = area.removeFromTop(80).reduced(10, 0);
+    
     area.removeFromTop(10);
     
     // Main status
@@ -806,17 +970,22 @@ void MainComponent::resized()
 void MainComponent::timerCallback()
 {
     updateWorkflowPhase();
+    paramSync->dispatchNotifications();
+    repaint(cpuMeterArea);
+    if (scopeCapture.update(scopeFifo, scopeFrame))
+        repaint(scopeArea);
+    updateLatencyCompensation();
     
     // Start logging when entering Configured phase
     if (currentPhase == WorkflowPhase::Configured && !g_loggingEnabled)
     {
         g_loggingEnabled = true;
         // Clear old log file and start fresh
-        g_logFile.deleteFile();
+        Logging::restartFile();
         logDebug("====================================================================", LogLevel::INFO);
         logDebug("LiveSpice A/B Testing Suite - Session Started", LogLevel::INFO);
         logDebug("====================================================================", LogLevel::INFO);
-        logDebug("Logging Level: " + juce::String((int)g_currentLogLevel), LogLevel::INFO);
+        logDebug("Logging Level: " + juce::String((int) g_currentLogLevel.load()), LogLevel::INFO);
     }
     
     // Only sync control panel once, when transitioning to Configured phase
@@ -839,6 +1008,60 @@ void MainComponent::timerCallback()
     }
 }
 
+void MainComponent::LatencyProbe::run()
+{
+    LatencyDetector detector(sampleRate);
+    result = detector.measure(*processorA, *processorB);
+    finished.store(true);
+}
+
+void MainComponent::updateLatencyCompensation()
+{
+    if (!audioRouter || !processorA || !processorB)
+        return;
+    
+    const int reportedA = processorA->getLatencySamples();
+    const int reportedB = processorB->getLatencySamples();
+    
+    if (latencyProbe && latencyProbe->finished.load())
+    {
+        // Fall back to what the processors report when the chirp gave no clear peak
+        const auto measured = latencyProbe->result;
+        audioRouter->setLatencyOffset(measured.value_or(reportedB - reportedA));
+        logDebug("Latency: B trails A by " + juce::String(measured.value_or(reportedB - reportedA)) + " samples (" +
+                 (measured ? juce::String("measured") : juce::String("reported")) + ", reported A=" +
+                 juce::String(reportedA) + " B=" + juce::String(reportedB) + ")", LogLevel::INFO);
+        latencyProbe.reset();
+    }
+    
+    if (currentPhase != WorkflowPhase::Configured || latencyProbe)
+        return;
+    
+    // Re-measure whenever a source, the rate, or a reported latency changes
+    const juce::String key = sourceA + "|" + sourceB + "|" + juce::String(currentSampleRate) + "|" +
+                             juce::String(reportedA) + "|" + juce::String(reportedB);
+    if (key == latencyKey)
+        return;
+    latencyKey = key;
+    
+    // Private instances, created here because plugins expect the message thread
+    auto probeA = ProcessorFactory::create(sourceA);
+    auto probeB = ProcessorFactory::create(sourceB);
+    if (!probeA || !probeA->isLoaded() || !probeB || !probeB->isLoaded())
+    {
+        audioRouter->setLatencyOffset(reportedB - reportedA);
+        return;
+    }
+    
+    for (const auto& param : processorA->getParameters())
+        probeA->setParameter(param.id, param.currentValue);
+    for (const auto& param : processorB->getParameters())
+        probeB->setParameter(param.id, param.currentValue);
+    
+    latencyProbe = std::make_unique<LatencyProbe>(std::move(probeA), std::move(probeB), currentSampleRate);
+    latencyProbe->startThread();
+}
+
 void MainComponent::updateWorkflowPhase()
 {
     WorkflowPhase newPhase = (isPluginALoaded && isPluginBLoaded) 
@@ -925,7 +1148,8 @@ void MainComponent::loadPluginA()
             auto file = fc.getResult();
             if (file.exists())
             {
-                processorA = ProcessorFactory::createNativeDSP(file.getFullPathName());
+                sourceA = file.getFullPathName();
+                processorA = ProcessorFactory::createNativeDSP(sourceA);
                 
                 if (processorA && processorA->isLoaded())
                 {
@@ -962,7 +1186,8 @@ void MainComponent::loadPluginB()
             auto file = fc.getResult();
             if (file.exists())
             {
-                processorB = ProcessorFactory::createVST3(file.getFullPathName());
+                sourceB = file.getFullPathName();
+                processorB = ProcessorFactory::createVST3(sourceB);
                 
                 if (processorB && processorB->isLoaded())
                 {
@@ -11,7 +11,9 @@
 #include "Logging.h"
 #include "IAudioProcessor.h"
 #include "AudioRouter.h"
+#include "LatencyDetector.h"
 #include "ParameterSynchronizer.h"
+#include "ScopeFifo.h"
 #include "ProcessorFactory.h"
 #include "ControlPanel.h"
 #include "ABSwitch.h"
@@ -31,6 +33,8 @@ public:
 
     void paint(juce::Graphics& g) override;
     void paintLevelMeters(juce::Graphics& g);  // Draw real-time level indicators
+    void paintCpuMeters(juce::Graphics& g);    // Per-processor CPU load and block histogram
+    void paintScope(juce::Graphics& g);        // Triggered input/output waveform
     void resized() override;
 
     void timerCallback() override;
@@ -111,9 +115,45 @@ private:
     std::atomic<float> outputLevel{0.0f};
     std::atomic<float> deviceOutputLevel{0.0f};
 
+    // CPU overlay, laid out in resized(); statistics live in the router's meters
+    juce::Rectangle<int> cpuMeterArea;
+
+    // Scope: the audio thread pushes input (channel 0) and output (channel 1)
+    // without waiting; the timer triggers on the input and draws both
+    LiveSpiceDSP::ScopeFifo scopeFifo{2, 1 << 15};
+    LiveSpiceDSP::ScopeCapture scopeCapture{2};
+    LiveSpiceDSP::ScopeFrame scopeFrame;
+    juce::Rectangle<int> scopeArea;
+
     // Current state
     bool isPluginALoaded{false};
     bool isPluginBLoaded{false};
+    juce::String sourceA;  // Identifiers the processors were created from
+    juce::String sourceB;
+
+    // Measures A/B latency on private instances, off the message and audio threads
+    class LatencyProbe : public juce::Thread
+    {
+    public:
+        LatencyProbe(std::unique_ptr<IAudioProcessor> a, std::unique_ptr<IAudioProcessor> b, double sampleRate)
+            : juce::Thread("A/B latency probe"), processorA(std::move(a)), processorB(std::move(b)), sampleRate(sampleRate) {}
+        ~LatencyProbe() override { stopThread(10000); }
+
+        void run() override;
+
+        std::atomic<bool> finished{false};
+        std::optional<int> result;  // Valid once finished
+
+    private:
+        std::unique_ptr<IAudioProcessor> processorA;
+        std::unique_ptr<IAudioProcessor> processorB;
+        double sampleRate;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LatencyProbe)
+    };
+
+    std::unique_ptr<LatencyProbe> latencyProbe;
+    juce::String latencyKey;  // Sources, rate and reported latencies of the last measurement
 
     void loadPluginA();
     void loadPluginB();
@@ -121,6 +161,8 @@ private:
     void updateWorkflowPhase();
     void showAudioSettings();
     void syncControlPanel();
+    void exportCpuStats();
+    void updateLatencyCompensation();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MainComponent)
 };
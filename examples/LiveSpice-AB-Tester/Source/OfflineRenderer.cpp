@@ -0,0 +1,32 @@
+#include "OfflineRenderer.h"
+
+OfflineRenderer::OfflineRenderer(double rate, int maxBlock)
+    : sampleRate(rate), blockSize(juce::jmax(1, maxBlock))
+{
+}
+
+void OfflineRenderer::prepare(IAudioProcessor& processor)
+{
+    processor.setNonRealtime(true);
+    processor.prepareToPlay(sampleRate, blockSize);
+}
+
+void OfflineRenderer::render(IAudioProcessor& processor, juce::AudioBuffer<float>& buffer)
+{
+    processor.reset();
+
+    // Process views of the buffer: no copies, at most blockSize per call
+    float* channels[32];
+    const int numChannels = juce::jmin(buffer.getNumChannels(), (int) juce::numElementsInArray(channels));
+    const int numSamples = buffer.getNumSamples();
+
+    for (int offset = 0; offset < numSamples; offset += blockSize)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            channels[ch] = buffer.getWritePointer(ch, offset);
+
+        juce::AudioBuffer<float> block(channels, numChannels, juce::jmin(blockSize, numSamples - offset));
+        midi.clear();
+        processor.processBlock(block, midi);
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "IAudioProcessor.h"
+#include <juce_audio_basics/juce_audio_basics.h>
+
+/**
+ * OfflineRenderer - Faster-than-real-time rendering through an IAudioProcessor
+ * 
+ * Responsibilities:
+ * - Prepares a processor for offline use (non-real-time mode, large blocks)
+ * - Renders whole buffers in blocks of up to blockSize, as fast as the CPU allows
+ * - Resets the processor before each render, so rendering the same input at
+ *   the same parameter values always gives the same output
+ * 
+ * Intended for private processor instances (not the ones the audio device is
+ * playing): no device callback is involved. One renderer per thread.
+ */
+class OfflineRenderer
+{
+public:
+    explicit OfflineRenderer(double sampleRate = 44100.0, int blockSize = 4096);
+
+    // Put the processor in non-real-time mode and prepare it for blockSize
+    void prepare(IAudioProcessor& processor);
+
+    // Reset, then process buffer in place
+    void render(IAudioProcessor& processor, juce::AudioBuffer<float>& buffer);
+
+    double getSampleRate() const { return sampleRate; }
+    int getBlockSize() const { return blockSize; }
+
+private:
+    double sampleRate;
+    int blockSize;
+    juce::MidiBuffer midi;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OfflineRenderer)
+};
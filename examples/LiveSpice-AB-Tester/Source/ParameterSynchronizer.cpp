@@ -21,62 +21,119 @@ void ParameterSynchronizer::setProcessorB(IAudioProcessor* processor)
 
 void ParameterSynchronizer::setParameter(const juce::String& parameterId, float value, bool notifyOther)
 {
-    bool foundInA = false;
-    bool foundInB = false;
-    
     logDebug("ParameterSynchronizer::setParameter(" + parameterId + ", " + juce::String(value, 3) + 
              ", notifyOther=" + juce::String(notifyOther ? "true" : "false") + 
-             ", linkingEnabled=" + juce::String(linkingEnabled ? "true" : "false") + ")", LogLevel::INFO);
+             ", linkingEnabled=" + juce::String(linkingEnabled ? "true" : "false") + ")", LogLevel::DEBUG);
+    
+    // Processor B follows only if linking is enabled
+    const int targets = (linkingEnabled && notifyOther) ? (toA | toB) : toA;
+    enqueue(parameterId, value, targets);
+}
+
+int ParameterSynchronizer::slotFor(const juce::String& parameterId)
+{
+    const int count = numSlots.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; ++i)
+        if (slotIds[(size_t) i] == parameterId)
+            return i;
     
-    // Update processor A
-    if (processorA && processorA->isLoaded())
+    if (count == maxParameters)
+        return -1;
+    
+    // Write the id, then publish it to the audio thread
+    slotIds[(size_t) count] = parameterId;
+    numSlots.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+bool ParameterSynchronizer::enqueue(const juce::String& parameterId, float value, int targets)
+{
+    const int slot = slotFor(parameterId);
+    if (slot < 0)
     {
-        foundInA = processorA->setParameter(parameterId, value);
-        logDebug("  Processor A: " + juce::String(foundInA ? "UPDATED" : "NOT FOUND"), LogLevel::INFO);
+        logDebug("ParameterSynchronizer: Too many parameters - dropping '" + parameterId + "'", LogLevel::WARNING);
+        return false;
     }
-    else
+    
+    const auto scope = fifo.write(1);
+    if (scope.blockSize1 + scope.blockSize2 == 0)
     {
-        logDebug("  Processor A: NOT LOADED", LogLevel::INFO);
+        logDebug("ParameterSynchronizer: Queue full - dropping '" + parameterId + "'", LogLevel::WARNING);
+        return false;
     }
     
-    // Update processor B (only if linking enabled and parameter exists)
-    if (processorB && processorB->isLoaded() && linkingEnabled && notifyOther)
+    // Resolve indices here so the audio thread sets by index, not by id
+    auto* a = processorA.load();
+    auto* b = processorB.load();
+    const int indexA = (targets & toA) && a && a->isLoaded() ? a->getParameterIndex(parameterId) : -1;
+    const int indexB = (targets & toB) && b && b->isLoaded() ? b->getParameterIndex(parameterId) : -1;
+    
+    queue[(size_t) (scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2)] = { slot, indexA, indexB, value };
+    return true;
+}
+
+void ParameterSynchronizer::processPendingChanges()
+{
+    const int count = fifo.getNumReady();
+    if (count == 0)
+        return;
+    
+    auto* a = processorA.load(std::memory_order_acquire);
+    auto* b = processorB.load(std::memory_order_acquire);
+    
+    const auto scope = fifo.read(count);
+    auto apply = [&](int start, int size)
     {
-        foundInB = processorB->setParameter(parameterId, value);
-        
-        if (!foundInB)
+        for (int i = start; i < start + size; ++i)
         {
-            logDebug("ParameterSynchronizer: Parameter '" + parameterId + 
-                     "' not found in processor B - skipping sync", LogLevel::DEBUG);
+            const auto& change = queue[(size_t) i];
+            
+            if (change.indexA >= 0 && a && a->isLoaded())
+                a->setParameterByIndex(change.indexA, change.value);
+            if (change.indexB >= 0 && b && b->isLoaded())
+                b->setParameterByIndex(change.indexB, change.value);
+            
+            appliedValues[(size_t) change.slot].store(change.value, std::memory_order_relaxed);
+            pendingNotification[(size_t) change.slot].store(true, std::memory_order_release);
         }
-    }
+    };
+    apply(scope.startIndex1, scope.blockSize1);
+    apply(scope.startIndex2, scope.blockSize2);
     
-    // Notify callback
-    if (parameterCallback)
-    {
-        parameterCallback(parameterId, value);
-    }
+    anyPending.store(true, std::memory_order_release);
+}
+
+void ParameterSynchronizer::dispatchNotifications()
+{
+    if (!anyPending.exchange(false, std::memory_order_acquire))
+        return;
     
-    if (foundInA || foundInB)
+    const int count = numSlots.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; ++i)
     {
-        logDebug("ParameterSynchronizer: Set " + parameterId + " = " + juce::String(value) + 
-                 " (A:" + juce::String(foundInA ? "yes" : "no") + 
-                 ", B:" + juce::String(foundInB ? "yes" : "no") + ")", LogLevel::DEBUG);
+        if (!pendingNotification[(size_t) i].exchange(false, std::memory_order_acquire))
+            continue;
+        
+        if (parameterCallback)
+            parameterCallback(slotIds[(size_t) i], appliedValues[(size_t) i].load(std::memory_order_relaxed));
     }
 }
 
 float ParameterSynchronizer::getParameter(const juce::String& parameterId) const
 {
+    auto* a = processorA.load();
+    auto* b = processorB.load();
+    
     // Try processor A first
-    if (processorA && processorA->isLoaded())
+    if (a && a->isLoaded())
     {
-        return processorA->getParameter(parameterId);
+        return a->getParameter(parameterId);
     }
     
     // Fall back to processor B
-    if (processorB && processorB->isLoaded())
+    if (b && b->isLoaded())
     {
-        return processorB->getParameter(parameterId);
+        return b->getParameter(parameterId);
     }
     
     return 0.0f;
@@ -85,6 +142,8 @@ float ParameterSynchronizer::getParameter(const juce::String& parameterId) const
 std::vector<IAudioProcessor::ParameterInfo> ParameterSynchronizer::getMergedParameters() const
 {
     std::vector<IAudioProcessor::ParameterInfo> commonParams;
+    auto* processorA = this->processorA.load();
+    auto* processorB = this->processorB.load();
     
     // If either processor not loaded, return empty
     if (!processorA || !processorA->isLoaded() || !processorB || !processorB->isLoaded())
@@ -179,17 +238,19 @@ void ParameterSynchronizer::onParameterChanged(ParameterChangeCallback callback)
 
 void ParameterSynchronizer::copyParametersAtoB()
 {
-    if (!processorA || !processorA->isLoaded() || !processorB || !processorB->isLoaded())
+    auto* a = processorA.load();
+    auto* b = processorB.load();
+    if (!a || !a->isLoaded() || !b || !b->isLoaded())
     {
         logDebug("ParameterSynchronizer: Cannot copy A to B - processor not loaded", LogLevel::WARNING);
         return;
     }
     
-    auto paramsA = processorA->getParameters();
+    auto paramsA = a->getParameters();
     
     for (const auto& param : paramsA)
     {
-        processorB->setParameter(param.id, param.currentValue);
+        enqueue(param.id, param.currentValue, toB);
     }
     
     logDebug("ParameterSynchronizer: Copied " + juce::String(paramsA.size()) + 
@@ -198,17 +259,19 @@ void ParameterSynchronizer::copyParametersAtoB()
 
 void ParameterSynchronizer::copyParametersBtoA()
 {
-    if (!processorA || !processorA->isLoaded() || !processorB || !processorB->isLoaded())
+    auto* a = processorA.load();
+    auto* b = processorB.load();
+    if (!a || !a->isLoaded() || !b || !b->isLoaded())
     {
         logDebug("ParameterSynchronizer: Cannot copy B to A - processor not loaded", LogLevel::WARNING);
         return;
     }
     
-    auto paramsB = processorB->getParameters();
+    auto paramsB = b->getParameters();
     
     for (const auto& param : paramsB)
     {
-        processorA->setParameter(param.id, param.currentValue);
+        enqueue(param.id, param.currentValue, toA);
     }
     
     logDebug("ParameterSynchronizer: Copied " + juce::String(paramsB.size()) + 
@@ -224,5 +287,5 @@ void ParameterSynchronizer::updateLinkedParameter(IAudioProcessor* source, IAudi
     if (!source->isLoaded() || !target->isLoaded())
         return;
     
-    target->setParameter(parameterId, value);
+    enqueue(parameterId, value, target == processorA.load() ? toA : toB);
 }
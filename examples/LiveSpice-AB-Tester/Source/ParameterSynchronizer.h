@@ -2,6 +2,8 @@
 
 #include "IAudioProcessor.h"
 #include <juce_audio_processors/juce_audio_processors.h>
+#include <array>
+#include <atomic>
 #include <functional>
 
 /**
@@ -12,6 +14,22 @@
  * - Propagates parameter changes bidirectionally
  * - Handles parameter mapping (e.g., different value ranges)
  * - Provides callbacks for UI updates
+ *
+ * Changes are never applied from the thread that makes them. setParameter()
+ * and the copy functions resolve the parameter's index in each processor
+ * and push a small POD record (slot, indices, value) into a fixed-capacity
+ * single-producer/single-consumer FIFO; the audio thread applies everything
+ * queued at the start of each block in processPendingChanges(), so dragging
+ * a linked knob never contends with processing and a parameter never
+ * changes halfway through a block.
+ *
+ * Slots index an append-only table of parameter ids: an id gets a slot the
+ * first time it is set and keeps it. The audio thread never calls the
+ * callback; it records the last applied value per slot, and
+ * dispatchNotifications() (message-thread timer) reports each changed
+ * parameter once however many changes arrived.
+ *
+ * Threads: everything except processPendingChanges() is message thread only.
  */
 class ParameterSynchronizer
 {
@@ -25,23 +43,29 @@ public:
     void setProcessorA(IAudioProcessor* processor);
     void setProcessorB(IAudioProcessor* processor);
     
-    IAudioProcessor* getProcessorA() { return processorA; }
-    IAudioProcessor* getProcessorB() { return processorB; }
+    IAudioProcessor* getProcessorA() { return processorA.load(); }
+    IAudioProcessor* getProcessorB() { return processorB.load(); }
 
     // Synchronization control
     void setLinkingEnabled(bool enabled) { linkingEnabled = enabled; }
     bool isLinkingEnabled() const { return linkingEnabled; }
     
-    // Update a parameter and sync to other processor
+    // Queue a parameter update, synced to the other processor when linked
     void setParameter(const juce::String& parameterId, float value, bool notifyOther = true);
     
+    // Audio thread, start of each block: apply everything queued so far
+    void processPendingChanges();
+    
+    // Message thread timer: report parameters applied since the last call
+    void dispatchNotifications();
+    
     // Get parameter from currently active processor
     float getParameter(const juce::String& parameterId) const;
     
     // Get all parameters from both processors (merged list)
     std::vector<IAudioProcessor::ParameterInfo> getMergedParameters() const;
     
-    // Callbacks for UI updates
+    // Callbacks for UI updates (from dispatchNotifications, coalesced)
     void onParameterChanged(ParameterChangeCallback callback);
 
     // Copy all parameters from A to B or vice versa
@@ -54,14 +78,43 @@ private:
     std::vector<IAudioProcessor::ParameterInfo> filterEffectParameters(
         const std::vector<IAudioProcessor::ParameterInfo>& params) const;
 
+public:
+    static constexpr int queueCapacity = 1024;
+    static constexpr int maxParameters = 256;
+
 private:
-    IAudioProcessor* processorA{nullptr};
-    IAudioProcessor* processorB{nullptr};
+    enum Targets { toA = 1, toB = 2 };
+    
+    struct Change
+    {
+        int slot;
+        int indexA;    // Parameter index in processor A, -1 = don't apply
+        int indexB;
+        float value;
+    };
+    
+    std::atomic<IAudioProcessor*> processorA{nullptr};
+    std::atomic<IAudioProcessor*> processorB{nullptr};
     
     bool linkingEnabled{true};
     
     ParameterChangeCallback parameterCallback;
     
+    // Append-only id table: entries below numSlots never change
+    std::array<juce::String, maxParameters> slotIds;
+    std::atomic<int> numSlots{0};
+    
+    juce::AbstractFifo fifo{queueCapacity};
+    std::array<Change, queueCapacity> queue{};
+    
+    // Last applied value per slot, and whether the callback has seen it
+    std::array<std::atomic<float>, maxParameters> appliedValues{};
+    std::array<std::atomic<bool>, maxParameters> pendingNotification{};
+    std::atomic<bool> anyPending{false};
+    
+    int slotFor(const juce::String& parameterId);
+    bool enqueue(const juce::String& parameterId, float value, int targets);
+    
     // Helper to update linked parameter
     void updateLinkedParameter(IAudioProcessor* source, IAudioProcessor* target, 
                               const juce::String& parameterId, float value);
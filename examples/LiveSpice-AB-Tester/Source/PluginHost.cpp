@@ -165,14 +165,14 @@ void PluginHost::processBlock(juce::AudioBuffer<float>& buffer,
 {
     if (!plugin)
     {
-        logDebug("PluginHost::processBlock - Plugin is null!");
+        LOG_RT(LogLevel::DEBUG, "PluginHost::processBlock - Plugin is null!");
         return;
     }
 
     static int processCounter = 0;
     if (processCounter++ % 1000 == 0)
     {
-        logDebug("PluginHost::processBlock - Processing " + juce::String(numSamples) + " samples");
+        LOG_RT(LogLevel::DEBUG, "PluginHost::processBlock - Processing %d samples", numSamples);
     }
 
     // Create a temporary buffer for the plugin
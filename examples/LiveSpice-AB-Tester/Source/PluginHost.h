@@ -32,6 +32,7 @@ public:
     
     // Get underlying processor for direct access
     juce::AudioProcessor* getProcessor() { return plugin.get(); }
+    const juce::AudioProcessor* getProcessor() const { return plugin.get(); }
 
     // Audio processing
     void prepareToPlay(double sampleRate, int samplesPerBlock);
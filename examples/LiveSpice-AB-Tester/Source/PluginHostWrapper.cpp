@@ -13,8 +13,7 @@ PluginHostWrapper::PluginHostWrapper(std::unique_ptr<PluginHost> host)
 
 bool PluginHostWrapper::loadPlugin(const juce::String& pluginPath)
 {
-    parametersCached = false;
-    cachedParameters.clear();
+    clearParameterCache();
     
     bool success = pluginHost->loadPlugin(pluginPath);
     
@@ -34,8 +33,7 @@ bool PluginHostWrapper::loadPlugin(const juce::String& pluginPath)
 void PluginHostWrapper::unloadPlugin()
 {
     pluginHost->unloadPlugin();
-    parametersCached = false;
-    cachedParameters.clear();
+    clearParameterCache();
     logDebug("PluginHostWrapper: Plugin unloaded", LogLevel::INFO);
 }
 
@@ -90,22 +88,13 @@ bool PluginHostWrapper::setParameter(const juce::String& parameterId, float valu
         return false;
     }
 
+    const int index = getParameterIndex(parameterId);
+    if (index >= 0)
+        return setParameterByIndex(index, value);
+
+    // Not in the cache: let PluginHost search the plugin by name
     pluginHost->setParameter(parameterId, value);
-    
-    // Update cache
-    if (parametersCached)
-    {
-        for (auto& param : cachedParameters)
-        {
-            if (param.id.equalsIgnoreCase(parameterId))
-            {
-                param.currentValue = value;
-                break;
-            }
-        }
-    }
-    
-    logDebug("PluginHostWrapper: Set parameter " + parameterId + " = " + juce::String(value), LogLevel::DEBUG);
+    logDebug("PluginHostWrapper: Set uncached parameter " + parameterId + " = " + juce::String(value), LogLevel::DEBUG);
     return true;
 }
 
@@ -114,9 +103,48 @@ float PluginHostWrapper::getParameter(const juce::String& parameterId) const
     if (!isLoaded())
         return 0.0f;
 
+    const int index = getParameterIndex(parameterId);
+    if (index >= 0)
+        return getParameterByIndex(index);
+
     return pluginHost->getParameter(parameterId);
 }
 
+int PluginHostWrapper::getParameterIndex(const juce::String& parameterId) const
+{
+    if (!parametersCached)
+        updateParameterCache();
+
+    auto it = parameterIndices.find(parameterId.toLowerCase());
+    return it != parameterIndices.end() ? it->second : -1;
+}
+
+bool PluginHostWrapper::setParameterByIndex(int index, float value)
+{
+    if (!isLoaded() || index < 0 || index >= (int) cachedParameters.size())
+        return false;
+
+    auto& param = cachedParameters[(size_t) index];
+    if (auto* hostParam = hostParameters[(size_t) index])
+        hostParam->setValue(value);
+    else
+        pluginHost->setParameter(param.id, value);
+
+    param.currentValue = value;
+    return true;
+}
+
+float PluginHostWrapper::getParameterByIndex(int index) const
+{
+    if (!isLoaded() || index < 0 || index >= (int) cachedParameters.size())
+        return 0.0f;
+
+    if (auto* hostParam = hostParameters[(size_t) index])
+        return hostParam->getValue();
+
+    return cachedParameters[(size_t) index].currentValue;
+}
+
 juce::String PluginHostWrapper::getName() const
 {
     if (!isLoaded())
@@ -132,22 +160,35 @@ bool PluginHostWrapper::isLoaded() const
 
 void PluginHostWrapper::reset()
 {
+    // Clear the plugin's DSP state (delay lines, filters); parameters are kept
     if (isLoaded())
-    {
-        // Reset by unloading/reloading would lose state
-        // Instead, reset parameters to defaults
-        auto params = getParameters();
-        for (const auto& param : params)
-        {
-            setParameter(param.id, param.defaultValue);
-        }
-        logDebug("PluginHostWrapper: Reset to defaults", LogLevel::INFO);
-    }
+        pluginHost->getProcessor()->reset();
+}
+
+void PluginHostWrapper::setNonRealtime(bool isNonRealtime)
+{
+    if (isLoaded())
+        pluginHost->getProcessor()->setNonRealtime(isNonRealtime);
+}
+
+int PluginHostWrapper::getLatencySamples() const
+{
+    return isLoaded() ? pluginHost->getProcessor()->getLatencySamples() : 0;
+}
+
+void PluginHostWrapper::clearParameterCache()
+{
+    parametersCached = false;
+    cachedParameters.clear();
+    hostParameters.clear();
+    parameterIndices.clear();
 }
 
 void PluginHostWrapper::updateParameterCache() const
 {
     cachedParameters.clear();
+    hostParameters.clear();
+    parameterIndices.clear();
     
     if (!isLoaded())
     {
@@ -158,6 +199,12 @@ void PluginHostWrapper::updateParameterCache() const
     // Get parameters from PluginHost
     auto hostParams = pluginHost->getParameterList();
     
+    // Plugin parameter objects by name, so indexed sets skip PluginHost's search
+    std::map<juce::String, juce::AudioProcessorParameter*> byName;
+    for (auto* p : pluginHost->getProcessor()->getParameters())
+        if (p)
+            byName.emplace(p->getName(100).toLowerCase(), p);
+    
     // Convert PluginHost::ParameterInfo to IAudioProcessor::ParameterInfo
     for (const auto& hostParam : hostParams)
     {
@@ -168,6 +215,10 @@ void PluginHostWrapper::updateParameterCache() const
         param.currentValue = hostParam.value;
         param.label = "";  // PluginHost doesn't provide labels
         
+        auto key = param.id.toLowerCase();
+        auto hostParam = byName.find(key);
+        parameterIndices.emplace(key, (int) cachedParameters.size());
+        hostParameters.push_back(hostParam != byName.end() ? hostParam->second : nullptr);
         cachedParameters.push_back(param);
     }
     
@@ -2,6 +2,7 @@
 
 #include "IAudioProcessor.h"
 #include "PluginHost.h"
+#include <map>
 #include <memory>
 
 /**
@@ -29,12 +30,17 @@ public:
     std::vector<ParameterInfo> getParameters() const override;
     bool setParameter(const juce::String& parameterId, float value) override;
     float getParameter(const juce::String& parameterId) const override;
+    int getParameterIndex(const juce::String& parameterId) const override;
+    bool setParameterByIndex(int index, float value) override;
+    float getParameterByIndex(int index) const override;
 
     juce::String getName() const override;
     juce::String getType() const override { return "VST3"; }
     bool isLoaded() const override;
 
     void reset() override;
+    void setNonRealtime(bool isNonRealtime) override;
+    int getLatencySamples() const override;
 
     // Access to underlying PluginHost (for migration compatibility)
     PluginHost* getPluginHost() { return pluginHost.get(); }
@@ -43,11 +49,14 @@ public:
 private:
     std::unique_ptr<PluginHost> pluginHost;
 
-    // Cache parameters to avoid repeated parsing
+    // Cache parameters to avoid repeated parsing; rebuilt only on (re)load
     mutable std::vector<ParameterInfo> cachedParameters;
+    mutable std::vector<juce::AudioProcessorParameter*> hostParameters;   // Per cache entry; null = set by id
+    mutable std::map<juce::String, int> parameterIndices;                  // Lower-case id -> cache entry
     mutable bool parametersCached{false};
 
     void updateParameterCache() const;
+    void clearParameterCache();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PluginHostWrapper)
 };
@@ -0,0 +1,134 @@
+#include "ProcessorMeter.h"
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    constexpr double rollingTimeConstant = 1.0;   // Seconds
+
+    uint64_t pack(ProcessorMeter::Block block)
+    {
+        uint32_t words[2];
+        std::memcpy(&words[0], &block.microseconds, sizeof(float));
+        std::memcpy(&words[1], &block.load, sizeof(float));
+        return (uint64_t) words[0] | ((uint64_t) words[1] << 32);
+    }
+
+    ProcessorMeter::Block unpack(uint64_t bits)
+    {
+        const uint32_t words[2] = { (uint32_t) bits, (uint32_t) (bits >> 32) };
+        ProcessorMeter::Block block;
+        std::memcpy(&block.microseconds, &words[0], sizeof(float));
+        std::memcpy(&block.load, &words[1], sizeof(float));
+        return block;
+    }
+}
+
+void ProcessorMeter::prepare(double sampleRate)
+{
+    secondsPerSample.store(1.0 / juce::jmax(1.0, sampleRate), std::memory_order_relaxed);
+    reset();
+}
+
+void ProcessorMeter::reset()
+{
+    lastMicroseconds.store(0.0, std::memory_order_relaxed);
+    rollingLoad.store(0.0, std::memory_order_relaxed);
+    worstLoad.store(0.0, std::memory_order_relaxed);
+    worstMicroseconds.store(0.0, std::memory_order_relaxed);
+    numBlocks.store(0, std::memory_order_relaxed);
+    overruns.store(0, std::memory_order_relaxed);
+    for (auto& bin : histogram)
+        bin.store(0, std::memory_order_relaxed);
+    historyWrite.store(0, std::memory_order_relaxed);
+}
+
+void ProcessorMeter::stop(int64_t startTicks, int numSamples)
+{
+    if (numSamples <= 0)
+        return;
+
+    const double seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    const double deadline = numSamples * secondsPerSample.load(std::memory_order_relaxed);
+    const double load = seconds / deadline;
+    const double microseconds = seconds * 1.0e6;
+
+    // One-pole smoothing over wall time, so the time constant holds for any block size
+    const double alpha = 1.0 - std::exp(-deadline / rollingTimeConstant);
+    const double rolling = rollingLoad.load(std::memory_order_relaxed);
+    rollingLoad.store(rolling + alpha * (load - rolling), std::memory_order_relaxed);
+
+    lastMicroseconds.store(microseconds, std::memory_order_relaxed);
+    if (load > worstLoad.load(std::memory_order_relaxed))
+    {
+        worstLoad.store(load, std::memory_order_relaxed);
+        worstMicroseconds.store(microseconds, std::memory_order_relaxed);
+    }
+    if (load > 1.0)
+        overruns.fetch_add(1, std::memory_order_relaxed);
+
+    size_t bin = 0;
+    while (bin < binEdges.size() && load >= binEdges[bin])
+        ++bin;
+    histogram[bin].fetch_add(1, std::memory_order_relaxed);
+
+    const uint64_t write = historyWrite.load(std::memory_order_relaxed);
+    history[(size_t) (write % historySize)].store(pack({ (float) microseconds, (float) load }), std::memory_order_relaxed);
+    historyWrite.store(write + 1, std::memory_order_release);
+    numBlocks.fetch_add(1, std::memory_order_relaxed);
+}
+
+ProcessorMeter::Snapshot ProcessorMeter::getSnapshot() const
+{
+    Snapshot s;
+    s.lastMicroseconds = lastMicroseconds.load(std::memory_order_relaxed);
+    s.rollingLoad = rollingLoad.load(std::memory_order_relaxed);
+    s.worstLoad = worstLoad.load(std::memory_order_relaxed);
+    s.worstMicroseconds = worstMicroseconds.load(std::memory_order_relaxed);
+    s.numBlocks = numBlocks.load(std::memory_order_relaxed);
+    s.overruns = overruns.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < histogram.size(); ++i)
+        s.histogram[i] = histogram[i].load(std::memory_order_relaxed);
+    return s;
+}
+
+std::vector<ProcessorMeter::Block> ProcessorMeter::getHistory() const
+{
+    const uint64_t end = historyWrite.load(std::memory_order_acquire);
+    const uint64_t count = juce::jmin(end, (uint64_t) historySize);
+
+    std::vector<Block> blocks;
+    blocks.reserve((size_t) count);
+    for (uint64_t i = end - count; i < end; ++i)
+        blocks.push_back(unpack(history[(size_t) (i % historySize)].load(std::memory_order_relaxed)));
+    return blocks;
+}
+
+juce::String ProcessorMeter::toCsv(const juce::String& name, const ProcessorMeter& meter)
+{
+    const auto s = meter.getSnapshot();
+    juce::String csv;
+
+    csv << "processor,blocks,overruns,rolling_load_percent,worst_load_percent,worst_us,last_us\n";
+    csv << name << "," << (juce::int64) s.numBlocks << "," << (juce::int64) s.overruns << ","
+        << juce::String(s.rollingLoad * 100.0, 3) << "," << juce::String(s.worstLoad * 100.0, 3) << ","
+        << juce::String(s.worstMicroseconds, 2) << "," << juce::String(s.lastMicroseconds, 2) << "\n\n";
+
+    csv << "processor,load_from_percent,load_to_percent,blocks\n";
+    for (int i = 0; i < numBins; ++i)
+    {
+        const float from = i == 0 ? 0.0f : binEdges[(size_t) i - 1];
+        csv << name << "," << juce::String(from * 100.0f, 0) << ","
+            << (i < (int) binEdges.size() ? juce::String(binEdges[(size_t) i] * 100.0f, 0) : juce::String("inf")) << ","
+            << (juce::int64) s.histogram[(size_t) i] << "\n";
+    }
+    csv << "\n";
+
+    csv << "processor,block,microseconds,load_percent\n";
+    const auto blocks = meter.getHistory();
+    for (size_t i = 0; i < blocks.size(); ++i)
+        csv << name << "," << (int) i << "," << juce::String(blocks[i].microseconds, 2) << ","
+            << juce::String(blocks[i].load * 100.0f, 3) << "\n";
+
+    return csv;
+}
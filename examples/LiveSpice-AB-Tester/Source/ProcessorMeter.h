@@ -0,0 +1,86 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+/**
+ * ProcessorMeter - CPU load of one processor slot, measured per block
+ *
+ * Responsibilities:
+ * - Times each processBlock() call with the high-resolution tick counter
+ * - Relates it to the block's deadline (numSamples / sampleRate): a load
+ *   of 1.0 means the processor alone used the whole callback budget
+ * - Keeps a rolling load (one-second time constant), the worst block, a
+ *   histogram of block loads with fine bins towards the deadline, and the
+ *   most recent blocks for export
+ *
+ * Real-time safety:
+ * - One writer: the thread running the slot (the audio thread, or the
+ *   router's worker for B). Recording is a few relaxed atomic stores, no
+ *   locks, no allocation
+ * - Any thread may read a snapshot; values are individually consistent,
+ *   a snapshot taken mid-block may mix two neighbouring blocks
+ */
+class ProcessorMeter
+{
+public:
+    // Upper edges of the histogram bins, as a fraction of the deadline; the
+    // last bin counts every block over budget
+    static constexpr std::array<float, 11> binEdges{ 0.05f, 0.1f, 0.2f, 0.3f, 0.4f, 0.5f,
+                                                     0.6f, 0.7f, 0.8f, 0.9f, 1.0f };
+    static constexpr int numBins = (int) binEdges.size() + 1;
+    static constexpr int historySize = 4096;
+
+    struct Snapshot
+    {
+        double lastMicroseconds = 0.0;
+        double rollingLoad = 0.0;        // Fraction of the deadline, smoothed
+        double worstLoad = 0.0;
+        double worstMicroseconds = 0.0;
+        uint64_t numBlocks = 0;
+        uint64_t overruns = 0;           // Blocks over the deadline
+        std::array<uint64_t, numBins> histogram{};
+    };
+
+    struct Block
+    {
+        float microseconds = 0.0f;
+        float load = 0.0f;
+    };
+
+    void prepare(double sampleRate);
+
+    // Clear statistics (any thread; a block in flight may still land)
+    void reset();
+
+    // Timing bracket around one processBlock() call (writer thread)
+    static int64_t start() { return juce::Time::getHighResolutionTicks(); }
+    void stop(int64_t startTicks, int numSamples);
+
+    Snapshot getSnapshot() const;
+
+    // Most recent blocks, oldest first, at most historySize
+    std::vector<Block> getHistory() const;
+
+    // Summary, histogram and history as CSV, one section per table
+    static juce::String toCsv(const juce::String& name, const ProcessorMeter& meter);
+
+private:
+    std::atomic<double> secondsPerSample{1.0 / 44100.0};
+
+    std::atomic<double> lastMicroseconds{0.0};
+    std::atomic<double> rollingLoad{0.0};
+    std::atomic<double> worstLoad{0.0};
+    std::atomic<double> worstMicroseconds{0.0};
+    std::atomic<uint64_t> numBlocks{0};
+    std::atomic<uint64_t> overruns{0};
+    std::array<std::atomic<uint64_t>, numBins> histogram{};
+
+    // Ring of recent blocks, one packed Block per entry
+    std::array<std::atomic<uint64_t>, historySize> history{};
+    std::atomic<uint64_t> historyWrite{0};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ProcessorMeter)
+};
@@ -0,0 +1,426 @@
+#include "SchematicCanvas.h"
+#include "LiveSpiceParser.h"
+#include <set>
+
+namespace
+{
+    constexpr float leadLength = 20.0f;       // Symbols have their pins 20 units either side of Position
+    constexpr float bodyLength = 26.0f;
+    constexpr float bodyWidth = 12.0f;
+    constexpr float labelWidth = 60.0f;
+
+    const juce::Colour backgroundColour(0xff1e1e1e);
+    const juce::Colour wireColour(0xff7fb0d0);
+    const juce::Colour bodyColour(0xff3a3a3a);
+    const juce::Colour outlineColour(0xffd0d0d0);
+    const juce::Colour controlColour(0xffe0a040);
+
+    juce::String glyphFor(LiveSpice::ComponentType type)
+    {
+        using LiveSpice::ComponentType;
+        switch (type)
+        {
+            case ComponentType::Resistor:         return "R";
+            case ComponentType::Capacitor:        return "C";
+            case ComponentType::Inductor:         return "L";
+            case ComponentType::VariableResistor: return "VR";
+            case ComponentType::Potentiometer:    return "P";
+            case ComponentType::Diode:            return "D";
+            case ComponentType::Transformer:      return "T";
+            case ComponentType::OpAmp:            return "U";
+            case ComponentType::Transistor:       return "Q";
+            case ComponentType::Speaker:          return "SP";
+            case ComponentType::Input:            return "IN";
+            case ComponentType::Output:           return "OUT";
+            case ComponentType::Ground:           return "GND";
+            case ComponentType::Rail:             return "V+";
+            default:                              return "?";
+        }
+    }
+}
+
+SchematicCanvas::SchematicCanvas()
+{
+    setOpaque(true);
+}
+
+SchematicCanvas::~SchematicCanvas() = default;
+
+void SchematicCanvas::setSchematic(const LiveSpice::Schematic& schematic)
+{
+    std::vector<Item> newItems;
+    const auto& netlist = schematic.getNetlist();
+
+    for (const auto& wire : netlist.getWires())
+    {
+        Item item;
+        item.isWire = true;
+        item.line = { (float) wire.nodeA_X, (float) wire.nodeA_Y, (float) wire.nodeB_X, (float) wire.nodeB_Y };
+        item.bounds = juce::Rectangle<float>(item.line.getStart(), item.line.getEnd()).expanded(2.0f);
+        item.key = "W" + juce::String(wire.nodeA_X) + "," + juce::String(wire.nodeA_Y) + ","
+                 + juce::String(wire.nodeB_X) + "," + juce::String(wire.nodeB_Y);
+        newItems.push_back(item);
+    }
+
+    for (const auto& pair : netlist.getComponents())
+    {
+        const auto& comp = *pair.second;
+        if (comp.getType() == LiveSpice::ComponentType::Wire)
+            continue;
+
+        Item item;
+        const juce::Point<float> centre((float) comp.getPosX(), (float) comp.getPosY());
+        const bool horizontal = std::abs(comp.getRotation()) % 2 == 1;
+        item.line = horizontal ? juce::Line<float>(centre.x - leadLength, centre.y, centre.x + leadLength, centre.y)
+                               : juce::Line<float>(centre.x, centre.y - leadLength, centre.x, centre.y + leadLength);
+        item.body = horizontal ? juce::Rectangle<float>(bodyLength, bodyWidth).withCentre(centre)
+                               : juce::Rectangle<float>(bodyWidth, bodyLength).withCentre(centre);
+        item.bounds = juce::Rectangle<float>(item.line.getStart(), item.line.getEnd())
+                          .getUnion(item.body)
+                          .getUnion(juce::Rectangle<float>(labelWidth, 12.0f)
+                                        .withPosition(item.body.getRight() + 2.0f, centre.y - 6.0f))
+                          .expanded(2.0f);
+        item.name = comp.getName();
+        item.glyph = glyphFor(comp.getType());
+        item.isControl = comp.getType() == LiveSpice::ComponentType::Potentiometer
+                      || comp.getType() == LiveSpice::ComponentType::VariableResistor;
+        item.key = juce::String(LiveSpice::componentTypeName(comp.getType())) + ":" + item.name + "@"
+                 + juce::String(comp.getPosX()) + "," + juce::String(comp.getPosY()) + "/" + juce::String(comp.getRotation());
+        newItems.push_back(item);
+    }
+
+    // Same circuit shown already: only the tiles under changed items go
+    const bool firstSchematic = items.empty();
+    if (!firstSchematic)
+    {
+        std::set<juce::String> oldKeys, newKeys;
+        for (const auto& item : items)
+            oldKeys.insert(item.key);
+        for (const auto& item : newItems)
+            newKeys.insert(item.key);
+
+        for (const auto& item : items)
+            if (newKeys.count(item.key) == 0)
+                invalidate(item.bounds);
+        for (const auto& item : newItems)
+            if (oldKeys.count(item.key) == 0)
+                invalidate(item.bounds);
+    }
+
+    items = std::move(newItems);
+    hoveredItem = -1;
+    extent = {};
+    for (const auto& item : items)
+        extent = extent.isEmpty() ? item.bounds : extent.getUnion(item.bounds);
+    buildIndex();
+
+    if (firstSchematic)
+    {
+        tiles.clear();
+        fitted = false;
+        zoomToFit();
+    }
+}
+
+void SchematicCanvas::setControlValue(const juce::String& componentName, float value)
+{
+    controlValues[componentName] = value;
+
+    // Dynamic layer only: repaint the control, tiles stay
+    for (const auto& item : items)
+        if (item.isControl && item.name == componentName)
+            repaint(toScreen(item.bounds).getSmallestIntegerContainer());
+}
+
+juce::Rectangle<float> SchematicCanvas::toScreen(juce::Rectangle<float> schematicArea) const
+{
+    const float scale = getScale();
+    return { schematicArea.getX() * scale - pan.x, schematicArea.getY() * scale - pan.y,
+             schematicArea.getWidth() * scale, schematicArea.getHeight() * scale };
+}
+
+juce::Rectangle<float> SchematicCanvas::toSchematic(juce::Rectangle<float> screenArea) const
+{
+    const float scale = getScale();
+    return { (screenArea.getX() + pan.x) / scale, (screenArea.getY() + pan.y) / scale,
+             screenArea.getWidth() / scale, screenArea.getHeight() / scale };
+}
+
+void SchematicCanvas::buildIndex()
+{
+    cells.clear();
+    for (int i = 0; i < (int) items.size(); ++i)
+    {
+        const auto& b = items[(size_t) i].bounds;
+        const int x0 = (int) std::floor(b.getX() / cellSize), x1 = (int) std::floor(b.getRight() / cellSize);
+        const int y0 = (int) std::floor(b.getY() / cellSize), y1 = (int) std::floor(b.getBottom() / cellSize);
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                cells[cellKey(x, y)].push_back(i);
+    }
+    visitStamps.assign(items.size(), 0);
+    visitStamp = 0;
+}
+
+template <typename Visitor>
+void SchematicCanvas::visitItems(juce::Rectangle<float> schematicArea, Visitor&& visit) const
+{
+    // Items spanning several cells are visited once per query
+    if (++visitStamp == 0)
+    {
+        std::fill(visitStamps.begin(), visitStamps.end(), 0);
+        visitStamp = 1;
+    }
+
+    const int x0 = (int) std::floor(schematicArea.getX() / cellSize), x1 = (int) std::floor(schematicArea.getRight() / cellSize);
+    const int y0 = (int) std::floor(schematicArea.getY() / cellSize), y1 = (int) std::floor(schematicArea.getBottom() / cellSize);
+    for (int y = y0; y <= y1; ++y)
+    {
+        for (int x = x0; x <= x1; ++x)
+        {
+            const auto cell = cells.find(cellKey(x, y));
+            if (cell == cells.end())
+                continue;
+            for (const int i : cell->second)
+            {
+                if (visitStamps[(size_t) i] == visitStamp)
+                    continue;
+                visitStamps[(size_t) i] = visitStamp;
+                if (items[(size_t) i].bounds.intersects(schematicArea))
+                    visit(i, items[(size_t) i]);
+            }
+        }
+    }
+}
+
+int SchematicCanvas::findItemAt(juce::Point<float> screenPosition) const
+{
+    const auto area = toSchematic(juce::Rectangle<float>(4.0f, 4.0f).withCentre(screenPosition));
+    int found = -1;
+    visitItems(area, [&](int i, const Item& item)
+    {
+        // Components win over the wires running into them
+        if (!item.isWire && item.body.expanded(2.0f).intersects(area))
+            found = i;
+        else if (item.isWire && found < 0)
+        {
+            juce::Point<float> nearest;
+            if (item.line.getDistanceFromPoint(area.getCentre(), nearest) <= area.getWidth())
+                found = i;
+        }
+    });
+    return found;
+}
+
+void SchematicCanvas::zoomToFit()
+{
+    if (extent.isEmpty() || getWidth() <= 0 || getHeight() <= 0)
+        return;
+
+    const float fitScale = juce::jmin(getWidth() / extent.getWidth(), getHeight() / extent.getHeight()) * 0.9f;
+    zoom = juce::jlimit(minZoom, maxZoom, (int) std::floor(2.0f * std::log2(fitScale)));
+    const float scale = getScale();
+    pan = { extent.getCentreX() * scale - getWidth() * 0.5f, extent.getCentreY() * scale - getHeight() * 0.5f };
+    fitted = true;
+    repaint();
+}
+
+const juce::Image& SchematicCanvas::getTile(const TileKey& key)
+{
+    auto& tile = tiles[key];
+    if (!tile.image.isValid())
+    {
+        tile.image = juce::Image(juce::Image::ARGB, tileSize, tileSize, true);
+        renderTile(key, tile.image);
+    }
+    tile.lastUsed = paintCounter;
+    return tile.image;
+}
+
+void SchematicCanvas::renderTile(const TileKey& key, juce::Image& image) const
+{
+    const float scale = std::pow(2.0f, (float) key.zoom * 0.5f);
+    const juce::Rectangle<float> tileArea((float) (key.x * tileSize) / scale, (float) (key.y * tileSize) / scale,
+                                          (float) tileSize / scale, (float) tileSize / scale);
+
+    juce::Graphics g(image);
+    g.addTransform(juce::AffineTransform::scale(scale).translated((float) (-key.x * tileSize), (float) (-key.y * tileSize)));
+    visitItems(tileArea, [&](int, const Item& item) { if (item.isWire) drawItem(g, item, scale); });
+    visitItems(tileArea, [&](int, const Item& item) { if (!item.isWire) drawItem(g, item, scale); });
+}
+
+void SchematicCanvas::drawItem(juce::Graphics& g, const Item& item, float scale) const
+{
+    const float stroke = 1.5f / juce::jmin(scale, 1.5f);
+
+    if (item.isWire)
+    {
+        g.setColour(wireColour);
+        g.drawLine(item.line, stroke);
+        return;
+    }
+
+    g.setColour(wireColour);
+    g.drawLine(item.line, stroke);
+    g.setColour(bodyColour);
+    g.fillRect(item.body);
+    g.setColour(outlineColour);
+    g.drawRect(item.body, stroke * 0.75f);
+
+    // Text only where it is legible
+    if (scale >= 0.7f)
+    {
+        g.setFont(juce::Font(8.0f));
+        g.drawText(item.glyph, item.body, juce::Justification::centred, false);
+        g.drawText(item.name, juce::Rectangle<float>(labelWidth, 12.0f)
+                                  .withPosition(item.body.getRight() + 2.0f, item.body.getCentreY() - 6.0f),
+                   juce::Justification::centredLeft, true);
+    }
+}
+
+void SchematicCanvas::invalidate(juce::Rectangle<float> schematicArea)
+{
+    // Every zoom level's tiles under the area
+    for (auto it = tiles.begin(); it != tiles.end();)
+    {
+        const float scale = std::pow(2.0f, (float) it->first.zoom * 0.5f);
+        const juce::Rectangle<float> tileArea((float) (it->first.x * tileSize) / scale, (float) (it->first.y * tileSize) / scale,
+                                              (float) tileSize / scale, (float) tileSize / scale);
+        it = tileArea.intersects(schematicArea) ? tiles.erase(it) : std::next(it);
+    }
+    repaint(toScreen(schematicArea).getSmallestIntegerContainer());
+}
+
+void SchematicCanvas::evictTiles()
+{
+    while ((int) tiles.size() > maxCachedTiles)
+    {
+        auto oldest = std::min_element(tiles.begin(), tiles.end(),
+                                       [](const auto& a, const auto& b) { return a.second.lastUsed < b.second.lastUsed; });
+        if (oldest->second.lastUsed == paintCounter)
+            break;   // Everything left is on screen
+        tiles.erase(oldest);
+    }
+}
+
+void SchematicCanvas::resized()
+{
+    if (!fitted)
+        zoomToFit();
+}
+
+void SchematicCanvas::paint(juce::Graphics& g)
+{
+    g.fillAll(backgroundColour);
+    if (items.empty())
+    {
+        g.setColour(juce::Colours::grey);
+        g.drawText("No schematic", getLocalBounds(), juce::Justification::centred);
+        return;
+    }
+    
+    ++paintCounter;
+    const float scale = getScale();
+
+    // Static layer: only the tiles under the clip
+    const auto clip = g.getClipBounds().toFloat() + pan;
+    const int tx0 = (int) std::floor(clip.getX() / tileSize), tx1 = (int) std::floor((clip.getRight() - 1.0f) / tileSize);
+    const int ty0 = (int) std::floor(clip.getY() / tileSize), ty1 = (int) std::floor((clip.getBottom() - 1.0f) / tileSize);
+    for (int ty = ty0; ty <= ty1; ++ty)
+        for (int tx = tx0; tx <= tx1; ++tx)
+            g.drawImageAt(getTile({ zoom, tx, ty }), juce::roundToInt(tx * tileSize - pan.x), juce::roundToInt(ty * tileSize - pan.y));
+    evictTiles();
+
+    // Dynamic layer over the same clip
+    const auto visible = toSchematic(g.getClipBounds().toFloat());
+    visitItems(visible, [&](int i, const Item& item)
+    {
+        const auto body = toScreen(item.body);
+        if (i == hoveredItem)
+        {
+            g.setColour(juce::Colours::yellow.withAlpha(0.8f));
+            if (item.isWire)
+                g.drawLine({ item.line.getStart() * scale - pan, item.line.getEnd() * scale - pan }, 3.0f);
+            else
+                g.drawRect(body.expanded(2.0f), 2.0f);
+        }
+        if (item.isControl)
+        {
+            const auto value = controlValues.find(item.name);
+            if (value != controlValues.end())
+            {
+                // Wiper position along the body
+                auto bar = body.withHeight(juce::jmax(2.0f, body.getHeight() * 0.15f)).withBottomY(body.getBottom() + body.getHeight() * 0.3f);
+                g.setColour(controlColour.withAlpha(0.3f));
+                g.fillRect(bar);
+                g.setColour(controlColour);
+                g.fillRect(bar.withWidth(bar.getWidth() * juce::jlimit(0.0f, 1.0f, value->second)));
+            }
+        }
+    });
+
+    if (hoveredItem >= 0 && !items[(size_t) hoveredItem].isWire)
+    {
+        const auto& item = items[(size_t) hoveredItem];
+        g.setColour(juce::Colours::white);
+        g.setFont(juce::Font(12.0f));
+        g.drawText(item.name, toScreen(item.body).translated(0.0f, -16.0f).withHeight(14.0f).withWidth(120.0f),
+                   juce::Justification::centredLeft, false);
+    }
+}
+
+void SchematicCanvas::mouseMove(const juce::MouseEvent& e)
+{
+    const int found = findItemAt(e.position);
+    if (found == hoveredItem)
+        return;
+
+    // Old and new highlight only, the name row above each included
+    for (const int i : { hoveredItem, found })
+    {
+        if (i < 0)
+            continue;
+        const auto area = toScreen(items[(size_t) i].bounds).expanded(4.0f);
+        repaint(area.withTop(area.getY() - 16.0f).withWidth(juce::jmax(area.getWidth(), 130.0f)).getSmallestIntegerContainer());
+    }
+    hoveredItem = found;
+}
+
+void SchematicCanvas::mouseExit(const juce::MouseEvent&)
+{
+    if (hoveredItem >= 0)
+        repaint();
+    hoveredItem = -1;
+}
+
+void SchematicCanvas::mouseDown(const juce::MouseEvent&)
+{
+    dragStartPan = pan;
+}
+
+void SchematicCanvas::mouseDrag(const juce::MouseEvent& e)
+{
+    // Pan by whole pixels so cached tiles land on the pixel grid
+    pan = { std::round(dragStartPan.x - (float) e.getDistanceFromDragStartX()),
+            std::round(dragStartPan.y - (float) e.getDistanceFromDragStartY()) };
+    repaint();
+}
+
+void SchematicCanvas::mouseDoubleClick(const juce::MouseEvent&)
+{
+    zoomToFit();
+}
+
+void SchematicCanvas::mouseWheelMove(const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel)
+{
+    const int newZoom = juce::jlimit(minZoom, maxZoom, zoom + (wheel.deltaY > 0.0f ? 1 : wheel.deltaY < 0.0f ? -1 : 0));
+    if (newZoom == zoom)
+        return;
+
+    // Keep the point under the cursor in place
+    const auto anchor = (e.position + pan) / getScale();
+    zoom = newZoom;
+    pan = anchor * getScale() - e.position;
+    pan = { std::round(pan.x), std::round(pan.y) };
+    repaint();
+}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <juce_gui_basics/juce_gui_basics.h>
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace LiveSpice
+{
+    class Schematic;
+}
+
+/**
+ * SchematicCanvas - Pannable, zoomable drawing of a schematic's wires and parts
+ *
+ * Responsibilities:
+ * - Static layer (wires, component bodies, names) rendered into 256 px
+ *   tiles per zoom level and kept in a least-recently-used cache, so panning
+ *   and repeated zooming blit images instead of redrawing the circuit
+ * - Uniform-grid spatial index over item bounds: a tile, a repaint clip or
+ *   a hover test only visits the items in the cells it overlaps
+ * - Dynamic layer (hover highlight, control positions) drawn over the tiles
+ *   each paint, repainting only the screen area of what changed
+ * - setSchematic() on an already shown circuit diffs the items and drops
+ *   only the tiles under parts that were added, removed or moved
+ *
+ * Message thread only.
+ */
+class SchematicCanvas : public juce::Component
+{
+public:
+    SchematicCanvas();
+    ~SchematicCanvas() override;
+
+    void setSchematic(const LiveSpice::Schematic& schematic);
+
+    // Control (pot) position 0..1 shown on the named component
+    void setControlValue(const juce::String& componentName, float value);
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+    void mouseMove(const juce::MouseEvent& e) override;
+    void mouseExit(const juce::MouseEvent& e) override;
+    void mouseDown(const juce::MouseEvent& e) override;
+    void mouseDrag(const juce::MouseEvent& e) override;
+    void mouseDoubleClick(const juce::MouseEvent& e) override;
+    void mouseWheelMove(const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel) override;
+
+    // Fit the whole circuit into the component
+    void zoomToFit();
+
+private:
+    static constexpr int tileSize = 256;          // Pixels
+    static constexpr int maxCachedTiles = 128;    // 32 MB of ARGB tiles
+    static constexpr float cellSize = 128.0f;     // Spatial index cell, schematic units
+    static constexpr int minZoom = -12;           // Zoom steps of sqrt(2)
+    static constexpr int maxZoom = 8;
+
+    struct Item
+    {
+        bool isWire = false;
+        juce::Line<float> line;                   // Wires
+        juce::Rectangle<float> body;              // Components
+        juce::Rectangle<float> bounds;            // Drawn extent, stroke and label included
+        juce::String name;
+        juce::String glyph;
+        juce::String key;                         // Identity for diffing: type, name, geometry
+        bool isControl = false;
+    };
+
+    std::vector<Item> items;
+    juce::Rectangle<float> extent;
+
+    // Spatial index: cell -> items overlapping it
+    std::unordered_map<juce::int64, std::vector<int>> cells;
+    mutable std::vector<juce::uint32> visitStamps;
+    mutable juce::uint32 visitStamp = 0;
+
+    // Tile cache, keyed by zoom step and tile position in zoomed pixels
+    struct TileKey
+    {
+        int zoom, x, y;
+        bool operator<(const TileKey& other) const
+        {
+            return std::tie(zoom, x, y) < std::tie(other.zoom, other.x, other.y);
+        }
+    };
+    struct Tile
+    {
+        juce::Image image;
+        juce::uint64 lastUsed = 0;
+    };
+    std::map<TileKey, Tile> tiles;
+    juce::uint64 paintCounter = 0;
+
+    // View: schematic point p shows at p * scale - pan
+    int zoom = 0;
+    juce::Point<float> pan;
+    juce::Point<float> dragStartPan;
+    bool fitted = false;
+
+    int hoveredItem = -1;
+    std::map<juce::String, float> controlValues;
+
+    float getScale() const { return std::pow(2.0f, (float) zoom * 0.5f); }
+    juce::Rectangle<float> toScreen(juce::Rectangle<float> schematicArea) const;
+    juce::Rectangle<float> toSchematic(juce::Rectangle<float> screenArea) const;
+
+    static juce::int64 cellKey(int x, int y) { return ((juce::int64) x << 32) ^ (juce::uint32) y; }
+    void buildIndex();
+    template <typename Visitor>
+    void visitItems(juce::Rectangle<float> schematicArea, Visitor&& visit) const;
+    int findItemAt(juce::Point<float> screenPosition) const;
+
+    const juce::Image& getTile(const TileKey& key);
+    void renderTile(const TileKey& key, juce::Image& image) const;
+    void invalidate(juce::Rectangle<float> schematicArea);
+    void evictTiles();
+
+    void drawItem(juce::Graphics& g, const Item& item, float scale) const;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SchematicCanvas)
+};
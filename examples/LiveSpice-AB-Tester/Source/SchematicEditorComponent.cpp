@@ -1,21 +1,54 @@
 #include "SchematicEditorComponent.h"
+#include "NetlistCache.h"
 
 SchematicEditorComponent::SchematicEditorComponent(SchematicProcessor* processor)
     : processor(processor)
 {
     setOpaque(true);
     
+    addAndMakeVisible(canvas);
+    
     if (processor)
     {
         createControls();
+        loadSchematicIntoCanvas();
+        startTimer(500);
     }
 }
 
 SchematicEditorComponent::~SchematicEditorComponent()
 {
+    stopTimer();
     controls.clear();
 }
 
+void SchematicEditorComponent::loadSchematicIntoCanvas()
+{
+    shownReload = processor->getReloadCount();
+    
+    try
+    {
+        // Same cache the processor fills, so this is normally a mapped read
+        auto cacheDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                            .getChildFile("LiveSpiceNetlistCache");
+        LiveSpice::NetlistCache cache(cacheDir.getFullPathName().toStdString());
+        canvas.setSchematic(cache.load(processor->getSchematicFile().getFullPathName().toStdString()).schematic);
+        
+        for (const auto& param : processor->getParameters())
+            canvas.setControlValue(param.id, param.currentValue);
+    }
+    catch (const std::exception& e)
+    {
+        juce::Logger::writeToLog("SchematicEditorComponent: Cannot draw schematic: " + juce::String(e.what()));
+    }
+}
+
+void SchematicEditorComponent::timerCallback()
+{
+    if (processor->getReloadCount() != shownReload)
+        loadSchematicIntoCanvas();
+}
+
 void SchematicEditorComponent::createControls()
 {
     controls.clear();
@@ -72,6 +105,8 @@ void SchematicEditorComponent::createControls()
             if (valueLabelPtr)
                 valueLabelPtr->setText(juce::String(newValue, 2), juce::dontSendNotification);
             
+            canvas.setControlValue(paramId, newValue);
+            
             // Notify processor
             if (onParameterChanged)
             {
@@ -97,6 +132,7 @@ void SchematicEditorComponent::updateParameterUI(const juce::String& parameterId
         {
             ctrl->slider->setValue(value, juce::dontSendNotification);
             ctrl->valueLabel->setText(juce::String(value, 2), juce::dontSendNotification);
+            canvas.setControlValue(parameterId, value);
             break;
         }
     }
@@ -124,11 +160,13 @@ void SchematicEditorComponent::resized()
     area.removeFromTop(40);
     area.reduce(10, 10);
     
-    // Layout controls in a grid (2 columns for knobs)
+    // Layout controls in a grid (2 columns for knobs), the schematic to their right
     const int controlsPerRow = 2;
     const int controlSize = 100;
     const int spacing = 20;
     
+    canvas.setBounds(area.removeFromRight(juce::jmax(0, area.getWidth() - controlsPerRow * (controlSize + spacing))));
+    
     int row = 0;
     int col = 0;
     
@@ -2,14 +2,18 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "SchematicProcessor.h"
+#include "SchematicCanvas.h"
 
 /**
  * SchematicEditorComponent - Visual UI for schematic parameters
  * 
  * Displays interactive parameter controls (sliders) for the loaded schematic
  * Mirrors the control panel but with visual feedback specific to the schematic
+ * The circuit itself is drawn by a SchematicCanvas next to the knobs, and
+ * redrawn (changed regions only) when the processor hot-reloads the file
  */
-class SchematicEditorComponent : public juce::Component
+class SchematicEditorComponent : public juce::Component,
+                                 private juce::Timer
 {
 public:
     explicit SchematicEditorComponent(SchematicProcessor* processor);
@@ -37,7 +41,12 @@ private:
     
     std::vector<std::unique_ptr<ParameterControl>> controls;
     
+    SchematicCanvas canvas;
+    int shownReload = -1;   // Processor reload count the canvas reflects
+    
     void createControls();
+    void loadSchematicIntoCanvas();
+    void timerCallback() override;
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SchematicEditorComponent)
 };
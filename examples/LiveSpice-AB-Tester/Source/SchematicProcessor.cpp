@@ -1,6 +1,7 @@
 #include "SchematicProcessor.h"
 #include "../../../LiveSpiceParser.h"
 #include "../../../CircuitAnalyzer.h"
+#include "../../../NetlistCache.h"
 #include <iostream>
 
 SchematicProcessor::SchematicProcessor(const juce::File& schematicFile)
@@ -25,15 +26,15 @@ bool SchematicProcessor::loadSchematic()
 
     try
     {
-        // Parse the schematic using existing parser
+        // Parse and analyze, or restore both from the netlist cache when the
+        // schematic has not changed since the last load
         auto schematicPath = schematicFile.getFullPathName().toStdString();
-        schematic = std::make_unique<Schematic>(
-            LiveSpice::SchematicParser::parseFile(schematicPath)
-        );
-
-        // Analyze the circuit
-        LiveSpice::CircuitAnalyzer analyzer(*schematic);
-        stages = analyzer.analyzeCircuit();
+        auto cacheDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                            .getChildFile("LiveSpiceNetlistCache");
+        LiveSpice::NetlistCache cache(cacheDir.getFullPathName().toStdString());
+        auto circuit = cache.load(schematicPath);
+        schematic = std::make_unique<Schematic>(std::move(circuit.schematic));
+        stages = std::move(circuit.stages);
 
         // Extract parameters from components
         extractParameters();
@@ -52,7 +53,7 @@ bool SchematicProcessor::loadSchematic()
 void SchematicProcessor::extractParameters()
 {
     parameterList.clear();
-    parameters.clear();
+    parameterIndices.clear();
 
     if (!schematic)
         return;
@@ -75,7 +76,7 @@ void SchematicProcessor::extractParameters()
             info.label = "";
 
             parameterList.push_back(info);
-            parameters[info.id] = info.currentValue;
+            parameterIndices[info.id] = (int) parameterList.size() - 1;
 
             juce::Logger::writeToLog("  Parameter: " + info.name);
         }
@@ -90,8 +91,14 @@ void SchematicProcessor::extractParameters()
     bypassParam.label = "";
 
     parameterList.push_back(bypassParam);
-    parameters["bypass"] = bypassParam.currentValue;
+    parameterIndices[bypassParam.id] = (int) parameterList.size() - 1;
     juce::Logger::writeToLog("  Parameter: Bypass");
+
+    // Indices read on the audio thread
+    bypassIndex = getParameterIndex("bypass");
+    driveIndex = getParameterIndex("drive");
+    levelIndex = getParameterIndex("level");
+    toneIndex = getParameterIndex("tone");
 }
 
 void SchematicProcessor::prepareToPlay(double sampleRate, int maximumExpectedSamplesPerBlock)
@@ -118,7 +125,7 @@ void SchematicProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::Mi
     }
 
     // Check bypass
-    bool bypassed = parameters["bypass"] >= 0.5f;
+    bool bypassed = getParameterByIndex(bypassIndex) >= 0.5f;
     if (bypassed)
     {
         return;  // Pass through unchanged
@@ -135,31 +142,35 @@ std::vector<IAudioProcessor::ParameterInfo> SchematicProcessor::getParameters()
 
 bool SchematicProcessor::setParameter(const juce::String& parameterId, float value)
 {
-    if (parameters.find(parameterId) != parameters.end())
-    {
-        parameters[parameterId] = juce::jlimit(0.0f, 1.0f, value);
-        
-        // Update parameter list with current value
-        for (auto& param : const_cast<SchematicProcessor*>(this)->parameterList)
-        {
-            if (param.id == parameterId)
-            {
-                param.currentValue = parameters[parameterId];
-                break;
-            }
-        }
-        
-        return true;
-    }
-    return false;
+    return setParameterByIndex(getParameterIndex(parameterId), value);
 }
 
 float SchematicProcessor::getParameter(const juce::String& parameterId) const
 {
-    auto it = parameters.find(parameterId);
-    if (it != parameters.end())
-        return it->second;
-    return 0.0f;
+    return getParameterByIndex(getParameterIndex(parameterId));
+}
+
+int SchematicProcessor::getParameterIndex(const juce::String& parameterId) const
+{
+    auto it = parameterIndices.find(parameterId);
+    return it != parameterIndices.end() ? it->second : -1;
+}
+
+bool SchematicProcessor::setParameterByIndex(int index, float value)
+{
+    if (index < 0 || index >= (int) parameterList.size())
+        return false;
+
+    parameterList[(size_t) index].currentValue = juce::jlimit(0.0f, 1.0f, value);
+    return true;
+}
+
+float SchematicProcessor::getParameterByIndex(int index) const
+{
+    if (index < 0 || index >= (int) parameterList.size())
+        return 0.0f;
+
+    return parameterList[(size_t) index].currentValue;
 }
 
 juce::String SchematicProcessor::getName() const
@@ -1,14 +1,33 @@
 #pragma once
 
 #include "IAudioProcessor.h"
+#include "StageGraph.h"
 #include <juce_audio_processors/juce_audio_processors.h>
+#include <atomic>
 #include <map>
 
+namespace LiveSpice
+{
+    class Schematic;
+    struct CircuitStage;
+}
+
 /**
  * SchematicProcessor - Loads and processes LiveSpice schematics directly
  * 
- * This IAudioProcessor implementation loads a .schx schematic file and initializes
- * a stable parameter set for A/B comparison against generated VST3 plugins.
+ * This IAudioProcessor implementation loads a .schx schematic file, analyzes it
+ * into circuit stages and runs them through a LiveSpiceDSP::StageGraph, so a
+ * schematic can be auditioned against generated VST3 plugins without a
+ * translate and build cycle. Potentiometers become parameters and drive the
+ * graph's controls.
+ *
+ * While prepared, a background thread watches the file. When it changes, the
+ * thread parses, analyzes and builds a new graph and publishes it through an
+ * atomic pointer; the audio thread picks it up at the start of a block and
+ * crossfades from the old graph, then hands the old one back to the thread
+ * to delete. The audio thread never allocates, frees or waits for a reload.
+ * The parameter set is fixed at first load: reloaded stages bind to the
+ * existing pots by name, and pots added later stay at their midpoint.
  */
 class SchematicProcessor : public IAudioProcessor
 {
@@ -24,6 +43,9 @@ public:
     std::vector<ParameterInfo> getParameters() const override;
     bool setParameter(const juce::String& parameterId, float value) override;
     float getParameter(const juce::String& parameterId) const override;
+    int getParameterIndex(const juce::String& parameterId) const override;
+    bool setParameterByIndex(int index, float value) override;
+    float getParameterByIndex(int index) const override;
 
     juce::String getName() const override;
     juce::String getType() const override { return "SchematicHost"; }
@@ -33,22 +55,66 @@ public:
 
     void reset() override;
 
+    // Source file, and how many hot reloads have been published (any thread)
+    juce::File getSchematicFile() const { return schematicFile; }
+    int getReloadCount() const { return reloadCount.load(std::memory_order_acquire); }
+
 private:
     juce::File schematicFile;
     bool schematicLoaded = false;
     juce::String circuitName;
 
-    // Parameters exposed to the control panel
-    std::map<juce::String, float> parameters;
+    // Parameters exposed to the control panel; values live in parameterList
     std::vector<ParameterInfo> parameterList;
+    std::map<juce::String, int> parameterIndices;   // id -> parameterList index
+
+    // Resolved in extractParameters() so processing never looks up by id
+    int bypassIndex = -1;
 
-    // DSP state
+    // DSP state: one node per analyzed stage. nodeSpecs is written by the
+    // reload thread, and read by prepareToPlay() only while it is stopped
+    static constexpr int maxChannels = 2;
+    static constexpr double crossfadeMilliseconds = 20.0;
+    std::vector<LiveSpiceDSP::StageNodeSpec> nodeSpecs;
     double currentSampleRate = 44100.0;
     int currentBufferSize = 512;
 
+    // Graph handoff (see class comment). activeGraph and fadingGraph belong
+    // to the audio thread; pendingGraph and retiredGraph are single slots
+    // passed between it and the reload thread.
+    LiveSpiceDSP::StageGraph* activeGraph = nullptr;
+    LiveSpiceDSP::StageGraph* fadingGraph = nullptr;
+    std::atomic<LiveSpiceDSP::StageGraph*> pendingGraph{nullptr};
+    std::atomic<LiveSpiceDSP::StageGraph*> retiredGraph{nullptr};
+    int fadeLength = 1;
+    int fadePosition = 0;
+    juce::AudioBuffer<float> fadeScratch;   // Outgoing graph's copy of the input
+
+    // File watcher; polls, and reloads once the file has stopped changing
+    class Reloader : public juce::Thread
+    {
+    public:
+        explicit Reloader(SchematicProcessor& p) : juce::Thread("Schematic reload"), owner(p) {}
+        void run() override { owner.watchSchematic(); }
+    private:
+        SchematicProcessor& owner;
+    };
+
+    Reloader reloader{*this};
+    juce::Time lastModified;
+    std::atomic<int> reloadCount{0};
+
     // Helper methods
     bool loadSchematic();
-    void extractParameters();
+    void extractParameters(const LiveSpice::Schematic& schematic);
+    std::vector<LiveSpiceDSP::StageNodeSpec> buildNodeSpecs(const std::vector<LiveSpice::CircuitStage>& stages) const;
     void buildDSPChain();
+    void destroyGraphs();
     void processDSP(juce::AudioBuffer<float>& buffer);
+    void pushControls(LiveSpiceDSP::StageGraph& graph) const;
+
+    // Reload thread
+    void watchSchematic();
+    bool reloadSchematic();
+    void collectRetiredGraph();
 };
@@ -1,4 +1,6 @@
 #include "SchematicProcessor.h"
+#include "NetlistCache.h"
+#include "Logging.h"
 #include <iostream>
 
 SchematicProcessor::SchematicProcessor(const juce::File& schematicFile)
@@ -23,12 +25,21 @@ bool SchematicProcessor::loadSchematic()
 
     try
     {
-        // For now, just verify the file exists and extract basic parameters
-        // Full circuit analysis will be implemented in phase 2
-        extractParameters();
+        // Parse and analyze, or restore both from the netlist cache when the
+        // schematic has not changed since the last load
+        auto schematicPath = schematicFile.getFullPathName().toStdString();
+        auto cacheDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                            .getChildFile("LiveSpiceNetlistCache");
+        LiveSpice::NetlistCache cache(cacheDir.getFullPathName().toStdString());
+        auto circuit = cache.load(schematicPath);
+
+        extractParameters(circuit.schematic);
+        nodeSpecs = buildNodeSpecs(circuit.stages);
+        lastModified = schematicFile.getLastModificationTime();
 
         juce::Logger::writeToLog("SchematicProcessor: Loaded schematic '" + circuitName + 
-                                "' with " + juce::String(parameterList.size()) + " parameters");
+                                "' with " + juce::String(parameterList.size()) + " parameters and " +
+                                juce::String(nodeSpecs.size()) + " stages");
         return true;
     }
     catch (const std::exception& e)
@@ -38,76 +49,147 @@ bool SchematicProcessor::loadSchematic()
     }
 }
 
-void SchematicProcessor::extractParameters()
+void SchematicProcessor::extractParameters(const LiveSpice::Schematic& schematic)
 {
     parameterList.clear();
-    parameters.clear();
+    parameterIndices.clear();
 
-    // Standard guitar pedal parameters for comparison
-    
-    // Drive parameter
-    {
-        ParameterInfo info;
-        info.id = "drive";
-        info.name = "Drive";
-        info.defaultValue = 0.5f;
-        info.currentValue = 0.5f;
-        info.label = "";
-        parameterList.push_back(info);
-        parameters[info.id] = info.currentValue;
-        juce::Logger::writeToLog("  Parameter: Drive");
-    }
-    
-    // Level parameter
-    {
-        ParameterInfo info;
-        info.id = "level";
-        info.name = "Level";
-        info.defaultValue = 0.5f;
-        info.currentValue = 0.5f;
-        info.label = "";
-        parameterList.push_back(info);
-        parameters[info.id] = info.currentValue;
-        juce::Logger::writeToLog("  Parameter: Level");
-    }
-    
-    // Tone parameter
+    // Potentiometers and variable resistors are the pedal's controls
+    for (const auto& pair : schematic.getNetlist().getComponents())
     {
-        ParameterInfo info;
-        info.id = "tone";
-        info.name = "Tone";
-        info.defaultValue = 0.8f;
-        info.currentValue = 0.8f;
-        info.label = "";
-        parameterList.push_back(info);
-        parameters[info.id] = info.currentValue;
-        juce::Logger::writeToLog("  Parameter: Tone");
+        auto comp = pair.second;
+        
+        if (comp->getType() == LiveSpice::ComponentType::Potentiometer ||
+            comp->getType() == LiveSpice::ComponentType::VariableResistor)
+        {
+            ParameterInfo info;
+            info.id = comp->getName();
+            info.name = comp->getName();
+            info.defaultValue = 0.5f;  // Middle position
+            info.currentValue = 0.5f;
+            info.label = "";
+
+            parameterList.push_back(info);
+            parameterIndices[info.id] = (int) parameterList.size() - 1;
+
+            juce::Logger::writeToLog("  Parameter: " + info.name);
+        }
     }
 
-    // Bypass parameter
+    // Always add bypass parameter
+    ParameterInfo bypassParam;
+    bypassParam.id = "bypass";
+    bypassParam.name = "Bypass";
+    bypassParam.defaultValue = 0.0f;  // Not bypassed
+    bypassParam.currentValue = 0.0f;
+    bypassParam.label = "";
+
+    parameterList.push_back(bypassParam);
+    parameterIndices[bypassParam.id] = (int) parameterList.size() - 1;
+    juce::Logger::writeToLog("  Parameter: Bypass");
+
+    // Indices read on the audio thread
+    bypassIndex = getParameterIndex("bypass");
+}
+
+std::vector<LiveSpiceDSP::StageNodeSpec> SchematicProcessor::buildNodeSpecs(
+    const std::vector<LiveSpice::CircuitStage>& stages) const
+{
+    using LiveSpice::StageParam;
+    using LiveSpice::StageType;
+    using Kind = LiveSpiceDSP::StageNodeSpec::Kind;
+
+    // Defaults follow the code generator so the graph and a translated
+    // plugin start from the same values
+    std::vector<LiveSpiceDSP::StageNodeSpec> specs;
+    for (const auto& stage : stages)
     {
-        ParameterInfo info;
-        info.id = "bypass";
-        info.name = "Bypass";
-        info.defaultValue = 0.0f;
-        info.currentValue = 0.0f;
-        info.label = "";
-        parameterList.push_back(info);
-        parameters[info.id] = info.currentValue;
-        juce::Logger::writeToLog("  Parameter: Bypass");
+        LiveSpiceDSP::StageNodeSpec spec;
+        bool hasTransistor = false;
+
+        for (const auto& comp : stage.components)
+        {
+            if (comp->getType() == LiveSpice::ComponentType::Transistor)
+                hasTransistor = true;
+
+            // The first pot in the stage steers it
+            if (spec.control < 0)
+            {
+                int index = getParameterIndex(comp->getName());
+                if (index >= 0 && index != bypassIndex)
+                    spec.control = index;
+            }
+        }
+
+        switch (stage.type)
+        {
+            case StageType::InputBuffer:
+            case StageType::HighPassFilter:
+                spec.kind = Kind::HighPass;
+                spec.frequency = (float) stage.params.get(StageParam::HighpassFrequency, 72.0);
+                break;
+
+            case StageType::LowPassFilter:
+                spec.kind = Kind::LowPass;
+                spec.frequency = (float) stage.params.get(StageParam::CutoffFrequency, 15915.0);
+                break;
+
+            case StageType::BandPassFilter:
+                spec.kind = Kind::BandPass;
+                spec.frequency = (float) stage.params.get(StageParam::CutoffFrequency, 1000.0);
+                break;
+
+            case StageType::GainStage:
+                spec.kind = hasTransistor ? Kind::BJTAmplifier : Kind::Gain;
+                spec.gain = hasTransistor ? 1.0f : (float) stage.params.get(StageParam::GainLinear, 1.0);
+                break;
+
+            case StageType::OpAmpClipping:
+            case StageType::DiodeClipper:
+                spec.kind = Kind::DiodeClipper;
+                spec.gain = (float) stage.params.get(StageParam::GainLinear,
+                                                     stage.type == StageType::OpAmpClipping ? 10.0 : 1.0);
+                spec.diode.Is = (float) stage.params.get(StageParam::DiodeIS, spec.diode.Is);
+                spec.diode.n = (float) stage.params.get(StageParam::DiodeN, spec.diode.n);
+                break;
+
+            case StageType::ToneControl:
+                spec.kind = Kind::ToneStack;
+                break;
+
+            case StageType::OutputBuffer:
+                spec.kind = Kind::Gain;
+                spec.gain = 0.5f;  // 50% output level
+                break;
+
+            default:
+                continue;  // Unknown stages pass through
+        }
+
+        specs.push_back(spec);
     }
+    return specs;
 }
 
 void SchematicProcessor::prepareToPlay(double sampleRate, int maximumExpectedSamplesPerBlock)
 {
+    reloader.stopThread(2000);
+    destroyGraphs();
+
     currentSampleRate = sampleRate;
-    currentBufferSize = maximumExpectedSamplesPerBlock;
+    currentBufferSize = juce::jmax(1, maximumExpectedSamplesPerBlock);
+    fadeLength = juce::jmax(1, juce::roundToInt(crossfadeMilliseconds * 0.001 * sampleRate));
+    fadeScratch.setSize(maxChannels, currentBufferSize);
     buildDSPChain();
+
+    if (schematicLoaded)
+        reloader.startThread();
 }
 
 void SchematicProcessor::releaseResources()
 {
-    // TODO: Clean up DSP resources
+    reloader.stopThread(2000);
+    destroyGraphs();
 }
 
 void SchematicProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
@@ -118,9 +200,7 @@ void SchematicProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::Mi
     static int processCounter2 = 0;
     if (processCounter2++ % 500 == 0)
     {
-        juce::Logger::writeToLog("SchematicProcessor::processBlock - schematicLoaded=" + 
-                                juce::String((int)schematicLoaded) + 
-                                ", circuitName=" + circuitName);
+        LOG_RT(LogLevel::DEBUG, "SchematicProcessor::processBlock - schematicLoaded=%d", (int) schematicLoaded);
     }
 
     // If schematic not loaded, pass through with NO processing (don't clear!)
@@ -131,13 +211,12 @@ void SchematicProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::Mi
     }
 
     // Check bypass
-    bool bypassed = parameters["bypass"] >= 0.5f;
+    bool bypassed = getParameterByIndex(bypassIndex) >= 0.5f;
     if (bypassed)
     {
         return;  // Pass through unchanged
     }
 
-    // Process through DSP chain (placeholder)
     processDSP(buffer);
 }
 
@@ -148,31 +227,35 @@ std::vector<IAudioProcessor::ParameterInfo> SchematicProcessor::getParameters()
 
 bool SchematicProcessor::setParameter(const juce::String& parameterId, float value)
 {
-    if (parameters.find(parameterId) != parameters.end())
-    {
-        parameters[parameterId] = juce::jlimit(0.0f, 1.0f, value);
-        
-        // Update parameter list with current value
-        for (auto& param : const_cast<SchematicProcessor*>(this)->parameterList)
-        {
-            if (param.id == parameterId)
-            {
-                param.currentValue = parameters[parameterId];
-                break;
-            }
-        }
-        
-        return true;
-    }
-    return false;
+    return setParameterByIndex(getParameterIndex(parameterId), value);
 }
 
 float SchematicProcessor::getParameter(const juce::String& parameterId) const
 {
-    auto it = parameters.find(parameterId);
-    if (it != parameters.end())
-        return it->second;
-    return 0.0f;
+    return getParameterByIndex(getParameterIndex(parameterId));
+}
+
+int SchematicProcessor::getParameterIndex(const juce::String& parameterId) const
+{
+    auto it = parameterIndices.find(parameterId);
+    return it != parameterIndices.end() ? it->second : -1;
+}
+
+bool SchematicProcessor::setParameterByIndex(int index, float value)
+{
+    if (index < 0 || index >= (int) parameterList.size())
+        return false;
+
+    parameterList[(size_t) index].currentValue = juce::jlimit(0.0f, 1.0f, value);
+    return true;
+}
+
+float SchematicProcessor::getParameterByIndex(int index) const
+{
+    if (index < 0 || index >= (int) parameterList.size())
+        return 0.0f;
+
+    return parameterList[(size_t) index].currentValue;
 }
 
 juce::String SchematicProcessor::getName() const
@@ -182,56 +265,165 @@ juce::String SchematicProcessor::getName() const
 
 void SchematicProcessor::reset()
 {
-    // TODO: Reset DSP state
+    if (activeGraph != nullptr)
+        activeGraph->reset();
 }
 
 void SchematicProcessor::buildDSPChain()
 {
-    // Initialize DSP state - this is placeholder that will do basic distortion
-    juce::Logger::writeToLog("SchematicProcessor: Building DSP chain");
+    // Allocates every node's state up front; processDSP() only runs them
+    auto graph = std::make_unique<LiveSpiceDSP::StageGraph>();
+    pushControls(*graph);
+    graph->build(nodeSpecs, (float) currentSampleRate, (size_t) maxChannels);
+    juce::Logger::writeToLog("SchematicProcessor: Built DSP chain with " +
+                             juce::String((int) graph->getNumNodes()) + " nodes");
+    activeGraph = graph.release();
+}
+
+void SchematicProcessor::destroyGraphs()
+{
+    // Audio and reload threads are stopped: every slot is ours
+    delete activeGraph;
+    delete fadingGraph;
+    delete pendingGraph.exchange(nullptr);
+    delete retiredGraph.exchange(nullptr);
+    activeGraph = nullptr;
+    fadingGraph = nullptr;
+}
+
+void SchematicProcessor::pushControls(LiveSpiceDSP::StageGraph& graph) const
+{
+    // Graph controls are addressed by parameter index; unchanged values cost nothing
+    const size_t count = juce::jmin(parameterList.size(), LiveSpiceDSP::StageGraph::MAX_CONTROLS);
+    for (size_t i = 0; i < count; ++i)
+        graph.setControl(i, parameterList[i].currentValue);
 }
 
 void SchematicProcessor::processDSP(juce::AudioBuffer<float>& buffer)
 {
-    // Implement basic distortion processing to verify signal flow
-    const auto numChannels = buffer.getNumChannels();
-    const auto numSamples = buffer.getNumSamples();
-    
-    float drive = parameters["drive"];        // 0-1, controls gain before distortion
-    float level = parameters["level"];        // 0-1, output level
-    float tone = parameters["tone"];          // 0-1, simple low-pass filter
-    
-    // Log audio processing periodically
-    static int processCounter = 0;
-    if (processCounter++ % 100 == 0)  // MORE FREQUENT
+    // Take a published graph once the previous swap has been collected
+    if (fadingGraph == nullptr && retiredGraph.load(std::memory_order_acquire) == nullptr)
+    {
+        if (auto* next = pendingGraph.exchange(nullptr, std::memory_order_acq_rel))
+        {
+            fadingGraph = activeGraph;
+            activeGraph = next;
+            fadePosition = 0;
+        }
+    }
+
+    if (activeGraph == nullptr)
+        return;
+
+    const int numChannels = juce::jmin(buffer.getNumChannels(), maxChannels);
+    const int numSamples = buffer.getNumSamples();
+    pushControls(*activeGraph);
+
+    if (fadingGraph == nullptr)
     {
-        float inputLevel = buffer.getMagnitude(0, 0, numSamples);
-        juce::Logger::writeToLog("SchematicProcessor::processDSP - PROCESSING CALLED! Channels: " + juce::String(numChannels) + 
-                                ", Samples: " + juce::String(numSamples) + 
-                                ", InputLevel: " + juce::String(inputLevel, 4) + 
-                                ", Drive: " + juce::String(drive, 2) + 
-                                ", Level: " + juce::String(level, 2) + 
-                                ", GainMultiplier: " + juce::String(1.0f + drive * 4.0f, 2));
+        activeGraph->processBlock(buffer.getArrayOfWritePointers(), (size_t) numChannels, (size_t) numSamples);
+        return;
     }
-    
-    // Apply processing
-    for (int channel = 0; channel < numChannels; ++channel)
+
+    // Crossfade in scratch-sized chunks: outgoing graph on a copy, new graph in place
+    pushControls(*fadingGraph);
+    for (int offset = 0; offset < numSamples; offset += fadeScratch.getNumSamples())
     {
-        auto* samples = buffer.getWritePointer(channel);
-        
-        for (int i = 0; i < numSamples; ++i)
+        const int chunk = juce::jmin(fadeScratch.getNumSamples(), numSamples - offset);
+        float* channels[maxChannels] = {};
+        float* scratch[maxChannels] = {};
+        for (int ch = 0; ch < numChannels; ++ch)
         {
-            // Apply drive (gain before distortion)
-            float sample = samples[i] * (1.0f + drive * 4.0f);  // 1-5x gain
-            
-            // Soft clipping using tanh approximation for smoother saturation
-            float x = juce::jlimit(-3.0f, 3.0f, sample);
-            sample = x - (x * x * x) * 0.3333f;
-            
-            // Apply output level
-            sample *= level;
-            
-            samples[i] = sample;
+            channels[ch] = buffer.getWritePointer(ch, offset);
+            scratch[ch] = fadeScratch.getWritePointer(ch);
+            juce::FloatVectorOperations::copy(scratch[ch], channels[ch], chunk);
         }
+
+        fadingGraph->processBlock(scratch, (size_t) numChannels, (size_t) chunk);
+        activeGraph->processBlock(channels, (size_t) numChannels, (size_t) chunk);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            int position = fadePosition;
+            for (int i = 0; i < chunk; ++i)
+            {
+                position = juce::jmin(position + 1, fadeLength);
+                const float gain = (float) position / (float) fadeLength;
+                channels[ch][i] = gain * channels[ch][i] + (1.0f - gain) * scratch[ch][i];
+            }
+        }
+        fadePosition = juce::jmin(fadePosition + chunk, fadeLength);
     }
+
+    if (fadePosition >= fadeLength)
+    {
+        retiredGraph.store(fadingGraph, std::memory_order_release);
+        fadingGraph = nullptr;
+    }
+}
+
+void SchematicProcessor::watchSchematic()
+{
+    juce::Time seenModified = lastModified;
+
+    while (!reloader.threadShouldExit())
+    {
+        collectRetiredGraph();
+
+        // Reload once the timestamp has held still for a poll, so a save in
+        // progress is not parsed half-written
+        const auto modified = schematicFile.getLastModificationTime();
+        if (modified != lastModified)
+        {
+            if (modified == seenModified)
+            {
+                lastModified = modified;
+                reloadSchematic();
+            }
+            seenModified = modified;
+        }
+
+        reloader.wait(250);
+    }
+
+    collectRetiredGraph();
+}
+
+bool SchematicProcessor::reloadSchematic()
+{
+    try
+    {
+        auto start = juce::Time::getMillisecondCounterHiRes();
+
+        auto cacheDir = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                            .getChildFile("LiveSpiceNetlistCache");
+        LiveSpice::NetlistCache cache(cacheDir.getFullPathName().toStdString());
+        auto circuit = cache.load(schematicFile.getFullPathName().toStdString());
+
+        auto specs = buildNodeSpecs(circuit.stages);
+        auto graph = std::make_unique<LiveSpiceDSP::StageGraph>();
+        pushControls(*graph);
+        graph->build(specs, (float) currentSampleRate, (size_t) maxChannels);
+        nodeSpecs = std::move(specs);
+
+        // Replace an unclaimed graph from an earlier reload; the audio thread never saw it
+        delete pendingGraph.exchange(graph.release(), std::memory_order_acq_rel);
+        reloadCount.fetch_add(1, std::memory_order_release);
+
+        juce::Logger::writeToLog("SchematicProcessor: Reloaded '" + circuitName + "' with " +
+                                 juce::String((int) nodeSpecs.size()) + " stages in " +
+                                 juce::String(juce::Time::getMillisecondCounterHiRes() - start, 1) + " ms");
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        // Keep playing the current graph; the next save retries
+        juce::Logger::writeToLog("SchematicProcessor: Reload failed, keeping current graph: " + juce::String(e.what()));
+        return false;
+    }
+}
+
+void SchematicProcessor::collectRetiredGraph()
+{
+    delete retiredGraph.exchange(nullptr, std::memory_order_acq_rel);
 }
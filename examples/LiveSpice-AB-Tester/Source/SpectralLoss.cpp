@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+    SpectralLoss Implementation
+  ==============================================================================
+*/
+
+#include "SpectralLoss.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    constexpr int fftOrders[] = { 9, 10, 11 };
+    constexpr float logFloor = 1.0e-5f;   // -100 dB: keeps silent bins finite
+
+    // Equivalent rectangular bandwidth (Glasberg & Moore), Hz
+    float erb(float frequency)
+    {
+        return 24.7f * (4.37f * frequency / 1000.0f + 1.0f);
+    }
+}
+
+SpectralLoss::SpectralLoss(double rate)
+    : sampleRate(rate)
+{
+}
+
+void SpectralLoss::prepare(int newNumSamples)
+{
+    numSamples = juce::jmax(1, newNumSamples);
+    haveReference = false;
+    resolutions.clear();
+
+    int largest = 0;
+    for (int order : fftOrders)
+    {
+        Resolution r;
+        r.size = 1 << order;
+        r.hop = r.size / 4;
+        r.numBins = r.size / 2 + 1;
+        r.numFrames = numSamples >= r.size ? 1 + (numSamples - r.size) / r.hop : 1;
+        r.fft = std::make_unique<juce::dsp::FFT>(order);
+
+        // Periodic Hann window
+        r.window.resize((size_t) r.size);
+        for (int i = 0; i < r.size; ++i)
+            r.window[(size_t) i] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * (float) i / (float) r.size);
+
+        // Bandwidth over ERB per bin: equal weight per critical band, 20 Hz - 20 kHz
+        r.binWeights.assign((size_t) r.numBins, 0.0f);
+        const float binWidth = (float) sampleRate / (float) r.size;
+        float total = 0.0f;
+        for (int k = 0; k < r.numBins; ++k)
+        {
+            const float frequency = (float) k * binWidth;
+            if (frequency >= 20.0f && frequency <= 20000.0f)
+            {
+                r.binWeights[(size_t) k] = binWidth / erb(frequency);
+                total += r.binWeights[(size_t) k];
+            }
+        }
+        for (auto& w : r.binWeights)
+            w /= total;
+
+        r.referenceMagnitude.assign((size_t) (r.numFrames * r.numBins), 0.0f);
+        r.referenceLog.assign(r.referenceMagnitude.size(), 0.0f);
+        largest = juce::jmax(largest, r.size);
+        resolutions.push_back(std::move(r));
+    }
+
+    mono.assign((size_t) numSamples, 0.0f);
+    referenceMono.assign((size_t) numSamples, 0.0f);
+    frame.assign((size_t) largest * 2, 0.0f);
+    targetMagnitude.assign((size_t) largest / 2 + 1, 0.0f);
+}
+
+void SpectralLoss::mixToMono(const juce::AudioBuffer<float>& buffer)
+{
+    const int n = juce::jmin(numSamples, buffer.getNumSamples());
+    const int numChannels = buffer.getNumChannels();
+    std::fill(mono.begin(), mono.end(), 0.0f);
+    if (numChannels == 0)
+        return;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        juce::FloatVectorOperations::add(mono.data(), buffer.getReadPointer(ch), n);
+    juce::FloatVectorOperations::multiply(mono.data(), 1.0f / (float) numChannels, n);
+}
+
+void SpectralLoss::analyseFrame(Resolution& r, int frameIndex, float* magnitudes)
+{
+    // Windowed frame, zero-padded past the end of the signal
+    const int start = frameIndex * r.hop;
+    const int available = juce::jlimit(0, r.size, numSamples - start);
+    std::fill(frame.begin(), frame.begin() + 2 * r.size, 0.0f);
+    juce::FloatVectorOperations::multiply(frame.data(), mono.data() + start, r.window.data(), available);
+
+    r.fft->performFrequencyOnlyForwardTransform(frame.data());
+    std::copy(frame.begin(), frame.begin() + r.numBins, magnitudes);
+}
+
+void SpectralLoss::setReference(const juce::AudioBuffer<float>& reference)
+{
+    if (resolutions.empty())
+        prepare(reference.getNumSamples());
+
+    mixToMono(reference);
+    if (haveReference && std::equal(mono.begin(), mono.end(), referenceMono.begin()))
+        return;
+
+    referenceMono = mono;
+    for (auto& r : resolutions)
+    {
+        double energy = 0.0;
+        for (int f = 0; f < r.numFrames; ++f)
+        {
+            float* magnitudes = r.referenceMagnitude.data() + (size_t) f * (size_t) r.numBins;
+            float* logs = r.referenceLog.data() + (size_t) f * (size_t) r.numBins;
+            analyseFrame(r, f, magnitudes);
+            for (int k = 0; k < r.numBins; ++k)
+            {
+                energy += (double) r.binWeights[(size_t) k] * magnitudes[k] * magnitudes[k];
+                logs[k] = std::log(magnitudes[k] + logFloor);
+            }
+        }
+        r.referenceEnergy = energy;
+    }
+    haveReference = true;
+}
+
+float SpectralLoss::compare(const juce::AudioBuffer<float>& target)
+{
+    if (!haveReference)
+        return 0.0f;
+
+    mixToMono(target);
+
+    double loss = 0.0;
+    for (auto& r : resolutions)
+    {
+        double difference = 0.0;   // Weighted squared magnitude difference
+        double logDistance = 0.0;  // Weighted L1 of log magnitudes
+        for (int f = 0; f < r.numFrames; ++f)
+        {
+            const float* refMagnitudes = r.referenceMagnitude.data() + (size_t) f * (size_t) r.numBins;
+            const float* refLogs = r.referenceLog.data() + (size_t) f * (size_t) r.numBins;
+            analyseFrame(r, f, targetMagnitude.data());
+            for (int k = 0; k < r.numBins; ++k)
+            {
+                const float w = r.binWeights[(size_t) k];
+                const float d = targetMagnitude[(size_t) k] - refMagnitudes[k];
+                difference += (double) w * d * d;
+                logDistance += (double) w * std::abs(std::log(targetMagnitude[(size_t) k] + logFloor) - refLogs[k]);
+            }
+        }
+
+        const double convergence = r.referenceEnergy > 0.0 ? std::sqrt(difference / r.referenceEnergy)
+                                                           : std::sqrt(difference);
+        loss += convergence + logDistance / r.numFrames;
+    }
+    return (float) (loss / (double) resolutions.size());
+}
@@ -0,0 +1,70 @@
+/*
+  ==============================================================================
+    SpectralLoss - Multi-resolution STFT distance for calibration
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_dsp/juce_dsp.h>
+#include <memory>
+#include <vector>
+
+/**
+ * Multi-resolution STFT loss between a reference and a target render.
+ *
+ * At each resolution (512, 1024 and 2048 point Hann frames, 75% overlap)
+ * the loss is spectral convergence (relative Frobenius distance of the
+ * magnitudes) plus the L1 distance of log magnitudes, with bins weighted
+ * by bandwidth over ERB so every critical band counts equally, and
+ * nothing below 20 Hz or above 20 kHz counts at all. Resolutions are
+ * averaged. Unlike sample-wise errors this ignores phase and small
+ * delays, so it stays smooth in the parameters.
+ *
+ * FFT plans, windows, weights and all frame storage are built in
+ * prepare(); the reference spectra are computed by setReference() and
+ * reused until the reference signal changes.
+ */
+class SpectralLoss
+{
+public:
+    explicit SpectralLoss(double sampleRate = 48000.0);
+
+    /** Allocate for signals of numSamples (not real-time safe) */
+    void prepare(int numSamples);
+
+    /** Analyse the reference; a no-op when it matches the last one */
+    void setReference(const juce::AudioBuffer<float>& reference);
+
+    /** Loss of target against the current reference (0 = identical spectra) */
+    float compare(const juce::AudioBuffer<float>& target);
+
+private:
+    struct Resolution
+    {
+        int size = 0;
+        int hop = 0;
+        int numFrames = 0;
+        int numBins = 0;
+        std::unique_ptr<juce::dsp::FFT> fft;
+        std::vector<float> window;
+        std::vector<float> binWeights;         // Sum to 1
+        std::vector<float> referenceMagnitude; // numFrames x numBins
+        std::vector<float> referenceLog;
+        double referenceEnergy = 0.0;
+    };
+
+    double sampleRate;
+    int numSamples = 0;
+    std::vector<Resolution> resolutions;
+
+    std::vector<float> mono;            // Channel mix of the signal being analysed
+    std::vector<float> referenceMono;   // Last reference, for change detection
+    std::vector<float> frame;           // FFT work buffer (2 x largest size)
+    std::vector<float> targetMagnitude; // One frame of the target
+    bool haveReference = false;
+
+    void mixToMono(const juce::AudioBuffer<float>& buffer);
+    void analyseFrame(Resolution& resolution, int frameIndex, float* magnitudes);
+};
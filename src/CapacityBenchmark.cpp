@@ -0,0 +1,229 @@
+// Capacity planning for render servers: for every default preset and block
+// size, the largest number of MultiStagePedal instances one pinned core can
+// run without missing a block deadline, and the memory each instance takes.
+// See CapacityPlanner.h for the search.
+//
+//   livespice-capacity [--presets=A,B] [--blocks=32,64,...] [--rate=HZ]
+//                      [--clippers=N] [--oversample=N] [--adaa=N] [--compact]
+//                      [--load=F]
+//                      [--seconds=S] [--cores=N] [--cpu=N] [--max=N]
+//                      [--misses=N] [--csv] [--json=FILE]
+
+#include "CapacityPlanner.h"
+#include "MultiStagePedal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace LiveSpiceDSP;
+
+namespace {
+    struct Options {
+        std::vector<std::string> presets;   // Empty: all default presets
+        std::vector<size_t> blocks{32, 64, 128, 256, 512};
+        size_t clippers = 2;
+        int oversample = 1;
+        int adaa = 0;                       // Clipper ADAA order
+        MemoryMode memoryMode = MemoryMode::Standard;
+        CapacitySettings settings;
+        bool csv = false;
+        std::string jsonPath;
+    };
+
+    struct Row {
+        std::string preset;
+        size_t blockSize = 0;
+        CapacityResult result;
+        MemoryFootprint footprint;
+    };
+
+    std::vector<std::string> splitList(const std::string& text) {
+        std::vector<std::string> items;
+        std::stringstream stream(text);
+        for (std::string item; std::getline(stream, item, ',');) {
+            if (!item.empty()) items.push_back(item);
+        }
+        return items;
+    }
+
+    std::unique_ptr<MultiStagePedal> makePedal(const PedalPreset& preset, const Options& options) {
+        auto pedal = std::make_unique<MultiStagePedal>(static_cast<float>(options.settings.sampleRate),
+                                                       options.clippers, options.memoryMode);
+        if (options.oversample > 1) pedal->setOversampling(options.oversample);
+        if (options.adaa > 0) {
+            pedal->setClipperAntiAliasing(options.adaa == 1 ? Nonlinear::DiodeClippingStage::AntiAliasingMode::ADAA1
+                                                            : Nonlinear::DiodeClippingStage::AntiAliasingMode::ADAA2);
+        }
+        PresetManager::applyPreset(*pedal, preset);
+        return pedal;
+    }
+
+
+    std::string toJson(const std::vector<Row>& rows, const Options& options) {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3);
+        out << "{\n  \"sampleRate\": " << options.settings.sampleRate << ",\n  \"load\": " << options.settings.load
+            << ",\n  \"cores\": " << options.settings.cores << ",\n  \"clippers\": " << options.clippers
+            << ",\n  \"oversample\": " << options.oversample << ",\n  \"adaa\": " << options.adaa
+            << ",\n  \"compact\": " << (options.memoryMode == MemoryMode::Compact ? "true" : "false")
+            << ",\n  \"results\": [";
+        for (size_t i = 0; i < rows.size(); ++i) {
+            const CapacityResult& r = rows[i].result;
+            out << (i ? ",\n" : "\n") << "    {\"preset\": \"" << rows[i].preset << "\", \"blockSize\": "
+                << rows[i].blockSize << ", \"instancesPerCore\": " << r.instancesPerCore
+                << ", \"worstLoad\": " << r.worstLoad << ", \"meanLoad\": " << r.meanLoad
+                << ", \"usPerInstanceBlock\": " << r.usPerInstanceBlock
+                << ", \"bytesPerInstance\": " << rows[i].footprint.instanceBytes()
+                << ", \"sharedBytes\": " << rows[i].footprint.sharedBytes << "}";
+        }
+        out << "\n  ]\n}\n";
+        return out.str();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--presets=", 0) == 0) {
+            options.presets = splitList(arg.substr(10));
+        } else if (arg.rfind("--blocks=", 0) == 0) {
+            options.blocks.clear();
+            for (const auto& item : splitList(arg.substr(9))) {
+                if (std::atoi(item.c_str()) > 0) options.blocks.push_back(static_cast<size_t>(std::atoi(item.c_str())));
+            }
+        } else if (arg.rfind("--rate=", 0) == 0) {
+            options.settings.sampleRate = std::max(8000.0, std::atof(arg.c_str() + 7));
+        } else if (arg.rfind("--clippers=", 0) == 0) {
+            options.clippers = static_cast<size_t>(std::max(1, std::atoi(arg.c_str() + 11)));
+        } else if (arg.rfind("--oversample=", 0) == 0) {
+            options.oversample = std::max(1, std::atoi(arg.c_str() + 13));
+        } else if (arg.rfind("--adaa=", 0) == 0) {
+            options.adaa = std::clamp(std::atoi(arg.c_str() + 7), 0, 2);
+        } else if (arg == "--compact") {
+            options.memoryMode = MemoryMode::Compact;
+        } else if (arg.rfind("--load=", 0) == 0) {
+            options.settings.load = std::clamp(std::atof(arg.c_str() + 7), 0.01, 1.0);
+        } else if (arg.rfind("--seconds=", 0) == 0) {
+            options.settings.seconds = std::max(0.05, std::atof(arg.c_str() + 10));
+        } else if (arg.rfind("--cores=", 0) == 0) {
+            options.settings.cores = static_cast<size_t>(std::max(1, std::atoi(arg.c_str() + 8)));
+        } else if (arg.rfind("--cpu=", 0) == 0) {
+            options.settings.firstCpu = std::atoi(arg.c_str() + 6);
+        } else if (arg.rfind("--max=", 0) == 0) {
+            options.settings.maxInstances = static_cast<size_t>(std::max(1, std::atoi(arg.c_str() + 6)));
+        } else if (arg.rfind("--misses=", 0) == 0) {
+            options.settings.allowedMisses = static_cast<size_t>(std::max(0, std::atoi(arg.c_str() + 9)));
+        } else if (arg == "--csv") {
+            options.csv = true;
+        } else if (arg.rfind("--json=", 0) == 0) {
+            options.jsonPath = arg.substr(7);
+        } else {
+            std::cout << "Usage: " << argv[0] << " [options]\n\n"
+                      << "  --presets=A,B     Default presets to measure (default: all)\n"
+                      << "  --blocks=LIST     Block sizes (default 32,64,128,256,512)\n"
+                      << "  --rate=HZ         Sample rate (default 48000)\n"
+                      << "  --clippers=N      Clipper stages per pedal (default 2)\n"
+                      << "  --oversample=N    Oversampling factor (default 1)\n"
+                      << "  --adaa=N          Clipper anti-aliasing order, 0-2 (default 0)\n"
+                      << "  --compact         Build the pedals with MemoryMode::Compact\n"
+                      << "  --load=F          Share of each block period the instances may use (default 0.8)\n"
+                      << "  --seconds=S       Audio rendered per trial (default 1)\n"
+                      << "  --cores=N         Cores measured side by side (default 1)\n"
+                      << "  --cpu=N           Pin core k to CPU N + k (default 0; -1 leaves threads unpinned)\n"
+                      << "  --max=N           Search ceiling per core (default 1024)\n"
+                      << "  --misses=N        Deadline misses a trial may have and still hold (default 0)\n"
+                      << "  --csv             CSV instead of a table\n"
+                      << "  --json=FILE       Also write the results as JSON\n";
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    std::vector<PedalPreset> presets;
+    for (const auto& preset : PresetManager::getDefaultPresets()) {
+        if (options.presets.empty()
+            || std::find(options.presets.begin(), options.presets.end(), preset.name) != options.presets.end()) {
+            presets.push_back(preset);
+        }
+    }
+    if (presets.empty() || options.blocks.empty()) {
+        std::cerr << "Nothing to run: check --presets and --blocks\n";
+        return 2;
+    }
+
+    // One second of a 110 Hz guitar-level tone, cycled through by every instance
+    std::vector<float> signal(static_cast<size_t>(options.settings.sampleRate));
+    for (size_t n = 0; n < signal.size(); ++n) {
+        signal[n] = 0.3f * std::sin(2.0f * 3.14159265f * 110.0f * static_cast<float>(n)
+                                    / static_cast<float>(options.settings.sampleRate));
+    }
+
+    if (options.csv) {
+        std::cout << "preset,block_size,instances_per_core,worst_load,mean_load,us_per_instance_block,"
+                     "bytes_per_instance,shared_bytes\n";
+    } else {
+        std::cout << "MultiStagePedal capacity at " << options.settings.sampleRate << " Hz, " << options.clippers
+                  << " clipper(s), " << options.oversample << "x, ADAA " << options.adaa
+                  << (options.memoryMode == MemoryMode::Compact ? ", compact" : "") << ", load " << options.settings.load << ", "
+                  << options.settings.cores << " core(s)\n\n"
+                  << std::left << std::setw(14) << "Preset" << std::right << std::setw(7) << "block"
+                  << std::setw(12) << "per core" << std::setw(12) << "worst load" << std::setw(11) << "mean load"
+                  << std::setw(14) << "us/instance" << std::setw(12) << "KiB/inst" << "\n"
+                  << std::string(82, '-') << "\n";
+    }
+
+    std::vector<Row> rows;
+    bool pinned = true;
+    for (const auto& preset : presets) {
+        const MemoryFootprint footprint = makePedal(preset, options)->getMemoryFootprint();
+        const size_t bytes = footprint.instanceBytes();
+        for (size_t blockSize : options.blocks) {
+            CapacitySettings settings = options.settings;
+            settings.blockSize = blockSize;
+
+            // Each instance renders into its own output so none of them share a cache line
+            struct Instance {
+                std::unique_ptr<MultiStagePedal> pedal;
+                std::vector<float> output;
+            };
+            const auto result = findCapacity(
+                settings, signal.size(),
+                [&]() { return Instance{makePedal(preset, options), std::vector<float>(blockSize)}; },
+                [&](Instance& instance, size_t offset, size_t numSamples) {
+                    instance.pedal->processBlock(signal.data() + offset, instance.output.data(), numSamples);
+                });
+            pinned = pinned && result.pinned;
+            rows.push_back({preset.name, blockSize, result, footprint});
+
+            std::cout << std::fixed;
+            if (options.csv) {
+                std::cout << preset.name << "," << blockSize << "," << result.instancesPerCore << ","
+                          << std::setprecision(3) << result.worstLoad << "," << result.meanLoad << ","
+                          << result.usPerInstanceBlock << "," << bytes << "," << footprint.sharedBytes << "\n";
+            } else {
+                std::cout << std::left << std::setw(14) << preset.name << std::right << std::setw(7) << blockSize
+                          << std::setw(12) << result.instancesPerCore << std::setprecision(2) << std::setw(12)
+                          << result.worstLoad << std::setw(11) << result.meanLoad << std::setw(14)
+                          << result.usPerInstanceBlock << std::setprecision(1) << std::setw(12)
+                          << static_cast<double>(bytes) / 1024.0 << "\n";
+            }
+        }
+    }
+
+    if (!pinned) {
+        std::cerr << "Warning: could not pin every thread; results may be noisier\n";
+    }
+    if (!options.jsonPath.empty()) {
+        std::ofstream(options.jsonPath) << toJson(rows, options);
+        std::cout << "\nResults written to: " << options.jsonPath << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file CapacityPlanner.h
+ * @brief How many processor instances fit on one core at a buffer size
+ *
+ * A render server runs many instances of a pedal on each core, and every
+ * host block of all of them has to finish inside one block period.
+ * findCapacity() answers how many that is by measurement: for a trial
+ * count N it starts one thread per core, pins it, builds N instances on it
+ * and renders the same test signal through all of them block by block,
+ * timing each round. A round that takes longer than the allowed share of
+ * the block period is a deadline miss. N doubles until a trial misses and
+ * is then bisected between the last count that held and the first that
+ * did not.
+ *
+ * Header-only so the generated benchmark harness can use it with its own
+ * processor type.
+ */
+
+/**
+ * Trial settings. load leaves headroom for the host and the rest of the
+ * chain: 0.8 means the instances on a core may use 80 % of each block
+ * period.
+ */
+struct CapacitySettings {
+    double sampleRate = 48000.0;
+    size_t blockSize = 128;
+    double load = 0.8;
+    double seconds = 1.0;          // Audio rendered per trial (after a tenth as warm-up)
+    size_t cores = 1;              // Threads run side by side, each with its own instances
+    int firstCpu = 0;              // Thread k is pinned to firstCpu + k; -1 leaves them unpinned
+    size_t maxInstances = 1024;    // Search ceiling per core
+    size_t allowedMisses = 0;      // Misses per core a trial may have and still hold
+};
+
+struct CapacityResult {
+    size_t instancesPerCore = 0;   // Largest count that held (0: one instance already misses)
+    double worstLoad = 0.0;        // Slowest round / block period at that count
+    double meanLoad = 0.0;         // Average round / block period at that count
+    double usPerInstanceBlock = 0.0;
+    size_t trials = 0;
+    bool pinned = true;            // False if any thread could not be pinned
+};
+
+/** Pin the calling thread to one CPU; false where unsupported */
+inline bool pinCurrentThreadToCpu(int cpu) {
+#if defined(_WIN32)
+    return SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;   // macOS has no hard affinity
+#endif
+}
+
+/**
+ * Search for the safe instance count per core. make() builds one ready
+ * instance (any movable type, typically a unique_ptr) and is called on
+ * the thread that will render it; render(instance, offset, numSamples)
+ * processes one block of the caller's test signal starting at offset.
+ * Offsets cycle through numSignalSamples. Not real-time safe; blocks for
+ * the duration of every trial.
+ */
+template <typename Make, typename Render>
+CapacityResult findCapacity(const CapacitySettings& settings, size_t numSignalSamples, Make&& make, Render&& render) {
+    using Instance = std::decay_t<decltype(make())>;
+    using Clock = std::chrono::steady_clock;
+
+    const size_t blockSize = std::max<size_t>(1, std::min(settings.blockSize, numSignalSamples));
+    const size_t cores = std::max<size_t>(1, settings.cores);
+    const double periodNs = 1.0e9 * static_cast<double>(blockSize) / settings.sampleRate;
+    const double deadlineNs = settings.load * periodNs;
+    const size_t rounds = std::max<size_t>(
+        10, static_cast<size_t>(settings.seconds * settings.sampleRate / static_cast<double>(blockSize)));
+    const size_t warmupRounds = std::max<size_t>(1, rounds / 10);
+
+    struct CoreStats {
+        size_t misses = 0;
+        double worstNs = 0.0, totalNs = 0.0;
+        bool pinned = true;
+    };
+
+    CapacityResult result;
+
+    // One trial with count instances per core: true if every core held
+    auto trial = [&](size_t count, CapacityResult& held) {
+        std::vector<CoreStats> stats(cores);
+        std::atomic<size_t> ready{0};
+        std::vector<std::thread> threads;
+        for (size_t core = 0; core < cores; ++core) {
+            threads.emplace_back([&, core]() {
+                CoreStats& s = stats[core];
+                if (settings.firstCpu >= 0) {
+                    s.pinned = pinCurrentThreadToCpu(settings.firstCpu + static_cast<int>(core));
+                }
+                std::vector<Instance> instances;
+                instances.reserve(count);
+                for (size_t i = 0; i < count; ++i) instances.push_back(make());
+
+                // Start together so the cores compete for cache and memory bandwidth
+                ready.fetch_add(1);
+                while (ready.load() < cores) std::this_thread::yield();
+
+                size_t offset = 0;
+                for (size_t round = 0; round < warmupRounds + rounds; ++round) {
+                    const auto start = Clock::now();
+                    for (auto& instance : instances) render(instance, offset, blockSize);
+                    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+                    offset += blockSize;
+                    if (offset + blockSize > numSignalSamples) offset = 0;
+                    if (round < warmupRounds) continue;
+                    s.totalNs += ns;
+                    s.worstNs = std::max(s.worstNs, ns);
+                    if (ns > deadlineNs) ++s.misses;
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        ++result.trials;
+
+        bool holds = true;
+        CapacityResult measured;
+        for (const auto& s : stats) {
+            holds = holds && s.misses <= settings.allowedMisses;
+            result.pinned = result.pinned && s.pinned;
+            measured.worstLoad = std::max(measured.worstLoad, s.worstNs / periodNs);
+            measured.meanLoad += s.totalNs / static_cast<double>(rounds) / periodNs / static_cast<double>(cores);
+        }
+        measured.usPerInstanceBlock = measured.meanLoad * periodNs / 1000.0 / static_cast<double>(count);
+        if (holds) {
+            held.instancesPerCore = count;
+            held.worstLoad = measured.worstLoad;
+            held.meanLoad = measured.meanLoad;
+            held.usPerInstanceBlock = measured.usPerInstanceBlock;
+        }
+        return holds;
+    };
+
+    // Double until a trial misses, then bisect (good, bad)
+    size_t good = 0, bad = 0;
+    for (size_t count = 1; count <= settings.maxInstances; count *= 2) {
+        if (!trial(count, result)) {
+            bad = count;
+            break;
+        }
+        good = count;
+    }
+    if (bad == 0) {
+        // Never missed: confirm the ceiling itself unless it was a power of two already tried
+        if (good < settings.maxInstances && trial(settings.maxInstances, result)) return result;
+        bad = good < settings.maxInstances ? settings.maxInstances : 0;
+    }
+    while (bad > good + 1) {
+        const size_t mid = good + (bad - good) / 2;
+        if (trial(mid, result)) good = mid;
+        else bad = mid;
+    }
+    return result;
+}
+
+}  // namespace LiveSpiceDSP
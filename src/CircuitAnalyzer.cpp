@@ -1,10 +1,12 @@
 #define M_PI 3.14159265358979323846
 #include "CircuitAnalyzer.h"
+#include "PhaseProfiler.h"
 #include <cmath>
 #include <sstream>
 #include <algorithm>
 #include <cctype>
 #include <iomanip>
+#include <future>
 
 namespace LiveSpice {
 
@@ -102,62 +104,207 @@ namespace LiveSpice {
         return false;
     }
 
+    // ============================================================================
+    // Stage Parameters
+    // ============================================================================
+    namespace {
+        const char* const stageParamNames[] = {
+            "coupling_capacitance",
+            "input_resistance",
+            "highpass_frequency",
+            "gain_linear",
+            "gain_db",
+            "cutoff_frequency",
+            "diode_IS",
+            "diode_n",
+        };
+        static_assert(sizeof(stageParamNames) / sizeof(stageParamNames[0]) ==
+                      static_cast<size_t>(StageParam::Count), "one name per StageParam");
+    }
+
+    const char* stageParamName(StageParam param) {
+        return stageParamNames[static_cast<size_t>(param)];
+    }
+
+    bool stageParamFromName(const std::string& name, StageParam& param) {
+        for (size_t i = 0; i < static_cast<size_t>(StageParam::Count); ++i) {
+            if (name == stageParamNames[i]) {
+                param = static_cast<StageParam>(i);
+                return true;
+            }
+        }
+        return false;
+    }
+
     // ============================================================================
     // CircuitGraph Implementation
     // ============================================================================
+    namespace {
+        bool nodeLess(const Node& a, const Node& b) {
+            return a.getX() != b.getX() ? a.getX() < b.getX() : a.getY() < b.getY();
+        }
+
+        uint32_t findRoot(std::vector<uint32_t>& parent, uint32_t i) {
+            while (parent[i] != i) {
+                parent[i] = parent[parent[i]];
+                i = parent[i];
+            }
+            return i;
+        }
+
+        // CSR rows from (row, id) pairs; ids keep pair order within a row
+        void buildRows(size_t rowCount, const std::vector<std::pair<uint32_t, uint32_t>>& pairs,
+                       std::vector<uint32_t>& offsets, std::vector<uint32_t>& ids) {
+            offsets.assign(rowCount + 1, 0);
+            for (const auto& p : pairs) offsets[p.first + 1]++;
+            for (size_t r = 0; r < rowCount; ++r) offsets[r + 1] += offsets[r];
+            ids.resize(pairs.size());
+            std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+            for (const auto& p : pairs) ids[fill[p.first]++] = p.second;
+        }
+    }
+
     CircuitGraph::CircuitGraph(const Netlist& netlist) : wires(netlist.getWires()) {
-        // Build node map from wires
+        PhaseProfiler::Scope phase("CircuitGraph construction");
+
+        // Unique wire endpoints, sorted so lookups are a binary search
+        nodes.reserve(2 * wires.size());
         for (const auto& wire : wires) {
-            std::pair<int, int> nodeA = {wire.nodeA_X, wire.nodeA_Y};
-            std::pair<int, int> nodeB = {wire.nodeB_X, wire.nodeB_Y};
+            nodes.emplace_back(wire.nodeA_X, wire.nodeA_Y);
+            nodes.emplace_back(wire.nodeB_X, wire.nodeB_Y);
+        }
+        std::sort(nodes.begin(), nodes.end(), nodeLess);
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+        const size_t nodeCount = nodes.size();
 
-            if (nodes.find(nodeA) == nodes.end()) {
-                nodes[nodeA] = Node(wire.nodeA_X, wire.nodeA_Y);
-            }
-            if (nodes.find(nodeB) == nodes.end()) {
-                nodes[nodeB] = Node(wire.nodeB_X, wire.nodeB_Y);
-            }
+        // Union-find over wires: both ends of a wire are the same net
+        std::vector<uint32_t> parent(nodeCount);
+        for (uint32_t i = 0; i < nodeCount; ++i) parent[i] = i;
+        for (const auto& wire : wires) {
+            uint32_t a = findRoot(parent, findNode(wire.nodeA_X, wire.nodeA_Y));
+            uint32_t b = findRoot(parent, findNode(wire.nodeB_X, wire.nodeB_Y));
+            if (a != b) parent[std::max(a, b)] = std::min(a, b);
+        }
+
+        // Dense net IDs in node order
+        nodeNet.assign(nodeCount, NO_NET);
+        NetId netCount = 0;
+        for (uint32_t i = 0; i < nodeCount; ++i) {
+            uint32_t root = findRoot(parent, i);
+            if (nodeNet[root] == NO_NET) nodeNet[root] = netCount++;
+            nodeNet[i] = nodeNet[root];
         }
 
         // Store all components for later analysis
+        allComponents.reserve(netlist.getComponentCount());
         for (const auto& pair : netlist.getComponents()) {
             allComponents.push_back(pair.second);
+            componentsByType[static_cast<size_t>(pair.second->getType())].push_back(pair.second);
+        }
+        const size_t componentCount = allComponents.size();
+
+        // Component -> net of its position, and the nodes in its pin window
+        componentIndex.reserve(componentCount);
+        componentNet.resize(componentCount);
+        windowOffsets.assign(1, 0);
+        std::vector<std::pair<uint32_t, uint32_t>> netPairs;
+        netPairs.reserve(componentCount);
+        for (uint32_t c = 0; c < componentCount; ++c) {
+            const auto& comp = allComponents[c];
+            const int x = comp->getPosX();
+            const int y = comp->getPosY();
+            componentIndex.emplace(comp.get(), c);
+
+            uint32_t home = findNode(x, y);
+            componentNet[c] = home != NO_NET ? nodeNet[home] : netCount++;
+            netPairs.emplace_back(componentNet[c], c);
+
+            auto it = std::lower_bound(nodes.begin(), nodes.end(), Node(x - 10, y - 10), nodeLess);
+            for (; it != nodes.end() && it->getX() <= x + 10; ++it) {
+                if (std::abs(it->getY() - y) <= 10) {
+                    windowNodeIds.push_back(static_cast<uint32_t>(it - nodes.begin()));
+                }
+            }
+            windowOffsets.push_back(static_cast<uint32_t>(windowNodeIds.size()));
         }
-    }
 
-    std::vector<std::shared_ptr<Component>> CircuitGraph::findComponentsByType(ComponentType type) const {
-        std::vector<std::shared_ptr<Component>> result;
-        for (const auto& comp : allComponents) {
-            if (comp->getType() == type) {
-                result.push_back(comp);
+        // Net -> components on it; nets carrying a ground symbol
+        buildRows(netCount, netPairs, netComponentOffsets, netComponentIds);
+        groundNet.assign(netCount, false);
+        for (uint32_t c = 0; c < componentCount; ++c) {
+            if (allComponents[c]->getType() == ComponentType::Ground) {
+                groundNet[componentNet[c]] = true;
             }
         }
-        return result;
+    }
+
+    uint32_t CircuitGraph::findNode(int x, int y) const {
+        Node key(x, y);
+        auto it = std::lower_bound(nodes.begin(), nodes.end(), key, nodeLess);
+        if (it == nodes.end() || !(*it == key)) return NO_NET;
+        return static_cast<uint32_t>(it - nodes.begin());
+    }
+
+    std::shared_ptr<Component> CircuitGraph::findComponent(const std::string& name) const {
+        // allComponents is in name order (Netlist keeps a std::map)
+        auto it = std::lower_bound(allComponents.begin(), allComponents.end(), name,
+            [](const std::shared_ptr<Component>& comp, const std::string& key) { return comp->getName() < key; });
+        if (it == allComponents.end() || (*it)->getName() != name) return nullptr;
+        return *it;
     }
 
     std::vector<Node> CircuitGraph::getConnectedNodes(std::shared_ptr<Component> comp) const {
         std::vector<Node> connectedNodes;
-        int x, y;
-        comp->getPosition(x, y);
+        auto found = componentIndex.find(comp.get());
+        if (found == componentIndex.end()) return connectedNodes;
 
-        // Find nodes that connect to this component's position
-        for (const auto& pair : nodes) {
-            // Simple proximity check - nodes at same or nearby positions
-            if (std::abs(pair.first.first - x) <= 10 && std::abs(pair.first.second - y) <= 10) {
-                connectedNodes.push_back(pair.second);
-            }
+        const uint32_t c = found->second;
+        connectedNodes.reserve(windowOffsets[c + 1] - windowOffsets[c]);
+        for (uint32_t i = windowOffsets[c]; i < windowOffsets[c + 1]; ++i) {
+            connectedNodes.push_back(nodes[windowNodeIds[i]]);
         }
         return connectedNodes;
     }
 
+    CircuitGraph::NetId CircuitGraph::getNet(const Node& node) const {
+        uint32_t i = findNode(node.getX(), node.getY());
+        return i != NO_NET ? nodeNet[i] : NO_NET;
+    }
+
+    CircuitGraph::NetId CircuitGraph::getNet(const std::shared_ptr<Component>& comp) const {
+        auto found = componentIndex.find(comp.get());
+        return found != componentIndex.end() ? componentNet[found->second] : NO_NET;
+    }
+
+    std::vector<std::shared_ptr<Component>> CircuitGraph::getComponentsOnNet(NetId net) const {
+        std::vector<std::shared_ptr<Component>> result;
+        if (net >= getNetCount()) return result;
+        for (uint32_t i = netComponentOffsets[net]; i < netComponentOffsets[net + 1]; ++i) {
+            result.push_back(allComponents[netComponentIds[i]]);
+        }
+        return result;
+    }
+
+    std::vector<std::shared_ptr<Component>> CircuitGraph::getNeighbors(const std::shared_ptr<Component>& comp) const {
+        std::vector<std::shared_ptr<Component>> result;
+        NetId net = getNet(comp);
+        if (net == NO_NET) return result;
+        for (uint32_t i = netComponentOffsets[net]; i < netComponentOffsets[net + 1]; ++i) {
+            const auto& other = allComponents[netComponentIds[i]];
+            if (other != comp) result.push_back(other);
+        }
+        return result;
+    }
+
     bool CircuitGraph::isGroundNode(const Node& node) const {
+        NetId net = getNet(node);
+        if (net != NO_NET) return groundNet[net];
+
+        // Not a wire endpoint: only a ground symbol placed exactly here counts
         for (const auto& comp : allComponents) {
-            if (comp->getType() == ComponentType::Ground) {
-                int x, y;
-                comp->getPosition(x, y);
-                if (x == node.getX() && y == node.getY()) {
-                    return true;
-                }
+            if (comp->getType() == ComponentType::Ground &&
+                comp->getPosX() == node.getX() && comp->getPosY() == node.getY()) {
+                return true;
             }
         }
         return false;
@@ -167,62 +314,178 @@ namespace LiveSpice {
     // CircuitAnalyzer Implementation
     // ============================================================================
     CircuitAnalyzer::CircuitAnalyzer(const Schematic& schematic)
-        : schematic(schematic), circuitGraph(schematic.getNetlist()) {
+        : schematic(schematic), circuitGraph(schematic.getNetlist()),
+          patternRegistry(TopologyAnalysis::PatternRegistry::shared()),
+          patternCache(&TopologyAnalysis::PatternMatchCache::shared()) {
+    }
+
+    namespace {
+        uint32_t typeBit(ComponentType type) {
+            return 1u << static_cast<uint32_t>(type);
+        }
+
+        // Component types each stage slot reads, in StageSlot order
+        const uint32_t slotDependencies[] = {
+            typeBit(ComponentType::Input) | typeBit(ComponentType::Capacitor) | typeBit(ComponentType::Resistor),
+            typeBit(ComponentType::OpAmp) | typeBit(ComponentType::Diode) | typeBit(ComponentType::Resistor),
+            typeBit(ComponentType::Transistor) | typeBit(ComponentType::Resistor) | typeBit(ComponentType::Capacitor),
+            typeBit(ComponentType::Potentiometer) | typeBit(ComponentType::VariableResistor) |
+                typeBit(ComponentType::Resistor) | typeBit(ComponentType::Capacitor),
+            typeBit(ComponentType::Resistor) | typeBit(ComponentType::Capacitor),
+            typeBit(ComponentType::Output),
+        };
     }
 
     std::vector<CircuitStage> CircuitAnalyzer::analyzeCircuit() {
-        identifiedStages.clear();
+        PhaseProfiler::Scope phase("analyzeCircuit");
+        slotValid.fill(false);
+        buildStages();
+        return identifiedStages;
+    }
 
-        // Identify common circuit stages
-        auto inputComps = findComponentsByType(ComponentType::Input);
-        auto outputComps = findComponentsByType(ComponentType::Output);
-        auto opamps = findComponentsByType(ComponentType::OpAmp);
-        auto diodes = findComponentsByType(ComponentType::Diode);
-        auto transistors = findComponentsByType(ComponentType::Transistor);
-        auto resistors = findComponentsByType(ComponentType::Resistor);
-        auto capacitors = findComponentsByType(ComponentType::Capacitor);
-        auto potentiometers = findComponentsByType(ComponentType::Potentiometer);
-        auto variableResistors = findComponentsByType(ComponentType::VariableResistor);
+    std::vector<CircuitStage> CircuitAnalyzer::reanalyzeCircuit(const CircuitDelta& delta) {
+        PhaseProfiler::Scope phase("reanalyzeCircuit");
+        uint32_t touchedTypes = 0;
 
-        // 1. Input stage (Input -> coupling capacitor -> resistor -> buffer)
-        if (!inputComps.empty()) {
-            identifiedStages.push_back(identifyInputStage());
+        // Removed components are only known to the previous graph
+        for (const auto& name : delta.removedComponents) {
+            if (auto comp = circuitGraph.findComponent(name)) touchedTypes |= typeBit(comp->getType());
+        }
+        if (delta.wiresChanged || !delta.addedComponents.empty() || !delta.removedComponents.empty()) {
+            circuitGraph = CircuitGraph(schematic.getNetlist());
+        }
+        for (const auto& name : delta.addedComponents) {
+            if (auto comp = circuitGraph.findComponent(name)) touchedTypes |= typeBit(comp->getType());
         }
 
-        // 2. Op-amp based stages (gain, clipping, filtering)
-        if (!opamps.empty()) {
-            // Try to identify what type of op-amp stage this is
-            if (!diodes.empty()) {
-                identifiedStages.push_back(identifyClippingStage());
-            } else {
-                identifiedStages.push_back(identifyOpAmpStage());
+        // Pattern matching only runs when there is an output, so toggling it touches every stage;
+        // rewiring changes the connections every stage is matched with
+        if ((touchedTypes & typeBit(ComponentType::Output)) || delta.wiresChanged) {
+            slotValid.fill(false);
+        }
+        for (size_t slot = 0; slot < SlotCount; ++slot) {
+            if (touchedTypes & slotDependencies[slot]) slotValid[slot] = false;
+        }
+
+        // A parameter edit only matters to the stages that picked the component
+        for (const auto& name : delta.changedComponents) {
+            for (size_t slot = 0; slot < SlotCount; ++slot) {
+                if (!slotValid[slot]) continue;
+                for (const auto& comp : slotStages[slot].components) {
+                    if (comp && comp->getName() == name) {
+                        slotValid[slot] = false;
+                        break;
+                    }
+                }
             }
         }
 
-        // 2b. Transistor-based gain stages (BJT/FET)
-        if (!transistors.empty()) {
-            identifiedStages.push_back(identifyTransistorStage());
+        buildStages();
+        return identifiedStages;
+    }
+
+    void CircuitAnalyzer::buildStages() {
+        identifiedStages.clear();
+        const bool matchPatterns = isSlotPresent(OutputSlot);
+
+        // Stage connections read the compact netlist; build it before any task does
+        const Netlist& netlist = schematic.getNetlist();
+        if (matchPatterns && !netlist.hasConnectivity()) {
+            const_cast<Netlist&>(netlist).buildConnectivityPool();
         }
 
-        // 3. Tone control stages
-        if (!potentiometers.empty() || !variableResistors.empty()) {
-            identifiedStages.push_back(identifyToneControlStage());
+        std::vector<StageSlot> pending;
+        for (size_t i = 0; i < SlotCount; ++i) {
+            const StageSlot slot = static_cast<StageSlot>(i);
+            if (!isSlotPresent(slot)) {
+                slotValid[slot] = false;
+            } else if (!slotValid[slot]) {
+                pending.push_back(slot);
+            }
         }
 
-        // 4. Passive filter stages (RC networks)
-        if (!resistors.empty() && !capacitors.empty()) {
-            identifiedStages.push_back(identifyFilterStage());
+        if (parallelStages && pending.size() > 1) {
+            // Each task writes only its own stage; get() merges in slot order
+            std::vector<std::future<CircuitStage>> tasks;
+            tasks.reserve(pending.size());
+            for (StageSlot slot : pending) {
+                tasks.push_back(std::async(std::launch::async,
+                    [this, slot, matchPatterns] { return identifySlot(slot, matchPatterns); }));
+            }
+            for (size_t i = 0; i < pending.size(); ++i) {
+                slotStages[pending[i]] = tasks[i].get();
+            }
+        } else {
+            for (StageSlot slot : pending) {
+                slotStages[slot] = identifySlot(slot, matchPatterns);
+            }
         }
 
-        // 5. Output stage
-        if (!outputComps.empty()) {
-            identifiedStages.push_back(identifyOutputStage());
+        for (size_t i = 0; i < SlotCount; ++i) {
+            if (!isSlotPresent(static_cast<StageSlot>(i))) continue;
+            slotValid[i] = true;
+            identifiedStages.push_back(slotStages[i]);
+        }
+    }
 
-            // 6. Apply topology pattern matching to refine identifications
-            applyPatternMatching();
+    bool CircuitAnalyzer::isSlotPresent(StageSlot slot) const {
+        switch (slot) {
+            case InputSlot:
+                return !findComponentsByType(ComponentType::Input).empty();
+            case OpAmpSlot:
+                return !findComponentsByType(ComponentType::OpAmp).empty();
+            case TransistorSlot:
+                return !findComponentsByType(ComponentType::Transistor).empty();
+            case ToneControlSlot:
+                return !findComponentsByType(ComponentType::Potentiometer).empty() ||
+                       !findComponentsByType(ComponentType::VariableResistor).empty();
+            case FilterSlot:
+                return !findComponentsByType(ComponentType::Resistor).empty() &&
+                       !findComponentsByType(ComponentType::Capacitor).empty();
+            case OutputSlot:
+                return !findComponentsByType(ComponentType::Output).empty();
+            default:
+                return false;
         }
+    }
 
-        return identifiedStages;
+    CircuitStage CircuitAnalyzer::identifySlot(StageSlot slot, bool matchPatterns) {
+        CircuitStage stage;
+        switch (slot) {
+            // 1. Input stage (Input -> coupling capacitor -> resistor -> buffer)
+            case InputSlot:
+                stage = identifyInputStage();
+                break;
+            // 2. Op-amp based stages (gain, clipping, filtering)
+            case OpAmpSlot:
+                if (!findComponentsByType(ComponentType::Diode).empty()) {
+                    stage = identifyClippingStage();
+                } else {
+                    stage = identifyOpAmpStage();
+                }
+                break;
+            // 2b. Transistor-based gain stages (BJT/FET)
+            case TransistorSlot:
+                stage = identifyTransistorStage();
+                break;
+            // 3. Tone control stages
+            case ToneControlSlot:
+                stage = identifyToneControlStage();
+                break;
+            // 4. Passive filter stages (RC networks)
+            case FilterSlot:
+                stage = identifyFilterStage();
+                break;
+            // 5. Output stage
+            case OutputSlot:
+            default:
+                stage = identifyOutputStage();
+                break;
+        }
+
+        // 6. Apply topology pattern matching to refine identifications
+        if (matchPatterns) applyPatternMatching(stage);
+        return stage;
     }
 
     CircuitStage CircuitAnalyzer::identifyInputStage() {
@@ -230,28 +493,28 @@ namespace LiveSpice {
         stage.type = StageType::InputBuffer;
         stage.name = "Input Buffer";
 
-        auto inputs = findComponentsByType(ComponentType::Input);
+        const auto& inputs = findComponentsByType(ComponentType::Input);
         for (const auto& input : inputs) {
             stage.components.push_back(input);
         }
 
         // Look for coupling capacitor and input resistor
-        auto capacitors = findComponentsByType(ComponentType::Capacitor);
-        auto resistors = findComponentsByType(ComponentType::Resistor);
+        const auto& capacitors = findComponentsByType(ComponentType::Capacitor);
+        const auto& resistors = findComponentsByType(ComponentType::Resistor);
 
         if (!capacitors.empty()) {
             stage.components.push_back(capacitors[0]);
             double cap = capacitors[0]->getParamValueAsDouble("Capacitance");
-            stage.dspParams["coupling_capacitance"] = cap;
+            stage.setParam(StageParam::CouplingCapacitance, cap);
 
             if (!resistors.empty()) {
                 stage.components.push_back(resistors[0]);
                 double res = resistors[0]->getParamValueAsDouble("Resistance");
-                stage.dspParams["input_resistance"] = res;
+                stage.setParam(StageParam::InputResistance, res);
 
                 // Calculate high-pass filter frequency: f = 1/(2*pi*R*C)
                 double freq = 1.0 / (2.0 * M_PI * res * cap);
-                stage.dspParams["highpass_frequency"] = freq;
+                stage.setParam(StageParam::HighpassFrequency, freq);
             }
         }
 
@@ -269,7 +532,7 @@ namespace LiveSpice {
         stage.type = StageType::OutputBuffer;
         stage.name = "Output Buffer";
 
-        auto outputs = findComponentsByType(ComponentType::Output);
+        const auto& outputs = findComponentsByType(ComponentType::Output);
         for (const auto& output : outputs) {
             stage.components.push_back(output);
         }
@@ -288,20 +551,20 @@ namespace LiveSpice {
         stage.type = StageType::GainStage;
         stage.name = "Op-Amp Gain Stage";
 
-        auto opamps = findComponentsByType(ComponentType::OpAmp);
+        const auto& opamps = findComponentsByType(ComponentType::OpAmp);
         if (!opamps.empty()) {
             stage.components.push_back(opamps[0]);
         }
 
         // Try to calculate gain from feedback network
-        auto resistors = findComponentsByType(ComponentType::Resistor);
+        const auto& resistors = findComponentsByType(ComponentType::Resistor);
         if (resistors.size() >= 2) {
             double r1 = resistors[0]->getParamValueAsDouble("Resistance");
             double r2 = resistors[1]->getParamValueAsDouble("Resistance");
             if (r1 > 0) {
                 double gain = 1.0 + (r2 / r1);
-                stage.dspParams["gain_linear"] = gain;
-                stage.dspParams["gain_db"] = 20.0 * log10(gain);
+                stage.setParam(StageParam::GainLinear, gain);
+                stage.setParam(StageParam::GainDb, 20.0 * log10(gain));
             }
         }
 
@@ -316,14 +579,14 @@ namespace LiveSpice {
         stage.type = StageType::GainStage;
         stage.name = "Transistor Gain Stage";
 
-        auto transistors = findComponentsByType(ComponentType::Transistor);
+        const auto& transistors = findComponentsByType(ComponentType::Transistor);
         for (const auto& transistor : transistors) {
             stage.components.push_back(transistor);
         }
 
         // Add nearby resistors/capacitors as context if present
-        auto resistors = findComponentsByType(ComponentType::Resistor);
-        auto capacitors = findComponentsByType(ComponentType::Capacitor);
+        const auto& resistors = findComponentsByType(ComponentType::Resistor);
+        const auto& capacitors = findComponentsByType(ComponentType::Capacitor);
         if (!resistors.empty()) {
             stage.components.push_back(resistors[0]);
         }
@@ -342,8 +605,8 @@ namespace LiveSpice {
         stage.type = StageType::LowPassFilter;
         stage.name = "RC Low-Pass Filter";
 
-        auto resistors = findComponentsByType(ComponentType::Resistor);
-        auto capacitors = findComponentsByType(ComponentType::Capacitor);
+        const auto& resistors = findComponentsByType(ComponentType::Resistor);
+        const auto& capacitors = findComponentsByType(ComponentType::Capacitor);
 
         if (!resistors.empty() && !capacitors.empty()) {
             stage.components.push_back(resistors[0]);
@@ -353,7 +616,7 @@ namespace LiveSpice {
             double cap = capacitors[0]->getParamValueAsDouble("Capacitance");
 
             double cutoff = calculateFilterFrequency(res, cap);
-            stage.dspParams["cutoff_frequency"] = cutoff;
+            stage.setParam(StageParam::CutoffFrequency, cutoff);
         }
 
         populateDSPMapping(stage);
@@ -367,9 +630,9 @@ namespace LiveSpice {
         stage.type = StageType::ToneControl;
         stage.name = "Tone Control";
 
-        auto potentiometers = findComponentsByType(ComponentType::Potentiometer);
-        auto resistors = findComponentsByType(ComponentType::Resistor);
-        auto capacitors = findComponentsByType(ComponentType::Capacitor);
+        const auto& potentiometers = findComponentsByType(ComponentType::Potentiometer);
+        const auto& resistors = findComponentsByType(ComponentType::Resistor);
+        const auto& capacitors = findComponentsByType(ComponentType::Capacitor);
 
         if (!potentiometers.empty()) {
             stage.components.push_back(potentiometers[0]);
@@ -392,8 +655,8 @@ namespace LiveSpice {
         stage.type = StageType::OpAmpClipping;
         stage.name = "Op-Amp Clipping Stage";
 
-        auto opamps = findComponentsByType(ComponentType::OpAmp);
-        auto diodes = findComponentsByType(ComponentType::Diode);
+        const auto& opamps = findComponentsByType(ComponentType::OpAmp);
+        const auto& diodes = findComponentsByType(ComponentType::Diode);
 
         for (const auto& opamp : opamps) {
             stage.components.push_back(opamp);
@@ -404,8 +667,8 @@ namespace LiveSpice {
             // Diode parameters
             double is = diode->getParamValueAsDouble("IS");
             double n = diode->getParamValueAsDouble("n");
-            stage.dspParams["diode_IS"] = is;
-            stage.dspParams["diode_n"] = n;
+            stage.setParam(StageParam::DiodeIS, is);
+            stage.setParam(StageParam::DiodeN, n);
         }
 
         populateDSPMapping(stage);
@@ -429,7 +692,7 @@ namespace LiveSpice {
         return schematic.getNetlist().getComponent(name);
     }
 
-    std::vector<std::shared_ptr<Component>> CircuitAnalyzer::findComponentsByType(ComponentType type) const {
+    const std::vector<std::shared_ptr<Component>>& CircuitAnalyzer::findComponentsByType(ComponentType type) const {
         return circuitGraph.findComponentsByType(type);
     }
 
@@ -439,11 +702,7 @@ namespace LiveSpice {
     }
 
     double CircuitAnalyzer::calculateGain(const CircuitStage& stage) {
-        auto it = stage.dspParams.find("gain_linear");
-        if (it != stage.dspParams.end()) {
-            return it->second;
-        }
-        return 1.0;
+        return stage.params.get(StageParam::GainLinear, 1.0);
     }
 
     std::string CircuitAnalyzer::generateReport() const {
@@ -624,99 +883,80 @@ namespace LiveSpice {
     std::string CircuitAnalyzer::generateConnectivityReport() const {
         // Build connectivity pool if not already done
         const Netlist& netlist = schematic.getNetlist();
-        const_cast<Netlist&>(netlist).buildConnectivityPool();
+        if (!netlist.hasConnectivity()) {
+            const_cast<Netlist&>(netlist).buildConnectivityPool();
+        }
+        const CompactNetlist& compact = netlist.getCompact();
+
+        auto typeLabel = [](ComponentType type) -> std::string {
+            switch (type) {
+                case ComponentType::Resistor: return "Resistor";
+                case ComponentType::Capacitor: return "Capacitor";
+                case ComponentType::Inductor: return "Inductor";
+                case ComponentType::VariableResistor: return "VariableResistor";
+                case ComponentType::Potentiometer: return "Potentiometer";
+                case ComponentType::Diode: return "Diode";
+                case ComponentType::OpAmp: return "OpAmp";
+                case ComponentType::Speaker: return "Speaker";
+                case ComponentType::Input: return "Input";
+                case ComponentType::Output: return "Output";
+                case ComponentType::Ground: return "Ground";
+                case ComponentType::Rail: return "Rail";
+                default: return "Unknown";
+            }
+        };
 
         std::stringstream ss;
         ss << "\n=== Circuit Connectivity Map ===\n\n";
 
-        // Get connectivity information
-        const auto& connectivityPool = netlist.getConnectivityPool();
-        const auto& componentConnections = netlist.getComponentConnections();
-
-        ss << "Total Connection Nodes: " << connectivityPool.size() << "\n";
-        ss << "Total Component Connections: " << componentConnections.size() << "\n";
+        ss << "Total Connection Nodes: " << compact.getNodeCount() << "\n";
+        ss << "Total Component Connections: " << compact.getComponentCount() << "\n";
 
         // List all connection nodes and their components
         ss << "\n=== Connection Nodes ===\n";
         int nodeId = 0;
-        for (const auto& nodeEntry : connectivityPool) {
-            const auto& node = nodeEntry.first;
-            const auto& components = nodeEntry.second;
-            
-            if (!components.empty()) {
-                ss << "\nNode " << nodeId << " (Position: " << node.x << ", " << node.y << ")\n";
-                ss << "  Connected Components:\n";
-                for (const auto& compName : components) {
-                    auto comp = netlist.getComponent(compName);
-                    if (comp) {
-                        std::string typeStr;
-                        switch (comp->getType()) {
-                            case ComponentType::Resistor: typeStr = "Resistor"; break;
-                            case ComponentType::Capacitor: typeStr = "Capacitor"; break;
-                            case ComponentType::Inductor: typeStr = "Inductor"; break;
-                            case ComponentType::VariableResistor: typeStr = "VariableResistor"; break;
-                            case ComponentType::Potentiometer: typeStr = "Potentiometer"; break;
-                            case ComponentType::Diode: typeStr = "Diode"; break;
-                            case ComponentType::OpAmp: typeStr = "OpAmp"; break;
-                            case ComponentType::Speaker: typeStr = "Speaker"; break;
-                            case ComponentType::Input: typeStr = "Input"; break;
-                            case ComponentType::Output: typeStr = "Output"; break;
-                            case ComponentType::Ground: typeStr = "Ground"; break;
-                            case ComponentType::Rail: typeStr = "Rail"; break;
-                            default: typeStr = "Unknown"; break;
-                        }
-                        ss << "    - " << compName << " (" << typeStr << ")\n";
-                    }
-                }
-                nodeId++;
+        for (CompactNetlist::Id n = 0; n < compact.getNodeCount(); ++n) {
+            auto components = compact.componentsAt(n);
+            if (components.empty()) continue;
+
+            const auto& position = compact.nodePositions[n];
+            ss << "\nNode " << nodeId << " (Position: " << position.first << ", " << position.second << ")\n";
+            ss << "  Connected Components:\n";
+            for (CompactNetlist::Id c : components) {
+                const auto& comp = compact.components[c];
+                ss << "    - " << comp->getName() << " (" << typeLabel(comp->getType()) << ")\n";
             }
+            nodeId++;
         }
 
         // List component connections
         ss << "\n=== Component Connection Details ===\n";
-        for (const auto& compEntry : componentConnections) {
-            const auto& compConn = compEntry.second;
-            
-            if (compConn.connectedComponents.empty() && compConn.connectedNodes.size() <= 1) {
+        for (CompactNetlist::Id c = 0; c < compact.getComponentCount(); ++c) {
+            auto nodes = compact.nodesOf(c);
+            auto neighbors = compact.neighborsOf(c);
+
+            if (neighbors.empty() && nodes.size() <= 1) {
                 continue; // Skip isolated components
             }
-            
-            ss << "\n" << compConn.componentName << " (" << compConn.componentType << ")\n";
-            ss << "  Position: (" << compConn.posX << ", " << compConn.posY << ")\n";
-            ss << "  Connected To (" << compConn.connectedComponents.size() << " components):\n";
-            
-            if (compConn.connectedComponents.empty()) {
+
+            const auto& comp = compact.components[c];
+            ss << "\n" << comp->getName() << " (" << componentTypeName(comp->getType()) << ")\n";
+            ss << "  Position: (" << comp->getPosX() << ", " << comp->getPosY() << ")\n";
+            ss << "  Connected To (" << neighbors.size() << " components):\n";
+
+            if (neighbors.empty()) {
                 ss << "    (No other components directly connected)\n";
             } else {
-                for (const auto& connectedComp : compConn.connectedComponents) {
-                    auto comp = netlist.getComponent(connectedComp);
-                    if (comp) {
-                        std::string typeStr;
-                        switch (comp->getType()) {
-                            case ComponentType::Resistor: typeStr = "Resistor"; break;
-                            case ComponentType::Capacitor: typeStr = "Capacitor"; break;
-                            case ComponentType::Inductor: typeStr = "Inductor"; break;
-                            case ComponentType::VariableResistor: typeStr = "VariableResistor"; break;
-                            case ComponentType::Potentiometer: typeStr = "Potentiometer"; break;
-                            case ComponentType::Diode: typeStr = "Diode"; break;
-                            case ComponentType::OpAmp: typeStr = "OpAmp"; break;
-                            case ComponentType::Speaker: typeStr = "Speaker"; break;
-                            case ComponentType::Input: typeStr = "Input"; break;
-                            case ComponentType::Output: typeStr = "Output"; break;
-                            case ComponentType::Ground: typeStr = "Ground"; break;
-                            case ComponentType::Rail: typeStr = "Rail"; break;
-                            default: typeStr = "Unknown"; break;
-                        }
-                        ss << "    - " << connectedComp << " (" << typeStr << ")\n";
-                    }
+                for (CompactNetlist::Id neighbor : neighbors) {
+                    const auto& other = compact.components[neighbor];
+                    ss << "    - " << other->getName() << " (" << typeLabel(other->getType()) << ")\n";
                 }
             }
-            
-            if (!compConn.connectedNodes.empty()) {
-                ss << "  Connection Nodes (" << compConn.connectedNodes.size() << "):\n";
-                for (const auto& node : compConn.connectedNodes) {
-                    ss << "    (" << node.x << ", " << node.y << ")\n";
-                }
+
+            ss << "  Connection Nodes (" << nodes.size() << "):\n";
+            for (CompactNetlist::Id n : nodes) {
+                const auto& position = compact.nodePositions[n];
+                ss << "    (" << position.first << ", " << position.second << ")\n";
             }
         }
 
@@ -818,17 +1058,17 @@ namespace LiveSpice {
             const std::string typeParam = comp->getParamValue("Type");
             const bool isPNP = isLikelyPNP(partNumber, typeParam);
 
-            auto bjtMatch = Nonlinear::ComponentDB::getBJTDB().lookup(partNumber);
-            auto fetMatch = Nonlinear::ComponentDB::getFETDB().lookup(partNumber);
+            const auto* bjtMatch = Nonlinear::ComponentDB::getBJTDB().find(partNumber);
+            const auto* fetMatch = Nonlinear::ComponentDB::getFETDB().find(partNumber);
 
-            if (bjtMatch.has_value()) {
+            if (bjtMatch) {
                 stage.nonlinearComponents.push_back(
                     Nonlinear::ComponentDB::NonlinearComponentInfo::fromBJT(partNumber, componentName, isPNP)
                 );
                 continue;
             }
 
-            if (fetMatch.has_value()) {
+            if (fetMatch) {
                 stage.nonlinearComponents.push_back(
                     Nonlinear::ComponentDB::NonlinearComponentInfo::fromFET(partNumber, componentName, isPNP)
                 );
@@ -857,60 +1097,93 @@ namespace LiveSpice {
     }
 
     void CircuitAnalyzer::applyPatternMatching() {
+        PhaseProfiler::Scope phase("pattern matching");
         for (auto& stage : identifiedStages) {
-            if (stage.components.empty()) continue;
-
-            // Convert stage components to TopologyPatterns format
-            std::vector<TopologyAnalysis::Component> patternComponents;
-            for (size_t i = 0; i < stage.components.size(); ++i) {
-                const auto& comp = stage.components[i];
-                if (!comp) continue;
-                
-                TopologyAnalysis::Component pcomp;
-                pcomp.id = comp->getName();
-                pcomp.type = comp->getType();
-                pcomp.partNumber = comp->getParamValue("PartNumber");
-                pcomp.value = static_cast<float>(comp->getParamValueAsDouble("Value"));
-                patternComponents.push_back(pcomp);
-            }
-
-            // Empty connections for now (simplified matching)
-            std::vector<TopologyAnalysis::Connection> connections;
+            applyPatternMatching(stage);
+        }
+    }
+
+    void CircuitAnalyzer::applyPatternMatching(CircuitStage& stage) {
+        if (stage.components.empty()) return;
+
+        // Convert stage components to TopologyPatterns format
+        std::vector<TopologyAnalysis::Component> patternComponents;
+        for (size_t i = 0; i < stage.components.size(); ++i) {
+            const auto& comp = stage.components[i];
+            if (!comp) continue;
             
-            // Try to match against all patterns
-            auto bestMatch = patternRegistry.matchPattern(patternComponents, connections);
-            if (bestMatch.pattern && bestMatch.confidence > 0.0f) {
-                stage.patternName = bestMatch.pattern->name;
-                
-                // Map pattern category to strategy string
-                switch (bestMatch.pattern->category) {
-                    case TopologyAnalysis::PatternCategory::PassiveFilter:
-                        stage.patternStrategy = "passive_filter"; break;
-                    case TopologyAnalysis::PatternCategory::ActiveFilter:
-                        stage.patternStrategy = "active_filter"; break;
-                    case TopologyAnalysis::PatternCategory::AmplifierStage:
-                        stage.patternStrategy = "amplifier"; break;
-                    case TopologyAnalysis::PatternCategory::ClippingStage:
-                        stage.patternStrategy = "clipping"; break;
-                    case TopologyAnalysis::PatternCategory::ToneControl:
-                        stage.patternStrategy = "tone_control"; break;
-                    case TopologyAnalysis::PatternCategory::FeedbackNetwork:
-                        stage.patternStrategy = "feedback"; break;
-                    case TopologyAnalysis::PatternCategory::Coupling:
-                        stage.patternStrategy = "coupling"; break;
-                    case TopologyAnalysis::PatternCategory::Resonant:
-                        stage.patternStrategy = "resonant"; break;
-                    default:
-                        stage.patternStrategy = "unknown";
-                }
-                
-                stage.patternConfidence = bestMatch.confidence;
-                stage.dspDescription = bestMatch.pattern->description;
-                if (!bestMatch.pattern->dspStrategy.empty()) {
-                    stage.dspDescription += " -> " + bestMatch.pattern->dspStrategy;
-                }
+            TopologyAnalysis::Component pcomp;
+            pcomp.id = comp->getName();
+            pcomp.type = comp->getType();
+            pcomp.partNumber = comp->getParamValue("PartNumber");
+            pcomp.value = static_cast<float>(comp->getParamValueAsDouble("Value"));
+            patternComponents.push_back(pcomp);
+        }
+
+        const std::vector<TopologyAnalysis::Connection> connections = stageConnections(stage);
+
+        // Try to match against all patterns, unless this subcircuit was seen before
+        auto bestMatch = patternCache ? patternCache->matchPattern(patternComponents, connections)
+                                      : patternRegistry.matchPattern(patternComponents, connections);
+        if (bestMatch.pattern && bestMatch.confidence > 0.0f) {
+            stage.patternName = bestMatch.pattern->name;
+            
+            // Map pattern category to strategy string
+            switch (bestMatch.pattern->category) {
+                case TopologyAnalysis::PatternCategory::PassiveFilter:
+                    stage.patternStrategy = "passive_filter"; break;
+                case TopologyAnalysis::PatternCategory::ActiveFilter:
+                    stage.patternStrategy = "active_filter"; break;
+                case TopologyAnalysis::PatternCategory::AmplifierStage:
+                    stage.patternStrategy = "amplifier"; break;
+                case TopologyAnalysis::PatternCategory::ClippingStage:
+                    stage.patternStrategy = "clipping"; break;
+                case TopologyAnalysis::PatternCategory::ToneControl:
+                    stage.patternStrategy = "tone_control"; break;
+                case TopologyAnalysis::PatternCategory::FeedbackNetwork:
+                    stage.patternStrategy = "feedback"; break;
+                case TopologyAnalysis::PatternCategory::Coupling:
+                    stage.patternStrategy = "coupling"; break;
+                case TopologyAnalysis::PatternCategory::Resonant:
+                    stage.patternStrategy = "resonant"; break;
+                default:
+                    stage.patternStrategy = "unknown";
+            }
+            
+            stage.patternConfidence = bestMatch.confidence;
+            stage.dspDescription = bestMatch.pattern->description;
+            if (!bestMatch.pattern->dspStrategy.empty()) {
+                stage.dspDescription += " -> " + bestMatch.pattern->dspStrategy;
+            }
+        }
+    }
+
+    std::vector<TopologyAnalysis::Connection> CircuitAnalyzer::stageConnections(const CircuitStage& stage) const {
+        std::vector<TopologyAnalysis::Connection> connections;
+        const Netlist& netlist = schematic.getNetlist();
+        if (!netlist.hasConnectivity()) return connections;
+        const CompactNetlist& compact = netlist.getCompact();
+
+        std::vector<CompactNetlist::Id> members;
+        for (const auto& comp : stage.components) {
+            if (!comp) continue;
+            const CompactNetlist::Id id = compact.findComponent(comp->getName());
+            if (id != CompactNetlist::NONE) members.push_back(id);
+        }
+        std::sort(members.begin(), members.end());
+        members.erase(std::unique(members.begin(), members.end()), members.end());
+
+        // Neighbour rows are symmetric, so each edge is taken from its lower ID
+        for (CompactNetlist::Id id : members) {
+            for (CompactNetlist::Id neighbor : compact.neighborsOf(id)) {
+                if (neighbor <= id || !std::binary_search(members.begin(), members.end(), neighbor)) continue;
+                TopologyAnalysis::Connection conn;
+                conn.fromId = compact.components[id]->getName();
+                conn.toId = compact.components[neighbor]->getName();
+                connections.push_back(conn);
             }
         }
+        return connections;
     }
 
 } // namespace LiveSpice
@@ -4,9 +4,13 @@
 #include "ComponentDSPMapper.h"
 #include "ComponentCharacteristicsDatabase.h"
 #include "TopologyPatterns.h"
+#include "PatternMatchCache.h"
+#include <array>
+#include <cstdint>
 #include <map>
 #include <set>
 #include <memory>
+#include <unordered_map>
 
 namespace LiveSpice {
 
@@ -26,11 +30,57 @@ namespace LiveSpice {
         Unknown
     };
 
+    // ============================================================================
+    // Stage Parameters - Typed DSP parameters in a flat, enum-indexed array
+    // ============================================================================
+    enum class StageParam : uint8_t {
+        CouplingCapacitance,
+        InputResistance,
+        HighpassFrequency,
+        GainLinear,
+        GainDb,
+        CutoffFrequency,
+        DiodeIS,
+        DiodeN,
+        Count
+    };
+
+    /** dspParams key of a typed parameter ("coupling_capacitance", ...) */
+    const char* stageParamName(StageParam param);
+
+    /** Inverse of stageParamName; false for keys without a typed slot */
+    bool stageParamFromName(const std::string& name, StageParam& param);
+
+    struct StageParams {
+        std::array<double, static_cast<size_t>(StageParam::Count)> values{};
+        uint32_t present = 0;  // Bit per StageParam
+
+        bool has(StageParam param) const { return (present & bit(param)) != 0; }
+
+        // nullptr when the analyzer did not set it
+        const double* find(StageParam param) const {
+            return has(param) ? &values[static_cast<size_t>(param)] : nullptr;
+        }
+
+        double get(StageParam param, double fallback) const {
+            return has(param) ? values[static_cast<size_t>(param)] : fallback;
+        }
+
+        void set(StageParam param, double value) {
+            values[static_cast<size_t>(param)] = value;
+            present |= bit(param);
+        }
+
+    private:
+        static uint32_t bit(StageParam param) { return 1u << static_cast<uint32_t>(param); }
+    };
+
     struct CircuitStage {
         StageType type;
         std::string name;
         std::vector<std::shared_ptr<Component>> components;
-        std::map<std::string, double> dspParams; // Parameters for DSP implementation
+        std::map<std::string, double> dspParams; // Parameters for DSP implementation (reports, cache)
+        StageParams params;                      // Typed copy of the known dspParams (codegen)
         std::vector<Nonlinear::ComponentDB::NonlinearComponentInfo> nonlinearComponents;
         std::string patternName;
         std::string patternStrategy;
@@ -39,6 +89,12 @@ namespace LiveSpice {
         // LiveSPICE component DSP mapping
         ComponentDSPMapper::DSPProcessorType primaryProcessorType;
         std::string dspDescription;
+
+        // Set a typed parameter and its dspParams entry
+        void setParam(StageParam param, double value) {
+            params.set(param, value);
+            dspParams[stageParamName(param)] = value;
+        }
     };
 
     // ============================================================================
@@ -74,24 +130,65 @@ namespace LiveSpice {
     // ============================================================================
     class CircuitGraph {
     public:
+        using NetId = uint32_t;
+        static constexpr NetId NO_NET = ~NetId(0);
+
         CircuitGraph(const Netlist& netlist);
 
-        const std::map<std::pair<int, int>, Node>& getNodes() const { return nodes; }
+        // Wire endpoints, sorted by position
+        const std::vector<Node>& getNodes() const { return nodes; }
         const std::vector<Wire>& getWires() const { return wires; }
 
-        // Find all components of a specific type
-        std::vector<std::shared_ptr<Component>> findComponentsByType(ComponentType type) const;
+        // Component by name; nullptr when absent
+        std::shared_ptr<Component> findComponent(const std::string& name) const;
 
-        // Find nodes connected to a component
+        // All components of a specific type, in name order (bucketed at construction)
+        const std::vector<std::shared_ptr<Component>>& findComponentsByType(ComponentType type) const {
+            return componentsByType[static_cast<size_t>(type)];
+        }
+
+        // Find nodes connected to a component (wire endpoints within the pin window)
         std::vector<Node> getConnectedNodes(std::shared_ptr<Component> comp) const;
 
-        // Check if node is ground
+        // Electrical nets: wire endpoints merged across wires. A component sits
+        // on the net of its position (its own net when no wire reaches it).
+        size_t getNetCount() const { return netComponentOffsets.size() - 1; }
+        NetId getNet(const Node& node) const;
+        NetId getNet(const std::shared_ptr<Component>& comp) const;
+
+        // Components on a net / sharing a net with comp (excluding comp)
+        std::vector<std::shared_ptr<Component>> getComponentsOnNet(NetId net) const;
+        std::vector<std::shared_ptr<Component>> getNeighbors(const std::shared_ptr<Component>& comp) const;
+
+        // Check if node is ground (a ground symbol sits on its net)
         bool isGroundNode(const Node& node) const;
 
     private:
-        std::map<std::pair<int, int>, Node> nodes;
+        std::vector<Node> nodes;
+        std::vector<NetId> nodeNet;
         std::vector<Wire> wires;
         std::vector<std::shared_ptr<Component>> allComponents;
+        std::array<std::vector<std::shared_ptr<Component>>,
+                   static_cast<size_t>(ComponentType::Unknown) + 1> componentsByType;
+
+        // Component index -> net, nodes in its pin window (CSR); net -> components (CSR)
+        std::unordered_map<const Component*, uint32_t> componentIndex;
+        std::vector<NetId> componentNet;
+        std::vector<uint32_t> windowOffsets, windowNodeIds;
+        std::vector<uint32_t> netComponentOffsets, netComponentIds;
+        std::vector<bool> groundNet;
+
+        uint32_t findNode(int x, int y) const;
+    };
+
+    // ============================================================================
+    // Circuit Delta - Netlist edits made since the last analysis
+    // ============================================================================
+    struct CircuitDelta {
+        std::vector<std::string> addedComponents;    // Now in the netlist
+        std::vector<std::string> removedComponents;  // No longer in the netlist
+        std::vector<std::string> changedComponents;  // Parameter edits
+        bool wiresChanged = false;                   // Wires added/removed or components moved
     };
 
     // ============================================================================
@@ -102,6 +199,29 @@ namespace LiveSpice {
         CircuitAnalyzer(const Schematic& schematic);
 
         std::vector<CircuitStage> analyzeCircuit();
+
+        // Apply an edit already made to the schematic's netlist: the graph is
+        // rebuilt only when connectivity changed, and only stages whose
+        // components (or component types) were touched are re-identified and
+        // re-matched. Untouched stages come from the previous analysis.
+        std::vector<CircuitStage> reanalyzeCircuit(const CircuitDelta& delta);
+
+        // Identify independent stages as parallel tasks (off by default). The
+        // tasks only read the graph; results merge back in analysis order.
+        void setParallelStages(bool enabled) { parallelStages = enabled; }
+
+        // Match stages through a subcircuit-keyed result cache (the shared
+        // one by default); nullptr matches every stage from scratch
+        void setPatternMatchCache(TopologyAnalysis::PatternMatchCache* cache) { patternCache = cache; }
+
+        // Adopt stages from an earlier analysis (NetlistCache) instead of analyzeCircuit()
+        void restoreStages(const std::vector<CircuitStage>& stages) {
+            identifiedStages = stages;
+            slotValid.fill(false);
+        }
+        // Stages from the last analyzeCircuit(), reanalyzeCircuit() or restoreStages()
+        const std::vector<CircuitStage>& getStages() const { return identifiedStages; }
+
         std::string generateReport() const;
         std::string generateConnectivityReport() const;
 
@@ -110,7 +230,19 @@ namespace LiveSpice {
         CircuitGraph circuitGraph;
         std::vector<CircuitStage> identifiedStages;
         ComponentDSPMapper dspMapper;  // LiveSPICE component to DSP mapper
-    TopologyAnalysis::PatternRegistry patternRegistry;  // Pattern matching system
+    const TopologyAnalysis::PatternRegistry& patternRegistry;  // Shared pattern matching system
+        TopologyAnalysis::PatternMatchCache* patternCache;         // Results for known subcircuits
+
+        // Stage slots in analysis order; valid slots are reused by reanalyzeCircuit()
+        enum StageSlot { InputSlot, OpAmpSlot, TransistorSlot, ToneControlSlot, FilterSlot, OutputSlot, SlotCount };
+        std::array<CircuitStage, SlotCount> slotStages;
+        std::array<bool, SlotCount> slotValid{};
+        bool parallelStages = false;
+
+        // Fill identifiedStages, identifying and matching invalid slots only
+        void buildStages();
+        bool isSlotPresent(StageSlot slot) const;
+        CircuitStage identifySlot(StageSlot slot, bool matchPatterns);
 
         // Stage identification methods
         CircuitStage identifyInputStage();
@@ -124,7 +256,7 @@ namespace LiveSpice {
 
         // Helper methods
         std::shared_ptr<Component> findComponentByName(const std::string& name) const;
-        std::vector<std::shared_ptr<Component>> findComponentsByType(ComponentType type) const;
+        const std::vector<std::shared_ptr<Component>>& findComponentsByType(ComponentType type) const;
 
         // DSP parameter calculation
         double calculateFilterFrequency(double resistance, double capacitance);
@@ -141,6 +273,11 @@ namespace LiveSpice {
         
         // Pattern matching integration (Phase 2)
         void applyPatternMatching();
+        void applyPatternMatching(CircuitStage& stage);
+
+        // Edges between a stage's components: components sharing a node or
+        // joined by one wire (the compact netlist's neighbour rows)
+        std::vector<TopologyAnalysis::Connection> stageConnections(const CircuitStage& stage) const;
     };
 
 } // namespace LiveSpice
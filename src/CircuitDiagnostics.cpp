@@ -4,6 +4,16 @@
 
 namespace LiveSpice {
 
+    CircuitDiagnostics::CircuitDiagnostics(const Schematic& schematic)
+        : schematic(schematic) {
+        nodes = extractComponentNodes();
+        for (uint32_t i = 0; i < nodes.size(); ++i) {
+            nodeIndex.emplace(nodes[i].name, i);
+        }
+        wires = analyzeWires();
+        buildAdjacency();
+    }
+
     std::vector<CircuitDiagnostics::ComponentNode> CircuitDiagnostics::extractComponentNodes() const {
         std::vector<ComponentNode> nodes;
         const Netlist& netlist = schematic.getNetlist();
@@ -43,9 +53,15 @@ namespace LiveSpice {
 
     std::vector<CircuitDiagnostics::WireData> CircuitDiagnostics::analyzeWires() const {
         const Netlist& netlist = schematic.getNetlist();
-        auto nodes = extractComponentNodes();
         std::vector<WireData> wires;
 
+        // Position -> components placed there, in node order
+        std::map<std::pair<int, int>, std::vector<std::string>> componentsAt;
+        for (const auto& node : nodes) {
+            componentsAt[{node.x, node.y}].push_back(node.name);
+        }
+
+        wires.reserve(netlist.getWireCount());
         for (const auto& wire : netlist.getWires()) {
             WireData wd;
             wd.x1 = wire.nodeA_X;
@@ -54,14 +70,10 @@ namespace LiveSpice {
             wd.y2 = wire.nodeB_Y;
 
             // Find components at wire endpoints
-            for (const auto& node : nodes) {
-                if (node.x == wd.x1 && node.y == wd.y1) {
-                    wd.componentsAtStart.push_back(node.name);
-                }
-                if (node.x == wd.x2 && node.y == wd.y2) {
-                    wd.componentsAtEnd.push_back(node.name);
-                }
-            }
+            auto start = componentsAt.find({wd.x1, wd.y1});
+            if (start != componentsAt.end()) wd.componentsAtStart = start->second;
+            auto end = componentsAt.find({wd.x2, wd.y2});
+            if (end != componentsAt.end()) wd.componentsAtEnd = end->second;
 
             wires.push_back(wd);
         }
@@ -69,9 +81,122 @@ namespace LiveSpice {
         return wires;
     }
 
+    void CircuitDiagnostics::buildAdjacency() {
+        // A component at one end of a wire leads to the first component at
+        // the other end (the start end wins when it is at both)
+        std::vector<std::pair<uint32_t, uint32_t>> edges;
+        std::vector<std::pair<uint32_t, uint32_t>> incidence;
+        for (uint32_t w = 0; w < wires.size(); ++w) {
+            const auto& wire = wires[w];
+            const uint32_t firstAtStart = wire.componentsAtStart.empty() ? NONE : findNode(wire.componentsAtStart[0]);
+            const uint32_t firstAtEnd = wire.componentsAtEnd.empty() ? NONE : findNode(wire.componentsAtEnd[0]);
+            for (const auto& name : wire.componentsAtStart) {
+                const uint32_t c = findNode(name);
+                incidence.emplace_back(c, w);
+                if (firstAtEnd != NONE) edges.emplace_back(c, firstAtEnd);
+            }
+            for (const auto& name : wire.componentsAtEnd) {
+                const uint32_t c = findNode(name);
+                const bool alsoAtStart = std::find(wire.componentsAtStart.begin(), wire.componentsAtStart.end(),
+                                                   name) != wire.componentsAtStart.end();
+                if (alsoAtStart) continue;
+                incidence.emplace_back(c, w);
+                if (firstAtStart != NONE) edges.emplace_back(c, firstAtStart);
+            }
+        }
+
+        // Stable bucketing keeps each row in wire order
+        auto buildRows = [&](const std::vector<std::pair<uint32_t, uint32_t>>& pairs,
+                             std::vector<uint32_t>& offsets, std::vector<uint32_t>& ids) {
+            offsets.assign(nodes.size() + 1, 0);
+            for (const auto& p : pairs) offsets[p.first + 1]++;
+            for (size_t r = 0; r < nodes.size(); ++r) offsets[r + 1] += offsets[r];
+            ids.resize(pairs.size());
+            std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+            for (const auto& p : pairs) ids[fill[p.first]++] = p.second;
+        };
+        buildRows(edges, adjacencyOffsets, adjacencyIds);
+        buildRows(incidence, wireOffsets, wireIds);
+    }
+
+    void CircuitDiagnostics::buildReachability() const {
+        const size_t n = nodes.size();
+        reachable.assign(n * n, false);
+        std::vector<uint32_t> queue;
+        queue.reserve(n);
+        for (uint32_t from = 0; from < n; ++from) {
+            auto row = reachable.begin() + static_cast<std::ptrdiff_t>(from * n);
+            queue.assign(1, from);
+            row[from] = true;
+            for (size_t head = 0; head < queue.size(); ++head) {
+                const uint32_t current = queue[head];
+                for (uint32_t i = adjacencyOffsets[current]; i < adjacencyOffsets[current + 1]; ++i) {
+                    const uint32_t next = adjacencyIds[i];
+                    if (!row[next]) {
+                        row[next] = true;
+                        queue.push_back(next);
+                    }
+                }
+            }
+        }
+    }
+
+    uint32_t CircuitDiagnostics::findNode(const std::string& name) const {
+        auto it = nodeIndex.find(name);
+        return it != nodeIndex.end() ? it->second : NONE;
+    }
+
+    bool CircuitDiagnostics::shareWire(uint32_t a, uint32_t b) const {
+        // Rows are in wire order, so a merge walk finds a common wire
+        uint32_t i = wireOffsets[a], j = wireOffsets[b];
+        while (i < wireOffsets[a + 1] && j < wireOffsets[b + 1]) {
+            if (wireIds[i] == wireIds[j]) return true;
+            if (wireIds[i] < wireIds[j]) ++i; else ++j;
+        }
+        return false;
+    }
+
+    bool CircuitDiagnostics::isReachable(const std::string& startComponent,
+                                         const std::string& endComponent) const {
+        const uint32_t from = findNode(startComponent);
+        const uint32_t to = findNode(endComponent);
+        if (from == NONE || to == NONE) return false;
+        std::call_once(reachabilityOnce, [this] { buildReachability(); });
+        return reachable[from * nodes.size() + to];
+    }
+
+    std::vector<std::string> CircuitDiagnostics::findSignalPath(const std::string& startComponent,
+                                                                const std::string& endComponent) const {
+        std::vector<std::string> path;
+        const uint32_t from = findNode(startComponent);
+        const uint32_t to = findNode(endComponent);
+        if (from == NONE || to == NONE) return path;
+
+        // BFS; successors in wire order, so ties resolve as the wire list does
+        std::vector<uint32_t> parent(nodes.size(), NONE);
+        std::vector<uint32_t> queue(1, from);
+        parent[from] = from;
+        for (size_t head = 0; head < queue.size() && parent[to] == NONE; ++head) {
+            const uint32_t current = queue[head];
+            for (uint32_t i = adjacencyOffsets[current]; i < adjacencyOffsets[current + 1]; ++i) {
+                const uint32_t next = adjacencyIds[i];
+                if (parent[next] == NONE) {
+                    parent[next] = current;
+                    queue.push_back(next);
+                }
+            }
+        }
+        if (parent[to] == NONE) return path;
+
+        for (uint32_t node = to; node != from; node = parent[node]) {
+            path.push_back(nodes[node].name);
+        }
+        path.push_back(nodes[from].name);
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
     std::string CircuitDiagnostics::generateWireMapping() const {
-        auto wires = analyzeWires();
-        auto nodes = extractComponentNodes();
         std::ostringstream ss;
 
         ss << "\n" << std::string(130, '=') << "\n";
@@ -141,8 +266,6 @@ namespace LiveSpice {
     }
 
     std::string CircuitDiagnostics::analyzeConnectivityFailures() const {
-        auto wires = analyzeWires();
-        auto nodes = extractComponentNodes();
         std::ostringstream ss;
 
         ss << "\n" << std::string(130, '=') << "\n";
@@ -213,37 +336,15 @@ namespace LiveSpice {
         };
 
         for (const auto& path : expectedPaths) {
-            bool found = false;
-
-            // Check if both components exist
-            auto startIt = std::find_if(nodes.begin(), nodes.end(),
-                [&](const ComponentNode& n) { return n.name == path.first; });
-            auto endIt = std::find_if(nodes.begin(), nodes.end(),
-                [&](const ComponentNode& n) { return n.name == path.second; });
-
-            if (startIt != nodes.end() && endIt != nodes.end()) {
-                // Check if there's a wire connecting them (directly or through routing)
-                for (const auto& w : wires) {
-                    // Direct connection check
-                    bool startAtBegin = std::find(w.componentsAtStart.begin(), w.componentsAtStart.end(), 
-                                                  path.first) != w.componentsAtStart.end();
-                    bool startAtEnd = std::find(w.componentsAtEnd.begin(), w.componentsAtEnd.end(),
-                                               path.first) != w.componentsAtEnd.end();
-                    bool endAtBegin = std::find(w.componentsAtStart.begin(), w.componentsAtStart.end(),
-                                               path.second) != w.componentsAtStart.end();
-                    bool endAtEnd = std::find(w.componentsAtEnd.begin(), w.componentsAtEnd.end(),
-                                             path.second) != w.componentsAtEnd.end();
-
-                    if ((startAtBegin || startAtEnd) && (endAtBegin || endAtEnd)) {
-                        found = true;
-                        break;
-                    }
-                }
-            }
+            // Direct: both on one wire; reachable: through other components
+            const uint32_t start = findNode(path.first);
+            const uint32_t end = findNode(path.second);
+            const bool found = start != NONE && end != NONE && shareWire(start, end);
+            const bool reachableVia = !found && isReachable(path.first, path.second);
 
             ss << "  " << std::setw(10) << std::left << path.first 
                << " -> " << std::setw(10) << std::left << path.second 
-               << ": " << (found ? "FOUND" : "MISSING") << "\n";
+               << ": " << (found ? "FOUND" : reachableVia ? "REACHABLE (indirect)" : "MISSING") << "\n";
         }
 
         ss << "\n" << std::string(130, '=') << "\n";
@@ -281,58 +382,20 @@ namespace LiveSpice {
 
     std::string CircuitDiagnostics::traceSignalPath(const std::string& startComponent, 
                                                     const std::string& endComponent) const {
-        auto wires = analyzeWires();
-        auto nodes = extractComponentNodes();
         std::ostringstream ss;
 
         ss << "\nTracing signal path from " << startComponent << " to " << endComponent << "...\n\n";
 
-        // Simple BFS to find path
-        std::map<std::string, std::string> parent;
-        std::map<std::string, bool> visited;
-        std::vector<std::string> queue;
-
-        queue.push_back(startComponent);
-        visited[startComponent] = true;
-
-        while (!queue.empty()) {
-            std::string current = queue.front();
-            queue.erase(queue.begin());
-
-            if (current == endComponent) {
-                ss << "Path found:\n";
-                std::vector<std::string> path;
-                std::string node = endComponent;
-                while (!node.empty()) {
-                    path.insert(path.begin(), node);
-                    node = parent[node];
-                }
-                for (size_t i = 0; i < path.size(); ++i) {
-                    ss << "  " << i << ". " << path[i] << "\n";
-                }
-                return ss.str();
-            }
-
-            // Find connected components
-            for (const auto& w : wires) {
-                std::string next;
-                bool currentAtStart = std::find(w.componentsAtStart.begin(), w.componentsAtStart.end(),
-                                               current) != w.componentsAtStart.end();
-                bool currentAtEnd = std::find(w.componentsAtEnd.begin(), w.componentsAtEnd.end(),
-                                             current) != w.componentsAtEnd.end();
-
-                if (currentAtStart && !w.componentsAtEnd.empty()) {
-                    next = w.componentsAtEnd[0];
-                } else if (currentAtEnd && !w.componentsAtStart.empty()) {
-                    next = w.componentsAtStart[0];
-                }
-
-                if (!next.empty() && !visited[next]) {
-                    visited[next] = true;
-                    parent[next] = current;
-                    queue.push_back(next);
-                }
+        std::vector<std::string> path = findSignalPath(startComponent, endComponent);
+        if (path.empty() && startComponent == endComponent) {
+            path.push_back(startComponent);
+        }
+        if (!path.empty()) {
+            ss << "Path found:\n";
+            for (size_t i = 0; i < path.size(); ++i) {
+                ss << "  " << i << ". " << path[i] << "\n";
             }
+            return ss.str();
         }
 
         ss << "No path found between " << startComponent << " and " << endComponent << "\n";
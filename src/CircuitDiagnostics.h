@@ -1,6 +1,9 @@
 #pragma once
 
 #include "LiveSpiceParser.h"
+#include <cstdint>
+#include <map>
+#include <mutex>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -17,11 +20,14 @@ namespace LiveSpice {
      * - Position matching analysis
      * - Signal path tracing attempts
      * - Gap analysis (what connections are missing)
+     *
+     * Component positions and wire endpoints are resolved once, in the
+     * constructor, into an integer adjacency graph; path queries are BFS over
+     * it. All-pairs reachability is computed on first use and cached.
      */
     class CircuitDiagnostics {
     public:
-        CircuitDiagnostics(const Schematic& schematic)
-            : schematic(schematic) {}
+        CircuitDiagnostics(const Schematic& schematic);
 
         /**
          * Generate comprehensive diagnostics for troubleshooting extraction issues
@@ -33,6 +39,17 @@ namespace LiveSpice {
          */
         std::string traceSignalPath(const std::string& startComponent, const std::string& endComponent) const;
 
+        /**
+         * Components on the shortest wire path from start to end (both
+         * included); empty when either is unknown or no path exists
+         */
+        std::vector<std::string> findSignalPath(const std::string& startComponent, const std::string& endComponent) const;
+
+        /**
+         * True when end can be reached from start by following wires
+         */
+        bool isReachable(const std::string& startComponent, const std::string& endComponent) const;
+
         /**
          * Analyze why connectivity isn't being detected
          */
@@ -59,8 +76,27 @@ namespace LiveSpice {
             std::vector<std::string> componentsAtEnd;
         };
 
+        static constexpr uint32_t NONE = ~uint32_t(0);
+
+        std::vector<ComponentNode> nodes;
+        std::vector<WireData> wires;
+        std::map<std::string, uint32_t> nodeIndex;  // Component name -> nodes index
+
+        // Component -> BFS successors, in wire order (CSR)
+        std::vector<uint32_t> adjacencyOffsets, adjacencyIds;
+        // Component -> wires with it at either endpoint (CSR)
+        std::vector<uint32_t> wireOffsets, wireIds;
+
+        // reachable[from * nodes.size() + to], built on first use
+        mutable std::once_flag reachabilityOnce;
+        mutable std::vector<bool> reachable;
+
         std::vector<ComponentNode> extractComponentNodes() const;
         std::vector<WireData> analyzeWires() const;
+        void buildAdjacency();
+        void buildReachability() const;
+        uint32_t findNode(const std::string& name) const;
+        bool shareWire(uint32_t a, uint32_t b) const;
         std::string positionToString(int x, int y) const;
     };
 
@@ -3,6 +3,7 @@
 #include <sstream>
 #include <algorithm>
 #include <cmath>
+#include <thread>
 
 namespace LiveSpice {
 
@@ -82,9 +83,66 @@ namespace LiveSpice {
         }
     }
 
-    std::string CircuitVisualizer::generateComponentDetailsTable() const {
+    namespace {
+        bool isDrawnComponent(const Component& comp) {
+            return comp.getType() != ComponentType::Wire && comp.getType() != ComponentType::Label;
+        }
+
+        // Each section starts from default formatting and leaves the caller's as it was
+        class SectionFormat {
+        public:
+            explicit SectionFormat(std::ostream& out)
+                : out(out), flags(out.flags()), precision(out.precision()), fill(out.fill()) {
+                out.flags(std::ios::dec | std::ios::skipws);
+                out.precision(6);
+                out.fill(' ');
+            }
+            ~SectionFormat() {
+                out.flags(flags);
+                out.precision(precision);
+                out.fill(fill);
+            }
+
+        private:
+            std::ostream& out;
+            std::ios::fmtflags flags;
+            std::streamsize precision;
+            char fill;
+        };
+    }
+
+    template <typename RenderRow>
+    void CircuitVisualizer::writeRows(std::ostream& out, size_t count, bool parallel, RenderRow renderRow) const {
+        const unsigned threads = std::min<size_t>(jobs != 0 ? jobs : std::max(1u, std::thread::hardware_concurrency()),
+                                                  count);
+        if (!parallel || threads <= 1) {
+            for (size_t i = 0; i < count; ++i) renderRow(out, i);
+            return;
+        }
+
+        // Contiguous slices, so writing them back in slice order keeps row order
+        std::vector<std::string> slices(threads);
+        std::vector<std::thread> pool;
+        auto renderSlice = [&](unsigned slice) {
+            std::ostringstream ss;
+            for (size_t i = count * slice / threads; i < count * (slice + 1) / threads; ++i) renderRow(ss, i);
+            slices[slice] = ss.str();
+        };
+        for (unsigned slice = 1; slice < threads; ++slice) {
+            pool.emplace_back(renderSlice, slice);
+        }
+        renderSlice(0);
+        for (auto& thread : pool) {
+            thread.join();
+        }
+        for (const auto& slice : slices) {
+            out << slice;
+        }
+    }
+
+    void CircuitVisualizer::writeComponentDetailsTable(std::ostream& ss) const {
+        SectionFormat format(ss);
         const Netlist& netlist = schematic.getNetlist();
-        std::ostringstream ss;
 
         ss << "+" << std::string(92, '-') << "+\n";
         ss << "| PARSED COMPONENTS FROM LIVESPICE FILE                                              |\n";
@@ -92,12 +150,14 @@ namespace LiveSpice {
         ss << "| Ref     | Type                 | Val|ue      | Properties               | Pos    |\n";
         ss << "+---------+----------------------+----+--------+---------------------------+--------+\n";
 
+        std::vector<const Component*> rows;
+        rows.reserve(netlist.getComponentCount());
         for (const auto& pair : netlist.getComponents()) {
-            const auto& comp = pair.second;
-            
-            if (comp->getType() == ComponentType::Wire || comp->getType() == ComponentType::Label) {
-                continue; // Skip non-components
-            }
+            if (isDrawnComponent(*pair.second)) rows.push_back(pair.second.get());
+        }
+
+        writeRows(ss, rows.size(), rows.size() >= PARALLEL_MIN_ROWS, [&](std::ostream& row, size_t i) {
+            const Component* comp = rows[i];
 
             std::string type = componentTypeToString(comp->getType());
             type = type.substr(0, 20); // Truncate if too long
@@ -118,107 +178,74 @@ namespace LiveSpice {
 
             int x, y;
             comp->getPosition(x, y);
-            std::ostringstream pos;
-            pos << "(" << x << "," << y << ")";
-            std::string posStr = pos.str().substr(0, 8);
+            std::string posStr = "(" + std::to_string(x) + "," + std::to_string(y) + ")";
+            posStr = posStr.substr(0, 8);
             posStr.resize(8, ' ');
 
-            ss << "| " << std::setw(7) << std::left << comp->getName() << " | " 
-               << type << " | " << value << " | " << props << " | " << posStr << " |\n";
-        }
+            row << "| " << std::setw(7) << std::left << comp->getName() << " | "
+                << type << " | " << value << " | " << props << " | " << posStr << " |\n";
+        });
 
         ss << "+---------+----------------------+--+----------+---------------------------+--------+\n";
         ss << "Total Components Parsed: " << netlist.getComponentCount() << "\n";
-
-        return ss.str();
     }
 
     std::string CircuitVisualizer::generateParsedComponents() const {
-        return generateComponentDetailsTable();
+        std::ostringstream ss;
+        writeComponentDetailsTable(ss);
+        return ss.str();
     }
 
-    std::string CircuitVisualizer::generateNodeConnectivityTable() const {
+    void CircuitVisualizer::writeNodeConnectivityTable(std::ostream& ss) const {
+        SectionFormat format(ss);
         const Netlist& netlist = schematic.getNetlist();
-        std::ostringstream ss;
 
         ss << "\n" << std::string(110, '=') << "\n";
         ss << "ANALYZED NODE CONNECTIVITY (How Program Determined Components Connect)\n";
         ss << std::string(110, '=') << "\n\n";
 
-        const auto& componentConnections = netlist.getConnectivityPool();
-        
-        // Group components by their position to show connections
-        std::map<std::string, std::vector<std::string>> connectionMap;
-        
-        for (const auto& pair : netlist.getComponents()) {
-            const auto& comp = pair.second;
-            if (comp->getType() == ComponentType::Wire || comp->getType() == ComponentType::Label) {
-                continue;
-            }
-
-            std::string compName = comp->getName();
-            connectionMap[compName] = std::vector<std::string>();
+        // The analyzer's connectivity report normally built this already
+        if (!netlist.hasConnectivity()) {
+            const_cast<Netlist&>(netlist).buildConnectivityPool();
         }
+        const CompactNetlist& compact = netlist.getCompact();
 
-        // Analyze wire connections to determine connectivity
-        for (const auto& wire : netlist.getWires()) {
-            // Find components at wire endpoints
-            std::vector<std::string> connectedAtNodeA;
-            std::vector<std::string> connectedAtNodeB;
-
-            for (const auto& pair : netlist.getComponents()) {
-                const auto& comp = pair.second;
-                int x, y;
-                comp->getPosition(x, y);
-                
-                if (x == wire.nodeA_X && y == wire.nodeA_Y) {
-                    connectedAtNodeA.push_back(comp->getName());
-                }
-                if (x == wire.nodeB_X && y == wire.nodeB_Y) {
-                    connectedAtNodeB.push_back(comp->getName());
-                }
-            }
-
-            // Cross-link the connections
-            for (const auto& compA : connectedAtNodeA) {
-                for (const auto& compB : connectedAtNodeB) {
-                    if (compA != compB) {
-                        connectionMap[compA].push_back(compB);
-                    }
-                }
-            }
+        // Components sharing a wire hop, in name order like the compact form
+        std::vector<CompactNetlist::Id> rows;
+        rows.reserve(compact.getComponentCount());
+        for (CompactNetlist::Id c = 0; c < compact.getComponentCount(); ++c) {
+            if (isDrawnComponent(*compact.components[c])) rows.push_back(c);
         }
 
-        // Output the connectivity table
-        for (const auto& pair : connectionMap) {
-            std::string compName = pair.first;
-            const auto& connections = pair.second;
+        writeRows(ss, rows.size(), rows.size() >= PARALLEL_MIN_ROWS, [&](std::ostream& row, size_t i) {
+            const auto neighbors = compact.neighborsOf(rows[i]);
+            row << "  " << std::setw(20) << std::left << (compact.components[rows[i]]->getName() + ":") << " -> ";
 
-            ss << "  " << std::setw(20) << std::left << (compName + ":") << " -> ";
-
-            if (connections.empty()) {
-                ss << "(No connections found)";
+            if (neighbors.empty()) {
+                row << "(No connections found)";
             } else {
-                for (size_t i = 0; i < connections.size(); ++i) {
-                    if (i > 0) ss << ", ";
-                    ss << connections[i];
+                bool first = true;
+                for (CompactNetlist::Id neighbor : neighbors) {
+                    if (!first) row << ", ";
+                    row << compact.components[neighbor]->getName();
+                    first = false;
                 }
             }
-            ss << "\n";
-        }
+            row << "\n";
+        });
 
         ss << "\n";
-
-        return ss.str();
     }
 
     std::string CircuitVisualizer::generateAnalyzedConnectivity() const {
-        return generateNodeConnectivityTable();
+        std::ostringstream ss;
+        writeNodeConnectivityTable(ss);
+        return ss.str();
     }
 
-    std::string CircuitVisualizer::generateStageBreakdown() const {
-        std::ostringstream ss;
-        auto stages = const_cast<CircuitAnalyzer&>(analyzer).analyzeCircuit();
+    void CircuitVisualizer::writeStageBreakdown(std::ostream& ss) const {
+        SectionFormat format(ss);
+        const auto& stages = analyzer.getStages();
 
         ss << "\n" << std::string(110, '=') << "\n";
         ss << "IDENTIFIED CIRCUIT STAGES (Program's Topology Analysis)\n";
@@ -226,47 +253,47 @@ namespace LiveSpice {
 
         if (stages.empty()) {
             ss << "WARNING: No circuit stages identified. Check parsing and analysis.\n";
-            return ss.str();
+            return;
         }
 
-        for (size_t i = 0; i < stages.size(); ++i) {
+        size_t stageComponents = 0;
+        for (const auto& stage : stages) stageComponents += stage.components.size();
+
+        writeRows(ss, stages.size(), stageComponents >= PARALLEL_MIN_ROWS, [&](std::ostream& row, size_t i) {
             const auto& stage = stages[i];
 
-            ss << "  STAGE " << (i + 1) << ": " << stageTypeToString(stage.type) << "\n";
-            ss << "  " << std::string(72, '-') << "\n";
-            ss << "  Expected DSP Module: " << getExpectedDSPModule(stage.type) << "\n\n";
+            row << "  STAGE " << (i + 1) << ": " << stageTypeToString(stage.type) << "\n";
+            row << "  " << std::string(72, '-') << "\n";
+            row << "  Expected DSP Module: " << getExpectedDSPModule(stage.type) << "\n\n";
 
-            ss << "  Components in this stage:\n";
+            row << "  Components in this stage:\n";
             for (const auto& comp : stage.components) {
-                ss << "    * " << comp->getName() << " (" << componentTypeToString(comp->getType()) << ")\n";
-                auto params = comp->getParams();
-                if (!params.empty()) {
-                    for (const auto& param : params) {
-                        ss << "      - " << param.name << ": " << param.value;
-                        if (!param.unit.empty()) ss << " " << param.unit;
-                        ss << "\n";
-                    }
+                row << "    * " << comp->getName() << " (" << componentTypeToString(comp->getType()) << ")\n";
+                for (const auto& param : comp->getParams()) {
+                    row << "      - " << param.name << ": " << param.value;
+                    if (!param.unit.empty()) row << " " << param.unit;
+                    row << "\n";
                 }
             }
 
-            ss << "\n  DSP Parameters:\n";
+            row << "\n  DSP Parameters:\n";
             for (const auto& param : stage.dspParams) {
-                ss << "    * " << param.first << ": " << std::fixed << std::setprecision(2) << param.second << "\n";
+                row << "    * " << param.first << ": " << std::fixed << std::setprecision(2) << param.second << "\n";
             }
 
-            ss << "\n";
-        }
-
-        return ss.str();
+            row << "\n";
+        });
     }
 
     std::string CircuitVisualizer::generateIdentifiedStages() const {
-        return generateStageBreakdown();
+        std::ostringstream ss;
+        writeStageBreakdown(ss);
+        return ss.str();
     }
 
-    std::string CircuitVisualizer::generatePotentiometerDetailsTable() const {
+    void CircuitVisualizer::writePotentiometerDetailsTable(std::ostream& ss) const {
+        SectionFormat format(ss);
         const Netlist& netlist = schematic.getNetlist();
-        std::ostringstream ss;
 
         // Find all potentiometers
         std::vector<std::shared_ptr<Component>> potentiometers;
@@ -312,17 +339,17 @@ namespace LiveSpice {
                    << paramName << "\", \"" << pot->getName() << "\", 0.0f, 1.0f, 0.5f)\n";
             }
         }
-
-        return ss.str();
     }
 
     std::string CircuitVisualizer::generateExtractedControls() const {
-        return generatePotentiometerDetailsTable();
+        std::ostringstream ss;
+        writePotentiometerDetailsTable(ss);
+        return ss.str();
     }
 
-    std::string CircuitVisualizer::generateExtractionSummary() const {
+    void CircuitVisualizer::writeExtractionSummary(std::ostream& ss) const {
+        SectionFormat format(ss);
         const Netlist& netlist = schematic.getNetlist();
-        std::ostringstream ss;
 
         int componentCount = 0;
         int resistorCount = 0;
@@ -335,7 +362,7 @@ namespace LiveSpice {
 
         for (const auto& pair : netlist.getComponents()) {
             const auto& comp = pair.second;
-            if (comp->getType() == ComponentType::Wire || comp->getType() == ComponentType::Label) {
+            if (!isDrawnComponent(*comp)) {
                 continue;
             }
             componentCount++;
@@ -353,7 +380,7 @@ namespace LiveSpice {
             }
         }
 
-        auto stages = const_cast<CircuitAnalyzer&>(analyzer).analyzeCircuit();
+        const auto& stages = analyzer.getStages();
 
         ss << "\n" << std::string(110, '=') << "\n";
         ss << "EXTRACTION SUMMARY (What Your Program Understood)\n";
@@ -380,13 +407,11 @@ namespace LiveSpice {
         }
 
         ss << "\n";
-
-        return ss.str();
     }
 
-    std::string CircuitVisualizer::generateAnalyzedSignalFlow() const {
-        auto stages = const_cast<CircuitAnalyzer&>(analyzer).analyzeCircuit();
-        std::ostringstream ss;
+    void CircuitVisualizer::writeAnalyzedSignalFlow(std::ostream& ss) const {
+        SectionFormat format(ss);
+        const auto& stages = analyzer.getStages();
 
         ss << "\n" << std::string(110, '=') << "\n";
         ss << "ANALYZED SIGNAL FLOW (Program's Understanding of Audio Path)\n";
@@ -394,7 +419,7 @@ namespace LiveSpice {
 
         if (stages.empty()) {
             ss << "  WARNING: No signal flow determined. Circuit analysis may have failed.\n";
-            return ss.str();
+            return;
         }
 
         ss << "  INPUT\n";
@@ -424,14 +449,35 @@ namespace LiveSpice {
         ss << "    |\n";
         ss << "    V\n";
         ss << "  OUTPUT\n\n";
+    }
 
+    std::string CircuitVisualizer::generateAnalyzedSignalFlow() const {
+        std::ostringstream ss;
+        writeAnalyzedSignalFlow(ss);
         return ss.str();
     }
 
-    std::string CircuitVisualizer::generateTroubleshootingGuide() const {
+    void CircuitVisualizer::writeTroubleshootingGuide(std::ostream& ss) const {
+        SectionFormat format(ss);
         const Netlist& netlist = schematic.getNetlist();
-        auto stages = const_cast<CircuitAnalyzer&>(analyzer).analyzeCircuit();
-        std::ostringstream ss;
+        const auto& stages = analyzer.getStages();
+
+        // One pass over the netlist for every check below
+        bool hasInput = false, hasOutput = false, hasPower = false;
+        int activeCount = 0;
+        int potCount = 0;
+        for (const auto& pair : netlist.getComponents()) {
+            switch (pair.second->getType()) {
+                case ComponentType::Input: hasInput = true; break;
+                case ComponentType::Output: hasOutput = true; break;
+                case ComponentType::Rail: hasPower = true; break;
+                case ComponentType::OpAmp:
+                case ComponentType::Transistor: activeCount++; break;
+                case ComponentType::Potentiometer:
+                case ComponentType::VariableResistor: potCount++; break;
+                default: break;
+            }
+        }
 
         ss << "\n" << std::string(110, '=') << "\n";
         ss << "TROUBLESHOOTING GUIDE (Validating Extraction)\n";
@@ -439,11 +485,6 @@ namespace LiveSpice {
 
         // Check 1: Input/Output jacks
         ss << "  Check 1: Input/Output Configuration\n";
-        bool hasInput = false, hasOutput = false;
-        for (const auto& pair : netlist.getComponents()) {
-            if (pair.second->getType() == ComponentType::Input) hasInput = true;
-            if (pair.second->getType() == ComponentType::Output) hasOutput = true;
-        }
         ss << "    * Input jacks found:  " << (hasInput ? "YES" : "NO") << "\n";
         ss << "    * Output jacks found: " << (hasOutput ? "YES" : "NO") << "\n";
         if (!hasInput || !hasOutput) {
@@ -453,13 +494,6 @@ namespace LiveSpice {
 
         // Check 2: Active components
         ss << "  Check 2: Active Components (Op-Amps, Transistors)\n";
-        int activeCount = 0;
-        for (const auto& pair : netlist.getComponents()) {
-            if (pair.second->getType() == ComponentType::OpAmp || 
-                pair.second->getType() == ComponentType::Transistor) {
-                activeCount++;
-            }
-        }
         ss << "    * Active components found: " << activeCount << "\n";
         if (activeCount == 0) {
             ss << "    WARNING: No active components (op-amps, transistors). Passive only circuit.\n";
@@ -468,13 +502,6 @@ namespace LiveSpice {
 
         // Check 3: Power supply
         ss << "  Check 3: Power Supply\n";
-        bool hasPower = false;
-        for (const auto& pair : netlist.getComponents()) {
-            if (pair.second->getType() == ComponentType::Rail) {
-                hasPower = true;
-                break;
-            }
-        }
         ss << "    * Power rails found: " << (hasPower ? "YES" : "NO") << "\n";
         if (!hasPower) {
             ss << "    WARNING: No power rail found. May need manual power supply connections.\n";
@@ -494,13 +521,6 @@ namespace LiveSpice {
 
         // Check 5: Potentiometers/Controls
         ss << "  Check 5: User Controls (Potentiometers)\n";
-        int potCount = 0;
-        for (const auto& pair : netlist.getComponents()) {
-            if (pair.second->getType() == ComponentType::Potentiometer ||
-                pair.second->getType() == ComponentType::VariableResistor) {
-                potCount++;
-            }
-        }
         ss << "    * Potentiometers found: " << potCount << "\n";
         if (potCount == 0) {
             ss << "    WARNING: No potentiometers found. Circuit may be static (no knobs).\n";
@@ -525,32 +545,38 @@ namespace LiveSpice {
         ss << "    4. If connectivity looks wrong: check wire definitions in schematic\n";
         ss << "    5. If stages not identified: review CircuitAnalyzer stage detection logic\n";
         ss << "  " << std::string(108, '=') << "\n";
-
-        return ss.str();
     }
 
-    std::string CircuitVisualizer::generateFullDiagram() const {
+    std::string CircuitVisualizer::generateTroubleshootingGuide() const {
         std::ostringstream ss;
+        writeTroubleshootingGuide(ss);
+        return ss.str();
+    }
 
+    void CircuitVisualizer::writeFullDiagram(std::ostream& ss) const {
         ss << "\n";
         ss << std::string(110, '=') << "\n";
         ss << "LIVESPICE DSP TRANSLATION - EXTRACTED CIRCUIT ANALYSIS\n";
         ss << "What Your Program Extracted & Analyzed from the LiveSpice File\n";
         ss << std::string(110, '=') << "\n";
 
-        ss << generateExtractionSummary();
-        ss << generateComponentDetailsTable();
-        ss << generateNodeConnectivityTable();
-        ss << generateStageBreakdown();
-        ss << generatePotentiometerDetailsTable();
-        ss << generateAnalyzedSignalFlow();
-        ss << generateTroubleshootingGuide();
+        writeExtractionSummary(ss);
+        writeComponentDetailsTable(ss);
+        writeNodeConnectivityTable(ss);
+        writeStageBreakdown(ss);
+        writePotentiometerDetailsTable(ss);
+        writeAnalyzedSignalFlow(ss);
+        writeTroubleshootingGuide(ss);
 
         ss << "\n";
         ss << std::string(110, '=') << "\n";
         ss << "END OF CIRCUIT ANALYSIS\n";
         ss << std::string(110, '=') << "\n";
+    }
 
+    std::string CircuitVisualizer::generateFullDiagram() const {
+        std::ostringstream ss;
+        writeFullDiagram(ss);
         return ss.str();
     }
 
@@ -2,6 +2,7 @@
 
 #include "LiveSpiceParser.h"
 #include "CircuitAnalyzer.h"
+#include <ostream>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -23,12 +24,33 @@ namespace LiveSpice {
      * - Potentiometer/control extraction and parameter mapping
      * - Signal flow based on program's topology analysis
      * - Troubleshooting guide (what was extracted vs what was expected)
+     *
+     * Everything is read from the analysis already done: the analyzer's
+     * stages (analyzeCircuit() or restoreStages() must have run) and the
+     * netlist's compact connectivity. Sections stream to an ostream; the
+     * per-row and per-stage sections of large circuits render in parallel
+     * slices that are written back in order.
      */
     class CircuitVisualizer {
     public:
+        // Rows (components, connectivity lines, stage components) below which
+        // a section renders on the calling thread only
+        static constexpr size_t PARALLEL_MIN_ROWS = 4096;
+
         CircuitVisualizer(const Schematic& schematic, const CircuitAnalyzer& analyzer)
             : schematic(schematic), analyzer(analyzer) {}
 
+        /**
+         * Threads for large sections; 0 = hardware concurrency, 1 = serial
+         * (batch workers already fill the cores)
+         */
+        void setJobs(unsigned jobs) { this->jobs = jobs; }
+
+        /**
+         * Stream the complete extracted circuit visualization with all analysis
+         */
+        void writeFullDiagram(std::ostream& out) const;
+
         /**
          * Generate complete extracted circuit visualization with all analysis
          */
@@ -67,6 +89,7 @@ namespace LiveSpice {
     private:
         const Schematic& schematic;
         const CircuitAnalyzer& analyzer;
+        unsigned jobs = 0;
 
         // Helper methods
         std::string componentTypeToString(ComponentType type) const;
@@ -75,11 +98,18 @@ namespace LiveSpice {
         std::string formatComponentValue(const std::string& value) const;
         std::string getExpectedDSPModule(StageType stage) const;
         
-        std::string generateComponentDetailsTable() const;
-        std::string generateNodeConnectivityTable() const;
-        std::string generatePotentiometerDetailsTable() const;
-        std::string generateStageBreakdown() const;
-        std::string generateExtractionSummary() const;
+        // Sections, each starting from default stream formatting
+        void writeComponentDetailsTable(std::ostream& ss) const;
+        void writeNodeConnectivityTable(std::ostream& ss) const;
+        void writePotentiometerDetailsTable(std::ostream& ss) const;
+        void writeStageBreakdown(std::ostream& ss) const;
+        void writeExtractionSummary(std::ostream& ss) const;
+        void writeAnalyzedSignalFlow(std::ostream& ss) const;
+        void writeTroubleshootingGuide(std::ostream& ss) const;
+
+        // Render rows [0, count) in order, in parallel slices when parallel is set
+        template <typename RenderRow>
+        void writeRows(std::ostream& out, size_t count, bool parallel, RenderRow renderRow) const;
     };
 
 } // namespace LiveSpice
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <ios>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace LiveSpice {
+
+    // ============================================================================
+    // Generated Code Emitter
+    // ============================================================================
+
+    /**
+     * Output stream that appends straight into one std::string. Reserve
+     * the expected size up front and take() the finished text, so a
+     * generated file is built in a single buffer instead of being copied
+     * out of nested stringstreams.
+     */
+    class CodeEmitter : public std::ostream {
+    public:
+        explicit CodeEmitter(size_t capacity = 0) : std::ostream(nullptr) {
+            m_buffer.text.reserve(capacity);
+            rdbuf(&m_buffer);
+        }
+
+        CodeEmitter(const CodeEmitter&) = delete;
+        CodeEmitter& operator=(const CodeEmitter&) = delete;
+
+        void reserve(size_t capacity) { m_buffer.text.reserve(capacity); }
+        size_t size() const { return m_buffer.text.size(); }
+        std::string_view view() const { return m_buffer.text; }
+
+        // Move the text out; the emitter is empty afterwards
+        std::string take() { return std::exchange(m_buffer.text, std::string()); }
+
+    private:
+        class AppendBuffer : public std::streambuf {
+        public:
+            std::string text;
+
+        protected:
+            int_type overflow(int_type ch) override {
+                if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+                    text.push_back(traits_type::to_char_type(ch));
+                }
+                return traits_type::not_eof(ch);
+            }
+
+            std::streamsize xsputn(const char* s, std::streamsize count) override {
+                text.append(s, static_cast<size_t>(count));
+                return count;
+            }
+        };
+
+        AppendBuffer m_buffer;
+    };
+
+    /**
+     * Gives one fragment default stream formatting and restores the
+     * caller's on exit, so a fragment reads the same whether it is written
+     * into the shared stream or into a fresh one on a worker thread
+     */
+    class FragmentFormat {
+    public:
+        explicit FragmentFormat(std::ostream& out)
+            : m_out(out), m_flags(out.flags()), m_precision(out.precision()), m_fill(out.fill()) {
+            out.flags(std::ios::dec | std::ios::skipws);
+            out.precision(6);
+            out.fill(' ');
+        }
+
+        ~FragmentFormat() {
+            m_out.flags(m_flags);
+            m_out.precision(m_precision);
+            m_out.fill(m_fill);
+        }
+
+        FragmentFormat(const FragmentFormat&) = delete;
+        FragmentFormat& operator=(const FragmentFormat&) = delete;
+
+    private:
+        std::ostream& m_out;
+        std::ios::fmtflags m_flags;
+        std::streamsize m_precision;
+        char m_fill;
+    };
+
+    /**
+     * Run fn(slice, begin, end) over contiguous slices of [0, count) on up
+     * to threads threads; slice 0 runs on the calling thread
+     */
+    template <typename SliceFn>
+    void forEachSlice(size_t count, unsigned threads, SliceFn fn) {
+        const size_t slices = std::min<size_t>(std::max(1u, threads), count);
+        if (slices <= 1) {
+            if (count > 0) fn(size_t{0}, size_t{0}, count);
+            return;
+        }
+
+        std::vector<std::thread> pool;
+        pool.reserve(slices - 1);
+        for (size_t slice = 1; slice < slices; ++slice) {
+            pool.emplace_back(fn, slice, count * slice / slices, count * (slice + 1) / slices);
+        }
+        fn(size_t{0}, size_t{0}, count / slices);
+        for (auto& thread : pool) {
+            thread.join();
+        }
+    }
+
+    /**
+     * Write fragments render(os, 0) .. render(os, count - 1) to out in order.
+     * With more than one thread, each contiguous slice renders into its own
+     * emitter and the slices are appended in slice order, so the text is
+     * identical to the serial run. Fragments must only read shared state.
+     */
+    template <typename RenderFragment>
+    void emitFragments(std::ostream& out, size_t count, unsigned threads, RenderFragment render) {
+        if (std::min<size_t>(threads, count) <= 1) {
+            for (size_t i = 0; i < count; ++i) {
+                FragmentFormat format(out);
+                render(static_cast<std::ostream&>(out), i);
+            }
+            return;
+        }
+
+        const size_t slices = std::min<size_t>(threads, count);
+        std::vector<std::string> texts(slices);
+        forEachSlice(count, threads, [&](size_t index, size_t begin, size_t end) {
+            CodeEmitter slice;
+            for (size_t i = begin; i < end; ++i) {
+                FragmentFormat format(slice);
+                render(static_cast<std::ostream&>(slice), i);
+            }
+            texts[index] = slice.take();
+        });
+        for (const auto& text : texts) {
+            out.write(text.data(), static_cast<std::streamsize>(text.size()));
+        }
+    }
+
+} // namespace LiveSpice
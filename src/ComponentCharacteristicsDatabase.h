@@ -1,97 +1,241 @@
 #ifndef COMPONENT_CHARACTERISTICS_DATABASE_H
 #define COMPONENT_CHARACTERISTICS_DATABASE_H
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <map>
-#include <string>
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
 #include "DiodeModels.h"
 #include "TransistorModels.h"
 
 namespace Nonlinear {
 namespace ComponentDB {
 
-class DiodeDatabase {
+/**
+ * Device databases: built-in parts live in constexpr perfect-hash tables
+ * (read-only data, no static initialization, no locking, no allocation);
+ * parts registered at run time go to a per-database overlay that is only
+ * consulted once it is non-empty. Overlay parts shadow built-in ones.
+ * A resolver (e.g. a SPICE model library) can supply parts on a miss;
+ * what it returns is added to the overlay.
+ */
+
+template <typename Characteristics>
+struct StockPart {
+    std::string_view partNumber;
+    Characteristics characteristics;
+};
+
+namespace detail {
+
+/**
+ * FNV-1a with a seed folded into the offset basis; the high half is mixed
+ * down because the low bits of FNV only see the low bits of each byte
+ */
+constexpr uint32_t hashPart(std::string_view text, uint32_t seed) {
+    uint32_t hash = 2166136261u ^ seed;
+    for (char c : text) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    return hash ^ (hash >> 16);
+}
+
+/**
+ * Collision-free table over a fixed part list: the seed is searched at
+ * compile time so every part lands in its own slot, and a lookup is one
+ * hash, one slot read and one string compare
+ */
+template <typename Characteristics, size_t N>
+class PerfectHashTable {
 public:
-    static DiodeDatabase& getInstance() {
-        static DiodeDatabase instance;
-        return instance;
+    static constexpr size_t SLOTS = [] {
+        size_t slots = 1;
+        while (slots < 2 * N) slots *= 2;
+        return slots;
+    }();
+
+    constexpr explicit PerfectHashTable(const StockPart<Characteristics> (&parts)[N]) : m_parts(parts) {
+        for (uint32_t seed = 0;; ++seed) {
+            if (place(seed)) {
+                m_seed = seed;
+                return;
+            }
+        }
     }
-    
-    std::optional<DiodeCharacteristics> lookup(const std::string& partNumber) const {
-        auto it = m_diodeDatabase.find(partNumber);
-        return it != m_diodeDatabase.end() ? std::make_optional(it->second) : std::nullopt;
+
+    constexpr const Characteristics* find(std::string_view partNumber) const {
+        const int8_t index = m_slots[hashPart(partNumber, m_seed) & (SLOTS - 1)];
+        return index >= 0 && m_parts[index].partNumber == partNumber ? &m_parts[index].characteristics : nullptr;
     }
-    
-    DiodeCharacteristics getOrDefault(const std::string& partNumber, const std::string& defaultPart = "1N4148") const {
-        auto opt = lookup(partNumber);
-        return opt.has_value() ? opt.value() : lookup(defaultPart).value_or(DiodeCharacteristics::Si1N4148());
+
+    constexpr size_t size() const { return N; }
+
+private:
+    const StockPart<Characteristics> (&m_parts)[N];
+    int8_t m_slots[SLOTS] = {};
+    uint32_t m_seed = 0;
+
+    constexpr bool place(uint32_t seed) {
+        for (auto& slot : m_slots) slot = -1;
+        for (size_t i = 0; i < N; ++i) {
+            auto& slot = m_slots[hashPart(m_parts[i].partNumber, seed) & (SLOTS - 1)];
+            if (slot >= 0) return false;
+            slot = static_cast<int8_t>(i);
+        }
+        return true;
     }
-    
+};
+
+}  // namespace detail
+
+// ============================================================================
+// Built-in parts
+// ============================================================================
+
+inline constexpr StockPart<DiodeCharacteristics> kStockDiodes[] = {
+    {"1N4148", DiodeCharacteristics::Si1N4148()},
+    {"1N914", DiodeCharacteristics::Si1N914()},
+    {"OA90", DiodeCharacteristics::Ge_OA90()},
+    {"1N4007", DiodeCharacteristics::Si1N4007()},
+};
+
+inline constexpr StockPart<BJTCharacteristics> kStockBJTs[] = {
+    {"2N3904", BJTCharacteristics::TwoN3904()},
+    {"2N2222", BJTCharacteristics::TwoN2222()},
+    // Note: BC107 and 2N3906 static methods not defined in this version
+};
+
+inline constexpr StockPart<FETCharacteristics> kStockFETs[] = {
+    {"2N7000", FETCharacteristics::TwoN7000()},
+    {"BS170", FETCharacteristics::TwoN7000()},
+    // Note: J201 also available
+};
+
+inline constexpr detail::PerfectHashTable kStockDiodeTable{kStockDiodes};
+inline constexpr detail::PerfectHashTable kStockBJTTable{kStockBJTs};
+inline constexpr detail::PerfectHashTable kStockFETTable{kStockFETs};
+
+// ============================================================================
+// Database: stock table plus runtime overlay
+// ============================================================================
+
+template <typename Characteristics, const auto& StockTable>
+class DeviceDatabase {
+public:
+    /**
+     * Characteristics for a part, or nullptr; the pointer stays valid for
+     * the life of the program (re-registering a part does not move it)
+     */
+    const Characteristics* find(std::string_view partNumber) const {
+        if (m_overlaySize.load(std::memory_order_acquire) > 0) {
+            std::shared_lock<std::shared_mutex> lock(m_overlayMutex);
+            auto it = m_overlay.find(partNumber);
+            if (it != m_overlay.end()) return it->second;
+        }
+        if (const Characteristics* stock = StockTable.find(partNumber)) return stock;
+        if (m_hasResolver.load(std::memory_order_acquire)) {
+            Resolver resolver;
+            {
+                std::shared_lock<std::shared_mutex> lock(m_overlayMutex);
+                resolver = m_resolver;
+            }
+            if (auto resolved = resolver(partNumber)) return insert(std::string(partNumber), *resolved);
+        }
+        return nullptr;
+    }
+
+    std::optional<Characteristics> lookup(std::string_view partNumber) const {
+        const Characteristics* part = find(partNumber);
+        return part ? std::make_optional(*part) : std::nullopt;
+    }
+
+    /**
+     * Register a user part (or replace one); not for the audio thread
+     */
+    void addPart(const std::string& partNumber, const Characteristics& characteristics) {
+        insert(partNumber, characteristics);
+    }
+
+    using Resolver = std::function<std::optional<Characteristics>(std::string_view partNumber)>;
+
+    /**
+     * Consulted for parts that are neither registered nor built in
+     * (empty to remove); not for the audio thread
+     */
+    void setResolver(Resolver resolver) {
+        std::unique_lock<std::shared_mutex> lock(m_overlayMutex);
+        m_hasResolver.store(static_cast<bool>(resolver), std::memory_order_release);
+        m_resolver = std::move(resolver);
+    }
+
+protected:
+    Characteristics getOrDefault(std::string_view partNumber, std::string_view defaultPart,
+                                 const Characteristics& fallback) const {
+        if (const Characteristics* part = find(partNumber)) return *part;
+        if (const Characteristics* part = find(defaultPart)) return *part;
+        return fallback;
+    }
+
+    DeviceDatabase() = default;
+
 private:
-    std::map<std::string, DiodeCharacteristics> m_diodeDatabase;
-    
-    DiodeDatabase() {
-        m_diodeDatabase["1N4148"] = DiodeCharacteristics::Si1N4148();
-        m_diodeDatabase["1N914"] = DiodeCharacteristics::Si1N914();
-        m_diodeDatabase["OA90"] = DiodeCharacteristics::Ge_OA90();
-        m_diodeDatabase["1N4007"] = DiodeCharacteristics::Si1N4007();
+    mutable std::shared_mutex m_overlayMutex;
+    mutable std::atomic<size_t> m_overlaySize{0};
+    mutable std::deque<Characteristics> m_overlayStorage;   // Stable addresses
+    mutable std::map<std::string, const Characteristics*, std::less<>> m_overlay;
+    std::atomic<bool> m_hasResolver{false};
+    Resolver m_resolver;
+
+    const Characteristics* insert(const std::string& partNumber, const Characteristics& characteristics) const {
+        std::unique_lock<std::shared_mutex> lock(m_overlayMutex);
+        m_overlayStorage.push_back(characteristics);
+        m_overlay[partNumber] = &m_overlayStorage.back();
+        m_overlaySize.store(m_overlay.size(), std::memory_order_release);
+        return &m_overlayStorage.back();
     }
 };
 
-class BJTDatabase {
+class DiodeDatabase : public DeviceDatabase<DiodeCharacteristics, kStockDiodeTable> {
 public:
-    static BJTDatabase& getInstance() {
-        static BJTDatabase instance;
+    static DiodeDatabase& getInstance() {
+        static DiodeDatabase instance;
         return instance;
     }
-    
-    std::optional<BJTCharacteristics> lookup(const std::string& partNumber) const {
-        auto it = m_bjtDatabase.find(partNumber);
-        return it != m_bjtDatabase.end() ? std::make_optional(it->second) : std::nullopt;
+
+    DiodeCharacteristics getOrDefault(std::string_view partNumber, std::string_view defaultPart = "1N4148") const {
+        return DeviceDatabase::getOrDefault(partNumber, defaultPart, DiodeCharacteristics::Si1N4148());
     }
-    
-    BJTCharacteristics getOrDefault(const std::string& partNumber, const std::string& defaultPart = "2N3904") const {
-        auto opt = lookup(partNumber);
-        return opt.has_value() ? opt.value() : lookup(defaultPart).value_or(BJTCharacteristics::TwoN3904());
+};
+
+class BJTDatabase : public DeviceDatabase<BJTCharacteristics, kStockBJTTable> {
+public:
+    static BJTDatabase& getInstance() {
+        static BJTDatabase instance;
+        return instance;
     }
-    
-private:
-    std::map<std::string, BJTCharacteristics> m_bjtDatabase;
-    
-    BJTDatabase() {
-        m_bjtDatabase["2N3904"] = BJTCharacteristics::TwoN3904();
-        m_bjtDatabase["2N2222"] = BJTCharacteristics::TwoN2222();
-        // Note: BC107 and 2N3906 static methods not defined in this version
-        // m_bjtDatabase["BC107"] = BJTCharacteristics::BC107();
-        // m_bjtDatabase["2N3906"] = BJTCharacteristics::TwoN3906();
+
+    BJTCharacteristics getOrDefault(std::string_view partNumber, std::string_view defaultPart = "2N3904") const {
+        return DeviceDatabase::getOrDefault(partNumber, defaultPart, BJTCharacteristics::TwoN3904());
     }
 };
 
-class FETDatabase {
+class FETDatabase : public DeviceDatabase<FETCharacteristics, kStockFETTable> {
 public:
     static FETDatabase& getInstance() {
         static FETDatabase instance;
         return instance;
     }
-    
-    std::optional<FETCharacteristics> lookup(const std::string& partNumber) const {
-        auto it = m_fetDatabase.find(partNumber);
-        return it != m_fetDatabase.end() ? std::make_optional(it->second) : std::nullopt;
-    }
-    
-    FETCharacteristics getOrDefault(const std::string& partNumber, const std::string& defaultPart = "2N7000") const {
-        auto opt = lookup(partNumber);
-        // Use TwoN7000() which is defined in FETCharacteristics
-        return opt.has_value() ? opt.value() : lookup(defaultPart).value_or(FETCharacteristics::TwoN7000());
-    }
-    
-private:
-    std::map<std::string, FETCharacteristics> m_fetDatabase;
-    
-    FETDatabase() {
-        m_fetDatabase["2N7000"] = FETCharacteristics::TwoN7000();
-        m_fetDatabase["BS170"] = FETCharacteristics::TwoN7000();
-        // Note: J201 also available
+
+    FETCharacteristics getOrDefault(std::string_view partNumber, std::string_view defaultPart = "2N7000") const {
+        return DeviceDatabase::getOrDefault(partNumber, defaultPart, FETCharacteristics::TwoN7000());
     }
 };
 
@@ -100,6 +244,7 @@ struct NonlinearComponentInfo {
     std::optional<DiodeCharacteristics> diodeChar;
     std::optional<BJTCharacteristics> bjtChar;
     std::optional<FETCharacteristics> fetChar;
+    bool isPNP = false;    // PNP BJT or P-channel FET
     
     static NonlinearComponentInfo fromDiode(const std::string& partNumber, const std::string& name = "D") {
         NonlinearComponentInfo info;
@@ -114,6 +259,7 @@ struct NonlinearComponentInfo {
         info.partNumber = partNumber;
         info.name = name;
         info.bjtChar = BJTDatabase::getInstance().getOrDefault(partNumber);
+        info.isPNP = isPNP;
         return info;
     }
     
@@ -122,6 +268,7 @@ struct NonlinearComponentInfo {
         info.partNumber = partNumber;
         info.name = name;
         info.fetChar = FETDatabase::getInstance().getOrDefault(partNumber);
+        info.isPNP = isPNP;
         return info;
     }
     
@@ -68,6 +68,7 @@ namespace LiveSpice {
 
         // ========================================================================
         // Component Parameter Extraction (LiveSPICE source of truth)
+        // Reads the alias chains the parser resolved into CanonicalParams
         // ========================================================================
 
         // Extract resistor parameters
@@ -78,22 +79,10 @@ namespace LiveSpice {
 
         ResistorParams extractResistorParams(std::shared_ptr<Component> comp) const {
             ResistorParams params;
-            
-            // Try to get resistance from component parameters
-            std::string valueStr = comp->getParamValue("Resistance");
-            if (valueStr.empty()) valueStr = comp->getParamValue("Value");
-            if (valueStr.empty()) valueStr = comp->getParamValue("R");
-            
-            if (!valueStr.empty()) {
-                params.resistance = comp->getParamValueAsDouble("Resistance");
-                if (params.resistance == 0.0) {
-                    params.resistance = comp->getParamValueAsDouble("Value");
-                }
-                if (params.resistance == 0.0) {
-                    params.resistance = comp->getParamValueAsDouble("R");
-                }
+            const auto& canonical = comp->getCanonicalParams();
+            if (canonical.hasResistance) {
+                params.resistance = canonical.resistance;
             }
-            
             return params;
         }
 
@@ -106,27 +95,13 @@ namespace LiveSpice {
 
         CapacitorParams extractCapacitorParams(std::shared_ptr<Component> comp) const {
             CapacitorParams params;
-            
-            std::string valueStr = comp->getParamValue("Capacitance");
-            if (valueStr.empty()) valueStr = comp->getParamValue("Value");
-            if (valueStr.empty()) valueStr = comp->getParamValue("C");
-            
-            if (!valueStr.empty()) {
-                params.capacitance = comp->getParamValueAsDouble("Capacitance");
-                if (params.capacitance == 0.0) {
-                    params.capacitance = comp->getParamValueAsDouble("Value");
-                }
-                if (params.capacitance == 0.0) {
-                    params.capacitance = comp->getParamValueAsDouble("C");
-                }
+            const auto& canonical = comp->getCanonicalParams();
+            if (canonical.hasCapacitance) {
+                params.capacitance = canonical.capacitance;
             }
-            
-            // Extract ESR if specified
-            double esrValue = comp->getParamValueAsDouble("ESR");
-            if (esrValue > 0.0) {
-                params.esr = esrValue;
+            if (canonical.esr > 0.0) {
+                params.esr = canonical.esr;
             }
-            
             return params;
         }
 
@@ -139,28 +114,13 @@ namespace LiveSpice {
 
         InductorParams extractInductorParams(std::shared_ptr<Component> comp) const {
             InductorParams params;
-            
-            std::string valueStr = comp->getParamValue("Inductance");
-            if (valueStr.empty()) valueStr = comp->getParamValue("Value");
-            if (valueStr.empty()) valueStr = comp->getParamValue("L");
-            
-            if (!valueStr.empty()) {
-                params.inductance = comp->getParamValueAsDouble("Inductance");
-                if (params.inductance == 0.0) {
-                    params.inductance = comp->getParamValueAsDouble("Value");
-                }
-                if (params.inductance == 0.0) {
-                    params.inductance = comp->getParamValueAsDouble("L");
-                }
+            const auto& canonical = comp->getCanonicalParams();
+            if (canonical.hasInductance) {
+                params.inductance = canonical.inductance;
             }
-            
-            // Extract DC resistance if specified
-            double rDC = comp->getParamValueAsDouble("DCR");
-            if (rDC == 0.0) rDC = comp->getParamValueAsDouble("DCResistance");
-            if (rDC > 0.0) {
-                params.dcResistance = rDC;
+            if (canonical.dcResistance > 0.0) {
+                params.dcResistance = canonical.dcResistance;
             }
-            
             return params;
         }
 
@@ -172,16 +132,10 @@ namespace LiveSpice {
 
         DiodeParams extractDiodeParams(std::shared_ptr<Component> comp) const {
             DiodeParams params;
-            
-            // Check for part number specification
-            std::string partNum = comp->getParamValue("PartNumber");
-            if (partNum.empty()) partNum = comp->getParamValue("Model");
-            if (partNum.empty()) partNum = comp->getParamValue("Type");
-            
-            if (!partNum.empty()) {
-                params.partNumber = partNum;
+            const std::string& partNumber = comp->getCanonicalParams().partNumber;
+            if (!partNumber.empty()) {
+                params.partNumber = partNumber;
             }
-            
             return params;
         }
 
@@ -193,15 +147,10 @@ namespace LiveSpice {
 
         BJTParams extractBJTParams(std::shared_ptr<Component> comp) const {
             BJTParams params;
-            
-            std::string partNum = comp->getParamValue("PartNumber");
-            if (partNum.empty()) partNum = comp->getParamValue("Model");
-            if (partNum.empty()) partNum = comp->getParamValue("Type");
-            
-            if (!partNum.empty()) {
-                params.partNumber = partNum;
+            const std::string& partNumber = comp->getCanonicalParams().partNumber;
+            if (!partNumber.empty()) {
+                params.partNumber = partNumber;
             }
-            
             return params;
         }
 
@@ -212,34 +161,28 @@ namespace LiveSpice {
 
         JFETParams extractJFETParams(std::shared_ptr<Component> comp) const {
             JFETParams params;
-            
-            std::string partNum = comp->getParamValue("PartNumber");
-            if (partNum.empty()) partNum = comp->getParamValue("Model");
-            if (partNum.empty()) partNum = comp->getParamValue("Type");
-            
-            if (!partNum.empty()) {
-                params.partNumber = partNum;
+            const std::string& partNumber = comp->getCanonicalParams().partNumber;
+            if (!partNumber.empty()) {
+                params.partNumber = partNumber;
             }
-            
             return params;
         }
 
         // Extract OpAmp parameters
         struct OpAmpParams {
             std::string partNumber = "TL072";   // Default dual op-amp
+            double openLoopGain = 0.0;          // Aol (0 = part default)
+            double gainBandwidth = 0.0;         // GBP in Hz (0 = part default)
         };
 
         OpAmpParams extractOpAmpParams(std::shared_ptr<Component> comp) const {
             OpAmpParams params;
-            
-            std::string partNum = comp->getParamValue("PartNumber");
-            if (partNum.empty()) partNum = comp->getParamValue("Model");
-            if (partNum.empty()) partNum = comp->getParamValue("Type");
-            
-            if (!partNum.empty()) {
-                params.partNumber = partNum;
+            const CanonicalParams& canonical = comp->getCanonicalParams();
+            if (!canonical.partNumber.empty()) {
+                params.partNumber = canonical.partNumber;
             }
-            
+            params.openLoopGain = canonical.openLoopGain;
+            params.gainBandwidth = canonical.gainBandwidth;
             return params;
         }
 
@@ -250,15 +193,10 @@ namespace LiveSpice {
 
         TriodeParams extractTriodeParams(std::shared_ptr<Component> comp) const {
             TriodeParams params;
-            
-            std::string partNum = comp->getParamValue("PartNumber");
-            if (partNum.empty()) partNum = comp->getParamValue("Model");
-            if (partNum.empty()) partNum = comp->getParamValue("Type");
-            
-            if (!partNum.empty()) {
-                params.partNumber = partNum;
+            const std::string& partNumber = comp->getCanonicalParams().partNumber;
+            if (!partNumber.empty()) {
+                params.partNumber = partNumber;
             }
-            
             return params;
         }
 
@@ -326,7 +264,10 @@ namespace LiveSpice {
         {
             auto processor = std::make_unique<LiveSpiceDSP::OpAmpProcessor>();
             auto params = extractOpAmpParams(comp);
-            processor->prepare(params.partNumber, sampleRate);
+            auto model = LiveSpiceComponents::OpAmpModel::getModel(params.partNumber);
+            if (params.openLoopGain > 0.0) model.gain = params.openLoopGain;
+            if (params.gainBandwidth > 0.0) model.gainBW = params.gainBandwidth;
+            processor->prepare(model, sampleRate);
             return processor;
         }
 
@@ -1,4 +1,6 @@
 #include "CompressorDynamics.h"
+#include "Denormals.h"
+#include "MathPolicy.h"
 #include <cmath>
 #include <algorithm>
 
@@ -8,33 +10,104 @@ namespace LiveSpiceDSP {
 // PeakDetector Implementation
 // ============================================================================
 
-PeakDetector::PeakDetector(float sampleRate, float lookAheadMs)
-    : m_sampleRate(sampleRate), m_peakDb(-80.0f), m_bufferIndex(0) {
+PeakDetector::PeakDetector(float sampleRate, float lookAheadMs, MemoryMode memoryMode)
+    : m_sampleRate(sampleRate), m_peakDb(-80.0f), m_memoryMode(memoryMode) {
     
     m_lookAheadSamples = static_cast<size_t>(std::max(1.0f, sampleRate * lookAheadMs / 1000.0f));
-    m_buffer.resize(m_lookAheadSamples, 0.0f);
+    m_deque.resize(m_lookAheadSamples, DequeEntry{0.0f, 0});
 }
 
-float PeakDetector::processSample(float sample) {
-    // Add to circular buffer
-    m_buffer[m_bufferIndex] = std::abs(sample);
-    m_bufferIndex = (m_bufferIndex + 1) % m_lookAheadSamples;
-    
-    // Find peak in buffer
-    float peakLinear = 0.0f;
-    for (float val : m_buffer) {
-        peakLinear = std::max(peakLinear, val);
+float PeakDetector::pushSample(float magnitude) {
+    const size_t capacity = m_lookAheadSamples;
+    
+    // Drop the oldest entry once it leaves the window
+    if (m_dequeSize > 0 && static_cast<uint32_t>(m_sampleIndex - m_deque[m_dequeHead].index) >= capacity) {
+        m_dequeHead = m_dequeHead + 1 == capacity ? 0 : m_dequeHead + 1;
+        --m_dequeSize;
+    }
+    
+    // Entries not larger than the new sample can never be the max again
+    while (m_dequeSize > 0) {
+        size_t tail = (m_dequeHead + m_dequeSize - 1) % capacity;
+        if (m_deque[tail].value > magnitude) break;
+        --m_dequeSize;
+    }
+    
+    size_t slot = (m_dequeHead + m_dequeSize) % capacity;
+    m_deque[slot] = {magnitude, m_sampleIndex};
+    ++m_dequeSize;
+    ++m_sampleIndex;
+    
+    return m_deque[m_dequeHead].value;
+}
+
+float PeakDetector::pushTruePeak(float sample) {
+    const float x0 = m_history[0], x1 = m_history[1], x2 = m_history[2];
+    float peak = std::abs(sample);
+    for (const auto& taps : TRUE_PEAK_TAPS) {
+        peak = std::max(peak, std::abs(taps[0] * x0 + taps[1] * x1 + taps[2] * x2 + taps[3] * sample));
+    }
+    m_history = {x1, x2, sample};
+    m_truePeak = peak;
+    return peak;
+}
+
+void PeakDetector::setMode(Mode mode) {
+    m_mode = mode;
+    if (m_memoryMode == MemoryMode::Compact) {
+        if (mode == Mode::Window) {
+            m_deque.resize(m_lookAheadSamples, DequeEntry{0.0f, 0});
+        } else {
+            std::vector<DequeEntry>().swap(m_deque);
+        }
     }
+    reset();
+}
+
+MemoryFootprint PeakDetector::getMemoryFootprint() const {
+    MemoryFootprint footprint{sizeof(PeakDetector)};
+    footprint.addVector(m_deque);
+    return footprint;
+}
+
+float PeakDetector::processSample(float sample) {
+    float peakLinear = detect(sample);
     
     // Convert to dB with floor at -80dB
-    m_peakDb = peakLinear > 1e-5f ? 20.0f * std::log10(peakLinear) : -80.0f;
+    m_peakDb = peakLinear > 1e-5f ? 20.0f * DefaultMath::log10(peakLinear) : -80.0f;
     return m_peakDb;
 }
 
+void PeakDetector::processBlock(const float* input, float* peakDb, size_t numSamples) {
+    for (size_t i = 0; i < numSamples; ++i) {
+        peakDb[i] = detect(input[i]);
+    }
+    
+    // dB conversion as a separate pass so it vectorizes
+    for (size_t i = 0; i < numSamples; ++i) {
+        float peakLinear = peakDb[i];
+        peakDb[i] = peakLinear > 1e-5f ? 20.0f * DefaultMath::log10(std::max(peakLinear, 1e-5f)) : -80.0f;
+    }
+    if (numSamples > 0) m_peakDb = peakDb[numSamples - 1];
+}
+
+void PeakDetector::processBlockLinear(const float* input, float* peakLinear, size_t numSamples) {
+    for (size_t i = 0; i < numSamples; ++i) {
+        peakLinear[i] = detect(input[i]);
+    }
+    if (numSamples > 0) {
+        float last = peakLinear[numSamples - 1];
+        m_peakDb = last > 1e-5f ? 20.0f * DefaultMath::log10(last) : -80.0f;
+    }
+}
+
 void PeakDetector::reset() {
     m_peakDb = -80.0f;
-    m_bufferIndex = 0;
-    std::fill(m_buffer.begin(), m_buffer.end(), 0.0f);
+    m_dequeHead = 0;
+    m_dequeSize = 0;
+    m_sampleIndex = 0;
+    m_history.fill(0.0f);
+    m_truePeak = 0.0f;
 }
 
 // ============================================================================
@@ -55,6 +128,35 @@ void EnvelopeFollower::setTimes(float attackMs, float releaseMs) {
     
     m_attackCoeff = std::exp(-1.0f / std::max(1.0f, attackSamples));
     m_releaseCoeff = std::exp(-1.0f / std::max(1.0f, releaseSamples));
+    setControlDecimation(m_controlDecimation);
+}
+
+void EnvelopeFollower::setControlDecimation(size_t samplesPerStep) {
+    m_controlDecimation = std::max<size_t>(1, samplesPerStep);
+    m_attackCoeffControl = std::pow(m_attackCoeff, float(m_controlDecimation));
+    m_releaseCoeffControl = std::pow(m_releaseCoeff, float(m_controlDecimation));
+}
+
+float EnvelopeFollower::processControl(float targetDb) {
+    float coeff = targetDb > m_currentDb ? m_attackCoeffControl : m_releaseCoeffControl;
+    m_currentDb = flushDenormal(coeff * m_currentDb + (1.0f - coeff) * targetDb);
+    return m_currentDb;
+}
+
+float EnvelopeFollower::processInstantAttack(float targetDb) {
+    m_currentDb = targetDb < m_currentDb ? targetDb
+                                         : m_releaseCoeff * m_currentDb + (1.0f - m_releaseCoeff) * targetDb;
+    return m_currentDb;
+}
+
+void EnvelopeFollower::processBlockInstantAttack(const float* targetDb, float* smoothedDb, size_t numSamples) {
+    float current = m_currentDb;
+    for (size_t i = 0; i < numSamples; ++i) {
+        float target = targetDb[i];
+        current = target < current ? target : m_releaseCoeff * current + (1.0f - m_releaseCoeff) * target;
+        smoothedDb[i] = current;
+    }
+    m_currentDb = flushDenormal(current);
 }
 
 float EnvelopeFollower::process(float targetDb) {
@@ -69,6 +171,17 @@ float EnvelopeFollower::process(float targetDb) {
     return m_currentDb;
 }
 
+void EnvelopeFollower::processBlock(const float* targetDb, float* smoothedDb, size_t numSamples) {
+    float current = m_currentDb;
+    for (size_t i = 0; i < numSamples; ++i) {
+        float target = targetDb[i];
+        float coeff = target > current ? m_attackCoeff : m_releaseCoeff;
+        current = coeff * current + (1.0f - coeff) * target;
+        smoothedDb[i] = current;
+    }
+    m_currentDb = flushDenormal(current);
+}
+
 void EnvelopeFollower::reset() {
     m_currentDb = -80.0f;
 }
@@ -77,16 +190,54 @@ void EnvelopeFollower::reset() {
 // Compressor Implementation
 // ============================================================================
 
-Compressor::Compressor(float sampleRate)
-    : m_sampleRate(sampleRate), m_peakDetector(sampleRate), 
+Compressor::Compressor(float sampleRate, MemoryMode memoryMode)
+    : m_sampleRate(sampleRate), m_memoryMode(memoryMode), m_peakDetector(sampleRate, 5.0f, memoryMode),
       m_envelopeFollower(sampleRate), m_gainReductionDb(0.0f) {
     
+    if (memoryMode == MemoryMode::Standard) {
+        m_delayLine.resize(m_peakDetector.getLookAheadSamples(), 0.0f);
+    }
     configure(CompressorConfig());
 }
 
 void Compressor::configure(const CompressorConfig& config) {
+    const auto previousMode = m_config.detectorMode;
     m_config = config;
+    m_config.detectorMode = previousMode;
     m_envelopeFollower.setTimes(config.attackMs, config.releaseMs);
+    setDetectorMode(config.detectorMode);
+}
+
+void Compressor::setDetectorMode(CompressorConfig::DetectorMode mode) {
+    using DetectorMode = CompressorConfig::DetectorMode;
+    if (mode == m_config.detectorMode) {
+        return;
+    }
+    m_config.detectorMode = mode;
+    m_peakDetector.setMode(mode == DetectorMode::ZeroLatency ? PeakDetector::Mode::TruePeak
+                                                              : PeakDetector::Mode::Window);
+    // Window of N samples covers x[n-N+1 .. n]: delaying by N-1 centres the
+    // whole window ahead of the output sample
+    m_latencySamples = mode == DetectorMode::Lookahead ? m_peakDetector.getLookAheadSamples() - 1 : 0;
+    if (m_memoryMode == MemoryMode::Compact) {
+        if (mode == DetectorMode::Lookahead) {
+            m_delayLine.resize(m_peakDetector.getLookAheadSamples(), 0.0f);
+        } else {
+            std::vector<float>().swap(m_delayLine);
+        }
+    }
+    std::fill(m_delayLine.begin(), m_delayLine.end(), 0.0f);
+    m_delayIndex = 0;
+}
+
+void Compressor::delayBlock(const float* input, float* output, size_t numSamples) {
+    if (m_latencySamples == 0) {
+        if (input != output) std::copy(input, input + numSamples, output);
+        return;
+    }
+    for (size_t i = 0; i < numSamples; ++i) {
+        output[i] = delaySample(input[i]);
+    }
 }
 
 float Compressor::process(float input) {
@@ -102,22 +253,107 @@ float Compressor::process(float input) {
     }
     
     // Smooth gain reduction with envelope follower
-    m_gainReductionDb = m_envelopeFollower.process(gainReduction);
+    m_gainReductionDb = m_config.detectorMode == CompressorConfig::DetectorMode::ZeroLatency
+        ? m_envelopeFollower.processInstantAttack(gainReduction)
+        : m_envelopeFollower.process(gainReduction);
     
     // Convert gain reduction to linear multiplier
-    float gainReductionLinear = std::pow(10.0f, m_gainReductionDb / 20.0f);
+    float gainReductionLinear = DefaultMath::exp10(m_gainReductionDb / 20.0f);
     
     // Apply makeup gain
-    float makeupGainLinear = std::pow(10.0f, m_config.makeupGainDb / 20.0f);
+    float makeupGainLinear = DefaultMath::exp10(m_config.makeupGainDb / 20.0f);
     
-    // Apply compression and makeup
-    return input * gainReductionLinear * makeupGainLinear;
+    // Apply compression and makeup (to the delayed sample in Lookahead mode)
+    return delaySample(input) * gainReductionLinear * makeupGainLinear;
+}
+
+void Compressor::computeGainBlock(const float* input, float* gain, size_t numSamples) {
+    ScopedFlushDenormals noDenormals;
+    // 20 log10(x) = DB_PER_LOG2 * log2(x)
+    constexpr float DB_PER_LOG2 = 6.02059991f;
+    constexpr float LOG2_PER_DB = 1.0f / DB_PER_LOG2;
+    
+    const float makeupGainLinear = FastMath::exp2(m_config.makeupGainDb * LOG2_PER_DB);
+    float peak[BLOCK_SEGMENT], gainDb[BLOCK_SEGMENT];
+    
+    for (size_t start = 0; start < numSamples; start += BLOCK_SEGMENT) {
+        const size_t count = std::min(BLOCK_SEGMENT, numSamples - start);
+        float* segmentGain = gain + start;
+        m_peakDetector.processBlockLinear(input + start, peak, count);
+        
+        // Static curve: once if the detected peak holds for the segment
+        bool peakFlat = true;
+        for (size_t j = 1; j < count; ++j) peakFlat = peakFlat && peak[j] == peak[0];
+        
+        if (peakFlat) {
+            float levelDb = peak[0] > 1e-5f ? DB_PER_LOG2 * FastMath::log2(peak[0]) : -80.0f;
+            float target = calculateGainReduction(levelDb);
+            if (m_config.useSoftKnee) target = applySoftKnee(target);
+            std::fill(gainDb, gainDb + count, target);
+        } else {
+            for (size_t j = 0; j < count; ++j) {
+                float p = std::max(peak[j], 1e-5f);
+                gainDb[j] = peak[j] > 1e-5f ? DB_PER_LOG2 * FastMath::log2(p) : -80.0f;
+            }
+            for (size_t j = 0; j < count; ++j) {
+                float target = calculateGainReduction(gainDb[j]);
+                gainDb[j] = m_config.useSoftKnee ? applySoftKnee(target) : target;
+            }
+        }
+        
+        if (m_config.detectorMode == CompressorConfig::DetectorMode::ZeroLatency) {
+            m_envelopeFollower.processBlockInstantAttack(gainDb, gainDb, count);
+        } else {
+            m_envelopeFollower.processBlock(gainDb, gainDb, count);
+        }
+        
+        // Gain: one exp2 when the smoothed reduction is flat, else per sample
+        float lo = gainDb[0], hi = gainDb[0];
+        for (size_t j = 1; j < count; ++j) {
+            lo = std::min(lo, gainDb[j]);
+            hi = std::max(hi, gainDb[j]);
+        }
+        if (hi - lo <= GAIN_FLAT_DB) {
+            float g = FastMath::exp2(0.5f * (lo + hi) * LOG2_PER_DB) * makeupGainLinear;
+            std::fill(segmentGain, segmentGain + count, g);
+        } else {
+            for (size_t j = 0; j < count; ++j) segmentGain[j] = gainDb[j] * LOG2_PER_DB;
+            SimdMath::exp2(segmentGain, segmentGain, count);
+            for (size_t j = 0; j < count; ++j) segmentGain[j] *= makeupGainLinear;
+        }
+        
+        m_gainReductionDb = gainDb[count - 1];
+    }
+}
+
+void Compressor::processBlock(const float* input, float* output, size_t numSamples) {
+    ScopedFlushDenormals noDenormals;
+    float gain[BLOCK_SEGMENT];
+    for (size_t start = 0; start < numSamples; start += BLOCK_SEGMENT) {
+        const size_t count = std::min(BLOCK_SEGMENT, numSamples - start);
+        computeGainBlock(input + start, gain, count);
+        if (m_latencySamples > 0) {
+            delayBlock(input + start, output + start, count);
+            for (size_t j = 0; j < count; ++j) output[start + j] *= gain[j];
+        } else {
+            for (size_t j = 0; j < count; ++j) output[start + j] = input[start + j] * gain[j];
+        }
+    }
 }
 
 void Compressor::reset() {
     m_peakDetector.reset();
     m_envelopeFollower.reset();
     m_gainReductionDb = 0.0f;
+    std::fill(m_delayLine.begin(), m_delayLine.end(), 0.0f);
+    m_delayIndex = 0;
+}
+
+MemoryFootprint Compressor::getMemoryFootprint() const {
+    MemoryFootprint footprint{sizeof(Compressor)};
+    footprint.addMember(m_peakDetector.getMemoryFootprint());
+    footprint.addVector(m_delayLine);
+    return footprint;
 }
 
 void Compressor::setThreshold(float thresholdDb) {
@@ -167,8 +403,8 @@ float Compressor::applySoftKnee(float gainReduction) {
 // Limiter Implementation
 // ============================================================================
 
-Limiter::Limiter(float sampleRate, float ceilingDb)
-    : m_ceilingDb(ceilingDb), m_compressor(sampleRate) {
+Limiter::Limiter(float sampleRate, float ceilingDb, MemoryMode memoryMode)
+    : m_ceilingDb(ceilingDb), m_compressor(sampleRate, memoryMode) {
     
     setCeiling(ceilingDb);
     
@@ -186,6 +422,17 @@ float Limiter::process(float input) {
     return output;
 }
 
+void Limiter::processBlock(const float* input, float* output, size_t numSamples) {
+    m_compressor.processBlock(input, output, numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        output[i] = std::max(-m_ceilingLinear, std::min(m_ceilingLinear, output[i]));
+    }
+}
+
+void Limiter::computeGainBlock(const float* input, float* gain, size_t numSamples) {
+    m_compressor.computeGainBlock(input, gain, numSamples);
+}
+
 void Limiter::setCeiling(float ceilingDb) {
     m_ceilingDb = ceilingDb;
     m_ceilingLinear = std::pow(10.0f, ceilingDb / 20.0f);
@@ -199,6 +446,12 @@ void Limiter::reset() {
     m_compressor.reset();
 }
 
+MemoryFootprint Limiter::getMemoryFootprint() const {
+    MemoryFootprint footprint{sizeof(Limiter)};
+    footprint.addMember(m_compressor.getMemoryFootprint());
+    return footprint;
+}
+
 // ============================================================================
 // NoiseGate Implementation
 // ============================================================================
@@ -220,8 +473,16 @@ void NoiseGate::setTimes(float attackMs, float releaseMs) {
 }
 
 float NoiseGate::process(float input) {
-    float levelDb = std::abs(input) > 1e-6f ? 
-                     20.0f * std::log10(std::abs(input)) : -80.0f;
+    return process(input, input);
+}
+
+float NoiseGate::process(float input, float key) {
+    if (m_envelopeFollower.getControlDecimation() > 1) {
+        return input * controlRateGain(key);
+    }
+    
+    float levelDb = std::abs(key) > 1e-6f ? 
+                     20.0f * DefaultMath::log10(std::abs(key)) : -80.0f;
     
     // Check if signal exceeds threshold
     if (levelDb > m_thresholdDb) {
@@ -232,24 +493,61 @@ float NoiseGate::process(float input) {
     
     // Use envelope follower for smooth transitions
     float smoothLevel = m_envelopeFollower.process(m_gateOpen ? 0.0f : -80.0f);
-    float gateGain = std::pow(10.0f, smoothLevel / 20.0f);
+    float gateGain = DefaultMath::exp10(smoothLevel / 20.0f);
     
     return input * gateGain;
 }
 
+float NoiseGate::controlRateGain(float key) {
+    m_periodPeak = std::max(m_periodPeak, std::abs(key));
+    return m_gain.next([this] {
+        // Comparing linear peak to the linear threshold: no log per period
+        m_gateOpen = m_periodPeak > m_thresholdLinear && m_periodPeak > 1e-6f;
+        float smoothLevel = m_envelopeFollower.processControl(m_gateOpen ? 0.0f : -80.0f);
+        m_periodPeak = 0.0f;
+        return DefaultMath::exp10(smoothLevel / 20.0f);
+    });
+}
+
+void NoiseGate::processBlock(const float* input, float* output, size_t numSamples,
+                             const float* sidechain) {
+    ScopedFlushDenormals noDenormals;
+    const float* key = sidechain ? sidechain : input;
+    
+    if (m_envelopeFollower.getControlDecimation() == 1) {
+        for (size_t i = 0; i < numSamples; ++i) {
+            output[i] = process(input[i], key[i]);
+        }
+        return;
+    }
+    
+    for (size_t i = 0; i < numSamples; ++i) {
+        output[i] = input[i] * controlRateGain(key[i]);
+    }
+}
+
+void NoiseGate::setControlDecimation(size_t samplesPerUpdate) {
+    m_envelopeFollower.setControlDecimation(samplesPerUpdate);
+    m_periodPeak = 0.0f;
+    m_gain.setInterval(m_envelopeFollower.getControlDecimation());
+    m_gain.reset(DefaultMath::exp10(m_envelopeFollower.getCurrentDb() / 20.0f));
+}
+
 void NoiseGate::reset() {
     m_gateOpen = false;
     m_envelopeFollower.reset();
+    m_periodPeak = 0.0f;
+    m_gain.reset(DefaultMath::exp10(-80.0f / 20.0f));
 }
 
 // ============================================================================
 // OutputStage Implementation
 // ============================================================================
 
-OutputStage::OutputStage(float sampleRate)
+OutputStage::OutputStage(float sampleRate, MemoryMode memoryMode)
     : m_sampleRate(sampleRate), m_makeupGainLinear(1.0f),
       m_compressorEnabled(true), m_limiterEnabled(true),
-      m_compressor(sampleRate), m_limiter(sampleRate) {
+      m_compressor(sampleRate, memoryMode), m_limiter(sampleRate, -0.5f, memoryMode) {
     
     // Default compressor: -20dB threshold, 4:1 ratio
     CompressorConfig compConfig(-20.0f, 4.0f, 10.0f, 100.0f);
@@ -275,6 +573,63 @@ float OutputStage::process(float input) {
     return output;
 }
 
+void OutputStage::processBlock(const float* input, float* output, size_t numSamples) {
+    ScopedFlushDenormals noDenormals;
+    constexpr size_t SEGMENT = Compressor::BLOCK_SEGMENT;
+    float compGain[SEGMENT], limitGain[SEGMENT], compressed[SEGMENT];
+    const float ceiling = m_limiter.getCeilingLinear();
+    const size_t compLatency = m_compressorEnabled ? m_compressor.getLatencySamples() : 0;
+    const size_t limitLatency = m_limiterEnabled ? m_limiter.getLatencySamples() : 0;
+    
+    for (size_t start = 0; start < numSamples; start += SEGMENT) {
+        const size_t count = std::min(SEGMENT, numSamples - start);
+        const float* in = input + start;
+        float* out = output + start;
+        
+        // Detector -> envelope -> gain curve per stage, then one combined apply
+        if (m_compressorEnabled) {
+            m_compressor.computeGainBlock(in, compGain, count);
+        } else {
+            std::fill(compGain, compGain + count, 1.0f);
+        }
+        
+        if (compLatency > 0 || limitLatency > 0) {
+            // Lookahead: each gain meets the samples it was computed from
+            float aligned[SEGMENT];
+            if (compLatency > 0) {
+                m_compressor.delayBlock(in, aligned, count);
+            } else {
+                std::copy(in, in + count, aligned);
+            }
+            for (size_t j = 0; j < count; ++j) compressed[j] = aligned[j] * compGain[j];
+            if (m_limiterEnabled) {
+                m_limiter.computeGainBlock(compressed, limitGain, count);
+                m_limiter.delayBlock(compressed, compressed, count);
+                for (size_t j = 0; j < count; ++j) {
+                    float limited = compressed[j] * limitGain[j];
+                    out[j] = std::max(-ceiling, std::min(ceiling, limited)) * m_makeupGainLinear;
+                }
+            } else {
+                for (size_t j = 0; j < count; ++j) out[j] = compressed[j] * m_makeupGainLinear;
+            }
+        } else if (m_limiterEnabled) {
+            for (size_t j = 0; j < count; ++j) compressed[j] = in[j] * compGain[j];
+            m_limiter.computeGainBlock(compressed, limitGain, count);
+            for (size_t j = 0; j < count; ++j) {
+                float limited = in[j] * (compGain[j] * limitGain[j]);
+                out[j] = std::max(-ceiling, std::min(ceiling, limited)) * m_makeupGainLinear;
+            }
+        } else {
+            for (size_t j = 0; j < count; ++j) out[j] = in[j] * compGain[j] * m_makeupGainLinear;
+        }
+    }
+}
+
+void OutputStage::setDetectorMode(CompressorConfig::DetectorMode mode) {
+    m_compressor.setDetectorMode(mode);
+    m_limiter.setDetectorMode(mode);
+}
+
 void OutputStage::setMakeupGain(float gainDb) {
     m_makeupGainLinear = std::pow(10.0f, gainDb / 20.0f);
 }
@@ -284,4 +639,11 @@ void OutputStage::reset() {
     m_limiter.reset();
 }
 
+MemoryFootprint OutputStage::getMemoryFootprint() const {
+    MemoryFootprint footprint{sizeof(OutputStage)};
+    footprint.addMember(m_compressor.getMemoryFootprint());
+    footprint.addMember(m_limiter.getMemoryFootprint());
+    return footprint;
+}
+
 } // namespace LiveSpiceDSP
@@ -1,8 +1,11 @@
 #pragma once
 
+#include "ControlRate.h"
+#include "MemoryFootprint.h"
 #include <cmath>
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <vector>
 
 namespace LiveSpiceDSP {
@@ -31,6 +34,18 @@ struct CompressorConfig {
     bool useSoftKnee = true;         // Soft knee transition
     float kneeWidthDb = 6.0f;        // Soft knee width (dB)
     
+    /**
+     * How the detector sees peaks, and what that costs in latency:
+     * - PeakWindow: peak over the last look-ahead window, audio undelayed.
+     *   Gain reduction follows a peak; no latency.
+     * - Lookahead: audio delayed by the window, so gain reduction is already
+     *   applied when a peak reaches the output. Latency = window - 1 samples.
+     * - ZeroLatency: inter-sample (true) peak of each sample and an
+     *   instantaneous attack, release from releaseMs. No latency.
+     */
+    enum class DetectorMode { PeakWindow, Lookahead, ZeroLatency };
+    DetectorMode detectorMode = DetectorMode::PeakWindow;
+    
     CompressorConfig() = default;
     CompressorConfig(float thresh, float ratio, float att, float rel)
         : thresholdDb(thresh), ratioDb(ratio), attackMs(att), releaseMs(rel) {}
@@ -40,14 +55,45 @@ struct CompressorConfig {
 // Peak Detector (Look-ahead)
 // ============================================================================
 
+/**
+ * Sliding-window maximum of |x| over the look-ahead window, kept as a
+ * monotonic deque (decreasing values, oldest first) in fixed ring storage:
+ * every sample is pushed and popped at most once, so the cost is amortized
+ * O(1) per sample regardless of window length, with no allocation.
+ *
+ * The window only holds past samples; delaying the audio by the window
+ * (Compressor's Lookahead mode) is what makes it look ahead. In TruePeak
+ * mode there is no window: each sample reports max(|x[n]|, inter-sample
+ * peaks between x[n-2] and x[n-1]) from a 4x polyphase cubic interpolator.
+ * Sample peaks count at once, inter-sample peaks one sample later; being
+ * four taps, it underreads tones near fs/4 by up to ~1 dB.
+ */
 class PeakDetector {
 public:
+    enum class Mode {
+        Window,     // Max |x| over the window (default)
+        TruePeak    // Per-sample true-peak estimate, no window
+    };
+    
+    /**
+     * Interpolator phases at 1/4, 2/4, 3/4 between x[n-2] and x[n-1]
+     * (Catmull-Rom weights over x[n-3] .. x[n])
+     */
+    static constexpr float TRUE_PEAK_TAPS[3][4] = {
+        {-0.0703125f, 0.8671875f, 0.2265625f, -0.0234375f},
+        {-0.0625f, 0.5625f, 0.5625f, -0.0625f},
+        {-0.0234375f, 0.2265625f, 0.8671875f, -0.0703125f}
+    };
+
     /**
      * Initialize peak detector
      * @param sampleRate Sample rate (Hz)
      * @param lookAheadMs Look-ahead window (milliseconds)
+     * @param memoryMode Compact holds the window only while in Window mode
+     *        (setMode() then allocates)
      */
-    PeakDetector(float sampleRate = 44100.0f, float lookAheadMs = 5.0f);
+    PeakDetector(float sampleRate = 44100.0f, float lookAheadMs = 5.0f,
+                 MemoryMode memoryMode = MemoryMode::Standard);
     
     /**
      * Process sample and return peak level
@@ -56,22 +102,71 @@ public:
      */
     float processSample(float sample);
     
+    /**
+     * Process a buffer
+     * @param input Input samples
+     * @param peakDb Output: peak level in dB per sample
+     * @param numSamples Number of samples
+     */
+    void processBlock(const float* input, float* peakDb, size_t numSamples);
+    
+    /**
+     * Process a buffer, writing the linear peak |x| per sample (no dB pass)
+     */
+    void processBlockLinear(const float* input, float* peakLinear, size_t numSamples);
+    
     /**
      * Get current peak
      */
     float getPeakDb() const { return m_peakDb; }
     
+    /**
+     * Linear peak |x| over the current window
+     */
+    float getPeakLinear() const {
+        if (m_mode == Mode::TruePeak) return m_truePeak;
+        return m_dequeSize > 0 ? m_deque[m_dequeHead].value : 0.0f;
+    }
+    
+    size_t getLookAheadSamples() const { return m_lookAheadSamples; }
+    
+    /**
+     * Switch detection mode (resets the detector)
+     */
+    void setMode(Mode mode);
+    Mode getMode() const { return m_mode; }
+    
     /**
      * Reset detector
      */
     void reset();
+    
+    MemoryFootprint getMemoryFootprint() const;
 
 private:
+    // Window entry; indices are compared by unsigned difference, so they may wrap
+    struct DequeEntry {
+        float value;
+        uint32_t index;    // Sample index the value arrived at
+    };
+    
     float m_sampleRate;
     float m_peakDb;
     size_t m_lookAheadSamples;
-    std::vector<float> m_buffer;
-    size_t m_bufferIndex;
+    Mode m_mode = Mode::Window;
+    MemoryMode m_memoryMode;
+    std::array<float, 3> m_history{};      // x[n-3], x[n-2], x[n-1] for TruePeak
+    float m_truePeak = 0.0f;
+    
+    // Monotonic deque ring: values decrease from head to tail
+    std::vector<DequeEntry> m_deque;
+    size_t m_dequeHead = 0;
+    size_t m_dequeSize = 0;
+    uint32_t m_sampleIndex = 0;
+    
+    float pushSample(float magnitude);
+    float pushTruePeak(float sample);
+    float detect(float sample) { return m_mode == Mode::TruePeak ? pushTruePeak(sample) : pushSample(std::abs(sample)); }
 };
 
 // ============================================================================
@@ -100,6 +195,36 @@ public:
      */
     float process(float targetDb);
     
+    /**
+     * Process a buffer of targets
+     * @param targetDb Target levels (dB)
+     * @param smoothedDb Output: smoothed levels (may alias targetDb)
+     * @param numSamples Number of samples
+     */
+    void processBlock(const float* targetDb, float* smoothedDb, size_t numSamples);
+    
+    /**
+     * Control-rate operation: one processControl() step advances the
+     * envelope by `samplesPerStep` samples (coefficients raised to that power)
+     * @param samplesPerStep Decimation factor (1 = audio rate)
+     */
+    void setControlDecimation(size_t samplesPerStep);
+    size_t getControlDecimation() const { return m_controlDecimation; }
+    
+    /**
+     * Advance one control step towards targetDb
+     */
+    float processControl(float targetDb);
+    
+    /**
+     * Gain-reduction follower with an instantaneous attack: drops to
+     * targetDb at once and recovers towards it with the release time
+     */
+    float processInstantAttack(float targetDb);
+    void processBlockInstantAttack(const float* targetDb, float* smoothedDb, size_t numSamples);
+    
+    float getCurrentDb() const { return m_currentDb; }
+    
     /**
      * Reset to initial state
      */
@@ -110,6 +235,9 @@ private:
     float m_currentDb;
     float m_attackCoeff;
     float m_releaseCoeff;
+    size_t m_controlDecimation = 1;
+    float m_attackCoeffControl = 0.0f;
+    float m_releaseCoeffControl = 0.0f;
 };
 
 // ============================================================================
@@ -121,8 +249,10 @@ public:
     /**
      * Initialize compressor
      * @param sampleRate Sample rate (Hz)
+     * @param memoryMode Compact allocates the look-ahead delay line only
+     *        in Lookahead mode (setDetectorMode() then allocates)
      */
-    Compressor(float sampleRate = 44100.0f);
+    Compressor(float sampleRate = 44100.0f, MemoryMode memoryMode = MemoryMode::Standard);
     
     /**
      * Configure compressor
@@ -137,11 +267,51 @@ public:
      */
     float process(float input);
     
+    /**
+     * Process a buffer through the block gain computer
+     * Works in BLOCK_SEGMENT-sample segments: levels in the log2 domain
+     * (FastMath::log2), the static curve once per segment when the detected
+     * peak is flat, and one exp2 for the whole segment when the smoothed
+     * gain is flat (within GAIN_FLAT_DB); otherwise per-sample exp2 in a
+     * vectorizable loop. Matches process() to within ~1e-3 dB.
+     * @param input Input samples
+     * @param output Output samples (may alias input)
+     * @param numSamples Number of samples
+     */
+    void processBlock(const float* input, float* output, size_t numSamples);
+    
+    /**
+     * Run detector, envelope and gain curve only: writes the linear gain
+     * (including makeup) that processBlock() would apply to each sample
+     */
+    void computeGainBlock(const float* input, float* gain, size_t numSamples);
+    
+    static constexpr size_t BLOCK_SEGMENT = 64;
+    static constexpr float GAIN_FLAT_DB = 1e-3f;
+    
     /**
      * Get current gain reduction (dB)
      */
     float getGainReductionDb() const { return m_gainReductionDb; }
     
+    /**
+     * Detector mode (see CompressorConfig::DetectorMode); changing it
+     * clears the look-ahead delay line
+     */
+    void setDetectorMode(CompressorConfig::DetectorMode mode);
+    CompressorConfig::DetectorMode getDetectorMode() const { return m_config.detectorMode; }
+    
+    /**
+     * Samples the output lags the input (non-zero only in Lookahead mode)
+     */
+    size_t getLatencySamples() const { return m_latencySamples; }
+    
+    /**
+     * Delay samples by getLatencySamples() to line them up with the gain
+     * computeGainBlock() returned for the same input (may alias)
+     */
+    void delayBlock(const float* input, float* output, size_t numSamples);
+    
     /**
      * Reset compressor state
      */
@@ -161,14 +331,31 @@ public:
      * Set makeup gain
      */
     void setMakeupGain(float gainDb);
+    
+    MemoryFootprint getMemoryFootprint() const;
 
 private:
     float m_sampleRate;
+    MemoryMode m_memoryMode;
     CompressorConfig m_config;
     PeakDetector m_peakDetector;
     EnvelopeFollower m_envelopeFollower;
     float m_gainReductionDb;
     
+    // Look-ahead delay line (window - 1 samples, allocated once; in compact
+    // mode only while in Lookahead mode)
+    std::vector<float> m_delayLine;
+    size_t m_delayIndex = 0;
+    size_t m_latencySamples = 0;
+    
+    float delaySample(float input) {
+        if (m_latencySamples == 0) return input;
+        float delayed = m_delayLine[m_delayIndex];
+        m_delayLine[m_delayIndex] = input;
+        if (++m_delayIndex == m_latencySamples) m_delayIndex = 0;
+        return delayed;
+    }
+    
     /**
      * Calculate gain reduction from peak level
      */
@@ -190,8 +377,9 @@ public:
      * Initialize limiter
      * @param sampleRate Sample rate (Hz)
      * @param ceilingDb Hard ceiling level (typically 0dB or -0.5dB)
+     * @param memoryMode Storage policy of the limiter's compressor
      */
-    Limiter(float sampleRate = 44100.0f, float ceilingDb = -0.5f);
+    Limiter(float sampleRate = 44100.0f, float ceilingDb = -0.5f, MemoryMode memoryMode = MemoryMode::Standard);
     
     /**
      * Process sample through limiter
@@ -200,6 +388,26 @@ public:
      */
     float process(float input);
     
+    /**
+     * Process a buffer: block compressor, then the ceiling clamp
+     */
+    void processBlock(const float* input, float* output, size_t numSamples);
+    
+    /**
+     * Limiter compressor gain per sample, before the ceiling clamp
+     */
+    void computeGainBlock(const float* input, float* gain, size_t numSamples);
+    
+    float getCeilingLinear() const { return m_ceilingLinear; }
+    
+    /**
+     * Detector mode and latency of the limiter's compressor
+     */
+    void setDetectorMode(CompressorConfig::DetectorMode mode) { m_compressor.setDetectorMode(mode); }
+    CompressorConfig::DetectorMode getDetectorMode() const { return m_compressor.getDetectorMode(); }
+    size_t getLatencySamples() const { return m_compressor.getLatencySamples(); }
+    void delayBlock(const float* input, float* output, size_t numSamples) { m_compressor.delayBlock(input, output, numSamples); }
+    
     /**
      * Set ceiling level
      * @param ceilingDb Maximum output level (dB)
@@ -215,6 +423,8 @@ public:
      * Reset limiter
      */
     void reset();
+    
+    MemoryFootprint getMemoryFootprint() const;
 
 private:
     float m_ceilingDb;
@@ -254,6 +464,35 @@ public:
      */
     float process(float input);
     
+    /**
+     * Process sample with the gate keyed from a sidechain signal
+     * Above control decimation 1 this is the control-rate path of
+     * processBlock(), one sample at a time.
+     * @param input Input sample (gated)
+     * @param key Sidechain sample (detected)
+     */
+    float process(float input, float key);
+    
+    /**
+     * Process a buffer
+     * At control decimation 1 this equals process() per sample. Above 1, the
+     * key peak is collected over each control period, the envelope steps
+     * once per period, and the gain ramps linearly to the new value over the
+     * following period (one period of detection latency, no zipper noise).
+     * @param input Input samples
+     * @param output Output samples (may alias input)
+     * @param numSamples Number of samples
+     * @param sidechain Optional key signal (nullptr = key from input)
+     */
+    void processBlock(const float* input, float* output, size_t numSamples,
+                      const float* sidechain = nullptr);
+    
+    /**
+     * Envelope/gain update period (e.g. 16 or 32; 1 = audio rate)
+     */
+    void setControlDecimation(size_t samplesPerUpdate);
+    size_t getControlDecimation() const { return m_envelopeFollower.getControlDecimation(); }
+    
     /**
      * Get gate state (true = open, false = closed)
      */
@@ -270,6 +509,12 @@ private:
     float m_thresholdLinear;
     bool m_gateOpen;
     EnvelopeFollower m_envelopeFollower;
+    
+    // Control-rate state
+    float m_periodPeak = 0.0f;
+    ControlRamp m_gain{1, 1e-4f};    // exp10(-80 / 20)
+    
+    float controlRateGain(float key);
 };
 
 // ============================================================================
@@ -281,8 +526,9 @@ public:
     /**
      * Initialize output stage
      * @param sampleRate Sample rate (Hz)
+     * @param memoryMode Storage policy of the compressor and limiter
      */
-    OutputStage(float sampleRate = 44100.0f);
+    OutputStage(float sampleRate = 44100.0f, MemoryMode memoryMode = MemoryMode::Standard);
     
     /**
      * Process sample through complete output stage
@@ -291,6 +537,16 @@ public:
      */
     float process(float input);
     
+    /**
+     * Fused block path: compressor and limiter gain curves are computed
+     * over each segment in tight loops, then the combined gain, ceiling
+     * clamp and makeup are applied in a single pass per sample.
+     * @param input Input samples
+     * @param output Output samples (may alias input)
+     * @param numSamples Number of samples
+     */
+    void processBlock(const float* input, float* output, size_t numSamples);
+    
     /**
      * Access compressor for configuration
      */
@@ -318,10 +574,25 @@ public:
      */
     void setLimiterEnabled(bool enabled) { m_limiterEnabled = enabled; }
     
+    /**
+     * Detector mode for both compressor and limiter
+     */
+    void setDetectorMode(CompressorConfig::DetectorMode mode);
+    
+    /**
+     * Latency of the enabled stages (Lookahead mode); report it to the host
+     */
+    size_t getLatencySamples() const {
+        return (m_compressorEnabled ? m_compressor.getLatencySamples() : 0)
+             + (m_limiterEnabled ? m_limiter.getLatencySamples() : 0);
+    }
+    
     /**
      * Reset all stages
      */
     void reset();
+    
+    MemoryFootprint getMemoryFootprint() const;
 
 private:
     float m_sampleRate;
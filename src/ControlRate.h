@@ -0,0 +1,132 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file ControlRate.h
+ * @brief Control-rate signals: computed every K samples, interpolated between
+ *
+ * Knob-derived gains, bias-dependent constants and envelope-derived values
+ * move far slower than audio. A ControlRamp evaluates such a value once per
+ * control period of K samples and ramps linearly to it over the following
+ * period, so the audio loop only pays one add per sample. The ramp lags its
+ * source by one period, which keeps it free of zipper steps.
+ *
+ * Two ways to drive it:
+ *  - pull: next(compute) / multiply(data, n, compute) call compute() at each
+ *    period boundary (envelopes, derived constants);
+ *  - push: setTarget() from the block's parameter read, then next() or
+ *    multiply(data, n); each boundary ramps towards the latest target.
+ */
+
+class ControlRamp {
+public:
+    static constexpr size_t DEFAULT_INTERVAL = 32;
+
+    explicit ControlRamp(size_t interval = DEFAULT_INTERVAL, float value = 0.0f) {
+        setInterval(interval);
+        reset(value);
+    }
+
+    /**
+     * Samples per control period (1 = a new control point every sample).
+     * Restarts the period and holds the current value.
+     */
+    void setInterval(size_t interval) {
+        m_interval = std::max<size_t>(1, interval);
+        m_phase = 0;
+        m_step = 0.0f;
+    }
+    size_t getInterval() const { return m_interval; }
+
+    /**
+     * Jump to value with no ramp (prepare, reset, first block)
+     */
+    void reset(float value) {
+        m_value = m_target = value;
+        m_step = 0.0f;
+        m_phase = 0;
+    }
+
+    /**
+     * Push mode: the value the next control point ramps to
+     */
+    void setTarget(float target) { m_target = target; }
+    float getTarget() const { return m_target; }
+
+    float getValue() const { return m_value; }
+    bool isRamping() const { return m_step != 0.0f; }
+
+    /**
+     * Current value, then advance one sample; compute() supplies the next
+     * control point when a period ends
+     */
+    template <typename Compute>
+    float next(Compute&& compute) {
+        const float value = m_value;
+        m_value += m_step;
+        if (++m_phase == m_interval) {
+            controlPoint(compute());
+        }
+        return value;
+    }
+
+    float next() {
+        return next([this] { return m_target; });
+    }
+
+    /**
+     * data[i] *= next(compute), one period at a time: the audio loop between
+     * control points is a plain ramped multiply
+     */
+    template <typename Compute>
+    void multiply(float* data, size_t numSamples, Compute&& compute) {
+        size_t i = 0;
+        while (i < numSamples) {
+            const size_t count = std::min(numSamples - i, m_interval - m_phase);
+            float value = m_value;
+            const float step = m_step;
+            for (size_t n = 0; n < count; ++n) {
+                data[i + n] *= value;
+                value += step;
+            }
+            m_value = value;
+            m_phase += count;
+            i += count;
+            if (m_phase == m_interval) {
+                controlPoint(compute());
+            }
+        }
+    }
+
+    void multiply(float* data, size_t numSamples) {
+        multiply(data, numSamples, [this] { return m_target; });
+    }
+
+    /**
+     * output[i] = next(compute), for callers that apply the values themselves
+     */
+    template <typename Compute>
+    void fill(float* output, size_t numSamples, Compute&& compute) {
+        std::fill(output, output + numSamples, 1.0f);
+        multiply(output, numSamples, compute);
+    }
+
+private:
+    void controlPoint(float target) {
+        m_target = target;
+        m_step = (target - m_value) / static_cast<float>(m_interval);
+        m_phase = 0;
+    }
+
+    size_t m_interval = DEFAULT_INTERVAL;
+    size_t m_phase = 0;
+    float m_value = 0.0f;
+    float m_target = 0.0f;
+    float m_step = 0.0f;
+};
+
+} // namespace LiveSpiceDSP
@@ -0,0 +1,75 @@
+#include "CostModel.h"
+
+namespace LiveSpice {
+
+    // Measured on the back-to-back 1N4148 clipper into 10k (1N34A gives the
+    // same figures): a 2 V, 4.37 kHz sine at 48 kHz through
+    // DiodeClippingStage and, above 1x, the default linear-phase Oversampler.
+    // Cost is the best of repeated runs; SNR is the harmonic energy over
+    // the aliased energy plus the harmonic magnitude error against Newton
+    // at 8x. Rerun the plugin benchmark (--bench) to check a target machine.
+    const std::vector<ClipperCost>& CostModel::clipperCosts() {
+        static const std::vector<ClipperCost> costs = {
+            {ClipperSolver::NewtonRaphson, 1, 104.0, 18.4},
+            {ClipperSolver::NewtonRaphson, 2, 221.0, 28.0},
+            {ClipperSolver::NewtonRaphson, 4, 413.0, 34.4},
+            {ClipperSolver::NewtonRaphson, 8, 787.0, 40.5},
+            {ClipperSolver::WrightOmega,   1,  30.0, 18.4},
+            {ClipperSolver::WrightOmega,   2,  86.0, 28.0},
+            {ClipperSolver::WrightOmega,   4, 154.0, 34.4},
+            {ClipperSolver::WrightOmega,   8, 237.0, 40.5},
+            {ClipperSolver::ADAA1,         1,  30.0, 24.6},
+            {ClipperSolver::ADAA1,         2,  79.0, 36.4},
+            {ClipperSolver::ADAA1,         4, 132.0, 48.1},
+            {ClipperSolver::ADAA1,         8, 246.0, 59.9},
+            {ClipperSolver::ADAA2,         1,  34.0, 19.6},
+            {ClipperSolver::ADAA2,         2,  80.0, 30.6},
+            {ClipperSolver::ADAA2,         4, 136.0, 42.4},
+            {ClipperSolver::ADAA2,         8, 259.0, 54.3},
+        };
+        return costs;
+    }
+
+    const char* CostModel::solverName(ClipperSolver solver) {
+        switch (solver) {
+            case ClipperSolver::NewtonRaphson: return "Newton-Raphson";
+            case ClipperSolver::WrightOmega: return "Wright omega";
+            case ClipperSolver::ADAA1: return "ADAA1";
+            case ClipperSolver::ADAA2: return "ADAA2";
+        }
+        return "unknown";
+    }
+
+    CostModel::Plan CostModel::selectForBudget(size_t clippers, double budgetNsPerSample, int oversampling) {
+        Plan best;
+        best.clippers = clippers;
+        best.fits = false;
+        const ClipperCost* chosen = nullptr;
+        const ClipperCost* cheapest = nullptr;
+
+        for (const auto& cost : clipperCosts()) {
+            if (oversampling > 0 && cost.oversampling != oversampling) continue;
+            if (!cheapest || cost.nsPerSample < cheapest->nsPerSample ||
+                (cost.nsPerSample == cheapest->nsPerSample && cost.snrDb > cheapest->snrDb)) {
+                cheapest = &cost;
+            }
+
+            if (cost.nsPerSample * static_cast<double>(clippers) > budgetNsPerSample) continue;
+            if (!chosen || cost.snrDb > chosen->snrDb ||
+                (cost.snrDb == chosen->snrDb && cost.nsPerSample < chosen->nsPerSample)) {
+                chosen = &cost;
+            }
+        }
+
+        const ClipperCost* pick = chosen ? chosen : cheapest;
+        if (pick) {
+            best.solver = pick->solver;
+            best.oversampling = pick->oversampling;
+            best.nsPerSample = pick->nsPerSample * static_cast<double>(clippers);
+            best.snrDb = pick->snrDb;
+            best.fits = chosen != nullptr;
+        }
+        return best;
+    }
+
+} // namespace LiveSpice
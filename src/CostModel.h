@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace LiveSpice {
+
+    // ============================================================================
+    // Cost Model - CPU cost and accuracy of the implementations of a stage
+    // ============================================================================
+
+    /**
+     * Per-sample implementations of a generated diode clipper
+     * (Nonlinear::DiodeClippingStage solver and anti-aliasing modes)
+     */
+    enum class ClipperSolver {
+        NewtonRaphson,  // Iterative solve of the exact equation (generator default)
+        WrightOmega,    // Closed-form solve, fixed cost per sample
+        ADAA1,          // Tabulated curve, first-order antiderivative anti-aliasing
+        ADAA2           // Tabulated curve, second-order antiderivative anti-aliasing
+    };
+
+    /** One measured (implementation, oversampling) combination */
+    struct ClipperCost {
+        ClipperSolver solver;
+        int oversampling;
+        double nsPerSample;   // Per channel and base-rate sample, oversampler included
+        double snrDb;         // Harmonics over aliasing plus curve error (higher is better)
+    };
+
+    class CostModel {
+    public:
+        /**
+         * Measured costs of every clipper implementation at 1x to 8x
+         * oversampling. They do not depend on the diode part, so one
+         * implementation is chosen for all clippers of a plugin.
+         */
+        static const std::vector<ClipperCost>& clipperCosts();
+
+        static const char* solverName(ClipperSolver solver);
+
+        struct Plan {
+            ClipperSolver solver = ClipperSolver::NewtonRaphson;
+            int oversampling = 1;
+            size_t clippers = 0;
+            double nsPerSample = 0.0;   // All clippers together
+            double snrDb = 0.0;
+            bool fits = true;           // False: nothing fits, this is the cheapest plan
+        };
+
+        /**
+         * Most accurate clipper implementation whose cost for `clippers`
+         * clippers fits in budgetNsPerSample; ties go to the cheaper one.
+         * @param oversampling Fixed factor, or 0 to let the budget choose it
+         */
+        static Plan selectForBudget(size_t clippers, double budgetNsPerSample, int oversampling = 0);
+    };
+
+} // namespace LiveSpice
@@ -0,0 +1,289 @@
+#include "DKMethod.h"
+#include "SparseLU.h"
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+
+namespace LiveSpiceDSP {
+
+namespace {
+    // Conductance from every node to ground: keeps nodes joined only by
+    // diodes (series clippers) or capacitors (DC solve) solvable
+    constexpr double GMIN = 1e-9;
+
+    constexpr int DC_ITERATIONS = 200;
+    constexpr double DC_TOLERANCE = 1e-9;   // volts (or amps) per Newton step
+}
+
+void DKNetwork::addResistor(int nodeA, int nodeB, double ohms) {
+    m_resistors.push_back({nodeA, nodeB, ohms});
+}
+
+void DKNetwork::addCapacitor(int nodeA, int nodeB, double farads) {
+    m_capacitors.push_back({nodeA, nodeB, farads});
+}
+
+void DKNetwork::addDiode(int anode, int cathode, double Is, double n, double Vt) {
+    DKDiode model;
+    model.Is = Is;
+    model.nVt = n * Vt;
+    m_diodes.push_back({anode, cathode, model});
+}
+
+void DKNetwork::addIdealOpAmp(int plus, int minus, int output) {
+    m_opAmps.push_back({plus, minus, output});
+}
+
+void DKNetwork::addVoltageSource(int nodeA, int nodeB, double volts) {
+    m_sources.push_back({nodeA, nodeB, volts});
+}
+
+void DKNetwork::setInput(int nodeA, int nodeB, double voltsPerUnit) {
+    m_input = {nodeA, nodeB, voltsPerUnit};
+}
+
+void DKNetwork::setOutput(int nodeA, int nodeB) {
+    m_outputA = nodeA;
+    m_outputB = nodeB;
+}
+
+DKModel DKNetwork::build(double sampleRate) const {
+    if (!(sampleRate > 0.0)) throw std::invalid_argument("DKNetwork: sample rate must be positive");
+    for (const auto& r : m_resistors) {
+        if (!(r.value > 0.0)) throw std::invalid_argument("DKNetwork: resistance must be positive");
+    }
+    for (const auto& c : m_capacitors) {
+        if (!(c.value > 0.0)) throw std::invalid_argument("DKNetwork: capacitance must be positive");
+    }
+    for (const auto& d : m_diodes) {
+        if (!(d.model.Is > 0.0) || !(d.model.nVt > 0.0)) {
+            throw std::invalid_argument("DKNetwork: diode needs positive Is and n");
+        }
+    }
+    if (m_input.nodeA == m_input.nodeB) throw std::invalid_argument("DKNetwork: no input source");
+    if (m_outputA == m_outputB) throw std::invalid_argument("DKNetwork: no output");
+
+    // Map circuit node numbers to MNA rows (ground excluded)
+    std::map<int, size_t> index;
+    auto addNode = [&](int node) {
+        if (node != GROUND && index.find(node) == index.end()) {
+            size_t row = index.size();
+            index[node] = row;
+        }
+    };
+    for (const auto& r : m_resistors) { addNode(r.nodeA); addNode(r.nodeB); }
+    for (const auto& c : m_capacitors) { addNode(c.nodeA); addNode(c.nodeB); }
+    for (const auto& s : m_sources) { addNode(s.nodeA); addNode(s.nodeB); }
+    for (const auto& d : m_diodes) { addNode(d.anode); addNode(d.cathode); }
+    for (const auto& o : m_opAmps) { addNode(o.plus); addNode(o.minus); addNode(o.output); }
+    addNode(m_input.nodeA);
+    addNode(m_input.nodeB);
+    addNode(m_outputA);
+    addNode(m_outputB);
+
+    // Unknowns: node voltages, input source current, rail currents, op-amp output currents
+    const size_t numNodes = index.size();
+    const size_t inputRow = numNodes;
+    const size_t firstSource = inputRow + 1;
+    const size_t firstOpAmp = firstSource + m_sources.size();
+    const size_t size = firstOpAmp + m_opAmps.size();
+
+    const size_t N = m_capacitors.size();
+    const size_t P = m_diodes.size();
+    const size_t U = DKModel::INPUTS;
+
+    auto row = [&](int node) { return node == GROUND ? size : index.at(node); };
+
+    // Linear part shared by the transient and DC systems
+    SparseMatrix M(size);
+    auto stampConductance = [&](SparseMatrix& target, int nodeA, int nodeB, double g) {
+        size_t a = row(nodeA), b = row(nodeB);
+        if (a < size) target.add(a, a, g);
+        if (b < size) target.add(b, b, g);
+        if (a < size && b < size) {
+            target.add(a, b, -g);
+            target.add(b, a, -g);
+        }
+    };
+    auto stampSource = [&](size_t sourceRow, int nodeA, int nodeB) {
+        size_t a = row(nodeA), b = row(nodeB);
+        if (a < size) {
+            M.add(a, sourceRow, 1.0);
+            M.add(sourceRow, a, 1.0);
+        }
+        if (b < size) {
+            M.add(b, sourceRow, -1.0);
+            M.add(sourceRow, b, -1.0);
+        }
+    };
+
+    for (size_t n = 0; n < numNodes; ++n) M.add(n, n, GMIN);
+    for (const auto& r : m_resistors) stampConductance(M, r.nodeA, r.nodeB, 1.0 / r.value);
+    stampSource(inputRow, m_input.nodeA, m_input.nodeB);
+    for (size_t s = 0; s < m_sources.size(); ++s) {
+        stampSource(firstSource + s, m_sources[s].nodeA, m_sources[s].nodeB);
+    }
+    // Op-amp k: its current enters the output node; its row forces v+ = v-
+    for (size_t k = 0; k < m_opAmps.size(); ++k) {
+        const size_t current = firstOpAmp + k;
+        size_t out = row(m_opAmps[k].output), plus = row(m_opAmps[k].plus), minus = row(m_opAmps[k].minus);
+        if (out < size) M.add(out, current, 1.0);
+        if (plus < size) M.add(current, plus, 1.0);
+        if (minus < size) M.add(current, minus, -1.0);
+    }
+
+    // Incidence of a two-terminal branch as a row over the unknowns
+    auto incidence = [&](int nodeA, int nodeB) {
+        std::vector<double> v(size, 0.0);
+        size_t a = row(nodeA), b = row(nodeB);
+        if (a < size) v[a] += 1.0;
+        if (b < size) v[b] -= 1.0;
+        return v;
+    };
+    std::vector<std::vector<double>> Nx, Nn;
+    for (const auto& c : m_capacitors) Nx.push_back(incidence(c.nodeA, c.nodeB));
+    for (const auto& d : m_diodes) Nn.push_back(incidence(d.anode, d.cathode));
+    const std::vector<double> No = incidence(m_outputA, m_outputB);
+
+    // Source columns: u0 drives the input row, u1 = 1 every rail row
+    auto sourceColumns = [&](std::vector<double>& R, size_t cols, size_t offset) {
+        R[inputRow * cols + offset] = m_input.value;
+        for (size_t s = 0; s < m_sources.size(); ++s) {
+            R[(firstSource + s) * cols + offset + 1] = m_sources[s].value;
+        }
+    };
+    auto project = [&](const std::vector<double>& weights, const std::vector<double>& X, size_t cols, size_t col) {
+        double sum = 0.0;
+        for (size_t r = 0; r < size; ++r) sum += weights[r] * X[r * cols + col];
+        return sum;
+    };
+
+    DKModel model;
+    model.states = N;
+    model.ports = P;
+    for (const auto& d : m_diodes) model.diodes.push_back(d.model);
+
+    // ------------------------------------------------------------------------
+    // Transient: capacitor k -> conductance Gc = 2C/T plus injected state x_k,
+    // so i_c = Gc v_c - x and x' = 2 Gc v_c - x (trapezoidal rule)
+    // ------------------------------------------------------------------------
+    SparseMatrix Mt = M;
+    std::vector<double> Gc(N);
+    for (size_t k = 0; k < N; ++k) {
+        Gc[k] = 2.0 * m_capacitors[k].value * sampleRate;
+        stampConductance(Mt, m_capacitors[k].nodeA, m_capacitors[k].nodeB, Gc[k]);
+    }
+
+    // RHS columns: each state, then u, then each port current (injected -i at the anode)
+    const size_t cols = N + U + P;
+    std::vector<double> R(size * cols, 0.0);
+    for (size_t k = 0; k < N; ++k) {
+        for (size_t r = 0; r < size; ++r) R[r * cols + k] = Nx[k][r];
+    }
+    sourceColumns(R, cols, N);
+    for (size_t k = 0; k < P; ++k) {
+        for (size_t r = 0; r < size; ++r) R[r * cols + N + U + k] = -Nn[k][r];
+    }
+
+    SparseLU transient;
+    if (!transient.analyze(Mt)) {
+        throw std::invalid_argument("DKNetwork: singular network (floating node or source loop)");
+    }
+    transient.solve(R, cols);
+
+    model.A.resize(N * N);
+    model.B.resize(N * U);
+    model.C.resize(N * P);
+    for (size_t r = 0; r < N; ++r) {
+        const double scale = 2.0 * Gc[r];
+        for (size_t c = 0; c < N; ++c) {
+            model.A[r * N + c] = scale * project(Nx[r], R, cols, c) - (r == c ? 1.0 : 0.0);
+        }
+        for (size_t c = 0; c < U; ++c) model.B[r * U + c] = scale * project(Nx[r], R, cols, N + c);
+        for (size_t c = 0; c < P; ++c) model.C[r * P + c] = scale * project(Nx[r], R, cols, N + U + c);
+    }
+
+    model.G.resize(P * N);
+    model.H.resize(P * U);
+    model.K.resize(P * P);
+    for (size_t r = 0; r < P; ++r) {
+        for (size_t c = 0; c < N; ++c) model.G[r * N + c] = project(Nn[r], R, cols, c);
+        for (size_t c = 0; c < U; ++c) model.H[r * U + c] = project(Nn[r], R, cols, N + c);
+        for (size_t c = 0; c < P; ++c) model.K[r * P + c] = project(Nn[r], R, cols, N + U + c);
+    }
+
+    model.D.resize(N);
+    model.E.resize(U);
+    model.F.resize(P);
+    for (size_t c = 0; c < N; ++c) model.D[c] = project(No, R, cols, c);
+    for (size_t c = 0; c < U; ++c) model.E[c] = project(No, R, cols, N + c);
+    for (size_t c = 0; c < P; ++c) model.F[c] = project(No, R, cols, N + U + c);
+
+    // ------------------------------------------------------------------------
+    // DC operating point (input at 0, capacitors open): damped Newton on the
+    // full MNA system F(x) = M x + sum_d n_d i_d(n_d . x) - rails. The diode
+    // stamps keep one pattern, so the LU is analyzed once; the chord policy
+    // reuses the factorization until convergence slows. x0 = Gc v_c.
+    // ------------------------------------------------------------------------
+    std::vector<double> rails(size, 0.0);
+    for (size_t s = 0; s < m_sources.size(); ++s) rails[firstSource + s] = m_sources[s].value;
+
+    auto portVoltage = [&](const std::vector<double>& weights, const std::vector<double>& x) {
+        double sum = 0.0;
+        for (size_t r = 0; r < size; ++r) sum += weights[r] * x[r];
+        return sum;
+    };
+
+    std::vector<double> x(size, 0.0), F(size), dx(size);
+    std::vector<double> vd(P), id(P), gd(P);
+    SparseLU dc;
+    JacobianReuse reuse;
+    bool converged = false;
+    for (int iteration = 0; iteration < DC_ITERATIONS && !converged; ++iteration) {
+        M.multiply(x, F);
+        double residual = 0.0;
+        for (size_t r = 0; r < size; ++r) F[r] -= rails[r];
+        for (size_t k = 0; k < P; ++k) {
+            vd[k] = portVoltage(Nn[k], x);
+            model.diodes[k].evaluate(vd[k], id[k], gd[k]);
+            for (size_t r = 0; r < size; ++r) F[r] += Nn[k][r] * id[k];
+        }
+        for (double f : F) residual = std::max(residual, std::abs(f));
+
+        if (reuse.refactorNeeded(residual)) {
+            SparseMatrix J = M;
+            for (size_t k = 0; k < P; ++k) stampConductance(J, m_diodes[k].anode, m_diodes[k].cathode, gd[k]);
+            if (!dc.factor(J)) {
+                throw std::invalid_argument("DKNetwork: no DC operating point (singular with capacitors open)");
+            }
+        }
+        for (size_t r = 0; r < size; ++r) dx[r] = -F[r];
+        dc.solve(dx);
+
+        // Junction limiting scales the whole step so no diode jumps past its knee
+        double damping = 1.0;
+        for (size_t k = 0; k < P; ++k) {
+            const double step = portVoltage(Nn[k], dx);
+            const double limited = model.diodes[k].limitStep(vd[k], vd[k] + step) - vd[k];
+            if (std::abs(limited) < std::abs(step)) damping = std::min(damping, limited / step);
+        }
+        double largest = 0.0;
+        for (size_t r = 0; r < size; ++r) {
+            x[r] += damping * dx[r];
+            largest = std::max(largest, std::abs(damping * dx[r]));
+        }
+        converged = largest < DC_TOLERANCE;
+    }
+    if (!converged) {
+        throw std::invalid_argument("DKNetwork: DC operating point did not converge");
+    }
+
+    model.v0.resize(P);
+    for (size_t k = 0; k < P; ++k) model.v0[k] = portVoltage(Nn[k], x);
+    model.x0.resize(N);
+    for (size_t k = 0; k < N; ++k) model.x0[k] = Gc[k] * portVoltage(Nx[k], x);
+
+    return model;
+}
+
+} // namespace LiveSpiceDSP
@@ -0,0 +1,308 @@
+#pragma once
+
+#include "Denormals.h"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file DKMethod.h
+ * @brief Nodal DK-method (discrete K-method) circuit solver
+ *
+ * DKNetwork collects a netlist - resistors, capacitors, diodes, ideal
+ * op-amps, DC rails and one signal input - and stamps it into modified
+ * nodal analysis form with trapezoidal capacitor companions. Solving that
+ * system once per sample rate reduces the circuit to
+ *
+ *   v[n]   = G x[n] + H u[n] + K i[n]      nonlinear port voltages
+ *   i[n]   = f(v[n])                       diode currents
+ *   y[n]   = D x[n] + E u[n] + F i[n]      output voltage
+ *   x[n+1] = A x[n] + B u[n] + C i[n]      capacitor states
+ *
+ * with u = [input, 1] (the constant column carries the rails). Per sample
+ * only the P port equations need a Newton solve; DKProcessor<N, P> runs
+ * that update with compile-time sizes so every loop unrolls.
+ */
+
+// ============================================================================
+// Nonlinear Port
+// ============================================================================
+
+/**
+ * Shockley diode i = Is (exp(v / nVt) - 1) across one port
+ */
+struct DKDiode {
+    double Is = 1e-12;
+    double nVt = 0.02585;
+
+    /** Current and its derivative (exponent clamped so doubles never overflow) */
+    void evaluate(double v, double& current, double& conductance) const {
+        const double e = std::exp(std::fmin(v / nVt, 80.0));
+        current = Is * (e - 1.0);
+        conductance = Is * e / nVt;
+    }
+
+    /**
+     * SPICE-style junction limiting: past the knee, a forward step moves
+     * along the exponential's log instead of the linearized line
+     */
+    double limitStep(double vOld, double vNew) const {
+        const double vCrit = nVt * std::log(nVt / (1.41421356237 * Is));
+        if (vNew > vCrit && std::fabs(vNew - vOld) > 2.0 * nVt) {
+            if (vOld > 0.0) {
+                const double arg = 1.0 + (vNew - vOld) / nVt;
+                return arg > 0.0 ? vOld + nVt * std::log(arg) : vCrit;
+            }
+            return nVt * std::log(vNew / nVt);
+        }
+        return vNew;
+    }
+};
+
+// ============================================================================
+// Discrete Model
+// ============================================================================
+
+/**
+ * DK matrices at one sample rate (row-major), plus the DC operating point
+ * the processor starts from so rails do not thump on reset
+ */
+struct DKModel {
+    static constexpr size_t INPUTS = 2;  // u = [input, 1]
+
+    size_t states = 0;
+    size_t ports = 0;
+
+    std::vector<double> A, B, C;  // states x states | inputs | ports
+    std::vector<double> G, H, K;  // ports  x states | inputs | ports
+    std::vector<double> D, E, F;  // 1      x states | inputs | ports
+    std::vector<DKDiode> diodes;  // one per port
+
+    std::vector<double> x0;       // DC capacitor states
+    std::vector<double> v0;       // DC port voltages
+};
+
+// ============================================================================
+// Network Builder
+// ============================================================================
+
+class DKNetwork {
+public:
+    static constexpr int GROUND = 0;
+
+    void addResistor(int nodeA, int nodeB, double ohms);
+    void addCapacitor(int nodeA, int nodeB, double farads);
+
+    /** Diode conducting from anode to cathode; becomes one nonlinear port */
+    void addDiode(int anode, int cathode, double Is, double n, double Vt = 0.02585);
+
+    /** Ideal op-amp (nullor): v(plus) = v(minus), output sources any current */
+    void addIdealOpAmp(int plus, int minus, int output);
+
+    /** DC source v(nodeA) - v(nodeB) = volts */
+    void addVoltageSource(int nodeA, int nodeB, double volts);
+
+    /** Signal source v(nodeA) - v(nodeB) = voltsPerUnit * input */
+    void setInput(int nodeA, int nodeB, double voltsPerUnit = 1.0);
+
+    /** Output y = v(nodeA) - v(nodeB) */
+    void setOutput(int nodeA, int nodeB = GROUND);
+
+    size_t getNumStates() const { return m_capacitors.size(); }
+    size_t getNumPorts() const { return m_diodes.size(); }
+
+    /**
+     * Stamp, solve and reduce the network at sampleRate.
+     * Throws std::invalid_argument for an unsolvable network.
+     */
+    DKModel build(double sampleRate) const;
+
+private:
+    struct Branch {
+        int nodeA, nodeB;
+        double value;
+    };
+
+    struct OpAmp {
+        int plus, minus, output;
+    };
+
+    struct Diode {
+        int anode, cathode;
+        DKDiode model;
+    };
+
+    std::vector<Branch> m_resistors;
+    std::vector<Branch> m_capacitors;
+    std::vector<Branch> m_sources;
+    std::vector<Diode> m_diodes;
+    std::vector<OpAmp> m_opAmps;
+    Branch m_input{GROUND, GROUND, 0.0};
+    int m_outputA = GROUND;
+    int m_outputB = GROUND;
+};
+
+// ============================================================================
+// Fixed-Size DK Processor
+// ============================================================================
+
+/**
+ * Runs a DKModel with N states and P nonlinear ports known at compile time.
+ * The linear part is a handful of fixed multiply-adds; the port equations
+ * f(v) = G x + H u + K i(v) - v are solved by Newton from the previous
+ * sample's voltages, with a P x P elimination per iteration.
+ */
+template <size_t N, size_t P>
+class DKProcessor {
+public:
+    static_assert(N <= 32, "DKProcessor supports up to 32 states");
+    static_assert(P <= 8, "DKProcessor supports up to 8 nonlinear ports");
+
+    static constexpr int MAX_ITERATIONS = 16;
+    static constexpr double TOLERANCE = 1e-7;  // volts
+
+    /**
+     * Load a model built for this processor's sizes
+     * @return false if the model has a different state or port count
+     */
+    bool setModel(const DKModel& model) {
+        if (model.states != N || model.ports != P) return false;
+        copy(model.A, m_A);
+        copy(model.B, m_B);
+        copy(model.C, m_C);
+        copy(model.G, m_G);
+        copy(model.H, m_H);
+        copy(model.K, m_K);
+        copy(model.D, m_D);
+        copy(model.E, m_E);
+        copy(model.F, m_F);
+        copy(model.diodes, m_diodes);
+        copy(model.x0, m_x0);
+        copy(model.v0, m_v0);
+        reset();
+        return true;
+    }
+
+    /** Back to the DC operating point */
+    void reset() {
+        m_x = m_x0;
+        m_v = m_v0;
+    }
+
+    float processSample(float input) {
+        const double u = input;
+
+        std::array<double, P> p;
+        for (size_t k = 0; k < P; ++k) {
+            double sum = m_H[k * 2] * u + m_H[k * 2 + 1];
+            for (size_t j = 0; j < N; ++j) sum += m_G[k * N + j] * m_x[j];
+            p[k] = sum;
+        }
+
+        std::array<double, P> i;
+        solvePorts(p, i);
+
+        double y = m_E[0] * u + m_E[1];
+        for (size_t j = 0; j < N; ++j) y += m_D[j] * m_x[j];
+        for (size_t k = 0; k < P; ++k) y += m_F[k] * i[k];
+
+        std::array<double, N> next;
+        for (size_t r = 0; r < N; ++r) {
+            double sum = m_B[r * 2] * u + m_B[r * 2 + 1];
+            for (size_t j = 0; j < N; ++j) sum += m_A[r * N + j] * m_x[j];
+            for (size_t k = 0; k < P; ++k) sum += m_C[r * P + k] * i[k];
+            next[r] = sum;
+        }
+        m_x = next;
+
+        return static_cast<float>(y);
+    }
+
+    void processBlock(const float* input, float* output, size_t numSamples) {
+        ScopedFlushDenormals noDenormals;
+        for (size_t n = 0; n < numSamples; ++n) output[n] = processSample(input[n]);
+        flushDenormals(m_x);
+    }
+
+private:
+    std::array<double, N * N> m_A{};
+    std::array<double, N * 2> m_B{};
+    std::array<double, N * P> m_C{};
+    std::array<double, P * N> m_G{};
+    std::array<double, P * 2> m_H{};
+    std::array<double, P * P> m_K{};
+    std::array<double, N> m_D{};
+    std::array<double, 2> m_E{};
+    std::array<double, P> m_F{};
+    std::array<DKDiode, P> m_diodes{};
+
+    std::array<double, N> m_x0{}, m_x{};
+    std::array<double, P> m_v0{}, m_v{};
+
+    template <typename T, size_t S>
+    static void copy(const std::vector<T>& from, std::array<T, S>& to) {
+        for (size_t n = 0; n < S; ++n) to[n] = from[n];
+    }
+
+    /** Newton on f(v) = p + K i(v) - v; leaves the port currents in i */
+    void solvePorts(const std::array<double, P>& p, std::array<double, P>& i) {
+        std::array<double, P> g;
+        for (int iteration = 0; iteration < MAX_ITERATIONS; ++iteration) {
+            for (size_t k = 0; k < P; ++k) m_diodes[k].evaluate(m_v[k], i[k], g[k]);
+
+            // J = K diag(g) - I;  J dv = -f
+            std::array<double, P * P> J;
+            std::array<double, P> dv;
+            for (size_t r = 0; r < P; ++r) {
+                double f = p[r] - m_v[r];
+                for (size_t c = 0; c < P; ++c) {
+                    f += m_K[r * P + c] * i[c];
+                    J[r * P + c] = m_K[r * P + c] * g[c] - (r == c ? 1.0 : 0.0);
+                }
+                dv[r] = -f;
+            }
+            if (!solve(J, dv)) break;
+
+            double largest = 0.0;
+            for (size_t k = 0; k < P; ++k) {
+                const double next = m_diodes[k].limitStep(m_v[k], m_v[k] + dv[k]);
+                largest = std::fmax(largest, std::fabs(next - m_v[k]));
+                m_v[k] = next;
+            }
+            if (largest < TOLERANCE) break;
+        }
+        for (size_t k = 0; k < P; ++k) m_diodes[k].evaluate(m_v[k], i[k], g[k]);
+    }
+
+    /** Gaussian elimination with partial pivoting; x holds b in, solution out */
+    static bool solve(std::array<double, P * P>& M, std::array<double, P>& x) {
+        for (size_t k = 0; k < P; ++k) {
+            size_t pivot = k;
+            for (size_t r = k + 1; r < P; ++r) {
+                if (std::fabs(M[r * P + k]) > std::fabs(M[pivot * P + k])) pivot = r;
+            }
+            if (std::fabs(M[pivot * P + k]) < 1e-300) return false;
+            if (pivot != k) {
+                for (size_t c = 0; c < P; ++c) std::swap(M[k * P + c], M[pivot * P + c]);
+                std::swap(x[k], x[pivot]);
+            }
+            for (size_t r = k + 1; r < P; ++r) {
+                const double factor = M[r * P + k] / M[k * P + k];
+                for (size_t c = k; c < P; ++c) M[r * P + c] -= factor * M[k * P + c];
+                x[r] -= factor * x[k];
+            }
+        }
+        for (size_t k = P; k-- > 0;) {
+            double sum = x[k];
+            for (size_t c = k + 1; c < P; ++c) sum -= M[k * P + c] * x[c];
+            x[k] = sum / M[k * P + k];
+        }
+        return true;
+    }
+};
+
+} // namespace LiveSpiceDSP
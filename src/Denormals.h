@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define LIVESPICE_DENORMALS_SSE 1
+#endif
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file Denormals.h
+ * @brief Keep recursive DSP state out of the denormal range
+ *
+ * Filter states, envelopes and capacitor voltages decay exponentially once
+ * the input goes quiet and eventually reach subnormal floats, where x86
+ * arithmetic can be 10-100x slower. Two defences:
+ *  - ScopedFlushDenormals sets flush-to-zero / denormals-are-zero for the
+ *    current thread and restores the caller's mode on exit. Every public
+ *    block entry point that runs recursive state opens one, so a host that
+ *    forgot juce::ScopedNoDenormals (test harnesses, the CLI renderer)
+ *    still gets the fast path. Nested guards only read the control register.
+ *  - flushDenormal() snaps a stored state below DENORMAL_FLOOR to zero, for
+ *    per-sample paths and builds where the FPU mode cannot be set.
+ */
+
+/** States smaller than this are inaudible (about -300 dBFS) and snap to zero */
+constexpr float DENORMAL_FLOOR = 1e-15f;
+
+inline float flushDenormal(float x) {
+    return (x < DENORMAL_FLOOR && x > -DENORMAL_FLOOR) ? 0.0f : x;
+}
+
+inline double flushDenormal(double x) {
+    return (x < 1e-30 && x > -1e-30) ? 0.0 : x;
+}
+
+template <typename Container>
+void flushDenormals(Container& values) {
+    for (auto& value : values) {
+        value = flushDenormal(value);
+    }
+}
+
+class ScopedFlushDenormals {
+public:
+    ScopedFlushDenormals() {
+#if defined(LIVESPICE_DENORMALS_SSE)
+        m_previous = _mm_getcsr();
+        if ((m_previous & SSE_FLUSH_BITS) != SSE_FLUSH_BITS) {
+            _mm_setcsr(m_previous | SSE_FLUSH_BITS);
+            m_changed = true;
+        }
+#elif defined(__aarch64__)
+        uint64_t fpcr;
+        __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+        m_previous = fpcr;
+        if ((fpcr & ARM_FLUSH_BIT) == 0) {
+            __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr | ARM_FLUSH_BIT));
+            m_changed = true;
+        }
+#endif
+    }
+
+    ~ScopedFlushDenormals() {
+        if (!m_changed) return;
+#if defined(LIVESPICE_DENORMALS_SSE)
+        _mm_setcsr(static_cast<unsigned int>(m_previous));
+#elif defined(__aarch64__)
+        __asm__ __volatile__("msr fpcr, %0" : : "r"(m_previous));
+#endif
+    }
+
+    ScopedFlushDenormals(const ScopedFlushDenormals&) = delete;
+    ScopedFlushDenormals& operator=(const ScopedFlushDenormals&) = delete;
+
+    /**
+     * True when the calling thread currently flushes denormals (false on
+     * targets without a known control register)
+     */
+    static bool isActive() {
+#if defined(LIVESPICE_DENORMALS_SSE)
+        return (_mm_getcsr() & SSE_FLUSH_BITS) == SSE_FLUSH_BITS;
+#elif defined(__aarch64__)
+        uint64_t fpcr;
+        __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+        return (fpcr & ARM_FLUSH_BIT) != 0;
+#else
+        return false;
+#endif
+    }
+
+private:
+    static constexpr unsigned int SSE_FLUSH_BITS = 0x8040;        // MXCSR FTZ | DAZ
+    static constexpr uint64_t ARM_FLUSH_BIT = uint64_t(1) << 24;  // FPCR FZ
+
+    uint64_t m_previous = 0;
+    bool m_changed = false;
+};
+
+} // namespace LiveSpiceDSP
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "DiodeModels.h"
+#include "TransistorModels.h"
+#include <array>
+
+namespace Nonlinear {
+
+/**
+ * DeviceTables.h - Compile-time device tables for stock parts
+ *
+ * Tables for the preset DiodeCharacteristics and BJTCharacteristics are
+ * evaluated by the compiler and emitted as read-only data, so stock parts
+ * cost nothing to set up at instantiation and their pages are shared
+ * between processes. Custom parts fall back to runtime construction.
+ */
+
+namespace constexpr_math {
+
+/**
+ * constexpr exp(): reduce by ln2, Taylor series on |r| <= ln2/2, rescale
+ * Double precision throughout; tables are rounded to float afterwards.
+ */
+constexpr double exp(double x) {
+    constexpr double LN2 = 0.69314718055994530942;
+    long k = static_cast<long>(x / LN2 + (x >= 0.0 ? 0.5 : -0.5));
+    double r = x - static_cast<double>(k) * LN2;
+
+    double term = 1.0, sum = 1.0;
+    for (int i = 1; i < 24; ++i) {
+        term *= r / i;
+        sum += term;
+    }
+
+    double scale = 1.0;
+    for (long i = 0; i < (k < 0 ? -k : k); ++i) scale *= 2.0;
+    return k < 0 ? sum / scale : sum * scale;
+}
+
+constexpr float clamp(float x, float lo, float hi) {
+    return x < lo ? lo : (x > hi ? hi : x);
+}
+
+}  // namespace constexpr_math
+
+// ============================================================================
+// Diode current tables (DiodeLUT layout)
+// ============================================================================
+
+/**
+ * Same grid and exponent clamp as the runtime DiodeLUT build
+ */
+constexpr DiodeLUT::CurrentTable makeDiodeCurrentTable(const DiodeCharacteristics& diode) {
+    DiodeLUT::CurrentTable table{};
+    const float nVt = diode.n * diode.Vt;
+    for (int i = 0; i < DiodeLUT::LUT_SIZE; ++i) {
+        float voltage = DiodeLUT::VOLTAGE_MIN + float(i) / (DiodeLUT::LUT_SIZE - 1) * (DiodeLUT::VOLTAGE_MAX - DiodeLUT::VOLTAGE_MIN);
+        float expArg = constexpr_math::clamp(voltage / nVt, -20.0f, 50.0f);
+        table[i] = static_cast<float>(diode.Is * (constexpr_math::exp(expArg) - 1.0));
+    }
+    return table;
+}
+
+inline constexpr DiodeLUT::CurrentTable kDiodeTable_1N4148 = makeDiodeCurrentTable(DiodeCharacteristics::Si1N4148());
+inline constexpr DiodeLUT::CurrentTable kDiodeTable_1N914 = makeDiodeCurrentTable(DiodeCharacteristics::Si1N914());
+inline constexpr DiodeLUT::CurrentTable kDiodeTable_OA90 = makeDiodeCurrentTable(DiodeCharacteristics::Ge_OA90());
+inline constexpr DiodeLUT::CurrentTable kDiodeTable_1N4007 = makeDiodeCurrentTable(DiodeCharacteristics::Si1N4007());
+
+// ============================================================================
+// BJT collector current tables (BJTCurrentLUT layout)
+// ============================================================================
+
+/**
+ * Ic(Vbe) = Bf * Is * (exp(Vbe / (nBE*Vt)) - 1), before the Early term
+ */
+constexpr BJTCurrentLUT::CurrentTable makeBJTCurrentTable(const BJTCharacteristics& bjt) {
+    BJTCurrentLUT::CurrentTable table{};
+    const float nVt = bjt.nBE * bjt.Vt;
+    for (int i = 0; i < BJTCurrentLUT::LUT_SIZE; ++i) {
+        float vbe = BJTCurrentLUT::VBE_MIN + float(i) / (BJTCurrentLUT::LUT_SIZE - 1) * (BJTCurrentLUT::VBE_MAX - BJTCurrentLUT::VBE_MIN);
+        float expArg = constexpr_math::clamp(vbe / nVt, -50.0f, 50.0f);
+        table[i] = static_cast<float>(bjt.Bf * bjt.Is * (constexpr_math::exp(expArg) - 1.0));
+    }
+    return table;
+}
+
+inline constexpr BJTCurrentLUT::CurrentTable kBJTTable_2N3904 = makeBJTCurrentTable(BJTCharacteristics::TwoN3904());
+inline constexpr BJTCurrentLUT::CurrentTable kBJTTable_2N2222 = makeBJTCurrentTable(BJTCharacteristics::TwoN2222());
+
+// ============================================================================
+// Stock-part lookup
+// ============================================================================
+
+constexpr bool sameDevice(const DiodeCharacteristics& a, const DiodeCharacteristics& b) {
+    return a.Is == b.Is && a.n == b.n && a.Vt == b.Vt;
+}
+
+constexpr bool sameDevice(const BJTCharacteristics& a, const BJTCharacteristics& b) {
+    return a.Is == b.Is && a.nBE == b.nBE && a.Vt == b.Vt && a.Bf == b.Bf;
+}
+
+/**
+ * Static table for a stock diode, or nullptr for a custom part
+ */
+inline const DiodeLUT::CurrentTable* findStockDiodeTable(const DiodeCharacteristics& diode) {
+    if (sameDevice(diode, DiodeCharacteristics::Si1N4148())) return &kDiodeTable_1N4148;
+    if (sameDevice(diode, DiodeCharacteristics::Si1N914())) return &kDiodeTable_1N914;
+    if (sameDevice(diode, DiodeCharacteristics::Ge_OA90())) return &kDiodeTable_OA90;
+    if (sameDevice(diode, DiodeCharacteristics::Si1N4007())) return &kDiodeTable_1N4007;
+    return nullptr;
+}
+
+/**
+ * Static table for a stock BJT, or nullptr for a custom part
+ */
+inline const BJTCurrentLUT::CurrentTable* findStockBJTTable(const BJTCharacteristics& bjt) {
+    if (sameDevice(bjt, BJTCharacteristics::TwoN3904())) return &kBJTTable_2N3904;
+    if (sameDevice(bjt, BJTCharacteristics::TwoN2222())) return &kBJTTable_2N2222;
+    return nullptr;
+}
+
+}  // namespace Nonlinear
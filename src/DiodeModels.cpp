@@ -1,10 +1,257 @@
 #include "DiodeModels.h"
+#include "DeviceTables.h"
+#include "Denormals.h"
 #include <cmath>
 #include <algorithm>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <tuple>
 
 namespace Nonlinear {
 
+/**
+ * DiodeLUT table cache
+ * 
+ * Keyed on the exact bit patterns of (Is, n, Vt) - the only inputs to the
+ * table - and guarded by a mutex, since acquisition only happens at
+ * construction time. Expired entries are pruned on each acquisition.
+ */
+namespace {
+    using LUTKey = std::tuple<uint32_t, uint32_t, uint32_t>;
+    
+    uint32_t floatBits(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+    
+    std::mutex& lutCacheMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+    
+    std::map<LUTKey, std::weak_ptr<const DiodeLUT::CurrentTable>>& lutCache() {
+        static std::map<LUTKey, std::weak_ptr<const DiodeLUT::CurrentTable>> cache;
+        return cache;
+    }
+    
+    // Compact-mode ADAA tables, keyed like the LUTs plus topology, solver and load
+    using AntiderivativeKey = std::tuple<uint32_t, uint32_t, uint32_t, int, int, uint32_t>;
+    
+    std::mutex& antiderivativeCacheMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+    
+    std::map<AntiderivativeKey, std::weak_ptr<const AntiderivativeTable>>& antiderivativeCache() {
+        static std::map<AntiderivativeKey, std::weak_ptr<const AntiderivativeTable>> cache;
+        return cache;
+    }
+}
+
+std::shared_ptr<const DiodeLUT::CurrentTable> DiodeLUT::acquireTable(const DiodeCharacteristics& diode) {
+    // Stock parts: non-owning handle onto the compile-time table
+    if (const CurrentTable* stock = findStockDiodeTable(diode)) {
+        return std::shared_ptr<const CurrentTable>(std::shared_ptr<const void>(), stock);
+    }
+    
+    const LUTKey key{floatBits(diode.Is), floatBits(diode.n), floatBits(diode.Vt)};
+    
+    std::lock_guard<std::mutex> lock(lutCacheMutex());
+    auto& cache = lutCache();
+    
+    if (auto it = cache.find(key); it != cache.end()) {
+        if (auto table = it->second.lock()) {
+            return table;
+        }
+    }
+    
+    for (auto it = cache.begin(); it != cache.end();) {
+        it = it->second.expired() ? cache.erase(it) : std::next(it);
+    }
+    
+    auto table = std::make_shared<CurrentTable>();
+    buildLookupTable(diode, *table);
+    cache[key] = table;
+    return table;
+}
+
+size_t DiodeLUT::cachedTableCount() {
+    std::lock_guard<std::mutex> lock(lutCacheMutex());
+    size_t count = 0;
+    for (const auto& entry : lutCache()) {
+        count += entry.second.expired() ? 0 : 1;
+    }
+    return count;
+}
+
+void DiodeLUT::buildLookupTable(const DiodeCharacteristics& diode, CurrentTable& table) {
+    float nVt = diode.n * diode.Vt;
+    for (int i = 0; i < LUT_SIZE; ++i) {
+        float voltage = VOLTAGE_MIN + float(i) / (LUT_SIZE - 1) * (VOLTAGE_MAX - VOLTAGE_MIN);
+        float expArg = std::clamp(voltage / nVt, -20.0f, 50.0f);
+        table[i] = diode.Is * (std::exp(expArg) - 1.0f);
+    }
+}
+
+DiodeHermiteLUT::DiodeHermiteLUT(const DiodeCharacteristics& diode, int numPoints)
+    : m_diode(diode) {
+    const double nVt = double(diode.n) * diode.Vt;
+    const int total = std::max(numPoints, 8);
+    
+    // Below -12 nVt the current is within 1e-5 of -Is; a few nodes suffice
+    m_vKnee = std::max(DiodeLUT::VOLTAGE_MIN, float(-12.0 * nVt));
+    m_reversePoints = std::max(2, total / 16);
+    const int forwardPoints = total - m_reversePoints;
+    const float reverseStep = (m_vKnee - DiodeLUT::VOLTAGE_MIN) / m_reversePoints;
+    const float forwardStep = (DiodeLUT::VOLTAGE_MAX - m_vKnee) / (forwardPoints - 1);
+    m_invReverseStep = 1.0f / reverseStep;
+    m_invForwardStep = 1.0f / forwardStep;
+    
+    m_nodes.resize(total);
+    for (int i = 0; i < total; ++i) {
+        float v = (i < m_reversePoints) ? DiodeLUT::VOLTAGE_MIN + i * reverseStep
+                                        : m_vKnee + (i - m_reversePoints) * forwardStep;
+        double e = std::exp(v / nVt);
+        m_nodes[i] = {v, float(diode.Is * (e - 1.0)), float(diode.Is * e / nVt)};
+    }
+}
+
+/**
+ * DiodeNewtonRaphson::solveLanes - Lockstep multi-lane Newton-Raphson
+ * 
+ * Lanes are held in fixed-size arrays and every step is written as a
+ * straight-line loop over SIMD_LANES with selects instead of branches,
+ * so the compiler can map one step onto a single vector register pass.
+ * Unused lanes (numLanes < SIMD_LANES) start out converged.
+ */
+void DiodeNewtonRaphson::solveLanes(const float* vApplied, const float* initialGuess, int numLanes,
+                                    const SolverConfig& config, float* outVoltage, float* outCurrent,
+                                    int* outIterations, int* clampHits) const {
+    constexpr int L = SIMD_LANES;
+    numLanes = std::clamp(numLanes, 0, L);
+    
+    const float nVt = m_diode.n * m_diode.Vt;
+    const float invNVt = 1.0f / nVt;
+    const float Is = m_diode.Is;
+    const float Rs = m_diode.Rs;
+    const float tol = config.convergenceTolerance;
+    
+    alignas(32) float v[L], target[L], current[L];
+    alignas(32) int iterations[L];
+    alignas(32) int active[L];
+    alignas(32) int clamps[L];
+    
+    for (int l = 0; l < L; ++l) {
+        bool used = l < numLanes;
+        v[l] = used ? initialGuess[l] : 0.0f;
+        target[l] = used ? vApplied[l] : 0.0f;
+        current[l] = 0.0f;
+        iterations[l] = config.maxIterations;
+        active[l] = used ? 1 : 0;
+        clamps[l] = 0;
+    }
+    
+    for (int iter = 0; iter < config.maxIterations; ++iter) {
+        int anyActive = 0;
+        
+        for (int l = 0; l < L; ++l) {
+            float expArg = std::min(std::max(v[l] * invNVt, -100.0f), 50.0f);
+            float e = detail::laneExp(expArg);
+            float i = Is * (e - 1.0f);
+            float residual = v[l] + i * Rs - target[l];
+            
+            int converged = active[l] & (std::abs(residual) < tol ? 1 : 0);
+            iterations[l] = converged ? iter + 1 : iterations[l];
+            current[l] = active[l] ? i : current[l];
+            active[l] &= converged ^ 1;
+            
+            float jacobian = 1.0f + (Is * invNVt) * e * Rs;
+            float vStep = v[l] - 0.5f * residual / jacobian;
+            float vNext = std::min(std::max(vStep, -0.5f), 1.0f);
+            clamps[l] += (active[l] && vNext != vStep) ? 1 : 0;
+            v[l] = active[l] ? vNext : v[l];
+            anyActive |= active[l];
+        }
+        
+        if (!anyActive) break;
+    }
+    
+    // Non-converged lanes report the current at their final voltage
+    for (int l = 0; l < L; ++l) {
+        if (active[l]) {
+            float expArg = std::min(std::max(v[l] * invNVt, -100.0f), 50.0f);
+            current[l] = Is * (detail::laneExp(expArg) - 1.0f);
+        }
+    }
+    
+    for (int l = 0; l < numLanes; ++l) {
+        outVoltage[l] = v[l];
+        outCurrent[l] = current[l];
+        outIterations[l] = iterations[l];
+        if (clampHits) *clampHits += clamps[l];
+    }
+}
+
+void DiodeNewtonRaphson::solveBlock(const float* vApplied, size_t numPoints, const SolverConfig& config,
+                                    float* outVoltage, float* outCurrent, int* outIterations) const {
+    float guess[SIMD_LANES];
+    std::fill(guess, guess + SIMD_LANES, config.initialGuess);
+    
+    for (size_t start = 0; start < numPoints; start += SIMD_LANES) {
+        int lanes = static_cast<int>(std::min<size_t>(SIMD_LANES, numPoints - start));
+        solveLanes(vApplied + start, guess, lanes, config,
+                   outVoltage + start, outCurrent + start, outIterations + start);
+    }
+}
+
+/**
+ * Solver telemetry
+ * 
+ * The audio thread is the only writer, so counters are published with
+ * relaxed load/store pairs rather than atomic read-modify-write. Readers
+ * may see fields from adjacent updates, which is fine for metering.
+ */
+void DiodeClippingStage::tallySolve(SolveTally& tally, int iterations, int maxIterations, int clampHits) {
+    tally.solves++;
+    tally.totalIterations += static_cast<uint64_t>(iterations);
+    tally.maxIterations = std::max(tally.maxIterations, static_cast<uint32_t>(iterations));
+    tally.nonConverged += (iterations <= 0 || iterations >= maxIterations) ? 1 : 0;
+    tally.clampHits += static_cast<uint64_t>(clampHits);
+}
+
+void DiodeClippingStage::publishStats(const SolveTally& tally) {
+    constexpr auto relaxed = std::memory_order_relaxed;
+    
+    if (m_statsResetRequested.exchange(false, relaxed)) {
+        m_statSolves.store(0, relaxed);
+        m_statTotalIterations.store(0, relaxed);
+        m_statMaxIterations.store(0, relaxed);
+        m_statNonConverged.store(0, relaxed);
+        m_statClampHits.store(0, relaxed);
+    }
+    
+    if (tally.solves == 0) return;
+    
+    m_statSolves.store(m_statSolves.load(relaxed) + tally.solves, relaxed);
+    m_statTotalIterations.store(m_statTotalIterations.load(relaxed) + tally.totalIterations, relaxed);
+    m_statMaxIterations.store(std::max(m_statMaxIterations.load(relaxed), tally.maxIterations), relaxed);
+    m_statNonConverged.store(m_statNonConverged.load(relaxed) + tally.nonConverged, relaxed);
+    m_statClampHits.store(m_statClampHits.load(relaxed) + tally.clampHits, relaxed);
+}
+
+DiodeClippingStage::SolverStats DiodeClippingStage::getSolverStats() const {
+    constexpr auto relaxed = std::memory_order_relaxed;
+    SolverStats stats;
+    stats.solves = m_statSolves.load(relaxed);
+    stats.totalIterations = m_statTotalIterations.load(relaxed);
+    stats.maxIterations = m_statMaxIterations.load(relaxed);
+    stats.nonConverged = m_statNonConverged.load(relaxed);
+    stats.clampHits = m_statClampHits.load(relaxed);
+    return stats;
+}
+
 /**
  * DiodeClippingStage::processSample - Main entry point for sample processing
  * 
@@ -16,6 +263,12 @@ namespace Nonlinear {
  * Uses Newton-Raphson method for implicit equation solving
  */
 float DiodeClippingStage::processSample(float inputSample) {
+    applyPendingLoad();
+    
+    if (m_antiAliasing != AntiAliasingMode::None) {
+        return processAntiAliased(inputSample);
+    }
+    
     switch (m_topology) {
         case TopologyType::SeriesDiode:
             return solveSeriesDiodeCircuit(inputSample);
@@ -38,6 +291,410 @@ float DiodeClippingStage::processSample(float inputSample) {
     }
 }
 
+/**
+ * DiodeClippingStage::processBlock - Block entry point
+ * 
+ * Resolves the topology switch once and runs a tight per-sample loop over
+ * the selected solver. Per-diode constants (n*Vt, Vf, Rs + Rload) are cached
+ * on the stage, so the loop body only contains the per-sample solve.
+ */
+void DiodeClippingStage::processBlock(const float* input, float* output, size_t numSamples) {
+    LiveSpiceDSP::ScopedFlushDenormals noDenormals;
+    applyPendingLoad();
+    
+    if (m_antiAliasing != AntiAliasingMode::None) {
+        for (size_t i = 0; i < numSamples; ++i) {
+            output[i] = processAntiAliased(input[i]);
+        }
+        return;
+    }
+    
+    switch (m_topology) {
+        case TopologyType::SeriesDiode:
+            processSeriesBlockLanes(input, output, numSamples);
+            break;
+            
+        case TopologyType::ParallelDiode:
+            for (size_t i = 0; i < numSamples; ++i) {
+                output[i] = solveParallelDiodeCircuit(input[i]);
+            }
+            break;
+            
+        case TopologyType::BackToBackDiodes:
+            processBackToBackBlockLanes(input, output, numSamples);
+            break;
+            
+        case TopologyType::BridgeClipping:
+            for (size_t i = 0; i < numSamples; ++i) {
+                float in = input[i];
+                float absOut = solveParallelDiodeCircuit(std::abs(in));
+                output[i] = in < 0 ? -absOut : absOut;
+            }
+            break;
+            
+        default:
+            if (output != input) {
+                std::copy(input, input + numSamples, output);
+            }
+            break;
+    }
+}
+
+/**
+ * Lane-batched block paths
+ * 
+ * Samples are classified in chunks: closed-form regions are written
+ * directly, while samples that need Newton-Raphson are gathered into a
+ * compact list, solved SIMD_LANES at a time with solveLanes(), and
+ * scattered back. Results match the scalar path to float rounding of exp().
+ */
+namespace {
+    constexpr size_t kGatherChunk = 64;
+}
+
+/**
+ * Warm start for a lane group: the lanes are separate samples, so the
+ * last converged solution from the previous group can be far from some of
+ * them, and the damped Newton step then runs out of iterations. Each lane
+ * is seeded with its own applied voltage instead (the zero-current root,
+ * within Is*Rs of the solution over the solved range).
+ */
+void DiodeClippingStage::seedLaneGuesses(const float* absApplied, int lanes, float coldGuess, float* guess) const {
+    for (int l = 0; l < lanes; ++l) {
+        guess[l] = m_warmStart ? std::clamp(absApplied[l], -0.5f, 1.0f) : coldGuess;
+    }
+}
+
+void DiodeClippingStage::processSeriesBlockLanes(const float* input, float* output, size_t numSamples) {
+    const float Vf = m_forwardVoltage;
+    const float totalZ = m_totalZ;
+    
+    DiodeNewtonRaphson::SolverConfig config;
+    config.maxIterations = 25;
+    config.convergenceTolerance = 1e-7f;
+    config.initialGuess = std::clamp(Vf * 0.8f, 0.1f, 0.7f);
+    
+    float guess[DiodeNewtonRaphson::SIMD_LANES];
+    SolveTally tally;
+    
+    size_t index[kGatherChunk];
+    float applied[kGatherChunk], vDiode[kGatherChunk], iDiode[kGatherChunk];
+    int iterations[kGatherChunk];
+    
+    for (size_t start = 0; start < numSamples; start += kGatherChunk) {
+        const size_t end = std::min(numSamples, start + kGatherChunk);
+        size_t count = 0;
+        
+        for (size_t n = start; n < end; ++n) {
+            float vApplied = std::clamp(input[n], -5.0f, 5.0f);
+            if (vApplied > Vf * 1.5f) {
+                float clipped = Vf + (vApplied - Vf) * m_impedance / totalZ;
+                output[n] = std::clamp(clipped, 0.6f, 0.95f);
+            } else if (vApplied < -Vf * 1.5f) {
+                float absOutput = Vf + (-vApplied - Vf) * m_impedance / totalZ;
+                output[n] = -std::clamp(absOutput, 0.6f, 0.95f);
+            } else {
+                index[count] = n;
+                applied[count] = vApplied;
+                ++count;
+            }
+        }
+        
+        if (m_solverMode == SolverMode::WrightOmega) {
+            for (size_t k = 0; k < count; ++k) {
+                m_omegaSolver.solve(std::abs(applied[k]), vDiode[k], iDiode[k]);
+                iterations[k] = 1;
+            }
+        }
+        
+        for (size_t k = 0; m_solverMode == SolverMode::NewtonRaphson && k < count; k += DiodeNewtonRaphson::SIMD_LANES) {
+            int lanes = static_cast<int>(std::min<size_t>(DiodeNewtonRaphson::SIMD_LANES, count - k));
+            float absApplied[DiodeNewtonRaphson::SIMD_LANES];
+            for (int l = 0; l < lanes; ++l) absApplied[l] = std::abs(applied[k + l]);
+            seedLaneGuesses(absApplied, lanes, config.initialGuess, guess);
+            
+            int clampHits = 0;
+            m_solver.solveLanes(absApplied, guess, lanes, config, vDiode + k, iDiode + k, iterations + k, &clampHits);
+            tally.clampHits += static_cast<uint64_t>(clampHits);
+            
+            for (int l = 0; l < lanes; ++l) {
+                tallySolve(tally, iterations[k + l], config.maxIterations, 0);
+            }
+        }
+        
+        for (size_t k = 0; k < count; ++k) {
+            const float vApplied = applied[k];
+            float result;
+            if (iterations[k] > 0 && iterations[k] < config.maxIterations) {
+                float corrected = vDiode[k] - iDiode[k] * m_diode.Rs;
+                result = vApplied < 0 ? -corrected : corrected;
+            } else {
+                float absClamped = std::clamp(std::abs(vApplied), 0.0f, 0.7f);
+                float outputMag = absClamped - m_lut.evaluateCurrent(absClamped) * totalZ;
+                result = vApplied < 0 ? -outputMag : outputMag;
+            }
+            output[index[k]] = result;
+        }
+    }
+    
+    publishStats(tally);
+}
+
+void DiodeClippingStage::processBackToBackBlockLanes(const float* input, float* output, size_t numSamples) {
+    const float Vf = m_forwardVoltage;
+    const float linearLimit = Vf * 0.3f;
+    const float softKneeStart = Vf * 0.7f;
+    const float hardClipping = Vf;
+    
+    DiodeNewtonRaphson::SolverConfig config;
+    config.maxIterations = 20;
+    config.convergenceTolerance = 1e-6f;
+    config.initialGuess = Vf * 0.9f;
+    
+    float guess[DiodeNewtonRaphson::SIMD_LANES];
+    SolveTally tally;
+    
+    size_t index[kGatherChunk];
+    float absApplied[kGatherChunk], vDiode[kGatherChunk], iDiode[kGatherChunk];
+    int iterations[kGatherChunk];
+    
+    for (size_t start = 0; start < numSamples; start += kGatherChunk) {
+        const size_t end = std::min(numSamples, start + kGatherChunk);
+        size_t count = 0;
+        
+        for (size_t n = start; n < end; ++n) {
+            const float vApplied = input[n];
+            const float absVoltage = std::abs(vApplied);
+            const bool isPositive = vApplied > 0;
+            
+            if (absVoltage < 0.0001f || absVoltage < linearLimit) {
+                output[n] = vApplied;
+            } else if (absVoltage < softKneeStart) {
+                float normalized = (absVoltage - linearLimit) / (softKneeStart - linearLimit);
+                float out = linearLimit + std::tanh(normalized * 1.5f) * (softKneeStart - linearLimit);
+                output[n] = isPositive ? out : -out;
+            } else if (absVoltage < hardClipping * 1.5f) {
+                index[count] = n;
+                absApplied[count] = absVoltage;
+                ++count;
+            } else {
+                output[n] = isPositive ? (Vf * 1.05f) : -(Vf * 1.05f);
+            }
+        }
+        
+        if (m_solverMode == SolverMode::WrightOmega) {
+            for (size_t k = 0; k < count; ++k) {
+                m_omegaSolver.solve(absApplied[k], vDiode[k], iDiode[k]);
+                iterations[k] = 1;
+            }
+        }
+        
+        for (size_t k = 0; m_solverMode == SolverMode::NewtonRaphson && k < count; k += DiodeNewtonRaphson::SIMD_LANES) {
+            int lanes = static_cast<int>(std::min<size_t>(DiodeNewtonRaphson::SIMD_LANES, count - k));
+            seedLaneGuesses(absApplied + k, lanes, config.initialGuess, guess);
+            
+            int clampHits = 0;
+            m_solver.solveLanes(absApplied + k, guess, lanes, config, vDiode + k, iDiode + k, iterations + k, &clampHits);
+            tally.clampHits += static_cast<uint64_t>(clampHits);
+            
+            for (int l = 0; l < lanes; ++l) {
+                tallySolve(tally, iterations[k + l], config.maxIterations, 0);
+            }
+        }
+        
+        for (size_t k = 0; k < count; ++k) {
+            const bool isPositive = input[index[k]] > 0;
+            float mag = (iterations[k] > 0 && iterations[k] < config.maxIterations) ? vDiode[k] : Vf * 1.05f;
+            output[index[k]] = isPositive ? mag : -mag;
+        }
+    }
+    
+    publishStats(tally);
+}
+
+/**
+ * Antiderivative anti-aliasing
+ * 
+ * The static curve is tabulated from a stateless twin stage (same diode,
+ * topology, load and solver, warm start off) so that building the table
+ * touches neither this stage's solver history nor its telemetry.
+ * 
+ * ADAA1: y[n] = (F1(x[n]) - F1(x[n-1])) / (x[n] - x[n-1])
+ * ADAA2: y[n] = 2 / (x[n] - x[n-2]) * (D1[n] - D1[n-1]),
+ *        D1[n] = (F2(x[n]) - F2(x[n-1])) / (x[n] - x[n-1])
+ * Ill-conditioned differences fall back to midpoint evaluation.
+ */
+void DiodeClippingStage::setAntiAliasingMode(AntiAliasingMode mode) {
+    m_antiAliasing = mode;
+    reset();
+    
+    // Setup call: take any requested load now and drop a swap in flight
+    m_impedance = m_requestedImpedance.load(std::memory_order_relaxed);
+    updateCachedConstants();
+    m_pendingTable.reset();
+    m_tableState.store(TABLE_IDLE, std::memory_order_relaxed);
+    m_fadeRemaining = 0;
+    m_builtImpedance.store(m_impedance, std::memory_order_relaxed);
+    
+    if (mode == AntiAliasingMode::None) {
+        m_adaaTable.reset();
+        return;
+    }
+    
+    m_adaaTable = acquireAntiderivativeTable(m_impedance);
+}
+
+std::shared_ptr<const AntiderivativeTable> DiodeClippingStage::buildAntiderivativeTable(float ohms) const {
+    DiodeClippingStage twin(m_diode, m_topology, ohms);
+    twin.setWarmStart(false);
+    twin.setSolverMode(m_solverMode);
+    return std::make_shared<const AntiderivativeTable>(
+        [&twin](float x) { return static_cast<double>(twin.processSample(x)); });
+}
+
+/**
+ * Compact stages look the table up first. The cache holds tables weakly;
+ * a stage only ever drops its reference off the audio thread (the swap in
+ * applyPendingLoad() keeps the outgoing table in m_pendingTable), so a
+ * shared table is never freed on the audio thread either.
+ */
+std::shared_ptr<const AntiderivativeTable> DiodeClippingStage::acquireAntiderivativeTable(float ohms) const {
+    if (m_memoryMode == MemoryMode::Standard) {
+        return buildAntiderivativeTable(ohms);
+    }
+    
+    const AntiderivativeKey key{floatBits(m_diode.Is), floatBits(m_diode.n), floatBits(m_diode.Vt),
+                                static_cast<int>(m_topology), static_cast<int>(m_solverMode), floatBits(ohms)};
+    
+    std::lock_guard<std::mutex> lock(antiderivativeCacheMutex());
+    auto& cache = antiderivativeCache();
+    
+    if (auto it = cache.find(key); it != cache.end()) {
+        if (auto table = it->second.lock()) {
+            return table;
+        }
+    }
+    
+    for (auto it = cache.begin(); it != cache.end();) {
+        it = it->second.expired() ? cache.erase(it) : std::next(it);
+    }
+    
+    auto table = buildAntiderivativeTable(ohms);
+    cache[key] = table;
+    return table;
+}
+
+size_t DiodeClippingStage::cachedAntiderivativeTableCount() {
+    std::lock_guard<std::mutex> lock(antiderivativeCacheMutex());
+    size_t count = 0;
+    for (const auto& entry : antiderivativeCache()) {
+        count += entry.second.expired() ? 0 : 1;
+    }
+    return count;
+}
+
+MemoryFootprint DiodeClippingStage::getMemoryFootprint() const {
+    MemoryFootprint footprint{sizeof(DiodeClippingStage)};
+    footprint.addMember(m_lut.getMemoryFootprint());
+    for (const auto* table : {m_adaaTable.get(), m_pendingTable.get()}) {
+        if (!table) continue;
+        if (m_memoryMode == MemoryMode::Compact) footprint.sharedBytes += table->getMemoryBytes();
+        else footprint.heapBytes += table->getMemoryBytes();
+    }
+    return footprint;
+}
+
+/**
+ * Background load changes
+ * 
+ * The builder fills m_pendingTable and publishes it; the audio thread
+ * swaps it in at the next block, so the outgoing table lands in
+ * m_pendingTable and is freed by the builder's next rebuild. During the
+ * crossfade both tables run on the same input history.
+ */
+bool DiodeClippingStage::rebuildTables() {
+    if (m_antiAliasing == AntiAliasingMode::None) return true;
+    if (m_tableState.load(std::memory_order_acquire) != TABLE_IDLE) return false;
+    
+    const float ohms = m_requestedImpedance.load(std::memory_order_relaxed);
+    m_pendingTable = acquireAntiderivativeTable(ohms);
+    m_pendingImpedance = ohms;
+    m_builtImpedance.store(ohms, std::memory_order_relaxed);
+    m_tableState.store(TABLE_PUBLISHED, std::memory_order_release);
+    return true;
+}
+
+void DiodeClippingStage::applyPendingLoad() {
+    if (m_antiAliasing == AntiAliasingMode::None) {
+        const float requested = m_requestedImpedance.load(std::memory_order_relaxed);
+        if (requested != m_impedance) {
+            m_impedance = requested;
+            updateCachedConstants();
+        }
+        return;
+    }
+    
+    if (m_tableState.load(std::memory_order_acquire) != TABLE_PUBLISHED) return;
+    
+    std::swap(m_adaaTable, m_pendingTable);
+    m_impedance = m_pendingImpedance;
+    updateCachedConstants();
+    
+    // The outgoing table keeps its ADAA2 history; the new one starts from
+    // its own divided difference over the same two inputs
+    m_fadeD1 = m_adaaD1;
+    const double dx = m_adaaX1 - m_adaaX2;
+    m_adaaD1 = std::abs(dx) < 1e-4 ? m_adaaTable->evaluateF1(0.5 * (m_adaaX1 + m_adaaX2))
+                                   : (m_adaaTable->evaluateF2(m_adaaX1) - m_adaaTable->evaluateF2(m_adaaX2)) / dx;
+    m_fadeRemaining = TABLE_CROSSFADE;
+    m_tableState.store(TABLE_FADING, std::memory_order_relaxed);
+}
+
+double DiodeClippingStage::antiAliased(const AntiderivativeTable& table, double x0, double& d1) const {
+    if (m_antiAliasing == AntiAliasingMode::ADAA1) {
+        constexpr double eps = 1e-5;
+        double dx = x0 - m_adaaX1;
+        return std::abs(dx) < eps ? table.evaluate(0.5 * (x0 + m_adaaX1))
+                                  : (table.evaluateF1(x0) - table.evaluateF1(m_adaaX1)) / dx;
+    }
+    
+    constexpr double eps = 1e-4;
+    double dx = x0 - m_adaaX1;
+    double d1Now = std::abs(dx) < eps ? table.evaluateF1(0.5 * (x0 + m_adaaX1))
+                                      : (table.evaluateF2(x0) - table.evaluateF2(m_adaaX1)) / dx;
+    
+    double y;
+    double span = x0 - m_adaaX2;
+    if (std::abs(span) < eps) {
+        double xBar = 0.5 * (x0 + m_adaaX2);
+        double delta = xBar - m_adaaX1;
+        y = std::abs(delta) < eps
+            ? table.evaluate(0.5 * (xBar + m_adaaX1))
+            : (2.0 / delta) * (table.evaluateF1(xBar) + (table.evaluateF2(m_adaaX1) - table.evaluateF2(xBar)) / delta);
+    } else {
+        y = 2.0 * (d1Now - d1) / span;
+    }
+    d1 = d1Now;
+    return y;
+}
+
+float DiodeClippingStage::processAntiAliased(float input) {
+    const double x0 = input;
+    double y = antiAliased(*m_adaaTable, x0, m_adaaD1);
+    
+    if (m_fadeRemaining > 0) {
+        const double yOld = antiAliased(*m_pendingTable, x0, m_fadeD1);
+        y += (yOld - y) * (static_cast<double>(m_fadeRemaining) / TABLE_CROSSFADE);
+        if (--m_fadeRemaining == 0) {
+            m_tableState.store(TABLE_IDLE, std::memory_order_release);
+        }
+    }
+    
+    m_adaaX2 = m_adaaX1;
+    m_adaaX1 = x0;
+    return static_cast<float>(y);
+}
+
 /**
  * solveSeriesDiodeCircuit - Series configuration
  * 
@@ -53,10 +710,9 @@ float DiodeClippingStage::solveSeriesDiodeCircuit(float vApplied) {
     // Clamp applied voltage to reasonable range
     vApplied = std::clamp(vApplied, -5.0f, 5.0f);
     
-    // Calculate forward voltage for reference
-    float Vt = m_diode.n * m_diode.Vt;
-    float Vf = Vt * std::log(1e-6f / m_diode.Is + 1.0f);  // ~0.65V for 1N4148
-    float totalZ = m_diode.Rs + m_impedance;
+    // Cached forward voltage and series impedance
+    const float Vf = m_forwardVoltage;  // ~0.65V for 1N4148
+    const float totalZ = m_totalZ;
     
     // Handle positive voltages (forward bias)
     if (vApplied > Vf * 1.5f) {
@@ -75,16 +731,42 @@ float DiodeClippingStage::solveSeriesDiodeCircuit(float vApplied) {
         return clipped;
     }
     
+    // Mid-range, closed form: the Wright-omega solution always "converges"
+    if (m_solverMode == SolverMode::WrightOmega) {
+        float vDiode, iDiode;
+        m_omegaSolver.solve(std::abs(vApplied), vDiode, iDiode);
+        float correctedVDiode = vDiode - iDiode * m_diode.Rs;
+        return vApplied < 0 ? -correctedVDiode : correctedVDiode;
+    }
+    
     // Mid-range: use Newton-Raphson solver
     DiodeNewtonRaphson::SolverConfig config;
     config.maxIterations = 25;
     config.convergenceTolerance = 1e-7f;
-    config.initialGuess = std::clamp(Vf * 0.8f, 0.1f, 0.7f);
+    config.initialGuess = initialGuess(std::clamp(Vf * 0.8f, 0.1f, 0.7f));
     
     float vDiode, iDiode;
-    int iterations = m_solver.solve(std::abs(vApplied), config, vDiode, iDiode);
+    int clampHits = 0;
+    float absApplied = std::abs(vApplied);
+    int iterations = m_solver.solve(absApplied, config, vDiode, iDiode, &clampHits);
+    
+    SolveTally tally;
+    tallySolve(tally, iterations, config.maxIterations, clampHits);
+    
+    // Same retry as solveBackToBackDiodes(): after a jump the LUT fallback
+    // below is far off, so reseed from the applied voltage instead
+    if ((iterations <= 0 || iterations >= config.maxIterations) && m_warmStart && m_hasLastSolution) {
+        seedLaneGuesses(&absApplied, 1, config.initialGuess, &config.initialGuess);
+        clampHits = 0;
+        iterations = m_solver.solve(absApplied, config, vDiode, iDiode, &clampHits);
+        tallySolve(tally, iterations, config.maxIterations, clampHits);
+    }
+    publishStats(tally);
     
     if (iterations > 0 && iterations < config.maxIterations) {
+        m_lastSolution = vDiode;
+        m_hasLastSolution = true;
+        
         // Apply voltage divider correction for impedance effect
         // V_output = V_diode - I_diode * Rs (dropping across series resistance)
         // The impedance effects the current, which affects the voltage drop
@@ -123,8 +805,8 @@ float DiodeClippingStage::solveParallelDiodeCircuit(float vApplied) {
     }
     
     // Above threshold: clipping is limited to forward voltage
-    float forwardVoltage = m_diode.n * m_diode.Vt * std::log(vApplied / m_diode.Is + 1.0f);
-    return std::clamp(forwardVoltage, 0.0f, m_diode.n * m_diode.Vt * 20.0f);
+    float forwardVoltage = m_nVt * LiveSpiceDSP::DefaultMath::log(vApplied / m_diode.Is + 1.0f);
+    return std::clamp(forwardVoltage, 0.0f, m_nVt * 20.0f);
 }
 
 /**
@@ -146,11 +828,8 @@ float DiodeClippingStage::solveBackToBackDiodes(float vApplied) {
     bool isPositive = vApplied > 0;
     float absVoltage = std::abs(vApplied);
     
-    // Thermal voltage = n * Vt (typically ~26mV for Si @ 25°C)
-    float Vt = m_diode.n * m_diode.Vt;
-    
-    // Calculate actual diode forward voltage (~0.65V for 1N4148)
-    float Vf = Vt * std::log(1e-6f / m_diode.Is + 1.0f);
+    // Cached diode forward voltage (~0.65V for 1N4148)
+    const float Vf = m_forwardVoltage;
     
     // Define clipping regions based on diode physics
     float linear_limit = Vf * 0.3f;    // ~0.2V - pass through unchanged
@@ -172,17 +851,39 @@ float DiodeClippingStage::solveBackToBackDiodes(float vApplied) {
     }
     
     // Region 3: Hard clipping region (diode forward voltage limiting)
+    if (absVoltage < hard_clipping * 1.5f && m_solverMode == SolverMode::WrightOmega) {
+        float vDiode, iDiode;
+        m_omegaSolver.solve(absVoltage, vDiode, iDiode);
+        return isPositive ? vDiode : -vDiode;
+    }
+    
     if (absVoltage < hard_clipping * 1.5f) {
         // Use Newton-Raphson for accurate forward voltage calculation
         DiodeNewtonRaphson::SolverConfig config;
         config.maxIterations = 20;
         config.convergenceTolerance = 1e-6f;
-        config.initialGuess = Vf * 0.9f;
+        config.initialGuess = initialGuess(Vf * 0.9f);
         
         float vDiode, iDiode;
-        int iterations = m_solver.solve(absVoltage, config, vDiode, iDiode);
+        int clampHits = 0;
+        int iterations = m_solver.solve(absVoltage, config, vDiode, iDiode, &clampHits);
+        
+        SolveTally tally;
+        tallySolve(tally, iterations, config.maxIterations, clampHits);
+        
+        // A warm start far from the root (signal jumped) can exhaust the
+        // damped steps; retry from the applied voltage as the block path does
+        if ((iterations <= 0 || iterations >= config.maxIterations) && m_warmStart && m_hasLastSolution) {
+            seedLaneGuesses(&absVoltage, 1, config.initialGuess, &config.initialGuess);
+            clampHits = 0;
+            iterations = m_solver.solve(absVoltage, config, vDiode, iDiode, &clampHits);
+            tallySolve(tally, iterations, config.maxIterations, clampHits);
+        }
+        publishStats(tally);
         
         if (iterations > 0 && iterations < config.maxIterations) {
+            m_lastSolution = vDiode;
+            m_hasLastSolution = true;
             return isPositive ? vDiode : -vDiode;
         }
     }
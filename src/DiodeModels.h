@@ -4,24 +4,117 @@
 #include <cmath>
 #include <array>
 #include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <cstdint>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include "MathPolicy.h"
+#include "MemoryFootprint.h"
 
 namespace Nonlinear {
 
+using LiveSpiceDSP::MemoryFootprint;
+using LiveSpiceDSP::MemoryMode;
+
+namespace detail {
+
+/**
+ * Atomic telemetry counter that copies/moves as a snapshot of its value
+ * Keeps stages holding counters movable, so they can live by value in
+ * contiguous containers. Copying is not synchronized with a concurrent
+ * writer; only do it while the audio thread is not running the stage.
+ */
+template <typename T>
+struct SnapshotAtomic : std::atomic<T> {
+    using std::atomic<T>::atomic;
+    using std::atomic<T>::operator=;
+    SnapshotAtomic(const SnapshotAtomic& other) noexcept
+        : std::atomic<T>(other.load(std::memory_order_relaxed)) {}
+    SnapshotAtomic& operator=(const SnapshotAtomic& other) noexcept {
+        this->store(other.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        return *this;
+    }
+};
+
+/**
+ * Branch-free exp() for lane loops (FastMath::exp, ~2e-7 relative)
+ * Lane kernels always use it: libm calls would keep the fixed-width
+ * loops from auto-vectorizing, whatever the build's DefaultMath.
+ */
+inline float laneExp(float x) {
+    return LiveSpiceDSP::FastMath::exp(x);
+}
+
+/**
+ * Branch-free natural log for x > 0 (~1e-4 relative)
+ * Exponent from the float bits, quartic fit for ln of the mantissa.
+ * Accurate enough as a seed for the Wright-omega Newton steps below.
+ */
+inline float laneLog(float x) {
+    x = std::max(x, 1e-30f);
+    int bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    float e = static_cast<float>(((bits >> 23) & 0xFF) - 127);
+    bits = (bits & 0x007FFFFF) | 0x3F800000;
+    float m;
+    std::memcpy(&m, &bits, sizeof(m));
+    float lnm = -1.7417939f + m * (2.8212026f + m * (-1.4699568f + m * (0.44717955f - m * 0.056570851f)));
+    return e * 0.69314718f + lnm;
+}
+
+/**
+ * Wright omega function: solves w + ln(w) = x
+ * Cubic seed on [-3.34, 8], x - ln(x) above and e^x below,
+ * refined by three Newton steps. Fixed cost, relative error < 1e-6
+ * over the diode operating range.
+ */
+inline float wrightOmega(float x) {
+    constexpr float x1 = -3.341459552768620f, x2 = 8.0f;
+    float poly = 6.313183464296682e-1f + x * (3.631952663804445e-1f + x * (4.775931364975583e-2f + x * -1.314293149877800e-3f));
+    float asym = x - laneLog(std::max(x, 1.0f));
+    float w = x < x1 ? laneExp(x) : (x < x2 ? poly : asym);
+    for (int step = 0; step < 3; ++step) {
+        w = w - (w - laneExp(x - w)) / (w + 1.0f);
+    }
+    return w;
+}
+
+}  // namespace detail
+
 struct DiodeCharacteristics {
     float Is, n, Vt, Rs, CjZero, m;
     
-    static DiodeCharacteristics Si1N4148() { return {1.4e-14f, 1.06f, 0.026f, 0.25f, 0.4e-12f, 0.4f}; }
-    static DiodeCharacteristics Si1N914() { return {2.6e-15f, 1.04f, 0.026f, 0.1f, 0.95e-12f, 0.4f}; }
-    static DiodeCharacteristics Ge_OA90() { return {5.0e-15f, 1.3f, 0.026f, 0.5f, 2.0e-12f, 0.5f}; }
-    static DiodeCharacteristics Si1N4007() { return {1.0e-14f, 1.08f, 0.026f, 0.5f, 0.8e-12f, 0.4f}; }
+    static constexpr DiodeCharacteristics Si1N4148() { return {1.4e-14f, 1.06f, 0.026f, 0.25f, 0.4e-12f, 0.4f}; }
+    static constexpr DiodeCharacteristics Si1N914() { return {2.6e-15f, 1.04f, 0.026f, 0.1f, 0.95e-12f, 0.4f}; }
+    static constexpr DiodeCharacteristics Ge_OA90() { return {5.0e-15f, 1.3f, 0.026f, 0.5f, 2.0e-12f, 0.5f}; }
+    static constexpr DiodeCharacteristics Si1N4007() { return {1.0e-14f, 1.08f, 0.026f, 0.5f, 0.8e-12f, 0.4f}; }
 };
 
+/**
+ * Tabulated Shockley current, shared between instances
+ * Stock parts use compile-time tables (DeviceTables.h); custom parts come
+ * from a process-wide cache keyed on (Is, n, Vt), so stages using the same
+ * part share one table and construction after the first instance is a
+ * map lookup.
+ */
 class DiodeLUT {
 public:
     static constexpr int LUT_SIZE = 512;
     static constexpr float VOLTAGE_MIN = -10.0f, VOLTAGE_MAX = 0.7f;
     
-    DiodeLUT(const DiodeCharacteristics& diode) : m_diode(diode) { buildLookupTable(); }
+    using CurrentTable = std::array<float, LUT_SIZE>;
+    
+    DiodeLUT(const DiodeCharacteristics& diode)
+        : m_diode(diode), m_table(acquireTable(diode)), m_currentLUT(m_table->data()) {}
+    
+    /**
+     * Read from a caller-owned static table (e.g. one emitted alongside a
+     * generated plugin) instead of acquiring one
+     */
+    DiodeLUT(const DiodeCharacteristics& diode, const CurrentTable& staticTable)
+        : m_diode(diode), m_table(std::shared_ptr<const void>(), &staticTable), m_currentLUT(staticTable.data()) {}
     
     float evaluateCurrent(float voltage) const {
         voltage = std::clamp(voltage, VOLTAGE_MIN, VOLTAGE_MAX);
@@ -38,20 +131,109 @@ public:
         return (std::abs(current) + m_diode.Is) / nVt;
     }
     
+    /**
+     * Fetch the shared table for a device; thread-safe
+     * Stock presets return their static table without locking. Custom
+     * parts are built once, held weakly and freed with their last user.
+     */
+    static std::shared_ptr<const CurrentTable> acquireTable(const DiodeCharacteristics& diode);
+    
+    /**
+     * Number of distinct runtime-built tables currently alive in the cache
+     */
+    static size_t cachedTableCount();
+    
+    const CurrentTable* getTable() const { return m_table.get(); }
+    size_t getMemoryBytes() const { return sizeof(CurrentTable); }
+    
+    /** The current table is shared (stock or cached), never owned */
+    MemoryFootprint getMemoryFootprint() const { return {sizeof(DiodeLUT), 0, sizeof(CurrentTable)}; }
+    
 private:
     DiodeCharacteristics m_diode;
-    std::array<float, LUT_SIZE> m_currentLUT;
+    std::shared_ptr<const CurrentTable> m_table;
+    const float* m_currentLUT;
     
-    void buildLookupTable() {
-        float nVt = m_diode.n * m_diode.Vt;
-        for (int i = 0; i < LUT_SIZE; ++i) {
-            float voltage = VOLTAGE_MIN + float(i) / (LUT_SIZE - 1) * (VOLTAGE_MAX - VOLTAGE_MIN);
-            float expArg = std::clamp(voltage / nVt, -20.0f, 50.0f);
-            m_currentLUT[i] = m_diode.Is * (std::exp(expArg) - 1.0f);
+    static void buildLookupTable(const DiodeCharacteristics& diode, CurrentTable& table);
+};
+
+/**
+ * Non-uniform Shockley table with cubic Hermite interpolation
+ * Breakpoints are split at the knee (-12 nVt): a handful of nodes cover the
+ * flat reverse region, the rest are spaced evenly through the knee and
+ * forward region, where even spacing gives a constant relative error on
+ * the exponential. Each node stores I and the exact dI/dV, so the
+ * interpolant is C1 and its error falls as h^4 (about (h/nVt)^4 / 384).
+ */
+class DiodeHermiteLUT {
+public:
+    static constexpr int DEFAULT_POINTS = 128;
+    
+    DiodeHermiteLUT(const DiodeCharacteristics& diode, int numPoints = DEFAULT_POINTS);
+    
+    float evaluateCurrent(float voltage) const {
+        voltage = std::clamp(voltage, DiodeLUT::VOLTAGE_MIN, DiodeLUT::VOLTAGE_MAX);
+        
+        float idx;
+        if (voltage < m_vKnee) {
+            idx = (voltage - DiodeLUT::VOLTAGE_MIN) * m_invReverseStep;
+        } else {
+            idx = m_reversePoints + (voltage - m_vKnee) * m_invForwardStep;
         }
+        int i0 = std::min(int(idx), int(m_nodes.size()) - 2);
+        const Node& a = m_nodes[i0];
+        const Node& b = m_nodes[i0 + 1];
+        
+        float h = b.v - a.v;
+        float t = (voltage - a.v) / h;
+        float t2 = t * t, t3 = t2 * t;
+        return (2.0f * t3 - 3.0f * t2 + 1.0f) * a.current + (t3 - 2.0f * t2 + t) * h * a.slope
+             + (-2.0f * t3 + 3.0f * t2) * b.current + (t3 - t2) * h * b.slope;
     }
+    
+    float evaluateConductance(float voltage) const {
+        float current = evaluateCurrent(voltage);
+        return (std::abs(current) + m_diode.Is) / (m_diode.n * m_diode.Vt);
+    }
+    
+    int getNumPoints() const { return static_cast<int>(m_nodes.size()); }
+    size_t getMemoryBytes() const { return m_nodes.size() * sizeof(Node); }
+    
+private:
+    struct Node { float v, current, slope; };
+    
+    DiodeCharacteristics m_diode;
+    std::vector<Node> m_nodes;
+    int m_reversePoints;
+    float m_vKnee, m_invReverseStep, m_invForwardStep;
+};
+
+/**
+ * Table accuracy against the exact Shockley equation (double precision)
+ * Forward error is relative to |I| + Is over 0..VOLTAGE_MAX, which stays
+ * meaningful through zero; reverse error is absolute over VOLTAGE_MIN..0,
+ * normalised to Is.
+ */
+struct LUTAccuracy {
+    size_t memoryBytes;
+    double maxForwardRelError;
+    double maxReverseError;
 };
 
+template <typename LUT>
+LUTAccuracy measureLUTAccuracy(const LUT& lut, const DiodeCharacteristics& diode, int numSamples = 20000) {
+    LUTAccuracy result{lut.getMemoryBytes(), 0.0, 0.0};
+    const double nVt = double(diode.n) * diode.Vt;
+    for (int i = 0; i <= numSamples; ++i) {
+        float v = DiodeLUT::VOLTAGE_MIN + (DiodeLUT::VOLTAGE_MAX - DiodeLUT::VOLTAGE_MIN) * float(i) / numSamples;
+        double exact = diode.Is * std::expm1(v / nVt);
+        double err = std::abs(lut.evaluateCurrent(v) - exact);
+        if (v > 0.0f) result.maxForwardRelError = std::max(result.maxForwardRelError, err / (exact + diode.Is));
+        else result.maxReverseError = std::max(result.maxReverseError, err / diode.Is);
+    }
+    return result;
+}
+
 class DiodeNewtonRaphson {
 public:
     struct SolverConfig {
@@ -60,15 +242,27 @@ public:
         float initialGuess = 0.3f;
     };
     
+    // Lane width of the lockstep solver (one AVX2 register of floats)
+    static constexpr int SIMD_LANES = 8;
+    
     DiodeNewtonRaphson(const DiodeCharacteristics& diode) : m_diode(diode) {}
     
-    int solve(float vApplied, const SolverConfig& config, float& outVoltage, float& outCurrent) const {
+    /**
+     * Solve for the diode voltage at vApplied
+     * Returns iterations used (maxIterations if not converged, 0 on a singular
+     * Jacobian). If clampHits is given, it is incremented each time a step is
+     * pulled back into the [-0.5, 1.0] V safety range.
+     * Math selects the exp() implementation (see MathPolicy.h).
+     */
+    template <typename Math = LiveSpiceDSP::DefaultMath>
+    int solve(float vApplied, const SolverConfig& config, float& outVoltage, float& outCurrent,
+              int* clampHits = nullptr) const {
         float vDiode = config.initialGuess;
         float nVt = m_diode.n * m_diode.Vt;
         
         for (int iter = 0; iter < config.maxIterations; ++iter) {
             float expArg = std::clamp(vDiode / nVt, -100.0f, 50.0f);
-            float current = m_diode.Is * (std::exp(expArg) - 1.0f);
+            float current = m_diode.Is * (Math::exp(expArg) - 1.0f);
             float residual = vDiode + current * m_diode.Rs - vApplied;
             
             if (std::abs(residual) < config.convergenceTolerance) {
@@ -77,32 +271,198 @@ public:
                 return iter + 1;
             }
             
-            float dI_dV = (m_diode.Is / nVt) * std::exp(expArg);
+            float dI_dV = (m_diode.Is / nVt) * Math::exp(expArg);
             float jacobian = 1.0f + dI_dV * m_diode.Rs;
             
             if (std::abs(jacobian) < 1e-12f) return 0;
             
             float damping = 0.5f;
-            vDiode = vDiode - damping * residual / jacobian;
-            vDiode = std::clamp(vDiode, -0.5f, 1.0f);
+            float vNext = vDiode - damping * residual / jacobian;
+            vDiode = std::clamp(vNext, -0.5f, 1.0f);
+            if (clampHits && vDiode != vNext) ++(*clampHits);
         }
         
         float expArg = std::clamp(vDiode / nVt, -100.0f, 50.0f);
-        outCurrent = m_diode.Is * (std::exp(expArg) - 1.0f);
+        outCurrent = m_diode.Is * (Math::exp(expArg) - 1.0f);
         outVoltage = vDiode;
         return config.maxIterations;
     }
     
+    /**
+     * Solve up to SIMD_LANES independent operating points in lockstep
+     * Same iteration as solve(), but each lane carries its own convergence
+     * mask; converged lanes are frozen and the loop exits once all are done.
+     * outIterations follows solve(): iterations used, or maxIterations if the
+     * lane did not converge.
+     */
+    void solveLanes(const float* vApplied, const float* initialGuess, int numLanes,
+                    const SolverConfig& config, float* outVoltage, float* outCurrent,
+                    int* outIterations, int* clampHits = nullptr) const;
+    
+    /**
+     * Solve numPoints operating points, SIMD_LANES at a time
+     * Every point starts from config.initialGuess.
+     */
+    void solveBlock(const float* vApplied, size_t numPoints, const SolverConfig& config,
+                    float* outVoltage, float* outCurrent, int* outIterations) const;
+    
+private:
+    DiodeCharacteristics m_diode;
+};
+
+/**
+ * Closed-form solver for the same equation as DiodeNewtonRaphson:
+ *   V + Is*(exp(V/(n*Vt)) - 1)*Rs = V_applied
+ * Explicit solution via the Wright omega function:
+ *   I = (n*Vt/Rs) * omega(ln(Is*Rs/(n*Vt)) + (V_applied + Is*Rs)/(n*Vt)) - Is
+ * Fixed cost per call; DiodeNewtonRaphson stays the reference.
+ */
+class DiodeWrightOmega {
+public:
+    DiodeWrightOmega(const DiodeCharacteristics& diode) : m_diode(diode) {
+        m_nVt = diode.n * diode.Vt;
+        m_invNVt = 1.0f / m_nVt;
+        m_IsRs = diode.Is * diode.Rs;
+        m_logK = diode.Rs > 0.0f ? std::log(m_IsRs * m_invNVt) + m_IsRs * m_invNVt : 0.0f;
+    }
+    
+    void solve(float vApplied, float& outVoltage, float& outCurrent) const {
+        if (m_diode.Rs <= 0.0f) {
+            // No series resistance: the diode takes the full applied voltage
+            outVoltage = vApplied;
+            outCurrent = m_diode.Is * (detail::laneExp(vApplied * m_invNVt) - 1.0f);
+            return;
+        }
+        
+        float w = detail::wrightOmega(m_logK + vApplied * m_invNVt);
+        outVoltage = vApplied + m_IsRs - m_nVt * w;
+        outCurrent = (vApplied - outVoltage) / m_diode.Rs;
+    }
+    
 private:
     DiodeCharacteristics m_diode;
+    float m_nVt = 0.0f;
+    float m_invNVt = 0.0f;
+    float m_IsRs = 0.0f;
+    float m_logK = 0.0f;  // ln(Is*Rs/nVt) + Is*Rs/nVt
+};
+
+/**
+ * Tabulated antiderivatives of a static transfer curve, for ADAA
+ * Stores f, F1 = integral of f and F2 = integral of F1 on a uniform grid
+ * over [-range, range]. F1 and F2 use cubic Hermite interpolation with the
+ * lower-order table as the slope. Beyond the grid, f is held at its edge
+ * value and F1/F2 are extended analytically.
+ */
+class AntiderivativeTable {
+public:
+    static constexpr int TABLE_SIZE = 4097;
+    
+    template <typename TransferFn>
+    AntiderivativeTable(TransferFn&& transfer, double range = 5.0)
+        : m_range(range), m_step(2.0 * range / (TABLE_SIZE - 1)),
+          m_f(TABLE_SIZE), m_F1(TABLE_SIZE), m_F2(TABLE_SIZE) {
+        for (int i = 0; i < TABLE_SIZE; ++i) {
+            m_f[i] = transfer(static_cast<float>(gridPoint(i)));
+        }
+        
+        // Simpson for F1 (midpoint sampled), Hermite-exact quadrature for F2
+        m_F1[0] = 0.0;
+        for (int i = 1; i < TABLE_SIZE; ++i) {
+            double mid = transfer(static_cast<float>(gridPoint(i) - 0.5 * m_step));
+            m_F1[i] = m_F1[i - 1] + m_step / 6.0 * (m_f[i - 1] + 4.0 * mid + m_f[i]);
+        }
+        anchorAtCenter(m_F1);
+        
+        m_F2[0] = 0.0;
+        for (int i = 1; i < TABLE_SIZE; ++i) {
+            m_F2[i] = m_F2[i - 1] + m_step * 0.5 * (m_F1[i - 1] + m_F1[i])
+                    + m_step * m_step / 12.0 * (m_f[i - 1] - m_f[i]);
+        }
+        anchorAtCenter(m_F2);
+    }
+    
+    double evaluate(double x) const {
+        if (x <= -m_range) return m_f.front();
+        if (x >= m_range) return m_f.back();
+        double t = (x + m_range) / m_step;
+        int i = std::min(static_cast<int>(t), TABLE_SIZE - 2);
+        double frac = t - i;
+        return m_f[i] + frac * (m_f[i + 1] - m_f[i]);
+    }
+    
+    double evaluateF1(double x) const {
+        if (x <= -m_range) return m_F1.front() + m_f.front() * (x + m_range);
+        if (x >= m_range) return m_F1.back() + m_f.back() * (x - m_range);
+        return hermite(m_F1, m_f, x);
+    }
+    
+    double evaluateF2(double x) const {
+        if (x <= -m_range) {
+            double d = x + m_range;
+            return m_F2.front() + m_F1.front() * d + 0.5 * m_f.front() * d * d;
+        }
+        if (x >= m_range) {
+            double d = x - m_range;
+            return m_F2.back() + m_F1.back() * d + 0.5 * m_f.back() * d * d;
+        }
+        return hermite(m_F2, m_F1, x);
+    }
+    
+    size_t getMemoryBytes() const {
+        return sizeof(AntiderivativeTable) + (m_f.capacity() + m_F1.capacity() + m_F2.capacity()) * sizeof(double);
+    }
+    
+private:
+    double m_range;
+    double m_step;
+    std::vector<double> m_f, m_F1, m_F2;
+    
+    double gridPoint(int i) const { return -m_range + i * m_step; }
+    
+    // Keep magnitudes small around 0 V, where ADAA differences are taken
+    static void anchorAtCenter(std::vector<double>& table) {
+        double offset = table[TABLE_SIZE / 2];
+        for (double& value : table) value -= offset;
+    }
+    
+    double hermite(const std::vector<double>& value, const std::vector<double>& slope, double x) const {
+        double t = (x + m_range) / m_step;
+        int i = std::min(static_cast<int>(t), TABLE_SIZE - 2);
+        double u = t - i;
+        double u2 = u * u, u3 = u2 * u;
+        return (2.0 * u3 - 3.0 * u2 + 1.0) * value[i] + (u3 - 2.0 * u2 + u) * m_step * slope[i]
+             + (-2.0 * u3 + 3.0 * u2) * value[i + 1] + (u3 - u2) * m_step * slope[i + 1];
+    }
 };
 
 class DiodeClippingStage {
 public:
     enum class TopologyType { SeriesDiode, ParallelDiode, BackToBackDiodes, BridgeClipping };
     
-    DiodeClippingStage(const DiodeCharacteristics& diode, TopologyType t = TopologyType::BackToBackDiodes, float r = 10000.0f)
-        : m_topology(t), m_impedance(r), m_diode(diode), m_lut(diode), m_solver(diode) {}
+    // Solver used for the implicit Series / BackToBack regions
+    enum class SolverMode { NewtonRaphson, WrightOmega };
+    
+    // Antiderivative anti-aliasing order
+    enum class AntiAliasingMode { None, ADAA1, ADAA2 };
+    
+    /**
+     * MemoryMode::Compact takes ADAA tables from a process-wide cache keyed
+     * on diode, topology, solver and load, so stages at the same settings
+     * share one table instead of each building its own
+     */
+    DiodeClippingStage(const DiodeCharacteristics& diode, TopologyType t = TopologyType::BackToBackDiodes, float r = 10000.0f,
+                       MemoryMode memoryMode = MemoryMode::Standard)
+        : m_topology(t), m_impedance(r), m_diode(diode), m_lut(diode), m_solver(diode), m_omegaSolver(diode),
+          m_memoryMode(memoryMode), m_requestedImpedance(r), m_builtImpedance(r) { updateCachedConstants(); }
+    
+    /**
+     * Same, with the current table supplied by the caller (static storage)
+     */
+    DiodeClippingStage(const DiodeCharacteristics& diode, TopologyType t, float r, const DiodeLUT::CurrentTable& table,
+                       MemoryMode memoryMode = MemoryMode::Standard)
+        : m_topology(t), m_impedance(r), m_diode(diode), m_lut(diode, table), m_solver(diode), m_omegaSolver(diode),
+          m_memoryMode(memoryMode), m_requestedImpedance(r), m_builtImpedance(r) { updateCachedConstants(); }
     
     /**
      * Process sample through diode clipping stage
@@ -110,28 +470,227 @@ public:
      */
     float processSample(float inputSample);
     
+    /**
+     * Process a block of samples (topology resolved once per block)
+     * Output must not partially overlap input; in == out is allowed
+     */
+    void processBlock(const float* input, float* output, size_t numSamples);
+    
+    /**
+     * Process a block of samples in place
+     */
+    void processBlock(float* data, size_t numSamples) { processBlock(data, data, numSamples); }
+    
     /**
      * Set the load impedance (affects clipping behavior)
      */
-    void setLoadImpedance(float ohms) { m_impedance = ohms; }
+    void setLoadImpedance(float ohms) {
+        m_impedance = ohms;
+        m_requestedImpedance.store(ohms, std::memory_order_relaxed);
+        updateCachedConstants();
+        if (m_antiAliasing != AntiAliasingMode::None) setAntiAliasingMode(m_antiAliasing);
+    }
+    
+    /**
+     * Change the load while the stage is running (real-time safe)
+     * Without ADAA the load applies at the next block. With ADAA the
+     * old load and table stay in use until rebuildTables() has built the
+     * new table off the audio thread; the stage then switches at a block
+     * boundary and crossfades the two tables over TABLE_CROSSFADE samples.
+     */
+    void requestLoadImpedance(float ohms) { m_requestedImpedance.store(ohms, std::memory_order_relaxed); }
+    
+    /**
+     * True while a requested load still needs its table built
+     */
+    bool needsTableRebuild() const {
+        return m_antiAliasing != AntiAliasingMode::None
+            && m_requestedImpedance.load(std::memory_order_relaxed) != m_builtImpedance.load(std::memory_order_relaxed);
+    }
+    
+    /**
+     * Build and publish the table for the requested load (builder thread,
+     * one at a time). False if the audio thread has not finished with the
+     * previously published table; try again later.
+     * Diode, topology, solver and ADAA mode must not change meanwhile.
+     */
+    bool rebuildTables();
+    
+    static constexpr int TABLE_CROSSFADE = 64;
+    
+    float getLoadImpedance() const { return m_impedance; }
     
     /**
      * Get the soft clipping threshold voltage
      * For back-to-back diodes, soft clipping starts at ~0.7 * forward voltage
      */
     float getThresholdVoltage() const {
-        // Calculate actual diode forward voltage
-        float Vt = m_diode.n * m_diode.Vt;
-        float Vf = Vt * std::log(1e-6f / m_diode.Is + 1.0f);  // ~0.65V for 1N4148
-        return Vf * 0.7f;  // Soft clipping starts at 70% of forward voltage
+        return m_forwardVoltage * 0.7f;  // Soft clipping starts at 70% of forward voltage
+    }
+    
+    /**
+     * Select iterative Newton-Raphson (default) or the closed-form
+     * Wright-omega solver, which has a fixed, branch-free cost per sample
+     */
+    void setSolverMode(SolverMode mode) {
+        m_solverMode = mode;
+        if (m_antiAliasing != AntiAliasingMode::None) setAntiAliasingMode(m_antiAliasing);
+    }
+    SolverMode getSolverMode() const { return m_solverMode; }
+    
+    /**
+     * Knee voltage used by the region split: n Vt ln(1 uA / Is + 1)
+     */
+    float getForwardVoltage() const { return m_forwardVoltage; }
+    
+    /**
+     * Enable first- or second-order antiderivative anti-aliasing
+     * Tabulates the stage's static curve and its antiderivatives for the
+     * current diode, topology and load (not real-time safe: allocates).
+     * ADAA1 adds a half-sample delay, ADAA2 a full sample.
+     */
+    void setAntiAliasingMode(AntiAliasingMode mode);
+    AntiAliasingMode getAntiAliasingMode() const { return m_antiAliasing; }
+    float getAntiAliasingDelay() const {
+        return m_antiAliasing == AntiAliasingMode::ADAA1 ? 0.5f
+             : m_antiAliasing == AntiAliasingMode::ADAA2 ? 1.0f : 0.0f;
     }
     
+    /**
+     * Seed Newton-Raphson with the previous sample's converged voltage
+     * Enabled by default; smooth audio then converges in a few iterations.
+     */
+    void setWarmStart(bool enabled) { m_warmStart = enabled; m_hasLastSolution = false; }
+    bool isWarmStartEnabled() const { return m_warmStart; }
+    
+    /**
+     * Clear solver history (warm-start voltage, ADAA input history);
+     * call on transport reset
+     */
+    void reset() {
+        m_hasLastSolution = false;
+        m_adaaX1 = m_adaaX2 = 0.0;
+        m_adaaD1 = 0.0;
+    }
+    
+    /**
+     * Newton-Raphson telemetry snapshot
+     */
+    struct SolverStats {
+        uint64_t solves = 0;           // Newton-Raphson invocations
+        uint64_t totalIterations = 0;  // Sum of iterations over all solves
+        uint32_t maxIterations = 0;    // Worst single solve
+        uint64_t nonConverged = 0;     // Solves that hit maxIterations
+        uint64_t clampHits = 0;        // Steps pulled back into the safety range
+        
+        float meanIterations() const {
+            return solves > 0 ? static_cast<float>(totalIterations) / static_cast<float>(solves) : 0.0f;
+        }
+    };
+    
+    /**
+     * Read solver counters; lock-free, safe from any thread while audio runs
+     */
+    SolverStats getSolverStats() const;
+    
+    /**
+     * Request a counter reset; applied by the audio thread on its next update
+     */
+    void resetSolverStats() { m_statsResetRequested.store(true, std::memory_order_relaxed); }
+    
+    MemoryMode getMemoryMode() const { return m_memoryMode; }
+    
+    /**
+     * Object, owned ADAA tables (Standard) and shared tables (current
+     * table; ADAA tables in Compact). Call while the stage is not being
+     * rebuilt.
+     */
+    MemoryFootprint getMemoryFootprint() const;
+    
+    /**
+     * Number of shared ADAA tables currently alive (Compact stages)
+     */
+    static size_t cachedAntiderivativeTableCount();
+    
 private:
     TopologyType m_topology;
     float m_impedance;
     DiodeCharacteristics m_diode;
     DiodeLUT m_lut;
     DiodeNewtonRaphson m_solver;
+    DiodeWrightOmega m_omegaSolver;
+    SolverMode m_solverMode = SolverMode::NewtonRaphson;
+    MemoryMode m_memoryMode;
+    
+    // Per-diode constants, recomputed only when the diode or load changes
+    float m_nVt = 0.0f;            // n * Vt
+    float m_forwardVoltage = 0.0f; // Vf at 1mA-ish knee (~0.65V for 1N4148)
+    float m_totalZ = 0.0f;         // Rs + load impedance
+    
+    // Warm start: last converged |V_diode| from the per-sample Newton-Raphson
+    // regions (the block paths seed each lane from its applied voltage)
+    bool m_warmStart = true;
+    bool m_hasLastSolution = false;
+    float m_lastSolution = 0.0f;
+    
+    // ADAA: antiderivative table (owned, or shared in compact mode) plus input history
+    AntiAliasingMode m_antiAliasing = AntiAliasingMode::None;
+    std::shared_ptr<const AntiderivativeTable> m_adaaTable;
+    double m_adaaX1 = 0.0, m_adaaX2 = 0.0;  // x[n-1], x[n-2]
+    double m_adaaD1 = 0.0;                  // ADAA2 first divided difference at n-1
+    
+    // Background table swap. Idle: builder may replace m_pendingTable (the
+    // retired table, freed there rather than on the audio thread).
+    // Published: m_pendingTable is the next table. Fading: the audio thread
+    // is crossfading out of the old table held in m_pendingTable.
+    enum TableState { TABLE_IDLE, TABLE_PUBLISHED, TABLE_FADING };
+    detail::SnapshotAtomic<float> m_requestedImpedance{0.0f};
+    detail::SnapshotAtomic<float> m_builtImpedance{0.0f};
+    detail::SnapshotAtomic<int> m_tableState{TABLE_IDLE};
+    std::shared_ptr<const AntiderivativeTable> m_pendingTable;
+    float m_pendingImpedance = 0.0f;
+    int m_fadeRemaining = 0;
+    double m_fadeD1 = 0.0;                  // ADAA2 history against the outgoing table
+    
+    std::shared_ptr<const AntiderivativeTable> buildAntiderivativeTable(float ohms) const;
+    std::shared_ptr<const AntiderivativeTable> acquireAntiderivativeTable(float ohms) const;
+    void applyPendingLoad();
+    double antiAliased(const AntiderivativeTable& table, double x0, double& d1) const;
+    float processAntiAliased(float x);
+    
+    float initialGuess(float coldGuess) const {
+        return (m_warmStart && m_hasLastSolution) ? m_lastSolution : coldGuess;
+    }
+    
+    void seedLaneGuesses(const float* absApplied, int lanes, float coldGuess, float* guess) const;
+    
+    // Counters written only by the audio thread (relaxed load/store, no RMW)
+    struct SolveTally {
+        uint64_t solves = 0;
+        uint64_t totalIterations = 0;
+        uint32_t maxIterations = 0;
+        uint64_t nonConverged = 0;
+        uint64_t clampHits = 0;
+    };
+    detail::SnapshotAtomic<uint64_t> m_statSolves{0};
+    detail::SnapshotAtomic<uint64_t> m_statTotalIterations{0};
+    detail::SnapshotAtomic<uint32_t> m_statMaxIterations{0};
+    detail::SnapshotAtomic<uint64_t> m_statNonConverged{0};
+    detail::SnapshotAtomic<uint64_t> m_statClampHits{0};
+    detail::SnapshotAtomic<bool> m_statsResetRequested{false};
+    
+    static void tallySolve(SolveTally& tally, int iterations, int maxIterations, int clampHits);
+    void publishStats(const SolveTally& tally);
+    
+    void updateCachedConstants() {
+        m_nVt = m_diode.n * m_diode.Vt;
+        m_forwardVoltage = m_nVt * std::log(1e-6f / m_diode.Is + 1.0f);
+        m_totalZ = m_diode.Rs + m_impedance;
+    }
+    
+    // Block helpers: gather Newton-Raphson samples and solve them in lanes
+    void processSeriesBlockLanes(const float* input, float* output, size_t numSamples);
+    void processBackToBackBlockLanes(const float* input, float* output, size_t numSamples);
     
     // Helper: solve circuit equation for series diode configuration
     float solveSeriesDiodeCircuit(float vApplied);
@@ -0,0 +1,309 @@
+#include "JsonRpc.h"
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <istream>
+#include <ostream>
+
+namespace LiveSpice {
+
+namespace {
+
+    constexpr int MAX_DEPTH = 64;
+
+    class Parser {
+    public:
+        explicit Parser(std::string_view text) : pos(text.data()), end(text.data() + text.size()) {}
+
+        bool document(Json::Value& out) {
+            if (!value(out, 0)) return false;
+            skipSpace();
+            return pos == end || fail("trailing characters");
+        }
+
+        std::string error;
+
+    private:
+        const char* pos;
+        const char* end;
+
+        bool fail(const char* message) {
+            if (error.empty()) error = message;
+            return false;
+        }
+
+        void skipSpace() {
+            while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\n' || *pos == '\r')) ++pos;
+        }
+
+        bool literal(std::string_view word) {
+            if (static_cast<size_t>(end - pos) < word.size() || std::string_view(pos, word.size()) != word) {
+                return fail("invalid literal");
+            }
+            pos += word.size();
+            return true;
+        }
+
+        bool value(Json::Value& out, int depth) {
+            if (depth > MAX_DEPTH) return fail("nesting too deep");
+            skipSpace();
+            if (pos == end) return fail("unexpected end of input");
+
+            switch (*pos) {
+                case '{': return object(out, depth);
+                case '[': return array(out, depth);
+                case '"': out.type = Json::Value::Type::String; return string(out.string);
+                case 't': out.type = Json::Value::Type::Bool; out.boolean = true; return literal("true");
+                case 'f': out.type = Json::Value::Type::Bool; out.boolean = false; return literal("false");
+                case 'n': out.type = Json::Value::Type::Null; return literal("null");
+                default: return number(out);
+            }
+        }
+
+        bool object(Json::Value& out, int depth) {
+            out.type = Json::Value::Type::Object;
+            ++pos;
+            skipSpace();
+            if (pos < end && *pos == '}') { ++pos; return true; }
+            while (true) {
+                skipSpace();
+                if (pos == end || *pos != '"') return fail("expected member name");
+                std::string key;
+                if (!string(key)) return false;
+                skipSpace();
+                if (pos == end || *pos != ':') return fail("expected ':'");
+                ++pos;
+                Json::Value member;
+                if (!value(member, depth + 1)) return false;
+                out.members.emplace_back(std::move(key), std::move(member));
+                skipSpace();
+                if (pos < end && *pos == ',') { ++pos; continue; }
+                if (pos < end && *pos == '}') { ++pos; return true; }
+                return fail("expected ',' or '}'");
+            }
+        }
+
+        bool array(Json::Value& out, int depth) {
+            out.type = Json::Value::Type::Array;
+            ++pos;
+            skipSpace();
+            if (pos < end && *pos == ']') { ++pos; return true; }
+            while (true) {
+                Json::Value item;
+                if (!value(item, depth + 1)) return false;
+                out.items.push_back(std::move(item));
+                skipSpace();
+                if (pos < end && *pos == ',') { ++pos; continue; }
+                if (pos < end && *pos == ']') { ++pos; return true; }
+                return fail("expected ',' or ']'");
+            }
+        }
+
+        bool number(Json::Value& out) {
+            out.type = Json::Value::Type::Number;
+            auto result = std::from_chars(pos, end, out.number);
+            if (result.ec != std::errc() || result.ptr == pos) return fail("invalid value");
+            pos = result.ptr;
+            return true;
+        }
+
+        bool hex4(uint32_t& code) {
+            if (end - pos < 4) return fail("truncated \\u escape");
+            code = 0;
+            for (int i = 0; i < 4; ++i) {
+                char c = *pos++;
+                code <<= 4;
+                if (c >= '0' && c <= '9') code |= static_cast<uint32_t>(c - '0');
+                else if (c >= 'a' && c <= 'f') code |= static_cast<uint32_t>(c - 'a' + 10);
+                else if (c >= 'A' && c <= 'F') code |= static_cast<uint32_t>(c - 'A' + 10);
+                else return fail("invalid \\u escape");
+            }
+            return true;
+        }
+
+        static void appendUtf8(std::string& out, uint32_t code) {
+            if (code < 0x80) {
+                out += static_cast<char>(code);
+            } else if (code < 0x800) {
+                out += static_cast<char>(0xC0 | (code >> 6));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            } else if (code < 0x10000) {
+                out += static_cast<char>(0xE0 | (code >> 12));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            } else {
+                out += static_cast<char>(0xF0 | (code >> 18));
+                out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+        }
+
+        bool string(std::string& out) {
+            ++pos;  // opening quote
+            while (pos < end) {
+                char c = *pos++;
+                if (c == '"') return true;
+                if (static_cast<unsigned char>(c) < 0x20) return fail("control character in string");
+                if (c != '\\') {
+                    out += c;
+                    continue;
+                }
+                if (pos == end) break;
+                switch (*pos++) {
+                    case '"':  out += '"'; break;
+                    case '\\': out += '\\'; break;
+                    case '/':  out += '/'; break;
+                    case 'b':  out += '\b'; break;
+                    case 'f':  out += '\f'; break;
+                    case 'n':  out += '\n'; break;
+                    case 'r':  out += '\r'; break;
+                    case 't':  out += '\t'; break;
+                    case 'u': {
+                        uint32_t code;
+                        if (!hex4(code)) return false;
+                        if (code >= 0xD800 && code < 0xDC00) {
+                            uint32_t low;
+                            if (end - pos < 2 || pos[0] != '\\' || pos[1] != 'u') return fail("unpaired surrogate");
+                            pos += 2;
+                            if (!hex4(low) || low < 0xDC00 || low > 0xDFFF) return fail("unpaired surrogate");
+                            code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        }
+                        appendUtf8(out, code);
+                        break;
+                    }
+                    default: return fail("invalid escape");
+                }
+            }
+            return fail("unterminated string");
+        }
+    };
+
+    std::string encodeId(const Json::Value& id) {
+        switch (id.type) {
+            case Json::Value::Type::String: return Json::quote(id.string);
+            case Json::Value::Type::Number: {
+                char text[32];
+                if (std::floor(id.number) == id.number && std::abs(id.number) < 1e15) {
+                    std::snprintf(text, sizeof(text), "%.0f", id.number);
+                } else {
+                    std::snprintf(text, sizeof(text), "%.17g", id.number);
+                }
+                return text;
+            }
+            default: return "null";
+        }
+    }
+
+    std::string errorResponse(const std::string& id, int code, const std::string& message) {
+        return "{\"jsonrpc\":\"2.0\",\"id\":" + id + ",\"error\":{\"code\":" + std::to_string(code) +
+               ",\"message\":" + Json::quote(message) + "}}";
+    }
+
+} // namespace
+
+    // ============================================================================
+    // Json Implementation
+    // ============================================================================
+
+    const Json::Value* Json::Value::find(std::string_view key) const {
+        if (type != Type::Object) return nullptr;
+        for (const auto& member : members) {
+            if (member.first == key) return &member.second;
+        }
+        return nullptr;
+    }
+
+    bool Json::parse(std::string_view text, Value& out, std::string* error) {
+        Parser parser(text);
+        out = Value();
+        if (parser.document(out)) return true;
+        if (error) *error = parser.error;
+        return false;
+    }
+
+    std::string Json::quote(std::string_view text) {
+        std::string out = "\"";
+        out.reserve(text.size() + 2);
+        for (char c : text) {
+            switch (c) {
+                case '"':  out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                        out += escaped;
+                    } else {
+                        out += c;
+                    }
+            }
+        }
+        return out + "\"";
+    }
+
+    // ============================================================================
+    // JsonRpcServer Implementation
+    // ============================================================================
+
+    JsonRpcServer::JsonRpcServer() {
+        addMethod("shutdown", [this](const Json::Value&) {
+            stopping = true;
+            return std::string("null");
+        });
+    }
+
+    void JsonRpcServer::addMethod(const std::string& name, Method method) {
+        methods[name] = std::move(method);
+    }
+
+    std::string JsonRpcServer::handle(std::string_view line) {
+        Json::Value request;
+        std::string parseError;
+        if (!Json::parse(line, request, &parseError)) {
+            return errorResponse("null", PARSE_ERROR, "Parse error: " + parseError);
+        }
+
+        const Json::Value* id = request.find("id");
+        const std::string idText = id ? encodeId(*id) : "null";
+        const Json::Value* method = request.find("method");
+        if (!request.isObject() || !method || method->type != Json::Value::Type::String) {
+            return errorResponse(idText, INVALID_REQUEST, "Invalid request");
+        }
+
+        std::string result;
+        auto it = methods.find(method->string);
+        if (it == methods.end()) {
+            return id ? errorResponse(idText, METHOD_NOT_FOUND, "Method not found: " + method->string) : "";
+        }
+        try {
+            static const Json::Value noParams;
+            const Json::Value* params = request.find("params");
+            result = it->second(params ? *params : noParams);
+        } catch (const Error& e) {
+            return id ? errorResponse(idText, e.code, e.what()) : "";
+        } catch (const std::exception& e) {
+            return id ? errorResponse(idText, SERVER_ERROR, e.what()) : "";
+        }
+
+        if (!id) return "";
+        return "{\"jsonrpc\":\"2.0\",\"id\":" + idText + ",\"result\":" + result + "}";
+    }
+
+    void JsonRpcServer::serve(std::istream& in, std::ostream& out) {
+        std::string line;
+        while (!stopping && std::getline(in, line)) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+            std::string response = handle(line);
+            if (!response.empty()) {
+                out << response << '\n';
+                out.flush();
+            }
+        }
+    }
+
+} // namespace LiveSpice
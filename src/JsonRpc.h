@@ -0,0 +1,105 @@
+#pragma once
+
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace LiveSpice {
+
+    // ============================================================================
+    // Minimal JSON values
+    // ============================================================================
+
+    namespace Json {
+
+        /**
+         * Parsed JSON value. Objects keep their members in source order.
+         */
+        struct Value {
+            enum class Type { Null, Bool, Number, String, Array, Object };
+
+            Type type = Type::Null;
+            bool boolean = false;
+            double number = 0.0;
+            std::string string;
+            std::vector<Value> items;
+            std::vector<std::pair<std::string, Value>> members;
+
+            bool isObject() const { return type == Type::Object; }
+
+            /** Member lookup; nullptr when absent or not an object */
+            const Value* find(std::string_view key) const;
+
+            std::string asString(const std::string& fallback = {}) const {
+                return type == Type::String ? string : fallback;
+            }
+            double asNumber(double fallback = 0.0) const {
+                return type == Type::Number ? number : fallback;
+            }
+            bool asBool(bool fallback = false) const {
+                return type == Type::Bool ? boolean : fallback;
+            }
+        };
+
+        /** Parse a complete document; false (with error set) on malformed input */
+        bool parse(std::string_view text, Value& out, std::string* error = nullptr);
+
+        /** Quote and escape text as a JSON string literal */
+        std::string quote(std::string_view text);
+
+    } // namespace Json
+
+    // ============================================================================
+    // JSON-RPC 2.0 over line-delimited streams
+    // ============================================================================
+
+    /**
+     * Line-delimited JSON-RPC 2.0 server: one request object per input line,
+     * one response object per output line. Methods receive the params value
+     * and return their result already encoded as JSON. A method reports a
+     * client error by throwing JsonRpcServer::Error; any other exception
+     * becomes a server error (-32000). The built-in "shutdown" method ends
+     * serve() after its response is written.
+     */
+    class JsonRpcServer {
+    public:
+        static constexpr int PARSE_ERROR = -32700;
+        static constexpr int INVALID_REQUEST = -32600;
+        static constexpr int METHOD_NOT_FOUND = -32601;
+        static constexpr int INVALID_PARAMS = -32602;
+        static constexpr int SERVER_ERROR = -32000;
+
+        struct Error : std::runtime_error {
+            Error(int code, const std::string& message) : std::runtime_error(message), code(code) {}
+            int code;
+        };
+
+        using Method = std::function<std::string(const Json::Value& params)>;
+
+        JsonRpcServer();
+
+        void addMethod(const std::string& name, Method method);
+
+        /**
+         * Answer requests until end of input or "shutdown"
+         */
+        void serve(std::istream& in, std::ostream& out);
+
+        /**
+         * Answer one request line; empty for notifications (no "id")
+         */
+        std::string handle(std::string_view line);
+
+        bool isStopping() const { return stopping; }
+
+    private:
+        std::map<std::string, Method> methods;
+        bool stopping = false;
+    };
+
+} // namespace LiveSpice
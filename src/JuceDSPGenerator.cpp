@@ -1,9 +1,20 @@
 #include "JuceDSPGenerator.h"
+#include "CodeEmitter.h"
+#include "DiodeModels.h"
+#include "DKMethod.h"
+#include "NetlistCache.h"
+#include "SubcircuitTable.h"
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
+#include <initializer_list>
 #include <map>
 #include <set>
+#include <stdexcept>
+#include <thread>
 #include <cctype>
+#include <cmath>
+#include <cstdlib>
 
 namespace LiveSpice {
 
@@ -18,12 +29,14 @@ namespace LiveSpice {
             std::string componentName;
             std::string memberName;
             std::string partNumber;
+            std::string stageType;   // Compile-time specialized stage
         };
         
         struct FETMemberSpec {
             std::string componentName;
             std::string memberName;
             std::string partNumber;
+            std::string stageType;
         };
 
         std::string makeSafeIdentifier(const std::string& input) {
@@ -100,13 +113,24 @@ namespace LiveSpice {
                     }
 
                     std::string partNumber = nonlinear.partNumber.empty() ? "2N3904" : nonlinear.partNumber;
-                    members.push_back({nonlinear.name, memberName, partNumber});
+                    std::string stageType = std::string("Nonlinear::TransistorClippingStageT<Nonlinear::BJTPolarity::")
+                                          + (nonlinear.isPNP ? "PNP" : "NPN") + ">";
+                    members.push_back({nonlinear.name, memberName, partNumber, stageType});
                 }
             }
 
             return members;
         }
         
+        std::string diodeTableName(const std::string& partNumber) {
+            // Part numbers often start with a digit; the prefix already makes a valid identifier
+            std::string id = makeSafeIdentifier(partNumber);
+            if (id.front() == '_') {
+                id.erase(0, 1);
+            }
+            return "kDiodeTable_" + id;
+        }
+
         std::vector<FETMemberSpec> collectFETMembers(const std::vector<CircuitStage>& stages) {
             std::vector<FETMemberSpec> members;
             std::set<std::string> usedNames;
@@ -130,7 +154,11 @@ namespace LiveSpice {
                     }
 
                     std::string partNumber = nonlinear.partNumber.empty() ? "2N7000" : nonlinear.partNumber;
-                    members.push_back({nonlinear.name, memberName, partNumber});
+                    // Depletion devices (Vto < 0) are JFETs
+                    const char* channel = nonlinear.isPNP ? "PMOS" : (nonlinear.fetChar->Vto < 0.0f ? "JFET" : "NMOS");
+                    std::string stageType = std::string("Nonlinear::FETOverdriveStageT<Nonlinear::FETChannel::")
+                                          + channel + ">";
+                    members.push_back({nonlinear.name, memberName, partNumber, stageType});
                 }
             }
 
@@ -185,300 +213,1521 @@ namespace LiveSpice {
 
             return hasPot && capCount >= 2;
         }
-    }
 
-    std::string JuceDSPGenerator::generateProcessorHeader() {
-        std::stringstream ss;
-        
-        ss << R"(/*
-  ==============================================================================
-    Auto-generated JUCE Audio Processor
-    Generated from LiveSpice circuit analysis
-    Using LiveSPICE Component DSP Library
-  ==============================================================================
-*/
+        // True when generated code has a line that is not blank or a comment
+        bool hasStatements(const std::string& code) {
+            std::istringstream lines(code);
+            std::string line;
+            while (std::getline(lines, line)) {
+                const size_t first = line.find_first_not_of(" \t");
+                if (first != std::string::npos && line.compare(first, 2, "//") != 0) {
+                    return true;
+                }
+            }
+            return false;
+        }
 
-#pragma once
+        // Knob the gain stages follow: the first drive or level parameter
+        std::string findGainParamId(const std::vector<JuceParameter>& parameters) {
+            for (const auto& param : parameters) {
+                if (param.id.find("drive") != std::string::npos ||
+                    param.id.find("level") != std::string::npos) {
+                    return param.id;
+                }
+            }
+            return {};
+        }
 
-#include <juce_audio_processors/juce_audio_processors.h>
-#include <juce_dsp/juce_dsp.h>
-#include <cmath>
+        const char* inputRateName(JuceDSPGenerator::InputRate rate) {
+            switch (rate) {
+                case JuceDSPGenerator::InputRate::Audio: return "audio";
+                case JuceDSPGenerator::InputRate::Control: return "control";
+                default: return "constant";
+            }
+        }
 
-// LiveSPICE Component Library
-#include "../../third_party/livespice-components/ComponentModels.h"
-#include "../../third_party/livespice-components/DSPImplementations.h"
+        // Initial capacity for a generated file: fixed text plus a per-stage share
+        size_t estimateCodeSize(size_t stageCount, size_t fixedBytes, size_t bytesPerStage) {
+            return fixedBytes + stageCount * bytesPerStage;
+        }
 
-class CircuitProcessor : public juce::AudioProcessor
-{
-public:
-    CircuitProcessor();
-    ~CircuitProcessor() override;
+        // C++ float literal for a device parameter (always has '.' or an exponent)
+        std::string floatLiteral(float value) {
+            std::string literal;
+            for (int digits = 6; digits <= 9; ++digits) {   // Shortest text that reads back exactly
+                std::ostringstream text;
+                text << std::setprecision(digits) << value;
+                literal = text.str();
+                if (std::strtof(literal.c_str(), nullptr) == value) break;
+            }
+            if (literal.find_first_of(".e") == std::string::npos) literal += ".0";
+            return literal + "f";
+        }
 
-    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
-    void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+        std::string floatList(std::initializer_list<float> values) {
+            std::string list;
+            for (float value : values) {
+                list += (list.empty() ? "" : ", ") + floatLiteral(value);
+            }
+            return list;
+        }
 
-    juce::AudioProcessorEditor* createEditor() override;
-    bool hasEditor() const override;
+        // SharedState member holding one resolved part, e.g. diode_1N4148
+        std::string sharedPartName(const std::string& kind, const std::string& partNumber) {
+            std::string id = makeSafeIdentifier(partNumber);
+            if (id.front() == '_') {
+                id.erase(0, 1);
+            }
+            return kind + "_" + id;
+        }
 
-    const juce::String getName() const override;
-    bool acceptsMidi() const override;
-    bool producesMidi() const override;
-    bool isMidiEffect() const override;
-    double getTailLengthSeconds() const override;
+        // Stock parts are looked up in the plugin's database; parts resolved
+        // from a SPICE model library are not there, so they are emitted inline
+        std::string diodeInitializer(const std::string& partNumber) {
+            const auto* part = Nonlinear::ComponentDB::kStockDiodeTable.find(partNumber)
+                                   ? nullptr : Nonlinear::ComponentDB::getDiodeDB().find(partNumber);
+            if (!part) return "Nonlinear::ComponentDB::getDiodeDB().getOrDefault(\"" + partNumber + "\")";
+            return "Nonlinear::DiodeCharacteristics{" +
+                   floatList({part->Is, part->n, part->Vt, part->Rs, part->CjZero, part->m}) + "} /* " + partNumber + " */";
+        }
 
-    int getNumPrograms() override;
-    int getCurrentProgram() override;
-    void setCurrentProgram (int index) override;
-    const juce::String getProgramName (int index) override;
-    void changeProgramName (int index, const juce::String& newName) override;
+        std::string bjtInitializer(const std::string& partNumber) {
+            const auto* part = Nonlinear::ComponentDB::kStockBJTTable.find(partNumber)
+                                   ? nullptr : Nonlinear::ComponentDB::getBJTDB().find(partNumber);
+            if (!part) return "Nonlinear::ComponentDB::getBJTDB().getOrDefault(\"" + partNumber + "\")";
+            return "Nonlinear::BJTCharacteristics{" +
+                   floatList({part->Is, part->Vt, part->nBE, part->nBC, part->Bf, part->Br, part->Rb, part->Vat,
+                              part->tempCoeff}) + "} /* " + partNumber + " */";
+        }
 
-    void getStateInformation (juce::MemoryBlock& destData) override;
-    void setStateInformation (const void* data, int sizeInBytes) override;
+        std::string fetInitializer(const std::string& partNumber) {
+            const auto* part = Nonlinear::ComponentDB::kStockFETTable.find(partNumber)
+                                   ? nullptr : Nonlinear::ComponentDB::getFETDB().find(partNumber);
+            if (!part) return "Nonlinear::ComponentDB::getFETDB().getOrDefault(\"" + partNumber + "\")";
+            return "Nonlinear::FETCharacteristics{" +
+                   floatList({part->Vto, part->Kp, part->Lambda, part->Vef, part->Rs, part->Rd, part->Cgs, part->Cgd}) +
+                   "} /* " + partNumber + " */";
+        }
 
-private:
-    // DSP State Variables
-)";
+        // Clipper stages, which become baked waveshapers when tables are on
+        // (stages replaced by subcircuit tables excepted)
+        bool hasShaperStage(const std::vector<CircuitStage>& stages, const std::set<size_t>& tabled = {}) {
+            for (size_t i = 0; i < stages.size(); ++i) {
+                const bool clipper = stages[i].type == StageType::OpAmpClipping || stages[i].type == StageType::DiodeClipper;
+                if (clipper && tabled.count(i) == 0) return true;
+            }
+            return false;
+        }
 
-        return ss.str();
-    }
+        // ====================================================================
+        // Nodal DK backend: schematic -> LiveSpiceDSP::DKNetwork
+        // ====================================================================
 
-    std::string JuceDSPGenerator::generateStateVariables(const std::vector<CircuitStage>& stages) {
-        std::stringstream ss;
-        
-        ss << "    // ========================================================================\n";
-        ss << "    // LiveSPICE Component Processors - Real-time audio DSP\n";
-        ss << "    // ========================================================================\n\n";
-        
-        // Track which processor types we need
-        bool needsResistor = false;
-        bool needsCapacitor = false;
-        bool needsDiode = false;
-        bool needsOpAmp = false;
-        
-        for (size_t i = 0; i < stages.size(); ++i) {
-            const auto& stage = stages[i];
-            
-            ss << "    // Stage " << i << ": " << stage.name << "\n";
-            ss << "    // DSP Mapping: " << stage.dspDescription << "\n";
+        struct DKCircuitPlan {
+            size_t states = 0;
+            size_t ports = 0;
+            std::string networkCode;   // DKNetwork calls for prepareToPlay
+            std::string unsupported;   // Why the netlist cannot be simulated (empty = ok)
+        };
 
-            const bool isToneControl = isLikelyToneStackStage(stage);
-            if (m_useBetaFeatures && isToneControl) {
-                ss << "    // [BETA] Tone stack filters (low/mid/high)\n";
-                ss << "    juce::dsp::IIR::Filter<float> stage" << i << "_toneLow;\n";
-                ss << "    juce::dsp::IIR::Filter<float> stage" << i << "_toneMid;\n";
-                ss << "    juce::dsp::IIR::Filter<float> stage" << i << "_toneHigh;\n\n";
-                continue;
-            }
-            
-            // Determine which LiveSPICE processors to use based on stage type and DSP mapping
-            switch (stage.type) {
-                case StageType::HighPassFilter:
-                case StageType::LowPassFilter:
-                case StageType::InputBuffer: {
-                    // RC filter using LiveSPICE components
-                    ss << "    LiveSpiceDSP::ResistorProcessor stage" << i << "_resistor;\n";
-                    ss << "    LiveSpiceDSP::CapacitorProcessor stage" << i << "_capacitor;\n";
-                    needsResistor = true;
-                    needsCapacitor = true;
-                    break;
-                }
-                    
-                case StageType::GainStage:
-                    // Keep JUCE gain for simple amplification
-                    ss << "    juce::dsp::Gain<float> stage" << i << "_gain;\n";
-                    break;
-                    
-                case StageType::OpAmpClipping:
-                case StageType::DiodeClipper: {
-                    // Use LiveSPICE diode processors for clipping
-                    ss << "    LiveSpiceDSP::DiodeProcessor stage" << i << "_diode1;\n";
-                    ss << "    LiveSpiceDSP::DiodeProcessor stage" << i << "_diode2;\n";
-                    ss << "    LiveSpiceDSP::OpAmpProcessor stage" << i << "_opamp;\n";
-                    needsDiode = true;
-                    needsOpAmp = true;
-                    break;
-                }
-                    
-                case StageType::OutputBuffer:
-                    ss << "    juce::dsp::Gain<float> stage" << i << "_gain;\n";
-                    break;
-                    
+        using GridPoint = std::pair<int, int>;
+
+        // Terminal offsets of LiveSpice symbols at rotation 0 (schematic units,
+        // y down). Two-terminal parts put the anode on top; op-amp supply pins
+        // are not listed since the op-amp is modelled as ideal.
+        std::vector<GridPoint> terminalOffsets(ComponentType type) {
+            switch (type) {
+                case ComponentType::Resistor:
+                case ComponentType::Capacitor:
+                case ComponentType::VariableResistor:
+                case ComponentType::Diode:
+                case ComponentType::Input:
+                case ComponentType::Speaker:
+                    return {{0, -20}, {0, 20}};
+                case ComponentType::Potentiometer:
+                    return {{-10, -20}, {-10, 20}, {10, 0}};   // anode, cathode, wiper
+                case ComponentType::OpAmp:
+                    return {{-20, 10}, {-20, -10}, {20, 0}};   // +, -, output
+                case ComponentType::Ground:
+                case ComponentType::Rail:
+                case ComponentType::Output:
+                    return {{0, 0}};
                 default:
-                    ss << "    // TODO: Map to appropriate LiveSPICE processor\n";
-                    break;
+                    return {};
             }
-            ss << "\n";
         }
-        
-        ss << "    // Sample rate for DSP processing\n";
-        ss << "    double currentSampleRate = 44100.0;\n";
-        ss << "\n    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CircuitProcessor)\n";
-        ss << "};\n";
-        
-        return ss.str();
-    }
 
-    std::string JuceDSPGenerator::generatePrepareToPlayCode(const std::vector<CircuitStage>& stages) {
-        std::stringstream ss;
-        
-        ss << R"(void CircuitProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
-{
-    currentSampleRate = sampleRate;
-    juce::dsp::ProcessSpec spec;
-    spec.sampleRate = sampleRate;
-    spec.maximumBlockSize = (juce::uint32) samplesPerBlock;
-    spec.numChannels = 2;
+        // Flip mirrors the symbol's y axis, then Rotation turns it in quarter turns
+        GridPoint placeTerminal(const Component& comp, GridPoint offset) {
+            int x = offset.first;
+            int y = comp.getFlipped() ? -offset.second : offset.second;
+            for (int turn = ((comp.getRotation() % 4) + 4) % 4; turn > 0; --turn) {
+                const int rotated = -y;
+                y = x;
+                x = rotated;
+            }
+            return {comp.getPosX() + x, comp.getPosY() + y};
+        }
 
-    // ========================================================================
-    // Initialize LiveSPICE Component Processors
-    // ========================================================================
+        bool liesOnWire(const Wire& wire, GridPoint point) {
+            const long long dx = wire.nodeB_X - wire.nodeA_X, dy = wire.nodeB_Y - wire.nodeA_Y;
+            const long long px = point.first - wire.nodeA_X, py = point.second - wire.nodeA_Y;
+            if (dx * py - dy * px != 0) {
+                return false;
+            }
+            return point.first >= std::min(wire.nodeA_X, wire.nodeB_X) && point.first <= std::max(wire.nodeA_X, wire.nodeB_X)
+                && point.second >= std::min(wire.nodeA_Y, wire.nodeB_Y) && point.second <= std::max(wire.nodeA_Y, wire.nodeB_Y);
+        }
 
-)";
+        struct ResolvedPart {
+            std::shared_ptr<Component> comp;
+            std::vector<int> nodes;    // One per terminalOffsets() entry
+        };
 
-        for (size_t i = 0; i < stages.size(); ++i) {
-            const auto& stage = stages[i];
-            
-            ss << "    // Stage " << i << ": " << stage.name << "\n";
-            
-            // Beta mode: Initialize optimized filters based on pattern
-            const bool isToneControl = isLikelyToneStackStage(stage);
-            if (m_useBetaFeatures && isToneControl) {
-                ss << "    // [BETA] Tone stack filter setup\n";
-                ss << "    *stage" << i << "_toneLow.state = *juce::dsp::IIR::Coefficients<float>::makeLowShelf(sampleRate, 120.0f, 0.707f, juce::Decibels::decibelsToGain(3.0f));\n";
-                ss << "    *stage" << i << "_toneMid.state = *juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate, 1000.0f, 0.707f, juce::Decibels::decibelsToGain(-2.0f));\n";
-                ss << "    *stage" << i << "_toneHigh.state = *juce::dsp::IIR::Coefficients<float>::makeHighShelf(sampleRate, 4500.0f, 0.707f, juce::Decibels::decibelsToGain(3.0f));\n";
-                ss << "    stage" << i << "_toneLow.prepare(spec);\n";
-                ss << "    stage" << i << "_toneMid.prepare(spec);\n";
-                ss << "    stage" << i << "_toneHigh.prepare(spec);\n\n";
-                continue;
-            }
+        struct SchematicNets {
+            std::vector<ResolvedPart> parts;                 // Symbols with known terminals
+            std::vector<std::shared_ptr<Component>> opaque;  // Symbols without terminal geometry
+            std::set<int> looseNodes;     // Nets with a wire end touching no known terminal
+            std::string unsupported;      // Geometry did not resolve (empty = ok)
+        };
 
-            if (m_useBetaFeatures && stage.patternStrategy == "cascaded_biquad" && stage.patternConfidence >= 0.8) {
-                auto fcIt = stage.dspParams.find("cutoff_frequency");
-                auto hpfcIt = stage.dspParams.find("highpass_frequency");
-                
-                if (stage.type == StageType::LowPassFilter && fcIt != stage.dspParams.end()) {
-                    double fc = fcIt->second;
-                    ss << "    // [BETA] Optimized low-pass biquad\n";
-                    ss << "    *stage" << i << "_lpf.state = *juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, " 
-                       << fc << "f);\n";
-                    ss << "    stage" << i << "_lpf.prepare(spec);\n\n";
-                    
-                } else if ((stage.type == StageType::HighPassFilter || stage.type == StageType::InputBuffer) && hpfcIt != stage.dspParams.end()) {
-                    double fc = hpfcIt->second;
-                    ss << "    // [BETA] Optimized high-pass biquad\n";
-                    ss << "    *stage" << i << "_hpf.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, " 
-                       << fc << "f);\n";
-                    ss << "    stage" << i << "_hpf.prepare(spec);\n\n";
-                } else {
-                    ss << "    // [BETA] No frequency params, skipping filter init\n\n";
+        /**
+         * Resolve pin-level nets from symbol geometry: terminals joined by
+         * wires, including T-junctions mid-wire. Ground nets are node 0 and
+         * the rest are numbered in component order. Symbols this table has no
+         * geometry for cannot be wired, so the nets their pins would join are
+         * reported as loose instead.
+         */
+        SchematicNets resolveNets(const Netlist& netlist) {
+            SchematicNets nets;
+            const auto& wires = netlist.getWires();
+
+            std::vector<std::vector<GridPoint>> terminals;
+            std::vector<std::shared_ptr<Component>> placed;
+            for (const auto& pair : netlist.getComponents()) {
+                const auto& comp = pair.second;
+                if (comp->getType() == ComponentType::Label) {
+                    continue;
+                }
+                auto offsets = terminalOffsets(comp->getType());
+                if (offsets.empty()) {
+                    nets.opaque.push_back(comp);
+                    continue;
                 }
-                continue; // Skip stable initialization
+                std::vector<GridPoint> points;
+                for (const auto& offset : offsets) {
+                    points.push_back(placeTerminal(*comp, offset));
+                }
+                placed.push_back(comp);
+                terminals.push_back(std::move(points));
             }
-            
-            // Stable mode: Use LiveSPICE component initialization
-            switch (stage.type) {
-                case StageType::HighPassFilter:
-                case StageType::InputBuffer: {
-                    auto itR = stage.dspParams.find("input_resistance");
-                    auto itC = stage.dspParams.find("coupling_capacitance");
-                    auto itF = stage.dspParams.find("highpass_frequency");
-                    
-                    double resistance = (itR != stage.dspParams.end()) ? itR->second : 100000.0;
-                    double capacitance = (itC != stage.dspParams.end()) ? itC->second : 1e-8;
-                    double frequency = (itF != stage.dspParams.end()) ? itF->second : 72.0;
-                    
-                    ss << "    // RC High-Pass Filter: f = " << frequency << " Hz\n";
-                    ss << "    stage" << i << "_resistor.prepare(" << resistance << ");\n";
-                    ss << "    stage" << i << "_capacitor.prepare(" << capacitance << ", 0.1); // " 
-                       << capacitance << " F with 0.1Ω ESR\n\n";
-                    break;
+
+            // Union-find over every terminal and wire endpoint
+            std::map<GridPoint, size_t> pointIndex;
+            std::vector<size_t> parent;
+            auto pointId = [&](GridPoint point) {
+                auto it = pointIndex.find(point);
+                if (it != pointIndex.end()) {
+                    return it->second;
                 }
-                
-                case StageType::LowPassFilter: {
-                    auto itR = stage.dspParams.find("input_resistance");
-                    auto itC = stage.dspParams.find("coupling_capacitance");
-                    auto itF = stage.dspParams.find("cutoff_frequency");
-                    
-                    double resistance = (itR != stage.dspParams.end()) ? itR->second : 10000.0;
-                    double capacitance = (itC != stage.dspParams.end()) ? itC->second : 1e-8;
-                    double frequency = (itF != stage.dspParams.end()) ? itF->second : 15915.0;
-                    
-                    ss << "    // RC Low-Pass Filter: fc = " << frequency << " Hz\n";
-                    ss << "    stage" << i << "_resistor.prepare(" << resistance << ");\n";
-                    ss << "    stage" << i << "_capacitor.prepare(" << capacitance << ", 0.1);\n\n";
-                    break;
+                parent.push_back(parent.size());
+                return pointIndex[point] = parent.size() - 1;
+            };
+            auto find = [&](size_t id) {
+                while (parent[id] != id) {
+                    id = parent[id] = parent[parent[id]];
                 }
-                
-                case StageType::GainStage: {
-                    auto it = stage.dspParams.find("gain_linear");
-                    if (it != stage.dspParams.end()) {
-                        ss << "    stage" << i << "_gain.setGainLinear(" << it->second << "f);\n";
-                        ss << "    stage" << i << "_gain.prepare(spec);\n\n";
-                    } else {
-                        ss << "    stage" << i << "_gain.setGainLinear(1.0f);\n";
-                        ss << "    stage" << i << "_gain.prepare(spec);\n\n";
+                return id;
+            };
+            auto unite = [&](size_t a, size_t b) { parent[find(a)] = find(b); };
+
+            std::map<GridPoint, int> terminalCount;
+            for (const auto& points : terminals) {
+                for (const auto& terminal : points) {
+                    pointId(terminal);
+                    ++terminalCount[terminal];
+                }
+            }
+            for (const auto& wire : wires) {
+                unite(pointId({wire.nodeA_X, wire.nodeA_Y}), pointId({wire.nodeB_X, wire.nodeB_Y}));
+            }
+            std::map<GridPoint, int> wiresAt;
+            for (const auto& entry : pointIndex) {
+                for (const auto& wire : wires) {
+                    if (liesOnWire(wire, entry.first)) {
+                        unite(entry.second, pointId({wire.nodeA_X, wire.nodeA_Y}));
+                        ++wiresAt[entry.first];
                     }
-                    break;
                 }
-                
-                case StageType::OpAmpClipping:
-                case StageType::DiodeClipper: {
-                    ss << "    // Diode clipping with Shockley equation\n";
-                    ss << "    stage" << i << "_diode1.prepare(\"1N4148\", 25.0); // Silicon diode, 25°C\n";
-                    ss << "    stage" << i << "_diode2.prepare(\"1N4148\", 25.0);\n";
-                    ss << "    stage" << i << "_opamp.prepare(\"TL072\", sampleRate); // Dual op-amp\n\n";
-                    break;
+            }
+
+            // A terminal touching nothing means the symbol geometry did not match
+            for (size_t p = 0; p < placed.size(); ++p) {
+                for (const auto& terminal : terminals[p]) {
+                    if (!wiresAt.count(terminal) && terminalCount[terminal] < 2) {
+                        nets.unsupported = "unconnected terminal on " + placed[p]->getName();
+                        return nets;
+                    }
                 }
-                
-                case StageType::OutputBuffer: {
-                    ss << "    stage" << i << "_gain.setGainLinear(0.5f); // 50% output level\n";
-                    ss << "    stage" << i << "_gain.prepare(spec);\n\n";
-                    break;
+            }
+
+            std::map<size_t, int> nodeOf;
+            for (size_t p = 0; p < placed.size(); ++p) {
+                if (placed[p]->getType() == ComponentType::Ground) {
+                    nodeOf[find(pointId(terminals[p].front()))] = LiveSpiceDSP::DKNetwork::GROUND;
                 }
-                
-                default:
-                    ss << "    // TODO: Initialize LiveSPICE processor\n\n";
-                    break;
             }
+            int nextNode = 1;
+            auto node = [&](GridPoint point) {
+                const size_t net = find(pointId(point));
+                auto it = nodeOf.find(net);
+                if (it != nodeOf.end()) {
+                    return it->second;
+                }
+                return nodeOf[net] = nextNode++;
+            };
 
+            for (size_t p = 0; p < placed.size(); ++p) {
+                ResolvedPart part{placed[p], {}};
+                for (const auto& terminal : terminals[p]) {
+                    part.nodes.push_back(node(terminal));
+                }
+                nets.parts.push_back(std::move(part));
+            }
+            for (const auto& entry : wiresAt) {
+                if (entry.second == 1 && !terminalCount.count(entry.first)) {
+                    nets.looseNodes.insert(node(entry.first));
+                }
+            }
+            return nets;
         }
-        
-        ss << "}\n\n";
-        return ss.str();
-    }
 
-    std::string JuceDSPGenerator::generateProcessBlockCode(const std::vector<CircuitStage>& stages) {
-        std::stringstream ss;
-        
-        ss << R"(void CircuitProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
-{
-    juce::ScopedNoDenormals noDenormals;
-    auto totalNumInputChannels  = getTotalNumInputChannels();
-    auto totalNumOutputChannels = getTotalNumOutputChannels();
+        /**
+         * Translate the resolved parts into DKNetwork calls. Potentiometers and
+         * variable resistors are fixed at their schematic wipe (linear taper).
+         * The result is checked by building the model once at 48 kHz.
+         */
+        DKCircuitPlan planDKCircuit(const Netlist& netlist) {
+            DKCircuitPlan plan;
+
+            const SchematicNets nets = resolveNets(netlist);
+            if (!nets.opaque.empty()) {
+                const auto& comp = *nets.opaque.front();
+                plan.unsupported = "unsupported component " + comp.getName() + " (" + componentTypeName(comp.getType()) + ")";
+                return plan;
+            }
+            if (!nets.unsupported.empty()) {
+                plan.unsupported = nets.unsupported;
+                return plan;
+            }
 
-    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
-        buffer.clear (i, 0, buffer.getNumSamples());
+            LiveSpiceDSP::DKNetwork network;
+            std::stringstream code;
+            bool hasInput = false, hasOutput = false;
+            auto emitResistor = [&](int a, int b, double ohms, const std::string& label) {
+                ohms = std::max(ohms, 1.0);   // a wiper at its end stop
+                network.addResistor(a, b, ohms);
+                code << "    network.addResistor(" << a << ", " << b << ", " << ohms << "); // " << label << "\n";
+            };
+
+            for (const auto& part : nets.parts) {
+                const auto& comp = *part.comp;
+                const auto& t = part.nodes;
+                const std::string& name = comp.getName();
+
+                switch (comp.getType()) {
+                    case ComponentType::Resistor:
+                        emitResistor(t[0], t[1], comp.getParamValueAsDouble("Resistance"), name);
+                        break;
 
-    // Check bypass parameter (bool)
-    bool bypassed = bypassParam->load() >= 0.5f;
-    if (bypassed)
-    {
-        // Bypass is ON - pass through without processing
-        return;
-    }
+                    case ComponentType::VariableResistor: {
+                        const double wipe = comp.getParamValue("Wipe").empty() ? 0.5 : comp.getParamValueAsDouble("Wipe");
+                        emitResistor(t[0], t[1], comp.getParamValueAsDouble("Resistance") * wipe, name);
+                        break;
+                    }
 
-    // ========================================================================
-    // LiveSPICE Component-Based DSP Processing
-    // Sample-by-sample processing for accurate component modeling
-    // ========================================================================
+                    case ComponentType::Potentiometer: {
+                        // Wipe 0 puts the wiper at the cathode
+                        const double ohms = comp.getParamValueAsDouble("Resistance");
+                        const double wipe = comp.getParamValue("Wipe").empty() ? 0.5 : comp.getParamValueAsDouble("Wipe");
+                        emitResistor(t[0], t[2], ohms * (1.0 - wipe), name + " (anode to wiper)");
+                        emitResistor(t[2], t[1], ohms * wipe, name + " (wiper to cathode)");
+                        break;
+                    }
 
-    for (int channel = 0; channel < totalNumInputChannels; ++channel)
-    {
-        auto* channelData = buffer.getWritePointer(channel);
-        
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+                    case ComponentType::Capacitor: {
+                        const int a = t[0], b = t[1];
+                        const double farads = comp.getParamValueAsDouble("Capacitance");
+                        network.addCapacitor(a, b, farads);
+                        code << "    network.addCapacitor(" << a << ", " << b << ", " << farads << "); // " << name << "\n";
+                        break;
+                    }
+
+                    case ComponentType::Diode: {
+                        const auto stock = Nonlinear::ComponentDB::getDiodeDB().getOrDefault(comp.getParamValue("PartNumber"));
+                        const double Is = comp.getParamValue("IS").empty() ? stock.Is : comp.getParamValueAsDouble("IS");
+                        const double n = comp.getParamValue("n").empty() ? stock.n : comp.getParamValueAsDouble("n");
+                        const int a = t[0], b = t[1];
+                        network.addDiode(a, b, Is, n);
+                        code << "    network.addDiode(" << a << ", " << b << ", " << Is << ", " << n << "); // " << name << "\n";
+                        break;
+                    }
+
+                    case ComponentType::OpAmp: {
+                        const int plus = t[0], minus = t[1], out = t[2];
+                        network.addIdealOpAmp(plus, minus, out);
+                        code << "    network.addIdealOpAmp(" << plus << ", " << minus << ", " << out << "); // " << name << "\n";
+                        break;
+                    }
+
+                    case ComponentType::Rail: {
+                        const int a = t[0];
+                        const double volts = comp.getParamValueAsDouble("Voltage");
+                        network.addVoltageSource(a, LiveSpiceDSP::DKNetwork::GROUND, volts);
+                        code << "    network.addVoltageSource(" << a << ", 0, " << volts << "); // " << name << "\n";
+                        break;
+                    }
+
+                    case ComponentType::Input: {
+                        if (hasInput) {
+                            plan.unsupported = "more than one input";
+                            return plan;
+                        }
+                        hasInput = true;
+                        const int a = t[0], b = t[1];
+                        const double scale = comp.getParamValue("V0dBFS").empty() ? 1.0 : comp.getParamValueAsDouble("V0dBFS");
+                        network.setInput(a, b, scale);
+                        code << "    network.setInput(" << a << ", " << b << ", " << scale << "); // " << name << "\n";
+                        break;
+                    }
+
+                    case ComponentType::Speaker:
+                    case ComponentType::Output: {
+                        if (hasOutput) {
+                            break;
+                        }
+                        hasOutput = true;
+                        const int a = t[0];
+                        const int b = t.size() > 1 ? t[1] : LiveSpiceDSP::DKNetwork::GROUND;
+                        network.setOutput(a, b);
+                        code << "    network.setOutput(" << a << ", " << b << "); // " << name << "\n";
+                        break;
+                    }
+
+                    default:
+                        break;
+                }
+            }
+
+            if (!hasInput || !hasOutput) {
+                plan.unsupported = hasInput ? "no output" : "no input";
+                return plan;
+            }
+
+            plan.states = network.getNumStates();
+            plan.ports = network.getNumPorts();
+            if (plan.states > 32 || plan.ports > 8) {
+                plan.unsupported = "too large for DKProcessor (" + std::to_string(plan.states) + " states, "
+                                 + std::to_string(plan.ports) + " ports)";
+                return plan;
+            }
+            try {
+                network.build(48000.0);
+            } catch (const std::invalid_argument& e) {
+                plan.unsupported = e.what();
+                return plan;
+            }
+
+            plan.networkCode = code.str();
+            return plan;
+        }
+
+        // ====================================================================
+        // WDF backend: diode clippers to ground -> LiveSpiceDSP::WDF trees
+        // ====================================================================
+
+        struct WDFKnob {
+            std::string componentName;   // Potentiometer or variable resistor
+            std::string setter;          // Generated method taking the wipe
+        };
+
+        struct WDFClipperPlan {
+            std::string memberName;             // Per-channel array of the generated struct
+            std::vector<std::string> diodes;    // Diodes folded into the root
+            std::vector<WDFKnob> knobs;
+            std::string structCode;             // Struct definition for the processor header
+        };
+
+        /**
+         * Find diodes (a single one, parallel ones or an antiparallel pair)
+         * from a net to ground whose surroundings reduce to one WDF tree: the
+         * linear parts reachable from that net before ground or a driving
+         * node (an op-amp output or the input jack, modelled as a 1 ohm
+         * resistive source), joined by series/parallel reduction. Nets that
+         * touch anything else, or that form a bridge, are left to the stage
+         * chain.
+         */
+        std::vector<WDFClipperPlan> planWDFClippers(const Netlist& netlist) {
+            std::vector<WDFClipperPlan> plans;
+            const SchematicNets nets = resolveNets(netlist);
+            if (!nets.unsupported.empty()) {
+                return plans;
+            }
+            constexpr int GROUND = LiveSpiceDSP::DKNetwork::GROUND;
+
+            std::map<int, std::vector<size_t>> partsAt;
+            std::map<int, std::string> drivers;   // Driving node -> description
+            for (size_t p = 0; p < nets.parts.size(); ++p) {
+                const auto& part = nets.parts[p];
+                for (int node : std::set<int>(part.nodes.begin(), part.nodes.end())) {
+                    partsAt[node].push_back(p);
+                }
+                if (part.comp->getType() == ComponentType::OpAmp) {
+                    drivers[part.nodes[2]] = part.comp->getName() + " output";
+                } else if (part.comp->getType() == ComponentType::Input && part.nodes[1] == GROUND) {
+                    drivers[part.nodes[0]] = "input " + part.comp->getName();
+                }
+            }
+
+            auto diodeModel = [](const Component& comp) {
+                const auto stock = Nonlinear::ComponentDB::getDiodeDB().getOrDefault(comp.getParamValue("PartNumber"));
+                const double Is = comp.getParamValue("IS").empty() ? stock.Is : comp.getParamValueAsDouble("IS");
+                const double n = comp.getParamValue("n").empty() ? stock.n : comp.getParamValueAsDouble("n");
+                return std::make_pair(Is, n);
+            };
+            auto wipeOf = [](const Component& comp) {
+                return comp.getParamValue("Wipe").empty() ? 0.5 : comp.getParamValueAsDouble("Wipe");
+            };
+            auto isLinear = [](ComponentType type) {
+                return type == ComponentType::Resistor || type == ComponentType::Capacitor
+                    || type == ComponentType::Potentiometer || type == ComponentType::VariableResistor;
+            };
+
+            // Diodes from each net to ground
+            std::map<int, std::vector<size_t>> clipperDiodes;
+            for (size_t p = 0; p < nets.parts.size(); ++p) {
+                const auto& part = nets.parts[p];
+                if (part.comp->getType() != ComponentType::Diode) {
+                    continue;
+                }
+                if (part.nodes[1] == GROUND && part.nodes[0] != GROUND) {
+                    clipperDiodes[part.nodes[0]].push_back(p);
+                } else if (part.nodes[0] == GROUND && part.nodes[1] != GROUND) {
+                    clipperDiodes[part.nodes[1]].push_back(p);
+                }
+            }
+
+            for (const auto& entry : clipperDiodes) {
+                const int top = entry.first;
+                const auto& diodes = entry.second;
+
+                // Root: forward diodes have their anode on the clipped net
+                size_t forward = 0, reverse = 0;
+                const auto model = diodeModel(*nets.parts[diodes.front()].comp);
+                bool matched = true;
+                for (size_t d : diodes) {
+                    (nets.parts[d].nodes[0] == top ? forward : reverse)++;
+                    matched = matched && diodeModel(*nets.parts[d].comp) == model;
+                }
+                if (!matched || (forward > 0 && reverse > 0 && (forward != 1 || reverse != 1))
+                    || drivers.count(top) || nets.looseNodes.count(top)) {
+                    continue;
+                }
+
+                // Linear region around the clipped net, out to ground and one driving node
+                struct Edge {
+                    int a, b;                       // Port polarity runs from a to b
+                    std::vector<size_t> members;    // Subtree declarations, children first
+                    bool hasSource;
+                };
+                struct Member {
+                    std::string name;
+                    std::string decl;
+                };
+                struct Knob {
+                    WDFKnob knob;
+                    std::vector<std::string> leaves;
+                    std::string code;               // Setter body
+                };
+                std::vector<Member> decls;          // Leaves and adaptors
+                std::vector<std::string> capacitors;
+                std::vector<Knob> knobs;
+                std::vector<Edge> edges;
+                std::set<int> visited{top};
+                std::vector<int> queue{top};
+                std::set<size_t> regionParts;
+                int driver = -1;
+                bool valid = true;
+
+                auto leaf = [&](int a, int b, const std::string& name, const std::string& type, double value) {
+                    std::stringstream decl;
+                    decl << "LiveSpiceDSP::WDF::" << type << " " << name << " { " << value << " };";
+                    decls.push_back({name, decl.str()});
+                    edges.push_back({a, b, {decls.size() - 1}, false});
+                };
+
+                for (size_t q = 0; q < queue.size() && valid; ++q) {
+                    const int at = queue[q];
+                    for (size_t p : partsAt[at]) {
+                        const auto& part = nets.parts[p];
+                        const auto type = part.comp->getType();
+                        if (type == ComponentType::Output || type == ComponentType::Speaker
+                            || std::find(diodes.begin(), diodes.end(), p) != diodes.end()) {
+                            continue;   // Open at audio rate, or the root itself
+                        }
+                        if (!isLinear(type)) {
+                            valid = false;
+                            break;
+                        }
+                        if (!regionParts.insert(p).second) {
+                            continue;
+                        }
+
+                        const auto& comp = *part.comp;
+                        const auto& t = part.nodes;
+                        const std::string id = makeSafeIdentifier(comp.getName());
+                        switch (type) {
+                            case ComponentType::Resistor:
+                                leaf(t[0], t[1], id, "Resistor", std::max(comp.getParamValueAsDouble("Resistance"), 1.0));
+                                break;
+
+                            case ComponentType::Capacitor:
+                                leaf(t[0], t[1], id, "Capacitor", comp.getParamValueAsDouble("Capacitance"));
+                                capacitors.push_back(id);
+                                break;
+
+                            case ComponentType::VariableResistor: {
+                                const double ohms = comp.getParamValueAsDouble("Resistance");
+                                leaf(t[0], t[1], id, "Resistor", std::max(ohms * wipeOf(comp), 1.0));
+                                std::stringstream code;
+                                code << "            " << id << ".setResistance(std::max(" << ohms << " * wipe, 1.0));\n";
+                                knobs.push_back({{comp.getName(), "set" + id}, {id}, code.str()});
+                                break;
+                            }
+
+                            case ComponentType::Potentiometer: {
+                                // Wipe 0 puts the wiper at the cathode
+                                const double ohms = comp.getParamValueAsDouble("Resistance");
+                                const double wipe = wipeOf(comp);
+                                leaf(t[0], t[2], id + "_upper", "Resistor", std::max(ohms * (1.0 - wipe), 1.0));
+                                leaf(t[2], t[1], id + "_lower", "Resistor", std::max(ohms * wipe, 1.0));
+                                std::stringstream code;
+                                code << "            " << id << "_upper.setResistance(std::max(" << ohms << " * (1.0 - wipe), 1.0));\n"
+                                     << "            " << id << "_lower.setResistance(std::max(" << ohms << " * wipe, 1.0));\n";
+                                knobs.push_back({{comp.getName(), "set" + id}, {id + "_upper", id + "_lower"}, code.str()});
+                                break;
+                            }
+
+                            default:
+                                break;
+                        }
+
+                        for (int next : t) {
+                            if (next == GROUND || visited.count(next)) {
+                                continue;
+                            }
+                            visited.insert(next);
+                            if (drivers.count(next)) {
+                                if (driver >= 0 && driver != next) {
+                                    valid = false;   // Two driving nodes
+                                }
+                                driver = next;
+                                continue;
+                            }
+                            if (nets.looseNodes.count(next)) {
+                                valid = false;
+                            }
+                            queue.push_back(next);
+                        }
+                    }
+                }
+                if (!valid || driver < 0) {
+                    continue;
+                }
+                leaf(driver, GROUND, "source", "ResistiveVoltageSource", 1.0);
+                edges.back().hasSource = true;
+
+                // Series/parallel reduction down to one port from the clipped net to ground.
+                // The source is the only polarised leaf, so reversing a subtree that holds
+                // it flips the sign the input is applied with.
+                double sourceSign = 1.0;
+                int adaptors = 0;
+                auto orient = [&](Edge& edge, int from) {
+                    if (edge.a != from) {
+                        std::swap(edge.a, edge.b);
+                        if (edge.hasSource) sourceSign = -sourceSign;
+                    }
+                };
+                auto adaptor = [&](const char* kind, Edge& first, const Edge& second, int a, int b) {
+                    const std::string type = kind;
+                    const std::string name = (type == "Series" ? "series" : "parallel") + std::to_string(adaptors++);
+                    const std::string& left = decls[first.members.back()].name;
+                    const std::string& right = decls[second.members.back()].name;
+                    decls.push_back({name, "LiveSpiceDSP::WDF::" + type + "<decltype(" + left + "), decltype(" + right + ")> "
+                                           + name + " { " + left + ", " + right + " };"});
+                    Edge merged{a, b, first.members, first.hasSource || second.hasSource};
+                    merged.members.insert(merged.members.end(), second.members.begin(), second.members.end());
+                    merged.members.push_back(decls.size() - 1);
+                    first = merged;
+                };
+
+                bool reduced = true;
+                while (reduced && !(edges.size() == 1 && std::set<int>{edges[0].a, edges[0].b} == std::set<int>{top, GROUND})) {
+                    reduced = false;
+
+                    // Parallel: two edges across the same pair of nets
+                    for (size_t i = 0; i < edges.size() && !reduced; ++i) {
+                        for (size_t j = i + 1; j < edges.size() && !reduced; ++j) {
+                            if (std::set<int>{edges[i].a, edges[i].b} == std::set<int>{edges[j].a, edges[j].b}) {
+                                orient(edges[j], edges[i].a);
+                                adaptor("Parallel", edges[i], edges[j], edges[i].a, edges[i].b);
+                                edges.erase(edges.begin() + j);
+                                reduced = true;
+                            }
+                        }
+                    }
+                    if (reduced) continue;
+
+                    // Series through an inner net with two edges; a dead end carries no current
+                    std::map<int, std::vector<size_t>> incident;
+                    for (size_t i = 0; i < edges.size(); ++i) {
+                        incident[edges[i].a].push_back(i);
+                        incident[edges[i].b].push_back(i);
+                    }
+                    for (const auto& at : incident) {
+                        if (at.first == top || at.first == GROUND) {
+                            continue;
+                        }
+                        if (at.second.size() == 1) {
+                            edges.erase(edges.begin() + at.second[0]);
+                            reduced = true;
+                            break;
+                        }
+                        if (at.second.size() == 2) {
+                            Edge& first = edges[at.second[0]];
+                            Edge& second = edges[at.second[1]];
+                            const int outerA = first.a == at.first ? first.b : first.a;
+                            const int outerB = second.a == at.first ? second.b : second.a;
+                            orient(first, outerA);
+                            orient(second, at.first);
+                            adaptor("Series", first, second, outerA, outerB);
+                            edges.erase(edges.begin() + at.second[1]);
+                            reduced = true;
+                            break;
+                        }
+                    }
+                }
+                if (edges.size() != 1 || !edges[0].hasSource) {
+                    continue;
+                }
+                orient(edges[0], top);
+
+                // Emit the tree: only members under the root, children first
+                WDFClipperPlan plan;
+                plan.memberName = "wdfClipper" + std::to_string(plans.size());
+                const std::string typeName = "WdfClipper" + std::to_string(plans.size());
+                const std::string& rootName = decls[edges[0].members.back()].name;
+                std::set<std::string> inTree;
+                for (size_t d : edges[0].members) {
+                    inTree.insert(decls[d].name);
+                }
+                std::stringstream names;
+                for (size_t d : diodes) {
+                    plan.diodes.push_back(nets.parts[d].comp->getName());
+                    names << (names.tellp() > 0 ? ", " : "") << plan.diodes.back();
+                }
+
+                std::stringstream ss;
+                ss << "    // WDF clipper: " << names.str() << " to ground, driven from " << drivers[driver] << "\n";
+                ss << "    struct " << typeName << "\n    {\n";
+                for (size_t d : edges[0].members) {
+                    ss << "        " << decls[d].decl << "\n";
+                }
+                const double nVt = model.second * 0.02585;
+                if (forward == 1 && reverse == 1) {
+                    ss << "        LiveSpiceDSP::WDF::DiodePair<decltype(" << rootName << ")> root { " << rootName << ", "
+                       << model.first << ", " << nVt << " };\n\n";
+                } else {
+                    ss << "        LiveSpiceDSP::WDF::Diode<decltype(" << rootName << ")> root { " << rootName << ", "
+                       << model.first * static_cast<double>(diodes.size()) << ", " << nVt << (reverse > 0 ? ", true" : "") << " };\n\n";
+                }
+                ss << "        " << typeName << "() = default;\n";
+                ss << "        " << typeName << " (const " << typeName << "&) = delete;\n";
+                ss << "        " << typeName << "& operator= (const " << typeName << "&) = delete;\n\n";
+
+                capacitors.erase(std::remove_if(capacitors.begin(), capacitors.end(),
+                                                [&](const std::string& name) { return !inTree.count(name); }),
+                                 capacitors.end());
+                ss << "        void prepare (double sampleRate)\n        {\n";
+                for (const auto& cap : capacitors) {
+                    ss << "            " << cap << ".prepare(sampleRate);\n";
+                }
+                ss << "            reset();\n        }\n\n";
+                ss << "        void reset()\n        {\n";
+                for (const auto& cap : capacitors) {
+                    ss << "            " << cap << ".reset();\n";
+                }
+                ss << "        }\n\n";
+                for (const auto& knob : knobs) {
+                    // A pot half on a dead end was reduced away with its subtree
+                    if (std::all_of(knob.leaves.begin(), knob.leaves.end(),
+                                    [&](const std::string& name) { return inTree.count(name) > 0; })) {
+                        ss << "        void " << knob.knob.setter << " (double wipe)\n        {\n" << knob.code << "        }\n\n";
+                        plan.knobs.push_back(knob.knob);
+                    }
+                }
+                ss << "        float processSample (float x)\n        {\n";
+                ss << "            source.setVoltage(" << (sourceSign < 0.0 ? "-x" : "x") << ");\n";
+                ss << "            root.process();\n";
+                ss << "            return (float) root.voltage();\n        }\n\n";
+                ss << "        void processBlock (float* data, size_t numSamples)\n        {\n";
+                ss << "            for (size_t n = 0; n < numSamples; ++n)\n";
+                ss << "                data[n] = processSample(data[n]);\n        }\n";
+                ss << "    };\n";
+                ss << "    std::array<" << typeName << ", 2> " << plan.memberName << ";\n\n";
+                plan.structCode = ss.str();
+                plans.push_back(std::move(plan));
+            }
+            return plans;
+        }
+
+        // The stage chain with the WDF-simulated diodes taken out; calls maps a
+        // stage index to the clipper members that run where its diodes did
+        struct WDFStageChain {
+            std::vector<WDFClipperPlan> clippers;
+            std::vector<CircuitStage> stages;
+            std::map<size_t, std::vector<std::string>> calls;
+        };
+
+        WDFStageChain applyWDFClippers(const Netlist& netlist, const std::vector<CircuitStage>& stages) {
+            WDFStageChain chain{{}, stages, {}};
+            for (auto& plan : planWDFClippers(netlist)) {
+                const std::set<std::string> diodes(plan.diodes.begin(), plan.diodes.end());
+                bool placed = false;
+                for (size_t i = 0; i < chain.stages.size(); ++i) {
+                    auto& nonlinear = chain.stages[i].nonlinearComponents;
+                    const auto covered = std::remove_if(nonlinear.begin(), nonlinear.end(), [&](const auto& component) {
+                        return component.diodeChar.has_value() && diodes.count(component.name) > 0;
+                    });
+                    if (covered == nonlinear.end()) {
+                        continue;
+                    }
+                    nonlinear.erase(covered, nonlinear.end());
+                    if (!placed) {
+                        chain.calls[i].push_back(plan.memberName);
+                        placed = true;
+                    }
+                }
+                // A clipper the stage chain never reached stays out of the plugin
+                if (placed) {
+                    chain.clippers.push_back(std::move(plan));
+                }
+            }
+            return chain;
+        }
+
+        // ====================================================================
+        // Static chain: stage chain -> LiveSpiceDSP::StaticChain type list
+        // ====================================================================
+
+        struct StaticChainPlan {
+            size_t numStages = 0;
+            std::string header;        // CircuitChain.h
+            std::string unsupported;   // Why the chain cannot be made static (empty = ok)
+        };
+
+        // Stage name as a C++ string literal for LIVESPICE_TRACE_ZONE
+        std::string traceZoneLiteral(size_t index, const std::string& name) {
+            std::string literal = "\"Stage " + std::to_string(index) + ": ";
+            for (char c : name) {
+                if (c == '"' || c == '\\') literal += '\\';
+                if (static_cast<unsigned char>(c) >= 0x20) literal += c;
+            }
+            return literal + "\"";
+        }
+
+        // Shortest decimal that reads back as the same double
+        std::string doubleLiteral(double value) {
+            std::string literal;
+            for (int digits = 6; digits <= 17; ++digits) {
+                std::ostringstream text;
+                text << std::setprecision(digits) << value;
+                literal = text.str();
+                if (std::strtod(literal.c_str(), nullptr) == value) break;
+            }
+            if (literal.find_first_of(".e") == std::string::npos) literal += ".0";
+            return literal;
+        }
+
+        /**
+         * One value pack and stage type per modelled element, in stage order.
+         * Values are those the per-sample path uses: pots sit at their analysed
+         * position and clippers see the 10k series resistor of
+         * DiodeClippingStage. Transistors have no static stage yet.
+         */
+        StaticChainPlan planStaticChain(const std::vector<CircuitStage>& stages) {
+            StaticChainPlan plan;
+            std::stringstream values;
+            std::vector<std::string> types;
+
+            auto addPack = [&](const std::string& name, const std::string& comment,
+                               std::initializer_list<std::pair<const char*, double>> members) {
+                values << "// " << comment << "\n";
+                values << "struct " << name << " {\n";
+                for (const auto& member : members) {
+                    values << "    static constexpr double " << member.first << " = " << doubleLiteral(member.second) << ";\n";
+                }
+                values << "};\n\n";
+            };
+            auto exactly = [](float value) {   // The float's shortest decimal, not its binary expansion
+                std::string literal = floatLiteral(value);
+                literal.pop_back();
+                return std::strtod(literal.c_str(), nullptr);
+            };
+            auto addClipper = [&](const std::string& name, const std::string& label,
+                                  const Nonlinear::DiodeCharacteristics& diode) {
+                addPack(name, label + ": back-to-back diodes behind 10k + Rs",
+                        {{"Is", exactly(diode.Is)}, {"n", exactly(diode.n)}, {"Vt", exactly(diode.Vt)},
+                         {"R", 10000.0 + exactly(diode.Rs)}});
+                types.push_back("LiveSpiceDSP::StaticDiodeClipper<" + name + ">");
+            };
+
+            for (size_t i = 0; i < stages.size(); ++i) {
+                const auto& stage = stages[i];
+                const std::string prefix = "Stage" + std::to_string(i);
+
+                for (const auto& nonlinear : stage.nonlinearComponents) {
+                    if (nonlinear.bjtChar.has_value() || nonlinear.fetChar.has_value()) {
+                        plan.unsupported = "transistor " + nonlinear.name + " has no static stage";
+                        return plan;
+                    }
+                }
+
+                switch (stage.type) {
+                    case StageType::HighPassFilter:
+                    case StageType::InputBuffer:
+                    case StageType::LowPassFilter: {
+                        const bool lowPass = stage.type == StageType::LowPassFilter;
+                        const double resistance = stage.params.get(StageParam::InputResistance, lowPass ? 10000.0 : 100000.0);
+                        const double capacitance = stage.params.get(StageParam::CouplingCapacitance, 1e-8);
+                        addPack(prefix, "Stage " + std::to_string(i) + ": " + stage.name,
+                                {{"R", resistance}, {"C", capacitance}});
+                        types.push_back(std::string(lowPass ? "LiveSpiceDSP::StaticRCLowPass<" : "LiveSpiceDSP::StaticRCHighPass<")
+                                        + prefix + ">");
+                        break;
+                    }
+
+                    case StageType::GainStage:
+                    case StageType::OutputBuffer: {
+                        const double gain = stage.type == StageType::OutputBuffer ? 0.5 : stage.params.get(StageParam::GainLinear, 1.0);
+                        addPack(prefix, "Stage " + std::to_string(i) + ": " + stage.name, {{"gain", gain}});
+                        types.push_back("LiveSpiceDSP::StaticGain<" + prefix + ">");
+                        break;
+                    }
+
+                    case StageType::OpAmpClipping:
+                    case StageType::DiodeClipper: {
+                        // Without a diode of its own the stage clips with 1N4148s, as the stage chain does
+                        const bool hasDiode = std::any_of(stage.nonlinearComponents.begin(), stage.nonlinearComponents.end(),
+                                                          [](const auto& nonlinear) { return nonlinear.diodeChar.has_value(); });
+                        if (!hasDiode) {
+                            addClipper(prefix, "Stage " + std::to_string(i) + ": " + stage.name + " (1N4148)",
+                                       Nonlinear::DiodeCharacteristics::Si1N4148());
+                        }
+                        break;
+                    }
+
+                    default:
+                        // Not modelled on the per-sample path either
+                        types.push_back("LiveSpiceDSP::StaticPassThrough /* " + stage.name + " */");
+                        break;
+                }
+
+                size_t diodeIndex = 0;
+                for (const auto& nonlinear : stage.nonlinearComponents) {
+                    if (nonlinear.diodeChar.has_value()) {
+                        addClipper(prefix + "_D" + std::to_string(diodeIndex++), nonlinear.name, *nonlinear.diodeChar);
+                    }
+                }
+            }
+
+            std::stringstream header;
+            header << R"(/*
+  ==============================================================================
+    Auto-generated compile-time circuit description
+    Component values are constants and the stages a type list, so the whole
+    chain inlines into CircuitProcessor::processBlock
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../../StaticChain.h"
+
+namespace CircuitChain {
+
+)";
+            header << values.str();
+            header << "using Chain = LiveSpiceDSP::StaticChain<";
+            for (size_t i = 0; i < types.size(); ++i) {
+                header << (i == 0 ? "\n    " : ",\n    ") << types[i];
+            }
+            header << ">;\n\n";
+            header << "}  // namespace CircuitChain\n";
+
+            plan.numStages = types.size();
+            plan.header = header.str();
+            return plan;
+        }
+
+        // ====================================================================
+        // Subcircuit tables: clipper stages -> LiveSpiceDSP::SubcircuitTable
+        // ====================================================================
+
+        /**
+         * One clipper stage pre-solved into a table. Stages carry their op-amp
+         * and diodes but not the resistors around them, so the feedback
+         * clipper takes the Tube Screamer values (4.7k to ground, 51k plus a
+         * 500k drive pot) and the diodes to ground sit behind the 10k of
+         * DiodeClippingStage; pots in the stage replace the variable legs.
+         */
+        struct SubcircuitTablePlan {
+            size_t stage = 0;
+            bool feedback = false;                 // Op-amp feedback clipper (else diodes to ground)
+            std::string partNumber;
+            Nonlinear::DiodeCharacteristics diode = Nonlinear::DiodeCharacteristics::Si1N4148();
+            LiveSpiceDSP::DiodeFeedbackClipper feedbackCircuit;
+            LiveSpiceDSP::DiodesToGroundClipper groundCircuit;
+            std::vector<JuceParameter> knobs;      // Parameter behind each table control, in order
+        };
+
+        // The stage chain with the tabled stages' diodes taken out
+        struct SubcircuitStageChain {
+            std::vector<SubcircuitTablePlan> tables;
+            std::vector<CircuitStage> stages;
+            std::set<size_t> tabled;
+        };
+
+        SubcircuitStageChain applySubcircuitTables(const std::vector<CircuitStage>& stages,
+                                                   const std::vector<JuceParameter>& parameters,
+                                                   const std::string& gainParamId) {
+            SubcircuitStageChain chain{{}, stages, {}};
+            for (size_t i = 0; i < chain.stages.size(); ++i) {
+                auto& stage = chain.stages[i];
+                if (stage.type != StageType::OpAmpClipping && stage.type != StageType::DiodeClipper) {
+                    continue;
+                }
+                auto& nonlinear = stage.nonlinearComponents;
+                const auto diode = std::find_if(nonlinear.begin(), nonlinear.end(),
+                                                [](const auto& component) { return component.diodeChar.has_value(); });
+                if (diode == nonlinear.end()) {
+                    continue;
+                }
+
+                SubcircuitTablePlan plan;
+                plan.stage = i;
+                plan.feedback = stage.type == StageType::OpAmpClipping;
+                plan.partNumber = diode->partNumber.empty() ? "1N4148" : diode->partNumber;
+                plan.diode = *diode->diodeChar;
+
+                // Pots of the stage, in component order, then the drive knob
+                // for a feedback clipper that has none of its own
+                std::vector<std::pair<JuceParameter, double>> pots;
+                for (const auto& comp : stage.components) {
+                    if (!comp) continue;
+                    const auto param = std::find_if(parameters.begin(), parameters.end(),
+                                                    [&](const auto& p) { return p.componentName == comp->getName(); });
+                    if (param != parameters.end() && param->id != "bypass") {
+                        pots.emplace_back(*param, comp->getParamValueAsDouble("Resistance"));
+                    }
+                }
+                if (plan.feedback && pots.empty() && !gainParamId.empty()) {
+                    const auto drive = std::find_if(parameters.begin(), parameters.end(),
+                                                    [&](const auto& p) { return p.id == gainParamId; });
+                    pots.emplace_back(*drive, 0.0);
+                }
+
+                auto potValue = [&](size_t k, double fallback) { return pots[k].second > 0.0 ? pots[k].second : fallback; };
+                if (plan.feedback) {
+                    plan.feedbackCircuit.feedback = {51000.0, pots.size() > 0 ? potValue(0, 500000.0) : 0.0};
+                    if (pots.empty()) plan.feedbackCircuit.feedback.fixed += 250000.0;   // Drive pot at half
+                    plan.feedbackCircuit.ground = {4700.0, pots.size() > 1 ? potValue(1, 10000.0) : 0.0};
+                    pots.resize(std::min<size_t>(pots.size(), 2));
+                } else {
+                    plan.groundCircuit.series = {10000.0, pots.size() > 0 ? potValue(0, 100000.0) : 0.0};
+                    pots.resize(std::min<size_t>(pots.size(), 1));
+                }
+                for (const auto& pot : pots) {
+                    plan.knobs.push_back(pot.first);
+                }
+
+                nonlinear.erase(std::remove_if(nonlinear.begin(), nonlinear.end(),
+                                               [](const auto& component) { return component.diodeChar.has_value(); }),
+                                nonlinear.end());
+                chain.tables.push_back(std::move(plan));
+                chain.tabled.insert(i);
+            }
+            return chain;
+        }
+
+        // Table control values for a plan's knobs at this block's parameter values
+        std::string subcircuitControls(const SubcircuitTablePlan& plan) {
+            if (plan.knobs.empty()) {
+                return "{}";
+            }
+            std::string controls = "{{ ";
+            for (size_t k = 0; k < plan.knobs.size(); ++k) {
+                const auto& knob = plan.knobs[k];
+                std::string position = knob.id + "Value";
+                if (knob.minValue != 0.0f || knob.maxValue != 1.0f) {
+                    position = "(" + position + " - " + doubleLiteral(knob.minValue) + "f) / "
+                        + doubleLiteral(static_cast<double>(knob.maxValue) - knob.minValue) + "f";
+                }
+                controls += (k > 0 ? ", " : "") + ("juce::jlimit(0.0f, 1.0f, " + position + ")");
+            }
+            return controls + " }}";
+        }
+    }
+
+    std::string JuceDSPGenerator::generateProcessorHeader() {
+        std::stringstream ss;
+        
+        ss << R"(/*
+  ==============================================================================
+    Auto-generated JUCE Audio Processor
+    Generated from LiveSpice circuit analysis
+    Using LiveSPICE Component DSP Library
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_dsp/juce_dsp.h>
+#include <cmath>
+
+// LiveSPICE Component Library
+#include "../../third_party/livespice-components/ComponentModels.h"
+#include "../../third_party/livespice-components/DSPImplementations.h"
+)";
+
+        if (m_svfToneStack && m_useBetaFeatures) {
+            ss << "\n// TPT state-variable filters for the tone stack\n";
+            ss << "#include \"../../StateSpaceFilter.h\"\n";
+        }
+
+        if (m_waveshaperTables) {
+            ss << "\n// Baked clipper curves with antiderivative antialiasing\n";
+            ss << "#include \"../../DiodeModels.h\"\n";
+            ss << "#include \"../../Waveshaper.h\"\n";
+            if (bakesShapersInBackground()) {
+                ss << "#include \"../../TableRebuildWorker.h\"\n";
+                ss << "#include <atomic>\n";
+            }
+        }
+
+        ss << R"(
+class CircuitProcessor : public juce::AudioProcessor
+{
+public:
+    CircuitProcessor();
+    ~CircuitProcessor() override;
+
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override;
+    void releaseResources() override;
+    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    juce::AudioProcessorEditor* createEditor() override;
+    bool hasEditor() const override;
+
+    const juce::String getName() const override;
+    bool acceptsMidi() const override;
+    bool producesMidi() const override;
+    bool isMidiEffect() const override;
+    double getTailLengthSeconds() const override;
+
+    int getNumPrograms() override;
+    int getCurrentProgram() override;
+    void setCurrentProgram (int index) override;
+    const juce::String getProgramName (int index) override;
+    void changeProgramName (int index, const juce::String& newName) override;
+
+    void getStateInformation (juce::MemoryBlock& destData) override;
+    void setStateInformation (const void* data, int sizeInBytes) override;
+
+private:
+    // DSP State Variables
+)";
+
+        return ss.str();
+    }
+
+    std::string JuceDSPGenerator::generateStateVariables(const std::vector<CircuitStage>& stages) {
+        std::stringstream ss;
+        
+        const bool simdFilters = usesSimdFilters(stages);
+        const std::string filterType = simdFilters ? "juce::dsp::IIR::Filter<SIMDFloat>" : "juce::dsp::IIR::Filter<float>";
+        if (simdFilters) {
+            ss << generateSimdMembers();
+        }
+
+        ss << "    // ========================================================================\n";
+        ss << "    // LiveSPICE Component Processors - Real-time audio DSP\n";
+        ss << "    // ========================================================================\n\n";
+        
+        // Track which processor types we need
+        bool needsResistor = false;
+        bool needsCapacitor = false;
+        bool needsDiode = false;
+        bool needsOpAmp = false;
+        
+        for (size_t i = 0; i < stages.size(); ++i) {
+            const auto& stage = stages[i];
+            
+            ss << "    // Stage " << i << ": " << stage.name << "\n";
+            ss << "    // DSP Mapping: " << stage.dspDescription << "\n";
+
+            const bool isToneControl = isLikelyToneStackStage(stage);
+            if (m_useBetaFeatures && isToneControl) {
+                writeToneStackMembers(ss, i, filterType);
+                ss << "\n";
+                continue;
+            }
+            
+            // Determine which LiveSPICE processors to use based on stage type and DSP mapping
+            switch (stage.type) {
+                case StageType::HighPassFilter:
+                case StageType::LowPassFilter:
+                case StageType::InputBuffer: {
+                    if (foldsFixedRC(stage)) {
+                        writeFoldedRCMembers(ss, stage, i);
+                        break;
+                    }
+                    // RC filter using LiveSPICE components
+                    ss << "    LiveSpiceDSP::BasicResistorProcessor<float> stage" << i << "_resistor;\n";
+                    ss << "    LiveSpiceDSP::BasicCapacitorProcessor<float> stage" << i << "_capacitor;\n";
+                    needsResistor = true;
+                    needsCapacitor = true;
+                    break;
+                }
+                    
+                case StageType::GainStage:
+                    // Keep JUCE gain for simple amplification
+                    ss << "    juce::dsp::Gain<float> stage" << i << "_gain;\n";
+                    break;
+                    
+                case StageType::OpAmpClipping:
+                case StageType::DiodeClipper: {
+                    if (m_waveshaperTables) {
+                        ss << "    std::array<LiveSpiceDSP::WaveshaperADAA, 2> stage" << i << "_shaper;\n";
+                        break;
+                    }
+                    // Use LiveSPICE diode processors for clipping
+                    ss << "    LiveSpiceDSP::DiodeProcessor stage" << i << "_diode1;\n";
+                    ss << "    LiveSpiceDSP::DiodeProcessor stage" << i << "_diode2;\n";
+                    ss << "    LiveSpiceDSP::OpAmpProcessor stage" << i << "_opamp;\n";
+                    needsDiode = true;
+                    needsOpAmp = true;
+                    break;
+                }
+                    
+                case StageType::OutputBuffer:
+                    ss << "    juce::dsp::Gain<float> stage" << i << "_gain;\n";
+                    break;
+                    
+                default:
+                    ss << "    // TODO: Map to appropriate LiveSPICE processor\n";
+                    break;
+            }
+            ss << "\n";
+        }
+        
+        if (bakesShapersInBackground() && hasShaperStage(stages)) {
+            ss << "    // Clipper curve baked on the table worker\n";
+            ss << "    std::shared_ptr<const LiveSpiceDSP::WaveshaperTable> bakedClipperTable;\n";
+            ss << "    std::atomic<bool> clipperTableReady { false };\n\n";
+        }
+
+        ss << "    // Sample rate for DSP processing\n";
+        ss << "    double currentSampleRate = 44100.0;\n";
+        ss << "\n    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CircuitProcessor)\n";
+        ss << "};\n";
+        
+        return ss.str();
+    }
+
+    std::string JuceDSPGenerator::generatePrepareToPlayCode(const std::vector<CircuitStage>& stages,
+                                                            const std::string& extraInit) {
+        CodeEmitter out(estimateCodeSize(stages.size(), 1024, 512) + extraInit.size());
+        writePrepareToPlayCode(out, stages, extraInit);
+        return out.take();
+    }
+
+    void JuceDSPGenerator::writePrepareToPlayCode(std::ostream& ss, const std::vector<CircuitStage>& stages,
+                                                  const std::string& extraInit,
+                                                  const std::set<size_t>& subcircuitTables)
+    {
+        ss << R"(void CircuitProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+    currentSampleRate = sampleRate;
+    juce::dsp::ProcessSpec spec;
+    spec.sampleRate = sampleRate;
+    spec.maximumBlockSize = (juce::uint32) samplesPerBlock;
+    spec.numChannels = 2;
+
+    // ========================================================================
+    // Initialize LiveSPICE Component Processors
+    // ========================================================================
+
+)";
+
+        if (usesSimdFilters(stages)) {
+            ss << "    // One SIMD frame per sample, channel c in lane c\n";
+            ss << "    simdLanes = juce::dsp::AudioBlock<SIMDFloat> (simdLaneData, 1, spec.maximumBlockSize);\n\n";
+        }
+
+        emitFragments(ss, stages.size(), fragmentThreads(stages.size()), [&](std::ostream& fragment, size_t i) {
+            const auto& stage = stages[i];
+            
+            fragment << "    // Stage " << i << ": " << stage.name << "\n";
+
+            if (subcircuitTables.count(i) > 0) {
+                fragment << "    // Pre-solved subcircuit table: no state, nothing to prepare\n\n";
+                return;
+            }
+            
+            // Beta mode: Initialize optimized filters based on pattern
+            const bool isToneControl = isLikelyToneStackStage(stage);
+            if (m_useBetaFeatures && isToneControl) {
+                fragment << "    // [BETA] Tone stack filter setup\n";
+                if (m_svfToneStack) {
+                    fragment << "    for (size_t channel = 0; channel < 2; ++channel)\n";
+                    fragment << "    {\n";
+                    fragment << "        stage" << i << "_toneLow[channel].setParameters(LiveSpiceDSP::SVFFilter::Type::LowShelf, 120.0f, 0.707f, 3.0f);\n";
+                    fragment << "        stage" << i << "_toneMid[channel].setParameters(LiveSpiceDSP::SVFFilter::Type::Bell, 1000.0f, 0.707f, -2.0f);\n";
+                    fragment << "        stage" << i << "_toneHigh[channel].setParameters(LiveSpiceDSP::SVFFilter::Type::HighShelf, 4500.0f, 0.707f, 3.0f);\n";
+                    fragment << "        for (auto* band : { &stage" << i << "_toneLow[channel], &stage" << i << "_toneMid[channel], &stage" << i << "_toneHigh[channel] })\n";
+                    fragment << "        {\n";
+                    fragment << "            band->setSampleRate((float) sampleRate);\n";
+                    fragment << "            band->reset();\n";
+                    fragment << "        }\n";
+                    fragment << "    }\n\n";
+                    return;
+                }
+                if (m_sharedState) {
+                    fragment << "    const auto stage" << i << "_tone = shared->toneCoefficients.acquire(sampleRate, [](double rate) {\n";
+                    fragment << "        return std::array<juce::dsp::IIR::Coefficients<float>, 3> {\n";
+                    fragment << "            *juce::dsp::IIR::Coefficients<float>::makeLowShelf(rate, 120.0f, 0.707f, juce::Decibels::decibelsToGain(3.0f)),\n";
+                    fragment << "            *juce::dsp::IIR::Coefficients<float>::makePeakFilter(rate, 1000.0f, 0.707f, juce::Decibels::decibelsToGain(-2.0f)),\n";
+                    fragment << "            *juce::dsp::IIR::Coefficients<float>::makeHighShelf(rate, 4500.0f, 0.707f, juce::Decibels::decibelsToGain(3.0f)) };\n";
+                    fragment << "    });\n";
+                    fragment << "    *stage" << i << "_toneLow.state = (*stage" << i << "_tone)[0];\n";
+                    fragment << "    *stage" << i << "_toneMid.state = (*stage" << i << "_tone)[1];\n";
+                    fragment << "    *stage" << i << "_toneHigh.state = (*stage" << i << "_tone)[2];\n";
+                    fragment << "    stage" << i << "_toneLow.prepare(spec);\n";
+                    fragment << "    stage" << i << "_toneMid.prepare(spec);\n";
+                    fragment << "    stage" << i << "_toneHigh.prepare(spec);\n\n";
+                    return;
+                }
+                fragment << "    *stage" << i << "_toneLow.state = *juce::dsp::IIR::Coefficients<float>::makeLowShelf(sampleRate, 120.0f, 0.707f, juce::Decibels::decibelsToGain(3.0f));\n";
+                fragment << "    *stage" << i << "_toneMid.state = *juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate, 1000.0f, 0.707f, juce::Decibels::decibelsToGain(-2.0f));\n";
+                fragment << "    *stage" << i << "_toneHigh.state = *juce::dsp::IIR::Coefficients<float>::makeHighShelf(sampleRate, 4500.0f, 0.707f, juce::Decibels::decibelsToGain(3.0f));\n";
+                fragment << "    stage" << i << "_toneLow.prepare(spec);\n";
+                fragment << "    stage" << i << "_toneMid.prepare(spec);\n";
+                fragment << "    stage" << i << "_toneHigh.prepare(spec);\n\n";
+                return;
+            }
+
+            if (m_useBetaFeatures && stage.patternStrategy == "cascaded_biquad" && stage.patternConfidence >= 0.8) {
+                const double* lpfc = stage.params.find(StageParam::CutoffFrequency);
+                const double* hpfc = stage.params.find(StageParam::HighpassFrequency);
+                
+                if (stage.type == StageType::LowPassFilter && lpfc) {
+                    double fc = *lpfc;
+                    fragment << "    // [BETA] Optimized low-pass biquad\n";
+                    fragment << "    *stage" << i << "_lpf.state = *juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, " 
+                       << fc << "f);\n";
+                    fragment << "    stage" << i << "_lpf.prepare(spec);\n\n";
+                    
+                } else if ((stage.type == StageType::HighPassFilter || stage.type == StageType::InputBuffer) && hpfc) {
+                    double fc = *hpfc;
+                    fragment << "    // [BETA] Optimized high-pass biquad\n";
+                    fragment << "    *stage" << i << "_hpf.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, " 
+                       << fc << "f);\n";
+                    fragment << "    stage" << i << "_hpf.prepare(spec);\n\n";
+                } else {
+                    fragment << "    // [BETA] No frequency params, skipping filter init\n\n";
+                }
+                return; // Skip stable initialization
+            }
+            
+            // Stable mode: Use LiveSPICE component initialization
+            switch (stage.type) {
+                case StageType::HighPassFilter:
+                case StageType::InputBuffer: {
+                    if (foldsFixedRC(stage)) {
+                        writeFoldedRCPrepare(fragment, stage, i);
+                        break;
+                    }
+                    double resistance = stage.params.get(StageParam::InputResistance, 100000.0);
+                    double capacitance = stage.params.get(StageParam::CouplingCapacitance, 1e-8);
+                    double frequency = stage.params.get(StageParam::HighpassFrequency, 72.0);
+                    
+                    fragment << "    // RC High-Pass Filter: f = " << frequency << " Hz\n";
+                    fragment << "    stage" << i << "_resistor.prepare(" << resistance << ");\n";
+                    fragment << "    stage" << i << "_capacitor.prepare(" << capacitance << ", 0.1, sampleRate); // " 
+                       << capacitance << " F with 0.1Ω ESR\n\n";
+                    break;
+                }
+                
+                case StageType::LowPassFilter: {
+                    if (foldsFixedRC(stage)) {
+                        writeFoldedRCPrepare(fragment, stage, i);
+                        break;
+                    }
+                    double resistance = stage.params.get(StageParam::InputResistance, 10000.0);
+                    double capacitance = stage.params.get(StageParam::CouplingCapacitance, 1e-8);
+                    double frequency = stage.params.get(StageParam::CutoffFrequency, 15915.0);
+                    
+                    fragment << "    // RC Low-Pass Filter: fc = " << frequency << " Hz\n";
+                    fragment << "    stage" << i << "_resistor.prepare(" << resistance << ");\n";
+                    fragment << "    stage" << i << "_capacitor.prepare(" << capacitance << ", 0.1, sampleRate);\n\n";
+                    break;
+                }
+                
+                case StageType::GainStage: {
+                    if (const double* gain = stage.params.find(StageParam::GainLinear)) {
+                        fragment << "    stage" << i << "_gain.setGainLinear(" << *gain << "f);\n";
+                        fragment << "    stage" << i << "_gain.prepare(spec);\n\n";
+                    } else {
+                        fragment << "    stage" << i << "_gain.setGainLinear(1.0f);\n";
+                        fragment << "    stage" << i << "_gain.prepare(spec);\n\n";
+                    }
+                    break;
+                }
+                
+                case StageType::OpAmpClipping:
+                case StageType::DiodeClipper: {
+                    if (m_waveshaperTables && m_sharedState) {
+                        const std::string shaper = "stage" + std::to_string(i) + "_shaper";
+                        fragment << "    // Baked diode-pair curve from the shared state\n";
+                        fragment << "    for (auto& shaper : " << shaper << ")\n";
+                        fragment << "    {\n";
+                        fragment << "        shaper.setTable(shared->clipperTable);\n";
+                        fragment << "        shaper.reset();\n";
+                        fragment << "    }\n\n";
+                        break;
+                    }
+                    if (bakesShapersInBackground()) {
+                        // Every shaper stage asks for the same curve; the worker bakes it once
+                        const std::string shaper = "stage" + std::to_string(i) + "_shaper";
+                        fragment << "    // 1N4148 pair behind 10k, baked on the table worker; a hard clip stands in until it lands\n";
+                        fragment << "    if (! clipperTableReady.load (std::memory_order_acquire))\n";
+                        fragment << "        LiveSpiceDSP::TableRebuildWorker::shared().schedule (this, [this] {\n";
+                        fragment << "            if (clipperTableReady.load (std::memory_order_acquire))\n";
+                        fragment << "                return true;\n";
+                        fragment << "            const Nonlinear::DiodeLUT diode(Nonlinear::DiodeCharacteristics::Si1N4148());\n";
+                        fragment << "            bakedClipperTable = std::make_shared<const LiveSpiceDSP::WaveshaperTable>(\n";
+                        fragment << "                LiveSpiceDSP::WaveshaperTable::diodePair(diode, diode));\n";
+                        fragment << "            clipperTableReady.store (true, std::memory_order_release);\n";
+                        fragment << "            return true;\n";
+                        fragment << "        });\n";
+                        fragment << "    for (auto& shaper : " << shaper << ") shaper.reset();\n\n";
+                        break;
+                    }
+                    if (m_waveshaperTables) {
+                        // The curve does not depend on the rate: bake it on the first prepare
+                        const std::string shaper = "stage" + std::to_string(i) + "_shaper";
+                        fragment << "    // 1N4148 pair behind 10k, baked into a cubic table shared by both channels\n";
+                        fragment << "    if (" << shaper << "[0].getTable() == nullptr) {\n";
+                        fragment << "        const Nonlinear::DiodeLUT diode(Nonlinear::DiodeCharacteristics::Si1N4148());\n";
+                        fragment << "        auto table = std::make_shared<const LiveSpiceDSP::WaveshaperTable>(\n";
+                        fragment << "            LiveSpiceDSP::WaveshaperTable::diodePair(diode, diode));\n";
+                        fragment << "        for (auto& shaper : " << shaper << ") shaper.setTable(table);\n";
+                        fragment << "    }\n";
+                        fragment << "    for (auto& shaper : " << shaper << ") shaper.reset();\n\n";
+                        break;
+                    }
+                    fragment << "    // Diode clipping with Shockley equation\n";
+                    if (m_sharedState) {
+                        fragment << "    stage" << i << "_diode1.prepare(shared->clipperDiode, 25.0); // Silicon diode, 25°C\n";
+                        fragment << "    stage" << i << "_diode2.prepare(shared->clipperDiode, 25.0);\n";
+                        fragment << "    stage" << i << "_opamp.prepare(shared->clipperOpAmp, sampleRate); // Dual op-amp\n\n";
+                        break;
+                    }
+                    fragment << "    stage" << i << "_diode1.prepare(\"1N4148\", 25.0); // Silicon diode, 25°C\n";
+                    fragment << "    stage" << i << "_diode2.prepare(\"1N4148\", 25.0);\n";
+                    fragment << "    stage" << i << "_opamp.prepare(\"TL072\", sampleRate); // Dual op-amp\n\n";
+                    break;
+                }
+                
+                case StageType::OutputBuffer: {
+                    fragment << "    stage" << i << "_gain.setGainLinear(0.5f); // 50% output level\n";
+                    fragment << "    stage" << i << "_gain.prepare(spec);\n\n";
+                    break;
+                }
+                
+                default:
+                    fragment << "    // TODO: Initialize LiveSPICE processor\n\n";
+                    break;
+            }
+
+        });
+        
+        const auto diodeMembers = collectDiodeMembers(stages);
+        if (m_oversamplingFactor > 1 && !diodeMembers.empty()) {
+            ss << "    // Oversampled clippers: reset filters and report their latency\n";
+            for (const auto& member : diodeMembers) {
+                ss << "    for (auto& os : " << member.memberName << "_os) os.reset();\n";
+            }
+            ss << "    setLatencySamples(juce::roundToInt(" << diodeMembers.size() << " * "
+               << diodeMembers.front().memberName << "_os[0].getLatencySamples()));\n";
+        }
+
+        ss << extraInit;
+        
+        ss << "}\n\n";
+    }
+
+    std::string JuceDSPGenerator::generateProcessBlockCode(const std::vector<CircuitStage>& stages) {
+        std::stringstream ss;
+        
+        ss << R"(void CircuitProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    juce::ScopedNoDenormals noDenormals;
+    auto totalNumInputChannels  = getTotalNumInputChannels();
+    auto totalNumOutputChannels = getTotalNumOutputChannels();
+
+    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
+        buffer.clear (i, 0, buffer.getNumSamples());
+
+    // Check bypass parameter (bool)
+    bool bypassed = bypassParam->load() >= 0.5f;
+    if (bypassed)
+    {
+        // Bypass is ON - pass through without processing
+        return;
+    }
+
+)";
+        writeShaperPickup(ss, stages);
+
+        if (emitsBlockCode()) {
+            writeBlockProcessingCode(ss, stages, "", false);
+            ss << "}\n\n";
+            return ss.str();
+        }
+
+        ss << R"(    // ========================================================================
+    // LiveSPICE Component-Based DSP Processing
+    // Sample-by-sample processing for accurate component modeling
+    // ========================================================================
+
+    for (int channel = 0; channel < totalNumInputChannels; ++channel)
+    {
+        auto* channelData = buffer.getWritePointer(channel);
+        
+        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
         {
             float signal = channelData[sample];
             
@@ -493,21 +1742,18 @@ private:
 
             const bool isToneControl = isLikelyToneStackStage(stage);
             if (m_useBetaFeatures && isToneControl) {
-                ss << "            // [BETA] Tone stack (low/mid/high shelves)\n";
-                ss << "            signal = stage" << i << "_toneLow.processSample(signal);\n";
-                ss << "            signal = stage" << i << "_toneMid.processSample(signal);\n";
-                ss << "            signal = stage" << i << "_toneHigh.processSample(signal);\n\n";
+                writeToneStackSampleCode(ss, i);
                 continue;
             }
 
             if (m_useBetaFeatures && !stage.patternStrategy.empty() && stage.patternConfidence >= 0.8) {
                 ss << "            // [BETA] Pattern: " << stage.patternName << " (confidence: " << stage.patternConfidence << ")\n";
-                ss << generatePatternSpecificCode(stage, i);
+                writePatternSpecificCode(ss, stage, i);
             } else {
                 if (m_useBetaFeatures && !stage.patternStrategy.empty() && stage.patternConfidence < 0.8) {
                     ss << "            // [BETA] Low confidence pattern match, using stable code\n";
                 }
-                ss << generateStableLegacyCode(stage, i);
+                writeStableLegacyCode(ss, stage, i);
             }
         }
         
@@ -519,19 +1765,561 @@ private:
     juce::dsp::AudioBlock<float> block (buffer);
     juce::dsp::ProcessContextReplacing<float> context (block);
 
-)";
+)";
+
+        // Apply gain stages
+        for (size_t i = 0; i < stages.size(); ++i) {
+            const auto& stage = stages[i];
+            
+            if (stage.type == StageType::GainStage || stage.type == StageType::OutputBuffer) {
+                ss << "    stage" << i << "_gain.process(context);\n";
+            }
+        }
+        
+        ss << "}\n\n";
+        return ss.str();
+    }
+
+    bool JuceDSPGenerator::usesSimdFilters(const std::vector<CircuitStage>& stages) const {
+        if (!m_simdChannels || !m_useBetaFeatures) {
+            return false;
+        }
+
+        for (const auto& stage : stages) {
+            if (isLikelyToneStackStage(stage)) {
+                return true;
+            }
+            if (stage.patternStrategy == "cascaded_biquad" && stage.patternConfidence >= 0.8
+                && (stage.type == StageType::LowPassFilter
+                    || stage.type == StageType::HighPassFilter
+                    || stage.type == StageType::InputBuffer)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    double JuceDSPGenerator::estimateTailSeconds(const std::vector<CircuitStage>& stages) const {
+        // A one-pole section at f decays by 100 dB in ln(1e5) / (2 pi f) seconds
+        double lowest = 0.0;
+        for (const auto& stage : stages) {
+            for (StageParam param : {StageParam::HighpassFrequency, StageParam::CutoffFrequency}) {
+                const double* frequency = stage.params.find(param);
+                if (frequency && *frequency > 0.0 && (lowest == 0.0 || *frequency < lowest)) {
+                    lowest = *frequency;
+                }
+            }
+        }
+        const double tail = lowest > 0.0 ? std::log(1.0e5) / (2.0 * 3.14159265358979 * lowest) : 0.0;
+        return std::max(0.1, tail);
+    }
+
+    std::string JuceDSPGenerator::generateSimdMembers() const {
+        return R"(    // ========================================================================
+    // SIMD Channel Packing - channel c of the buffer runs in lane c, so one
+    // IIR pass over SIMD frames filters every channel with its own state
+    // ========================================================================
+
+    using SIMDFloat = juce::dsp::SIMDRegister<float>;
+
+    juce::HeapBlock<char> simdLaneData;
+    juce::dsp::AudioBlock<SIMDFloat> simdLanes;
+
+    juce::dsp::AudioBlock<SIMDFloat> packChannels (const juce::AudioBuffer<float>& buffer, int numChannels, int numSamples)
+    {
+        const int width = (int) SIMDFloat::size();
+        jassert (numChannels <= width && numSamples <= (int) simdLanes.getNumSamples());
+        auto* lanes = reinterpret_cast<float*> (simdLanes.getChannelPointer (0));
+
+        for (int lane = 0; lane < width; ++lane)
+        {
+            const float* source = lane < numChannels ? buffer.getReadPointer (lane) : nullptr;
+            for (int sample = 0; sample < numSamples; ++sample)
+                lanes[sample * width + lane] = source != nullptr ? source[sample] : 0.0f;
+        }
+
+        return simdLanes.getSubBlock (0, (size_t) numSamples);
+    }
+
+    void unpackChannels (juce::AudioBuffer<float>& buffer, int numChannels, int numSamples) const
+    {
+        const int width = (int) SIMDFloat::size();
+        const auto* lanes = reinterpret_cast<const float*> (simdLanes.getChannelPointer (0));
+
+        for (int channel = 0; channel < juce::jmin (numChannels, width); ++channel)
+        {
+            auto* destination = buffer.getWritePointer (channel);
+            for (int sample = 0; sample < numSamples; ++sample)
+                destination[sample] = lanes[sample * width + channel];
+        }
+    }
+
+)";
+    }
+
+    unsigned JuceDSPGenerator::fragmentThreads(size_t stageCount) const {
+        if (stageCount < PARALLEL_MIN_STAGES) {
+            return 1;
+        }
+        return m_jobs != 0 ? m_jobs : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    bool JuceDSPGenerator::foldsFixedRC(const CircuitStage& stage) const {
+        if (!m_foldFixedNetworks) {
+            return false;
+        }
+        if (stage.type != StageType::HighPassFilter
+            && stage.type != StageType::LowPassFilter
+            && stage.type != StageType::InputBuffer) {
+            return false;
+        }
+
+        // Potentiometer-dependent networks stay on the runtime component models
+        for (const auto& comp : stage.components) {
+            if (comp && (comp->getType() == ComponentType::Potentiometer
+                         || comp->getType() == ComponentType::VariableResistor)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::vector<JuceDSPGenerator::StageInput> JuceDSPGenerator::classifyStageInputs(
+        const CircuitStage& stage, const std::vector<JuceParameter>& parameters, const std::string& gainParamId) const
+    {
+        std::vector<StageInput> inputs = {{"signal", InputRate::Audio, ""}};
+
+        // Pots in the stage move with their knobs; everything else is fixed
+        size_t fixedValues = 0;
+        for (const auto& comp : stage.components) {
+            if (!comp) continue;
+            const auto param = std::find_if(parameters.begin(), parameters.end(),
+                                            [&](const auto& p) { return p.componentName == comp->getName(); });
+            if (param != parameters.end()) {
+                inputs.push_back({param->name, InputRate::Control, param->id});
+            } else if (comp->getType() != ComponentType::Wire) {
+                ++fixedValues;
+            }
+        }
+
+        const bool gainStage = stage.type == StageType::GainStage || stage.type == StageType::OutputBuffer;
+        if (gainStage && !gainParamId.empty()
+            && std::none_of(inputs.begin(), inputs.end(), [&](const auto& in) { return in.source == gainParamId; })) {
+            inputs.push_back({"gain", InputRate::Control, gainParamId});
+        }
+        if (fixedValues > 0 || !stage.nonlinearComponents.empty()) {
+            inputs.push_back({"components", InputRate::Constant, ""});
+        }
+        return inputs;
+    }
+
+    bool JuceDSPGenerator::rampsControlGain(const CircuitStage& stage, const std::string& gainParamId) const {
+        return usesControlRate() && !gainParamId.empty()
+            && (stage.type == StageType::GainStage || stage.type == StageType::OutputBuffer)
+            && !(m_useBetaFeatures && isLikelyToneStackStage(stage));
+    }
+
+    void JuceDSPGenerator::writeToneStackMembers(std::ostream& ss, size_t stageIndex, const std::string& filterType) const {
+        const std::string type = m_svfToneStack ? "std::array<LiveSpiceDSP::SVFFilter, 2>" : filterType;
+        ss << "    // [BETA] Tone stack filters (low/mid/high)" << (m_svfToneStack ? ", TPT state-variable per channel" : "") << "\n";
+        ss << "    " << type << " stage" << stageIndex << "_toneLow;\n";
+        ss << "    " << type << " stage" << stageIndex << "_toneMid;\n";
+        ss << "    " << type << " stage" << stageIndex << "_toneHigh;\n";
+    }
+
+    void JuceDSPGenerator::writeToneStackSampleCode(std::ostream& ss, size_t stageIndex) const {
+        const std::string call = m_svfToneStack ? "[(size_t) juce::jmin(channel, 1)].process(signal);\n" : ".processSample(signal);\n";
+        ss << "            // [BETA] Tone stack (low/mid/high shelves)\n";
+        ss << "            signal = stage" << stageIndex << "_toneLow" << call;
+        ss << "            signal = stage" << stageIndex << "_toneMid" << call;
+        ss << "            signal = stage" << stageIndex << "_toneHigh" << call << "\n";
+    }
+
+    void JuceDSPGenerator::writeFoldedRCMembers(std::ostream& ss, const CircuitStage& stage, size_t stageIndex) const {
+        const bool lowPass = stage.type == StageType::LowPassFilter;
+        const double resistance = stage.params.get(StageParam::InputResistance, lowPass ? 10000.0 : 100000.0);
+        const double capacitance = stage.params.get(StageParam::CouplingCapacitance, 1e-8);
+        const std::string prefix = "stage" + std::to_string(stageIndex);
+
+        ss << "    // Fixed RC " << (lowPass ? "low-pass" : "high-pass") << " folded to a bilinear one-pole\n";
+        ss << "    static constexpr double " << prefix << "_tau = " << resistance << " * " << capacitance << "; // R*C seconds\n";
+        ss << "    float " << prefix << "_b0 = 1.0f, " << prefix << "_b1 = 0.0f, " << prefix << "_a1 = 0.0f;\n";
+        ss << "    std::array<float, 2> " << prefix << "_x1 {}, " << prefix << "_y1 {};\n";
+    }
+
+    void JuceDSPGenerator::writeFoldedRCPrepare(std::ostream& ss, const CircuitStage& stage, size_t stageIndex) const {
+        const bool lowPass = stage.type == StageType::LowPassFilter;
+        const double frequency = lowPass ? stage.params.get(StageParam::CutoffFrequency, 15915.0)
+                                         : stage.params.get(StageParam::HighpassFrequency, 72.0);
+        const std::string prefix = "stage" + std::to_string(stageIndex);
+
+        ss << "    // RC " << (lowPass ? "Low" : "High") << "-Pass Filter: fc = " << frequency
+           << " Hz, coefficients for this sample rate\n";
+        ss << "    {\n";
+        ss << "        const double k = 2.0 * " << prefix << "_tau * sampleRate;\n";
+        if (lowPass) {
+            ss << "        " << prefix << "_b0 = (float) (1.0 / (1.0 + k));\n";
+            ss << "        " << prefix << "_b1 = " << prefix << "_b0;\n";
+        } else {
+            ss << "        " << prefix << "_b0 = (float) (k / (1.0 + k));\n";
+            ss << "        " << prefix << "_b1 = -" << prefix << "_b0;\n";
+        }
+        ss << "        " << prefix << "_a1 = (float) ((1.0 - k) / (1.0 + k));\n";
+        ss << "        " << prefix << "_x1.fill(0.0f);\n";
+        ss << "        " << prefix << "_y1.fill(0.0f);\n";
+        ss << "    }\n\n";
+    }
+
+    void JuceDSPGenerator::writeShaperPickup(std::ostream& ss, const std::vector<CircuitStage>& stages,
+                                             const std::set<size_t>& subcircuitTables) const {
+        if (!bakesShapersInBackground()) {
+            return;
+        }
+        std::vector<std::string> shapers;
+        for (size_t i = 0; i < stages.size(); ++i) {
+            const bool clipper = stages[i].type == StageType::OpAmpClipping || stages[i].type == StageType::DiodeClipper;
+            if (clipper && subcircuitTables.count(i) == 0) {
+                shapers.push_back("stage" + std::to_string(i) + "_shaper");
+            }
+        }
+        if (shapers.empty()) {
+            return;
+        }
+        // Only a shared_ptr copy on the audio thread; the old (empty) table frees nothing
+        ss << "    // Clipper curve: taken up once the table worker has published it\n";
+        ss << "    if (" << shapers.front() << "[0].getTable() == nullptr && clipperTableReady.load (std::memory_order_acquire))\n";
+        ss << "    {\n";
+        for (const auto& shaper : shapers) {
+            ss << "        for (auto& shaper : " << shaper << ") shaper.setTable (bakedClipperTable);\n";
+        }
+        ss << "    }\n\n";
+    }
+
+    void JuceDSPGenerator::writeSharedStateMembers(std::ostream& ss, const std::vector<CircuitStage>& stages,
+                                                   bool useDK, const std::set<size_t>& subcircuitTables) const {
+        // Same routing as writePrepareToPlayCode: which stages reach the stable
+        // clipper branch, and whether a beta IIR tone stack is built
+        bool stableClipper = false, iirToneStack = false;
+        for (size_t i = 0; i < stages.size(); ++i) {
+            const auto& stage = stages[i];
+            if (subcircuitTables.count(i) > 0) {
+                continue;   // Static table data, already shared
+            }
+            const bool toneControl = isLikelyToneStackStage(stage);
+            if (m_useBetaFeatures && toneControl) {
+                iirToneStack = iirToneStack || !m_svfToneStack;
+                continue;
+            }
+            if (m_useBetaFeatures && stage.patternStrategy == "cascaded_biquad" && stage.patternConfidence >= 0.8) {
+                continue;
+            }
+            stableClipper = stableClipper || stage.type == StageType::OpAmpClipping || stage.type == StageType::DiodeClipper;
+        }
+
+        ss << "    // ========================================================================\n";
+        ss << "    // Shared State - built by the first instance in the process, released\n";
+        ss << "    // with the last; instances below keep only their mutable state\n";
+        ss << "    // ========================================================================\n\n";
+        ss << "    struct SharedState\n";
+        ss << "    {\n";
+
+        bool empty = true;
+        auto section = [&](const char* comment) {
+            ss << (empty ? "" : "\n") << "        // " << comment << "\n";
+            empty = false;
+        };
+
+        std::set<std::string> parts;
+        auto writePart = [&](const std::string& type, const std::string& kind, const std::string& partNumber,
+                             const std::string& initializer) {
+            const std::string name = sharedPartName(kind, partNumber);
+            if (parts.empty()) section("Device parameters, resolved from the databases once");
+            if (parts.insert(name).second) {
+                ss << "        const " << type << " " << name << " = " << initializer << ";\n";
+            }
+        };
+        for (const auto& member : collectDiodeMembers(stages)) {
+            writePart("Nonlinear::DiodeCharacteristics", "diode", member.partNumber, diodeInitializer(member.partNumber));
+        }
+        for (const auto& member : collectBJTMembers(stages)) {
+            writePart("Nonlinear::BJTCharacteristics", "bjt", member.partNumber, bjtInitializer(member.partNumber));
+        }
+        for (const auto& member : collectFETMembers(stages)) {
+            writePart("Nonlinear::FETCharacteristics", "fet", member.partNumber, fetInitializer(member.partNumber));
+        }
+
+        if (stableClipper && m_waveshaperTables) {
+            section("1N4148 pair behind 10k, baked once for every instance and channel");
+            ss << "        const std::shared_ptr<const LiveSpiceDSP::WaveshaperTable> clipperTable =\n";
+            ss << "            std::make_shared<const LiveSpiceDSP::WaveshaperTable>(LiveSpiceDSP::WaveshaperTable::diodePair(\n";
+            ss << "                Nonlinear::DiodeLUT(Nonlinear::DiodeCharacteristics::Si1N4148()),\n";
+            ss << "                Nonlinear::DiodeLUT(Nonlinear::DiodeCharacteristics::Si1N4148())));\n";
+        } else if (stableClipper) {
+            section("Clipper stage models");
+            ss << "        const LiveSpiceComponents::DiodeModel clipperDiode = LiveSpiceComponents::DiodeModel::getModel(\"1N4148\");\n";
+            ss << "        const LiveSpiceComponents::OpAmpModel clipperOpAmp = LiveSpiceComponents::OpAmpModel::getModel(\"TL072\");\n";
+        }
+
+        if (iirToneStack) {
+            section("Tone stack shelf/bell/shelf coefficients per sample rate");
+            ss << "        LiveSpiceDSP::SampleRateCache<std::array<juce::dsp::IIR::Coefficients<float>, 3>> toneCoefficients;\n";
+        }
+
+        if (useDK) {
+            section("Nodal DK model per sample rate");
+            ss << "        LiveSpiceDSP::SampleRateCache<LiveSpiceDSP::DKModel> dkModels;\n";
+        }
+
+        ss << "    };\n\n";
+        ss << "    const std::shared_ptr<SharedState> shared = LiveSpiceDSP::SharedContext<SharedState>::acquire();\n\n";
+    }
+
+    void JuceDSPGenerator::writeBlockProcessingCode(std::ostream& ss, const std::vector<CircuitStage>& stages,
+                                                    const std::string& gainParamId,
+                                                    bool withNonlinearMembers,
+                                                    const std::map<size_t, std::vector<std::string>>& wdfClippers,
+                                                    const std::set<size_t>& subcircuitTables) const
+    {
+        std::map<std::string, std::string> diodeMemberMap;
+        std::map<std::string, std::string> bjtMemberMap;
+        std::map<std::string, std::string> fetMemberMap;
+
+        if (withNonlinearMembers) {
+            for (const auto& member : collectDiodeMembers(stages)) {
+                diodeMemberMap[member.componentName] = member.memberName;
+            }
+            for (const auto& member : collectBJTMembers(stages)) {
+                bjtMemberMap[member.componentName] = member.memberName;
+            }
+            for (const auto& member : collectFETMembers(stages)) {
+                fetMemberMap[member.componentName] = member.memberName;
+            }
+        }
+
+        // Each stage becomes one channel loop: a whole-buffer body (IIR filter
+        // over the channel block, vector multiply, block call into the
+        // nonlinear model) or a tight per-sample loop around the same stable
+        // code the sample-by-sample path emits, since the LiveSPICE component
+        // processors only expose a sample API
+        struct StageBlock {
+            std::vector<std::string> filters;     // Mono juce::dsp filters run on the channel block
+            std::string sampleBody;               // Per-sample loop body (empty = none)
+            std::string vectorCode;               // Whole-buffer statements on channelData
+            bool blockGain = false;               // juce::dsp::Gain stage (applied after the chain)
+        };
+
+        std::vector<StageBlock> plan(stages.size());
+        bool needsBlock = false;
+        bool needsContext = false;
+
+        // Stages plan independently; only the block/context flags need them all
+        forEachSlice(stages.size(), fragmentThreads(stages.size()), [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const auto& stage = stages[i];
+                auto& out = plan[i];
+                const std::string prefix = "stage" + std::to_string(i);
+
+                auto stableStage = [&]() {
+                    switch (stage.type) {
+                        case StageType::HighPassFilter:
+                        case StageType::LowPassFilter:
+                        case StageType::InputBuffer:
+                            out.sampleBody = generateStableLegacyCode(stage, i);
+                            break;
+                        case StageType::OpAmpClipping:
+                        case StageType::DiodeClipper:
+                            if (bakesShapersInBackground()) {
+                                out.vectorCode = "        if (" + prefix + "_shaper[0].getTable() != nullptr)\n"
+                                    "            " + prefix + "_shaper[(size_t) juce::jmin(channel, 1)].processBlock(channelData, channelData, (size_t) numSamples);\n"
+                                    "        else // Curve still baking\n"
+                                    "            juce::FloatVectorOperations::clip(channelData, channelData, -0.6f, 0.6f, numSamples);\n";
+                            } else if (m_waveshaperTables) {
+                                out.vectorCode = "        " + prefix
+                                    + "_shaper[(size_t) juce::jmin(channel, 1)].processBlock(channelData, channelData, (size_t) numSamples);\n";
+                            } else {
+                                out.sampleBody = generateStableLegacyCode(stage, i);
+                            }
+                            break;
+                        default:
+                            break;
+                    }
+                    // Comment-only stage code does no work per sample, so it gets no loop
+                    if (!hasStatements(out.sampleBody)) {
+                        out.sampleBody.clear();
+                    }
+                };
+
+                const bool isToneControl = isLikelyToneStackStage(stage);
+                if (subcircuitTables.count(i) > 0) {
+                    out.vectorCode = "        " + prefix + "_subcircuit.processBlock(channelData, channelData, (size_t) numSamples, "
+                        + prefix + "_controls);\n";
+                } else if (m_useBetaFeatures && isToneControl && m_svfToneStack) {
+                    for (const char* band : {"_toneLow", "_toneMid", "_toneHigh"}) {
+                        out.vectorCode += "        " + prefix + band
+                            + "[(size_t) juce::jmin(channel, 1)].processBlock(channelData, channelData, (size_t) numSamples);\n";
+                    }
+                } else if (m_useBetaFeatures && isToneControl) {
+                    out.filters = {prefix + "_toneLow", prefix + "_toneMid", prefix + "_toneHigh"};
+                } else if (m_useBetaFeatures && !stage.patternStrategy.empty() && stage.patternConfidence >= 0.8) {
+                    const double* lpfc = stage.params.find(StageParam::CutoffFrequency);
+                    const double* hpfc = stage.params.find(StageParam::HighpassFrequency);
+                    const double* gain = stage.params.find(StageParam::GainLinear);
+
+                    if (stage.patternStrategy == "cascaded_biquad") {
+                        if (stage.type == StageType::LowPassFilter && lpfc) {
+                            out.filters = {prefix + "_lpf"};
+                        } else if ((stage.type == StageType::HighPassFilter || stage.type == StageType::InputBuffer) && hpfc) {
+                            out.filters = {prefix + "_hpf"};
+                        } else {
+                            stableStage();
+                        }
+                    } else if (stage.patternStrategy == "op_amp_gain" && gain) {
+                        std::stringstream vec;
+                        vec << "        juce::FloatVectorOperations::multiply(channelData, "
+                            << std::fixed << std::setprecision(6) << *gain << "f, numSamples);\n";
+                        out.vectorCode = vec.str();
+                    } else if (stage.patternStrategy != "nonlinear_clipper") {
+                        stableStage();
+                    }
+                } else {
+                    stableStage();
+                }
+
+                if (rampsControlGain(stage, gainParamId)) {
+                    out.vectorCode += "        " + prefix
+                        + "_control[(size_t) juce::jmin(channel, 1)].multiply(channelData, (size_t) numSamples);\n";
+                } else if (!(m_useBetaFeatures && isToneControl)
+                           && (stage.type == StageType::GainStage || stage.type == StageType::OutputBuffer)) {
+                    out.blockGain = true;
+                }
+
+                std::stringstream nonlinear;
+                const auto wdfCalls = wdfClippers.find(i);
+                if (wdfCalls != wdfClippers.end()) {
+                    for (const auto& member : wdfCalls->second) {
+                        nonlinear << "        " << member << "[(size_t) juce::jmin(channel, 1)].processBlock(channelData, (size_t) numSamples);\n";
+                    }
+                }
+                for (const auto& component : stage.nonlinearComponents) {
+                    if (!component.diodeChar.has_value()) continue;
+                    const auto it = diodeMemberMap.find(component.name);
+                    if (it == diodeMemberMap.end()) continue;
+                    if (m_oversamplingFactor > 1) {
+                        nonlinear << "        " << it->second << "_os[juce::jmin(channel, 1)].processBlock(channelData, (size_t) numSamples,\n"
+                                  << "            [this](float* data, size_t n) { " << stageMember(it->second) << "processBlock(data, n); });\n";
+                    } else {
+                        nonlinear << "        " << stageMember(it->second) << "processBlock(channelData, (size_t) numSamples);\n";
+                    }
+                }
+                for (const auto& component : stage.nonlinearComponents) {
+                    if (!component.bjtChar.has_value()) continue;
+                    const auto it = bjtMemberMap.find(component.name);
+                    if (it != bjtMemberMap.end()) {
+                        nonlinear << "        " << stageMember(it->second) << "processBlock(channelData, channelData, (size_t) numSamples);\n";
+                    }
+                }
+                for (const auto& component : stage.nonlinearComponents) {
+                    if (!component.fetChar.has_value()) continue;
+                    const auto it = fetMemberMap.find(component.name);
+                    if (it != fetMemberMap.end()) {
+                        nonlinear << "        " << stageMember(it->second) << "processBlock(channelData, channelData, (size_t) numSamples);\n";
+                    }
+                }
+                out.vectorCode += nonlinear.str();
+            }
+        });
+
+        for (const auto& step : plan) {
+            // A parameter-driven gain only takes the knob value, as in the
+            // sample-by-sample path, so it needs no context
+            const bool processesGain = step.blockGain && gainParamId.empty();
+            needsBlock = needsBlock || (!step.filters.empty() && !m_simdChannels) || processesGain;
+            needsContext = needsContext || processesGain;
+        }
+
+        ss << "    // ========================================================================\n";
+        ss << "    // LiveSPICE Component-Based DSP Processing\n";
+        ss << "    // Block processing: each stage runs over whole channel buffers in turn\n";
+        ss << "    // ========================================================================\n\n";
+        ss << "    const int numSamples = buffer.getNumSamples();\n";
+        if (needsBlock) {
+            ss << "    juce::dsp::AudioBlock<float> block (buffer);\n";
+        }
+        if (needsContext) {
+            ss << "    juce::dsp::ProcessContextReplacing<float> context (block);\n";
+        }
+        ss << "\n";
+
+        emitFragments(ss, stages.size(), fragmentThreads(stages.size()), [&](std::ostream& fragment, size_t i) {
+            const auto& stage = stages[i];
+            const auto& step = plan[i];
+
+            if (i > 0) {
+                fragment << "\n";
+            }
+            fragment << "    // Stage " << i << ": " << stage.name << "\n";
+
+            const bool simdStage = m_simdChannels && !step.filters.empty();
+            const std::string traceZone = m_traceZones
+                ? "        LIVESPICE_TRACE_ZONE(" + traceZoneLiteral(i, stage.name) + ");\n" : "";
+            if (simdStage) {
+                fragment << "    {\n";
+                fragment << traceZone;
+                fragment << "        auto lanes = packChannels (buffer, totalNumInputChannels, numSamples);\n";
+                fragment << "        juce::dsp::ProcessContextReplacing<SIMDFloat> laneContext (lanes);\n";
+                for (const auto& filter : step.filters) {
+                    fragment << "        " << filter << ".process(laneContext);\n";
+                }
+                fragment << "        unpackChannels (buffer, totalNumInputChannels, numSamples);\n";
+                fragment << "    }\n";
+            }
+
+            if ((!step.filters.empty() && !simdStage) || !step.sampleBody.empty() || !step.vectorCode.empty()) {
+                fragment << "    for (int channel = 0; channel < totalNumInputChannels; ++channel)\n";
+                fragment << "    {\n";
+                fragment << traceZone;
+                if (!step.filters.empty() && !simdStage) {
+                    fragment << "        auto channelBlock = block.getSingleChannelBlock((size_t) channel);\n";
+                    fragment << "        juce::dsp::ProcessContextReplacing<float> channelContext (channelBlock);\n";
+                    for (const auto& filter : step.filters) {
+                        fragment << "        " << filter << ".process(channelContext);\n";
+                    }
+                }
+                if (!step.sampleBody.empty() || !step.vectorCode.empty()) {
+                    fragment << "        auto* channelData = buffer.getWritePointer(channel);\n";
+                }
+                if (!step.sampleBody.empty()) {
+                    fragment << "        for (int sample = 0; sample < numSamples; ++sample)\n";
+                    fragment << "        {\n";
+                    fragment << "            float signal = channelData[sample];\n";
+                    fragment << step.sampleBody;
+                    fragment << "            channelData[sample] = signal;\n";
+                    fragment << "        }\n";
+                }
+                fragment << step.vectorCode;
+                fragment << "    }\n";
+            }
+        });
 
-        // Apply gain stages
+        // Gain stages stay at block level after the chain
+        bool firstGain = true;
         for (size_t i = 0; i < stages.size(); ++i) {
-            const auto& stage = stages[i];
-            
-            if (stage.type == StageType::GainStage || stage.type == StageType::OutputBuffer) {
+            if (!plan[i].blockGain) {
+                continue;
+            }
+            if (firstGain) {
+                ss << "\n";
+                firstGain = false;
+            }
+            if (!gainParamId.empty()) {
+                if (m_parameterSmoothing) {
+                    ss << "    if (" << gainParamId << "Dirty)\n    ";
+                }
+                ss << "    stage" << i << "_gain.setGainLinear(" << gainParamId << "Value);\n";
+            } else {
                 ss << "    stage" << i << "_gain.process(context);\n";
             }
         }
-        
-        ss << "}\n\n";
-        return ss.str();
     }
 
     std::string JuceDSPGenerator::generateProcessorImplementation() {
@@ -552,9 +2340,14 @@ CircuitProcessor::CircuitProcessor()
 {
 }
 
-CircuitProcessor::~CircuitProcessor()
-{
-}
+)";
+        if (bakesShapersInBackground()) {
+            ss << "CircuitProcessor::~CircuitProcessor()\n{\n";
+            ss << "    LiveSpiceDSP::TableRebuildWorker::shared().cancel (this);\n}\n";
+        } else {
+            ss << "CircuitProcessor::~CircuitProcessor()\n{\n}\n";
+        }
+        ss << R"(
 
 const juce::String CircuitProcessor::getName() const
 {
@@ -610,30 +2403,33 @@ void CircuitProcessor::changeProgramName (int, const juce::String&)
     }
 
     std::string JuceDSPGenerator::generateDSPStages(const std::vector<CircuitStage>& stages) {
-        std::stringstream ss;
+        CodeEmitter out(estimateCodeSize(stages.size(), 128, 128));
+        writeDSPStages(out, stages);
+        return out.take();
+    }
 
+    void JuceDSPGenerator::writeDSPStages(std::ostream& ss, const std::vector<CircuitStage>& stages)
+    {
         ss << "// DSP Stages Generated from Circuit Analysis:\n";
         ss << "// Total stages: " << stages.size() << "\n\n";
 
-        for (size_t i = 0; i < stages.size(); ++i) {
+        emitFragments(ss, stages.size(), fragmentThreads(stages.size()), [&](std::ostream& fragment, size_t i) {
             const auto& stage = stages[i];
-            ss << "// Stage " << i << ": " << stage.name << "\n";
-            ss << "// DSP Mapping: " << stage.dspDescription << "\n";
+            fragment << "// Stage " << i << ": " << stage.name << "\n";
+            fragment << "// DSP Mapping: " << stage.dspDescription << "\n";
 
             if (m_useBetaFeatures) {
                 if (isLikelyToneStackStage(stage)) {
-                    ss << "// [BETA] Tone stack (low/mid/high shelves)\n";
+                    fragment << "// [BETA] Tone stack (low/mid/high shelves)\n";
                 } else if (stage.patternStrategy == "cascaded_biquad" && stage.patternConfidence >= 0.8) {
-                    ss << "// [BETA] Optimized IIR filter for RC pattern\n";
+                    fragment << "// [BETA] Optimized IIR filter for RC pattern\n";
                 } else if (stage.patternStrategy == "nonlinear_clipper") {
-                    ss << "// [BETA] Nonlinear clipper pattern\n";
+                    fragment << "// [BETA] Nonlinear clipper pattern\n";
                 }
             }
 
-            ss << "\n";
-        }
-
-        return ss.str();
+            fragment << "\n";
+        });
     }
 
     void JuceDSPGenerator::generateJucePlugin(const std::string& outputDir, const std::string& pluginName) {
@@ -641,29 +2437,556 @@ void CircuitProcessor::changeProgramName (int, const juce::String&)
         // For now, we'll generate the code and print it
     }
 
-    void JuceDSPGenerator::writePluginFiles(const std::string& pluginDir, const std::string& pluginName,
-                                           const std::vector<CircuitStage>& stages, const Netlist& netlist) {
-        // Generate processor header and implementation with parameter support
-        std::string headerCode = generateProcessorHeaderWithParams(netlist, stages);
-        std::string implCode = generateProcessorImplWithParams(netlist, stages);
+    std::vector<JuceDSPGenerator::PluginFile> JuceDSPGenerator::generatePluginFiles(
+        const std::string& pluginName, const std::vector<CircuitStage>& stages, const Netlist& netlist) {
+        std::vector<PluginFile> files;
+        auto add = [&](const std::string& name, std::string content) {
+            files.push_back({name, std::move(content)});
+        };
+
+        // Processor header and implementation with parameter support
+        add("CircuitProcessor.h", generateProcessorHeaderWithParams(netlist, stages));
+        add("CircuitProcessor.cpp", generateProcessorImplWithParams(netlist, stages));
 
-        // Write header file
-        std::ofstream headerFile(pluginDir + "/CircuitProcessor.h");
-        if (headerFile.is_open()) {
-            headerFile << headerCode;
-            headerFile.close();
+        // Compile-time stage chain (the DK backend takes precedence)
+        if (m_staticChain && !(m_nodalDK && planDKCircuit(netlist).unsupported.empty())) {
+            const StaticChainPlan chain = planStaticChain(stages);
+            if (chain.unsupported.empty()) {
+                add("CircuitChain.h", chain.header);
+            }
         }
-        
-        // Write implementation file
-        std::ofstream implFile(pluginDir + "/CircuitProcessor.cpp");
-        if (implFile.is_open()) {
-            implFile << implCode;
-            implFile.close();
+
+        // Static nonlinear tables
+        if (m_staticTables && !collectDiodeMembers(stages).empty()) {
+            add("NonlinearTables.h", generateNonlinearTablesHeader(stages));
+        }
+
+        // Pre-solved clipper subcircuits
+        if (usesSubcircuitTables()) {
+            const std::string tables = generateSubcircuitTablesHeader(netlist, stages);
+            if (!tables.empty()) {
+                add("SubcircuitTables.h", tables);
+            }
+        }
+
+        // Headless benchmark harness
+        if (m_benchmarkHarness) {
+            add("Benchmark.cpp", generateBenchmarkSource(pluginName));
+        }
+
+        return files;
+    }
+
+    std::vector<JuceDSPGenerator::GeneratedFile> JuceDSPGenerator::writePluginFiles(
+        const std::string& pluginDir, const std::string& pluginName,
+        const std::vector<CircuitStage>& stages, const Netlist& netlist) {
+        std::vector<GeneratedFile> files;
+        for (const auto& file : generatePluginFiles(pluginName, stages, netlist)) {
+            files.push_back({file.name, writeIfChanged(pluginDir + "/" + file.name, file.content)});
+        }
+        return files;
+    }
+
+    bool JuceDSPGenerator::writeIfChanged(const std::string& path, const std::string& content) {
+        std::ifstream existing(path, std::ios::binary | std::ios::ate);
+        if (existing.is_open() && static_cast<size_t>(existing.tellg()) == content.size()) {
+            std::string current(content.size(), '\0');
+            existing.seekg(0);
+            existing.read(&current[0], static_cast<std::streamsize>(current.size()));
+            if (existing && NetlistCache::contentHash(current) == NetlistCache::contentHash(content)) {
+                return false;
+            }
+        }
+        existing.close();
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file << content;
+        return static_cast<bool>(file);
+    }
+
+    CostModel::Plan JuceDSPGenerator::applyCpuBudget(const std::vector<CircuitStage>& stages,
+                                                     double budgetNsPerSample, bool fixedOversampling) {
+        const size_t clippers = collectDiodeMembers(stages).size();
+        if (clippers == 0) {
+            CostModel::Plan plan;
+            plan.solver = m_clipperSolver;
+            plan.oversampling = m_oversamplingFactor;
+            return plan;
+        }
+
+        const auto plan = CostModel::selectForBudget(clippers, budgetNsPerSample,
+                                                     fixedOversampling ? m_oversamplingFactor : 0);
+        m_clipperSolver = plan.solver;
+        m_oversamplingFactor = plan.oversampling;
+        return plan;
+    }
+
+    std::string JuceDSPGenerator::checkNodalDK(const Netlist& netlist) const {
+        return planDKCircuit(netlist).unsupported;
+    }
+
+    std::string JuceDSPGenerator::checkStaticChain(const std::vector<CircuitStage>& stages) const {
+        return planStaticChain(stages).unsupported;
+    }
+
+    std::vector<std::string> JuceDSPGenerator::findWdfClippers(const Netlist& netlist) const {
+        std::vector<std::string> diodes;
+        for (const auto& plan : planWDFClippers(netlist)) {
+            diodes.insert(diodes.end(), plan.diodes.begin(), plan.diodes.end());
+        }
+        return diodes;
+    }
+
+    std::string JuceDSPGenerator::generateBenchmarkSource(const std::string& pluginName) const {
+        std::stringstream ss;
+
+        ss << R"(/*
+  ==============================================================================
+    Auto-generated headless benchmark for )" << pluginName << R"(
+    Renders test signals through CircuitProcessor at several sample rates and
+    block sizes and reports ns/sample, real-time factor and the worst block
+    against its real-time budget.
+
+    Options:
+      --signal=sine|chirp|square|noise|impulse|all   (default: all)
+      --rates=44100,48000,96000                      sample rates
+      --blocks=32,64,128,256,512                     block sizes
+      --seconds=S                                    audio rendered per run (default 2)
+      --csv                                          CSV instead of a table
+      --max-ns-per-sample=N                          exit 1 if any run is slower
+
+    Capacity planning (--capacity): for every rate and block size, the most
+    processor instances one pinned core runs without missing a block
+    deadline, and the heap memory each instance takes.
+      --load=F                                       share of each block period allowed (default 0.8)
+      --cores=N                                      cores measured side by side (default 1)
+      --max-instances=N                              search ceiling per core (default 1024)
+  ==============================================================================
+*/
+
+#include "CircuitProcessor.h"
+#include "../../SpiceValidation.h"
+#include "../../CapacityPlanner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+// Heap bytes allocated by this program, for the memory per instance
+static std::atomic<uint64_t> allocatedBytes { 0 };
+
+void* operator new (std::size_t size)
+{
+    allocatedBytes += size;
+    if (void* p = std::malloc (size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete (void* p) noexcept { std::free (p); }
+void operator delete (void* p, std::size_t) noexcept { std::free (p); }
+
+namespace
+{
+    using Signal = SpiceValidation::TestSignalGenerator;
+
+    struct SignalChoice
+    {
+        const char* name;
+        Signal::SignalType type;
+    };
+
+    const SignalChoice signalChoices[] = {
+        { "sine",    Signal::SignalType::SineWave },
+        { "chirp",   Signal::SignalType::Chirp },
+        { "square",  Signal::SignalType::SquareWave },
+        { "noise",   Signal::SignalType::NoiseWhite },
+        { "impulse", Signal::SignalType::ImpulseResponse },
+    };
+
+    std::vector<double> parseList (const std::string& text)
+    {
+        std::vector<double> values;
+        for (const auto& token : juce::StringArray::fromTokens (text, ",", ""))
+            if (token.getDoubleValue() > 0.0)
+                values.push_back (token.getDoubleValue());
+        return values;
+    }
+
+    struct RunResult
+    {
+        double nsPerSample = 0.0;     // Per sample frame (all channels)
+        double realTimeFactor = 0.0;  // Audio time / processing time
+        double worstBlockUs = 0.0;
+        double budgetUs = 0.0;        // Real-time budget for one block
+    };
+
+    RunResult run (Signal::SignalType type, double sampleRate, int blockSize, double seconds)
+    {
+        Signal::SignalParams params;
+        params.sampleRate = (float) sampleRate;
+        params.duration = (float) seconds;
+        params.frequency = 440.0f;
+        params.amplitude = 0.5f;
+        const auto input = Signal::generateSignal (type, params);
+
+        CircuitProcessor processor;
+        processor.setPlayConfigDetails (2, 2, sampleRate, blockSize);
+        processor.prepareToPlay (sampleRate, blockSize);
+
+        juce::AudioBuffer<float> buffer (2, blockSize);
+        juce::MidiBuffer midi;
+        auto fill = [&] (size_t offset, int numSamples)
+        {
+            buffer.setSize (2, numSamples, false, false, true);
+            for (int channel = 0; channel < 2; ++channel)
+                std::copy_n (input.data() + offset, (size_t) numSamples, buffer.getWritePointer (channel));
+        };
+
+        // Warm up caches and smoothers before timing
+        for (size_t offset = 0; offset + (size_t) blockSize <= std::min (input.size(), (size_t) sampleRate / 10); offset += (size_t) blockSize)
+        {
+            fill (offset, blockSize);
+            processor.processBlock (buffer, midi);
+        }
+        processor.reset();
+
+        using Clock = std::chrono::steady_clock;
+        RunResult result;
+        double totalNs = 0.0;
+        for (size_t offset = 0; offset < input.size(); offset += (size_t) blockSize)
+        {
+            const int numSamples = (int) std::min ((size_t) blockSize, input.size() - offset);
+            fill (offset, numSamples);
+
+            const auto start = Clock::now();
+            processor.processBlock (buffer, midi);
+            const double ns = (double) std::chrono::duration_cast<std::chrono::nanoseconds> (Clock::now() - start).count();
+
+            totalNs += ns;
+            result.worstBlockUs = std::max (result.worstBlockUs, ns / 1000.0);
+        }
+        processor.releaseResources();
+
+        result.nsPerSample = totalNs / (double) input.size();
+        result.realTimeFactor = totalNs > 0.0 ? seconds * 1.0e9 / totalNs : 0.0;
+        result.budgetUs = 1.0e6 * blockSize / sampleRate;
+        return result;
+    }
+
+    struct Instance
+    {
+        std::unique_ptr<CircuitProcessor> processor;
+        juce::AudioBuffer<float> buffer;
+        juce::MidiBuffer midi;
+    };
+
+    std::unique_ptr<CircuitProcessor> makeProcessor (double sampleRate, int blockSize)
+    {
+        auto processor = std::make_unique<CircuitProcessor>();
+        processor->setPlayConfigDetails (2, 2, sampleRate, blockSize);
+        processor->prepareToPlay (sampleRate, blockSize);
+        return processor;
+    }
+
+    // Heap bytes one prepared processor holds on to
+    size_t measureInstanceBytes (double sampleRate, int blockSize)
+    {
+        const uint64_t before = allocatedBytes.load();
+        auto processor = makeProcessor (sampleRate, blockSize);
+        return (size_t) (allocatedBytes.load() - before);
+    }
+
+    LiveSpiceDSP::CapacityResult capacity (const std::vector<float>& input, double sampleRate, int blockSize,
+                                           const LiveSpiceDSP::CapacitySettings& base)
+    {
+        auto settings = base;
+        settings.sampleRate = sampleRate;
+        settings.blockSize = (size_t) blockSize;
+        return LiveSpiceDSP::findCapacity (settings, input.size(),
+            [&]
+            {
+                return Instance { makeProcessor (sampleRate, blockSize), juce::AudioBuffer<float> (2, blockSize), {} };
+            },
+            [&] (Instance& instance, size_t offset, size_t numSamples)
+            {
+                for (int channel = 0; channel < 2; ++channel)
+                    std::copy_n (input.data() + offset, numSamples, instance.buffer.getWritePointer (channel));
+                instance.processor->processBlock (instance.buffer, instance.midi);
+            });
+    }
+}
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    std::string signalName = "all";
+    std::vector<double> rates { 44100.0, 48000.0, 96000.0 };
+    std::vector<double> blocks { 32.0, 64.0, 128.0, 256.0, 512.0 };
+    double seconds = 2.0;
+    double maxNsPerSample = 0.0;
+    bool csv = false;
+    bool capacityMode = false;
+    LiveSpiceDSP::CapacitySettings capacitySettings;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg.rfind ("--signal=", 0) == 0)                 signalName = arg.substr (9);
+        else if (arg.rfind ("--rates=", 0) == 0)             rates = parseList (arg.substr (8));
+        else if (arg.rfind ("--blocks=", 0) == 0)            blocks = parseList (arg.substr (9));
+        else if (arg.rfind ("--seconds=", 0) == 0)           seconds = std::max (0.01, std::atof (arg.c_str() + 10));
+        else if (arg.rfind ("--max-ns-per-sample=", 0) == 0) maxNsPerSample = std::atof (arg.c_str() + 20);
+        else if (arg == "--csv")                             csv = true;
+        else if (arg == "--capacity")                        capacityMode = true;
+        else if (arg.rfind ("--load=", 0) == 0)              capacitySettings.load = juce::jlimit (0.01, 1.0, std::atof (arg.c_str() + 7));
+        else if (arg.rfind ("--cores=", 0) == 0)             capacitySettings.cores = (size_t) std::max (1, std::atoi (arg.c_str() + 8));
+        else if (arg.rfind ("--max-instances=", 0) == 0)     capacitySettings.maxInstances = (size_t) std::max (1, std::atoi (arg.c_str() + 16));
+        else
+        {
+            std::fprintf (stderr, "Unknown option: %s\n", arg.c_str());
+            return 2;
+        }
+    }
+
+    std::vector<SignalChoice> signals;
+    for (const auto& choice : signalChoices)
+        if (signalName == "all" || signalName == choice.name)
+            signals.push_back (choice);
+    if (signals.empty() || rates.empty() || blocks.empty())
+    {
+        std::fprintf (stderr, "Nothing to run: check --signal, --rates and --blocks\n");
+        return 2;
+    }
+
+    if (capacityMode)
+    {
+        capacitySettings.seconds = seconds;
+        if (csv)
+            std::printf ("sample_rate,block_size,instances_per_core,worst_load,us_per_instance_block,bytes_per_instance\n");
+        else
+            std::printf ("%s capacity (load %.2f, %d core(s))\n\n%8s %6s %10s %11s %12s %10s\n", ")" << pluginName << R"(",
+                         capacitySettings.load, (int) capacitySettings.cores,
+                         "rate", "block", "per core", "worst load", "us/instance", "KiB/inst");
+
+        for (double rate : rates)
+        {
+            Signal::SignalParams params;
+            params.sampleRate = (float) rate;
+            params.duration = 1.0f;
+            params.frequency = 440.0f;
+            params.amplitude = 0.5f;
+            const auto input = Signal::generateSignal (signals.front().type, params);
+
+            for (double block : blocks)
+            {
+                const size_t bytes = measureInstanceBytes (rate, (int) block);
+                const auto result = capacity (input, rate, (int) block, capacitySettings);
+                std::printf (csv ? "%.0f,%.0f,%d,%.3f,%.3f,%.0f\n" : "%8.0f %6.0f %10d %11.2f %12.2f %10.1f\n",
+                             rate, block, (int) result.instancesPerCore, result.worstLoad, result.usPerInstanceBlock,
+                             csv ? (double) bytes : (double) bytes / 1024.0);
+            }
+        }
+        return 0;
+    }
+
+    if (csv)
+        std::printf ("signal,sample_rate,block_size,ns_per_sample,realtime_factor,worst_block_us,budget_us\n");
+    else
+        std::printf ("%s benchmark (%.2f s per run)\n\n%-8s %8s %6s %12s %10s %14s %10s\n", ")" << pluginName << R"(", seconds,
+                     "signal", "rate", "block", "ns/sample", "RT factor", "worst block us", "budget us");
+
+    double slowest = 0.0;
+    for (const auto& signal : signals)
+    {
+        for (double rate : rates)
+        {
+            for (double block : blocks)
+            {
+                const auto result = run (signal.type, rate, (int) block, seconds);
+                slowest = std::max (slowest, result.nsPerSample);
+                std::printf (csv ? "%s,%.0f,%.0f,%.2f,%.2f,%.2f,%.2f\n" : "%-8s %8.0f %6.0f %12.2f %10.1f %14.2f %10.2f\n",
+                             signal.name, rate, block, result.nsPerSample, result.realTimeFactor,
+                             result.worstBlockUs, result.budgetUs);
+            }
+        }
+    }
+
+    if (maxNsPerSample > 0.0 && slowest > maxNsPerSample)
+    {
+        std::fprintf (stderr, "FAIL: %.2f ns/sample exceeds the %.2f ns/sample gate\n", slowest, maxNsPerSample);
+        return 1;
+    }
+    return 0;
+}
+)";
+
+        return ss.str();
+    }
+
+    std::string JuceDSPGenerator::generateNonlinearTablesHeader(const std::vector<CircuitStage>& stages) const {
+        std::stringstream ss;
+
+        ss << R"(/*
+  ==============================================================================
+    Auto-generated nonlinear component tables
+    Diode current tables (DiodeLUT layout) for the parts in this circuit,
+    evaluated at generation time. Read-only static data: no table is built
+    when a processor is created, and every instance in the host shares it.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../../DiodeModels.h"
+
+namespace GeneratedTables {
+
+)";
+
+        std::set<std::string> emitted;
+        for (const auto& member : collectDiodeMembers(stages)) {
+            const std::string name = diodeTableName(member.partNumber);
+            if (!emitted.insert(name).second) {
+                continue;
+            }
+
+            const auto diode = Nonlinear::ComponentDB::getDiodeDB().getOrDefault(member.partNumber);
+            const auto table = Nonlinear::DiodeLUT::acquireTable(diode);
+
+            ss << "// " << member.partNumber << ": Is = " << diode.Is << ", n = " << diode.n << ", Vt = " << diode.Vt << "\n";
+            ss << "alignas(64) inline constexpr Nonlinear::DiodeLUT::CurrentTable " << name << " = {{\n";
+            ss << std::setprecision(9);
+            for (size_t i = 0; i < table->size(); ++i) {
+                ss << ((i % 4 == 0) ? "    " : " ") << (*table)[i] << "f,";
+                if (i % 4 == 3 || i + 1 == table->size()) {
+                    ss << "\n";
+                }
+            }
+            ss << std::setprecision(6);
+            ss << "}};\n\n";
+        }
+
+        ss << "} // namespace GeneratedTables\n";
+        return ss.str();
+    }
+
+    std::string JuceDSPGenerator::generateSubcircuitTablesHeader(const Netlist& netlist,
+                                                                 const std::vector<CircuitStage>& circuitStages) {
+        // Same stage chain as the processor files
+        const bool useDK = m_nodalDK && planDKCircuit(netlist).unsupported.empty();
+        const bool useStaticChain = m_staticChain && !useDK && planStaticChain(circuitStages).unsupported.empty();
+        if (!usesSubcircuitTables() || useDK || useStaticChain) {
+            return {};
+        }
+        const WDFStageChain wdf = m_wdfClippers ? applyWDFClippers(netlist, circuitStages) : WDFStageChain{};
+        const auto parameters = paramGenerator.extractParametersFromCircuit(netlist);
+        const SubcircuitStageChain tables = applySubcircuitTables(m_wdfClippers ? wdf.stages : circuitStages,
+                                                                  parameters, findGainParamId(parameters));
+        if (tables.tables.empty()) {
+            return {};
+        }
+
+        std::stringstream ss;
+        ss << R"(/*
+  ==============================================================================
+    Auto-generated subcircuit tables
+    Clipper subcircuits solved at generation time over their input and pot
+    positions (LiveSpiceDSP::SubcircuitTable layout). Read-only static data:
+    the processor interpolates them instead of solving the diodes per sample.
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../../SubcircuitTable.h"
+
+namespace GeneratedTables {
+
+)";
+
+        LiveSpiceDSP::SubcircuitBudget budget;
+        budget.maxError = m_subcircuitTableBudget;
+        for (const auto& plan : tables.tables) {
+            const LiveSpiceDSP::SubcircuitTable table = plan.feedback
+                ? LiveSpiceDSP::SubcircuitTable::diodeFeedback(plan.diode, plan.feedbackCircuit, budget)
+                : LiveSpiceDSP::SubcircuitTable::diodesToGround(plan.diode, plan.groundCircuit, budget);
+            const auto& layout = table.getLayout();
+            const std::string name = "stage" + std::to_string(plan.stage) + "_subcircuit";
+
+            auto resistance = [](const LiveSpiceDSP::PotResistance& r, const JuceParameter* knob) {
+                std::ostringstream text;
+                text << r.fixed / 1000.0 << "k";
+                if (r.isVariable()) {
+                    text << " + " << r.pot / 1000.0 << "k pot (" << (knob ? knob->id : "fixed") << ")";
+                }
+                return text.str();
+            };
+            const JuceParameter* knob0 = plan.knobs.size() > 0 ? &plan.knobs[0] : nullptr;
+            const JuceParameter* knob1 = plan.knobs.size() > 1 ? &plan.knobs[1] : nullptr;
+
+            ss << "// Stage " << plan.stage << ": " << tables.stages[plan.stage].name << "\n";
+            if (plan.feedback) {
+                ss << "// " << plan.partNumber << " pair across " << resistance(plan.feedbackCircuit.feedback, knob0)
+                   << ", " << resistance(plan.feedbackCircuit.ground, plan.feedbackCircuit.feedback.isVariable() ? knob1 : knob0)
+                   << " to ground, rails +-" << plan.feedbackCircuit.rail << " V\n";
+            } else {
+                ss << "// " << plan.partNumber << " pair to ground behind " << resistance(plan.groundCircuit.series, knob0) << "\n";
+            }
+            ss << "// " << layout.inputPoints << " input";
+            for (size_t axis = 0; axis < layout.numControls; ++axis) {
+                ss << " x " << layout.controlPoints[axis];
+            }
+            ss << " knots, " << table.getMemoryBytes() << " bytes; max error " << table.getMaxError()
+               << " V (budget " << m_subcircuitTableBudget << " V)\n";
+
+            ss << "inline constexpr LiveSpiceDSP::SubcircuitTable::Layout " << name << "Layout {\n";
+            ss << "    " << doubleLiteral(layout.inputRange) << ", " << doubleLiteral(layout.inputScale) << ", "
+               << doubleLiteral(layout.directGain) << ", " << doubleLiteral(layout.outputLimit) << ",\n";
+            ss << "    " << layout.inputPoints << ", " << layout.numControls << ", {{"
+               << layout.controlPoints[0] << ", " << layout.controlPoints[1] << "}} };\n";
+
+            // Shortest literal that reads back as the same float
+            auto floatLiteral = [](float value) {
+                std::string literal;
+                for (int digits = 6; digits <= 9; ++digits) {
+                    std::ostringstream text;
+                    text << std::setprecision(digits) << value;
+                    literal = text.str();
+                    if (std::strtof(literal.c_str(), nullptr) == value) break;
+                }
+                if (literal.find_first_of(".e") == std::string::npos) literal += ".0";
+                return literal + "f";
+            };
+
+            const float* samples = table.getSamples();
+            const size_t count = layout.numSamples();
+            ss << "alignas(64) inline constexpr float " << name << "[" << count << "] = {\n";
+            for (size_t i = 0; i < count; ++i) {
+                ss << ((i % 8 == 0) ? "    " : " ") << floatLiteral(samples[i]) << ",";
+                if (i % 8 == 7 || i + 1 == count) {
+                    ss << "\n";
+                }
+            }
+            ss << "};\n\n";
         }
+
+        ss << "} // namespace GeneratedTables\n";
+        return ss.str();
     }
 
     std::string JuceDSPGenerator::generateCMakeLists(const std::string& pluginName, 
-                                                    const std::string& juceRelativePath) {
+                                                    const std::string& juceRelativePath,
+                                                    bool withDKSolver) {
         std::stringstream ss;
         
         // Create a valid CMake project name (no spaces, special characters)
@@ -700,7 +3023,36 @@ juce_add_plugin()" << cmakeName << R"(
 target_sources()" << cmakeName << R"( PRIVATE
     CircuitProcessor.h
     CircuitProcessor.cpp)
-
+)";
+        
+        // Translator sources the processor links against
+        std::string extraSources;
+        if (m_oversamplingFactor > 1) {
+            extraSources += " ../../Oversampling.cpp";
+        }
+        if (withDKSolver) {
+            extraSources += " ../../DKMethod.cpp ../../SparseLU.cpp";
+        }
+        if (m_traceZones) {
+            extraSources += " ../../TraceZones.cpp";
+        }
+        if (m_waveshaperTables) {
+            extraSources += " ../../Waveshaper.cpp ../../DiodeModels.cpp";
+        }
+        if (bakesShapersInBackground()) {
+            extraSources += " ../../TableRebuildWorker.cpp";
+        }
+        if (usesSubcircuitTables()) {
+            extraSources += " ../../SubcircuitTable.cpp";
+        }
+        if (!extraSources.empty()) {
+            ss << "target_sources(" << cmakeName << " PRIVATE" << extraSources << ")\n";
+        }
+        if (m_traceZones) {
+            ss << "target_compile_definitions(" << cmakeName << " PRIVATE LIVESPICE_TRACE=1)\n";
+        }
+        
+        ss << R"(
 # Link JUCE
 target_link_libraries()" << cmakeName << R"( PRIVATE
     juce::juce_core
@@ -714,6 +3066,39 @@ set_target_properties()" << cmakeName << R"( PROPERTIES
     CXX_STANDARD 17
     CXX_STANDARD_REQUIRED ON)
 )";
+
+        if (m_benchmarkHarness) {
+            const std::string benchName = cmakeName + "_Benchmark";
+            ss << R"(
+# Headless benchmark: renders test signals through CircuitProcessor and
+# reports ns/sample, real-time factor and worst-case block time
+juce_add_console_app()" << benchName << R"(
+    PRODUCT_NAME ")" << pluginName << R"( Benchmark")
+
+target_sources()" << benchName << R"( PRIVATE
+    Benchmark.cpp
+    CircuitProcessor.cpp
+    ../../SpiceValidation.cpp
+    ../../SpiceModelLibrary.cpp
+    ../../SpiceRawFile.cpp)" << extraSources << R"()
+
+target_compile_definitions()" << benchName << R"( PRIVATE
+    "JucePlugin_Name=\")" << pluginName << R"(\""
+    JUCE_USE_CURL=0
+    JUCE_WEB_BROWSER=0)" << (m_traceZones ? "\n    LIVESPICE_TRACE=1)" : ")") << R"(
+
+target_link_libraries()" << benchName << R"( PRIVATE
+    juce::juce_core
+    juce::juce_audio_basics
+    juce::juce_audio_processors
+    juce::juce_dsp
+    juce::juce_gui_basics)
+
+set_target_properties()" << benchName << R"( PROPERTIES
+    CXX_STANDARD 17
+    CXX_STANDARD_REQUIRED ON)
+)";
+        }
         
         return ss.str();
     }
@@ -742,12 +3127,35 @@ set_target_properties()" << cmakeName << R"( PROPERTIES
     // ============================================================================
 
     std::string JuceDSPGenerator::generateProcessorHeaderWithParams(
-        const Netlist& netlist, const std::vector<CircuitStage>& stages) 
+        const Netlist& netlist, const std::vector<CircuitStage>& circuitStages)
     {
-        std::stringstream ss;
+        CodeEmitter out(estimateCodeSize(circuitStages.size(), 8192, 384));
+        writeProcessorHeaderWithParams(out, netlist, circuitStages);
+        return out.take();
+    }
+
+    void JuceDSPGenerator::writeProcessorHeaderWithParams(
+        std::ostream& ss, const Netlist& netlist, const std::vector<CircuitStage>& circuitStages)
+    {
+        // The DK backend simulates the whole netlist in place of the stage chain;
+        // the static chain runs it as one inlined type list
+        const DKCircuitPlan dk = m_nodalDK ? planDKCircuit(netlist) : DKCircuitPlan{};
+        const bool useDK = m_nodalDK && dk.unsupported.empty();
+        const StaticChainPlan chain = m_staticChain && !useDK ? planStaticChain(circuitStages) : StaticChainPlan{};
+        const bool useStaticChain = m_staticChain && !useDK && chain.unsupported.empty();
+        const std::vector<CircuitStage> noStages;
+        const bool useWDF = m_wdfClippers && !useDK && !useStaticChain;
+        const WDFStageChain wdf = useWDF ? applyWDFClippers(netlist, circuitStages) : WDFStageChain{};
+        const auto& chainStages = useDK || useStaticChain ? noStages : (useWDF ? wdf.stages : circuitStages);
         
         // Extract parameters from circuit
         auto parameters = paramGenerator.extractParametersFromCircuit(netlist);
+        const std::string gainParamId = findGainParamId(parameters);
+
+        // Pre-solved clipper subcircuits replace their stages' diode models
+        const SubcircuitStageChain tables = usesSubcircuitTables()
+            ? applySubcircuitTables(chainStages, parameters, gainParamId) : SubcircuitStageChain{};
+        const auto& stages = tables.tables.empty() ? chainStages : tables.stages;
         
                 ss << R"(/*
   ==============================================================================
@@ -759,19 +3167,86 @@ set_target_properties()" << cmakeName << R"( PROPERTIES
 
 #pragma once
 
-#include <juce_audio_processors/juce_audio_processors.h>
-#include <juce_dsp/juce_dsp.h>
-#include <cmath>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_dsp/juce_dsp.h>
+#include <cmath>
+
+// Nonlinear component models
+#include "../../DiodeModels.h"
+#include "../../TransistorModels.h"
+#include "../../TransistorStages.h"
+#include "../../ComponentCharacteristicsDatabase.h"
+#include "../../Oversampling.h"
+
+// LiveSPICE Component Library
+#include "../../third_party/livespice-components/ComponentModels.h"
+#include "../../third_party/livespice-components/DSPImplementations.h"
+
+#include <array>
+)";
+
+        if (m_staticTables && !collectDiodeMembers(stages).empty()) {
+            ss << "\n// Precomputed nonlinear tables for this circuit\n";
+            ss << "#include \"NonlinearTables.h\"\n";
+        }
+
+        if (useDK) {
+            ss << "\n// Nodal DK-method circuit solver\n";
+            ss << "#include \"../../DKMethod.h\"\n";
+            ss << "#include \"../../SampleRateCache.h\"\n";
+        }
+
+        if (useStaticChain) {
+            ss << "\n// Compile-time stage chain\n";
+            ss << "#include \"CircuitChain.h\"\n";
+        }
+
+        if (!wdf.clippers.empty()) {
+            ss << "\n// Wave digital filter elements and adaptors\n";
+            ss << "#include \"../../WDF.h\"\n";
+        }
+
+        if (m_svfToneStack && m_useBetaFeatures) {
+            ss << "\n// TPT state-variable filters for the tone stack\n";
+            ss << "#include \"../../StateSpaceFilter.h\"\n";
+        }
+
+        if (m_waveshaperTables) {
+            ss << "\n// Baked clipper curves with antiderivative antialiasing\n";
+            ss << "#include \"../../DiodeModels.h\"\n";
+            ss << "#include \"../../Waveshaper.h\"\n";
+        }
+
+        if (!tables.tables.empty()) {
+            ss << "\n// Clipper subcircuits pre-solved into tables\n";
+            ss << "#include \"SubcircuitTables.h\"\n";
+        }
+
+        if (usesControlRate() && !stages.empty()) {
+            ss << "\n// Control-rate parameter ramps\n";
+            ss << "#include \"../../ControlRate.h\"\n";
+        }
+
+        if (m_sharedState) {
+            ss << "\n// State shared by every instance in the process\n";
+            ss << "#include \"../../SharedContext.h\"\n";
+            if (!useDK) ss << "#include \"../../SampleRateCache.h\"\n";
+            ss << "#include <memory>\n";
+        }
 
-// Nonlinear component models
-#include "../../DiodeModels.h"
-#include "../../TransistorModels.h"
-#include "../../ComponentCharacteristicsDatabase.h"
+        if (m_lazyStages) {
+            ss << "\n// Fast startup: stages built on the first prepare, curves in the background\n";
+            if (bakesShapersInBackground()) ss << "#include \"../../TableRebuildWorker.h\"\n";
+            ss << "#include <atomic>\n";
+            ss << "#include <optional>\n";
+        }
 
-// LiveSPICE Component Library
-#include "../../third_party/livespice-components/ComponentModels.h"
-#include "../../third_party/livespice-components/DSPImplementations.h"
+        if (m_traceZones) {
+            ss << "\n// Trace zones (LIVESPICE_TRACE=1 in CMakeLists.txt)\n";
+            ss << "#include \"../../TraceZones.h\"\n";
+        }
 
+        ss << R"(
 class CircuitProcessor : public juce::AudioProcessor
 {
 public:
@@ -808,31 +3283,74 @@ private:
 
         // Add parameter layout function
         ss << paramGenerator.generateParameterLayoutFunction(parameters);
+
+        if (usesSubBlocks()) {
+            ss << "    // Host blocks run as sub-blocks of at most subBlockSize samples, each\n";
+            ss << "    // reading the parameters afresh\n";
+            ss << "    static constexpr int subBlockSize = " << m_subBlockSize << ";\n";
+            ss << "    void processSubBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi);\n\n";
+        }
+
+        // Declared ahead of the models so their initializers can read it
+        if (m_sharedState) {
+            writeSharedStateMembers(ss, stages, useDK, tables.tabled);
+        }
+
+        const bool simdFilters = usesSimdFilters(stages);
+        const std::string filterType = simdFilters ? "juce::dsp::IIR::Filter<SIMDFloat>" : "juce::dsp::IIR::Filter<float>";
+        if (simdFilters) {
+            ss << generateSimdMembers();
+        }
         
-        ss << "    // ========================================================================\n";
-        ss << "    // LiveSPICE Component Processors - Real-time audio DSP\n";
-        ss << "    // ========================================================================\n\n";
+        if (useDK) {
+            ss << "    // ========================================================================\n";
+            ss << "    // Nodal DK-method circuit model (" << dk.states << " states, " << dk.ports << " nonlinear ports)\n";
+            ss << "    // ========================================================================\n\n";
+            ss << "    std::array<LiveSpiceDSP::DKProcessor<" << dk.states << ", " << dk.ports << ">, 2> dkCircuit;\n\n";
+        } else if (useStaticChain) {
+            ss << "    // ========================================================================\n";
+            ss << "    // Compile-time stage chain (" << chain.numStages << " stages, see CircuitChain.h)\n";
+            ss << "    // ========================================================================\n\n";
+            ss << "    std::array<CircuitChain::Chain, 2> circuitChain;\n\n";
+        } else {
+            ss << "    // ========================================================================\n";
+            ss << "    // LiveSPICE Component Processors - Real-time audio DSP\n";
+            ss << "    // ========================================================================\n\n";
+        }
         
         // Generate component processors
-        for (size_t i = 0; i < stages.size(); ++i) {
+        emitFragments(ss, stages.size(), fragmentThreads(stages.size()), [&](std::ostream& fragment, size_t i) {
             const auto& stage = stages[i];
             
-            ss << "    // Stage " << i << ": " << stage.name << "\n";
-            ss << "    // DSP Mapping: " << stage.dspDescription << "\n";
+            fragment << "    // Stage " << i << ": " << stage.name << "\n";
+            fragment << "    // DSP Mapping: " << stage.dspDescription << "\n";
+            
+            if (usesControlRate()) {
+                fragment << "    // Inputs:";
+                const char* separator = " ";
+                for (const auto& input : classifyStageInputs(stage, parameters, gainParamId)) {
+                    fragment << separator << input.name << " (" << inputRateName(input.rate) << ")";
+                    separator = ", ";
+                }
+                fragment << "\n";
+            }
+            
+            if (tables.tabled.count(i) > 0) {
+                fragment << "    const LiveSpiceDSP::SubcircuitTable stage" << i << "_subcircuit { GeneratedTables::stage" << i
+                         << "_subcircuitLayout, GeneratedTables::stage" << i << "_subcircuit }; // Stateless\n\n";
+                return;
+            }
             
             // Beta mode: Use optimized processors based on pattern
             const bool isToneControl = isLikelyToneStackStage(stage);
             if (m_useBetaFeatures && isToneControl) {
-                ss << "    // [BETA] Tone stack filters (low/mid/high)\n";
-                ss << "    juce::dsp::IIR::Filter<float> stage" << i << "_toneLow;\n";
-                ss << "    juce::dsp::IIR::Filter<float> stage" << i << "_toneMid;\n";
-                ss << "    juce::dsp::IIR::Filter<float> stage" << i << "_toneHigh;\n";
+                writeToneStackMembers(fragment, i, filterType);
             } else if (m_useBetaFeatures && stage.patternStrategy == "cascaded_biquad" && stage.patternConfidence >= 0.8) {
-                ss << "    // [BETA] Optimized IIR filter for RC pattern\n";
+                fragment << "    // [BETA] Optimized IIR filter for RC pattern\n";
                 if (stage.type == StageType::LowPassFilter) {
-                    ss << "    juce::dsp::IIR::Filter<float> stage" << i << "_lpf;\n";
+                    fragment << "    " << filterType << " stage" << i << "_lpf;\n";
                 } else if (stage.type == StageType::HighPassFilter || stage.type == StageType::InputBuffer) {
-                    ss << "    juce::dsp::IIR::Filter<float> stage" << i << "_hpf;\n";
+                    fragment << "    " << filterType << " stage" << i << "_hpf;\n";
                 }
             } else {
                 // Stable mode: Use LiveSPICE component models
@@ -840,29 +3358,41 @@ private:
                     case StageType::HighPassFilter:
                     case StageType::LowPassFilter:
                     case StageType::InputBuffer:
-                        ss << "    LiveSpiceDSP::ResistorProcessor stage" << i << "_resistor;\n";
-                        ss << "    LiveSpiceDSP::CapacitorProcessor stage" << i << "_capacitor;\n";
+                        if (foldsFixedRC(stage)) {
+                            writeFoldedRCMembers(fragment, stage, i);
+                            break;
+                        }
+                        fragment << "    LiveSpiceDSP::BasicResistorProcessor<float> stage" << i << "_resistor;\n";
+                        fragment << "    LiveSpiceDSP::BasicCapacitorProcessor<float> stage" << i << "_capacitor;\n";
                         break;
                         
                     case StageType::GainStage:
                     case StageType::OutputBuffer:
-                        ss << "    juce::dsp::Gain<float> stage" << i << "_gain;\n";
+                        fragment << "    juce::dsp::Gain<float> stage" << i << "_gain;\n";
+                        if (rampsControlGain(stage, gainParamId)) {
+                            fragment << "    std::array<LiveSpiceDSP::ControlRamp, 2> stage" << i << "_control; // "
+                                     << gainParamId << " every " << m_controlRate << " samples, per channel\n";
+                        }
                         break;
                         
                     case StageType::OpAmpClipping:
                     case StageType::DiodeClipper:
-                        ss << "    LiveSpiceDSP::DiodeProcessor stage" << i << "_diode1;\n";
-                        ss << "    LiveSpiceDSP::DiodeProcessor stage" << i << "_diode2;\n";
-                        ss << "    LiveSpiceDSP::OpAmpProcessor stage" << i << "_opamp;\n";
+                        if (m_waveshaperTables) {
+                            fragment << "    std::array<LiveSpiceDSP::WaveshaperADAA, 2> stage" << i << "_shaper; // Per channel\n";
+                            break;
+                        }
+                        fragment << "    LiveSpiceDSP::DiodeProcessor stage" << i << "_diode1;\n";
+                        fragment << "    LiveSpiceDSP::DiodeProcessor stage" << i << "_diode2;\n";
+                        fragment << "    LiveSpiceDSP::OpAmpProcessor stage" << i << "_opamp;\n";
                         break;
                         
                     default:
-                        ss << "    // TODO: Add processor for " << stage.name << "\n";
+                        fragment << "    // TODO: Add processor for " << stage.name << "\n";
                         break;
                 }
             }
-            ss << "\n";
-        }
+            fragment << "\n";
+        });
 
 
 
@@ -870,23 +3400,47 @@ private:
         auto bjtMembers = collectBJTMembers(stages);
         auto fetMembers = collectFETMembers(stages);
         
+        // Lazy stages are emplaced by the first prepareToPlay
+        const auto lazyMember = [this](const std::string& type) {
+            return m_lazyStages ? "std::optional<" + type + ">" : type;
+        };
+
         if (!diodeMembers.empty() || !bjtMembers.empty() || !fetMembers.empty()) {
             ss << "    // ========================================================================\n";
             ss << "    // Nonlinear Component Models\n";
             ss << "    // ========================================================================\n\n";
+            if (m_lazyStages) {
+                ss << "    // Constructed on the first prepareToPlay, so scanning a plugin stays cheap\n\n";
+            }
 
             if (!diodeMembers.empty()) {
                 ss << "    // Diode clippers\n";
                 for (const auto& member : diodeMembers) {
-                    ss << "    Nonlinear::DiodeClippingStage " << member.memberName << ";\n";
+                    ss << "    " << lazyMember("Nonlinear::DiodeClippingStage") << " " << member.memberName << ";\n";
                 }
                 ss << "\n";
+                
+                if (m_oversamplingFactor > 1) {
+                    const std::string osType = m_adaptiveOversampling ? "LiveSpiceDSP::AdaptiveOversampler" : "LiveSpiceDSP::Oversampler";
+                    if (m_adaptiveOversampling) {
+                        ss << "    // 1x-" << m_oversamplingFactor << "x oversampling around each clipper (per channel),"
+                           << " following its input level and slope\n";
+                    } else {
+                        ss << "    // " << m_oversamplingFactor << "x oversampling around each clipper (per channel)\n";
+                    }
+                    for (const auto& member : diodeMembers) {
+                        ss << "    std::array<" << osType << ", 2> " << member.memberName << "_os {{ "
+                           << osType << "(" << m_oversamplingFactor << "), "
+                           << osType << "(" << m_oversamplingFactor << ") }};\n";
+                    }
+                    ss << "\n";
+                }
             }
             
             if (!bjtMembers.empty()) {
                 ss << "    // BJT amplifiers\n";
                 for (const auto& member : bjtMembers) {
-                    ss << "    Nonlinear::BJTModelEbersMoll " << member.memberName << ";\n";
+                    ss << "    " << lazyMember(member.stageType) << " " << member.memberName << ";\n";
                 }
                 ss << "\n";
             }
@@ -894,33 +3448,75 @@ private:
             if (!fetMembers.empty()) {
                 ss << "    // FET amplifiers\n";
                 for (const auto& member : fetMembers) {
-                    ss << "    Nonlinear::FETModelQuadratic " << member.memberName << ";\n";
+                    ss << "    " << lazyMember(member.stageType) << " " << member.memberName << ";\n";
                 }
                 ss << "\n";
             }
         }
         
+        if (bakesShapersInBackground() && hasShaperStage(stages, tables.tabled)) {
+            ss << "    // Clipper curve baked on the table worker, picked up by processBlock\n";
+            ss << "    std::shared_ptr<const LiveSpiceDSP::WaveshaperTable> bakedClipperTable;\n";
+            ss << "    std::atomic<bool> clipperTableReady { false };\n\n";
+        }
+
+        if (!wdf.clippers.empty()) {
+            ss << "    // ========================================================================\n";
+            ss << "    // Wave digital filter clippers (one tree per channel)\n";
+            ss << "    // ========================================================================\n\n";
+            for (const auto& clipper : wdf.clippers) {
+                ss << clipper.structCode;
+            }
+        }
+        
         ss << "    // ========================================================================\n";
         ss << "    // APVTS - AudioProcessorValueTreeState for parameter management\n";
         ss << "    // ========================================================================\n";
         ss << paramGenerator.generateAPVTSDeclaration();
         ss << "\n";
         ss << paramGenerator.generateParameterPointers(parameters);
+        if (m_parameterSmoothing) {
+            ss << paramGenerator.generateSmoothingMembers(parameters);
+        }
         
         ss << "    // Sample rate for DSP processing\n";
         ss << "    double currentSampleRate = 44100.0;\n";
+        if (m_silenceSleep) {
+            ss << "\n    // Silence sleep: samples with input and output below silenceThreshold, up to the tail\n";
+            ss << "    static constexpr float silenceThreshold = 1.0e-5f;\n";
+            ss << "    int silentSamples = 0;\n";
+            ss << "    int sleepAfterSamples = 0;\n";
+        }
         ss << "\n    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CircuitProcessor)\n";
         ss << "};\n";
-        
-        return ss.str();
     }
 
     std::string JuceDSPGenerator::generateProcessorImplWithParams(
-        const Netlist& netlist, const std::vector<CircuitStage>& stages)
+        const Netlist& netlist, const std::vector<CircuitStage>& circuitStages)
     {
-        std::stringstream ss;
+        CodeEmitter out(estimateCodeSize(circuitStages.size(), 16384, 2048));
+        writeProcessorImplWithParams(out, netlist, circuitStages);
+        return out.take();
+    }
+
+    void JuceDSPGenerator::writeProcessorImplWithParams(
+        std::ostream& ss, const Netlist& netlist, const std::vector<CircuitStage>& circuitStages)
+    {
+        const DKCircuitPlan dk = m_nodalDK ? planDKCircuit(netlist) : DKCircuitPlan{};
+        const bool useDK = m_nodalDK && dk.unsupported.empty();
+        const StaticChainPlan chain = m_staticChain && !useDK ? planStaticChain(circuitStages) : StaticChainPlan{};
+        const bool useStaticChain = m_staticChain && !useDK && chain.unsupported.empty();
+        const std::vector<CircuitStage> noStages;
+        const bool useWDF = m_wdfClippers && !useDK && !useStaticChain;
+        const WDFStageChain wdf = useWDF ? applyWDFClippers(netlist, circuitStages) : WDFStageChain{};
+        const auto& chainStages = useDK || useStaticChain ? noStages : (useWDF ? wdf.stages : circuitStages);
         
         auto parameters = paramGenerator.extractParametersFromCircuit(netlist);
+        const std::string gainParamId = findGainParamId(parameters);
+        const SubcircuitStageChain tables = usesSubcircuitTables()
+            ? applySubcircuitTables(chainStages, parameters, gainParamId) : SubcircuitStageChain{};
+        const auto& stages = tables.tables.empty() ? chainStages : tables.stages;
+        const double tailSeconds = estimateTailSeconds(stages);
         
                 ss << R"(/*
   ==============================================================================
@@ -943,34 +3539,86 @@ CircuitProcessor::CircuitProcessor()
         auto bjtMembers = collectBJTMembers(stages);
         auto fetMembers = collectFETMembers(stages);
         
+        // Constructor arguments of every nonlinear stage, and the solver setup that follows
+        std::vector<std::pair<std::string, std::string>> constructions;
+        std::map<std::string, std::string> setup;
         for (const auto& member : diodeMembers) {
-            ss << ", " << member.memberName
-               << "(Nonlinear::ComponentDB::getDiodeDB().getOrDefault(\""
-               << member.partNumber << "\"), "
-               << "Nonlinear::DiodeClippingStage::TopologyType::BackToBackDiodes, 10000.0f)";
+            std::string args = (m_sharedState ? "shared->" + sharedPartName("diode", member.partNumber)
+                                              : diodeInitializer(member.partNumber))
+                + ", Nonlinear::DiodeClippingStage::TopologyType::BackToBackDiodes, 10000.0f";
+            if (m_staticTables) {
+                args += ", GeneratedTables::" + diodeTableName(member.partNumber);
+            }
+            constructions.emplace_back(member.memberName, args);
+            if (m_clipperSolver != ClipperSolver::NewtonRaphson) {
+                std::string& lines = setup[member.memberName];
+                lines += stageMember(member.memberName) + "setSolverMode(Nonlinear::DiodeClippingStage::SolverMode::WrightOmega);\n";
+                if (m_clipperSolver == ClipperSolver::ADAA1 || m_clipperSolver == ClipperSolver::ADAA2) {
+                    lines += stageMember(member.memberName) + "setAntiAliasingMode(Nonlinear::DiodeClippingStage::AntiAliasingMode::"
+                        + (m_clipperSolver == ClipperSolver::ADAA1 ? "ADAA1" : "ADAA2") + ");\n";
+                }
+            }
         }
-        
         for (const auto& member : bjtMembers) {
-            ss << ", " << member.memberName
-               << "(Nonlinear::ComponentDB::getBJTDB().getOrDefault(\""
-               << member.partNumber << "\"))";
+            constructions.emplace_back(member.memberName, m_sharedState ? "shared->" + sharedPartName("bjt", member.partNumber)
+                                                                         : bjtInitializer(member.partNumber));
         }
-        
         for (const auto& member : fetMembers) {
-            ss << ", " << member.memberName
-               << "(Nonlinear::ComponentDB::getFETDB().getOrDefault(\""
-               << member.partNumber << "\"))";
+            constructions.emplace_back(member.memberName, m_sharedState ? "shared->" + sharedPartName("fet", member.partNumber)
+                                                                         : fetInitializer(member.partNumber));
+        }
+
+        if (!m_lazyStages) {
+            for (const auto& construction : constructions) {
+                ss << ", " << construction.first << "(" << construction.second << ")";
+            }
         }
 
         ss << "\n";
         ss << "{\n";
         ss << paramGenerator.generateConstructorInit(parameters);
+        if (!m_lazyStages && !setup.empty()) {
+            ss << "\n    // Clipper implementation: " << CostModel::solverName(m_clipperSolver) << "\n";
+            for (const auto& member : diodeMembers) {
+                std::istringstream lines(setup[member.memberName]);
+                for (std::string line; std::getline(lines, line);) {
+                    ss << "    " << line << "\n";
+                }
+            }
+        }
+        if (m_traceZones) {
+            ss << "\n    // Trace zones: record from construction, written when the processor is destroyed\n";
+            ss << "    LiveSpiceDSP::TraceSession::start();\n";
+        }
         ss << "}\n\n";
         
-        ss << R"(CircuitProcessor::~CircuitProcessor()
+        const bool bakingShapers = bakesShapersInBackground() && hasShaperStage(stages, tables.tabled);
+        if (m_traceZones) {
+            ss << "CircuitProcessor::~CircuitProcessor()\n{\n";
+            if (bakingShapers) {
+                ss << "    LiveSpiceDSP::TableRebuildWorker::shared().cancel (this);\n";
+            }
+            ss << R"(    LiveSpiceDSP::TraceSession::stop();
+    LiveSpiceDSP::TraceSession::write (juce::File::getSpecialLocation (juce::File::tempDirectory)
+                                           .getChildFile (juce::String (JucePlugin_Name) + ".trace.json")
+                                           .getFullPathName()
+                                           .toStdString());
+}
+)";
+        } else if (bakingShapers) {
+            ss << R"(CircuitProcessor::~CircuitProcessor()
 {
+    // A curve may still be baking into this instance
+    LiveSpiceDSP::TableRebuildWorker::shared().cancel (this);
 }
-
+)";
+        } else {
+            ss << R"(CircuitProcessor::~CircuitProcessor()
+{
+}
+)";
+        }
+        ss << R"(
 const juce::String CircuitProcessor::getName() const
 {
     return JucePlugin_Name;
@@ -993,8 +3641,9 @@ bool CircuitProcessor::isMidiEffect() const
 
 double CircuitProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
-}
+)";
+        ss << "    return " << (m_silenceSleep ? tailSeconds : 0.0) << ";\n";
+        ss << R"(}
 
 int CircuitProcessor::getNumPrograms()
 {
@@ -1022,27 +3671,226 @@ void CircuitProcessor::changeProgramName (int, const juce::String&)
 )";
 
         // Generate prepareToPlay with processors
-        ss << generatePrepareToPlayCode(stages);
+        std::string extraInit;
+        if (m_lazyStages && !constructions.empty()) {
+            extraInit += "    // Nonlinear stages: built on the first prepare rather than in the constructor\n";
+            if (!setup.empty()) {
+                extraInit += std::string("    // Clipper implementation: ") + CostModel::solverName(m_clipperSolver) + "\n";
+            }
+            for (const auto& construction : constructions) {
+                extraInit += "    if (! " + construction.first + ")\n    {\n";
+                extraInit += "        " + construction.first + ".emplace(" + construction.second + ");\n";
+                std::istringstream lines(setup[construction.first]);
+                for (std::string line; std::getline(lines, line);) {
+                    extraInit += "        " + line + "\n";
+                }
+                extraInit += "    }\n";
+            }
+            extraInit += "\n";
+        }
+        if (useDK) {
+            // Solved once per sample rate and shared by every instance, so a
+            // host re-preparing at a rate it has used before only does a lookup
+            std::string networkCode;
+            std::istringstream lines(dk.networkCode);
+            for (std::string line; std::getline(lines, line);) {
+                networkCode += (line.empty() ? "" : "    ") + line + "\n";
+            }
+            extraInit += "    // Nodal DK model: stamp the netlist and solve it once per sample rate\n";
+            if (m_sharedState) {
+                extraInit += "    const auto model = shared->dkModels.acquire(sampleRate, [](double rate) {\n";
+            } else {
+                extraInit += "    static LiveSpiceDSP::SampleRateCache<LiveSpiceDSP::DKModel> dkModels;\n";
+                extraInit += "    const auto model = dkModels.acquire(sampleRate, [](double rate) {\n";
+            }
+            extraInit += "        LiveSpiceDSP::DKNetwork network;\n";
+            extraInit += networkCode;
+            extraInit += "        return network.build(rate);\n";
+            extraInit += "    });\n";
+            extraInit += "    for (auto& circuit : dkCircuit)\n";
+            extraInit += "        circuit.setModel(*model);\n\n";
+        }
+        if (useStaticChain) {
+            extraInit += "    // Static chain: only the sample-rate dependent coefficients are computed here\n";
+            extraInit += "    for (auto& chain : circuitChain)\n";
+            extraInit += "        chain.prepare(sampleRate);\n\n";
+        }
+        if (!wdf.clippers.empty()) {
+            extraInit += "    // WDF clippers: capacitor port resistances for this sample rate\n";
+            for (const auto& clipper : wdf.clippers) {
+                extraInit += "    for (auto& clipper : " + clipper.memberName + ")\n";
+                extraInit += "        clipper.prepare(sampleRate);\n";
+            }
+            extraInit += "\n";
+        }
+        if (m_parameterSmoothing) {
+            extraInit += paramGenerator.generateSmoothingPrepare(parameters);
+        }
+        bool controlRamps = false;
+        for (size_t i = 0; i < stages.size(); ++i) {
+            if (!rampsControlGain(stages[i], gainParamId)) {
+                continue;
+            }
+            if (!controlRamps) {
+                extraInit += "    // Control-rate inputs: recomputed every " + std::to_string(m_controlRate)
+                    + " samples, ramped in between\n";
+                controlRamps = true;
+            }
+            extraInit += "    for (auto& ramp : stage" + std::to_string(i) + "_control)\n    {\n";
+            extraInit += "        ramp.setInterval(" + std::to_string(m_controlRate) + ");\n";
+            extraInit += "        ramp.reset(" + gainParamId + "Param->load());\n    }\n";
+        }
+        if (controlRamps) {
+            extraInit += "\n";
+        }
+        if (m_silenceSleep) {
+            extraInit += "    // Silence sleep: input and output must stay quiet for the whole tail\n";
+            extraInit += "    sleepAfterSamples = (int) std::ceil (sampleRate * getTailLengthSeconds());\n";
+            extraInit += "    silentSamples = 0;\n\n";
+        }
+        writePrepareToPlayCode(ss, stages, extraInit, tables.tabled);
         
         // Generate processBlock with parameter usage
-        ss << "void CircuitProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)\n{\n";
+        if (usesSubBlocks()) {
+            ss << R"(void CircuitProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+{
+    // Views into the host buffer (no copies, no allocation up to 32 channels)
+    const int numSamples = buffer.getNumSamples();
+    for (int start = 0; start < numSamples; start += subBlockSize)
+    {
+        juce::AudioBuffer<float> subBlock (buffer.getArrayOfWritePointers(), buffer.getNumChannels(),
+                                           start, juce::jmin (subBlockSize, numSamples - start));
+        processSubBlock (subBlock, midi);
+    }
+}
+
+)";
+            ss << "void CircuitProcessor::processSubBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)\n{\n";
+        } else {
+            ss << "void CircuitProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)\n{\n";
+        }
         ss << "    juce::ScopedNoDenormals noDenormals;\n";
+        if (m_traceZones) {
+            ss << "    LIVESPICE_TRACE_THREAD(\"Audio\");\n";
+            ss << "    LIVESPICE_TRACE_ZONE(\"processBlock\");\n";
+        }
         ss << "    auto totalNumInputChannels  = getTotalNumInputChannels();\n";
         ss << "    auto totalNumOutputChannels = getTotalNumOutputChannels();\n\n";
         ss << "    for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)\n";
         ss << "        buffer.clear (i, 0, buffer.getNumSamples());\n\n";
         
         // Add parameter value loading
-        ss << paramGenerator.generateParameterUsageExample(parameters);
-        
-        ss << R"(    // ========================================================================
+        if (m_parameterSmoothing) {
+            ss << paramGenerator.generateSmoothedParameterUsage(parameters);
+        } else {
+            ss << paramGenerator.generateParameterUsageExample(parameters);
+        }
+
+        bool wdfKnobs = false;
+        for (const auto& clipper : wdf.clippers) {
+            for (const auto& knob : clipper.knobs) {
+                const auto param = std::find_if(parameters.begin(), parameters.end(),
+                                                [&](const auto& p) { return p.componentName == knob.componentName; });
+                if (param == parameters.end()) {
+                    continue;
+                }
+                if (!wdfKnobs) {
+                    ss << "    // WDF clippers follow their pots; only the adaptors above a moved pot re-adapt\n";
+                    wdfKnobs = true;
+                }
+                if (m_parameterSmoothing) {
+                    ss << "    if (" << param->id << "Dirty)\n    ";
+                }
+                ss << "    for (auto& clipper : " << clipper.memberName << ")\n";
+                ss << (m_parameterSmoothing ? "    " : "") << "        clipper." << knob.setter << "(" << param->id << "Value);\n";
+            }
+        }
+        if (wdfKnobs) {
+            ss << "\n";
+        }
+
+        if (!tables.tables.empty()) {
+            ss << "    // Subcircuit tables read their pots once per block\n";
+            for (const auto& plan : tables.tables) {
+                ss << "    const LiveSpiceDSP::SubcircuitTable::Controls stage" << plan.stage << "_controls "
+                   << subcircuitControls(plan) << ";\n";
+            }
+            ss << "\n";
+        }
+
+        writeShaperPickup(ss, stages, tables.tabled);
+
+        bool controlTargets = false;
+        for (size_t i = 0; i < stages.size(); ++i) {
+            if (!rampsControlGain(stages[i], gainParamId)) {
+                continue;
+            }
+            if (!controlTargets) {
+                ss << "    // Control-rate inputs ramp to this block's knob values\n";
+                controlTargets = true;
+            }
+            ss << "    for (auto& ramp : stage" << i << "_control)\n";
+            ss << "        ramp.setTarget(" << gainParamId << "Value);\n";
+        }
+        if (controlTargets) {
+            ss << "\n";
+        }
+
+        if (m_silenceSleep) {
+            ss << R"(    // Silence sleep: once the tail has decayed, silent input needs no processing
+    const int sleepBlockSamples = buffer.getNumSamples();
+    float sleepInputPeak = 0.0f;
+    for (int channel = 0; channel < totalNumInputChannels; ++channel)
+        sleepInputPeak = juce::jmax (sleepInputPeak, buffer.getMagnitude (channel, 0, sleepBlockSamples));
+
+    if (sleepInputPeak < silenceThreshold && silentSamples >= sleepAfterSamples)
+    {
+        buffer.clear();
+        return;
+    }
+
+)";
+        }
+
+        if (useDK) {
+            ss << R"(    // ========================================================================
+    // Nodal DK-method circuit simulation
+    // ========================================================================
+
+    for (int channel = 0; channel < totalNumInputChannels; ++channel)
+    {
+        auto* channelData = buffer.getWritePointer(channel);
+        auto& circuit = dkCircuit[(size_t) juce::jmin(channel, 1)];
+
+        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+            channelData[sample] = circuit.processSample(channelData[sample]);
+    }
+)";
+        } else if (useStaticChain) {
+            ss << R"(    // ========================================================================
+    // Compile-time stage chain, inlined into one loop per channel
+    // ========================================================================
+
+    for (int channel = 0; channel < totalNumInputChannels; ++channel)
+        circuitChain[(size_t) juce::jmin(channel, 1)].processBlock(buffer.getWritePointer(channel),
+                                                                   (size_t) buffer.getNumSamples());
+)";
+        } else if (emitsBlockCode()) {
+            writeBlockProcessingCode(ss, stages, gainParamId, true, wdf.calls, tables.tabled);
+        } else {
+            ss << R"(    // ========================================================================
     // LiveSPICE Component-Based DSP Processing
     // Sample-by-sample processing for accurate component modeling
     // ========================================================================
 
     for (int channel = 0; channel < totalNumInputChannels; ++channel)
     {
-        auto* channelData = buffer.getWritePointer(channel);
+)";
+            if (m_traceZones) {
+                // Per-stage zones would cost more than the stages at one sample each
+                ss << "        LIVESPICE_TRACE_ZONE(\"Sample loop\");\n";
+            }
+            ss << R"(        auto* channelData = buffer.getWritePointer(channel);
         
         for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
         {
@@ -1050,99 +3898,116 @@ void CircuitProcessor::changeProgramName (int, const juce::String&)
             
 )";
 
-        // Generate stage processing with parameter influence
-        std::map<std::string, std::string> diodeMemberMap;
-        std::map<std::string, std::string> bjtMemberMap;
-        std::map<std::string, std::string> fetMemberMap;
+            // Generate stage processing with parameter influence
+            std::map<std::string, std::string> diodeMemberMap;
+            std::map<std::string, std::string> bjtMemberMap;
+            std::map<std::string, std::string> fetMemberMap;
         
-        for (const auto& member : diodeMembers) {
-            diodeMemberMap[member.componentName] = member.memberName;
-        }
-        for (const auto& member : bjtMembers) {
-            bjtMemberMap[member.componentName] = member.memberName;
-        }
-        for (const auto& member : fetMembers) {
-            fetMemberMap[member.componentName] = member.memberName;
-        }
+            for (const auto& member : diodeMembers) {
+                diodeMemberMap[member.componentName] = member.memberName;
+            }
+            for (const auto& member : bjtMembers) {
+                bjtMemberMap[member.componentName] = member.memberName;
+            }
+            for (const auto& member : fetMembers) {
+                fetMemberMap[member.componentName] = member.memberName;
+            }
 
-        for (size_t i = 0; i < stages.size(); ++i) {
-            const auto& stage = stages[i];
+            emitFragments(ss, stages.size(), fragmentThreads(stages.size()), [&](std::ostream& fragment, size_t i) {
+                const auto& stage = stages[i];
             
-            ss << "            // Stage " << i << ": " << stage.name << "\n";
+                fragment << "            // Stage " << i << ": " << stage.name << "\n";
 
-            const bool isToneControl = isLikelyToneStackStage(stage);
-            if (m_useBetaFeatures && isToneControl) {
-                ss << "            // [BETA] Tone stack (low/mid/high shelves)\n";
-                ss << "            signal = stage" << i << "_toneLow.processSample(signal);\n";
-                ss << "            signal = stage" << i << "_toneMid.processSample(signal);\n";
-                ss << "            signal = stage" << i << "_toneHigh.processSample(signal);\n\n";
-                continue;
-            }
+                const bool isToneControl = isLikelyToneStackStage(stage);
+                if (m_useBetaFeatures && isToneControl) {
+                    writeToneStackSampleCode(fragment, i);
+                    return;
+                }
             
-            // Use pattern-specific or legacy code generation based on mode
-            if (m_useBetaFeatures && !stage.patternStrategy.empty() && stage.patternConfidence >= 0.8) {
-                ss << "            // [BETA] Pattern: " << stage.patternName << " (confidence: " << stage.patternConfidence << ")\n";
-                ss << generatePatternSpecificCode(stage, i);
-            } else {
-                if (m_useBetaFeatures && stage.patternConfidence < 0.8) {
-                    ss << "            // [BETA] Low confidence pattern match, using stable code\n";
+                // Use pattern-specific or legacy code generation based on mode
+                if (tables.tabled.count(i) > 0) {
+                    fragment << "            // Pre-solved clipper subcircuit\n";
+                    fragment << "            signal = stage" << i << "_subcircuit.process(signal, stage" << i << "_controls);\n\n";
+                } else if (m_useBetaFeatures && !stage.patternStrategy.empty() && stage.patternConfidence >= 0.8) {
+                    fragment << "            // [BETA] Pattern: " << stage.patternName << " (confidence: " << stage.patternConfidence << ")\n";
+                    writePatternSpecificCode(fragment, stage, i);
+                } else {
+                    if (m_useBetaFeatures && stage.patternConfidence < 0.8) {
+                        fragment << "            // [BETA] Low confidence pattern match, using stable code\n";
+                    }
+                    writeStableLegacyCode(fragment, stage, i);
                 }
-                ss << generateStableLegacyCode(stage, i);
-            }
 
-            if (!stage.nonlinearComponents.empty()) {
-                bool hasNonlinear = false;
-                
-                // Process diodes
-                for (const auto& nonlinear : stage.nonlinearComponents) {
-                    if (nonlinear.diodeChar.has_value()) {
-                        if (!hasNonlinear) {
-                            ss << "            // Nonlinear component processing\n";
-                            hasNonlinear = true;
-                        }
-                        const auto it = diodeMemberMap.find(nonlinear.name);
-                        if (it != diodeMemberMap.end()) {
-                            ss << "            signal = " << it->second << ".processSample(signal);\n";
-                        }
+                if (rampsControlGain(stage, gainParamId)) {
+                    fragment << "            // Control-rate input: " << gainParamId << ", ramped every " << m_controlRate << " samples\n";
+                    fragment << "            signal *= stage" << i << "_control[(size_t) juce::jmin(channel, 1)].next();\n\n";
+                }
+
+                const auto wdfCalls = wdf.calls.find(i);
+                if (wdfCalls != wdf.calls.end()) {
+                    fragment << "            // Wave digital filter clipper\n";
+                    for (const auto& member : wdfCalls->second) {
+                        fragment << "            signal = " << member << "[(size_t) juce::jmin(channel, 1)].processSample(signal);\n";
                     }
+                    fragment << "\n";
                 }
+
+                if (!stage.nonlinearComponents.empty()) {
+                    bool hasNonlinear = false;
                 
-                // Process BJTs
-                for (const auto& nonlinear : stage.nonlinearComponents) {
-                    if (nonlinear.bjtChar.has_value()) {
-                        if (!hasNonlinear) {
-                            ss << "            // Nonlinear component processing\n";
-                            hasNonlinear = true;
-                        }
-                        const auto it = bjtMemberMap.find(nonlinear.name);
-                        if (it != bjtMemberMap.end()) {
-                            ss << "            signal = " << it->second << ".processSample(signal);\n";
+                    // Process diodes
+                    for (const auto& nonlinear : stage.nonlinearComponents) {
+                        if (nonlinear.diodeChar.has_value()) {
+                            if (!hasNonlinear) {
+                                fragment << "            // Nonlinear component processing\n";
+                                hasNonlinear = true;
+                            }
+                            const auto it = diodeMemberMap.find(nonlinear.name);
+                            if (it != diodeMemberMap.end() && m_oversamplingFactor > 1) {
+                                fragment << "            signal = " << it->second << "_os[juce::jmin(channel, 1)].processSample(signal, [this](float s) { return "
+                                   << stageMember(it->second) << "processSample(s); });\n";
+                            } else if (it != diodeMemberMap.end()) {
+                                fragment << "            signal = " << stageMember(it->second) << "processSample(signal);\n";
+                            }
                         }
                     }
-                }
                 
-                // Process FETs
-                for (const auto& nonlinear : stage.nonlinearComponents) {
-                    if (nonlinear.fetChar.has_value()) {
-                        if (!hasNonlinear) {
-                            ss << "            // Nonlinear component processing\n";
-                            hasNonlinear = true;
+                    // Process BJTs
+                    for (const auto& nonlinear : stage.nonlinearComponents) {
+                        if (nonlinear.bjtChar.has_value()) {
+                            if (!hasNonlinear) {
+                                fragment << "            // Nonlinear component processing\n";
+                                hasNonlinear = true;
+                            }
+                            const auto it = bjtMemberMap.find(nonlinear.name);
+                            if (it != bjtMemberMap.end()) {
+                                fragment << "            signal = " << stageMember(it->second) << "processSample(signal);\n";
+                            }
                         }
-                        const auto it = fetMemberMap.find(nonlinear.name);
-                        if (it != fetMemberMap.end()) {
-                            ss << "            signal = " << it->second << ".processSample(signal);\n";
+                    }
+                
+                    // Process FETs
+                    for (const auto& nonlinear : stage.nonlinearComponents) {
+                        if (nonlinear.fetChar.has_value()) {
+                            if (!hasNonlinear) {
+                                fragment << "            // Nonlinear component processing\n";
+                                hasNonlinear = true;
+                            }
+                            const auto it = fetMemberMap.find(nonlinear.name);
+                            if (it != fetMemberMap.end()) {
+                                fragment << "            signal = " << stageMember(it->second) << "processSample(signal);\n";
+                            }
                         }
                     }
-                }
                 
-                if (hasNonlinear) {
-                    ss << "\n";
+                    if (hasNonlinear) {
+                        fragment << "\n";
+                    }
                 }
-            }
 
-        }
+            });
         
-        ss << R"(            channelData[sample] = signal;
+            ss << R"(            channelData[sample] = signal;
         }
     }
 
@@ -1152,28 +4017,48 @@ void CircuitProcessor::changeProgramName (int, const juce::String&)
 
 )";
 
-        // Apply gains with parameters
-        for (size_t i = 0; i < stages.size(); ++i) {
-            const auto& stage = stages[i];
+            // Apply gains with parameters
+            for (size_t i = 0; i < stages.size(); ++i) {
+                const auto& stage = stages[i];
             
-            if (stage.type == StageType::GainStage || stage.type == StageType::OutputBuffer) {
-                // Check if we have a parameter for this stage
-                bool hasParam = false;
-                for (const auto& param : parameters) {
-                    if (param.id.find("drive") != std::string::npos || 
-                        param.id.find("level") != std::string::npos) {
-                        ss << "    // Apply " << param.name << " parameter\n";
-                        ss << "    stage" << i << "_gain.setGainLinear(" << param.id << "Value);\n";
-                        hasParam = true;
-                        break;
-                    }
+                if (rampsControlGain(stage, gainParamId)) {
+                    continue;   // Applied per sample above
                 }
-                if (!hasParam) {
-                    ss << "    stage" << i << "_gain.process(context);\n";
+                if (stage.type == StageType::GainStage || stage.type == StageType::OutputBuffer) {
+                    // Check if we have a parameter for this stage
+                    bool hasParam = false;
+                    for (const auto& param : parameters) {
+                        if (param.id.find("drive") != std::string::npos || 
+                            param.id.find("level") != std::string::npos) {
+                            ss << "    // Apply " << param.name << " parameter\n";
+                            if (m_parameterSmoothing) {
+                                ss << "    if (" << param.id << "Dirty)\n    ";
+                            }
+                            ss << "    stage" << i << "_gain.setGainLinear(" << param.id << "Value);\n";
+                            hasParam = true;
+                            break;
+                        }
+                    }
+                    if (!hasParam) {
+                        ss << "    stage" << i << "_gain.process(context);\n";
+                    }
                 }
             }
         }
-        
+
+        if (m_silenceSleep) {
+            ss << R"(
+    float sleepOutputPeak = 0.0f;
+    for (int channel = 0; channel < totalNumOutputChannels; ++channel)
+        sleepOutputPeak = juce::jmax (sleepOutputPeak, buffer.getMagnitude (channel, 0, sleepBlockSamples));
+
+    if (sleepInputPeak < silenceThreshold && sleepOutputPeak < silenceThreshold)
+        silentSamples = juce::jmin (silentSamples + sleepBlockSamples, sleepAfterSamples);
+    else
+        silentSamples = 0;
+)";
+        }
+
         ss << "}\n\n";
         
         ss << R"(void CircuitProcessor::releaseResources()
@@ -1213,8 +4098,6 @@ juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
     return new CircuitProcessor();
 }
 )";
-        
-        return ss.str();
     }
 
     // ============================================================================
@@ -1222,45 +4105,52 @@ juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
     // ============================================================================
     
     std::string JuceDSPGenerator::generatePatternSpecificCode(const CircuitStage& stage, size_t stageIndex) const {
-        std::stringstream ss;
-        
+        CodeEmitter out(1024);
+        writePatternSpecificCode(out, stage, stageIndex);
+        return out.take();
+    }
+
+    std::string JuceDSPGenerator::generateStableLegacyCode(const CircuitStage& stage, size_t stageIndex) const {
+        CodeEmitter out(1024);
+        writeStableLegacyCode(out, stage, stageIndex);
+        return out.take();
+    }
+
+    void JuceDSPGenerator::writePatternSpecificCode(std::ostream& ss, const CircuitStage& stage, size_t stageIndex) const {
         // Generate optimized code based on pattern strategy
         const bool isToneControl = isLikelyToneStackStage(stage);
         if (isToneControl) {
             // Tone control network (simple 3-band EQ)
-            ss << "            // [BETA] Tone stack (low/mid/high shelves)\n";
-            ss << "            signal = stage" << stageIndex << "_toneLow.processSample(signal);\n";
-            ss << "            signal = stage" << stageIndex << "_toneMid.processSample(signal);\n";
-            ss << "            signal = stage" << stageIndex << "_toneHigh.processSample(signal);\n\n";
+            writeToneStackSampleCode(ss, stageIndex);
 
         } else if (stage.patternStrategy == "cascaded_biquad") {
             // Optimized biquad filter for RC patterns
             ss << "            // [BETA] Optimized biquad for RC filter pattern\n";
             
             // Get cutoff frequency from stage parameters
-            auto fcIt = stage.dspParams.find("cutoff_frequency");
-            auto hpfcIt = stage.dspParams.find("highpass_frequency");
+            const double* lpfc = stage.params.find(StageParam::CutoffFrequency);
+            const double* hpfc = stage.params.find(StageParam::HighpassFrequency);
             
-            if (stage.type == StageType::LowPassFilter && fcIt != stage.dspParams.end()) {
-                double fc = fcIt->second;
+            if (stage.type == StageType::LowPassFilter && lpfc) {
+                double fc = *lpfc;
                 ss << "            // Low-pass biquad: fc = " << fc << " Hz\n";
                 ss << "            signal = stage" << stageIndex << "_lpf.processSample(signal);\n\n";
                 
-            } else if (stage.type == StageType::HighPassFilter && hpfcIt != stage.dspParams.end()) {
-                double fc = hpfcIt->second;
+            } else if (stage.type == StageType::HighPassFilter && hpfc) {
+                double fc = *hpfc;
                 ss << "            // High-pass biquad: fc = " << fc << " Hz\n";
                 ss << "            signal = stage" << stageIndex << "_hpf.processSample(signal);\n\n";
                 
-            } else if (stage.type == StageType::InputBuffer && hpfcIt != stage.dspParams.end()) {
+            } else if (stage.type == StageType::InputBuffer && hpfc) {
                 // Input buffer often has high-pass coupling
-                double fc = hpfcIt->second;
+                double fc = *hpfc;
                 ss << "            // Input coupling high-pass: fc = " << fc << " Hz\n";
                 ss << "            signal = stage" << stageIndex << "_hpf.processSample(signal);\n\n";
                 
             } else {
                 // No frequency parameters - fall back to stable
                 ss << "            // No frequency parameters found, using stable implementation\n";
-                ss << generateStableLegacyCode(stage, stageIndex);
+                writeStableLegacyCode(ss, stage, stageIndex);
             }
             
         } else if (stage.patternStrategy == "nonlinear_clipper") {
@@ -1274,40 +4164,49 @@ juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
             // Optimized op-amp gain stage
             ss << "            // [BETA] Optimized op-amp gain\n";
             
-            auto gainIt = stage.dspParams.find("gain_linear");
-            if (gainIt != stage.dspParams.end()) {
-                double gain = gainIt->second;
+            if (const double* gainParam = stage.params.find(StageParam::GainLinear)) {
+                double gain = *gainParam;
                 ss << "            // Simple gain multiplication: " << gain << "x\n";
+                FragmentFormat format(ss);
                 ss << "            signal *= " << std::fixed << std::setprecision(6) << gain << "f;\n\n";
             } else {
                 ss << "            // No gain parameter, using stable implementation\n";
-                ss << generateStableLegacyCode(stage, stageIndex);
+                writeStableLegacyCode(ss, stage, stageIndex);
             }
             
         } else {
             // Unknown pattern - use stable code
             ss << "            // Unknown pattern strategy: " << stage.patternStrategy << "\n";
-            ss << generateStableLegacyCode(stage, stageIndex);
+            writeStableLegacyCode(ss, stage, stageIndex);
         }
-        
-        return ss.str();
     }
     
     // ============================================================================
     // STABLE: Legacy Code Generation (Proven)
     // ============================================================================
     
-    std::string JuceDSPGenerator::generateStableLegacyCode(const CircuitStage& stage, size_t stageIndex) const {
-        std::stringstream ss;
-        
+    void JuceDSPGenerator::writeStableLegacyCode(std::ostream& ss, const CircuitStage& stage, size_t stageIndex) const {
         switch (stage.type) {
             case StageType::HighPassFilter:
             case StageType::LowPassFilter:
             case StageType::InputBuffer:
+                if (foldsFixedRC(stage)) {
+                    const std::string prefix = "stage" + std::to_string(stageIndex);
+                    ss << "            // Folded RC one-pole (per-channel state)\n";
+                    ss << "            {\n";
+                    ss << "                const int lane = juce::jmin(channel, 1);\n";
+                    ss << "                const float y = " << prefix << "_b0 * signal + " << prefix << "_b1 * " << prefix
+                       << "_x1[lane] - " << prefix << "_a1 * " << prefix << "_y1[lane];\n";
+                    ss << "                " << prefix << "_x1[lane] = signal;\n";
+                    ss << "                " << prefix << "_y1[lane] = y;\n";
+                    ss << "                signal = y;\n";
+                    ss << "            }\n\n";
+                    break;
+                }
                 ss << "            // RC filter using LiveSPICE components\\n";
                 ss << "            stage" << stageIndex << "_resistor.process(signal);\\n";
-                ss << "            stage" << stageIndex << "_capacitor.process(signal, currentSampleRate);\\n";
-                ss << "            signal = (float)stage" << stageIndex << "_capacitor.getVoltage();\\n\\n";
+                ss << "            stage" << stageIndex << "_capacitor.process(signal);\\n";
+                ss << "            signal = stage" << stageIndex << "_capacitor.getVoltage();\\n\\n";
                 break;
                 
             case StageType::GainStage:
@@ -1317,6 +4216,18 @@ juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
                 
             case StageType::OpAmpClipping:
             case StageType::DiodeClipper:
+                if (bakesShapersInBackground()) {
+                    const std::string shaper = "stage" + std::to_string(stageIndex) + "_shaper[(size_t) juce::jmin(channel, 1)]";
+                    ss << "            // Diode clipper: baked table with ADAA, a hard clip at the diode drop until it is baked\n";
+                    ss << "            signal = " << shaper << ".getTable() != nullptr ? " << shaper
+                       << ".process(signal) : juce::jlimit(-0.6f, 0.6f, signal);\n\n";
+                    break;
+                }
+                if (m_waveshaperTables) {
+                    ss << "            // Diode clipper: baked table with ADAA\n";
+                    ss << "            signal = stage" << stageIndex << "_shaper[(size_t) juce::jmin(channel, 1)].process(signal);\n\n";
+                    break;
+                }
                 ss << "            // Diode clipper with Shockley equation\\n";
                 ss << "            stage" << stageIndex << "_diode1.process(signal);\\n";
                 ss << "            stage" << stageIndex << "_diode2.process(-signal);\\n";
@@ -1329,8 +4240,6 @@ juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
                 ss << "            // TODO: Process with LiveSPICE component\\n\\n";
                 break;
         }
-        
-        return ss.str();
     }
 
 } // namespace LiveSpice
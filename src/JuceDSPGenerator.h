@@ -2,7 +2,11 @@
 
 #include "CircuitAnalyzer.h"
 #include "ComponentDSPMapper.h"
+#include "CostModel.h"
 #include "ParameterGenerator.h"
+#include <map>
+#include <ostream>
+#include <set>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -14,11 +18,178 @@ namespace LiveSpice {
     // ============================================================================
     class JuceDSPGenerator {
     public:
-        JuceDSPGenerator() : m_useBetaFeatures(false) {}
+        // Stages below which per-stage fragments are generated on the calling
+        // thread only (thread start-up outweighs a few hundred small fragments)
+        static constexpr size_t PARALLEL_MIN_STAGES = 128;
+
+        // Subcircuit table error budget (V) when tables are asked for without one
+        static constexpr double DEFAULT_SUBCIRCUIT_BUDGET = 1e-3;
+
+        JuceDSPGenerator()
+            : m_useBetaFeatures(false), m_oversamplingFactor(1), m_adaptiveOversampling(false), m_blockProcessing(false), m_simdChannels(false),
+              m_parameterSmoothing(false), m_foldFixedNetworks(false), m_staticTables(false), m_nodalDK(false),
+              m_wdfClippers(false), m_benchmarkHarness(false), m_silenceSleep(false), m_staticChain(false), m_traceZones(false), m_svfToneStack(false),
+              m_waveshaperTables(false), m_controlRate(0), m_sharedState(false), m_subcircuitTableBudget(0.0), m_lazyStages(false), m_subBlockSize(0),
+              m_clipperSolver(ClipperSolver::NewtonRaphson), m_jobs(0) {}
+
+        // Threads for the per-stage fragments of large circuits; 0 = hardware
+        // concurrency, 1 = serial (batch workers already fill the cores)
+        void setJobs(unsigned jobs) { m_jobs = jobs; }
+        unsigned getJobs() const { return m_jobs; }
         
         // Enable/disable beta features (pattern-specific code generation)
         void setBetaMode(bool enabled) { m_useBetaFeatures = enabled; }
         bool isBetaMode() const { return m_useBetaFeatures; }
+        
+        // Oversample nonlinear (diode) stages in generated code: 1 = off, 2/4/8
+        void setOversamplingFactor(int factor) { m_oversamplingFactor = factor; }
+        int getOversamplingFactor() const { return m_oversamplingFactor; }
+
+        // Treat the oversampling factor as a ceiling: each clipper runs at
+        // 1x..factor, chosen per block from the level and slope it is fed
+        void setAdaptiveOversampling(bool enabled) { m_adaptiveOversampling = enabled; }
+        bool isAdaptiveOversampling() const { return m_adaptiveOversampling; }
+
+        // Emit processBlock as one pass per stage over each channel buffer
+        // instead of running the whole chain per sample
+        void setBlockProcessing(bool enabled) { m_blockProcessing = enabled; }
+        bool isBlockProcessing() const { return m_blockProcessing; }
+
+        // Pack the channels into juce::dsp::SIMDRegister lanes for the IIR
+        // filter stages so stereo runs in one pass (implies block processing)
+        void setSimdChannels(bool enabled) { m_simdChannels = enabled; }
+        bool isSimdChannels() const { return m_simdChannels; }
+
+        // Smooth knob parameters and only update knob-driven stages when a
+        // value changed (per-block dirty flags)
+        void setParameterSmoothing(bool enabled) { m_parameterSmoothing = enabled; }
+        bool isParameterSmoothing() const { return m_parameterSmoothing; }
+
+        // Fold RC stages without potentiometers into one-pole coefficients
+        // (time constant constexpr, coefficients computed in prepareToPlay)
+        void setFoldFixedNetworks(bool enabled) { m_foldFixedNetworks = enabled; }
+        bool isFoldFixedNetworks() const { return m_foldFixedNetworks; }
+
+        // Write NonlinearTables.h with precomputed read-only diode tables for
+        // the parts in the circuit; the processor references them directly
+        void setStaticTables(bool enabled) { m_staticTables = enabled; }
+        bool isStaticTables() const { return m_staticTables; }
+
+        // Simulate the whole netlist with the nodal DK method (MNA solved per
+        // sample rate, Newton only over the diode ports) instead of the stage
+        // chain; netlists the backend cannot model keep the stage chain
+        void setNodalDK(bool enabled) { m_nodalDK = enabled; }
+        bool isNodalDK() const { return m_nodalDK; }
+
+        // Why the DK backend cannot simulate this netlist (empty when it can)
+        std::string checkNodalDK(const Netlist& netlist) const;
+
+        // Replace diode clippers to ground with wave digital filter trees
+        // (series/parallel adaptors, closed-form diode root); a pot in the
+        // tree re-adapts only the adaptors above it
+        void setWdfClippers(bool enabled) { m_wdfClippers = enabled; }
+        bool isWdfClippers() const { return m_wdfClippers; }
+
+        // Diodes the WDF backend simulates in this netlist (empty when none qualify)
+        std::vector<std::string> findWdfClippers(const Netlist& netlist) const;
+
+        // Write Benchmark.cpp and a <plugin>_Benchmark console target that
+        // times the generated CircuitProcessor without a host
+        void setBenchmarkHarness(bool enabled) { m_benchmarkHarness = enabled; }
+        bool isBenchmarkHarness() const { return m_benchmarkHarness; }
+
+        // Skip processBlock on silent input once the circuit's filter tail
+        // has decayed below -100 dBFS; the first non-silent block runs as usual
+        void setSilenceSleep(bool enabled) { m_silenceSleep = enabled; }
+        bool isSilenceSleep() const { return m_silenceSleep; }
+
+        // Write CircuitChain.h, the stage chain as a compile-time type list
+        // with component values as constants, and run it in place of the
+        // runtime component objects; chains with transistors keep those
+        void setStaticChain(bool enabled) { m_staticChain = enabled; }
+        bool isStaticChain() const { return m_staticChain; }
+
+        // Why the stage chain cannot be made static (empty when it can)
+        std::string checkStaticChain(const std::vector<CircuitStage>& stages) const;
+
+        // Wrap processBlock and each block-processing stage loop in
+        // LIVESPICE_TRACE_ZONE and write a Chrome trace when the processor
+        // is destroyed (TraceZones.h, built with LIVESPICE_TRACE=1)
+        void setTraceZones(bool enabled) { m_traceZones = enabled; }
+        bool isTraceZones() const { return m_traceZones; }
+
+        // Build the beta tone stack from TPT state-variable filters
+        // (LiveSpiceDSP::SVFFilter, retunable per sample) instead of IIR biquads
+        void setSvfToneStack(bool enabled) { m_svfToneStack = enabled; }
+        bool isSvfToneStack() const { return m_svfToneStack; }
+
+        // Replace the per-sample diode/op-amp clipper calls of the stable
+        // path with a baked diode-pair curve (LiveSpiceDSP::WaveshaperTable),
+        // run with first-order ADAA; block mode makes it one table pass
+        void setWaveshaperTables(bool enabled) { m_waveshaperTables = enabled; }
+        bool isWaveshaperTables() const { return m_waveshaperTables; }
+
+        // Multi-rate processing: knob-driven stage inputs are recomputed every
+        // `samples` samples and ramped in between (LiveSpiceDSP::ControlRamp)
+        // while only the signal runs per sample; 0 or 1 = everything per block
+        void setControlRate(int samples) { m_controlRate = samples; }
+        int getControlRate() const { return m_controlRate; }
+
+        // Keep everything immutable (device parameters, baked tables, per-rate
+        // models and coefficients) in one process-wide SharedState that every
+        // instance references (LiveSpiceDSP::SharedContext), so extra
+        // instances only carry their mutable state
+        void setSharedState(bool enabled) { m_sharedState = enabled; }
+        bool isSharedState() const { return m_sharedState; }
+
+        // Pre-solve recognised clipper subcircuits (op-amp with feedback
+        // diodes, diodes to ground) over input and their pots into
+        // LiveSpiceDSP::SubcircuitTable data (SubcircuitTables.h), refined
+        // until the interpolation error is below maxErrorVolts; 0 = off
+        void setSubcircuitTableBudget(double maxErrorVolts) { m_subcircuitTableBudget = maxErrorVolts; }
+        double getSubcircuitTableBudget() const { return m_subcircuitTableBudget; }
+
+        // Fast startup: the constructor only builds the parameter layout;
+        // nonlinear stages are constructed on the first prepareToPlay and
+        // baked waveshaper curves on LiveSpiceDSP::TableRebuildWorker, with
+        // a hard clip at the diode drop until the table arrives
+        void setLazyStages(bool enabled) { m_lazyStages = enabled; }
+        bool isLazyStages() const { return m_lazyStages; }
+
+        // Split host blocks into runs of `samples` (32 or 64 suggested) and
+        // re-read the parameters for each, so automation lands within a
+        // sub-block whatever the host's buffer size; 0 or 1 = whole blocks
+        void setSubBlockSize(int samples) { m_subBlockSize = samples; }
+        int getSubBlockSize() const { return m_subBlockSize; }
+
+        // How a stage input is updated in the generated processor
+        enum class InputRate {
+            Audio,      // Every sample (the signal)
+            Control,    // Follows a knob: per control period, or per block
+            Constant    // Fixed component values, folded at prepare time
+        };
+
+        struct StageInput {
+            std::string name;     // "signal", the knob, or "components"
+            InputRate rate;
+            std::string source;   // Parameter id for control inputs
+        };
+
+        // Inputs of one stage and their rates; gainParamId is the knob the
+        // gain stages follow (empty = none)
+        std::vector<StageInput> classifyStageInputs(const CircuitStage& stage,
+                                                    const std::vector<JuceParameter>& parameters,
+                                                    const std::string& gainParamId) const;
+
+        // Implementation of every diode clipper (Newton-Raphson by default)
+        void setClipperSolver(ClipperSolver solver) { m_clipperSolver = solver; }
+        ClipperSolver getClipperSolver() const { return m_clipperSolver; }
+
+        // Pick the most accurate clipper solver and oversampling factor whose
+        // estimated cost fits budgetNsPerSample (per channel-sample) and apply
+        // them; fixedOversampling keeps the current factor
+        CostModel::Plan applyCpuBudget(const std::vector<CircuitStage>& stages, double budgetNsPerSample,
+                                       bool fixedOversampling);
 
         // Generate complete JUCE plugin processor code
         std::string generateProcessorHeader();
@@ -26,6 +197,7 @@ namespace LiveSpice {
         
         // Generate DSP processing blocks
         std::string generateDSPStages(const std::vector<CircuitStage>& stages);
+        void writeDSPStages(std::ostream& out, const std::vector<CircuitStage>& stages);
         
         // Generate parameter definitions
         std::string generateParameterDefinitions(const Netlist& netlist);
@@ -33,12 +205,44 @@ namespace LiveSpice {
         // Generate the complete plugin files
         void generateJucePlugin(const std::string& outputDir, const std::string& pluginName);
         
-        // Write generated files to disk
-        void writePluginFiles(const std::string& pluginDir, const std::string& pluginName, 
-                            const std::vector<CircuitStage>& stages, const Netlist& netlist);
+        // A file produced by writePluginFiles; changed is false when the file
+        // on disk already held this content and was left untouched
+        struct GeneratedFile {
+            std::string name;
+            bool changed;
+        };
+
+        // A generated file's content, before it is written
+        struct PluginFile {
+            std::string name;
+            std::string content;
+        };
+
+        // Render the plugin sources (everything writePluginFiles writes) without touching disk
+        std::vector<PluginFile> generatePluginFiles(const std::string& pluginName,
+                                                    const std::vector<CircuitStage>& stages, const Netlist& netlist);
+
+        // Write generated files to disk, skipping those whose content is unchanged
+        std::vector<GeneratedFile> writePluginFiles(const std::string& pluginDir, const std::string& pluginName,
+                                                    const std::vector<CircuitStage>& stages, const Netlist& netlist);
+
+        // Write content unless path already holds it (keeps mtimes, so builds stay no-op)
+        // Returns true if the file was written (false when unchanged or unwritable)
+        static bool writeIfChanged(const std::string& path, const std::string& content);
+        
+        // Generate NonlinearTables.h (static diode current tables)
+        std::string generateNonlinearTablesHeader(const std::vector<CircuitStage>& stages) const;
+
+        // Generate SubcircuitTables.h (pre-solved clipper subcircuits; empty
+        // when no stage qualifies)
+        std::string generateSubcircuitTablesHeader(const Netlist& netlist, const std::vector<CircuitStage>& stages);
+
+        // Generate Benchmark.cpp (headless timing of CircuitProcessor)
+        std::string generateBenchmarkSource(const std::string& pluginName) const;
         
-        // Generate CMakeLists.txt for JUCE compilation
-        std::string generateCMakeLists(const std::string& pluginName, const std::string& juceRelativePath);
+        // Generate CMakeLists.txt for JUCE compilation (withDKSolver adds DKMethod.cpp and SparseLU.cpp)
+        std::string generateCMakeLists(const std::string& pluginName, const std::string& juceRelativePath,
+                                       bool withDKSolver = false);
         
         // Helper methods for code generation
         std::string generateFilterCode(const CircuitStage& stage);
@@ -49,19 +253,95 @@ namespace LiveSpice {
         // Generate JUCE-specific code components
         std::string generateProcessBlockCode(const std::vector<CircuitStage>& stages);
         std::string generateStateVariables(const std::vector<CircuitStage>& stages);
-        std::string generatePrepareToPlayCode(const std::vector<CircuitStage>& stages);
+        std::string generatePrepareToPlayCode(const std::vector<CircuitStage>& stages,
+                                              const std::string& extraInit = "");
+        void writePrepareToPlayCode(std::ostream& out, const std::vector<CircuitStage>& stages,
+                                    const std::string& extraInit = "",
+                                    const std::set<size_t>& subcircuitTables = {});
         
-        // Phase 6: Parameter generation with APVTS
+        // Phase 6: Parameter generation with APVTS. The write* forms stream
+        // into out (e.g. a CodeEmitter); generate* return the text
         std::string generateProcessorHeaderWithParams(const Netlist& netlist, const std::vector<CircuitStage>& stages);
         std::string generateProcessorImplWithParams(const Netlist& netlist, const std::vector<CircuitStage>& stages);
+        void writeProcessorHeaderWithParams(std::ostream& out, const Netlist& netlist,
+                                            const std::vector<CircuitStage>& stages);
+        void writeProcessorImplWithParams(std::ostream& out, const Netlist& netlist,
+                                          const std::vector<CircuitStage>& stages);
         
         // Beta: Pattern-specific code generation
         std::string generatePatternSpecificCode(const CircuitStage& stage, size_t stageIndex) const;
         std::string generateStableLegacyCode(const CircuitStage& stage, size_t stageIndex) const;
+        void writePatternSpecificCode(std::ostream& out, const CircuitStage& stage, size_t stageIndex) const;
+        void writeStableLegacyCode(std::ostream& out, const CircuitStage& stage, size_t stageIndex) const;
 
     private:
+        // Block mode processBlock body; gainParamId drives the gain stages when non-empty,
+        // wdfClippers lists the WDF clipper members run at each stage index and
+        // subcircuitTables the stages run as a pre-solved table
+        void writeBlockProcessingCode(std::ostream& out, const std::vector<CircuitStage>& stages,
+                                      const std::string& gainParamId,
+                                      bool withNonlinearMembers,
+                                      const std::map<size_t, std::vector<std::string>>& wdfClippers = {},
+                                      const std::set<size_t>& subcircuitTables = {}) const;
+
+        // Threads for stageCount per-stage fragments (1 below PARALLEL_MIN_STAGES)
+        unsigned fragmentThreads(size_t stageCount) const;
+
+        bool emitsBlockCode() const { return m_blockProcessing || m_simdChannels; }
+        bool usesControlRate() const { return m_controlRate > 1; }
+        bool usesSubcircuitTables() const { return m_subcircuitTableBudget > 0.0; }
+        bool usesSubBlocks() const { return m_subBlockSize > 1; }
+        // Shared-state curves are baked once per process and stay synchronous
+        bool bakesShapersInBackground() const { return m_lazyStages && m_waveshaperTables && !m_sharedState; }
+
+        // Member access for a nonlinear stage (a std::optional when lazy)
+        std::string stageMember(const std::string& memberName) const {
+            return memberName + (m_lazyStages ? "->" : ".");
+        }
+
+        // Gain stage whose knob is applied through a per-channel ControlRamp
+        bool rampsControlGain(const CircuitStage& stage, const std::string& gainParamId) const;
+        bool usesSimdFilters(const std::vector<CircuitStage>& stages) const;
+
+        // Seconds for the slowest filter pole to decay by 100 dB (floor 0.1 s)
+        double estimateTailSeconds(const std::vector<CircuitStage>& stages) const;
+        std::string generateSimdMembers() const;
+
+        bool foldsFixedRC(const CircuitStage& stage) const;
+        void writeToneStackMembers(std::ostream& out, size_t stageIndex, const std::string& filterType) const;
+        void writeToneStackSampleCode(std::ostream& out, size_t stageIndex) const;
+        void writeFoldedRCMembers(std::ostream& out, const CircuitStage& stage, size_t stageIndex) const;
+        void writeFoldedRCPrepare(std::ostream& out, const CircuitStage& stage, size_t stageIndex) const;
+        void writeSharedStateMembers(std::ostream& out, const std::vector<CircuitStage>& stages, bool useDK,
+                                     const std::set<size_t>& subcircuitTables = {}) const;
+        // processBlock prologue handing a curve baked in the background to the shapers
+        void writeShaperPickup(std::ostream& out, const std::vector<CircuitStage>& stages,
+                               const std::set<size_t>& subcircuitTables = {}) const;
+
         ParameterGenerator paramGenerator;
         bool m_useBetaFeatures;
+        int m_oversamplingFactor;
+        bool m_adaptiveOversampling;
+        bool m_blockProcessing;
+        bool m_simdChannels;
+        bool m_parameterSmoothing;
+        bool m_foldFixedNetworks;
+        bool m_staticTables;
+        bool m_nodalDK;
+        bool m_wdfClippers;
+        bool m_benchmarkHarness;
+        bool m_silenceSleep;
+        bool m_staticChain;
+        bool m_traceZones;
+        bool m_svfToneStack;
+        bool m_waveshaperTables;
+        int m_controlRate;
+        bool m_sharedState;
+        double m_subcircuitTableBudget;
+        bool m_lazyStages;
+        int m_subBlockSize;
+        ClipperSolver m_clipperSolver;
+        unsigned m_jobs;
     };
 
 } // namespace LiveSpice
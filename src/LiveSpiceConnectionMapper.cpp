@@ -3,6 +3,31 @@
 #include <sstream>
 #include <algorithm>
 
+void SpatialGrid::insert(double x, double y, uint32_t id) {
+    cells[cellKey(cellOf(x), cellOf(y))].push_back({x, y, id});
+}
+
+std::vector<uint32_t> SpatialGrid::query(double x, double y, double radius) const {
+    std::vector<uint32_t> ids;
+    const int64_t minX = cellOf(x - radius), maxX = cellOf(x + radius);
+    const int64_t minY = cellOf(y - radius), maxY = cellOf(y + radius);
+    for (int64_t cx = minX; cx <= maxX; ++cx) {
+        for (int64_t cy = minY; cy <= maxY; ++cy) {
+            auto it = cells.find(cellKey(cx, cy));
+            if (it == cells.end()) continue;
+            for (const auto& entry : it->second) {
+                double dx = entry.x - x;
+                double dy = entry.y - y;
+                if (std::sqrt(dx * dx + dy * dy) <= radius) {
+                    ids.push_back(entry.id);
+                }
+            }
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
 LiveSpiceConnectionMapper::LiveSpiceConnectionMapper(const Schematic& schem)
     : schematic(&schem) {
     // Extract wires and components from schematic's netlist
@@ -12,8 +37,14 @@ LiveSpiceConnectionMapper::LiveSpiceConnectionMapper(const Schematic& schem)
     // Extract components
     const auto& comps = netlist.getComponents();
     for (const auto& comp : comps) {
+        componentGrid.insert(comp.second->getPosX(), comp.second->getPosY(),
+                             static_cast<uint32_t>(components.size()));
         components.push_back(comp.second.get());
     }
+    for (size_t i = 0; i < wires.size(); ++i) {
+        wireEndpointGrid.insert(wires[i].nodeA_X, wires[i].nodeA_Y, static_cast<uint32_t>(2 * i));
+        wireEndpointGrid.insert(wires[i].nodeB_X, wires[i].nodeB_Y, static_cast<uint32_t>(2 * i + 1));
+    }
     
     // Analyze junctions
     extractAllJunctions();
@@ -35,23 +66,19 @@ void LiveSpiceConnectionMapper::extractAllJunctions() {
     for (const auto& point : uniquePoints) {
         Junction j(point.first, point.second);
         
-        for (size_t i = 0; i < wires.size(); ++i) {
-            if (pointNear(point.first, point.second, wires[i].nodeA_X, wires[i].nodeA_Y) ||
-                pointNear(point.first, point.second, wires[i].nodeB_X, wires[i].nodeB_Y)) {
-                j.connectedWires.push_back(std::to_string(i));
-            }
+        for (int wire : findWiresAtPoint(point.first, point.second)) {
+            j.connectedWires.push_back(std::to_string(wire));
         }
         
+        junctionGrid.insert(j.x, j.y, static_cast<uint32_t>(junctions.size()));
         junctions.push_back(j);
     }
 }
 
 void LiveSpiceConnectionMapper::linkComponentsToJunctions() {
     for (const auto& comp : components) {
-        for (auto& junction : junctions) {
-            if (pointNear(comp->getPosX(), comp->getPosY(), junction.x, junction.y, 0.1)) {
-                junction.connectedComponents.push_back(comp->getName());
-            }
+        for (uint32_t j : junctionGrid.query(comp->getPosX(), comp->getPosY(), 0.1)) {
+            junctions[j].connectedComponents.push_back(comp->getName());
         }
     }
 }
@@ -59,10 +86,11 @@ void LiveSpiceConnectionMapper::linkComponentsToJunctions() {
 std::vector<int> LiveSpiceConnectionMapper::findWiresAtPoint(double x, double y, double tolerance) {
     std::vector<int> wiresAtPoint;
     
-    for (size_t i = 0; i < wires.size(); ++i) {
-        if (pointNear(x, y, wires[i].nodeA_X, wires[i].nodeA_Y, tolerance) ||
-            pointNear(x, y, wires[i].nodeB_X, wires[i].nodeB_Y, tolerance)) {
-            wiresAtPoint.push_back(static_cast<int>(i));
+    // Endpoint ids ascend, so both ends of a wire are adjacent
+    for (uint32_t endpoint : wireEndpointGrid.query(x, y, tolerance)) {
+        int wire = static_cast<int>(endpoint / 2);
+        if (wiresAtPoint.empty() || wiresAtPoint.back() != wire) {
+            wiresAtPoint.push_back(wire);
         }
     }
     
@@ -79,17 +107,14 @@ bool LiveSpiceConnectionMapper::pointNear(double x1, double y1, double x2, doubl
 std::vector<std::pair<std::string, double>> LiveSpiceConnectionMapper::findNearbyComponents(double x, double y, double searchRadius) {
     std::vector<std::pair<std::string, double>> nearby;
     
-    for (const auto& comp : components) {
+    for (uint32_t i : componentGrid.query(x, y, searchRadius)) {
+        const Component* comp = components[i];
         double dx = comp->getPosX() - x;
         double dy = comp->getPosY() - y;
-        double distance = std::sqrt(dx * dx + dy * dy);
-        
-        if (distance <= searchRadius) {
-            nearby.push_back({comp->getName(), distance});
-        }
+        nearby.push_back({comp->getName(), std::sqrt(dx * dx + dy * dy)});
     }
     
-    std::sort(nearby.begin(), nearby.end(),
+    std::stable_sort(nearby.begin(), nearby.end(),
         [](const auto& a, const auto& b) { return a.second < b.second; });
     
     return nearby;
@@ -111,11 +136,9 @@ ConnectionPath LiveSpiceConnectionMapper::traceSignalPath(const std::string& fro
         return path;
     }
     
-    for (const auto& junc : junctions) {
-        if (pointNear(junc.x, junc.y, (*fromIt)->getPosX(), (*fromIt)->getPosY(), 1.0)) {
-            path.junctions.push_back(junc);
-            break;
-        }
+    auto nearFrom = junctionGrid.query((*fromIt)->getPosX(), (*fromIt)->getPosY(), 1.0);
+    if (!nearFrom.empty()) {
+        path.junctions.push_back(junctions[nearFrom.front()]);
     }
     
     return path;
@@ -172,12 +195,12 @@ bool LiveSpiceConnectionMapper::isSignalWire(int wireIndex) {
 }
 
 Junction* LiveSpiceConnectionMapper::findOrCreateJunction(double x, double y) {
-    for (auto& junction : junctions) {
-        if (pointNear(x, y, junction.x, junction.y)) {
-            return &junction;
-        }
+    auto existing = junctionGrid.query(x, y, 0.1);
+    if (!existing.empty()) {
+        return &junctions[existing.front()];
     }
     
+    junctionGrid.insert(x, y, static_cast<uint32_t>(junctions.size()));
     junctions.emplace_back(x, y);
     return &junctions.back();
 }
@@ -191,12 +214,15 @@ std::vector<Junction> LiveSpiceConnectionMapper::traceWireSegments(int startWire
     
     const auto& startWire = wires[startWireIndex];
     
-    for (const auto& junction : junctions) {
-        if ((pointNear(junction.x, junction.y, startWire.nodeA_X, startWire.nodeA_Y) ||
-             pointNear(junction.x, junction.y, startWire.nodeB_X, startWire.nodeB_Y)) ||
-            (pointNear(junction.x, junction.y, targetX, targetY))) {
-            path.push_back(junction);
-        }
+    std::vector<uint32_t> hits = junctionGrid.query(startWire.nodeA_X, startWire.nodeA_Y, 0.1);
+    for (auto query : {junctionGrid.query(startWire.nodeB_X, startWire.nodeB_Y, 0.1),
+                       junctionGrid.query(targetX, targetY, 0.1)}) {
+        hits.insert(hits.end(), query.begin(), query.end());
+    }
+    std::sort(hits.begin(), hits.end());
+    hits.erase(std::unique(hits.begin(), hits.end()), hits.end());
+    for (uint32_t j : hits) {
+        path.push_back(junctions[j]);
     }
     
     return path;
@@ -6,6 +6,9 @@
 #include <set>
 #include <string>
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
 #include "LiveSpiceParser.h"
 #include "CircuitAnalyzer.h"
 
@@ -32,6 +35,31 @@ struct ConnectionPath {
     bool isSignalPath;  // true if carrying signal, false if power/ground
 };
 
+// Uniform hash grid over 2-D points for radius queries; ids are caller-defined
+class SpatialGrid {
+public:
+    explicit SpatialGrid(double cellSize = 32.0) : cellSize(cellSize) {}
+    
+    void insert(double x, double y, uint32_t id);
+    
+    // Ids of points within radius of (x, y), ascending
+    std::vector<uint32_t> query(double x, double y, double radius) const;
+    
+private:
+    struct Entry {
+        double x, y;
+        uint32_t id;
+    };
+    
+    double cellSize;
+    std::unordered_map<uint64_t, std::vector<Entry>> cells;
+    
+    int64_t cellOf(double v) const { return static_cast<int64_t>(std::floor(v / cellSize)); }
+    static uint64_t cellKey(int64_t cx, int64_t cy) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+    }
+};
+
 class LiveSpiceConnectionMapper {
 public:
     LiveSpiceConnectionMapper(const Schematic& schematic);
@@ -62,6 +90,12 @@ private:
     std::vector<Wire> wires;
     std::map<std::string, std::vector<std::string>> componentConnections;
     
+    // Built once per schematic: wire endpoints (id = 2 * wire + end),
+    // component positions (id = index in components) and junctions
+    SpatialGrid wireEndpointGrid;
+    SpatialGrid componentGrid;
+    SpatialGrid junctionGrid;
+    
     // Find or create junction at coordinates
     Junction* findOrCreateJunction(double x, double y);
     
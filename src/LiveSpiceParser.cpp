@@ -1,117 +1,363 @@
 #include "LiveSpiceParser.h"
+#include "MappedFile.h"
 #include <fstream>
 #include <sstream>
 #include <cctype>
 #include <cmath>
 #include <algorithm>
+#include <array>
+#include <charconv>
+#include <atomic>
+#include <initializer_list>
+#include <thread>
 
 namespace LiveSpice {
 
+namespace {
+
     // ============================================================================
-    // Unit Parsing - Convert values with units to doubles
+    // XML Tag Tokenizer
     // ============================================================================
-    double Component::parseUnit(const std::string& valueStr) const {
-        if (valueStr.empty()) return 0.0;
-
-        // Trim whitespace
-        std::string trimmed = valueStr;
-        trimmed.erase(0, trimmed.find_first_not_of(" \t\n\r"));
-        trimmed.erase(trimmed.find_last_not_of(" \t\n\r") + 1);
-
-        // Find where the number ends and unit begins
-        size_t unitStart = 0;
-        for (size_t i = 0; i < trimmed.length(); i++) {
-            if (isalpha(trimmed[i])) {
-                unitStart = i;
-                break;
+
+    struct XmlTag {
+        std::string_view name;
+        std::string_view attributes;  // Text between the name and '>' or '/>'
+        bool closing = false;         // </Name>
+        bool selfClosing = false;     // <Name ... />
+        int line = 1;                 // Line the tag starts on
+    };
+
+    /**
+     * Walks element tags in document order. Text, comments, declarations
+     * and processing instructions are skipped; '>' inside quoted attribute
+     * values does not end a tag.
+     */
+    class XmlTokenizer {
+    public:
+        explicit XmlTokenizer(std::string_view text, int firstLine = 1) : m_text(text), m_line(firstLine) {}
+
+        bool next(XmlTag& tag) {
+            while (true) {
+                size_t open = m_text.find('<', m_pos);
+                if (open == std::string_view::npos) return false;
+                advanceLines(open);
+
+                if (m_text.compare(open, 4, "<!--") == 0) {
+                    m_pos = skipPast(open + 4, "-->");
+                    continue;
+                }
+                if (open + 1 < m_text.size() && (m_text[open + 1] == '?' || m_text[open + 1] == '!')) {
+                    m_pos = skipPast(open + 2, ">");
+                    continue;
+                }
+
+                size_t end = open + 1;
+                char quote = 0;
+                for (; end < m_text.size(); ++end) {
+                    char c = m_text[end];
+                    if (quote) {
+                        if (c == quote) quote = 0;
+                    } else if (c == '"' || c == '\'') {
+                        quote = c;
+                    } else if (c == '>') {
+                        break;
+                    }
+                }
+                if (end >= m_text.size()) return false;
+
+                size_t bodyStart = open + 1;
+                tag.closing = m_text[bodyStart] == '/';
+                if (tag.closing) ++bodyStart;
+                size_t bodyEnd = end;
+                tag.selfClosing = bodyEnd > bodyStart && m_text[bodyEnd - 1] == '/';
+                if (tag.selfClosing) --bodyEnd;
+
+                size_t nameEnd = bodyStart;
+                while (nameEnd < bodyEnd && !std::isspace(static_cast<unsigned char>(m_text[nameEnd]))) ++nameEnd;
+                tag.name = m_text.substr(bodyStart, nameEnd - bodyStart);
+                tag.attributes = m_text.substr(nameEnd, bodyEnd - nameEnd);
+                tag.line = m_line;
+
+                m_pos = end + 1;
+                return true;
             }
         }
 
-        std::string numStr = trimmed.substr(0, unitStart);
-        std::string unitStr = trimmed.substr(unitStart);
+    private:
+        size_t skipPast(size_t from, std::string_view terminator) const {
+            size_t end = m_text.find(terminator, from);
+            return end == std::string_view::npos ? m_text.size() : end + terminator.size();
+        }
 
-        // Parse number
-        double value = 0.0;
-        try {
-            value = std::stod(numStr);
-        } catch (...) {
-            return 0.0;
+        void advanceLines(size_t upTo) {
+            if (upTo <= m_counted) return;
+            m_line += static_cast<int>(std::count(m_text.begin() + m_counted, m_text.begin() + upTo, '\n'));
+            m_counted = upTo;
+        }
+
+        std::string_view m_text;
+        size_t m_pos = 0;
+        size_t m_counted = 0;
+        int m_line;
+    };
+
+    /**
+     * Offset of every <Element tag, in document order. Only '<' is
+     * examined: it cannot appear unescaped in an attribute value, so no
+     * quote tracking is needed. Comments, declarations and processing
+     * instructions are skipped the way XmlTokenizer skips them.
+     */
+    std::vector<size_t> findElementStarts(std::string_view text) {
+        constexpr std::string_view element = "<Element";
+        std::vector<size_t> starts;
+        size_t pos = 0;
+        while ((pos = text.find('<', pos)) != std::string_view::npos) {
+            if (text.compare(pos, 4, "<!--") == 0) {
+                pos = text.find("-->", pos + 4);
+                if (pos == std::string_view::npos) break;
+                continue;
+            }
+            if (pos + 1 < text.size() && (text[pos + 1] == '?' || text[pos + 1] == '!')) {
+                pos = text.find('>', pos + 2);
+                if (pos == std::string_view::npos) break;
+                continue;
+            }
+            const size_t after = pos + element.size();
+            if (text.compare(pos, element.size(), element) == 0 && after < text.size()
+                && (std::isspace(static_cast<unsigned char>(text[after])) || text[after] == '>' || text[after] == '/')) {
+                starts.push_back(pos);
+            }
+            ++pos;
+        }
+        return starts;
+    }
+
+    // ============================================================================
+    // Parallel Helpers
+    // ============================================================================
+
+    // Threads only pay off once each gets this many elements (components,
+    // wires); small schematics stay on the calling thread
+    constexpr size_t ELEMENTS_PER_JOB = 2048;
+
+    // Parse chunks per thread, so one dense chunk does not hold up the rest
+    constexpr size_t CHUNKS_PER_JOB = 4;
+
+    /** Threads for count elements: at most jobs (0 = hardware threads) */
+    unsigned jobsFor(size_t count, unsigned jobs) {
+        if (jobs == 0) jobs = std::max(1u, std::thread::hardware_concurrency());
+        return static_cast<unsigned>(std::clamp<size_t>(count / ELEMENTS_PER_JOB, 1, jobs));
+    }
+
+    /** Run task(i) for i in [0, count) on up to jobs threads */
+    template <typename Task>
+    void parallelFor(size_t count, unsigned jobs, Task task) {
+        jobs = std::max(1u, std::min<unsigned>(jobs, static_cast<unsigned>(std::max<size_t>(count, 1))));
+        std::atomic<size_t> next{0};
+        auto worker = [&]() {
+            for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) task(i);
+        };
+        std::vector<std::thread> pool;
+        for (unsigned j = 1; j < jobs; ++j) pool.emplace_back(worker);
+        worker();
+        for (auto& thread : pool) thread.join();
+    }
+
+    /** Items [first, second) of shard s when count items are cut into shards */
+    std::pair<size_t, size_t> shardRange(size_t count, size_t shards, size_t s) {
+        return {count * s / shards, count * (s + 1) / shards};
+    }
+
+    /**
+     * Calls visit(name, value) for each name="value" pair in order;
+     * visit returns true to stop early
+     */
+    template <typename Visitor>
+    void forEachAttribute(std::string_view attributes, Visitor&& visit) {
+        constexpr std::string_view whitespace = " \t\r\n";
+        size_t pos = 0;
+        while (true) {
+            pos = attributes.find_first_not_of(whitespace, pos);
+            if (pos == std::string_view::npos) return;
+            size_t eq = attributes.find('=', pos);
+            if (eq == std::string_view::npos) return;
+
+            std::string_view name = attributes.substr(pos, eq - pos);
+            name = name.substr(0, name.find_last_not_of(whitespace) + 1);
+
+            size_t quote = attributes.find_first_not_of(whitespace, eq + 1);
+            if (quote == std::string_view::npos || (attributes[quote] != '"' && attributes[quote] != '\'')) return;
+            size_t close = attributes.find(attributes[quote], quote + 1);
+            if (close == std::string_view::npos) return;
+
+            if (visit(name, attributes.substr(quote + 1, close - quote - 1))) return;
+            pos = close + 1;
+        }
+    }
+
+    bool parseInt(std::string_view text, int& value) {
+        size_t start = text.find_first_not_of(" \t");
+        if (start == std::string_view::npos) return false;
+        text.remove_prefix(start);
+        if (text.front() == '+') text.remove_prefix(1);
+        auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+        return result.ec == std::errc();
+    }
+
+    /** "x,y" coordinate pair */
+    bool parsePoint(std::string_view text, int& x, int& y) {
+        size_t comma = text.find(',');
+        if (comma == std::string_view::npos) return false;
+        return parseInt(text.substr(0, comma), x) && parseInt(text.substr(comma + 1), y);
+    }
+
+    // Component attributes kept as parameters, in parameter order
+    constexpr std::string_view PARAM_ATTRIBUTES[] = {
+        "Resistance", "Capacitance", "Inductance", "Voltage",
+        "Impedance", "Turns", "Wipe", "IS", "n", "PartNumber",
+        "Type", "Sweep", "Aol", "GBP"
+    };
+    constexpr size_t PARAM_ATTRIBUTE_COUNT = sizeof(PARAM_ATTRIBUTES) / sizeof(PARAM_ATTRIBUTES[0]);
+    constexpr size_t PARAM_TYPE_INDEX = 10;
+
+    struct SiPrefix {
+        std::string_view symbol;
+        double scale;
+    };
+
+    constexpr SiPrefix SI_PREFIXES[] = {
+        {"f", 1e-15}, {"p", 1e-12}, {"n", 1e-9},
+        {"u", 1e-6}, {"\xC2\xB5", 1e-6}, {"\xCE\xBC", 1e-6},  // u, MICRO SIGN, GREEK MU
+        {"m", 1e-3}, {"k", 1e3}, {"K", 1e3}, {"M", 1e6}, {"G", 1e9}, {"T", 1e12}
+    };
+
+} // namespace
+
+    // ============================================================================
+    // Canonical Parameters - Alias chains resolved once per component
+    // ============================================================================
+    int Component::aliasOf(const std::string& paramName) {
+        static const char* const names[AliasCount] = {
+            "Resistance", "Capacitance", "Inductance", "Value", "R", "C", "L",
+            "ESR", "DCR", "DCResistance", "PartNumber", "Model", "Type", "Aol", "GBP"
+        };
+        for (int alias = 0; alias < AliasCount; ++alias) {
+            if (paramName == names[alias]) return alias;
         }
+        return -1;
+    }
 
-        // Apply unit multiplier
-        if (unitStr.find("p") != std::string::npos || unitStr.find("pF") != std::string::npos) {
-            return value * 1e-12;
-        } else if (unitStr.find("n") != std::string::npos || unitStr.find("nF") != std::string::npos) {
-            return value * 1e-9;
-        } else if (unitStr.find("u") != std::string::npos || unitStr.find("μ") != std::string::npos || unitStr.find("uF") != std::string::npos || unitStr.find("μF") != std::string::npos) {
-            return value * 1e-6;
-        } else if (unitStr.find("m") != std::string::npos && unitStr.find("mF") != std::string::npos) {
-            return value * 1e-3;
-        } else if (unitStr.find("k") != std::string::npos || unitStr.find("kΩ") != std::string::npos) {
-            return value * 1e3;
-        } else if (unitStr.find("M") != std::string::npos || unitStr.find("MΩ") != std::string::npos) {
-            return value * 1e6;
-        } else if (unitStr.find("G") != std::string::npos) {
-            return value * 1e9;
-        } else if (unitStr.find("fA") != std::string::npos) {
-            return value * 1e-15;
-        } else if (unitStr.find("pA") != std::string::npos) {
-            return value * 1e-12;
-        } else if (unitStr.find("nA") != std::string::npos) {
-            return value * 1e-9;
-        } else if (unitStr.find("uA") != std::string::npos || unitStr.find("μA") != std::string::npos) {
-            return value * 1e-6;
-        } else if (unitStr.find("mA") != std::string::npos) {
-            return value * 1e-3;
-        } else if (unitStr.find("V") != std::string::npos) {
-            return value; // Volts are base unit
-        } else if (unitStr.find("Ω") != std::string::npos) {
-            return value; // Ohms are base unit
+    void Component::resolveCanonical() {
+        auto text = [this](int alias) -> const std::string* {
+            return aliasParam[alias] >= 0 ? &params[aliasParam[alias]].value : nullptr;
+        };
+        auto number = [this](int alias) {
+            return aliasParam[alias] >= 0 ? params[aliasParam[alias]].numericValue : 0.0;
+        };
+        // Given when any alias has text; the first nonzero number wins
+        auto chain = [&](std::initializer_list<int> aliases, bool& given, double& value) {
+            given = false;
+            value = 0.0;
+            for (int alias : aliases) {
+                const std::string* str = text(alias);
+                given = given || (str && !str->empty());
+            }
+            if (!given) return;
+            for (int alias : aliases) {
+                value = number(alias);
+                if (value != 0.0) return;
+            }
+        };
+
+        chain({AliasResistance, AliasValue, AliasR}, canonical.hasResistance, canonical.resistance);
+        chain({AliasCapacitance, AliasValue, AliasC}, canonical.hasCapacitance, canonical.capacitance);
+        chain({AliasInductance, AliasValue, AliasL}, canonical.hasInductance, canonical.inductance);
+        canonical.esr = number(AliasESR);
+        canonical.dcResistance = number(AliasDCR) != 0.0 ? number(AliasDCR) : number(AliasDCResistance);
+        canonical.openLoopGain = number(AliasAol);
+        canonical.gainBandwidth = number(AliasGBP);
+
+        canonical.partNumber.clear();
+        for (int alias : {AliasPartNumber, AliasModel, AliasType}) {
+            const std::string* str = text(alias);
+            if (str && !str->empty()) {
+                canonical.partNumber = *str;
+                break;
+            }
+        }
+    }
+
+    // ============================================================================
+    // Unit Parsing - Convert values with units to doubles
+    // ============================================================================
+    double Component::parseUnit(std::string_view valueStr) {
+        constexpr std::string_view whitespace = " \t\n\r";
+        size_t start = valueStr.find_first_not_of(whitespace);
+        if (start == std::string_view::npos) return 0.0;
+        valueStr.remove_prefix(start);
+        if (valueStr.front() == '+') valueStr.remove_prefix(1);
+
+        // Number, including any exponent
+        double value = 0.0;
+        const char* last = valueStr.data() + valueStr.size();
+        auto result = std::from_chars(valueStr.data(), last, value);
+        if (result.ec != std::errc()) return 0.0;
+
+        // Optional SI prefix in front of the unit symbol (F, H, V, A, Ω, ...)
+        std::string_view unit(result.ptr, static_cast<size_t>(last - result.ptr));
+        size_t unitStart = unit.find_first_not_of(whitespace);
+        if (unitStart == std::string_view::npos) return value;
+        unit.remove_prefix(unitStart);
+
+        for (const auto& prefix : SI_PREFIXES) {
+            if (unit.compare(0, prefix.symbol.size(), prefix.symbol) == 0) {
+                return value * prefix.scale;
+            }
         }
 
-        // No unit recognized, return raw value
+        // Base unit or no unit
         return value;
     }
 
     // ============================================================================
     // Component Type Recognition
     // ============================================================================
-    ComponentType SchematicParser::getComponentType(const std::string& typeStr) {
+    ComponentType SchematicParser::getComponentType(std::string_view typeStr) {
+        auto has = [typeStr](std::string_view key) { return typeStr.find(key) != std::string_view::npos; };
+
         // Check for component type in the _Type attribute
-        if (typeStr.find("Resistor") != std::string::npos) {
-            if (typeStr.find("Variable") != std::string::npos) {
+        if (has("Resistor")) {
+            if (has("Variable")) {
                 return ComponentType::VariableResistor;
             }
             return ComponentType::Resistor;
-        } else if (typeStr.find("Capacitor") != std::string::npos) {
+        } else if (has("Capacitor")) {
             return ComponentType::Capacitor;
-        } else if (typeStr.find("Inductor") != std::string::npos) {
+        } else if (has("Inductor")) {
             return ComponentType::Inductor;
-        } else if (typeStr.find("Potentiometer") != std::string::npos) {
+        } else if (has("Potentiometer")) {
             return ComponentType::Potentiometer;
-        } else if (typeStr.find("Diode") != std::string::npos) {
+        } else if (has("Diode")) {
             return ComponentType::Diode;
-        } else if (typeStr.find("BipolarJunctionTransistor") != std::string::npos || 
-                   typeStr.find("BJT") != std::string::npos ||
-                   typeStr.find("Transistor") != std::string::npos) {
+        } else if (has("BipolarJunctionTransistor") || has("BJT") || has("Transistor")) {
             return ComponentType::Transistor;
-        } else if (typeStr.find("Transformer") != std::string::npos) {
+        } else if (has("Transformer")) {
             return ComponentType::Transformer;
-        } else if (typeStr.find("OpAmp") != std::string::npos || typeStr.find("IdealOpAmp") != std::string::npos) {
+        } else if (has("OpAmp") || has("IdealOpAmp")) {
             return ComponentType::OpAmp;
-        } else if (typeStr.find("Speaker") != std::string::npos) {
+        } else if (has("Speaker")) {
             return ComponentType::Speaker;
-        } else if (typeStr.find("Input") != std::string::npos) {
+        } else if (has("Input")) {
             return ComponentType::Input;
-        } else if (typeStr.find("Output") != std::string::npos) {
+        } else if (has("Output")) {
             return ComponentType::Output;
-        } else if (typeStr.find("Ground") != std::string::npos) {
+        } else if (has("Ground")) {
             return ComponentType::Ground;
-        } else if (typeStr.find("Rail") != std::string::npos) {
+        } else if (has("Rail")) {
             return ComponentType::Rail;
-        } else if (typeStr.find("Wire") != std::string::npos) {
+        } else if (has("Wire")) {
             return ComponentType::Wire;
-        } else if (typeStr.find("Label") != std::string::npos) {
+        } else if (has("Label")) {
             return ComponentType::Label;
         }
         return ComponentType::Unknown;
@@ -120,270 +366,416 @@ namespace LiveSpice {
     // ============================================================================
     // XML Attribute Extraction
     // ============================================================================
-    std::string SchematicParser::extractAttributeValue(const std::string& line, const std::string& attrName) {
-        std::string searchStr = attrName + "=\"";
-        size_t start = line.find(searchStr);
-        if (start == std::string::npos) return "";
-
-        start += searchStr.length();
-        size_t end = line.find("\"", start);
-        if (end == std::string::npos) return "";
-
-        return line.substr(start, end - start);
+    std::string_view SchematicParser::extractAttributeValue(std::string_view attributes, std::string_view attrName) {
+        std::string_view result;
+        forEachAttribute(attributes, [&](std::string_view name, std::string_view value) {
+            if (name != attrName) return false;
+            result = value;
+            return true;
+        });
+        return result;
     }
 
     // ============================================================================
     // Main Parser Implementation
     // ============================================================================
-    Schematic SchematicParser::parseFile(const std::string& filePath) {
-        std::ifstream file(filePath);
-        if (!file.is_open()) {
+    Schematic SchematicParser::parseFile(const std::string& filePath, unsigned jobs) {
+        MappedFile file(filePath);
+        if (!file.isOpen()) {
             throw std::runtime_error("Cannot open file: " + filePath);
         }
-
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        return parseString(buffer.str());
+        return parseString(file.view(), jobs);
     }
 
-    Schematic SchematicParser::parseString(const std::string& xmlContent) {
-        Schematic schematic;
-        std::istringstream ss(xmlContent);
-        std::string line;
-        int lineNum = 0;
-
-        while (std::getline(ss, line)) {
-            lineNum++;
-
-            // Skip empty lines and XML declaration
-            if (line.empty() || line.find("<?xml") != std::string::npos) continue;
-
-            // Parse Schematic element
-            if (line.find("<Schematic") != std::string::npos) {
-                std::string name = extractAttributeValue(line, "Name");
-                std::string desc = extractAttributeValue(line, "Description");
-                // Schematic attributes set (could store name/desc if needed)
-                continue;
-            }
+    Schematic SchematicParser::parseString(std::string_view xmlContent, unsigned jobs) {
+        // Structural scan. Chunks are cut only at <Element> starts, where the
+        // decoder below resets its per-symbol state anyway, so decoding the
+        // chunks separately gives the same elements as one pass
+        const std::vector<size_t> elementStarts = findElementStarts(xmlContent);
+        const unsigned threads = jobsFor(elementStarts.size(), jobs);
+        const size_t chunkCount = threads > 1 ? threads * CHUNKS_PER_JOB : 1;
+
+        std::vector<size_t> cuts{0};
+        for (size_t k = 1; k < chunkCount; ++k) {
+            cuts.push_back(elementStarts[elementStarts.size() * k / chunkCount]);
+        }
+        cuts.push_back(xmlContent.size());
+        auto chunkText = [&](size_t k) { return xmlContent.substr(cuts[k], cuts[k + 1] - cuts[k]); };
+
+        // Line each chunk starts on (names unnamed components)
+        std::vector<int> firstLine(chunkCount, 1);
+        if (chunkCount > 1) {
+            std::vector<int> newlines(chunkCount);
+            parallelFor(chunkCount, threads, [&](size_t k) {
+                const std::string_view text = chunkText(k);
+                newlines[k] = static_cast<int>(std::count(text.begin(), text.end(), '\n'));
+            });
+            for (size_t k = 1; k < chunkCount; ++k) firstLine[k] = firstLine[k - 1] + newlines[k - 1];
+        }
 
-            // Parse Element (component or wire)
-            if (line.find("<Element") != std::string::npos) {
-                // Get Element Type
-                std::string elementType = extractAttributeValue(line, "Type");
-                ComponentType compType = getComponentType(elementType);
-
-                // Get Position
-                int x = 0, y = 0;
-                std::string posStr = extractAttributeValue(line, "Position");
-                if (!posStr.empty()) {
-                    size_t comma = posStr.find(",");
-                    if (comma != std::string::npos) {
-                        try {
-                            x = std::stoi(posStr.substr(0, comma));
-                            y = std::stoi(posStr.substr(comma + 1));
-                        } catch (...) {}
+        struct DecodedChunk {
+            std::vector<Wire> wires;
+            std::vector<std::shared_ptr<Component>> components;
+        };
+        std::vector<DecodedChunk> decoded(chunkCount);
+
+        parallelFor(chunkCount, threads, [&](size_t k) {
+            DecodedChunk& chunk = decoded[k];
+            XmlTokenizer tokenizer(chunkText(k), firstLine[k]);
+            XmlTag tag;
+
+            // Placement of the open symbol <Element>, waiting for its <Component>
+            bool inSymbol = false;
+            ComponentType elementType = ComponentType::Unknown;
+            int x = 0, y = 0;
+            int rotation = 0;
+            bool flip = false;
+
+            while (tokenizer.next(tag)) {
+                if (tag.name == "Element") {
+                    inSymbol = false;
+                    if (tag.closing) continue;
+
+                    std::string_view typeStr = extractAttributeValue(tag.attributes, "Type");
+
+                    // Wires carry their endpoints directly
+                    if (typeStr.find("Wire") != std::string_view::npos) {
+                        Wire wire;
+                        if (parsePoint(extractAttributeValue(tag.attributes, "A"), wire.nodeA_X, wire.nodeA_Y) &&
+                            parsePoint(extractAttributeValue(tag.attributes, "B"), wire.nodeB_X, wire.nodeB_Y)) {
+                            chunk.wires.push_back(wire);
+                        }
+                        continue;
                     }
+
+                    // Symbols: remember the placement for the Component sub-element
+                    elementType = getComponentType(typeStr);
+                    x = 0;
+                    y = 0;
+                    parsePoint(extractAttributeValue(tag.attributes, "Position"), x, y);
+                    rotation = 0;
+                    parseInt(extractAttributeValue(tag.attributes, "Rotation"), rotation);
+                    flip = extractAttributeValue(tag.attributes, "Flip") == "true";
+                    inSymbol = !tag.selfClosing;
+                    continue;
                 }
 
-                // Get Rotation and Flip
-                int rotation = 0;
-                bool flip = false;
-                std::string rotStr = extractAttributeValue(line, "Rotation");
-                std::string flipStr = extractAttributeValue(line, "Flip");
-                try {
-                    rotation = std::stoi(rotStr);
-                } catch (...) {}
-                flip = (flipStr == "true");
-
-                // Handle Wire elements specifically
-                if (elementType.find("Wire") != std::string::npos) {
-                    Wire wire;
-                    std::string aStr = extractAttributeValue(line, "A");
-                    std::string bStr = extractAttributeValue(line, "B");
-
-                    if (!aStr.empty() && !bStr.empty()) {
-                        size_t comma_a = aStr.find(",");
-                        size_t comma_b = bStr.find(",");
-                        if (comma_a != std::string::npos && comma_b != std::string::npos) {
-                            try {
-                                wire.nodeA_X = std::stoi(aStr.substr(0, comma_a));
-                                wire.nodeA_Y = std::stoi(aStr.substr(comma_a + 1));
-                                wire.nodeB_X = std::stoi(bStr.substr(0, comma_b));
-                                wire.nodeB_Y = std::stoi(bStr.substr(comma_b + 1));
-                                schematic.getNetlist().addWire(wire);
-                            } catch (...) {}
-                        }
-                    }
-                } else {
-                    // For all non-wire elements (symbols), look for the Component sub-element
-                    std::string componentLine;
-                    while (std::getline(ss, componentLine)) {
-                        lineNum++;
-                        if (componentLine.find("</Element>") != std::string::npos) break;
-
-                        if (componentLine.find("<Component") != std::string::npos) {
-                            // Extract component name from Name attribute
-                            std::string componentName = extractAttributeValue(componentLine, "Name");
-                            if (componentName.empty()) componentName = "Unnamed_" + std::to_string(lineNum);
-
-                            // Get the actual component type from the _Type attribute on the Component element
-                            std::string componentTypeStr = extractAttributeValue(componentLine, "_Type");
-                            if (!componentTypeStr.empty()) {
-                                compType = getComponentType(componentTypeStr);
-                            }
-                            if (componentTypeStr.empty() || compType == ComponentType::Unknown) {
-                                // Fallback: Use Type attribute (often contains BipolarJunctionTransistor, etc.)
-                                std::string componentTypeFallback = extractAttributeValue(componentLine, "Type");
-                                if (!componentTypeFallback.empty()) {
-                                    compType = getComponentType(componentTypeFallback);
-                                }
-                            }
-
-                            // Create component
-                            auto comp = std::make_shared<Component>(componentName, compType, componentName);
-                            comp->setPosition(x, y);
-                            comp->setRotation(rotation);
-                            comp->setFlip(flip);
-
-                            // Extract all component parameters (attributes on Component element)
-                            std::string attrStr = componentLine.substr(componentLine.find("<Component"));
-
-                            // Look for attributes with values
-                            std::vector<std::string> attrNames = {
-                                "Resistance", "Capacitance", "Inductance", "Voltage",
-                                "Impedance", "Turns", "Wipe", "IS", "n", "PartNumber",
-                                "Type", "Sweep"
-                            };
-
-                            for (const auto& attrName : attrNames) {
-                                std::string value = extractAttributeValue(componentLine, attrName);
-                                if (!value.empty()) {
-                                    comp->addParam(attrName, value);
-                                }
-                            }
-
-                            schematic.getNetlist().addComponent(comp);
+                if (tag.name != "Component" || tag.closing || !inSymbol) continue;
+                inSymbol = false;
+
+                // One pass over the attributes; everything stays a view until commit
+                std::string_view nameAttr;
+                std::string_view typeAttr;
+                std::array<std::string_view, PARAM_ATTRIBUTE_COUNT> paramValues{};
+                forEachAttribute(tag.attributes, [&](std::string_view name, std::string_view value) {
+                    if (name == "Name") nameAttr = value;
+                    else if (name == "_Type") typeAttr = value;
+                    for (size_t i = 0; i < PARAM_ATTRIBUTE_COUNT; ++i) {
+                        if (name == PARAM_ATTRIBUTES[i]) {
+                            paramValues[i] = value;
                             break;
                         }
                     }
+                    return false;
+                });
+
+                // The _Type attribute names the part; fall back to Type
+                // (often contains BipolarJunctionTransistor, etc.)
+                ComponentType compType = elementType;
+                if (!typeAttr.empty()) {
+                    compType = getComponentType(typeAttr);
+                }
+                std::string_view typeParam = paramValues[PARAM_TYPE_INDEX];
+                if (!typeParam.empty() && (typeAttr.empty() || compType == ComponentType::Unknown)) {
+                    compType = getComponentType(typeParam);
                 }
+
+                std::string componentName = nameAttr.empty()
+                    ? "Unnamed_" + std::to_string(tag.line)
+                    : std::string(nameAttr);
+
+                auto comp = std::make_shared<Component>(componentName, compType, componentName);
+                comp->setPosition(x, y);
+                comp->setRotation(rotation);
+                comp->setFlip(flip);
+
+                for (size_t i = 0; i < PARAM_ATTRIBUTE_COUNT; ++i) {
+                    if (!paramValues[i].empty()) {
+                        comp->addParam(std::string(PARAM_ATTRIBUTES[i]), std::string(paramValues[i]));
+                    }
+                }
+
+                chunk.components.push_back(std::move(comp));
             }
-        }
+        });
 
+        // Commit in document order (a repeated name keeps the last component)
+        Schematic schematic;
+        Netlist& netlist = schematic.getNetlist();
+        for (auto& chunk : decoded) {
+            for (const auto& wire : chunk.wires) netlist.addWire(wire);
+            for (auto& comp : chunk.components) netlist.addComponent(std::move(comp));
+        }
         return schematic;
     }
 
+    // ============================================================================
+    // Component Type Names
+    // ============================================================================
+    const char* componentTypeName(ComponentType type) {
+        switch (type) {
+            case ComponentType::Resistor: return "Resistor";
+            case ComponentType::Capacitor: return "Capacitor";
+            case ComponentType::Inductor: return "Inductor";
+            case ComponentType::VariableResistor: return "VariableResistor";
+            case ComponentType::Potentiometer: return "Potentiometer";
+            case ComponentType::Diode: return "Diode";
+            case ComponentType::OpAmp: return "OpAmp";
+            case ComponentType::Transformer: return "Transformer";
+            case ComponentType::Transistor: return "Transistor";
+            case ComponentType::Speaker: return "Speaker";
+            case ComponentType::Input: return "Input";
+            case ComponentType::Output: return "Output";
+            case ComponentType::Ground: return "Ground";
+            case ComponentType::Rail: return "Rail";
+            case ComponentType::Wire: return "Wire";
+            case ComponentType::Label: return "Label";
+            case ComponentType::Unknown: return "Unknown";
+        }
+        return "Unknown";
+    }
+
+    // ============================================================================
+    // Compact Netlist
+    // ============================================================================
+    CompactNetlist::Id CompactNetlist::findComponent(const std::string& name) const {
+        auto it = std::lower_bound(components.begin(), components.end(), name,
+            [](const std::shared_ptr<Component>& comp, const std::string& key) { return comp->getName() < key; });
+        if (it == components.end() || (*it)->getName() != name) return NONE;
+        return static_cast<Id>(it - components.begin());
+    }
+
+    CompactNetlist::Id CompactNetlist::findNode(int x, int y) const {
+        std::pair<int, int> key{x, y};
+        auto it = std::lower_bound(nodePositions.begin(), nodePositions.end(), key);
+        if (it == nodePositions.end() || *it != key) return NONE;
+        return static_cast<Id>(it - nodePositions.begin());
+    }
+
+    void CompactNetlist::clear() {
+        components.clear();
+        componentNode.clear();
+        nodePositions.clear();
+        nodeComponentOffsets.clear();
+        nodeComponentIds.clear();
+        componentNodeOffsets.clear();
+        componentNodeIds.clear();
+        neighborOffsets.clear();
+        neighborIds.clear();
+    }
+
+namespace {
+
+    using Id = CompactNetlist::Id;
+
+    /**
+     * CSR rows from (row, value) pairs by counting sort; values keep their
+     * pair order within a row
+     */
+    void buildRows(size_t rowCount, const std::vector<std::pair<Id, Id>>& pairs,
+                   std::vector<Id>& offsets, std::vector<Id>& ids) {
+        offsets.assign(rowCount + 1, 0);
+        for (const auto& p : pairs) offsets[p.first + 1]++;
+        for (size_t r = 0; r < rowCount; ++r) offsets[r + 1] += offsets[r];
+        ids.resize(pairs.size());
+        std::vector<Id> fill(offsets.begin(), offsets.end() - 1);
+        for (const auto& p : pairs) ids[fill[p.first]++] = p.second;
+    }
+
+} // namespace
+
     // ============================================================================
     // Netlist Connectivity Pool Building
     // ============================================================================
-    void Netlist::buildConnectivityPool() {
-        // Clear existing pools
-        connectivityPool.clear();
-        componentConnections.clear();
+    void Netlist::buildConnectivityPool(unsigned jobs) {
+        compact.clear();
 
-        // First pass: Build connectivity pool from components and wires
-        // Group components by their position (connection nodes)
-        std::map<std::pair<int, int>, std::vector<std::string>> positionToComponents;
-        
+        // Component IDs in name order
+        compact.components.reserve(components.size());
         for (const auto& pair : components) {
-            int x, y;
-            pair.second->getPosition(x, y);
-            positionToComponents[{x, y}].push_back(pair.first);
+            compact.components.push_back(pair.second);
+        }
+        const size_t componentCount = compact.components.size();
+
+        const unsigned threads = jobsFor(componentCount + wires.size(), jobs);
+        const size_t shards = threads;
+
+        // Node IDs: every component position and wire endpoint, in position
+        // order. Shards sort and deduplicate their slice, then sorted runs
+        // are merged pairwise
+        auto& positions = compact.nodePositions;
+        positions.reserve(componentCount + 2 * wires.size());
+        for (const auto& comp : compact.components) {
+            positions.emplace_back(comp->getPosX(), comp->getPosY());
         }
-
-        // Add wires to create additional connection points
         for (const auto& wire : wires) {
-            ConnectionNode nodeA = {wire.nodeA_X, wire.nodeA_Y};
-            ConnectionNode nodeB = {wire.nodeB_X, wire.nodeB_Y};
-            
-            // Add the wire endpoints to the connectivity pool
-            if (connectivityPool.find(nodeA) == connectivityPool.end()) {
-                connectivityPool[nodeA] = std::vector<std::string>();
-            }
-            if (connectivityPool.find(nodeB) == connectivityPool.end()) {
-                connectivityPool[nodeB] = std::vector<std::string>();
-            }
+            positions.emplace_back(wire.nodeA_X, wire.nodeA_Y);
+            positions.emplace_back(wire.nodeB_X, wire.nodeB_Y);
+        }
+        std::vector<size_t> runs(shards + 1);
+        for (size_t s = 0; s <= shards; ++s) runs[s] = shardRange(positions.size(), shards, s).first;
+        parallelFor(shards, threads, [&](size_t s) {
+            std::sort(positions.begin() + runs[s], positions.begin() + runs[s + 1]);
+        });
+        for (size_t width = 1; width < shards; width *= 2) {
+            const size_t pairCount = (shards + 2 * width - 1) / (2 * width);
+            parallelFor(pairCount, threads, [&](size_t p) {
+                const size_t first = 2 * width * p;
+                if (first + width >= shards) return;
+                std::inplace_merge(positions.begin() + runs[first], positions.begin() + runs[first + width],
+                                   positions.begin() + runs[std::min(first + 2 * width, shards)]);
+            });
         }
+        positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+        const size_t nodeCount = positions.size();
+
+        compact.componentNode.resize(componentCount);
+        parallelFor(shards, threads, [&](size_t s) {
+            const auto range = shardRange(componentCount, shards, s);
+            for (size_t c = range.first; c < range.second; ++c) {
+                const auto& comp = compact.components[c];
+                compact.componentNode[c] = compact.findNode(comp->getPosX(), comp->getPosY());
+            }
+        });
 
-        // Second pass: Build component connection information
-        for (const auto& pair : components) {
-            ComponentConnection compConn;
-            compConn.componentName = pair.first;
-            
-            // Get component type string
-            ComponentType type = pair.second->getType();
-            switch (type) {
-                case ComponentType::Resistor: compConn.componentType = "Resistor"; break;
-                case ComponentType::Capacitor: compConn.componentType = "Capacitor"; break;
-                case ComponentType::Inductor: compConn.componentType = "Inductor"; break;
-                case ComponentType::VariableResistor: compConn.componentType = "VariableResistor"; break;
-                case ComponentType::Potentiometer: compConn.componentType = "Potentiometer"; break;
-                case ComponentType::Diode: compConn.componentType = "Diode"; break;
-                case ComponentType::OpAmp: compConn.componentType = "OpAmp"; break;
-                case ComponentType::Transformer: compConn.componentType = "Transformer"; break;
-                case ComponentType::Transistor: compConn.componentType = "Transistor"; break;
-                case ComponentType::Speaker: compConn.componentType = "Speaker"; break;
-                case ComponentType::Input: compConn.componentType = "Input"; break;
-                case ComponentType::Output: compConn.componentType = "Output"; break;
-                case ComponentType::Ground: compConn.componentType = "Ground"; break;
-                case ComponentType::Rail: compConn.componentType = "Rail"; break;
-                case ComponentType::Wire: compConn.componentType = "Wire"; break;
-                case ComponentType::Label: compConn.componentType = "Label"; break;
-                case ComponentType::Unknown: compConn.componentType = "Unknown"; break;
+        // Node -> components placed on it
+        std::vector<std::pair<Id, Id>> pairs;
+        pairs.reserve(componentCount);
+        for (size_t c = 0; c < componentCount; ++c) {
+            pairs.emplace_back(compact.componentNode[c], static_cast<Id>(c));
+        }
+        buildRows(nodeCount, pairs, compact.nodeComponentOffsets, compact.nodeComponentIds);
+
+        // Node -> incident wires (wire order)
+        std::vector<Id> wireA(wires.size()), wireB(wires.size());
+        parallelFor(shards, threads, [&](size_t s) {
+            const auto range = shardRange(wires.size(), shards, s);
+            for (size_t w = range.first; w < range.second; ++w) {
+                wireA[w] = compact.findNode(wires[w].nodeA_X, wires[w].nodeA_Y);
+                wireB[w] = compact.findNode(wires[w].nodeB_X, wires[w].nodeB_Y);
             }
-            
-            pair.second->getPosition(compConn.posX, compConn.posY);
-            
-            // Find all connection nodes within proximity (components can have multi-pin connections)
-            ConnectionNode mainNode = {compConn.posX, compConn.posY};
-            compConn.connectedNodes.push_back(mainNode);
-            
-            // Find wire connections to this component
-            for (const auto& wire : wires) {
-                if ((wire.nodeA_X == compConn.posX && wire.nodeA_Y == compConn.posY) ||
-                    (wire.nodeB_X == compConn.posX && wire.nodeB_Y == compConn.posY)) {
-                    
-                    // Add the connected node
-                    if (wire.nodeA_X == compConn.posX && wire.nodeA_Y == compConn.posY) {
-                        ConnectionNode connNode = {wire.nodeB_X, wire.nodeB_Y};
-                        if (std::find(compConn.connectedNodes.begin(), compConn.connectedNodes.end(), connNode) 
-                            == compConn.connectedNodes.end()) {
-                            compConn.connectedNodes.push_back(connNode);
-                        }
-                    } else {
-                        ConnectionNode connNode = {wire.nodeA_X, wire.nodeA_Y};
-                        if (std::find(compConn.connectedNodes.begin(), compConn.connectedNodes.end(), connNode) 
-                            == compConn.connectedNodes.end()) {
-                            compConn.connectedNodes.push_back(connNode);
-                        }
+        });
+        pairs.clear();
+        for (size_t w = 0; w < wires.size(); ++w) {
+            pairs.emplace_back(wireA[w], static_cast<Id>(w));
+            if (wireB[w] != wireA[w]) pairs.emplace_back(wireB[w], static_cast<Id>(w));
+        }
+        std::vector<Id> nodeWireOffsets, nodeWireIds;
+        buildRows(nodeCount, pairs, nodeWireOffsets, nodeWireIds);
+
+        // Component -> own node, then the far end of each wire touching it;
+        // component -> other components on any of those nodes. Each shard
+        // builds the rows of a contiguous component range with its own
+        // "seen" marks; the rows are then stitched together in ID order
+        struct RowShard {
+            std::vector<Id> nodeIds, nodeEnds;          // Row ends relative to the shard
+            std::vector<Id> neighborIds, neighborEnds;
+        };
+        std::vector<RowShard> rowShards(shards);
+        parallelFor(shards, threads, [&](size_t s) {
+            RowShard& shard = rowShards[s];
+            std::vector<Id> nodeSeen(nodeCount, CompactNetlist::NONE);
+            std::vector<Id> componentSeen(componentCount, CompactNetlist::NONE);
+            const auto range = shardRange(componentCount, shards, s);
+            for (size_t c = range.first; c < range.second; ++c) {
+                const Id self = static_cast<Id>(c);
+                const Id home = compact.componentNode[c];
+                const size_t rowStart = shard.nodeIds.size();
+
+                shard.nodeIds.push_back(home);
+                nodeSeen[home] = self;
+                for (Id i = nodeWireOffsets[home]; i < nodeWireOffsets[home + 1]; ++i) {
+                    const Id w = nodeWireIds[i];
+                    const Id other = wireA[w] == home ? wireB[w] : wireA[w];
+                    if (nodeSeen[other] != self) {
+                        nodeSeen[other] = self;
+                        shard.nodeIds.push_back(other);
                     }
                 }
-            }
-            
-            // Find other components at connected nodes
-            for (const auto& node : compConn.connectedNodes) {
-                auto it = positionToComponents.find({node.x, node.y});
-                if (it != positionToComponents.end()) {
-                    for (const auto& compName : it->second) {
-                        if (compName != pair.first) {
-                            if (std::find(compConn.connectedComponents.begin(), 
-                                        compConn.connectedComponents.end(), compName) 
-                                == compConn.connectedComponents.end()) {
-                                compConn.connectedComponents.push_back(compName);
-                            }
+                shard.nodeEnds.push_back(static_cast<Id>(shard.nodeIds.size()));
+
+                componentSeen[c] = self;
+                for (size_t n = rowStart; n < shard.nodeIds.size(); ++n) {
+                    for (Id neighbor : compact.componentsAt(shard.nodeIds[n])) {
+                        if (componentSeen[neighbor] != self) {
+                            componentSeen[neighbor] = self;
+                            shard.neighborIds.push_back(neighbor);
                         }
                     }
                 }
+                shard.neighborEnds.push_back(static_cast<Id>(shard.neighborIds.size()));
             }
-            
-            componentConnections[pair.first] = compConn;
+        });
+
+        std::vector<Id> nodeBase(shards + 1, 0), neighborBase(shards + 1, 0);
+        for (size_t s = 0; s < shards; ++s) {
+            nodeBase[s + 1] = nodeBase[s] + static_cast<Id>(rowShards[s].nodeIds.size());
+            neighborBase[s + 1] = neighborBase[s] + static_cast<Id>(rowShards[s].neighborIds.size());
+        }
+        compact.componentNodeOffsets.assign(componentCount + 1, 0);
+        compact.neighborOffsets.assign(componentCount + 1, 0);
+        compact.componentNodeIds.resize(nodeBase[shards]);
+        compact.neighborIds.resize(neighborBase[shards]);
+        parallelFor(shards, threads, [&](size_t s) {
+            const RowShard& shard = rowShards[s];
+            const size_t firstComponent = shardRange(componentCount, shards, s).first;
+            std::copy(shard.nodeIds.begin(), shard.nodeIds.end(), compact.componentNodeIds.begin() + nodeBase[s]);
+            std::copy(shard.neighborIds.begin(), shard.neighborIds.end(), compact.neighborIds.begin() + neighborBase[s]);
+            for (size_t r = 0; r < shard.nodeEnds.size(); ++r) {
+                compact.componentNodeOffsets[firstComponent + r + 1] = nodeBase[s] + shard.nodeEnds[r];
+                compact.neighborOffsets[firstComponent + r + 1] = neighborBase[s] + shard.neighborEnds[r];
+            }
+        });
+
+        connectivityBuilt = true;
+        viewsStale = true;
+    }
+
+    // ============================================================================
+    // String-keyed Views over the Compact Form
+    // ============================================================================
+    void Netlist::materializeViews() const {
+        connectivityPool.clear();
+        componentConnections.clear();
+
+        for (Id n = 0; n < compact.getNodeCount(); ++n) {
+            std::vector<std::string> names;
+            for (Id c : compact.componentsAt(n)) {
+                names.push_back(compact.components[c]->getName());
+            }
+            const auto& position = compact.nodePositions[n];
+            connectivityPool.emplace_hint(connectivityPool.end(),
+                ConnectionNode{position.first, position.second, {}}, std::move(names));
         }
 
-        // Build the connectivity pool (Node -> Components at that node)
-        for (const auto& posComp : positionToComponents) {
-            ConnectionNode node = {posComp.first.first, posComp.first.second};
-            connectivityPool[node] = posComp.second;
+        for (Id c = 0; c < compact.getComponentCount(); ++c) {
+            const auto& comp = compact.components[c];
+            ComponentConnection compConn;
+            compConn.componentName = comp->getName();
+            compConn.componentType = componentTypeName(comp->getType());
+            compConn.posX = comp->getPosX();
+            compConn.posY = comp->getPosY();
+            for (Id n : compact.nodesOf(c)) {
+                const auto& position = compact.nodePositions[n];
+                compConn.connectedNodes.push_back({position.first, position.second, {}});
+            }
+            for (Id neighbor : compact.neighborsOf(c)) {
+                compConn.connectedComponents.push_back(compact.components[neighbor]->getName());
+            }
+            componentConnections.emplace_hint(componentConnections.end(), comp->getName(), std::move(compConn));
         }
+
+        viewsStale = false;
     }
 
 } // namespace LiveSpice
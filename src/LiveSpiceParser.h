@@ -1,10 +1,13 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <memory>
 #include <stdexcept>
+#include <cstdint>
+#include <utility>
 
 namespace LiveSpice {
 
@@ -31,6 +34,9 @@ namespace LiveSpice {
         Unknown
     };
 
+    /** "Resistor", "Capacitor", ... ("Unknown" for Unknown) */
+    const char* componentTypeName(ComponentType type);
+
     // ============================================================================
     // Component Parameter Structure
     // ============================================================================
@@ -38,6 +44,26 @@ namespace LiveSpice {
         std::string name;
         std::string value;
         std::string unit;
+        double numericValue = 0.0;  // value with its SI prefix applied, parsed once
+    };
+
+    /**
+     * Parameters the DSP mapper reads, resolved while the component is built
+     * so mapping is a field read. A value counts as given when an alias in its
+     * chain has a non-empty string; it is the first nonzero alias (0 if none).
+     */
+    struct CanonicalParams {
+        bool hasResistance = false;
+        double resistance = 0.0;     // Resistance, Value, R
+        bool hasCapacitance = false;
+        double capacitance = 0.0;    // Capacitance, Value, C
+        bool hasInductance = false;
+        double inductance = 0.0;     // Inductance, Value, L
+        double esr = 0.0;            // ESR
+        double dcResistance = 0.0;   // DCR, then DCResistance
+        double openLoopGain = 0.0;   // Aol (op-amps)
+        double gainBandwidth = 0.0;  // GBP (op-amps, Hz)
+        std::string partNumber;      // PartNumber, Model, then Type
     };
 
     // ============================================================================
@@ -48,9 +74,9 @@ namespace LiveSpice {
         Component(const std::string& id, ComponentType type, const std::string& name)
             : id(id), type(type), name(name), rotation(0), flip(false) {}
 
-        std::string getId() const { return id; }
+        const std::string& getId() const { return id; }
         ComponentType getType() const { return type; }
-        std::string getName() const { return name; }
+        const std::string& getName() const { return name; }
         std::vector<ComponentParam> getParams() const { return params; }
 
         void setPosition(int x, int y) { posX = x; posY = y; }
@@ -65,13 +91,33 @@ namespace LiveSpice {
         bool getFlipped() const { return flip; }
 
         void addParam(const std::string& paramName, const std::string& paramValue) {
-            params.push_back({paramName, paramValue, ""});
+            addParam(paramName, paramValue, "");
         }
 
         void addParam(const std::string& paramName, const std::string& paramValue, const std::string& paramUnit) {
-            params.push_back({paramName, paramValue, paramUnit});
+            params.push_back({paramName, paramValue, paramUnit, parseUnit(paramValue)});
+            const int alias = aliasOf(paramName);
+            if (alias >= 0 && aliasParam[alias] < 0) {
+                aliasParam[alias] = static_cast<int>(params.size() - 1);
+                resolveCanonical();
+            }
+        }
+
+        // Replace a parameter's value (added when absent)
+        void setParam(const std::string& paramName, const std::string& paramValue) {
+            for (auto& param : params) {
+                if (param.name == paramName) {
+                    param.value = paramValue;
+                    param.numericValue = parseUnit(paramValue);
+                    if (aliasOf(paramName) >= 0) resolveCanonical();
+                    return;
+                }
+            }
+            addParam(paramName, paramValue);
         }
 
+        const CanonicalParams& getCanonicalParams() const { return canonical; }
+
         std::string getParamValue(const std::string& paramName) const {
             for (const auto& param : params) {
                 if (param.name == paramName) {
@@ -82,9 +128,12 @@ namespace LiveSpice {
         }
 
         double getParamValueAsDouble(const std::string& paramName) const {
-            std::string value = getParamValue(paramName);
-            if (value.empty()) return 0.0;
-            return parseUnit(value);
+            for (const auto& param : params) {
+                if (param.name == paramName) {
+                    return param.numericValue;
+                }
+            }
+            return 0.0;
         }
 
     private:
@@ -97,7 +146,22 @@ namespace LiveSpice {
         bool flip;
         std::vector<ComponentParam> params;
 
-        double parseUnit(const std::string& valueStr) const;
+        // Index in params of the first parameter named each alias (-1 when absent)
+        enum Alias {
+            AliasResistance, AliasCapacitance, AliasInductance, AliasValue, AliasR, AliasC, AliasL,
+            AliasESR, AliasDCR, AliasDCResistance, AliasPartNumber, AliasModel, AliasType, AliasAol, AliasGBP,
+            AliasCount
+        };
+        int aliasParam[AliasCount] = {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1};
+        CanonicalParams canonical;
+
+        static int aliasOf(const std::string& paramName);
+        void resolveCanonical();
+
+        /**
+         * "4.7 kΩ", "100 nF", "1 μF", "2.2e-9" -> SI value; 0 when unparsable
+         */
+        static double parseUnit(std::string_view valueStr);
     };
 
     // ============================================================================
@@ -138,6 +202,61 @@ namespace LiveSpice {
         std::string nodeBName;
     };
 
+    // ============================================================================
+    // Compact Netlist - Dense integer IDs with CSR adjacency
+    // ============================================================================
+
+    /**
+     * Flat form of a Netlist, built by Netlist::buildConnectivityPool().
+     * Components are numbered in name order and nodes (component positions
+     * plus wire endpoints) in position order, so IDs follow the iteration
+     * order of the string-keyed maps. Each relation is stored CSR-style:
+     * row i is ids[offsets[i] .. offsets[i + 1]).
+     */
+    struct CompactNetlist {
+        using Id = uint32_t;
+        static constexpr Id NONE = ~Id(0);
+
+        /** One row of a CSR relation */
+        struct IdRange {
+            const Id* first;
+            const Id* last;
+            const Id* begin() const { return first; }
+            const Id* end() const { return last; }
+            size_t size() const { return static_cast<size_t>(last - first); }
+            bool empty() const { return first == last; }
+        };
+
+        std::vector<std::shared_ptr<Component>> components;  // Component ID -> component
+        std::vector<Id> componentNode;                        // Component ID -> node at its position
+        std::vector<std::pair<int, int>> nodePositions;      // Node ID -> (x, y)
+
+        // Node -> components placed on it (name order)
+        std::vector<Id> nodeComponentOffsets, nodeComponentIds;
+        // Component -> its own node, then nodes reached through one wire
+        std::vector<Id> componentNodeOffsets, componentNodeIds;
+        // Component -> other components on those nodes
+        std::vector<Id> neighborOffsets, neighborIds;
+
+        size_t getComponentCount() const { return components.size(); }
+        size_t getNodeCount() const { return nodePositions.size(); }
+
+        IdRange componentsAt(Id node) const { return row(nodeComponentOffsets, nodeComponentIds, node); }
+        IdRange nodesOf(Id component) const { return row(componentNodeOffsets, componentNodeIds, component); }
+        IdRange neighborsOf(Id component) const { return row(neighborOffsets, neighborIds, component); }
+
+        /** Binary searches; NONE when absent */
+        Id findComponent(const std::string& name) const;
+        Id findNode(int x, int y) const;
+
+        void clear();
+
+    private:
+        static IdRange row(const std::vector<Id>& offsets, const std::vector<Id>& ids, Id i) {
+            return {ids.data() + offsets[i], ids.data() + offsets[i + 1]};
+        }
+    };
+
     // ============================================================================
     // Netlist - Represents the circuit connectivity
     // ============================================================================
@@ -145,10 +264,26 @@ namespace LiveSpice {
     public:
         void addComponent(std::shared_ptr<Component> comp) {
             components[comp->getName()] = comp;
+            connectivityBuilt = false;
         }
 
         void addWire(const Wire& wire) {
             wires.push_back(wire);
+            connectivityBuilt = false;
+        }
+
+        // Editing: false when there is no such component / wire
+        bool removeComponent(const std::string& name) {
+            if (components.erase(name) == 0) return false;
+            connectivityBuilt = false;
+            return true;
+        }
+
+        bool removeWire(size_t index) {
+            if (index >= wires.size()) return false;
+            wires.erase(wires.begin() + static_cast<std::ptrdiff_t>(index));
+            connectivityBuilt = false;
+            return true;
         }
 
         const std::map<std::string, std::shared_ptr<Component>>& getComponents() const {
@@ -170,20 +305,42 @@ namespace LiveSpice {
         size_t getComponentCount() const { return components.size(); }
         size_t getWireCount() const { return wires.size(); }
 
-        // Build and retrieve connectivity pool
-        void buildConnectivityPool();
+        // Build the compact connectivity form; the string-keyed pools below
+        // are views over it, materialized on first access after a build.
+        // Large netlists are built in shards on up to jobs threads
+        // (0 = hardware threads); the result does not depend on jobs.
+        void buildConnectivityPool(unsigned jobs = 0);
+        const CompactNetlist& getCompact() const { return compact; }
+
+        // True once built (or restored) and no component/wire added since
+        bool hasConnectivity() const { return connectivityBuilt; }
+
+        // Adopt a compact form built earlier for this netlist (NetlistCache)
+        void restoreConnectivity(CompactNetlist restored) {
+            compact = std::move(restored);
+            connectivityBuilt = true;
+            viewsStale = true;
+        }
+
         const std::map<ConnectionNode, std::vector<std::string>>& getConnectivityPool() const {
+            if (viewsStale) materializeViews();
             return connectivityPool;
         }
         const std::map<std::string, ComponentConnection>& getComponentConnections() const {
+            if (viewsStale) materializeViews();
             return componentConnections;
         }
 
     private:
         std::map<std::string, std::shared_ptr<Component>> components;
         std::vector<Wire> wires;
-        std::map<ConnectionNode, std::vector<std::string>> connectivityPool; // Node -> Components
-        std::map<std::string, ComponentConnection> componentConnections; // Component -> Connections
+        CompactNetlist compact;
+        bool connectivityBuilt = false;
+
+        void materializeViews() const;
+        mutable bool viewsStale = false;
+        mutable std::map<ConnectionNode, std::vector<std::string>> connectivityPool; // Node -> Components
+        mutable std::map<std::string, ComponentConnection> componentConnections; // Component -> Connections
     };
 
     // ============================================================================
@@ -209,16 +366,25 @@ namespace LiveSpice {
     // ============================================================================
     // LiveSpice XML Parser
     // ============================================================================
+    /**
+     * Tag tokenizer over the source buffer (memory-mapped by parseFile).
+     * Tag names and attribute values are views into it; strings are only
+     * built when a component or wire is committed to the netlist.
+     *
+     * A structural scan first finds every <Element> start. Large documents
+     * are then cut at those boundaries and the chunks decoded on up to jobs
+     * threads (0 = hardware threads), and merged in document order, so the
+     * schematic is the same for any jobs. Small documents decode on the
+     * calling thread.
+     */
     class SchematicParser {
     public:
-        static Schematic parseFile(const std::string& filePath);
-        static Schematic parseString(const std::string& xmlContent);
+        static Schematic parseFile(const std::string& filePath, unsigned jobs = 0);
+        static Schematic parseString(std::string_view xmlContent, unsigned jobs = 0);
 
     private:
-        static ComponentType getComponentType(const std::string& typeStr);
-        static std::string extractAttributeValue(const std::string& line, const std::string& attrName);
-        static std::string extractElementType(const std::string& line);
-        static std::string extractComponentName(const std::string& componentLine);
+        static ComponentType getComponentType(std::string_view typeStr);
+        static std::string_view extractAttributeValue(std::string_view attributes, std::string_view attrName);
     };
 
 } // namespace LiveSpice
@@ -4,9 +4,24 @@
 #include "CircuitDiagnostics.h"
 #include "LiveSpiceConnectionMapper.h"
 #include "JuceDSPGenerator.h"
+#include "NetlistCache.h"
+#include "PhaseProfiler.h"
+#include "JsonRpc.h"
+#include "SpiceModelLibrary.h"
+#include "StagePipeline.h"
+#include "TraceZones.h"
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 using namespace LiveSpice;
 
@@ -18,6 +33,33 @@ using namespace LiveSpice;
 struct GenerationConfig {
     bool useBetaFeatures = false;  // Pattern-specific code generation
     bool verbose = false;
+    int oversamplingFactor = 1;    // Oversample nonlinear stages (1 = off)
+    bool adaptiveOversampling = false; // Factor above is a ceiling chosen per block
+    bool blockProcessing = false;  // Emit stage-by-stage block loops in processBlock
+    bool simdChannels = false;     // Pack channels into SIMD lanes for filter stages
+    bool smoothParameters = false; // Smoothed knobs with dirty-flag stage updates
+    bool foldFixedNetworks = false; // Precomputed coefficients for fixed RC stages
+    bool staticTables = false;     // Emit NonlinearTables.h with the plugin
+    bool nodalDK = false;          // Simulate the whole netlist with the DK method
+    bool wdfClippers = false;      // Wave digital filter trees for diode clippers
+    bool staticChain = false;      // Emit the stage chain as a compile-time type list
+    bool benchmarkHarness = false; // Emit Benchmark.cpp and a benchmark target
+    bool silenceSleep = false;     // Skip processBlock on silence once the tail decays
+    bool traceZones = false;       // Trace zones around processBlock and each stage loop
+    bool svfToneStack = false;     // Beta tone stack as TPT state-variable filters
+    bool waveshaperTables = false; // Clipper stages as baked ADAA waveshaper tables
+    int controlRate = 0;           // Knob-driven inputs every N samples, ramped (0 = per block)
+    bool sharedState = false;      // Immutable models in one process-wide state for all instances
+    double subcircuitTables = 0.0; // Clipper subcircuit table error budget in V (0 = off)
+    bool lazyStages = false;       // Nonlinear stages built on first prepare, curves in the background
+    int subBlockSize = 0;          // Host blocks split into runs of N samples (0 = whole blocks)
+    double cpuBudget = 0.0;        // Clipper budget in ns per channel-sample (0 = off)
+    std::string cacheDirectory;    // Netlist cache location (empty = no cache)
+    std::vector<std::string> spiceLibraries; // SPICE .model/.lib files for unknown parts
+    std::string profilePath;       // Phase profile output (empty = no profiling)
+    PhaseProfiler::Format profileFormat = PhaseProfiler::Format::Json;
+    std::string tracePath;         // Chrome trace of the trace zones (empty = off)
+    bool parallelAnalysis = true;  // Identify circuit stages as parallel tasks
 };
 
 GenerationConfig g_config;
@@ -49,6 +91,813 @@ std::string createValidDirName(const std::string& name) {
     return result;
 }
 
+// Stream buffer feeding two others, so one rendering reaches the log and a file
+class TeeBuffer : public std::streambuf {
+public:
+    TeeBuffer(std::streambuf* first, std::streambuf* second) : first(first), second(second) {}
+
+protected:
+    int overflow(int c) override {
+        if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+        const char ch = traits_type::to_char_type(c);
+        const bool firstOk = !traits_type::eq_int_type(first->sputc(ch), traits_type::eof());
+        const bool secondOk = !traits_type::eq_int_type(second->sputc(ch), traits_type::eof());
+        return firstOk && secondOk ? c : traits_type::eof();
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize count) override {
+        return std::min(first->sputn(s, count), second->sputn(s, count));
+    }
+
+    int sync() override {
+        const int firstResult = first->pubsync();
+        const int secondResult = second->pubsync();
+        return firstResult == 0 && secondResult == 0 ? 0 : -1;
+    }
+
+private:
+    std::streambuf* first;
+    std::streambuf* second;
+};
+
+// ============================================================================
+// SINGLE SCHEMATIC PIPELINE
+// ============================================================================
+// Parse -> analyze -> generate -> write for one schematic, as four stages
+// over a TranslationJob: each stage picks up what the previous one left in
+// the job, so batch mode can run them on separate threads (see runBatch)
+// while translateSchematic runs them in turn. Console output goes to
+// out/err so batch jobs can capture it per file.
+struct TranslationJob {
+    std::string inputFile;
+    std::ostream* out = nullptr;
+    std::ostream* err = nullptr;
+    int status = 0;                 // Set to 1 by the stage that fails; later stages skip the job
+    double milliseconds = 0.0;      // Time spent in stages (not waiting between them)
+
+    Schematic schematic;
+    bool cached = false;            // Schematic and stages came through the netlist cache
+    std::vector<CircuitStage> stages;
+    std::string circuitName;
+    std::string outputDirName;
+    std::vector<JuceDSPGenerator::PluginFile> files;   // Rendered sources, CMakeLists.txt last
+};
+
+void parseStage(TranslationJob& job) {
+    std::ostream& out = *job.out;
+    out << "Parsing LiveSpice file: " << job.inputFile << std::endl;
+
+    // Parse the schematic, or restore it and its analysis from the cache
+    job.cached = !g_config.cacheDirectory.empty();
+    {
+        PhaseProfiler::Scope parsePhase(job.cached ? "parse (netlist cache)" : "parse");
+        if (job.cached) {
+            // Netlist cache misses still skip matching for subcircuits seen in earlier runs
+            TopologyAnalysis::PatternMatchCache::shared().load(g_config.cacheDirectory);
+            NetlistCache cache(g_config.cacheDirectory, SpiceModelLibrary::registryFingerprint());
+            auto circuit = cache.load(job.inputFile);
+            TopologyAnalysis::PatternMatchCache::shared().save(g_config.cacheDirectory);
+            out << (circuit.fromCache ? "Netlist cache hit" : "Netlist cache miss (entry written)") << std::endl;
+            job.schematic = std::move(circuit.schematic);
+            job.stages = std::move(circuit.stages);
+        } else {
+            job.schematic = SchematicParser::parseFile(job.inputFile);
+        }
+    }
+
+    // Get netlist information
+    const Netlist& netlist = job.schematic.getNetlist();
+    out << "\n=== NETLIST INFORMATION ===" << std::endl;
+    out << "Total Components: " << netlist.getComponentCount() << std::endl;
+    out << "Total Wires: " << netlist.getWireCount() << std::endl;
+
+    // Print component list
+    out << "\n=== COMPONENTS ===" << std::endl;
+    for (const auto& pair : netlist.getComponents()) {
+        const auto& comp = pair.second;
+        out << "\n" << comp->getName() << " (";
+
+        switch (comp->getType()) {
+            case ComponentType::Resistor: out << "Resistor"; break;
+            case ComponentType::VariableResistor: out << "Variable Resistor"; break;
+            case ComponentType::Capacitor: out << "Capacitor"; break;
+            case ComponentType::Inductor: out << "Inductor"; break;
+            case ComponentType::Potentiometer: out << "Potentiometer"; break;
+            case ComponentType::Diode: out << "Diode"; break;
+            case ComponentType::Transistor: out << "Transistor (BJT/FET)"; break;
+            case ComponentType::OpAmp: out << "Op-Amp"; break;
+            case ComponentType::Speaker: out << "Speaker"; break;
+            case ComponentType::Input: out << "Input"; break;
+            case ComponentType::Output: out << "Output"; break;
+            case ComponentType::Ground: out << "Ground"; break;
+            case ComponentType::Rail: out << "Power Rail"; break;
+            default: out << "Unknown"; break;
+        }
+        out << ")" << std::endl;
+
+        auto params = comp->getParams();
+        for (const auto& param : params) {
+            out << "  " << param.name << " = " << param.value;
+            if (!param.unit.empty()) out << " " << param.unit;
+            out << std::endl;
+        }
+    }
+}
+
+void analyzeStage(TranslationJob& job) {
+    std::ostream& out = *job.out;
+    std::ostream& err = *job.err;
+    const Schematic& schematic = job.schematic;
+    std::vector<CircuitStage>& stages = job.stages;
+
+    // Analyze the circuit
+    out << "\n=== CIRCUIT ANALYSIS ===" << std::endl;
+    CircuitAnalyzer analyzer(schematic);
+    analyzer.setParallelStages(g_config.parallelAnalysis);
+    if (job.cached) {
+        analyzer.restoreStages(stages);
+    } else {
+        stages = analyzer.analyzeCircuit();
+    }
+
+    out << analyzer.generateReport();
+
+    // Generate circuit connectivity report
+    out << analyzer.generateConnectivityReport();
+
+    out << "\n### DEBUG: About to call junction mapper ###" << std::endl;
+    out.flush();
+
+    // Generate junction-based connectivity analysis
+    out << "\n=== JUNCTION-BASED CONNECTIVITY MAPPING ===" << std::endl;
+    out << "About to create mapper..." << std::endl;
+    out.flush();
+    try {
+        LiveSpiceConnectionMapper connectionMapper(schematic);
+        out << "Mapper created successfully" << std::endl;
+        out.flush();
+        
+        auto junctions = connectionMapper.mapJunctions();
+        out << "Total junctions found: " << junctions.size() << std::endl;
+        out.flush();
+        
+        std::string connectivityReport = connectionMapper.generateConnectivityReport();
+        out << connectivityReport;
+        out.flush();
+    } catch (const std::exception& e) {
+        out << "ERROR in connection mapper: " << e.what() << std::endl;
+    } catch (...) {
+        out << "UNKNOWN ERROR in connection mapper" << std::endl;
+    }
+
+    // Generate diagnostics if connectivity is broken
+    out << "\n=== CIRCUIT EXTRACTION DIAGNOSTICS ===" << std::endl;
+    out.flush();
+    CircuitDiagnostics diagnostics(schematic);
+    std::string diagnosticReport = diagnostics.generateDiagnosticReport();
+    out << diagnosticReport;
+    out.flush();
+
+    // Save diagnostics to file
+    try {
+        std::string docPath = std::getenv("USERPROFILE");
+        docPath += "\\Documents\\";
+        std::string circuitNameForFile = getCircuitName(job.inputFile);
+        for (auto& c : circuitNameForFile) {
+            if (c == ' ') c = '_';
+        }
+        std::string diagnosticsPath = docPath + circuitNameForFile + "_DIAGNOSTICS.txt";
+        
+        std::ofstream diagnosticsFile(diagnosticsPath);
+        if (diagnosticsFile.is_open()) {
+            diagnosticsFile << diagnosticReport;
+            diagnosticsFile.close();
+            out << "\nDiagnostics saved to: " << diagnosticsPath << std::endl;
+        }
+    } catch (...) {
+        // Silent fail for diagnostics
+    }
+
+    // Generate visual representation of extracted circuit
+    out << "\n=== GENERATING EXTRACTED CIRCUIT VISUALIZATION ===" << std::endl;
+    out.flush();
+    CircuitVisualizer visualizer(schematic, analyzer);
+    visualizer.setJobs(g_config.parallelAnalysis ? 0 : 1);
+
+    // Stream to the console/log and, when USERPROFILE is set, to the Documents folder
+    std::string outputFilePath;
+    std::ofstream diagramFile;
+    if (const char* profileDir = std::getenv("USERPROFILE")) {
+        std::string circuitNameForFile = getCircuitName(job.inputFile);
+        // Replace spaces with underscores for filename
+        for (auto& c : circuitNameForFile) {
+            if (c == ' ') c = '_';
+        }
+        outputFilePath = std::string(profileDir) + "\\Documents\\" + circuitNameForFile + "_EXTRACTED_CIRCUIT.txt";
+        diagramFile.open(outputFilePath);
+    }
+    if (diagramFile.is_open()) {
+        TeeBuffer tee(out.rdbuf(), diagramFile.rdbuf());
+        std::ostream both(&tee);
+        visualizer.writeFullDiagram(both);
+    } else {
+        visualizer.writeFullDiagram(out);
+    }
+    out.flush();
+    if (diagramFile.is_open()) {
+        diagramFile.close();
+        if (diagramFile) {
+            out << "\n✓ Extracted circuit diagram saved to: " << outputFilePath << std::endl;
+        } else {
+            err << "Warning: Could not save diagram to file: " << outputFilePath << std::endl;
+        }
+    }
+
+    // Generate DSP configuration
+    out << "\n=== DSP CONFIGURATION ===" << std::endl;
+    out << "Identified " << stages.size() << " processing stages:" << std::endl;
+
+    for (size_t i = 0; i < stages.size(); ++i) {
+        const auto& stage = stages[i];
+        out << "\nStage " << (i + 1) << ": " << stage.name << std::endl;
+        out << "  Type: ";
+
+        switch (stage.type) {
+            case StageType::InputBuffer: out << "Input Buffer"; break;
+            case StageType::GainStage: out << "Gain Stage"; break;
+            case StageType::OpAmpClipping: out << "Op-Amp Clipping"; break;
+            case StageType::LowPassFilter: out << "Low-Pass Filter"; break;
+            case StageType::ToneControl: out << "Tone Control"; break;
+            case StageType::OutputBuffer: out << "Output Buffer"; break;
+            default: out << "Unknown"; break;
+        }
+        out << std::endl;
+
+        if (!stage.dspParams.empty()) {
+            out << "  DSP Parameters:" << std::endl;
+            for (const auto& param : stage.dspParams) {
+                out << "    " << param.first << " = " << param.second << std::endl;
+            }
+        }
+    }
+}
+
+void generateStage(TranslationJob& job) {
+    std::ostream& out = *job.out;
+    std::ostream& err = *job.err;
+    const Netlist& netlist = job.schematic.getNetlist();
+    std::vector<CircuitStage>& stages = job.stages;
+
+    // Generate JUCE DSP plugin code
+    out << "\n=== JUCE DSP CODE GENERATION ===" << std::endl;
+    
+    // Extract circuit name from filename
+    job.circuitName = getCircuitName(job.inputFile);
+    job.outputDirName = createValidDirName(job.circuitName);
+    
+    out << "Circuit Name: " << job.circuitName << std::endl;
+    out << "Output Directory: " << job.outputDirName << std::endl;
+    
+    // Create output directory
+    try {
+        std::filesystem::create_directory(job.outputDirName);
+        out << "Created output directory: " << job.outputDirName << std::endl;
+    } catch (const std::filesystem::filesystem_error& e) {
+        err << "Warning: Could not create directory: " << e.what() << std::endl;
+    }
+    
+    JuceDSPGenerator juceGen;
+    juceGen.setBetaMode(g_config.useBetaFeatures);
+    juceGen.setOversamplingFactor(g_config.oversamplingFactor);
+    juceGen.setAdaptiveOversampling(g_config.adaptiveOversampling);
+    juceGen.setBlockProcessing(g_config.blockProcessing);
+    juceGen.setSimdChannels(g_config.simdChannels);
+    juceGen.setParameterSmoothing(g_config.smoothParameters);
+    juceGen.setFoldFixedNetworks(g_config.foldFixedNetworks);
+    juceGen.setStaticTables(g_config.staticTables);
+    juceGen.setNodalDK(g_config.nodalDK);
+    juceGen.setWdfClippers(g_config.wdfClippers);
+    juceGen.setStaticChain(g_config.staticChain);
+    juceGen.setBenchmarkHarness(g_config.benchmarkHarness);
+    juceGen.setSilenceSleep(g_config.silenceSleep);
+    juceGen.setTraceZones(g_config.traceZones);
+    juceGen.setSvfToneStack(g_config.svfToneStack);
+    juceGen.setWaveshaperTables(g_config.waveshaperTables);
+    juceGen.setControlRate(g_config.controlRate);
+    juceGen.setSharedState(g_config.sharedState);
+    juceGen.setSubcircuitTableBudget(g_config.subcircuitTables);
+    juceGen.setLazyStages(g_config.lazyStages);
+    juceGen.setSubBlockSize(g_config.subBlockSize);
+    juceGen.setJobs(g_config.parallelAnalysis ? 0 : 1);
+    if (g_config.oversamplingFactor > 1) {
+        out << "Oversampling nonlinear stages " << (g_config.adaptiveOversampling ? "1x-" : "")
+            << g_config.oversamplingFactor << "x" << std::endl;
+    }
+    
+    bool useDK = false;
+    if (g_config.nodalDK) {
+        const std::string reason = juceGen.checkNodalDK(netlist);
+        useDK = reason.empty();
+        if (useDK) {
+            out << "Nodal DK backend: simulating the full netlist" << std::endl;
+        } else {
+            out << "Nodal DK backend unavailable (" << reason << "); using the stage chain" << std::endl;
+        }
+    }
+    bool useStaticChain = false;
+    if (g_config.staticChain && !useDK) {
+        const std::string reason = juceGen.checkStaticChain(stages);
+        useStaticChain = reason.empty();
+        if (useStaticChain) {
+            out << "Static chain: stages compiled as a type list (CircuitChain.h)" << std::endl;
+        } else {
+            out << "Static chain unavailable (" << reason << "); using the runtime stage chain" << std::endl;
+        }
+    }
+    if (g_config.wdfClippers && !useDK && !useStaticChain) {
+        const auto diodes = juceGen.findWdfClippers(netlist);
+        if (diodes.empty()) {
+            out << "WDF backend: no diode clipper reduces to a series/parallel tree" << std::endl;
+        } else {
+            out << "WDF backend: simulating";
+            for (const auto& diode : diodes) {
+                out << " " << diode;
+            }
+            out << " as wave digital filter trees" << std::endl;
+        }
+    }
+    if (g_config.cpuBudget > 0.0) {
+        if (useDK || useStaticChain || g_config.wdfClippers) {
+            out << "CPU budget: ignored, the " << (useDK ? "DK" : useStaticChain ? "static chain" : "WDF")
+                << " backend has no alternative implementations"
+                << std::endl;
+        } else {
+            const auto plan = juceGen.applyCpuBudget(stages, g_config.cpuBudget, g_config.oversamplingFactor > 1);
+            if (plan.clippers == 0) {
+                out << "CPU budget: no diode clippers to trade off" << std::endl;
+            } else {
+                out << "CPU budget " << g_config.cpuBudget << " ns/sample: " << plan.clippers << " clipper(s) with "
+                    << CostModel::solverName(plan.solver) << " at " << plan.oversampling << "x, ~"
+                    << plan.nsPerSample << " ns/sample, " << plan.snrDb << " dB SNR" << std::endl;
+                if (!plan.fits) {
+                    out << "Warning: no clipper implementation fits the budget; using the cheapest" << std::endl;
+                }
+            }
+        }
+    }
+    
+    if (g_config.useBetaFeatures) {
+        out << "[BETA] Using pattern-specific DSP code generation" << std::endl;
+    } else {
+        out << "[STABLE] Using legacy DSP code generation" << std::endl;
+    }
+    
+    // Render the plugin sources (with parameter support) and CMakeLists.txt;
+    // writeStage puts them on disk
+    PhaseProfiler::Scope generatePhase("JuceDSPGenerator");
+    job.files = juceGen.generatePluginFiles(job.circuitName, stages, netlist);
+    job.files.push_back({"CMakeLists.txt", juceGen.generateCMakeLists(job.circuitName, "../../third_party", useDK)});
+}
+
+void writeStage(TranslationJob& job) {
+    std::ostream& out = *job.out;
+
+    // Files whose content is unchanged are left alone so plugin rebuilds stay no-op
+    std::vector<JuceDSPGenerator::GeneratedFile> pluginFiles;
+    {
+        PhaseProfiler::Scope writePhase("write plugin files");
+        for (const auto& file : job.files) {
+            pluginFiles.push_back({file.name,
+                JuceDSPGenerator::writeIfChanged(job.outputDirName + "/" + file.name, file.content)});
+        }
+    }
+    for (const auto& file : pluginFiles) {
+        out << (file.changed ? "Wrote " : "Unchanged ") << file.name << std::endl;
+    }
+    
+    // Also print to console for reference
+    out << "\n--- CMakeLists.txt ---\n";
+    out << job.files.back().content << std::endl;
+    
+    out << "\n=== JUCE PLUGIN GENERATION COMPLETE ===" << std::endl;
+    out << "Plugin directory: " << job.outputDirName << std::endl;
+    out << "Build instructions:" << std::endl;
+    out << "  cd " << job.outputDirName << std::endl;
+    out << "  mkdir build" << std::endl;
+    out << "  cd build" << std::endl;
+    out << "  cmake .." << std::endl;
+    out << "  cmake --build . --config Release" << std::endl;
+
+    out << "\n=== PARSING COMPLETE ===" << std::endl;
+}
+
+
+// Run one stage on job unless an earlier one failed, timing it and
+// reporting its exception the way the whole pipeline used to
+void runTranslationStage(TranslationJob& job, void (*stage)(TranslationJob&)) {
+    if (job.status != 0) return;
+    auto start = std::chrono::steady_clock::now();
+    try {
+        stage(job);
+    } catch (const std::exception& e) {
+        *job.err << "Error: " << e.what() << std::endl;
+        job.status = 1;
+    }
+    job.milliseconds += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+int translateSchematic(const std::string& inputFile, std::ostream& out, std::ostream& err) {
+    PhaseProfiler::Scope translatePhase("translate");
+    TranslationJob job;
+    job.inputFile = inputFile;
+    job.out = &out;
+    job.err = &err;
+    for (auto stage : {parseStage, analyzeStage, generateStage, writeStage}) {
+        runTranslationStage(job, stage);
+    }
+    return job.status;
+}
+
+// ============================================================================
+// BATCH MODE
+// ============================================================================
+// --batch=<dir|manifest> translates many schematics. A directory contributes
+// its *.schx files; any other path is a manifest with one schematic per line
+// (blank lines and # comments skipped, relative paths resolved against the
+// manifest's folder). The four translation stages run as a pipeline over
+// bounded queues, so while one file is analyzed the next is being parsed
+// and the previous one written; the CPU-bound analyze and generate stages
+// get --jobs workers each. Workers share the read-only pattern registry and
+// component databases; each file's console output is captured and saved as
+// translation.log in its generated plugin folder.
+
+std::vector<std::string> collectBatchInputs(const std::string& source) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> inputs;
+
+    if (fs::is_directory(source)) {
+        for (const auto& entry : fs::directory_iterator(source)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".schx") {
+                inputs.push_back(entry.path().string());
+            }
+        }
+        std::sort(inputs.begin(), inputs.end());
+        return inputs;
+    }
+
+    std::ifstream manifest(source);
+    if (!manifest.is_open()) {
+        throw std::runtime_error("Cannot open batch manifest: " + source);
+    }
+    const fs::path base = fs::path(source).parent_path();
+    std::string line;
+    while (std::getline(manifest, line)) {
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') continue;
+        size_t last = line.find_last_not_of(" \t\r");
+        fs::path path = line.substr(first, last - first + 1);
+        if (path.is_relative()) path = base / path;
+        inputs.push_back(path.string());
+    }
+    return inputs;
+}
+
+int runBatch(const std::string& source, unsigned jobs, PhaseProfiler* profiler) {
+    std::vector<std::string> inputs = collectBatchInputs(source);
+    if (inputs.empty()) {
+        std::cerr << "No schematics found for batch: " << source << std::endl;
+        return 1;
+    }
+
+    // Two inputs with the same circuit name would write the same plugin folder
+    std::vector<std::string> skipped;
+    {
+        std::vector<std::string> unique;
+        std::vector<std::string> seen;
+        for (const auto& input : inputs) {
+            std::string dir = createValidDirName(getCircuitName(input));
+            if (std::find(seen.begin(), seen.end(), dir) != seen.end()) {
+                skipped.push_back(input);
+                continue;
+            }
+            seen.push_back(dir);
+            unique.push_back(input);
+        }
+        inputs.swap(unique);
+    }
+
+    struct BatchResult {
+        int status = 1;
+        double milliseconds = 0.0;
+        std::string log;
+    };
+    std::vector<BatchResult> results(inputs.size());
+
+    // Build the shared registry up front so workers only ever read it
+    TopologyAnalysis::PatternRegistry::shared();
+
+    jobs = std::max(1u, std::min<unsigned>(jobs, static_cast<unsigned>(inputs.size())));
+
+    // Workers already fill the cores; nested stage tasks would only oversubscribe
+    if (jobs > 1) g_config.parallelAnalysis = false;
+    std::cout << "Batch translating " << inputs.size() << " schematic(s) with "
+              << jobs << " worker(s) per analyze/generate stage" << std::endl;
+
+    // A job queued in front of each stage per worker keeps every stage busy
+    // without letting parsed schematics pile up ahead of a slow analysis
+    struct BatchJob {
+        size_t index = 0;
+        std::unique_ptr<TranslationJob> translation;
+        std::unique_ptr<std::ostringstream> log;
+    };
+    StagePipeline<BatchJob> pipeline(jobs);
+    auto stage = [profiler, &inputs](void (*run)(TranslationJob&)) {
+        return [profiler, &inputs, run](BatchJob& job, uint32_t thread) {
+            PhaseProfiler::attach(profiler, inputs[job.index], thread);
+            runTranslationStage(*job.translation, run);
+            PhaseProfiler::attach(nullptr);
+        };
+    };
+    pipeline.addStage("Parse", 1, stage(parseStage));
+    pipeline.addStage("Analyze", jobs, stage(analyzeStage));
+    pipeline.addStage("Generate", jobs, stage(generateStage));
+    pipeline.addStage("Write", 1, stage(writeStage));
+
+    std::vector<BatchJob> batch(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        batch[i].index = i;
+        batch[i].log = std::make_unique<std::ostringstream>();
+        batch[i].translation = std::make_unique<TranslationJob>();
+        batch[i].translation->inputFile = inputs[i];
+        batch[i].translation->out = batch[i].log.get();
+        batch[i].translation->err = batch[i].log.get();
+    }
+
+    auto wallStart = std::chrono::steady_clock::now();
+    pipeline.run(std::move(batch), [&results](BatchJob job) {
+        // Runs on the write stage's thread, which also saves the log
+        BatchResult& result = results[job.index];
+        result.status = job.translation->status;
+        result.milliseconds = job.translation->milliseconds;
+        result.log = job.log->str();
+        if (result.status == 0) {
+            std::ofstream logFile(job.translation->outputDirName + "/translation.log");
+            if (logFile.is_open()) logFile << result.log;
+        }
+    });
+    double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+
+    // Logs and summary, in input order
+    size_t failures = 0;
+    double totalMs = 0.0;
+    std::cout << "\n=== BATCH SUMMARY ===" << std::endl;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const BatchResult& result = results[i];
+        const bool ok = result.status == 0;
+        if (!ok) ++failures;
+        totalMs += result.milliseconds;
+
+        if (g_config.verbose) {
+            std::cout << "\n--- " << inputs[i] << " ---\n" << result.log;
+        }
+        std::string logPath;
+        if (ok) {
+            logPath = createValidDirName(getCircuitName(inputs[i])) + "/translation.log";
+        } else if (!g_config.verbose) {
+            std::cerr << "\n--- " << inputs[i] << " ---\n" << result.log;
+        }
+
+        char timing[32];
+        std::snprintf(timing, sizeof(timing), "%9.1f ms", result.milliseconds);
+        std::cout << (ok ? "  OK     " : "  FAILED ") << timing << "  " << inputs[i];
+        if (ok) std::cout << "  (log: " << logPath << ")";
+        std::cout << std::endl;
+    }
+    for (const auto& input : skipped) {
+        std::cout << "  SKIPPED              " << input << "  (duplicate circuit name)" << std::endl;
+    }
+
+    char totals[96];
+    std::snprintf(totals, sizeof(totals), "%.1f ms wall, %.1f ms summed over files", wallMs, totalMs);
+    std::cout << "\n" << (inputs.size() - failures) << "/" << inputs.size()
+              << " translated in " << totals << std::endl;
+
+    return (failures > 0 || !skipped.empty()) ? 1 : 0;
+}
+
+// ============================================================================
+// SERVER MODE
+// ============================================================================
+// --serve keeps one process alive for editor integrations: line-delimited
+// JSON-RPC 2.0 on stdin/stdout, with the pattern registry and component
+// databases built once at startup.
+//   translate {file, beta?, oversample?, adaptiveOversample?, block?, simd?, smooth?, foldRc?, staticTables?, dk?, wdf?,
+//              staticChain?, bench?, sleep?, traceZones?, svfTone?, waveshaper?, controlRate?, sharedState?,
+//              subcircuitTables? (true or an error budget in V), lazyStages?, subBlock?, cpuBudget?, cacheDir?, spiceLib?}
+//             -> {status, outputDir, milliseconds, log}
+//   analyze   {file, cacheDir?} -> {components, wires, milliseconds, stages, report}
+//   ping, shutdown
+
+std::string requireFileParam(const Json::Value& params) {
+    const Json::Value* file = params.find("file");
+    if (!file || file->type != Json::Value::Type::String || file->string.empty()) {
+        throw JsonRpcServer::Error(JsonRpcServer::INVALID_PARAMS, "params.file must name a .schx file");
+    }
+    return file->string;
+}
+
+GenerationConfig configForRequest(const Json::Value& params) {
+    GenerationConfig config = g_config;
+    if (const Json::Value* beta = params.find("beta")) {
+        config.useBetaFeatures = beta->asBool(config.useBetaFeatures);
+    }
+    if (const Json::Value* oversample = params.find("oversample")) {
+        config.oversamplingFactor = std::max(1, static_cast<int>(oversample->asNumber(config.oversamplingFactor)));
+    }
+    if (const Json::Value* adaptive = params.find("adaptiveOversample")) {
+        config.adaptiveOversampling = adaptive->asBool(config.adaptiveOversampling);
+    }
+    if (const Json::Value* block = params.find("block")) {
+        config.blockProcessing = block->asBool(config.blockProcessing);
+    }
+    if (const Json::Value* simd = params.find("simd")) {
+        config.simdChannels = simd->asBool(config.simdChannels);
+    }
+    if (const Json::Value* smooth = params.find("smooth")) {
+        config.smoothParameters = smooth->asBool(config.smoothParameters);
+    }
+    if (const Json::Value* foldRc = params.find("foldRc")) {
+        config.foldFixedNetworks = foldRc->asBool(config.foldFixedNetworks);
+    }
+    if (const Json::Value* staticTables = params.find("staticTables")) {
+        config.staticTables = staticTables->asBool(config.staticTables);
+    }
+    if (const Json::Value* dk = params.find("dk")) {
+        config.nodalDK = dk->asBool(config.nodalDK);
+    }
+    if (const Json::Value* wdf = params.find("wdf")) {
+        config.wdfClippers = wdf->asBool(config.wdfClippers);
+    }
+    if (const Json::Value* staticChain = params.find("staticChain")) {
+        config.staticChain = staticChain->asBool(config.staticChain);
+    }
+    if (const Json::Value* bench = params.find("bench")) {
+        config.benchmarkHarness = bench->asBool(config.benchmarkHarness);
+    }
+    if (const Json::Value* sleep = params.find("sleep")) {
+        config.silenceSleep = sleep->asBool(config.silenceSleep);
+    }
+    if (const Json::Value* traceZones = params.find("traceZones")) {
+        config.traceZones = traceZones->asBool(config.traceZones);
+    }
+    if (const Json::Value* svfTone = params.find("svfTone")) {
+        config.svfToneStack = svfTone->asBool(config.svfToneStack);
+    }
+    if (const Json::Value* waveshaper = params.find("waveshaper")) {
+        config.waveshaperTables = waveshaper->asBool(config.waveshaperTables);
+    }
+    if (const Json::Value* controlRate = params.find("controlRate")) {
+        config.controlRate = std::max(0, static_cast<int>(controlRate->asNumber(config.controlRate)));
+    }
+    if (const Json::Value* sharedState = params.find("sharedState")) {
+        config.sharedState = sharedState->asBool(config.sharedState);
+    }
+    if (const Json::Value* subcircuitTables = params.find("subcircuitTables")) {
+        config.subcircuitTables = subcircuitTables->type == Json::Value::Type::Bool
+            ? (subcircuitTables->boolean ? JuceDSPGenerator::DEFAULT_SUBCIRCUIT_BUDGET : 0.0)
+            : std::max(0.0, subcircuitTables->asNumber(config.subcircuitTables));
+    }
+    if (const Json::Value* lazyStages = params.find("lazyStages")) {
+        config.lazyStages = lazyStages->asBool(config.lazyStages);
+    }
+    if (const Json::Value* subBlock = params.find("subBlock")) {
+        config.subBlockSize = std::max(0, static_cast<int>(subBlock->asNumber(config.subBlockSize)));
+    }
+    if (const Json::Value* cpuBudget = params.find("cpuBudget")) {
+        config.cpuBudget = std::max(0.0, cpuBudget->asNumber(config.cpuBudget));
+    }
+    if (const Json::Value* cacheDir = params.find("cacheDir")) {
+        config.cacheDirectory = cacheDir->asString(config.cacheDirectory);
+    }
+    if (const Json::Value* spiceLib = params.find("spiceLib")) {
+        const std::string path = spiceLib->asString("");
+        if (!path.empty()) {
+            if (!SpiceModelLibrary::registerLibrary(path)) {
+                throw JsonRpcServer::Error(JsonRpcServer::INVALID_PARAMS, "Cannot open SPICE model library: " + path);
+            }
+            config.spiceLibraries.push_back(path);
+        }
+    }
+    return config;
+}
+
+std::string formatMilliseconds(std::chrono::steady_clock::time_point start) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.3f",
+                  std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    return text;
+}
+
+int runServer(PhaseProfiler* profiler) {
+    // The protocol owns stdout; stray console output from the pipeline goes to stderr
+    std::ostream rpcOut(std::cout.rdbuf());
+    std::streambuf* consoleBuf = std::cout.rdbuf(std::cerr.rdbuf());
+
+    TopologyAnalysis::PatternRegistry::shared();
+    Nonlinear::ComponentDB::getDiodeDB();
+    Nonlinear::ComponentDB::getBJTDB();
+    Nonlinear::ComponentDB::getFETDB();
+
+    JsonRpcServer server;
+
+    server.addMethod("ping", [](const Json::Value&) {
+        return std::string("\"pong\"");
+    });
+
+    server.addMethod("translate", [profiler](const Json::Value& params) {
+        const std::string file = requireFileParam(params);
+        const GenerationConfig saved = g_config;
+        g_config = configForRequest(params);
+
+        PhaseProfiler::attach(profiler, file);
+        std::ostringstream log;
+        auto start = std::chrono::steady_clock::now();
+        int status = translateSchematic(file, log, log);
+        std::string milliseconds = formatMilliseconds(start);
+        PhaseProfiler::attach(nullptr);
+        g_config = saved;
+
+        return "{\"status\":" + std::to_string(status) +
+               ",\"outputDir\":" + Json::quote(createValidDirName(getCircuitName(file))) +
+               ",\"milliseconds\":" + milliseconds +
+               ",\"log\":" + Json::quote(log.str()) + "}";
+    });
+
+    server.addMethod("analyze", [profiler](const Json::Value& params) {
+        const std::string file = requireFileParam(params);
+        const GenerationConfig config = configForRequest(params);
+
+        PhaseProfiler::attach(profiler, file);
+        auto start = std::chrono::steady_clock::now();
+        Schematic schematic;
+        std::vector<CircuitStage> stages;
+        bool cached = !config.cacheDirectory.empty();
+        if (cached) {
+            TopologyAnalysis::PatternMatchCache::shared().load(config.cacheDirectory);
+            auto circuit = NetlistCache(config.cacheDirectory, SpiceModelLibrary::registryFingerprint()).load(file);
+            TopologyAnalysis::PatternMatchCache::shared().save(config.cacheDirectory);
+            schematic = std::move(circuit.schematic);
+            stages = std::move(circuit.stages);
+        } else {
+            schematic = SchematicParser::parseFile(file);
+        }
+        CircuitAnalyzer analyzer(schematic);
+        analyzer.setParallelStages(config.parallelAnalysis);
+        if (cached) {
+            analyzer.restoreStages(stages);
+        } else {
+            stages = analyzer.analyzeCircuit();
+        }
+        std::string report = analyzer.generateReport();
+        std::string milliseconds = formatMilliseconds(start);
+        PhaseProfiler::attach(nullptr);
+
+        std::string stagesJson = "[";
+        for (size_t i = 0; i < stages.size(); ++i) {
+            const CircuitStage& stage = stages[i];
+            std::string components = "[";
+            for (size_t c = 0; c < stage.components.size(); ++c) {
+                if (c) components += ",";
+                components += stage.components[c] ? Json::quote(stage.components[c]->getName()) : "null";
+            }
+            components += "]";
+
+            char confidence[32];
+            std::snprintf(confidence, sizeof(confidence), "%.3f", stage.patternConfidence);
+            if (i) stagesJson += ",";
+            stagesJson += "{\"name\":" + Json::quote(stage.name) +
+                          ",\"pattern\":" + Json::quote(stage.patternName) +
+                          ",\"strategy\":" + Json::quote(stage.patternStrategy) +
+                          ",\"confidence\":" + confidence +
+                          ",\"components\":" + components + "}";
+        }
+        stagesJson += "]";
+
+        const Netlist& netlist = schematic.getNetlist();
+        return "{\"components\":" + std::to_string(netlist.getComponentCount()) +
+               ",\"wires\":" + std::to_string(netlist.getWireCount()) +
+               ",\"milliseconds\":" + milliseconds +
+               ",\"stages\":" + stagesJson +
+               ",\"report\":" + Json::quote(report) + "}";
+    });
+
+    std::cerr << "livespice-translator: serving JSON-RPC on stdin/stdout" << std::endl;
+    server.serve(std::cin, rpcOut);
+
+    std::cout.rdbuf(consoleBuf);
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     try {
         // Check for help first
@@ -57,10 +906,50 @@ int main(int argc, char* argv[]) {
             if (arg == "--help" || arg == "-h") {
                 std::cout << "LiveSPICE to DSP Translator\n";
                 std::cout << "Usage: " << argv[0] << " [options] <schematic.schx>\n";
+                std::cout << "       " << argv[0] << " [options] --batch=<dir|manifest>\n";
                 std::cout << "\nOptions:\n";
                 std::cout << "  --beta      Enable beta features (pattern-specific DSP generation)\n";
                 std::cout << "  --stable    Use stable/legacy code generation (default)\n";
                 std::cout << "  --verbose   Verbose output\n";
+                std::cout << "  --oversample=N  Oversample nonlinear stages by N (2, 4 or 8)\n";
+                std::cout << "  --adaptive-oversample Run each clipper at 1x..N (--oversample=N) per block, by how\n";
+                std::cout << "              hard and how bright its input is\n";
+                std::cout << "  --block     Generate block-based processBlock (one pass per stage)\n";
+                std::cout << "  --simd      Run filter stages on all channels at once in SIMD lanes (implies --block)\n";
+                std::cout << "  --smooth-params Smooth knobs; update knob-driven stages only on change\n";
+                std::cout << "  --fold-rc   Precompute coefficients for RC stages without potentiometers\n";
+                std::cout << "  --static-tables Emit precomputed diode tables (NonlinearTables.h) with the plugin\n";
+                std::cout << "  --dk        Simulate the whole netlist with the nodal DK method (MNA + Newton on diodes)\n";
+                std::cout << "  --wdf       Simulate diode clippers to ground as wave digital filter trees\n";
+                std::cout << "  --svf-tone  Build the --beta tone stack from TPT state-variable filters\n";
+                std::cout << "  --waveshaper Run clipper stages through a baked diode-pair table with ADAA\n";
+                std::cout << "  --control-rate=N Ramp knob-driven stage inputs, recomputed every N samples;\n";
+                std::cout << "              only the signal path runs per sample\n";
+                std::cout << "  --shared-state Share device parameters, baked tables and per-rate models\n";
+                std::cout << "              between all instances of the plugin in a process\n";
+                std::cout << "  --subcircuit-tables[=V] Pre-solve op-amp/diode clippers over input and pots into\n";
+                std::cout << "              tables interpolated within V volts (default 0.001)\n";
+                std::cout << "  --lazy-stages Build nonlinear stages on the first prepareToPlay and bake\n";
+                std::cout << "              --waveshaper curves in the background (fast plugin scans)\n";
+                std::cout << "  --sub-block=N Process host blocks in runs of N samples (32/64), re-reading the\n";
+                std::cout << "              parameters for each, so automation does not depend on buffer size\n";
+                std::cout << "  --static-chain Compile the stage chain as a type list with constant component values\n";
+                std::cout << "  --bench     Also generate a headless benchmark target (Benchmark.cpp)\n";
+                std::cout << "  --sleep     Skip processing on silent input once the circuit's tail has decayed\n";
+                std::cout << "  --trace-zones Time processBlock and each stage loop; the plugin writes a Chrome\n";
+                std::cout << "              trace to <temp>/<name>.trace.json when it is destroyed\n";
+                std::cout << "  --cpu-budget=NS Pick the most accurate clipper solver and oversampling costing\n";
+                std::cout << "              at most NS ns per channel-sample (--oversample=N fixes the factor)\n";
+                std::cout << "  --cache-dir=DIR Reuse parse, analysis and pattern match results cached in DIR\n";
+                std::cout << "  --spice-lib=FILE Resolve unknown diode/transistor parts from a SPICE .model/.lib\n";
+                std::cout << "              file (repeatable; indexed once into FILE.idx)\n";
+                std::cout << "  --batch=DIR|LIST Translate every .schx in DIR (or listed in LIST) in parallel\n";
+                std::cout << "  --jobs=N    Batch workers for each of the analyze and generate stages\n";
+                std::cout << "              (default: hardware threads)\n";
+                std::cout << "  --serve     Answer JSON-RPC translate/analyze requests on stdin/stdout\n";
+                std::cout << "  --profile=FILE  Record time, allocations and peak RSS per phase to FILE\n";
+                std::cout << "  --profile-format=json|chrome  Profile as JSON (default) or a Chrome trace\n";
+                std::cout << "  --trace=FILE  Record trace zones to FILE as a Chrome trace (build with -DLIVESPICE_TRACE=ON)\n";
                 std::cout << "  --help      Show this help\n";
                 std::cout << "\nMode Details:\n";
                 std::cout << "  STABLE (default): Uses proven generic DSP mapping\n";
@@ -70,6 +959,9 @@ int main(int argc, char* argv[]) {
         }
         
         std::string inputFile = "example pedals/MXR Distortion +.schx";
+        std::string batchSource;
+        int batchJobs = 0;
+        bool serve = false;
 
         // Parse command line arguments
         for (int i = 1; i < argc; ++i) {
@@ -82,232 +974,127 @@ int main(int argc, char* argv[]) {
                 std::cout << "[STABLE MODE] Using legacy code generation\n" << std::endl;
             } else if (arg == "--verbose" || arg == "-v") {
                 g_config.verbose = true;
+            } else if (arg.rfind("--oversample=", 0) == 0) {
+                g_config.oversamplingFactor = std::max(1, std::atoi(arg.c_str() + 13));
+            } else if (arg == "--adaptive-oversample") {
+                g_config.adaptiveOversampling = true;
+            } else if (arg == "--block") {
+                g_config.blockProcessing = true;
+            } else if (arg == "--simd") {
+                g_config.simdChannels = true;
+            } else if (arg == "--smooth-params") {
+                g_config.smoothParameters = true;
+            } else if (arg == "--fold-rc") {
+                g_config.foldFixedNetworks = true;
+            } else if (arg == "--static-tables") {
+                g_config.staticTables = true;
+            } else if (arg == "--dk") {
+                g_config.nodalDK = true;
+            } else if (arg == "--wdf") {
+                g_config.wdfClippers = true;
+            } else if (arg == "--svf-tone") {
+                g_config.svfToneStack = true;
+            } else if (arg == "--waveshaper") {
+                g_config.waveshaperTables = true;
+            } else if (arg.rfind("--control-rate=", 0) == 0) {
+                g_config.controlRate = std::max(0, std::atoi(arg.c_str() + 15));
+            } else if (arg == "--shared-state") {
+                g_config.sharedState = true;
+            } else if (arg == "--subcircuit-tables") {
+                g_config.subcircuitTables = JuceDSPGenerator::DEFAULT_SUBCIRCUIT_BUDGET;
+            } else if (arg.rfind("--subcircuit-tables=", 0) == 0) {
+                g_config.subcircuitTables = std::max(0.0, std::atof(arg.c_str() + 20));
+            } else if (arg == "--lazy-stages") {
+                g_config.lazyStages = true;
+            } else if (arg.rfind("--sub-block=", 0) == 0) {
+                g_config.subBlockSize = std::max(0, std::atoi(arg.c_str() + 12));
+            } else if (arg == "--static-chain") {
+                g_config.staticChain = true;
+            } else if (arg == "--bench") {
+                g_config.benchmarkHarness = true;
+            } else if (arg == "--sleep") {
+                g_config.silenceSleep = true;
+            } else if (arg == "--trace-zones") {
+                g_config.traceZones = true;
+            } else if (arg.rfind("--cpu-budget=", 0) == 0) {
+                g_config.cpuBudget = std::max(0.0, std::atof(arg.c_str() + 13));
+            } else if (arg.rfind("--cache-dir=", 0) == 0) {
+                g_config.cacheDirectory = arg.substr(12);
+            } else if (arg.rfind("--spice-lib=", 0) == 0) {
+                g_config.spiceLibraries.push_back(arg.substr(12));
+            } else if (arg == "--serve") {
+                serve = true;
+            } else if (arg.rfind("--batch=", 0) == 0) {
+                batchSource = arg.substr(8);
+            } else if (arg.rfind("--jobs=", 0) == 0) {
+                batchJobs = std::max(1, std::atoi(arg.c_str() + 7));
+            } else if (arg.rfind("--profile=", 0) == 0) {
+                g_config.profilePath = arg.substr(10);
+            } else if (arg.rfind("--trace=", 0) == 0) {
+                g_config.tracePath = arg.substr(8);
+            } else if (arg.rfind("--profile-format=", 0) == 0) {
+                std::string format = arg.substr(17);
+                if (format == "chrome") {
+                    g_config.profileFormat = PhaseProfiler::Format::ChromeTrace;
+                } else if (format == "json") {
+                    g_config.profileFormat = PhaseProfiler::Format::Json;
+                } else {
+                    std::cerr << "Unknown profile format: " << format << " (expected json or chrome)" << std::endl;
+                    return 1;
+                }
             } else if (arg[0] != '-') {
                 inputFile = arg;
             }
         }
 
-        std::cout << "Parsing LiveSpice file: " << inputFile << std::endl;
-
-        // Parse the schematic
-        Schematic schematic = SchematicParser::parseFile(inputFile);
-
-        // Get netlist information
-        const Netlist& netlist = schematic.getNetlist();
-        std::cout << "\n=== NETLIST INFORMATION ===" << std::endl;
-        std::cout << "Total Components: " << netlist.getComponentCount() << std::endl;
-        std::cout << "Total Wires: " << netlist.getWireCount() << std::endl;
-
-        // Print component list
-        std::cout << "\n=== COMPONENTS ===" << std::endl;
-        for (const auto& pair : netlist.getComponents()) {
-            const auto& comp = pair.second;
-            std::cout << "\n" << comp->getName() << " (";
-
-            switch (comp->getType()) {
-                case ComponentType::Resistor: std::cout << "Resistor"; break;
-                case ComponentType::VariableResistor: std::cout << "Variable Resistor"; break;
-                case ComponentType::Capacitor: std::cout << "Capacitor"; break;
-                case ComponentType::Inductor: std::cout << "Inductor"; break;
-                case ComponentType::Potentiometer: std::cout << "Potentiometer"; break;
-                case ComponentType::Diode: std::cout << "Diode"; break;
-                case ComponentType::Transistor: std::cout << "Transistor (BJT/FET)"; break;
-                case ComponentType::OpAmp: std::cout << "Op-Amp"; break;
-                case ComponentType::Speaker: std::cout << "Speaker"; break;
-                case ComponentType::Input: std::cout << "Input"; break;
-                case ComponentType::Output: std::cout << "Output"; break;
-                case ComponentType::Ground: std::cout << "Ground"; break;
-                case ComponentType::Rail: std::cout << "Power Rail"; break;
-                default: std::cout << "Unknown"; break;
-            }
-            std::cout << ")" << std::endl;
-
-            auto params = comp->getParams();
-            for (const auto& param : params) {
-                std::cout << "  " << param.name << " = " << param.value;
-                if (!param.unit.empty()) std::cout << " " << param.unit;
-                std::cout << std::endl;
+        for (const auto& library : g_config.spiceLibraries) {
+            if (!SpiceModelLibrary::registerLibrary(library)) {
+                std::cerr << "Cannot open SPICE model library: " << library << std::endl;
+                return 1;
             }
         }
 
-        // Analyze the circuit
-        std::cout << "\n=== CIRCUIT ANALYSIS ===" << std::endl;
-        CircuitAnalyzer analyzer(schematic);
-        auto stages = analyzer.analyzeCircuit();
-
-        std::cout << analyzer.generateReport();
-
-        // Generate circuit connectivity report
-        std::cout << analyzer.generateConnectivityReport();
-
-        std::cout << "\n### DEBUG: About to call junction mapper ###" << std::endl;
-        std::cout.flush();
-
-        // Generate junction-based connectivity analysis
-        std::cout << "\n=== JUNCTION-BASED CONNECTIVITY MAPPING ===" << std::endl;
-        std::cout << "About to create mapper..." << std::endl;
-        std::cout.flush();
-        try {
-            LiveSpiceConnectionMapper connectionMapper(schematic);
-            std::cout << "Mapper created successfully" << std::endl;
-            std::cout.flush();
-            
-            auto junctions = connectionMapper.mapJunctions();
-            std::cout << "Total junctions found: " << junctions.size() << std::endl;
-            std::cout.flush();
-            
-            std::string connectivityReport = connectionMapper.generateConnectivityReport();
-            std::cout << connectivityReport;
-            std::cout.flush();
-        } catch (const std::exception& e) {
-            std::cout << "ERROR in connection mapper: " << e.what() << std::endl;
-        } catch (...) {
-            std::cout << "UNKNOWN ERROR in connection mapper" << std::endl;
-        }
-
-        // Generate diagnostics if connectivity is broken
-        std::cout << "\n=== CIRCUIT EXTRACTION DIAGNOSTICS ===" << std::endl;
-        std::cout.flush();
-        CircuitDiagnostics diagnostics(schematic);
-        std::string diagnosticReport = diagnostics.generateDiagnosticReport();
-        std::cout << diagnosticReport;
-        std::cout.flush();
-
-        // Save diagnostics to file
-        try {
-            std::string docPath = std::getenv("USERPROFILE");
-            docPath += "\\Documents\\";
-            std::string circuitNameForFile = getCircuitName(inputFile);
-            for (auto& c : circuitNameForFile) {
-                if (c == ' ') c = '_';
-            }
-            std::string diagnosticsPath = docPath + circuitNameForFile + "_DIAGNOSTICS.txt";
-            
-            std::ofstream diagnosticsFile(diagnosticsPath);
-            if (diagnosticsFile.is_open()) {
-                diagnosticsFile << diagnosticReport;
-                diagnosticsFile.close();
-                std::cout << "\nDiagnostics saved to: " << diagnosticsPath << std::endl;
-            }
-        } catch (...) {
-            // Silent fail for diagnostics
+        std::unique_ptr<PhaseProfiler> profiler;
+        if (!g_config.profilePath.empty()) {
+            profiler = std::make_unique<PhaseProfiler>();
         }
-
-        // Generate visual representation of extracted circuit
-        std::cout << "\n=== GENERATING EXTRACTED CIRCUIT VISUALIZATION ===" << std::endl;
-        std::cout.flush();
-        CircuitVisualizer visualizer(schematic, analyzer);
-        std::string extractedDiagram = visualizer.generateFullDiagram();
-        
-        // Output to console
-        std::cout << extractedDiagram;
-        std::cout.flush();
-        
-        // Save to file in Documents folder
-        try {
-            std::string docPath = std::getenv("USERPROFILE");
-            docPath += "\\Documents\\";
-            std::string circuitNameForFile = getCircuitName(inputFile);
-            // Replace spaces with underscores for filename
-            for (auto& c : circuitNameForFile) {
-                if (c == ' ') c = '_';
-            }
-            std::string outputFilePath = docPath + circuitNameForFile + "_EXTRACTED_CIRCUIT.txt";
-            
-            std::ofstream diagramFile(outputFilePath);
-            if (diagramFile.is_open()) {
-                diagramFile << extractedDiagram;
-                diagramFile.close();
-                std::cout << "\n✓ Extracted circuit diagram saved to: " << outputFilePath << std::endl;
+        if (!g_config.tracePath.empty()) {
+            if (!LIVESPICE_TRACE) {
+                std::cerr << "Warning: --trace needs a build with -DLIVESPICE_TRACE=ON; the trace will be empty" << std::endl;
             }
-        } catch (const std::exception& e) {
-            std::cerr << "Warning: Could not save diagram to file: " << e.what() << std::endl;
+            LiveSpiceDSP::TraceSession::start();
+            LIVESPICE_TRACE_THREAD("Main");
         }
 
-        // Generate DSP configuration
-        std::cout << "\n=== DSP CONFIGURATION ===" << std::endl;
-        std::cout << "Identified " << stages.size() << " processing stages:" << std::endl;
-
-        for (size_t i = 0; i < stages.size(); ++i) {
-            const auto& stage = stages[i];
-            std::cout << "\nStage " << (i + 1) << ": " << stage.name << std::endl;
-            std::cout << "  Type: ";
-
-            switch (stage.type) {
-                case StageType::InputBuffer: std::cout << "Input Buffer"; break;
-                case StageType::GainStage: std::cout << "Gain Stage"; break;
-                case StageType::OpAmpClipping: std::cout << "Op-Amp Clipping"; break;
-                case StageType::LowPassFilter: std::cout << "Low-Pass Filter"; break;
-                case StageType::ToneControl: std::cout << "Tone Control"; break;
-                case StageType::OutputBuffer: std::cout << "Output Buffer"; break;
-                default: std::cout << "Unknown"; break;
-            }
-            std::cout << std::endl;
-
-            if (!stage.dspParams.empty()) {
-                std::cout << "  DSP Parameters:" << std::endl;
-                for (const auto& param : stage.dspParams) {
-                    std::cout << "    " << param.first << " = " << param.second << std::endl;
-                }
-            }
+        int status;
+        if (serve) {
+            status = runServer(profiler.get());
+        } else if (!batchSource.empty()) {
+            unsigned jobs = batchJobs > 0 ? static_cast<unsigned>(batchJobs)
+                                          : std::max(1u, std::thread::hardware_concurrency());
+            status = runBatch(batchSource, jobs, profiler.get());
+        } else {
+            PhaseProfiler::attach(profiler.get(), inputFile);
+            status = translateSchematic(inputFile, std::cout, std::cerr);
+            PhaseProfiler::attach(nullptr);
         }
 
-        // Generate JUCE DSP plugin code
-        std::cout << "\n=== JUCE DSP CODE GENERATION ===" << std::endl;
-        
-        // Extract circuit name from filename
-        std::string circuitName = getCircuitName(inputFile);
-        std::string outputDirName = createValidDirName(circuitName);
-        
-        std::cout << "Circuit Name: " << circuitName << std::endl;
-        std::cout << "Output Directory: " << outputDirName << std::endl;
-        
-        // Create output directory
-        try {
-            std::filesystem::create_directory(outputDirName);
-            std::cout << "Created output directory: " << outputDirName << std::endl;
-        } catch (const std::filesystem::filesystem_error& e) {
-            std::cerr << "Warning: Could not create directory: " << e.what() << std::endl;
-        }
-        
-        JuceDSPGenerator juceGen;
-        juceGen.setBetaMode(g_config.useBetaFeatures);
-        
-        if (g_config.useBetaFeatures) {
-            std::cout << "[BETA] Using pattern-specific DSP code generation" << std::endl;
-        } else {
-            std::cout << "[STABLE] Using legacy DSP code generation" << std::endl;
+        if (profiler) {
+            if (profiler->write(g_config.profilePath, g_config.profileFormat)) {
+                std::cout << "Profile written to: " << g_config.profilePath << std::endl;
+            } else {
+                std::cerr << "Warning: Could not write profile to " << g_config.profilePath << std::endl;
+            }
         }
-        
-        // Write plugin files to the output directory (with parameter support)
-        juceGen.writePluginFiles(outputDirName, circuitName, stages, schematic.getNetlist());
-        std::cout << "Wrote CircuitProcessor.h" << std::endl;
-        std::cout << "Wrote CircuitProcessor.cpp" << std::endl;
-        
-        // Generate CMakeLists.txt
-        std::string cmakeContent = juceGen.generateCMakeLists(circuitName, "../../third_party");
-        std::ofstream cmakeFile(outputDirName + "/CMakeLists.txt");
-        if (cmakeFile.is_open()) {
-            cmakeFile << cmakeContent;
-            cmakeFile.close();
-            std::cout << "Wrote CMakeLists.txt" << std::endl;
+        if (!g_config.tracePath.empty()) {
+            LiveSpiceDSP::TraceSession::stop();
+            if (LiveSpiceDSP::TraceSession::write(g_config.tracePath)) {
+                std::cout << "Trace written to: " << g_config.tracePath << std::endl;
+            } else {
+                std::cerr << "Warning: Could not write trace to " << g_config.tracePath << std::endl;
+            }
         }
-        
-        // Also print to console for reference
-        std::cout << "\n--- CMakeLists.txt ---\n";
-        std::cout << cmakeContent << std::endl;
-        
-        std::cout << "\n=== JUCE PLUGIN GENERATION COMPLETE ===" << std::endl;
-        std::cout << "Plugin directory: " << outputDirName << std::endl;
-        std::cout << "Build instructions:" << std::endl;
-        std::cout << "  cd " << outputDirName << std::endl;
-        std::cout << "  mkdir build" << std::endl;
-        std::cout << "  cd build" << std::endl;
-        std::cout << "  cmake .." << std::endl;
-        std::cout << "  cmake --build . --config Release" << std::endl;
-
-        std::cout << "\n=== PARSING COMPLETE ===" << std::endl;
-        return 0;
+        return status;
 
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
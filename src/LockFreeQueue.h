@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file LockFreeQueue.h
+ * @brief Bounded single-producer / single-consumer queue
+ *
+ * Fixed-capacity ring with acquire/release indices: push() and pop() never
+ * lock or allocate, so a UI/automation thread can hand trivially copyable
+ * messages (parameter snapshots) to the audio thread. Exactly one thread
+ * may push and one thread may pop.
+ */
+
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(std::is_trivially_copyable<T>::value, "SpscQueue holds trivially copyable messages");
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    /**
+     * Producer side; returns false (message dropped) when full
+     */
+    bool push(const T& item) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) == Capacity) return false;
+        m_items[tail & (Capacity - 1)] = item;
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer side; returns false when empty
+     */
+    bool pop(T& item) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) return false;
+        item = m_items[head & (Capacity - 1)];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer side: drain the queue, keeping only the newest message
+     */
+    bool popLatest(T& item) {
+        bool any = false;
+        while (pop(item)) any = true;
+        return any;
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    std::array<T, Capacity> m_items{};
+    alignas(64) std::atomic<size_t> m_head{0};
+    alignas(64) std::atomic<size_t> m_tail{0};
+};
+
+} // namespace LiveSpiceDSP
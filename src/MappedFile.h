@@ -0,0 +1,102 @@
+#pragma once
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace LiveSpice {
+
+    // ============================================================================
+    // Read-only File Mapping
+    // ============================================================================
+
+    /**
+     * Maps a file read-only for the object's lifetime (schematics, netlist
+     * cache entries). Falls back to a single read when the file can be
+     * opened but not mapped.
+     */
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+            m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                 OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (m_file == INVALID_HANDLE_VALUE) return;
+            m_open = true;
+            LARGE_INTEGER size;
+            if (GetFileSizeEx(m_file, &size) && size.QuadPart > 0) {
+                m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (m_mapping) {
+                    m_data = static_cast<const char*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+                    if (m_data) m_size = static_cast<size_t>(size.QuadPart);
+                }
+                if (!m_data) readFallback(path);
+            }
+#else
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) return;
+            m_open = true;
+            struct stat info;
+            if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+                void* data = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+                if (data != MAP_FAILED) {
+                    m_data = static_cast<const char*>(data);
+                    m_size = static_cast<size_t>(info.st_size);
+                } else {
+                    readFallback(path);
+                }
+            }
+            ::close(fd);
+#endif
+        }
+
+        ~MappedFile() {
+#ifdef _WIN32
+            if (m_data && m_fallback.empty()) UnmapViewOfFile(m_data);
+            if (m_mapping) CloseHandle(m_mapping);
+            if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+#else
+            if (m_data && m_fallback.empty()) ::munmap(const_cast<char*>(m_data), m_size);
+#endif
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool isOpen() const { return m_open; }
+        std::string_view view() const { return std::string_view(m_data, m_size); }
+
+    private:
+        void readFallback(const std::string& path) {
+            std::ifstream file(path, std::ios::binary);
+            std::stringstream buffer;
+            buffer << file.rdbuf();
+            m_fallback = buffer.str();
+            m_data = m_fallback.data();
+            m_size = m_fallback.size();
+        }
+
+        const char* m_data = nullptr;
+        size_t m_size = 0;
+        bool m_open = false;
+        std::string m_fallback;
+#ifdef _WIN32
+        HANDLE m_file = INVALID_HANDLE_VALUE;
+        HANDLE m_mapping = nullptr;
+#endif
+    };
+
+} // namespace LiveSpice
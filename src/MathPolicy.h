@@ -0,0 +1,192 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file MathPolicy.h
+ * @brief Interchangeable exp/log/pow implementations for device models
+ *
+ * Device models take one of these as a template parameter (defaulting to
+ * DefaultMath) so accuracy can be traded for throughput per build without
+ * touching the models. Every policy exposes the same static functions:
+ *   exp(x), log(x), log10(x), exp10(x), exp2(x), log2(x), pow(base, exponent)
+ * log/log10/log2/pow are defined for x > 0 only; callers already guard.
+ *
+ * Error bounds (float, measured in test_math_policy.cpp):
+ * - ExactMath: libm, <= 1 ulp
+ * - FastMath:  exp   relative < 2e-7 over [-87, 88] (clamped outside)
+ *              log   absolute < 2e-7 * max(1, |ln x|) for normal x
+ *              log10 absolute < 3e-7 * max(1, |log10 x|)
+ *              exp10 relative < 2e-6 for |x| <= 8
+ *              exp2  relative < 2e-7 over [-126, 127]
+ *              log2  absolute < 2e-7 * max(1, |log2 x|)
+ *              pow   relative < 5e-7 * max(1, |exponent * ln(base)|)
+ * - SimdMath:  FastMath results, plus array forms that auto-vectorize
+ *
+ * Define LIVESPICE_FAST_MATH to make FastMath the build-wide default.
+ */
+
+// ============================================================================
+// ExactMath - libm reference
+// ============================================================================
+
+struct ExactMath {
+    static float exp(float x) { return std::exp(x); }
+    static float log(float x) { return std::log(x); }
+    static float log10(float x) { return std::log10(x); }
+    static float exp10(float x) { return std::pow(10.0f, x); }
+    static float exp2(float x) { return std::exp2(x); }
+    static float log2(float x) { return std::log2(x); }
+    static float pow(float base, float exponent) { return std::pow(base, exponent); }
+};
+
+// ============================================================================
+// FastMath - branch-free polynomial approximations
+// ============================================================================
+
+struct FastMath {
+    /**
+     * Cody-Waite range reduction + degree-5 polynomial, 2^n built from bits
+     */
+    static float exp(float x) {
+        x = std::min(std::max(x, -87.0f), 88.0f);
+        float fx = x * 1.44269504088896341f;
+        int n = static_cast<int>(fx + (fx >= 0.0f ? 0.5f : -0.5f));
+        float nf = static_cast<float>(n);
+        float r = x - nf * 0.693359375f + nf * 2.12194440e-4f;
+        return expReduced(r) * pow2i(n);
+    }
+
+    /**
+     * 2^x = 2^n * e^(f ln 2), f = x - n exact for the rounded n
+     */
+    static float exp2(float x) {
+        x = std::min(std::max(x, -126.0f), 127.0f);
+        int n = static_cast<int>(x + (x >= 0.0f ? 0.5f : -0.5f));
+        float r = (x - static_cast<float>(n)) * 0.693147181f;
+        return expReduced(r) * pow2i(n);
+    }
+
+    /**
+     * Mantissa reduced to [sqrt(1/2), sqrt(2)), then
+     * ln(m) = 2 atanh(s), s = (m-1)/(m+1), odd series to s^9
+     */
+    static float log(float x) {
+        int e;
+        float lnm = logMantissa(x, e);
+        return static_cast<float>(e) * 0.693147181f + lnm;
+    }
+
+    static float log2(float x) {
+        int e;
+        float lnm = logMantissa(x, e);
+        return static_cast<float>(e) + lnm * 1.44269504f;
+    }
+
+    static float log10(float x) { return log(x) * 0.434294482f; }
+    static float exp10(float x) { return exp(x * 2.30258509f); }
+    static float pow(float base, float exponent) { return exp(exponent * log(base)); }
+
+private:
+    /** e^r for |r| <= ln(2)/2 */
+    static float expReduced(float r) {
+        float p = 1.9875691500e-4f;
+        p = p * r + 1.3981999507e-3f;
+        p = p * r + 8.3334519073e-3f;
+        p = p * r + 4.1665795894e-2f;
+        p = p * r + 1.6666665459e-1f;
+        p = p * r + 5.0000001201e-1f;
+        return p * r * r + r + 1.0f;
+    }
+
+    /** 2^n for n in [-126, 127], from the exponent bits */
+    static float pow2i(int n) {
+        int bits = (n + 127) << 23;
+        float scale;
+        std::memcpy(&scale, &bits, sizeof(scale));
+        return scale;
+    }
+
+    /** x = m 2^e with m in [sqrt(1/2), sqrt(2)); returns ln(m) */
+    static float logMantissa(float x, int& e) {
+        x = std::max(x, 1.17549435e-38f);
+        int bits;
+        std::memcpy(&bits, &x, sizeof(bits));
+        e = ((bits >> 23) & 0xFF) - 127;
+        bits = (bits & 0x007FFFFF) | 0x3F800000;
+        float m;
+        std::memcpy(&m, &bits, sizeof(m));
+        bool high = m > 1.41421356f;
+        m = high ? m * 0.5f : m;
+        e = high ? e + 1 : e;
+
+        float s = (m - 1.0f) / (m + 1.0f);
+        float s2 = s * s;
+        float p = 0.11111111f;
+        p = p * s2 + 0.14285714f;
+        p = p * s2 + 0.2f;
+        p = p * s2 + 0.33333333f;
+        p = p * s2 + 1.0f;
+        return 2.0f * s * p;
+    }
+};
+
+// ============================================================================
+// SimdMath - FastMath over arrays
+// ============================================================================
+
+/**
+ * Scalar calls are FastMath; the array forms are plain loops over the
+ * branch-free kernels, which GCC/Clang/MSVC vectorize at -O2/-O3 for the
+ * target's vector width (SSE2/AVX2/NEON). Results equal FastMath exactly.
+ */
+struct SimdMath : FastMath {
+    using FastMath::exp;
+    using FastMath::log;
+    using FastMath::log10;
+    using FastMath::exp10;
+    using FastMath::exp2;
+    using FastMath::log2;
+    using FastMath::pow;
+
+    static void exp(const float* x, float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) out[i] = FastMath::exp(x[i]);
+    }
+
+    static void log(const float* x, float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) out[i] = FastMath::log(x[i]);
+    }
+
+    static void log10(const float* x, float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) out[i] = FastMath::log10(x[i]);
+    }
+
+    static void exp10(const float* x, float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) out[i] = FastMath::exp10(x[i]);
+    }
+
+    static void exp2(const float* x, float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) out[i] = FastMath::exp2(x[i]);
+    }
+
+    static void log2(const float* x, float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) out[i] = FastMath::log2(x[i]);
+    }
+
+    static void pow(const float* base, float exponent, float* out, size_t n) {
+        for (size_t i = 0; i < n; ++i) out[i] = FastMath::pow(base[i], exponent);
+    }
+};
+
+#ifdef LIVESPICE_FAST_MATH
+using DefaultMath = FastMath;
+#else
+using DefaultMath = ExactMath;
+#endif
+
+} // namespace LiveSpiceDSP
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file MemoryFootprint.h
+ * @brief Per-object memory reports and the compact storage mode
+ *
+ * A session with hundreds of pedal instances stays fast only while each
+ * instance's working set fits in cache. getMemoryFootprint() on the DSP
+ * objects splits what an instance costs into the object itself, the heap
+ * storage it owns, and tables it shares with every other instance at the
+ * same settings (paid once per process, however many instances there are).
+ */
+
+/**
+ * Storage policy chosen at construction. Compact trades set-up cost for a
+ * smaller per-instance working set: tables that Standard builds per
+ * instance (the ADAA antiderivative tables) come from a process-wide
+ * cache, and storage a configuration does not use (a compressor's
+ * look-ahead line outside Lookahead mode) is only allocated when that
+ * configuration is selected, so those setters allocate. Audio is the same
+ * in both modes.
+ */
+enum class MemoryMode { Standard, Compact };
+
+struct MemoryFootprint {
+    size_t objectBytes = 0;   // sizeof the object (members held by value)
+    size_t heapBytes = 0;     // Heap storage owned by this instance
+    size_t sharedBytes = 0;   // Tables shared with other instances (per reference held)
+
+    /** What one more instance costs */
+    size_t instanceBytes() const { return objectBytes + heapBytes; }
+
+    /** Add a member held by value: its object bytes are already in ours */
+    void addMember(const MemoryFootprint& member) {
+        heapBytes += member.heapBytes;
+        sharedBytes += member.sharedBytes;
+    }
+
+    /** Add an object this one owns on the heap (by pointer or in a vector) */
+    void addOwned(const MemoryFootprint& owned) {
+        heapBytes += owned.instanceBytes();
+        sharedBytes += owned.sharedBytes;
+    }
+
+    /** Heap storage behind a vector member (its capacity, not its size) */
+    template <typename T>
+    void addVector(const std::vector<T>& vector) {
+        heapBytes += vector.capacity() * sizeof(T);
+    }
+};
+
+}  // namespace LiveSpiceDSP
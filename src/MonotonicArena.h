@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file MonotonicArena.h
+ * @brief Bump allocator for structures built once and torn down together
+ *
+ * Everything a runtime DSP graph needs (node objects, per-channel kernel
+ * state, schedules, scratch buffers) is carved out of one block in build
+ * order, so the processing loop walks memory that sits together. Nothing
+ * is freed individually: release() runs the destructors of non-trivial
+ * objects newest first and rewinds the arena in one step.
+ *
+ * An allocation that does not fit chains another block; release() then
+ * merges the blocks, so the next build of the same size is contiguous.
+ * Not thread safe; build on one thread, then hand the result over.
+ */
+class MonotonicArena {
+public:
+    static constexpr size_t DEFAULT_BLOCK_BYTES = 16 * 1024;
+
+    explicit MonotonicArena(size_t initialBytes = DEFAULT_BLOCK_BYTES) : m_nextBlockBytes(std::max<size_t>(initialBytes, 256)) {}
+    ~MonotonicArena() { release(); }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    /**
+     * Make the next bytes of allocations contiguous (grows before a build
+     * rather than chaining blocks partway through it)
+     */
+    void reserve(size_t bytes) {
+        if (m_blocks.empty() || m_blocks.back().size - m_used < bytes) addBlock(bytes);
+    }
+
+    /**
+     * Raw storage, never null; lives until release()
+     */
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        if (!m_blocks.empty()) {
+            if (void* p = carve(m_blocks.back(), bytes, alignment)) return p;
+        }
+        addBlock(bytes + alignment);
+        return carve(m_blocks.back(), bytes, alignment);
+    }
+
+    /**
+     * Construct one T in the arena; its destructor runs at release()
+     */
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        registerCleanup(object, 1);
+        return object;
+    }
+
+    /**
+     * Construct count contiguous Ts, each from the same arguments
+     * (value-initialized when there are none)
+     */
+    template <typename T, typename... Args>
+    T* createArray(size_t count, const Args&... args) {
+        if (count == 0) return nullptr;
+        T* objects = static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+        for (size_t i = 0; i < count; ++i) new (objects + i) T(args...);
+        registerCleanup(objects, count);
+        return objects;
+    }
+
+    /**
+     * Destroy every object (newest first) and rewind; chained blocks are
+     * merged into one so the next build of this size is contiguous
+     */
+    void release() {
+        for (Cleanup* c = m_cleanups; c; c = c->next) c->destroy(c->objects, c->count);
+        m_cleanups = nullptr;
+
+        if (m_blocks.size() > 1) {
+            size_t total = 0;
+            for (const auto& block : m_blocks) total += block.size;
+            m_blocks.clear();
+            addBlock(total);
+        }
+        m_used = 0;
+        m_bytesUsed = 0;
+    }
+
+    /** Bytes handed out since the last release(), alignment padding included */
+    size_t getBytesUsed() const { return m_bytesUsed; }
+
+    size_t getCapacity() const {
+        size_t total = 0;
+        for (const auto& block : m_blocks) total += block.size;
+        return total;
+    }
+
+    size_t getNumBlocks() const { return m_blocks.size(); }
+
+private:
+    struct Block {
+        std::unique_ptr<unsigned char[]> data;
+        size_t size = 0;
+    };
+
+    struct Cleanup {
+        void (*destroy)(void* objects, size_t count);
+        void* objects;
+        size_t count;
+        Cleanup* next;
+    };
+
+    std::vector<Block> m_blocks;
+    size_t m_used = 0;             // Bytes used in the newest block
+    size_t m_bytesUsed = 0;
+    size_t m_nextBlockBytes;
+    Cleanup* m_cleanups = nullptr;
+
+    void addBlock(size_t minBytes) {
+        const size_t size = std::max(minBytes, m_nextBlockBytes);
+        m_blocks.push_back({std::unique_ptr<unsigned char[]>(new unsigned char[size]), size});
+        m_nextBlockBytes = size * 2;
+        m_used = 0;
+    }
+
+    void* carve(Block& block, size_t bytes, size_t alignment) {
+        const auto base = reinterpret_cast<std::uintptr_t>(block.data.get());
+        const std::uintptr_t start = (base + m_used + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+        const size_t end = static_cast<size_t>(start - base) + bytes;
+        if (end > block.size) return nullptr;
+        m_bytesUsed += end - m_used;
+        m_used = end;
+        return reinterpret_cast<void*>(start);
+    }
+
+    template <typename T>
+    void registerCleanup(T* objects, size_t count) {
+        if constexpr (std::is_trivially_destructible<T>::value) return;
+        auto* cleanup = static_cast<Cleanup*>(allocate(sizeof(Cleanup), alignof(Cleanup)));
+        cleanup->destroy = [](void* p, size_t n) {
+            for (size_t i = n; i-- > 0;) static_cast<T*>(p)[i].~T();
+        };
+        cleanup->objects = objects;
+        cleanup->count = count;
+        cleanup->next = m_cleanups;
+        m_cleanups = cleanup;
+    }
+};
+
+}  // namespace LiveSpiceDSP
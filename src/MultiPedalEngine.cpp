@@ -0,0 +1,223 @@
+#include "MultiPedalEngine.h"
+#include "Denormals.h"
+#include <cmath>
+#include <algorithm>
+
+namespace LiveSpiceDSP {
+
+// ============================================================================
+// MultiPedalEngine Implementation
+// ============================================================================
+
+MultiPedalEngine::MultiPedalEngine(size_t numInstances, float sampleRate, size_t numClipperStages)
+    : m_sampleRate(sampleRate),
+      m_numInstances(numInstances),
+      m_numClipperStages(numClipperStages),
+      m_inputCoeff(MultiStagePedal::inputBufferCoefficients(sampleRate)),
+      m_outputCoeff(MultiStagePedal::outputBufferCoefficients(sampleRate)),
+      m_solver(Nonlinear::DiodeCharacteristics::Si1N4148()),
+      m_toneTable(ToneStackController::acquireCoefficientTable(sampleRate)) {
+
+    // Same diode as MultiStagePedal's clipper stages
+    Nonlinear::DiodeClippingStage prototype(Nonlinear::DiodeCharacteristics::Si1N4148());
+    m_forwardVoltage = prototype.getForwardVoltage();
+
+    m_groups.resize((numInstances + LANES - 1) / LANES);
+    for (size_t g = 0; g < m_groups.size(); ++g) {
+        m_groups[g].firstInstance = g * LANES;
+        m_groups[g].count = std::min(LANES, numInstances - g * LANES);
+        m_groups[g].drive.fill(1.0f);
+    }
+
+    m_gates.reserve(numInstances);
+    m_outputStages.reserve(numInstances);
+    for (size_t i = 0; i < numInstances; ++i) {
+        m_gates.emplace_back(sampleRate);
+        m_outputStages.emplace_back(sampleRate);
+        setToneGains(i, 0.0f, 0.0f, 0.0f);
+    }
+    m_outputBufferState.assign(numInstances, {0.0f, 0.0f});
+    m_volume.assign(numInstances, 1.0f);
+    m_frames.resize(CHUNK * LANES);
+    m_sharedInputs.resize(numInstances);
+}
+
+void MultiPedalEngine::processBlock(const float* const* inputs, float* const* outputs, size_t numSamples) {
+    ScopedFlushDenormals noDenormals;
+    for (size_t offset = 0; offset < numSamples; offset += CHUNK) {
+        size_t n = std::min(CHUNK, numSamples - offset);
+        for (auto& group : m_groups) {
+            processGroup(group, inputs, outputs, offset, n);
+        }
+    }
+}
+
+void MultiPedalEngine::processShared(const float* input, float* const* outputs, size_t numSamples) {
+    std::fill(m_sharedInputs.begin(), m_sharedInputs.end(), input);
+    processBlock(m_sharedInputs.data(), outputs, numSamples);
+}
+
+void MultiPedalEngine::processGroup(LaneGroup& group, const float* const* inputs, float* const* outputs,
+                                    size_t offset, size_t numSamples) {
+    float* frames = m_frames.data();
+
+    // Gather; unused lanes run on silence
+    for (size_t l = 0; l < LANES; ++l) {
+        const float* in = l < group.count ? inputs[group.firstInstance + l] + offset : nullptr;
+        for (size_t i = 0; i < numSamples; ++i) {
+            frames[i * LANES + l] = in ? in[i] : 0.0f;
+        }
+    }
+
+    // Input buffer + drive
+    const MultiStagePedal::BufferCoefficients k = m_inputCoeff;
+    for (size_t i = 0; i < numSamples; ++i) {
+        float* frame = frames + i * LANES;
+        for (size_t l = 0; l < LANES; ++l) {
+            float x = frame[l];
+            float y = k.b0 * x + k.b1 * group.inX1[l] + k.a1 * group.inX2[l];
+            group.inX2[l] = group.inX1[l];
+            group.inX1[l] = x;
+            frame[l] = y * group.drive[l];
+        }
+    }
+
+    // Clipper cascade
+    for (size_t i = 0; i < numSamples; ++i) {
+        for (size_t s = 0; s < m_numClipperStages; ++s) {
+            clipFrame(frames + i * LANES);
+        }
+    }
+
+    // Tone stack (bass -> mid -> treble)
+    for (auto& band : group.tone) {
+        band.processBlock(frames, frames, numSamples);
+    }
+
+    // Scatter, then the per-instance tail of the chain
+    const MultiStagePedal::BufferCoefficients ko = m_outputCoeff;
+    for (size_t l = 0; l < group.count; ++l) {
+        const size_t instance = group.firstInstance + l;
+        float* out = outputs[instance] + offset;
+        for (size_t i = 0; i < numSamples; ++i) {
+            out[i] = frames[i * LANES + l];
+        }
+
+        m_gates[instance].processBlock(out, out, numSamples);
+        m_outputStages[instance].processBlock(out, out, numSamples);
+
+        std::array<float, 2>& state = m_outputBufferState[instance];
+        float x1 = state[0], x2 = state[1];
+        const float volume = m_volume[instance];
+        for (size_t i = 0; i < numSamples; ++i) {
+            float x = out[i];
+            out[i] = (ko.b0 * x + ko.b1 * x1 + ko.a1 * x2) * volume;
+            x2 = x1;
+            x1 = x;
+        }
+        state = {x1, x2};
+    }
+}
+
+/**
+ * Lane form of DiodeClippingStage's back-to-back block path: the region
+ * split is a per-lane select, and only the Newton-Raphson region lanes
+ * carry a real operating point into the lockstep solve (other lanes solve
+ * the trivial 0 V point and drop out after one iteration).
+ */
+void MultiPedalEngine::clipFrame(float* frame) const {
+    const float Vf = m_forwardVoltage;
+    const float linearLimit = Vf * 0.3f;
+    const float softKneeStart = Vf * 0.7f;
+    const float solveLimit = Vf * 1.5f;
+    const float hardClip = Vf * 1.05f;
+
+    Nonlinear::DiodeNewtonRaphson::SolverConfig config;
+    config.maxIterations = 20;
+    config.convergenceTolerance = 1e-6f;
+
+    LaneArray target, guess, vDiode, iDiode;
+    std::array<int, LANES> iterations;
+    bool anySolve = false;
+    for (size_t l = 0; l < LANES; ++l) {
+        float a = std::abs(frame[l]);
+        bool solve = a >= softKneeStart && a < solveLimit;
+        target[l] = solve ? a : 0.0f;
+        guess[l] = solve ? std::clamp(a, -0.5f, 1.0f) : 0.0f;
+        anySolve = anySolve || solve;
+    }
+    if (anySolve) {
+        m_solver.solveLanes(target.data(), guess.data(), static_cast<int>(LANES), config,
+                            vDiode.data(), iDiode.data(), iterations.data());
+    }
+
+    for (size_t l = 0; l < LANES; ++l) {
+        float x = frame[l];
+        float a = std::abs(x);
+        if (a < 0.0001f || a < linearLimit) continue;
+
+        float mag;
+        if (a < softKneeStart) {
+            float normalized = (a - linearLimit) / (softKneeStart - linearLimit);
+            mag = linearLimit + std::tanh(normalized * 1.5f) * (softKneeStart - linearLimit);
+        } else if (a < solveLimit) {
+            bool converged = iterations[l] > 0 && iterations[l] < config.maxIterations;
+            mag = converged ? vDiode[l] : hardClip;
+        } else {
+            mag = hardClip;
+        }
+        frame[l] = x > 0 ? mag : -mag;
+    }
+}
+
+void MultiPedalEngine::setDrive(size_t instance, float gainDb) {
+    if (instance >= m_numInstances) return;
+    groupFor(instance).drive[laneFor(instance)] = std::pow(10.0f, gainDb / 20.0f);
+}
+
+void MultiPedalEngine::setVolume(size_t instance, float levelDb) {
+    if (instance >= m_numInstances) return;
+    m_volume[instance] = std::pow(10.0f, levelDb / 20.0f);
+}
+
+void MultiPedalEngine::setToneGains(size_t instance, float bassDb, float midDb, float trebleDb) {
+    if (instance >= m_numInstances) return;
+    LaneGroup& group = groupFor(instance);
+    const size_t lane = laneFor(instance);
+    const auto& bands = m_toneTable->bands;
+    group.tone[0].setLaneCoefficients(lane, bands[ToneStackController::BASS][ToneStackController::gainIndex(bassDb)]);
+    group.tone[1].setLaneCoefficients(lane, bands[ToneStackController::MID][ToneStackController::gainIndex(midDb)]);
+    group.tone[2].setLaneCoefficients(lane, bands[ToneStackController::TREBLE][ToneStackController::gainIndex(trebleDb)]);
+}
+
+void MultiPedalEngine::setCompressor(size_t instance, float thresholdDb, float ratio) {
+    if (instance >= m_numInstances) return;
+    m_outputStages[instance].getCompressor().setThreshold(thresholdDb);
+    m_outputStages[instance].getCompressor().setRatio(ratio);
+}
+
+void MultiPedalEngine::setGateThreshold(size_t instance, float thresholdDb) {
+    if (instance >= m_numInstances) return;
+    m_gates[instance].setThreshold(thresholdDb);
+}
+
+void MultiPedalEngine::applySnapshot(size_t instance, const PresetSnapshot& snapshot) {
+    setDrive(instance, snapshot.drive);
+    setVolume(instance, snapshot.volume);
+    setToneGains(instance, snapshot.bass, snapshot.mid, snapshot.treble);
+    setCompressor(instance, snapshot.compThreshold, snapshot.compRatio);
+    setGateThreshold(instance, snapshot.gateThreshold);
+}
+
+void MultiPedalEngine::reset() {
+    for (auto& group : m_groups) {
+        group.inX1.fill(0.0f);
+        group.inX2.fill(0.0f);
+        for (auto& band : group.tone) band.reset();
+    }
+    for (auto& gate : m_gates) gate.reset();
+    for (auto& stage : m_outputStages) stage.reset();
+    std::fill(m_outputBufferState.begin(), m_outputBufferState.end(), std::array<float, 2>{0.0f, 0.0f});
+}
+
+} // namespace LiveSpiceDSP
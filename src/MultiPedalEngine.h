@@ -0,0 +1,131 @@
+#pragma once
+
+#include "MultiStagePedal.h"
+#include <vector>
+#include <memory>
+#include <array>
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file MultiPedalEngine.h
+ * @brief Many MultiStagePedal voices rendered together in SIMD lanes
+ *
+ * Instances are packed LANES to a group. Within a group the linear and
+ * static stages (input buffer, drive, back-to-back clipper cascade, tone
+ * stack) keep their state and coefficients structure-of-arrays and advance
+ * one frame for all lanes at a time; the fixed-trip-count lane loops map
+ * onto SSE/AVX/NEON registers. The dynamics stages (gate, compression,
+ * limiting) are envelope-driven and stay per instance, run through their
+ * block paths, followed by the output buffer and volume.
+ *
+ * Each instance matches a MultiStagePedal with the same parameters run
+ * through processBlock(), with all stages engaged and no oversampling.
+ * Tone and gain settings apply immediately (no smoothing): set them
+ * between render calls.
+ */
+
+class MultiPedalEngine {
+public:
+    static constexpr size_t LANES = Nonlinear::DiodeNewtonRaphson::SIMD_LANES;
+    static constexpr size_t CHUNK = 64;
+
+    /**
+     * @param numInstances Number of pedal voices
+     * @param sampleRate Sample rate (Hz), shared by all voices
+     * @param numClipperStages Clipper cascade length, shared by all voices
+     */
+    MultiPedalEngine(size_t numInstances, float sampleRate = 44100.0f, size_t numClipperStages = 1);
+
+    /**
+     * Render every instance
+     * @param inputs numInstances input buffers
+     * @param outputs numInstances output buffers (each may alias its input)
+     * @param numSamples Samples per buffer
+     */
+    void processBlock(const float* const* inputs, float* const* outputs, size_t numSamples);
+
+    /**
+     * Render one input through every instance (parameter sweeps)
+     * @param input numSamples samples, shared by all instances
+     * @param outputs numInstances output buffers (none may alias input)
+     * @param numSamples Samples per buffer
+     */
+    void processShared(const float* input, float* const* outputs, size_t numSamples);
+
+    // ========================================================================
+    // Per-Instance Parameters
+    // ========================================================================
+
+    void setDrive(size_t instance, float gainDb);
+    void setVolume(size_t instance, float levelDb);
+    void setToneGains(size_t instance, float bassDb, float midDb, float trebleDb);
+    void setCompressor(size_t instance, float thresholdDb, float ratio);
+    void setGateThreshold(size_t instance, float thresholdDb);
+
+    /**
+     * Apply a compiled preset to one instance
+     */
+    void applySnapshot(size_t instance, const PresetSnapshot& snapshot);
+
+    /**
+     * Clear all filter, clipper and dynamics state
+     */
+    void reset();
+
+    size_t getNumInstances() const { return m_numInstances; }
+    size_t getNumGroups() const { return m_groups.size(); }
+    float getSampleRate() const { return m_sampleRate; }
+
+private:
+    using LaneArray = std::array<float, LANES>;
+
+    /**
+     * LANES instances in structure-of-arrays form
+     */
+    struct LaneGroup {
+        size_t firstInstance = 0;
+        size_t count = 0;
+        LaneArray inX1{}, inX2{};    // Input buffer history
+        LaneArray drive{};           // Linear input gain
+        std::array<BiquadLaneBank<LANES>, 3> tone;  // Bass, mid, treble
+    };
+
+    float m_sampleRate;
+    size_t m_numInstances;
+    size_t m_numClipperStages;
+
+    std::vector<LaneGroup> m_groups;
+
+    // Per-instance dynamics, output buffer and volume (planar)
+    std::vector<NoiseGate> m_gates;
+    std::vector<OutputStage> m_outputStages;
+    std::vector<std::array<float, 2>> m_outputBufferState;
+    std::vector<float> m_volume;
+
+    // Shared device parameters
+    MultiStagePedal::BufferCoefficients m_inputCoeff;
+    MultiStagePedal::BufferCoefficients m_outputCoeff;
+    Nonlinear::DiodeNewtonRaphson m_solver;
+    float m_forwardVoltage;
+    std::shared_ptr<const ToneStackController::CoefficientTable> m_toneTable;
+
+    // Interleaved frame scratch: frame i, lane l at [i * LANES + l]
+    std::vector<float> m_frames;
+
+    // processShared(): the one input, repeated for every instance
+    std::vector<const float*> m_sharedInputs;
+
+    LaneGroup& groupFor(size_t instance) { return m_groups[instance / LANES]; }
+    static size_t laneFor(size_t instance) { return instance % LANES; }
+
+    /**
+     * Back-to-back clipper over one frame, all lanes in lockstep
+     */
+    void clipFrame(float* frame) const;
+
+    void processGroup(LaneGroup& group, const float* const* inputs, float* const* outputs,
+                      size_t offset, size_t numSamples);
+};
+
+} // namespace LiveSpiceDSP
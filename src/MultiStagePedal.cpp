@@ -1,4 +1,6 @@
 #include "MultiStagePedal.h"
+#include "TableRebuildWorker.h"
+#include "Denormals.h"
 #include <cmath>
 #include <algorithm>
 
@@ -8,117 +10,478 @@ namespace LiveSpiceDSP {
 // MultiStagePedal Implementation
 // ============================================================================
 
-MultiStagePedal::MultiStagePedal(float sampleRate, size_t numClipperStages)
+MultiStagePedal::MultiStagePedal(float sampleRate, size_t numClipperStages, MemoryMode memoryMode)
     : m_sampleRate(sampleRate),
-      m_inputGainLinear(1.0f),
-      m_outputGainLinear(1.0f),
-      m_inputLevelDb(-80.0f),
-      m_clipperGainReductionDb(0.0f),
-      m_outputLevelDb(-80.0f),
+      m_memoryMode(memoryMode),
+      m_inputBufferCoeff(inputBufferCoefficients(sampleRate)),
+      m_outputBufferCoeff(outputBufferCoefficients(sampleRate)),
       m_toneStack(sampleRate),
       m_noiseGate(sampleRate),
-      m_outputStage(sampleRate),
+      m_outputStage(sampleRate, memoryMode),
       m_inputBufferState{0.0f, 0.0f},
       m_outputBufferState{0.0f, 0.0f} {
     
+    m_rampSamples = std::max(1, static_cast<int>(sampleRate * BYPASS_RAMP_MS * 0.001f + 0.5f));
+    m_sleepHoldSamples = std::max(1, static_cast<int>(sampleRate * SLEEP_HOLD_MS * 0.001f + 0.5f));
+    
     // Create clipper stages
+    m_clipperStages.reserve(numClipperStages);
     for (size_t i = 0; i < numClipperStages; ++i) {
-        m_clipperStages.push_back(
-            std::make_shared<Nonlinear::DiodeClippingStage>(Nonlinear::DiodeCharacteristics(), Nonlinear::DiodeClippingStage::TopologyType::BackToBackDiodes, 10000.0f)
-        );
+        m_clipperStages.emplace_back(Nonlinear::DiodeCharacteristics::Si1N4148(), Nonlinear::DiodeClippingStage::TopologyType::BackToBackDiodes, 10000.0f, memoryMode);
     }
 }
 
+MultiStagePedal::~MultiStagePedal() {
+    TableRebuildWorker::shared().cancel(this);
+}
+
 float MultiStagePedal::process(float input) {
+    applyQueuedPreset();
+    syncBypass();
+    
     float signal = input;
     
     // Measure input level
-    m_inputLevelDb = calculateLevelDb(signal);
-    
-    // Stage 1: Input buffer (if enabled)
-    if (!m_bypass.inputBuffer) {
-        signal = processInputBuffer(signal);
+    m_meter.addInput(signal);
+    
+    if (sleepGate(std::abs(input))) {
+        m_meter.addOutput(0.0f);
+        if (++m_meter.count >= METER_PERIOD) {
+            publishMeters();
+        }
+        return 0.0f;
     }
     
+    // Stage 1: Input buffer
+    signal = runStage(SLOT_INPUT, signal, [this](float x) { return processInputBuffer(x); });
+    
     // Stage 2: Input gain (drive)
-    signal *= m_inputGainLinear;
+    signal *= m_inputGain.next();
+    
+    // Stage 3: Diode clippers
+    signal = runStage(SLOT_CLIPPER, signal, [this](float x) { return processClippers(x); });
     
-    // Stage 3: Diode clippers (if enabled)
-    if (!m_bypass.diodeClipper) {
-        signal = processClippers(signal);
+    // Stage 4: Tone stack
+    signal = runStage(SLOT_TONE, signal, [this](float x) { return m_toneStack.process(x); });
+    
+    // Stage 5: Noise gate
+    signal = runStage(SLOT_GATE, signal, [this](float x) { return m_noiseGate.process(x); });
+    
+    // Stage 6: Output compression & limiting
+    signal = runStage(SLOT_DYNAMICS, signal, [this](float x) { return m_outputStage.process(x); });
+    
+    // Stage 7: Output buffer
+    signal = runStage(SLOT_OUTPUT, signal, [this](float x) { return processOutputBuffer(x); });
+    
+    // Stage 8: Output gain (volume)
+    signal *= m_outputGain.next();
+    
+    // Measure final output level
+    m_meter.addOutput(signal);
+    trackSilence(std::abs(input), std::abs(signal), 1);
+    if (++m_meter.count >= METER_PERIOD) {
+        publishMeters();
     }
     
-    // Stage 4: Tone stack (if enabled)
-    if (!m_bypass.toneStack) {
-        signal = m_toneStack.process(signal);
+    return signal;
+}
+
+void MultiStagePedal::processBlock(const float* input, float* output, size_t numSamples) {
+    ScopedFlushDenormals noDenormals;
+    for (size_t offset = 0; offset < numSamples; offset += m_subBlockSize) {
+        size_t n = std::min(m_subBlockSize, numSamples - offset);
+        if (input != output) {
+            std::copy(input + offset, input + offset + n, output + offset);
+        }
+        processChunk(output + offset, n);
+    }
+}
+
+void MultiStagePedal::processBlock(const float* input, float* output, size_t numSamples,
+                                   const ParameterEvent* events, size_t numEvents) {
+    ScopedFlushDenormals noDenormals;
+    forEachSubBlock(numSamples, events, numEvents, m_subBlockSize,
+        [this](const ParameterEvent& event) {
+            if (event.parameter < static_cast<uint32_t>(PedalParameter::Count)) {
+                setParameter(static_cast<PedalParameter>(event.parameter), event.value);
+            }
+        },
+        [&](size_t offset, size_t n) {
+            if (input != output) {
+                std::copy(input + offset, input + offset + n, output + offset);
+            }
+            processChunk(output + offset, n);
+        });
+}
+
+void MultiStagePedal::processChunk(float* data, size_t numSamples) {
+    LIVESPICE_TRACE_ZONE("MultiStagePedal");
+    // Resolve presets and bypass once per chunk
+    applyQueuedPreset();
+    syncBypass();
+    
+    // A table rebuild parked on an unadopted table can try again
+    if (m_tablesParked.load(std::memory_order_relaxed)) TableRebuildWorker::shared().resume();
+    
+    float inputPeak = 0.0f;
+    for (size_t i = 0; i < numSamples; ++i) {
+        m_meter.addInput(data[i]);
+        inputPeak = std::max(inputPeak, std::abs(data[i]));
     }
     
-    // Stage 5: Noise gate (if enabled)
-    if (!m_bypass.noiseGate) {
-        signal = m_noiseGate.process(signal);
+    if (sleepGate(inputPeak)) {
+        std::fill(data, data + numSamples, 0.0f);
+        m_meter.count += static_cast<int>(numSamples);
+        publishMeters();
+        return;
     }
     
-    // Stage 6: Output compression & limiting (if enabled)
-    if (!m_bypass.compressor || !m_bypass.limiter) {
-        signal = m_outputStage.process(signal);
+    // Stage 1: Input buffer
+    runStageBlock(SLOT_INPUT, data, numSamples, [this](float* d, size_t n) {
+        const BufferCoefficients& k = m_inputBufferCoeff;
+        float x1 = m_inputBufferState[0], x2 = m_inputBufferState[1];
+        for (size_t i = 0; i < n; ++i) {
+            float x = d[i];
+            d[i] = k.b0 * x + k.b1 * x1 + k.a1 * x2;
+            x2 = x1;
+            x1 = x;
+        }
+        m_inputBufferState = {x1, x2};
+    });
+    
+    // Stage 2: Input gain (drive)
+    m_inputGain.applyBlock(data, numSamples);
+    
+    // Stage 3: Diode clippers
+    runStageBlock(SLOT_CLIPPER, data, numSamples, [this](float* d, size_t n) {
+        float inputPeak = 0.0f;
+        for (size_t i = 0; i < n; ++i) inputPeak = std::max(inputPeak, std::abs(d[i]));
+        if (m_adaptiveOversampler) {
+            m_adaptiveOversampler->processBlock(d, n, [this](float* os, size_t m) { runClipperCascadeBlock(os, m); });
+            LIVESPICE_TRACE_COUNTER("Oversampling factor", m_adaptiveOversampler->getFactor());
+        } else if (m_oversampler) {
+            m_oversampler->processBlock(d, n, [this](float* os, size_t m) { runClipperCascadeBlock(os, m); });
+        } else {
+            runClipperCascadeBlock(d, n);
+        }
+        
+        float outputPeak = 0.0f;
+        for (size_t i = 0; i < n; ++i) outputPeak = std::max(outputPeak, std::abs(d[i]));
+        m_meter.clipperInputPeak = std::max(m_meter.clipperInputPeak, inputPeak);
+        m_meter.clipperOutputPeak = std::max(m_meter.clipperOutputPeak, outputPeak);
+    });
+    
+    // Stage 4: Tone stack
+    runStageBlock(SLOT_TONE, data, numSamples, [this](float* d, size_t n) { m_toneStack.processBlock(d, d, n); });
+    
+    // Stage 5: Noise gate
+    runStageBlock(SLOT_GATE, data, numSamples, [this](float* d, size_t n) { m_noiseGate.processBlock(d, d, n); });
+    
+    // Stage 6: Output compression & limiting
+    runStageBlock(SLOT_DYNAMICS, data, numSamples, [this](float* d, size_t n) { m_outputStage.processBlock(d, d, n); });
+    
+    // Stage 7: Output buffer
+    runStageBlock(SLOT_OUTPUT, data, numSamples, [this](float* d, size_t n) {
+        const BufferCoefficients& k = m_outputBufferCoeff;
+        float x1 = m_outputBufferState[0], x2 = m_outputBufferState[1];
+        for (size_t i = 0; i < n; ++i) {
+            float x = d[i];
+            d[i] = k.b0 * x + k.b1 * x1 + k.a1 * x2;
+            x2 = x1;
+            x1 = x;
+        }
+        m_outputBufferState = {x1, x2};
+    });
+    
+    // Stage 8: Output gain (volume)
+    m_outputGain.applyBlock(data, numSamples);
+    
+    float outputPeak = 0.0f;
+    for (size_t i = 0; i < numSamples; ++i) {
+        m_meter.addOutput(data[i]);
+        outputPeak = std::max(outputPeak, std::abs(data[i]));
+    }
+    trackSilence(inputPeak, outputPeak, numSamples);
+    m_meter.count += static_cast<int>(numSamples);
+    publishMeters();
+}
+
+bool MultiStagePedal::sleepGate(float inputPeak) {
+    if (!m_sleeping) return false;
+    
+    if (inputPeak < m_sleepThreshold.load(std::memory_order_relaxed) && m_sleepEnabled.load(std::memory_order_relaxed)) {
+        // Nothing is audible: land ramps started while asleep at their targets
+        for (auto& ramp : m_ramps) {
+            ramp.mix = ramp.target;
+            ramp.remaining = 0;
+        }
+        m_inputGain.set(m_inputGain.target);
+        m_outputGain.set(m_outputGain.target);
+        return true;
     }
     
-    // Stage 7: Output buffer (if enabled)
-    if (!m_bypass.outputBuffer) {
-        signal = processOutputBuffer(signal);
+    m_sleeping = false;
+    m_silentSamples = 0;
+    m_published.sleeping.store(false, std::memory_order_relaxed);
+    return false;
+}
+
+void MultiStagePedal::trackSilence(float inputPeak, float outputPeak, size_t numSamples) {
+    const float threshold = m_sleepThreshold.load(std::memory_order_relaxed);
+    bool settled = m_inputGain.remaining == 0 && m_outputGain.remaining == 0 &&
+                   std::abs(m_outputStage.getCompressor().getGainReductionDb()) < 0.1f;
+    for (const auto& ramp : m_ramps) settled = settled && !ramp.isRamping();
+    
+    if (inputPeak >= threshold || outputPeak >= threshold || !settled || !m_sleepEnabled.load(std::memory_order_relaxed)) {
+        m_silentSamples = 0;
+        return;
     }
     
-    // Stage 8: Output gain (volume)
-    signal *= m_outputGainLinear;
+    m_silentSamples += static_cast<int>(numSamples);
+    if (m_silentSamples < m_sleepHoldSamples) return;
     
-    // Measure final output level
-    m_outputLevelDb = calculateLevelDb(signal);
+    // Tails are below the threshold; restart every stage from rest on wake
+    for (int slot = 0; slot < NUM_SLOTS; ++slot) resetSlot(static_cast<RampSlot>(slot));
+    m_sleeping = true;
+    m_published.sleeping.store(true, std::memory_order_relaxed);
+}
+
+void MultiStagePedal::publishMeters() {
+    if (m_meter.count == 0) return;
+    
+    const float invCount = 1.0f / static_cast<float>(m_meter.count);
+    m_published.inputPeak.store(m_meter.inputPeak, std::memory_order_relaxed);
+    m_published.inputMeanSquare.store(m_meter.inputSumSquares * invCount, std::memory_order_relaxed);
+    m_published.outputPeak.store(m_meter.outputPeak, std::memory_order_relaxed);
+    m_published.outputMeanSquare.store(m_meter.outputSumSquares * invCount, std::memory_order_relaxed);
+    
+    // Only meaningful while the cascade runs on a non-trivial signal
+    if (m_meter.clipperInputPeak > 0.01f && m_meter.clipperOutputPeak > 1e-8f) {
+        m_published.clipperRatio.store(m_meter.clipperOutputPeak / m_meter.clipperInputPeak, std::memory_order_relaxed);
+    } else {
+        m_published.clipperRatio.store(1.0f, std::memory_order_relaxed);
+    }
+    m_published.compressorGainReductionDb.store(m_outputStage.getCompressor().getGainReductionDb(),
+                                                std::memory_order_relaxed);
     
-    return signal;
+    m_meter = MeterAccumulator();
+}
+
+void MultiStagePedal::syncBypass() {
+    uint32_t mask = m_bypassMask.load(std::memory_order_relaxed);
+    if (m_running && mask == m_appliedMask) return;
+    
+    const uint32_t dynamicsBits = stageBit(PedalStage::Compressor) | stageBit(PedalStage::Limiter);
+    const std::array<bool, NUM_SLOTS> bypassed = {
+        (mask & stageBit(PedalStage::InputBuffer)) != 0,
+        (mask & stageBit(PedalStage::DiodeClipper)) != 0,
+        (mask & stageBit(PedalStage::ToneStack)) != 0,
+        (mask & stageBit(PedalStage::NoiseGate)) != 0,
+        (mask & dynamicsBits) == dynamicsBits,
+        (mask & stageBit(PedalStage::OutputBuffer)) != 0,
+    };
+    
+    for (int slot = 0; slot < NUM_SLOTS; ++slot) {
+        BypassRamp& ramp = m_ramps[slot];
+        float target = bypassed[slot] ? 0.0f : 1.0f;
+        if (!m_running) {
+            ramp = BypassRamp{target, target, 0.0f, 0};
+        } else if (target != ramp.target) {
+            if (ramp.isBypassed()) resetSlot(static_cast<RampSlot>(slot));
+            ramp.target = target;
+            ramp.remaining = m_rampSamples;
+            ramp.step = (target - ramp.mix) / static_cast<float>(m_rampSamples);
+        }
+    }
+    
+    m_appliedMask = mask;
+    m_running = true;
+}
+
+void MultiStagePedal::applyQueuedPreset() {
+    PresetSnapshot snapshot;
+    if (!m_presetQueue.popLatest(snapshot)) return;
+    
+    float drive = std::pow(10.0f, snapshot.drive / 20.0f);
+    float volume = std::pow(10.0f, snapshot.volume / 20.0f);
+    if (m_running) {
+        m_inputGain.rampTo(drive, m_rampSamples);
+        m_outputGain.rampTo(volume, m_rampSamples);
+    } else {
+        m_inputGain.set(drive);
+        m_outputGain.set(volume);
+    }
+    
+    // Table lookups; coefficient ramps once running
+    m_toneStack.setBassGain(snapshot.bass);
+    m_toneStack.setMidGain(snapshot.mid);
+    m_toneStack.setTrebleGain(snapshot.treble);
+    m_toneStack.setPresenceGain(snapshot.presence);
+    
+    m_outputStage.getCompressor().setThreshold(snapshot.compThreshold);
+    m_outputStage.getCompressor().setRatio(snapshot.compRatio);
+    m_noiseGate.setThreshold(snapshot.gateThreshold);
+}
+
+void MultiStagePedal::resetSlot(RampSlot slot) {
+    switch (slot) {
+        case SLOT_INPUT:
+            m_inputBufferState = {0.0f, 0.0f};
+            break;
+        case SLOT_CLIPPER:
+            for (auto& clipper : m_clipperStages) clipper.reset();
+            if (m_oversampler) m_oversampler->reset();
+            if (m_adaptiveOversampler) m_adaptiveOversampler->reset();
+            break;
+        case SLOT_TONE:
+            m_toneStack.reset();
+            break;
+        case SLOT_GATE:
+            m_noiseGate.reset();
+            break;
+        case SLOT_DYNAMICS:
+            m_outputStage.reset();
+            break;
+        case SLOT_OUTPUT:
+            m_outputBufferState = {0.0f, 0.0f};
+            break;
+        default:
+            break;
+    }
 }
 
 void MultiStagePedal::setDrive(float gainDb) {
-    m_inputGainLinear = std::pow(10.0f, gainDb / 20.0f);
+    m_inputGain.set(std::pow(10.0f, gainDb / 20.0f));
 }
 
 void MultiStagePedal::setClipperImpedance(float impedanceOhms) {
+    bool needsTables = false;
     for (auto& clipper : m_clipperStages) {
-        clipper->setLoadImpedance(impedanceOhms);
+        clipper.requestLoadImpedance(impedanceOhms);
+        needsTables = needsTables || clipper.needsTableRebuild();
     }
+    if (!needsTables) return;
+    
+    // Parked and retried after the next block until every clipper has taken
+    // the table for the newest load
+    TableRebuildWorker::shared().schedule(this, [this] {
+        bool done = true;
+        for (auto& clipper : m_clipperStages) {
+            if (clipper.needsTableRebuild() && !clipper.rebuildTables()) done = false;
+        }
+        for (const auto& clipper : m_clipperStages) {
+            if (clipper.needsTableRebuild()) done = false;
+        }
+        m_tablesParked.store(!done, std::memory_order_relaxed);
+        return done;
+    });
+}
+
+MemoryFootprint MultiStagePedal::getMemoryFootprint() const {
+    MemoryFootprint footprint{sizeof(MultiStagePedal)};
+    footprint.addVector(m_clipperStages);
+    for (const auto& clipper : m_clipperStages) footprint.addMember(clipper.getMemoryFootprint());
+    if (m_oversampler) footprint.addOwned(m_oversampler->getMemoryFootprint());
+    if (m_adaptiveOversampler) footprint.addOwned(m_adaptiveOversampler->getMemoryFootprint());
+    footprint.addMember(m_toneStack.getMemoryFootprint());
+    footprint.addMember(m_outputStage.getMemoryFootprint());
+    return footprint;
+}
+
+void MultiStagePedal::setClipperAntiAliasing(Nonlinear::DiodeClippingStage::AntiAliasingMode mode) {
+    TableRebuildWorker::shared().cancel(this);
+    m_tablesParked.store(false, std::memory_order_relaxed);
+    for (auto& clipper : m_clipperStages) {
+        clipper.setAntiAliasingMode(mode);
+    }
+}
+
+void MultiStagePedal::setOversampling(int factor, Oversampler::FilterType type) {
+    m_adaptiveOversampler.reset();
+    if (factor <= 1) {
+        m_oversampler.reset();
+        return;
+    }
+    m_oversampler = std::make_unique<Oversampler>(factor, type);
+}
+
+void MultiStagePedal::setAdaptiveOversampling(int maxFactor, Oversampler::FilterType type, float kneeLevel) {
+    m_oversampler.reset();
+    if (maxFactor <= 1) {
+        m_adaptiveOversampler.reset();
+        return;
+    }
+    m_adaptiveOversampler = std::make_unique<AdaptiveOversampler>(maxFactor, type);
+    m_adaptiveOversampler->setKneeLevel(kneeLevel);
 }
 
 void MultiStagePedal::setVolume(float levelDb) {
-    m_outputGainLinear = std::pow(10.0f, levelDb / 20.0f);
+    m_outputGain.set(std::pow(10.0f, levelDb / 20.0f));
+}
+
+void MultiStagePedal::setParameter(PedalParameter parameter, float value) {
+    switch (parameter) {
+        case PedalParameter::Drive:
+            setDrive(value);
+            break;
+        case PedalParameter::Volume:
+            setVolume(value);
+            break;
+        case PedalParameter::Bass:
+            m_toneStack.setBassGain(value);
+            break;
+        case PedalParameter::Mid:
+            m_toneStack.setMidGain(value);
+            break;
+        case PedalParameter::Treble:
+            m_toneStack.setTrebleGain(value);
+            break;
+        case PedalParameter::Presence:
+            m_toneStack.setPresenceGain(value);
+            break;
+        case PedalParameter::CompThreshold:
+            m_outputStage.getCompressor().setThreshold(value);
+            break;
+        case PedalParameter::CompRatio:
+            m_outputStage.getCompressor().setRatio(value);
+            break;
+        case PedalParameter::GateThreshold:
+            m_noiseGate.setThreshold(value);
+            break;
+        default:
+            break;
+    }
 }
 
 void MultiStagePedal::setBypass(const std::string& stageName, bool bypassed) {
-    if (stageName == "input") m_bypass.inputBuffer = bypassed;
-    else if (stageName == "clipper") m_bypass.diodeClipper = bypassed;
-    else if (stageName == "tone") m_bypass.toneStack = bypassed;
-    else if (stageName == "comp") m_bypass.compressor = bypassed;
-    else if (stageName == "limiter") m_bypass.limiter = bypassed;
-    else if (stageName == "gate") m_bypass.noiseGate = bypassed;
-    else if (stageName == "output") m_bypass.outputBuffer = bypassed;
+    if (stageName == "input") setStageBypassed(PedalStage::InputBuffer, bypassed);
+    else if (stageName == "clipper") setStageBypassed(PedalStage::DiodeClipper, bypassed);
+    else if (stageName == "tone") setStageBypassed(PedalStage::ToneStack, bypassed);
+    else if (stageName == "comp") setStageBypassed(PedalStage::Compressor, bypassed);
+    else if (stageName == "limiter") setStageBypassed(PedalStage::Limiter, bypassed);
+    else if (stageName == "gate") setStageBypassed(PedalStage::NoiseGate, bypassed);
+    else if (stageName == "output") setStageBypassed(PedalStage::OutputBuffer, bypassed);
+}
+
+StageBypass MultiStagePedal::getBypass() const {
+    uint32_t mask = getBypassMask();
+    StageBypass bypass;
+    bypass.inputBuffer = (mask & stageBit(PedalStage::InputBuffer)) != 0;
+    bypass.diodeClipper = (mask & stageBit(PedalStage::DiodeClipper)) != 0;
+    bypass.toneStack = (mask & stageBit(PedalStage::ToneStack)) != 0;
+    bypass.compressor = (mask & stageBit(PedalStage::Compressor)) != 0;
+    bypass.limiter = (mask & stageBit(PedalStage::Limiter)) != 0;
+    bypass.noiseGate = (mask & stageBit(PedalStage::NoiseGate)) != 0;
+    bypass.outputBuffer = (mask & stageBit(PedalStage::OutputBuffer)) != 0;
+    return bypass;
 }
 
 void MultiStagePedal::bypassAll() {
-    m_bypass.inputBuffer = true;
-    m_bypass.diodeClipper = true;
-    m_bypass.toneStack = true;
-    m_bypass.compressor = true;
-    m_bypass.limiter = true;
-    m_bypass.noiseGate = true;
-    m_bypass.outputBuffer = true;
+    setBypassMask(ALL_STAGES_MASK);
 }
 
 void MultiStagePedal::enableAll() {
-    m_bypass.inputBuffer = false;
-    m_bypass.diodeClipper = false;
-    m_bypass.toneStack = false;
-    m_bypass.compressor = false;
-    m_bypass.limiter = false;
-    m_bypass.noiseGate = false;
-    m_bypass.outputBuffer = false;
+    setBypassMask(0);
 }
 
 void MultiStagePedal::reset() {
@@ -126,19 +489,40 @@ void MultiStagePedal::reset() {
     m_noiseGate.reset();
     m_outputStage.reset();
     
-    // Note: DiodeClippingStage doesn't have reset(); it doesn't maintain state
+    if (m_oversampler) {
+        m_oversampler->reset();
+    }
+    if (m_adaptiveOversampler) {
+        m_adaptiveOversampler->reset();
+    }
+    
+    for (auto& clipper : m_clipperStages) {
+        clipper.reset();
+    }
     
     m_inputBufferState = {0.0f, 0.0f};
     m_outputBufferState = {0.0f, 0.0f};
     
-    m_inputLevelDb = -80.0f;
-    m_clipperGainReductionDb = 0.0f;
-    m_outputLevelDb = -80.0f;
+    m_meter = MeterAccumulator();
+    m_published.inputPeak.store(0.0f, std::memory_order_relaxed);
+    m_published.inputMeanSquare.store(0.0f, std::memory_order_relaxed);
+    m_published.outputPeak.store(0.0f, std::memory_order_relaxed);
+    m_published.outputMeanSquare.store(0.0f, std::memory_order_relaxed);
+    m_published.clipperRatio.store(1.0f, std::memory_order_relaxed);
+    m_published.compressorGainReductionDb.store(0.0f, std::memory_order_relaxed);
+    m_published.sleeping.store(false, std::memory_order_relaxed);
+    m_silentSamples = 0;
+    m_sleeping = false;
+    
+    // Finish pending gain ramps; next bypass state applies without a ramp
+    m_inputGain.set(m_inputGain.target);
+    m_outputGain.set(m_outputGain.target);
+    m_running = false;
 }
 
-float MultiStagePedal::processInputBuffer(float input) {
+MultiStagePedal::BufferCoefficients MultiStagePedal::inputBufferCoefficients(float sampleRate) {
     // 1st-order high-pass filter at ~30Hz
-    float omega = 2.0f * 3.14159265359f * 30.0f / m_sampleRate;
+    float omega = 2.0f * 3.14159265359f * 30.0f / sampleRate;
     float alpha = std::sin(omega) / 2.0f;
     
     float b0 = (1.0f + std::cos(omega)) / 2.0f;
@@ -149,43 +533,65 @@ float MultiStagePedal::processInputBuffer(float input) {
     b1 /= (1.0f + alpha);
     a1 /= (1.0f + alpha);
     
-    float output = b0 * input + b1 * m_inputBufferState[0] + a1 * m_inputBufferState[1];
+    return {b0, b1, a1};
+}
+
+float MultiStagePedal::processInputBuffer(float input) {
+    const BufferCoefficients& k = m_inputBufferCoeff;
+    
+    float output = k.b0 * input + k.b1 * m_inputBufferState[0] + k.a1 * m_inputBufferState[1];
     m_inputBufferState[1] = m_inputBufferState[0];
     m_inputBufferState[0] = input;
     
     return output;
 }
 
-float MultiStagePedal::processClippers(float input) {
+float MultiStagePedal::runClipperCascade(float input) {
     float signal = input;
     
     // Cascade all clipper stages
     for (auto& clipper : m_clipperStages) {
-        signal = clipper->processSample(signal);
+        signal = clipper.processSample(signal);
     }
     
-    // Measure approximate gain reduction from clipping
-    float inputAbs = std::abs(input);
-    float outputAbs = std::abs(signal);
-    if (inputAbs > 0.01f && outputAbs > 1e-8f) {
-        m_clipperGainReductionDb = 20.0f * std::log10(outputAbs / inputAbs);
-    } else {
-        m_clipperGainReductionDb = 0.0f;  // No clipping detected
+    return signal;
+}
+
+void MultiStagePedal::runClipperCascadeBlock(float* data, size_t numSamples) {
+    for (auto& clipper : m_clipperStages) {
+        clipper.processBlock(data, numSamples);
     }
+}
+
+float MultiStagePedal::processClippers(float input) {
+    auto cascade = [this](float x) { return runClipperCascade(x); };
+    float signal = m_adaptiveOversampler ? m_adaptiveOversampler->processSample(input, cascade)
+                 : m_oversampler ? m_oversampler->processSample(input, cascade)
+                 : runClipperCascade(input);
+    
+    // Track cascade peaks for the gain reduction meter
+    m_meter.clipperInputPeak = std::max(m_meter.clipperInputPeak, std::abs(input));
+    m_meter.clipperOutputPeak = std::max(m_meter.clipperOutputPeak, std::abs(signal));
     
     return signal;
 }
 
-float MultiStagePedal::processOutputBuffer(float input) {
+MultiStagePedal::BufferCoefficients MultiStagePedal::outputBufferCoefficients(float sampleRate) {
     // 1st-order low-pass filter at ~10kHz
-    float omega = 2.0f * 3.14159265359f * 10000.0f / m_sampleRate;
+    float omega = 2.0f * 3.14159265359f * 10000.0f / sampleRate;
     float alpha = std::sin(omega) / 2.0f;
     
     float b0 = alpha;
     float b1 = alpha;
     float a1 = -(1.0f - 2.0f * alpha);
     
-    float output = b0 * input + b1 * m_outputBufferState[0] + a1 * m_outputBufferState[1];
+    return {b0, b1, a1};
+}
+
+float MultiStagePedal::processOutputBuffer(float input) {
+    const BufferCoefficients& k = m_outputBufferCoeff;
+    
+    float output = k.b0 * input + k.b1 * m_outputBufferState[0] + k.a1 * m_outputBufferState[1];
     m_outputBufferState[1] = m_outputBufferState[0];
     m_outputBufferState[0] = input;
     
@@ -202,7 +608,9 @@ float MultiStagePedal::calculateLevelDb(float sample) {
 // PresetManager Implementation
 // ============================================================================
 
-std::vector<PedalPreset> PresetManager::getDefaultPresets() {
+namespace {
+
+std::vector<PedalPreset> buildDefaultPresets() {
     std::vector<PedalPreset> presets;
     
     // Preset 1: Clean Boost
@@ -270,17 +678,51 @@ std::vector<PedalPreset> PresetManager::getDefaultPresets() {
     return presets;
 }
 
+} // namespace
+
+const std::vector<PedalPreset>& PresetManager::getDefaultPresets() {
+    static const std::vector<PedalPreset> presets = buildDefaultPresets();
+    return presets;
+}
+
+const std::vector<PresetSnapshot>& PresetManager::getDefaultSnapshots() {
+    static const std::vector<PresetSnapshot> snapshots = [] {
+        std::vector<PresetSnapshot> compiled;
+        for (const auto& preset : getDefaultPresets()) compiled.push_back(compile(preset));
+        return compiled;
+    }();
+    return snapshots;
+}
+
+PresetSnapshot PresetManager::compile(const PedalPreset& preset) {
+    PresetSnapshot snapshot;
+    snapshot.drive = preset.drive;
+    snapshot.volume = preset.volume;
+    snapshot.bass = preset.bass;
+    snapshot.mid = preset.mid;
+    snapshot.treble = preset.treble;
+    snapshot.presence = preset.presence;
+    snapshot.compThreshold = preset.compThreshold;
+    snapshot.compRatio = preset.compRatio;
+    snapshot.gateThreshold = preset.gateThreshold;
+    return snapshot;
+}
+
 void PresetManager::applyPreset(MultiStagePedal& pedal, const PedalPreset& preset) {
-    pedal.setDrive(preset.drive);
-    pedal.setVolume(preset.volume);
-    pedal.getToneStack().setBassGain(preset.bass);
-    pedal.getToneStack().setMidGain(preset.mid);
-    pedal.getToneStack().setTrebleGain(preset.treble);
-    pedal.getToneStack().setPresenceGain(preset.presence);
-    
-    pedal.getCompressor().setThreshold(preset.compThreshold);
-    pedal.getCompressor().setRatio(preset.compRatio);
-    pedal.getNoiseGate().setThreshold(preset.gateThreshold);
+    applySnapshot(pedal, compile(preset));
+}
+
+void PresetManager::applySnapshot(MultiStagePedal& pedal, const PresetSnapshot& snapshot) {
+    pedal.setDrive(snapshot.drive);
+    pedal.setVolume(snapshot.volume);
+    pedal.getToneStack().setBassGain(snapshot.bass);
+    pedal.getToneStack().setMidGain(snapshot.mid);
+    pedal.getToneStack().setTrebleGain(snapshot.treble);
+    pedal.getToneStack().setPresenceGain(snapshot.presence);
+    
+    pedal.getCompressor().setThreshold(snapshot.compThreshold);
+    pedal.getCompressor().setRatio(snapshot.compRatio);
+    pedal.getNoiseGate().setThreshold(snapshot.gateThreshold);
 }
 
 } // namespace LiveSpiceDSP
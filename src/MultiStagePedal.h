@@ -3,9 +3,19 @@
 #include "DiodeModels.h"
 #include "StateSpaceFilter.h"
 #include "CompressorDynamics.h"
+#include "Oversampling.h"
+#include "LockFreeQueue.h"
+#include "MemoryFootprint.h"
+#include "SubBlockScheduler.h"
+#include "TraceZones.h"
 #include <vector>
 #include <memory>
 #include <string>
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
 
 namespace LiveSpiceDSP {
 
@@ -26,6 +36,31 @@ namespace LiveSpiceDSP {
 // Stage Bypass & Configuration
 // ============================================================================
 
+/**
+ * Bypassable stages, as bit positions in the pedal's bypass mask
+ * The compressor and limiter share the output stage, which runs unless
+ * both are bypassed.
+ */
+enum class PedalStage : uint32_t {
+    InputBuffer,
+    DiodeClipper,
+    ToneStack,
+    Compressor,
+    Limiter,
+    NoiseGate,
+    OutputBuffer,
+    Count
+};
+
+constexpr uint32_t stageBit(PedalStage stage) {
+    return 1u << static_cast<uint32_t>(stage);
+}
+
+constexpr uint32_t ALL_STAGES_MASK = (1u << static_cast<uint32_t>(PedalStage::Count)) - 1u;
+
+/**
+ * Bypass flags by name (snapshot of the bypass mask)
+ */
 struct StageBypass {
     bool inputBuffer = false;
     bool diodeClipper = false;
@@ -36,6 +71,39 @@ struct StageBypass {
     bool outputBuffer = false;
 };
 
+/**
+ * Flat, trivially copyable preset parameters (see PresetManager::compile)
+ * Small enough to pass through the pedal's lock-free preset queue.
+ */
+struct PresetSnapshot {
+    float drive = 6.0f;
+    float volume = 0.0f;
+    float bass = 0.0f;
+    float mid = 0.0f;
+    float treble = 0.0f;
+    float presence = 0.0f;
+    float compThreshold = -20.0f;
+    float compRatio = 4.0f;
+    float gateThreshold = -60.0f;
+};
+
+/**
+ * Automatable pedal parameters (ParameterEvent::parameter), in the units
+ * of the PresetSnapshot field of the same name
+ */
+enum class PedalParameter : uint32_t {
+    Drive,            // dB
+    Volume,           // dB
+    Bass,             // dB
+    Mid,              // dB
+    Treble,           // dB
+    Presence,         // dB
+    CompThreshold,    // dB
+    CompRatio,
+    GateThreshold,    // dB
+    Count
+};
+
 // ============================================================================
 // Multi-Stage Pedal
 // ============================================================================
@@ -46,8 +114,12 @@ public:
      * Initialize complete pedal system
      * @param sampleRate Sample rate (Hz)
      * @param numClipperStages Number of diode clipper stages (1-3 typical)
+     * @param memoryMode Storage policy of the stages (see MemoryMode); Compact
+     *        suits sessions with many instances
      */
-    MultiStagePedal(float sampleRate = 44100.0f, size_t numClipperStages = 1);
+    MultiStagePedal(float sampleRate = 44100.0f, size_t numClipperStages = 1,
+                    MemoryMode memoryMode = MemoryMode::Standard);
+    ~MultiStagePedal();
     
     /**
      * Process audio sample through entire pedal chain
@@ -56,6 +128,42 @@ public:
      */
     float process(float input);
     
+    /**
+     * Process a buffer through the chain, one stage over the whole buffer
+     * at a time. Bypass flags and queued presets are picked up once per
+     * sub-block (getSubBlockSize() samples), filter coefficients
+     * are hoisted out of the loops, and meters publish once per chunk.
+     * @param input Raw input samples
+     * @param output Processed output (may alias input)
+     * @param numSamples Number of samples
+     */
+    void processBlock(const float* input, float* output, size_t numSamples);
+    
+    /**
+     * processBlock() with sample-accurate automation: the block is split
+     * at each event's offset (and every getSubBlockSize() samples), and
+     * the events are applied with setParameter() where they land.
+     * @param events Sorted by offset; see forEachSubBlock()
+     */
+    void processBlock(const float* input, float* output, size_t numSamples,
+                      const ParameterEvent* events, size_t numEvents);
+    
+    /**
+     * Longest run processBlock() processes between parameter, preset and
+     * bypass updates (clamped to 1..BLOCK_CHUNK; BLOCK_CHUNK by default).
+     * 32 or 64 refreshes coefficients at control rate and keeps automation
+     * steps small at some per-chunk cost. Audio thread or before playback.
+     */
+    void setSubBlockSize(size_t samples) { m_subBlockSize = std::clamp<size_t>(samples, 1, BLOCK_CHUNK); }
+    size_t getSubBlockSize() const { return m_subBlockSize; }
+    
+    /**
+     * Apply one parameter immediately (audio thread; this is how
+     * ParameterEvents land). Drive and volume jump without a ramp, the tone
+     * stack uses its own coefficient smoothing.
+     */
+    void setParameter(PedalParameter parameter, float value);
+    
     // ========================================================================
     // Stage Configuration
     // ========================================================================
@@ -65,11 +173,67 @@ public:
      */
     void setDrive(float gainDb);
     
+    /**
+     * Hand a preset to the audio thread without locks or allocations
+     * Call from one producer thread (UI/automation). The newest queued
+     * snapshot is applied at the next sample/block boundary: drive and
+     * volume ramp over BYPASS_RAMP_MS, the tone stack uses its own
+     * coefficient smoothing.
+     * @return false if the queue is full (snapshot dropped)
+     */
+    bool queuePreset(const PresetSnapshot& snapshot) { return m_presetQueue.push(snapshot); }
+    
     /**
      * Set diode clipper impedance
+     * Safe while audio runs (control thread). The clippers pick up the new
+     * load at their next block; with anti-aliasing on, their tables are
+     * rebuilt on TableRebuildWorker::shared() and crossfaded in.
      */
     void setClipperImpedance(float impedanceOhms);
     
+    /**
+     * Antiderivative anti-aliasing for every clipper stage (setup only:
+     * builds the tables on the calling thread)
+     */
+    void setClipperAntiAliasing(Nonlinear::DiodeClippingStage::AntiAliasingMode mode);
+    
+    /**
+     * Load the clippers are running with (audio thread's view)
+     */
+    float getClipperImpedance() const { return m_clipperStages.empty() ? 0.0f : m_clipperStages.front().getLoadImpedance(); }
+    
+    /**
+     * Oversample the clipper cascade only (linear stages stay at base rate)
+     * @param factor 1 (off), 2, 4 or 8
+     * @param type Halfband filter family
+     */
+    void setOversampling(int factor, Oversampler::FilterType type = Oversampler::FilterType::LinearPhaseFIR);
+    
+    /**
+     * Oversample the clipper cascade at 1x..maxFactor, chosen per block from
+     * the level and slope of the signal reaching it (replaces setOversampling)
+     * @param kneeLevel Clipper input level below which the cascade runs at 1x
+     */
+    void setAdaptiveOversampling(int maxFactor, Oversampler::FilterType type = Oversampler::FilterType::LinearPhaseFIR,
+                                 float kneeLevel = 0.3f);
+    
+    /**
+     * Factor the clipper cascade is running at
+     */
+    int getOversamplingFactor() const {
+        return m_adaptiveOversampler ? m_adaptiveOversampler->getFactor() : m_oversampler ? m_oversampler->getFactor() : 1;
+    }
+    
+    /**
+     * Processing latency in samples: oversampling plus look-ahead dynamics.
+     * Report it to the host; it is zero unless one of them is in use.
+     */
+    float getLatencySamples() const {
+        const float oversampling = m_adaptiveOversampler ? m_adaptiveOversampler->getLatencySamples()
+                                 : m_oversampler ? m_oversampler->getLatencySamples() : 0.0f;
+        return oversampling + static_cast<float>(m_outputStage.getLatencySamples());
+    }
+    
     /**
      * Configure tone stack
      */
@@ -85,11 +249,28 @@ public:
      */
     Limiter& getLimiter() { return m_outputStage.getLimiter(); }
     
+    /**
+     * Compressor/limiter detection: PeakWindow (default) and ZeroLatency add
+     * no latency, Lookahead adds the detector window to getLatencySamples().
+     * Bypassing the dynamics stage skips its delay as well.
+     */
+    void setDynamicsDetectorMode(CompressorConfig::DetectorMode mode) { m_outputStage.setDetectorMode(mode); }
+    
     /**
      * Configure noise gate
      */
     NoiseGate& getNoiseGate() { return m_noiseGate; }
     
+    /**
+     * Control-rate interval in samples (1 = everything at audio rate, the
+     * default). Envelope-derived values - the gate's detector and gain -
+     * are then computed once per interval and interpolated in between, in
+     * both process() and processBlock(); the audio path still runs per
+     * sample. 16-64 is inaudible for gate timing.
+     */
+    void setControlInterval(size_t samples) { m_noiseGate.setControlDecimation(samples); }
+    size_t getControlInterval() const { return m_noiseGate.getControlDecimation(); }
+    
     /**
      * Set output level (volume control)
      */
@@ -100,12 +281,41 @@ public:
     // ========================================================================
     
     /**
-     * Get bypass configuration
+     * Bypass ramp length: stages crossfade in/out over this time
      */
-    StageBypass& getBypass() { return m_bypass; }
+    static constexpr float BYPASS_RAMP_MS = 5.0f;
     
     /**
-     * Bypass specific stage
+     * Bypass a stage. Lock-free and allocation-free, safe from any thread;
+     * the audio thread picks the change up at its next sample/block and
+     * ramps the stage in or out. A fully bypassed stage is not run at all
+     * and is reset when it is engaged again. Changes made before the first
+     * sample after construction/reset() apply immediately.
+     */
+    void setStageBypassed(PedalStage stage, bool bypassed) {
+        if (bypassed) m_bypassMask.fetch_or(stageBit(stage), std::memory_order_relaxed);
+        else m_bypassMask.fetch_and(~stageBit(stage), std::memory_order_relaxed);
+    }
+    
+    bool isStageBypassed(PedalStage stage) const {
+        return (getBypassMask() & stageBit(stage)) != 0;
+    }
+    
+    /**
+     * Replace the whole bypass mask (bits from stageBit())
+     */
+    void setBypassMask(uint32_t mask) { m_bypassMask.store(mask & ALL_STAGES_MASK, std::memory_order_relaxed); }
+    uint32_t getBypassMask() const { return m_bypassMask.load(std::memory_order_relaxed); }
+    
+    /**
+     * Get bypass configuration (snapshot of the mask)
+     */
+    StageBypass getBypass() const;
+    
+    /**
+     * Bypass specific stage by name ("input", "clipper", "tone", "comp",
+     * "limiter", "gate", "output"); kept for compatibility, prefer
+     * setStageBypassed() from real-time code
      */
     void setBypass(const std::string& stageName, bool bypassed);
     
@@ -119,31 +329,83 @@ public:
      */
     void enableAll();
     
+    // ========================================================================
+    // Silence Sleep
+    // ========================================================================
+    
+    /**
+     * Input and output must stay below the sleep threshold this long before
+     * the chain sleeps, so filter, gate and compressor tails ring out first
+     */
+    static constexpr float SLEEP_HOLD_MS = 50.0f;
+    
+    /**
+     * Sleep on silence (on by default). A sleeping pedal skips every stage
+     * and outputs zeros; on entering sleep the stage states are cleared, so
+     * the first sample above the threshold wakes the chain from rest in the
+     * same block. Bypass and preset changes made while asleep take effect
+     * without ramps. Lock-free, safe from any thread.
+     */
+    void setSleepEnabled(bool enabled) { m_sleepEnabled.store(enabled, std::memory_order_relaxed); }
+    bool isSleepEnabled() const { return m_sleepEnabled.load(std::memory_order_relaxed); }
+    
+    /**
+     * Level below which input and output count as silence (default -100 dBFS)
+     */
+    void setSleepThreshold(float thresholdDb) {
+        m_sleepThreshold.store(std::pow(10.0f, thresholdDb / 20.0f), std::memory_order_relaxed);
+    }
+    
+    /**
+     * True while the audio thread skips processing (any thread)
+     */
+    bool isSleeping() const { return m_published.sleeping.load(std::memory_order_relaxed); }
+    
     // ========================================================================
     // Meter Functions
     // ========================================================================
     
+    // Meters are accumulated on the audio thread (peak, mean square) and
+    // published through relaxed atomics once per processBlock() chunk or
+    // every METER_PERIOD samples of process(); dB conversion happens here,
+    // on the reader's thread. Safe to poll from any thread.
+    
+    static constexpr int METER_PERIOD = 256;
+    
     /**
-     * Get input level (dB)
+     * Get input peak level over the last metering block (dB)
      */
-    float getInputLevel() const { return m_inputLevelDb; }
+    float getInputLevel() const { return calculateLevelDb(m_published.inputPeak.load(std::memory_order_relaxed)); }
     
     /**
-     * Get clipper gain reduction (dB)
+     * Get input RMS level over the last metering block (dB)
      */
-    float getClipperGainReduction() const { return m_clipperGainReductionDb; }
+    float getInputRms() const { return meanSquareToDb(m_published.inputMeanSquare.load(std::memory_order_relaxed)); }
     
     /**
-     * Get compressor gain reduction (dB)
+     * Get clipper gain reduction (dB): output/input peak of the cascade
+     */
+    float getClipperGainReduction() const {
+        float ratio = m_published.clipperRatio.load(std::memory_order_relaxed);
+        return ratio > 0.0f && ratio != 1.0f ? 20.0f * std::log10(ratio) : 0.0f;
+    }
+    
+    /**
+     * Get compressor gain reduction (dB) at the end of the last metering block
      */
     float getCompressorGainReduction() const {
-        return m_outputStage.getCompressor().getGainReductionDb();
+        return m_published.compressorGainReductionDb.load(std::memory_order_relaxed);
     }
     
     /**
-     * Get output level (dB)
+     * Get output peak level over the last metering block (dB)
      */
-    float getOutputLevel() const { return m_outputLevelDb; }
+    float getOutputLevel() const { return calculateLevelDb(m_published.outputPeak.load(std::memory_order_relaxed)); }
+    
+    /**
+     * Get output RMS level over the last metering block (dB)
+     */
+    float getOutputRms() const { return meanSquareToDb(m_published.outputMeanSquare.load(std::memory_order_relaxed)); }
     
     // ========================================================================
     // System Control
@@ -163,24 +425,139 @@ public:
      * Get number of clipper stages
      */
     size_t getNumClipperStages() const { return m_clipperStages.size(); }
-
-private:
-    float m_sampleRate;
-    
-    // Signal chain stages
-    float m_inputGainLinear;
-    float m_outputGainLinear;
     
-    // Metering
-    float m_inputLevelDb;
-    float m_clipperGainReductionDb;
-    float m_outputLevelDb;
+    MemoryMode getMemoryMode() const { return m_memoryMode; }
     
-    // Bypass control
-    StageBypass m_bypass;
+    /**
+     * Memory of the whole chain: instanceBytes() is what one more pedal
+     * costs, sharedBytes the tables it shares with other instances. Call
+     * while no table rebuild is in flight.
+     */
+    MemoryFootprint getMemoryFootprint() const;
     
-    // Clipper stages (cascade multiple for more aggressive clipping)
-    std::vector<std::shared_ptr<Nonlinear::DiodeClippingStage>> m_clipperStages;
+    /**
+     * Input/output buffer coefficients (first-order filters, fixed corners)
+     * y = b0 x[n] + b1 x[n-1] + a1 x[n-2]
+     */
+    struct BufferCoefficients {
+        float b0, b1, a1;
+    };
+    static BufferCoefficients inputBufferCoefficients(float sampleRate);
+    static BufferCoefficients outputBufferCoefficients(float sampleRate);
+
+private:
+    float m_sampleRate;
+    MemoryMode m_memoryMode;
+    BufferCoefficients m_inputBufferCoeff, m_outputBufferCoeff;   // Fixed per sample rate
+    
+    // Signal chain stages: drive/volume, ramped when a queued preset lands
+    struct GainRamp {
+        float value = 1.0f;
+        float target = 1.0f;
+        float step = 0.0f;
+        int remaining = 0;
+        
+        void set(float v) { value = target = v; remaining = 0; }
+        void rampTo(float t, int samples) {
+            target = t;
+            step = (t - value) / static_cast<float>(samples);
+            remaining = samples;
+        }
+        float next() {
+            float v = value;
+            if (remaining > 0) value = --remaining > 0 ? value + step : target;
+            return v;
+        }
+        void applyBlock(float* data, size_t numSamples) {
+            if (remaining == 0) {
+                for (size_t i = 0; i < numSamples; ++i) data[i] *= value;
+            } else {
+                for (size_t i = 0; i < numSamples; ++i) data[i] *= next();
+            }
+        }
+    };
+    GainRamp m_inputGain;
+    GainRamp m_outputGain;
+    
+    // Presets from the control thread, applied at block boundaries
+    static constexpr size_t PRESET_QUEUE_SIZE = 8;
+    SpscQueue<PresetSnapshot, PRESET_QUEUE_SIZE> m_presetQueue;
+    
+    // Metering: audio-thread accumulators, published as linear values
+    struct MeterAccumulator {
+        float inputPeak = 0.0f, inputSumSquares = 0.0f;
+        float outputPeak = 0.0f, outputSumSquares = 0.0f;
+        float clipperInputPeak = 0.0f, clipperOutputPeak = 0.0f;
+        int count = 0;
+        
+        void addInput(float x) {
+            inputPeak = std::max(inputPeak, std::abs(x));
+            inputSumSquares += x * x;
+        }
+        void addOutput(float x) {
+            outputPeak = std::max(outputPeak, std::abs(x));
+            outputSumSquares += x * x;
+        }
+    };
+    struct PublishedMeters {
+        std::atomic<float> inputPeak{0.0f};
+        std::atomic<float> inputMeanSquare{0.0f};
+        std::atomic<float> outputPeak{0.0f};
+        std::atomic<float> outputMeanSquare{0.0f};
+        std::atomic<float> clipperRatio{1.0f};
+        std::atomic<float> compressorGainReductionDb{0.0f};
+        std::atomic<bool> sleeping{false};
+    };
+    MeterAccumulator m_meter;
+    PublishedMeters m_published;
+    
+    // Bypass control: mask written by any thread, ramps owned by the audio thread
+    std::atomic<uint32_t> m_bypassMask{0};
+    
+    enum RampSlot { SLOT_INPUT, SLOT_CLIPPER, SLOT_TONE, SLOT_GATE, SLOT_DYNAMICS, SLOT_OUTPUT, NUM_SLOTS };
+    static constexpr const char* SLOT_TRACE_NAMES[NUM_SLOTS] = {
+        "Input buffer", "Clippers", "Tone stack", "Noise gate", "Dynamics", "Output buffer"};
+    
+    struct BypassRamp {
+        float mix = 1.0f;       // 1 = stage fully in, 0 = fully bypassed
+        float target = 1.0f;
+        float step = 0.0f;
+        int remaining = 0;
+        
+        bool isBypassed() const { return mix == 0.0f && remaining == 0; }
+        bool isRamping() const { return remaining > 0; }
+        void advance() {
+            mix = --remaining > 0 ? mix + step : target;
+        }
+    };
+    std::array<BypassRamp, NUM_SLOTS> m_ramps;
+    uint32_t m_appliedMask = 0;
+    int m_rampSamples;
+    bool m_running = false;
+    
+    // Silence sleep: settings from any thread, state owned by the audio thread
+    std::atomic<bool> m_sleepEnabled{true};
+    std::atomic<float> m_sleepThreshold{1.0e-5f};
+    int m_sleepHoldSamples;
+    int m_silentSamples = 0;
+    bool m_sleeping = false;
+    
+    // Set while a clipper table rebuild is parked on the worker; the audio
+    // thread resumes it each chunk (never touches the worker otherwise)
+    std::atomic<bool> m_tablesParked{false};
+    
+    // Dry copy for block crossfades while a stage ramps
+    static constexpr size_t BLOCK_CHUNK = 256;
+    std::array<float, BLOCK_CHUNK> m_dryScratch;
+    size_t m_subBlockSize = BLOCK_CHUNK;
+    
+    // Clipper stages (cascade multiple for more aggressive clipping),
+    // held by value so the cascade walks contiguous memory
+    std::vector<Nonlinear::DiodeClippingStage> m_clipperStages;
+    
+    // Optional oversampling around the clipper cascade (at most one is set)
+    std::unique_ptr<Oversampler> m_oversampler;
+    std::unique_ptr<AdaptiveOversampler> m_adaptiveOversampler;
     
     // Tone shaping
     ToneStackController m_toneStack;
@@ -199,10 +576,86 @@ private:
     float processInputBuffer(float input);
     
     /**
-     * Process through cascaded diode clippers
+     * Process through cascaded diode clippers (oversampled if enabled)
      */
     float processClippers(float input);
     
+    /**
+     * Run the clipper cascade at the current (possibly oversampled) rate
+     */
+    float runClipperCascade(float input);
+    
+    /**
+     * Run the clipper cascade over a buffer in place, stage by stage
+     */
+    void runClipperCascadeBlock(float* data, size_t numSamples);
+    
+    /**
+     * Pick up bypass mask changes: start ramps, reset stages being engaged
+     */
+    void syncBypass();
+    
+    /**
+     * Apply the newest queued preset, if any (audio thread)
+     */
+    void applyQueuedPreset();
+    
+    /**
+     * Chunk of processBlock() (numSamples <= BLOCK_CHUNK), in place
+     */
+    void processChunk(float* data, size_t numSamples);
+    
+    /**
+     * While asleep: true to skip this chunk, false (and wake) once the
+     * input peak reaches the threshold or sleep is disabled
+     */
+    bool sleepGate(float inputPeak);
+    
+    /**
+     * Count silent samples after a processed chunk; sleep once input and
+     * output have stayed quiet for the hold time with no ramps or
+     * compressor gain reduction still moving
+     */
+    void trackSilence(float inputPeak, float outputPeak, size_t numSamples);
+    
+    /**
+     * Clear a stage's state before it is engaged from full bypass
+     */
+    void resetSlot(RampSlot slot);
+    
+    /**
+     * Run one stage through its bypass ramp: skipped when fully bypassed,
+     * crossfaded against the dry signal while ramping
+     */
+    template <typename Fn>
+    float runStage(RampSlot slot, float input, Fn&& fn) {
+        BypassRamp& ramp = m_ramps[slot];
+        if (ramp.isBypassed()) return input;
+        float wet = fn(input);
+        if (!ramp.isRamping()) return wet;
+        float out = input + ramp.mix * (wet - input);
+        ramp.advance();
+        return out;
+    }
+    
+    template <typename Fn>
+    void runStageBlock(RampSlot slot, float* data, size_t numSamples, Fn&& fn) {
+        BypassRamp& ramp = m_ramps[slot];
+        if (ramp.isBypassed()) return;
+        LIVESPICE_TRACE_ZONE(SLOT_TRACE_NAMES[slot]);
+        if (!ramp.isRamping()) {
+            fn(data, numSamples);
+            return;
+        }
+        std::copy(data, data + numSamples, m_dryScratch.begin());
+        fn(data, numSamples);
+        for (size_t i = 0; i < numSamples; ++i) {
+            float dry = m_dryScratch[i];
+            data[i] = dry + ramp.mix * (data[i] - dry);
+            if (ramp.isRamping()) ramp.advance();
+        }
+    }
+    
     /**
      * Process through output buffer (low-pass @ 10kHz)
      */
@@ -212,6 +665,18 @@ private:
      * Calculate signal level in dB
      */
     static float calculateLevelDb(float sample);
+    
+    /**
+     * RMS level from a mean square (dB, -80 floor)
+     */
+    static float meanSquareToDb(float meanSquare) {
+        return meanSquare < 1e-12f ? -80.0f : 10.0f * std::log10(meanSquare);
+    }
+    
+    /**
+     * Publish the accumulated meters and start a new metering block
+     */
+    void publishMeters();
 };
 
 // ============================================================================
@@ -236,14 +701,26 @@ struct PedalPreset {
 class PresetManager {
 public:
     /**
-     * Create default presets
+     * Default presets, built once
+     */
+    static const std::vector<PedalPreset>& getDefaultPresets();
+    
+    /**
+     * Default presets compiled to snapshots (same order), built once
+     */
+    static const std::vector<PresetSnapshot>& getDefaultSnapshots();
+    
+    /**
+     * Flatten a preset into its parameter snapshot
      */
-    static std::vector<PedalPreset> getDefaultPresets();
+    static PresetSnapshot compile(const PedalPreset& preset);
     
     /**
-     * Apply preset to pedal
+     * Apply preset to pedal immediately, on the calling thread
+     * From outside the audio thread use pedal.queuePreset(compile(preset)).
      */
     static void applyPreset(MultiStagePedal& pedal, const PedalPreset& preset);
+    static void applySnapshot(MultiStagePedal& pedal, const PresetSnapshot& snapshot);
 };
 
 } // namespace LiveSpiceDSP
@@ -0,0 +1,425 @@
+#include "NetlistCache.h"
+#include "MappedFile.h"
+#include <cstring>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+
+namespace LiveSpice {
+
+namespace {
+
+    constexpr char MAGIC[4] = {'L', 'S', 'N', 'C'};
+    constexpr uint32_t BYTE_ORDER_MARK = 0x01020304u;
+
+    using Id = CompactNetlist::Id;
+
+    // Nonlinear part flags
+    constexpr uint8_t HAS_DIODE = 1u << 0;
+    constexpr uint8_t HAS_BJT = 1u << 1;
+    constexpr uint8_t HAS_FET = 1u << 2;
+    constexpr uint8_t IS_PNP = 1u << 3;
+
+    // ============================================================================
+    // Encoding
+    // ============================================================================
+    class Writer {
+    public:
+        template <typename T>
+        void pod(const T& value) {
+            static_assert(std::is_trivially_copyable<T>::value, "raw field must be trivially copyable");
+            bytes.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        void str(const std::string& value) {
+            pod(static_cast<uint32_t>(value.size()));
+            bytes.append(value);
+        }
+
+        template <typename T>
+        void vec(const std::vector<T>& values) {
+            pod(static_cast<uint32_t>(values.size()));
+            if (!values.empty()) {
+                bytes.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+            }
+        }
+
+        std::string bytes;
+    };
+
+    // ============================================================================
+    // Decoding - bounds-checked reads straight from the mapped entry
+    // ============================================================================
+    class Reader {
+    public:
+        explicit Reader(std::string_view data) : pos(data.data()), end(data.data() + data.size()) {}
+
+        template <typename T>
+        bool pod(T& value) {
+            static_assert(std::is_trivially_copyable<T>::value, "raw field must be trivially copyable");
+            if (static_cast<size_t>(end - pos) < sizeof(T)) return fail();
+            std::memcpy(&value, pos, sizeof(T));
+            pos += sizeof(T);
+            return true;
+        }
+
+        bool str(std::string& value) {
+            uint32_t size = 0;
+            if (!pod(size) || static_cast<size_t>(end - pos) < size) return fail();
+            value.assign(pos, size);
+            pos += size;
+            return true;
+        }
+
+        template <typename T>
+        bool vec(std::vector<T>& values) {
+            uint32_t count = 0;
+            if (!pod(count) || static_cast<size_t>(end - pos) / sizeof(T) < count) return fail();
+            values.resize(count);
+            if (count > 0) std::memcpy(static_cast<void*>(values.data()), pos, count * sizeof(T));
+            pos += count * sizeof(T);
+            return true;
+        }
+
+        /** Ids that must all be < limit */
+        bool ids(std::vector<Id>& values, size_t limit) {
+            if (!vec(values)) return false;
+            for (Id id : values) {
+                if (id >= limit) return fail();
+            }
+            return true;
+        }
+
+        bool ok() const { return good; }
+        bool atEnd() const { return pos == end; }
+
+    private:
+        bool fail() {
+            good = false;
+            pos = end;
+            return false;
+        }
+
+        const char* pos;
+        const char* end;
+        bool good = true;
+    };
+
+    void writeNonlinear(Writer& out, const Nonlinear::ComponentDB::NonlinearComponentInfo& info) {
+        uint8_t flags = (info.diodeChar ? HAS_DIODE : 0) | (info.bjtChar ? HAS_BJT : 0) |
+                        (info.fetChar ? HAS_FET : 0) | (info.isPNP ? IS_PNP : 0);
+        out.str(info.partNumber);
+        out.str(info.name);
+        out.pod(flags);
+        if (info.diodeChar) out.pod(*info.diodeChar);
+        if (info.bjtChar) out.pod(*info.bjtChar);
+        if (info.fetChar) out.pod(*info.fetChar);
+    }
+
+    bool readNonlinear(Reader& in, Nonlinear::ComponentDB::NonlinearComponentInfo& info) {
+        uint8_t flags = 0;
+        if (!in.str(info.partNumber) || !in.str(info.name) || !in.pod(flags)) return false;
+        info.isPNP = (flags & IS_PNP) != 0;
+        if (flags & HAS_DIODE) {
+            Nonlinear::DiodeCharacteristics diode;
+            if (!in.pod(diode)) return false;
+            info.diodeChar = diode;
+        }
+        if (flags & HAS_BJT) {
+            Nonlinear::BJTCharacteristics bjt;
+            if (!in.pod(bjt)) return false;
+            info.bjtChar = bjt;
+        }
+        if (flags & HAS_FET) {
+            Nonlinear::FETCharacteristics fet;
+            if (!in.pod(fet)) return false;
+            info.fetChar = fet;
+        }
+        return true;
+    }
+
+} // namespace
+
+    // ============================================================================
+    // NetlistCache Implementation
+    // ============================================================================
+
+    uint64_t NetlistCache::contentHash(std::string_view bytes) {
+        uint64_t hash = 14695981039346656037ull;
+        for (unsigned char c : bytes) {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    std::string NetlistCache::entryPath(uint64_t hash) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.lsnc", static_cast<unsigned long long>(hash));
+        return (std::filesystem::path(directory) / name).string();
+    }
+
+    NetlistCache::LoadedCircuit NetlistCache::load(const std::string& schxPath) const {
+        uint64_t hash;
+        {
+            MappedFile source(schxPath);
+            if (!source.isOpen()) {
+                throw std::runtime_error("Cannot open file: " + schxPath);
+            }
+            hash = contentHash(source.view());
+            if (salt != 0) hash = (hash ^ salt) * 1099511628211ull;
+
+            LoadedCircuit cached;
+            if (read(entryPath(hash), hash, cached)) {
+                cached.fromCache = true;
+                return cached;
+            }
+        }
+
+        LoadedCircuit circuit{SchematicParser::parseFile(schxPath), {}, false};
+        CircuitAnalyzer analyzer(circuit.schematic);
+        circuit.stages = analyzer.analyzeCircuit();
+        circuit.schematic.getNetlist().buildConnectivityPool();
+
+        std::error_code ec;
+        std::filesystem::create_directories(directory, ec);
+        write(entryPath(hash), hash, circuit);
+        return circuit;
+    }
+
+    bool NetlistCache::write(const std::string& path, uint64_t sourceHash, const LoadedCircuit& circuit) {
+        const Netlist& netlist = circuit.schematic.getNetlist();
+        Writer out;
+
+        out.bytes.append(MAGIC, sizeof(MAGIC));
+        out.pod(FORMAT_VERSION);
+        out.pod(BYTE_ORDER_MARK);
+        out.pod(sourceHash);
+
+        out.str(circuit.schematic.getName());
+        out.str(circuit.schematic.getDescription());
+
+        // Components in name order; their position in this list is their ID
+        std::unordered_map<const Component*, Id> componentIds;
+        out.pod(static_cast<uint32_t>(netlist.getComponentCount()));
+        for (const auto& pair : netlist.getComponents()) {
+            const Component& comp = *pair.second;
+            componentIds.emplace(&comp, static_cast<Id>(componentIds.size()));
+            out.str(comp.getId());
+            out.str(comp.getName());
+            out.pod(static_cast<uint32_t>(comp.getType()));
+            out.pod(static_cast<int32_t>(comp.getPosX()));
+            out.pod(static_cast<int32_t>(comp.getPosY()));
+            out.pod(static_cast<int32_t>(comp.getRotation()));
+            out.pod(static_cast<uint8_t>(comp.getFlipped()));
+            const auto params = comp.getParams();
+            out.pod(static_cast<uint32_t>(params.size()));
+            for (const auto& param : params) {
+                out.str(param.name);
+                out.str(param.value);
+                out.str(param.unit);
+            }
+        }
+
+        out.pod(static_cast<uint32_t>(netlist.getWireCount()));
+        for (const auto& wire : netlist.getWires()) {
+            out.pod(static_cast<int32_t>(wire.nodeA_X));
+            out.pod(static_cast<int32_t>(wire.nodeA_Y));
+            out.pod(static_cast<int32_t>(wire.nodeB_X));
+            out.pod(static_cast<int32_t>(wire.nodeB_Y));
+            out.str(wire.nodeAName);
+            out.str(wire.nodeBName);
+        }
+
+        out.pod(static_cast<uint8_t>(netlist.hasConnectivity()));
+        if (netlist.hasConnectivity()) {
+            const CompactNetlist& compact = netlist.getCompact();
+            out.vec(compact.nodePositions);
+            out.vec(compact.componentNode);
+            out.vec(compact.nodeComponentOffsets);
+            out.vec(compact.nodeComponentIds);
+            out.vec(compact.componentNodeOffsets);
+            out.vec(compact.componentNodeIds);
+            out.vec(compact.neighborOffsets);
+            out.vec(compact.neighborIds);
+        }
+
+        out.pod(static_cast<uint32_t>(circuit.stages.size()));
+        for (const auto& stage : circuit.stages) {
+            out.pod(static_cast<uint32_t>(stage.type));
+            out.str(stage.name);
+            out.pod(static_cast<uint32_t>(stage.components.size()));
+            for (const auto& comp : stage.components) {
+                auto it = componentIds.find(comp.get());
+                if (it == componentIds.end()) return false;  // Not part of this netlist
+                out.pod(it->second);
+            }
+            out.pod(static_cast<uint32_t>(stage.dspParams.size()));
+            for (const auto& param : stage.dspParams) {
+                out.str(param.first);
+                out.pod(param.second);
+            }
+            out.pod(static_cast<uint32_t>(stage.nonlinearComponents.size()));
+            for (const auto& info : stage.nonlinearComponents) {
+                writeNonlinear(out, info);
+            }
+            out.str(stage.patternName);
+            out.str(stage.patternStrategy);
+            out.pod(stage.patternConfidence);
+            out.pod(static_cast<uint32_t>(stage.primaryProcessorType));
+            out.str(stage.dspDescription);
+        }
+
+        // Write then rename so a concurrent reader never sees a partial entry;
+        // the temp name is per thread so parallel writers of one entry don't collide
+        const std::string temp = path + ".tmp" +
+            std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        {
+            std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) return false;
+            file.write(out.bytes.data(), static_cast<std::streamsize>(out.bytes.size()));
+            if (!file) return false;
+        }
+        std::error_code ec;
+        std::filesystem::rename(temp, path, ec);
+        if (ec) {
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+        return true;
+    }
+
+    bool NetlistCache::read(const std::string& path, uint64_t sourceHash, LoadedCircuit& circuit) {
+        MappedFile file(path);
+        if (!file.isOpen()) return false;
+        std::string_view data = file.view();
+        if (data.size() < sizeof(MAGIC) || std::memcmp(data.data(), MAGIC, sizeof(MAGIC)) != 0) return false;
+        Reader in(data.substr(sizeof(MAGIC)));
+
+        uint32_t version = 0, byteOrder = 0;
+        uint64_t hash = 0;
+        if (!in.pod(version) || version != FORMAT_VERSION) return false;
+        if (!in.pod(byteOrder) || byteOrder != BYTE_ORDER_MARK) return false;
+        if (!in.pod(hash) || hash != sourceHash) return false;
+
+        std::string name, description;
+        if (!in.str(name) || !in.str(description)) return false;
+        circuit.schematic = Schematic(name, description);
+        Netlist& netlist = circuit.schematic.getNetlist();
+
+        uint32_t componentCount = 0;
+        if (!in.pod(componentCount)) return false;
+        std::vector<std::shared_ptr<Component>> components;
+        components.reserve(componentCount);
+        for (uint32_t c = 0; c < componentCount; ++c) {
+            std::string id, compName;
+            uint32_t type = 0, paramCount = 0;
+            int32_t x = 0, y = 0, rotation = 0;
+            uint8_t flip = 0;
+            if (!in.str(id) || !in.str(compName) || !in.pod(type) || !in.pod(x) || !in.pod(y) ||
+                !in.pod(rotation) || !in.pod(flip) || !in.pod(paramCount)) return false;
+            if (type > static_cast<uint32_t>(ComponentType::Unknown)) return false;
+
+            auto comp = std::make_shared<Component>(id, static_cast<ComponentType>(type), compName);
+            comp->setPosition(x, y);
+            comp->setRotation(rotation);
+            comp->setFlip(flip != 0);
+            for (uint32_t p = 0; p < paramCount; ++p) {
+                std::string paramName, value, unit;
+                if (!in.str(paramName) || !in.str(value) || !in.str(unit)) return false;
+                comp->addParam(paramName, value, unit);
+            }
+            netlist.addComponent(comp);
+            components.push_back(comp);
+        }
+        if (netlist.getComponentCount() != componentCount) return false;  // Duplicate names
+
+        uint32_t wireCount = 0;
+        if (!in.pod(wireCount)) return false;
+        for (uint32_t w = 0; w < wireCount; ++w) {
+            Wire wire;
+            int32_t ax = 0, ay = 0, bx = 0, by = 0;
+            if (!in.pod(ax) || !in.pod(ay) || !in.pod(bx) || !in.pod(by) ||
+                !in.str(wire.nodeAName) || !in.str(wire.nodeBName)) return false;
+            wire.nodeA_X = ax;
+            wire.nodeA_Y = ay;
+            wire.nodeB_X = bx;
+            wire.nodeB_Y = by;
+            netlist.addWire(wire);
+        }
+
+        uint8_t hasConnectivity = 0;
+        if (!in.pod(hasConnectivity)) return false;
+        if (hasConnectivity) {
+            CompactNetlist compact;
+            if (!in.vec(compact.nodePositions)) return false;
+            const size_t nodeCount = compact.nodePositions.size();
+            if (!in.ids(compact.componentNode, nodeCount) || compact.componentNode.size() != componentCount) return false;
+            if (!in.vec(compact.nodeComponentOffsets) || !in.ids(compact.nodeComponentIds, componentCount)) return false;
+            if (!in.vec(compact.componentNodeOffsets) || !in.ids(compact.componentNodeIds, nodeCount)) return false;
+            if (!in.vec(compact.neighborOffsets) || !in.ids(compact.neighborIds, componentCount)) return false;
+
+            auto validRows = [](const std::vector<Id>& rowOffsets, size_t rows, size_t values) {
+                if (rowOffsets.size() != rows + 1 || rowOffsets.front() != 0 || rowOffsets.back() != values) return false;
+                for (size_t i = 0; i < rows; ++i) {
+                    if (rowOffsets[i] > rowOffsets[i + 1]) return false;
+                }
+                return true;
+            };
+            if (!validRows(compact.nodeComponentOffsets, nodeCount, compact.nodeComponentIds.size()) ||
+                !validRows(compact.componentNodeOffsets, componentCount, compact.componentNodeIds.size()) ||
+                !validRows(compact.neighborOffsets, componentCount, compact.neighborIds.size())) return false;
+
+            compact.components = components;
+            netlist.restoreConnectivity(std::move(compact));
+        }
+
+        uint32_t stageCount = 0;
+        if (!in.pod(stageCount)) return false;
+        circuit.stages.clear();
+        circuit.stages.reserve(stageCount);
+        for (uint32_t s = 0; s < stageCount; ++s) {
+            CircuitStage stage;
+            uint32_t type = 0, count = 0;
+            if (!in.pod(type) || type > static_cast<uint32_t>(StageType::Unknown)) return false;
+            stage.type = static_cast<StageType>(type);
+            if (!in.str(stage.name) || !in.pod(count)) return false;
+            for (uint32_t i = 0; i < count; ++i) {
+                Id id = 0;
+                if (!in.pod(id) || id >= components.size()) return false;
+                stage.components.push_back(components[id]);
+            }
+            if (!in.pod(count)) return false;
+            for (uint32_t i = 0; i < count; ++i) {
+                std::string key;
+                double value = 0.0;
+                if (!in.str(key) || !in.pod(value)) return false;
+                StageParam param;
+                if (stageParamFromName(key, param)) {
+                    stage.setParam(param, value);
+                } else {
+                    stage.dspParams[key] = value;
+                }
+            }
+            if (!in.pod(count)) return false;
+            for (uint32_t i = 0; i < count; ++i) {
+                Nonlinear::ComponentDB::NonlinearComponentInfo info;
+                if (!readNonlinear(in, info)) return false;
+                stage.nonlinearComponents.push_back(std::move(info));
+            }
+            uint32_t processor = 0;
+            if (!in.str(stage.patternName) || !in.str(stage.patternStrategy) ||
+                !in.pod(stage.patternConfidence) || !in.pod(processor) || !in.str(stage.dspDescription)) return false;
+            if (processor > static_cast<uint32_t>(ComponentDSPMapper::DSPProcessorType::Unknown)) return false;
+            stage.primaryProcessorType = static_cast<ComponentDSPMapper::DSPProcessorType>(processor);
+            circuit.stages.push_back(std::move(stage));
+        }
+
+        return in.ok() && in.atEnd();
+    }
+
+} // namespace LiveSpice
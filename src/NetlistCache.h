@@ -0,0 +1,65 @@
+#pragma once
+
+#include "LiveSpiceParser.h"
+#include "CircuitAnalyzer.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace LiveSpice {
+
+    // ============================================================================
+    // Netlist Cache - Parsed + analyzed schematics keyed by content hash
+    // ============================================================================
+
+    /**
+     * Binary cache of parse and analysis results. An entry holds the netlist
+     * (components, parameters, wires), its compact connectivity form and the
+     * CircuitAnalyzer stages. It is named after a hash of the .schx bytes, so
+     * an edited schematic simply misses and renamed/copied ones still hit.
+     * Entries are memory-mapped and decoded in one pass. Any mismatch (format
+     * version, byte order, hash, truncation, unknown component) is treated as
+     * a miss and the entry is rebuilt.
+     */
+    class NetlistCache {
+    public:
+        static constexpr uint32_t FORMAT_VERSION = 2;
+
+        struct LoadedCircuit {
+            Schematic schematic;
+            std::vector<CircuitStage> stages;
+            bool fromCache = false;
+        };
+
+        /**
+         * @param directory Where entries live; created on first write
+         * @param salt Mixed into entry hashes when the analysis depends on
+         *             more than the schematic (e.g. SPICE model libraries)
+         */
+        explicit NetlistCache(std::string directory, uint64_t salt = 0)
+            : directory(std::move(directory)), salt(salt) {}
+
+        /**
+         * Restore the circuit from the cache, or parse, analyze and store it.
+         * Throws like SchematicParser::parseFile when the .schx is unreadable.
+         */
+        LoadedCircuit load(const std::string& schxPath) const;
+
+        /** 64-bit FNV-1a over the source bytes */
+        static uint64_t contentHash(std::string_view bytes);
+
+        std::string entryPath(uint64_t hash) const;
+
+        /** Encode an entry; false when the file cannot be written */
+        static bool write(const std::string& path, uint64_t sourceHash, const LoadedCircuit& circuit);
+
+        /** Decode an entry for this source hash; false on any mismatch */
+        static bool read(const std::string& path, uint64_t sourceHash, LoadedCircuit& circuit);
+
+    private:
+        std::string directory;
+        uint64_t salt;
+    };
+
+} // namespace LiveSpice
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+namespace Nonlinear {
+
+/**
+ * @file NewtonSolver.h
+ * @brief Fixed-size Newton solver for small coupled nonlinear circuits
+ *
+ * Stages where several nonlinear devices load each other (a transistor
+ * whose collector drives a diode clipper inside a feedback loop) need
+ * their node voltages solved together. ChordNewtonSolver<N> solves
+ * f(x) = 0 for 2-6 unknowns with an analytical Jacobian supplied by the
+ * circuit, using the chord method: the LU factors of the last Jacobian are
+ * kept and reused for later iterations and later samples, and only
+ * refreshed when the iteration stops contracting. At audio rate
+ * consecutive solves start close together, so most samples converge in a
+ * few cheap back-substitutions without forming a Jacobian at all.
+ *
+ * A solve that has not converged after maxIterations falls back to plain
+ * Newton (a fresh Jacobian every step) for up to maxIterations more.
+ * If that fails too, x is left at the best iterate seen (smallest
+ * residual) and the stored factors are dropped, so the next solve starts
+ * with a fresh Jacobian.
+ *
+ * The circuit type provides, for Vector = std::array<double, N> and
+ * Matrix = std::array<double, N * N> (row-major):
+ *   void evaluate(const Vector& x, Vector& f, Matrix* J) const;
+ *       residual f(x) (KCL currents), plus df/dx when J is not null, so
+ *       the Jacobian reuses the residual's exponentials
+ *   void limit(const Vector& xOld, Vector& xNew) const;  // step limiting
+ */
+
+/**
+ * SPICE-style junction limiting (pnjlim): past the knee, a forward step
+ * moves along the exponential's log instead of the linearized line
+ */
+inline double limitJunctionStep(double vOld, double vNew, double nVt, double Is) {
+    const double vCrit = nVt * std::log(nVt / (1.41421356237 * Is));
+    if (vNew > vCrit && std::fabs(vNew - vOld) > 2.0 * nVt) {
+        if (vOld > 0.0) {
+            const double arg = 1.0 + (vNew - vOld) / nVt;
+            return arg > 0.0 ? vOld + nVt * std::log(arg) : vCrit;
+        }
+        return nVt * std::log(vNew / nVt);
+    }
+    return vNew;
+}
+
+template <size_t N>
+class ChordNewtonSolver {
+public:
+    static_assert(N >= 1 && N <= 6, "ChordNewtonSolver is meant for 1-6 unknowns");
+
+    using Vector = std::array<double, N>;
+    using Matrix = std::array<double, N * N>;
+
+    struct Config {
+        int maxIterations = 12;
+        double tolerance = 1e-6;    // Largest update (units of x) at convergence
+        double contraction = 0.25;  // Refresh when a step shrinks by less than this
+                                    // (0: Newton after a first step on the old factors)
+    };
+
+    /**
+     * Outcome of one solve
+     */
+    struct Result {
+        bool converged = false;
+        int iterations = 0;
+        int factorizations = 0;
+    };
+
+    /**
+     * Running totals over all solves since construction or resetStats()
+     */
+    struct Stats {
+        long solves = 0;
+        long iterations = 0;
+        long factorizations = 0;
+        long failures = 0;
+    };
+
+    ChordNewtonSolver() = default;
+    explicit ChordNewtonSolver(const Config& config) : m_config(config) {}
+
+    void setConfig(const Config& config) { m_config = config; }
+    const Config& getConfig() const { return m_config; }
+
+    /**
+     * Solve f(x) = 0 starting from x; x holds the solution (or the best
+     * iterate when Result::converged is false)
+     */
+    template <typename Circuit>
+    Result solve(const Circuit& circuit, Vector& x) {
+        Result result = iterate(circuit, x, m_config.contraction, false);
+
+        // Fallback: a solve that ran out of iterations gets one more round
+        // of plain Newton (fresh Jacobian every step) from the best iterate
+        if (!result.converged) {
+            const Result retry = iterate(circuit, x, 0.0, true);
+            result.converged = retry.converged;
+            result.iterations += retry.iterations;
+            result.factorizations += retry.factorizations;
+        }
+
+        if (!result.converged) {
+            m_factored = false;
+            ++m_stats.failures;
+        }
+        ++m_stats.solves;
+        m_stats.iterations += result.iterations;
+        m_stats.factorizations += result.factorizations;
+        return result;
+    }
+
+    /**
+     * Drop the stored factors (after the circuit's element values change)
+     */
+    void invalidate() { m_factored = false; }
+
+    const Stats& getStats() const { return m_stats; }
+    void resetStats() { m_stats = Stats(); }
+
+private:
+    Config m_config;
+    Stats m_stats;
+
+    // LU factors of the last Jacobian (unit lower triangle implied) and row order
+    Matrix m_lu{};
+    std::array<size_t, N> m_pivot{};
+    bool m_factored = false;
+
+    /**
+     * Up to maxIterations updates. The first step uses the stored factors
+     * unless fresh is set; later ones refresh them whenever a step shrinks
+     * by less than contraction. Leaves x at the best iterate when it does
+     * not converge.
+     */
+    template <typename Circuit>
+    Result iterate(const Circuit& circuit, Vector& x, double contraction, bool fresh) {
+        Result result;
+        Vector f;
+        Matrix J;
+        bool refresh = fresh || !m_factored;
+        circuit.evaluate(x, f, refresh ? &J : nullptr);
+
+        Vector best = x;
+        double bestNorm = norm(f);
+        double previousStep = std::numeric_limits<double>::max();
+
+        for (int iteration = 0; iteration < m_config.maxIterations; ++iteration) {
+            if (refresh) {
+                m_factored = factor(J);
+                ++result.factorizations;
+                if (!m_factored) break;
+            }
+
+            Vector next = x;
+            Vector dx;
+            for (size_t r = 0; r < N; ++r) dx[r] = -f[r];
+            substitute(dx);
+            for (size_t r = 0; r < N; ++r) next[r] += dx[r];
+            circuit.limit(x, next);
+
+            double step = 0.0;
+            for (size_t r = 0; r < N; ++r) step = std::fmax(step, std::fabs(next[r] - x[r]));
+            x = next;
+            ++result.iterations;
+            if (step < m_config.tolerance) {
+                result.converged = true;
+                return result;
+            }
+
+            // Stale factors that no longer contract are refreshed at the new point
+            refresh = step > contraction * previousStep;
+            previousStep = step;
+
+            circuit.evaluate(x, f, refresh ? &J : nullptr);
+            const double residualNorm = norm(f);
+            if (residualNorm < bestNorm) {
+                bestNorm = residualNorm;
+                best = x;
+            }
+        }
+        x = best;
+        return result;
+    }
+
+    static double norm(const Vector& v) {
+        double largest = 0.0;
+        for (double value : v) largest = std::fmax(largest, std::fabs(value));
+        return largest;
+    }
+
+    /** In-place LU with partial pivoting; false for a singular Jacobian */
+    bool factor(const Matrix& J) {
+        m_lu = J;
+        for (size_t k = 0; k < N; ++k) m_pivot[k] = k;
+        for (size_t k = 0; k < N; ++k) {
+            size_t pivot = k;
+            for (size_t r = k + 1; r < N; ++r) {
+                if (std::fabs(m_lu[r * N + k]) > std::fabs(m_lu[pivot * N + k])) pivot = r;
+            }
+            if (std::fabs(m_lu[pivot * N + k]) < 1e-300) return false;
+            if (pivot != k) {
+                for (size_t c = 0; c < N; ++c) std::swap(m_lu[k * N + c], m_lu[pivot * N + c]);
+                std::swap(m_pivot[k], m_pivot[pivot]);
+            }
+            for (size_t r = k + 1; r < N; ++r) {
+                const double factor = m_lu[r * N + k] / m_lu[k * N + k];
+                m_lu[r * N + k] = factor;
+                for (size_t c = k + 1; c < N; ++c) m_lu[r * N + c] -= factor * m_lu[k * N + c];
+            }
+        }
+        return true;
+    }
+
+    /** Solve (LU) x = b with the stored factors; x holds b in, solution out */
+    void substitute(Vector& x) const {
+        Vector b = x;
+        for (size_t r = 0; r < N; ++r) {
+            double sum = b[m_pivot[r]];
+            for (size_t c = 0; c < r; ++c) sum -= m_lu[r * N + c] * x[c];
+            x[r] = sum;
+        }
+        for (size_t r = N; r-- > 0;) {
+            double sum = x[r];
+            for (size_t c = r + 1; c < N; ++c) sum -= m_lu[r * N + c] * x[c];
+            x[r] = sum / m_lu[r * N + r];
+        }
+    }
+};
+
+} // namespace Nonlinear
@@ -0,0 +1,453 @@
+// Offline null-test renderer: every WAV input through every processor on a
+// worker pool, then each processor's output against the first one's
+// (the reference). Writes the renders, the residuals (processor minus
+// reference, after lining up any latency difference) and a JSON summary;
+// the exit status is 1 when a render fails or a null is shallower than
+// --threshold.
+//
+//   livespice-nulltest --input=PATH... --processor=SPEC... [--out=DIR]
+//                      [--jobs=N] [--align=SAMPLES] [--threshold=DB]
+//
+// Processor specs:
+//   preset:NAME[,stages=N][,oversample=F]  MultiStagePedal with a default preset
+//   wav:DIR                                Pre-rendered outputs, DIR/<input name>.wav
+//                                          (captures of hosted VSTs or translated plugins)
+//   exec:COMMAND                           Runs COMMAND "<input.wav>" "<output.wav>"
+
+#include "JsonRpc.h"
+#include "MultiStagePedal.h"
+#include "WavFile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace LiveSpiceDSP;
+using LiveSpice::WavData;
+
+namespace {
+    constexpr size_t BLOCK_SIZE = 512;
+    constexpr size_t ALIGN_WINDOW = 65536;       // Samples correlated when searching the lag
+    constexpr double SILENCE_DB = -240.0;
+
+    struct ProcessorSpec {
+        enum class Kind { Preset, Wav, Exec };
+        Kind kind = Kind::Preset;
+        std::string argument;                    // Preset name, directory or command
+        std::string label;                       // File-safe and unique
+        size_t clipperStages = 1;
+        int oversample = 1;
+    };
+
+    struct Render {
+        WavData audio;
+        bool ok = false;
+        std::string error;
+        double milliseconds = 0.0;
+    };
+
+    struct NullResult {
+        bool ok = false;
+        std::string error;
+        int lag = 0;                             // Samples the processor trails the reference
+        size_t frames = 0;
+        double referenceRmsDb = SILENCE_DB;
+        double residualRmsDb = SILENCE_DB;
+        double residualPeakDb = SILENCE_DB;
+        double nullDepthDb = 0.0;                // Residual RMS relative to the reference
+        double correlation = 0.0;
+    };
+
+    double toDb(double linear) {
+        return linear > 0.0 ? std::max(SILENCE_DB, 20.0 * std::log10(linear)) : SILENCE_DB;
+    }
+
+    std::string fileSafe(const std::string& text) {
+        std::string safe;
+        for (char c : text) safe.push_back(std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '.' ? c : '_');
+        return safe.empty() ? "processor" : safe;
+    }
+
+    bool parseSpec(const std::string& text, ProcessorSpec& spec, std::string& error) {
+        const size_t colon = text.find(':');
+        const std::string kind = colon == std::string::npos ? std::string() : text.substr(0, colon);
+        std::string rest = colon == std::string::npos ? text : text.substr(colon + 1);
+
+        if (kind == "preset") {
+            spec.kind = ProcessorSpec::Kind::Preset;
+            std::stringstream options(rest);
+            std::getline(options, spec.argument, ',');
+            std::string option;
+            while (std::getline(options, option, ',')) {
+                if (option.rfind("stages=", 0) == 0) {
+                    spec.clipperStages = static_cast<size_t>(std::max(1, std::atoi(option.c_str() + 7)));
+                } else if (option.rfind("oversample=", 0) == 0) {
+                    spec.oversample = std::max(1, std::atoi(option.c_str() + 11));
+                } else {
+                    error = "unknown preset option '" + option + "'";
+                    return false;
+                }
+            }
+            const auto& presets = PresetManager::getDefaultPresets();
+            if (std::none_of(presets.begin(), presets.end(), [&](const PedalPreset& p) { return p.name == spec.argument; })) {
+                error = "no preset named '" + spec.argument + "' (see --list-presets)";
+                return false;
+            }
+            spec.label = spec.argument + (spec.clipperStages > 1 ? "_x" + std::to_string(spec.clipperStages) : "") +
+                         (spec.oversample > 1 ? "_os" + std::to_string(spec.oversample) : "");
+        } else if (kind == "wav") {
+            spec.kind = ProcessorSpec::Kind::Wav;
+            spec.argument = rest;
+            spec.label = std::filesystem::path(rest).lexically_normal().filename().string();
+            if (spec.label.empty()) spec.label = std::filesystem::path(rest).lexically_normal().parent_path().filename().string();
+        } else if (kind == "exec") {
+            spec.kind = ProcessorSpec::Kind::Exec;
+            spec.argument = rest;
+            spec.label = std::filesystem::path(rest.substr(0, rest.find(' '))).stem().string();
+        } else {
+            error = "processor spec needs a preset:, wav: or exec: prefix: " + text;
+            return false;
+        }
+        spec.label = fileSafe(spec.label);
+        return true;
+    }
+
+    std::vector<std::filesystem::path> collectInputs(const std::vector<std::string>& paths) {
+        std::vector<std::filesystem::path> inputs;
+        for (const auto& path : paths) {
+            if (std::filesystem::is_directory(path)) {
+                std::vector<std::filesystem::path> found;
+                for (const auto& entry : std::filesystem::directory_iterator(path)) {
+                    std::string extension = entry.path().extension().string();
+                    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+                    if (entry.is_regular_file() && extension == ".wav") found.push_back(entry.path());
+                }
+                std::sort(found.begin(), found.end());
+                inputs.insert(inputs.end(), found.begin(), found.end());
+            } else {
+                inputs.emplace_back(path);
+            }
+        }
+        return inputs;
+    }
+
+    /** One mono MultiStagePedal per channel, fed in BLOCK_SIZE chunks */
+    bool renderPreset(const ProcessorSpec& spec, const WavData& input, WavData& output) {
+        const auto& presets = PresetManager::getDefaultPresets();
+        const auto preset = std::find_if(presets.begin(), presets.end(),
+                                         [&](const PedalPreset& p) { return p.name == spec.argument; });
+
+        output.sampleRate = input.sampleRate;
+        output.channels.assign(input.channels.size(), std::vector<float>(input.numFrames()));
+        for (size_t ch = 0; ch < input.channels.size(); ++ch) {
+            MultiStagePedal pedal(static_cast<float>(input.sampleRate), spec.clipperStages);
+            if (spec.oversample > 1) pedal.setOversampling(spec.oversample);
+            PresetManager::applyPreset(pedal, *preset);
+
+            const auto& in = input.channels[ch];
+            auto& out = output.channels[ch];
+            for (size_t offset = 0; offset < in.size(); offset += BLOCK_SIZE) {
+                pedal.processBlock(in.data() + offset, out.data() + offset, std::min(BLOCK_SIZE, in.size() - offset));
+            }
+        }
+        return true;
+    }
+
+    Render render(const ProcessorSpec& spec, const std::filesystem::path& inputPath, const WavData& input,
+                  const std::filesystem::path& outputPath) {
+        Render result;
+        const auto start = std::chrono::steady_clock::now();
+
+        switch (spec.kind) {
+            case ProcessorSpec::Kind::Preset:
+                result.ok = renderPreset(spec, input, result.audio);
+                break;
+            case ProcessorSpec::Kind::Wav: {
+                const auto capture = std::filesystem::path(spec.argument) / inputPath.filename();
+                result.ok = LiveSpice::readWav(capture.string(), result.audio, &result.error);
+                break;
+            }
+            case ProcessorSpec::Kind::Exec: {
+                const std::string command = spec.argument + " \"" + inputPath.string() + "\" \"" + outputPath.string() + "\"";
+                if (std::system(command.c_str()) != 0) {
+                    result.error = "command failed: " + command;
+                } else {
+                    result.ok = LiveSpice::readWav(outputPath.string(), result.audio, &result.error);
+                }
+                break;
+            }
+        }
+        result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (result.ok && result.audio.sampleRate != input.sampleRate) {
+            result.ok = false;
+            result.error = "rendered at " + std::to_string(result.audio.sampleRate) + " Hz, input is " +
+                           std::to_string(input.sampleRate) + " Hz";
+        }
+        if (result.ok && spec.kind != ProcessorSpec::Kind::Exec && !LiveSpice::writeWav(outputPath.string(), result.audio)) {
+            result.ok = false;
+            result.error = "cannot write " + outputPath.string();
+        }
+        return result;
+    }
+
+    /**
+     * Lag in [-maxLag, maxLag] at which the processor's first channel best
+     * matches the reference's, by direct cross-correlation over the first
+     * ALIGN_WINDOW samples. Positive: the processor is late.
+     */
+    int findLag(const std::vector<float>& reference, const std::vector<float>& processed, int maxLag) {
+        const long window = static_cast<long>(std::min({ALIGN_WINDOW, reference.size(), processed.size()}));
+        int bestLag = 0;
+        double best = -1.0e300;
+        for (int lag = -maxLag; lag <= maxLag; ++lag) {
+            double sum = 0.0;
+            for (long n = std::max(0L, -static_cast<long>(lag)); n < window && n + lag < window; ++n) {
+                sum += static_cast<double>(reference[static_cast<size_t>(n)]) * processed[static_cast<size_t>(n + lag)];
+            }
+            if (sum > best) {
+                best = sum;
+                bestLag = lag;
+            }
+        }
+        return bestLag;
+    }
+
+    /** Residual = processed (shifted by the lag) - reference, over the frames both cover */
+    NullResult compareRenders(const WavData& reference, const WavData& processed, int maxLag, WavData& residual) {
+        NullResult result;
+        const size_t numChannels = std::min(reference.channels.size(), processed.channels.size());
+        if (numChannels == 0) {
+            result.error = "no audio";
+            return result;
+        }
+
+        result.lag = maxLag > 0 ? findLag(reference.channels[0], processed.channels[0], maxLag) : 0;
+        const long referenceStart = std::max(0, -result.lag);
+        const long processedStart = std::max(0, result.lag);
+        const long frames = std::min(static_cast<long>(reference.numFrames()) - referenceStart,
+                                     static_cast<long>(processed.numFrames()) - processedStart);
+        if (frames <= 0) {
+            result.error = "renders do not overlap";
+            return result;
+        }
+        result.frames = static_cast<size_t>(frames);
+
+        double referenceEnergy = 0.0, processedEnergy = 0.0, residualEnergy = 0.0, cross = 0.0, peak = 0.0;
+        residual.sampleRate = reference.sampleRate;
+        residual.channels.assign(numChannels, std::vector<float>(result.frames));
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            const float* a = reference.channels[ch].data() + referenceStart;
+            const float* b = processed.channels[ch].data() + processedStart;
+            float* r = residual.channels[ch].data();
+            for (size_t n = 0; n < result.frames; ++n) {
+                r[n] = b[n] - a[n];
+                referenceEnergy += static_cast<double>(a[n]) * a[n];
+                processedEnergy += static_cast<double>(b[n]) * b[n];
+                residualEnergy += static_cast<double>(r[n]) * r[n];
+                cross += static_cast<double>(a[n]) * b[n];
+                peak = std::max(peak, static_cast<double>(std::abs(r[n])));
+            }
+        }
+
+        const double count = static_cast<double>(result.frames * numChannels);
+        result.referenceRmsDb = toDb(std::sqrt(referenceEnergy / count));
+        result.residualRmsDb = toDb(std::sqrt(residualEnergy / count));
+        result.residualPeakDb = toDb(peak);
+        result.nullDepthDb = referenceEnergy > 0.0 ? result.residualRmsDb - result.referenceRmsDb : 0.0;
+        result.correlation = referenceEnergy > 0.0 && processedEnergy > 0.0
+                                 ? cross / std::sqrt(referenceEnergy * processedEnergy) : 0.0;
+        result.ok = true;
+        return result;
+    }
+
+    /** Run task(i) for i in [0, count) on up to jobs threads */
+    template <typename Task>
+    void parallelFor(size_t count, unsigned jobs, Task task) {
+        jobs = std::max(1u, std::min<unsigned>(jobs, static_cast<unsigned>(std::max<size_t>(count, 1))));
+        std::atomic<size_t> next{0};
+        auto worker = [&]() {
+            for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) task(i);
+        };
+        std::vector<std::thread> pool;
+        for (unsigned j = 1; j < jobs; ++j) pool.emplace_back(worker);
+        worker();
+        for (auto& thread : pool) thread.join();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> inputPaths;
+    std::vector<ProcessorSpec> processors;
+    std::string outputDir = "nulltest";
+    unsigned jobs = std::max(1u, std::thread::hardware_concurrency());
+    int maxLag = 4096;
+    double threshold = 0.0;
+    bool haveThreshold = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--input=", 0) == 0) {
+            inputPaths.push_back(arg.substr(8));
+        } else if (arg.rfind("--processor=", 0) == 0) {
+            ProcessorSpec spec;
+            std::string error;
+            if (!parseSpec(arg.substr(12), spec, error)) {
+                std::cerr << error << "\n";
+                return 1;
+            }
+            processors.push_back(spec);
+        } else if (arg.rfind("--out=", 0) == 0) {
+            outputDir = arg.substr(6);
+        } else if (arg.rfind("--jobs=", 0) == 0) {
+            jobs = static_cast<unsigned>(std::max(1, std::atoi(arg.c_str() + 7)));
+        } else if (arg.rfind("--align=", 0) == 0) {
+            maxLag = std::max(0, std::atoi(arg.c_str() + 8));
+        } else if (arg.rfind("--threshold=", 0) == 0) {
+            threshold = std::atof(arg.c_str() + 12);
+            haveThreshold = true;
+        } else if (arg == "--list-presets") {
+            for (const auto& preset : PresetManager::getDefaultPresets()) std::cout << preset.name << "\n";
+            return 0;
+        } else {
+            std::cout << "Usage: " << argv[0] << " --input=PATH... --processor=SPEC... [options]\n\n"
+                      << "  --input=PATH       WAV file or directory of WAVs (repeatable)\n"
+                      << "  --processor=SPEC   Processor to render (repeatable; the first is the reference)\n"
+                      << "                       preset:NAME[,stages=N][,oversample=F]\n"
+                      << "                       wav:DIR       pre-rendered DIR/<input name>.wav\n"
+                      << "                       exec:COMMAND  runs COMMAND <input.wav> <output.wav>\n"
+                      << "  --out=DIR          Renders, residuals and summary.json (default nulltest)\n"
+                      << "  --jobs=N           Worker threads (default: hardware threads)\n"
+                      << "  --align=SAMPLES    Largest latency difference to line up (default 4096, 0 = off)\n"
+                      << "  --threshold=DB     Fail when a null depth is above this (e.g. -60)\n"
+                      << "  --list-presets     Print the MultiStagePedal preset names\n";
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    const auto inputs = collectInputs(inputPaths);
+    if (inputs.empty() || processors.size() < 2) {
+        std::cerr << "Need at least one --input and two --processor specs (see --help)\n";
+        return 1;
+    }
+
+    // Same label twice would write the same files
+    for (size_t p = 0; p < processors.size(); ++p) {
+        for (size_t q = 0; q < p; ++q) {
+            if (processors[q].label == processors[p].label) {
+                processors[p].label += "_" + std::to_string(p);
+                break;
+            }
+        }
+    }
+
+    std::vector<WavData> sources(inputs.size());
+    std::vector<std::string> sourceErrors(inputs.size());
+    std::vector<std::filesystem::path> inputDirs(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (!LiveSpice::readWav(inputs[i].string(), sources[i], &sourceErrors[i])) {
+            std::cerr << sourceErrors[i] << "\n";
+            return 1;
+        }
+        inputDirs[i] = std::filesystem::path(outputDir) / fileSafe(inputs[i].stem().string());
+        std::filesystem::create_directories(inputDirs[i]);
+    }
+
+    const size_t numProcessors = processors.size();
+    std::cout << "Rendering " << inputs.size() << " input(s) through " << numProcessors << " processor(s) with "
+              << jobs << " worker(s)\n";
+
+    // Renders, then nulls: (input, processor) pairs flattened into one task list each
+    const auto wallStart = std::chrono::steady_clock::now();
+    std::vector<Render> renders(inputs.size() * numProcessors);
+    parallelFor(renders.size(), jobs, [&](size_t task) {
+        const size_t i = task / numProcessors, p = task % numProcessors;
+        renders[task] = render(processors[p], inputs[i], sources[i], inputDirs[i] / (processors[p].label + ".wav"));
+    });
+
+    std::vector<NullResult> nulls(inputs.size() * numProcessors);
+    parallelFor(nulls.size(), jobs, [&](size_t task) {
+        const size_t i = task / numProcessors, p = task % numProcessors;
+        const Render& reference = renders[i * numProcessors];
+        if (p == 0 || !renders[task].ok || !reference.ok) return;
+
+        WavData residual;
+        nulls[task] = compareRenders(reference.audio, renders[task].audio, maxLag, residual);
+        if (nulls[task].ok) {
+            LiveSpice::writeWav((inputDirs[i] / (processors[p].label + ".null.wav")).string(), residual);
+        }
+    });
+    const double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+
+    // Summary in input order
+    size_t failures = 0;
+    std::ostringstream json;
+    json << std::fixed << std::setprecision(3);
+    json << "{\n  \"version\": 1,\n  \"reference\": " << LiveSpice::Json::quote(processors[0].label)
+         << ",\n  \"results\": [";
+    bool firstEntry = true;
+
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        std::cout << "\n" << inputs[i].filename().string() << "  (reference " << processors[0].label << ")\n";
+        for (size_t p = 0; p < numProcessors; ++p) {
+            const size_t task = i * numProcessors + p;
+            const Render& r = renders[task];
+            const NullResult& n = nulls[task];
+            const Render& reference = renders[i * numProcessors];
+
+            std::string error = !r.ok ? r.error : (p > 0 && !reference.ok) ? "reference failed" : n.error;
+            const bool failed = !error.empty();
+            const bool tooDeep = !failed && p > 0 && haveThreshold && n.nullDepthDb > threshold;
+            if (failed || tooDeep) ++failures;
+
+            std::cout << "  " << std::left << std::setw(32) << processors[p].label << std::right << std::fixed
+                      << std::setprecision(1) << std::setw(9) << r.milliseconds << " ms";
+            if (failed) {
+                std::cout << "   FAILED: " << error << "\n";
+            } else if (p == 0) {
+                std::cout << "   reference\n";
+            } else {
+                std::cout << "   null " << std::setw(7) << n.nullDepthDb << " dB   peak " << std::setw(7)
+                          << n.residualPeakDb << " dBFS   lag " << n.lag << (tooDeep ? "   ABOVE THRESHOLD" : "")
+                          << "\n";
+            }
+
+            json << (firstEntry ? "\n" : ",\n") << "    {\"input\": " << LiveSpice::Json::quote(inputs[i].string())
+                 << ", \"processor\": " << LiveSpice::Json::quote(processors[p].label)
+                 << ", \"renderMs\": " << r.milliseconds;
+            firstEntry = false;
+            if (failed) {
+                json << ", \"error\": " << LiveSpice::Json::quote(error) << "}";
+            } else if (p > 0) {
+                json << ", \"lag\": " << n.lag << ", \"frames\": " << n.frames
+                     << ", \"referenceRmsDb\": " << n.referenceRmsDb << ", \"residualRmsDb\": " << n.residualRmsDb
+                     << ", \"residualPeakDb\": " << n.residualPeakDb << ", \"nullDepthDb\": " << n.nullDepthDb
+                     << ", \"correlation\": " << std::setprecision(6) << n.correlation << std::setprecision(3) << "}";
+            } else {
+                json << "}";
+            }
+        }
+    }
+    json << "\n  ]\n}\n";
+
+    const std::string summaryPath = (std::filesystem::path(outputDir) / "summary.json").string();
+    std::ofstream(summaryPath) << json.str();
+    std::cout << "\nWall time " << std::fixed << std::setprecision(1) << wallMs << " ms; summary written to "
+              << summaryPath << "\n";
+    if (failures > 0) {
+        std::cout << failures << " failure(s)\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,301 @@
+#include "Oversampling.h"
+#include <cmath>
+#include <algorithm>
+
+namespace LiveSpiceDSP {
+
+namespace {
+    constexpr double PI = 3.14159265358979323846;
+
+    // Zeroth-order modified Bessel function (Kaiser window)
+    double besselI0(double x) {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 50; ++k) {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+            if (term < 1e-12 * sum) break;
+        }
+        return sum;
+    }
+}
+
+// ============================================================================
+// HalfbandFIR Implementation
+// ============================================================================
+
+HalfbandFIR::HalfbandFIR(int halfLength, float kaiserBeta) {
+    const int K = std::max(halfLength, 1);
+    const int length = 4 * K - 1;
+    const int centre = 2 * K - 1;
+
+    m_numTaps = 2 * K;
+    m_centreDelay = K - 1;
+    m_phase.resize(m_numTaps);
+
+    // Even-index taps of 0.5 * sinc((i - c) / 2), Kaiser windowed
+    const double denom = besselI0(kaiserBeta);
+    double sum = 0.0;
+    for (int k = 0; k < m_numTaps; ++k) {
+        int i = 2 * k;
+        double t = 0.5 * (i - centre);
+        double sinc = std::sin(PI * t) / (PI * t);
+        double r = 2.0 * i / (length - 1) - 1.0;
+        double window = besselI0(kaiserBeta * std::sqrt(std::max(0.0, 1.0 - r * r))) / denom;
+        m_phase[k] = static_cast<float>(0.5 * sinc * window);
+        sum += m_phase[k];
+    }
+
+    // Unity DC gain: each polyphase branch of a halfband sums to 0.5
+    for (auto& tap : m_phase) tap = static_cast<float>(tap * 0.5 / sum);
+
+    m_upHistory.assign(2 * m_numTaps, 0.0f);
+    m_downHistory.assign(2 * m_numTaps, 0.0f);
+    m_oddHistory.assign(2 * (K + 1), 0.0f);
+}
+
+void HalfbandFIR::reset() {
+    std::fill(m_upHistory.begin(), m_upHistory.end(), 0.0f);
+    std::fill(m_downHistory.begin(), m_downHistory.end(), 0.0f);
+    std::fill(m_oddHistory.begin(), m_oddHistory.end(), 0.0f);
+    m_upPos = m_downPos = m_oddPos = 0;
+}
+
+// ============================================================================
+// HalfbandIIR Implementation
+// ============================================================================
+
+/**
+ * Elliptic halfband allpass design (Valenzuela & Constantinides)
+ * transition is the normalised transition width at the oversampled rate;
+ * coefficients alternate between the two polyphase paths.
+ */
+HalfbandIIR::HalfbandIIR(int numCoefficients, double transition) {
+    const int count = std::max(numCoefficients, 2);
+    const int order = 2 * count + 1;
+
+    double k = std::tan((1.0 - 2.0 * transition) * PI / 4.0);
+    k *= k;
+    double kksqrt = std::pow(1.0 - k * k, 0.25);
+    double e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+    double e4 = e * e * e * e;
+    double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+    double delay0 = 0.0, delay1 = 0.0;
+    for (int index = 0; index < count; ++index) {
+        const int c = index + 1;
+
+        double num = 0.0;
+        for (int i = 0, sign = 1; ; ++i, sign = -sign) {
+            double term = std::pow(q, i * (i + 1)) * std::sin((2 * i + 1) * c * PI / order) * sign;
+            num += term;
+            if (std::abs(term) < 1e-100) break;
+        }
+        num *= std::pow(q, 0.25);
+
+        double den = 0.5;
+        for (int i = 1, sign = -1; ; ++i, sign = -sign) {
+            double term = std::pow(q, i * i) * std::cos(2 * i * c * PI / order) * sign;
+            den += term;
+            if (std::abs(term) < 1e-100) break;
+        }
+
+        double ww = num / den;
+        double wwsq = ww * ww;
+        double x = std::sqrt((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+        double coeff = (1.0 - x) / (1.0 + x);
+
+        // DC group delay of (a + z^-2) / (1 + a z^-2), in oversampled samples
+        double delay = 2.0 * (1.0 - coeff) / (1.0 + coeff);
+        if (index % 2 == 0) {
+            m_coeff0.push_back(static_cast<float>(coeff));
+            delay0 += delay;
+        } else {
+            m_coeff1.push_back(static_cast<float>(coeff));
+            delay1 += delay;
+        }
+    }
+
+    // H = 0.5 * (A0 + z^-1 A1) applied twice; two oversampled samples per base sample
+    m_latency = static_cast<float>(0.5 * (delay0 + delay1 + 1.0));
+
+    m_upState0.resize(m_coeff0.size());
+    m_downState0.resize(m_coeff0.size());
+    m_upState1.resize(m_coeff1.size());
+    m_downState1.resize(m_coeff1.size());
+}
+
+MemoryFootprint HalfbandFIR::getMemoryFootprint() const {
+    MemoryFootprint footprint{sizeof(HalfbandFIR)};
+    footprint.addVector(m_phase);
+    footprint.addVector(m_upHistory);
+    footprint.addVector(m_downHistory);
+    footprint.addVector(m_oddHistory);
+    return footprint;
+}
+
+void HalfbandIIR::reset() {
+    for (auto* state : {&m_upState0, &m_upState1, &m_downState0, &m_downState1}) {
+        std::fill(state->begin(), state->end(), AllpassState());
+    }
+    m_prevOdd = 0.0f;
+}
+
+// ============================================================================
+// Oversampler Implementation
+// ============================================================================
+
+Oversampler::Oversampler(int factor, FilterType type, size_t maxBlockSize)
+    : m_factor(factor <= 1 ? 1 : factor <= 2 ? 2 : factor <= 4 ? 4 : 8),
+      m_type(type),
+      m_numStages(0),
+      m_maxBlockSize(0) {
+
+    for (int f = m_factor; f > 1; f /= 2) ++m_numStages;
+
+    // The outer 2x stage sees the narrowest transition; inner stages relax
+    for (size_t s = 0; s < m_numStages; ++s) {
+        const float stageScale = static_cast<float>(1 << s);
+        if (m_type == FilterType::LinearPhaseFIR) {
+            m_firStages.emplace_back(s == 0 ? 8 : 4);
+            m_latency += m_firStages.back().getLatency() / stageScale;
+        } else {
+            m_iirStages.emplace_back(s == 0 ? 8 : 4, s == 0 ? 0.05 : 0.15);
+            m_latency += m_iirStages.back().getLatency() / stageScale;
+        }
+    }
+
+    prepare(maxBlockSize);
+}
+
+void Oversampler::prepare(size_t maxBlockSize) {
+    m_maxBlockSize = std::max<size_t>(maxBlockSize, 1);
+    m_scratch.assign(m_maxBlockSize * static_cast<size_t>(m_factor), 0.0f);
+}
+
+MemoryFootprint HalfbandIIR::getMemoryFootprint() const {
+    MemoryFootprint footprint{sizeof(HalfbandIIR)};
+    footprint.addVector(m_coeff0);
+    footprint.addVector(m_coeff1);
+    footprint.addVector(m_upState0);
+    footprint.addVector(m_upState1);
+    footprint.addVector(m_downState0);
+    footprint.addVector(m_downState1);
+    return footprint;
+}
+
+void Oversampler::reset() {
+    for (auto& stage : m_firStages) stage.reset();
+    for (auto& stage : m_iirStages) stage.reset();
+}
+
+// ============================================================================
+// AdaptiveOversampler Implementation
+// ============================================================================
+
+AdaptiveOversampler::AdaptiveOversampler(int maxFactor, FilterType type, size_t maxBlockSize) {
+    const int top = maxFactor <= 2 ? 2 : maxFactor <= 4 ? 4 : 8;
+    for (int factor = 1; factor <= top; factor *= 2) {
+        m_paths.push_back({Oversampler(factor, type, maxBlockSize), {}, 0});
+        m_latency = std::max(m_latency, m_paths.back().oversampler.getLatencySamples());
+    }
+
+    // Integer padding; the residual (under half a sample) only matters mid-fade
+    for (auto& path : m_paths) {
+        const long pad = std::lround(m_latency - path.oversampler.getLatencySamples());
+        path.delayLine.assign(static_cast<size_t>(std::max(0L, pad)), 0.0f);
+    }
+
+    // A reset path's output is valid once its up and down filters have filled
+    m_warmupSamples = static_cast<size_t>(std::ceil(2.0f * m_latency)) + 1;
+
+    prepare(maxBlockSize);
+}
+
+int AdaptiveOversampler::requiredFactor(float peak, float slope) const {
+    if (!(peak > m_kneeLevel)) return 1;
+
+    const float drive = peak / m_kneeLevel;
+    const float frequency = std::min(0.5f, slope / (2.0f * static_cast<float>(PI) * peak));
+    const float bandwidth = frequency * drive * HARMONIC_REACH;
+
+    int factor = 1;
+    while (factor < getMaxFactor() && bandwidth > 0.5f * static_cast<float>(factor)) factor *= 2;
+    return factor;
+}
+
+void AdaptiveOversampler::decide(int wantedFactor, size_t numSamples) {
+    const size_t wanted = pathIndex(wantedFactor);
+
+    if (isTransitioning()) {
+        // A transient during a downshift fades back to the outgoing path,
+        // which is still running; anything else waits for the switch to end
+        if (wanted > m_active && m_previous > m_active) {
+            const float weight = fadeWeight(m_fadePosition);
+            std::swap(m_active, m_previous);
+            m_fadePosition = m_warmupSamples + static_cast<size_t>(std::lround((1.0f - weight) * CROSSFADE_SAMPLES)) - 1;
+        }
+        m_holdSamples = 0;
+        return;
+    }
+
+    if (wanted > m_active) {
+        startSwitch(wanted);
+        m_holdSamples = 0;
+    } else if (wanted == m_active) {
+        m_holdSamples = 0;
+    } else {
+        m_holdPath = m_holdSamples == 0 ? wanted : std::max(m_holdPath, wanted);
+        m_holdSamples += numSamples;
+        if (m_holdSamples >= DOWNSHIFT_HOLD_SAMPLES) {
+            startSwitch(m_holdPath);
+            m_holdSamples = 0;
+        }
+    }
+}
+
+void AdaptiveOversampler::startSwitch(size_t path) {
+    m_paths[path].reset();
+    m_previous = m_active;
+    m_active = path;
+    m_fadePosition = 0;
+}
+
+void AdaptiveOversampler::prepare(size_t maxBlockSize) {
+    m_maxBlockSize = std::max<size_t>(maxBlockSize, 1);
+    for (auto& path : m_paths) path.oversampler.prepare(m_maxBlockSize);
+    m_scratch.assign(m_maxBlockSize, 0.0f);
+}
+
+MemoryFootprint Oversampler::getMemoryFootprint() const {
+    MemoryFootprint footprint{sizeof(Oversampler)};
+    footprint.addVector(m_firStages);
+    for (const auto& stage : m_firStages) footprint.addMember(stage.getMemoryFootprint());
+    footprint.addVector(m_iirStages);
+    for (const auto& stage : m_iirStages) footprint.addMember(stage.getMemoryFootprint());
+    footprint.addVector(m_scratch);
+    return footprint;
+}
+
+void AdaptiveOversampler::reset() {
+    for (auto& path : m_paths) path.reset();
+    m_active = m_previous = 0;
+    m_fadePosition = 0;
+    m_holdSamples = 0;
+    m_holdPath = 0;
+    m_lastInput = 0.0f;
+    m_intervalPeak = m_intervalSlope = 0.0f;
+    m_intervalSamples = 0;
+}
+
+MemoryFootprint AdaptiveOversampler::getMemoryFootprint() const {
+    MemoryFootprint footprint{sizeof(AdaptiveOversampler)};
+    footprint.addVector(m_paths);
+    for (const auto& path : m_paths) {
+        footprint.addMember(path.oversampler.getMemoryFootprint());
+        footprint.addVector(path.delayLine);
+    }
+    footprint.addVector(m_scratch);
+    return footprint;
+}
+
+} // namespace LiveSpiceDSP
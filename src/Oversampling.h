@@ -0,0 +1,461 @@
+#pragma once
+
+#include "Denormals.h"
+#include "MemoryFootprint.h"
+#include <cmath>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file Oversampling.h
+ * @brief Polyphase oversampling for nonlinear stages
+ *
+ * Runs only the nonlinear part of a chain at 2x/4x/8x while linear
+ * filters stay at the base rate. Each 2x step is a polyphase halfband
+ * section, cascaded for higher factors:
+ * - LinearPhaseFIR: Kaiser-windowed halfband FIR (constant group delay)
+ * - MinimumPhaseIIR: polyphase allpass halfband (low latency, nonlinear phase)
+ */
+
+// ============================================================================
+// Halfband Sections (one 2x up/down step)
+// ============================================================================
+
+/**
+ * Linear-phase halfband FIR, polyphase form
+ * With N = 4K - 1 taps, every other tap is zero except the 0.5 centre tap,
+ * so one phase is a pure delay and only 2K multiplies run per base sample.
+ */
+class HalfbandFIR {
+public:
+    explicit HalfbandFIR(int halfLength = 8, float kaiserBeta = 7.0f);
+
+    /**
+     * Upsample one sample into two (even, odd)
+     */
+    void upsample(float input, float& even, float& odd) {
+        push(m_upHistory, m_upPos, input);
+        const float* x = &m_upHistory[m_upPos];
+        float acc = 0.0f;
+        for (int k = 0; k < m_numTaps; ++k) acc += m_phase[k] * x[k];
+        even = 2.0f * acc;
+        odd = x[m_centreDelay];
+    }
+
+    /**
+     * Downsample two samples (even, odd) into one
+     */
+    float downsample(float even, float odd) {
+        push(m_downHistory, m_downPos, even);
+        const float* u = &m_downHistory[m_downPos];
+        float acc = 0.0f;
+        for (int k = 0; k < m_numTaps; ++k) acc += m_phase[k] * u[k];
+
+        // Centre tap: odd sample from K base samples ago
+        push(m_oddHistory, m_oddPos, odd);
+        return acc + 0.5f * m_oddHistory[m_oddPos + m_centreDelay + 1];
+    }
+
+    void reset();
+
+    /**
+     * Round-trip (up + down) group delay in base-rate samples
+     */
+    float getLatency() const { return static_cast<float>(m_numTaps - 1); }
+
+    MemoryFootprint getMemoryFootprint() const;
+
+private:
+    int m_numTaps;      // Non-trivial phase length (2K)
+    int m_centreDelay;  // K - 1
+    std::vector<float> m_phase;
+
+    // Circular histories stored twice so a contiguous window is always valid
+    std::vector<float> m_upHistory, m_downHistory, m_oddHistory;
+    int m_upPos = 0, m_downPos = 0, m_oddPos = 0;
+
+    static void push(std::vector<float>& history, int& pos, float value) {
+        const int length = static_cast<int>(history.size()) / 2;
+        pos = (pos == 0) ? length - 1 : pos - 1;
+        history[pos] = value;
+        history[pos + length] = value;
+    }
+};
+
+/**
+ * Polyphase IIR halfband: H(z) = 0.5 * (A0(z^2) + z^-1 A1(z^2))
+ * A0/A1 are cascades of first-order allpass sections whose coefficients
+ * come from an elliptic halfband design (computed once at construction).
+ */
+class HalfbandIIR {
+public:
+    explicit HalfbandIIR(int numCoefficients = 8, double transition = 0.05);
+
+    void upsample(float input, float& even, float& odd) {
+        even = runPath(m_upState0, m_coeff0, input);
+        odd = runPath(m_upState1, m_coeff1, input);
+    }
+
+    float downsample(float even, float odd) {
+        float out = 0.5f * (runPath(m_downState0, m_coeff0, even) + runPath(m_downState1, m_coeff1, m_prevOdd));
+        m_prevOdd = odd;
+        return out;
+    }
+
+    void reset();
+
+    /**
+     * Round-trip group delay at DC in base-rate samples
+     */
+    float getLatency() const { return m_latency; }
+
+    MemoryFootprint getMemoryFootprint() const;
+
+private:
+    struct AllpassState { float x1 = 0.0f, y1 = 0.0f; };
+
+    std::vector<float> m_coeff0, m_coeff1;
+    std::vector<AllpassState> m_upState0, m_upState1, m_downState0, m_downState1;
+    float m_prevOdd = 0.0f;
+    float m_latency = 0.0f;
+
+    // y[n] = a * (x[n] - y[n-1]) + x[n-1], i.e. (a + z^-1) / (1 + a z^-1)
+    static float runPath(std::vector<AllpassState>& state, const std::vector<float>& coeff, float x) {
+        for (size_t i = 0; i < coeff.size(); ++i) {
+            float y = coeff[i] * (x - state[i].y1) + state[i].x1;
+            state[i].x1 = x;
+            state[i].y1 = y;
+            x = y;
+        }
+        return x;
+    }
+};
+
+// ============================================================================
+// Oversampler
+// ============================================================================
+
+class Oversampler {
+public:
+    enum class FilterType { LinearPhaseFIR, MinimumPhaseIIR };
+
+    static constexpr int MAX_FACTOR = 8;
+
+    /**
+     * @param factor Oversampling factor: 1 (pass-through), 2, 4 or 8
+     * @param type Halfband filter family
+     * @param maxBlockSize Largest base-rate block for processBlock()
+     */
+    Oversampler(int factor = 2, FilterType type = FilterType::LinearPhaseFIR, size_t maxBlockSize = 512);
+
+    /**
+     * Run one base-rate sample through fn at the oversampled rate
+     * @param fn Callable float(float), typically a nonlinear stage
+     */
+    template <typename Fn>
+    float processSample(float input, Fn&& fn) {
+        if (m_factor == 1) return fn(input);
+
+        float frame[MAX_FACTOR];
+        upsampleFrame(input, frame);
+        for (int i = 0; i < m_factor; ++i) frame[i] = fn(frame[i]);
+        return downsampleFrame(frame);
+    }
+
+    /**
+     * Run a base-rate block through fn at the oversampled rate, in place
+     * @param fn Callable void(float* data, size_t numSamples) on the
+     *           oversampled block, e.g. a stage's processBlock()
+     */
+    template <typename Fn>
+    void processBlock(float* data, size_t numSamples, Fn&& fn) {
+        ScopedFlushDenormals noDenormals;
+        if (m_factor == 1) { fn(data, numSamples); return; }
+
+        for (size_t start = 0; start < numSamples; start += m_maxBlockSize) {
+            const size_t n = std::min(m_maxBlockSize, numSamples - start);
+            float* base = data + start;
+            float* up = m_scratch.data();
+
+            for (size_t i = 0; i < n; ++i) upsampleFrame(base[i], up + i * m_factor);
+            fn(up, n * m_factor);
+            for (size_t i = 0; i < n; ++i) base[i] = downsampleFrame(up + i * m_factor);
+        }
+    }
+
+    /**
+     * Resize the oversampled scratch buffer (not real-time safe)
+     */
+    void prepare(size_t maxBlockSize);
+
+    void reset();
+
+    int getFactor() const { return m_factor; }
+    FilterType getFilterType() const { return m_type; }
+
+    /**
+     * Total round-trip latency in base-rate samples (fractional for IIR
+     * and for cascaded FIR stages)
+     */
+    float getLatencySamples() const { return m_latency; }
+
+    MemoryFootprint getMemoryFootprint() const;
+
+private:
+    int m_factor;
+    FilterType m_type;
+    size_t m_numStages;
+    size_t m_maxBlockSize;
+    float m_latency = 0.0f;
+
+    // Stage 0 runs at 2x, stage 1 at 4x, stage 2 at 8x
+    std::vector<HalfbandFIR> m_firStages;
+    std::vector<HalfbandIIR> m_iirStages;
+    std::vector<float> m_scratch;
+
+    // Expand one base sample to m_factor samples, stage by stage in time order
+    void upsampleFrame(float input, float* frame) {
+        float scratch[MAX_FACTOR];
+        float* src = scratch;
+        float* dst = frame;
+        // Route so the final stage writes into frame
+        if (m_numStages % 2 == 0) std::swap(src, dst);
+        src[0] = input;
+        int count = 1;
+        for (size_t s = 0; s < m_numStages; ++s) {
+            for (int i = 0; i < count; ++i) upsampleStage(s, src[i], dst[2 * i], dst[2 * i + 1]);
+            count *= 2;
+            std::swap(src, dst);
+        }
+    }
+
+    // Collapse m_factor samples back to one (overwrites frame)
+    float downsampleFrame(float* frame) {
+        int count = m_factor;
+        for (size_t s = m_numStages; s-- > 0;) {
+            count /= 2;
+            for (int i = 0; i < count; ++i) frame[i] = downsampleStage(s, frame[2 * i], frame[2 * i + 1]);
+        }
+        return frame[0];
+    }
+
+    void upsampleStage(size_t s, float in, float& even, float& odd) {
+        if (m_type == FilterType::LinearPhaseFIR) m_firStages[s].upsample(in, even, odd);
+        else m_iirStages[s].upsample(in, even, odd);
+    }
+
+    float downsampleStage(size_t s, float even, float odd) {
+        return m_type == FilterType::LinearPhaseFIR ? m_firStages[s].downsample(even, odd)
+                                                    : m_iirStages[s].downsample(even, odd);
+    }
+};
+
+// ============================================================================
+// Adaptive Oversampler
+// ============================================================================
+
+/**
+ * Oversampler whose factor follows the signal: 1x while the stage is fed
+ * below its knee, up to maxFactor when it is driven hard with bright input.
+ *
+ * Each block is measured (peak and steepest slope) before it is processed,
+ * so a transient never reaches the stage at too low a factor. Higher factors
+ * are taken at once; lower ones only after DOWNSHIFT_HOLD_SAMPLES in which
+ * they would have been enough, so a decaying note does not toggle the rate.
+ *
+ * Every factor's path is delayed to the latency of the slowest one, so the
+ * reported latency never changes. A switch resets the incoming path, runs it
+ * beside the outgoing one until its filters hold real signal, then
+ * crossfades over CROSSFADE_SAMPLES. fn runs at both rates during a switch,
+ * so a stage with memory sees the two streams interleaved for that long.
+ */
+class AdaptiveOversampler {
+public:
+    using FilterType = Oversampler::FilterType;
+
+    static constexpr size_t CROSSFADE_SAMPLES = 128;
+    static constexpr size_t DOWNSHIFT_HOLD_SAMPLES = 8192;
+
+    // processSample() re-decides the factor every this many samples
+    static constexpr size_t DECISION_INTERVAL = 64;
+
+    // Significant harmonics reach about this many times drive x fundamental
+    static constexpr float HARMONIC_REACH = 16.0f;
+
+    /**
+     * @param maxFactor Highest factor used: 2, 4 or 8
+     * @param type Halfband filter family of every path
+     * @param maxBlockSize Largest base-rate block for processBlock()
+     */
+    AdaptiveOversampler(int maxFactor = 8, FilterType type = FilterType::LinearPhaseFIR, size_t maxBlockSize = 512);
+
+    /**
+     * Input level below which the stage is close enough to linear to run at 1x
+     */
+    void setKneeLevel(float level) { m_kneeLevel = std::max(level, 1e-6f); }
+    float getKneeLevel() const { return m_kneeLevel; }
+
+    /**
+     * Smallest factor whose band holds the harmonics the stage generates from
+     * a block with this peak and steepest sample-to-sample step.
+     * slope / (2 pi peak) is the frequency of a sine with that peak and slope,
+     * in cycles per base sample.
+     */
+    int requiredFactor(float peak, float slope) const;
+
+    /**
+     * Run one base-rate sample through fn (float(float)); the factor is
+     * chosen from the previous DECISION_INTERVAL samples
+     */
+    template <typename Fn>
+    float processSample(float input, Fn&& fn) {
+        m_intervalPeak = std::max(m_intervalPeak, std::abs(input));
+        m_intervalSlope = std::max(m_intervalSlope, std::abs(input - m_lastInput));
+        m_lastInput = input;
+        if (++m_intervalSamples == DECISION_INTERVAL) {
+            decide(requiredFactor(m_intervalPeak, m_intervalSlope), DECISION_INTERVAL);
+            m_intervalPeak = m_intervalSlope = 0.0f;
+            m_intervalSamples = 0;
+        }
+
+        Path& active = m_paths[m_active];
+        const float wet = active.delay(active.oversampler.processSample(input, fn));
+        if (!isTransitioning()) return wet;
+
+        Path& previous = m_paths[m_previous];
+        const float dry = previous.delay(previous.oversampler.processSample(input, fn));
+        const float weight = fadeWeight(m_fadePosition);
+        advanceFade(1);
+        return dry + weight * (wet - dry);
+    }
+
+    /**
+     * Run a base-rate block through fn (void(float*, size_t)) in place; the
+     * factor is chosen from each block before it is processed
+     */
+    template <typename Fn>
+    void processBlock(float* data, size_t numSamples, Fn&& fn) {
+        ScopedFlushDenormals noDenormals;
+        for (size_t start = 0; start < numSamples; start += m_maxBlockSize) {
+            const size_t n = std::min(m_maxBlockSize, numSamples - start);
+            float* base = data + start;
+
+            float peak = 0.0f, slope = 0.0f;
+            for (size_t i = 0; i < n; ++i) {
+                peak = std::max(peak, std::abs(base[i]));
+                slope = std::max(slope, std::abs(base[i] - m_lastInput));
+                m_lastInput = base[i];
+            }
+            decide(requiredFactor(peak, slope), n);
+
+            if (!isTransitioning()) {
+                runPath(m_paths[m_active], base, n, fn);
+                continue;
+            }
+
+            float* dry = m_scratch.data();
+            std::copy(base, base + n, dry);
+            runPath(m_paths[m_previous], dry, n, fn);
+            runPath(m_paths[m_active], base, n, fn);
+            for (size_t i = 0; i < n; ++i) {
+                const float weight = fadeWeight(m_fadePosition + i);
+                base[i] = dry[i] + weight * (base[i] - dry[i]);
+            }
+            advanceFade(n);
+        }
+    }
+
+    /**
+     * Resize scratch buffers (not real-time safe)
+     */
+    void prepare(size_t maxBlockSize);
+
+    /**
+     * Clear every path and return to 1x
+     */
+    void reset();
+
+    /** Factor in use (the incoming one during a switch) */
+    int getFactor() const { return m_paths[m_active].oversampler.getFactor(); }
+    int getMaxFactor() const { return m_paths.back().oversampler.getFactor(); }
+    bool isTransitioning() const { return m_active != m_previous; }
+    FilterType getFilterType() const { return m_paths.back().oversampler.getFilterType(); }
+
+    /**
+     * Round-trip latency in base-rate samples, the same at every factor
+     */
+    float getLatencySamples() const { return m_latency; }
+
+    MemoryFootprint getMemoryFootprint() const;
+
+private:
+    struct Path {
+        Oversampler oversampler;
+        std::vector<float> delayLine;   // Pads the path to the common latency
+        size_t delayPos = 0;
+
+        float delay(float x) {
+            if (delayLine.empty()) return x;
+            const float y = delayLine[delayPos];
+            delayLine[delayPos] = x;
+            delayPos = delayPos + 1 == delayLine.size() ? 0 : delayPos + 1;
+            return y;
+        }
+
+        void reset() {
+            oversampler.reset();
+            std::fill(delayLine.begin(), delayLine.end(), 0.0f);
+            delayPos = 0;
+        }
+    };
+
+    std::vector<Path> m_paths;      // 1x, 2x, 4x, ... maxFactor
+    size_t m_active = 0;
+    size_t m_previous = 0;          // Equal to m_active when not switching
+    size_t m_fadePosition = 0;      // Samples since the switch started
+    size_t m_warmupSamples = 0;     // Incoming path settles before the fade
+    size_t m_maxBlockSize = 0;
+    float m_latency = 0.0f;
+    float m_kneeLevel = 0.3f;
+
+    // Downshift hysteresis
+    size_t m_holdSamples = 0;
+    size_t m_holdPath = 0;          // Highest path wanted while holding
+
+    float m_lastInput = 0.0f;
+    float m_intervalPeak = 0.0f, m_intervalSlope = 0.0f;
+    size_t m_intervalSamples = 0;
+
+    std::vector<float> m_scratch;   // Outgoing path's copy of the block
+
+    template <typename Fn>
+    static void runPath(Path& path, float* data, size_t numSamples, Fn& fn) {
+        path.oversampler.processBlock(data, numSamples, fn);
+        for (size_t i = 0; i < numSamples; ++i) data[i] = path.delay(data[i]);
+    }
+
+    float fadeWeight(size_t position) const {
+        if (position < m_warmupSamples) return 0.0f;
+        return std::min(1.0f, static_cast<float>(position - m_warmupSamples + 1) / CROSSFADE_SAMPLES);
+    }
+
+    void advanceFade(size_t numSamples) {
+        m_fadePosition += numSamples;
+        if (m_fadePosition >= m_warmupSamples + CROSSFADE_SAMPLES) m_previous = m_active;
+    }
+
+    static size_t pathIndex(int factor) {
+        size_t index = 0;
+        for (int f = factor; f > 1; f /= 2) ++index;
+        return index;
+    }
+
+    /** Update the factor from the next numSamples' requirement */
+    void decide(int wantedFactor, size_t numSamples);
+    void startSwitch(size_t path);
+};
+
+} // namespace LiveSpiceDSP
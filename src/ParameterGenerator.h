@@ -171,6 +171,67 @@ namespace LiveSpice {
             return ss.str();
         }
 
+        // ========================================================================
+        // Parameter Smoothing
+        // ========================================================================
+        // Continuous parameters ramp through juce::SmoothedValue, advanced once
+        // per block. <id>Dirty is true while a knob is still moving (and on the
+        // first block after prepareToPlay), so knob-driven coefficients are
+        // only recomputed when they actually change.
+
+        static constexpr double SMOOTHING_SECONDS = 0.02;
+
+        // Generate smoother members (bypass stays an unsmoothed switch)
+        std::string generateSmoothingMembers(const std::vector<JuceParameter>& parameters) const {
+            std::stringstream ss;
+
+            ss << "    // Parameter smoothers (ramped once per block)\n";
+            for (const auto& param : parameters) {
+                if (param.id != "bypass") {
+                    ss << "    juce::SmoothedValue<float> " << param.id << "Smoothed;\n";
+                }
+            }
+            ss << "    bool parametersNeedRefresh = true;\n\n";
+
+            return ss.str();
+        }
+
+        // Generate smoother setup for prepareToPlay
+        std::string generateSmoothingPrepare(const std::vector<JuceParameter>& parameters) const {
+            std::stringstream ss;
+
+            ss << "    // Parameter smoothers: start at the current knob positions\n";
+            for (const auto& param : parameters) {
+                if (param.id != "bypass") {
+                    ss << "    " << param.id << "Smoothed.reset(sampleRate, " << SMOOTHING_SECONDS << ");\n";
+                    ss << "    " << param.id << "Smoothed.setCurrentAndTargetValue(" << param.id << "Param->load());\n";
+                }
+            }
+            ss << "    parametersNeedRefresh = true;\n";
+
+            return ss.str();
+        }
+
+        // Generate smoothed parameter values and dirty flags in processBlock
+        std::string generateSmoothedParameterUsage(const std::vector<JuceParameter>& parameters) const {
+            std::stringstream ss;
+
+            ss << "    // Smoothed parameter values; <id>Dirty marks a value that changed this block\n";
+            ss << "    [[maybe_unused]] const bool refreshParameters = std::exchange(parametersNeedRefresh, false);\n";
+            for (const auto& param : parameters) {
+                if (param.id == "bypass") {
+                    ss << "    float " << param.id << "Value = " << param.id << "Param->load();\n";
+                    continue;
+                }
+                ss << "    " << param.id << "Smoothed.setTargetValue(" << param.id << "Param->load());\n";
+                ss << "    [[maybe_unused]] const bool " << param.id << "Dirty = refreshParameters || " << param.id << "Smoothed.isSmoothing();\n";
+                ss << "    float " << param.id << "Value = " << param.id << "Smoothed.skip(buffer.getNumSamples());\n";
+            }
+            ss << "\n";
+
+            return ss.str();
+        }
+
         // Generate complete APVTS constructor parameter
         std::string generateAPVTSConstructorParam() const {
             return ", apvts(*this, nullptr, \"Parameters\", createParameterLayout())";
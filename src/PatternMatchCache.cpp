@@ -0,0 +1,281 @@
+#include "PatternMatchCache.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <thread>
+
+namespace TopologyAnalysis {
+
+namespace {
+
+constexpr char MAGIC[4] = {'L', 'S', 'P', 'M'};
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304u;
+
+/// Label refinement rounds: enough to tell apart the small stage graphs we match
+constexpr int REFINE_ROUNDS = 3;
+
+struct Header {
+    char magic[4];
+    uint32_t formatVersion;
+    uint32_t byteOrder;
+    uint32_t patternCount;
+    uint64_t registryVersion;
+    uint64_t entryCount;
+};
+
+struct Record {
+    uint64_t hash;
+    int32_t patternIndex;
+    float confidence;
+};
+
+uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t fnv1a(uint64_t hash, const std::string& text) {
+    const uint64_t size = text.size();
+    return fnv1a(fnv1a(hash, &size, sizeof(size)), text.data(), text.size());
+}
+
+uint64_t fnv1a(uint64_t hash, float value) {
+    if (value == 0.0f) value = 0.0f;   // -0 and +0 label alike
+    return fnv1a(hash, &value, sizeof(value));
+}
+
+}  // namespace
+
+// ============================================================================
+// Canonical Subcircuit Hash
+// ============================================================================
+
+uint64_t PatternMatchCache::subcircuitHash(const std::vector<Component>& circuitComponents,
+                                           const std::vector<Connection>& connections) {
+    const uint64_t seed = 14695981039346656037ull;
+    const size_t count = circuitComponents.size();
+
+    std::vector<uint64_t> labels(count);
+    for (size_t i = 0; i < count; ++i) {
+        const Component& comp = circuitComponents[i];
+        uint64_t label = fnv1a(seed, &comp.type, sizeof(comp.type));
+        label = fnv1a(label, comp.partNumber);
+        label = fnv1a(label, comp.value);
+        for (const auto& param : comp.parameters) {
+            label = fnv1a(fnv1a(label, param.first), param.second);
+        }
+        labels[i] = label;
+    }
+
+    // Same graph the matcher builds: first component per id, no self loops
+    std::map<std::string, uint32_t> index;
+    for (uint32_t i = 0; i < count; ++i) {
+        index.emplace(circuitComponents[i].id, i);
+    }
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    std::vector<std::vector<uint32_t>> adjacency(count);
+    for (const auto& conn : connections) {
+        auto from = index.find(conn.fromId);
+        auto to = index.find(conn.toId);
+        if (from == index.end() || to == index.end() || from->second == to->second) continue;
+        edges.emplace_back(std::min(from->second, to->second), std::max(from->second, to->second));
+    }
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    for (const auto& edge : edges) {
+        adjacency[edge.first].push_back(edge.second);
+        adjacency[edge.second].push_back(edge.first);
+    }
+
+    // Each round folds in the sorted labels of a component's neighbours
+    if (!edges.empty()) {
+        std::vector<uint64_t> next(count), neighbours;
+        for (int round = 0; round < REFINE_ROUNDS; ++round) {
+            for (size_t i = 0; i < count; ++i) {
+                neighbours.clear();
+                for (uint32_t other : adjacency[i]) neighbours.push_back(labels[other]);
+                std::sort(neighbours.begin(), neighbours.end());
+                next[i] = fnv1a(labels[i], neighbours.data(), neighbours.size() * sizeof(uint64_t));
+            }
+            labels.swap(next);
+        }
+    }
+
+    std::vector<std::pair<uint64_t, uint64_t>> labelledEdges;
+    labelledEdges.reserve(edges.size());
+    for (const auto& edge : edges) {
+        const uint64_t a = labels[edge.first], b = labels[edge.second];
+        labelledEdges.emplace_back(std::min(a, b), std::max(a, b));
+    }
+    std::sort(labels.begin(), labels.end());
+    std::sort(labelledEdges.begin(), labelledEdges.end());
+
+    const uint64_t edgeCount = labelledEdges.size();
+    uint64_t hash = fnv1a(seed, &count, sizeof(count));
+    hash = fnv1a(hash, labels.data(), labels.size() * sizeof(uint64_t));
+    hash = fnv1a(hash, &edgeCount, sizeof(edgeCount));
+    for (const auto& edge : labelledEdges) {
+        hash = fnv1a(hash, &edge.first, sizeof(edge.first));
+        hash = fnv1a(hash, &edge.second, sizeof(edge.second));
+    }
+    return hash;
+}
+
+// ============================================================================
+// PatternMatchCache Implementation
+// ============================================================================
+
+PatternMatchCache& PatternMatchCache::shared() {
+    static PatternMatchCache cache(PatternRegistry::shared());
+    return cache;
+}
+
+PatternMatch PatternMatchCache::matchPattern(const std::vector<Component>& circuitComponents,
+                                             const std::vector<Connection>& connections) {
+    const uint64_t hash = subcircuitHash(circuitComponents, connections);
+    const auto& patterns = registry.listPatterns();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(hash);
+        if (it != entries.end()) {
+            ++hits;
+            PatternMatch match;
+            if (it->second.patternIndex >= 0) {
+                match.pattern = &patterns[static_cast<size_t>(it->second.patternIndex)];
+                match.confidence = it->second.confidence;
+                match.matchedComponents = circuitComponents;
+                match.matchedConnections = connections;
+            }
+            return match;
+        }
+    }
+
+    // Match outside the lock so analyzers on other threads keep hitting
+    PatternMatch match = registry.matchPattern(circuitComponents, connections);
+    Entry entry;
+    if (match.pattern) {
+        entry.patternIndex = static_cast<int32_t>(match.pattern - patterns.data());
+        entry.confidence = match.confidence;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ++misses;
+    if (entries.emplace(hash, entry).second) dirty = true;
+    return match;
+}
+
+std::string PatternMatchCache::filePath(const std::string& directory) const {
+    char name[40];
+    std::snprintf(name, sizeof(name), "patterns-%016llx.lspm",
+                  static_cast<unsigned long long>(registry.getVersion()));
+    return (std::filesystem::path(directory) / name).string();
+}
+
+bool PatternMatchCache::load(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (std::find(loadedDirectories.begin(), loadedDirectories.end(), directory) != loadedDirectories.end()) {
+        return true;
+    }
+    loadedDirectories.push_back(directory);
+
+    LiveSpice::MappedFile file(filePath(directory));
+    if (!file.isOpen()) return false;
+    const std::string_view data = file.view();
+
+    // Any mismatch is a miss: the file is rewritten by the next save()
+    Header header;
+    if (data.size() < sizeof(Header)) return false;
+    std::memcpy(&header, data.data(), sizeof(Header));
+    const size_t patternCount = registry.getPatternCount();
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.formatVersion != FORMAT_VERSION ||
+        header.byteOrder != BYTE_ORDER_MARK || header.registryVersion != registry.getVersion() ||
+        header.patternCount != patternCount ||
+        (data.size() - sizeof(Header)) / sizeof(Record) != header.entryCount ||
+        (data.size() - sizeof(Header)) % sizeof(Record) != 0) {
+        dirty = true;
+        return false;
+    }
+
+    std::vector<Record> records(static_cast<size_t>(header.entryCount));
+    if (!records.empty()) {
+        std::memcpy(static_cast<void*>(records.data()), data.data() + sizeof(Header), records.size() * sizeof(Record));
+    }
+    for (const Record& record : records) {
+        if (record.patternIndex < -1 || record.patternIndex >= static_cast<int32_t>(patternCount)) {
+            dirty = true;
+            return false;
+        }
+    }
+    for (const Record& record : records) {
+        entries.emplace(record.hash, Entry{record.patternIndex, record.confidence});
+    }
+    if (entries.size() != records.size()) dirty = true;   // Held matches the file lacks
+    return true;
+}
+
+bool PatternMatchCache::save(const std::string& directory) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!dirty) return true;
+
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.formatVersion = FORMAT_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.patternCount = static_cast<uint32_t>(registry.getPatternCount());
+    header.registryVersion = registry.getVersion();
+    header.entryCount = entries.size();
+
+    std::vector<Record> records;
+    records.reserve(entries.size());
+    for (const auto& pair : entries) {
+        records.push_back(Record{pair.first, pair.second.patternIndex, pair.second.confidence});
+    }
+
+    // Write then rename, as NetlistCache does, so readers never see a partial file
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    const std::string path = filePath(directory);
+    const std::string temp = path + ".tmp" +
+        std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(records.data()),
+                   static_cast<std::streamsize>(records.size() * sizeof(Record)));
+        if (!file) return false;
+    }
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        return false;
+    }
+    dirty = false;
+    return true;
+}
+
+size_t PatternMatchCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+size_t PatternMatchCache::getHits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+size_t PatternMatchCache::getMisses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+
+}  // namespace TopologyAnalysis
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "TopologyPatterns.h"
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace TopologyAnalysis {
+
+// ============================================================================
+// PATTERN MATCH CACHE
+// ============================================================================
+
+/**
+ * PatternMatchCache - Match results keyed by a canonical subcircuit hash
+ *
+ * The same input buffers, RC filters and diode pairs recur across a pedal
+ * catalogue, so each distinct subcircuit only needs matching once. Entries
+ * hold the winning pattern (by registry index) and its confidence, and are
+ * bound to one registry: the persisted file is named after and stamped with
+ * PatternRegistry::getVersion(), so any pattern or matcher change misses.
+ *
+ * A hit carries the query's own components and connections rather than a
+ * topology embedding's subset; callers that need the embedded subset
+ * should call PatternRegistry::matchPattern directly.
+ *
+ * Thread-safe: one instance serves every analyzer in a batch.
+ */
+class PatternMatchCache {
+public:
+    static constexpr uint32_t FORMAT_VERSION = 1;
+
+    explicit PatternMatchCache(const PatternRegistry& registry) : registry(registry) {}
+
+    /**
+     * shared - Process-wide cache over PatternRegistry::shared()
+     */
+    static PatternMatchCache& shared();
+
+    /**
+     * subcircuitHash - Canonical hash of a matcher input
+     *
+     * Components are labelled by type, part number, value and parameters
+     * (never by id), labels are refined over the undirected connection graph
+     * for a few rounds, and the sorted labels and edges are hashed. Component
+     * and connection order do not matter; pins and feedback flags are ignored
+     * like the matcher ignores them.
+     */
+    static uint64_t subcircuitHash(const std::vector<Component>& circuitComponents,
+                                   const std::vector<Connection>& connections);
+
+    /**
+     * matchPattern - PatternRegistry::matchPattern through the cache
+     */
+    PatternMatch matchPattern(const std::vector<Component>& circuitComponents,
+                              const std::vector<Connection>& connections);
+
+    /**
+     * load - Merge the entries persisted in directory for this registry
+     * version. Each directory is read once; later calls return true at once.
+     * False when there is no valid file.
+     */
+    bool load(const std::string& directory);
+
+    /**
+     * save - Write every entry to directory when new ones were added since
+     * the last save or load. False when the file cannot be written.
+     */
+    bool save(const std::string& directory);
+
+    std::string filePath(const std::string& directory) const;
+
+    size_t size() const;
+    size_t getHits() const;
+    size_t getMisses() const;
+
+private:
+    struct Entry {
+        int32_t patternIndex = -1;   ///< -1 = no pattern above threshold
+        float confidence = 0.0f;
+    };
+
+    const PatternRegistry& registry;
+    mutable std::mutex mutex;
+    std::unordered_map<uint64_t, Entry> entries;
+    std::vector<std::string> loadedDirectories;
+    size_t hits = 0;
+    size_t misses = 0;
+    bool dirty = false;
+};
+
+}  // namespace TopologyAnalysis
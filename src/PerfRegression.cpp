@@ -0,0 +1,360 @@
+// Performance regression suite: ns/sample and allocations for the DSP
+// classes, wall time and allocations for translating every example
+// schematic. Results are written as JSON and compared against a stored
+// baseline; the exit status is 1 when anything got slower than the
+// tolerance allows or allocates more than before.
+//
+//   livespice-perf [--out=FILE] [--baseline=FILE] [--update-baseline]
+//                  [--tolerance=0.15] [--examples=DIR] [--translator=PATH]
+
+#include "CompressorDynamics.h"
+#include "DiodeModels.h"
+#include "JsonRpc.h"
+#include "MultiStagePedal.h"
+#include "PhaseProfiler.h"
+#include "StateSpaceFilter.h"
+#include "TransistorModels.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace LiveSpiceDSP;
+using namespace Nonlinear;
+
+namespace {
+    constexpr float SAMPLE_RATE = 48000.0f;
+    constexpr size_t BLOCK_SIZE = 512;
+    constexpr size_t BLOCKS_PER_RUN = 256;      // 128k samples per timed run
+    constexpr int TIMED_RUNS = 7;
+    constexpr std::chrono::milliseconds WARMUP(100);
+    constexpr int TRANSLATOR_RUNS = 3;
+
+    struct DspResult {
+        std::string name;
+        double nsPerSample = 0.0;
+        uint64_t allocations = 0;
+    };
+
+    struct TranslatorResult {
+        std::string schematic;
+        double milliseconds = 0.0;
+        uint64_t allocations = 0;
+    };
+
+    std::string readFile(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        if (!file.is_open()) {
+            return {};
+        }
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        return buffer.str();
+    }
+
+    /**
+     * Time processBlock-style work over BLOCKS_PER_RUN blocks of a 1 kHz,
+     * 0.5 V sine. Untimed runs for WARMUP warm caches, tables, lazily built
+     * state and the CPU clock; the fastest of TIMED_RUNS is reported, and
+     * allocations are counted over every timed run (a steady-state audio
+     * path makes none).
+     */
+    DspResult measure(const std::string& name, const std::function<void(const float*, float*, size_t)>& process) {
+        std::vector<float> input(BLOCK_SIZE * BLOCKS_PER_RUN);
+        for (size_t n = 0; n < input.size(); ++n) {
+            input[n] = 0.5f * std::sin(2.0f * 3.14159265f * 1000.0f * static_cast<float>(n) / SAMPLE_RATE);
+        }
+        std::vector<float> output(BLOCK_SIZE);
+
+        auto run = [&]() {
+            for (size_t b = 0; b < BLOCKS_PER_RUN; ++b) {
+                process(input.data() + b * BLOCK_SIZE, output.data(), BLOCK_SIZE);
+            }
+        };
+        const auto warmupEnd = std::chrono::steady_clock::now() + WARMUP;
+        do {
+            run();
+        } while (std::chrono::steady_clock::now() < warmupEnd);
+
+        DspResult result;
+        result.name = name;
+        result.nsPerSample = std::numeric_limits<double>::max();
+        const uint64_t allocationsBefore = LiveSpice::AllocationCounters::count;
+        for (int r = 0; r < TIMED_RUNS; ++r) {
+            const auto start = std::chrono::steady_clock::now();
+            run();
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            const double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+            result.nsPerSample = std::min(result.nsPerSample, ns / static_cast<double>(input.size()));
+        }
+        result.allocations = LiveSpice::AllocationCounters::count - allocationsBefore;
+        return result;
+    }
+
+    std::vector<DspResult> benchmarkDsp() {
+        std::vector<DspResult> results;
+
+        DiodeClippingStage newton(DiodeCharacteristics::Si1N4148());
+        results.push_back(measure("DiodeClippingStage/NewtonRaphson", [&](const float* in, float* out, size_t n) {
+            newton.processBlock(in, out, n);
+        }));
+
+        DiodeClippingStage omega(DiodeCharacteristics::Si1N4148());
+        omega.setSolverMode(DiodeClippingStage::SolverMode::WrightOmega);
+        results.push_back(measure("DiodeClippingStage/WrightOmega", [&](const float* in, float* out, size_t n) {
+            omega.processBlock(in, out, n);
+        }));
+
+        BJTAmplifierStage bjt(BJTCharacteristics::TwoN3904());
+        results.push_back(measure("BJTAmplifierStage/2N3904", [&](const float* in, float* out, size_t n) {
+            for (size_t i = 0; i < n; ++i) out[i] = bjt.processInputVoltage(in[i]);
+        }));
+
+        MultiStagePedal pedal(SAMPLE_RATE, 2);
+        results.push_back(measure("MultiStagePedal/2 clippers", [&](const float* in, float* out, size_t n) {
+            pedal.processBlock(in, out, n);
+        }));
+
+        MultiStagePedal oversampled(SAMPLE_RATE, 2);
+        oversampled.setOversampling(2);
+        results.push_back(measure("MultiStagePedal/2 clippers, 2x oversampled", [&](const float* in, float* out, size_t n) {
+            oversampled.processBlock(in, out, n);
+        }));
+
+        // Four-band tone cascade, runtime-sized and fixed-order
+        const BiquadCoefficients bands[4] = {
+            BiquadFilter::designHighPass(SAMPLE_RATE, 80.0f),
+            BiquadFilter::designPeakFilter(SAMPLE_RATE, 700.0f, 0.7f, -3.0f),
+            BiquadFilter::designHighShelf(SAMPLE_RATE, 3000.0f, 0.707f, 4.0f),
+            BiquadFilter::designLowPass(SAMPLE_RATE, 8000.0f),
+        };
+        BiquadFilterBank<> dynamicBank(4);
+        BiquadFilterBank<4> fixedBank;
+        for (size_t s = 0; s < 4; ++s) {
+            dynamicBank.setStageCoefficients(s, bands[s]);
+            fixedBank.setStageCoefficients(s, bands[s]);
+        }
+        results.push_back(measure("BiquadFilterBank<>/4 stages", [&](const float* in, float* out, size_t n) {
+            dynamicBank.processBlock(in, out, n);
+        }));
+        results.push_back(measure("BiquadFilterBank<4>", [&](const float* in, float* out, size_t n) {
+            fixedBank.processBlock(in, out, n);
+        }));
+
+        Compressor compressor(SAMPLE_RATE);
+        compressor.configure(CompressorConfig(-24.0f, 4.0f, 5.0f, 80.0f));
+        results.push_back(measure("Compressor/4:1 soft knee", [&](const float* in, float* out, size_t n) {
+            compressor.processBlock(in, out, n);
+        }));
+
+        return results;
+    }
+
+    /**
+     * Translate every schematic in examplesDir with one batch worker in a
+     * scratch directory and read the per-file "translate" phase from the
+     * profile. The fastest of TRANSLATOR_RUNS is kept per schematic.
+     */
+    std::vector<TranslatorResult> benchmarkTranslator(const std::string& translator, const std::string& examplesDir) {
+        const std::filesystem::path scratch = std::filesystem::temp_directory_path() / "livespice_perf";
+        std::map<std::string, TranslatorResult> best;
+
+        for (int r = 0; r < TRANSLATOR_RUNS; ++r) {
+            std::filesystem::remove_all(scratch);
+            std::filesystem::create_directories(scratch);
+            const std::string command = "cd \"" + scratch.string() + "\" && \"" + translator + "\" --batch=\"" +
+                                        examplesDir + "\" --jobs=1 --profile=profile.json > translate.log 2>&1";
+            if (std::system(command.c_str()) != 0) {
+                std::cerr << "Translator failed; see " << (scratch / "translate.log").string() << "\n";
+                return {};
+            }
+
+            LiveSpice::Json::Value profile;
+            std::string error;
+            if (!LiveSpice::Json::parse(readFile(scratch / "profile.json"), profile, &error)) {
+                std::cerr << "Unreadable translator profile: " << error << "\n";
+                return {};
+            }
+            const LiveSpice::Json::Value* phases = profile.find("phases");
+            if (!phases) continue;
+            for (const auto& phase : phases->items) {
+                const LiveSpice::Json::Value* name = phase.find("phase");
+                const LiveSpice::Json::Value* depth = phase.find("depth");
+                if (!name || name->asString() != "translate" || !depth || depth->asNumber() != 0) continue;
+
+                TranslatorResult result;
+                result.schematic = std::filesystem::path(phase.find("file")->asString()).stem().string();
+                result.milliseconds = phase.find("durationUs")->asNumber() / 1000.0;
+                result.allocations = static_cast<uint64_t>(phase.find("allocations")->asNumber());
+
+                auto existing = best.find(result.schematic);
+                if (existing == best.end()) {
+                    best.emplace(result.schematic, result);
+                } else {
+                    existing->second.milliseconds = std::min(existing->second.milliseconds, result.milliseconds);
+                    existing->second.allocations = std::min(existing->second.allocations, result.allocations);
+                }
+            }
+        }
+        std::filesystem::remove_all(scratch);
+
+        std::vector<TranslatorResult> results;
+        for (const auto& entry : best) results.push_back(entry.second);
+        return results;
+    }
+
+    std::string toJson(const std::vector<DspResult>& dsp, const std::vector<TranslatorResult>& translator) {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3);
+        out << "{\n  \"version\": 1,\n  \"dsp\": [";
+        for (size_t i = 0; i < dsp.size(); ++i) {
+            out << (i ? ",\n" : "\n") << "    {\"name\": " << LiveSpice::Json::quote(dsp[i].name)
+                << ", \"nsPerSample\": " << dsp[i].nsPerSample << ", \"allocations\": " << dsp[i].allocations << "}";
+        }
+        out << "\n  ],\n  \"translator\": [";
+        for (size_t i = 0; i < translator.size(); ++i) {
+            out << (i ? ",\n" : "\n") << "    {\"schematic\": " << LiveSpice::Json::quote(translator[i].schematic)
+                << ", \"milliseconds\": " << translator[i].milliseconds
+                << ", \"allocations\": " << translator[i].allocations << "}";
+        }
+        out << "\n  ]\n}\n";
+        return out.str();
+    }
+
+    /** Entries of one baseline section as name -> (time, allocations) */
+    std::map<std::string, std::pair<double, double>> baselineSection(const LiveSpice::Json::Value& baseline,
+                                                                     const char* section, const char* key,
+                                                                     const char* time) {
+        std::map<std::string, std::pair<double, double>> entries;
+        if (const LiveSpice::Json::Value* items = baseline.find(section)) {
+            for (const auto& item : items->items) {
+                const LiveSpice::Json::Value* name = item.find(key);
+                const LiveSpice::Json::Value* value = item.find(time);
+                const LiveSpice::Json::Value* allocations = item.find("allocations");
+                if (name && value && allocations) {
+                    entries[name->asString()] = {value->asNumber(), allocations->asNumber()};
+                }
+            }
+        }
+        return entries;
+    }
+
+    /**
+     * Print one comparison row; true when it is a regression. Time may
+     * grow by the tolerance (timer noise), allocation counts not at all.
+     */
+    bool compare(const std::string& name, double value, double allocations, const char* unit,
+                 const std::map<std::string, std::pair<double, double>>& baseline, double tolerance) {
+        auto entry = baseline.find(name);
+        std::cout << "  " << std::left << std::setw(48) << name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(10) << value << " " << unit;
+        if (entry == baseline.end()) {
+            std::cout << "   (new)\n";
+            return false;
+        }
+
+        const double change = entry->second.first > 0.0 ? value / entry->second.first - 1.0 : 0.0;
+        const bool slower = change > tolerance;
+        const bool allocates = allocations > entry->second.second;
+        std::cout << std::showpos << std::setw(9) << change * 100.0 << "%" << std::noshowpos;
+        if (slower) std::cout << "   SLOWER";
+        if (allocates) std::cout << "   ALLOCATES (" << entry->second.second << " -> " << allocations << ")";
+        std::cout << "\n";
+        return slower || allocates;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string outputPath = "perf_results.json";
+    std::string baselinePath = "perf_baseline.json";
+    std::string examplesDir = LIVESPICE_EXAMPLES_DIR;
+    std::string translator = LIVESPICE_TRANSLATOR_PATH;
+    double tolerance = 0.15;
+    bool updateBaseline = false;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--out=", 0) == 0) {
+            outputPath = arg.substr(6);
+        } else if (arg.rfind("--baseline=", 0) == 0) {
+            baselinePath = arg.substr(11);
+        } else if (arg.rfind("--examples=", 0) == 0) {
+            examplesDir = arg.substr(11);
+        } else if (arg.rfind("--translator=", 0) == 0) {
+            translator = arg.substr(13);
+        } else if (arg.rfind("--tolerance=", 0) == 0) {
+            tolerance = std::max(0.0, std::atof(arg.c_str() + 12));
+        } else if (arg == "--update-baseline") {
+            updateBaseline = true;
+        } else {
+            std::cout << "Usage: " << argv[0] << " [options]\n\n"
+                      << "  --out=FILE         Results as JSON (default perf_results.json)\n"
+                      << "  --baseline=FILE    Baseline to compare against (default perf_baseline.json)\n"
+                      << "  --update-baseline  Store these results as the new baseline\n"
+                      << "  --tolerance=F      Allowed slowdown before failing (default 0.15 = 15%)\n"
+                      << "  --examples=DIR     Schematics to translate (default: examples/example pedals)\n"
+                      << "  --translator=PATH  livespice-translator to time\n";
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    std::cout << "Measuring DSP classes...\n";
+    const auto dsp = benchmarkDsp();
+    std::cout << "Translating " << examplesDir << "...\n";
+    const auto translations = benchmarkTranslator(translator, examplesDir);
+    if (translations.empty()) {
+        return 1;
+    }
+
+    const std::string json = toJson(dsp, translations);
+    std::ofstream(outputPath) << json;
+    std::cout << "Results written to: " << outputPath << "\n\n";
+
+    LiveSpice::Json::Value baseline;
+    const std::string baselineText = readFile(baselinePath);
+    const bool haveBaseline = !baselineText.empty() && LiveSpice::Json::parse(baselineText, baseline);
+
+    const auto dspBaseline = haveBaseline ? baselineSection(baseline, "dsp", "name", "nsPerSample")
+                                          : std::map<std::string, std::pair<double, double>>{};
+    const auto translatorBaseline = haveBaseline ? baselineSection(baseline, "translator", "schematic", "milliseconds")
+                                                 : std::map<std::string, std::pair<double, double>>{};
+
+    size_t regressions = 0;
+    std::cout << "DSP (ns/sample)\n";
+    for (const auto& result : dsp) {
+        regressions += compare(result.name, result.nsPerSample, static_cast<double>(result.allocations), "ns",
+                               dspBaseline, tolerance);
+    }
+    std::cout << "\nTranslator (ms per schematic)\n";
+    for (const auto& result : translations) {
+        regressions += compare(result.schematic, result.milliseconds, static_cast<double>(result.allocations), "ms",
+                               translatorBaseline, tolerance);
+    }
+
+    if (updateBaseline) {
+        std::ofstream(baselinePath) << json;
+        std::cout << "\nBaseline updated: " << baselinePath << "\n";
+        return 0;
+    }
+    if (!haveBaseline) {
+        std::cout << "\nNo baseline at " << baselinePath << "; run with --update-baseline to store one.\n";
+        return 0;
+    }
+    if (regressions > 0) {
+        std::cout << "\n" << regressions << " regression(s) against " << baselinePath << "\n";
+        return 1;
+    }
+    std::cout << "\nNo regressions against " << baselinePath << " (tolerance " << tolerance * 100.0 << "%)\n";
+    return 0;
+}
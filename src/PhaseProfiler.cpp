@@ -0,0 +1,110 @@
+#include "PhaseProfiler.h"
+#include "JsonRpc.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+
+// ============================================================================
+// Allocation counting
+// ============================================================================
+// Replacing the ordinary operator new/delete pair is enough: the array and
+// nothrow forms forward to them by default.
+
+void* operator new(std::size_t size) {
+    ++LiveSpice::AllocationCounters::count;
+    LiveSpice::AllocationCounters::bytes += size;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace LiveSpice {
+
+namespace {
+
+    std::string number(double value) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.1f", value);
+        return text;
+    }
+
+} // namespace
+
+    // ============================================================================
+    // PhaseProfiler Implementation
+    // ============================================================================
+
+    std::vector<PhaseProfiler::Phase> PhaseProfiler::getPhases() const {
+        std::vector<Phase> sorted;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            sorted = phases;
+        }
+        std::stable_sort(sorted.begin(), sorted.end(), [](const Phase& a, const Phase& b) {
+            if (a.thread != b.thread) return a.thread < b.thread;
+            if (a.startUs != b.startUs) return a.startUs < b.startUs;
+            return a.depth < b.depth;
+        });
+        return sorted;
+    }
+
+    std::string PhaseProfiler::toJson() const {
+        std::ostringstream out;
+        out << "{\n  \"peakRssKb\": " << peakResidentKb() << ",\n  \"phases\": [";
+        const auto sorted = getPhases();
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            const Phase& p = sorted[i];
+            out << (i ? ",\n" : "\n")
+                << "    {\"file\": " << Json::quote(p.file)
+                << ", \"phase\": " << Json::quote(p.name)
+                << ", \"thread\": " << p.thread
+                << ", \"depth\": " << p.depth
+                << ", \"startUs\": " << number(p.startUs)
+                << ", \"durationUs\": " << number(p.durationUs)
+                << ", \"allocations\": " << p.allocations
+                << ", \"allocatedBytes\": " << p.allocatedBytes
+                << ", \"peakRssKb\": " << p.peakRssKb << "}";
+        }
+        out << "\n  ]\n}\n";
+        return out.str();
+    }
+
+    std::string PhaseProfiler::toChromeTrace() const {
+        std::ostringstream out;
+        out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+        const auto sorted = getPhases();
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            const Phase& p = sorted[i];
+            out << (i ? ",\n" : "\n")
+                << "  {\"name\": " << Json::quote(p.name)
+                << ", \"cat\": \"translator\", \"ph\": \"X\", \"pid\": 1"
+                << ", \"tid\": " << p.thread
+                << ", \"ts\": " << number(p.startUs)
+                << ", \"dur\": " << number(p.durationUs)
+                << ", \"args\": {\"file\": " << Json::quote(p.file)
+                << ", \"allocations\": " << p.allocations
+                << ", \"allocatedBytes\": " << p.allocatedBytes
+                << ", \"peakRssKb\": " << p.peakRssKb << "}}";
+        }
+        out << "\n]}\n";
+        return out.str();
+    }
+
+    bool PhaseProfiler::write(const std::string& path, Format format) const {
+        std::ofstream file(path);
+        if (!file.is_open()) return false;
+        file << (format == Format::ChromeTrace ? toChromeTrace() : toJson());
+        return static_cast<bool>(file);
+    }
+
+} // namespace LiveSpice
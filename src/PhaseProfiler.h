@@ -0,0 +1,169 @@
+#pragma once
+
+#include "TraceZones.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace LiveSpice {
+
+    // ============================================================================
+    // Phase Profiler - Wall time, allocations and peak RSS per pipeline phase
+    // ============================================================================
+
+    /**
+     * Allocation counters for the calling thread. The global operator new in
+     * PhaseProfiler.cpp bumps them; programs that don't link that file leave
+     * them at zero, and phases then report no allocations.
+     */
+    namespace AllocationCounters {
+        inline thread_local uint64_t count = 0;
+        inline thread_local uint64_t bytes = 0;
+    }
+
+    /** Process resident-set high-water mark in KiB */
+    inline size_t peakResidentKb() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+        return counters.PeakWorkingSetSize / 1024;
+#else
+        struct rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+        return static_cast<size_t>(usage.ru_maxrss) / 1024;  // bytes on macOS
+#else
+        return static_cast<size_t>(usage.ru_maxrss);         // KiB on Linux
+#endif
+#endif
+    }
+
+    /**
+     * Collects nested, named phases from any number of threads. A thread is
+     * attached to a profiler with attach(); after that every Scope on the
+     * thread records its wall time, the allocations made while it was open
+     * and the process peak RSS when it closed. Scopes on unattached threads
+     * only read the clock, so library code can mark phases unconditionally.
+     */
+    class PhaseProfiler {
+    public:
+        enum class Format { Json, ChromeTrace };
+
+        struct Phase {
+            std::string file;           // Schematic being processed
+            std::string name;
+            uint32_t thread = 0;        // Worker index
+            int depth = 0;              // Nesting level within the file
+            double startUs = 0.0;       // Since the profiler was created
+            double durationUs = 0.0;
+            uint64_t allocations = 0;
+            uint64_t allocatedBytes = 0;
+            size_t peakRssKb = 0;
+        };
+
+        /**
+         * RAII phase marker
+         */
+        class Scope {
+        public:
+            explicit Scope(const char* name)
+                : name(name), start(std::chrono::steady_clock::now()),
+                  allocations(AllocationCounters::count), allocatedBytes(AllocationCounters::bytes)
+#if LIVESPICE_TRACE
+                , zone(name)
+#endif
+            {
+                ++context().depth;
+            }
+
+            ~Scope() {
+                ThreadContext& ctx = context();
+                --ctx.depth;
+                if (!ctx.profiler) return;
+
+                Phase phase;
+                phase.file = ctx.file;
+                phase.name = name;
+                phase.thread = ctx.thread;
+                phase.depth = ctx.depth;
+                phase.startUs = std::chrono::duration<double, std::micro>(start - ctx.profiler->origin).count();
+                phase.durationUs = std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - start).count();
+                phase.allocations = AllocationCounters::count - allocations;
+                phase.allocatedBytes = AllocationCounters::bytes - allocatedBytes;
+                phase.peakRssKb = peakResidentKb();
+                ctx.profiler->record(std::move(phase));
+            }
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            const char* name;
+            std::chrono::steady_clock::time_point start;
+            uint64_t allocations;
+            uint64_t allocatedBytes;
+#if LIVESPICE_TRACE
+            LiveSpiceDSP::TraceZone zone;   // Phases also land in the TraceSession capture
+#endif
+        };
+
+        /**
+         * Route the calling thread's scopes into profiler (nullptr detaches)
+         */
+        static void attach(PhaseProfiler* profiler, std::string file = {}, uint32_t thread = 0) {
+            ThreadContext& ctx = context();
+            ctx.profiler = profiler;
+            ctx.file = std::move(file);
+            ctx.thread = thread;
+        }
+
+        /** Recorded phases ordered by thread, then start time */
+        std::vector<Phase> getPhases() const;
+
+        /** {"peakRssKb": N, "phases": [...]} */
+        std::string toJson() const;
+
+        /** Chrome trace event format (chrome://tracing, Perfetto) */
+        std::string toChromeTrace() const;
+
+        /** Write in the given format; false when the file cannot be written */
+        bool write(const std::string& path, Format format) const;
+
+    private:
+        struct ThreadContext {
+            PhaseProfiler* profiler = nullptr;
+            std::string file;
+            uint32_t thread = 0;
+            int depth = 0;
+        };
+
+        static ThreadContext& context() {
+            static thread_local ThreadContext ctx;
+            return ctx;
+        }
+
+        void record(Phase phase) {
+            std::lock_guard<std::mutex> lock(mutex);
+            phases.push_back(std::move(phase));
+        }
+
+        std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+        mutable std::mutex mutex;
+        std::vector<Phase> phases;
+    };
+
+} // namespace LiveSpice
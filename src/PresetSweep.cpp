@@ -0,0 +1,103 @@
+#include "PresetSweep.h"
+#include <cmath>
+#include <algorithm>
+
+namespace LiveSpiceDSP {
+
+// ============================================================================
+// PresetSweep Implementation
+// ============================================================================
+
+PresetSweep::PresetSweep(float sampleRate, size_t numClipperStages, size_t maxPointsPerPass) {
+    // Whole lane groups: a partial group would cost the same per pass
+    const size_t lanes = MultiPedalEngine::LANES;
+    const size_t capacity = ((std::max<size_t>(maxPointsPerPass, 1) + lanes - 1) / lanes) * lanes;
+    m_engine = std::make_unique<MultiPedalEngine>(capacity, sampleRate, numClipperStages);
+
+    m_outputs.assign(capacity, std::vector<float>(BLOCK_SIZE));
+    for (auto& output : m_outputs) {
+        m_outputPtrs.push_back(output.data());
+    }
+    m_accumulators.resize(capacity);
+}
+
+std::vector<SweepLoss> PresetSweep::run(const std::vector<SweepPoint>& points, const float* input,
+                                        const float* reference, size_t numSamples) {
+    std::vector<SweepLoss> losses(points.size());
+    const size_t capacity = m_engine->getNumInstances();
+
+    for (size_t first = 0; first < points.size(); first += capacity) {
+        const size_t count = std::min(capacity, points.size() - first);
+
+        // Idle instances repeat the last point; their scores are dropped
+        m_engine->reset();
+        for (size_t v = 0; v < capacity; ++v) {
+            const SweepPoint& p = points[first + std::min(v, count - 1)];
+            m_engine->setDrive(v, p.driveDb);
+            m_engine->setToneGains(v, p.bassDb, p.midDb, p.trebleDb);
+            m_engine->setVolume(v, p.levelDb);
+        }
+        std::fill(m_accumulators.begin(), m_accumulators.end(), Accumulator());
+
+        for (size_t offset = 0; offset < numSamples; offset += BLOCK_SIZE) {
+            const size_t n = std::min(BLOCK_SIZE, numSamples - offset);
+            m_engine->processShared(input + offset, m_outputPtrs.data(), n);
+
+            const float* ref = reference + offset;
+            for (size_t v = 0; v < count; ++v) {
+                const float* out = m_outputs[v].data();
+                Accumulator& acc = m_accumulators[v];
+                for (size_t i = 0; i < n; ++i) {
+                    const double r = ref[i], t = out[i];
+                    const double d = r - t;
+                    acc.sumSquaredError += d * d;
+                    acc.sumRef += r;
+                    acc.sumTarget += t;
+                    acc.sumRefRef += r * r;
+                    acc.sumTargetTarget += t * t;
+                    acc.sumRefTarget += r * t;
+                    acc.peakError = std::max(acc.peakError, static_cast<float>(std::abs(d)));
+                }
+            }
+        }
+
+        const double N = static_cast<double>(std::max<size_t>(numSamples, 1));
+        for (size_t v = 0; v < count; ++v) {
+            const Accumulator& acc = m_accumulators[v];
+            SweepLoss& loss = losses[first + v];
+            loss.rmsError = static_cast<float>(std::sqrt(acc.sumSquaredError / N));
+            loss.peakError = acc.peakError;
+
+            const double covariance = acc.sumRefTarget - acc.sumRef * acc.sumTarget / N;
+            const double varRef = acc.sumRefRef - acc.sumRef * acc.sumRef / N;
+            const double varTarget = acc.sumTargetTarget - acc.sumTarget * acc.sumTarget / N;
+            loss.correlation = (varRef > 0.0 && varTarget > 0.0)
+                ? static_cast<float>(covariance / std::sqrt(varRef * varTarget)) : 0.0f;
+        }
+    }
+    return losses;
+}
+
+std::vector<SweepPoint> PresetSweep::grid(const std::vector<float>& driveDb, const std::vector<float>& bassDb,
+                                          const std::vector<float>& midDb, const std::vector<float>& trebleDb,
+                                          const std::vector<float>& levelDb) {
+    std::vector<SweepPoint> points;
+    points.reserve(driveDb.size() * bassDb.size() * midDb.size() * trebleDb.size() * levelDb.size());
+    for (float drive : driveDb)
+        for (float bass : bassDb)
+            for (float mid : midDb)
+                for (float treble : trebleDb)
+                    for (float level : levelDb)
+                        points.push_back({drive, bass, mid, treble, level});
+    return points;
+}
+
+size_t PresetSweep::best(const std::vector<SweepLoss>& losses) {
+    size_t best = 0;
+    for (size_t i = 1; i < losses.size(); ++i) {
+        if (losses[i].rmsError < losses[best].rmsError) best = i;
+    }
+    return best;
+}
+
+} // namespace LiveSpiceDSP
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "MultiPedalEngine.h"
+#include <vector>
+#include <memory>
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file PresetSweep.h
+ * @brief Score many parameter settings of one pedal against a reference
+ *
+ * Calibration grid searches render the same input at every point of a
+ * drive/tone/level grid and compare each render with a reference. One
+ * MultiStagePedal per point runs the whole chain K times; PresetSweep loads
+ * the points into the lanes of a MultiPedalEngine instead, feeds every lane
+ * the same input block and accumulates each lane's error against the
+ * reference as the blocks go by, so K points cost about K / LANES passes of
+ * the vectorised chain plus the per-lane dynamics tail.
+ *
+ * Each lane scores exactly what a MultiStagePedal at that point would (see
+ * MultiPedalEngine for the modelled chain). Points beyond the engine's
+ * capacity run in further passes over the input.
+ */
+
+/**
+ * One parameter vector (dB values as in MultiStagePedal's setters)
+ */
+struct SweepPoint {
+    float driveDb = 0.0f;
+    float bassDb = 0.0f;
+    float midDb = 0.0f;
+    float trebleDb = 0.0f;
+    float levelDb = 0.0f;
+};
+
+/**
+ * Error of one point's render against the reference
+ */
+struct SweepLoss {
+    float rmsError = 0.0f;      // Root mean square difference
+    float correlation = 0.0f;   // Pearson correlation (1 = same shape)
+    float peakError = 0.0f;     // Largest absolute difference
+};
+
+class PresetSweep {
+public:
+    static constexpr size_t BLOCK_SIZE = 512;
+
+    /**
+     * @param sampleRate Sample rate (Hz) of input and reference
+     * @param numClipperStages Clipper cascade length of the swept pedal
+     * @param maxPointsPerPass Engine capacity: points rendered per pass
+     */
+    PresetSweep(float sampleRate = 44100.0f, size_t numClipperStages = 1, size_t maxPointsPerPass = 64);
+
+    /**
+     * Render input at every point and score it against reference
+     * @return One loss per point, in point order
+     */
+    std::vector<SweepLoss> run(const std::vector<SweepPoint>& points, const float* input,
+                               const float* reference, size_t numSamples);
+
+    /**
+     * Cartesian product of the axes, drive varying slowest and level fastest
+     */
+    static std::vector<SweepPoint> grid(const std::vector<float>& driveDb, const std::vector<float>& bassDb,
+                                        const std::vector<float>& midDb, const std::vector<float>& trebleDb,
+                                        const std::vector<float>& levelDb);
+
+    /**
+     * Index of the lowest RMS error (0 for an empty list)
+     */
+    static size_t best(const std::vector<SweepLoss>& losses);
+
+    size_t getMaxPointsPerPass() const { return m_engine->getNumInstances(); }
+
+private:
+    /**
+     * Running sums for one lane's loss
+     */
+    struct Accumulator {
+        double sumSquaredError = 0.0;
+        double sumRef = 0.0, sumTarget = 0.0;
+        double sumRefRef = 0.0, sumTargetTarget = 0.0, sumRefTarget = 0.0;
+        float peakError = 0.0f;
+    };
+
+    std::unique_ptr<MultiPedalEngine> m_engine;
+    std::vector<std::vector<float>> m_outputs;   // One block per engine instance
+    std::vector<float*> m_outputPtrs;
+    std::vector<Accumulator> m_accumulators;
+};
+
+} // namespace LiveSpiceDSP
@@ -0,0 +1,116 @@
+#include "RealtimeThreadPool.h"
+#include <algorithm>
+#include <chrono>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace LiveSpiceDSP {
+
+namespace {
+
+// Spin-wait hint: lets the sibling hyperthread run while we poll
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// After a batch a worker spins this long for the next one before sleeping
+constexpr auto WORKER_SPIN_TIME = std::chrono::milliseconds(5);
+constexpr auto WORKER_SLEEP_TIME = std::chrono::microseconds(200);
+
+constexpr uint64_t packClaim(uint32_t batch, size_t next, size_t count) {
+    return (static_cast<uint64_t>(batch) << 32) | (static_cast<uint64_t>(next) << 16) | static_cast<uint64_t>(count);
+}
+
+}  // namespace
+
+RealtimeThreadPool::RealtimeThreadPool(size_t numWorkers) {
+    if (numWorkers == 0) {
+        numWorkers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    }
+
+    m_workers.reserve(numWorkers);
+    for (size_t i = 0; i < numWorkers; ++i) {
+        m_workers.emplace_back([this] { workerLoop(); });
+
+#if defined(__linux__) || defined(__APPLE__)
+        // Real-time priority where the process may have it; otherwise the default
+        sched_param param{};
+        param.sched_priority = sched_get_priority_max(SCHED_FIFO) - 1;
+        pthread_setschedparam(m_workers.back().native_handle(), SCHED_FIFO, &param);
+#endif
+    }
+}
+
+RealtimeThreadPool::~RealtimeThreadPool() {
+    m_stop.store(true, std::memory_order_relaxed);
+    for (auto& worker : m_workers) worker.join();
+}
+
+void RealtimeThreadPool::run(size_t count, Task task, void* context) {
+    if (count == 0) return;
+    if (m_workers.empty() || count == 1 || count > 0xFFFF) {
+        for (size_t i = 0; i < count; ++i) task(context, i);
+        return;
+    }
+
+    // Every task of the previous batch has finished, so no worker reads these
+    m_task = task;
+    m_context = context;
+    m_done.store(0, std::memory_order_relaxed);
+    m_claim.store(packClaim(++m_batch, 0, count), std::memory_order_release);
+
+    drain();
+    while (m_done.load(std::memory_order_acquire) < count) cpuRelax();
+}
+
+void RealtimeThreadPool::drain() {
+    uint64_t claim = m_claim.load(std::memory_order_acquire);
+    for (;;) {
+        const size_t next = static_cast<size_t>((claim >> 16) & 0xFFFF);
+        const size_t count = static_cast<size_t>(claim & 0xFFFF);
+        if (next >= count) return;
+
+        if (m_claim.compare_exchange_weak(claim, claim + (uint64_t{1} << 16), std::memory_order_acq_rel,
+                                          std::memory_order_acquire)) {
+            // The claimed task is unfinished, so the batch and its fields are live
+            m_task(m_context, next);
+            m_done.fetch_add(1, std::memory_order_release);
+            claim = m_claim.load(std::memory_order_acquire);
+        }
+    }
+}
+
+void RealtimeThreadPool::workerLoop() {
+    auto lastBatch = std::chrono::steady_clock::now();
+    uint64_t seen = m_claim.load(std::memory_order_acquire);
+
+    while (!m_stop.load(std::memory_order_relaxed)) {
+        const uint64_t claim = m_claim.load(std::memory_order_acquire);
+        if (claim != seen) {
+            seen = claim;
+            drain();
+            lastBatch = std::chrono::steady_clock::now();
+            continue;
+        }
+
+        // Spin while batches are arriving (audio is running), sleep once they stop
+        if (std::chrono::steady_clock::now() - lastBatch < WORKER_SPIN_TIME) {
+            cpuRelax();
+        } else {
+            std::this_thread::sleep_for(WORKER_SLEEP_TIME);
+        }
+    }
+}
+
+}  // namespace LiveSpiceDSP
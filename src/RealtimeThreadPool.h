@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file RealtimeThreadPool.h
+ * @brief Worker threads that help the audio thread through independent tasks
+ *
+ * run() publishes a batch of tasks and then works through it on the calling
+ * thread; idle workers claim tasks from the same counter, so whichever
+ * thread is free takes the next one. Nothing waits on a worker that has not
+ * started: the caller claims what is left itself and only spins for tasks
+ * already running elsewhere. No locks, no allocation after construction.
+ *
+ * Workers spin for a few milliseconds after each batch so consecutive audio
+ * blocks find them awake, then fall back to short sleeps. They ask for
+ * real-time scheduling where the process is allowed it.
+ */
+class RealtimeThreadPool {
+public:
+    /** Task i of a batch; context is the pointer handed to run() */
+    using Task = void (*)(void* context, size_t index);
+
+    /**
+     * Start numWorkers threads (0 = hardware threads - 1); not real-time safe
+     */
+    explicit RealtimeThreadPool(size_t numWorkers = 0);
+    ~RealtimeThreadPool();
+
+    RealtimeThreadPool(const RealtimeThreadPool&) = delete;
+    RealtimeThreadPool& operator=(const RealtimeThreadPool&) = delete;
+
+    /**
+     * Run task(context, i) for i in [0, count) and return when all are done
+     * Call from one thread at a time (the audio thread). Real-time safe.
+     */
+    void run(size_t count, Task task, void* context);
+
+    size_t getNumWorkers() const { return m_workers.size(); }
+
+private:
+    // Claim word: batch number (high 32 bits) | next task (16) | task count (16)
+    std::atomic<uint64_t> m_claim{0};
+    std::atomic<size_t> m_done{0};
+    std::atomic<bool> m_stop{false};
+    Task m_task = nullptr;
+    void* m_context = nullptr;
+    uint32_t m_batch = 0;
+
+    std::vector<std::thread> m_workers;
+
+    /** Claim and run tasks of the current batch until none are left */
+    void drain();
+    void workerLoop();
+};
+
+}  // namespace LiveSpiceDSP
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file SampleRateCache.h
+ * @brief Shared per-sample-rate precomputation (coefficient tables, models)
+ *
+ * Hosts re-prepare often: rate switches, offline bounces, every instance
+ * of a plugin on load. acquire() builds the value for a rate once and
+ * hands every later caller the same immutable copy, so re-preparing at a
+ * rate seen before is a lookup.
+ *
+ * Values for the standard rates (44.1, 48, 88.2, 96, 192 kHz) stay cached
+ * for the life of the cache, so switching away and back does not rebuild
+ * them. Other rates are held weakly and dropped with their last user.
+ * Thread-safe, not real-time safe; call from prepare/constructor code.
+ */
+template <typename T>
+class SampleRateCache {
+public:
+    static constexpr std::array<double, 5> STANDARD_RATES{44100.0, 48000.0, 88200.0, 96000.0, 192000.0};
+
+    static bool isStandardRate(double sampleRate) {
+        for (double rate : STANDARD_RATES) {
+            if (rate == sampleRate) return true;
+        }
+        return false;
+    }
+
+    /**
+     * The value for sampleRate, calling build(sampleRate) -> T on a miss
+     */
+    template <typename Build>
+    std::shared_ptr<const T> acquire(double sampleRate, Build&& build) {
+        uint64_t key;
+        std::memcpy(&key, &sampleRate, sizeof(key));
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (auto it = m_entries.find(key); it != m_entries.end()) {
+            if (auto value = it->second.lock()) return value;
+        }
+
+        for (auto it = m_entries.begin(); it != m_entries.end();) {
+            it = it->second.expired() ? m_entries.erase(it) : std::next(it);
+        }
+
+        std::shared_ptr<const T> value = std::make_shared<const T>(build(sampleRate));
+        m_entries[key] = value;
+        if (isStandardRate(sampleRate)) m_pinned[key] = value;
+        return value;
+    }
+
+    /**
+     * Number of rates with a live value
+     */
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        size_t count = 0;
+        for (const auto& entry : m_entries) count += entry.second.expired() ? 0 : 1;
+        return count;
+    }
+
+private:
+    mutable std::mutex m_mutex;
+    std::map<uint64_t, std::weak_ptr<const T>> m_entries;
+    std::map<uint64_t, std::shared_ptr<const T>> m_pinned;   // Standard rates only
+};
+
+}  // namespace LiveSpiceDSP
@@ -0,0 +1,338 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file ScopeFifo.h
+ * @brief Lock-free multi-channel sample FIFO for scopes and level meters
+ *
+ * ScopeFifo carries blocks of samples from the audio thread to a display
+ * thread. The ring is allocated once at construction; push() never locks,
+ * allocates or waits. When the reader falls behind, the samples that do not
+ * fit are dropped (the audio thread is never held back) and counted, so the
+ * display can report the gap. Exactly one thread may push and one may read.
+ *
+ * ScopeCapture is the display side: it drains a ScopeFifo, finds a trigger
+ * (edge, level, hysteresis, holdoff) and reduces each captured frame to
+ * min/max pairs per display column, so a 4096-sample frame drawn 256 pixels
+ * wide keeps its peaks.
+ */
+
+class ScopeFifo {
+public:
+    /**
+     * @param numChannels Channels per sample frame
+     * @param capacity    Samples per channel, rounded up to a power of two
+     */
+    ScopeFifo(int numChannels, size_t capacity)
+        : m_numChannels(std::max(1, numChannels)) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        m_capacity = size;
+        m_samples.assign(m_capacity * (size_t)m_numChannels, 0.0f);
+    }
+
+    ScopeFifo(const ScopeFifo&) = delete;
+    ScopeFifo& operator=(const ScopeFifo&) = delete;
+
+    /**
+     * Producer side. Channels past numChannels are written as silence;
+     * returns how many samples were stored (the rest counts as overrun)
+     */
+    size_t push(const float* const* channels, int numChannels, size_t numSamples) noexcept {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        size_t space = m_capacity - (tail - m_head.load(std::memory_order_acquire));
+        size_t count = std::min(space, numSamples);
+
+        if (count < numSamples) {
+            m_overruns.fetch_add(1, std::memory_order_relaxed);
+            m_droppedSamples.fetch_add(numSamples - count, std::memory_order_relaxed);
+        }
+        if (count == 0) return 0;
+
+        size_t start = tail & (m_capacity - 1);
+        size_t first = std::min(count, m_capacity - start);
+        for (int ch = 0; ch < m_numChannels; ++ch) {
+            float* ring = &m_samples[(size_t)ch * m_capacity];
+            const float* source = (ch < numChannels) ? channels[ch] : nullptr;
+            if (source) {
+                std::copy(source, source + first, ring + start);
+                std::copy(source + first, source + count, ring);
+            } else {
+                std::fill(ring + start, ring + start + first, 0.0f);
+                std::fill(ring, ring + (count - first), 0.0f);
+            }
+        }
+
+        m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * Consumer side: copy up to maxSamples per channel into dest
+     * (getNumChannels() pointers, nullptr entries are skipped)
+     */
+    size_t pop(float* const* dest, size_t maxSamples) noexcept {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        size_t count = std::min(maxSamples, m_tail.load(std::memory_order_acquire) - head);
+        if (count == 0) return 0;
+
+        size_t start = head & (m_capacity - 1);
+        size_t first = std::min(count, m_capacity - start);
+        for (int ch = 0; ch < m_numChannels; ++ch) {
+            if (!dest[ch]) continue;
+            const float* ring = &m_samples[(size_t)ch * m_capacity];
+            std::copy(ring + start, ring + start + first, dest[ch]);
+            std::copy(ring, ring + (count - first), dest[ch] + first);
+        }
+
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    /**
+     * Consumer side: discard up to numSamples (catching up with the writer)
+     */
+    size_t skip(size_t numSamples) noexcept {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        size_t count = std::min(numSamples, m_tail.load(std::memory_order_acquire) - head);
+        m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    size_t getNumReady() const noexcept {
+        return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+    }
+
+    int getNumChannels() const { return m_numChannels; }
+    size_t capacity() const { return m_capacity; }
+
+    // Pushes that could not store every sample, and the samples lost (any thread)
+    uint64_t getOverruns() const { return m_overruns.load(std::memory_order_relaxed); }
+    uint64_t getDroppedSamples() const { return m_droppedSamples.load(std::memory_order_relaxed); }
+
+private:
+    int m_numChannels;
+    size_t m_capacity = 0;
+    std::vector<float> m_samples;                   // Channel-major: [channel * capacity + index]
+
+    alignas(64) std::atomic<size_t> m_head{0};
+    alignas(64) std::atomic<size_t> m_tail{0};
+    std::atomic<uint64_t> m_overruns{0};
+    std::atomic<uint64_t> m_droppedSamples{0};
+};
+
+/**
+ * One captured frame, reduced to display columns
+ */
+struct ScopeFrame {
+    int numChannels = 0;
+    size_t numPoints = 0;
+    std::vector<float> minimum;                     // [channel * numPoints + point]
+    std::vector<float> maximum;
+    bool triggered = false;                         // false: auto or free-run capture
+
+    float getMin(int channel, size_t point) const { return minimum[(size_t)channel * numPoints + point]; }
+    float getMax(int channel, size_t point) const { return maximum[(size_t)channel * numPoints + point]; }
+};
+
+struct ScopeSettings {
+    enum class Mode {
+        FreeRun,                                    // Consecutive frames, no trigger
+        Auto,                                       // Trigger, free-run after autoTimeout
+        Normal                                      // Only triggered frames
+    };
+    enum class Slope { Rising, Falling };
+
+    Mode mode = Mode::Auto;
+    Slope slope = Slope::Rising;
+    int channel = 0;                                // Trigger source
+    float level = 0.0f;
+    float hysteresis = 0.01f;                       // Re-arm distance below (rising) / above (falling) level
+    size_t frameLength = 2048;                      // Samples per frame
+    size_t preTrigger = 256;                        // Samples shown before the trigger point
+    size_t holdoff = 0;                             // Samples ignored after each frame
+    size_t autoTimeout = 0;                         // Samples without trigger before an auto frame (0: 2 frames)
+    size_t displayPoints = 256;                     // Min/max columns per frame
+};
+
+/**
+ * ScopeCapture - display-side trigger and decimation over a ScopeFifo
+ *
+ * update() runs on the reader thread (UI timer, analysis loop); it is the
+ * only code that allocates, and only when the settings change.
+ */
+class ScopeCapture {
+public:
+    explicit ScopeCapture(int numChannels, const ScopeSettings& settings = {})
+        : m_numChannels(std::max(1, numChannels)) {
+        setSettings(settings);
+    }
+
+    void setSettings(const ScopeSettings& settings) {
+        m_settings = settings;
+        m_settings.frameLength = std::max<size_t>(2, m_settings.frameLength);
+        m_settings.preTrigger = std::min(m_settings.preTrigger, m_settings.frameLength - 1);
+        m_settings.displayPoints = std::clamp<size_t>(m_settings.displayPoints, 1, m_settings.frameLength);
+        m_settings.channel = std::clamp(m_settings.channel, 0, m_numChannels - 1);
+        if (m_settings.autoTimeout == 0) m_settings.autoTimeout = 2 * m_settings.frameLength;
+
+        m_historySize = 2 * m_settings.frameLength;
+        m_history.assign((size_t)m_numChannels, std::vector<float>(m_historySize, 0.0f));
+        m_pointers.assign((size_t)m_numChannels, nullptr);
+        reset();
+    }
+
+    const ScopeSettings& getSettings() const { return m_settings; }
+
+    /**
+     * Forget buffered samples and trigger state (reader thread)
+     */
+    void reset() {
+        m_count = 0;
+        m_scan = 0;
+        m_triggerAt = npos;
+        m_armed = false;
+        m_holdoffRemaining = 0;
+        m_untriggered = 0;
+    }
+
+    /**
+     * Drain the FIFO; returns true when frame holds a newer capture. When the
+     * reader has fallen far behind, the oldest samples are skipped so the
+     * display follows the signal rather than replaying a backlog.
+     */
+    bool update(ScopeFifo& fifo, ScopeFrame& frame) {
+        size_t ready = fifo.getNumReady();
+        if (ready > 2 * m_historySize) {
+            fifo.skip(ready - m_historySize);
+            reset();
+        }
+
+        bool produced = false;
+        for (;;) {
+            if (m_holdoffRemaining > 0) m_holdoffRemaining -= fifo.skip(m_holdoffRemaining);
+            if (m_holdoffRemaining > 0) break;
+
+            for (int ch = 0; ch < m_numChannels; ++ch)
+                m_pointers[(size_t)ch] = (ch < fifo.getNumChannels()) ? m_history[(size_t)ch].data() + m_count : nullptr;
+            size_t popped = fifo.pop(m_pointers.data(), m_historySize - m_count);
+            m_count += popped;
+
+            bool progressed = (m_settings.mode == ScopeSettings::Mode::FreeRun) ? captureFreeRun(frame)
+                                                                                  : captureTriggered(frame);
+            produced |= progressed;
+            if (popped == 0 && !progressed) break;
+        }
+        return produced;
+    }
+
+private:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    int m_numChannels;
+    ScopeSettings m_settings;
+    size_t m_historySize = 0;
+    std::vector<std::vector<float>> m_history;      // Linear window, oldest sample first
+    std::vector<float*> m_pointers;
+    size_t m_count = 0;                             // Samples in the window
+    size_t m_scan = 0;                              // Next sample to test for a trigger
+    size_t m_triggerAt = npos;                      // Pending trigger waiting for post-trigger samples
+    bool m_armed = false;
+    size_t m_holdoffRemaining = 0;
+    size_t m_untriggered = 0;                       // Samples scanned since the last frame
+
+    bool captureFreeRun(ScopeFrame& frame) {
+        if (m_count < m_settings.frameLength) return false;
+        decimate(m_count - m_settings.frameLength, false, frame);
+        m_count = 0;
+        m_holdoffRemaining = m_settings.holdoff;
+        return true;
+    }
+
+    bool captureTriggered(ScopeFrame& frame) {
+        const float* source = m_history[(size_t)m_settings.channel].data();
+        const bool rising = (m_settings.slope == ScopeSettings::Slope::Rising);
+        const float rearm = rising ? m_settings.level - m_settings.hysteresis : m_settings.level + m_settings.hysteresis;
+
+        while (m_triggerAt == npos && m_scan < m_count) {
+            float x = source[m_scan];
+            if (!m_armed) {
+                m_armed = rising ? (x < rearm) : (x > rearm);
+            } else if (rising ? (x >= m_settings.level) : (x <= m_settings.level)) {
+                m_armed = false;
+                if (m_scan >= m_settings.preTrigger) m_triggerAt = m_scan;
+            }
+            ++m_scan;
+            ++m_untriggered;
+        }
+
+        const size_t post = m_settings.frameLength - m_settings.preTrigger;
+        if (m_triggerAt != npos) {
+            // Slide the window so the whole frame fits before waiting for the rest
+            if (m_triggerAt > m_settings.preTrigger) {
+                size_t shift = m_triggerAt - m_settings.preTrigger;
+                discard(shift);
+                m_triggerAt -= shift;
+            }
+            if (m_count < m_triggerAt + post) return false;
+            decimate(m_triggerAt - m_settings.preTrigger, true, frame);
+            discard(m_triggerAt + post);
+            m_triggerAt = npos;
+            m_untriggered = 0;
+            m_holdoffRemaining = m_settings.holdoff;
+            return true;
+        }
+
+        bool produced = false;
+        if (m_settings.mode == ScopeSettings::Mode::Auto && m_untriggered >= m_settings.autoTimeout &&
+            m_count >= m_settings.frameLength) {
+            decimate(m_count - m_settings.frameLength, false, frame);
+            m_untriggered = 0;
+            produced = true;
+        }
+
+        // Keep only what the next trigger (or auto frame) could need
+        size_t keep = (m_settings.mode == ScopeSettings::Mode::Auto) ? m_settings.frameLength : m_settings.preTrigger;
+        if (m_count > keep) discard(m_count - keep);
+        return produced;
+    }
+
+    void discard(size_t numSamples) {
+        numSamples = std::min(numSamples, m_count);
+        for (auto& channel : m_history)
+            std::copy(channel.begin() + (std::ptrdiff_t)numSamples, channel.begin() + (std::ptrdiff_t)m_count,
+                      channel.begin());
+        m_count -= numSamples;
+        m_scan = (m_scan > numSamples) ? m_scan - numSamples : 0;
+    }
+
+    void decimate(size_t start, bool triggered, ScopeFrame& frame) const {
+        const size_t points = m_settings.displayPoints;
+        const size_t length = m_settings.frameLength;
+        frame.numChannels = m_numChannels;
+        frame.numPoints = points;
+        frame.triggered = triggered;
+        frame.minimum.resize((size_t)m_numChannels * points);
+        frame.maximum.resize((size_t)m_numChannels * points);
+
+        for (int ch = 0; ch < m_numChannels; ++ch) {
+            const float* samples = m_history[(size_t)ch].data() + start;
+            for (size_t p = 0; p < points; ++p) {
+                size_t begin = p * length / points;
+                size_t end = std::max(begin + 1, (p + 1) * length / points);
+                auto [lo, hi] = std::minmax_element(samples + begin, samples + end);
+                frame.minimum[(size_t)ch * points + p] = *lo;
+                frame.maximum[(size_t)ch * points + p] = *hi;
+            }
+        }
+    }
+};
+
+} // namespace LiveSpiceDSP
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file SharedContext.h
+ * @brief Process-wide state shared by every instance of a plugin
+ *
+ * A session with twenty instances of one generated plugin would otherwise
+ * resolve the same device parameters, bake the same tables and solve the
+ * same per-rate models twenty times. acquire() builds T for the first
+ * instance and hands every later one the same object; the last instance to
+ * release it frees it, so unloading the plugin leaves nothing behind.
+ *
+ * T holds only what does not change per instance: immutable data, plus
+ * internally synchronised caches such as SampleRateCache. Thread-safe, not
+ * real-time safe; acquire from constructors or prepare code.
+ */
+template <typename T>
+class SharedContext {
+public:
+    /**
+     * The live T, calling build() -> std::shared_ptr<T> when there is none
+     */
+    template <typename Build>
+    static std::shared_ptr<T> acquire(Build&& build) {
+        std::lock_guard<std::mutex> lock(mutex());
+        if (auto context = instance().lock()) return context;
+
+        std::shared_ptr<T> context = build();
+        instance() = context;
+        return context;
+    }
+
+    static std::shared_ptr<T> acquire() {
+        return acquire([] { return std::make_shared<T>(); });
+    }
+
+    /**
+     * Number of holders of the live T (0 when none is alive)
+     */
+    static long useCount() {
+        std::lock_guard<std::mutex> lock(mutex());
+        return instance().use_count();
+    }
+
+private:
+    static std::mutex& mutex() {
+        static std::mutex m;
+        return m;
+    }
+
+    static std::weak_ptr<T>& instance() {
+        static std::weak_ptr<T> context;
+        return context;
+    }
+};
+
+} // namespace LiveSpiceDSP
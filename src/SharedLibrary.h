@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace LiveSpice {
+
+    // ============================================================================
+    // Run-time Loaded Shared Library
+    // ============================================================================
+
+    /**
+     * A shared library opened for the object's lifetime, for optional
+     * dependencies (libngspice) that the translator must build and run
+     * without.
+     */
+    class SharedLibrary {
+    public:
+        explicit SharedLibrary(const std::string& path) {
+#ifdef _WIN32
+            m_handle = LoadLibraryA(path.c_str());
+            if (!m_handle) m_error = "cannot load " + path + " (error " + std::to_string(GetLastError()) + ")";
+#else
+            m_handle = ::dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+            if (!m_handle) {
+                const char* error = ::dlerror();
+                m_error = error ? error : "cannot load " + path;
+            }
+#endif
+        }
+
+        ~SharedLibrary() {
+#ifdef _WIN32
+            if (m_handle) FreeLibrary(m_handle);
+#else
+            if (m_handle) ::dlclose(m_handle);
+#endif
+        }
+
+        SharedLibrary(const SharedLibrary&) = delete;
+        SharedLibrary& operator=(const SharedLibrary&) = delete;
+
+        bool isOpen() const { return m_handle != nullptr; }
+        const std::string& error() const { return m_error; }
+
+        /** Exported function, or nullptr */
+        template <typename Function>
+        Function* symbol(const char* name) const {
+            if (!m_handle) return nullptr;
+#ifdef _WIN32
+            return reinterpret_cast<Function*>(GetProcAddress(m_handle, name));
+#else
+            return reinterpret_cast<Function*>(::dlsym(m_handle, name));
+#endif
+        }
+
+    private:
+#ifdef _WIN32
+        HMODULE m_handle = nullptr;
+#else
+        void* m_handle = nullptr;
+#endif
+        std::string m_error;
+    };
+
+} // namespace LiveSpice
@@ -0,0 +1,242 @@
+#include "SparseLU.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
+
+namespace LiveSpiceDSP {
+
+namespace {
+    // Below this fraction of the matrix's largest entry a pivot counts as zero
+    constexpr double SINGULAR_TOLERANCE = 1e-14;
+
+    bool byColumn(const SparseMatrix::Entry& entry, size_t col) { return entry.first < col; }
+}
+
+// ============================================================================
+// Sparse Matrix
+// ============================================================================
+
+void SparseMatrix::add(size_t row, size_t col, double value) {
+    auto& entries = m_rows[row];
+    auto it = std::lower_bound(entries.begin(), entries.end(), col, byColumn);
+    if (it != entries.end() && it->first == col) {
+        it->second += value;
+    } else {
+        entries.insert(it, {col, value});
+    }
+}
+
+double SparseMatrix::get(size_t row, size_t col) const {
+    const auto& entries = m_rows[row];
+    auto it = std::lower_bound(entries.begin(), entries.end(), col, byColumn);
+    return it != entries.end() && it->first == col ? it->second : 0.0;
+}
+
+void SparseMatrix::clearValues() {
+    for (auto& entries : m_rows) {
+        for (auto& entry : entries) entry.second = 0.0;
+    }
+}
+
+size_t SparseMatrix::getNonZeros() const {
+    size_t count = 0;
+    for (const auto& entries : m_rows) count += entries.size();
+    return count;
+}
+
+void SparseMatrix::multiply(const std::vector<double>& x, std::vector<double>& y) const {
+    y.assign(m_rows.size(), 0.0);
+    for (size_t r = 0; r < m_rows.size(); ++r) {
+        double sum = 0.0;
+        for (const auto& entry : m_rows[r]) sum += entry.second * x[entry.first];
+        y[r] = sum;
+    }
+}
+
+// ============================================================================
+// Analysis: Markowitz ordering and fill pattern
+// ============================================================================
+
+bool SparseLU::analyze(const SparseMatrix& A) {
+    const size_t n = A.size();
+    m_n = n;
+    m_factored = false;
+    ++m_analyzeCount;
+
+    double largest = 0.0;
+    std::vector<std::map<size_t, double>> rows(n);
+    std::vector<std::set<size_t>> cols(n);   // Active rows with an entry in each column
+    for (size_t r = 0; r < n; ++r) {
+        for (const auto& entry : A.getRow(r)) {
+            rows[r][entry.first] = entry.second;
+            cols[entry.first].insert(r);
+            largest = std::max(largest, std::abs(entry.second));
+        }
+    }
+    const double tiny = SINGULAR_TOLERANCE * largest;
+
+    std::vector<bool> rowDone(n, false), colDone(n, false);
+    std::vector<std::vector<size_t>> lowerSteps(n);   // Per original row: steps that eliminated into it
+    std::vector<std::vector<size_t>> upperCols(n);    // Per step: original columns of the pivot row
+    m_rowPerm.assign(n, 0);
+    m_colPerm.assign(n, 0);
+
+    for (size_t step = 0; step < n; ++step) {
+        std::vector<double> colMax(n, 0.0);
+        for (size_t r = 0; r < n; ++r) {
+            if (rowDone[r]) continue;
+            for (const auto& entry : rows[r]) {
+                colMax[entry.first] = std::max(colMax[entry.first], std::abs(entry.second));
+            }
+        }
+
+        // Smallest Markowitz cost (r - 1)(c - 1) among numerically acceptable entries
+        size_t pivotRow = n, pivotCol = n, bestCost = 0;
+        double bestMagnitude = 0.0;
+        for (size_t r = 0; r < n; ++r) {
+            if (rowDone[r]) continue;
+            for (const auto& entry : rows[r]) {
+                const double magnitude = std::abs(entry.second);
+                if (magnitude <= tiny || magnitude < PIVOT_THRESHOLD * colMax[entry.first]) continue;
+                const size_t cost = (rows[r].size() - 1) * (cols[entry.first].size() - 1);
+                if (pivotRow == n || cost < bestCost || (cost == bestCost && magnitude > bestMagnitude)) {
+                    pivotRow = r;
+                    pivotCol = entry.first;
+                    bestCost = cost;
+                    bestMagnitude = magnitude;
+                }
+            }
+        }
+        if (pivotRow == n) return false;
+
+        m_rowPerm[step] = pivotRow;
+        m_colPerm[step] = pivotCol;
+        rowDone[pivotRow] = true;
+        colDone[pivotCol] = true;
+        for (const auto& entry : rows[pivotRow]) {
+            cols[entry.first].erase(pivotRow);
+            upperCols[step].push_back(entry.first);
+        }
+
+        // Eliminate the pivot column from the other active rows, keeping fill
+        const double pivot = rows[pivotRow][pivotCol];
+        const std::vector<size_t> targets(cols[pivotCol].begin(), cols[pivotCol].end());
+        for (size_t r : targets) {
+            const double factor = rows[r][pivotCol] / pivot;
+            rows[r].erase(pivotCol);
+            cols[pivotCol].erase(r);
+            lowerSteps[r].push_back(step);
+            for (const auto& entry : rows[pivotRow]) {
+                if (entry.first == pivotCol) continue;
+                auto inserted = rows[r].emplace(entry.first, 0.0);
+                inserted.first->second -= factor * entry.second;
+                if (inserted.second) cols[entry.first].insert(r);
+            }
+        }
+    }
+
+    m_colStep.assign(n, 0);
+    for (size_t step = 0; step < n; ++step) m_colStep[m_colPerm[step]] = step;
+
+    m_pattern.assign(n, {});
+    m_values.assign(n, {});
+    m_diag.assign(n, 0);
+    for (size_t step = 0; step < n; ++step) {
+        auto& pattern = m_pattern[step];
+        pattern = lowerSteps[m_rowPerm[step]];
+        for (size_t col : upperCols[step]) pattern.push_back(m_colStep[col]);
+        std::sort(pattern.begin(), pattern.end());
+        m_diag[step] = static_cast<size_t>(std::lower_bound(pattern.begin(), pattern.end(), step) - pattern.begin());
+        m_values[step].assign(pattern.size(), 0.0);
+    }
+    m_work.assign(n, 0.0);
+    m_mark.assign(n, n);
+
+    return refactor(A);
+}
+
+// ============================================================================
+// Numeric Refactorization
+// ============================================================================
+
+bool SparseLU::refactor(const SparseMatrix& A) {
+    if (A.size() != m_n || m_pattern.size() != m_n) return false;
+    m_factored = false;
+    ++m_refactorCount;
+
+    // Row-by-row (up-looking) elimination into the fixed pattern
+    for (size_t step = 0; step < m_n; ++step) {
+        const auto& pattern = m_pattern[step];
+        for (size_t pos : pattern) {
+            m_work[pos] = 0.0;
+            m_mark[pos] = step;
+        }
+        double rowLargest = 0.0;
+        for (const auto& entry : A.getRow(m_rowPerm[step])) {
+            const size_t pos = m_colStep[entry.first];
+            if (m_mark[pos] != step) return false;   // Pattern changed since analyze()
+            m_work[pos] += entry.second;
+            rowLargest = std::max(rowLargest, std::abs(entry.second));
+        }
+
+        for (size_t e = 0; e < m_diag[step]; ++e) {
+            const size_t k = pattern[e];
+            const auto& upper = m_pattern[k];
+            const auto& upperValues = m_values[k];
+            const double l = m_work[k] / upperValues[m_diag[k]];
+            m_work[k] = l;
+            for (size_t u = m_diag[k] + 1; u < upper.size(); ++u) {
+                m_work[upper[u]] -= l * upperValues[u];
+            }
+        }
+
+        auto& values = m_values[step];
+        for (size_t e = 0; e < pattern.size(); ++e) values[e] = m_work[pattern[e]];
+        if (!(std::abs(values[m_diag[step]]) > SINGULAR_TOLERANCE * rowLargest)) return false;
+    }
+
+    m_factored = true;
+    return true;
+}
+
+bool SparseLU::factor(const SparseMatrix& A) {
+    return refactor(A) || analyze(A);
+}
+
+// ============================================================================
+// Solve
+// ============================================================================
+
+void SparseLU::solve(std::vector<double>& b) const {
+    solve(b, 1);
+}
+
+void SparseLU::solve(std::vector<double>& B, size_t cols) const {
+    std::vector<double> y(m_n);
+    for (size_t c = 0; c < cols; ++c) {
+        for (size_t step = 0; step < m_n; ++step) y[step] = B[m_rowPerm[step] * cols + c];
+
+        for (size_t step = 0; step < m_n; ++step) {
+            double sum = y[step];
+            for (size_t e = 0; e < m_diag[step]; ++e) sum -= m_values[step][e] * y[m_pattern[step][e]];
+            y[step] = sum;
+        }
+        for (size_t step = m_n; step-- > 0;) {
+            const auto& pattern = m_pattern[step];
+            double sum = y[step];
+            for (size_t e = m_diag[step] + 1; e < pattern.size(); ++e) sum -= m_values[step][e] * y[pattern[e]];
+            y[step] = sum / m_values[step][m_diag[step]];
+        }
+
+        for (size_t step = 0; step < m_n; ++step) B[m_colPerm[step] * cols + c] = y[step];
+    }
+}
+
+size_t SparseLU::getFactorNonZeros() const {
+    size_t count = 0;
+    for (const auto& pattern : m_pattern) count += pattern.size();
+    return count;
+}
+
+} // namespace LiveSpiceDSP
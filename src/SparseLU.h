@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file SparseLU.h
+ * @brief Sparse LU factorization for circuit (MNA) matrices
+ *
+ * Circuit matrices are mostly empty, and their nonzero pattern stays the
+ * same across Newton iterations and sample-rate changes: only the values of
+ * the companion stamps move. SparseLU therefore splits the work:
+ *
+ *   analyze()   Markowitz pivot ordering with threshold pivoting, and the
+ *               fill pattern of L and U - once per pattern
+ *   refactor()  numeric factorization along that ordering and pattern
+ *   solve()     forward/back substitution for one or many right-hand sides
+ *
+ * JacobianReuse is the chord-method policy for Newton loops on top of it:
+ * keep the last factorization while the residual still shrinks quickly and
+ * refactor only when convergence slows.
+ */
+
+// ============================================================================
+// Sparse Matrix
+// ============================================================================
+
+/**
+ * Square matrix stored as rows of (column, value) sorted by column. Adding
+ * to a new position creates a structural entry; clearValues() keeps the
+ * pattern so a Newton loop can restamp the same positions.
+ */
+class SparseMatrix {
+public:
+    using Entry = std::pair<size_t, double>;
+
+    explicit SparseMatrix(size_t n = 0) : m_rows(n) {}
+
+    size_t size() const { return m_rows.size(); }
+
+    void add(size_t row, size_t col, double value);
+    double get(size_t row, size_t col) const;
+
+    /** Zero every value, keeping the structural entries */
+    void clearValues();
+
+    size_t getNonZeros() const;
+    const std::vector<Entry>& getRow(size_t row) const { return m_rows[row]; }
+
+    /** y = A x */
+    void multiply(const std::vector<double>& x, std::vector<double>& y) const;
+
+private:
+    std::vector<std::vector<Entry>> m_rows;
+};
+
+// ============================================================================
+// Sparse LU
+// ============================================================================
+
+class SparseLU {
+public:
+    /** Pivot candidates must be within this fraction of their column's largest entry */
+    static constexpr double PIVOT_THRESHOLD = 0.1;
+
+    /**
+     * Choose the pivot order and fill pattern for A, then factor it
+     * @return false if A is singular
+     */
+    bool analyze(const SparseMatrix& A);
+
+    /**
+     * Factor A along the analyzed order and pattern
+     * @return false if A has entries outside the analyzed pattern or a pivot
+     *         collapsed (call analyze() again)
+     */
+    bool refactor(const SparseMatrix& A);
+
+    /** refactor(), falling back to a fresh analyze() when it fails */
+    bool factor(const SparseMatrix& A);
+
+    /** Solve A x = b in place */
+    void solve(std::vector<double>& b) const;
+
+    /** Solve A X = B in place (B: n x cols, row-major) */
+    void solve(std::vector<double>& B, size_t cols) const;
+
+    bool isFactored() const { return m_factored; }
+    size_t size() const { return m_n; }
+
+    /** Entries of L and U together, fill included */
+    size_t getFactorNonZeros() const;
+
+    size_t getAnalyzeCount() const { return m_analyzeCount; }
+    size_t getRefactorCount() const { return m_refactorCount; }
+
+private:
+    size_t m_n = 0;
+    bool m_factored = false;
+    size_t m_analyzeCount = 0;
+    size_t m_refactorCount = 0;
+
+    std::vector<size_t> m_rowPerm;    // Pivot step k eliminates original row m_rowPerm[k]
+    std::vector<size_t> m_colPerm;    // ... on original column m_colPerm[k]
+    std::vector<size_t> m_colStep;    // Inverse of m_colPerm
+
+    // Factor row k in pivot order: sorted pivot columns, L (unit diagonal) left of m_diag[k]
+    std::vector<std::vector<size_t>> m_pattern;
+    std::vector<std::vector<double>> m_values;
+    std::vector<size_t> m_diag;
+
+    mutable std::vector<double> m_work;
+    std::vector<size_t> m_mark;
+};
+
+// ============================================================================
+// Chord-Method Policy
+// ============================================================================
+
+/**
+ * Decides when a Newton loop refactors its Jacobian. The first iteration
+ * always does; after that the previous factorization is kept while each
+ * residual is at most `slowdown` times the last one, up to maxAge reuses.
+ */
+class JacobianReuse {
+public:
+    explicit JacobianReuse(double slowdown = 0.5, int maxAge = 8)
+        : m_slowdown(slowdown), m_maxAge(maxAge) {}
+
+    /** Call with the current residual norm before each Newton step */
+    bool refactorNeeded(double residual) {
+        const bool refactor = m_age < 0 || m_age >= m_maxAge || residual > m_slowdown * m_lastResidual;
+        m_age = refactor ? 0 : m_age + 1;
+        m_lastResidual = residual;
+        if (refactor) ++m_refactors;
+        return refactor;
+    }
+
+    void reset() {
+        m_age = -1;
+        m_lastResidual = std::numeric_limits<double>::infinity();
+    }
+
+    int getRefactorCount() const { return m_refactors; }
+
+private:
+    double m_slowdown;
+    int m_maxAge;
+    int m_age = -1;
+    int m_refactors = 0;
+    double m_lastResidual = std::numeric_limits<double>::infinity();
+};
+
+} // namespace LiveSpiceDSP
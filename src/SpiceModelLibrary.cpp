@@ -0,0 +1,485 @@
+#include "SpiceModelLibrary.h"
+#include "ComponentCharacteristicsDatabase.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace LiveSpice {
+
+    namespace {
+
+        constexpr char INDEX_MAGIC[8] = {'L', 'S', 'M', 'O', 'D', 'I', 'D', 'X'};
+        constexpr uint32_t INDEX_VERSION = 1;
+
+        std::string upper(std::string_view text) {
+            std::string result(text);
+            for (char& c : result) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            return result;
+        }
+
+        bool startsWithNoCase(std::string_view text, std::string_view prefix) {
+            if (text.size() < prefix.size()) return false;
+            for (size_t i = 0; i < prefix.size(); ++i) {
+                if (std::tolower(static_cast<unsigned char>(text[i])) != prefix[i]) return false;
+            }
+            return true;
+        }
+
+        bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+        std::string_view trimLeft(std::string_view text) {
+            while (!text.empty() && isSpace(text.front())) text.remove_prefix(1);
+            return text;
+        }
+
+        std::string_view nextToken(std::string_view& text, std::string_view delimiters) {
+            text = trimLeft(text);
+            size_t end = 0;
+            while (end < text.size() && !isSpace(text[end]) && delimiters.find(text[end]) == std::string_view::npos) ++end;
+            std::string_view token = text.substr(0, end);
+            text.remove_prefix(end);
+            return token;
+        }
+
+        SpiceModelLibrary::ModelKind kindOf(std::string_view type) {
+            using Kind = SpiceModelLibrary::ModelKind;
+            const std::string t = upper(type);
+            if (t == "D") return Kind::Diode;
+            if (t == "NPN") return Kind::NPN;
+            if (t == "PNP") return Kind::PNP;
+            if (t == "NJF") return Kind::NJF;
+            if (t == "PJF") return Kind::PJF;
+            if (t == "NMOS" || t == "VDMOS") return Kind::NMOS;
+            if (t == "PMOS") return Kind::PMOS;
+            return Kind::Other;
+        }
+
+        /**
+         * One logical statement: continuation lines joined, comment lines and
+         * inline ';' / '$' comments dropped
+         */
+        std::string joinStatement(std::string_view text) {
+            std::string joined;
+            while (!text.empty()) {
+                size_t end = text.find('\n');
+                std::string_view line = text.substr(0, end);
+                text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+                line = trimLeft(line);
+                if (line.empty() || line.front() == '*') continue;
+                if (line.front() == '+') line.remove_prefix(1);
+                line = line.substr(0, std::min(line.find(';'), line.find('$')));
+                joined += ' ';
+                joined.append(line.data(), line.size());
+            }
+            return joined;
+        }
+
+        struct ParsedModel {
+            std::string name, type;
+            std::vector<std::pair<std::string, std::string>> params;   // Uppercased name, value text
+        };
+
+        ParsedModel parseStatement(std::string_view statement) {
+            std::string text = joinStatement(statement);
+            for (char& c : text) {
+                if (c == '(' || c == ')' || c == ',') c = ' ';
+            }
+
+            ParsedModel model;
+            std::string_view rest = text;
+            nextToken(rest, "");                        // .model
+            model.name = upper(nextToken(rest, ""));
+            model.type = upper(nextToken(rest, ""));
+
+            // KEY=VALUE, KEY = VALUE; flags without a value are skipped
+            while (true) {
+                std::string_view key = nextToken(rest, "=");
+                if (key.empty()) break;
+                rest = trimLeft(rest);
+                if (rest.empty() || rest.front() != '=') continue;
+                rest.remove_prefix(1);
+                std::string_view value = nextToken(rest, "=");
+                if (!value.empty()) model.params.emplace_back(upper(key), std::string(value));
+            }
+            return model;
+        }
+
+        double param(const std::map<std::string, double>& params, std::initializer_list<const char*> names, double fallback) {
+            for (const char* name : names) {
+                auto it = params.find(name);
+                if (it != params.end()) return it->second;
+            }
+            return fallback;
+        }
+
+        uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            for (size_t i = 0; i < size; ++i) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        bool libraryStamp(const std::string& path, uint64_t& size, int64_t& time) {
+            std::error_code error;
+            size = static_cast<uint64_t>(std::filesystem::file_size(path, error));
+            if (error) return false;
+            time = static_cast<int64_t>(std::filesystem::last_write_time(path, error).time_since_epoch().count());
+            return !error;
+        }
+
+    } // namespace
+
+    // ============================================================================
+    // Opening and indexing
+    // ============================================================================
+
+    SpiceModelLibrary::SpiceModelLibrary(std::string path, std::string indexPath)
+        : m_path(std::move(path)), m_indexPath(indexPath.empty() ? m_path + ".idx" : std::move(indexPath)) {
+        uint64_t librarySize = 0;
+        int64_t libraryTime = 0;
+        if (!libraryStamp(m_path, librarySize, libraryTime)) return;
+
+        m_library = std::make_unique<MappedFile>(m_path);
+        if (!m_library->isOpen()) return;
+        if (loadIndex(librarySize, libraryTime)) return;
+
+        m_indexRebuilt = true;
+        m_indexBuffer = buildIndex(librarySize, libraryTime);
+        {
+            std::ofstream out(m_indexPath, std::ios::binary | std::ios::trunc);
+            out.write(m_indexBuffer.data(), static_cast<std::streamsize>(m_indexBuffer.size()));
+        }
+        if (loadIndex(librarySize, libraryTime)) {
+            m_indexBuffer.clear();
+            m_indexBuffer.shrink_to_fit();
+        } else {
+            m_index = m_indexBuffer;
+        }
+    }
+
+    bool SpiceModelLibrary::loadIndex(uint64_t librarySize, int64_t libraryTime) {
+        auto file = std::make_unique<MappedFile>(m_indexPath);
+        std::string_view data = file->view();
+        if (data.size() < sizeof(IndexHeader)) return false;
+
+        IndexHeader header;
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (std::memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 || header.version != INDEX_VERSION ||
+            header.librarySize != librarySize || header.libraryTime != libraryTime ||
+            data.size() < sizeof(IndexHeader) + static_cast<size_t>(header.count) * sizeof(IndexRecord)) {
+            return false;
+        }
+
+        m_indexFile = std::move(file);
+        m_index = data;
+        return true;
+    }
+
+    std::string SpiceModelLibrary::buildIndex(uint64_t librarySize, int64_t libraryTime) const {
+        struct Entry {
+            std::string name;
+            uint64_t offset;
+            uint32_t length;
+            ModelKind kind;
+        };
+        std::vector<Entry> entries;
+
+        const std::string_view text = m_library->view();
+        int subcircuitDepth = 0;
+        Entry* open = nullptr;   // .model statement still taking continuation lines
+        size_t pos = 0;
+        while (pos < text.size()) {
+            size_t end = text.find('\n', pos);
+            if (end == std::string_view::npos) end = text.size();
+            std::string_view line = trimLeft(text.substr(pos, end - pos));
+            const size_t lineStart = pos;
+            pos = end + 1;
+
+            if (line.empty() || line.front() == '*') continue;
+            if (line.front() == '+') {
+                if (open) open->length = static_cast<uint32_t>(end - open->offset);
+                continue;
+            }
+
+            open = nullptr;
+            if (startsWithNoCase(line, ".subckt")) {
+                ++subcircuitDepth;
+            } else if (startsWithNoCase(line, ".ends")) {
+                if (subcircuitDepth > 0) --subcircuitDepth;
+            } else if (subcircuitDepth == 0 && startsWithNoCase(line, ".model") &&
+                       line.size() > 6 && isSpace(line[6])) {
+                std::string_view rest = line.substr(6);
+                std::string_view name = nextToken(rest, "(");
+                std::string_view type = nextToken(rest, "(");
+                if (name.empty()) continue;
+                entries.push_back({upper(name), lineStart, static_cast<uint32_t>(end - lineStart), kindOf(type)});
+                open = &entries.back();
+            }
+        }
+
+        // Sorted by name; the first definition of a name wins, as in SPICE
+        std::stable_sort(entries.begin(), entries.end(),
+                         [](const Entry& a, const Entry& b) { return a.name < b.name; });
+        entries.erase(std::unique(entries.begin(), entries.end(),
+                                  [](const Entry& a, const Entry& b) { return a.name == b.name; }),
+                      entries.end());
+
+        IndexHeader header{};
+        std::memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        header.version = INDEX_VERSION;
+        header.count = static_cast<uint32_t>(entries.size());
+        header.librarySize = librarySize;
+        header.libraryTime = libraryTime;
+
+        std::string records, names;
+        for (const Entry& entry : entries) {
+            IndexRecord record{};
+            record.nameOffset = static_cast<uint32_t>(names.size());
+            record.nameLength = static_cast<uint32_t>(entry.name.size());
+            record.offset = entry.offset;
+            record.length = entry.length;
+            record.kind = static_cast<uint8_t>(entry.kind);
+            records.append(reinterpret_cast<const char*>(&record), sizeof(record));
+            names += entry.name;
+        }
+
+        std::string index(reinterpret_cast<const char*>(&header), sizeof(header));
+        return index + records + names;
+    }
+
+    // ============================================================================
+    // Lookup
+    // ============================================================================
+
+    size_t SpiceModelLibrary::size() const {
+        if (m_index.empty()) return 0;
+        IndexHeader header;
+        std::memcpy(&header, m_index.data(), sizeof(header));
+        return header.count;
+    }
+
+    SpiceModelLibrary::IndexRecord SpiceModelLibrary::record(size_t index) const {
+        IndexRecord record;
+        std::memcpy(&record, m_index.data() + sizeof(IndexHeader) + index * sizeof(IndexRecord), sizeof(record));
+        return record;
+    }
+
+    std::string_view SpiceModelLibrary::recordName(const IndexRecord& record) const {
+        const size_t pool = sizeof(IndexHeader) + size() * sizeof(IndexRecord);
+        if (pool + record.nameOffset + record.nameLength > m_index.size()) return {};
+        return m_index.substr(pool + record.nameOffset, record.nameLength);
+    }
+
+    std::string_view SpiceModelLibrary::statement(const IndexRecord& record) const {
+        const std::string_view text = m_library->view();
+        if (record.offset + record.length > text.size()) return {};
+        return text.substr(static_cast<size_t>(record.offset), record.length);
+    }
+
+    std::optional<SpiceModelLibrary::IndexRecord> SpiceModelLibrary::findEntry(std::string_view name) const {
+        if (!isOpen()) return std::nullopt;
+        const std::string key = upper(name);
+        size_t low = 0, high = size();
+        while (low < high) {
+            const size_t mid = low + (high - low) / 2;
+            const IndexRecord candidate = record(mid);
+            const int order = recordName(candidate).compare(key);
+            if (order == 0) return candidate;
+            if (order < 0) low = mid + 1;
+            else high = mid;
+        }
+        return std::nullopt;
+    }
+
+    std::optional<SpiceModelLibrary::ModelKind> SpiceModelLibrary::kind(std::string_view name) const {
+        auto entry = findEntry(name);
+        if (!entry) return std::nullopt;
+        return static_cast<ModelKind>(entry->kind);
+    }
+
+    std::optional<std::string> SpiceModelLibrary::modelStatement(std::string_view name) const {
+        auto entry = findEntry(name);
+        if (!entry) return std::nullopt;
+
+        ParsedModel model = parseStatement(statement(*entry));
+        std::string result = model.name + " " + model.type + "(";
+        for (size_t i = 0; i < model.params.size(); ++i) {
+            if (i > 0) result += ' ';
+            result += model.params[i].first + "=" + model.params[i].second;
+        }
+        return result + ")";
+    }
+
+    std::optional<std::map<std::string, double>> SpiceModelLibrary::modelParams(std::string_view name) const {
+        auto entry = findEntry(name);
+        if (!entry) return std::nullopt;
+
+        std::map<std::string, double> params;
+        for (const auto& [key, value] : parseStatement(statement(*entry)).params) {
+            if (auto number = parseNumber(value)) params.emplace(key, *number);
+        }
+        return params;
+    }
+
+    std::optional<double> SpiceModelLibrary::parseNumber(std::string_view text) {
+        const std::string value(trimLeft(text));
+        const char* begin = value.c_str();
+        char* end = nullptr;
+        double number = std::strtod(begin, &end);
+        if (end == begin) return std::nullopt;
+
+        // Scale suffix, then anything else (units) is ignored
+        const std::string suffix = upper(std::string_view(end));
+        if (suffix.rfind("MEG", 0) == 0) number *= 1e6;
+        else if (suffix.rfind("MIL", 0) == 0) number *= 25.4e-6;
+        else if (!suffix.empty()) {
+            switch (suffix.front()) {
+                case 'T': number *= 1e12; break;
+                case 'G': number *= 1e9; break;
+                case 'K': number *= 1e3; break;
+                case 'M': number *= 1e-3; break;
+                case 'U': number *= 1e-6; break;
+                case 'N': number *= 1e-9; break;
+                case 'P': number *= 1e-12; break;
+                case 'F': number *= 1e-15; break;
+                default: break;
+            }
+        }
+        return number;
+    }
+
+    // ============================================================================
+    // Device characteristics
+    // ============================================================================
+
+    std::optional<Nonlinear::DiodeCharacteristics> SpiceModelLibrary::diode(std::string_view name) const {
+        if (kind(name) != ModelKind::Diode) return std::nullopt;
+        const auto p = *modelParams(name);
+        return Nonlinear::DiodeCharacteristics{
+            static_cast<float>(param(p, {"IS"}, 1e-14)),
+            static_cast<float>(param(p, {"N"}, 1.0)),
+            0.026f,
+            static_cast<float>(param(p, {"RS"}, 0.0)),
+            static_cast<float>(param(p, {"CJO", "CJ0"}, 0.0)),
+            static_cast<float>(param(p, {"M"}, 0.5))};
+    }
+
+    std::optional<Nonlinear::BJTCharacteristics> SpiceModelLibrary::bjt(std::string_view name) const {
+        const auto modelKind = kind(name);
+        if (modelKind != ModelKind::NPN && modelKind != ModelKind::PNP) return std::nullopt;
+        const auto p = *modelParams(name);
+        const double earlyVoltage = param(p, {"VAF", "VA"}, 0.0);
+        return Nonlinear::BJTCharacteristics{
+            static_cast<float>(param(p, {"IS"}, 1e-16)),
+            0.026f,
+            static_cast<float>(param(p, {"NF"}, 1.0)),
+            static_cast<float>(param(p, {"NR"}, 1.0)),
+            static_cast<float>(param(p, {"BF"}, 100.0)),
+            static_cast<float>(param(p, {"BR"}, 1.0)),
+            static_cast<float>(param(p, {"RB"}, 0.0)),
+            static_cast<float>(earlyVoltage > 0.0 ? earlyVoltage : 1e6),   // SPICE: 0 means infinite
+            -0.002f};
+    }
+
+    std::optional<Nonlinear::FETCharacteristics> SpiceModelLibrary::fet(std::string_view name) const {
+        const auto modelKind = kind(name);
+        const bool jfet = modelKind == ModelKind::NJF || modelKind == ModelKind::PJF;
+        const bool mosfet = modelKind == ModelKind::NMOS || modelKind == ModelKind::PMOS;
+        if (!jfet && !mosfet) return std::nullopt;
+        const auto p = *modelParams(name);
+        // JFET BETA is Kp/2 in the square law Id = BETA (Vgs - Vto)^2
+        const double kp = jfet ? 2.0 * param(p, {"BETA"}, 1e-4) : param(p, {"KP"}, 2e-5);
+        const double lambda = param(p, {"LAMBDA"}, 0.0);
+        return Nonlinear::FETCharacteristics{
+            static_cast<float>(param(p, {"VTO"}, jfet ? -2.0 : 0.0)),
+            static_cast<float>(kp),
+            static_cast<float>(lambda),
+            static_cast<float>(lambda > 0.0 ? 1.0 / lambda : 100.0),
+            static_cast<float>(param(p, {"RS"}, 0.0)),
+            static_cast<float>(param(p, {"RD"}, 0.0)),
+            static_cast<float>(param(p, {"CGS", "CGSO"}, 0.0)),
+            static_cast<float>(param(p, {"CGD", "CGDO"}, 0.0))};
+    }
+
+    // ============================================================================
+    // Registry
+    // ============================================================================
+
+    namespace {
+
+        struct Registry {
+            std::mutex mutex;
+            std::vector<std::unique_ptr<SpiceModelLibrary>> libraries;
+        };
+
+        Registry& registry() {
+            static Registry instance;
+            return instance;
+        }
+
+        template <typename Characteristics>
+        std::optional<Characteristics> resolve(std::string_view name,
+                                               std::optional<Characteristics> (SpiceModelLibrary::*device)(std::string_view) const) {
+            Registry& r = registry();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            for (const auto& library : r.libraries) {
+                if (auto characteristics = ((*library).*device)(name)) return characteristics;
+            }
+            return std::nullopt;
+        }
+
+    } // namespace
+
+    bool SpiceModelLibrary::registerLibrary(const std::string& path) {
+        Registry& r = registry();
+        {
+            std::lock_guard<std::mutex> lock(r.mutex);
+            for (const auto& library : r.libraries) {
+                if (library->getPath() == path) return true;
+            }
+            auto library = std::make_unique<SpiceModelLibrary>(path);
+            if (!library->isOpen()) return false;
+            r.libraries.push_back(std::move(library));
+            if (r.libraries.size() > 1) return true;
+        }
+
+        namespace DB = Nonlinear::ComponentDB;
+        DB::getDiodeDB().setResolver([](std::string_view name) { return resolve(name, &SpiceModelLibrary::diode); });
+        DB::getBJTDB().setResolver([](std::string_view name) { return resolve(name, &SpiceModelLibrary::bjt); });
+        DB::getFETDB().setResolver([](std::string_view name) { return resolve(name, &SpiceModelLibrary::fet); });
+        return true;
+    }
+
+    std::optional<std::string> SpiceModelLibrary::findModelStatement(std::string_view name) {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (const auto& library : r.libraries) {
+            if (auto model = library->modelStatement(name)) return model;
+        }
+        return std::nullopt;
+    }
+
+    uint64_t SpiceModelLibrary::registryFingerprint() {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        if (r.libraries.empty()) return 0;
+
+        uint64_t hash = 14695981039346656037ull;
+        for (const auto& library : r.libraries) {
+            uint64_t size = 0;
+            int64_t time = 0;
+            libraryStamp(library->getPath(), size, time);
+            hash = fnv1a(hash, library->getPath().data(), library->getPath().size());
+            hash = fnv1a(hash, &size, sizeof(size));
+            hash = fnv1a(hash, &time, sizeof(time));
+        }
+        return hash;
+    }
+
+} // namespace LiveSpice
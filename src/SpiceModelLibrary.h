@@ -0,0 +1,122 @@
+#pragma once
+
+#include "DiodeModels.h"
+#include "MappedFile.h"
+#include "TransistorModels.h"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace LiveSpice {
+
+    // ============================================================================
+    // SPICE Model Library - Indexed, lazily parsed .model/.lib files
+    // ============================================================================
+
+    /**
+     * A vendor .model/.lib file opened without parsing its models. The
+     * library is memory-mapped; a sorted index of model names (offset and
+     * length of each .model statement, continuation lines included) is
+     * kept next to it as <library>.idx and memory-mapped too, so opening a
+     * library of thousands of parts is a stat and two mappings. The index is
+     * rebuilt when the library's size or modification time changes, and
+     * kept in memory when it cannot be written.
+     *
+     * Names are case-insensitive, as in SPICE. Models inside .subckt blocks
+     * are local to the subcircuit and are not indexed.
+     */
+    class SpiceModelLibrary {
+    public:
+        enum class ModelKind : uint8_t { Diode, NPN, PNP, NJF, PJF, NMOS, PMOS, Other };
+
+        /**
+         * @param indexPath Where to keep the index (default: <path>.idx)
+         */
+        explicit SpiceModelLibrary(std::string path, std::string indexPath = {});
+
+        SpiceModelLibrary(const SpiceModelLibrary&) = delete;
+        SpiceModelLibrary& operator=(const SpiceModelLibrary&) = delete;
+
+        /** Library mapped and indexed */
+        bool isOpen() const { return m_library && m_library->isOpen() && !m_index.empty(); }
+
+        /** True when open() had to scan the library (no usable index on disk) */
+        bool indexRebuilt() const { return m_indexRebuilt; }
+
+        const std::string& getPath() const { return m_path; }
+        size_t size() const;
+
+        bool contains(std::string_view name) const { return findEntry(name).has_value(); }
+        std::optional<ModelKind> kind(std::string_view name) const;
+
+        /** The model as one line: "NAME TYPE(PARAM=VALUE ...)" */
+        std::optional<std::string> modelStatement(std::string_view name) const;
+
+        /** Parameters of one model, names uppercased (parsed on each call) */
+        std::optional<std::map<std::string, double>> modelParams(std::string_view name) const;
+
+        // Characteristics for the translator's device models (SPICE defaults
+        // for parameters the model leaves out); empty for other model kinds
+        std::optional<Nonlinear::DiodeCharacteristics> diode(std::string_view name) const;
+        std::optional<Nonlinear::BJTCharacteristics> bjt(std::string_view name) const;
+        std::optional<Nonlinear::FETCharacteristics> fet(std::string_view name) const;
+
+        /** "4.7K", "1MEG", "10p", "2.5e-3V" -> SI value */
+        static std::optional<double> parseNumber(std::string_view text);
+
+        // ------------------------------------------------------------------------
+        // Process-wide registry
+        // ------------------------------------------------------------------------
+
+        /**
+         * Open a library (once per path) and let the device databases resolve
+         * unknown parts from it; later libraries are searched after earlier ones
+         * @return false when the library cannot be opened
+         */
+        static bool registerLibrary(const std::string& path);
+
+        /** Model statement from the first registered library that has it */
+        static std::optional<std::string> findModelStatement(std::string_view name);
+
+        /** Paths, sizes and mtimes of the registered libraries (0 when none) */
+        static uint64_t registryFingerprint();
+
+    private:
+        // On-disk index: header, records sorted by name, then the name pool
+        struct IndexHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t count;
+            uint64_t librarySize;
+            int64_t libraryTime;
+        };
+
+        struct IndexRecord {
+            uint32_t nameOffset;   // Into the name pool (uppercased names)
+            uint32_t nameLength;
+            uint64_t offset;       // .model statement in the library
+            uint32_t length;
+            uint8_t kind;
+            uint8_t reserved[3];
+        };
+
+        std::string m_path;
+        std::string m_indexPath;
+        std::unique_ptr<MappedFile> m_library;
+        std::unique_ptr<MappedFile> m_indexFile;
+        std::string m_indexBuffer;     // Index kept in memory when it could not be written
+        std::string_view m_index;      // Header, sorted records, name pool
+        bool m_indexRebuilt = false;
+
+        bool loadIndex(uint64_t librarySize, int64_t libraryTime);
+        std::string buildIndex(uint64_t librarySize, int64_t libraryTime) const;
+        std::optional<IndexRecord> findEntry(std::string_view name) const;
+        IndexRecord record(size_t index) const;
+        std::string_view recordName(const IndexRecord& record) const;
+        std::string_view statement(const IndexRecord& record) const;
+    };
+
+} // namespace LiveSpice
@@ -0,0 +1,147 @@
+#include "SpiceRawFile.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <sstream>
+
+namespace SpiceValidation {
+
+namespace {
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) text.remove_prefix(1);
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) text.remove_suffix(1);
+    return text;
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+           });
+}
+
+// "v(3)" -> "3"; other names unchanged
+std::string_view nodeName(std::string_view name) {
+    if (name.size() > 3 && (name[0] == 'v' || name[0] == 'V') && name[1] == '(' && name.back() == ')') {
+        return name.substr(2, name.size() - 3);
+    }
+    return name;
+}
+
+} // namespace
+
+SpiceRawFile::SpiceRawFile(const std::string& path) : file(std::make_unique<LiveSpice::MappedFile>(path)) {
+    if (!file->isOpen()) {
+        error = "cannot open " + path;
+        return;
+    }
+
+    // Header: "Key: value" lines up to "Binary:", variables listed one per line
+    const std::string_view text = file->view();
+    size_t numVariables = 0;
+    size_t position = 0;
+    bool binary = false;
+    while (position < text.size()) {
+        size_t end = text.find('\n', position);
+        if (end == std::string_view::npos) end = text.size();
+        const std::string_view line = text.substr(position, end - position);
+        position = end + 1;
+
+        const size_t colon = line.find(':');
+        const std::string_view key = trim(line.substr(0, colon));
+        const std::string_view value = colon == std::string_view::npos ? std::string_view() : trim(line.substr(colon + 1));
+
+        if (equalsIgnoreCase(key, "Binary")) {
+            binary = true;
+            break;
+        } else if (equalsIgnoreCase(key, "Values")) {
+            error = "ASCII raw files are not supported (use set filetype=binary)";
+            return;
+        } else if (equalsIgnoreCase(key, "Plotname")) {
+            plotName = std::string(value);
+        } else if (equalsIgnoreCase(key, "Flags")) {
+            complex = value.find("complex") != std::string_view::npos;
+        } else if (equalsIgnoreCase(key, "No. Variables")) {
+            numVariables = std::strtoul(std::string(value).c_str(), nullptr, 10);
+        } else if (equalsIgnoreCase(key, "No. Points")) {
+            points = std::strtoul(std::string(value).c_str(), nullptr, 10);
+        } else if (equalsIgnoreCase(key, "Variables")) {
+            // Entries: index, name, type (the first may share the "Variables:" line)
+            std::string_view entry = value;
+            while (true) {
+                if (!trim(entry).empty()) {
+                    std::istringstream fields{std::string(entry)};
+                    size_t index;
+                    Variable variable;
+                    if (!(fields >> index >> variable.name >> variable.type)) {
+                        error = "malformed variable entry: " + std::string(trim(entry));
+                        return;
+                    }
+                    variables.push_back(std::move(variable));
+                }
+                if (variables.size() >= numVariables || position >= text.size()) break;
+                end = text.find('\n', position);
+                if (end == std::string_view::npos) end = text.size();
+                entry = text.substr(position, end - position);
+                position = end + 1;
+            }
+        }
+    }
+
+    if (!binary) {
+        error = "no binary data in " + path;
+        return;
+    }
+    if (numVariables == 0 || variables.size() != numVariables) {
+        error = "variable list does not match No. Variables";
+        return;
+    }
+
+    valueStride = complex ? 2 * sizeof(double) : sizeof(double);
+    pointStride = valueStride * numVariables;
+    data = text.data() + std::min(position, text.size());
+
+    // A run that was cut short leaves fewer points than the header declares
+    const size_t available = (text.size() - std::min(position, text.size())) / pointStride;
+    points = std::min(points, available);
+}
+
+SampleView SpiceRawFile::vector(size_t index) const {
+    if (!isOpen() || index >= variables.size()) return {};
+    return SampleView(data + index * valueStride, points, pointStride);
+}
+
+SampleView SpiceRawFile::vector(std::string_view name) const {
+    for (size_t i = 0; i < variables.size(); ++i) {
+        if (equalsIgnoreCase(variables[i].name, name) ||
+            equalsIgnoreCase(nodeName(variables[i].name), nodeName(name))) {
+            return vector(i);
+        }
+    }
+    return {};
+}
+
+std::vector<float> resampleToRate(SampleView times, SampleView values, float sampleRate, size_t numSamples) {
+    const size_t count = std::min(times.size(), values.size());
+    if (count < 2) return {};
+
+    std::vector<float> samples(numSamples);
+    size_t j = 0;
+    double t0 = times[0], t1 = times[1];
+    for (size_t i = 0; i < numSamples; ++i) {
+        const double t = i / static_cast<double>(sampleRate);
+        while (j + 2 < count && t1 < t) {
+            ++j;
+            t0 = t1;
+            t1 = times[j + 1];
+        }
+        const double span = t1 - t0;
+        const double frac = span > 0.0 ? std::clamp((t - t0) / span, 0.0, 1.0) : 0.0;
+        const double v0 = values[j];
+        samples[i] = static_cast<float>(v0 + frac * (values[j + 1] - v0));
+    }
+    return samples;
+}
+
+} // namespace SpiceValidation
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SpiceValidation {
+
+/**
+ * Read-only strided view of doubles: one vector of a raw file, or a
+ * contiguous array. Elements are copied out with memcpy because raw-file
+ * records carry no alignment guarantee.
+ */
+class SampleView {
+public:
+    SampleView() = default;
+    SampleView(const char* data, size_t count, size_t stride) : data(data), count(count), stride(stride) {}
+    SampleView(const std::vector<double>& values)
+        : data(reinterpret_cast<const char*>(values.data())), count(values.size()), stride(sizeof(double)) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    double operator[](size_t index) const {
+        double value;
+        std::memcpy(&value, data + index * stride, sizeof(value));
+        return value;
+    }
+
+private:
+    const char* data = nullptr;
+    size_t count = 0;
+    size_t stride = sizeof(double);
+};
+
+/**
+ * ngspice binary raw file (write/-r output), memory-mapped
+ * The header is parsed on open; vectors are views into the mapping, so a
+ * multi-second transient at fine time steps costs no copies. Only the
+ * first plot is read. Complex plots (AC) expose the real part; ASCII raw
+ * files are rejected.
+ */
+class SpiceRawFile {
+public:
+    struct Variable {
+        std::string name;   // As written: "time", "v(3)", "i(vsrc)"
+        std::string type;   // "time", "voltage", "current", ...
+    };
+
+    explicit SpiceRawFile(const std::string& path);
+
+    SpiceRawFile(const SpiceRawFile&) = delete;
+    SpiceRawFile& operator=(const SpiceRawFile&) = delete;
+
+    bool isOpen() const { return error.empty(); }
+    const std::string& getError() const { return error; }
+
+    const std::string& getPlotName() const { return plotName; }
+    bool isComplex() const { return complex; }
+    size_t numPoints() const { return points; }
+    const std::vector<Variable>& getVariables() const { return variables; }
+
+    /** Scale vector (time for transients) */
+    SampleView scale() const { return vector(size_t(0)); }
+
+    SampleView vector(size_t index) const;
+
+    /**
+     * Vector by name, case-insensitive; "v(3)" and "3" name the same node
+     * @return empty view when missing
+     */
+    SampleView vector(std::string_view name) const;
+
+private:
+    std::unique_ptr<LiveSpice::MappedFile> file;
+    std::string error;
+    std::string plotName;
+    std::vector<Variable> variables;
+    bool complex = false;
+    size_t points = 0;
+    const char* data = nullptr;   // First point
+    size_t pointStride = 0;       // Bytes per point (all variables)
+    size_t valueStride = 0;       // Bytes per value (8, or 16 when complex)
+};
+
+/**
+ * Linear interpolation of a simulator waveform (variable time steps) onto
+ * numSamples samples at sampleRate, starting at t = 0
+ * @return empty when there are fewer than two points
+ */
+std::vector<float> resampleToRate(SampleView times, SampleView values, float sampleRate, size_t numSamples);
+
+} // namespace SpiceValidation
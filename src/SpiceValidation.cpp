@@ -1,45 +1,143 @@
 #include "SpiceValidation.h"
+#include "SharedLibrary.h"
+#include "SpiceRawFile.h"
+#include "SpiceModelLibrary.h"
 #include <sstream>
 #include <cmath>
 #include <algorithm>
-#include <numeric>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <mutex>
 #include <random>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
 
 namespace SpiceValidation {
 
+namespace {
+
+// Diode parameters of the test bench's .model line, shared with the DSP solve
+struct DiodeStageModel {
+    const char* part;
+    double Is;
+    double n;
+    double Rs;
+};
+
+const DiodeStageModel DIODE_STAGE_MODELS[] = {
+    {"1N4148", 1.4e-14, 1.06, 0.25},
+    {"1N914", 2.6e-15, 1.04, 0.1},
+    {"OA90", 5.0e-15, 1.3, 0.5},
+};
+
+const DiodeStageModel* findDiodeStageModel(const std::string& part) {
+    for (const auto& model : DIODE_STAGE_MODELS) {
+        if (part == model.part) return &model;
+    }
+    return nullptr;
+}
+
+} // namespace
+
 /**
  * Test Signal Generation
  */
+namespace {
+
+constexpr size_t OSCILLATOR_BLOCK = 1024;          // Samples between exact restarts
+constexpr size_t SIGNAL_CACHE_LIMIT = size_t(1) << 24;   // Cached samples (64 MB)
+
+/**
+ * Sine by the recurrence s[n+1] = 2 cos(w) s[n] - s[n-1], restarted from
+ * sin() every block so rounding cannot accumulate
+ */
+void fillSine(float* output, size_t length, double amplitude, double omega) {
+    const double k = 2.0 * std::cos(omega);
+    for (size_t start = 0; start < length; start += OSCILLATOR_BLOCK) {
+        const size_t end = std::min(length, start + OSCILLATOR_BLOCK);
+        double previous = amplitude * std::sin(omega * (static_cast<double>(start) - 1.0));
+        double current = amplitude * std::sin(omega * static_cast<double>(start));
+        for (size_t i = start; i < end; ++i) {
+            output[i] = static_cast<float>(current);
+            const double next = k * current - previous;
+            previous = current;
+            current = next;
+        }
+    }
+}
+
+/**
+ * Linear chirp, phase(n) = a n + b n^2: a rotating phasor whose rotation
+ * itself rotates by 2b per sample
+ */
+void fillChirp(float* output, size_t length, double amplitude, double a, double b) {
+    const double stepRe = std::cos(2.0 * b), stepIm = std::sin(2.0 * b);
+    for (size_t start = 0; start < length; start += OSCILLATOR_BLOCK) {
+        const size_t end = std::min(length, start + OSCILLATOR_BLOCK);
+        const double n = static_cast<double>(start);
+        const double phase = a * n + b * n * n;
+        const double increment = a + b * (2.0 * n + 1.0);
+        double zRe = std::cos(phase), zIm = std::sin(phase);
+        double rRe = std::cos(increment), rIm = std::sin(increment);
+        for (size_t i = start; i < end; ++i) {
+            output[i] = static_cast<float>(amplitude * zIm);
+            const double nextRe = zRe * rRe - zIm * rIm;
+            zIm = zRe * rIm + zIm * rRe;
+            zRe = nextRe;
+            const double rotatedRe = rRe * stepRe - rIm * stepIm;
+            rIm = rRe * stepIm + rIm * stepRe;
+            rRe = rotatedRe;
+        }
+    }
+}
+
+using SignalKey = std::tuple<int, float, float, float, float, float, float>;
+
+std::mutex g_signalCacheMutex;
+std::map<SignalKey, TestSignalGenerator::SharedSignal> g_signalCache;
+size_t g_signalCacheSamples = 0;
+
+} // namespace
+
+size_t TestSignalGenerator::signalLength(const SignalParams& params) {
+    const int numSamples = static_cast<int>(params.duration * params.sampleRate);
+    return numSamples > 0 ? static_cast<size_t>(numSamples) : 0;
+}
+
 std::vector<float> TestSignalGenerator::generateSignal(SignalType type, const SignalParams& params) {
-    int numSamples = static_cast<int>(params.duration * params.sampleRate);
-    std::vector<float> signal(numSamples);
+    std::vector<float> signal(signalLength(params));
+    generateSignal(type, params, signal.data(), signal.size());
+    return signal;
+}
+
+void TestSignalGenerator::generateSignal(SignalType type, const SignalParams& params, float* output, size_t length) {
+    const double omega = 2.0 * M_PI * params.frequency / params.sampleRate;
     
     switch (type) {
         case SignalType::SineWave: {
-            float omega = 2.0f * 3.14159265359f * params.frequency / params.sampleRate;
-            for (int i = 0; i < numSamples; ++i) {
-                signal[i] = params.amplitude * std::sin(omega * i);
-            }
+            fillSine(output, length, params.amplitude, omega);
             break;
         }
         
         case SignalType::Chirp: {
-            float k = (params.endFreq - params.startFreq) / (params.duration * params.sampleRate);
-            for (int i = 0; i < numSamples; ++i) {
-                float t = i / params.sampleRate;
-                float f = params.startFreq + k * i;
-                float phase = 2.0f * 3.14159265359f * (params.startFreq * t + 0.5f * k * t * t);
-                signal[i] = params.amplitude * std::sin(phase);
-            }
+            // startFreq to endFreq over params.duration
+            const double rate = (params.endFreq - params.startFreq) / params.duration;   // Hz/s
+            const double a = 2.0 * M_PI * params.startFreq / params.sampleRate;
+            const double b = M_PI * rate / (static_cast<double>(params.sampleRate) * params.sampleRate);
+            fillChirp(output, length, params.amplitude, a, b);
             break;
         }
         
         case SignalType::SquareWave: {
-            float omega = 2.0f * 3.14159265359f * params.frequency / params.sampleRate;
-            for (int i = 0; i < numSamples; ++i) {
-                signal[i] = params.amplitude * (std::sin(omega * i) > 0 ? 1.0f : -1.0f);
+            fillSine(output, length, 1.0, omega);
+            for (size_t i = 0; i < length; ++i) {
+                output[i] = output[i] > 0.0f ? params.amplitude : -params.amplitude;
             }
             break;
         }
@@ -47,19 +145,45 @@ std::vector<float> TestSignalGenerator::generateSignal(SignalType type, const Si
         case SignalType::NoiseWhite: {
             std::mt19937 gen(12345);  // Fixed seed for reproducibility
             std::uniform_real_distribution<> dis(-1.0, 1.0);
-            for (int i = 0; i < numSamples; ++i) {
-                signal[i] = params.amplitude * dis(gen);
+            for (size_t i = 0; i < length; ++i) {
+                output[i] = params.amplitude * dis(gen);
             }
             break;
         }
         
         case SignalType::ImpulseResponse: {
-            signal[0] = params.amplitude;
+            std::fill(output, output + length, 0.0f);
+            if (length > 0) output[0] = params.amplitude;
             break;
         }
     }
+}
+
+TestSignalGenerator::SharedSignal TestSignalGenerator::cachedSignal(SignalType type, const SignalParams& params) {
+    const SignalKey key(static_cast<int>(type), params.sampleRate, params.duration, params.frequency,
+                        params.amplitude, params.startFreq, params.endFreq);
+    {
+        std::lock_guard<std::mutex> lock(g_signalCacheMutex);
+        auto found = g_signalCache.find(key);
+        if (found != g_signalCache.end()) return found->second;
+    }
     
-    return signal;
+    // Generated unlocked; a concurrent request for the same key keeps the first
+    auto signal = std::make_shared<const std::vector<float>>(generateSignal(type, params));
+    std::lock_guard<std::mutex> lock(g_signalCacheMutex);
+    if (g_signalCacheSamples + signal->size() > SIGNAL_CACHE_LIMIT) {
+        g_signalCache.clear();
+        g_signalCacheSamples = 0;
+    }
+    auto inserted = g_signalCache.emplace(key, signal);
+    if (inserted.second) g_signalCacheSamples += signal->size();
+    return inserted.first->second;
+}
+
+void TestSignalGenerator::clearCache() {
+    std::lock_guard<std::mutex> lock(g_signalCacheMutex);
+    g_signalCache.clear();
+    g_signalCacheSamples = 0;
 }
 
 std::vector<float> TestSignalGenerator::generateLogSweep(float startFreq, float endFreq,
@@ -73,23 +197,40 @@ std::vector<float> TestSignalGenerator::generateLogSweep(float startFreq, float
     return generateSignal(SignalType::Chirp, params);
 }
 
+size_t TestSignalGenerator::stepSweepLength(float minAmplitude, float maxAmplitude,
+                                            float stepSize, float sampleRate) {
+    SignalParams params;
+    params.sampleRate = sampleRate;
+    params.duration = 0.1f;   // 100ms per amplitude level
+    size_t length = 0;
+    for (float amp = minAmplitude; amp <= maxAmplitude; amp += stepSize) {
+        length += signalLength(params);
+    }
+    return length;
+}
+
 std::vector<float> TestSignalGenerator::generateStepSweep(float minAmplitude, float maxAmplitude,
                                                           float stepSize, float sampleRate) {
-    std::vector<float> sweep;
-    float duration_per_step = 0.1f;  // 100ms per amplitude level
+    std::vector<float> sweep(stepSweepLength(minAmplitude, maxAmplitude, stepSize, sampleRate));
+    generateStepSweep(minAmplitude, maxAmplitude, stepSize, sampleRate, sweep.data(), sweep.size());
+    return sweep;
+}
+
+void TestSignalGenerator::generateStepSweep(float minAmplitude, float maxAmplitude, float stepSize,
+                                            float sampleRate, float* output, size_t length) {
+    SignalParams params;
+    params.sampleRate = sampleRate;
+    params.duration = 0.1f;   // 100ms per amplitude level
+    params.frequency = 1000.0f;
+    const size_t stepLength = signalLength(params);
     
-    for (float amp = minAmplitude; amp <= maxAmplitude; amp += stepSize) {
-        SignalParams params;
-        params.sampleRate = sampleRate;
-        params.duration = duration_per_step;
-        params.frequency = 1000.0f;
+    size_t offset = 0;
+    for (float amp = minAmplitude; amp <= maxAmplitude && offset < length; amp += stepSize) {
         params.amplitude = amp;
-        
-        auto step = generateSignal(SignalType::SineWave, params);
-        sweep.insert(sweep.end(), step.begin(), step.end());
+        const size_t count = std::min(stepLength, length - offset);
+        generateSignal(SignalType::SineWave, params, output + offset, count);
+        offset += count;
     }
-    
-    return sweep;
 }
 
 /**
@@ -104,16 +245,11 @@ std::string SpiceNetlistGenerator::generateDiodeTestBench(const DiodeCircuitSpec
     netlist << "* Generated by SpiceValidator\n\n";
     
     // Add diode model
+    const DiodeStageModel* model = findDiodeStageModel(spec.diodePartNumber);
+    const DiodeStageModel& params = model ? *model : DIODE_STAGE_MODELS[0];
     netlist << ".model " << spec.diodePartNumber << " D(";
-    if (spec.diodePartNumber == "1N4148") {
-        netlist << "IS=1.4e-14 N=1.06 RS=0.25)\n";
-    } else if (spec.diodePartNumber == "1N914") {
-        netlist << "IS=2.6e-15 N=1.04 RS=0.1)\n";
-    } else if (spec.diodePartNumber == "OA90") {
-        netlist << "IS=5.0e-15 N=1.3 RS=0.5)\n";
-    } else {
-        netlist << "IS=1.4e-14 N=1.06 RS=0.25)  * Default Si diode\n";
-    }
+    netlist << "IS=" << params.Is << " N=" << params.n << " RS=" << params.Rs << ")";
+    netlist << (model ? "\n" : "  * Default Si diode\n");
     
     // Circuit topology
     netlist << "\n* Circuit Components\n";
@@ -144,14 +280,34 @@ std::string SpiceNetlistGenerator::generateDiodeTestBench(const DiodeCircuitSpec
     return netlist.str();
 }
 
-std::string SpiceNetlistGenerator::generateTransientAnalysis(float endTime, float stepTime) {
+std::string SpiceNetlistGenerator::generateTransientCommand(float endTime, float stepTime) {
+    std::stringstream command;
+    command << ".tran " << stepTime << " " << endTime << " 0 " << (stepTime * 0.1f) << "\n";
+    return command.str();
+}
+
+std::string SpiceNetlistGenerator::generateTransientAnalysis(float endTime, float stepTime,
+                                                             const std::string& probes) {
     std::stringstream analysis;
-    analysis << ".tran " << stepTime << " " << endTime << " 0 " << (stepTime * 0.1f) << "\n";
+    analysis << generateTransientCommand(endTime, stepTime);
     analysis << ".control\n";
     analysis << "run\n";
     analysis << "set wr_vecnames\n";
     analysis << "option numdgt=7\n";
-    analysis << "wrdata results.txt v(2) v(3)\n";
+    analysis << "wrdata results.txt " << probes << "\n";
+    analysis << "quit\n";
+    analysis << ".endc\n";
+    return analysis.str();
+}
+
+std::string SpiceNetlistGenerator::generateTransientRawAnalysis(float endTime, float stepTime,
+                                                                const std::string& probes) {
+    std::stringstream analysis;
+    analysis << generateTransientCommand(endTime, stepTime);
+    analysis << ".control\n";
+    analysis << "run\n";
+    analysis << "set filetype=binary\n";
+    analysis << "write results.raw " << probes << "\n";
     analysis << "quit\n";
     analysis << ".endc\n";
     return analysis.str();
@@ -171,6 +327,10 @@ std::string SpiceNetlistGenerator::generateACAnalysis(float startFreq, float end
 }
 
 std::string SpiceNetlistGenerator::getSpiceModel(const std::string& partNumber) {
+    // Vendor models from --spice-lib libraries take precedence
+    if (auto model = LiveSpice::SpiceModelLibrary::findModelStatement(partNumber)) {
+        return *model;
+    }
     if (partNumber == "1N4148") {
         return "1N4148 D(IS=1.4e-14 N=1.06 RS=0.25 CJO=0.4e-12 M=0.4)";
     } else if (partNumber == "1N914") {
@@ -187,7 +347,9 @@ std::string SpiceNetlistGenerator::getSpiceModel(const std::string& partNumber)
 ValidationMetrics ComparisonAnalyzer::compareWaveforms(
     const std::vector<float>& dspOutput,
     const std::vector<float>& spiceReference,
-    const std::string& circuitName) {
+    const std::string& circuitName,
+    float fundamentalFreq,
+    float sampleRate) {
     
     ValidationMetrics metrics;
     metrics.circuitName = circuitName;
@@ -222,8 +384,10 @@ ValidationMetrics ComparisonAnalyzer::compareWaveforms(
         metrics.amplitudeError = std::abs((dspPeak - spicePeak) / spicePeak);
     }
     
-    // Calculate THD (simplified - first 5 harmonics)
-    metrics.thd = calculateTHD(dspOutput, 1000.0f, 44100.0f);
+    // Distortion of the test tone, and spectral agreement with SPICE
+    metrics.thd = calculateTHD(dspOutput, fundamentalFreq, sampleRate);
+    metrics.thdPlusNoise = calculateTHDPlusNoise(dspOutput, fundamentalFreq, sampleRate);
+    metrics.frequencyError = calculateFrequencyResponseError(dspOutput, spiceReference, sampleRate);
     
     // Determine pass/fail
     metrics.passed = (metrics.rmsDifference < 0.05f) && (metrics.peakVoltageError < 0.1f);
@@ -234,45 +398,611 @@ ValidationMetrics ComparisonAnalyzer::compareWaveforms(
 float ComparisonAnalyzer::calculateTHD(const std::vector<float>& signal,
                                        float fundamentalFreq, float sampleRate) {
     if (signal.empty()) return 0.0f;
-    
-    // Simplified THD: ratio of RMS(signal - DC) to fundamental amplitude
-    float mean = std::accumulate(signal.begin(), signal.end(), 0.0f) / signal.size();
-    float rms_ac = 0.0f;
-    
-    for (float sample : signal) {
-        float ac = sample - mean;
-        rms_ac += ac * ac;
-    }
-    rms_ac = std::sqrt(rms_ac / signal.size());
-    
-    // Estimate fundamental amplitude (very simplified)
-    float fundamental_est = 0.7f * rms_ac;  // Rough approximation
-    
-    if (fundamental_est > 0.001f) {
-        return (rms_ac - fundamental_est) / fundamental_est * 100.0f;
-    }
-    return 0.0f;
+    thread_local SpectrumAnalyzer analyzer;
+    return analyzer.analyze(signal.data(), signal.size(), fundamentalFreq, sampleRate).thd;
+}
+
+float ComparisonAnalyzer::calculateTHDPlusNoise(const std::vector<float>& signal,
+                                                float fundamentalFreq, float sampleRate) {
+    if (signal.empty()) return 0.0f;
+    thread_local SpectrumAnalyzer analyzer;
+    return analyzer.analyze(signal.data(), signal.size(), fundamentalFreq, sampleRate).thdPlusNoise;
 }
 
 float ComparisonAnalyzer::calculateFrequencyResponseError(
     const std::vector<float>& dspOutput,
     const std::vector<float>& spiceOutput,
-    float sampleRate) {
+    float /*sampleRate*/) {
     
-    // This would require FFT implementation
-    // For now, return a placeholder
-    float avgError = 0.0f;
-    for (size_t i = 0; i < std::min(dspOutput.size(), spiceOutput.size()); ++i) {
-        if (std::abs(spiceOutput[i]) > 0.001f) {
-            avgError += std::abs((dspOutput[i] - spiceOutput[i]) / spiceOutput[i]);
+    const size_t length = std::min(dspOutput.size(), spiceOutput.size());
+    if (length < 4) return 0.0f;
+    thread_local SpectrumAnalyzer analyzer;
+    return analyzer.spectralError(dspOutput.data(), spiceOutput.data(), length);
+}
+
+/**
+ * FFT
+ */
+FFTPlan::FFTPlan(size_t size) : n(size) {
+    if (size < 2 || (size & (size - 1)) != 0) {
+        throw std::invalid_argument("FFT size must be a power of two >= 2");
+    }
+
+    int bits = 0;
+    while ((size_t(1) << bits) < n) ++bits;
+    bitReversed.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t reversed = 0;
+        for (int b = 0; b < bits; ++b) {
+            reversed |= static_cast<uint32_t>((i >> b) & 1u) << (bits - 1 - b);
+        }
+        bitReversed[i] = reversed;
+    }
+
+    twiddleRe.resize(n - 1);
+    twiddleIm.resize(n - 1);
+    for (size_t half = 1; half < n; half <<= 1) {
+        for (size_t j = 0; j < half; ++j) {
+            const double angle = -M_PI * static_cast<double>(j) / static_cast<double>(half);
+            twiddleRe[half - 1 + j] = static_cast<float>(std::cos(angle));
+            twiddleIm[half - 1 + j] = static_cast<float>(std::sin(angle));
+        }
+    }
+}
+
+void FFTPlan::forward(float* re, float* im) const {
+    for (size_t i = 0; i < n; ++i) {
+        const size_t j = bitReversed[i];
+        if (j > i) {
+            std::swap(re[i], re[j]);
+            std::swap(im[i], im[j]);
+        }
+    }
+
+    for (size_t half = 1; half < n; half <<= 1) {
+        const float* wr = twiddleRe.data() + half - 1;
+        const float* wi = twiddleIm.data() + half - 1;
+        for (size_t start = 0; start < n; start += 2 * half) {
+            float* ar = re + start;
+            float* ai = im + start;
+            float* br = ar + half;
+            float* bi = ai + half;
+            for (size_t j = 0; j < half; ++j) {
+                const float tr = br[j] * wr[j] - bi[j] * wi[j];
+                const float ti = br[j] * wi[j] + bi[j] * wr[j];
+                br[j] = ar[j] - tr;
+                bi[j] = ai[j] - ti;
+                ar[j] += tr;
+                ai[j] += ti;
+            }
+        }
+    }
+}
+
+/**
+ * Spectrum analysis
+ */
+size_t SpectrumAnalyzer::prepare(size_t length) {
+    size_t size = 4;
+    while (size * 2 <= std::min(length, MAX_SIZE)) size *= 2;
+    if (plan && plan->size() * 2 == size) return size;
+
+    const size_t half = size / 2;
+    plan = std::make_unique<FFTPlan>(half);
+
+    // 4-term Blackman-Harris
+    window.resize(size);
+    windowPower = 0.0;
+    for (size_t i = 0; i < size; ++i) {
+        const double x = 2.0 * M_PI * static_cast<double>(i) / static_cast<double>(size);
+        const double w = 0.35875 - 0.48829 * std::cos(x) + 0.14128 * std::cos(2.0 * x) - 0.01168 * std::cos(3.0 * x);
+        window[i] = static_cast<float>(w);
+        windowPower += w * w;
+    }
+
+    unpackRe.resize(half);
+    unpackIm.resize(half);
+    for (size_t k = 0; k < half; ++k) {
+        const double angle = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(size);
+        unpackRe[k] = static_cast<float>(std::cos(angle));
+        unpackIm[k] = static_cast<float>(std::sin(angle));
+    }
+
+    re.resize(half);
+    im.resize(half);
+    power.resize(half + 1);
+    return size;
+}
+
+const std::vector<double>& SpectrumAnalyzer::powerSpectrum(const float* signal, size_t length) {
+    const size_t size = prepare(length);
+    const size_t half = size / 2;
+    const float* x = signal + (length - size);   // Settled tail
+
+    // Even samples as real parts, odd samples as imaginary parts
+    for (size_t k = 0; k < half; ++k) {
+        re[k] = x[2 * k] * window[2 * k];
+        im[k] = x[2 * k + 1] * window[2 * k + 1];
+    }
+    plan->forward(re.data(), im.data());
+
+    // X[k] = E[k] + e^{-2 pi i k / N} O[k], from Z[k] and conj(Z[N/2 - k])
+    for (size_t k = 0; k <= half; ++k) {
+        const size_t a = k % half;
+        const size_t b = (half - k) % half;
+        const double evenRe = 0.5 * (re[a] + re[b]);
+        const double evenIm = 0.5 * (im[a] - im[b]);
+        const double oddRe = 0.5 * (im[a] + im[b]);
+        const double oddIm = -0.5 * (re[a] - re[b]);
+        const double c = k < half ? unpackRe[k] : -1.0;
+        const double s = k < half ? unpackIm[k] : 0.0;
+        const double xr = evenRe + c * oddRe - s * oddIm;
+        const double xi = evenIm + c * oddIm + s * oddRe;
+        power[k] = xr * xr + xi * xi;
+    }
+    return power;
+}
+
+SpectrumMetrics SpectrumAnalyzer::analyze(const float* signal, size_t length, float fundamentalFreq,
+                                          float sampleRate, int maxHarmonic) {
+    SpectrumMetrics metrics;
+    if (length < 4 || sampleRate <= 0.0f) return metrics;
+
+    const auto& spectrum = powerSpectrum(signal, length);
+    const size_t size = plan->size() * 2;
+    const size_t bins = spectrum.size();
+    const double binHz = sampleRate / static_cast<double>(size);
+
+    // Main lobe of the window is +-4 bins; narrower when harmonics crowd
+    const double expected = fundamentalFreq > 0.0f ? fundamentalFreq / binHz : 0.0;
+    const size_t lobe = std::max<size_t>(1, std::min<size_t>(4, static_cast<size_t>(expected / 2.0)));
+
+    auto peakNear = [&](double bin, size_t radius) {
+        const size_t center = static_cast<size_t>(std::lround(bin));
+        const size_t first = center > radius ? center - radius : 1;
+        const size_t last = std::min(bins - 1, center + radius);
+        size_t peak = first;
+        for (size_t k = first; k <= last; ++k) {
+            if (spectrum[k] > spectrum[peak]) peak = k;
         }
+        return peak;
+    };
+    auto bandPower = [&](size_t center) {
+        double sum = 0.0;
+        const size_t first = center > lobe ? center - lobe : 0;
+        for (size_t k = first; k <= std::min(bins - 1, center + lobe); ++k) sum += spectrum[k];
+        return sum;
+    };
+
+    size_t fundamental;
+    if (expected >= 1.0) {
+        fundamental = peakNear(expected, 2);
+    } else {
+        fundamental = peakNear(static_cast<double>(bins) / 2.0, bins / 2);   // Strongest non-DC bin
+    }
+    const double fundamentalPower = bandPower(fundamental);
+    if (fundamentalPower <= 0.0) return metrics;
+
+    metrics.fundamentalHz = static_cast<float>(fundamental * binHz);
+    metrics.fundamentalAmplitude = static_cast<float>(std::sqrt(4.0 * fundamentalPower / (size * windowPower)));
+
+    const double fundamentalBin = expected >= 1.0 ? expected : static_cast<double>(fundamental);
+    double harmonicPower = 0.0;
+    for (int h = 2; h <= maxHarmonic; ++h) {
+        const double bin = fundamentalBin * h;
+        if (bin + lobe >= static_cast<double>(bins)) break;
+        const double p = bandPower(peakNear(bin, 1));
+        harmonicPower += p;
+        metrics.harmonicLevelsDb.push_back(static_cast<float>(10.0 * std::log10(std::max(p, 1e-30) / fundamentalPower)));
     }
-    return avgError / std::min(dspOutput.size(), spiceOutput.size());
+    metrics.thd = static_cast<float>(100.0 * std::sqrt(harmonicPower / fundamentalPower));
+
+    double total = 0.0;
+    for (size_t k = lobe + 1; k < bins; ++k) total += spectrum[k];   // All but DC
+    metrics.thdPlusNoise = static_cast<float>(100.0 * std::sqrt(std::max(0.0, total - fundamentalPower) / fundamentalPower));
+    return metrics;
+}
+
+float SpectrumAnalyzer::spectralError(const float* output, const float* reference, size_t length, float floorDb) {
+    if (length < 4) return 0.0f;
+    referencePower = powerSpectrum(reference, length);
+    const auto& outputPower = powerSpectrum(output, length);
+
+    const double peak = *std::max_element(referencePower.begin(), referencePower.end());
+    if (peak <= 0.0) return 0.0f;
+    const double threshold = peak * std::pow(10.0, floorDb / 10.0);
+
+    double sumSquares = 0.0;
+    size_t count = 0;
+    for (size_t k = 1; k < referencePower.size(); ++k) {
+        if (referencePower[k] < threshold) continue;
+        const double db = 10.0 * std::log10(std::max(outputPower[k], threshold * 1e-3) / referencePower[k]);
+        sumSquares += db * db;
+        ++count;
+    }
+    return count > 0 ? static_cast<float>(std::sqrt(sumSquares / count)) : 0.0f;
+}
+
+/**
+ * In-process ngspice
+ */
+namespace {
+
+// ABI of ngspice's sharedspice.h
+struct NgComplex {
+    double real;
+    double imag;
+};
+
+struct NgVectorInfo {
+    char* name;
+    int type;
+    short flags;
+    double* realData;
+    NgComplex* complexData;
+    int length;
+};
+
+using NgSendChar = int(char* text, int id, void* user);
+using NgSendStat = int(char* status, int id, void* user);
+using NgControlledExit = int(int status, bool unload, bool quit, int id, void* user);
+using NgInit = int(NgSendChar*, NgSendStat*, NgControlledExit*, void* sendData, void* sendInitData,
+                   void* backgroundRunning, void* user);
+using NgCommand = int(char* command);
+using NgCircuit = int(char** lines);
+using NgGetVectorInfo = NgVectorInfo*(char* name);
+
+#ifdef _WIN32
+const char* DEFAULT_NGSPICE_LIBRARY = "ngspice.dll";
+#elif defined(__APPLE__)
+const char* DEFAULT_NGSPICE_LIBRARY = "libngspice.dylib";
+#else
+const char* DEFAULT_NGSPICE_LIBRARY = "libngspice.so.0";
+#endif
+
+std::mutex g_ngspiceMutex;
+std::unique_ptr<NgspiceShared> g_ngspice;
+std::string g_ngspiceError;
+bool g_ngspiceLoadAttempted = false;
+
+} // namespace
+
+struct NgspiceShared::Library {
+    LiveSpice::SharedLibrary handle;
+    NgCommand* command = nullptr;
+    NgCircuit* circuit = nullptr;
+    NgGetVectorInfo* vectorInfo = nullptr;
+    std::string output;    // Simulator messages of the current run
+    bool exited = false;   // ngspice asked to be unloaded
+
+    explicit Library(const std::string& path) : handle(path) {}
+
+    int run(std::string text) { return command(text.data()); }
+
+    const NgVectorInfo* vector(const std::string& name) {
+        std::string key = name;
+        const NgVectorInfo* info = vectorInfo(key.data());
+        // Node voltages are stored under the node name: v(3) -> 3
+        if (!info && key.size() > 3 && (key[0] == 'v' || key[0] == 'V') && key[1] == '(' && key.back() == ')') {
+            key = key.substr(2, key.size() - 3);
+            info = vectorInfo(key.data());
+        }
+        return info && info->realData && info->length > 0 ? info : nullptr;
+    }
+
+    static int sendChar(char* text, int, void* user) {
+        auto* library = static_cast<Library*>(user);
+        library->output += text;
+        library->output += '\n';
+        return 0;
+    }
+
+    static int sendStat(char*, int, void*) { return 0; }
+
+    static int controlledExit(int, bool, bool, int, void* user) {
+        static_cast<Library*>(user)->exited = true;
+        return 0;
+    }
+};
+
+NgspiceShared::NgspiceShared(std::unique_ptr<Library> library) : library(std::move(library)) {}
+
+NgspiceShared::~NgspiceShared() = default;
+
+NgspiceShared* NgspiceShared::instance(const std::string& libraryPath) {
+    std::lock_guard<std::mutex> lock(g_ngspiceMutex);
+    if (g_ngspiceLoadAttempted) return g_ngspice.get();
+    g_ngspiceLoadAttempted = true;
+
+    auto library = std::make_unique<Library>(libraryPath.empty() ? DEFAULT_NGSPICE_LIBRARY : libraryPath);
+    if (!library->handle.isOpen()) {
+        g_ngspiceError = library->handle.error();
+        return nullptr;
+    }
+    auto* init = library->handle.symbol<NgInit>("ngSpice_Init");
+    library->command = library->handle.symbol<NgCommand>("ngSpice_Command");
+    library->circuit = library->handle.symbol<NgCircuit>("ngSpice_Circ");
+    library->vectorInfo = library->handle.symbol<NgGetVectorInfo>("ngGet_Vec_Info");
+    if (!init || !library->command || !library->circuit || !library->vectorInfo) {
+        g_ngspiceError = "not a libngspice (ngSpice_* functions missing)";
+        return nullptr;
+    }
+    if (init(&Library::sendChar, &Library::sendStat, &Library::controlledExit,
+             nullptr, nullptr, nullptr, library.get()) != 0) {
+        g_ngspiceError = "ngSpice_Init failed";
+        return nullptr;
+    }
+
+    g_ngspice.reset(new NgspiceShared(std::move(library)));
+    return g_ngspice.get();
+}
+
+std::string NgspiceShared::loadError() {
+    std::lock_guard<std::mutex> lock(g_ngspiceMutex);
+    return g_ngspiceError;
+}
+
+NgspiceShared::Result NgspiceShared::simulate(const std::string& netlist, const std::vector<std::string>& probes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Result result;
+    library->output.clear();
+    if (library->exited) {
+        result.log = "ngspice has exited";
+        return result;
+    }
+
+    // ngSpice_Circ takes the netlist as a null-terminated array of lines
+    std::vector<std::string> lines;
+    std::istringstream in(netlist);
+    for (std::string line; std::getline(in, line);) lines.push_back(line);
+    std::vector<char*> linePointers;
+    for (auto& line : lines) linePointers.push_back(line.data());
+    linePointers.push_back(nullptr);
+
+    if (library->circuit(linePointers.data()) == 0 && library->run("run") == 0 && !library->exited) {
+        if (const NgVectorInfo* time = library->vector("time")) {
+            result.time.assign(time->realData, time->realData + time->length);
+            result.ok = true;
+            for (const auto& probe : probes) {
+                const NgVectorInfo* values = library->vector(probe);
+                if (!values || values->length != time->length) {
+                    result.ok = false;
+                    break;
+                }
+                result.vectors.emplace_back(values->realData, values->realData + values->length);
+            }
+        }
+    }
+
+    // Free the circuit and its plots before the next run
+    library->run("remcirc");
+    library->run("destroy all");
+    result.log = library->output;
+    if (!result.ok) result.vectors.clear();
+    return result;
 }
 
 /**
  * Main Validation Runner
  */
+namespace {
+
+using Topology = SpiceNetlistGenerator::DiodeCircuitSpec::Topology;
+
+const char* topologyName(Topology topology) {
+    switch (topology) {
+        case Topology::BackToBack: return "back-to-back";
+        case Topology::Series: return "series";
+        case Topology::Parallel: return "parallel";
+    }
+    return "unknown";
+}
+
+// The test bench's output: node 3 after the series diodes, node 2 across the shunt diode
+std::string outputProbe(Topology topology) {
+    return topology == Topology::Parallel ? "v(2)" : "v(3)";
+}
+
+/**
+ * The test bench solved per sample (it is memoryless), Newton on the
+ * junction voltage. Rs of the idle diode of a back-to-back pair is
+ * ignored; its current is negligible whenever Rs matters.
+ */
+std::vector<float> solveDiodeStage(const SpiceNetlistGenerator::DiodeCircuitSpec& spec,
+                                   const std::vector<float>& input) {
+    const DiodeStageModel* model = findDiodeStageModel(spec.diodePartNumber);
+    const DiodeStageModel& d = model ? *model : DIODE_STAGE_MODELS[0];
+    const double nVt = d.n * 0.025852;   // 300 K
+    const bool pair = spec.topology == Topology::BackToBack;
+    const bool shunt = spec.topology == Topology::Parallel;
+    const double rSource = spec.sourceResistance;
+    const double rLoad = spec.loadResistance;
+    const double rSeries = rSource + d.Rs + rLoad;
+
+    std::vector<float> output(input.size());
+    if (shunt && rSource <= 0.0) {
+        return input;   // Ideal source: the diode cannot pull the node
+    }
+
+    double vj = 0.0;
+    for (size_t i = 0; i < input.size(); ++i) {
+        const double vin = input[i];
+        double id = 0.0;
+        for (int iteration = 0; iteration < 100; ++iteration) {
+            const double e = std::exp(std::clamp(vj / nVt, -80.0, 80.0));
+            double gd;
+            if (pair) {
+                id = d.Is * (e - 1.0 / e);
+                gd = d.Is * (e + 1.0 / e) / nVt;
+            } else {
+                id = d.Is * (e - 1.0);
+                gd = d.Is * e / nVt;
+            }
+
+            double f, df;
+            if (shunt) {
+                // (vin - v2) / Rsrc = v2 / Rload + id, with v2 = vj + id * Rs
+                const double v2 = vj + id * d.Rs;
+                f = (v2 - vin) / rSource + v2 / rLoad + id;
+                df = (1.0 + gd * d.Rs) * (1.0 / rSource + 1.0 / rLoad) + gd;
+            } else {
+                f = vj + id * rSeries - vin;
+                df = 1.0 + gd * rSeries;
+            }
+
+            const double step = std::clamp(f / df, -0.1, 0.1);
+            vj -= step;
+            if (std::abs(step) < 1e-12) break;
+        }
+        output[i] = static_cast<float>(shunt ? vj + id * d.Rs : id * rLoad);
+    }
+    return output;
+}
+
+bool ngspiceAvailable(const std::string& ngspicePath) {
+    const std::string command = "command -v \"" + ngspicePath + "\" > /dev/null 2>&1";
+    return std::system(command.c_str()) == 0;
+}
+
+bool spiceAvailable(const SpiceValidator::ValidationConfig& config) {
+    if (!config.runNgspice) return false;
+    if (config.backend == SpiceValidator::SpiceBackend::SharedLibrary) {
+        return NgspiceShared::instance(config.ngspiceLibrary) != nullptr;
+    }
+    return ngspiceAvailable(config.ngspicePath);
+}
+
+ValidationMetrics runCase(const SpiceValidator::ValidationCase& testCase,
+                          const SpiceValidator::ValidationConfig& config,
+                          const std::string& workDir, bool spice) {
+    TestSignalGenerator::SignalParams params;
+    params.sampleRate = config.sampleRate;
+    params.duration = config.duration;
+    params.frequency = testCase.frequency;
+    params.amplitude = testCase.amplitude;
+    // Topologies of a sweep share their (frequency, amplitude) stimulus
+    const auto stimulus = TestSignalGenerator::cachedSignal(TestSignalGenerator::SignalType::SineWave, params);
+    const std::vector<float>& input = *stimulus;
+    const auto dspOutput = solveDiodeStage(testCase.spec, input);
+
+    const bool shared = config.backend == SpiceValidator::SpiceBackend::SharedLibrary;
+    const std::string probe = outputProbe(testCase.spec.topology);
+    std::ostringstream source;
+    source << "SIN(0 " << testCase.amplitude << " " << testCase.frequency << ")";
+    std::string netlist = SpiceNetlistGenerator::generateDiodeTestBench(testCase.spec, source.str()) + "\n";
+    if (shared) {
+        netlist += SpiceNetlistGenerator::generateTransientCommand(config.duration, 1.0f / config.sampleRate);
+        netlist += ".end\n";
+    } else {
+        netlist += SpiceNetlistGenerator::generateTransientRawAnalysis(config.duration, 1.0f / config.sampleRate, probe);
+    }
+
+    if (config.generateNetlists || (spice && !shared)) {
+        std::filesystem::create_directories(workDir);
+        std::ofstream(workDir + "/case.cir") << netlist;
+    }
+
+    ValidationMetrics metrics;
+    if (spice && shared) {
+        auto result = NgspiceShared::instance(config.ngspiceLibrary)->simulate(netlist, {probe});
+        if (result.ok) {
+            const auto reference = resampleToRate(result.time, result.vectors.front(), config.sampleRate, input.size());
+            return ComparisonAnalyzer::compareWaveforms(dspOutput, reference, testCase.name,
+                                                        testCase.frequency, config.sampleRate);
+        }
+        metrics.notes = "libngspice failed: " + result.log.substr(0, 200);
+    } else if (spice) {
+        // Relative paths in the netlist (results.raw) resolve in the case directory
+        const std::string command = "cd \"" + workDir + "\" && \"" + config.ngspicePath +
+                                    "\" -b case.cir > ngspice.log 2>&1";
+        const int status = std::system(command.c_str());
+        const SpiceRawFile raw(workDir + "/results.raw");
+        const auto reference = resampleToRate(raw.scale(), raw.vector(probe), config.sampleRate, input.size());
+        if (status == 0 && !reference.empty()) {
+            return ComparisonAnalyzer::compareWaveforms(dspOutput, reference, testCase.name,
+                                                        testCase.frequency, config.sampleRate);
+        }
+        metrics.notes = "ngspice failed (see " + workDir + "/ngspice.log)";
+    } else if (!config.runNgspice) {
+        metrics.notes = "ngspice disabled: DSP metrics only";
+    } else if (shared) {
+        metrics.notes = "libngspice not loaded (" + NgspiceShared::loadError() + "): DSP metrics only";
+    } else {
+        metrics.notes = "ngspice not found: DSP metrics only";
+    }
+    metrics.circuitName = testCase.name;
+    metrics.thd = ComparisonAnalyzer::calculateTHD(dspOutput, testCase.frequency, config.sampleRate);
+    metrics.thdPlusNoise = ComparisonAnalyzer::calculateTHDPlusNoise(dspOutput, testCase.frequency, config.sampleRate);
+    return metrics;
+}
+
+} // namespace
+
+std::vector<SpiceValidator::ValidationCase> SpiceValidator::buildSweep(
+    const SpiceNetlistGenerator::DiodeCircuitSpec& spec,
+    const ValidationConfig& config) {
+    
+    std::vector<ValidationCase> cases;
+    for (Topology topology : config.topologies) {
+        for (float frequency : config.frequencies) {
+            for (float amplitude : config.amplitudes) {
+                ValidationCase testCase;
+                testCase.spec = spec;
+                testCase.spec.topology = topology;
+                testCase.frequency = frequency;
+                testCase.amplitude = amplitude;
+                std::ostringstream name;
+                name << spec.title << " (" << topologyName(topology) << ", " << frequency << " Hz, "
+                     << amplitude << " V)";
+                testCase.name = name.str();
+                cases.push_back(std::move(testCase));
+            }
+        }
+    }
+    return cases;
+}
+
+std::vector<ValidationMetrics> SpiceValidator::runSweep(
+    const std::vector<ValidationCase>& cases,
+    const ValidationConfig& config) {
+    
+    std::vector<ValidationMetrics> results(cases.size());
+    if (cases.empty()) return results;
+
+    const bool spice = spiceAvailable(config);
+    size_t jobs = config.jobs > 0 ? config.jobs : std::max(1u, std::thread::hardware_concurrency());
+    jobs = std::min(jobs, cases.size());
+
+    std::mutex resultMutex;
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < cases.size(); i = next.fetch_add(1)) {
+            char caseDir[32];
+            std::snprintf(caseDir, sizeof(caseDir), "/case_%03zu", i);
+            try {
+                results[i] = runCase(cases[i], config, config.outputDir + caseDir, spice);
+            } catch (const std::exception& e) {
+                results[i].circuitName = cases[i].name;
+                results[i].notes = e.what();
+            }
+            if (config.onResult) {
+                std::lock_guard<std::mutex> lock(resultMutex);
+                config.onResult(results[i]);
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t j = 1; j < jobs; ++j) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    return results;
+}
+
 std::vector<ValidationMetrics> SpiceValidator::validateAgainstMXR(const ValidationConfig& config) {
     std::vector<ValidationMetrics> results;
     
@@ -330,24 +1060,40 @@ std::vector<ValidationMetrics> SpiceValidator::validateAgainstMXR(const Validati
         std::cout << "  ✓ Generated: mxr_validation.cir" << std::endl;
     }
     
-    // Placeholder results (would populate from ngspice if available)
-    ValidationMetrics result;
-    result.circuitName = "MXR Distortion+ @ 1kHz";
-    result.thd = 2.5f;           // Would get from SPICE
-    result.amplitudeError = 0.08f;
-    result.rmsDifference = 0.015f;
-    result.peakVoltageError = 0.03f;
-    result.passed = true;
-    result.notes = "SPICE validation pending - ngspice not yet integrated";
+    // Sweep cases run concurrently, each in its own directory
+    const auto cases = buildSweep(mxrSpec, config);
+    std::cout << "\nRunning " << cases.size() << " validation case(s)..." << std::endl;
     
-    results.push_back(result);
+    ValidationConfig sweepConfig = config;
+    if (!sweepConfig.onResult) {
+        sweepConfig.onResult = [](const ValidationMetrics& result) {
+            std::cout << (result.passed ? "  ✓ " : "  ✗ ") << result.circuitName;
+            if (!result.notes.empty()) std::cout << " - " << result.notes;
+            std::cout << std::endl;
+        };
+    }
+    results = runSweep(cases, sweepConfig);
     
-    std::cout << "\n✓ Validation framework ready" << std::endl;
-    std::cout << "  Next: Run ngspice and compare results" << std::endl;
+    if (config.generateReport) {
+        generateValidationReport(results, config.outputDir);
+        std::cout << "\n✓ Report: " << config.outputDir << "/validation_report.html" << std::endl;
+    }
     
     return results;
 }
 
+ValidationMetrics SpiceValidator::validateDiodeStage(
+    const SpiceNetlistGenerator::DiodeCircuitSpec& spec,
+    const ValidationConfig& config) {
+    
+    ValidationCase testCase;
+    testCase.name = spec.title;
+    testCase.spec = spec;
+    if (!config.frequencies.empty()) testCase.frequency = config.frequencies.front();
+    if (!config.amplitudes.empty()) testCase.amplitude = config.amplitudes.front();
+    return runSweep({testCase}, config).front();
+}
+
 void SpiceValidator::generateValidationReport(
     const std::vector<ValidationMetrics>& results,
     const std::string& outputPath) {
@@ -369,13 +1115,14 @@ void SpiceValidator::generateValidationReport(
     report << "<p>Generated: January 31, 2026</p>\n";
     
     report << "<table>\n";
-    report << "<tr><th>Circuit</th><th>THD (%)</th><th>Amplitude Error</th>";
+    report << "<tr><th>Circuit</th><th>THD (%)</th><th>THD+N (%)</th><th>Amplitude Error</th>";
     report << "<th>RMS Diff</th><th>Peak Error</th><th>Status</th></tr>\n";
     
     for (const auto& r : results) {
         report << "<tr>\n";
         report << "<td>" << r.circuitName << "</td>\n";
         report << "<td>" << r.thd << "</td>\n";
+        report << "<td>" << r.thdPlusNoise << "</td>\n";
         report << "<td>" << r.amplitudeError << "</td>\n";
         report << "<td>" << r.rmsDifference << "</td>\n";
         report << "<td>" << r.peakVoltageError << "</td>\n";
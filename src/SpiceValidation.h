@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <cmath>
 
 namespace SpiceValidation {
@@ -30,11 +34,34 @@ public:
         float endFreq = 20000.0f;     // For chirp
     };
     
+    using SharedSignal = std::shared_ptr<const std::vector<float>>;
+    
     /**
      * Generate test signal
      */
     static std::vector<float> generateSignal(SignalType type, const SignalParams& params);
     
+    /**
+     * Generate test signal into a caller-owned buffer
+     * Sines, squares and chirps come from recursive oscillators restarted
+     * from exact values every 1024 samples, not from sin() per sample.
+     * @param length Samples to write (signalLength(params) for the whole signal)
+     */
+    static void generateSignal(SignalType type, const SignalParams& params, float* output, size_t length);
+    
+    /** Samples in a signal of params.duration */
+    static size_t signalLength(const SignalParams& params);
+    
+    /**
+     * Signal from a process-wide cache of immutable signals keyed by type
+     * and parameters, generated on first request. Safe to share across
+     * threads and test cases.
+     */
+    static SharedSignal cachedSignal(SignalType type, const SignalParams& params);
+    
+    /** Drop all cached signals (signals still referenced stay alive) */
+    static void clearCache();
+    
     /**
      * Generate logarithmic sweep (for frequency response)
      */
@@ -46,6 +73,15 @@ public:
      */
     static std::vector<float> generateStepSweep(float minAmplitude, float maxAmplitude, 
                                                 float stepSize, float sampleRate);
+    
+    /**
+     * Generate stepped input levels into a caller-owned buffer
+     * @param length At most stepSweepLength(...) samples
+     */
+    static void generateStepSweep(float minAmplitude, float maxAmplitude, float stepSize,
+                                  float sampleRate, float* output, size_t length);
+    
+    static size_t stepSweepLength(float minAmplitude, float maxAmplitude, float stepSize, float sampleRate);
 };
 
 /**
@@ -77,9 +113,23 @@ public:
                                               const std::string& signalDescription);
     
     /**
-     * Generate transient analysis command
+     * The .tran line alone, for simulators driven through an API
+     */
+    static std::string generateTransientCommand(float endTime, float stepTime);
+
+    /**
+     * Generate transient analysis command (batch-mode .control block)
+     * @param probes Vectors written to results.txt
+     */
+    static std::string generateTransientAnalysis(float endTime, float stepTime,
+                                                 const std::string& probes = "v(2) v(3)");
+    
+    /**
+     * Transient analysis writing a binary raw file (results.raw), for long
+     * runs read back through SpiceRawFile
      */
-    static std::string generateTransientAnalysis(float endTime, float stepTime);
+    static std::string generateTransientRawAnalysis(float endTime, float stepTime,
+                                                    const std::string& probes = "v(2) v(3)");
     
     /**
      * Generate frequency response analysis
@@ -97,15 +147,84 @@ public:
  */
 struct ValidationMetrics {
     std::string circuitName;
-    float thd;               // Total Harmonic Distortion %
-    float frequencyError;    // ±dB error across range
-    float amplitudeError;    // ±dB error
-    float peakVoltageError;  // Volts
-    float rmsDifference;     // RMS of difference signal
-    bool passed;
+    float thd = 0.0f;              // Total Harmonic Distortion %
+    float thdPlusNoise = 0.0f;     // THD+N %
+    float frequencyError = 0.0f;   // ±dB error across range
+    float amplitudeError = 0.0f;   // ±dB error
+    float peakVoltageError = 0.0f; // Volts
+    float rmsDifference = 0.0f;    // RMS of difference signal
+    bool passed = false;
     std::string notes;
 };
 
+/**
+ * Radix-2 FFT plan for one power-of-two size
+ * Twiddles (contiguous per stage) and the bit-reversal order are computed
+ * once; data is split into real and imaginary arrays so each stage's
+ * butterflies run over contiguous memory and vectorize.
+ */
+class FFTPlan {
+public:
+    explicit FFTPlan(size_t size);
+
+    size_t size() const { return n; }
+
+    /** In-place forward transform (unnormalized) */
+    void forward(float* re, float* im) const;
+
+private:
+    size_t n;
+    std::vector<uint32_t> bitReversed;
+    std::vector<float> twiddleRe, twiddleIm;   // Stage with half-size h at [h - 1, 2h - 1)
+};
+
+/**
+ * Spectrum of a test response
+ */
+struct SpectrumMetrics {
+    float fundamentalHz = 0.0f;          // Peak bin near the expected fundamental
+    float fundamentalAmplitude = 0.0f;   // Peak volts
+    std::vector<float> harmonicLevelsDb; // H2, H3, ... relative to the fundamental (dBc)
+    float thd = 0.0f;                    // %
+    float thdPlusNoise = 0.0f;           // %
+};
+
+/**
+ * Windowed spectral analysis with a reusable plan and scratch buffers
+ * A real signal of N samples is transformed as N/2 complex points. The
+ * Blackman-Harris window (-92 dB sidelobes) keeps leakage below the
+ * harmonics of interest; each tone is the power summed over its main lobe.
+ * Analyses use the last power-of-two samples of the signal (up to 65536),
+ * i.e. the settled part of a transient response. Not thread-safe: use one
+ * analyzer per thread.
+ */
+class SpectrumAnalyzer {
+public:
+    static constexpr size_t MAX_SIZE = 65536;
+
+    SpectrumMetrics analyze(const float* signal, size_t length, float fundamentalFreq, float sampleRate,
+                            int maxHarmonic = 10);
+
+    /**
+     * RMS dB difference of the magnitude spectra over the bins where the
+     * reference is within floorDb of its peak
+     */
+    float spectralError(const float* output, const float* reference, size_t length, float floorDb = -60.0f);
+
+    /** Power of bins 0..N/2 of the windowed signal (valid until the next call) */
+    const std::vector<double>& powerSpectrum(const float* signal, size_t length);
+
+private:
+    std::unique_ptr<FFTPlan> plan;       // Half size: N/2 complex points
+    std::vector<float> window;
+    std::vector<float> unpackRe, unpackIm;   // e^{-2 pi i k / N}, k < N/2
+    std::vector<float> re, im;
+    std::vector<double> power, referencePower;
+    double windowPower = 0.0;            // Sum of squared window samples
+
+    size_t prepare(size_t length);
+};
+
 /**
  * Comparison Framework
  */
@@ -117,16 +236,24 @@ public:
     static ValidationMetrics compareWaveforms(
         const std::vector<float>& dspOutput,
         const std::vector<float>& spiceReference,
-        const std::string& circuitName);
+        const std::string& circuitName,
+        float fundamentalFreq = 1000.0f,
+        float sampleRate = 44100.0f);
     
     /**
-     * Calculate THD (Total Harmonic Distortion)
+     * Calculate THD (Total Harmonic Distortion) in percent, harmonics 2-10
      */
     static float calculateTHD(const std::vector<float>& signal, 
                              float fundamentalFreq, float sampleRate);
+
+    /**
+     * THD+N in percent: everything but DC and the fundamental
+     */
+    static float calculateTHDPlusNoise(const std::vector<float>& signal,
+                                       float fundamentalFreq, float sampleRate);
     
     /**
-     * Calculate frequency response error
+     * Calculate frequency response error (RMS dB difference of the spectra)
      */
     static float calculateFrequencyResponseError(
         const std::vector<float>& dspOutput,
@@ -134,18 +261,108 @@ public:
         float sampleRate);
 };
 
+/**
+ * In-process ngspice (libngspice, loaded at run time)
+ * Netlists are passed from memory and vectors read back from the
+ * simulator: no netlist files, output parsing or process per run.
+ * libngspice keeps one circuit per process, so simulations through the
+ * instance are serialized.
+ */
+class NgspiceShared {
+public:
+    struct Result {
+        bool ok = false;
+        std::vector<double> time;
+        std::vector<std::vector<double>> vectors;   // In probe order
+        std::string log;                            // Simulator output
+    };
+
+    /**
+     * The process-wide instance, loaded on first use
+     * @param libraryPath libngspice to load (empty: platform default name)
+     * @return nullptr when the library cannot be loaded
+     */
+    static NgspiceShared* instance(const std::string& libraryPath = {});
+
+    /** Why instance() returned nullptr */
+    static std::string loadError();
+
+    /**
+     * Load a netlist (analysis line included, no .control block), run it
+     * and read back the probed vectors
+     */
+    Result simulate(const std::string& netlist, const std::vector<std::string>& probes);
+
+    ~NgspiceShared();
+
+private:
+    struct Library;
+    std::unique_ptr<Library> library;
+    std::mutex mutex;
+
+    explicit NgspiceShared(std::unique_ptr<Library> library);
+};
+
 /**
  * Main Validation Runner
  */
 class SpiceValidator {
 public:
+    using Topology = SpiceNetlistGenerator::DiodeCircuitSpec::Topology;
+
+    enum class SpiceBackend {
+        Process,         // ngspice -b per case, netlist and results on disk
+        SharedLibrary    // libngspice in-process (see NgspiceShared)
+    };
+
     struct ValidationConfig {
         bool generateNetlists = true;
         bool runNgspice = true;        // Requires ngspice installed
+        SpiceBackend backend = SpiceBackend::Process;
         std::string ngspicePath = "ngspice";
+        std::string ngspiceLibrary;    // SharedLibrary backend (empty: platform default name)
         bool generateReport = true;
         std::string outputDir = "./validation_results";
+
+        // Sweep: one case per (topology, frequency, amplitude)
+        std::vector<Topology> topologies = {Topology::BackToBack};
+        std::vector<float> frequencies = {1000.0f};   // Hz
+        std::vector<float> amplitudes = {0.1f};       // V (peak)
+        float sampleRate = 44100.0f;
+        float duration = 0.05f;                       // Seconds per case
+        unsigned jobs = 0;                            // Worker threads (0 = hardware threads)
+
+        // Called as each case finishes (one call at a time, in completion order)
+        std::function<void(const ValidationMetrics&)> onResult;
+    };
+
+    /**
+     * One test case: a circuit driven by one sine
+     */
+    struct ValidationCase {
+        std::string name;
+        SpiceNetlistGenerator::DiodeCircuitSpec spec;
+        float frequency = 1000.0f;
+        float amplitude = 0.1f;
     };
+
+    /**
+     * Cases for every topology, frequency and amplitude in the config
+     */
+    static std::vector<ValidationCase> buildSweep(
+        const SpiceNetlistGenerator::DiodeCircuitSpec& spec,
+        const ValidationConfig& config);
+
+    /**
+     * Run cases as independent tasks on config.jobs worker threads
+     * With the Process backend each case simulates in its own directory
+     * under config.outputDir (netlist, ngspice log, binary results.raw), so
+     * ngspice runs proceed concurrently. Results are streamed through
+     * config.onResult and returned in case order.
+     */
+    static std::vector<ValidationMetrics> runSweep(
+        const std::vector<ValidationCase>& cases,
+        const ValidationConfig& config);
     
     /**
      * Run full validation suite against MXR Distortion+ circuit
@@ -154,7 +371,8 @@ public:
         const ValidationConfig& config);
     
     /**
-     * Validate generic diode clipping stage
+     * Validate generic diode clipping stage at the first sweep frequency
+     * and amplitude of the config
      */
     static ValidationMetrics validateDiodeStage(
         const SpiceNetlistGenerator::DiodeCircuitSpec& spec,
@@ -0,0 +1,436 @@
+#include "StageGraph.h"
+#include "TraceZones.h"
+#include "Denormals.h"
+#include <algorithm>
+#include <cmath>
+
+namespace LiveSpiceDSP {
+
+namespace {
+
+/**
+ * Cutoff for a control position: a decade sweep ending at the analysed value
+ * Kept below Nyquist so the bilinear designs stay stable.
+ */
+float sweptFrequency(float frequency, float position, float sampleRate) {
+    float f = frequency * std::pow(10.0f, position - 1.0f);
+    return std::clamp(f, 10.0f, 0.45f * sampleRate);
+}
+
+// ============================================================================
+// Nodes
+// ============================================================================
+
+/**
+ * Fixed or pot-controlled gain, ramped across the block on changes
+ */
+class GainNode : public StageGraph::Node {
+public:
+    explicit GainNode(float gain) : m_base(gain), m_target(gain), m_current(gain) {}
+
+    void setControl(float position) override { m_target = m_base * position * position; }
+
+    void process(float* const* channels, size_t numChannels, size_t numSamples) override {
+        if (m_current == m_target) {
+            if (m_current == 1.0f) return;
+            for (size_t ch = 0; ch < numChannels; ++ch)
+                for (size_t i = 0; i < numSamples; ++i) channels[ch][i] *= m_current;
+            return;
+        }
+
+        const float step = (m_target - m_current) / static_cast<float>(std::max<size_t>(numSamples, 1));
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            float g = m_current;
+            for (size_t i = 0; i < numSamples; ++i) {
+                g += step;
+                channels[ch][i] *= g;
+            }
+        }
+        m_current = m_target;
+    }
+
+    void reset() override { m_current = m_target; }
+
+private:
+    float m_base, m_target, m_current;
+};
+
+/**
+ * High-, low- or band-pass Butterworth sections, one bank per channel
+ * Band-pass is a high-pass an octave below the centre into a low-pass an
+ * octave above it.
+ */
+class FilterNode : public StageGraph::Node {
+public:
+    FilterNode(StageNodeSpec::Kind kind, float frequency, float sampleRate, size_t numChannels, MonotonicArena& arena)
+        : m_kind(kind), m_frequency(frequency), m_sampleRate(sampleRate),
+          m_numStages(kind == StageNodeSpec::Kind::BandPass ? 2 : 1), m_numChannels(numChannels),
+          m_sections(arena.createArray<BiquadFilter>(numChannels * m_numStages)) {
+        design(std::clamp(frequency, 10.0f, 0.45f * sampleRate));
+    }
+
+    void setControl(float position) override {
+        design(sweptFrequency(m_frequency, position, m_sampleRate));
+    }
+
+    void process(float* const* channels, size_t numChannels, size_t numSamples) override {
+        for (size_t ch = 0; ch < std::min(numChannels, m_numChannels); ++ch) {
+            BiquadFilter* sections = m_sections + ch * m_numStages;
+            for (size_t s = 0; s < m_numStages; ++s) sections[s].processBlock(channels[ch], channels[ch], numSamples);
+        }
+    }
+
+    void reset() override {
+        for (size_t i = 0; i < m_numChannels * m_numStages; ++i) m_sections[i].reset();
+    }
+
+private:
+    StageNodeSpec::Kind m_kind;
+    float m_frequency, m_sampleRate;
+    size_t m_numStages, m_numChannels;
+    BiquadFilter* m_sections;  // [channel][stage], in the graph's arena
+
+    void design(float f) {
+        for (size_t ch = 0; ch < m_numChannels; ++ch) {
+            BiquadFilter* sections = m_sections + ch * m_numStages;
+            switch (m_kind) {
+                case StageNodeSpec::Kind::HighPass:
+                    sections[0].setCoefficients(BiquadFilter::designHighPass(m_sampleRate, f));
+                    break;
+                case StageNodeSpec::Kind::BandPass:
+                    sections[0].setCoefficients(BiquadFilter::designHighPass(m_sampleRate, std::max(f * 0.5f, 10.0f)));
+                    sections[1].setCoefficients(BiquadFilter::designLowPass(m_sampleRate, std::min(f * 2.0f, 0.45f * m_sampleRate)));
+                    break;
+                default:
+                    sections[0].setCoefficients(BiquadFilter::designLowPass(m_sampleRate, f));
+                    break;
+            }
+        }
+    }
+};
+
+/**
+ * Drive gain into a back-to-back diode pair, one solver per channel
+ */
+class DiodeClipperNode : public StageGraph::Node {
+public:
+    DiodeClipperNode(const StageNodeSpec& spec, size_t numChannels, MonotonicArena& arena)
+        : m_maxDrive(std::max(spec.gain, 1.0f)), m_target(m_maxDrive), m_current(m_maxDrive), m_numChannels(numChannels),
+          m_stages(arena.createArray<Nonlinear::DiodeClippingStage>(
+              numChannels, spec.diode, Nonlinear::DiodeClippingStage::TopologyType::BackToBackDiodes, spec.impedance)) {}
+
+    void setControl(float position) override { m_target = 1.0f + (m_maxDrive - 1.0f) * position; }
+
+    void process(float* const* channels, size_t numChannels, size_t numSamples) override {
+        const float step = (m_target - m_current) / static_cast<float>(std::max<size_t>(numSamples, 1));
+        for (size_t ch = 0; ch < std::min(numChannels, m_numChannels); ++ch) {
+            float g = m_current;
+            for (size_t i = 0; i < numSamples; ++i) {
+                g += step;
+                channels[ch][i] *= g;
+            }
+            m_stages[ch].processBlock(channels[ch], numSamples);
+        }
+        m_current = m_target;
+    }
+
+    void reset() override {
+        m_current = m_target;
+        for (size_t ch = 0; ch < m_numChannels; ++ch) m_stages[ch].reset();
+    }
+
+private:
+    float m_maxDrive, m_target, m_current;
+    size_t m_numChannels;
+    Nonlinear::DiodeClippingStage* m_stages;
+};
+
+/**
+ * Common-emitter stage biased so the collector idles at mid-swing
+ * The quiescent input is the stage's cached DC operating point; the node outputs the
+ * AC-coupled collector swing about that point (inverting), scaled so the
+ * rails sit at +/-1, then by the level.
+ */
+class BJTAmplifierNode : public StageGraph::Node {
+public:
+    BJTAmplifierNode(const StageNodeSpec& spec, size_t numChannels, MonotonicArena& arena)
+        : m_level(spec.gain), m_target(spec.gain), m_current(spec.gain), m_numChannels(numChannels),
+          m_stages(arena.createArray<Nonlinear::BJTAmplifierStage>(numChannels, spec.transistor, spec.impedance)) {
+        if (numChannels == 0) return;
+
+        // Shared per part, so rebuilding the graph does not re-solve the bias
+        for (size_t ch = 0; ch < numChannels; ++ch) m_stages[ch].solveOperatingPoint();
+        m_quiescentIn = m_stages[0].getOperatingPoint().inputVoltage;
+        m_quiescentOut = m_stages[0].getOperatingPoint().outputVoltage;
+        m_scale = m_quiescentOut > 0.0f ? 1.0f / m_quiescentOut : 0.0f;
+    }
+
+    void setControl(float position) override { m_target = m_level * position; }
+
+    void process(float* const* channels, size_t numChannels, size_t numSamples) override {
+        const float step = (m_target - m_current) / static_cast<float>(std::max<size_t>(numSamples, 1));
+        for (size_t ch = 0; ch < std::min(numChannels, m_numChannels); ++ch) {
+            auto& stage = m_stages[ch];
+            float g = m_current;
+            for (size_t i = 0; i < numSamples; ++i) {
+                g += step;
+                const float swing = stage.processInputVoltage(m_quiescentIn + channels[ch][i]) - m_quiescentOut;
+                channels[ch][i] = swing * m_scale * g;
+            }
+        }
+        m_current = m_target;
+    }
+
+    void reset() override {
+        m_current = m_target;
+        for (size_t ch = 0; ch < m_numChannels; ++ch) m_stages[ch].reset();
+    }
+
+private:
+    float m_level, m_target, m_current;
+    size_t m_numChannels;
+    Nonlinear::BJTAmplifierStage* m_stages;
+    float m_quiescentIn = 0.0f, m_quiescentOut = 0.0f, m_scale = 0.0f;
+};
+
+/**
+ * Tone stack tilt: treble follows the control over +/-12 dB, bass the
+ * opposite way over half that
+ */
+class ToneStackNode : public StageGraph::Node {
+public:
+    ToneStackNode(float sampleRate, size_t numChannels, MonotonicArena& arena)
+        : m_numChannels(numChannels), m_stacks(arena.createArray<ToneStackController>(numChannels, sampleRate)) {}
+
+    void setControl(float position) override {
+        const float tilt = (2.0f * position - 1.0f) * ToneStackController::GAIN_RANGE_DB;
+        for (size_t ch = 0; ch < m_numChannels; ++ch) {
+            m_stacks[ch].setTrebleGain(tilt);
+            m_stacks[ch].setBassGain(-0.5f * tilt);
+        }
+    }
+
+    void process(float* const* channels, size_t numChannels, size_t numSamples) override {
+        for (size_t ch = 0; ch < std::min(numChannels, m_numChannels); ++ch)
+            m_stacks[ch].processBlock(channels[ch], channels[ch], numSamples);
+    }
+
+    void reset() override {
+        for (size_t ch = 0; ch < m_numChannels; ++ch) m_stacks[ch].reset();
+    }
+
+private:
+    size_t m_numChannels;
+    ToneStackController* m_stacks;
+};
+
+StageGraph::Node* createNode(const StageNodeSpec& spec, float sampleRate, size_t numChannels, MonotonicArena& arena) {
+    switch (spec.kind) {
+        case StageNodeSpec::Kind::HighPass:
+        case StageNodeSpec::Kind::LowPass:
+        case StageNodeSpec::Kind::BandPass:
+            return arena.create<FilterNode>(spec.kind, spec.frequency, sampleRate, numChannels, arena);
+        case StageNodeSpec::Kind::DiodeClipper:
+            return arena.create<DiodeClipperNode>(spec, numChannels, arena);
+        case StageNodeSpec::Kind::BJTAmplifier:
+            return arena.create<BJTAmplifierNode>(spec, numChannels, arena);
+        case StageNodeSpec::Kind::ToneStack:
+            return arena.create<ToneStackNode>(sampleRate, numChannels, arena);
+        case StageNodeSpec::Kind::Gain:
+        default:
+            return arena.create<GainNode>(spec.gain);
+    }
+}
+
+// Zone names for LIVESPICE_TRACE captures
+const char* traceName(StageNodeSpec::Kind kind) {
+    switch (kind) {
+        case StageNodeSpec::Kind::HighPass: return "High-pass";
+        case StageNodeSpec::Kind::LowPass: return "Low-pass";
+        case StageNodeSpec::Kind::BandPass: return "Band-pass";
+        case StageNodeSpec::Kind::DiodeClipper: return "Diode clipper";
+        case StageNodeSpec::Kind::BJTAmplifier: return "BJT amplifier";
+        case StageNodeSpec::Kind::ToneStack: return "Tone stack";
+        case StageNodeSpec::Kind::Gain:
+        default: return "Gain";
+    }
+}
+
+}  // namespace
+
+// ============================================================================
+// StageGraph Implementation
+// ============================================================================
+
+StageGraph::StageGraph() {
+    for (auto& control : m_controls) control.store(0.5f, std::memory_order_relaxed);
+}
+
+StageGraph::~StageGraph() = default;
+
+void StageGraph::build(const std::vector<StageNodeSpec>& specs, float sampleRate, size_t numChannels,
+                       size_t maxBlockSize) {
+    m_arena.release();
+    m_numChannels = numChannels;
+    m_maxBlockSize = std::max<size_t>(maxBlockSize, 1);
+    m_numNodes = specs.size();
+    m_chain = true;
+
+    // Branch buffers plus a rough per-node allowance, so a typical build fits one block
+    bool branching = false;
+    for (size_t index = 0; index < m_numNodes; ++index) {
+        const auto& inputs = specs[index].inputs;
+        branching = branching || inputs.size() > 1 || (inputs.size() == 1 && inputs[0] != static_cast<int>(index) - 1);
+    }
+    const size_t bufferBytes = branching ? numChannels * m_maxBlockSize * sizeof(float) : 0;
+    m_arena.reserve(m_numNodes * (bufferBytes + 2048 * (numChannels + 1)));
+
+    m_nodes = m_arena.createArray<Binding>(m_numNodes);
+    for (size_t index = 0; index < m_numNodes; ++index) {
+        const auto& spec = specs[index];
+        Binding& binding = m_nodes[index];
+        binding.node = createNode(spec, sampleRate, numChannels, m_arena);
+        binding.traceName = traceName(spec.kind);
+        binding.control = spec.control >= 0 && static_cast<size_t>(spec.control) < MAX_CONTROLS ? spec.control : -1;
+        if (binding.control >= 0) {
+            binding.applied = getControl(static_cast<size_t>(binding.control));
+            binding.node->setControl(binding.applied);
+            binding.node->reset();  // Start at the control position, no ramp
+        }
+
+        const int previous = static_cast<int>(index) - 1;
+        binding.numInputs = std::max<size_t>(spec.inputs.size(), 1);
+        binding.inputs = m_arena.createArray<int>(binding.numInputs, previous);
+        for (size_t i = 0; i < spec.inputs.size(); ++i) {
+            const int input = spec.inputs[i];
+            if (input >= StageNodeSpec::GRAPH_INPUT && input < static_cast<int>(index)) binding.inputs[i] = input;
+        }
+        m_chain = m_chain && binding.numInputs == 1 && binding.inputs[0] == previous;
+    }
+
+    // Level = longest path from the block input; a level's nodes only read earlier levels
+    std::vector<size_t> level(m_numNodes, 0);
+    m_numLevels = 0;
+    for (size_t index = 0; index < m_numNodes; ++index) {
+        const Binding& binding = m_nodes[index];
+        for (size_t i = 0; i < binding.numInputs; ++i) {
+            if (binding.inputs[i] >= 0)
+                level[index] = std::max(level[index], level[static_cast<size_t>(binding.inputs[i])] + 1);
+        }
+        m_numLevels = std::max(m_numLevels, level[index] + 1);
+    }
+
+    m_order = m_arena.createArray<size_t>(m_numNodes);
+    m_levelStarts = m_arena.createArray<size_t>(m_numLevels + 1);
+    size_t position = 0;
+    for (size_t l = 0; l < m_numLevels; ++l) {
+        m_levelStarts[l] = position;
+        for (size_t index = 0; index < m_numNodes; ++index) {
+            if (level[index] == l) m_order[position++] = index;
+        }
+    }
+    if (m_levelStarts) m_levelStarts[m_numLevels] = position;
+
+    // A chain runs in place; branches need every node's output kept for its readers
+    m_slice = m_arena.createArray<float*>(numChannels, nullptr);
+    if (!m_chain) {
+        float* buffers = m_arena.createArray<float>(m_numNodes * numChannels * m_maxBlockSize);
+        for (size_t index = 0; index < m_numNodes; ++index) {
+            m_nodes[index].output = m_arena.createArray<float*>(numChannels, nullptr);
+            for (size_t ch = 0; ch < numChannels; ++ch) {
+                m_nodes[index].output[ch] = buffers + (index * numChannels + ch) * m_maxBlockSize;
+            }
+        }
+    }
+    m_built = true;
+}
+
+void StageGraph::processBlock(float* const* channels, size_t numChannels, size_t numSamples) {
+    ScopedFlushDenormals noDenormals;
+    numChannels = std::min(numChannels, m_numChannels);
+
+    if (m_chain) {
+        for (size_t index = 0; index < m_numNodes; ++index) {
+            LIVESPICE_TRACE_ZONE(m_nodes[index].traceName);
+            updateControl(m_nodes[index]);
+            m_nodes[index].node->process(channels, numChannels, numSamples);
+        }
+        return;
+    }
+
+    // Slices of the block so the node buffers stay within maxBlockSize
+    for (size_t offset = 0; offset < numSamples; offset += m_maxBlockSize) {
+        for (size_t ch = 0; ch < numChannels; ++ch) m_slice[ch] = channels[ch] + offset;
+        m_blockChannels = numChannels;
+        m_blockSamples = std::min(m_maxBlockSize, numSamples - offset);
+
+        for (size_t l = 0; l < m_numLevels; ++l) {
+            const size_t begin = m_levelStarts[l], count = m_levelStarts[l + 1] - begin;
+            if (m_pool && count > 1) {
+                m_levelBegin = begin;
+                m_pool->run(count, &StageGraph::runNodeTask, this);
+                continue;
+            }
+            for (size_t i = 0; i < count; ++i) runNode(m_order[begin + i]);
+        }
+
+        const Binding& last = m_nodes[m_numNodes - 1];
+        for (size_t ch = 0; ch < numChannels; ++ch) {
+            std::copy(last.output[ch], last.output[ch] + m_blockSamples, m_slice[ch]);
+        }
+    }
+}
+
+void StageGraph::updateControl(Binding& binding) {
+    if (binding.control < 0) return;
+    const float position = m_controls[static_cast<size_t>(binding.control)].load(std::memory_order_relaxed);
+    if (position != binding.applied) {
+        binding.applied = position;
+        binding.node->setControl(position);
+    }
+}
+
+void StageGraph::runNode(size_t index) {
+    Binding& binding = m_nodes[index];
+    LIVESPICE_TRACE_ZONE(binding.traceName);
+    const size_t n = m_blockSamples;
+
+    // Sum the inputs into this node's buffer, then process it there
+    for (size_t ch = 0; ch < m_blockChannels; ++ch) {
+        float* out = binding.output[ch];
+        bool first = true;
+        for (size_t i = 0; i < binding.numInputs; ++i) {
+            const int input = binding.inputs[i];
+            const float* in = input < 0 ? m_slice[ch] : m_nodes[static_cast<size_t>(input)].output[ch];
+            if (first) {
+                std::copy(in, in + n, out);
+                first = false;
+            } else {
+                for (size_t i = 0; i < n; ++i) out[i] += in[i];
+            }
+        }
+    }
+
+    updateControl(binding);
+    binding.node->process(binding.output, m_blockChannels, n);
+}
+
+void StageGraph::runNodeTask(void* graph, size_t index) {
+    auto* self = static_cast<StageGraph*>(graph);
+    self->runNode(self->m_order[self->m_levelBegin + index]);
+}
+
+void StageGraph::reset() {
+    for (size_t index = 0; index < m_numNodes; ++index) m_nodes[index].node->reset();
+}
+
+void StageGraph::setControl(size_t slot, float position) {
+    if (slot < MAX_CONTROLS)
+        m_controls[slot].store(std::clamp(position, 0.0f, 1.0f), std::memory_order_relaxed);
+}
+
+float StageGraph::getControl(size_t slot) const {
+    return slot < MAX_CONTROLS ? m_controls[slot].load(std::memory_order_relaxed) : 0.0f;
+}
+
+}  // namespace LiveSpiceDSP
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "DiodeModels.h"
+#include "MonotonicArena.h"
+#include "RealtimeThreadPool.h"
+#include "StateSpaceFilter.h"
+#include "TransistorModels.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file StageGraph.h
+ * @brief Runtime-built stage chain for auditioning schematics without codegen
+ *
+ * The translator turns analyzed circuit stages into C++ that has to be
+ * compiled into a plugin before anyone can hear it. StageGraph interprets
+ * the same stages directly: build() instantiates one block-processing node
+ * per stage from the existing kernels (DiodeClippingStage, BiquadFilterBank,
+ * BJTAmplifierStage, ToneStackController) with all state allocated up
+ * front, and processBlock() runs the chain in place, one node over the
+ * whole block at a time, without allocating.
+ *
+ * Nodes, their per-channel kernels, the schedule and the branch buffers
+ * all live in one MonotonicArena: a build is a few bump allocations into
+ * one block, and a rebuild or teardown frees them all at once.
+ *
+ * Node descriptions are plain data (StageNodeSpec), so this library does not
+ * depend on the parser or analyzer; the host maps CircuitStages onto specs.
+ *
+ * Specs may branch: a node lists the earlier nodes it sums as its input,
+ * and the last node is the output. build() sorts the nodes into levels
+ * whose members depend only on earlier levels; with a RealtimeThreadPool
+ * attached, the nodes of a level run in parallel. A plain chain keeps the
+ * in-place path and never touches the pool.
+ */
+
+/**
+ * One node of a StageGraph
+ * A node may follow a control (a potentiometer): its position 0..1 scales
+ * the node's main setting, as documented per Kind.
+ */
+struct StageNodeSpec {
+    enum class Kind {
+        Gain,          // gain (control: audio-taper volume, gain * p^2)
+        HighPass,      // frequency (control: sweeps a decade down to frequency / 10)
+        LowPass,       // frequency (control: sweeps a decade down to frequency / 10)
+        BandPass,      // frequency, octave either side (control: as LowPass)
+        DiodeClipper,  // gain into the clipper, diode, impedance (control: drive 1..gain)
+        BJTAmplifier,  // common-emitter stage biased to mid-supply (control: output level)
+        ToneStack      // bass/treble tilt (control: 0 = dark, 0.5 = flat, 1 = bright)
+    };
+
+    Kind kind = Kind::Gain;
+    float gain = 1.0f;
+    float frequency = 1000.0f;
+    float impedance = 10000.0f;
+    Nonlinear::DiodeCharacteristics diode = Nonlinear::DiodeCharacteristics::Si1N4148();
+    Nonlinear::BJTCharacteristics transistor = Nonlinear::BJTCharacteristics::TwoN3904();
+    int control = -1;  // Control slot, -1 = fixed
+
+    /**
+     * Earlier nodes summed into this one (GRAPH_INPUT for the block input);
+     * empty = the previous node, or the block input for the first node
+     */
+    static constexpr int GRAPH_INPUT = -1;
+    std::vector<int> inputs;
+};
+
+class StageGraph {
+public:
+    static constexpr size_t MAX_CONTROLS = 64;
+
+    /**
+     * Node interface: processes numChannels channels of numSamples in place
+     */
+    class Node {
+    public:
+        virtual ~Node() = default;
+        virtual void process(float* const* channels, size_t numChannels, size_t numSamples) = 0;
+        virtual void reset() = 0;
+
+        /** New control position (audio thread, before process; never allocates) */
+        virtual void setControl(float position) { (void) position; }
+    };
+
+    StageGraph();
+    ~StageGraph();
+
+    /**
+     * Instantiate the nodes and their schedule (allocates; not real-time safe)
+     * Channels beyond numChannels pass through processBlock() untouched.
+     * Branching graphs render in slices of at most maxBlockSize samples;
+     * inputs naming the node itself or a later one fall back to the previous node.
+     */
+    void build(const std::vector<StageNodeSpec>& specs, float sampleRate, size_t numChannels,
+               size_t maxBlockSize = 1024);
+
+    /**
+     * Workers for the independent nodes of a level (nullptr = run them all
+     * on the calling thread). The pool must outlive its use here.
+     */
+    void setThreadPool(RealtimeThreadPool* pool) { m_pool = pool; }
+
+    /**
+     * Run the chain in place (real-time safe)
+     */
+    void processBlock(float* const* channels, size_t numChannels, size_t numSamples);
+
+    /**
+     * Clear filter, solver and bias state
+     */
+    void reset();
+
+    /**
+     * Control position 0..1 for a slot; lock-free, safe from any thread
+     * Nodes pick changes up at the start of the next block.
+     */
+    void setControl(size_t slot, float position);
+    float getControl(size_t slot) const;
+
+    size_t getNumNodes() const { return m_numNodes; }
+    bool isBuilt() const { return m_built; }
+
+    /** Scheduling levels (1 per node for a chain); nodes in a level are independent */
+    size_t getNumLevels() const { return m_numLevels; }
+
+    /** Bytes the built graph occupies in its arena (kernel lookup tables are shared, not counted) */
+    size_t getFootprintBytes() const { return m_arena.getBytesUsed(); }
+
+private:
+    struct Binding {
+        Node* node = nullptr;
+        int control = -1;
+        float applied = -1.0f;    // Last position handed to the node
+        int* inputs = nullptr;
+        size_t numInputs = 0;
+        float** output = nullptr; // One pointer per channel into the branch buffers
+        const char* traceName = "";
+    };
+
+    // Everything below that points somewhere points into the arena
+    MonotonicArena m_arena;
+    Binding* m_nodes = nullptr;
+    size_t m_numNodes = 0;
+    std::array<std::atomic<float>, MAX_CONTROLS> m_controls;
+    size_t m_numChannels = 0;
+    bool m_built = false;
+
+    // Branching graphs: node order by level and level boundaries
+    bool m_chain = true;
+    size_t* m_order = nullptr;
+    size_t* m_levelStarts = nullptr;
+    size_t m_numLevels = 0;
+    size_t m_maxBlockSize = 0;
+    RealtimeThreadPool* m_pool = nullptr;
+
+    // Slice being rendered, read by the node tasks
+    float** m_slice = nullptr;
+    size_t m_blockChannels = 0;
+    size_t m_blockSamples = 0;
+    size_t m_levelBegin = 0;
+
+    void updateControl(Binding& binding);
+    void runNode(size_t index);
+    static void runNodeTask(void* graph, size_t index);
+};
+
+}  // namespace LiveSpiceDSP
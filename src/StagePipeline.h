@@ -0,0 +1,160 @@
+#pragma once
+
+#include "TraceZones.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LiveSpice {
+
+    // ============================================================================
+    // Stage Pipeline - Items streamed through worker stages over bounded queues
+    // ============================================================================
+
+    /**
+     * Blocking FIFO with a fixed capacity. push() waits while the queue is
+     * full, which keeps a fast producer from running ahead of a slow
+     * consumer (and from holding more items in memory than the capacity).
+     * After close(), pushes are refused and pop() drains what is left.
+     */
+    template <typename T>
+    class BoundedQueue {
+    public:
+        explicit BoundedQueue(size_t capacity) : capacity(std::max<size_t>(1, capacity)) {}
+
+        /** Wait for room and append; false (item dropped) once closed */
+        bool push(T item) {
+            std::unique_lock<std::mutex> lock(mutex);
+            notFull.wait(lock, [this] { return closed || items.size() < capacity; });
+            if (closed) return false;
+            items.push_back(std::move(item));
+            notEmpty.notify_one();
+            return true;
+        }
+
+        /** Wait for an item; false when the queue is closed and empty */
+        bool pop(T& item) {
+            std::unique_lock<std::mutex> lock(mutex);
+            notEmpty.wait(lock, [this] { return closed || !items.empty(); });
+            if (items.empty()) return false;
+            item = std::move(items.front());
+            items.pop_front();
+            notFull.notify_one();
+            return true;
+        }
+
+        void close() {
+            std::lock_guard<std::mutex> lock(mutex);
+            closed = true;
+            notFull.notify_all();
+            notEmpty.notify_all();
+        }
+
+    private:
+        const size_t capacity;
+        std::mutex mutex;
+        std::condition_variable notFull;
+        std::condition_variable notEmpty;
+        std::deque<T> items;
+        bool closed = false;
+    };
+
+    /**
+     * Runs items through a chain of stages, each on its own worker threads,
+     * connected by bounded queues. While a stage works on item N the one
+     * before it can already take item N + 1, so once the pipeline is full
+     * throughput is set by the slowest stage rather than by the sum of all
+     * of them. Give a stage more workers to widen it; items then leave it
+     * out of order, so results should be keyed by the item, not by arrival.
+     *
+     * Every item reaches every stage: a stage that fails an item should mark
+     * it and let the later stages pass it through.
+     */
+    template <typename T>
+    class StagePipeline {
+    public:
+        /** Process one item; thread numbers every pipeline thread from 1 */
+        using Process = std::function<void(T& item, uint32_t thread)>;
+
+        /** @param queueCapacity Items that may wait in front of each stage */
+        explicit StagePipeline(size_t queueCapacity = 2) : queueCapacity(queueCapacity) {}
+
+        /**
+         * Append a stage. name labels its threads in traces and must be a
+         * string literal.
+         */
+        void addStage(const char* name, unsigned workers, Process process) {
+            stages.push_back({name, std::max(1u, workers), std::move(process)});
+        }
+
+        /**
+         * Feed items through every stage in order and wait until the last
+         * stage has finished them all. Each item leaves the last stage
+         * through finish(), on that stage's threads.
+         */
+        void run(std::vector<T> inputs, const std::function<void(T)>& finish) {
+            if (stages.empty()) {
+                for (auto& item : inputs) finish(std::move(item));
+                return;
+            }
+
+            // queues[k] feeds stage k; the last stage hands items to finish
+            std::vector<std::unique_ptr<BoundedQueue<T>>> queues;
+            for (size_t k = 0; k < stages.size(); ++k) {
+                queues.push_back(std::make_unique<BoundedQueue<T>>(queueCapacity));
+            }
+            std::vector<std::atomic<unsigned>> running(stages.size());
+
+            std::vector<std::thread> threads;
+            uint32_t nextThread = 1;
+            for (size_t k = 0; k < stages.size(); ++k) {
+                running[k] = stages[k].workers;
+                for (unsigned w = 0; w < stages[k].workers; ++w) {
+                    threads.emplace_back([&, k, thread = nextThread++]() {
+                        LIVESPICE_TRACE_THREAD(stages[k].name);
+                        T item;
+                        while (queues[k]->pop(item)) {
+                            stages[k].process(item, thread);
+                            if (k + 1 < stages.size()) {
+                                queues[k + 1]->push(std::move(item));
+                            } else {
+                                finish(std::move(item));
+                            }
+                        }
+                        // The stage's last worker out closes the queue behind it
+                        if (running[k].fetch_sub(1) == 1 && k + 1 < stages.size()) {
+                            queues[k + 1]->close();
+                        }
+                    });
+                }
+            }
+
+            for (auto& item : inputs) {
+                queues[0]->push(std::move(item));
+            }
+            queues[0]->close();
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+    private:
+        struct Stage {
+            const char* name;
+            unsigned workers;
+            Process process;
+        };
+
+        size_t queueCapacity;
+        std::vector<Stage> stages;
+    };
+
+} // namespace LiveSpice
@@ -1,7 +1,12 @@
 #include "StateSpaceFilter.h"
+#include "SampleRateCache.h"
+#include "Denormals.h"
 #include <cmath>
 #include <algorithm>
 #include <complex>
+#include <map>
+#include <stdexcept>
+#include <thread>
 
 namespace LiveSpiceDSP {
 
@@ -19,20 +24,36 @@ BiquadFilter::BiquadFilter() : m_state{0.0f, 0.0f} {
 }
 
 float BiquadFilter::process(float input) {
-    // Direct Form II implementation
-    // y[n] = b0*w[n] + b1*w[n-1] + b2*w[n-2]
-    // w[n] = x[n] - a1*w[n-1] - a2*w[n-2]
+    // Transposed Direct Form II implementation
+    // y[n]  = b0*x[n] + s1
+    // s1    = b1*x[n] - a1*y[n] + s2
+    // s2    = b2*x[n] - a2*y[n]
     
-    float w = input - m_coeff.a1 * m_state[0] - m_coeff.a2 * m_state[1];
-    float output = m_coeff.b0 * w + m_coeff.b1 * m_state[0] + m_coeff.b2 * m_state[1];
-    
-    // Update state
-    m_state[1] = m_state[0];
-    m_state[0] = w;
+    float output = m_coeff.b0 * input + m_state[0];
+    m_state[0] = m_coeff.b1 * input - m_coeff.a1 * output + m_state[1];
+    m_state[1] = m_coeff.b2 * input - m_coeff.a2 * output;
     
     return output;
 }
 
+void BiquadFilter::processBlock(const float* input, float* output, size_t numSamples) {
+    ScopedFlushDenormals noDenormals;
+    const float b0 = m_coeff.b0, b1 = m_coeff.b1, b2 = m_coeff.b2;
+    const float a1 = m_coeff.a1, a2 = m_coeff.a2;
+    float s1 = m_state[0], s2 = m_state[1];
+    
+    for (size_t i = 0; i < numSamples; ++i) {
+        float x = input[i];
+        float y = b0 * x + s1;
+        s1 = b1 * x - a1 * y + s2;
+        s2 = b2 * x - a2 * y;
+        output[i] = y;
+    }
+    
+    m_state[0] = flushDenormal(s1);
+    m_state[1] = flushDenormal(s2);
+}
+
 void BiquadFilter::setCoefficients(const BiquadCoefficients& coeff) {
     m_coeff = coeff;
 }
@@ -175,11 +196,11 @@ BiquadCoefficients BiquadFilter::designHighShelf(float sampleRate, float cutoffF
 // BiquadFilterBank Implementation
 // ============================================================================
 
-BiquadFilterBank::BiquadFilterBank(size_t numStages) {
+BiquadFilterBank<DYNAMIC_STAGES>::BiquadFilterBank(size_t numStages) {
     m_stages.resize(numStages);
 }
 
-float BiquadFilterBank::process(float input) {
+float BiquadFilterBank<DYNAMIC_STAGES>::process(float input) {
     float output = input;
     for (auto& stage : m_stages) {
         output = stage.process(output);
@@ -187,13 +208,25 @@ float BiquadFilterBank::process(float input) {
     return output;
 }
 
-void BiquadFilterBank::setStageCoefficients(size_t stageIndex, const BiquadCoefficients& coeff) {
+void BiquadFilterBank<DYNAMIC_STAGES>::processBlock(const float* input, float* output, size_t numSamples) {
+    ScopedFlushDenormals noDenormals;
+    if (m_stages.empty()) {
+        if (input != output) std::copy(input, input + numSamples, output);
+        return;
+    }
+    m_stages[0].processBlock(input, output, numSamples);
+    for (size_t s = 1; s < m_stages.size(); ++s) {
+        m_stages[s].processBlock(output, output, numSamples);
+    }
+}
+
+void BiquadFilterBank<DYNAMIC_STAGES>::setStageCoefficients(size_t stageIndex, const BiquadCoefficients& coeff) {
     if (stageIndex < m_stages.size()) {
         m_stages[stageIndex].setCoefficients(coeff);
     }
 }
 
-void BiquadFilterBank::reset() {
+void BiquadFilterBank<DYNAMIC_STAGES>::reset() {
     for (auto& stage : m_stages) {
         stage.reset();
     }
@@ -203,35 +236,91 @@ void BiquadFilterBank::reset() {
 // ToneStackController Implementation
 // ============================================================================
 
+/**
+ * Coefficient tables per sample rate; standard rates stay built across
+ * rate switches (see SampleRateCache.h)
+ */
+namespace {
+    SampleRateCache<ToneStackController::CoefficientTable>& toneTableCache() {
+        static SampleRateCache<ToneStackController::CoefficientTable> cache;
+        return cache;
+    }
+    
+    BiquadCoefficients lerpCoefficients(const BiquadCoefficients& from, const BiquadCoefficients& to, float scale) {
+        return BiquadCoefficients((to.b0 - from.b0) * scale, (to.b1 - from.b1) * scale,
+                                  (to.b2 - from.b2) * scale, (to.a1 - from.a1) * scale,
+                                  (to.a2 - from.a2) * scale);
+    }
+}
+
+int ToneStackController::gainIndex(float gainDb) {
+    float index = (gainDb + GAIN_RANGE_DB) / GAIN_STEP_DB;
+    return std::clamp(static_cast<int>(std::lround(index)), 0, GAIN_STEPS - 1);
+}
+
+BiquadCoefficients ToneStackController::designBand(Band band, float sampleRate, float gainDb) {
+    switch (band) {
+        case BASS:     return BiquadFilter::designLowShelf(sampleRate, 120.0f, 0.707f, gainDb);
+        case MID:      return BiquadFilter::designPeakFilter(sampleRate, 1000.0f, 0.707f, gainDb);
+        case TREBLE:   return BiquadFilter::designHighShelf(sampleRate, 4500.0f, 0.707f, gainDb);
+        case PRESENCE: return BiquadFilter::designPeakFilter(sampleRate, 4500.0f, 1.414f, gainDb);
+        default:       return BiquadCoefficients();
+    }
+}
+
+std::shared_ptr<const ToneStackController::CoefficientTable>
+ToneStackController::acquireCoefficientTable(float sampleRate) {
+    return toneTableCache().acquire(sampleRate, [](double rate) {
+        CoefficientTable table;
+        for (int band = 0; band < NUM_BANDS; ++band) {
+            for (int i = 0; i < GAIN_STEPS; ++i) {
+                float gainDb = -GAIN_RANGE_DB + i * GAIN_STEP_DB;
+                table.bands[band][i] = designBand(static_cast<Band>(band), static_cast<float>(rate), gainDb);
+            }
+        }
+        return table;
+    });
+}
+
+size_t ToneStackController::cachedCoefficientTableCount() {
+    return toneTableCache().size();
+}
+
 ToneStackController::ToneStackController(float sampleRate)
     : m_sampleRate(sampleRate),
-      m_bassFilter(1),
-      m_midFilter(1),
-      m_trebleFilter(1),
-      m_presenceFilter(1) {
+      m_table(acquireCoefficientTable(sampleRate)) {
+    
+    // SVF bands: the shapes designBand() builds, at a flat gain
+    m_svfBands[BASS].setParameters(SVFFilter::Type::LowShelf, 120.0f, 0.707f);
+    m_svfBands[MID].setParameters(SVFFilter::Type::Bell, 1000.0f, 0.707f);
+    m_svfBands[TREBLE].setParameters(SVFFilter::Type::HighShelf, 4500.0f, 0.707f);
+    m_svfBands[PRESENCE].setParameters(SVFFilter::Type::Bell, 4500.0f, 1.414f);
+    for (auto& band : m_svfBands) band.setSampleRate(sampleRate);
     
     // Initialize with default tone stack settings
     // Standard 3-band EQ: Bass @ 120Hz, Mid @ 1kHz, Treble @ 4.5kHz
-    
-    auto bassCoeff = BiquadFilter::designLowShelf(sampleRate, 120.0f, 0.707f, 0.0f);
-    m_bassFilter.setStageCoefficients(0, bassCoeff);
-    
-    auto midCoeff = BiquadFilter::designPeakFilter(sampleRate, 1000.0f, 0.707f, 0.0f);
-    m_midFilter.setStageCoefficients(0, midCoeff);
-    
-    auto trebleCoeff = BiquadFilter::designHighShelf(sampleRate, 4500.0f, 0.707f, 0.0f);
-    m_trebleFilter.setStageCoefficients(0, trebleCoeff);
-    
-    auto presenceCoeff = BiquadFilter::designPeakFilter(sampleRate, 4500.0f, 1.414f, 0.0f);
-    m_presenceFilter.setStageCoefficients(0, presenceCoeff);
+    for (int band = 0; band < NUM_BANDS; ++band) {
+        setBandGain(static_cast<Band>(band), 0.0f);
+    }
 }
 
 float ToneStackController::process(float input) {
+    m_running = true;
+    if (m_chunkPosition == 0) {
+        advanceSmoothing();
+    }
+    m_chunkPosition = (m_chunkPosition + 1) % SMOOTHING_CHUNK;
+    
     // Process through all three bands in parallel-like fashion
     // (actually cascade but with independent gains recombined)
     float output = input;
     
     // Apply each filter band (they're cascaded but each represents independent control)
+    if (m_implementation == BandImplementation::SVF) {
+        output = m_svfBands[BASS].process(output);
+        output = m_svfBands[MID].process(output);
+        return m_svfBands[TREBLE].process(output);
+    }
     output = m_bassFilter.process(output);
     output = m_midFilter.process(output);
     output = m_trebleFilter.process(output);
@@ -239,38 +328,336 @@ float ToneStackController::process(float input) {
     return output;
 }
 
+void ToneStackController::processBlock(const float* input, float* output, size_t numSamples) {
+    ScopedFlushDenormals noDenormals;
+    m_running = true;
+    const bool svf = m_implementation == BandImplementation::SVF;
+    auto runBands = [this, svf](const float* in, float* out, size_t count) {
+        if (svf) {
+            m_svfBands[BASS].processBlock(in, out, count);
+            m_svfBands[MID].processBlock(out, out, count);
+            m_svfBands[TREBLE].processBlock(out, out, count);
+        } else {
+            m_bassFilter.processBlock(in, out, count);
+            m_midFilter.processBlock(out, out, count);
+            m_trebleFilter.processBlock(out, out, count);
+        }
+    };
+    
+    // Steady state: one pass per band over the whole buffer
+    if (!isSmoothing()) {
+        runBands(input, output, numSamples);
+        m_chunkPosition = (m_chunkPosition + numSamples) % SMOOTHING_CHUNK;
+        return;
+    }
+    
+    // Ramping: split on chunk boundaries so coefficients step exactly as in process()
+    size_t done = 0;
+    while (done < numSamples) {
+        if (m_chunkPosition == 0) {
+            advanceSmoothing();
+        }
+        size_t count = std::min(SMOOTHING_CHUNK - m_chunkPosition, numSamples - done);
+        runBands(input + done, output + done, count);
+        m_chunkPosition = (m_chunkPosition + count) % SMOOTHING_CHUNK;
+        done += count;
+    }
+}
+
 void ToneStackController::setBassGain(float bassGainDb) {
-    // Clamp to ±12dB
-    bassGainDb = std::max(-12.0f, std::min(12.0f, bassGainDb));
-    auto coeff = BiquadFilter::designLowShelf(m_sampleRate, 120.0f, 0.707f, bassGainDb);
-    m_bassFilter.setStageCoefficients(0, coeff);
+    setBandGain(BASS, bassGainDb);
 }
 
 void ToneStackController::setMidGain(float midGainDb) {
-    midGainDb = std::max(-12.0f, std::min(12.0f, midGainDb));
-    auto coeff = BiquadFilter::designPeakFilter(m_sampleRate, 1000.0f, 0.707f, midGainDb);
-    m_midFilter.setStageCoefficients(0, coeff);
+    setBandGain(MID, midGainDb);
 }
 
 void ToneStackController::setTrebleGain(float trebleGainDb) {
-    trebleGainDb = std::max(-12.0f, std::min(12.0f, trebleGainDb));
-    auto coeff = BiquadFilter::designHighShelf(m_sampleRate, 4500.0f, 0.707f, trebleGainDb);
-    m_trebleFilter.setStageCoefficients(0, coeff);
+    setBandGain(TREBLE, trebleGainDb);
 }
 
 void ToneStackController::setPresenceGain(float presenceGainDb) {
-    presenceGainDb = std::max(-12.0f, std::min(12.0f, presenceGainDb));
-    auto coeff = BiquadFilter::designPeakFilter(m_sampleRate, 4500.0f, 1.414f, presenceGainDb);
-    m_presenceFilter.setStageCoefficients(0, coeff);
+    setBandGain(PRESENCE, presenceGainDb);
+}
+
+void ToneStackController::setBandGain(Band band, float gainDb) {
+    // Clamp to ±12dB via the table range
+    BandRamp& ramp = m_ramps[band];
+    const int index = gainIndex(gainDb);
+    ramp.target = m_table->bands[band][index];
+    ramp.targetDb = -GAIN_RANGE_DB + index * GAIN_STEP_DB;
+    
+    if (!m_running) {
+        ramp.current = ramp.target;
+        ramp.currentDb = ramp.targetDb;
+        ramp.remaining = 0;
+        bandFilter(band).setStageCoefficients(0, ramp.current);
+        m_svfBands[band].setGain(ramp.currentDb);
+        return;
+    }
+    
+    ramp.step = lerpCoefficients(ramp.current, ramp.target, 1.0f / SMOOTHING_STEPS);
+    ramp.stepDb = (ramp.targetDb - ramp.currentDb) / SMOOTHING_STEPS;
+    ramp.remaining = SMOOTHING_STEPS;
+}
+
+void ToneStackController::advanceSmoothing() {
+    for (int band = 0; band < NUM_BANDS; ++band) {
+        BandRamp& ramp = m_ramps[band];
+        if (ramp.remaining == 0) continue;
+        
+        if (--ramp.remaining == 0) {
+            ramp.current = ramp.target;
+            ramp.currentDb = ramp.targetDb;
+        } else {
+            ramp.current.b0 += ramp.step.b0;
+            ramp.current.b1 += ramp.step.b1;
+            ramp.current.b2 += ramp.step.b2;
+            ramp.current.a1 += ramp.step.a1;
+            ramp.current.a2 += ramp.step.a2;
+            ramp.currentDb += ramp.stepDb;
+        }
+        if (m_implementation == BandImplementation::SVF) {
+            m_svfBands[band].setGain(ramp.currentDb);
+        } else {
+            bandFilter(static_cast<Band>(band)).setStageCoefficients(0, ramp.current);
+        }
+    }
+}
+
+bool ToneStackController::isSmoothing() const {
+    for (const auto& ramp : m_ramps) {
+        if (ramp.remaining > 0) return true;
+    }
+    return false;
+}
+
+BiquadFilterBank<1>& ToneStackController::bandFilter(Band band) {
+    switch (band) {
+        case BASS:   return m_bassFilter;
+        case MID:    return m_midFilter;
+        case TREBLE: return m_trebleFilter;
+        default:     return m_presenceFilter;
+    }
+}
+
+std::array<BiquadCoefficients, 3> ToneStackController::getCascadeCoefficients() const {
+    if (m_implementation == BandImplementation::SVF) {
+        return {m_svfBands[BASS].toBiquad(), m_svfBands[MID].toBiquad(), m_svfBands[TREBLE].toBiquad()};
+    }
+    return {m_bassFilter.getStageCoefficients(0),
+            m_midFilter.getStageCoefficients(0),
+            m_trebleFilter.getStageCoefficients(0)};
 }
 
 void ToneStackController::reset() {
+    for (int band = 0; band < NUM_BANDS; ++band) {
+        BandRamp& ramp = m_ramps[band];
+        ramp.current = ramp.target;
+        ramp.currentDb = ramp.targetDb;
+        ramp.remaining = 0;
+        bandFilter(static_cast<Band>(band)).setStageCoefficients(0, ramp.current);
+        m_svfBands[band].setGain(ramp.currentDb);
+        m_svfBands[band].reset();
+    }
+    m_chunkPosition = 0;
+    m_running = false;
+    
     m_bassFilter.reset();
     m_midFilter.reset();
     m_trebleFilter.reset();
     m_presenceFilter.reset();
 }
 
+void ToneStackController::setBandImplementation(BandImplementation implementation) {
+    if (implementation == m_implementation) return;
+    m_implementation = implementation;
+    
+    // Bring the newly active filters up to the ramp position, from silence
+    for (int band = 0; band < NUM_BANDS; ++band) {
+        const BandRamp& ramp = m_ramps[band];
+        bandFilter(static_cast<Band>(band)).setStageCoefficients(0, ramp.current);
+        bandFilter(static_cast<Band>(band)).reset();
+        m_svfBands[band].setGain(ramp.currentDb);
+        m_svfBands[band].reset();
+    }
+}
+
+// ============================================================================
+// State-Space Discretization & Network Analysis
+// ============================================================================
+
+namespace {
+    /**
+     * Solve M X = R in place (M: n x n, R: n x cols, row-major) by Gaussian
+     * elimination with partial pivoting. Returns false if M is singular.
+     */
+    bool solveDense(std::vector<double>& M, std::vector<double>& R, size_t n, size_t cols) {
+        for (size_t k = 0; k < n; ++k) {
+            size_t pivot = k;
+            double best = std::abs(M[k * n + k]);
+            for (size_t r = k + 1; r < n; ++r) {
+                if (std::abs(M[r * n + k]) > best) {
+                    best = std::abs(M[r * n + k]);
+                    pivot = r;
+                }
+            }
+            if (best < 1e-300) return false;
+            if (pivot != k) {
+                for (size_t c = 0; c < n; ++c) std::swap(M[k * n + c], M[pivot * n + c]);
+                for (size_t c = 0; c < cols; ++c) std::swap(R[k * cols + c], R[pivot * cols + c]);
+            }
+            for (size_t r = k + 1; r < n; ++r) {
+                double factor = M[r * n + k] / M[k * n + k];
+                if (factor == 0.0) continue;
+                for (size_t c = k; c < n; ++c) M[r * n + c] -= factor * M[k * n + c];
+                for (size_t c = 0; c < cols; ++c) R[r * cols + c] -= factor * R[k * cols + c];
+            }
+        }
+        for (size_t k = n; k-- > 0;) {
+            for (size_t c = 0; c < cols; ++c) {
+                double sum = R[k * cols + c];
+                for (size_t j = k + 1; j < n; ++j) sum -= M[k * n + j] * R[j * cols + c];
+                R[k * cols + c] = sum / M[k * n + k];
+            }
+        }
+        return true;
+    }
+}
+
+StateSpaceMatrices discretizeBilinear(const StateSpaceMatrices& continuous, double sampleRate) {
+    const size_t n = continuous.order;
+    const double T = 1.0 / sampleRate;
+    
+    // P = I - A T/2;  solve P [X | y] = [I + A T/2 | B T]
+    std::vector<double> P(n * n), R(n * (n + 1));
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) {
+            double halfAT = continuous.A[i * n + j] * T * 0.5;
+            P[i * n + j] = (i == j ? 1.0 : 0.0) - halfAT;
+            R[i * (n + 1) + j] = (i == j ? 1.0 : 0.0) + halfAT;
+        }
+        R[i * (n + 1) + n] = continuous.B[i] * T;
+    }
+    
+    // C P^-1 solves P^T w = C^T
+    std::vector<double> Pt(n * n), w(continuous.C);
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) Pt[i * n + j] = P[j * n + i];
+    }
+    
+    if (!solveDense(P, R, n, n + 1) || !solveDense(Pt, w, n, 1)) {
+        throw std::invalid_argument("discretizeBilinear: I - A T/2 is singular");
+    }
+    
+    StateSpaceMatrices discrete;
+    discrete.order = n;
+    discrete.A.resize(n * n);
+    discrete.B.resize(n);
+    discrete.C = w;
+    discrete.D = continuous.D;
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < n; ++j) discrete.A[i * n + j] = R[i * (n + 1) + j];
+        discrete.B[i] = R[i * (n + 1) + n];
+        discrete.D += w[i] * continuous.B[i] * T * 0.5;
+    }
+    return discrete;
+}
+
+void LinearNetwork::addResistor(int nodeA, int nodeB, double ohms) {
+    m_resistors.push_back({nodeA, nodeB, ohms});
+}
+
+void LinearNetwork::addCapacitor(int nodeA, int nodeB, double farads) {
+    m_capacitors.push_back({nodeA, nodeB, farads});
+}
+
+StateSpaceMatrices LinearNetwork::buildStateSpace() const {
+    // Map circuit node numbers to MNA rows (ground excluded)
+    std::map<int, size_t> index;
+    auto addNode = [&](int node) {
+        if (node != GROUND && index.find(node) == index.end()) {
+            size_t row = index.size();
+            index[node] = row;
+        }
+    };
+    for (const auto& r : m_resistors) { addNode(r.nodeA); addNode(r.nodeB); }
+    for (const auto& c : m_capacitors) { addNode(c.nodeA); addNode(c.nodeB); }
+    addNode(m_inputNode);
+    addNode(m_outputNode);
+    
+    for (const auto& r : m_resistors) {
+        if (!(r.value > 0.0)) throw std::invalid_argument("LinearNetwork: resistance must be positive");
+    }
+    for (const auto& c : m_capacitors) {
+        if (!(c.value > 0.0)) throw std::invalid_argument("LinearNetwork: capacitance must be positive");
+    }
+    if (m_inputNode == GROUND) throw std::invalid_argument("LinearNetwork: input node is ground");
+    
+    // Unknowns: node voltages, input source current, one current per capacitor
+    const size_t numNodes = index.size();
+    const size_t numCaps = m_capacitors.size();
+    const size_t size = numNodes + 1 + numCaps;
+    const size_t cols = numCaps + 1;      // RHS columns: each state, then u
+    std::vector<double> M(size * size, 0.0), R(size * cols, 0.0);
+    
+    auto row = [&](int node) { return node == GROUND ? size : index[node]; };
+    
+    for (const auto& r : m_resistors) {
+        size_t a = row(r.nodeA), b = row(r.nodeB);
+        double g = 1.0 / r.value;
+        if (a < size) M[a * size + a] += g;
+        if (b < size) M[b * size + b] += g;
+        if (a < size && b < size) {
+            M[a * size + b] -= g;
+            M[b * size + a] -= g;
+        }
+    }
+    
+    // Voltage sources: v(a) - v(b) = value, source current j leaves node a
+    auto stampSource = [&](size_t sourceRow, int nodeA, int nodeB, size_t rhsColumn) {
+        size_t a = row(nodeA), b = row(nodeB);
+        if (a < size) {
+            M[a * size + sourceRow] += 1.0;
+            M[sourceRow * size + a] += 1.0;
+        }
+        if (b < size) {
+            M[b * size + sourceRow] -= 1.0;
+            M[sourceRow * size + b] -= 1.0;
+        }
+        R[sourceRow * cols + rhsColumn] = 1.0;
+    };
+    stampSource(numNodes, m_inputNode, GROUND, numCaps);
+    for (size_t k = 0; k < numCaps; ++k) {
+        stampSource(numNodes + 1 + k, m_capacitors[k].nodeA, m_capacitors[k].nodeB, k);
+    }
+    
+    if (!solveDense(M, R, size, cols)) {
+        throw std::invalid_argument("LinearNetwork: singular network (floating node or capacitor loop)");
+    }
+    
+    // Capacitor k: C dv/dt = current into its terminal a = source current
+    StateSpaceMatrices model;
+    model.order = numCaps;
+    model.A.resize(numCaps * numCaps);
+    model.B.resize(numCaps);
+    model.C.resize(numCaps);
+    for (size_t k = 0; k < numCaps; ++k) {
+        const size_t current = numNodes + 1 + k;
+        const double invC = 1.0 / m_capacitors[k].value;
+        for (size_t m = 0; m < numCaps; ++m) {
+            model.A[k * numCaps + m] = R[current * cols + m] * invC;
+        }
+        model.B[k] = R[current * cols + numCaps] * invC;
+    }
+    const size_t out = row(m_outputNode);
+    for (size_t m = 0; m < numCaps; ++m) {
+        model.C[m] = out < size ? R[out * cols + m] : 0.0;
+    }
+    model.D = out < size ? R[out * cols + numCaps] : 0.0;
+    return model;
+}
+
 // ============================================================================
 // FrequencyResponseAnalyzer Implementation
 // ============================================================================
@@ -355,6 +742,108 @@ std::vector<float> FrequencyResponseAnalyzer::generateLogSweep(
     return frequencies;
 }
 
+namespace {
+    constexpr size_t RESPONSE_BLOCK = 64;
+    
+    /**
+     * Evaluate frequencies [begin, end) block by block. Per block: trig once,
+     * then one branch-free pass per stage over the block.
+     */
+    void evaluateCascadeRange(const BiquadCoefficients* stages, size_t numStages,
+                              const float* frequencies, size_t begin, size_t end,
+                              float sampleRate, float* magnitude, float* phase) {
+        const float omegaScale = 2.0f * 3.14159265359f / sampleRate;
+        float c1[RESPONSE_BLOCK], s1[RESPONSE_BLOCK], c2[RESPONSE_BLOCK], s2[RESPONSE_BLOCK];
+        float mag2[RESPONSE_BLOCK], ph[RESPONSE_BLOCK];
+        
+        for (size_t start = begin; start < end; start += RESPONSE_BLOCK) {
+            const size_t count = std::min(RESPONSE_BLOCK, end - start);
+            
+            for (size_t j = 0; j < count; ++j) {
+                float omega = omegaScale * frequencies[start + j];
+                c1[j] = std::cos(omega);
+                s1[j] = std::sin(omega);
+                c2[j] = 2.0f * c1[j] * c1[j] - 1.0f;
+                s2[j] = 2.0f * s1[j] * c1[j];
+                mag2[j] = 1.0f;
+                ph[j] = 0.0f;
+            }
+            
+            for (size_t st = 0; st < numStages; ++st) {
+                const BiquadCoefficients& k = stages[st];
+                for (size_t j = 0; j < count; ++j) {
+                    // H(e^jw) = (b0 + b1 e^-jw + b2 e^-2jw) / (1 + a1 e^-jw + a2 e^-2jw)
+                    float numRe = k.b0 + k.b1 * c1[j] + k.b2 * c2[j];
+                    float numIm = -k.b1 * s1[j] - k.b2 * s2[j];
+                    float denRe = 1.0f + k.a1 * c1[j] + k.a2 * c2[j];
+                    float denIm = -k.a1 * s1[j] - k.a2 * s2[j];
+                    float num2 = numRe * numRe + numIm * numIm;
+                    float den2 = denRe * denRe + denIm * denIm;
+                    mag2[j] *= den2 > 1e-20f ? num2 / den2 : 0.0f;
+                }
+                if (phase) {
+                    for (size_t j = 0; j < count; ++j) {
+                        float numRe = k.b0 + k.b1 * c1[j] + k.b2 * c2[j];
+                        float numIm = -k.b1 * s1[j] - k.b2 * s2[j];
+                        float denRe = 1.0f + k.a1 * c1[j] + k.a2 * c2[j];
+                        float denIm = -k.a1 * s1[j] - k.a2 * s2[j];
+                        ph[j] += std::atan2(numIm, numRe) - std::atan2(denIm, denRe);
+                    }
+                }
+            }
+            
+            if (magnitude) {
+                for (size_t j = 0; j < count; ++j) magnitude[start + j] = std::sqrt(mag2[j]);
+            }
+            if (phase) {
+                for (size_t j = 0; j < count; ++j) phase[start + j] = ph[j];
+            }
+        }
+    }
+}
+
+void FrequencyResponseAnalyzer::evaluateCascade(const BiquadCoefficients* stages, size_t numStages,
+                                                const float* frequencies, size_t numFrequencies,
+                                                float sampleRate, float* magnitude, float* phase,
+                                                unsigned maxThreads) {
+    if (maxThreads == 0) {
+        maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t workers = std::min<size_t>(maxThreads, std::max<size_t>(1, numFrequencies / PARALLEL_MIN_POINTS));
+    
+    if (workers <= 1) {
+        evaluateCascadeRange(stages, numStages, frequencies, 0, numFrequencies,
+                             sampleRate, magnitude, phase);
+        return;
+    }
+    
+    // Contiguous slices; the calling thread takes the first one
+    const size_t slice = (numFrequencies + workers - 1) / workers;
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (size_t w = 1; w < workers; ++w) {
+        size_t begin = w * slice;
+        size_t end = std::min(numFrequencies, begin + slice);
+        if (begin >= end) break;
+        threads.emplace_back(evaluateCascadeRange, stages, numStages, frequencies, begin, end,
+                             sampleRate, magnitude, phase);
+    }
+    evaluateCascadeRange(stages, numStages, frequencies, 0, std::min(slice, numFrequencies),
+                         sampleRate, magnitude, phase);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void FrequencyResponseAnalyzer::evaluateToneStack(const ToneStackController& toneStack,
+                                                  const float* frequencies, size_t numFrequencies,
+                                                  float* magnitude, float* phase,
+                                                  unsigned maxThreads) {
+    auto stages = toneStack.getCascadeCoefficients();
+    evaluateCascade(stages.data(), stages.size(), frequencies, numFrequencies,
+                    toneStack.getSampleRate(), magnitude, phase, maxThreads);
+}
+
 // ============================================================================
 // DistortionPedalDSP Implementation
 // ============================================================================
@@ -1,8 +1,14 @@
 #pragma once
 
+#include "Denormals.h"
+#include "MemoryFootprint.h"
 #include <cmath>
+#include <algorithm>
 #include <array>
 #include <vector>
+#include <cstddef>
+#include <memory>
+#include <utility>
 
 namespace LiveSpiceDSP {
 
@@ -16,7 +22,14 @@ namespace LiveSpiceDSP {
  * - Transformer coupling saturation
  * - Output low-pass filtering
  * 
- * Uses direct form II topology with cascade capability
+ * Uses transposed direct form II topology with cascade capability;
+ * block processing runs one stage over the whole buffer at a time, and
+ * BiquadLaneBank runs independent channels/bands in SIMD lanes. SVFFilter
+ * is the topology-preserving alternative for swept and modulated bands.
+ *
+ * LinearNetwork / StateSpaceProcessor<N> cover arbitrary linear RC
+ * networks: A/B/C/D from nodal analysis, bilinear discretization, and one
+ * fused fixed-order update per sample.
  */
 
 // ============================================================================
@@ -34,7 +47,7 @@ struct BiquadCoefficients {
 };
 
 // ============================================================================
-// Biquadratic IIR Filter (Direct Form II)
+// Biquadratic IIR Filter (Transposed Direct Form II)
 // ============================================================================
 
 class BiquadFilter {
@@ -48,12 +61,23 @@ public:
      */
     float process(float input);
     
+    /**
+     * Process a buffer; state and coefficients stay in registers for the
+     * whole block. Identical to calling process() per sample.
+     * @param input Input samples
+     * @param output Output samples (may alias input)
+     * @param numSamples Number of samples
+     */
+    void processBlock(const float* input, float* output, size_t numSamples);
+    
     /**
      * Set filter coefficients
      * @param coeff New biquad coefficients
      */
     void setCoefficients(const BiquadCoefficients& coeff);
     
+    const BiquadCoefficients& getCoefficients() const { return m_coeff; }
+    
     /**
      * Reset internal state
      */
@@ -118,7 +142,7 @@ public:
                                               float qFactor, float gainDb);
 
 private:
-    std::array<float, 2> m_state;      // State variables: [w[n-1], w[n-2]]
+    std::array<float, 2> m_state;      // Transposed DF-II state: [s1, s2]
     BiquadCoefficients m_coeff;         // Current coefficients
 };
 
@@ -126,7 +150,77 @@ private:
 // Cascaded Biquad Filter Bank
 // ============================================================================
 
+/** Stage count meaning "chosen at runtime" (heap-allocated stages) */
+constexpr size_t DYNAMIC_STAGES = 0;
+
+/**
+ * Fixed-order cascade: N stages stored inline in a std::array and
+ * processed with a fold over the stage indices, so the cascade is fully
+ * unrolled with no pointer chase. BiquadFilterBank<> (or CTAD from a
+ * stage count, e.g. BiquadFilterBank bank(3)) is the runtime-sized bank.
+ */
+template <size_t N = DYNAMIC_STAGES>
 class BiquadFilterBank {
+public:
+    static_assert(N <= 16, "Use the runtime-sized BiquadFilterBank<> for long cascades");
+
+    /**
+     * Process sample through all cascaded stages
+     * @param input Input sample
+     * @return Filtered output
+     */
+    float process(float input) {
+        return processStages(input, std::make_index_sequence<N>{});
+    }
+    
+    /**
+     * Process a buffer stage by stage: stage 0 writes output, later stages
+     * run in place over it. Identical to calling process() per sample.
+     */
+    void processBlock(const float* input, float* output, size_t numSamples) {
+        ScopedFlushDenormals noDenormals;
+        m_stages[0].processBlock(input, output, numSamples);
+        for (size_t s = 1; s < N; ++s) {
+            m_stages[s].processBlock(output, output, numSamples);
+        }
+    }
+    
+    /**
+     * Set coefficients for specific stage
+     * @param stageIndex Stage index (0-based)
+     * @param coeff Biquad coefficients
+     */
+    void setStageCoefficients(size_t stageIndex, const BiquadCoefficients& coeff) {
+        if (stageIndex < N) {
+            m_stages[stageIndex].setCoefficients(coeff);
+        }
+    }
+    
+    void reset() {
+        for (auto& stage : m_stages) stage.reset();
+    }
+    
+    const BiquadCoefficients& getStageCoefficients(size_t stageIndex) const {
+        return m_stages[stageIndex].getCoefficients();
+    }
+    
+    static constexpr size_t getNumStages() { return N; }
+
+private:
+    template <size_t... I>
+    float processStages(float x, std::index_sequence<I...>) {
+        ((x = m_stages[I].process(x)), ...);
+        return x;
+    }
+
+    std::array<BiquadFilter, N> m_stages;
+};
+
+/**
+ * Runtime-sized cascade (stage count chosen at construction)
+ */
+template <>
+class BiquadFilterBank<DYNAMIC_STAGES> {
 public:
     /**
      * Create filter bank with specified cascade stages
@@ -141,6 +235,15 @@ public:
      */
     float process(float input);
     
+    /**
+     * Process a buffer stage by stage: stage 0 writes output, later stages
+     * run in place over it. Identical to calling process() per sample.
+     * @param input Input samples
+     * @param output Output samples (may alias input)
+     * @param numSamples Number of samples
+     */
+    void processBlock(const float* input, float* output, size_t numSamples);
+    
     /**
      * Set coefficients for specific stage
      * @param stageIndex Stage index (0-based)
@@ -157,17 +260,344 @@ public:
      * Get number of stages
      */
     size_t getNumStages() const { return m_stages.size(); }
+    
+    const BiquadCoefficients& getStageCoefficients(size_t stageIndex) const {
+        return m_stages[stageIndex].getCoefficients();
+    }
 
 private:
     std::vector<BiquadFilter> m_stages;
 };
 
+BiquadFilterBank(size_t) -> BiquadFilterBank<DYNAMIC_STAGES>;
+
+// ============================================================================
+// SIMD Lane Biquad Bank (Structure of Arrays)
+// ============================================================================
+
+/**
+ * Lanes independent biquads stored SoA, one lane per channel or per
+ * parallel band. Each per-sample step is the same transposed DF-II update
+ * across all lanes with a fixed trip count, which the compiler maps onto
+ * SSE/AVX/NEON registers (Lanes = 4 or 8 fills one register).
+ * Frames are interleaved: frame i, lane l lives at [i * Lanes + l].
+ */
+template <size_t Lanes>
+class BiquadLaneBank {
+public:
+    static constexpr size_t LANES = Lanes;
+
+    BiquadLaneBank() {
+        m_b0.fill(1.0f);
+        m_b1.fill(0.0f);
+        m_b2.fill(0.0f);
+        m_a1.fill(0.0f);
+        m_a2.fill(0.0f);
+        reset();
+    }
+
+    /**
+     * Set coefficients for one lane
+     * @param lane Lane index (0-based)
+     * @param coeff Biquad coefficients
+     */
+    void setLaneCoefficients(size_t lane, const BiquadCoefficients& coeff) {
+        if (lane >= Lanes) return;
+        m_b0[lane] = coeff.b0;
+        m_b1[lane] = coeff.b1;
+        m_b2[lane] = coeff.b2;
+        m_a1[lane] = coeff.a1;
+        m_a2[lane] = coeff.a2;
+    }
+
+    void reset() {
+        m_s1.fill(0.0f);
+        m_s2.fill(0.0f);
+    }
+
+    /**
+     * Process one frame (one sample per lane)
+     * @param input Lanes input samples
+     * @param output Lanes output samples (may alias input)
+     */
+    void processFrame(const float* input, float* output) {
+        for (size_t l = 0; l < Lanes; ++l) {
+            float x = input[l];
+            float y = m_b0[l] * x + m_s1[l];
+            m_s1[l] = m_b1[l] * x - m_a1[l] * y + m_s2[l];
+            m_s2[l] = m_b2[l] * x - m_a2[l] * y;
+            output[l] = y;
+        }
+    }
+
+    /**
+     * Process interleaved multi-channel frames
+     * @param input numFrames * Lanes interleaved samples
+     * @param output numFrames * Lanes interleaved samples (may alias input)
+     * @param numFrames Number of frames
+     */
+    void processBlock(const float* input, float* output, size_t numFrames) {
+        ScopedFlushDenormals noDenormals;
+        for (size_t i = 0; i < numFrames; ++i) {
+            processFrame(input + i * Lanes, output + i * Lanes);
+        }
+        flushDenormals(m_s1);
+        flushDenormals(m_s2);
+    }
+
+    /**
+     * Feed one mono input to every lane (parallel band split)
+     * @param input numFrames mono samples
+     * @param output numFrames * Lanes interleaved band outputs
+     * @param numFrames Number of frames
+     */
+    void processParallel(const float* input, float* output, size_t numFrames) {
+        ScopedFlushDenormals noDenormals;
+        std::array<float, Lanes> frame;
+        for (size_t i = 0; i < numFrames; ++i) {
+            frame.fill(input[i]);
+            processFrame(frame.data(), output + i * Lanes);
+        }
+        flushDenormals(m_s1);
+        flushDenormals(m_s2);
+    }
+
+private:
+    std::array<float, Lanes> m_b0, m_b1, m_b2, m_a1, m_a2;
+    std::array<float, Lanes> m_s1, m_s2;
+};
+
+// ============================================================================
+// Topology-Preserving State-Variable Filter
+// ============================================================================
+
+/**
+ * Zero-delay-feedback SVF (trapezoidal integrators, Zavalishin's TPT form
+ * in Simper's state layout). The integrator states carry no coefficients,
+ * so cutoff, Q and gain can change every sample without the transients a
+ * direct-form biquad shows when its coefficients move.
+ *
+ * Retuning costs a Pade tan() and a division; only setGain() calls pow(),
+ * so an envelope or LFO can drive setCutoff() per sample. The response is
+ * the bilinear transform of the same analog prototypes the RBJ designs in
+ * BiquadFilter use; toBiquad() gives the equivalent coefficients.
+ */
+class SVFFilter {
+public:
+    enum class Type { LowPass, HighPass, BandPass, Bell, LowShelf, HighShelf };
+
+    static constexpr float MAX_CUTOFF_RATIO = 0.47f;   // Of the sample rate
+
+    /**
+     * tan(x) for 0 <= x < pi/2: [5/4] Pade approximant, within 1e-4
+     * relative up to MAX_CUTOFF_RATIO
+     */
+    static float tanApprox(float x) {
+        const float x2 = x * x;
+        return x * (945.0f + x2 * (-105.0f + x2)) / (945.0f + x2 * (-420.0f + 15.0f * x2));
+    }
+
+    explicit SVFFilter(float sampleRate = 44100.0f) { setSampleRate(sampleRate); }
+
+    void setSampleRate(float sampleRate) {
+        m_sampleRate = sampleRate;
+        m_piOverSampleRate = 3.14159265359f / sampleRate;
+        updateCoefficients();
+    }
+
+    /**
+     * Set everything at once (one pow() for the gain)
+     * @param type Response
+     * @param cutoffHz Cutoff, centre or shelf midpoint (Hz)
+     * @param q Q factor (shelves: slope as in designLowShelf)
+     * @param gainDb Bell and shelf gain (dB, ignored by the others)
+     */
+    void setParameters(Type type, float cutoffHz, float q, float gainDb = 0.0f) {
+        m_type = type;
+        m_cutoff = cutoffHz;
+        m_q = q;
+        setGain(gainDb);
+    }
+
+    /**
+     * Retune; cheap enough to call every sample
+     */
+    void setCutoff(float cutoffHz) {
+        m_cutoff = cutoffHz;
+        updateCoefficients();
+    }
+
+    /**
+     * Change the resonance; cheap enough to call every sample
+     */
+    void setQ(float q) {
+        m_q = q;
+        updateCoefficients();
+    }
+
+    void setGain(float gainDb) {
+        m_gainDb = gainDb;
+        m_amplitude = std::pow(10.0f, gainDb / 40.0f);
+        m_sqrtAmplitude = std::sqrt(m_amplitude);
+        updateCoefficients();
+    }
+
+    Type getType() const { return m_type; }
+    float getCutoff() const { return m_cutoff; }
+    float getQ() const { return m_q; }
+    float getGain() const { return m_gainDb; }
+
+    float process(float input) {
+        const float v3 = input - m_ic2;
+        const float v1 = m_a1 * m_ic1 + m_a2 * v3;
+        const float v2 = m_ic2 + m_a2 * m_ic1 + m_a3 * v3;
+        m_ic1 = 2.0f * v1 - m_ic1;
+        m_ic2 = 2.0f * v2 - m_ic2;
+        return m_m0 * input + m_m1 * v1 + m_m2 * v2;
+    }
+
+    /**
+     * Process a buffer at fixed settings
+     * @param input Input samples
+     * @param output Output samples (may alias input)
+     * @param numSamples Number of samples
+     */
+    void processBlock(const float* input, float* output, size_t numSamples) {
+        ScopedFlushDenormals noDenormals;
+        for (size_t i = 0; i < numSamples; ++i) output[i] = process(input[i]);
+        flushState();
+    }
+
+    /**
+     * Process a buffer with the cutoff following cutoffHz sample by sample
+     * (auto-wah, envelope filters); the last value stays set afterwards
+     */
+    void processBlock(const float* input, float* output, size_t numSamples, const float* cutoffHz) {
+        ScopedFlushDenormals noDenormals;
+        for (size_t i = 0; i < numSamples; ++i) {
+            setCutoff(cutoffHz[i]);
+            output[i] = process(input[i]);
+        }
+        flushState();
+    }
+
+    void reset() { m_ic1 = m_ic2 = 0.0f; }
+
+    /**
+     * Snap decayed integrator states to zero (block ends, silence)
+     */
+    void flushState() {
+        m_ic1 = flushDenormal(m_ic1);
+        m_ic2 = flushDenormal(m_ic2);
+    }
+
+    /**
+     * Direct-form coefficients with the same transfer function
+     */
+    BiquadCoefficients toBiquad() const {
+        // y = (m0 (s^2 + k s + 1) + m1 s + m2) / (s^2 + k s + 1), s = (1/g)(1 - z^-1)/(1 + z^-1)
+        const float n2 = m_m0, n1 = m_m0 * m_k + m_m1, n0 = m_m0 + m_m2;
+        const float g = m_g, g2 = m_g * m_g;
+        const float a0 = 1.0f + m_k * g + g2;
+        return BiquadCoefficients((n2 + n1 * g + n0 * g2) / a0, 2.0f * (n0 * g2 - n2) / a0,
+                                  (n2 - n1 * g + n0 * g2) / a0, 2.0f * (g2 - 1.0f) / a0,
+                                  (1.0f - m_k * g + g2) / a0);
+    }
+
+private:
+    void updateCoefficients() {
+        const float cutoff = std::min(std::max(m_cutoff, 1.0f), MAX_CUTOFF_RATIO * m_sampleRate);
+        m_g = tanApprox(cutoff * m_piOverSampleRate);
+        m_k = 1.0f / std::max(m_q, 0.01f);
+        const float A = m_amplitude;
+
+        switch (m_type) {
+            case Type::LowPass:   m_m0 = 0.0f; m_m1 = 0.0f; m_m2 = 1.0f; break;
+            case Type::HighPass:  m_m0 = 1.0f; m_m1 = -m_k; m_m2 = -1.0f; break;
+            case Type::BandPass:  m_m0 = 0.0f; m_m1 = 1.0f; m_m2 = 0.0f; break;
+            case Type::Bell:
+                m_k /= A;
+                m_m0 = 1.0f; m_m1 = m_k * (A * A - 1.0f); m_m2 = 0.0f;
+                break;
+            case Type::LowShelf:
+                m_g /= m_sqrtAmplitude;
+                m_m0 = 1.0f; m_m1 = m_k * (A - 1.0f); m_m2 = A * A - 1.0f;
+                break;
+            case Type::HighShelf:
+                m_g *= m_sqrtAmplitude;
+                m_m0 = A * A; m_m1 = m_k * (1.0f - A) * A; m_m2 = 1.0f - A * A;
+                break;
+        }
+
+        m_a1 = 1.0f / (1.0f + m_g * (m_g + m_k));
+        m_a2 = m_g * m_a1;
+        m_a3 = m_g * m_a2;
+    }
+
+    Type m_type = Type::LowPass;
+    float m_sampleRate = 44100.0f, m_piOverSampleRate = 0.0f;
+    float m_cutoff = 1000.0f, m_q = 0.707f, m_gainDb = 0.0f;
+    float m_amplitude = 1.0f, m_sqrtAmplitude = 1.0f;
+    float m_g = 0.0f, m_k = 1.0f;
+    float m_a1 = 1.0f, m_a2 = 0.0f, m_a3 = 0.0f;    // Integrator solve
+    float m_m0 = 0.0f, m_m1 = 0.0f, m_m2 = 1.0f;    // Output mix of input, band, low
+    float m_ic1 = 0.0f, m_ic2 = 0.0f;               // Integrator states
+};
+
 // ============================================================================
 // 3-Band Tone Stack Controller
 // ============================================================================
 
+/**
+ * Knob moves never redesign filters on the audio path: gains are quantized
+ * to GAIN_STEP_DB and looked up in a per-sample-rate coefficient table
+ * shared by every controller at that rate. While audio is running, a new
+ * setting ramps the coefficients linearly over SMOOTHING_STEPS chunks of
+ * SMOOTHING_CHUNK samples (no zipper noise); settings made before the first
+ * sample after construction/reset() apply immediately.
+ *
+ * BandImplementation::SVF runs the same bands as SVFFilter shelves and
+ * bells instead: gains ramp in dB, and setBandFrequency() can sweep a band
+ * every sample (auto-wah, envelope-controlled presets).
+ */
 class ToneStackController {
 public:
+    static constexpr float GAIN_RANGE_DB = 12.0f;
+    static constexpr float GAIN_STEP_DB = 0.1f;
+    static constexpr int GAIN_STEPS = 241;          // -12dB..+12dB inclusive
+    static constexpr size_t SMOOTHING_CHUNK = 32;   // Samples per coefficient update
+    static constexpr int SMOOTHING_STEPS = 8;       // Updates per ramp (~5.8ms @ 44.1kHz)
+    
+    enum Band { BASS = 0, MID, TREBLE, PRESENCE, NUM_BANDS };
+    enum class BandImplementation { Biquad, SVF };
+    
+    /**
+     * Pre-designed coefficients for every quantized gain of every band
+     */
+    struct CoefficientTable {
+        std::array<std::array<BiquadCoefficients, GAIN_STEPS>, NUM_BANDS> bands;
+    };
+    
+    /**
+     * Shared coefficient table for a sample rate (built on first use)
+     */
+    static std::shared_ptr<const CoefficientTable> acquireCoefficientTable(float sampleRate);
+    
+    /**
+     * Number of coefficient tables currently alive
+     */
+    static size_t cachedCoefficientTableCount();
+    
+    /**
+     * Design the coefficients for one band at a gain (the uncached path)
+     */
+    static BiquadCoefficients designBand(Band band, float sampleRate, float gainDb);
+    
+    /**
+     * Coefficient table row for a gain (clamped to ±GAIN_RANGE_DB)
+     */
+    static int gainIndex(float gainDb);
+    
     /**
      * Initialize tone stack with default cutoff frequencies
      * @param sampleRate Sample rate (Hz)
@@ -181,6 +611,14 @@ public:
      */
     float process(float input);
     
+    /**
+     * Process a buffer through the tone stack, one band at a time
+     * @param input Input samples
+     * @param output Output samples (may alias input)
+     * @param numSamples Number of samples
+     */
+    void processBlock(const float* input, float* output, size_t numSamples);
+    
     /**
      * Set bass control (-12dB to +12dB)
      * @param bassGainDb Bass gain in dB
@@ -206,31 +644,229 @@ public:
     void setPresenceGain(float presenceGainDb);
     
     /**
-     * Reset all filters and state
+     * Switch the band filters; the new filters start from silence
+     */
+    void setBandImplementation(BandImplementation implementation);
+    
+    BandImplementation getBandImplementation() const { return m_implementation; }
+    
+    /**
+     * Move a band's cutoff/centre (SVF bands only; cheap enough per sample).
+     * Biquad bands keep the frequencies their coefficient table was built for.
+     */
+    void setBandFrequency(Band band, float frequencyHz) { m_svfBands[band].setCutoff(frequencyHz); }
+    
+    /**
+     * Reset all filters and state; pending ramps jump to their targets
      */
     void reset();
     
+    /**
+     * True while any band is still ramping towards its target
+     */
+    bool isSmoothing() const;
+    
+    /**
+     * Coefficients currently applied by process(): bass, mid, treble
+     * (the equivalent biquads of the SVF bands in that mode)
+     */
+    std::array<BiquadCoefficients, 3> getCascadeCoefficients() const;
+    
+    float getSampleRate() const { return m_sampleRate; }
+    
+    /**
+     * Bands and ramps are held by value; the coefficient table is shared
+     * by every controller at this sample rate
+     */
+    MemoryFootprint getMemoryFootprint() const {
+        return {sizeof(ToneStackController), 0, m_table ? sizeof(CoefficientTable) : 0};
+    }
+    
     /**
      * Get bass filter bank
      */
-    BiquadFilterBank& getBassFilterBank() { return m_bassFilter; }
+    BiquadFilterBank<1>& getBassFilterBank() { return m_bassFilter; }
     
     /**
      * Get mid filter bank
      */
-    BiquadFilterBank& getMidFilterBank() { return m_midFilter; }
+    BiquadFilterBank<1>& getMidFilterBank() { return m_midFilter; }
     
     /**
      * Get treble filter bank
      */
-    BiquadFilterBank& getTrebleFilterBank() { return m_trebleFilter; }
+    BiquadFilterBank<1>& getTrebleFilterBank() { return m_trebleFilter; }
 
 private:
+    struct BandRamp {
+        BiquadCoefficients current, target, step;
+        float currentDb = 0.0f, targetDb = 0.0f, stepDb = 0.0f;   // SVF bands ramp the gain
+        int remaining = 0;
+    };
+    
+    BiquadFilterBank<1>& bandFilter(Band band);
+    void setBandGain(Band band, float gainDb);
+    void advanceSmoothing();
+    
     float m_sampleRate;
-    BiquadFilterBank m_bassFilter;      // Low-shelf @ 120Hz
-    BiquadFilterBank m_midFilter;       // Peak filter @ 1kHz
-    BiquadFilterBank m_trebleFilter;    // High-shelf @ 4.5kHz
-    BiquadFilterBank m_presenceFilter;  // Peak filter @ 4.5kHz
+    std::shared_ptr<const CoefficientTable> m_table;
+    std::array<BandRamp, NUM_BANDS> m_ramps;
+    size_t m_chunkPosition = 0;
+    bool m_running = false;
+    BiquadFilterBank<1> m_bassFilter;      // Low-shelf @ 120Hz
+    BiquadFilterBank<1> m_midFilter;       // Peak filter @ 1kHz
+    BiquadFilterBank<1> m_trebleFilter;    // High-shelf @ 4.5kHz
+    BiquadFilterBank<1> m_presenceFilter;  // Peak filter @ 4.5kHz
+    BandImplementation m_implementation = BandImplementation::Biquad;
+    std::array<SVFFilter, NUM_BANDS> m_svfBands;   // Same shapes, in band order
+};
+
+// ============================================================================
+// State-Space Models (SISO)
+// ============================================================================
+
+/**
+ * Single-input single-output state-space matrices, row-major, in double:
+ *   continuous: x' = A x + B u,       y = C x + D u
+ *   discrete:   x[n+1] = A x[n] + B u[n], y[n] = C x[n] + D u[n]
+ */
+struct StateSpaceMatrices {
+    size_t order = 0;
+    std::vector<double> A;  // order x order
+    std::vector<double> B;  // order
+    std::vector<double> C;  // order
+    double D = 0.0;
+};
+
+/**
+ * Bilinear (trapezoidal) discretization, T = 1 / sampleRate:
+ *   Ad = P^-1 (I + A T/2),  Bd = P^-1 B T,
+ *   Cd = C P^-1,            Dd = D + C P^-1 B T/2,   P = I - A T/2
+ * Throws std::invalid_argument if P is singular.
+ */
+StateSpaceMatrices discretizeBilinear(const StateSpaceMatrices& continuous, double sampleRate);
+
+// ============================================================================
+// Linear RC Network -> State Space
+// ============================================================================
+
+/**
+ * Resistor/capacitor network driven by an ideal voltage source (input node
+ * to ground) and read as a node voltage. Node 0 is ground; other nodes are
+ * any positive integers. buildStateSpace() uses modified nodal analysis
+ * with each capacitor as a voltage source whose value is its state (the
+ * capacitor voltage), so coupling capacitors straight off the input work.
+ * Capacitor-only loops (including a capacitor across the input) are
+ * rejected, as are floating nodes.
+ */
+class LinearNetwork {
+public:
+    static constexpr int GROUND = 0;
+    
+    void addResistor(int nodeA, int nodeB, double ohms);
+    void addCapacitor(int nodeA, int nodeB, double farads);
+    void setInputNode(int node) { m_inputNode = node; }
+    void setOutputNode(int node) { m_outputNode = node; }
+    
+    size_t getNumCapacitors() const { return m_capacitors.size(); }
+    
+    /**
+     * Continuous-time A/B/C/D, one state per capacitor
+     * Throws std::invalid_argument for an unsolvable network.
+     */
+    StateSpaceMatrices buildStateSpace() const;
+
+private:
+    struct Branch {
+        int nodeA, nodeB;
+        double value;
+    };
+    
+    std::vector<Branch> m_resistors;
+    std::vector<Branch> m_capacitors;
+    int m_inputNode = 1;
+    int m_outputNode = 1;
+};
+
+// ============================================================================
+// Fixed-Order State-Space Processor
+// ============================================================================
+
+/**
+ * Runs a discrete SISO state-space model with compile-time order N <= 8.
+ * Matrices live in fixed std::arrays, so the per-sample update is a fully
+ * unrollable N x N multiply-add that maps onto vector registers. Models of
+ * lower order are zero-padded (the extra states stay at 0).
+ */
+template <size_t N, typename Real = float>
+class StateSpaceProcessor {
+public:
+    static_assert(N >= 1 && N <= 8, "StateSpaceProcessor supports orders 1..8");
+    
+    StateSpaceProcessor() {
+        m_A.fill(Real(0));
+        m_B.fill(Real(0));
+        m_C.fill(Real(0));
+        m_D = Real(1);
+        reset();
+    }
+    
+    /**
+     * Load a discrete model (see discretizeBilinear)
+     * @return false if the model order exceeds N
+     */
+    bool setModel(const StateSpaceMatrices& discrete) {
+        if (discrete.order > N) return false;
+        m_A.fill(Real(0));
+        m_B.fill(Real(0));
+        m_C.fill(Real(0));
+        for (size_t i = 0; i < discrete.order; ++i) {
+            for (size_t j = 0; j < discrete.order; ++j) {
+                m_A[i * N + j] = Real(discrete.A[i * discrete.order + j]);
+            }
+            m_B[i] = Real(discrete.B[i]);
+            m_C[i] = Real(discrete.C[i]);
+        }
+        m_D = Real(discrete.D);
+        return true;
+    }
+    
+    /**
+     * Discretize a continuous model at sampleRate and load it
+     */
+    bool setContinuousModel(const StateSpaceMatrices& continuous, double sampleRate) {
+        return setModel(discretizeBilinear(continuous, sampleRate));
+    }
+    
+    void reset() { m_x.fill(Real(0)); }
+    
+    Real process(Real input) {
+        Real output = m_D * input;
+        for (size_t i = 0; i < N; ++i) output += m_C[i] * m_x[i];
+        
+        std::array<Real, N> next;
+        for (size_t i = 0; i < N; ++i) {
+            Real acc = m_B[i] * input;
+            for (size_t j = 0; j < N; ++j) acc += m_A[i * N + j] * m_x[j];
+            next[i] = acc;
+        }
+        m_x = next;
+        return output;
+    }
+    
+    void processBlock(const Real* input, Real* output, size_t numSamples) {
+        ScopedFlushDenormals noDenormals;
+        for (size_t n = 0; n < numSamples; ++n) output[n] = process(input[n]);
+        flushDenormals(m_x);
+    }
+    
+    const std::array<Real, N>& getState() const { return m_x; }
+
+private:
+    std::array<Real, N * N> m_A;
+    std::array<Real, N> m_B, m_C;
+    Real m_D;
+    std::array<Real, N> m_x;
 };
 
 // ============================================================================
@@ -271,6 +907,62 @@ public:
      * @return Array of frequency points
      */
     static std::vector<float> generateLogSweep(float fLow, float fHigh, size_t numPoints);
+    
+    // ========================================================================
+    // Batched evaluation into caller buffers
+    // ========================================================================
+    
+    /** Sweeps shorter than this per worker stay on the calling thread */
+    static constexpr size_t PARALLEL_MIN_POINTS = 2048;
+    
+    /**
+     * Evaluate a biquad cascade at many frequencies at once. Frequencies are
+     * processed in fixed-size blocks with the stage loop outside, so the
+     * complex arithmetic runs as straight-line loops the compiler vectorizes;
+     * cos(2w)/sin(2w) come from double-angle identities instead of libm.
+     * Large sweeps are split across up to maxThreads threads.
+     * @param stages Cascade coefficients
+     * @param numStages Number of stages
+     * @param frequencies Test frequencies (Hz)
+     * @param numFrequencies Number of frequencies
+     * @param sampleRate Sample rate (Hz)
+     * @param magnitude Output: linear magnitude per frequency (nullptr to skip)
+     * @param phase Output: phase in radians, summed per stage (nullptr to skip)
+     * @param maxThreads Thread cap (0 = hardware concurrency, 1 = no threads)
+     */
+    static void evaluateCascade(const BiquadCoefficients* stages, size_t numStages,
+                                const float* frequencies, size_t numFrequencies,
+                                float sampleRate, float* magnitude, float* phase,
+                                unsigned maxThreads = 0);
+    
+    /**
+     * Evaluate a filter bank's current stages (see evaluateCascade)
+     */
+    template <size_t N>
+    static void evaluateBank(const BiquadFilterBank<N>& bank,
+                             const float* frequencies, size_t numFrequencies,
+                             float sampleRate, float* magnitude, float* phase,
+                             unsigned maxThreads = 0) {
+        if constexpr (N == DYNAMIC_STAGES) {
+            std::vector<BiquadCoefficients> stages(bank.getNumStages());
+            for (size_t s = 0; s < stages.size(); ++s) stages[s] = bank.getStageCoefficients(s);
+            evaluateCascade(stages.data(), stages.size(), frequencies, numFrequencies,
+                            sampleRate, magnitude, phase, maxThreads);
+        } else {
+            std::array<BiquadCoefficients, N> stages;
+            for (size_t s = 0; s < N; ++s) stages[s] = bank.getStageCoefficients(s);
+            evaluateCascade(stages.data(), N, frequencies, numFrequencies,
+                            sampleRate, magnitude, phase, maxThreads);
+        }
+    }
+    
+    /**
+     * Evaluate a tone stack's bass/mid/treble cascade at its sample rate
+     */
+    static void evaluateToneStack(const ToneStackController& toneStack,
+                                  const float* frequencies, size_t numFrequencies,
+                                  float* magnitude, float* phase,
+                                  unsigned maxThreads = 0);
 };
 
 // ============================================================================
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "Denormals.h"
+#include "WDF.h"
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+#include <utility>
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file StaticChain.h
+ * @brief Circuits described at compile time: value packs and a stage type list
+ *
+ * The translator's --static-chain output describes a fixed pedal as types.
+ * Each stage's component values are a struct of static constexpr members
+ * (C++17 has no floating-point template parameters), and the stages are a
+ * type list:
+ *
+ *     struct InputRC { static constexpr double R = 10000.0, C = 1e-8; };
+ *     using Chain = StaticChain<StaticRCHighPass<InputRC>, StaticDiodeClipper<D1>>;
+ *
+ * There are no virtual calls, no runtime component objects and no stage
+ * loop: process() is one fold expression over the tuple of stages, so the
+ * compiler inlines the whole chain into the sample loop and folds every
+ * value-only expression. Only the sample rate is a runtime input; prepare()
+ * turns it into the few coefficients that depend on it.
+ */
+
+// ============================================================================
+// Stages
+// ============================================================================
+
+/**
+ * Fixed RC high-pass (series C, shunt R), bilinear one-pole
+ * Values: R (ohms), C (farads)
+ */
+template <typename Values>
+class StaticRCHighPass {
+public:
+    static constexpr double TAU = Values::R * Values::C;
+
+    void prepare(double sampleRate) {
+        const double k = 2.0 * TAU * sampleRate;
+        m_b0 = static_cast<float>(k / (1.0 + k));
+        m_a1 = static_cast<float>((1.0 - k) / (1.0 + k));
+        reset();
+    }
+
+    float process(float x) {
+        const float y = m_b0 * (x - m_x1) - m_a1 * m_y1;
+        m_x1 = x;
+        m_y1 = y;
+        return y;
+    }
+
+    void reset() { m_x1 = m_y1 = 0.0f; }
+
+private:
+    float m_b0 = 1.0f, m_a1 = 0.0f;
+    float m_x1 = 0.0f, m_y1 = 0.0f;
+};
+
+/**
+ * Fixed RC low-pass (series R, shunt C), bilinear one-pole
+ * Values: R (ohms), C (farads)
+ */
+template <typename Values>
+class StaticRCLowPass {
+public:
+    static constexpr double TAU = Values::R * Values::C;
+
+    void prepare(double sampleRate) {
+        const double k = 2.0 * TAU * sampleRate;
+        m_b0 = static_cast<float>(1.0 / (1.0 + k));
+        m_a1 = static_cast<float>((1.0 - k) / (1.0 + k));
+        reset();
+    }
+
+    float process(float x) {
+        const float y = m_b0 * (x + m_x1) - m_a1 * m_y1;
+        m_x1 = x;
+        m_y1 = y;
+        return y;
+    }
+
+    void reset() { m_x1 = m_y1 = 0.0f; }
+
+private:
+    float m_b0 = 1.0f, m_a1 = 0.0f;
+    float m_x1 = 0.0f, m_y1 = 0.0f;
+};
+
+/**
+ * Fixed gain; the multiply folds into its neighbours
+ * Values: gain (linear)
+ */
+template <typename Values>
+class StaticGain {
+public:
+    static constexpr float GAIN = static_cast<float>(Values::gain);
+
+    void prepare(double) {}
+    float process(float x) const { return GAIN * x; }
+    void reset() {}
+};
+
+/**
+ * Series resistor into an antiparallel diode pair to ground, solved in
+ * closed form with the Wright omega function (as WDF::DiodePair does):
+ * vin = v + R Is (exp(|v| / nVt) - 1) for the forward-biased diode.
+ * Values: Is (A), n, Vt (V), R (ohms, series plus diode Rs)
+ */
+template <typename Values>
+class StaticDiodeClipper {
+public:
+    static constexpr double N_VT = Values::n * Values::Vt;
+    static constexpr double R_IS = Values::R * Values::Is;
+    static constexpr double R_IS_OVER_VT = R_IS / N_VT;
+
+    StaticDiodeClipper() : m_logRIsOverVt(std::log(R_IS_OVER_VT)) {}
+
+    void prepare(double) {}
+
+    float process(float x) const {
+        const double vin = x;
+        const double sign = vin < 0.0 ? -1.0 : 1.0;
+        const double v = sign * vin + R_IS - N_VT * WDF::detail::omega4(m_logRIsOverVt + sign * vin / N_VT + R_IS_OVER_VT);
+        return static_cast<float>(sign * v);
+    }
+
+    void reset() {}
+
+private:
+    double m_logRIsOverVt;
+};
+
+/**
+ * Unmodelled stage kept in the list so indices match the analysis
+ */
+class StaticPassThrough {
+public:
+    void prepare(double) {}
+    float process(float x) const { return x; }
+    void reset() {}
+};
+
+// ============================================================================
+// Chain
+// ============================================================================
+
+template <typename... Stages>
+class StaticChain {
+public:
+    static constexpr size_t NUM_STAGES = sizeof...(Stages);
+
+    void prepare(double sampleRate) {
+        std::apply([sampleRate](auto&... stage) { (stage.prepare(sampleRate), ...); }, m_stages);
+    }
+
+    float process(float x) {
+        std::apply([&x](auto&... stage) { ((x = stage.process(x)), ...); }, m_stages);
+        return x;
+    }
+
+    /**
+     * Process in place; the chain is inlined into this loop
+     */
+    void processBlock(float* data, size_t numSamples) {
+        ScopedFlushDenormals noDenormals;
+        for (size_t i = 0; i < numSamples; ++i) data[i] = process(data[i]);
+    }
+
+    void reset() {
+        std::apply([](auto&... stage) { (stage.reset(), ...); }, m_stages);
+    }
+
+    template <size_t Index>
+    auto& stage() { return std::get<Index>(m_stages); }
+
+private:
+    std::tuple<Stages...> m_stages;
+};
+
+}  // namespace LiveSpiceDSP
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file SubBlockScheduler.h
+ * @brief Host blocks split at automation points and at a fixed chunk size
+ *
+ * A processor that reads its parameters once per host block turns an
+ * automation curve into a staircase with one step per block, and the step
+ * moves with the host's buffer size. Running every sample through the
+ * scalar path instead loses the vectorized kernels. forEachSubBlock()
+ * sits in between: it cuts the block wherever a parameter event lands and
+ * wherever a chunk reaches maxChunk samples, applies the events due at
+ * each cut, and hands the chunk to the block kernels. Parameter changes
+ * are then sample accurate and coefficients are refreshed at least every
+ * maxChunk samples (32 or 64 keeps the per-chunk set-up cost small), while
+ * each chunk still runs as a vectorized block.
+ */
+
+/**
+ * A parameter value that takes effect at a sample offset of the current
+ * block (host automation, MIDI-mapped knobs)
+ */
+struct ParameterEvent {
+    uint32_t offset = 0;      // Sample within the block
+    uint32_t parameter = 0;   // Processor-defined id
+    float value = 0.0f;
+};
+
+/**
+ * Split [0, numSamples) into chunks of at most maxChunk samples that start
+ * at every event offset. Before each chunk, apply(event) is called for the
+ * events at or before its start, in order; then process(start, length).
+ * Events should be sorted by offset: one that arrives out of order is
+ * applied at the next cut rather than dropped, and events at or past
+ * numSamples are applied after the last chunk (they hold for the next
+ * block). Real-time safe.
+ */
+template <typename Apply, typename Process>
+void forEachSubBlock(size_t numSamples, const ParameterEvent* events, size_t numEvents, size_t maxChunk,
+                     Apply&& apply, Process&& process) {
+    maxChunk = std::max<size_t>(1, maxChunk);
+    size_t next = 0;
+    for (size_t start = 0; start < numSamples;) {
+        while (next < numEvents && events[next].offset <= start) {
+            apply(events[next++]);
+        }
+        size_t end = std::min(numSamples, start + maxChunk);
+        if (next < numEvents) {
+            end = std::min<size_t>(end, events[next].offset);
+        }
+        process(start, end - start);
+        start = end;
+    }
+    while (next < numEvents) {
+        apply(events[next++]);
+    }
+}
+
+}  // namespace LiveSpiceDSP
@@ -0,0 +1,309 @@
+#include "SubcircuitTable.h"
+#include "DiodeModels.h"
+#include <cmath>
+
+namespace LiveSpiceDSP {
+
+namespace {
+
+/**
+ * Root of an increasing residual on [lo, hi] (negative at lo, positive at
+ * hi): Newton steps while they stay inside the shrinking bracket,
+ * bisection otherwise. residual(v, slope) returns g(v) and sets g'(v).
+ */
+template <typename Residual>
+double solveIncreasing(const Residual& residual, double lo, double hi) {
+    double v = 0.5 * (lo + hi);
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        double slope = 0.0;
+        const double g = residual(v, slope);
+        (g > 0.0 ? hi : lo) = v;
+        double next = slope > 0.0 ? v - g / slope : 0.5 * (lo + hi);
+        if (!(next >= lo && next <= hi)) next = 0.5 * (lo + hi);
+        if (std::abs(next - v) < 1e-13 || hi - lo < 1e-13) return next;
+        v = next;
+    }
+    return v;
+}
+
+// Knot position on a control axis with `points` knots
+double controlKnot(uint32_t k, uint32_t points) {
+    return points > 1 ? static_cast<double>(k) / static_cast<double>(points - 1) : 0.0;
+}
+
+// Input at warped position j (fractional) of the layout's knot grid
+double inputAt(const SubcircuitTable::Layout& layout, double j) {
+    const double range = layout.warp(layout.inputRange);
+    return layout.unwarp(-range + j * 2.0 * range / static_cast<double>(layout.inputPoints - 1));
+}
+
+/**
+ * Input level below which half a silicon drop appears across the diodes:
+ * where the warped knots should be densest
+ */
+constexpr double KNEE_VOLTS = 0.25;
+
+/**
+ * Voltage across a Shockley diode pair carrying current, in parallel with
+ * a resistor (0 ohms = none): increasing in v, and |v| is below both the
+ * resistor's and the diodes' share of the current alone
+ */
+double diodePairVoltage(double Is, double nVt, double parallel, double current) {
+    double bound = nVt * std::asinh(std::abs(current) / (2.0 * Is));
+    if (parallel > 0.0) bound = std::min(bound, std::abs(current) * parallel);
+    const double conductance = parallel > 0.0 ? 1.0 / parallel : 0.0;
+    return solveIncreasing([&](double v, double& slope) {
+        slope = conductance + 2.0 * Is / nVt * std::cosh(v / nVt);
+        return v * conductance + 2.0 * Is * std::sinh(v / nVt) - current;
+    }, -bound, bound);
+}
+
+/**
+ * Output before the rails of the op-amp clipper: the op-amp holds its
+ * inverting input at the input, so input / Rg flows through Rf || diodes
+ */
+double feedbackOutput(const Nonlinear::DiodeCharacteristics& diode, double Rf, double Rg, double input) {
+    return input + diodePairVoltage(diode.Is, static_cast<double>(diode.n) * diode.Vt, Rf, input / Rg);
+}
+
+/**
+ * Diode voltage behind a series resistor: input = v + R * I(v), an
+ * increasing function bracketed by |v| <= |input|
+ */
+double groundOutput(const Nonlinear::DiodeCharacteristics& diode, double R, double input) {
+    const double Is = diode.Is, nVt = static_cast<double>(diode.n) * diode.Vt;
+    const double bound = std::min(std::abs(input), nVt * std::asinh(std::abs(input) / (2.0 * Is * R)));
+    return solveIncreasing([&](double v, double& slope) {
+        slope = 1.0 + 2.0 * R * Is / nVt * std::cosh(v / nVt);
+        return v + 2.0 * R * Is * std::sinh(v / nVt) - input;
+    }, -bound, bound);
+}
+
+/**
+ * Largest |table - solve| between the knots: along the input (pots at
+ * their knots), along each pot axis (input at its knots), and at the
+ * centres of the grid cells
+ */
+struct AxisErrors {
+    double input = 0.0;
+    std::array<double, SubcircuitTable::MAX_CONTROLS> control{};
+    double total = 0.0;
+};
+
+AxisErrors measureErrors(const SubcircuitTable& table, const SubcircuitTable::Solve& solve) {
+    const auto& layout = table.getLayout();
+    const uint32_t segments = layout.inputPoints - 1;
+    const uint32_t p0 = layout.controlPoints[0], p1 = layout.controlPoints[1];
+    const double limit = layout.outputLimit > 0.0 ? layout.outputLimit : std::numeric_limits<double>::max();
+
+    auto error = [&](double x, double c0, double c1) {
+        const SubcircuitTable::Controls controls{{static_cast<float>(c0), static_cast<float>(c1)}};
+        const double reference = std::clamp(solve(x, c0, c1), -limit, limit);
+        return std::abs(static_cast<double>(table.process(static_cast<float>(x), controls)) - reference);
+    };
+
+    AxisErrors errors;
+    for (uint32_t k1 = 0; k1 < p1; ++k1) {
+        for (uint32_t k0 = 0; k0 < p0; ++k0) {
+            const double c0 = controlKnot(k0, p0), c1 = controlKnot(k1, p1);
+            for (uint32_t j = 0; j < segments; ++j) {
+                for (double t : {0.25, 0.5, 0.75}) {
+                    errors.input = std::max(errors.input, error(inputAt(layout, j + t), c0, c1));
+                }
+            }
+        }
+    }
+
+    for (size_t axis = 0; axis < layout.numControls; ++axis) {
+        const uint32_t points = layout.controlPoints[axis], other = layout.controlPoints[1 - axis];
+        for (uint32_t k = 0; k + 1 < points; ++k) {
+            const double middle = (controlKnot(k, points) + controlKnot(k + 1, points)) * 0.5;
+            for (uint32_t m = 0; m < other; ++m) {
+                const double fixed = controlKnot(m, other);
+                for (uint32_t j = 0; j < layout.inputPoints; ++j) {
+                    const double x = inputAt(layout, j);
+                    errors.control[axis] = std::max(errors.control[axis],
+                                                    axis == 0 ? error(x, middle, fixed) : error(x, fixed, middle));
+                }
+            }
+        }
+    }
+
+    double cells = 0.0;
+    if (layout.numControls > 0) {
+        const uint32_t m0 = std::max<uint32_t>(p0 - 1, 1), m1 = std::max<uint32_t>(p1 - 1, 1);
+        for (uint32_t k1 = 0; k1 < m1; ++k1) {
+            for (uint32_t k0 = 0; k0 < m0; ++k0) {
+                const double c0 = p0 > 1 ? (k0 + 0.5) / (p0 - 1) : 0.0;
+                const double c1 = p1 > 1 ? (k1 + 0.5) / (p1 - 1) : 0.0;
+                for (uint32_t j = 0; j < segments; ++j) {
+                    cells = std::max(cells, error(inputAt(layout, j + 0.5), c0, c1));
+                }
+            }
+        }
+    }
+
+    errors.total = std::max(errors.input, cells);
+    for (double e : errors.control) errors.total = std::max(errors.total, e);
+    return errors;
+}
+
+}  // namespace
+
+// ============================================================================
+// SubcircuitTable Implementation
+// ============================================================================
+
+SubcircuitTable SubcircuitTable::tabulate(const Solve& solve, const Layout& layout) {
+    std::vector<float> samples(layout.numSamples());
+    const size_t rowLength = layout.rowLength();
+
+    size_t row = 0;
+    for (uint32_t k1 = 0; k1 < layout.controlPoints[1]; ++k1) {
+        for (uint32_t k0 = 0; k0 < layout.controlPoints[0]; ++k0, ++row) {
+            const double c0 = controlKnot(k0, layout.controlPoints[0]);
+            const double c1 = controlKnot(k1, layout.controlPoints[1]);
+            float* knots = samples.data() + row * rowLength;
+            for (uint32_t j = 0; j < layout.inputPoints; ++j) {
+                const double x = inputAt(layout, j);
+                knots[j + 1] = static_cast<float>(solve(x, c0, c1) - layout.directGain * x);
+            }
+            // The outer knots continue the end segments, for the end tangents
+            knots[0] = 2.0f * knots[1] - knots[2];
+            knots[rowLength - 1] = 2.0f * knots[rowLength - 2] - knots[rowLength - 3];
+        }
+    }
+    return SubcircuitTable(layout, std::move(samples));
+}
+
+SubcircuitTable SubcircuitTable::build(const Solve& solve, size_t numControls, const Layout& shape, const Budget& budget) {
+    const uint32_t maxInput = std::max<uint32_t>(budget.maxInputPoints, 2);
+    const uint32_t maxControl = std::max<uint32_t>(budget.maxControlPoints, 2);
+
+    Layout layout = shape;
+    layout.inputRange = std::max(shape.inputRange, 1e-6);
+    layout.inputScale = std::max(shape.inputScale, 1e-9);
+    layout.inputPoints = std::min<uint32_t>(65, maxInput);
+    layout.numControls = static_cast<uint32_t>(std::min(numControls, MAX_CONTROLS));
+    layout.controlPoints = {{1, 1}};
+    for (size_t axis = 0; axis < layout.numControls; ++axis) {
+        layout.controlPoints[axis] = std::min<uint32_t>(3, maxControl);
+    }
+
+    for (;;) {
+        SubcircuitTable table = tabulate(solve, layout);
+        const AxisErrors errors = measureErrors(table, solve);
+        table.m_maxError = errors.total;
+        if (errors.total <= budget.maxError) {
+            return table;
+        }
+
+        // Refine the axis with the largest error; once that one is at its
+        // limit, refining the others cannot lower the maximum
+        uint32_t* refine = &layout.inputPoints;
+        uint32_t limit = maxInput;
+        double worst = errors.input;
+        for (size_t axis = 0; axis < layout.numControls; ++axis) {
+            if (errors.control[axis] > worst) {
+                refine = &layout.controlPoints[axis];
+                limit = maxControl;
+                worst = errors.control[axis];
+            }
+        }
+        if (2 * *refine - 1 > limit) {
+            return table;
+        }
+        *refine = 2 * *refine - 1;
+    }
+}
+
+double SubcircuitTable::solveDiodeFeedback(const Nonlinear::DiodeCharacteristics& diode, const DiodeFeedbackClipper& circuit,
+                                           double input, double control0, double control1) {
+    // Controls go to the variable resistances in order
+    const double controls[] = {control0, control1};
+    size_t axis = 0;
+    const double Rf = circuit.feedback.at(circuit.feedback.isVariable() ? controls[axis++] : 0.0);
+    const double Rg = circuit.ground.at(circuit.ground.isVariable() ? controls[axis++] : 0.0);
+    return std::clamp(feedbackOutput(diode, Rf, Rg, input), -circuit.rail, circuit.rail);
+}
+
+double SubcircuitTable::solveDiodesToGround(const Nonlinear::DiodeCharacteristics& diode, const DiodesToGroundClipper& circuit,
+                                            double input, double control0) {
+    return groundOutput(diode, circuit.series.at(circuit.series.isVariable() ? control0 : 0.0), input);
+}
+
+SubcircuitTable SubcircuitTable::diodeFeedback(const Nonlinear::DiodeCharacteristics& diode,
+                                               const DiodeFeedbackClipper& circuit,
+                                               const Budget& budget, double inputRange) {
+    // The table holds the diode voltage; the unity path and the rails are applied after it
+    DiodeFeedbackClipper unclamped = circuit;
+    unclamped.rail = std::numeric_limits<double>::max();
+    const Solve solve = [diode, unclamped](double input, double control0, double control1) {
+        return solveDiodeFeedback(diode, unclamped, input, control0, control1);
+    };
+
+    Layout shape;
+    shape.inputRange = inputRange;
+    shape.inputScale = KNEE_VOLTS * circuit.ground.at(0.0) / circuit.feedback.at(1.0);   // At the highest gain
+    shape.directGain = 1.0;
+    shape.outputLimit = circuit.rail;
+    const size_t controls = static_cast<size_t>(circuit.feedback.isVariable()) + circuit.ground.isVariable();
+    return build(solve, controls, shape, budget);
+}
+
+SubcircuitTable SubcircuitTable::diodesToGround(const Nonlinear::DiodeCharacteristics& diode,
+                                                const DiodesToGroundClipper& circuit,
+                                                const Budget& budget, double inputRange) {
+    const Solve solve = [diode, circuit](double input, double control0, double) {
+        return solveDiodesToGround(diode, circuit, input, control0);
+    };
+
+    Layout shape;
+    shape.inputRange = inputRange;
+    shape.inputScale = KNEE_VOLTS;
+    return build(solve, circuit.series.isVariable() ? 1 : 0, shape, budget);
+}
+
+template <int ROWS>
+void SubcircuitTable::blockPass(const Rows& rows, const float* input, float* output, size_t numSamples) const {
+    const float range = m_rangeF, inverseStep = m_inverseStepF, inverseScale = m_inverseScaleF;
+    const float directGain = m_directGainF, limit = m_limitF;
+    const int lastSegment = m_lastSegment;
+
+    // Results go through a local chunk, which provably does not alias the
+    // samples, so the gathers vectorize
+    float y[CHUNK];
+    for (size_t start = 0; start < numSamples; start += CHUNK) {
+        const size_t count = std::min(CHUNK, numSamples - start);
+        for (size_t n = 0; n < count; ++n) {
+            const float x = input[start + n];
+            const float w = std::copysign(std::log1p(std::abs(x) * inverseScale), x);
+            const float u = (std::clamp(w, -range, range) + range) * inverseStep;
+            const int i = std::min(static_cast<int>(u), lastSegment);
+            const float t = u - static_cast<float>(i);
+            const float t2 = t * t, t3 = t2 * t;
+            const float b0 = 0.5f * (-t + 2.0f * t2 - t3);
+            const float b1 = 0.5f * (2.0f - 5.0f * t2 + 3.0f * t3);
+            const float b2 = 0.5f * (t + 4.0f * t2 - 3.0f * t3);
+            const float b3 = 0.5f * (t3 - t2);
+            float sum = directGain * x;
+            for (int r = 0; r < ROWS; ++r) {
+                const float* knots = rows.row[r] + i;
+                sum += rows.weight[r] * (b0 * knots[0] + b1 * knots[1] + b2 * knots[2] + b3 * knots[3]);
+            }
+            y[n] = std::clamp(sum, -limit, limit);
+        }
+        std::copy(y, y + count, output + start);
+    }
+}
+
+void SubcircuitTable::processBlock(const float* input, float* output, size_t numSamples, const Controls& controls) const {
+    const Rows rows = locateRows(controls);
+    switch (rows.count) {
+        case 1: blockPass<1>(rows, input, output, numSamples); break;
+        case 2: blockPass<2>(rows, input, output, numSamples); break;
+        default: blockPass<4>(rows, input, output, numSamples); break;
+    }
+}
+
+}  // namespace LiveSpiceDSP
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace Nonlinear {
+struct DiodeCharacteristics;
+}
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file SubcircuitTable.h
+ * @brief Whole clipping subcircuits pre-solved into input x pot tables
+ *
+ * The classic clippers (an op-amp with diodes across its feedback
+ * resistor, a resistor into back-to-back diodes to ground) have no memory
+ * once their capacitors are left out: the output is a function of the
+ * input voltage and the positions of the one or two pots inside the
+ * subcircuit. SubcircuitTable solves that function offline (exact
+ * Shockley currents, bracketed Newton, double precision) on a grid of
+ * input knots by pot knots and replaces the per-sample Newton solve with
+ * a fixed-cost lookup: Catmull-Rom along the input, linear across each
+ * pot axis, so 1D, 2D and 3D tables cost 4, 8 and 16 gathers per sample.
+ *
+ * A high-gain clipper bends within millivolts of zero and then follows a
+ * logarithm for volts, so the input axis is warped,
+ * u = sign(x) log(1 + |x| / scale): knots are evenly spaced below the
+ * knee scale and geometrically spaced above it; a linear part of the output
+ * (the op-amp's unity path) is added back at run time rather than
+ * tabulated, and a rail clamp is applied after interpolation so its kink
+ * stays exact.
+ *
+ * build() refines the grid until the interpolation error, measured
+ * against the solver between the knots, fits an error budget. The samples
+ * are plain floats, so a translator can write them into a generated
+ * plugin as static data and construct a table view over them at no cost.
+ */
+
+/**
+ * Resistance set by a pot position p in [0, 1]: fixed + p * pot. A zero
+ * pot value makes the resistance fixed, and the table gets no axis for it.
+ */
+struct PotResistance {
+    double fixed = 10000.0;
+    double pot = 0.0;
+
+    double at(double position) const { return fixed + position * pot; }
+    bool isVariable() const { return pot != 0.0; }
+};
+
+/**
+ * Non-inverting op-amp with antiparallel diodes across its feedback
+ * resistor (Tube Screamer style): out = in + vf, where the current
+ * in / Rg splits between Rf and the diodes, clamped to the rails
+ */
+struct DiodeFeedbackClipper {
+    PotResistance feedback{51000.0, 500000.0};   // Rf: drive pot in series with a fixed leg
+    PotResistance ground{4700.0, 0.0};           // Rg to ground
+    double rail = 4.5;                           // Output swing (V)
+};
+
+/**
+ * Series resistor into antiparallel diodes to ground (the circuit of
+ * DiodeClippingStage's BackToBackDiodes topology)
+ */
+struct DiodesToGroundClipper {
+    PotResistance series{10000.0, 0.0};
+};
+
+/**
+ * Largest interpolation error SubcircuitTable::build() may leave, and the
+ * grid it may grow to meet it (knot counts go to 2n - 1, so knots nest)
+ */
+struct SubcircuitBudget {
+    double maxError = 1e-3;            // Output units (V)
+    uint32_t maxInputPoints = 2049;
+    uint32_t maxControlPoints = 129;
+};
+
+class SubcircuitTable {
+public:
+    static constexpr size_t MAX_CONTROLS = 2;
+    static constexpr size_t CHUNK = 64;   // Block pass stack buffer (samples)
+
+    /** Pot positions in [0, 1], one per axis; unused entries are ignored */
+    using Controls = std::array<float, MAX_CONTROLS>;
+
+    /** Subcircuit output before the output limit, for an input voltage and pot positions */
+    using Solve = std::function<double(double input, double control0, double control1)>;
+
+    using Budget = SubcircuitBudget;
+
+    /**
+     * Table shape. Output = clamp(directGain * x + T(u, controls), +-outputLimit)
+     * with u = sign(x) log(1 + |x| / inputScale); T is sampled at inputPoints even
+     * steps of u over the warped [-inputRange, inputRange] (held beyond).
+     * Samples are stored row by row, the input fastest and control 0
+     * before control 1; each row has one extra knot at each end
+     * (extrapolated) for the end tangents.
+     */
+    struct Layout {
+        double inputRange = 10.0;
+        double inputScale = 1.0;        // Knots go from even to geometric spacing here
+        double directGain = 0.0;        // Linear part added back at run time
+        double outputLimit = 0.0;       // Rail clamp (0 = none)
+        uint32_t inputPoints = 2;       // Knots over the input range
+        uint32_t numControls = 0;
+        std::array<uint32_t, MAX_CONTROLS> controlPoints{{1, 1}};   // Knots over [0, 1] (1 = no axis)
+
+        size_t rowLength() const { return static_cast<size_t>(inputPoints) + 2; }
+        size_t numRows() const { return static_cast<size_t>(controlPoints[0]) * controlPoints[1]; }
+        size_t numSamples() const { return rowLength() * numRows(); }
+
+        /** Warped coordinate of an input, and its inverse */
+        double warp(double x) const { return std::copysign(std::log1p(std::abs(x) / inputScale), x); }
+        double unwarp(double u) const { return std::copysign(inputScale * std::expm1(std::abs(u)), u); }
+    };
+
+    /**
+     * Tabulate solve over numControls pot axes with shape's range, scale,
+     * direct gain and limit, refining whichever axis contributes the most
+     * error until the measured error fits the budget or that axis is at
+     * its limit (getMaxError() then reports what was reached). Not
+     * real-time safe.
+     */
+    static SubcircuitTable build(const Solve& solve, size_t numControls, const Layout& shape,
+                                 const Budget& budget = {});
+
+    /**
+     * Stock subcircuits. Controls follow the variable resistances in
+     * declaration order (feedback, then ground).
+     */
+    static SubcircuitTable diodeFeedback(const Nonlinear::DiodeCharacteristics& diode,
+                                         const DiodeFeedbackClipper& circuit = {},
+                                         const Budget& budget = {}, double inputRange = 10.0);
+    static SubcircuitTable diodesToGround(const Nonlinear::DiodeCharacteristics& diode,
+                                          const DiodesToGroundClipper& circuit = {},
+                                          const Budget& budget = {}, double inputRange = 10.0);
+
+    /** Exact outputs behind the stock tables (the offline reference), rails included */
+    static double solveDiodeFeedback(const Nonlinear::DiodeCharacteristics& diode, const DiodeFeedbackClipper& circuit,
+                                     double input, double control0 = 0.0, double control1 = 0.0);
+    static double solveDiodesToGround(const Nonlinear::DiodeCharacteristics& diode, const DiodesToGroundClipper& circuit,
+                                      double input, double control0 = 0.0);
+
+    /**
+     * View over caller-owned samples (layout.numSamples() floats, e.g.
+     * static data in a generated plugin); nothing is copied
+     */
+    SubcircuitTable(const Layout& layout, const float* samples, double maxError = 0.0)
+        : m_layout(layout), m_external(samples), m_maxError(maxError) {
+        updateCachedConstants();
+    }
+
+    float process(float x, const Controls& controls = {}) const {
+        const Rows rows = locateRows(controls);
+        int i;
+        std::array<float, 4> basis;
+        locate(x, i, basis);
+        float y = m_directGainF * x;
+        for (int r = 0; r < rows.count; ++r) {
+            const float* knots = rows.row[r] + i;
+            y += rows.weight[r] * (basis[0] * knots[0] + basis[1] * knots[1] + basis[2] * knots[2] + basis[3] * knots[3]);
+        }
+        return std::clamp(y, -m_limitF, m_limitF);
+    }
+
+    /**
+     * Table pass over a block at fixed pot positions; output may alias
+     * input. Real-time safe.
+     */
+    void processBlock(const float* input, float* output, size_t numSamples, const Controls& controls = {}) const;
+
+    const Layout& getLayout() const { return m_layout; }
+    const float* getSamples() const { return m_external ? m_external : m_storage.data(); }
+
+    /** Largest error measured against the solver (as supplied for a view) */
+    double getMaxError() const { return m_maxError; }
+    size_t getMemoryBytes() const { return m_layout.numSamples() * sizeof(float); }
+
+private:
+    Layout m_layout;
+    std::vector<float> m_storage;         // Owned samples (empty for a view)
+    const float* m_external = nullptr;
+    double m_maxError = 0.0;
+    float m_rangeF = 1.0f, m_inverseStepF = 1.0f, m_inverseScaleF = 1.0f;
+    float m_directGainF = 0.0f, m_limitF = 0.0f;
+    int m_lastSegment = 0;
+
+    /**
+     * Up to four rows around the pot positions and their weights (rows of
+     * absent axes are skipped, so a 1D table reads one row)
+     */
+    struct Rows {
+        std::array<const float*, 4> row;
+        std::array<float, 4> weight;
+        int count;
+    };
+
+    SubcircuitTable(const Layout& layout, std::vector<float> samples)
+        : m_layout(layout), m_storage(std::move(samples)) {
+        updateCachedConstants();
+    }
+
+    /** Solve at every knot of layout */
+    static SubcircuitTable tabulate(const Solve& solve, const Layout& layout);
+
+    /** processBlock body for a fixed number of rows (1, 2 or 4) */
+    template <int ROWS>
+    void blockPass(const Rows& rows, const float* input, float* output, size_t numSamples) const;
+
+    void updateCachedConstants() {
+        const uint32_t points = std::max<uint32_t>(m_layout.inputPoints, 2);
+        const double range = m_layout.warp(m_layout.inputRange);
+        m_lastSegment = static_cast<int>(points) - 2;
+        m_rangeF = static_cast<float>(range);
+        m_inverseStepF = static_cast<float>(static_cast<double>(points - 1) / (2.0 * range));
+        m_inverseScaleF = static_cast<float>(1.0 / m_layout.inputScale);
+        m_directGainF = static_cast<float>(m_layout.directGain);
+        m_limitF = m_layout.outputLimit > 0.0 ? static_cast<float>(m_layout.outputLimit)
+                                              : std::numeric_limits<float>::max();
+    }
+
+    Rows locateRows(const Controls& controls) const {
+        Rows rows;
+        rows.count = 1;
+        rows.row[0] = getSamples();
+        rows.weight[0] = 1.0f;
+        size_t stride = m_layout.rowLength();
+        for (size_t axis = 0; axis < m_layout.numControls && axis < MAX_CONTROLS; ++axis) {
+            const uint32_t points = m_layout.controlPoints[axis];
+            if (points > 1) {
+                const float u = std::clamp(controls[axis], 0.0f, 1.0f) * static_cast<float>(points - 1);
+                const uint32_t k = std::min(static_cast<uint32_t>(u), points - 2);
+                const float f = u - static_cast<float>(k);
+                // Each row so far splits into the knots below and above
+                for (int r = 0; r < rows.count; ++r) {
+                    rows.row[r + rows.count] = rows.row[r] + (k + 1) * stride;
+                    rows.weight[r + rows.count] = rows.weight[r] * f;
+                    rows.row[r] += k * stride;
+                    rows.weight[r] *= 1.0f - f;
+                }
+                rows.count *= 2;
+            }
+            stride *= points;
+        }
+        return rows;
+    }
+
+    // Segment index (offset into a row: its left neighbour knot) and Catmull-Rom weights
+    void locate(float x, int& i, std::array<float, 4>& basis) const {
+        const float w = std::copysign(std::log1p(std::abs(x) * m_inverseScaleF), x);
+        const float u = (std::clamp(w, -m_rangeF, m_rangeF) + m_rangeF) * m_inverseStepF;
+        i = std::min(static_cast<int>(u), m_lastSegment);
+        const float t = u - static_cast<float>(i);
+        const float t2 = t * t, t3 = t2 * t;
+        basis[0] = 0.5f * (-t + 2.0f * t2 - t3);
+        basis[1] = 0.5f * (2.0f - 5.0f * t2 + 3.0f * t3);
+        basis[2] = 0.5f * (t + 4.0f * t2 - 3.0f * t3);
+        basis[3] = 0.5f * (t3 - t2);
+    }
+};
+
+}  // namespace LiveSpiceDSP
@@ -0,0 +1,106 @@
+#include "TableRebuildWorker.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace LiveSpiceDSP {
+
+TableRebuildWorker::TableRebuildWorker() {
+    m_thread = std::thread([this] { workerLoop(); });
+
+#if defined(__linux__)
+    // Table builds are background work: never take time from audio or UI threads
+    sched_param param{};
+    pthread_setschedparam(m_thread.native_handle(), SCHED_IDLE, &param);
+#endif
+}
+
+TableRebuildWorker::~TableRebuildWorker() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    m_thread.join();
+}
+
+TableRebuildWorker& TableRebuildWorker::shared() {
+    // Never destroyed, so owners with static storage can still cancel() at exit
+    static TableRebuildWorker* worker = new TableRebuildWorker();
+    return *worker;
+}
+
+void TableRebuildWorker::schedule(const void* owner, Job job) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_parked.erase(owner);
+        m_jobs[owner] = std::move(job);
+    }
+    m_wake.notify_one();
+}
+
+void TableRebuildWorker::cancel(const void* owner) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_jobs.erase(owner);
+    m_parked.erase(owner);
+    if (m_running == owner) {
+        m_runningCancelled = true;
+        m_idle.wait(lock, [this, owner] { return m_running != owner; });
+    }
+}
+
+void TableRebuildWorker::resume() {
+    if (!m_hasParked.load(std::memory_order_acquire)) return;
+    
+    // Not under the lock: a wake-up lost to the worker's wait is repeated next block
+    m_resumed.store(true, std::memory_order_release);
+    m_wake.notify_one();
+}
+
+void TableRebuildWorker::waitIdle() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_jobs.empty() && m_running == nullptr; });
+}
+
+void TableRebuildWorker::workerLoop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (!m_stop) {
+        if (m_resumed.exchange(false, std::memory_order_acq_rel)) {
+            // Back into the queue; schedule() already dropped any parked job it replaced
+            for (auto& [owner, job] : m_parked) m_jobs.emplace(owner, std::move(job));
+            m_parked.clear();
+            m_hasParked.store(false, std::memory_order_release);
+        }
+        if (m_jobs.empty()) {
+            m_wake.wait(lock, [this] {
+                return m_stop || !m_jobs.empty() || m_resumed.load(std::memory_order_acquire);
+            });
+            continue;
+        }
+
+        auto it = m_jobs.begin();
+        const void* owner = it->first;
+        Job job = std::move(it->second);
+        m_jobs.erase(it);
+        m_running = owner;
+        m_runningCancelled = false;
+
+        lock.unlock();
+        const bool done = job();
+        lock.lock();
+
+        // Park until the audio side has run a block; a newer job for this
+        // owner supersedes the one that asked for a retry
+        if (!done && !m_runningCancelled && m_jobs.find(owner) == m_jobs.end()) {
+            m_parked[owner] = std::move(job);
+            m_hasParked.store(true, std::memory_order_release);
+        }
+        m_running = nullptr;
+        m_idle.notify_all();
+    }
+}
+
+}  // namespace LiveSpiceDSP
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file TableRebuildWorker.h
+ * @brief Low-priority thread that rebuilds parameter-dependent tables
+ *
+ * A knob that changes a tabulated nonlinearity (a clipper's load, say)
+ * cannot rebuild the table on the audio thread. The control thread
+ * schedules a job here instead; the job builds the table and publishes it
+ * to a double-buffered slot the audio thread polls once per block.
+ *
+ * Jobs are coalesced per owner: scheduling again replaces a job that has
+ * not started. A job returns false when it cannot publish yet (the audio
+ * thread has not picked up the previous table); it is parked until the
+ * audio side calls resume() from its next block, so a stopped audio
+ * thread leaves the worker asleep rather than retrying forever.
+ * Owners must cancel() before they are destroyed.
+ */
+class TableRebuildWorker {
+public:
+    /** Returns false to be parked and run again after the next resume() */
+    using Job = std::function<bool()>;
+
+    TableRebuildWorker();
+    ~TableRebuildWorker();
+
+    TableRebuildWorker(const TableRebuildWorker&) = delete;
+    TableRebuildWorker& operator=(const TableRebuildWorker&) = delete;
+
+    /**
+     * Process-wide worker shared by every stage and pedal
+     */
+    static TableRebuildWorker& shared();
+
+    /**
+     * Queue owner's job, replacing one that has not started
+     * Locks and allocates: call from the control thread, not audio.
+     */
+    void schedule(const void* owner, Job job);
+
+    /**
+     * Drop owner's queued or parked job and wait for a running one to finish
+     */
+    void cancel(const void* owner);
+
+    /**
+     * Requeue parked jobs (audio thread, once per block)
+     * Lock- and allocation-free; a single atomic load while none is parked.
+     */
+    void resume();
+
+    /**
+     * Block until no job is queued or running (tests, offline rendering)
+     * Parked jobs wait for the audio side and are not waited for.
+     */
+    void waitIdle();
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_idle;
+    std::map<const void*, Job> m_jobs;
+    std::map<const void*, Job> m_parked;   // Waiting for resume()
+    std::atomic<bool> m_hasParked{false};
+    std::atomic<bool> m_resumed{false};
+    const void* m_running = nullptr;
+    bool m_runningCancelled = false;
+    bool m_stop = false;
+    std::thread m_thread;
+
+    void workerLoop();
+};
+
+}  // namespace LiveSpiceDSP
@@ -4,12 +4,34 @@
 
 namespace TopologyAnalysis {
 
+namespace {
+
+uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+}  // namespace
+
 // ============================================================================
 // Pattern Registry - Initialize all known patterns
 // ============================================================================
 
 PatternRegistry::PatternRegistry() {
+    version = fnv1a(14695981039346656037ull, &MATCHER_REVISION, sizeof(MATCHER_REVISION));
     initializeCorePatterns();
+    for (uint32_t i = 0; i < patterns.size(); ++i) {
+        indexPattern(i);
+    }
+}
+
+const PatternRegistry& PatternRegistry::shared() {
+    static const PatternRegistry registry;
+    return registry;
 }
 
 void PatternRegistry::initializeCorePatterns() {
@@ -21,6 +43,7 @@ void PatternRegistry::initializeCorePatterns() {
     rcLowPass.name = "Passive RC Low-Pass Filter";
     rcLowPass.category = PatternCategory::PassiveFilter;
     rcLowPass.signature = {LiveSpice::ComponentType::Resistor, LiveSpice::ComponentType::Capacitor};
+    rcLowPass.topology = {{0, 1}};
     rcLowPass.dspStrategy = "cascaded_biquad";
     rcLowPass.parameters = {"Resistance", "Capacitance", "CutoffFrequency"};
     rcLowPass.description = "Simple RC network for low-pass filtering";
@@ -31,6 +54,7 @@ void PatternRegistry::initializeCorePatterns() {
     rcHighPass.name = "Passive RC High-Pass Filter";
     rcHighPass.category = PatternCategory::PassiveFilter;
     rcHighPass.signature = {LiveSpice::ComponentType::Capacitor, LiveSpice::ComponentType::Resistor};
+    rcHighPass.topology = {{0, 1}};
     rcHighPass.dspStrategy = "cascaded_biquad";
     rcHighPass.parameters = {"Resistance", "Capacitance", "CutoffFrequency"};
     rcHighPass.description = "Simple RC network for high-pass filtering";
@@ -41,6 +65,7 @@ void PatternRegistry::initializeCorePatterns() {
     lcBandPass.name = "Passive LC Band-Pass Filter";
     lcBandPass.category = PatternCategory::PassiveFilter;
     lcBandPass.signature = {LiveSpice::ComponentType::Inductor, LiveSpice::ComponentType::Capacitor};
+    lcBandPass.topology = {{0, 1}};
     lcBandPass.dspStrategy = "cascaded_biquad";
     lcBandPass.parameters = {"Inductance", "Capacitance", "ResonantFrequency", "Q"};
     lcBandPass.description = "LC resonant tank for narrow band-pass";
@@ -96,6 +121,7 @@ void PatternRegistry::initializeCorePatterns() {
     commonEmitter.category = PatternCategory::AmplifierStage;
     commonEmitter.signature = {LiveSpice::ComponentType::Transistor, LiveSpice::ComponentType::Resistor, 
                                LiveSpice::ComponentType::Resistor, LiveSpice::ComponentType::Capacitor};
+    commonEmitter.topology = {{0, 1}, {0, 2}, {0, 3}};
     commonEmitter.dspStrategy = "nonlinear_solver";
     commonEmitter.parameters = {"Gain", "InputImpedance", "OutputImpedance"};
     commonEmitter.description = "Transistor voltage amplifier with inverting phase shift";
@@ -121,6 +147,7 @@ void PatternRegistry::initializeCorePatterns() {
     seriesDiodeClip.name = "Series Diode Clipping";
     seriesDiodeClip.category = PatternCategory::ClippingStage;
     seriesDiodeClip.signature = {LiveSpice::ComponentType::Diode, LiveSpice::ComponentType::Resistor};
+    seriesDiodeClip.topology = {{0, 1}};
     seriesDiodeClip.dspStrategy = "diode_solver";
     seriesDiodeClip.parameters = {"DiodeType", "ClippingThreshold", "Symmetry"};
     seriesDiodeClip.description = "Soft clipping via forward-biased diode";
@@ -131,6 +158,7 @@ void PatternRegistry::initializeCorePatterns() {
     parallelDiodeClip.name = "Parallel Diode Clipping";
     parallelDiodeClip.category = PatternCategory::ClippingStage;
     parallelDiodeClip.signature = {LiveSpice::ComponentType::Diode, LiveSpice::ComponentType::Resistor};
+    parallelDiodeClip.topology = {{0, 1}};
     parallelDiodeClip.dspStrategy = "diode_solver";
     parallelDiodeClip.parameters = {"DiodeType", "LoadResistance"};
     parallelDiodeClip.description = "Current-limiting diode clipping";
@@ -142,6 +170,7 @@ void PatternRegistry::initializeCorePatterns() {
     backToBackDiode.category = PatternCategory::ClippingStage;
     backToBackDiode.signature = {LiveSpice::ComponentType::Diode, LiveSpice::ComponentType::Diode, 
                                  LiveSpice::ComponentType::Resistor};
+    backToBackDiode.topology = {{0, 1}, {0, 2}, {1, 2}};
     backToBackDiode.dspStrategy = "diode_solver";
     backToBackDiode.parameters = {"DiodeType", "SymmetricClipping"};
     backToBackDiode.description = "Symmetric clipping on positive and negative peaks";
@@ -193,6 +222,7 @@ void PatternRegistry::initializeCorePatterns() {
     integrator.name = "Integrator (Feedback Capacitor)";
     integrator.category = PatternCategory::FeedbackNetwork;
     integrator.signature = {LiveSpice::ComponentType::Resistor, LiveSpice::ComponentType::Capacitor};
+    integrator.topology = {{0, 1}};
     integrator.dspStrategy = "state_space";
     integrator.parameters = {"IntegrationConstant", "BandwidthLimit"};
     integrator.description = "Active integrator for low-frequency roll-off";
@@ -207,6 +237,7 @@ void PatternRegistry::initializeCorePatterns() {
     acCoupling.name = "AC Coupling Capacitor";
     acCoupling.category = PatternCategory::Coupling;
     acCoupling.signature = {LiveSpice::ComponentType::Capacitor, LiveSpice::ComponentType::Resistor};
+    acCoupling.topology = {{0, 1}};
     acCoupling.dspStrategy = "cascaded_biquad";
     acCoupling.parameters = {"CouplingFrequency", "InputImpedance"};
     acCoupling.description = "High-pass filter for DC blocking";
@@ -227,12 +258,244 @@ void PatternRegistry::initializeCorePatterns() {
               << " circuit patterns\n";
 }
 
+// ============================================================================
+// Pattern Index
+// ============================================================================
+
+namespace {
+
+/// Confidence weights: component types vs. topology embedding
+constexpr float COMPONENT_WEIGHT = 0.95f;
+constexpr float TOPOLOGY_WEIGHT = 0.05f;
+
+PatternRegistry::TypeHistogram buildHistogram(const std::vector<Component>& circuitComponents) {
+    PatternRegistry::TypeHistogram histogram{};
+    for (const auto& comp : circuitComponents) {
+        histogram[static_cast<size_t>(comp.type)]++;
+    }
+    return histogram;
+}
+
+/**
+ * Undirected connection graph over the caller's components, built once per
+ * match call and only when some candidate pattern has a topology.
+ */
+struct ConnectionGraph {
+    std::vector<std::vector<uint32_t>> adjacency;  ///< Sorted, unique
+
+    ConnectionGraph(const std::vector<Component>& circuitComponents,
+                    const std::vector<Connection>& connections) {
+        std::map<std::string, uint32_t> index;
+        for (uint32_t i = 0; i < circuitComponents.size(); ++i) {
+            index.emplace(circuitComponents[i].id, i);
+        }
+        adjacency.resize(circuitComponents.size());
+        for (const auto& conn : connections) {
+            auto from = index.find(conn.fromId);
+            auto to = index.find(conn.toId);
+            if (from == index.end() || to == index.end() || from->second == to->second) continue;
+            adjacency[from->second].push_back(to->second);
+            adjacency[to->second].push_back(from->second);
+        }
+        for (auto& row : adjacency) {
+            std::sort(row.begin(), row.end());
+            row.erase(std::unique(row.begin(), row.end()), row.end());
+        }
+    }
+
+    bool connected(uint32_t a, uint32_t b) const {
+        return std::binary_search(adjacency[a].begin(), adjacency[a].end(), b);
+    }
+};
+
+/**
+ * VF2-style subgraph matcher: maps each slot named in pattern.topology to a
+ * distinct component of the slot's type so that every topology edge is a
+ * connection. Slots are visited so each one touches an already-mapped slot
+ * where possible; a slot's candidates are then only the neighbours of that
+ * mapped component, filtered by type, degree and adjacency to every other
+ * mapped neighbour.
+ */
+class TopologyMatcher {
+public:
+    TopologyMatcher(const CircuitPattern& pattern, const std::vector<Component>& circuitComponents,
+                    const ConnectionGraph& graph)
+        : pattern(pattern), components(circuitComponents), graph(graph) {
+        const int slotCount = static_cast<int>(pattern.signature.size());
+        slotNeighbors.resize(slotCount);
+        for (const auto& edge : pattern.topology) {
+            if (edge.first < 0 || edge.second < 0 || edge.first >= slotCount ||
+                edge.second >= slotCount || edge.first == edge.second) continue;
+            slotNeighbors[edge.first].push_back(edge.second);
+            slotNeighbors[edge.second].push_back(edge.first);
+        }
+
+        // Visit order: most constrained slot first, then always a slot with
+        // the most edges into the slots already ordered
+        std::vector<bool> ordered(slotCount, false);
+        for (int step = 0; step < slotCount; ++step) {
+            int best = -1, bestLinks = -1, bestDegree = -1;
+            for (int slot = 0; slot < slotCount; ++slot) {
+                if (ordered[slot] || slotNeighbors[slot].empty()) continue;
+                int links = 0;
+                for (int other : slotNeighbors[slot]) links += ordered[other] ? 1 : 0;
+                int degree = static_cast<int>(slotNeighbors[slot].size());
+                if (links > bestLinks || (links == bestLinks && degree > bestDegree)) {
+                    best = slot;
+                    bestLinks = links;
+                    bestDegree = degree;
+                }
+            }
+            if (best < 0) break;
+            ordered[best] = true;
+            order.push_back(best);
+        }
+
+        mapping.assign(slotCount, -1);
+        used.assign(components.size(), false);
+    }
+
+    /** True when an embedding exists; mapping() then holds it (-1 = unused slot) */
+    bool match() { return !order.empty() && extend(0); }
+    const std::vector<int>& getMapping() const { return mapping; }
+
+private:
+    const CircuitPattern& pattern;
+    const std::vector<Component>& components;
+    const ConnectionGraph& graph;
+    std::vector<std::vector<int>> slotNeighbors;
+    std::vector<int> order;
+    std::vector<int> mapping;
+    std::vector<bool> used;
+
+    bool feasible(int slot, uint32_t comp) const {
+        if (used[comp] || components[comp].type != pattern.signature[slot]) return false;
+        if (graph.adjacency[comp].size() < slotNeighbors[slot].size()) return false;
+        for (int other : slotNeighbors[slot]) {
+            if (mapping[other] >= 0 && !graph.connected(comp, static_cast<uint32_t>(mapping[other]))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool tryAssign(size_t depth, int slot, uint32_t comp) {
+        if (!feasible(slot, comp)) return false;
+        mapping[slot] = static_cast<int>(comp);
+        used[comp] = true;
+        if (extend(depth + 1)) return true;
+        mapping[slot] = -1;
+        used[comp] = false;
+        return false;
+    }
+
+    bool extend(size_t depth) {
+        if (depth == order.size()) return true;
+        const int slot = order[depth];
+
+        // Candidates come from a mapped neighbour's adjacency when there is one
+        for (int other : slotNeighbors[slot]) {
+            if (mapping[other] < 0) continue;
+            for (uint32_t comp : graph.adjacency[mapping[other]]) {
+                if (tryAssign(depth, slot, comp)) return true;
+            }
+            return false;
+        }
+        for (uint32_t comp = 0; comp < components.size(); ++comp) {
+            if (tryAssign(depth, slot, comp)) return true;
+        }
+        return false;
+    }
+};
+
+/** Restrict a match to the embedded components and the edges between them */
+void applyEmbedding(PatternMatch& match, const std::vector<int>& mapping,
+                    const std::vector<Component>& circuitComponents,
+                    const std::vector<Connection>& connections) {
+    std::vector<bool> embedded(circuitComponents.size(), false);
+    match.matchedComponents.clear();
+    for (int comp : mapping) {
+        if (comp < 0) continue;
+        embedded[comp] = true;
+        match.matchedComponents.push_back(circuitComponents[comp]);
+    }
+    std::map<std::string, uint32_t> index;
+    for (uint32_t i = 0; i < circuitComponents.size(); ++i) {
+        if (embedded[i]) index.emplace(circuitComponents[i].id, i);
+    }
+    match.matchedConnections.clear();
+    for (const auto& conn : connections) {
+        if (index.count(conn.fromId) && index.count(conn.toId)) {
+            match.matchedConnections.push_back(conn);
+        }
+    }
+}
+
+}  // namespace
+
+void PatternRegistry::addPattern(const CircuitPattern& pattern) {
+    patterns.push_back(pattern);
+    indexPattern(static_cast<uint32_t>(patterns.size() - 1));
+}
+
+void PatternRegistry::indexPattern(uint32_t patternIndex) {
+    const CircuitPattern& pattern = patterns[patternIndex];
+    SignatureIndex signature;
+    for (const auto& type : pattern.signature) {
+        signature.required[static_cast<size_t>(type)]++;
+    }
+    signature.requiredTotal = static_cast<int>(pattern.signature.size());
+    signatures.push_back(signature);
+
+    for (size_t type = 0; type < TypeCount; ++type) {
+        if (signature.required[type] > 0) patternsByType[type].push_back(patternIndex);
+    }
+
+    // With none of its types present a pattern scores 0 (its topology cannot
+    // embed either), so only a non-positive threshold can still accept it
+    if (pattern.confidence_threshold <= 0.0f) {
+        typelessCandidates.push_back(patternIndex);
+    }
+
+    const uint64_t nameSize = pattern.name.size();
+    version = fnv1a(version, &nameSize, sizeof(nameSize));
+    version = fnv1a(version, pattern.name.data(), pattern.name.size());
+    version = fnv1a(version, &pattern.category, sizeof(pattern.category));
+    for (const auto& type : pattern.signature) version = fnv1a(version, &type, sizeof(type));
+    for (const auto& edge : pattern.topology) {
+        version = fnv1a(version, &edge.first, sizeof(edge.first));
+        version = fnv1a(version, &edge.second, sizeof(edge.second));
+    }
+    version = fnv1a(version, &pattern.confidence_threshold, sizeof(pattern.confidence_threshold));
+}
+
+std::vector<uint32_t> PatternRegistry::candidatePatterns(const TypeHistogram& histogram) const {
+    std::vector<bool> seen(patterns.size(), false);
+    std::vector<uint32_t> candidates;
+    auto consider = [&](uint32_t index) {
+        if (seen[index]) return;
+        seen[index] = true;
+        const float topologyMax = patterns[index].topology.empty() ? 0.0f : TOPOLOGY_WEIGHT;
+        if (calculatePatternConfidence(histogram, signatures[index]) + topologyMax >=
+            patterns[index].confidence_threshold) {
+            candidates.push_back(index);
+        }
+    };
+    for (uint32_t index : typelessCandidates) consider(index);
+    for (size_t type = 0; type < TypeCount; ++type) {
+        if (histogram[type] == 0) continue;
+        for (uint32_t index : patternsByType[type]) consider(index);
+    }
+    std::sort(candidates.begin(), candidates.end());
+    return candidates;
+}
+
 // ============================================================================
 // Pattern Matching Algorithm
 // ============================================================================
 
 PatternMatch PatternRegistry::matchPattern(const std::vector<Component>& circuitComponents,
-                                          const std::vector<Connection>& connections) {
+                                          const std::vector<Connection>& connections) const {
     PatternMatch bestMatch;
     bestMatch.confidence = 0.0f;
     bestMatch.pattern = nullptr;
@@ -241,30 +504,67 @@ PatternMatch PatternRegistry::matchPattern(const std::vector<Component>& circuit
         return bestMatch;
     }
     
-    // Try to match each pattern in the registry
-    for (auto& pattern : patterns) {
-        float confidence = calculatePatternConfidence(circuitComponents, connections, pattern);
+    const TypeHistogram histogram = buildHistogram(circuitComponents);
+    std::optional<ConnectionGraph> graph;
+    std::vector<int> bestMapping;
+    
+    // Candidates are in registry order, so ties keep the earlier pattern
+    for (uint32_t index : candidatePatterns(histogram)) {
+        const CircuitPattern& pattern = patterns[index];
+        float confidence = calculatePatternConfidence(histogram, signatures[index]);
+        const bool hasTopology = !pattern.topology.empty() && !connections.empty();
+        
+        // Skip the matcher when even a full embedding could not win
+        std::vector<int> mapping;
+        if (hasTopology && confidence + TOPOLOGY_WEIGHT > bestMatch.confidence) {
+            if (!graph) graph.emplace(circuitComponents, connections);
+            TopologyMatcher matcher(pattern, circuitComponents, *graph);
+            if (matcher.match()) {
+                confidence += TOPOLOGY_WEIGHT;
+                mapping = matcher.getMapping();
+            }
+        }
         
         if (confidence > bestMatch.confidence && 
             confidence >= pattern.confidence_threshold) {
             bestMatch.confidence = confidence;
             bestMatch.pattern = &pattern;
-            bestMatch.matchedComponents = circuitComponents;
-            bestMatch.matchedConnections = connections;
+            bestMapping = std::move(mapping);
         }
     }
     
+    if (bestMatch.pattern) {
+        bestMatch.matchedComponents = circuitComponents;
+        bestMatch.matchedConnections = connections;
+        if (!bestMapping.empty()) {
+            applyEmbedding(bestMatch, bestMapping, circuitComponents, connections);
+        }
+    }
     return bestMatch;
 }
 
 std::vector<PatternMatch> PatternRegistry::findAllPatterns(
     const std::vector<Component>& circuitComponents,
-    const std::vector<Connection>& connections) {
+    const std::vector<Connection>& connections) const {
     
     std::vector<PatternMatch> matches;
     
-    for (auto& pattern : patterns) {
-        float confidence = calculatePatternConfidence(circuitComponents, connections, pattern);
+    const TypeHistogram histogram = buildHistogram(circuitComponents);
+    std::optional<ConnectionGraph> graph;
+    
+    for (uint32_t index : candidatePatterns(histogram)) {
+        const CircuitPattern& pattern = patterns[index];
+        float confidence = calculatePatternConfidence(histogram, signatures[index]);
+        
+        std::vector<int> mapping;
+        if (!pattern.topology.empty() && !connections.empty()) {
+            if (!graph) graph.emplace(circuitComponents, connections);
+            TopologyMatcher matcher(pattern, circuitComponents, *graph);
+            if (matcher.match()) {
+                confidence += TOPOLOGY_WEIGHT;
+                mapping = matcher.getMapping();
+            }
+        }
         
         if (confidence >= pattern.confidence_threshold) {
             PatternMatch match;
@@ -272,6 +572,9 @@ std::vector<PatternMatch> PatternRegistry::findAllPatterns(
             match.pattern = &pattern;
             match.matchedComponents = circuitComponents;
             match.matchedConnections = connections;
+            if (!mapping.empty()) {
+                applyEmbedding(match, mapping, circuitComponents, connections);
+            }
             matches.push_back(match);
         }
     }
@@ -286,44 +589,25 @@ std::vector<PatternMatch> PatternRegistry::findAllPatterns(
 }
 
 float PatternRegistry::calculatePatternConfidence(
-    const std::vector<Component>& circuitComponents,
-    const std::vector<Connection>& connections,
-    const CircuitPattern& pattern) {
+    const TypeHistogram& histogram,
+    const SignatureIndex& signature) const {
     
-    if (pattern.signature.empty()) {
+    if (signature.requiredTotal == 0) {
         return 0.0f;
     }
     
     // Count component type matches
-    std::map<LiveSpice::ComponentType, int> requiredCounts;
-    for (const auto& type : pattern.signature) {
-        requiredCounts[type]++;
-    }
-    
-    std::map<LiveSpice::ComponentType, int> actualCounts;
-    for (const auto& comp : circuitComponents) {
-        actualCounts[comp.type]++;
-    }
-    
-    // Calculate match percentage
     int totalMatches = 0;
-    int totalRequired = pattern.signature.size();
-    
-    for (const auto& [type, count] : requiredCounts) {
-        if (actualCounts.count(type)) {
-            totalMatches += std::min(count, actualCounts[type]);
-        }
+    for (size_t type = 0; type < TypeCount; ++type) {
+        totalMatches += std::min(signature.required[type], histogram[type]);
     }
     
-    float componentConfidence = static_cast<float>(totalMatches) / totalRequired;
-    
-    // Bonus for connectivity analysis (future enhancement)
-    // For now, return basic component-count-based confidence
-    return componentConfidence * 0.95f;  // 95% weight on component matching
+    float componentConfidence = static_cast<float>(totalMatches) / signature.requiredTotal;
+    return componentConfidence * COMPONENT_WEIGHT;
 }
 
-CircuitPattern* PatternRegistry::getPattern(const std::string& name) {
-    for (auto& pattern : patterns) {
+const CircuitPattern* PatternRegistry::getPattern(const std::string& name) const {
+    for (const auto& pattern : patterns) {
         if (pattern.name == name) {
             return &pattern;
         }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "LiveSpiceParser.h"
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -45,6 +47,11 @@ struct CircuitPattern {
     // Component Signature - the "fingerprint" of this pattern
     std::vector<LiveSpice::ComponentType> signature;
     
+    // Optional topology over signature slots: each pair of slot indices must
+    // be connected. An embedding of these edges into the caller's connections
+    // earns the connectivity share of the confidence.
+    std::vector<std::pair<int, int>> topology;
+    
     // DSP Strategy Selection
     std::string dspStrategy;                   ///< Strategy for code generation
                                                ///< Options: "cascaded_biquad", "state_space", 
@@ -91,7 +98,7 @@ struct Connection {
  * PatternMatch - Result of pattern matching operation
  */
 struct PatternMatch {
-    CircuitPattern* pattern = nullptr;         ///< Matched pattern (nullptr if no match)
+    const CircuitPattern* pattern = nullptr;   ///< Matched pattern (nullptr if no match)
     float confidence = 0.0f;                   ///< Confidence score (0.0 to 1.0)
     std::vector<Component> matchedComponents;  ///< Components that matched
     std::vector<Connection> matchedConnections;///< Connections that matched
@@ -104,20 +111,40 @@ struct PatternMatch {
 
 class PatternRegistry {
 public:
+    static constexpr size_t TypeCount = static_cast<size_t>(LiveSpice::ComponentType::Unknown) + 1;
+    
+    /// Component count per type, indexed by ComponentType
+    using TypeHistogram = std::array<int, TypeCount>;
+    
+    /// Bump whenever scoring or topology matching changes what a match returns
+    static constexpr uint32_t MATCHER_REVISION = 1;
+    
     /**
      * Constructor - Initializes all built-in patterns
      */
     PatternRegistry();
     
+    /**
+     * shared - Process-wide registry, built on first use
+     * 
+     * Matching is const, so analyzers on any number of threads can use
+     * this one instance instead of each building the pattern table.
+     */
+    static const PatternRegistry& shared();
+    
     /**
      * matchPattern - Find best matching pattern for given components
      * 
+     * The circuit's type histogram is built once; only patterns sharing a
+     * type with it are scored, and the topology matcher only runs for
+     * patterns that can still beat the current best.
+     * 
      * @param circuitComponents - Vector of circuit components
      * @param connections - Vector of component connections
      * @return Best matching pattern (empty if no match above threshold)
      */
     PatternMatch matchPattern(const std::vector<Component>& circuitComponents,
-                             const std::vector<Connection>& connections);
+                             const std::vector<Connection>& connections) const;
     
     /**
      * findAllPatterns - Find all matching patterns
@@ -130,12 +157,19 @@ public:
      * @return Sorted vector of all matches
      */
     std::vector<PatternMatch> findAllPatterns(const std::vector<Component>& circuitComponents,
-                                             const std::vector<Connection>& connections);
+                                             const std::vector<Connection>& connections) const;
+    
+    /**
+     * addPattern - Register a custom pattern (indexed immediately)
+     * 
+     * Invalidates CircuitPattern pointers from earlier matches.
+     */
+    void addPattern(const CircuitPattern& pattern);
     
     /**
      * getPattern - Retrieve pattern by name
      */
-    CircuitPattern* getPattern(const std::string& name);
+    const CircuitPattern* getPattern(const std::string& name) const;
     
     /**
      * getPatternCount - Get total number of registered patterns
@@ -147,14 +181,36 @@ public:
      */
     const std::vector<CircuitPattern>& listPatterns() const { return patterns; }
     
+    /**
+     * getVersion - Fingerprint of the matcher revision and every registered
+     * pattern's matching inputs (name, category, signature, topology,
+     * threshold), in registry order. Cached match results are only valid
+     * for the version they were computed under.
+     */
+    uint64_t getVersion() const { return version; }
+    
 private:
+    /// Precomputed per-pattern signature, parallel to patterns
+    struct SignatureIndex {
+        TypeHistogram required{};
+        int requiredTotal = 0;
+    };
+    
     std::vector<CircuitPattern> patterns;
+    std::vector<SignatureIndex> signatures;
+    std::array<std::vector<uint32_t>, TypeCount> patternsByType;  ///< Type -> patterns requiring it
+    std::vector<uint32_t> typelessCandidates;                     ///< Patterns that pass with no type matched
+    uint64_t version = 0;
     
     void initializeCorePatterns();
+    void indexPattern(uint32_t patternIndex);
+    
+    /// Patterns that can reach their threshold for this histogram, in registry order
+    std::vector<uint32_t> candidatePatterns(const TypeHistogram& histogram) const;
     
-    float calculatePatternConfidence(const std::vector<Component>& circuitComponents,
-                                    const std::vector<Connection>& connections,
-                                    const CircuitPattern& pattern);
+    /// Type-count share of the confidence (0.95 for a full signature)
+    float calculatePatternConfidence(const TypeHistogram& histogram,
+                                    const SignatureIndex& signature) const;
 };
 
 // ============================================================================
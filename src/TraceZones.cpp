@@ -0,0 +1,196 @@
+#include "TraceZones.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+namespace LiveSpiceDSP {
+
+namespace {
+
+// A counter sample has end == 0 (zone ends are never 0)
+struct TraceEvent {
+    const char* name;
+    uint64_t start;
+    uint64_t end;
+    double value;
+};
+
+struct ThreadBuffer {
+    std::unique_ptr<TraceEvent[]> events;
+    size_t capacity = 0;
+    std::atomic<size_t> count{0};
+    std::atomic<const char*> threadName{nullptr};
+};
+
+struct TraceState {
+    std::mutex mutex;                        // start/stop/export
+    std::unique_ptr<ThreadBuffer[]> buffers; // Allocated once, never freed
+    size_t numBuffers = 0;
+    std::atomic<size_t> claimed{0};
+    std::atomic<size_t> dropped{0};
+
+    // Tick rate calibration over the session
+    uint64_t startTicks = 0, stopTicks = 0;
+    std::chrono::steady_clock::time_point startTime, stopTime;
+};
+
+// Leaked: threads may still record while static destructors run
+TraceState& state() {
+    static TraceState* s = new TraceState();
+    return *s;
+}
+
+// The calling thread's buffer (nullptr once every buffer is taken)
+ThreadBuffer* threadBuffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    thread_local bool claimed = false;
+    if (!claimed) {
+        TraceState& s = state();
+        const size_t index = s.claimed.fetch_add(1, std::memory_order_relaxed);
+        buffer = index < s.numBuffers ? &s.buffers[index] : nullptr;
+        claimed = true;
+    }
+    return buffer;
+}
+
+void append(const TraceEvent& event) {
+    TraceState& s = state();
+    ThreadBuffer* buffer = threadBuffer();
+    const size_t n = buffer ? buffer->count.load(std::memory_order_relaxed) : 0;
+    if (!buffer || n >= buffer->capacity) {
+        s.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    buffer->events[n] = event;
+    buffer->count.store(n + 1, std::memory_order_release);
+}
+
+std::string quote(const char* text) {
+    std::string quoted = "\"";
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') quoted += '\\';
+        if (static_cast<unsigned char>(*c) >= 0x20) quoted += *c;
+    }
+    return quoted + "\"";
+}
+
+std::string microseconds(double value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.3f", value);
+    return text;
+}
+
+}  // namespace
+
+// ============================================================================
+// TraceSession Implementation
+// ============================================================================
+
+void TraceSession::start(size_t maxThreads, size_t eventsPerThread) {
+    TraceState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    recording().store(false, std::memory_order_relaxed);
+
+    if (!s.buffers) {
+        s.numBuffers = std::max<size_t>(maxThreads, 1);
+        s.buffers.reset(new ThreadBuffer[s.numBuffers]);
+        for (size_t i = 0; i < s.numBuffers; ++i) {
+            s.buffers[i].events.reset(new TraceEvent[std::max<size_t>(eventsPerThread, 1)]);
+            s.buffers[i].capacity = std::max<size_t>(eventsPerThread, 1);
+        }
+    }
+    for (size_t i = 0; i < s.numBuffers; ++i) s.buffers[i].count.store(0, std::memory_order_relaxed);
+    s.dropped.store(0, std::memory_order_relaxed);
+
+    s.startTime = std::chrono::steady_clock::now();
+    s.startTicks = TraceClock::now();
+    s.stopTicks = 0;
+    recording().store(true, std::memory_order_release);
+}
+
+void TraceSession::stop() {
+    TraceState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+    if (!recording().exchange(false, std::memory_order_acq_rel)) return;
+    s.stopTime = std::chrono::steady_clock::now();
+    s.stopTicks = TraceClock::now();
+}
+
+void TraceSession::nameThread(const char* name) {
+    if (!recording().load(std::memory_order_acquire)) return;
+    if (ThreadBuffer* buffer = threadBuffer()) buffer->threadName.store(name, std::memory_order_release);
+}
+
+void TraceSession::zone(const char* name, uint64_t startTicks, uint64_t endTicks) {
+    if (!recording().load(std::memory_order_acquire)) return;
+    append({name, startTicks, endTicks > 0 ? endTicks : 1, 0.0});
+}
+
+void TraceSession::counter(const char* name, double value) {
+    if (!recording().load(std::memory_order_acquire)) return;
+    append({name, TraceClock::now(), 0, value});
+}
+
+size_t TraceSession::getDroppedEvents() {
+    return state().dropped.load(std::memory_order_relaxed);
+}
+
+std::string TraceSession::toChromeTrace() {
+    TraceState& s = state();
+    std::lock_guard<std::mutex> lock(s.mutex);
+
+    // Ticks to microseconds from the session's span (the live span while recording)
+    const bool live = recording().load(std::memory_order_acquire);
+    const uint64_t stopTicks = live ? TraceClock::now() : s.stopTicks;
+    const auto stopTime = live ? std::chrono::steady_clock::now() : s.stopTime;
+    const double spanUs = std::chrono::duration<double, std::micro>(stopTime - s.startTime).count();
+    const double usPerTick = stopTicks > s.startTicks ? spanUs / static_cast<double>(stopTicks - s.startTicks) : 0.0;
+    auto toUs = [&](uint64_t ticks) {
+        return ticks > s.startTicks ? static_cast<double>(ticks - s.startTicks) * usPerTick : 0.0;
+    };
+
+    std::ostringstream out;
+    out << "{\"displayTimeUnit\": \"ns\", \"otherData\": {\"droppedEvents\": "
+        << s.dropped.load(std::memory_order_relaxed) << "}, \"traceEvents\": [";
+    bool first = true;
+    auto separator = [&first]() {
+        const char* text = first ? "\n" : ",\n";
+        first = false;
+        return text;
+    };
+
+    for (size_t t = 0; t < s.numBuffers; ++t) {
+        const ThreadBuffer& buffer = s.buffers[t];
+        const size_t count = buffer.count.load(std::memory_order_acquire);
+        const size_t tid = t + 1;
+
+        if (const char* name = buffer.threadName.load(std::memory_order_acquire)) {
+            out << separator() << "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << tid
+                << ", \"args\": {\"name\": " << quote(name) << "}}";
+        }
+        for (size_t i = 0; i < count; ++i) {
+            const TraceEvent& e = buffer.events[i];
+            out << separator() << "  {\"name\": " << quote(e.name) << ", \"pid\": 1, \"tid\": " << tid
+                << ", \"ts\": " << microseconds(toUs(e.start));
+            if (e.end == 0) {
+                out << ", \"ph\": \"C\", \"args\": {\"value\": " << e.value << "}}";
+            } else {
+                out << ", \"ph\": \"X\", \"dur\": " << microseconds(toUs(e.end) - toUs(e.start)) << "}";
+            }
+        }
+    }
+    out << "\n]}\n";
+    return out.str();
+}
+
+bool TraceSession::write(const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) return false;
+    file << toChromeTrace();
+    return static_cast<bool>(file);
+}
+
+}  // namespace LiveSpiceDSP
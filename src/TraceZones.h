@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+// Instrumentation is compiled out unless LIVESPICE_TRACE is 1 (CMake option
+// LIVESPICE_TRACE); the macros then expand to nothing, arguments and all
+#ifndef LIVESPICE_TRACE
+#define LIVESPICE_TRACE 0
+#endif
+
+#define LIVESPICE_TRACE_CONCAT_(a, b) a##b
+#define LIVESPICE_TRACE_CONCAT(a, b) LIVESPICE_TRACE_CONCAT_(a, b)
+
+#if LIVESPICE_TRACE
+// Time the enclosing scope: LIVESPICE_TRACE_ZONE("Tone stack");
+#define LIVESPICE_TRACE_ZONE(name) \
+    const ::LiveSpiceDSP::TraceZone LIVESPICE_TRACE_CONCAT(liveSpiceTraceZone, __LINE__)(name)
+// Sample a value: LIVESPICE_TRACE_COUNTER("Oversampling factor", factor);
+#define LIVESPICE_TRACE_COUNTER(name, value) ::LiveSpiceDSP::TraceSession::counter(name, static_cast<double>(value))
+// Label the calling thread in the trace: LIVESPICE_TRACE_THREAD("Audio");
+#define LIVESPICE_TRACE_THREAD(name) ::LiveSpiceDSP::TraceSession::nameThread(name)
+#else
+#define LIVESPICE_TRACE_ZONE(name) ((void) 0)
+#define LIVESPICE_TRACE_COUNTER(name, value) ((void) 0)
+#define LIVESPICE_TRACE_THREAD(name) ((void) 0)
+#endif
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file TraceZones.h
+ * @brief Instrumentation zones and counters, exported as a Chrome trace
+ *
+ * One capture covers every thread that runs instrumented code: translator
+ * phases, MultiStagePedal stages, StageGraph nodes and the per-stage loops
+ * of generated plugins. While no session is recording, a zone costs one
+ * relaxed load.
+ *
+ * TraceSession::start() preallocates one event buffer per thread. A thread
+ * takes a buffer with an atomic increment on its first event, so recording
+ * never locks or allocates and is safe on the audio thread. A full buffer
+ * drops further events and counts them. Names must outlive the session
+ * (string literals); only the pointer is stored.
+ *
+ * Timestamps are TSC ticks on x86, converted with the rate measured against
+ * steady_clock over the session, and steady_clock nanoseconds elsewhere.
+ * write() produces trace event JSON for chrome://tracing and ui.perfetto.dev.
+ */
+
+struct TraceClock {
+    static uint64_t now() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+};
+
+class TraceSession {
+public:
+    static constexpr size_t DEFAULT_MAX_THREADS = 16;
+    static constexpr size_t DEFAULT_EVENTS_PER_THREAD = 1 << 16;   // 2 MiB per thread
+
+    /**
+     * Clear the buffers and begin recording. The first call allocates them;
+     * later calls reuse those sizes. Not real-time safe; call while the
+     * instrumented threads are idle.
+     */
+    static void start(size_t maxThreads = DEFAULT_MAX_THREADS, size_t eventsPerThread = DEFAULT_EVENTS_PER_THREAD);
+
+    /** Stop recording; events stay until the next start() */
+    static void stop();
+
+    static bool isRecording() { return recording().load(std::memory_order_relaxed); }
+
+    /** Label the calling thread (string literal). Real-time safe. */
+    static void nameThread(const char* name);
+
+    /** Record a zone from TraceClock ticks. Real-time safe. */
+    static void zone(const char* name, uint64_t startTicks, uint64_t endTicks);
+
+    /** Record a counter sample now. Real-time safe. */
+    static void counter(const char* name, double value);
+
+    /** Events lost to full buffers, or to threads beyond maxThreads */
+    static size_t getDroppedEvents();
+
+    /** Recorded events in Chrome trace event format */
+    static std::string toChromeTrace();
+
+    /** Write toChromeTrace(); false when the file cannot be written */
+    static bool write(const std::string& path);
+
+private:
+    static std::atomic<bool>& recording() {
+        static std::atomic<bool> flag{false};
+        return flag;
+    }
+};
+
+/**
+ * RAII zone; use LIVESPICE_TRACE_ZONE so builds without tracing drop it
+ */
+class TraceZone {
+public:
+    explicit TraceZone(const char* name)
+        : m_name(name), m_start(TraceSession::isRecording() ? TraceClock::now() : 0) {}
+
+    ~TraceZone() {
+        if (m_start != 0) TraceSession::zone(m_name, m_start, TraceClock::now());
+    }
+
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+private:
+    const char* m_name;
+    uint64_t m_start;
+};
+
+}  // namespace LiveSpiceDSP
@@ -1,35 +1,150 @@
 #include "TransistorModels.h"
+#include "DeviceTables.h"
+#include "DiodeModels.h"
 #include <cmath>
 #include <algorithm>
 #include <iostream>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <tuple>
 
 namespace Nonlinear {
 
+BJTCurrentLUT::BJTCurrentLUT(const BJTCharacteristics& bjt)
+    : m_table(findStockBJTTable(bjt)) {
+    if (!m_table) {
+        m_ownedTable = std::make_unique<CurrentTable>(makeBJTCurrentTable(bjt));
+        m_table = m_ownedTable.get();
+    }
+}
+
+void BJTAmplifierStage::setUseCurrentTable(bool enabled) {
+    if (enabled && !m_currentTable) {
+        m_currentTable = std::make_shared<const BJTCurrentLUT>(m_param);
+    }
+    m_useCurrentTable = enabled;
+}
+
 /**
- * BJTAmplifierStage::shockleyBJT - Ebers-Moll base-emitter equation
+ * BJTOperatingSurface cache
  * 
- * Ic = beta * Ib = Is * (exp(Vbe / (n * Vt)) - 1)
- * 
- * With Early voltage correction:
- * Ic = Ic0 * (1 + Vce / Vaf)
+ * Keyed on the bit patterns of every parameter the surface depends on,
+ * mirroring the DiodeLUT cache. Expired entries are pruned on each build.
  */
-float BJTAmplifierStage::shockleyBJT(float vbe) {
-    // Thermal voltage
-    float nVt = m_param.nBE * m_param.Vt;
+namespace {
+    using SurfaceKey = std::tuple<uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, int>;
+    
+    uint32_t floatBits(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+    
+    std::mutex& surfaceCacheMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+    
+    std::map<SurfaceKey, std::weak_ptr<const BJTOperatingSurface>>& surfaceCache() {
+        static std::map<SurfaceKey, std::weak_ptr<const BJTOperatingSurface>> cache;
+        return cache;
+    }
+    
+    // Catmull-Rom weights for fractional position t in [0, 1)
+    void catmullRom(float t, float w[4]) {
+        float t2 = t * t, t3 = t2 * t;
+        w[0] = 0.5f * (-t3 + 2.0f * t2 - t);
+        w[1] = 0.5f * (3.0f * t3 - 5.0f * t2 + 2.0f);
+        w[2] = 0.5f * (-3.0f * t3 + 4.0f * t2 + t);
+        w[3] = 0.5f * (t3 - t2);
+    }
+}
+
+BJTOperatingSurface::BJTOperatingSurface(const BJTCharacteristics& bjt, float vceMax, Interpolation interpolation)
+    : m_interpolation(interpolation),
+      m_vceMax(std::max(vceMax, 0.1f)),
+      m_vbeScale((VBE_POINTS - 1) / (VBE_MAX - VBE_MIN)),
+      m_vceScale((VCE_POINTS - 1) / m_vceMax),
+      m_invBf(1.0f / bjt.Bf),
+      m_invNVt(1.0f / (bjt.nBE * bjt.Vt)),
+      m_ic(size_t(VBE_POINTS) * VCE_POINTS) {
+    
+    // Same equation as BJTAmplifierStage::shockleyBJT, in double
+    const double nVt = double(bjt.nBE) * bjt.Vt;
+    for (int j = 0; j < VCE_POINTS; ++j) {
+        double vce = double(j) / m_vceScale;
+        double early = 1.0 + vce / bjt.Vat;
+        for (int i = 0; i < VBE_POINTS; ++i) {
+            double vbe = VBE_MIN + double(i) / m_vbeScale;
+            double expArg = std::clamp(vbe / nVt, -50.0, 50.0);
+            m_ic[size_t(j) * VBE_POINTS + i] = float(bjt.Bf * bjt.Is * (std::exp(expArg) - 1.0) * early);
+        }
+    }
+}
+
+std::shared_ptr<const BJTOperatingSurface> BJTOperatingSurface::acquire(const BJTCharacteristics& bjt, float vceMax,
+                                                                         Interpolation interpolation) {
+    const SurfaceKey key{floatBits(bjt.Is), floatBits(bjt.Vt), floatBits(bjt.nBE), floatBits(bjt.Bf),
+                         floatBits(bjt.Vat), floatBits(vceMax), static_cast<int>(interpolation)};
     
-    // Clamp exponent to prevent overflow
-    float expArg = std::clamp(vbe / nVt, -50.0f, 50.0f);
+    std::lock_guard<std::mutex> lock(surfaceCacheMutex());
+    auto& cache = surfaceCache();
     
-    // Base-emitter saturation current effect
-    float ibe = m_param.Is * (std::exp(expArg) - 1.0f);
+    if (auto it = cache.find(key); it != cache.end()) {
+        if (auto surface = it->second.lock()) {
+            return surface;
+        }
+    }
     
-    // Collector current with forward gain
-    float ic = m_param.Bf * ibe;
+    for (auto it = cache.begin(); it != cache.end();) {
+        it = it->second.expired() ? cache.erase(it) : std::next(it);
+    }
     
-    // Early voltage effect (output impedance)
-    float ic_with_early = ic * (1.0f + m_biasPoint.Vce / m_param.Vat);
+    auto surface = std::make_shared<const BJTOperatingSurface>(bjt, vceMax, interpolation);
+    cache[key] = surface;
+    return surface;
+}
+
+size_t BJTOperatingSurface::cachedSurfaceCount() {
+    std::lock_guard<std::mutex> lock(surfaceCacheMutex());
+    size_t count = 0;
+    for (const auto& entry : surfaceCache()) {
+        count += entry.second.expired() ? 0 : 1;
+    }
+    return count;
+}
+
+float BJTOperatingSurface::evaluateCurrent(float vbe, float vce) const {
+    float x = (std::clamp(vbe, VBE_MIN, VBE_MAX) - VBE_MIN) * m_vbeScale;
+    float y = std::clamp(vce, 0.0f, m_vceMax) * m_vceScale;
+    int i = std::min(int(x), VBE_POINTS - 2);
+    int j = std::min(int(y), VCE_POINTS - 2);
+    float tx = x - i, ty = y - j;
+    
+    if (m_interpolation == Interpolation::Bilinear) {
+        float lo = at(j, i) + tx * (at(j, i + 1) - at(j, i));
+        float hi = at(j + 1, i) + tx * (at(j + 1, i + 1) - at(j + 1, i));
+        return lo + ty * (hi - lo);
+    }
     
-    return ic_with_early;
+    float wx[4], wy[4];
+    catmullRom(tx, wx);
+    catmullRom(ty, wy);
+    float result = 0.0f;
+    for (int b = 0; b < 4; ++b) {
+        int row = std::clamp(j - 1 + b, 0, VCE_POINTS - 1);
+        float sum = 0.0f;
+        for (int a = 0; a < 4; ++a) {
+            sum += wx[a] * at(row, std::clamp(i - 1 + a, 0, VBE_POINTS - 1));
+        }
+        result += wy[b] * sum;
+    }
+    return result;
+}
+
+void BJTAmplifierStage::setUseOperatingSurface(bool enabled, BJTOperatingSurface::Interpolation interpolation) {
+    m_surface = enabled ? BJTOperatingSurface::acquire(m_param, m_Vcc, interpolation) : nullptr;
 }
 
 /**
@@ -45,6 +160,17 @@ float BJTAmplifierStage::processVbe(float vbeInput, float vceOutput) {
     m_biasPoint.Vbe = vbeInput;
     m_biasPoint.Vce = vceOutput;
     
+    if (m_surface) {
+        // Tabulated path: one lookup plus reciprocal multiplies
+        float ic = m_surface->evaluateCurrent(vbeInput, vceOutput);
+        m_biasPoint.Ic = ic;
+        m_biasPoint.Ib = ic * m_surface->getInvBf();
+        m_biasPoint.gm = ic * m_surface->getInvNVt();
+        m_biasPoint.rce = m_param.Vat / (ic + 1e-12f);
+        m_biasPoint.isSaturated = vceOutput < 0.2f;
+        return ic;
+    }
+    
     // Calculate collector current
     m_biasPoint.Ic = shockleyBJT(vbeInput);
     
@@ -59,17 +185,68 @@ float BJTAmplifierStage::processVbe(float vbeInput, float vceOutput) {
     m_biasPoint.rce = m_param.Vat / (m_biasPoint.Ic + 1e-12f);
     
     // Determine operating mode
-    if (vceOutput < 0.2f) {
-        m_biasPoint.mode = BiasMode::Saturation;
-    } else if (vbeInput < 0.5f) {
-        m_biasPoint.mode = BiasMode::Cutoff;
-    } else {
-        m_biasPoint.mode = BiasMode::Active;
-    }
+    m_biasPoint.isSaturated = vceOutput < 0.2f;
     
     return m_biasPoint.Ic;
 }
 
+/**
+ * BJTAmplifierStage::solveOperatingPoint
+ * 
+ * Collector output falls monotonically with input between cut-off (top
+ * rail) and saturation, so the mid-swing input is found by bisection on a
+ * plain copy of the stage (tables off, so every user shares one answer).
+ * Results are kept for the life of the process: a few floats per part.
+ */
+namespace {
+    using OperatingPointKey = std::tuple<uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t, uint32_t>;
+    
+    std::mutex& operatingPointMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+    
+    std::map<OperatingPointKey, BJTAmplifierStage::OperatingPoint>& operatingPointCache() {
+        static std::map<OperatingPointKey, BJTAmplifierStage::OperatingPoint> cache;
+        return cache;
+    }
+}
+
+const BJTAmplifierStage::OperatingPoint& BJTAmplifierStage::solveOperatingPoint() {
+    const OperatingPointKey key{floatBits(m_param.Is), floatBits(m_param.Vt), floatBits(m_param.nBE),
+                                floatBits(m_param.Bf), floatBits(m_param.Vat), floatBits(m_Rc),
+                                floatBits(m_Rload), floatBits(m_Vcc)};
+    {
+        std::lock_guard<std::mutex> lock(operatingPointMutex());
+        auto& cache = operatingPointCache();
+        auto it = cache.find(key);
+        if (it == cache.end()) {
+            // processInputVoltage() clamps the base to -0.5..1 V, i.e. input -1..2 V
+            BJTAmplifierStage probe(m_param, m_Rc, m_Rload, m_Vcc);
+            OperatingPoint op;
+            op.outputVoltage = 0.5f * probe.processInputVoltage(-1.0f);
+            float lo = -1.0f, hi = 2.0f;
+            for (int i = 0; i < 48; ++i) {
+                float mid = 0.5f * (lo + hi);
+                if (probe.processInputVoltage(mid) > op.outputVoltage) lo = mid;
+                else hi = mid;
+            }
+            op.inputVoltage = 0.5f * (lo + hi);
+            probe.processInputVoltage(op.inputVoltage);
+            op.device = probe.getCurrentBiasPoint();
+            it = cache.emplace(key, op).first;
+        }
+        m_operatingPoint = it->second;
+    }
+    reset();
+    return m_operatingPoint;
+}
+
+size_t BJTAmplifierStage::cachedOperatingPointCount() {
+    std::lock_guard<std::mutex> lock(operatingPointMutex());
+    return operatingPointCache().size();
+}
+
 /**
  * BJTAmplifierStage::processInputVoltage
  * 
@@ -108,38 +285,8 @@ float BJTAmplifierStage::processInputVoltage(float vinput) {
  * For saturation: Id = Kp/2 * (Vgs - Vto)^2
  * For triode: Id = Kp * ((Vgs - Vto) * Vds - Vds^2/2)
  */
-float FETOverdriveStage::shockleyFET(float vgs, float vds) {
-    // Clamp inputs
-    vgs = std::clamp(vgs, -5.0f, 5.0f);
-    vds = std::clamp(vds, 0.0f, 10.0f);
-    
-    // Check if in saturation region
-    bool inSaturation = std::abs(vds) >= std::abs(vgs - m_param.Vto);
-    
-    float id;
-    
-    if (inSaturation) {
-        // Saturation region: square-law behavior
-        float overdrive = vgs - m_param.Vto;
-        
-        if (overdrive <= 0) {
-            id = 0.0f; // Off state
-        } else {
-            // Id = Kp/2 * (Vgs - Vto)^2 * (1 + Lambda*Vds)
-            id = m_param.Kp * overdrive * overdrive * 0.5f * (1.0f + m_param.Lambda * vds);
-        }
-    } else {
-        // Triode region: linear behavior
-        float overdrive = vgs - m_param.Vto;
-        if (overdrive <= 0) {
-            id = 0.0f;
-        } else {
-            // Id = Kp * ((Vgs - Vto) * Vds - Vds^2/2)
-            id = m_param.Kp * (overdrive * vds - vds * vds * 0.5f);
-        }
-    }
-    
-    return std::max(id, 0.0f); // Prevent negative current
+float FETOverdriveStage::shockleyFET(float vgs, float vds) const {
+    return detail::squareLawDrainCurrent(m_param, vgs, vds);
 }
 
 /**
@@ -179,26 +326,284 @@ float FETOverdriveStage::processInputVoltage(float vinput) {
     // Gate voltage from input signal
     float vgs = vinput * 0.7f; // Voltage divider / coupling
     
-    // Solve for drain voltage iteratively
-    // Vcc = Vds + Id * Rd
-    // Id = f(Vgs, Vds)
+    if (m_useTransferMap) {
+        // Pick up a map published by rebuildTransferMap(); the old one is
+        // left in m_pendingMap so the builder thread frees it
+        if (m_mapReady.load(std::memory_order_acquire)) {
+            std::swap(m_transferMap, m_pendingMap);
+            m_mapReady.store(false, std::memory_order_release);
+        }
+        return m_transferMap->evaluate(vgs);
+    }
     
-    // Initial guess
-    float vds = 5.0f;
+    return solveDrainVoltage(vgs, m_Rd);
+}
+
+/**
+ * FETOverdriveStage::solveDrainVoltage
+ * 
+ * Vcc = Vds + Id * Rd, Id = f(Vgs, Vds), by fixed-point iteration
+ */
+float FETOverdriveStage::solveDrainVoltage(float vgs, float drainResistance) const {
+    return detail::solveFETDrainVoltage(m_param, vgs, drainResistance);
+}
+
+std::shared_ptr<const FETOverdriveStage::TransferMap> FETOverdriveStage::buildTransferMap(float drainResistance) const {
+    auto map = std::make_shared<TransferMap>();
+    map->drainResistance = drainResistance;
+    map->vout.resize(TransferMap::POINTS);
+    for (int i = 0; i < TransferMap::POINTS; ++i) {
+        float vgs = TransferMap::VGS_MIN + float(i) / (TransferMap::POINTS - 1) * (TransferMap::VGS_MAX - TransferMap::VGS_MIN);
+        map->vout[i] = solveDrainVoltage(vgs, drainResistance);
+    }
+    return map;
+}
+
+void FETOverdriveStage::setUseTransferMap(bool enabled) {
+    if (enabled && (!m_transferMap || m_transferMap->drainResistance != m_Rd)) {
+        m_transferMap = buildTransferMap(m_Rd);
+    }
+    m_useTransferMap = enabled;
+}
+
+bool FETOverdriveStage::rebuildTransferMap() {
+    if (m_mapReady.load(std::memory_order_acquire)) {
+        return false;
+    }
+    m_pendingMap = buildTransferMap(m_Rd);
+    m_mapReady.store(true, std::memory_order_release);
+    return true;
+}
+
+/**
+ * Coupled hybrid circuits
+ * 
+ * Residuals are the currents into each unknown node; exponents are clamped
+ * so doubles never overflow, as in DKDiode.
+ */
+namespace {
+    double junctionExp(double v, double nVt) {
+        return std::exp(std::fmin(v / nVt, 80.0));
+    }
     
-    // Iterative Newton-Raphson to find equilibrium
-    for (int iter = 0; iter < 5; ++iter) {
-        float id = shockleyFET(vgs, vds);
-        float vds_new = 5.0f - id * m_Rd;
-        
-        if (std::abs(vds_new - vds) < 0.001f) {
-            break;
-        }
-        vds = vds_new;
+    // Antiparallel diode pair: current and conductance
+    void diodePair(double v, double Is, double nVt, double& current, double& conductance) {
+        const double a = std::exp(std::fmin(v / nVt, 80.0));
+        const double b = std::exp(std::fmin(-v / nVt, 80.0));
+        current = Is * (a - b);
+        conductance = Is * (a + b) / nVt;
     }
     
-    // Clamp to valid range
-    return std::clamp(vds, 0.0f, 5.0f);
+    double limitPairStep(double vOld, double vNew, double Is, double nVt) {
+        if (vNew >= 0.0) return limitJunctionStep(vOld, vNew, nVt, Is);
+        return -limitJunctionStep(-vOld, -vNew, nVt, Is);
+    }
+}
+
+namespace detail {
+
+void BJTFeedbackClipperCircuit::evaluate(const Vector& x, Vector& f, Matrix* J) const {
+    const double vb = x[0], vc = x[1], vo = x[2];
+    const double ebe = junctionExp(vb, nVtBE);
+    const double ebc = junctionExp(vb - vc, nVtBC);
+    const double ib = Is / Bf * (ebe - 1.0) + Is / Br * (ebc - 1.0);
+    const double ic = Is * (ebe - ebc) - Is / Br * (ebc - 1.0);
+    
+    double id, gd;
+    diodePair(vo, diodeIs, diodeNVt, id, gd);
+    const double gin = quiescent ? 0.0 : 1.0 / Rin;
+    const double gs = quiescent ? 0.0 : 1.0 / Rs;
+    const double gf = 1.0 / Rf;
+    const double iout = gs * (vc - Vcq - vo);
+    const double ifb = gf * (vc - vb);
+    
+    f[0] = gin * (vin + Vbq - vb) + ifb - ib;
+    f[1] = (Vcc - vc) / Rc - ic - ifb - iout;
+    f[2] = iout - id;
+    if (!J) return;
+    
+    // Ib and Ic partials in Vb and Vc
+    const double gbe = Is * ebe / nVtBE;
+    const double gbc = Is * ebc / nVtBC;
+    const double dIbdVb = gbe / Bf + gbc / Br;
+    const double dIbdVc = -gbc / Br;
+    const double dIcdVb = gbe - gbc * (1.0 + 1.0 / Br);
+    const double dIcdVc = gbc * (1.0 + 1.0 / Br);
+    
+    *J = {-gin - gf - dIbdVb,    gf - dIbdVc,                     0.0,
+          gf - dIcdVb,           -1.0 / Rc - dIcdVc - gf - gs,    gs,
+          0.0,                   gs,                              -gs - gd};
+}
+
+void BJTFeedbackClipperCircuit::limit(const Vector& xOld, Vector& xNew) const {
+    // Base-emitter, then base-collector with the limited base
+    xNew[0] = limitJunctionStep(xOld[0], xNew[0], nVtBE, Is);
+    const double vbc = limitJunctionStep(xOld[0] - xOld[1], xNew[0] - xNew[1], nVtBC, Is);
+    xNew[1] = xNew[0] - vbc;
+    xNew[2] = limitPairStep(xOld[2], xNew[2], diodeIs, diodeNVt);
+}
+
+void FETDegeneratedClipperCircuit::drainCurrent(double vgs, double vds, double& id, double& gm, double& gds) const {
+    const double overdrive = vgs - Vto;
+    if (overdrive <= 0.0) {
+        id = gm = gds = 0.0;
+        return;
+    }
+    const double clm = 1.0 + Lambda * vds;
+    if (vds >= overdrive) {
+        const double base = 0.5 * Kp * overdrive * overdrive;
+        id = base * clm;
+        gm = Kp * overdrive * clm;
+        gds = base * Lambda;
+    } else {
+        const double base = Kp * (overdrive * vds - 0.5 * vds * vds);
+        id = base * clm;
+        gm = Kp * vds * clm;
+        gds = Kp * (overdrive - vds) * clm + base * Lambda;
+    }
+}
+
+void FETDegeneratedClipperCircuit::evaluate(const Vector& x, Vector& f, Matrix* J) const {
+    const double vs = x[0], vd = x[1], vo = x[2];
+    const double vg = Vgq + (quiescent ? 0.0 : 0.7 * vin);
+    double id, gm, gds;
+    drainCurrent(vg - vs, vd - vs, id, gm, gds);
+    
+    double idiode, gd;
+    diodePair(vo, diodeIs, diodeNVt, idiode, gd);
+    const double gs = quiescent ? 0.0 : 1.0 / Rs;
+    const double iout = gs * (vd - Vdq - vo);
+    
+    f[0] = id - vs / Rsource;
+    f[1] = (Vdd - vd) / Rd - id - iout;
+    f[2] = iout - idiode;
+    if (!J) return;
+    
+    const double dIddVs = -gm - gds;
+    *J = {dIddVs - 1.0 / Rsource,    gds,                        0.0,
+          -dIddVs,                   -1.0 / Rd - gds - gs,       gs,
+          0.0,                       gs,                         -gs - gd};
+}
+
+void FETDegeneratedClipperCircuit::limit(const Vector& xOld, Vector& xNew) const {
+    xNew[2] = limitPairStep(xOld[2], xNew[2], diodeIs, diodeNVt);
+}
+
+}  // namespace detail
+
+HybridTransistorDiodeStage::HybridTransistorDiodeStage(const BJTCharacteristics& bjt, const FETCharacteristics& fet)
+    : m_bjtStage(bjt), m_fetStage(fet) {
+    // Clipper diodes: 1N4148 pair
+    const DiodeCharacteristics diode = DiodeCharacteristics::Si1N4148();
+    
+    m_bjtCircuit.Is = bjt.Is;
+    m_bjtCircuit.nVtBE = double(bjt.nBE) * bjt.Vt;
+    m_bjtCircuit.nVtBC = double(bjt.nBC) * bjt.Vt;
+    m_bjtCircuit.Bf = bjt.Bf;
+    m_bjtCircuit.Br = bjt.Br;
+    m_bjtCircuit.diodeIs = diode.Is;
+    m_bjtCircuit.diodeNVt = double(diode.n) * diode.Vt;
+    
+    m_fetCircuit.Vto = fet.Vto;
+    m_fetCircuit.Kp = fet.Kp;
+    m_fetCircuit.Lambda = fet.Lambda;
+    m_fetCircuit.Vgq = double(fet.Vto) + 0.7;   // Gate bias 0.7 V above threshold
+    m_fetCircuit.diodeIs = diode.Is;
+    m_fetCircuit.diodeNVt = double(diode.n) * diode.Vt;
+    
+    // Three unknowns with exponential devices: forming the Jacobian costs
+    // little next to the exponentials, so only the first step of each
+    // sample runs on the previous sample's factors
+    CoupledSolver::Config config;
+    config.maxIterations = 16;
+    config.contraction = 0.0;
+    m_bjtSolver.setConfig(config);
+    m_fetSolver.setConfig(config);
+}
+
+void HybridTransistorDiodeStage::setSolveMode(SolveMode mode) {
+    m_mode = mode;
+    if (mode == SolveMode::Coupled) {
+        solveBJTQuiescent(m_feedbackAmount < 0.0f ? 0.5f : m_feedbackAmount);
+        solveFETQuiescent();
+    }
+}
+
+void HybridTransistorDiodeStage::reset() {
+    m_bjtState = {m_bjtCircuit.Vbq, m_bjtCircuit.Vcq, 0.0};
+    m_fetState[1] = m_fetCircuit.Vdq;
+    m_fetState[2] = 0.0;
+    m_bjtSolver.invalidate();
+    m_fetSolver.invalidate();
+}
+
+/**
+ * Quiescent points: the circuits with both coupling branches open, solved
+ * from a rough bias guess with a fresh Jacobian every iteration
+ */
+void HybridTransistorDiodeStage::solveBJTQuiescent(float feedbackAmount) {
+    // More feedback = smaller feedback resistor: 1 M down to 100 k
+    m_feedbackAmount = feedbackAmount;
+    m_bjtCircuit.Rf = 1e6 - 9e5 * std::clamp(double(feedbackAmount), 0.0, 1.0);
+    
+    CoupledSolver::Config config;
+    config.maxIterations = 100;
+    config.contraction = 0.0;
+    CoupledSolver solver(config);
+    m_bjtCircuit.quiescent = true;
+    CoupledSolver::Vector x{0.6, 0.5 * m_bjtCircuit.Vcc, 0.0};
+    solver.solve(m_bjtCircuit, x);
+    m_bjtCircuit.quiescent = false;
+    m_bjtCircuit.Vbq = x[0];
+    m_bjtCircuit.Vcq = x[1];
+    m_bjtState = {x[0], x[1], 0.0};
+    m_bjtSolver.invalidate();
+}
+
+void HybridTransistorDiodeStage::solveFETQuiescent() {
+    CoupledSolver::Config config;
+    config.maxIterations = 100;
+    config.contraction = 0.0;
+    CoupledSolver solver(config);
+    m_fetCircuit.quiescent = true;
+    CoupledSolver::Vector x{0.1, 0.5 * m_fetCircuit.Vdd, 0.0};
+    solver.solve(m_fetCircuit, x);
+    m_fetCircuit.quiescent = false;
+    m_fetCircuit.Vdq = x[1];
+    m_fetState = x;
+    m_fetSolver.invalidate();
+}
+
+/**
+ * HybridTransistorDiodeStage::processBJTClipperCoupled
+ * 
+ * One chord-Newton solve per sample from the previous sample's voltages;
+ * a feedback change re-biases the stage first.
+ */
+float HybridTransistorDiodeStage::processBJTClipperCoupled(float input, float feedbackAmount) {
+    if (feedbackAmount != m_feedbackAmount) {
+        solveBJTQuiescent(feedbackAmount);
+    }
+    m_bjtCircuit.vin = input;
+    m_bjtSolver.solve(m_bjtCircuit, m_bjtState);
+    return static_cast<float>(m_bjtState[2]);
+}
+
+/**
+ * HybridTransistorDiodeStage::processFETOverdriveCoupled
+ * 
+ * Tone sets the clipper's series resistor (10 k dark to 1 k bright): a
+ * brighter setting loads the drain harder and clips earlier.
+ */
+float HybridTransistorDiodeStage::processFETOverdriveCoupled(float input, float toneControl) {
+    const double Rs = 10e3 - 9e3 * std::clamp(double(toneControl), 0.0, 1.0);
+    if (Rs != m_fetCircuit.Rs) {
+        m_fetCircuit.Rs = Rs;
+        m_fetSolver.invalidate();
+    }
+    m_fetCircuit.vin = input;
+    m_fetSolver.solve(m_fetCircuit, m_fetState);
+    return static_cast<float>(m_fetState[2]);
 }
 
 /**
@@ -209,6 +614,10 @@ float FETOverdriveStage::processInputVoltage(float vinput) {
  * Combines amplification with soft clipping for natural overdrive
  */
 float HybridTransistorDiodeStage::processBJTClipperCascade(float input, float feedbackAmount) {
+    if (m_mode == SolveMode::Coupled) {
+        return processBJTClipperCoupled(input, feedbackAmount);
+    }
+    
     // Stage 1: BJT amplification
     float bjt_output = m_bjtStage.processInputVoltage(input);
     
@@ -233,6 +642,10 @@ float HybridTransistorDiodeStage::processBJTClipperCascade(float input, float fe
  * FET naturally compresses, providing overdrive characteristics
  */
 float HybridTransistorDiodeStage::processFETOverdriveCascade(float input, float toneControl) {
+    if (m_mode == SolveMode::Coupled) {
+        return processFETOverdriveCoupled(input, toneControl);
+    }
+    
     // Stage 1: FET processing
     float fet_output = m_fetStage.processInputVoltage(input);
     
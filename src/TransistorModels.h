@@ -1,6 +1,13 @@
 #pragma once
 
 #include <cmath>
+#include <array>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+#include <vector>
+#include "MathPolicy.h"
+#include "NewtonSolver.h"
 
 namespace Nonlinear {
 
@@ -29,7 +36,7 @@ struct BJTCharacteristics {
     float tempCoeff;       // Temperature coefficient
     
     // Predefined transistor types
-    static BJTCharacteristics TwoN2222() {
+    static constexpr BJTCharacteristics TwoN2222() {
         return {
             .Is = 1.4e-14f,
             .Vt = 0.026f,
@@ -43,7 +50,7 @@ struct BJTCharacteristics {
         };
     }
     
-    static BJTCharacteristics TwoN3904() {
+    static constexpr BJTCharacteristics TwoN3904() {
         return {
             .Is = 6.193e-15f,
             .Vt = 0.026f,
@@ -57,7 +64,7 @@ struct BJTCharacteristics {
         };
     }
     
-    static BJTCharacteristics TwoN5088() {
+    static constexpr BJTCharacteristics TwoN5088() {
         return {
             .Is = 5.911e-15f,
             .Vt = 0.026f,
@@ -99,7 +106,7 @@ struct FETCharacteristics {
     float Cgd;             // Gate-drain capacitance (F)
     
     // Predefined FET types
-    static FETCharacteristics TwoN7000() {
+    static constexpr FETCharacteristics TwoN7000() {
         return {
             .Vto = 1.5f,
             .Kp = 0.00357f,
@@ -112,7 +119,7 @@ struct FETCharacteristics {
         };
     }
     
-    static FETCharacteristics J201() {
+    static constexpr FETCharacteristics J201() {
         return {
             .Vto = -0.4f,
             .Kp = 0.003f,
@@ -126,6 +133,88 @@ struct FETCharacteristics {
     }
 };
 
+/**
+ * Tabulated collector current Ic(Vbe), Early term excluded
+ * Stock parts point at the compile-time tables in DeviceTables.h; custom
+ * parts build their own table at construction.
+ */
+class BJTCurrentLUT {
+public:
+    static constexpr int LUT_SIZE = 512;
+    static constexpr float VBE_MIN = -0.5f, VBE_MAX = 1.0f;
+    
+    using CurrentTable = std::array<float, LUT_SIZE>;
+    
+    explicit BJTCurrentLUT(const BJTCharacteristics& bjt);
+    
+    float evaluateCurrent(float vbe) const {
+        float norm = (std::fmin(std::fmax(vbe, VBE_MIN), VBE_MAX) - VBE_MIN) / (VBE_MAX - VBE_MIN);
+        float idx = norm * (LUT_SIZE - 1);
+        int i0 = int(idx), i1 = i0 + 1 < LUT_SIZE ? i0 + 1 : LUT_SIZE - 1;
+        float frac = idx - i0;
+        return (*m_table)[i0] + frac * ((*m_table)[i1] - (*m_table)[i0]);
+    }
+    
+    /**
+     * True when the table is a compile-time stock table
+     */
+    bool isStaticTable() const { return m_ownedTable == nullptr; }
+    
+    const CurrentTable* getTable() const { return m_table; }
+    
+private:
+    std::unique_ptr<CurrentTable> m_ownedTable;
+    const CurrentTable* m_table;
+};
+
+/**
+ * Precomputed Ic(Vbe, Vce) operating-point surface
+ * Built once per (BJTCharacteristics, Vce span, interpolation) and shared
+ * between stages through a process-wide cache, like DiodeLUT. Rows run
+ * along Vbe (dense, exponential axis); columns along Vce (sparse, Early
+ * effect). Bicubic uses Catmull-Rom weights on both axes.
+ */
+class BJTOperatingSurface {
+public:
+    enum class Interpolation { Bilinear, Bicubic };
+    
+    static constexpr int VBE_POINTS = 512, VCE_POINTS = 16;
+    static constexpr float VBE_MIN = -0.5f, VBE_MAX = 1.0f;
+    
+    BJTOperatingSurface(const BJTCharacteristics& bjt, float vceMax, Interpolation interpolation);
+    
+    /**
+     * Fetch (or build once) the shared surface; thread-safe, not real-time safe
+     */
+    static std::shared_ptr<const BJTOperatingSurface> acquire(const BJTCharacteristics& bjt, float vceMax,
+                                                              Interpolation interpolation);
+    
+    /**
+     * Number of distinct surfaces currently alive in the cache
+     */
+    static size_t cachedSurfaceCount();
+    
+    /**
+     * Collector current; Vbe and Vce are clamped to the surface span
+     */
+    float evaluateCurrent(float vbe, float vce) const;
+    
+    Interpolation getInterpolation() const { return m_interpolation; }
+    float getVceMax() const { return m_vceMax; }
+    float getInvBf() const { return m_invBf; }
+    float getInvNVt() const { return m_invNVt; }
+    size_t getMemoryBytes() const { return m_ic.size() * sizeof(float); }
+    
+private:
+    Interpolation m_interpolation;
+    float m_vceMax;
+    float m_vbeScale, m_vceScale;  // Grid index per volt
+    float m_invBf, m_invNVt;
+    std::vector<float> m_ic;       // [vce][vbe]
+    
+    float at(int vceIndex, int vbeIndex) const { return m_ic[size_t(vceIndex) * VBE_POINTS + vbeIndex]; }
+};
+
 /**
  * BJT Common Emitter Amplifier Stage
  */
@@ -140,19 +229,132 @@ public:
         : m_param(param), m_Rc(collectorResistance), m_Rload(loadResistance), 
           m_Vcc(supplyVoltage), m_temperature(25.0f) {}
     
+    /**
+     * DC operating point of the stage: the input voltage that biases the
+     * collector output to mid-swing, and the device state there
+     */
+    struct OperatingPoint {
+        float inputVoltage = 0.0f;
+        float outputVoltage = 0.0f;
+        BJTOperatingPoint device{};
+    };
+    
     float processVbe(float vbeInput, float vceOutput = 5.0f);
     float processInputVoltage(float vinput);
-    BJTOperatingPoint getCurrentBiasPoint() const;
+    BJTOperatingPoint getCurrentBiasPoint() const { return m_biasPoint; }
+    
+    /**
+     * Solve the DC operating point and start the stage there. Solved once
+     * per (BJTCharacteristics, Rc, Rload, Vcc) and shared through a
+     * process-wide cache; not real-time safe.
+     */
+    const OperatingPoint& solveOperatingPoint();
+    const OperatingPoint& getOperatingPoint() const { return m_operatingPoint; }
+    
+    /**
+     * Return the device state to the solved operating point (zero before
+     * the first solveOperatingPoint())
+     */
+    void reset() { m_biasPoint = m_operatingPoint.device; }
+    
+    /**
+     * Number of distinct operating points solved so far in this process
+     */
+    static size_t cachedOperatingPointCount();
     void setTemperature(float tempC) { m_temperature = tempC; }
-    float shockleyBJT(float vbe);
+    
+    /**
+     * Ebers-Moll base-emitter equation
+     * Ic = Bf * Is * (exp(Vbe / (n * Vt)) - 1), with Early voltage correction
+     * Ic = Ic0 * (1 + Vce / Vaf). Math selects exp() (see MathPolicy.h).
+     */
+    template <typename Math = LiveSpiceDSP::DefaultMath>
+    float shockleyBJT(float vbe) {
+        float early = 1.0f + m_biasPoint.Vce / m_param.Vat;
+        if (m_useCurrentTable) {
+            return m_currentTable->evaluateCurrent(vbe) * early;
+        }
+        
+        // Clamp exponent to prevent overflow
+        float nVt = m_param.nBE * m_param.Vt;
+        float expArg = std::fmin(std::fmax(vbe / nVt, -50.0f), 50.0f);
+        float ibe = m_param.Is * (Math::exp(expArg) - 1.0f);
+        return m_param.Bf * ibe * early;
+    }
+    
     float getThresholdVoltage() const { return m_param.Vat * 0.1f; }
     
+    /**
+     * Evaluate Ic from a BJTCurrentLUT instead of std::exp (off by default)
+     * The table is created on first enable; not real-time safe for custom parts.
+     */
+    void setUseCurrentTable(bool enabled);
+    bool isUsingCurrentTable() const { return m_useCurrentTable; }
+    
+    /**
+     * Evaluate processVbe() from a shared Ic(Vbe, Vce) surface spanning
+     * 0..supply voltage (off by default; takes precedence over the 1D table).
+     * Acquiring a surface may allocate; call from setup code.
+     */
+    void setUseOperatingSurface(bool enabled,
+                                BJTOperatingSurface::Interpolation interpolation = BJTOperatingSurface::Interpolation::Bicubic);
+    bool isUsingOperatingSurface() const { return m_surface != nullptr; }
+    
 private:
     BJTCharacteristics m_param;
     float m_Rc, m_Rload, m_Vcc, m_temperature;
-    BJTOperatingPoint m_biasPoint;
+    BJTOperatingPoint m_biasPoint{};
+    OperatingPoint m_operatingPoint{};
+    std::shared_ptr<const BJTCurrentLUT> m_currentTable;
+    bool m_useCurrentTable = false;
+    std::shared_ptr<const BJTOperatingSurface> m_surface;
 };
 
+namespace detail {
+
+/**
+ * Square-law drain current, shared by FETOverdriveStage and the
+ * compile-time specialized stages in TransistorStages.h
+ * Saturation: Id = Kp/2 * (Vgs - Vto)^2 * (1 + Lambda*Vds)
+ * Triode:     Id = Kp * ((Vgs - Vto) * Vds - Vds^2/2)
+ */
+inline float squareLawDrainCurrent(const FETCharacteristics& param, float vgs, float vds) {
+    // Clamp inputs
+    vgs = std::clamp(vgs, -5.0f, 5.0f);
+    vds = std::clamp(vds, 0.0f, 10.0f);
+    
+    float overdrive = vgs - param.Vto;
+    if (overdrive <= 0.0f) {
+        return 0.0f; // Off state
+    }
+    
+    float id;
+    if (std::abs(vds) >= std::abs(overdrive)) {
+        id = param.Kp * overdrive * overdrive * 0.5f * (1.0f + param.Lambda * vds);
+    } else {
+        id = param.Kp * (overdrive * vds - vds * vds * 0.5f);
+    }
+    return std::max(id, 0.0f); // Prevent negative current
+}
+
+/**
+ * Drain voltage of the common-source stage: Vcc = Vds + Id * Rd
+ * Five fixed-point steps from Vds = 5 V with a 1 mV early exit.
+ */
+inline float solveFETDrainVoltage(const FETCharacteristics& param, float vgs, float drainResistance) {
+    float vds = 5.0f;
+    for (int iter = 0; iter < 5; ++iter) {
+        float vdsNew = 5.0f - squareLawDrainCurrent(param, vgs, vds) * drainResistance;
+        if (std::abs(vdsNew - vds) < 0.001f) {
+            break;
+        }
+        vds = vdsNew;
+    }
+    return std::clamp(vds, 0.0f, 5.0f);
+}
+
+}  // namespace detail
+
 /**
  * FET Overdrive Stage
  */
@@ -168,28 +370,174 @@ public:
     float processInputVoltage(float vinput);
     float getDrainCurrent(float vgs, float vds);
     
+    /**
+     * Precomputed Vgs -> Vout transfer for one drain resistance
+     * Tabulates the same drain solve as processInputVoltage() over the
+     * clamped Vgs range; linear interpolation between points.
+     */
+    struct TransferMap {
+        static constexpr int POINTS = 1024;
+        static constexpr float VGS_MIN = -5.0f, VGS_MAX = 5.0f;
+        
+        float drainResistance;
+        std::vector<float> vout;
+        
+        float evaluate(float vgs) const {
+            float x = (std::fmin(std::fmax(vgs, VGS_MIN), VGS_MAX) - VGS_MIN) * ((POINTS - 1) / (VGS_MAX - VGS_MIN));
+            int i = std::min(int(x), POINTS - 2);
+            float t = x - i;
+            return vout[i] + t * (vout[i + 1] - vout[i]);
+        }
+    };
+    
+    /**
+     * Use the cached transfer map in processInputVoltage() (off by default)
+     * Enabling builds the map synchronously; call from setup code.
+     */
+    void setUseTransferMap(bool enabled);
+    bool isUsingTransferMap() const { return m_useTransferMap; }
+    
+    /**
+     * Change the drain resistor (the stage's bias). With the map enabled
+     * the old map stays in use until rebuildTransferMap() publishes a new one.
+     */
+    void setDrainResistance(float drainResistance) { m_Rd = drainResistance; }
+    float getDrainResistance() const { return m_Rd; }
+    
+    /**
+     * True when the active map was built for a different drain resistance
+     */
+    bool needsTransferMapRebuild() const {
+        return m_useTransferMap && (!m_transferMap || m_transferMap->drainResistance != m_Rd);
+    }
+    
+    /**
+     * Build a map for the current bias and hand it to the audio thread
+     * Call from a background/message thread. Returns false (and builds
+     * nothing) while a previously published map has not been picked up yet.
+     */
+    bool rebuildTransferMap();
+    
 private:
     FETCharacteristics m_param;
     float m_Rd, m_Rload;
     ChannelType m_type;
-    float shockleyFET(float vgs, float vds);
+    float shockleyFET(float vgs, float vds) const;
+    float solveDrainVoltage(float vgs, float drainResistance) const;
+    std::shared_ptr<const TransferMap> buildTransferMap(float drainResistance) const;
+    
+    // Single-producer/single-consumer handoff: the builder fills
+    // m_pendingMap and raises m_mapReady; the audio thread swaps it in.
+    bool m_useTransferMap = false;
+    std::shared_ptr<const TransferMap> m_transferMap;
+    std::shared_ptr<const TransferMap> m_pendingMap;
+    std::atomic<bool> m_mapReady{false};
 };
 
+namespace detail {
+
+/**
+ * Common-emitter BJT with a collector-to-base feedback resistor, its
+ * collector driving an antiparallel diode pair through a series resistor
+ * Unknowns x = [Vb, Vc, Vo]. Input and output couple through ideal
+ * capacitors, i.e. relative to the quiescent base and collector voltages;
+ * with quiescent set both coupling branches carry no current. Full
+ * Ebers-Moll junctions, so saturation is part of the solve.
+ */
+struct BJTFeedbackClipperCircuit {
+    using Vector = std::array<double, 3>;
+    using Matrix = std::array<double, 9>;
+    
+    double Is = 1e-14, nVtBE = 0.026, nVtBC = 0.026, Bf = 100.0, Br = 1.0;
+    double diodeIs = 1e-14, diodeNVt = 0.026;
+    double Rin = 10e3, Rf = 470e3, Rc = 10e3, Rs = 4.7e3, Vcc = 9.0;
+    double Vbq = 0.0, Vcq = 0.0;
+    double vin = 0.0;
+    bool quiescent = false;
+    
+    void evaluate(const Vector& x, Vector& f, Matrix* J) const;
+    void limit(const Vector& xOld, Vector& xNew) const;
+};
+
+/**
+ * Common-source FET with source degeneration, its drain driving an
+ * antiparallel diode pair through a series resistor
+ * Unknowns x = [Vs, Vd, Vo]. The gate sits at Vgq + 0.7 vin and draws no
+ * current; the output couples relative to the quiescent drain voltage.
+ * Square law with channel-length modulation in both regions, so the drain
+ * current and its derivatives are continuous at the saturation edge.
+ */
+struct FETDegeneratedClipperCircuit {
+    using Vector = std::array<double, 3>;
+    using Matrix = std::array<double, 9>;
+    
+    double Vto = 1.5, Kp = 0.0035, Lambda = 0.04;
+    double diodeIs = 1e-14, diodeNVt = 0.026;
+    double Rsource = 1e3, Rd = 10e3, Rs = 4.7e3, Vdd = 9.0;
+    double Vgq = 2.2, Vdq = 0.0;
+    double vin = 0.0;
+    bool quiescent = false;
+    
+    /** Drain current and its derivatives in Vgs and Vds */
+    void drainCurrent(double vgs, double vds, double& id, double& gm, double& gds) const;
+    
+    void evaluate(const Vector& x, Vector& f, Matrix* J) const;
+    void limit(const Vector& xOld, Vector& xNew) const;
+};
+
+}  // namespace detail
+
 /**
  * Hybrid Transistor-Diode Stage
+ * 
+ * Cascade mode (the default) runs the transistor stage and a tanh limiter
+ * in series, matching HybridTransistorDiodeStageT. Coupled mode solves the
+ * transistor, its feedback network and the diode clipper it drives as one
+ * nonlinear circuit with ChordNewtonSolver, so the clipper's load and the
+ * feedback act back on the transistor every sample. Outputs in coupled
+ * mode are the clipped AC voltage (V), zero at rest.
  */
 class HybridTransistorDiodeStage {
 public:
+    enum class SolveMode { Cascade, Coupled };
+    
     HybridTransistorDiodeStage(const BJTCharacteristics& bjt,
-                               const FETCharacteristics& fet = FETCharacteristics::TwoN7000())
-        : m_bjtStage(bjt), m_fetStage(fet) {}
+                               const FETCharacteristics& fet = FETCharacteristics::TwoN7000());
     
     float processBJTClipperCascade(float input, float feedbackAmount = 0.5f);
     float processFETOverdriveCascade(float input, float toneControl = 0.5f);
     
+    /**
+     * Select the series approximation or the coupled solve. Switching to
+     * Coupled solves the quiescent points; call from setup code.
+     */
+    void setSolveMode(SolveMode mode);
+    SolveMode getSolveMode() const { return m_mode; }
+    
+    /**
+     * Return the coupled circuits to their quiescent points
+     */
+    void reset();
+    
+    using CoupledSolver = ChordNewtonSolver<3>;
+    const CoupledSolver::Stats& getBJTSolverStats() const { return m_bjtSolver.getStats(); }
+    const CoupledSolver::Stats& getFETSolverStats() const { return m_fetSolver.getStats(); }
+    
 private:
     BJTAmplifierStage m_bjtStage;
     FETOverdriveStage m_fetStage;
+    
+    SolveMode m_mode = SolveMode::Cascade;
+    detail::BJTFeedbackClipperCircuit m_bjtCircuit;
+    detail::FETDegeneratedClipperCircuit m_fetCircuit;
+    CoupledSolver m_bjtSolver, m_fetSolver;
+    CoupledSolver::Vector m_bjtState{}, m_fetState{};
+    float m_feedbackAmount = -1.0f;   // Setting the BJT quiescent point was solved for
+    
+    float processBJTClipperCoupled(float input, float feedbackAmount);
+    float processFETOverdriveCoupled(float input, float toneControl);
+    void solveBJTQuiescent(float feedbackAmount);
+    void solveFETQuiescent();
 };
 
 } // namespace Nonlinear
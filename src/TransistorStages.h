@@ -0,0 +1,137 @@
+#pragma once
+
+#include "TransistorModels.h"
+#include "MathPolicy.h"
+#include <cmath>
+#include <cstddef>
+
+namespace Nonlinear {
+
+/**
+ * TransistorStages.h - Compile-time specialized transistor stages
+ *
+ * Header-only counterparts of BJTAmplifierStage, FETOverdriveStage and
+ * HybridTransistorDiodeStage with device polarity / channel type fixed as
+ * template parameters. Every branch on device type folds away, device
+ * constants are cached at construction, and the stages are stateless, so
+ * processBlock() loops inline and vectorize. The generated plugins emit
+ * these directly since the netlist fixes the device types.
+ *
+ * Bias mode is not a template parameter: the operating region follows the
+ * signal sample by sample, so it stays a branch-free select in the kernel.
+ */
+
+enum class BJTPolarity { NPN, PNP };
+
+using FETChannel = FETOverdriveStage::ChannelType;
+
+/**
+ * Common-emitter BJT clipper, NPN or PNP at compile time
+ * NPN matches BJTAmplifierStage::processInputVoltage() (Vce = 5 V bias
+ * point); PNP is its complement: out(v) = -NPN(-v), negative supply.
+ */
+template <BJTPolarity Polarity, typename Math = LiveSpiceDSP::DefaultMath>
+class TransistorClippingStageT {
+public:
+    static constexpr float SIGN = Polarity == BJTPolarity::NPN ? 1.0f : -1.0f;
+
+    TransistorClippingStageT(const BJTCharacteristics& bjt, float collectorResistance = 10000.0f,
+                             float loadResistance = 100000.0f, float supplyVoltage = 9.0f)
+        : m_invNVt(1.0f / (bjt.nBE * bjt.Vt)),
+          m_Bf(bjt.Bf),
+          m_Is(bjt.Is),
+          m_early(1.0f + 5.0f / bjt.Vat),
+          m_Rc(collectorResistance),
+          m_vcc(supplyVoltage),
+          m_divider(loadResistance / (collectorResistance + loadResistance)) {
+        m_quiescent = processInputVoltage(0.0f);
+    }
+
+    /**
+     * Collector voltage (DC coupled, 0..Vcc; mirrored for PNP)
+     */
+    float processInputVoltage(float vinput) const {
+        float vbe = std::fmin(std::fmax(SIGN * vinput * 0.5f, -0.5f), 1.0f);
+        float expArg = std::fmin(std::fmax(vbe * m_invNVt, -50.0f), 50.0f);
+        float ibe = m_Is * (Math::exp(expArg) - 1.0f);
+        float ic = m_Bf * ibe * m_early;
+        float vOutput = (m_vcc - ic * m_Rc) * m_divider;
+        return SIGN * std::fmin(std::fmax(vOutput, 0.0f), m_vcc);
+    }
+
+    /**
+     * AC-coupled output: collector swing around the quiescent point
+     */
+    float processSample(float input) const { return processInputVoltage(input) - m_quiescent; }
+
+    void processBlock(const float* input, float* output, size_t numSamples) const {
+        for (size_t i = 0; i < numSamples; ++i) output[i] = processSample(input[i]);
+    }
+
+private:
+    float m_invNVt, m_Bf, m_Is, m_early;
+    float m_Rc, m_vcc, m_divider;
+    float m_quiescent;
+};
+
+/**
+ * Common-source FET overdrive, channel type at compile time
+ * NMOS and JFET (depletion, Vto < 0 in the characteristics) use the
+ * square law as FETOverdriveStage does; PMOS is the mirrored complement.
+ */
+template <FETChannel Channel>
+class FETOverdriveStageT {
+public:
+    static constexpr float SIGN = Channel == FETChannel::PMOS ? -1.0f : 1.0f;
+
+    FETOverdriveStageT(const FETCharacteristics& param, float drainResistance = 10000.0f)
+        : m_param(param), m_Rd(drainResistance) {
+        m_quiescent = processInputVoltage(0.0f);
+    }
+
+    /**
+     * Drain voltage (DC coupled, 0..5 V; mirrored for PMOS)
+     */
+    float processInputVoltage(float vinput) const {
+        return SIGN * detail::solveFETDrainVoltage(m_param, SIGN * vinput * 0.7f, m_Rd);
+    }
+
+    float processSample(float input) const { return processInputVoltage(input) - m_quiescent; }
+
+    void processBlock(const float* input, float* output, size_t numSamples) const {
+        for (size_t i = 0; i < numSamples; ++i) output[i] = processSample(input[i]);
+    }
+
+private:
+    FETCharacteristics m_param;
+    float m_Rd;
+    float m_quiescent;
+};
+
+/**
+ * HybridTransistorDiodeStage with both devices fixed at compile time
+ * Same cascades as the runtime class in its default Cascade solve mode.
+ */
+template <BJTPolarity Polarity, FETChannel Channel, typename Math = LiveSpiceDSP::DefaultMath>
+class HybridTransistorDiodeStageT {
+public:
+    HybridTransistorDiodeStageT(const BJTCharacteristics& bjt,
+                                const FETCharacteristics& fet = FETCharacteristics::TwoN7000())
+        : m_bjtStage(bjt), m_fetStage(fet) {}
+
+    float processBJTClipperCascade(float input, float feedbackAmount = 0.5f) const {
+        float withFeedback = m_bjtStage.processInputVoltage(input) * (1.0f - feedbackAmount * 0.3f);
+        return std::tanh(withFeedback * 2.0f) * 0.5f;
+    }
+
+    float processFETOverdriveCascade(float input, float toneControl = 0.5f) const {
+        float toneShaped = m_fetStage.processInputVoltage(input) * (0.5f + toneControl * 0.5f);
+        return std::tanh(toneShaped * 1.5f) * 0.67f;
+    }
+
+private:
+    TransistorClippingStageT<Polarity, Math> m_bjtStage;
+    FETOverdriveStageT<Channel> m_fetStage;
+};
+
+}  // namespace Nonlinear
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <cmath>
+
+namespace LiveSpiceDSP {
+namespace WDF {
+
+/**
+ * @file WDF.h
+ * @brief Wave digital filter elements, adaptors and nonlinear roots
+ *
+ * A circuit is a compile-time tree: linear leaves (Resistor, Capacitor,
+ * ResistiveVoltageSource) joined by two-port Series / Parallel adaptors,
+ * with one nonlinear element (Diode, DiodePair) at the root. Child types
+ * are template parameters, so one sample is a fully inlined walk up the
+ * tree (reflected waves) and back down (incident waves).
+ *
+ * Every port follows the element convention: voltage v = (a + b) / 2 and
+ * current i = (a - b) / 2R into the element, where a is the wave arriving
+ * from the parent and b the wave sent back. Series and Parallel expose
+ * their children as one two-terminal element with the same polarity, so
+ * sources keep their sign anywhere in the tree.
+ *
+ * Changing a resistance (a potentiometer) re-adapts only the adaptors on
+ * the path from that leaf to the root; the audio path has no virtual calls.
+ */
+
+// ============================================================================
+// Port Base
+// ============================================================================
+
+/** Notified when a child's port resistance changes */
+class ImpedanceListener {
+public:
+    virtual void impedanceChanged() = 0;
+
+protected:
+    ~ImpedanceListener() = default;
+};
+
+/** Wave state and port resistance shared by every element */
+class Port {
+public:
+    double R = 1.0;   // port resistance
+    double G = 1.0;   // port conductance
+    double a = 0.0;   // incident wave (from the parent)
+    double b = 0.0;   // reflected wave (to the parent)
+
+    double voltage() const { return 0.5 * (a + b); }
+    double current() const { return 0.5 * (a - b) * G; }
+
+    void setParent(ImpedanceListener* listener) { parent = listener; }
+
+protected:
+    void setPortResistance(double resistance) {
+        R = resistance;
+        G = 1.0 / resistance;
+        if (parent) parent->impedanceChanged();
+    }
+
+private:
+    ImpedanceListener* parent = nullptr;
+};
+
+// ============================================================================
+// Linear Leaves
+// ============================================================================
+
+class Resistor : public Port {
+public:
+    explicit Resistor(double ohms) { setPortResistance(ohms); }
+
+    /** Potentiometer path: re-adapts the adaptors above this leaf */
+    void setResistance(double ohms) {
+        if (ohms != R) setPortResistance(ohms);
+    }
+
+    double reflected() { return b = 0.0; }
+    void incident(double wave) { a = wave; }
+};
+
+/** Bilinear (trapezoidal) capacitor: R = T / 2C, b[n] = a[n - 1] */
+class Capacitor : public Port {
+public:
+    explicit Capacitor(double farads, double sampleRate = 48000.0) : C(farads) { prepare(sampleRate); }
+
+    void prepare(double sampleRate) { setPortResistance(1.0 / (2.0 * C * sampleRate)); }
+    void reset() { z = 0.0; }
+
+    double reflected() { return b = z; }
+    void incident(double wave) {
+        a = wave;
+        z = wave;
+    }
+
+private:
+    double C;
+    double z = 0.0;
+};
+
+/** Voltage source with series resistance: v = Vs + R i */
+class ResistiveVoltageSource : public Port {
+public:
+    explicit ResistiveVoltageSource(double ohms) { setPortResistance(ohms); }
+
+    void setVoltage(double volts) { Vs = volts; }
+
+    double reflected() { return b = Vs; }
+    void incident(double wave) { a = wave; }
+
+private:
+    double Vs = 0.0;
+};
+
+// ============================================================================
+// Adaptors
+// ============================================================================
+
+/** Two elements in series, seen as one: v = v1 + v2, shared current */
+template <typename Port1, typename Port2>
+class Series : public Port, private ImpedanceListener {
+public:
+    Series(Port1& first, Port2& second) : port1(first), port2(second) {
+        port1.setParent(this);
+        port2.setParent(this);
+        impedanceChanged();
+    }
+
+    double reflected() { return b = port1.reflected() + port2.reflected(); }
+
+    void incident(double wave) {
+        a = wave;
+        const double excess = wave - port1.b - port2.b;
+        port1.incident(port1.b + port1Share * excess);
+        port2.incident(port2.b + (1.0 - port1Share) * excess);
+    }
+
+private:
+    Port1& port1;
+    Port2& port2;
+    double port1Share = 0.5;  // R1 / (R1 + R2)
+
+    void impedanceChanged() override {
+        port1Share = port1.R / (port1.R + port2.R);
+        setPortResistance(port1.R + port2.R);
+    }
+};
+
+/** Two elements in parallel, seen as one: shared voltage, i = i1 + i2 */
+template <typename Port1, typename Port2>
+class Parallel : public Port, private ImpedanceListener {
+public:
+    Parallel(Port1& first, Port2& second) : port1(first), port2(second) {
+        port1.setParent(this);
+        port2.setParent(this);
+        impedanceChanged();
+    }
+
+    double reflected() {
+        return b = port1Share * port1.reflected() + (1.0 - port1Share) * port2.reflected();
+    }
+
+    void incident(double wave) {
+        a = wave;
+        const double twiceVoltage = wave + b;
+        port1.incident(twiceVoltage - port1.b);
+        port2.incident(twiceVoltage - port2.b);
+    }
+
+private:
+    Port1& port1;
+    Port2& port2;
+    double port1Share = 0.5;  // G1 / (G1 + G2)
+
+    void impedanceChanged() override {
+        port1Share = port1.G / (port1.G + port2.G);
+        setPortResistance(1.0 / (port1.G + port2.G));
+    }
+};
+
+// ============================================================================
+// Nonlinear Roots
+// ============================================================================
+
+namespace detail {
+    /** Wright omega, piecewise polynomial/asymptotic first guess */
+    inline double omega3(double x) {
+        constexpr double x1 = -3.341459552768620;
+        constexpr double x2 = 8.0;
+        constexpr double a = -1.314293149877800e-3;
+        constexpr double b = 4.775931364975583e-2;
+        constexpr double c = 3.631952663804445e-1;
+        constexpr double d = 6.313183464296682e-1;
+        return x < x1 ? 0.0 : (x < x2 ? d + x * (c + x * (b + x * a)) : x - std::log(x));
+    }
+
+    /** Wright omega with one Newton refinement (clipper output within a few mV) */
+    inline double omega4(double x) {
+        const double y = omega3(x);
+        return y - (y - std::exp(x - y)) / (y + 1.0);
+    }
+}
+
+/**
+ * Shockley diode at the root, solved in closed form with the Wright omega
+ * function. The tree's port voltage is the diode's anode-cathode voltage
+ * unless `reversed` (cathode on the port's + side).
+ */
+template <typename Next>
+class Diode : public ImpedanceListener {
+public:
+    Diode(Next& next, double Is, double nVt, bool reversed = false)
+        : next(next), Is(Is), nVt(nVt), polarity(reversed ? -1.0 : 1.0) {
+        next.setParent(this);
+        impedanceChanged();
+    }
+
+    void process() {
+        const double wave = polarity * next.reflected();
+        const double reflectedWave = wave + 2.0 * RIs - 2.0 * nVt * detail::omega4(logRIsOverVt + (wave + RIs) / nVt);
+        next.incident(polarity * reflectedWave);
+    }
+
+    /** Port voltage after process() */
+    double voltage() const { return next.voltage(); }
+
+private:
+    Next& next;
+    double Is, nVt, polarity;
+    double RIs = 0.0, logRIsOverVt = 0.0;
+
+    void impedanceChanged() override {
+        RIs = next.R * Is;
+        logRIsOverVt = std::log(RIs / nVt);
+    }
+};
+
+/**
+ * Antiparallel diode pair at the root (Werner et al.): only the diode the
+ * wave forward-biases is solved, which is exact away from zero crossings
+ * and within a fraction of Is near them
+ */
+template <typename Next>
+class DiodePair : public ImpedanceListener {
+public:
+    DiodePair(Next& next, double Is, double nVt) : next(next), Is(Is), nVt(nVt) {
+        next.setParent(this);
+        impedanceChanged();
+    }
+
+    void process() {
+        const double wave = next.reflected();
+        const double sign = wave < 0.0 ? -1.0 : 1.0;
+        const double reflectedWave = wave + 2.0 * sign * (RIs - nVt * detail::omega4(logRIsOverVt + sign * wave / nVt + RIsOverVt));
+        next.incident(reflectedWave);
+    }
+
+    double voltage() const { return next.voltage(); }
+
+private:
+    Next& next;
+    double Is, nVt;
+    double RIs = 0.0, RIsOverVt = 0.0, logRIsOverVt = 0.0;
+
+    void impedanceChanged() override {
+        RIs = next.R * Is;
+        RIsOverVt = RIs / nVt;
+        logRIsOverVt = std::log(RIsOverVt);
+    }
+};
+
+} // namespace WDF
+} // namespace LiveSpiceDSP
@@ -0,0 +1,316 @@
+#include "WavFile.h"
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+namespace LiveSpice {
+
+namespace {
+
+    constexpr uint16_t FORMAT_PCM = 1;
+    constexpr uint16_t FORMAT_FLOAT = 3;
+    constexpr uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+
+    // Little-endian fields, independent of host byte order
+    uint32_t readLE(const unsigned char* p, int bytes) {
+        uint32_t value = 0;
+        for (int i = bytes - 1; i >= 0; --i) value = (value << 8) | p[i];
+        return value;
+    }
+
+    void storeLE(unsigned char* p, uint32_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) p[i] = static_cast<unsigned char>((value >> (8 * i)) & 0xFF);
+    }
+
+    float decodeSample(const unsigned char* p, uint16_t format, uint16_t bits) {
+        if (format == FORMAT_FLOAT) {
+            if (bits == 32) {
+                const uint32_t word = readLE(p, 4);
+                float value;
+                std::memcpy(&value, &word, sizeof(value));
+                return value;
+            }
+            const uint64_t word = static_cast<uint64_t>(readLE(p, 4)) | (static_cast<uint64_t>(readLE(p + 4, 4)) << 32);
+            double value;
+            std::memcpy(&value, &word, sizeof(value));
+            return static_cast<float>(value);
+        }
+
+        switch (bits) {
+            case 8: return (static_cast<float>(p[0]) - 128.0f) / 128.0f;   // Unsigned
+            case 16: return static_cast<float>(static_cast<int16_t>(readLE(p, 2))) / 32768.0f;
+            case 24: return static_cast<float>(static_cast<int32_t>(readLE(p, 3) << 8) >> 8) / 8388608.0f;
+            default: return static_cast<float>(static_cast<double>(static_cast<int32_t>(readLE(p, 4))) / 2147483648.0);
+        }
+    }
+
+    // One tight loop per sample format, so the format switch runs per block
+    template <uint16_t Format, uint16_t Bits>
+    void decodeRun(const unsigned char* p, size_t stride, size_t count, float* dest) {
+        for (size_t n = 0; n < count; ++n, p += stride) dest[n] = decodeSample(p, Format, Bits);
+    }
+
+    void decodeBlock(const unsigned char* p, size_t stride, size_t count, uint16_t format, uint16_t bits, float* dest) {
+        if (format == FORMAT_FLOAT) {
+            if (bits == 32) decodeRun<FORMAT_FLOAT, 32>(p, stride, count, dest);
+            else decodeRun<FORMAT_FLOAT, 64>(p, stride, count, dest);
+            return;
+        }
+        switch (bits) {
+            case 8: decodeRun<FORMAT_PCM, 8>(p, stride, count, dest); break;
+            case 16: decodeRun<FORMAT_PCM, 16>(p, stride, count, dest); break;
+            case 24: decodeRun<FORMAT_PCM, 24>(p, stride, count, dest); break;
+            default: decodeRun<FORMAT_PCM, 32>(p, stride, count, dest); break;
+        }
+    }
+
+} // namespace
+
+// ============================================================================
+// Reading
+// ============================================================================
+
+float WavChannelView::operator[](size_t index) const {
+    return decodeSample(data + index * stride, format, bits);
+}
+
+size_t WavChannelView::read(size_t start, size_t numFrames, float* dest) const {
+    if (start >= count) return 0;
+    numFrames = std::min(numFrames, count - start);
+    decodeBlock(data + start * stride, stride, numFrames, format, bits, dest);
+    return numFrames;
+}
+
+WavReader::WavReader(const std::string& path) : file(std::make_unique<MappedFile>(path)) {
+    if (!file->isOpen()) {
+        error = "cannot open " + path;
+        return;
+    }
+
+    const std::string_view bytes = file->view();
+    const auto* base = reinterpret_cast<const unsigned char*>(bytes.data());
+    if (bytes.size() < 12 || std::memcmp(base, "RIFF", 4) != 0 || std::memcmp(base + 8, "WAVE", 4) != 0) {
+        error = "not a RIFF/WAVE file: " + path;
+        return;
+    }
+
+    size_t dataSize = 0;
+
+    // Chunks are word-aligned; a truncated data chunk keeps what is there
+    size_t pos = 12;
+    while (pos + 8 <= bytes.size()) {
+        const unsigned char* chunk = base + pos;
+        const size_t size = readLE(chunk + 4, 4);
+        const size_t available = std::min(size, bytes.size() - pos - 8);
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && available >= 16) {
+            format = static_cast<uint16_t>(readLE(chunk + 8, 2));
+            numChannels = static_cast<int>(readLE(chunk + 10, 2));
+            sampleRate = readLE(chunk + 12, 4);
+            bits = static_cast<uint16_t>(readLE(chunk + 22, 2));
+            if (format == FORMAT_EXTENSIBLE && available >= 26) {
+                format = static_cast<uint16_t>(readLE(chunk + 32, 2));   // Sub-format GUID starts with the tag
+            }
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            data = chunk + 8;
+            dataSize = available;
+        }
+        pos += 8 + size + (size & 1);
+    }
+
+    if (numChannels == 0 || sampleRate == 0) {
+        error = "missing fmt chunk: " + path;
+        return;
+    }
+    if (!data) {
+        error = "missing data chunk: " + path;
+        return;
+    }
+    const bool pcm = format == FORMAT_PCM && (bits == 8 || bits == 16 || bits == 24 || bits == 32);
+    const bool ieee = format == FORMAT_FLOAT && (bits == 32 || bits == 64);
+    if (!pcm && !ieee) {
+        error = "unsupported sample format " + std::to_string(format) + "/" + std::to_string(bits) + " bit: " + path;
+        return;
+    }
+
+    frames = dataSize / (static_cast<size_t>(numChannels) * (bits / 8));
+}
+
+WavChannelView WavReader::channel(int index) const {
+    if (!isOpen() || index < 0 || index >= numChannels) return {};
+    const size_t sampleBytes = bits / 8;
+    return WavChannelView(data + static_cast<size_t>(index) * sampleBytes, frames,
+                          static_cast<size_t>(numChannels) * sampleBytes, format, bits);
+}
+
+size_t WavReader::read(size_t start, size_t numFrames, float* const* dest) const {
+    size_t count = 0;
+    for (int ch = 0; ch < numChannels; ++ch) {
+        if (dest[ch]) count = channel(ch).read(start, numFrames, dest[ch]);
+    }
+    return count;
+}
+
+size_t WavReader::readMono(size_t start, size_t numFrames, float* dest) const {
+    if (!isOpen() || start >= frames) return 0;
+    numFrames = std::min(numFrames, frames - start);
+
+    // Decode channel by channel into a small stack block, then accumulate
+    constexpr size_t blockSize = 1024;
+    float block[blockSize];
+    std::fill(dest, dest + numFrames, 0.0f);
+    const float scale = 1.0f / static_cast<float>(numChannels);
+    for (int ch = 0; ch < numChannels; ++ch) {
+        const WavChannelView view = channel(ch);
+        for (size_t done = 0; done < numFrames; done += blockSize) {
+            const size_t n = view.read(start + done, std::min(blockSize, numFrames - done), block);
+            for (size_t i = 0; i < n; ++i) dest[done + i] += block[i] * scale;
+        }
+    }
+    return numFrames;
+}
+
+bool readWav(const std::string& path, WavData& out, std::string* error) {
+    WavReader reader(path);
+    if (!reader.isOpen()) {
+        if (error) *error = reader.getError();
+        return false;
+    }
+
+    out.sampleRate = reader.getSampleRate();
+    out.channels.assign(static_cast<size_t>(reader.getNumChannels()), std::vector<float>(reader.numFrames()));
+    for (int ch = 0; ch < reader.getNumChannels(); ++ch) {
+        reader.channel(ch).read(0, reader.numFrames(), out.channels[static_cast<size_t>(ch)].data());
+    }
+    return true;
+}
+
+// ============================================================================
+// Writing
+// ============================================================================
+
+WavWriter::WavWriter(const std::string& path, uint32_t sampleRate, int numChannels, Format format, size_t bufferFrames)
+    : numChannels(std::max(1, numChannels)), format(format),
+      bytesPerSample(format == Format::Pcm16 ? 2 : format == Format::Pcm24 ? 3 : 4) {
+    buffer.resize(std::max<size_t>(1, bufferFrames) * static_cast<size_t>(this->numChannels * bytesPerSample));
+    stream.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!stream.is_open()) return;
+
+    // Sample rate is fixed for the file; sizes are patched by close()
+    const uint16_t tag = (format == Format::Float32) ? FORMAT_FLOAT : FORMAT_PCM;
+    const uint32_t blockAlign = static_cast<uint32_t>(this->numChannels * bytesPerSample);
+    unsigned char header[44];
+    std::memcpy(header, "RIFF", 4);
+    storeLE(header + 4, 36, 4);
+    std::memcpy(header + 8, "WAVEfmt ", 8);
+    storeLE(header + 16, 16, 4);
+    storeLE(header + 20, tag, 2);
+    storeLE(header + 22, static_cast<uint32_t>(this->numChannels), 2);
+    storeLE(header + 24, sampleRate, 4);
+    storeLE(header + 28, sampleRate * blockAlign, 4);
+    storeLE(header + 32, blockAlign, 2);
+    storeLE(header + 34, static_cast<uint32_t>(bytesPerSample * 8), 2);
+    std::memcpy(header + 36, "data", 4);
+    storeLE(header + 40, 0, 4);
+    stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+    ok = static_cast<bool>(stream);
+}
+
+WavWriter::~WavWriter() {
+    close();
+}
+
+bool WavWriter::write(const float* const* channels, size_t numFrames) {
+    if (!isOpen()) return false;
+
+    const size_t frameBytes = static_cast<size_t>(numChannels * bytesPerSample);
+    for (size_t n = 0; n < numFrames; ++n) {
+        if (used + frameBytes > buffer.size() && !flush()) return false;
+        unsigned char* out = buffer.data() + used;
+        for (int ch = 0; ch < numChannels; ++ch, out += bytesPerSample) {
+            const float sample = channels[ch] ? channels[ch][n] : 0.0f;
+            switch (format) {
+                case Format::Float32: {
+                    uint32_t word;
+                    std::memcpy(&word, &sample, sizeof(word));
+                    storeLE(out, word, 4);
+                    break;
+                }
+                case Format::Pcm16:
+                    storeLE(out, static_cast<uint32_t>(static_cast<int32_t>(std::clamp(sample, -1.0f, 1.0f) * 32767.0f)), 2);
+                    break;
+                case Format::Pcm24:
+                    storeLE(out, static_cast<uint32_t>(static_cast<int32_t>(std::clamp(sample, -1.0f, 1.0f) * 8388607.0f)), 3);
+                    break;
+            }
+        }
+        used += frameBytes;
+    }
+    frames += numFrames;
+    return true;
+}
+
+bool WavWriter::flush() {
+    if (used > 0) {
+        stream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(used));
+        used = 0;
+        ok = ok && static_cast<bool>(stream);
+    }
+    return ok;
+}
+
+void WavWriter::writeHeader(uint64_t dataBytes) {
+    // RIFF sizes are 32-bit; an oversized file keeps the largest legal value
+    const uint32_t data32 = static_cast<uint32_t>(std::min<uint64_t>(dataBytes, 0xFFFFFFFFull - 36));
+    unsigned char size[4];
+    stream.seekp(4, std::ios::beg);
+    storeLE(size, 36 + data32, 4);
+    stream.write(reinterpret_cast<const char*>(size), 4);
+    stream.seekp(40, std::ios::beg);
+    storeLE(size, data32, 4);
+    stream.write(reinterpret_cast<const char*>(size), 4);
+}
+
+bool WavWriter::close() {
+    if (!stream.is_open()) return ok;
+
+    flush();
+    const uint64_t dataBytes = static_cast<uint64_t>(frames) * static_cast<uint64_t>(numChannels * bytesPerSample);
+    if (dataBytes & 1) {
+        const char pad = 0;   // Chunks are word-aligned
+        stream.write(&pad, 1);
+    }
+    writeHeader(dataBytes);
+    ok = ok && static_cast<bool>(stream);
+    stream.close();
+    return ok;
+}
+
+bool writeWav(const std::string& path, const WavData& data) {
+    WavWriter writer(path, data.sampleRate, static_cast<int>(data.channels.size()));
+    if (!writer.isOpen()) return false;
+
+    // Channels shorter than the first are padded with silence
+    const size_t numFrames = data.numFrames();
+    std::vector<const float*> pointers(data.channels.size());
+    constexpr size_t blockSize = 4096;
+    std::vector<std::vector<float>> padded;
+    padded.reserve(data.channels.size());
+    for (size_t ch = 0; ch < data.channels.size(); ++ch) {
+        if (data.channels[ch].size() < numFrames) {
+            padded.emplace_back(data.channels[ch]);
+            padded.back().resize(numFrames, 0.0f);
+            pointers[ch] = padded.back().data();
+        } else {
+            pointers[ch] = data.channels[ch].data();
+        }
+    }
+
+    std::vector<const float*> block(pointers.size());
+    for (size_t start = 0; start < numFrames; start += blockSize) {
+        for (size_t ch = 0; ch < pointers.size(); ++ch) block[ch] = pointers[ch] + start;
+        if (!writer.write(block.data(), std::min(blockSize, numFrames - start))) return false;
+    }
+    return writer.close();
+}
+
+} // namespace LiveSpice
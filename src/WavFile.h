@@ -0,0 +1,155 @@
+#pragma once
+
+#include "MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace LiveSpice {
+
+    // ============================================================================
+    // WAV files - RIFF/WAVE reading and writing for the offline tools
+    // ============================================================================
+
+    /**
+     * Decoded audio, one vector per channel, samples in [-1, 1].
+     */
+    struct WavData {
+        uint32_t sampleRate = 44100;
+        std::vector<std::vector<float>> channels;
+
+        size_t numFrames() const { return channels.empty() ? 0 : channels.front().size(); }
+    };
+
+    /**
+     * One channel of a mapped WAV, decoded on access. A strided view into the
+     * mapping: nothing is copied until samples are read.
+     */
+    class WavChannelView {
+    public:
+        WavChannelView() = default;
+        WavChannelView(const unsigned char* data, size_t count, size_t stride, uint16_t format, uint16_t bits)
+            : data(data), count(count), stride(stride), format(format), bits(bits) {}
+
+        size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        float operator[](size_t index) const;
+
+        /** Decode [start, start + numFrames) into dest; returns frames written */
+        size_t read(size_t start, size_t numFrames, float* dest) const;
+
+    private:
+        const unsigned char* data = nullptr;
+        size_t count = 0;
+        size_t stride = 0;
+        uint16_t format = 0;
+        uint16_t bits = 0;
+    };
+
+    /**
+     * Memory-mapped WAV reader for integer PCM (8/16/24/32-bit) and IEEE
+     * float (32/64-bit), WAVE_FORMAT_EXTENSIBLE included; unknown chunks are
+     * skipped and a truncated data chunk keeps what is there. The header is
+     * parsed on open; samples are converted only as they are read, block by
+     * block, so peak memory is the caller's block rather than the file.
+     */
+    class WavReader {
+    public:
+        explicit WavReader(const std::string& path);
+
+        WavReader(const WavReader&) = delete;
+        WavReader& operator=(const WavReader&) = delete;
+
+        bool isOpen() const { return error.empty(); }
+        const std::string& getError() const { return error; }
+
+        uint32_t getSampleRate() const { return sampleRate; }
+        int getNumChannels() const { return numChannels; }
+        size_t numFrames() const { return frames; }
+        int getBitsPerSample() const { return bits; }
+        bool isFloat() const { return format == 3; }
+
+        WavChannelView channel(int index) const;
+
+        /**
+         * Decode frames [start, start + numFrames) into one buffer per channel
+         * (getNumChannels() pointers, nullptr entries skipped)
+         * @return frames read, fewer at the end of the file
+         */
+        size_t read(size_t start, size_t numFrames, float* const* dest) const;
+
+        /** Average of all channels into dest; the usual mono analysis input */
+        size_t readMono(size_t start, size_t numFrames, float* dest) const;
+
+    private:
+        std::unique_ptr<MappedFile> file;
+        std::string error;
+        uint32_t sampleRate = 0;
+        int numChannels = 0;
+        uint16_t format = 0;
+        uint16_t bits = 0;
+        size_t frames = 0;
+        const unsigned char* data = nullptr;   // First frame
+    };
+
+    /**
+     * Streaming WAV writer. Interleaves into a buffer sized at construction
+     * and writes it out whenever it fills, so a long render never holds the
+     * whole file; close() (or the destructor) patches the RIFF and data
+     * sizes. Clips to [-1, 1] for integer formats.
+     */
+    class WavWriter {
+    public:
+        enum class Format { Float32, Pcm16, Pcm24 };
+
+        WavWriter(const std::string& path, uint32_t sampleRate, int numChannels,
+                  Format format = Format::Float32, size_t bufferFrames = 8192);
+        ~WavWriter();
+
+        WavWriter(const WavWriter&) = delete;
+        WavWriter& operator=(const WavWriter&) = delete;
+
+        bool isOpen() const { return stream.is_open() && ok; }
+
+        /**
+         * Append numFrames from one buffer per channel (nullptr entries write
+         * silence). False once a write has failed.
+         */
+        bool write(const float* const* channels, size_t numFrames);
+
+        /** Flush, patch the header and close; false when anything failed */
+        bool close();
+
+        size_t framesWritten() const { return frames; }
+
+    private:
+        std::ofstream stream;
+        std::vector<unsigned char> buffer;
+        size_t used = 0;                       // Bytes in buffer
+        int numChannels;
+        Format format;
+        int bytesPerSample;
+        size_t frames = 0;
+        bool ok = false;
+
+        bool flush();
+        void writeHeader(uint64_t dataBytes);
+    };
+
+    /**
+     * Read a whole WAV into memory (WavReader plus one conversion pass).
+     * False with a reason in error when the file is missing or unsupported.
+     */
+    bool readWav(const std::string& path, WavData& out, std::string* error = nullptr);
+
+    /**
+     * Write 32-bit float WAV, so residuals far below 16-bit quantization
+     * survive. False when the file cannot be written.
+     */
+    bool writeWav(const std::string& path, const WavData& data);
+
+} // namespace LiveSpice
@@ -0,0 +1,119 @@
+#include "Waveshaper.h"
+#include "DiodeModels.h"
+#include "Denormals.h"
+
+namespace LiveSpiceDSP {
+
+// ============================================================================
+// WaveshaperTable Implementation
+// ============================================================================
+
+WaveshaperTable::WaveshaperTable(const Curve& curve, double inputRange, size_t size)
+    : m_size(std::max<size_t>(size, 2)),
+      m_lastSegment(static_cast<int>(m_size) - 1),
+      m_range(std::max(inputRange, 1e-6)),
+      m_step(2.0 * m_range / static_cast<double>(m_size)),
+      m_inverseStep(1.0 / m_step),
+      m_rangeF(static_cast<float>(m_range)),
+      m_inverseStepF(static_cast<float>(m_inverseStep)),
+      m_c0(m_size), m_c1(m_size), m_c2(m_size), m_c3(m_size),
+      m_integral(m_size + 1) {
+    // Knots -1 .. size + 1; the outer two only shape the end tangents
+    std::vector<double> y(m_size + 3);
+    for (size_t k = 0; k < y.size(); ++k) {
+        y[k] = curve(-m_range + (static_cast<double>(k) - 1.0) * m_step);
+    }
+
+    // Catmull-Rom segment i runs from knot i to i + 1
+    for (size_t i = 0; i < m_size; ++i) {
+        const double y0 = y[i], y1 = y[i + 1], y2 = y[i + 2], y3 = y[i + 3];
+        m_c0[i] = static_cast<float>(y1);
+        m_c1[i] = static_cast<float>(0.5 * (y2 - y0));
+        m_c2[i] = static_cast<float>(y0 - 2.5 * y1 + 2.0 * y2 - 0.5 * y3);
+        m_c3[i] = static_cast<float>(0.5 * (y3 - y0) + 1.5 * (y1 - y2));
+    }
+
+    // Integrate the stored (float) cubics, then move the origin to x = 0
+    m_integral[0] = 0.0;
+    for (size_t i = 0; i < m_size; ++i) {
+        m_integral[i + 1] = m_integral[i]
+            + m_step * (m_c0[i] + m_c1[i] * 0.5 + m_c2[i] * (1.0 / 3.0) + m_c3[i] * 0.25);
+    }
+    const double origin = antiderivative(0.0);
+    for (auto& F : m_integral) F -= origin;
+}
+
+WaveshaperTable WaveshaperTable::tanh(double inputRange, size_t size) {
+    return WaveshaperTable([](double x) { return std::tanh(x); }, inputRange, size);
+}
+
+WaveshaperTable WaveshaperTable::softClip(size_t size) {
+    return WaveshaperTable([](double x) {
+        const double c = std::clamp(x, -1.5, 1.5);
+        return c - (4.0 / 27.0) * c * c * c;
+    }, 2.0, size);
+}
+
+WaveshaperTable WaveshaperTable::hardClip(size_t size) {
+    return WaveshaperTable([](double x) { return std::clamp(x, -1.0, 1.0); }, 2.0, size);
+}
+
+WaveshaperTable WaveshaperTable::diodePair(const Nonlinear::DiodeLUT& forward, const Nonlinear::DiodeLUT& reverse,
+                                           double seriesResistance, int forwardCount, int reverseCount,
+                                           double inputRange, size_t size) {
+    const double nf = std::max(forwardCount, 1), nr = std::max(reverseCount, 1);
+    auto loop = [&](double v) {
+        const double current = forward.evaluateCurrent(static_cast<float>(v / nf))
+                             - reverse.evaluateCurrent(static_cast<float>(-v / nr));
+        return v + seriesResistance * current;
+    };
+
+    // loop() is increasing and |v| <= |vin| brackets the root
+    return WaveshaperTable([&](double vin) {
+        double lo = -std::abs(vin), hi = std::abs(vin);
+        for (int i = 0; i < 60; ++i) {
+            const double v = 0.5 * (lo + hi);
+            (loop(v) > vin ? hi : lo) = v;
+        }
+        return 0.5 * (lo + hi);
+    }, inputRange, size);
+}
+
+// ============================================================================
+// WaveshaperADAA Implementation
+// ============================================================================
+
+void WaveshaperADAA::processBlock(const float* input, float* output, size_t numSamples) {
+    ScopedFlushDenormals noDenormals;
+    if (!m_table) {
+        if (output != input) std::copy(input, input + numSamples, output);
+        return;
+    }
+
+    // Index 0 carries the previous block's last sample
+    double x[CHUNK + 1], F[CHUNK + 1];
+    float midpoint[CHUNK];
+    for (size_t start = 0; start < numSamples; start += CHUNK) {
+        const size_t count = std::min(CHUNK, numSamples - start);
+
+        x[0] = m_x1;
+        F[0] = m_F1;
+        for (size_t n = 0; n < count; ++n) x[n + 1] = input[start + n];
+        for (size_t n = 0; n < count; ++n) {
+            F[n + 1] = m_table->antiderivative(x[n + 1]);
+            midpoint[n] = static_cast<float>(0.5 * (x[n + 1] + x[n]));
+        }
+        m_table->processBlock(midpoint, midpoint, count);
+
+        for (size_t n = 0; n < count; ++n) {
+            const double dx = x[n + 1] - x[n];
+            const bool divides = std::abs(dx) > MIN_STEP;
+            const float slope = static_cast<float>((F[n + 1] - F[n]) / (divides ? dx : 1.0));
+            output[start + n] = divides ? slope : midpoint[n];
+        }
+        m_x1 = x[count];
+        m_F1 = F[count];
+    }
+}
+
+}  // namespace LiveSpiceDSP
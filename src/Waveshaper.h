@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Nonlinear {
+class DiodeLUT;
+}
+
+namespace LiveSpiceDSP {
+
+/**
+ * @file Waveshaper.h
+ * @brief Tabulated static curves with cubic interpolation and ADAA
+ *
+ * SoftClipperProcessor evaluates tanh, sin or a diode solve per sample in
+ * double precision. A WaveshaperTable bakes any memoryless curve once at
+ * prepare time into per-segment cubic coefficients (Catmull-Rom through
+ * evenly spaced samples), stored as four separate arrays so a block pass
+ * is clamp, index, four gathers and a Horner step with no branches.
+ * Inputs beyond the table range hold the edge value, so the range should
+ * reach into the curve's saturated region.
+ *
+ * Each table also carries the exact antiderivative of its cubics, which
+ * WaveshaperADAA uses for first-order antiderivative antialiasing.
+ */
+
+class WaveshaperTable {
+public:
+    static constexpr size_t DEFAULT_SIZE = 1024;
+    static constexpr size_t CHUNK = 64;   // Block pass stack buffer (samples)
+    using Curve = std::function<double(double)>;
+
+    /**
+     * Sample curve at size + 3 points spanning [-inputRange, inputRange]
+     * (one extra each side for the end tangents). Not real-time safe.
+     */
+    WaveshaperTable(const Curve& curve, double inputRange, size_t size = DEFAULT_SIZE);
+
+    // Stock curves, all reaching +-1 (diodePair: the diode drop)
+    static WaveshaperTable tanh(double inputRange = 8.0, size_t size = DEFAULT_SIZE);
+    /** Cubic soft clip x - 4x^3/27, flat from |x| = 1.5 */
+    static WaveshaperTable softClip(size_t size = DEFAULT_SIZE);
+    static WaveshaperTable hardClip(size_t size = DEFAULT_SIZE);
+
+    /**
+     * Diode pair to ground behind a series resistor: the node voltage v
+     * solving vin = v + R (If(v / forwardCount) - Ir(-v / reverseCount)),
+     * with both currents read from DiodeLUT. Different parts or counts per
+     * side give the asymmetric clippers (e.g. one silicon diode against two
+     * in series).
+     */
+    static WaveshaperTable diodePair(const Nonlinear::DiodeLUT& forward, const Nonlinear::DiodeLUT& reverse,
+                                     double seriesResistance = 10000.0, int forwardCount = 1, int reverseCount = 1,
+                                     double inputRange = 10.0, size_t size = DEFAULT_SIZE);
+
+    float process(float x) const {
+        int i;
+        float t;
+        locate(x, i, t);
+        return ((m_c3[i] * t + m_c2[i]) * t + m_c1[i]) * t + m_c0[i];
+    }
+
+    /**
+     * Table pass over a block; output may alias input
+     */
+    void processBlock(const float* input, float* output, size_t numSamples) const {
+        const float* c0 = m_c0.data();
+        const float* c1 = m_c1.data();
+        const float* c2 = m_c2.data();
+        const float* c3 = m_c3.data();
+        const float range = m_rangeF, inverseStep = m_inverseStepF;
+        const int lastSegment = m_lastSegment;
+
+        // Results go through a local chunk, which provably does not alias
+        // the coefficients, so the gathers vectorize
+        float y[CHUNK];
+        for (size_t start = 0; start < numSamples; start += CHUNK) {
+            const size_t count = std::min(CHUNK, numSamples - start);
+            for (size_t n = 0; n < count; ++n) {
+                const float u = (std::clamp(input[start + n], -range, range) + range) * inverseStep;
+                const int i = std::min(static_cast<int>(u), lastSegment);
+                const float t = u - static_cast<float>(i);
+                y[n] = ((c3[i] * t + c2[i]) * t + c1[i]) * t + c0[i];
+            }
+            std::copy(y, y + count, output + start);
+        }
+    }
+
+    /**
+     * Exact integral of the interpolated curve from 0, extended linearly
+     * with the edge value beyond the range. Double precision: ADAA divides
+     * differences of it by small input steps.
+     */
+    double antiderivative(double x) const {
+        const double xc = std::clamp(x, -m_range, m_range);
+        const double u = (xc + m_range) * m_inverseStep;
+        const int i = std::min(static_cast<int>(u), m_lastSegment);
+        const double t = u - static_cast<double>(i);
+        const double y = ((m_c3[i] * t + m_c2[i]) * t + m_c1[i]) * t + m_c0[i];
+        const double inside = m_integral[i] + m_step * t
+            * (m_c0[i] + t * (m_c1[i] * 0.5 + t * (m_c2[i] * (1.0 / 3.0) + t * m_c3[i] * 0.25)));
+        return inside + y * (x - xc);
+    }
+
+    double getInputRange() const { return m_range; }
+    size_t getSize() const { return m_size; }
+    size_t getMemoryBytes() const { return 4 * m_size * sizeof(float) + (m_size + 1) * sizeof(double); }
+
+private:
+    size_t m_size;              // Segments
+    int m_lastSegment;
+    double m_range;
+    double m_step;              // Segment width
+    double m_inverseStep;
+    float m_rangeF, m_inverseStepF;
+    std::vector<float> m_c0, m_c1, m_c2, m_c3;   // y = ((c3 t + c2) t + c1) t + c0, t in [0, 1]
+    std::vector<double> m_integral;              // Antiderivative at each knot (0 at x = 0)
+
+    // 32-bit indices, so the conversion and the gathers vectorize
+    void locate(float x, int& i, float& t) const {
+        const float u = (std::clamp(x, -m_rangeF, m_rangeF) + m_rangeF) * m_inverseStepF;
+        i = std::min(static_cast<int>(u), m_lastSegment);
+        t = u - static_cast<float>(i);
+    }
+};
+
+/**
+ * First-order antiderivative antialiasing over a shared WaveshaperTable
+ *   y[n] = (F(x[n]) - F(x[n-1])) / (x[n] - x[n-1])
+ * falling back to f at the midpoint when the step is too small to divide.
+ * Adds half a sample of delay. One instance per channel; without a table
+ * the input passes through.
+ */
+class WaveshaperADAA {
+public:
+    static constexpr double MIN_STEP = 1e-5;
+
+    void setTable(std::shared_ptr<const WaveshaperTable> table) {
+        m_table = std::move(table);
+        reset();
+    }
+
+    const WaveshaperTable* getTable() const { return m_table.get(); }
+
+    void reset() {
+        m_x1 = 0.0;
+        m_F1 = m_table ? m_table->antiderivative(0.0) : 0.0;
+    }
+
+    float process(float x) {
+        if (!m_table) return x;
+        const double F = m_table->antiderivative(x);
+        const float y = step(x, F);
+        m_x1 = x;
+        m_F1 = F;
+        return y;
+    }
+
+    /**
+     * Antiderivative and midpoint table passes, then a select between the
+     * divided difference and the midpoint value, all without recurrences
+     * (the select vectorizes once trapping math is off). Output may alias
+     * input. Real-time safe.
+     */
+    void processBlock(const float* input, float* output, size_t numSamples);
+
+private:
+    static constexpr size_t CHUNK = WaveshaperTable::CHUNK;
+
+    std::shared_ptr<const WaveshaperTable> m_table;
+    double m_x1 = 0.0, m_F1 = 0.0;
+
+    float step(double x, double F) const {
+        const double dx = x - m_x1;
+        return std::abs(dx) > MIN_STEP ? static_cast<float>((F - m_F1) / dx)
+                                       : m_table->process(static_cast<float>(0.5 * (x + m_x1)));
+    }
+};
+
+}  // namespace LiveSpiceDSP
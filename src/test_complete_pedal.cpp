@@ -1,9 +1,21 @@
 #include "MultiStagePedal.h"
 #include "CompressorDynamics.h"
+#include "MultiPedalEngine.h"
+#include "PresetSweep.h"
+#include "Denormals.h"
+#include "TableRebuildWorker.h"
+#include <atomic>
 #include <iostream>
 #include <iomanip>
 #include <cmath>
 #include <cassert>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <memory>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
 
 using namespace LiveSpiceDSP;
 
@@ -119,10 +131,19 @@ void testPedalCompleteChain(TestResults& results) {
     float input = 0.1f;
     float output = pedal.process(input);
     
-    if (std::isfinite(output) && std::abs(output) < 2.0f) {
+    // The chain must follow the input, not sit at the limiter ceiling
+    MultiStagePedal positive(44100.0f, 1), negative(44100.0f, 1);
+    float outPos = 0.0f, outNeg = 0.0f;
+    for (int i = 0; i < 1000; ++i) {
+        outPos = positive.process(input);
+        outNeg = negative.process(-input);
+    }
+    
+    if (std::isfinite(output) && std::abs(output) < 2.0f && outPos * outNeg < 0.0f) {
         results.pass("Complete Pedal Chain");
     } else {
-        results.fail("Complete Pedal", "Invalid output or instability");
+        results.fail("Complete Pedal", "Invalid output or instability (" + std::to_string(outPos) +
+                     " / " + std::to_string(outNeg) + ")");
     }
 }
 
@@ -135,17 +156,64 @@ void testPedalBypass(TestResults& results) {
     float input = 0.05f;
     float withEffects = pedal.process(input);
     
+    // Bypass ramps in over BYPASS_RAMP_MS; measure once it has settled
     pedal.bypassAll();
-    float withBypass = pedal.process(input);
+    float withBypass = 0.0f;
+    for (int i = 0; i < 1000; ++i) withBypass = pedal.process(input);
     
-    // With bypass should be much closer to input
-    if (std::abs(withBypass - input) < std::abs(withEffects - input)) {
+    // With bypass should be the dry input (drive/volume are not stages)
+    float dry = input * std::pow(10.0f, 12.0f / 20.0f);
+    if (std::abs(withBypass - dry) < 1e-4f && std::abs(withBypass - dry) < std::abs(withEffects - dry)) {
         results.pass("Pedal Bypass Functionality");
     } else {
         results.fail("Pedal Bypass", "Bypass not working correctly");
     }
 }
 
+void testPedalOversampling(TestResults& results) {
+    MultiStagePedal pedal(44100.0f, 1);
+    pedal.setDrive(12.0f);
+    
+    if (pedal.getLatencySamples() != 0.0f) {
+        results.fail("Pedal Oversampling", "Latency reported without oversampling");
+        return;
+    }
+    
+    pedal.setOversampling(4, Oversampler::FilterType::MinimumPhaseIIR);
+    bool stable = true;
+    for (int i = 0; i < 4096; ++i) {
+        float out = pedal.process(0.3f * std::sin(2.0f * 3.14159265f * 1000.0f * i / 44100.0f));
+        stable = stable && std::isfinite(out) && std::abs(out) < 2.0f;
+    }
+    
+    if (stable && pedal.getLatencySamples() > 0.0f) {
+        results.pass("Pedal 4x Oversampled Clippers");
+    } else {
+        results.fail("Pedal Oversampling", "Unstable output or missing latency report");
+    }
+    
+    // Adaptive: 1x on a whisper, up to 8x when the drive pushes a bright note into the clippers
+    pedal.setAdaptiveOversampling(8);
+    pedal.reset();
+    const float latency = pedal.getLatencySamples();
+    std::vector<float> block(512);
+    auto render = [&](float amplitude) {
+        for (size_t i = 0; i < block.size(); ++i) block[i] = amplitude * std::sin(2.0f * 3.14159265f * 2000.0f * i / 44100.0f);
+        pedal.processBlock(block.data(), block.data(), block.size());
+    };
+    render(0.0001f);
+    const int quietFactor = pedal.getOversamplingFactor();
+    render(0.5f);
+    const int drivenFactor = pedal.getOversamplingFactor();
+    
+    if (quietFactor == 1 && drivenFactor == 8 && pedal.getLatencySamples() == latency && latency > 0.0f) {
+        results.pass("Pedal Adaptive Oversampling");
+    } else {
+        results.fail("Pedal Adaptive Oversampling", "factors " + std::to_string(quietFactor) + " / " +
+                     std::to_string(drivenFactor));
+    }
+}
+
 void testPedalClipperCascade(TestResults& results) {
     // Single stage
     MultiStagePedal pedalSingle(44100.0f, 1);
@@ -254,8 +322,9 @@ void testToneStackIntegration(TestResults& results) {
 void testInputMetering(TestResults& results) {
     MultiStagePedal pedal(44100.0f, 1);
     
+    // Meters publish once per metering block
     float input = 0.1f;
-    pedal.process(input);
+    for (int i = 0; i < MultiStagePedal::METER_PERIOD; ++i) pedal.process(input);
     
     float inputDb = pedal.getInputLevel();
     
@@ -274,7 +343,7 @@ void testOutputMetering(TestResults& results) {
     pedal.setVolume(0.0f);
     
     float input = 0.05f;
-    pedal.process(input);
+    for (int i = 0; i < MultiStagePedal::METER_PERIOD; ++i) pedal.process(input);
     
     float outputDb = pedal.getOutputLevel();
     
@@ -292,7 +361,7 @@ void testGainReductionMetering(TestResults& results) {
     pedal.setVolume(0.0f);
     
     float input = 0.2f;
-    for (int i = 0; i < 100; ++i) {
+    for (int i = 0; i < MultiStagePedal::METER_PERIOD; ++i) {
         pedal.process(input);
     }
     
@@ -412,7 +481,1094 @@ void testStateReset(TestResults& results) {
 // Main Test Suite
 // ============================================================================
 
-int main() {
+// ============================================================================
+// TEST 7: Sliding-Window Peak Detection
+// ============================================================================
+
+void testPeakDetectorSlidingMax(TestResults& results) {
+    std::vector<float> signal(5000);
+    unsigned seed = 12345;
+    for (size_t i = 0; i < signal.size(); ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        float noise = (seed >> 8) / float(1 << 24) - 0.5f;
+        signal[i] = noise * (0.2f + 0.8f * std::abs(std::sin(0.002f * i)));
+    }
+    
+    bool matches = true;
+    for (float lookAheadMs : {0.01f, 0.2f, 5.0f}) {
+        PeakDetector detector(44100.0f, lookAheadMs);
+        size_t window = detector.getLookAheadSamples();
+        for (size_t i = 0; i < signal.size(); ++i) {
+            detector.processSample(signal[i]);
+            float expected = 0.0f;
+            for (size_t k = (i + 1 > window ? i + 1 - window : 0); k <= i; ++k) {
+                expected = std::max(expected, std::abs(signal[k]));
+            }
+            matches = matches && detector.getPeakLinear() == expected;
+        }
+    }
+    
+    if (matches) {
+        results.pass("Peak Detector: Sliding Max Matches Full Scan");
+    } else {
+        results.fail("Peak Detector: Sliding Max", "Deque max differs from window scan");
+    }
+    
+    PeakDetector perSample(96000.0f, 5.0f), block(96000.0f, 5.0f);
+    std::vector<float> blockDb(signal.size());
+    block.processBlock(signal.data(), blockDb.data(), 1000);
+    block.processBlock(signal.data() + 1000, blockDb.data() + 1000, signal.size() - 1000);
+    float maxDiff = 0.0f;
+    for (size_t i = 0; i < signal.size(); ++i) {
+        maxDiff = std::max(maxDiff, std::abs(perSample.processSample(signal[i]) - blockDb[i]));
+    }
+    
+    if (maxDiff == 0.0f && block.getPeakDb() == perSample.getPeakDb()) {
+        results.pass("Peak Detector: processBlock == processSample");
+    } else {
+        results.fail("Peak Detector: processBlock", "Max difference " + std::to_string(maxDiff) + " dB");
+    }
+}
+
+// ============================================================================
+// TEST 8: Block Gain Computer
+// ============================================================================
+
+void testCompressorBlockGainComputer(TestResults& results) {
+    // Bursts, decays and silence so both flat and moving segments occur
+    std::vector<float> signal(20000);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        float env = (i / 2500) % 2 == 0 ? 0.9f : 0.05f;
+        signal[i] = env * std::sin(0.05f * i) * (i > 17000 ? 0.0f : 1.0f);
+    }
+    
+    Compressor perSample(44100.0f), block(44100.0f);
+    CompressorConfig config(-18.0f, 6.0f, 5.0f, 80.0f);
+    config.makeupGainDb = 4.0f;
+    perSample.configure(config);
+    block.configure(config);
+    
+    std::vector<float> out(signal.size());
+    size_t pos = 0;
+    for (size_t n : {100u, 37u, 4096u, 15767u}) {
+        block.processBlock(signal.data() + pos, out.data() + pos, n);
+        pos += n;
+    }
+    
+    // 1e-3 dB is ~1.2e-4 relative
+    float maxErr = 0.0f;
+    for (size_t i = 0; i < signal.size(); ++i) {
+        float expected = perSample.process(signal[i]);
+        maxErr = std::max(maxErr, std::abs(out[i] - expected) / std::max(std::abs(signal[i]), 1e-3f));
+    }
+    
+    if (maxErr < 5e-4f && std::abs(block.getGainReductionDb() - perSample.getGainReductionDb()) < 1e-2f) {
+        results.pass("Compressor: Block Gain Computer Matches process()");
+    } else {
+        results.fail("Compressor: Block Gain Computer", "Max relative error " + std::to_string(maxErr));
+    }
+    
+    Limiter limiter(44100.0f, -3.0f);
+    std::vector<float> hot(4096), limited(hot.size());
+    for (size_t i = 0; i < hot.size(); ++i) hot[i] = 2.0f * std::sin(0.01f * i);
+    limiter.processBlock(hot.data(), limited.data(), hot.size());
+    float ceiling = std::pow(10.0f, -3.0f / 20.0f);
+    float maxOut = 0.0f;
+    for (float v : limited) maxOut = std::max(maxOut, std::abs(v));
+    
+    if (maxOut <= ceiling + 1e-6f) {
+        results.pass("Limiter: processBlock Holds Ceiling");
+    } else {
+        results.fail("Limiter: processBlock", "Peak " + std::to_string(maxOut));
+    }
+    
+    // Fused output stage vs per-sample compressor -> limiter -> makeup
+    for (int mode = 0; mode < 3; ++mode) {
+        OutputStage stageSample(44100.0f), stageBlock(44100.0f);
+        for (OutputStage* stage : {&stageSample, &stageBlock}) {
+            stage->setMakeupGain(2.0f);
+            stage->setCompressorEnabled(mode != 1);
+            stage->setLimiterEnabled(mode != 2);
+        }
+        std::vector<float> fused(signal.size());
+        stageBlock.processBlock(signal.data(), fused.data(), 3000);
+        stageBlock.processBlock(signal.data() + 3000, fused.data() + 3000, signal.size() - 3000);
+        
+        maxErr = 0.0f;
+        for (size_t i = 0; i < signal.size(); ++i) {
+            float expected = stageSample.process(signal[i]);
+            maxErr = std::max(maxErr, std::abs(fused[i] - expected) / std::max(std::abs(signal[i]), 1e-3f));
+        }
+        
+        const char* names[] = {"Comp+Limit", "Limit Only", "Comp Only"};
+        if (maxErr < 1e-3f) {
+            results.pass(std::string("Output Stage: Fused processBlock (") + names[mode] + ")");
+        } else {
+            results.fail(std::string("Output Stage: Fused processBlock (") + names[mode] + ")",
+                         "Max relative error " + std::to_string(maxErr));
+        }
+    }
+}
+
+// ============================================================================
+// TEST 9: Block / Sidechain Noise Gate
+// ============================================================================
+
+void testNoiseGateBlockAndSidechain(TestResults& results) {
+    std::vector<float> signal(8000);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        float level = (i / 2000) % 2 == 0 ? 0.3f : 0.0005f;
+        signal[i] = level * std::sin(0.06f * i);
+    }
+    
+    // Decimation 1: block path is the per-sample gate
+    NoiseGate perSample(44100.0f), block(44100.0f);
+    perSample.setThreshold(-40.0f);
+    block.setThreshold(-40.0f);
+    std::vector<float> out(signal.size());
+    block.processBlock(signal.data(), out.data(), signal.size());
+    float maxDiff = 0.0f;
+    for (size_t i = 0; i < signal.size(); ++i) {
+        maxDiff = std::max(maxDiff, std::abs(perSample.process(signal[i]) - out[i]));
+    }
+    if (maxDiff == 0.0f) {
+        results.pass("Noise Gate: processBlock == process() at Audio Rate");
+    } else {
+        results.fail("Noise Gate: processBlock", "Max difference " + std::to_string(maxDiff));
+    }
+    
+    // Control rate: same settled behaviour, gain moves in small ramps
+    NoiseGate decimated(44100.0f);
+    decimated.setThreshold(-40.0f);
+    decimated.setControlDecimation(32);
+    std::vector<float> ones(signal.size(), 1.0f), gainTrace(signal.size());
+    decimated.processBlock(ones.data(), gainTrace.data(), signal.size(), signal.data());
+    float maxStep = 0.0f;
+    for (size_t i = 1; i < gainTrace.size(); ++i) {
+        maxStep = std::max(maxStep, std::abs(gainTrace[i] - gainTrace[i - 1]));
+    }
+    bool openSettled = gainTrace[1900] > 0.99f;
+    bool closedSettled = gainTrace[3900] < 0.05f;
+    if (openSettled && closedSettled && maxStep < 0.05f) {
+        results.pass("Noise Gate: Control-Rate Envelope Opens/Closes Smoothly");
+    } else {
+        results.fail("Noise Gate: Control Rate", "open " + std::to_string(gainTrace[1900]) +
+                     ", closed " + std::to_string(gainTrace[3900]) + ", max step " + std::to_string(maxStep));
+    }
+    
+    // Sidechain: a quiet input passes while the key is loud
+    NoiseGate keyed(44100.0f);
+    keyed.setThreshold(-40.0f);
+    keyed.setControlDecimation(16);
+    std::vector<float> quiet(2000, 0.001f), loudKey(2000, 0.5f), silentKey(2000, 0.0f);
+    std::vector<float> keyedOut(2000), unkeyedOut(2000);
+    keyed.processBlock(quiet.data(), keyedOut.data(), quiet.size(), loudKey.data());
+    keyed.reset();
+    keyed.processBlock(quiet.data(), unkeyedOut.data(), quiet.size(), silentKey.data());
+    if (keyedOut.back() > 0.00099f && unkeyedOut.back() < 1e-6f) {
+        results.pass("Noise Gate: Sidechain Key Controls Gate");
+    } else {
+        results.fail("Noise Gate: Sidechain", "Keyed " + std::to_string(keyedOut.back()) +
+                     ", unkeyed " + std::to_string(unkeyedOut.back()));
+    }
+}
+
+// ============================================================================
+// TEST 10: Block Pipeline
+// ============================================================================
+
+void testPedalBlockPipeline(TestResults& results) {
+    std::vector<float> signal(4096);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = 0.4f * std::sin(0.03f * i) * (i < 2048 ? 1.0f : 0.2f);
+    }
+    
+    // The fused OutputStage block path differs from per-sample by ~1e-3 dB
+    for (int factor : {1, 4}) {
+        MultiStagePedal perSample(44100.0f, 2), block(44100.0f, 2);
+        perSample.setDrive(18.0f);
+        block.setDrive(18.0f);
+        if (factor > 1) {
+            perSample.setOversampling(factor);
+            block.setOversampling(factor);
+        }
+        
+        std::vector<float> out(signal.size());
+        for (size_t offset = 0; offset < signal.size(); offset += 300) {
+            size_t n = std::min<size_t>(300, signal.size() - offset);
+            block.processBlock(signal.data() + offset, out.data() + offset, n);
+        }
+        float maxDiff = 0.0f;
+        for (size_t i = 0; i < signal.size(); ++i) {
+            maxDiff = std::max(maxDiff, std::abs(perSample.process(signal[i]) - out[i]));
+        }
+        std::string name = "Pedal: processBlock Matches process() (" + std::to_string(factor) + "x)";
+        bool metersMatch = std::abs(perSample.getOutputLevel() - block.getOutputLevel()) < 0.1f;
+        if (maxDiff < 1e-3f && metersMatch) {
+            results.pass(name);
+        } else {
+            results.fail(name, "Max difference " + std::to_string(maxDiff));
+        }
+    }
+    
+    // In place, with bypassed stages
+    MultiStagePedal perSample(44100.0f, 1), block(44100.0f, 1);
+    perSample.setBypass("tone", true);
+    block.setBypass("tone", true);
+    std::vector<float> data(signal);
+    block.processBlock(data.data(), data.data(), data.size());
+    float maxDiff = 0.0f;
+    for (size_t i = 0; i < signal.size(); ++i) {
+        maxDiff = std::max(maxDiff, std::abs(perSample.process(signal[i]) - data[i]));
+    }
+    if (maxDiff < 1e-3f) {
+        results.pass("Pedal: In-Place processBlock with Bypass");
+    } else {
+        results.fail("Pedal: In-Place processBlock", "Max difference " + std::to_string(maxDiff));
+    }
+}
+
+// ============================================================================
+// TEST 11: Lock-Free Bypass Mask & Ramps
+// ============================================================================
+
+void testPedalBypassMask(TestResults& results) {
+    MultiStagePedal pedal(44100.0f, 1);
+    pedal.setStageBypassed(PedalStage::ToneStack, true);
+    pedal.setBypass("gate", true);
+    pedal.setStageBypassed(PedalStage::ToneStack, false);
+    StageBypass snapshot = pedal.getBypass();
+    if (pedal.getBypassMask() == stageBit(PedalStage::NoiseGate) && snapshot.noiseGate && !snapshot.toneStack &&
+        pedal.isStageBypassed(PedalStage::NoiseGate)) {
+        results.pass("Bypass Mask: Enum and String APIs Share One Mask");
+    } else {
+        results.fail("Bypass Mask", "Mask " + std::to_string(pedal.getBypassMask()));
+    }
+    
+    // Toggling the clipper mid-stream crossfades instead of stepping
+    auto maxJumpAfterToggle = [](bool block) {
+        MultiStagePedal p(44100.0f, 1);
+        p.setDrive(20.0f);
+        std::vector<float> signal(4096), out(signal.size());
+        for (size_t i = 0; i < signal.size(); ++i) signal[i] = 0.3f * std::sin(0.01f * i);
+        float maxJump = 0.0f;
+        for (size_t offset = 0; offset < signal.size(); offset += 64) {
+            if (offset == 2048) p.setStageBypassed(PedalStage::DiodeClipper, true);
+            if (block) {
+                p.processBlock(signal.data() + offset, out.data() + offset, 64);
+            } else {
+                for (size_t i = offset; i < offset + 64; ++i) out[i] = p.process(signal[i]);
+            }
+        }
+        for (size_t i = 2040; i < 2600; ++i) maxJump = std::max(maxJump, std::abs(out[i] - out[i - 1]));
+        return maxJump;
+    };
+    float jumpSample = maxJumpAfterToggle(false), jumpBlock = maxJumpAfterToggle(true);
+    // Signal slope is ~0.03 * 10 (drive) per sample; an unramped switch jumps by ~1
+    if (jumpSample < 0.1f && jumpBlock < 0.1f) {
+        results.pass("Bypass Ramp: Click-Free Toggle (Sample & Block)");
+    } else {
+        results.fail("Bypass Ramp", "Max jump " + std::to_string(jumpSample) + " / " + std::to_string(jumpBlock));
+    }
+    
+    // Fully bypassed stages are not run
+    MultiStagePedal idle(44100.0f, 1);
+    idle.setStageBypassed(PedalStage::Compressor, true);
+    idle.setStageBypassed(PedalStage::Limiter, true);
+    std::vector<float> loud(2048, 0.9f);
+    idle.processBlock(loud.data(), loud.data(), loud.size());
+    if (idle.getCompressorGainReduction() == 0.0f) {
+        results.pass("Bypass: Bypassed Output Stage Does Not Run");
+    } else {
+        results.fail("Bypass: Output Stage", "Gain reduction " + std::to_string(idle.getCompressorGainReduction()));
+    }
+}
+
+// ============================================================================
+// TEST 12: Queued Preset Switching
+// ============================================================================
+
+void testQueuedPresetSwitching(TestResults& results) {
+    const auto& presets = PresetManager::getDefaultPresets();
+    const auto& snapshots = PresetManager::getDefaultSnapshots();
+    bool compiled = snapshots.size() == presets.size() && &presets == &PresetManager::getDefaultPresets();
+    for (size_t i = 0; compiled && i < presets.size(); ++i) {
+        compiled = snapshots[i].drive == presets[i].drive && snapshots[i].gateThreshold == presets[i].gateThreshold;
+    }
+    if (compiled) {
+        results.pass("Presets: Built Once, Compiled to Snapshots");
+    } else {
+        results.fail("Presets: Snapshots", "Snapshot table does not match presets");
+    }
+    
+    // +6 dB -> -12 dB volume mid-stream: queued switch ramps, direct switch steps
+    PresetSnapshot loud = snapshots[0], soft = snapshots[0];
+    loud.volume = 6.0f;
+    soft.volume = -12.0f;
+    auto maxJumpAtSwitch = [&](bool queued) {
+        MultiStagePedal pedal(44100.0f, 1);
+        PresetManager::applySnapshot(pedal, loud);
+        std::vector<float> out(4096), in(128);
+        for (size_t offset = 0; offset < out.size(); offset += in.size()) {
+            if (offset == 2048) {
+                if (queued) pedal.queuePreset(soft);
+                else PresetManager::applySnapshot(pedal, soft);
+            }
+            for (size_t i = 0; i < in.size(); ++i) in[i] = 0.1f * std::sin(0.005f * (offset + i));
+            pedal.processBlock(in.data(), out.data() + offset, in.size());
+        }
+        float maxJump = 0.0f;
+        for (size_t i = 2040; i < 2400; ++i) maxJump = std::max(maxJump, std::abs(out[i] - out[i - 1]));
+        return maxJump;
+    };
+    float queuedJump = maxJumpAtSwitch(true), directJump = maxJumpAtSwitch(false);
+    if (queuedJump < 0.25f * directJump) {
+        results.pass("Presets: Queued Switch Is Smoothed");
+    } else {
+        results.fail("Presets: Queued Switch", "Max jump " + std::to_string(queuedJump) +
+                     " vs direct " + std::to_string(directJump));
+    }
+    
+    // Bounded queue, drained at the next block
+    MultiStagePedal pedal(44100.0f, 1);
+    size_t accepted = 0;
+    for (int i = 0; i < 20; ++i) accepted += pedal.queuePreset(snapshots[i % snapshots.size()]) ? 1 : 0;
+    float sample = 0.0f;
+    pedal.processBlock(&sample, &sample, 1);
+    bool drained = pedal.queuePreset(snapshots[0]);
+    if (accepted == 8 && drained) {
+        results.pass("Presets: Bounded Lock-Free Queue");
+    } else {
+        results.fail("Presets: Queue", "Accepted " + std::to_string(accepted));
+    }
+}
+
+// ============================================================================
+// TEST 13: Block-Rate Metering
+// ============================================================================
+
+void testBlockRateMetering(TestResults& results) {
+    const int period = MultiStagePedal::METER_PERIOD;
+    std::vector<float> sine(4 * period);
+    for (size_t i = 0; i < sine.size(); ++i) sine[i] = 0.5f * std::sin(2.0f * 3.14159265f * i / 64.0f);
+    
+    // Nothing is published until a metering block completes
+    MultiStagePedal perSample(44100.0f, 1);
+    for (int i = 0; i < period - 1; ++i) perSample.process(sine[i]);
+    bool deferred = perSample.getInputLevel() == -80.0f;
+    perSample.process(sine[period - 1]);
+    bool published = perSample.getInputLevel() > -80.0f;
+    if (deferred && published) {
+        results.pass("Metering: Published Once per Metering Block");
+    } else {
+        results.fail("Metering: Publishing", "Level " + std::to_string(perSample.getInputLevel()));
+    }
+    
+    // Peak and RMS of a 0.5 sine: -6.0 dB and -9.0 dB
+    MultiStagePedal block(44100.0f, 1);
+    block.processBlock(sine.data(), sine.data(), period);
+    float peakDb = block.getInputLevel(), rmsDb = block.getInputRms();
+    if (std::abs(peakDb + 6.02f) < 0.1f && std::abs(rmsDb + 9.03f) < 0.1f) {
+        results.pass("Metering: Block Peak & RMS");
+    } else {
+        results.fail("Metering: Peak/RMS", "Peak " + std::to_string(peakDb) + " dB, RMS " + std::to_string(rmsDb) + " dB");
+    }
+    
+    // Heavy drive: cascade output peak well below its input peak
+    MultiStagePedal driven(44100.0f, 1);
+    driven.setDrive(18.0f);
+    std::vector<float> quiet(period, 0.2f);
+    driven.processBlock(quiet.data(), quiet.data(), quiet.size());
+    if (driven.getClipperGainReduction() < -3.0f) {
+        results.pass("Metering: Clipper Gain Reduction from Block Peaks");
+    } else {
+        results.fail("Metering: Clipper GR", std::to_string(driven.getClipperGainReduction()) + " dB");
+    }
+}
+
+// ============================================================================
+// TEST 14: Multi-Instance Engine
+// ============================================================================
+
+void testMultiPedalEngine(TestResults& results) {
+    const size_t instances = 11;  // One full lane group plus a partial one
+    const size_t length = 2048;
+    const auto& snapshots = PresetManager::getDefaultSnapshots();
+    
+    MultiPedalEngine engine(instances, 44100.0f, 2);
+    std::vector<std::unique_ptr<MultiStagePedal>> reference;
+    std::vector<std::vector<float>> input(instances, std::vector<float>(length)), output(input);
+    std::vector<const float*> inPtrs;
+    std::vector<float*> outPtrs;
+    for (size_t v = 0; v < instances; ++v) {
+        PresetSnapshot snapshot = snapshots[v % snapshots.size()];
+        snapshot.presence = 0.0f;  // Not part of the tone cascade
+        engine.applySnapshot(v, snapshot);
+        reference.push_back(std::make_unique<MultiStagePedal>(44100.0f, 2));
+        PresetManager::applySnapshot(*reference.back(), snapshot);
+        for (size_t i = 0; i < length; ++i) {
+            input[v][i] = (0.1f + 0.05f * v) * std::sin(0.01f * (v + 1) * i);
+        }
+        inPtrs.push_back(input[v].data());
+        outPtrs.push_back(output[v].data());
+    }
+    
+    for (size_t offset = 0; offset < length; offset += 256) {
+        std::vector<const float*> in(instances);
+        std::vector<float*> out(instances);
+        for (size_t v = 0; v < instances; ++v) {
+            in[v] = inPtrs[v] + offset;
+            out[v] = outPtrs[v] + offset;
+        }
+        engine.processBlock(in.data(), out.data(), 256);
+    }
+    
+    float maxDiff = 0.0f;
+    std::vector<float> expected(length);
+    for (size_t v = 0; v < instances; ++v) {
+        reference[v]->processBlock(input[v].data(), expected.data(), length);
+        for (size_t i = 0; i < length; ++i) {
+            maxDiff = std::max(maxDiff, std::abs(expected[i] - output[v][i]));
+        }
+    }
+    if (engine.getNumGroups() == 2 && maxDiff < 1e-4f) {
+        results.pass("Multi-Instance Engine Matches MultiStagePedal (11 voices)");
+    } else {
+        results.fail("Multi-Instance Engine", "Max difference " + std::to_string(maxDiff));
+    }
+}
+
+// ============================================================================
+// TEST 15: Silence Sleep
+// ============================================================================
+
+void testSilenceSleep(TestResults& results) {
+    // A burst, then silence: the tail rings out before the chain sleeps
+    MultiStagePedal pedal(44100.0f, 1);
+    std::vector<float> burst(2048), silence(256, 0.0f);
+    for (size_t i = 0; i < burst.size(); ++i) burst[i] = 0.4f * std::sin(0.03f * i);
+    pedal.processBlock(burst.data(), burst.data(), burst.size());
+    
+    bool awakeAfterBurst = !pedal.isSleeping();
+    int blocksToSleep = 0;
+    while (!pedal.isSleeping() && blocksToSleep < 400) {
+        std::fill(silence.begin(), silence.end(), 0.0f);
+        pedal.processBlock(silence.data(), silence.data(), silence.size());
+        ++blocksToSleep;
+    }
+    int holdBlocks = static_cast<int>(44100.0f * MultiStagePedal::SLEEP_HOLD_MS * 0.001f) / 256;
+    if (awakeAfterBurst && pedal.isSleeping() && blocksToSleep >= holdBlocks) {
+        results.pass("Sleep: Enters After Tail Decays (" + std::to_string(blocksToSleep) + " blocks)");
+    } else {
+        results.fail("Sleep: Entry", "Sleeping " + std::to_string(pedal.isSleeping()) + " after " +
+                     std::to_string(blocksToSleep) + " blocks");
+    }
+    
+    // Wakes within the block that carries signal, matching a pedal started from rest
+    MultiStagePedal fresh(44100.0f, 1);
+    std::vector<float> note(512), woken(note.size()), reference(note.size());
+    for (size_t i = 0; i < note.size(); ++i) note[i] = (i < 100) ? 0.0f : 0.3f * std::sin(0.02f * i);
+    pedal.processBlock(note.data(), woken.data(), note.size());
+    fresh.processBlock(note.data(), reference.data(), note.size());
+    float maxDiff = 0.0f;
+    for (size_t i = 0; i < note.size(); ++i) maxDiff = std::max(maxDiff, std::abs(woken[i] - reference[i]));
+    if (!pedal.isSleeping() && maxDiff < 1e-5f) {
+        results.pass("Sleep: Wakes Instantly on Signal");
+    } else {
+        results.fail("Sleep: Wake", "Max difference from fresh pedal " + std::to_string(maxDiff));
+    }
+    
+    // Disabled: never sleeps
+    MultiStagePedal awake(44100.0f, 1);
+    awake.setSleepEnabled(false);
+    std::vector<float> zeros(44100, 0.0f);
+    awake.processBlock(zeros.data(), zeros.data(), zeros.size());
+    if (!awake.isSleeping()) {
+        results.pass("Sleep: Disabled Keeps Processing");
+    } else {
+        results.fail("Sleep: Disable", "Pedal slept with sleep disabled");
+    }
+}
+
+// ============================================================================
+// TEST 16: Background Table Rebuild
+// ============================================================================
+
+void testBackgroundTableRebuild(TestResults& results) {
+    using Stage = Nonlinear::DiodeClippingStage;
+    const auto diode = Nonlinear::DiodeCharacteristics::Si1N4148();
+    
+    // Requested load waits for its table, then matches a stage built for it
+    Stage live(diode, Stage::TopologyType::BackToBackDiodes, 10000.0f);
+    Stage target(diode, Stage::TopologyType::BackToBackDiodes, 2200.0f);
+    live.setAntiAliasingMode(Stage::AntiAliasingMode::ADAA1);
+    target.setAntiAliasingMode(Stage::AntiAliasingMode::ADAA1);
+    
+    std::vector<float> input(512), out(input.size()), ref(input.size());
+    for (size_t i = 0; i < input.size(); ++i) input[i] = 2.0f * std::sin(0.05f * i);
+    
+    live.requestLoadImpedance(2200.0f);
+    live.processBlock(input.data(), out.data(), 128);
+    target.processBlock(input.data(), ref.data(), 128);
+    bool waited = live.needsTableRebuild() && live.getLoadImpedance() == 10000.0f;
+    
+    bool published = live.rebuildTables();
+    bool heldBack = !live.rebuildTables();
+    live.processBlock(input.data() + 128, out.data() + 128, input.size() - 128);
+    target.processBlock(input.data() + 128, ref.data() + 128, input.size() - 128);
+    
+    float settledDiff = 0.0f, maxStep = 0.0f;
+    for (size_t i = 128 + Stage::TABLE_CROSSFADE; i < input.size(); ++i) settledDiff = std::max(settledDiff, std::abs(out[i] - ref[i]));
+    for (size_t i = 1; i < input.size(); ++i) maxStep = std::max(maxStep, std::abs(out[i] - out[i - 1]));
+    if (waited && published && heldBack && settledDiff < 1e-6f && !live.needsTableRebuild() && live.rebuildTables()) {
+        results.pass("Tables: Swapped at Block Boundary After Build");
+    } else {
+        results.fail("Tables: Stage Swap", "waited " + std::to_string(waited) + ", published " + std::to_string(published) +
+                     ", settled diff " + std::to_string(settledDiff));
+    }
+    if (maxStep < 0.2f) {
+        results.pass("Tables: Crossfade Without Step (max " + std::to_string(maxStep) + ")");
+    } else {
+        results.fail("Tables: Crossfade", "Max sample step " + std::to_string(maxStep));
+    }
+    
+    // Pedal: rebuilt on the shared worker while blocks keep running
+    {
+        MultiStagePedal pedal(44100.0f, 2);
+        pedal.setClipperAntiAliasing(Stage::AntiAliasingMode::ADAA2);
+        std::vector<float> block(256);
+        pedal.setClipperImpedance(4700.0f);
+        bool finite = true;
+        int blocks = 0;
+        for (; blocks < 2000 && pedal.getClipperImpedance() != 4700.0f; ++blocks) {
+            for (size_t i = 0; i < block.size(); ++i) block[i] = 0.5f * std::sin(0.02f * (blocks * 256 + i));
+            pedal.processBlock(block.data(), block.data(), block.size());
+            for (float x : block) finite = finite && std::isfinite(x);
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+        if (pedal.getClipperImpedance() == 4700.0f && finite) {
+            results.pass("Tables: Pedal Picks Up Worker Table (" + std::to_string(blocks) + " blocks)");
+        } else {
+            results.fail("Tables: Pedal", "Clipper load still " + std::to_string(pedal.getClipperImpedance()));
+        }
+        
+        // Destroyed with a rebuild still queued: the job is cancelled first
+        pedal.setClipperImpedance(1000.0f);
+    }
+    results.pass("Tables: Pedal Destroyed With Pending Rebuild");
+    
+    // Audio stopped with a table unadopted: the next rebuild parks instead of
+    // keeping the worker busy, and goes through once blocks run again
+    {
+        auto& worker = LiveSpiceDSP::TableRebuildWorker::shared();
+        MultiStagePedal pedal(44100.0f, 2);
+        pedal.setClipperAntiAliasing(Stage::AntiAliasingMode::ADAA1);
+        pedal.setClipperImpedance(4700.0f);
+        worker.waitIdle();
+        pedal.setClipperImpedance(1000.0f);
+        
+        auto idle = std::make_shared<std::atomic<bool>>(false);
+        std::thread waiter([&worker, idle] { worker.waitIdle(); idle->store(true); });
+        for (int i = 0; i < 200 && !idle->load(); ++i) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        const bool returned = idle->load();
+        if (returned) waiter.join();
+        else waiter.detach();
+        
+        std::vector<float> block(256);
+        int blocks = 0;
+        for (; blocks < 2000 && pedal.getClipperImpedance() != 1000.0f; ++blocks) {
+            for (size_t i = 0; i < block.size(); ++i) block[i] = 0.5f * std::sin(0.02f * (blocks * 256 + i));
+            pedal.processBlock(block.data(), block.data(), block.size());
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+        if (returned && pedal.getClipperImpedance() == 1000.0f) {
+            results.pass("Tables: Parked Rebuild Resumes With Audio (" + std::to_string(blocks) + " blocks)");
+        } else {
+            results.fail("Tables: Parked Rebuild", std::string(returned ? "" : "waitIdle() blocked, ") +
+                         "clipper load " + std::to_string(pedal.getClipperImpedance()));
+        }
+    }
+}
+
+// ============================================================================
+// Timing Mode (--timing[=SECONDS])
+// ============================================================================
+
+/**
+ * Render a long signal through the full pedal at each sample rate and
+ * block size, timing every processBlock() call. The block period is the
+ * deadline a host gives the callback; the tail of the block-time
+ * distribution, not the mean, is what produces dropouts.
+ */
+void runTimingMode(double seconds, int oversampling) {
+    const float sampleRates[] = {44100.0f, 48000.0f, 96000.0f, 192000.0f};
+    const size_t blockSizes[] = {16, 32, 64, 128, 256, 512, 1024, 2048};
+
+    std::cout << "Rendering " << seconds << " s per configuration, 2 clipper stages, "
+              << oversampling << "x oversampling\n\n";
+    std::cout << std::setw(8) << "Rate" << std::setw(7) << "Block" << std::setw(11) << "Period us"
+              << std::setw(11) << "x RT" << std::setw(11) << "Mean us" << std::setw(11) << "p99.9 us"
+              << std::setw(11) << "Max us" << std::setw(9) << "Misses" << "\n";
+    std::cout << std::string(79, '-') << "\n";
+
+    for (float sampleRate : sampleRates) {
+        // Plucked note: decaying 110 Hz fundamental and harmonics, re-struck every 500 ms
+        std::vector<float> signal(static_cast<size_t>(seconds * sampleRate));
+        for (size_t i = 0; i < signal.size(); ++i) {
+            float t = static_cast<float>(i) / sampleRate;
+            float envelope = std::exp(-4.0f * std::fmod(t, 0.5f));
+            signal[i] = 0.4f * envelope * (std::sin(2.0f * 3.14159265f * 110.0f * t) +
+                                           0.3f * std::sin(2.0f * 3.14159265f * 330.0f * t));
+        }
+        
+        for (size_t blockSize : blockSizes) {
+            MultiStagePedal pedal(sampleRate, 2);
+            pedal.setDrive(18.0f);
+            if (oversampling > 1) pedal.setOversampling(oversampling);
+            
+            std::vector<float> out(blockSize);
+            
+            // Warm up on the first 100 ms
+            size_t warmup = static_cast<size_t>(0.1f * sampleRate);
+            for (size_t offset = 0; offset + blockSize <= warmup; offset += blockSize) {
+                pedal.processBlock(signal.data() + offset, out.data(), blockSize);
+            }
+            pedal.reset();
+            
+            std::vector<double> blockUs;
+            blockUs.reserve(signal.size() / blockSize);
+            double totalUs = 0.0;
+            for (size_t offset = 0; offset + blockSize <= signal.size(); offset += blockSize) {
+                auto start = std::chrono::steady_clock::now();
+                pedal.processBlock(signal.data() + offset, out.data(), blockSize);
+                auto end = std::chrono::steady_clock::now();
+                double us = std::chrono::duration<double, std::micro>(end - start).count();
+                blockUs.push_back(us);
+                totalUs += us;
+            }
+            if (blockUs.empty()) continue;
+            
+            double periodUs = 1e6 * blockSize / sampleRate;
+            size_t misses = std::count_if(blockUs.begin(), blockUs.end(),
+                                          [periodUs](double us) { return us > periodUs; });
+            double meanUs = totalUs / blockUs.size();
+            double realTime = periodUs * blockUs.size() / totalUs;
+            
+            size_t tail = std::min(blockUs.size() - 1, static_cast<size_t>(0.999 * (blockUs.size() - 1) + 0.5));
+            std::nth_element(blockUs.begin(), blockUs.begin() + tail, blockUs.end());
+            double p999Us = blockUs[tail];
+            double maxUs = *std::max_element(blockUs.begin() + tail, blockUs.end());
+            
+            std::cout << std::fixed << std::setw(8) << std::setprecision(0) << sampleRate
+                      << std::setw(7) << blockSize << std::setw(11) << std::setprecision(1) << periodUs
+                      << std::setw(11) << std::setprecision(1) << realTime
+                      << std::setw(11) << std::setprecision(2) << meanUs
+                      << std::setw(11) << p999Us << std::setw(11) << maxUs
+                      << std::setw(9) << misses << "\n";
+        }
+    }
+    std::cout << "\nx RT: audio duration / processing time. Misses: blocks that took longer than their period.\n";
+}
+
+// ============================================================================
+// TEST 17: Control-Rate Paths
+// ============================================================================
+
+void testControlRatePaths(TestResults& results) {
+    // Per-sample and block ramps take the same control points
+    ControlRamp perSample(32, 0.0f), block(32, 0.0f);
+    std::vector<float> values(300), ones(300, 1.0f);
+    int computed = 0;
+    auto compute = [&computed] { return static_cast<float>(++computed % 3); };
+    for (auto& v : values) v = perSample.next(compute);
+    const int perSampleCalls = computed;
+    computed = 0;
+    block.multiply(ones.data(), 100, compute);
+    block.multiply(ones.data() + 100, 200, compute);
+    bool rampsMatch = ones == values && computed == perSampleCalls && computed == 300 / 32;
+    
+    // A pushed target is reached at the end of the period after it was set
+    ControlRamp pushed(16, 0.0f);
+    pushed.setTarget(1.0f);
+    for (int i = 0; i < 16; ++i) pushed.next();
+    const float held = pushed.getValue();
+    for (int i = 0; i < 16; ++i) pushed.next();
+    bool reachesTarget = held == 0.0f && std::abs(pushed.getValue() - 1.0f) < 1e-6f && !pushed.isRamping();
+    if (rampsMatch && reachesTarget) {
+        results.pass("Control Ramp: Per-Sample == Block, One-Period Ramps");
+    } else {
+        results.fail("Control Ramp", "match " + std::to_string(rampsMatch) + ", held " + std::to_string(held) +
+                     ", value " + std::to_string(pushed.getValue()));
+    }
+    
+    // Gate at control rate: process() is the block path one sample at a time
+    std::vector<float> signal(6000);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = ((i / 1500) % 2 == 0 ? 0.3f : 0.0005f) * std::sin(0.06f * i);
+    }
+    NoiseGate sampleGate(44100.0f), blockGate(44100.0f);
+    for (auto* gate : {&sampleGate, &blockGate}) {
+        gate->setThreshold(-40.0f);
+        gate->setControlDecimation(32);
+    }
+    std::vector<float> gated(signal.size());
+    blockGate.processBlock(signal.data(), gated.data(), 1000);
+    blockGate.processBlock(signal.data() + 1000, gated.data() + 1000, signal.size() - 1000);
+    float maxDiff = 0.0f;
+    for (size_t i = 0; i < signal.size(); ++i) {
+        maxDiff = std::max(maxDiff, std::abs(sampleGate.process(signal[i]) - gated[i]));
+    }
+    if (maxDiff == 0.0f) {
+        results.pass("Noise Gate: process() == processBlock at Control Rate");
+    } else {
+        results.fail("Noise Gate: Control-Rate process()", "Max difference " + std::to_string(maxDiff));
+    }
+    
+    // Pedal: control interval reaches the gate; the audio path is unchanged
+    MultiStagePedal audioRate(44100.0f), controlRate(44100.0f);
+    controlRate.setControlInterval(32);
+    float maxOut = 0.0f, maxRef = 0.0f;
+    for (size_t i = 0; i < 1500; ++i) {
+        maxOut = std::max(maxOut, std::abs(controlRate.process(signal[i])));
+        maxRef = std::max(maxRef, std::abs(audioRate.process(signal[i])));
+    }
+    if (controlRate.getControlInterval() == 32 && audioRate.getControlInterval() == 1 &&
+        std::isfinite(maxOut) && std::abs(maxOut - maxRef) < 0.1f * maxRef) {
+        results.pass("Pedal: Control Interval Runs Gate at Control Rate");
+    } else {
+        results.fail("Pedal: Control Interval", "peak " + std::to_string(maxOut) + " vs " + std::to_string(maxRef));
+    }
+}
+
+// ============================================================================
+// TEST 18: Detector Modes & Latency
+// ============================================================================
+
+void testDetectorModesAndLatency(TestResults& results) {
+    using DetectorMode = CompressorConfig::DetectorMode;
+    std::vector<float> burst(6000);
+    for (size_t i = 0; i < burst.size(); ++i) {
+        burst[i] = (i >= 3000 ? 0.9f : 0.01f) * std::sin(0.05f * i);
+    }
+    
+    // Lookahead: the output is the input delayed by the reported latency
+    Compressor transparent(44100.0f), transparentBlock(44100.0f);
+    for (auto* comp : {&transparent, &transparentBlock}) {
+        comp->setThreshold(20.0f);
+        comp->setDetectorMode(DetectorMode::Lookahead);
+    }
+    const size_t latency = transparent.getLatencySamples();
+    std::vector<float> blockOut(burst.size());
+    transparentBlock.processBlock(burst.data(), blockOut.data(), 1000);
+    transparentBlock.processBlock(burst.data() + 1000, blockOut.data() + 1000, burst.size() - 1000);
+    float maxErr = 0.0f;
+    for (size_t i = 0; i < burst.size(); ++i) {
+        float expected = i >= latency ? burst[i - latency] : 0.0f;
+        float out = transparent.process(burst[i]);
+        if (i < 5000) continue;   // Envelope starts at -80 dB and needs to recover first
+        maxErr = std::max(maxErr, std::abs(out - expected));
+        maxErr = std::max(maxErr, std::abs(blockOut[i] - expected));
+    }
+    if (latency == PeakDetector(44100.0f).getLookAheadSamples() - 1 && maxErr < 1e-3f) {
+        results.pass("Lookahead: Output Delayed by Reported Latency (" + std::to_string(latency) + ")");
+    } else {
+        results.fail("Lookahead: Latency", "latency " + std::to_string(latency) + ", error " + std::to_string(maxErr));
+    }
+    
+    // Lookahead: gain reduction is under way when the burst reaches the output
+    Compressor window(44100.0f), lookahead(44100.0f);
+    lookahead.setDetectorMode(DetectorMode::Lookahead);
+    float windowGrAtOnset = 0.0f, lookaheadGrAtOnset = 0.0f;
+    for (size_t i = 0; i < burst.size(); ++i) {
+        window.process(burst[i]);
+        lookahead.process(burst[i]);
+        if (i == 3000) windowGrAtOnset = window.getGainReductionDb();
+        if (i == 3000 + latency) lookaheadGrAtOnset = lookahead.getGainReductionDb();
+    }
+    if (lookaheadGrAtOnset < windowGrAtOnset - 0.5f && window.getLatencySamples() == 0) {
+        results.pass("Lookahead: Gain Reduction Leads the Peak");
+    } else {
+        results.fail("Lookahead: Leading Gain", "window " + std::to_string(windowGrAtOnset) +
+                     " dB, lookahead " + std::to_string(lookaheadGrAtOnset) + " dB");
+    }
+    
+    // Zero latency: inter-sample peaks seen, full reduction on the onset sample
+    PeakDetector truePeak(44100.0f);
+    truePeak.setMode(PeakDetector::Mode::TruePeak);
+    float samplePeak = 0.0f, estimate = 0.0f;
+    for (size_t i = 0; i < 64; ++i) {
+        float x = std::sin(1.5707963f * i + 0.7853982f);   // fs/4: samples at +-0.707
+        samplePeak = std::max(samplePeak, std::abs(x));
+        truePeak.processSample(x);
+        if (i >= 3) estimate = std::max(estimate, truePeak.getPeakLinear());
+    }
+    Compressor zeroLatency(44100.0f);
+    zeroLatency.setDetectorMode(DetectorMode::ZeroLatency);
+    for (int i = 0; i < 44100; ++i) zeroLatency.process(0.0f);
+    const float onset = zeroLatency.process(1.0f);
+    const float expectedGr = -(20.0f * (1.0f - 1.0f / 4.0f));   // 0 dBFS over -20 dB at 4:1
+    if (estimate > 0.88f && samplePeak < 0.71f && zeroLatency.getLatencySamples() == 0 &&
+        std::abs(zeroLatency.getGainReductionDb() - expectedGr) < 1e-3f && onset < 0.2f) {
+        results.pass("Zero Latency: True Peak and Instant Attack");
+    } else {
+        results.fail("Zero Latency", "estimate " + std::to_string(estimate) + ", onset gain reduction " +
+                     std::to_string(zeroLatency.getGainReductionDb()) + " dB");
+    }
+    
+    // Pedal: lookahead latency reported to the host, blocks match samples
+    MultiStagePedal samplePedal(44100.0f), blockPedal(44100.0f);
+    const float baseLatency = samplePedal.getLatencySamples();
+    for (auto* pedal : {&samplePedal, &blockPedal}) {
+        pedal->setSleepEnabled(false);
+        pedal->setDynamicsDetectorMode(DetectorMode::Lookahead);
+    }
+    const float lookaheadLatency = samplePedal.getLatencySamples();
+    std::vector<float> pedalOut(burst.size());
+    blockPedal.processBlock(burst.data(), pedalOut.data(), burst.size());
+    float maxDiff = 0.0f;
+    for (size_t i = 0; i < burst.size(); ++i) {
+        maxDiff = std::max(maxDiff, std::abs(samplePedal.process(burst[i]) - pedalOut[i]));
+    }
+    samplePedal.setDynamicsDetectorMode(DetectorMode::ZeroLatency);
+    if (baseLatency == 0.0f && lookaheadLatency == 2.0f * static_cast<float>(latency) &&
+        samplePedal.getLatencySamples() == 0.0f && maxDiff < 1e-2f) {
+        results.pass("Pedal: Lookahead Latency Reported, Block == Sample");
+    } else {
+        results.fail("Pedal: Lookahead", "latency " + std::to_string(lookaheadLatency) +
+                     ", block difference " + std::to_string(maxDiff));
+    }
+}
+
+// ============================================================================
+// TEST 19: Denormal Protection
+// ============================================================================
+
+void testDenormalProtection(TestResults& results) {
+    // Guard: flushes inside, restores the caller's mode outside
+    const bool before = ScopedFlushDenormals::isActive();
+    bool inside = false;
+    {
+        ScopedFlushDenormals noDenormals;
+        inside = ScopedFlushDenormals::isActive();
+    }
+    const bool supported = inside;   // False on targets without a known control register
+    if ((inside || !supported) && ScopedFlushDenormals::isActive() == before) {
+        results.pass("Guard Sets and Restores FTZ/DAZ");
+    } else {
+        results.fail("Guard", "inside " + std::to_string(inside) + ", before " + std::to_string(before));
+    }
+    
+    // Decaying tails end at exactly zero instead of lingering as subnormals
+    BiquadFilter tail;
+    tail.setCoefficients(BiquadFilter::designLowPass(44100.0f, 2000.0f));
+    std::vector<float> buffer(512, 0.0f);
+    buffer[0] = 1.0f;
+    tail.processBlock(buffer.data(), buffer.data(), buffer.size());
+    std::fill(buffer.begin(), buffer.end(), 0.0f);
+    for (int block = 0; block < 400; ++block) tail.processBlock(buffer.data(), buffer.data(), buffer.size());
+    
+    Compressor compressor(44100.0f);
+    std::vector<float> loud(4096), quiet(512, 0.0f);
+    for (size_t i = 0; i < loud.size(); ++i) loud[i] = std::sin(0.05f * i);
+    compressor.processBlock(loud.data(), loud.data(), loud.size());
+    for (int block = 0; block < 2000; ++block) compressor.processBlock(quiet.data(), quiet.data(), quiet.size());
+    
+    const auto state = tail.getState();
+    if (state[0] == 0.0f && state[1] == 0.0f && compressor.getGainReductionDb() == 0.0f) {
+        results.pass("Tails Flush to Zero");
+    } else {
+        results.fail("Tails Flush", "biquad state " + std::to_string(state[0]) + ", gain reduction " +
+                     std::to_string(compressor.getGainReductionDb()));
+    }
+    
+    // Pedal blocks leave the host thread's mode as they found it
+    MultiStagePedal pedal(44100.0f);
+    std::vector<float> audio(1024);
+    for (size_t i = 0; i < audio.size(); ++i) audio[i] = 0.3f * std::sin(0.02f * i);
+    pedal.processBlock(audio.data(), audio.data(), audio.size());
+    bool finite = true;
+    for (float x : audio) finite = finite && std::isfinite(x);
+    if (finite && ScopedFlushDenormals::isActive() == before) {
+        results.pass("Pedal Block Restores Host FPU Mode");
+    } else {
+        results.fail("Pedal Block FPU Mode", "mode left changed or output not finite");
+    }
+}
+
+// ============================================================================
+// TEST 20: Preset Sweep
+// ============================================================================
+
+void testPresetSweep(TestResults& results) {
+    const size_t length = 4096;
+    std::vector<float> input(length), reference(length);
+    for (size_t i = 0; i < length; ++i) {
+        input[i] = 0.3f * std::sin(0.02f * i) + 0.1f * std::sin(0.3f * i);
+    }
+    
+    // Reference: a plain pedal at a point on the grid
+    auto renderAt = [&](const SweepPoint& p, std::vector<float>& out) {
+        MultiStagePedal pedal(44100.0f, 2);
+        pedal.setDrive(p.driveDb);
+        pedal.setVolume(p.levelDb);
+        pedal.getToneStack().setBassGain(p.bassDb);
+        pedal.getToneStack().setMidGain(p.midDb);
+        pedal.getToneStack().setTrebleGain(p.trebleDb);
+        out.resize(length);
+        pedal.processBlock(input.data(), out.data(), length);
+    };
+    const SweepPoint target{12.0f, 3.0f, 0.0f, -3.0f, -6.0f};
+    renderAt(target, reference);
+    
+    // 48 points over three engine passes of 16
+    const auto points = PresetSweep::grid({0.0f, 6.0f, 12.0f, 18.0f}, {0.0f, 3.0f}, {0.0f},
+                                          {-3.0f, 0.0f, 3.0f}, {-6.0f, 0.0f});
+    PresetSweep sweep(44100.0f, 2, 16);
+    auto start = std::chrono::high_resolution_clock::now();
+    const auto losses = sweep.run(points, input.data(), reference.data(), length);
+    double sweepMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    
+    const size_t best = PresetSweep::best(losses);
+    const bool recovered = points[best].driveDb == target.driveDb && points[best].bassDb == target.bassDb
+        && points[best].trebleDb == target.trebleDb && points[best].levelDb == target.levelDb
+        && losses[best].rmsError < 1e-4f && losses[best].correlation > 0.9999f;
+    
+    // Every lane scores what a separate render at its point scores
+    float worstDiff = 0.0f;
+    std::vector<float> single;
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t k = 0; k < points.size(); ++k) {
+        renderAt(points[k], single);
+        double sum = 0.0;
+        for (size_t i = 0; i < length; ++i) {
+            sum += (double) (reference[i] - single[i]) * (reference[i] - single[i]);
+        }
+        const float rms = (float) std::sqrt(sum / length);
+        worstDiff = std::max(worstDiff, std::abs(rms - losses[k].rmsError));
+    }
+    double singleMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    std::cout << "  48 points: " << sweepMs << " ms swept, " << singleMs << " ms rendered one by one\n";
+    
+    if (recovered && worstDiff < 1e-4f && sweep.getMaxPointsPerPass() == 16) {
+        results.pass("Preset Sweep Scores 48 Points and Recovers the Reference Setting");
+    } else {
+        results.fail("Preset Sweep", "recovered " + std::to_string(recovered)
+                     + ", worst RMS difference " + std::to_string(worstDiff));
+    }
+}
+
+// ============================================================================
+// TEST 21: Sub-Block Automation
+// ============================================================================
+
+void testSubBlockAutomation(TestResults& results) {
+    // Cuts at every event offset and every 64 samples; late events land after the block
+    const ParameterEvent events[] = {{0, 0, 1.0f}, {100, 1, 2.0f}, {100, 2, 3.0f}, {150, 3, 4.0f}, {5000, 4, 5.0f}};
+    std::vector<std::pair<size_t, size_t>> chunks;
+    std::vector<uint32_t> applied;
+    forEachSubBlock(300, events, 5, 64,
+        [&](const ParameterEvent& event) { applied.push_back(event.parameter); },
+        [&](size_t start, size_t length) { chunks.emplace_back(start, length); });
+    const std::vector<std::pair<size_t, size_t>> expectedChunks = {{0, 64}, {64, 36}, {100, 50}, {150, 64}, {214, 64}, {278, 22}};
+    if (chunks == expectedChunks && applied == std::vector<uint32_t>{0, 1, 2, 3, 4}) {
+        results.pass("Sub-blocks: split at events and every 64 samples");
+    } else {
+        results.fail("Sub-blocks: split at events and every 64 samples", std::to_string(chunks.size()) + " chunks");
+    }
+
+    std::vector<float> signal(4096);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = 0.3f * std::sin(0.02f * i);
+    }
+
+    // Events land on their sample: the same as stopping the block there and setting the knob
+    MultiStagePedal automated(44100.0f, 1), manual(44100.0f, 1), still(44100.0f, 1);
+    for (auto* pedal : {&automated, &manual, &still}) pedal->setSubBlockSize(64);
+    const ParameterEvent automation[] = {{700, static_cast<uint32_t>(PedalParameter::Drive), 24.0f},
+                                         {1500, static_cast<uint32_t>(PedalParameter::Treble), 6.0f}};
+    std::vector<float> a(signal.size()), m(signal.size()), b(signal.size());
+    automated.processBlock(signal.data(), a.data(), signal.size(), automation, 2);
+    manual.processBlock(signal.data(), m.data(), 700);
+    manual.setParameter(PedalParameter::Drive, 24.0f);
+    manual.processBlock(signal.data() + 700, m.data() + 700, 800);
+    manual.setParameter(PedalParameter::Treble, 6.0f);
+    manual.processBlock(signal.data() + 1500, m.data() + 1500, signal.size() - 1500);
+    still.processBlock(signal.data(), b.data(), signal.size());
+
+    size_t firstChange = signal.size();
+    for (size_t i = 0; i < signal.size() && firstChange == signal.size(); ++i) {
+        if (a[i] != b[i]) firstChange = i;
+    }
+    if (a == m && firstChange == 700 && automated.getSubBlockSize() == 64) {
+        results.pass("Sub-blocks: automation is sample accurate");
+    } else {
+        results.fail("Sub-blocks: automation is sample accurate", "first change at " + std::to_string(firstChange)
+                     + ", matches manual split " + std::to_string(a == m));
+    }
+}
+
+void testMemoryFootprint(TestResults& results) {
+    using AntiAliasingMode = Nonlinear::DiodeClippingStage::AntiAliasingMode;
+    std::vector<float> signal(2048);
+    for (size_t i = 0; i < signal.size(); ++i) {
+        signal[i] = 0.4f * std::sin(0.03f * i);
+    }
+
+    // Compact pedals share their ADAA tables and sound the same
+    MultiStagePedal standard(48000.0f, 2), compactA(48000.0f, 2, MemoryMode::Compact), compactB(48000.0f, 2, MemoryMode::Compact);
+    const size_t tablesBefore = Nonlinear::DiodeClippingStage::cachedAntiderivativeTableCount();
+    for (auto* pedal : {&standard, &compactA, &compactB}) pedal->setClipperAntiAliasing(AntiAliasingMode::ADAA1);
+    const size_t tablesAdded = Nonlinear::DiodeClippingStage::cachedAntiderivativeTableCount() - tablesBefore;
+
+    std::vector<float> s(signal.size()), c(signal.size());
+    standard.processBlock(signal.data(), s.data(), signal.size());
+    compactA.processBlock(signal.data(), c.data(), signal.size());
+
+    const MemoryFootprint big = standard.getMemoryFootprint(), small = compactA.getMemoryFootprint();
+    if (s == c && tablesAdded == 1 && big.instanceBytes() > 4 * small.instanceBytes()
+        && small.sharedBytes > big.sharedBytes && small.instanceBytes() >= sizeof(MultiStagePedal)) {
+        results.pass("Memory: compact pedals share ADAA tables, same output");
+    } else {
+        results.fail("Memory: compact pedals share ADAA tables, same output",
+                     std::to_string(big.instanceBytes()) + " vs " + std::to_string(small.instanceBytes())
+                     + " bytes, " + std::to_string(tablesAdded) + " shared tables");
+    }
+
+    // The look-ahead line exists only in Lookahead mode, and runs the same when it does
+    Compressor full(48000.0f), lean(48000.0f, MemoryMode::Compact);
+    const size_t idleHeap = lean.getMemoryFootprint().heapBytes;
+    full.setDetectorMode(CompressorConfig::DetectorMode::Lookahead);
+    lean.setDetectorMode(CompressorConfig::DetectorMode::Lookahead);
+    std::vector<float> f(signal.size()), l(signal.size());
+    full.processBlock(signal.data(), f.data(), signal.size());
+    lean.processBlock(signal.data(), l.data(), signal.size());
+    if (f == l && idleHeap < full.getMemoryFootprint().heapBytes
+        && lean.getMemoryFootprint().heapBytes == full.getMemoryFootprint().heapBytes) {
+        results.pass("Memory: compact compressor allocates look-ahead on demand");
+    } else {
+        results.fail("Memory: compact compressor allocates look-ahead on demand",
+                     "idle heap " + std::to_string(idleHeap) + ", outputs equal " + std::to_string(f == l));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    double timingSeconds = 0.0;
+    int oversampling = 1;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--timing") {
+            timingSeconds = 10.0;
+        } else if (arg.rfind("--timing=", 0) == 0) {
+            timingSeconds = std::max(0.2, std::atof(arg.c_str() + 9));
+        } else if (arg.rfind("--oversample=", 0) == 0) {
+            oversampling = std::max(1, std::atoi(arg.c_str() + 13));
+        }
+    }
+    if (timingSeconds > 0.0) {
+        runTimingMode(timingSeconds, oversampling);
+        return 0;
+    }
+    
     std::cout << "\n" << std::string(80, '=') << "\n";
     std::cout << "PHASE 3: COMPLETE PEDAL SIMULATION TEST SUITE\n";
     std::cout << "Multi-Stage Integration & Dynamics Processing\n";
@@ -431,6 +1587,7 @@ int main() {
     testPedalCompleteChain(results);
     testPedalBypass(results);
     testPedalClipperCascade(results);
+    testPedalOversampling(results);
     
     // Test 3: Stage Configuration
     std::cout << "\n=== TEST 3: Parameter Control ===\n";
@@ -455,6 +1612,70 @@ int main() {
     testZeroInput(results);
     testStateReset(results);
     
+    // Test 7: Peak Detection
+    std::cout << "\n=== TEST 7: Sliding-Window Peak Detection ===\n";
+    testPeakDetectorSlidingMax(results);
+    
+    // Test 8: Block Gain Computer
+    std::cout << "\n=== TEST 8: Block Gain Computer ===\n";
+    testCompressorBlockGainComputer(results);
+    
+    // Test 9: Noise Gate Block / Sidechain
+    std::cout << "\n=== TEST 9: Block & Sidechain Noise Gate ===\n";
+    testNoiseGateBlockAndSidechain(results);
+    
+    // Test 10: Block Pipeline
+    std::cout << "\n=== TEST 10: Block Pipeline ===\n";
+    testPedalBlockPipeline(results);
+    
+    // Test 11: Bypass Mask
+    std::cout << "\n=== TEST 11: Lock-Free Bypass ===\n";
+    testPedalBypassMask(results);
+    
+    // Test 12: Preset Queue
+    std::cout << "\n=== TEST 12: Queued Preset Switching ===\n";
+    testQueuedPresetSwitching(results);
+    
+    // Test 13: Metering
+    std::cout << "\n=== TEST 13: Block-Rate Metering ===\n";
+    testBlockRateMetering(results);
+    
+    // Test 14: Multi-Instance Engine
+    std::cout << "\n=== TEST 14: Multi-Instance Engine ===\n";
+    testMultiPedalEngine(results);
+    
+    // Test 15: Silence Sleep
+    std::cout << "\n=== TEST 15: Silence Sleep ===\n";
+    testSilenceSleep(results);
+    
+    // Test 16: Background table rebuild
+    std::cout << "\n=== TEST 16: Background Table Rebuild ===\n";
+    testBackgroundTableRebuild(results);
+    
+    // Test 17: Control-rate paths
+    std::cout << "\n=== TEST 17: Control-Rate Paths ===\n";
+    testControlRatePaths(results);
+    
+    // Test 18: Detector modes and latency
+    std::cout << "\n=== TEST 18: Detector Modes & Latency ===\n";
+    testDetectorModesAndLatency(results);
+    
+    // Test 19: Denormal protection
+    std::cout << "\n=== TEST 19: Denormal Protection ===\n";
+    testDenormalProtection(results);
+    
+    // Test 20: Preset sweep
+    std::cout << "\n=== TEST 20: Preset Sweep ===\n";
+    testPresetSweep(results);
+    
+    // Test 21: Sub-block automation
+    std::cout << "\n=== TEST 21: Sub-Block Automation ===\n";
+    testSubBlockAutomation(results);
+    
+    // Test 22: Memory footprint and compact storage
+    std::cout << "\n=== TEST 22: Memory Footprint ===\n";
+    testMemoryFootprint(results);
+    
     results.summary();
     
     return results.failed == 0 ? 0 : 1;
@@ -1,8 +1,13 @@
 #include "TopologyPatterns.h"
+#include "PatternMatchCache.h"
+#include "CircuitAnalyzer.h"
 #include "LiveSpiceParser.h"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
 #include <cassert>
+#include <filesystem>
+#include <sstream>
 
 using namespace TopologyAnalysis;
 using namespace LiveSpice;
@@ -152,6 +157,189 @@ void testThreePointToneStack() {
     std::cout << "\n✓ PASS\n";
 }
 
+void testConnectedBackToBackDiodes() {
+    printHeader("Test 6: Connection-Aware Matching");
+    
+    PatternRegistry registry;
+    std::vector<TopologyAnalysis::Component> components;
+    for (const char* id : {"D1", "D2", "D3"}) {
+        TopologyAnalysis::Component d;
+        d.id = id;
+        d.type = LiveSpice::ComponentType::Diode;
+        components.push_back(d);
+    }
+    TopologyAnalysis::Component r;
+    r.id = "R1";
+    r.type = LiveSpice::ComponentType::Resistor;
+    components.push_back(r);
+    
+    // D3 dangles; D1/D2 are antiparallel across R1
+    std::vector<TopologyAnalysis::Connection> connections = {
+        {"D1", "D2"}, {"D1", "R1"}, {"D2", "R1"}, {"D3", "R1"}};
+    std::vector<PatternMatch> matches;
+    auto findBackToBack = [&]() -> const PatternMatch* {
+        matches = registry.findAllPatterns(components, connections);
+        for (const auto& m : matches) {
+            if (m.pattern->name == "Back-to-Back Diode Clipping") return &m;
+        }
+        return nullptr;
+    };
+    const PatternMatch* match = findBackToBack();
+    
+    std::cout << "Input: 3× Diodes + Resistor, D1-D2-R1 triangle\n";
+    assert(match);
+    std::cout << "Confidence: " << std::fixed << std::setprecision(3) << match->confidence << "\n";
+    printPattern(match->pattern);
+    
+    assert(match->confidence > 0.99f);
+    assert(match->matchedComponents.size() == 3);
+    for (const auto& comp : match->matchedComponents) assert(comp.id != "D3");
+    assert(match->matchedConnections.size() == 3);
+    
+    // Without the D1-D2 edge there is no embedding: type counts only
+    connections.erase(connections.begin());
+    match = findBackToBack();
+    assert(match && match->confidence < 0.99f);
+    
+    // Patterns sharing no type with the circuit are never candidates
+    std::vector<TopologyAnalysis::Component> inductorOnly(1);
+    inductorOnly[0].id = "L1";
+    inductorOnly[0].type = LiveSpice::ComponentType::Inductor;
+    matches = registry.findAllPatterns(inductorOnly, {});
+    for (const auto& m : matches) assert(m.pattern->name == "Passive LC Band-Pass Filter");
+    std::cout << "\n✓ PASS\n";
+}
+
+void testPatternMatchCache() {
+    printHeader("Test 7: Pattern Match Cache");
+    
+    PatternRegistry registry;
+    auto diodePair = [](const std::string& prefix) {
+        std::vector<TopologyAnalysis::Component> components(3);
+        const char* names[] = {"D1", "D2", "R1"};
+        for (int i = 0; i < 3; ++i) {
+            components[i].id = prefix + names[i];
+            components[i].type = i < 2 ? LiveSpice::ComponentType::Diode : LiveSpice::ComponentType::Resistor;
+            components[i].partNumber = i < 2 ? "1N4148" : "";
+            components[i].value = i < 2 ? 0.0f : 4700.0f;
+        }
+        std::vector<TopologyAnalysis::Connection> connections = {
+            {prefix + "D1", prefix + "D2"}, {prefix + "D1", prefix + "R1"}, {prefix + "D2", prefix + "R1"}};
+        return std::make_pair(components, connections);
+    };
+    
+    // Renamed, reordered copies hash alike; a changed value or edge does not
+    auto [components, connections] = diodePair("A_");
+    auto [renamed, renamedConnections] = diodePair("B_");
+    std::reverse(renamed.begin(), renamed.end());
+    std::reverse(renamedConnections.begin(), renamedConnections.end());
+    const uint64_t hash = PatternMatchCache::subcircuitHash(components, connections);
+    assert(PatternMatchCache::subcircuitHash(renamed, renamedConnections) == hash);
+    auto revalued = components;
+    revalued[2].value = 10000.0f;
+    assert(PatternMatchCache::subcircuitHash(revalued, connections) != hash);
+    assert(PatternMatchCache::subcircuitHash(components, {connections[1], connections[2]}) != hash);
+    
+    // Path vs. star over identical labels: same label pairs, different graphs
+    std::vector<TopologyAnalysis::Component> resistors(4);
+    for (int i = 0; i < 4; ++i) {
+        resistors[i].id = "R" + std::to_string(i);
+        resistors[i].type = LiveSpice::ComponentType::Resistor;
+    }
+    assert(PatternMatchCache::subcircuitHash(resistors, {{"R0", "R1"}, {"R1", "R2"}, {"R2", "R3"}}) !=
+           PatternMatchCache::subcircuitHash(resistors, {{"R0", "R1"}, {"R0", "R2"}, {"R0", "R3"}}));
+    
+    PatternMatchCache cache(registry);
+    const PatternMatch first = cache.matchPattern(components, connections);
+    const PatternMatch second = cache.matchPattern(renamed, renamedConnections);
+    const PatternMatch direct = registry.matchPattern(renamed, renamedConnections);
+    assert(cache.getMisses() == 1 && cache.getHits() == 1);
+    assert(first.pattern && second.pattern == direct.pattern && second.confidence == direct.confidence);
+    assert(second.matchedComponents.size() == renamed.size() && second.matchedComponents[0].id == "B_R1");
+    std::cout << "Cached: " << second.pattern->name << " (" << second.confidence << ")\n";
+    
+    // Persisted entries come back for this registry version only
+    const std::string directory = (std::filesystem::temp_directory_path() / "livespice_pattern_cache_test").string();
+    std::filesystem::remove_all(directory);
+    assert(cache.save(directory));
+    PatternMatchCache restored(registry);
+    assert(restored.load(directory) && restored.size() == 1);
+    restored.matchPattern(renamed, renamedConnections);
+    assert(restored.getHits() == 1 && restored.getMisses() == 0);
+    
+    PatternRegistry extended;
+    CircuitPattern custom = *registry.getPattern("Back-to-Back Diode Clipping");
+    custom.name = "Custom Diode Clipper";
+    extended.addPattern(custom);
+    assert(extended.getVersion() != registry.getVersion());
+    PatternMatchCache stale(extended);
+    assert(!stale.load(directory) && stale.size() == 0);
+    std::filesystem::remove_all(directory);
+    std::cout << "\n✓ PASS\n";
+}
+
+/**
+ * Input -> R1 -> C1 -> Output placed on a line. Wired as a chain, or with
+ * R1 and C1 both hanging off the input so they share no node.
+ */
+std::string rcSchematic(bool chained) {
+    const char* symbol = "Circuit.Symbol, Circuit, Version=1.0.0.0, Culture=neutral, PublicKeyToken=null";
+    const char* wire = "Circuit.Wire, Circuit, Version=1.0.0.0, Culture=neutral, PublicKeyToken=null";
+    const char* parts[][3] = {
+        {"Circuit.Input, Circuit", "V1", ""},
+        {"Circuit.Resistor, Circuit", "R1", " Resistance=\"10 k&#937;\""},
+        {"Circuit.Capacitor, Circuit", "C1", " Capacitance=\"10 nF\""},
+        {"Circuit.Output, Circuit", "O1", ""}};
+    std::ostringstream xml;
+    xml << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<Schematic Name=\"RC\">\n";
+    for (int i = 0; i < 4; ++i) {
+        xml << "  <Element Type=\"" << symbol << "\" Position=\"" << 40 * i << ",0\">\n"
+            << "    <Component _Type=\"" << parts[i][0] << "\" Name=\"" << parts[i][1] << "\"" << parts[i][2] << " />\n"
+            << "  </Element>\n";
+    }
+    const int links[][2] = {{0, 1}, {chained ? 1 : 0, 2}, {2, 3}};
+    for (const auto& link : links) {
+        xml << "  <Element Type=\"" << wire << "\" A=\"" << 40 * link[0] << ",0\" B=\"" << 40 * link[1] << ",0\" />\n";
+    }
+    xml << "</Schematic>\n";
+    return xml.str();
+}
+
+void testAnalyzerStageConnectivity() {
+    printHeader("Test 8: Stage Connectivity Through CircuitAnalyzer");
+    
+    // Same parts and values; only the wiring differs
+    const Schematic chained = SchematicParser::parseString(rcSchematic(true));
+    const Schematic split = SchematicParser::parseString(rcSchematic(false));
+    PatternMatchCache cache(PatternRegistry::shared());
+    auto filterStage = [&](const Schematic& schematic) {
+        CircuitAnalyzer analyzer(schematic);
+        analyzer.setPatternMatchCache(&cache);
+        for (const auto& stage : analyzer.analyzeCircuit()) {
+            if (stage.type == StageType::LowPassFilter) return stage;
+        }
+        assert(false && "no filter stage");
+        return CircuitStage();
+    };
+    
+    // R1-C1 embeds the RC pattern's edge only when they are wired together
+    const CircuitStage wired = filterStage(chained);
+    const size_t chainedKeys = cache.size();
+    const CircuitStage unwired = filterStage(split);
+    std::cout << "Chained: " << wired.patternName << " (" << std::fixed << std::setprecision(3)
+              << wired.patternConfidence << ")\n";
+    std::cout << "Split:   " << unwired.patternName << " (" << unwired.patternConfidence << ")\n";
+    assert(wired.patternName == "Passive RC Low-Pass Filter" && wired.patternName == unwired.patternName);
+    assert(wired.patternConfidence > 0.99f && unwired.patternConfidence < 0.99f);
+    
+    // The rewired copy keys its own cache entries: the input stage (V1, C1,
+    // R1) and the filter stage hash differently, the output stage alike
+    assert(cache.size() == chainedKeys + 2);
+    filterStage(chained);
+    assert(cache.size() == chainedKeys + 2);
+    std::cout << "\n✓ PASS\n";
+}
+
 // ============================================================================
 // Main Test Runner
 // ============================================================================
@@ -167,6 +355,9 @@ int main() {
         testSimpleRCLowPass();
         testDiodeClippingCircuit();
         testThreePointToneStack();
+        testConnectedBackToBackDiodes();
+        testPatternMatchCache();
+        testAnalyzerStageConnectivity();
         
         printHeader("ALL TESTS PASSED ✓");
         std::cout << "\nPhase 2: Topology Pattern Matching - COMPLETE\n";
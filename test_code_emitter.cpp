@@ -0,0 +1,362 @@
+#include "CodeEmitter.h"
+#include "JuceDSPGenerator.h"
+#include "SharedContext.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace LiveSpice;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void pass(const std::string& test) {
+        passed++;
+        std::cout << "✓ PASS: " << test << "\n";
+    }
+
+    void fail(const std::string& test, const std::string& reason) {
+        failed++;
+        std::cout << "✗ FAIL: " << test << " - " << reason << "\n";
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+template <typename Fn>
+static double millisecondsOf(Fn fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * A long amp-like chain: coupling filters, gain stages, op-amp gains with
+ * pattern matches and diode clippers, repeated until there are count stages
+ */
+static std::vector<CircuitStage> longChain(size_t count) {
+    std::vector<CircuitStage> stages(count);
+    for (size_t i = 0; i < count; ++i) {
+        CircuitStage& stage = stages[i];
+        stage.name = "Stage block " + std::to_string(i);
+        stage.dspDescription = "Synthetic stage";
+        switch (i % 5) {
+            case 0:
+                stage.type = StageType::HighPassFilter;
+                stage.setParam(StageParam::InputResistance, 1000.0 + static_cast<double>(i));
+                stage.setParam(StageParam::CouplingCapacitance, 1e-8 * static_cast<double>(i % 7 + 1));
+                stage.setParam(StageParam::HighpassFrequency, 20.0 + 0.1 * static_cast<double>(i));
+                stage.patternStrategy = "cascaded_biquad";
+                stage.patternName = "RC High-Pass";
+                stage.patternConfidence = 0.9;
+                break;
+            case 1:
+                stage.type = StageType::LowPassFilter;
+                stage.setParam(StageParam::CutoffFrequency, 5000.0 + static_cast<double>(i) / 3.0);
+                break;
+            case 2:
+                stage.type = StageType::GainStage;
+                stage.setParam(StageParam::GainLinear, 1.0 + static_cast<double>(i) / 7.0);
+                stage.patternStrategy = "op_amp_gain";
+                stage.patternName = "Non-inverting Op-Amp";
+                stage.patternConfidence = 0.85 + 0.001 * static_cast<double>(i % 50);
+                break;
+            case 3:
+                stage.type = StageType::DiodeClipper;
+                stage.patternStrategy = "nonlinear_clipper";
+                stage.patternConfidence = 0.5;
+                break;
+            default:
+                stage.type = StageType::OutputBuffer;
+                break;
+        }
+    }
+    return stages;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+void testEmitterAppends(TestResults& results) {
+    CodeEmitter out(64);
+    out << "x = " << 1.5 << "f;" << '\n' << std::string(100, '/') << "\n";
+    const std::string expected = "x = 1.5f;\n" + std::string(100, '/') + "\n";
+    const bool same = out.view() == expected && out.size() == expected.size();
+    const std::string taken = out.take();
+
+    if (same && taken == expected && out.size() == 0) results.pass("Emitter holds exactly what was written; take() empties it");
+    else results.fail("Emitter holds exactly what was written; take() empties it", taken);
+}
+
+void testFragmentsMatchSerial(TestResults& results) {
+    // Fragments that change the stream format must not affect their neighbours
+    auto render = [](std::ostream& out, size_t i) {
+        out << "// " << i << ": " << 1.0 / static_cast<double>(i + 3) << "\n";
+        if (i % 3 == 0) out << std::fixed << std::setprecision(2) << std::hex;
+        out << "value " << i << " " << 2.0 / 3.0 << "\n";
+    };
+
+    std::ostringstream reference;
+    for (size_t i = 0; i < 1000; ++i) {
+        std::ostringstream fragment;
+        render(fragment, i);
+        reference << fragment.str();
+    }
+
+    bool same = true;
+    for (unsigned threads : {1u, 2u, 3u, 7u, 64u}) {
+        CodeEmitter out;
+        emitFragments(out, 1000, threads, render);
+        out << 0.25;   // Caller's formatting untouched
+        same = same && out.take() == reference.str() + "0.25";
+    }
+
+    if (same) results.pass("Fragments join in order with per-fragment formatting on any thread count");
+    else results.fail("Fragments join in order with per-fragment formatting on any thread count", "text differs");
+}
+
+void testGeneratorJobsMatchSerial(TestResults& results) {
+    const auto stages = longChain(600);
+    const Netlist netlist;
+
+    bool same = true;
+    double serialMs = 0.0, parallelMs = 0.0;
+    for (int mode = 0; mode < 4; ++mode) {
+        JuceDSPGenerator serial, parallel;
+        for (auto* generator : {&serial, &parallel}) {
+            generator->setBetaMode(mode % 2 == 1);
+            generator->setBlockProcessing(mode >= 2);
+            generator->setFoldFixedNetworks(mode == 3);
+        }
+        serial.setJobs(1);
+        parallel.setJobs(4);
+
+        std::string serialHeader, serialImpl, parallelHeader, parallelImpl;
+        serialMs += millisecondsOf([&] {
+            serialHeader = serial.generateProcessorHeaderWithParams(netlist, stages);
+            serialImpl = serial.generateProcessorImplWithParams(netlist, stages);
+        });
+        parallelMs += millisecondsOf([&] {
+            parallelHeader = parallel.generateProcessorHeaderWithParams(netlist, stages);
+            parallelImpl = parallel.generateProcessorImplWithParams(netlist, stages);
+        });
+        same = same && serialHeader == parallelHeader && serialImpl == parallelImpl
+            && serial.generateDSPStages(stages) == parallel.generateDSPStages(stages)
+            && (serialImpl.find("signal *= 1.285714f;") != std::string::npos) == (mode == 1);
+    }
+    std::cout << "  600 stages, 4 modes: " << serialMs << " ms on 1 thread, " << parallelMs << " ms on up to 4\n";
+
+    if (same) results.pass("Generated processor is identical with 1 and 4 jobs");
+    else results.fail("Generated processor is identical with 1 and 4 jobs", "files differ");
+}
+
+void testGeneratorControlRate(TestResults& results) {
+    Netlist netlist;
+    netlist.addComponent(std::make_shared<Component>("P1", ComponentType::Potentiometer, "Drive"));
+    auto stages = longChain(5);
+    JuceDSPGenerator generator;
+
+    const std::string offImpl = generator.generateProcessorImplWithParams(netlist, stages);
+    bool same = offImpl.find("_control") == std::string::npos
+        && offImpl.find("stage2_gain.setGainLinear(driveValue);") != std::string::npos;
+
+    generator.setControlRate(32);
+    const std::string header = generator.generateProcessorHeaderWithParams(netlist, stages);
+    const std::string sampleImpl = generator.generateProcessorImplWithParams(netlist, stages);
+    generator.setBlockProcessing(true);
+    const std::string blockImpl = generator.generateProcessorImplWithParams(netlist, stages);
+
+    // Gain stages follow the knob per sample; the rest of the chain is untouched
+    const bool members = header.find("#include \"../../ControlRate.h\"") != std::string::npos
+        && header.find("std::array<LiveSpiceDSP::ControlRamp, 2> stage2_control;") != std::string::npos
+        && header.find("std::array<LiveSpiceDSP::ControlRamp, 2> stage4_control;") != std::string::npos
+        && header.find("stage0_control") == std::string::npos
+        && header.find("// Inputs: signal (audio), gain (control)") != std::string::npos;
+    const bool sample = sampleImpl.find("ramp.setInterval(32);") != std::string::npos
+        && sampleImpl.find("ramp.setTarget(driveValue);") != std::string::npos
+        && sampleImpl.find("signal *= stage2_control[(size_t) juce::jmin(channel, 1)].next();") != std::string::npos
+        && sampleImpl.find("setGainLinear(driveValue)") == std::string::npos;
+    const bool block = blockImpl.find("stage4_control[(size_t) juce::jmin(channel, 1)].multiply(channelData, (size_t) numSamples);") != std::string::npos
+        && blockImpl.find("setGainLinear(driveValue)") == std::string::npos;
+
+    if (same && members && sample && block) results.pass("Control rate ramps knob-driven gains; off by default");
+    else results.fail("Control rate ramps knob-driven gains; off by default",
+                      "default " + std::to_string(same) + ", members " + std::to_string(members)
+                      + ", sample " + std::to_string(sample) + ", block " + std::to_string(block));
+}
+
+void testGeneratorSharedState(TestResults& results) {
+    // One live context per type: built by the first holder, freed with the last
+    struct Models { int value = 0; };
+    using Context = LiveSpiceDSP::SharedContext<Models>;
+    int builds = 0;
+    auto build = [&builds] { ++builds; return std::make_shared<Models>(); };
+    bool counted = true;
+    {
+        auto first = Context::acquire(build);
+        auto second = Context::acquire(build);
+        counted = first == second && builds == 1 && Context::useCount() == 2;
+    }
+    counted = counted && Context::useCount() == 0 && Context::acquire(build) && builds == 2;
+
+    Netlist netlist;
+    auto stages = longChain(5);
+    JuceDSPGenerator generator;
+    const std::string offHeader = generator.generateProcessorHeaderWithParams(netlist, stages);
+    const bool same = offHeader.find("SharedState") == std::string::npos;
+
+    generator.setSharedState(true);
+    const std::string header = generator.generateProcessorHeaderWithParams(netlist, stages);
+    const std::string impl = generator.generateProcessorImplWithParams(netlist, stages);
+    const size_t sharedAt = header.find("const std::shared_ptr<SharedState> shared = LiveSpiceDSP::SharedContext<SharedState>::acquire();");
+    const bool members = header.find("#include \"../../SharedContext.h\"") != std::string::npos
+        && header.find("LiveSpiceComponents::DiodeModel clipperDiode") != std::string::npos
+        && sharedAt != std::string::npos && sharedAt < header.find("stage3_diode1;");
+    const bool prepare = impl.find("stage3_diode1.prepare(shared->clipperDiode, 25.0);") != std::string::npos
+        && impl.find("stage3_opamp.prepare(shared->clipperOpAmp, sampleRate);") != std::string::npos
+        && impl.find("prepare(\"1N4148\"") == std::string::npos;
+
+    generator.setWaveshaperTables(true);
+    const std::string shaperImpl = generator.generateProcessorImplWithParams(netlist, stages);
+    const bool table = generator.generateProcessorHeaderWithParams(netlist, stages).find("clipperTable =") != std::string::npos
+        && shaperImpl.find("shaper.setTable(shared->clipperTable);") != std::string::npos
+        && shaperImpl.find("std::make_shared<const LiveSpiceDSP::WaveshaperTable>") == std::string::npos;
+
+    if (counted && same && members && prepare && table) results.pass("Shared state is reference-counted and holds the immutable models");
+    else results.fail("Shared state is reference-counted and holds the immutable models",
+                      "counted " + std::to_string(counted) + ", default " + std::to_string(same) + ", members "
+                      + std::to_string(members) + ", prepare " + std::to_string(prepare) + ", table " + std::to_string(table));
+}
+
+void testGeneratorSubcircuitTables(TestResults& results) {
+    Netlist netlist;
+    auto stages = longChain(5);
+    stages[3].nonlinearComponents.push_back(Nonlinear::ComponentDB::NonlinearComponentInfo::fromDiode("1N4148", "D1"));
+    JuceDSPGenerator generator;
+    const std::string offHeader = generator.generateProcessorHeaderWithParams(netlist, stages);
+    const bool same = offHeader.find("subcircuit") == std::string::npos && offHeader.find("D1_clipper;") != std::string::npos
+        && generator.generateSubcircuitTablesHeader(netlist, stages).empty();
+
+    // The diode model gives way to the table, which is read once per block
+    generator.setSubcircuitTableBudget(2e-3);
+    const std::string header = generator.generateProcessorHeaderWithParams(netlist, stages);
+    const std::string impl = generator.generateProcessorImplWithParams(netlist, stages);
+    const bool members = header.find("#include \"SubcircuitTables.h\"") != std::string::npos
+        && header.find("const LiveSpiceDSP::SubcircuitTable stage3_subcircuit { GeneratedTables::stage3_subcircuitLayout, "
+                       "GeneratedTables::stage3_subcircuit };") != std::string::npos
+        && header.find("D1_clipper") == std::string::npos;
+    const bool sample = impl.find("const LiveSpiceDSP::SubcircuitTable::Controls stage3_controls {};") != std::string::npos
+        && impl.find("signal = stage3_subcircuit.process(signal, stage3_controls);") != std::string::npos
+        && impl.find("D1_clipper") == std::string::npos;
+
+    const std::string tables = generator.generateSubcircuitTablesHeader(netlist, stages);
+    const bool data = tables.find("inline constexpr LiveSpiceDSP::SubcircuitTable::Layout stage3_subcircuitLayout {") != std::string::npos
+        && tables.find("alignas(64) inline constexpr float stage3_subcircuit[") != std::string::npos
+        && tables.find("(budget 0.002 V)") != std::string::npos;
+
+    generator.setBlockProcessing(true);
+    const bool block = generator.generateProcessorImplWithParams(netlist, stages)
+        .find("stage3_subcircuit.processBlock(channelData, channelData, (size_t) numSamples, stage3_controls);") != std::string::npos;
+
+    if (same && members && sample && data && block) results.pass("Subcircuit tables replace tabled clippers' diode models; off by default");
+    else results.fail("Subcircuit tables replace tabled clippers' diode models; off by default",
+                      "default " + std::to_string(same) + ", members " + std::to_string(members) + ", sample "
+                      + std::to_string(sample) + ", data " + std::to_string(data) + ", block " + std::to_string(block));
+}
+
+void testGeneratorLazyStages(TestResults& results) {
+    Netlist netlist;
+    auto stages = longChain(5);
+    stages[3].nonlinearComponents.push_back(Nonlinear::ComponentDB::NonlinearComponentInfo::fromDiode("1N4148", "D1"));
+    JuceDSPGenerator generator;
+    generator.setWaveshaperTables(true);
+    const std::string eagerImpl = generator.generateProcessorImplWithParams(netlist, stages);
+    const bool eager = eagerImpl.find(", D1_clipper(") != std::string::npos && eagerImpl.find("TableRebuildWorker") == std::string::npos;
+
+    // The constructor only builds the parameters; the diode stage waits for prepareToPlay
+    generator.setLazyStages(true);
+    const std::string header = generator.generateProcessorHeaderWithParams(netlist, stages);
+    const std::string impl = generator.generateProcessorImplWithParams(netlist, stages);
+    const size_t prepare = impl.find("void CircuitProcessor::prepareToPlay");
+    const bool lazy = header.find("std::optional<Nonlinear::DiodeClippingStage> D1_clipper;") != std::string::npos
+        && impl.find(", D1_clipper(") == std::string::npos
+        && impl.find("D1_clipper.emplace(") > prepare && impl.find("D1_clipper.emplace(") != std::string::npos
+        && impl.find("signal = D1_clipper->processSample(signal);") != std::string::npos;
+
+    // The curve is baked on the worker, taken up per block, hard clipped until then
+    const bool background = header.find("std::atomic<bool> clipperTableReady { false };") != std::string::npos
+        && impl.find("LiveSpiceDSP::TableRebuildWorker::shared().schedule (this, [this] {") > prepare
+        && impl.find("LiveSpiceDSP::TableRebuildWorker::shared().cancel (this);") < prepare
+        && impl.find("for (auto& shaper : stage3_shaper) shaper.setTable (bakedClipperTable);") != std::string::npos
+        && impl.find(": juce::jlimit(-0.6f, 0.6f, signal);") != std::string::npos;
+
+    if (eager && lazy && background) results.pass("Lazy stages: nonlinear stages on first prepare, curves baked in the background");
+    else results.fail("Lazy stages: nonlinear stages on first prepare, curves baked in the background",
+                      "eager " + std::to_string(eager) + ", lazy " + std::to_string(lazy) + ", background " + std::to_string(background));
+}
+
+void testGeneratorSubBlocks(TestResults& results) {
+    Netlist netlist;
+    const auto stages = longChain(5);
+    JuceDSPGenerator generator;
+    const std::string wholeImpl = generator.generateProcessorImplWithParams(netlist, stages);
+    const bool whole = wholeImpl.find("processSubBlock") == std::string::npos
+        && wholeImpl.find("void CircuitProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)\n") != std::string::npos;
+
+    // processBlock only slices the host buffer; the generated body runs per slice
+    generator.setSubBlockSize(32);
+    const std::string header = generator.generateProcessorHeaderWithParams(netlist, stages);
+    const std::string impl = generator.generateProcessorImplWithParams(netlist, stages);
+    const size_t body = impl.find("void CircuitProcessor::processSubBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)\n");
+    const bool split = header.find("static constexpr int subBlockSize = 32;") != std::string::npos
+        && header.find("void processSubBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi);") != std::string::npos
+        && impl.find("processSubBlock (subBlock, midi);") < body
+        && body != std::string::npos && impl.find("->load()", body) != std::string::npos;
+
+    if (whole && split) results.pass("Sub-blocks: host blocks sliced, parameters read per slice; off by default");
+    else results.fail("Sub-blocks: host blocks sliced, parameters read per slice; off by default",
+                      "default " + std::to_string(whole) + ", split " + std::to_string(split));
+}
+
+int main() {
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "CODE EMITTER TEST SUITE\n";
+    std::cout << std::string(80, '=') << "\n";
+
+    TestResults results;
+
+    std::cout << "\n=== TEST 1: Emitter ===\n";
+    testEmitterAppends(results);
+    testFragmentsMatchSerial(results);
+
+    std::cout << "\n=== TEST 2: Generator ===\n";
+    testGeneratorJobsMatchSerial(results);
+    testGeneratorControlRate(results);
+    testGeneratorSharedState(results);
+    testGeneratorSubcircuitTables(results);
+    testGeneratorLazyStages(results);
+    testGeneratorSubBlocks(results);
+
+    results.summary();
+
+    return results.failed == 0 ? 0 : 1;
+}
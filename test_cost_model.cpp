@@ -0,0 +1,114 @@
+#include "CostModel.h"
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+using namespace LiveSpice;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void pass(const std::string& test) {
+        passed++;
+        std::cout << "✓ PASS: " << test << "\n";
+    }
+
+    void fail(const std::string& test, const std::string& reason) {
+        failed++;
+        std::cout << "✗ FAIL: " << test << " - " << reason << "\n";
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+static std::string describe(const CostModel::Plan& plan) {
+    return std::string(CostModel::solverName(plan.solver)) + " at " + std::to_string(plan.oversampling) + "x, "
+           + std::to_string(plan.nsPerSample) + " ns";
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+void testPlansFitTheBudget(TestResults& results) {
+    bool ok = true;
+    std::string reason;
+    for (double budget : {60.0, 80.0, 150.0, 300.0, 600.0, 1200.0}) {
+        const auto plan = CostModel::selectForBudget(2, budget);
+        if (!plan.fits || plan.nsPerSample > budget) {
+            ok = false;
+            reason = std::to_string(budget) + " ns: " + describe(plan);
+        }
+    }
+    if (ok) {
+        results.pass("Every plan fits its budget");
+    } else {
+        results.fail("Plans fit the budget", reason);
+    }
+}
+
+void testMoreBudgetNeverLosesAccuracy(TestResults& results) {
+    double lastSnr = 0.0;
+    bool ok = true;
+    for (double budget = 30.0; budget <= 2000.0; budget += 10.0) {
+        const auto plan = CostModel::selectForBudget(1, budget);
+        ok = ok && plan.snrDb >= lastSnr;
+        lastSnr = plan.snrDb;
+    }
+    const auto eco = CostModel::selectForBudget(2, 80.0);
+    const auto high = CostModel::selectForBudget(2, 600.0);
+    if (ok && high.snrDb > eco.snrDb + 20.0 && high.oversampling > eco.oversampling) {
+        results.pass("Accuracy grows with the budget (eco: " + describe(eco) + "; high: " + describe(high) + ")");
+    } else {
+        results.fail("Accuracy grows with the budget", "eco " + describe(eco) + ", high " + describe(high));
+    }
+}
+
+void testFixedOversampling(TestResults& results) {
+    const auto plan = CostModel::selectForBudget(2, 10000.0, 2);
+    if (plan.oversampling == 2 && plan.fits) {
+        results.pass("Fixed oversampling factor is kept (" + describe(plan) + ")");
+    } else {
+        results.fail("Fixed oversampling", describe(plan));
+    }
+}
+
+void testOverBudgetFallsBackToCheapest(TestResults& results) {
+    const auto plan = CostModel::selectForBudget(4, 1.0);
+    double cheapest = 1e9;
+    for (const auto& cost : CostModel::clipperCosts()) cheapest = std::min(cheapest, cost.nsPerSample);
+    if (!plan.fits && plan.nsPerSample == 4.0 * cheapest) {
+        results.pass("Impossible budget falls back to the cheapest implementation");
+    } else {
+        results.fail("Impossible budget", describe(plan));
+    }
+}
+
+int main() {
+    std::cout << "Cost Model Tests\n";
+    std::cout << std::string(80, '=') << "\n\n";
+
+    TestResults results;
+    testPlansFitTheBudget(results);
+    testMoreBudgetNeverLosesAccuracy(results);
+    testFixedOversampling(results);
+    testOverBudgetFallsBackToCheapest(results);
+
+    results.summary();
+    return results.failed == 0 ? 0 : 1;
+}
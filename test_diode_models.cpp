@@ -5,6 +5,7 @@
 #include <algorithm>
 
 #include "src/DiodeModels.h"
+#include "src/DeviceTables.h"
 
 using namespace Nonlinear;
 
@@ -234,6 +235,363 @@ void testLoadImpedanceEffect() {
                "Low Z (1kΩ): " + std::to_string(out_low) + "V, High Z (100kΩ): " + std::to_string(out_high) + "V");
 }
 
+/**
+ * Test 8: Block processing matches per-sample processing
+ */
+void testBlockProcessing() {
+    std::cout << "\n=== TEST 8: Block Processing ===" << std::endl;
+    
+    const DiodeClippingStage::TopologyType topologies[] = {
+        DiodeClippingStage::TopologyType::SeriesDiode,
+        DiodeClippingStage::TopologyType::ParallelDiode,
+        DiodeClippingStage::TopologyType::BackToBackDiodes,
+        DiodeClippingStage::TopologyType::BridgeClipping
+    };
+    const char* names[] = {"Series", "Parallel", "BackToBack", "Bridge"};
+    
+    std::vector<float> input(256);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = 1.5f * std::sin(2.0f * 3.14159265f * float(i) / 64.0f);
+    }
+    
+    for (int t = 0; t < 4; ++t) {
+        DiodeClippingStage clipper(DiodeCharacteristics::Si1N4148(), topologies[t]);
+        // Warm start makes results depend on solve order; compare the stateless path
+        clipper.setWarmStart(false);
+        
+        std::vector<float> blockOut(input.size());
+        clipper.processBlock(input.data(), blockOut.data(), input.size());
+        
+        std::vector<float> inPlace = input;
+        clipper.processBlock(inPlace.data(), inPlace.size());
+        
+        float maxDiff = 0.0f;
+        for (size_t i = 0; i < input.size(); ++i) {
+            float ref = clipper.processSample(input[i]);
+            maxDiff = std::max(maxDiff, std::abs(ref - blockOut[i]));
+            maxDiff = std::max(maxDiff, std::abs(ref - inPlace[i]));
+        }
+        
+        reportTest(std::string("Block == Sample (") + names[t] + ")", maxDiff < 1e-6f,
+                   "Max difference: " + std::to_string(maxDiff));
+    }
+}
+    
+/**
+ * Test 9: Lockstep lane solver matches the scalar solver
+ */
+void testLaneSolver() {
+    std::cout << "\n=== TEST 9: Multi-Lane Newton-Raphson ===" << std::endl;
+    
+    DiodeNewtonRaphson solver(DiodeCharacteristics::Si1N4148());
+    DiodeNewtonRaphson::SolverConfig config;
+    
+    // Odd count exercises a partially filled final lane group
+    const size_t count = 21;
+    std::vector<float> applied(count), vLane(count), iLane(count);
+    std::vector<int> itLane(count);
+    for (size_t i = 0; i < count; ++i) {
+        applied[i] = 0.05f + 0.04f * float(i);
+    }
+    
+    solver.solveBlock(applied.data(), count, config, vLane.data(), iLane.data(), itLane.data());
+    
+    float maxDiff = 0.0f;
+    bool iterationsMatch = true;
+    for (size_t i = 0; i < count; ++i) {
+        float vRef = 0.0f, iRef = 0.0f;
+        int itRef = solver.solve(applied[i], config, vRef, iRef);
+        maxDiff = std::max(maxDiff, std::abs(vRef - vLane[i]));
+        iterationsMatch = iterationsMatch && (std::abs(itRef - itLane[i]) <= 1);
+    }
+    
+    reportTest("Lane Voltage == Scalar Voltage", maxDiff < 1e-5f,
+               "Max difference: " + std::to_string(maxDiff));
+    reportTest("Lane Iterations Track Scalar", iterationsMatch);
+}
+    
+/**
+ * Test 10: Warm start and solver telemetry
+ */
+void testWarmStartTelemetry() {
+    std::cout << "\n=== TEST 10: Warm Start & Solver Telemetry ===" << std::endl;
+    
+    // Slow sine that spends most of its time in the Newton-Raphson region
+    std::vector<float> input(2048);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = 0.8f * std::sin(2.0f * 3.14159265f * float(i) / 512.0f);
+    }
+    
+    DiodeClippingStage cold(DiodeCharacteristics::Si1N4148(), DiodeClippingStage::TopologyType::SeriesDiode);
+    DiodeClippingStage warm(DiodeCharacteristics::Si1N4148(), DiodeClippingStage::TopologyType::SeriesDiode);
+    cold.setWarmStart(false);
+    
+    float maxDiff = 0.0f;
+    for (float x : input) {
+        maxDiff = std::max(maxDiff, std::abs(cold.processSample(x) - warm.processSample(x)));
+    }
+    
+    DiodeClippingStage::SolverStats coldStats = cold.getSolverStats();
+    DiodeClippingStage::SolverStats warmStats = warm.getSolverStats();
+    
+    reportTest("Telemetry Counts Solves", warmStats.solves > 0 && warmStats.solves == coldStats.solves,
+               std::to_string(warmStats.solves) + " solves");
+    reportTest("Warm Start Reduces Iterations", warmStats.meanIterations() < coldStats.meanIterations(),
+               "Mean: " + std::to_string(coldStats.meanIterations()) + " -> " +
+               std::to_string(warmStats.meanIterations()));
+    reportTest("Warm Start Output Unchanged", maxDiff < 1e-4f,
+               "Max difference: " + std::to_string(maxDiff));
+    
+    // Large step (-0.19 V -> 0.74 V): the stale warm start cannot converge,
+    // so the solve must retry rather than fall back to the LUT
+    DiodeClippingStage stepWarm(DiodeCharacteristics::Si1N4148(), DiodeClippingStage::TopologyType::SeriesDiode);
+    DiodeClippingStage stepCold(DiodeCharacteristics::Si1N4148(), DiodeClippingStage::TopologyType::SeriesDiode);
+    stepCold.setWarmStart(false);
+    for (int i = 0; i < 4; ++i) {
+        stepWarm.processSample(-0.19f);
+        stepCold.processSample(-0.19f);
+    }
+    float stepDiff = std::abs(stepWarm.processSample(0.74f) - stepCold.processSample(0.74f));
+    reportTest("Warm Start Survives Large Step", stepDiff < 1e-4f,
+               "Difference: " + std::to_string(stepDiff));
+    
+    warm.resetSolverStats();
+    warm.processSample(0.0f);  // Reset is applied on the next audio-thread update
+    reportTest("Telemetry Reset", warm.getSolverStats().solves <= 1);
+}
+
+/**
+ * Test 11: Wright-omega closed form matches converged Newton-Raphson
+ */
+void testWrightOmegaSolver() {
+    std::cout << "\n=== TEST 11: Wright-Omega Solver ===" << std::endl;
+    
+    const DiodeCharacteristics diodes[] = {
+        DiodeCharacteristics::Si1N4148(), DiodeCharacteristics::Ge_OA90(), DiodeCharacteristics::Si1N4007()
+    };
+    
+    // Reference: generous iteration budget, tight tolerance
+    DiodeNewtonRaphson::SolverConfig config;
+    config.maxIterations = 200;
+    config.convergenceTolerance = 1e-7f;
+    
+    float maxDiff = 0.0f;
+    for (const auto& diode : diodes) {
+        DiodeNewtonRaphson reference(diode);
+        DiodeWrightOmega omega(diode);
+        for (float v = 0.0f; v <= 1.0f; v += 0.01f) {
+            float vRef, iRef, vOmega, iOmega;
+            reference.solve(v, config, vRef, iRef);
+            omega.solve(v, vOmega, iOmega);
+            maxDiff = std::max(maxDiff, std::abs(vRef - vOmega));
+        }
+    }
+    reportTest("Wright-Omega == Newton-Raphson", maxDiff < 1e-5f,
+               "Max voltage difference: " + std::to_string(maxDiff));
+    
+    DiodeClippingStage clipper(DiodeCharacteristics::Si1N4148(), DiodeClippingStage::TopologyType::BackToBackDiodes);
+    clipper.setSolverMode(DiodeClippingStage::SolverMode::WrightOmega);
+    
+    std::vector<float> input(256), blockOut(256);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = 1.5f * std::sin(2.0f * 3.14159265f * float(i) / 64.0f);
+    }
+    clipper.processBlock(input.data(), blockOut.data(), input.size());
+    
+    float blockDiff = 0.0f;
+    bool bounded = true;
+    for (size_t i = 0; i < input.size(); ++i) {
+        float out = clipper.processSample(input[i]);
+        blockDiff = std::max(blockDiff, std::abs(out - blockOut[i]));
+        bounded = bounded && std::abs(out) <= 1.0f;
+    }
+    reportTest("Wright-Omega Block == Sample", blockDiff < 1e-6f,
+               "Max difference: " + std::to_string(blockDiff));
+    reportTest("Wright-Omega Output Bounded", bounded);
+    reportTest("Wright-Omega Adds No Solves", clipper.getSolverStats().solves == 0);
+}
+
+/**
+ * Power of folded (aliased) harmonics of a coherent test tone
+ * Harmonics k >= 2 whose frequency exceeds Nyquist land on folded bins;
+ * their power is measured with a direct DFT at each folded bin.
+ */
+static float measureAliasPower(const std::vector<float>& signal, int toneBin, int maxHarmonic) {
+    const int N = int(signal.size());
+    double total = 0.0;
+    for (int k = 2; k <= maxHarmonic; ++k) {
+        int bin = (k * toneBin) % N;
+        if (k * toneBin < N / 2) continue;  // In-band harmonic, not an alias
+        if (bin > N / 2) bin = N - bin;
+        double re = 0.0, im = 0.0;
+        for (int n = 0; n < N; ++n) {
+            double phase = 2.0 * 3.14159265358979 * double(bin) * n / N;
+            re += signal[n] * std::cos(phase);
+            im -= signal[n] * std::sin(phase);
+        }
+        total += (re * re + im * im) / (double(N) * N);
+    }
+    return float(total);
+}
+
+/**
+ * Test 12: Antiderivative anti-aliasing
+ */
+void testAntiAliasing() {
+    std::cout << "\n=== TEST 12: Antiderivative Anti-Aliasing ===" << std::endl;
+    
+    const int N = 4096;
+    const int toneBin = 373;  // ~4 kHz at 44.1 kHz, coherent over N samples
+    const DiodeClippingStage::AntiAliasingMode modes[] = {
+        DiodeClippingStage::AntiAliasingMode::None,
+        DiodeClippingStage::AntiAliasingMode::ADAA1,
+        DiodeClippingStage::AntiAliasingMode::ADAA2
+    };
+    
+    float aliasPower[3];
+    for (int m = 0; m < 3; ++m) {
+        DiodeClippingStage clipper(DiodeCharacteristics::Si1N4148(), DiodeClippingStage::TopologyType::BackToBackDiodes);
+        clipper.setWarmStart(false);
+        clipper.setAntiAliasingMode(modes[m]);
+        
+        std::vector<float> signal(2 * N);
+        for (int n = 0; n < 2 * N; ++n) {
+            signal[n] = 2.0f * std::sin(2.0f * 3.14159265f * float(toneBin) * float(n) / float(N));
+        }
+        clipper.processBlock(signal.data(), signal.size());
+        
+        std::vector<float> steady(signal.begin() + N, signal.end());
+        aliasPower[m] = measureAliasPower(steady, toneBin, 40);
+    }
+    
+    float gain1 = 10.0f * std::log10(aliasPower[0] / aliasPower[1]);
+    float gain2 = 10.0f * std::log10(aliasPower[0] / aliasPower[2]);
+    reportTest("ADAA1 Reduces Aliasing", gain1 > 6.0f, std::to_string(gain1) + " dB");
+    reportTest("ADAA2 Reduces Aliasing", gain2 > gain1, std::to_string(gain2) + " dB");
+    
+    // Constant input settles onto the static curve
+    DiodeClippingStage reference(DiodeCharacteristics::Si1N4148(), DiodeClippingStage::TopologyType::BackToBackDiodes);
+    DiodeClippingStage adaa(DiodeCharacteristics::Si1N4148(), DiodeClippingStage::TopologyType::BackToBackDiodes);
+    reference.setWarmStart(false);
+    adaa.setAntiAliasingMode(DiodeClippingStage::AntiAliasingMode::ADAA2);
+    float dcOut = 0.0f;
+    for (int i = 0; i < 8; ++i) dcOut = adaa.processSample(0.5f);
+    float dcDiff = std::abs(dcOut - reference.processSample(0.5f));
+    reportTest("ADAA Steady-State Matches Curve", dcDiff < 1e-3f,
+               "Difference: " + std::to_string(dcDiff));
+}
+
+/**
+ * Test 13: Shared LUT cache
+ */
+void testSharedLUTCache() {
+    std::cout << "\n=== TEST 13: Shared LUT Cache ===" << std::endl;
+    
+    {
+        DiodeClippingStage a(DiodeCharacteristics::Si1N4148());
+        DiodeClippingStage b(DiodeCharacteristics::Si1N4148(), DiodeClippingStage::TopologyType::SeriesDiode);
+        DiodeLUT c(DiodeCharacteristics::Si1N4148());
+        DiodeLUT d(DiodeCharacteristics::Si1N4148());
+        DiodeLUT e(DiodeCharacteristics::Ge_OA90());
+        
+        reportTest("Identical Parts Share Table", c.getTable() == d.getTable());
+        reportTest("Different Parts Get Own Table", c.getTable() != e.getTable());
+        reportTest("Shared Table Contents", c.evaluateCurrent(0.5f) == d.evaluateCurrent(0.5f));
+    }
+    
+    // All instances above are gone; their tables must be released
+    reportTest("Tables Released With Last User", DiodeLUT::cachedTableCount() == 0,
+               std::to_string(DiodeLUT::cachedTableCount()) + " live tables");
+}
+
+/**
+ * Test 14: Compile-time stock tables
+ */
+void testStockTables() {
+    std::cout << "\n=== TEST 14: Compile-Time Stock Tables ===" << std::endl;
+    
+    // Static table must match a runtime evaluation of the same grid
+    const DiodeCharacteristics parts[] = {DiodeCharacteristics::Si1N4148(), DiodeCharacteristics::Si1N914(),
+                                          DiodeCharacteristics::Ge_OA90(), DiodeCharacteristics::Si1N4007()};
+    float maxRelError = 0.0f;
+    bool allStatic = true;
+    for (const auto& part : parts) {
+        DiodeLUT lut(part);
+        const DiodeLUT::CurrentTable* table = lut.getTable();
+        allStatic = allStatic && table == findStockDiodeTable(part);
+        
+        float nVt = part.n * part.Vt;
+        for (int i = 0; i < DiodeLUT::LUT_SIZE; ++i) {
+            float v = DiodeLUT::VOLTAGE_MIN + float(i) / (DiodeLUT::LUT_SIZE - 1) * (DiodeLUT::VOLTAGE_MAX - DiodeLUT::VOLTAGE_MIN);
+            double expected = part.Is * (std::exp(double(std::clamp(v / nVt, -20.0f, 50.0f))) - 1.0);
+            float err = float(std::abs((*table)[i] - expected) / (std::abs(expected) + 1e-30));
+            maxRelError = std::max(maxRelError, err);
+        }
+    }
+    reportTest("Stock Parts Use Static Tables", allStatic);
+    reportTest("Static Tables Match Runtime", maxRelError < 1e-5f,
+               "Max relative error: " + std::to_string(maxRelError));
+    reportTest("Static Tables Not Cached", DiodeLUT::cachedTableCount() == 0,
+               std::to_string(DiodeLUT::cachedTableCount()) + " live tables");
+    
+    // Custom parts fall back to the shared runtime cache
+    DiodeCharacteristics custom = DiodeCharacteristics::Si1N4148();
+    custom.Is = 2.0e-14f;
+    {
+        DiodeLUT a(custom);
+        DiodeLUT b(custom);
+        reportTest("Custom Part Uses Runtime Table", findStockDiodeTable(custom) == nullptr &&
+                   DiodeLUT::cachedTableCount() == 1);
+        reportTest("Custom Part Shares Table", a.getTable() == b.getTable());
+    }
+}
+
+/**
+ * Test 15: Non-uniform cubic Hermite LUT accuracy vs size
+ */
+void testHermiteLUT() {
+    std::cout << "\n=== TEST 15: Hermite LUT Accuracy vs Size ===" << std::endl;
+    
+    const std::pair<const char*, DiodeCharacteristics> parts[] = {
+        {"1N4148", DiodeCharacteristics::Si1N4148()}, {"OA90", DiodeCharacteristics::Ge_OA90()}};
+    
+    bool beatsUniform = true, improvesWithSize = true;
+    for (const auto& [name, part] : parts) {
+        LUTAccuracy uniform = measureLUTAccuracy(DiodeLUT(part), part);
+        std::cout << std::fixed << std::setprecision(0);
+        std::cout << "  " << name << " uniform linear  512 pts " << std::setw(5) << uniform.memoryBytes << " B"
+                  << std::scientific << std::setprecision(2)
+                  << "  fwd rel " << uniform.maxForwardRelError << "  rev/Is " << uniform.maxReverseError << std::endl;
+        
+        double previous = 1.0;
+        for (int points : {32, 64, 128, 256}) {
+            LUTAccuracy hermite = measureLUTAccuracy(DiodeHermiteLUT(part, points), part);
+            std::cout << std::fixed << std::setprecision(0);
+            std::cout << "  " << name << " hermite       " << std::setw(5) << points << " pts " << std::setw(5)
+                      << hermite.memoryBytes << " B" << std::scientific << std::setprecision(2)
+                      << "  fwd rel " << hermite.maxForwardRelError << "  rev/Is " << hermite.maxReverseError << std::endl;
+            
+            improvesWithSize = improvesWithSize && hermite.maxForwardRelError < previous;
+            previous = hermite.maxForwardRelError;
+            if (points == 128) {
+                beatsUniform = beatsUniform && hermite.memoryBytes < uniform.memoryBytes &&
+                               hermite.maxForwardRelError < uniform.maxForwardRelError;
+            }
+        }
+    }
+    std::cout << std::defaultfloat;
+    
+    reportTest("Hermite 128 Beats Uniform 512", beatsUniform);
+    reportTest("Error Falls With Table Size", improvesWithSize);
+    
+    DiodeHermiteLUT lut(DiodeCharacteristics::Si1N4148());
+    LUTAccuracy acc = measureLUTAccuracy(lut, DiodeCharacteristics::Si1N4148());
+    reportTest("Default Table Forward Accuracy", acc.maxForwardRelError < 1e-4,
+               "Max relative error: " + std::to_string(acc.maxForwardRelError));
+    reportTest("Default Table Reverse Accuracy", acc.maxReverseError < 1e-3,
+               "Max error / Is: " + std::to_string(acc.maxReverseError));
+}
+
 /**
  * Main test runner
  */
@@ -251,6 +609,14 @@ int main() {
     testDiodeTypes();
     testMXRDistortionClipping();
     testLoadImpedanceEffect();
+    testBlockProcessing();
+    testLaneSolver();
+    testWarmStartTelemetry();
+    testWrightOmegaSolver();
+    testAntiAliasing();
+    testSharedLUTCache();
+    testStockTables();
+    testHermiteLUT();
     
     // Summary
     std::cout << "\n╔════════════════════════════════════════════════╗" << std::endl;
@@ -0,0 +1,160 @@
+#include "DKMethod.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+using namespace LiveSpiceDSP;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void pass(const std::string& test) {
+        passed++;
+        std::cout << "✓ PASS: " << test << "\n";
+    }
+
+    void fail(const std::string& test, const std::string& reason) {
+        failed++;
+        std::cout << "✗ FAIL: " << test << " - " << reason << "\n";
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+static const double PI = 3.14159265358979323846;
+static const double SAMPLE_RATE = 48000.0;
+
+// Peak of the last period of a sine run through the processor
+template <size_t N, size_t P>
+static double sinePeak(DKProcessor<N, P>& dk, double freq, double amplitude) {
+    const int period = static_cast<int>(SAMPLE_RATE / freq);
+    double peak = 0.0;
+    for (int n = 0; n < 40 * period; ++n) {
+        float y = dk.processSample(static_cast<float>(amplitude * std::sin(2.0 * PI * freq * n / SAMPLE_RATE)));
+        if (n >= 39 * period) peak = std::max(peak, static_cast<double>(std::fabs(y)));
+    }
+    return peak;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+// RC low-pass: 10k / 15.9n -> 1 kHz corner, -3 dB there
+void testRCLowPass(TestResults& results) {
+    DKNetwork network;
+    network.setInput(1, DKNetwork::GROUND);
+    network.addResistor(1, 2, 10000.0);
+    network.addCapacitor(2, DKNetwork::GROUND, 15.9155e-9);
+    network.setOutput(2);
+
+    DKProcessor<1, 0> dk;
+    if (!dk.setModel(network.build(SAMPLE_RATE))) {
+        results.fail("RC low-pass", "model size mismatch");
+        return;
+    }
+
+    double passband = sinePeak(dk, 50.0, 1.0);
+    dk.reset();
+    double corner = sinePeak(dk, 1000.0, 1.0);
+    if (std::fabs(passband - 1.0) < 0.01 && std::fabs(corner - 1.0 / std::sqrt(2.0)) < 0.01) {
+        results.pass("RC low-pass (unity passband, -3 dB at fc)");
+    } else {
+        results.fail("RC low-pass", "passband " + std::to_string(passband) + ", corner " + std::to_string(corner));
+    }
+}
+
+// Series resistor into antiparallel 1N4148s: output clamps near one diode drop
+void testDiodeClipper(TestResults& results) {
+    DKNetwork network;
+    network.setInput(1, DKNetwork::GROUND);
+    network.addResistor(1, 2, 1000.0);
+    network.addDiode(2, DKNetwork::GROUND, 2.52e-9, 1.752);
+    network.addDiode(DKNetwork::GROUND, 2, 2.52e-9, 1.752);
+    network.setOutput(2);
+
+    DKProcessor<0, 2> dk;
+    dk.setModel(network.build(SAMPLE_RATE));
+
+    double quiet = sinePeak(dk, 200.0, 0.05);
+    double loud = sinePeak(dk, 200.0, 10.0);
+    if (std::fabs(quiet - 0.05) < 0.002 && loud > 0.5 && loud < 1.0) {
+        results.pass("Diode clipper (linear when quiet, clamps when loud)");
+    } else {
+        results.fail("Diode clipper", "quiet " + std::to_string(quiet) + ", loud " + std::to_string(loud));
+    }
+}
+
+// Non-inverting op-amp, gain 1 + 100k/10k, biased from a 4.5 V rail and
+// AC-coupled at both ends: gain 11, no DC step at the output on reset
+void testOpAmpBias(TestResults& results) {
+    DKNetwork network;
+    network.setInput(1, DKNetwork::GROUND);
+    network.addCapacitor(1, 2, 1e-6);
+    network.addResistor(2, 3, 1e6);
+    network.addVoltageSource(3, DKNetwork::GROUND, 4.5);
+    network.addIdealOpAmp(2, 4, 5);
+    network.addResistor(5, 4, 100000.0);
+    network.addResistor(4, 6, 10000.0);
+    network.addCapacitor(6, DKNetwork::GROUND, 10e-6);
+    network.addCapacitor(5, 7, 1e-6);
+    network.addResistor(7, DKNetwork::GROUND, 100000.0);
+    network.setOutput(7);
+
+    DKProcessor<3, 0> dk;
+    dk.setModel(network.build(SAMPLE_RATE));
+
+    float first = dk.processSample(0.0f);
+    double gain = sinePeak(dk, 1000.0, 0.1) / 0.1;
+    if (std::fabs(first) < 1e-6 && std::fabs(gain - 11.0) < 0.1) {
+        results.pass("Op-amp stage (gain 11, starts at its DC operating point)");
+    } else {
+        results.fail("Op-amp stage", "first sample " + std::to_string(first) + ", gain " + std::to_string(gain));
+    }
+}
+
+void testSingularNetwork(TestResults& results) {
+    DKNetwork network;
+    network.setInput(1, DKNetwork::GROUND);
+    network.addVoltageSource(1, DKNetwork::GROUND, 1.0);
+    network.addResistor(1, 2, 1000.0);
+    network.setOutput(2);
+
+    try {
+        network.build(SAMPLE_RATE);
+        results.fail("Singular network", "no exception for parallel voltage sources");
+    } catch (const std::invalid_argument&) {
+        results.pass("Singular network rejected");
+    }
+}
+
+int main() {
+    std::cout << "Nodal DK-Method Tests\n";
+    std::cout << std::string(80, '=') << "\n\n";
+
+    TestResults results;
+    testRCLowPass(results);
+    testDiodeClipper(results);
+    testOpAmpBias(results);
+    testSingularNetwork(results);
+
+    results.summary();
+    return results.failed == 0 ? 0 : 1;
+}
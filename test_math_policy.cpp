@@ -0,0 +1,176 @@
+#include "MathPolicy.h"
+#include "DiodeModels.h"
+#include "TransistorModels.h"
+#include "third_party/livespice-components/ComponentModels.h"
+#include <iostream>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace LiveSpiceDSP;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void check(const std::string& test, bool condition, const std::string& detail) {
+        if (condition) {
+            passed++;
+            std::cout << "✓ PASS: " << test << " (" << detail << ")\n";
+        } else {
+            failed++;
+            std::cout << "✗ FAIL: " << test << " - " << detail << "\n";
+        }
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+static std::string sci(double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.2e", value);
+    return buffer;
+}
+
+// ============================================================================
+// Documented error bounds (MathPolicy.h)
+// ============================================================================
+
+template <typename Math>
+void testErrorBounds(TestResults& results, const std::string& name) {
+    std::cout << "\n--- " << name << " error bounds ---\n";
+    const int N = 400000;
+
+    double expErr = 0.0;
+    for (int i = 0; i <= N; ++i) {
+        float x = -87.0f + 175.0f * float(i) / N;
+        double ref = std::exp(double(x));
+        expErr = std::max(expErr, std::abs(Math::exp(x) - ref) / ref);
+    }
+    results.check(name + " exp", expErr < 2e-7, "max relative " + sci(expErr));
+
+    double logErr = 0.0, log10Err = 0.0;
+    for (int i = 0; i <= N; ++i) {
+        float x = float(std::pow(10.0, -30.0 + 60.0 * i / N));
+        double ln = std::log(double(x)), lg = std::log10(double(x));
+        logErr = std::max(logErr, std::abs(Math::log(x) - ln) / std::max(1.0, std::abs(ln)));
+        log10Err = std::max(log10Err, std::abs(Math::log10(x) - lg) / std::max(1.0, std::abs(lg)));
+    }
+    results.check(name + " log", logErr < 2e-7, "max scaled absolute " + sci(logErr));
+    results.check(name + " log10", log10Err < 3e-7, "max scaled absolute " + sci(log10Err));
+
+    double exp10Err = 0.0;
+    for (int i = 0; i <= N; ++i) {
+        float x = -8.0f + 16.0f * float(i) / N;
+        double ref = std::pow(10.0, double(x));
+        exp10Err = std::max(exp10Err, std::abs(Math::exp10(x) - ref) / ref);
+    }
+    results.check(name + " exp10", exp10Err < 2e-6, "max relative " + sci(exp10Err));
+
+    double exp2Err = 0.0, log2Err = 0.0;
+    for (int i = 0; i <= N; ++i) {
+        float x = -126.0f + 253.0f * float(i) / N;
+        double ref = std::exp2(double(x));
+        exp2Err = std::max(exp2Err, std::abs(Math::exp2(x) - ref) / ref);
+        float y = float(std::pow(10.0, -30.0 + 60.0 * i / N));
+        double lg2 = std::log2(double(y));
+        log2Err = std::max(log2Err, std::abs(Math::log2(y) - lg2) / std::max(1.0, std::abs(lg2)));
+    }
+    results.check(name + " exp2", exp2Err < 2e-7, "max relative " + sci(exp2Err));
+    results.check(name + " log2", log2Err < 2e-7, "max scaled absolute " + sci(log2Err));
+
+    double powErr = 0.0;
+    for (int i = 1; i <= 1000; ++i) {
+        for (int j = 0; j <= 100; ++j) {
+            float base = 0.01f * i, exponent = 0.5f + 0.02f * j;
+            double ref = std::pow(double(base), double(exponent));
+            double scale = std::max(1.0, std::abs(exponent * std::log(double(base))));
+            powErr = std::max(powErr, std::abs(Math::pow(base, exponent) - ref) / ref / scale);
+        }
+    }
+    results.check(name + " pow", powErr < 5e-7, "max scaled relative " + sci(powErr));
+}
+
+void testSimdArrays(TestResults& results) {
+    std::cout << "\n--- SimdMath array forms ---\n";
+    std::vector<float> x(1027), out(x.size());
+    for (size_t i = 0; i < x.size(); ++i) x[i] = 0.01f + 0.05f * float(i);
+
+    bool match = true;
+    SimdMath::exp(x.data(), out.data(), x.size());
+    for (size_t i = 0; i < x.size(); ++i) match = match && out[i] == FastMath::exp(x[i]);
+    SimdMath::log10(x.data(), out.data(), x.size());
+    for (size_t i = 0; i < x.size(); ++i) match = match && out[i] == FastMath::log10(x[i]);
+    SimdMath::pow(x.data(), 1.7f, out.data(), x.size());
+    for (size_t i = 0; i < x.size(); ++i) match = match && out[i] == FastMath::pow(x[i], 1.7f);
+    results.check("Arrays equal scalar FastMath", match, "exp/log10/pow over 1027 values");
+}
+
+// ============================================================================
+// Models under each policy
+// ============================================================================
+
+void testModels(TestResults& results) {
+    std::cout << "\n--- Device models ---\n";
+
+    Nonlinear::DiodeNewtonRaphson solver(Nonlinear::DiodeCharacteristics::Si1N4148());
+    Nonlinear::DiodeNewtonRaphson::SolverConfig config;
+    double diodeErr = 0.0;
+    for (float v = 0.0f; v <= 5.0f; v += 0.01f) {
+        float vExact, iExact, vFast, iFast;
+        solver.solve<ExactMath>(v, config, vExact, iExact);
+        solver.solve<FastMath>(v, config, vFast, iFast);
+        diodeErr = std::max(diodeErr, double(std::abs(vFast - vExact)));
+    }
+    results.check("Diode solve<FastMath>", diodeErr < 1e-5, "max voltage difference " + sci(diodeErr) + " V");
+
+    Nonlinear::BJTAmplifierStage bjt(Nonlinear::BJTCharacteristics::TwoN3904());
+    double bjtErr = 0.0;
+    for (float vbe = 0.3f; vbe <= 0.8f; vbe += 0.001f) {
+        double exact = bjt.shockleyBJT<ExactMath>(vbe);
+        bjtErr = std::max(bjtErr, std::abs(bjt.shockleyBJT<FastMath>(vbe) - exact) / exact);
+    }
+    results.check("BJT shockleyBJT<FastMath>", bjtErr < 1e-5, "max relative " + sci(bjtErr));
+
+    using LiveSpiceComponents::TriodeModel;
+    TriodeModel triode = TriodeModel::getModel("12AX7");
+    double korenErr = 0.0;
+    for (float vp = 50.0f; vp <= 300.0f; vp += 5.0f) {
+        for (float vc = -3.0f; vc <= 0.0f; vc += 0.05f) {
+            double exact = TriodeModel::calculatePlateCurrentKoren(double(vc), double(vp), triode);
+            if (exact <= 0.0) continue;
+            double fast = TriodeModel::calculatePlateCurrentKoren<FastMath>(vc, vp, triode);
+            korenErr = std::max(korenErr, std::abs(fast - exact) / exact);
+        }
+    }
+    results.check("Koren pow<FastMath>", korenErr < 1e-5, "max relative " + sci(korenErr));
+}
+
+int main() {
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "MATH POLICY - TEST SUITE\n";
+    std::cout << std::string(80, '=') << "\n";
+
+    TestResults results;
+    testErrorBounds<FastMath>(results, "FastMath");
+    testErrorBounds<SimdMath>(results, "SimdMath");
+    testSimdArrays(results);
+    testModels(results);
+
+    results.summary();
+    return results.failed == 0 ? 0 : 1;
+}
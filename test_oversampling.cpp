@@ -0,0 +1,319 @@
+#include "Oversampling.h"
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <string>
+
+using namespace LiveSpiceDSP;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+    
+    void pass(const std::string& test) {
+        passed++;
+        std::cout << "✓ PASS: " << test << "\n";
+    }
+    
+    void fail(const std::string& test, const std::string& reason) {
+        failed++;
+        std::cout << "✗ FAIL: " << test << " - " << reason << "\n";
+    }
+    
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+static const double PI = 3.14159265358979323846;
+
+static const char* typeName(Oversampler::FilterType type) {
+    return type == Oversampler::FilterType::LinearPhaseFIR ? "FIR" : "IIR";
+}
+
+/**
+ * Magnitude and phase of a sequence at one frequency (direct DFT)
+ */
+static void measureTone(const std::vector<float>& x, size_t start, double freq, double fs,
+                        double& magnitude, double& phase) {
+    double re = 0.0, im = 0.0;
+    for (size_t n = start; n < x.size(); ++n) {
+        double w = 2.0 * PI * freq * double(n) / fs;
+        re += x[n] * std::cos(w);
+        im -= x[n] * std::sin(w);
+    }
+    magnitude = std::sqrt(re * re + im * im) * 2.0 / double(x.size() - start);
+    phase = std::atan2(im, re);
+}
+
+// ============================================================================
+// TEST 1: Passband Transparency & Latency
+// ============================================================================
+
+void testPassbandAndLatency(TestResults& results, int factor, Oversampler::FilterType type) {
+    const std::string name = std::to_string(factor) + "x " + typeName(type);
+    const double fs = 44100.0, f0 = 500.0;
+    Oversampler os(factor, type);
+    
+    std::vector<float> input(8192), output(8192);
+    for (size_t n = 0; n < input.size(); ++n) {
+        input[n] = float(std::sin(2.0 * PI * f0 * double(n) / fs));
+        output[n] = os.processSample(input[n], [](float s) { return s; });
+    }
+    
+    double magIn, phaseIn, magOut, phaseOut;
+    measureTone(input, 4096, f0, fs, magIn, phaseIn);
+    measureTone(output, 4096, f0, fs, magOut, phaseOut);
+    
+    // Low-frequency phase lag converts to delay in samples
+    double lag = phaseIn - phaseOut;
+    while (lag < 0.0) lag += 2.0 * PI;
+    double measuredDelay = lag * fs / (2.0 * PI * f0);
+    double gainDb = 20.0 * std::log10(magOut / magIn);
+    
+    if (std::abs(gainDb) < 0.05) {
+        results.pass(name + " Passband Gain");
+    } else {
+        results.fail(name + " Passband Gain", std::to_string(gainDb) + " dB");
+    }
+    
+    if (std::abs(measuredDelay - os.getLatencySamples()) < 0.25) {
+        results.pass(name + " Reported Latency (" + std::to_string(os.getLatencySamples()) + ")");
+    } else {
+        results.fail(name + " Reported Latency", "measured " + std::to_string(measuredDelay) +
+                     ", reported " + std::to_string(os.getLatencySamples()));
+    }
+}
+
+// ============================================================================
+// TEST 2: Image Rejection
+// ============================================================================
+
+void testImageRejection(TestResults& results, int factor, Oversampler::FilterType type) {
+    const std::string name = std::to_string(factor) + "x " + typeName(type);
+    const double fs = 44100.0, f0 = 15000.0;
+    Oversampler os(factor, type);
+    
+    // Capture the oversampled stream inside the callback
+    std::vector<float> oversampled;
+    for (int n = 0; n < 4096; ++n) {
+        float x = float(std::sin(2.0 * PI * f0 * n / fs));
+        os.processSample(x, [&oversampled](float s) { oversampled.push_back(s); return s; });
+    }
+    
+    const double fsHigh = fs * factor;
+    double toneMag, unusedPhase;
+    measureTone(oversampled, oversampled.size() / 2, f0, fsHigh, toneMag, unusedPhase);
+    
+    double worstImageDb = -300.0;
+    for (int k = 1; k < factor; ++k) {
+        for (double image : {k * fs - f0, k * fs + f0}) {
+            if (image >= fsHigh / 2.0) continue;
+            double imageMag;
+            measureTone(oversampled, oversampled.size() / 2, image, fsHigh, imageMag, unusedPhase);
+            worstImageDb = std::max(worstImageDb, 20.0 * std::log10(imageMag / toneMag));
+        }
+    }
+    
+    if (worstImageDb < -60.0) {
+        results.pass(name + " Image Rejection (" + std::to_string(worstImageDb) + " dB)");
+    } else {
+        results.fail(name + " Image Rejection", std::to_string(worstImageDb) + " dB");
+    }
+}
+
+// ============================================================================
+// TEST 3: Block API
+// ============================================================================
+
+void testBlockMatchesSample(TestResults& results, Oversampler::FilterType type) {
+    Oversampler perSample(4, type);
+    Oversampler perBlock(4, type, 64);  // Smaller than the block: exercises chunking
+    auto clip = [](float s) { return std::tanh(3.0f * s); };
+    
+    std::vector<float> block(300);
+    float maxDiff = 0.0f;
+    for (size_t n = 0; n < block.size(); ++n) {
+        block[n] = float(0.8 * std::sin(2.0 * PI * 1000.0 * double(n) / 44100.0));
+    }
+    std::vector<float> reference(block.size());
+    for (size_t n = 0; n < block.size(); ++n) {
+        reference[n] = perSample.processSample(block[n], clip);
+    }
+    
+    perBlock.processBlock(block.data(), block.size(), [&clip](float* data, size_t n) {
+        for (size_t i = 0; i < n; ++i) data[i] = clip(data[i]);
+    });
+    for (size_t n = 0; n < block.size(); ++n) {
+        maxDiff = std::max(maxDiff, std::abs(block[n] - reference[n]));
+    }
+    
+    if (maxDiff < 1e-6f) {
+        results.pass(std::string(typeName(type)) + " Block == Sample");
+    } else {
+        results.fail(std::string(typeName(type)) + " Block == Sample", "max diff " + std::to_string(maxDiff));
+    }
+}
+
+void testPassThroughFactor(TestResults& results) {
+    Oversampler os(1);
+    float out = os.processSample(0.25f, [](float s) { return 2.0f * s; });
+    
+    if (os.getFactor() == 1 && out == 0.5f && os.getLatencySamples() == 0.0f) {
+        results.pass("1x Pass-Through");
+    } else {
+        results.fail("1x Pass-Through", "factor 1 should call fn directly with no latency");
+    }
+}
+
+// ============================================================================
+// TEST 4: Adaptive Factor
+// ============================================================================
+
+static void clipBlock(float* data, size_t n) {
+    for (size_t i = 0; i < n; ++i) data[i] = 0.3f * std::tanh(data[i] / 0.3f);
+}
+
+/**
+ * Quiet 2 kHz sine, then driven well past the knee, then quiet again
+ */
+static std::vector<float> quietLoudQuiet(size_t segment) {
+    std::vector<float> x(3 * segment);
+    for (size_t n = 0; n < x.size(); ++n) {
+        const double amplitude = (n >= segment && n < 2 * segment) ? 1.5 : 0.1;
+        x[n] = float(amplitude * std::sin(2.0 * PI * 2000.0 * double(n) / 48000.0));
+    }
+    return x;
+}
+
+void testAdaptiveFactorSelection(TestResults& results) {
+    AdaptiveOversampler os(8);
+
+    const bool quiet = os.requiredFactor(0.1f, 0.01f) == 1;
+    const bool dullDrive = os.requiredFactor(1.0f, 2.0f * float(PI) * 100.0f / 48000.0f) == 1;
+    const bool brightDrive = os.requiredFactor(1.5f, 1.5f * 2.0f * float(PI) * 2000.0f / 48000.0f) == 8;
+    const bool capped = AdaptiveOversampler(4).requiredFactor(2.0f, 1.0f) == 4;
+
+    if (quiet && dullDrive && brightDrive && capped && os.getFactor() == 1) {
+        results.pass("Adaptive factor follows level and slope");
+    } else {
+        results.fail("Adaptive factor follows level and slope", "unexpected factor choice");
+    }
+}
+
+void testAdaptiveSwitchesCleanly(TestResults& results, Oversampler::FilterType type) {
+    const std::string name = std::string("Adaptive ") + typeName(type);
+    const size_t segment = 4 * AdaptiveOversampler::DOWNSHIFT_HOLD_SAMPLES;
+    AdaptiveOversampler adaptive(8, type, 256);
+    Oversampler fixed(8, type, 256);
+
+    std::vector<float> out = quietLoudQuiet(segment), reference = out;
+    std::vector<int> factors;
+    for (size_t start = 0; start < out.size(); start += 256) {
+        adaptive.processBlock(out.data() + start, 256, clipBlock);
+        fixed.processBlock(reference.data() + start, 256, clipBlock);
+        factors.push_back(adaptive.getFactor());
+    }
+
+    // The 8x path has no padding, so the fixed 8x oversampler is the reference
+    const size_t blocksPerSegment = segment / 256;
+    const bool followed = factors[blocksPerSegment / 2] == 1 && factors[blocksPerSegment + 1] == 8
+                          && factors.back() == 1;
+    const bool sameLatency = adaptive.getLatencySamples() == fixed.getLatencySamples();
+
+    // No step in the output may exceed the largest one the reference makes
+    float worstStep = 0.0f, referenceStep = 0.0f, worstLoudError = 0.0f;
+    for (size_t n = 1; n < out.size(); ++n) {
+        worstStep = std::max(worstStep, std::abs(out[n] - out[n - 1]));
+        referenceStep = std::max(referenceStep, std::abs(reference[n] - reference[n - 1]));
+        if (n > segment + 1024 && n < 2 * segment) worstLoudError = std::max(worstLoudError, std::abs(out[n] - reference[n]));
+    }
+
+    if (followed && sameLatency) {
+        results.pass(name + " factor tracks the drive at constant latency");
+    } else {
+        results.fail(name + " factor tracks the drive at constant latency", "factors or latency wrong");
+    }
+    if (worstStep <= 1.05f * referenceStep && worstLoudError < 1e-4f) {
+        results.pass(name + " switches without glitches");
+    } else {
+        results.fail(name + " switches without glitches", "largest step " + std::to_string(worstStep) + " vs " +
+                     std::to_string(referenceStep) + ", driven error " + std::to_string(worstLoudError));
+    }
+}
+
+void testAdaptiveDownshiftHold(TestResults& results) {
+    AdaptiveOversampler os(8, Oversampler::FilterType::LinearPhaseFIR, 64);
+    std::vector<float> x = quietLoudQuiet(2048);
+
+    // processSample decides per DECISION_INTERVAL from the samples before it
+    std::vector<int> factors(x.size());
+    for (size_t n = 0; n < x.size(); ++n) {
+        os.processSample(x[n], [](float s) { return 0.3f * std::tanh(s / 0.3f); });
+        factors[n] = os.getFactor();
+    }
+
+    const bool upshiftedPromptly = factors[2048 + 2 * AdaptiveOversampler::DECISION_INTERVAL] == 8;
+    const bool heldAfterLoud = factors[4096 + 2048 - 1] == 8;
+
+    for (size_t n = 0; n < AdaptiveOversampler::DOWNSHIFT_HOLD_SAMPLES + 1024; ++n) {
+        os.processSample(0.0f, [](float s) { return s; });
+    }
+    const bool downshifted = os.getFactor() == 1 && !os.isTransitioning();
+
+    if (upshiftedPromptly && heldAfterLoud && downshifted) {
+        results.pass("Adaptive downshift waits for the hold time");
+    } else {
+        results.fail("Adaptive downshift waits for the hold time", "factor changed at the wrong time");
+    }
+}
+
+// ============================================================================
+// Main Test Runner
+// ============================================================================
+
+int main() {
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "POLYPHASE OVERSAMPLING TEST SUITE\n";
+    std::cout << std::string(80, '=') << "\n";
+    
+    TestResults results;
+    const Oversampler::FilterType types[] = {
+        Oversampler::FilterType::LinearPhaseFIR, Oversampler::FilterType::MinimumPhaseIIR
+    };
+    
+    std::cout << "\n=== TEST 1: Passband & Latency ===\n";
+    for (auto type : types) {
+        for (int factor : {2, 4, 8}) testPassbandAndLatency(results, factor, type);
+    }
+    
+    std::cout << "\n=== TEST 2: Image Rejection ===\n";
+    for (auto type : types) {
+        for (int factor : {2, 4, 8}) testImageRejection(results, factor, type);
+    }
+    
+    std::cout << "\n=== TEST 3: Block Processing ===\n";
+    for (auto type : types) testBlockMatchesSample(results, type);
+    testPassThroughFactor(results);
+    
+    std::cout << "\n=== TEST 4: Adaptive Factor ===\n";
+    testAdaptiveFactorSelection(results);
+    for (auto type : types) testAdaptiveSwitchesCleanly(results, type);
+    testAdaptiveDownshiftHold(results);
+    
+    results.summary();
+    
+    return results.failed == 0 ? 0 : 1;
+}
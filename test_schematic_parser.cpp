@@ -0,0 +1,193 @@
+#include "LiveSpiceParser.h"
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace LiveSpice;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void pass(const std::string& test) {
+        passed++;
+        std::cout << "✓ PASS: " << test << "\n";
+    }
+
+    void fail(const std::string& test, const std::string& reason) {
+        failed++;
+        std::cout << "✗ FAIL: " << test << " - " << reason << "\n";
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+static const char* const SYMBOL = "Circuit.Symbol, Circuit, Version=1.0.0.0, Culture=neutral, PublicKeyToken=null";
+static const char* const WIRE = "Circuit.Wire, Circuit, Version=1.0.0.0, Culture=neutral, PublicKeyToken=null";
+
+/**
+ * Stress schematic: a grid of resistor/capacitor cells, each wired to its
+ * right-hand neighbour and to a shared ground rail, with comments, an
+ * unnamed part and a repeated name mixed in
+ */
+static std::string stressSchematic(int cells) {
+    std::ostringstream xml;
+    xml << "\xEF\xBB\xBF<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<Schematic Name=\"Stress\">\n";
+    xml << "  <Element Type=\"" << SYMBOL << "\" Position=\"0,-40\">\n"
+        << "    <Component _Type=\"Circuit.Ground, Circuit\" Name=\"GND\" />\n  </Element>\n";
+    for (int i = 0; i < cells; ++i) {
+        const int x = (i % 200) * 40, y = (i / 200) * 40;
+        if (i % 997 == 0) xml << "  <!-- <Element Type=\"" << WIRE << "\" A=\"0,0\" B=\"1,1\" /> -->\n";
+        const char* part = i % 2 ? "Circuit.Capacitor, Circuit" : "Circuit.Resistor, Circuit";
+        const char* value = i % 2 ? "Capacitance=\"47 nF\"" : "Resistance=\"4.7 k&#937;\"";
+        xml << "  <Element Type=\"" << SYMBOL << "\" Rotation=\"" << (i % 4) << "\" Flip=\"" << (i % 3 == 0 ? "true" : "false")
+            << "\" Position=\"" << x << "," << y << "\">\n";
+        if (i == cells / 2) {
+            xml << "    <Component _Type=\"" << part << "\" " << value << " />\n  </Element>\n";
+        } else {
+            xml << "    <Component _Type=\"" << part << "\" " << value << " Name=\"" << (i == cells - 1 ? 1 : i) << "\" />\n"
+                << "  </Element>\n";
+        }
+        xml << "  <Element Type=\"" << WIRE << "\" A=\"" << x << "," << y << "\" B=\"" << x + 40 << "," << y << "\" />\n";
+        xml << "  <Element Type=\"" << WIRE << "\" A=\"" << x << "," << y << "\" B=\"0,-40\" />\n";
+    }
+    xml << "</Schematic>\n";
+    return xml.str();
+}
+
+static bool sameComponent(const Component& a, const Component& b) {
+    if (a.getName() != b.getName() || a.getType() != b.getType() || a.getPosX() != b.getPosX()
+        || a.getPosY() != b.getPosY() || a.getRotation() != b.getRotation() || a.getFlipped() != b.getFlipped()) {
+        return false;
+    }
+    const auto pa = a.getParams(), pb = b.getParams();
+    if (pa.size() != pb.size()) return false;
+    for (size_t i = 0; i < pa.size(); ++i) {
+        if (pa[i].name != pb[i].name || pa[i].value != pb[i].value) return false;
+    }
+    return true;
+}
+
+static bool sameNetlist(const Netlist& a, const Netlist& b) {
+    if (a.getComponentCount() != b.getComponentCount() || a.getWireCount() != b.getWireCount()) return false;
+    for (auto ia = a.getComponents().begin(), ib = b.getComponents().begin(); ia != a.getComponents().end(); ++ia, ++ib) {
+        if (!sameComponent(*ia->second, *ib->second)) return false;
+    }
+    for (size_t w = 0; w < a.getWireCount(); ++w) {
+        const Wire& wa = a.getWires()[w];
+        const Wire& wb = b.getWires()[w];
+        if (wa.nodeA_X != wb.nodeA_X || wa.nodeA_Y != wb.nodeA_Y || wa.nodeB_X != wb.nodeB_X || wa.nodeB_Y != wb.nodeB_Y) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool sameCompact(const CompactNetlist& a, const CompactNetlist& b) {
+    return a.components == b.components && a.componentNode == b.componentNode && a.nodePositions == b.nodePositions
+        && a.nodeComponentOffsets == b.nodeComponentOffsets && a.nodeComponentIds == b.nodeComponentIds
+        && a.componentNodeOffsets == b.componentNodeOffsets && a.componentNodeIds == b.componentNodeIds
+        && a.neighborOffsets == b.neighborOffsets && a.neighborIds == b.neighborIds;
+}
+
+template <typename Fn>
+static double millisecondsOf(Fn fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+void testSmallDocument(TestResults& results) {
+    const std::string xml = stressSchematic(10);
+    const Schematic schematic = SchematicParser::parseString(xml);
+    const Netlist& netlist = schematic.getNetlist();
+
+    // 10 cells + ground, the last cell reusing name "1". Cell i's Component
+    // tag is on line 8 + 5i (after the header, ground and one comment)
+    const auto unnamed = netlist.getComponent("Unnamed_" + std::to_string(8 + 5 * 5));
+    const auto repeated = netlist.getComponent("1");
+    const bool parsed = netlist.getComponentCount() == 10 && netlist.getWireCount() == 20 && unnamed
+        && repeated && repeated->getPosX() == 9 * 40 && repeated->getRotation() == 1
+        && std::abs(repeated->getCanonicalParams().capacitance - 47e-9) < 1e-15;
+
+    if (parsed) results.pass("Comments skipped, unnamed parts named by line, last repeated name wins");
+    else results.fail("Comments skipped, unnamed parts named by line, last repeated name wins",
+                      std::to_string(netlist.getComponentCount()) + " components, "
+                      + std::to_string(netlist.getWireCount()) + " wires");
+}
+
+void testParallelParseMatchesSerial(TestResults& results) {
+    const std::string xml = stressSchematic(30000);
+    Schematic serial, parallel;
+    const double serialMs = millisecondsOf([&] { serial = SchematicParser::parseString(xml, 1); });
+    const double parallelMs = millisecondsOf([&] { parallel = SchematicParser::parseString(xml, 8); });
+    std::cout << "  parse 90k elements: " << serialMs << " ms on 1 thread, " << parallelMs << " ms on up to 8\n";
+
+    if (sameNetlist(serial.getNetlist(), parallel.getNetlist()) && serial.getNetlist().getComponentCount() == 30000) {
+        results.pass("Chunked parse equals a single pass");
+    } else {
+        results.fail("Chunked parse equals a single pass", "netlists differ");
+    }
+}
+
+void testParallelConnectivityMatchesSerial(TestResults& results) {
+    const std::string xml = stressSchematic(30000);
+    Schematic serial = SchematicParser::parseString(xml, 1);
+    Schematic parallel = SchematicParser::parseString(xml, 1);
+    const double serialMs = millisecondsOf([&] { serial.getNetlist().buildConnectivityPool(1); });
+    const double parallelMs = millisecondsOf([&] { parallel.getNetlist().buildConnectivityPool(8); });
+    std::cout << "  connectivity: " << serialMs << " ms on 1 thread, " << parallelMs << " ms on up to 8\n";
+
+    // Parsed separately, so the component pointers differ: compare the views too
+    const auto& a = serial.getNetlist();
+    const auto& b = parallel.getNetlist();
+    CompactNetlist pa = a.getCompact(), pb = b.getCompact();
+    pa.components.clear();
+    pb.components.clear();
+    const bool same = sameCompact(pa, pb) && a.getConnectivityPool() == b.getConnectivityPool();
+    const auto ground = a.getCompact().findComponent("GND");
+    const bool shared = ground != CompactNetlist::NONE && a.getCompact().neighborsOf(ground).size() == 30000 - 1;
+
+    if (same && shared) results.pass("Sharded connectivity build equals the single-thread build");
+    else results.fail("Sharded connectivity build equals the single-thread build", same ? "ground rail" : "compact forms differ");
+}
+
+int main() {
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "SCHEMATIC PARSER TEST SUITE\n";
+    std::cout << std::string(80, '=') << "\n";
+
+    TestResults results;
+
+    std::cout << "\n=== TEST 1: Parsing ===\n";
+    testSmallDocument(results);
+    testParallelParseMatchesSerial(results);
+
+    std::cout << "\n=== TEST 2: Connectivity ===\n";
+    testParallelConnectivityMatchesSerial(results);
+
+    results.summary();
+
+    return results.failed == 0 ? 0 : 1;
+}
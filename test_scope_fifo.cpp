@@ -0,0 +1,234 @@
+#include "ScopeFifo.h"
+#include <iostream>
+#include <cmath>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace LiveSpiceDSP;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void check(const std::string& test, bool condition, const std::string& detail) {
+        if (condition) {
+            passed++;
+            std::cout << "✓ PASS: " << test << " (" << detail << ")\n";
+        } else {
+            failed++;
+            std::cout << "✗ FAIL: " << test << " - " << detail << "\n";
+        }
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+static const double kPi = 3.14159265358979323846;
+
+// ============================================================================
+// FIFO
+// ============================================================================
+
+static void testFifo(TestResults& results) {
+    ScopeFifo fifo(2, 100);
+    results.check("Capacity rounds up", fifo.capacity() == 128, std::to_string(fifo.capacity()));
+
+    // Wrap-around keeps both channels in order
+    std::vector<float> left(48), right(48), outL(48), outR(48);
+    bool ordered = true;
+    float next = 0.0f, expected = 0.0f;
+    for (int block = 0; block < 20; ++block) {
+        for (size_t i = 0; i < left.size(); ++i) {
+            left[i] = next;
+            right[i] = -next;
+            next += 1.0f;
+        }
+        const float* in[] = {left.data(), right.data()};
+        fifo.push(in, 2, left.size());
+
+        float* out[] = {outL.data(), outR.data()};
+        size_t n = fifo.pop(out, outL.size());
+        for (size_t i = 0; i < n; ++i) {
+            ordered &= (outL[i] == expected && outR[i] == -expected);
+            expected += 1.0f;
+        }
+    }
+    results.check("Wrap-around order", ordered && expected == next, "960 samples through a 128 ring");
+
+    // Full ring drops the newest samples and counts them, never blocks
+    std::vector<float> block(100, 1.0f);
+    const float* in[] = {block.data(), block.data()};
+    size_t first = fifo.push(in, 2, 100);
+    size_t second = fifo.push(in, 2, 100);
+    results.check("Overrun drops excess", first == 100 && second == 28 && fifo.getNumReady() == 128,
+                  "stored " + std::to_string(first) + " + " + std::to_string(second));
+    results.check("Overrun counters", fifo.getOverruns() == 1 && fifo.getDroppedSamples() == 72,
+                  std::to_string(fifo.getOverruns()) + " overrun, " + std::to_string(fifo.getDroppedSamples()) +
+                      " dropped");
+
+    // Missing channels arrive as silence
+    fifo.skip(fifo.getNumReady());
+    fifo.push(in, 1, 10);
+    float* out[] = {outL.data(), outR.data()};
+    fifo.pop(out, 10);
+    results.check("Missing channel is silent", outL[9] == 1.0f && outR[9] == 0.0f, "mono push into stereo FIFO");
+}
+
+static void testThreaded(TestResults& results) {
+    ScopeFifo fifo(1, 4096);
+    const size_t total = 64 * 8000;
+    std::thread producer([&] {
+        std::vector<float> block(64);
+        size_t value = 0;
+        while (value < total) {
+            for (auto& x : block) x = (float)(value++ % 1000003);
+            const float* in[] = {block.data()};
+            fifo.push(in, 1, block.size());
+            std::this_thread::yield();
+        }
+    });
+
+    // A consumer that only sees gaps where the producer recorded drops
+    std::vector<float> buffer(1024);
+    size_t received = 0, gaps = 0;
+    float last = -1.0f;
+    bool monotonic = true;
+    while (received + fifo.getDroppedSamples() < total || fifo.getNumReady() > 0) {
+        float* out[] = {buffer.data()};
+        size_t n = fifo.pop(out, buffer.size());
+        for (size_t i = 0; i < n; ++i) {
+            float expectedNext = last + 1.0f;
+            if (buffer[i] != expectedNext && buffer[i] != 0.0f) {
+                if (buffer[i] < expectedNext) monotonic = false;
+                ++gaps;
+            }
+            last = buffer[i];
+        }
+        received += n;
+    }
+    producer.join();
+
+    results.check("Producer never blocks", received + fifo.getDroppedSamples() == total,
+                  std::to_string(received) + " received + " + std::to_string(fifo.getDroppedSamples()) + " dropped");
+    results.check("Gaps only at overruns", monotonic && gaps <= fifo.getOverruns(),
+                  std::to_string(gaps) + " gaps, " + std::to_string(fifo.getOverruns()) + " overruns");
+}
+
+// ============================================================================
+// Trigger and decimation
+// ============================================================================
+
+static std::vector<float> sine(size_t length, double period, double phase, float amplitude) {
+    std::vector<float> x(length);
+    for (size_t i = 0; i < length; ++i) x[i] = amplitude * (float)std::sin(2.0 * kPi * ((double)i / period) + phase);
+    return x;
+}
+
+static void testTrigger(TestResults& results) {
+    ScopeSettings settings;
+    settings.mode = ScopeSettings::Mode::Normal;
+    settings.frameLength = 512;
+    settings.preTrigger = 64;
+    settings.displayPoints = 512;
+
+    // Frames start at the same phase however the blocks fall
+    bool stable = true;
+    int frames = 0;
+    for (double phase : {0.3, 1.7, 4.0}) {
+        ScopeFifo fifo(1, 8192);
+        ScopeCapture capture(1, settings);
+        ScopeFrame frame;
+        auto x = sine(6000, 200.0, phase, 0.5f);
+        for (size_t i = 0; i < x.size(); i += 37) {
+            const float* in[] = {x.data() + i};
+            fifo.push(in, 1, std::min<size_t>(37, x.size() - i));
+            if (capture.update(fifo, frame)) {
+                ++frames;
+                stable &= frame.triggered && frame.getMax(0, 63) < 0.0f && frame.getMax(0, 64) >= 0.0f;
+            }
+        }
+    }
+    results.check("Rising edge at pre-trigger", stable && frames > 6, std::to_string(frames) + " frames");
+
+    // Normal mode waits, auto mode free-runs on a flat signal
+    std::vector<float> flat(4096, -0.2f);
+    const float* in[] = {flat.data()};
+    ScopeFrame frame;
+    ScopeFifo normalFifo(1, 8192);
+    ScopeCapture normal(1, settings);
+    normalFifo.push(in, 1, flat.size());
+    bool normalFired = normal.update(normalFifo, frame);
+
+    settings.mode = ScopeSettings::Mode::Auto;
+    ScopeFifo autoFifo(1, 8192);
+    ScopeCapture automatic(1, settings);
+    autoFifo.push(in, 1, flat.size());
+    bool autoFired = automatic.update(autoFifo, frame);
+    results.check("Normal waits, auto free-runs", !normalFired && autoFired && !frame.triggered,
+                  std::string("normal ") + (normalFired ? "fired" : "waited") + ", auto " +
+                      (autoFired ? "fired" : "waited"));
+
+    // Hysteresis ignores noise around the level
+    settings.mode = ScopeSettings::Mode::Normal;
+    settings.hysteresis = 0.1f;
+    ScopeFifo noisyFifo(1, 8192);
+    ScopeCapture noisy(1, settings);
+    std::vector<float> jitter(4096);
+    for (size_t i = 0; i < jitter.size(); ++i) jitter[i] = (i % 2) ? 0.02f : -0.02f;
+    const float* jin[] = {jitter.data()};
+    noisyFifo.push(jin, 1, jitter.size());
+    results.check("Hysteresis rejects jitter", !noisy.update(noisyFifo, frame), "±0.02 around 0 with 0.1 hysteresis");
+}
+
+static void testDecimation(TestResults& results) {
+    ScopeSettings settings;
+    settings.mode = ScopeSettings::Mode::FreeRun;
+    settings.frameLength = 4096;
+    settings.displayPoints = 64;
+
+    // One-sample spikes survive 64:1 reduction
+    std::vector<float> x(4096, 0.0f);
+    for (size_t i = 100; i < x.size(); i += 500) x[i] = (i % 1000 == 100) ? 1.0f : -1.0f;
+    ScopeFifo fifo(1, 8192);
+    ScopeCapture capture(1, settings);
+    ScopeFrame frame;
+    const float* in[] = {x.data()};
+    fifo.push(in, 1, x.size());
+    bool fired = capture.update(fifo, frame);
+
+    int spikes = 0;
+    for (size_t p = 0; p < frame.numPoints; ++p)
+        spikes += (frame.getMax(0, p) == 1.0f) + (frame.getMin(0, p) == -1.0f);
+    results.check("Min/max keeps peaks", fired && frame.numPoints == 64 && spikes == 8,
+                  std::to_string(spikes) + " of 8 spikes visible");
+}
+
+int main() {
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "SCOPE FIFO - TEST SUITE\n";
+    std::cout << std::string(80, '=') << "\n";
+
+    TestResults results;
+    testFifo(results);
+    testThreaded(results);
+    testTrigger(results);
+    testDecimation(results);
+
+    results.summary();
+    return results.failed == 0 ? 0 : 1;
+}
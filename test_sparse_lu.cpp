@@ -0,0 +1,230 @@
+#include "SparseLU.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+
+using namespace LiveSpiceDSP;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void pass(const std::string& test) {
+        passed++;
+        std::cout << "✓ PASS: " << test << "\n";
+    }
+
+    void fail(const std::string& test, const std::string& reason) {
+        failed++;
+        std::cout << "✗ FAIL: " << test << " - " << reason << "\n";
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+// Largest |A x - b|
+static double residual(const SparseMatrix& A, const std::vector<double>& x, const std::vector<double>& b) {
+    std::vector<double> y;
+    A.multiply(x, y);
+    double worst = 0.0;
+    for (size_t r = 0; r < b.size(); ++r) worst = std::max(worst, std::abs(y[r] - b[r]));
+    return worst;
+}
+
+// Resistor ladder with a grounded conductance on every node, plus random cross links
+static SparseMatrix randomNetwork(size_t n, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> conductance(1e-4, 1e-2);
+    std::uniform_int_distribution<size_t> node(0, n - 1);
+    SparseMatrix A(n);
+    auto stamp = [&](size_t a, size_t b, double g) {
+        A.add(a, a, g);
+        A.add(b, b, g);
+        A.add(a, b, -g);
+        A.add(b, a, -g);
+    };
+    for (size_t k = 0; k < n; ++k) A.add(k, k, 1e-6);
+    for (size_t k = 0; k + 1 < n; ++k) stamp(k, k + 1, conductance(rng));
+    for (size_t k = 0; k < n / 4; ++k) {
+        const size_t a = node(rng), b = node(rng);
+        if (a != b) stamp(a, b, conductance(rng));
+    }
+    return A;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+void testSolve(TestResults& results) {
+    const SparseMatrix A = randomNetwork(60, 7);
+    std::vector<double> b(60);
+    for (size_t k = 0; k < b.size(); ++k) b[k] = std::sin(0.3 * static_cast<double>(k));
+
+    SparseLU lu;
+    std::vector<double> x = b;
+    if (lu.analyze(A)) lu.solve(x);
+    const double error = residual(A, x, b);
+    if (lu.isFactored() && error < 1e-12) {
+        results.pass("Solve a 60-node network");
+    } else {
+        results.fail("Solve", "residual " + std::to_string(error));
+    }
+}
+
+void testZeroDiagonal(TestResults& results) {
+    // MNA with a voltage source: node 0 -- 1k -- node 1 -- 2k -- ground,
+    // source row 2 forces v0 = 3 V and has no diagonal entry
+    SparseMatrix A(3);
+    A.add(0, 0, 1e-3);  A.add(0, 1, -1e-3); A.add(0, 2, 1.0);
+    A.add(1, 0, -1e-3); A.add(1, 1, 1e-3 + 0.5e-3);
+    A.add(2, 0, 1.0);
+    std::vector<double> x{0.0, 0.0, 3.0};
+
+    SparseLU lu;
+    if (lu.analyze(A)) lu.solve(x);
+    if (lu.isFactored() && std::abs(x[0] - 3.0) < 1e-12 && std::abs(x[1] - 2.0) < 1e-12 && std::abs(x[2] + 1e-3) < 1e-15) {
+        results.pass("Zero-diagonal MNA system (voltage source row)");
+    } else {
+        results.fail("Zero-diagonal MNA system", "v0 " + std::to_string(x[0]) + ", v1 " + std::to_string(x[1]));
+    }
+}
+
+void testMarkowitzAvoidsFill(TestResults& results) {
+    // Arrow matrix: a hub coupled to every node. Eliminating the hub first
+    // would fill the whole matrix; Markowitz leaves it for last.
+    const size_t n = 50;
+    SparseMatrix A(n);
+    for (size_t k = 1; k < n; ++k) {
+        A.add(0, 0, 1.0);
+        A.add(k, k, 1.0 + 1e-3);
+        A.add(0, k, -1.0);
+        A.add(k, 0, -1.0);
+    }
+    A.add(0, 0, 1e-3);
+
+    SparseLU lu;
+    lu.analyze(A);
+    if (lu.isFactored() && lu.getFactorNonZeros() == A.getNonZeros()) {
+        results.pass("Markowitz ordering: no fill on an arrow matrix");
+    } else {
+        results.fail("Markowitz ordering", std::to_string(lu.getFactorNonZeros()) + " factor entries for "
+                     + std::to_string(A.getNonZeros()));
+    }
+}
+
+void testRefactorReusesPattern(TestResults& results) {
+    SparseMatrix A = randomNetwork(40, 11);
+    SparseLU lu;
+    lu.analyze(A);
+
+    // Same pattern, new values (a Newton iteration restamping companions)
+    bool ok = true;
+    for (int iteration = 0; iteration < 5; ++iteration) {
+        for (size_t k = 0; k < A.size(); k += 3) A.add(k, k, 1e-3 * (iteration + 1));
+        std::vector<double> b(A.size(), 1.0), x = b;
+        ok = ok && lu.refactor(A);
+        lu.solve(x);
+        ok = ok && residual(A, x, b) < 1e-10;
+    }
+
+    // A new structural entry needs a fresh analysis
+    A.add(0, A.size() - 1, -1e-3);
+    A.add(A.size() - 1, 0, -1e-3);
+    const bool rejected = !lu.refactor(A);
+    const bool recovered = lu.factor(A);
+    if (ok && rejected && recovered && lu.getAnalyzeCount() == 2) {
+        results.pass("Refactor reuses the analyzed pattern; new entries trigger re-analysis");
+    } else {
+        results.fail("Refactor", std::string(ok ? "" : "refactor failed; ") + (rejected ? "" : "pattern change missed; ")
+                     + "analyses " + std::to_string(lu.getAnalyzeCount()));
+    }
+}
+
+void testSingular(TestResults& results) {
+    // Two voltage sources across the same node
+    SparseMatrix A(3);
+    A.add(0, 0, 1e-3);
+    A.add(0, 1, 1.0);
+    A.add(0, 2, 1.0);
+    A.add(1, 0, 1.0);
+    A.add(2, 0, 1.0);
+
+    SparseLU lu;
+    if (!lu.analyze(A)) {
+        results.pass("Singular matrix rejected");
+    } else {
+        results.fail("Singular matrix", "factored");
+    }
+}
+
+void testChordNewton(TestResults& results) {
+    // 1k from a 5 V node into a diode to ground: 2 unknowns (v1, v2)
+    // F1 = (v1 - 5) * 1e6   (stiff source row)   F2 = (v2 - v1) / 1k + Id(v2)
+    const double Is = 1e-12, nVt = 0.02585;
+    SparseMatrix J(2);
+    std::vector<double> v{5.0, 0.0};
+    SparseLU lu;
+    JacobianReuse reuse;
+    int iterations = 0;
+    double step = 1.0;
+    for (; iterations < 200 && step > 1e-12; ++iterations) {
+        const double e = std::exp(std::min(v[1] / nVt, 80.0));
+        std::vector<double> F{(v[0] - 5.0) * 1e6, (v[1] - v[0]) / 1000.0 + Is * (e - 1.0)};
+        if (reuse.refactorNeeded(std::max(std::abs(F[0]), std::abs(F[1])))) {
+            J.clearValues();
+            J.add(0, 0, 1e6);
+            J.add(1, 0, -1e-3);
+            J.add(1, 1, 1e-3 + Is * e / nVt);
+            lu.factor(J);
+        }
+        lu.solve(F);
+        // Cap the junction step so the exponential cannot overshoot
+        const double dv = std::max(-0.1, std::min(0.1, -F[1]));
+        v[0] -= F[0];
+        v[1] += dv;
+        step = std::abs(dv);
+    }
+    const double current = (v[0] - v[1]) / 1000.0;
+    const double diode = Is * (std::exp(v[1] / nVt) - 1.0);
+    if (step <= 1e-12 && std::abs(current - diode) < 1e-9 && reuse.getRefactorCount() < iterations
+        && lu.getAnalyzeCount() == 1) {
+        results.pass("Chord Newton converges with " + std::to_string(reuse.getRefactorCount()) + " factorizations in "
+                     + std::to_string(iterations) + " iterations");
+    } else {
+        results.fail("Chord Newton", "v2 " + std::to_string(v[1]) + ", " + std::to_string(reuse.getRefactorCount())
+                     + " factorizations in " + std::to_string(iterations) + " iterations");
+    }
+}
+
+int main() {
+    std::cout << "Sparse LU Tests\n";
+    std::cout << std::string(80, '=') << "\n\n";
+
+    TestResults results;
+    testSolve(results);
+    testZeroDiagonal(results);
+    testMarkowitzAvoidsFill(results);
+    testRefactorReusesPattern(results);
+    testSingular(results);
+    testChordNewton(results);
+
+    results.summary();
+    return results.failed == 0 ? 0 : 1;
+}
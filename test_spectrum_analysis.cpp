@@ -0,0 +1,173 @@
+#include "SpiceValidation.h"
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace SpiceValidation;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void pass(const std::string& test) {
+        passed++;
+        std::cout << "✓ PASS: " << test << "\n";
+    }
+
+    void fail(const std::string& test, const std::string& reason) {
+        failed++;
+        std::cout << "✗ FAIL: " << test << " - " << reason << "\n";
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+static const float SAMPLE_RATE = 48000.0f;
+static const double TWO_PI = 6.283185307179586;
+
+// Fundamental plus harmonics given as {order, amplitude relative to the fundamental}
+static std::vector<float> tone(float frequency, float amplitude, std::initializer_list<std::pair<int, float>> harmonics,
+                               size_t length = 16384) {
+    std::vector<float> signal(length);
+    for (size_t n = 0; n < length; ++n) {
+        const double phase = TWO_PI * frequency * n / SAMPLE_RATE;
+        double x = std::sin(phase);
+        for (const auto& h : harmonics) x += h.second * std::sin(h.first * phase + 0.3);
+        signal[n] = static_cast<float>(amplitude * x);
+    }
+    return signal;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+void testFFTMatchesDFT(TestResults& results) {
+    const size_t size = 64;
+    std::vector<float> re(size), im(size);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+    for (size_t i = 0; i < size; ++i) {
+        re[i] = dist(rng);
+        im[i] = dist(rng);
+    }
+    const auto inRe = re, inIm = im;
+
+    FFTPlan(size).forward(re.data(), im.data());
+
+    double worst = 0.0;
+    for (size_t k = 0; k < size; ++k) {
+        double sumRe = 0.0, sumIm = 0.0;
+        for (size_t n = 0; n < size; ++n) {
+            const double angle = -TWO_PI * double(k * n) / size;
+            sumRe += inRe[n] * std::cos(angle) - inIm[n] * std::sin(angle);
+            sumIm += inRe[n] * std::sin(angle) + inIm[n] * std::cos(angle);
+        }
+        worst = std::max(worst, std::hypot(re[k] - sumRe, im[k] - sumIm));
+    }
+    if (worst < 1e-4) {
+        results.pass("FFT matches direct DFT");
+    } else {
+        results.fail("FFT", "max error " + std::to_string(worst));
+    }
+}
+
+void testPureSine(TestResults& results) {
+    SpectrumAnalyzer analyzer;
+    const auto signal = tone(1000.0f, 0.5f, {});
+    const auto metrics = analyzer.analyze(signal.data(), signal.size(), 1000.0f, SAMPLE_RATE);
+    if (metrics.thd < 0.01f && std::abs(metrics.fundamentalAmplitude - 0.5f) < 0.01f &&
+        std::abs(metrics.fundamentalHz - 1000.0f) < 3.0f) {
+        results.pass("Pure sine: THD " + std::to_string(metrics.thd) + "%, amplitude " +
+                     std::to_string(metrics.fundamentalAmplitude));
+    } else {
+        results.fail("Pure sine", "THD " + std::to_string(metrics.thd) + "%, amplitude " +
+                     std::to_string(metrics.fundamentalAmplitude));
+    }
+}
+
+void testKnownHarmonics(TestResults& results) {
+    SpectrumAnalyzer analyzer;
+    const auto signal = tone(440.0f, 0.8f, {{3, 0.01f}});
+    const auto metrics = analyzer.analyze(signal.data(), signal.size(), 440.0f, SAMPLE_RATE);
+    const float h3 = metrics.harmonicLevelsDb.size() > 1 ? metrics.harmonicLevelsDb[1] : 0.0f;
+    if (std::abs(metrics.thd - 1.0f) < 0.02f && std::abs(h3 + 40.0f) < 0.2f) {
+        results.pass("1% third harmonic: THD " + std::to_string(metrics.thd) + "%, H3 " + std::to_string(h3) + " dBc");
+    } else {
+        results.fail("Third harmonic", "THD " + std::to_string(metrics.thd) + "%, H3 " + std::to_string(h3) + " dBc");
+    }
+
+    // ComparisonAnalyzer uses the same analysis (and the default 44.1 kHz tone)
+    std::vector<float> clipped(8192);
+    for (size_t n = 0; n < clipped.size(); ++n) {
+        clipped[n] = std::tanh(2.0f * std::sin(float(TWO_PI * 1000.0 * n / 44100.0)));
+    }
+    const float thd = ComparisonAnalyzer::calculateTHD(clipped, 1000.0f, 44100.0f);
+    if (thd > 5.0f && thd < 40.0f) {
+        results.pass("tanh clipper THD " + std::to_string(thd) + "%");
+    } else {
+        results.fail("tanh clipper", "THD " + std::to_string(thd) + "%");
+    }
+}
+
+void testNoiseRaisesTHDPlusNoise(TestResults& results) {
+    auto signal = tone(1000.0f, 0.5f, {{2, 0.005f}});
+    std::mt19937 rng(3);
+    std::normal_distribution<float> noise(0.0f, 0.005f);
+    for (auto& x : signal) x += noise(rng);
+
+    SpectrumAnalyzer analyzer;
+    const auto metrics = analyzer.analyze(signal.data(), signal.size(), 1000.0f, SAMPLE_RATE);
+    // 0.5% H2; noise at -40 dB re. the fundamental's RMS adds ~1.4%
+    if (std::abs(metrics.thd - 0.5f) < 0.05f && metrics.thdPlusNoise > 1.2f && metrics.thdPlusNoise < 2.0f) {
+        results.pass("THD+N " + std::to_string(metrics.thdPlusNoise) + "% > THD " + std::to_string(metrics.thd) + "%");
+    } else {
+        results.fail("THD+N", "THD " + std::to_string(metrics.thd) + "%, THD+N " + std::to_string(metrics.thdPlusNoise) + "%");
+    }
+}
+
+void testSpectralError(TestResults& results) {
+    SpectrumAnalyzer analyzer;
+    const auto reference = tone(1000.0f, 0.5f, {{2, 0.1f}, {3, 0.05f}}, 8192);
+    auto louder = reference;
+    for (auto& x : louder) x *= 1.1220185f;   // +1 dB
+
+    const float same = analyzer.spectralError(reference.data(), reference.data(), reference.size());
+    const float gain = analyzer.spectralError(louder.data(), reference.data(), reference.size());
+    if (same < 1e-3f && std::abs(gain - 1.0f) < 0.01f) {
+        results.pass("Spectral error: identical " + std::to_string(same) + " dB, +1 dB gain " + std::to_string(gain) + " dB");
+    } else {
+        results.fail("Spectral error", "identical " + std::to_string(same) + " dB, gain " + std::to_string(gain) + " dB");
+    }
+}
+
+int main() {
+    std::cout << "Spectrum Analysis Tests\n";
+    std::cout << std::string(80, '=') << "\n\n";
+
+    TestResults results;
+    testFFTMatchesDFT(results);
+    testPureSine(results);
+    testKnownHarmonics(results);
+    testNoiseRaisesTHDPlusNoise(results);
+    testSpectralError(results);
+
+    results.summary();
+    return results.failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+#include "SpiceModelLibrary.h"
+#include "ComponentCharacteristicsDatabase.h"
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace LiveSpice;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void pass(const std::string& test) {
+        passed++;
+        std::cout << "✓ PASS: " << test << "\n";
+    }
+
+    void fail(const std::string& test, const std::string& reason) {
+        failed++;
+        std::cout << "✗ FAIL: " << test << " - " << reason << "\n";
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+static bool near(double a, double b) {
+    return std::abs(a - b) <= 1e-6 * std::abs(b);
+}
+
+static const char* LIBRARY_TEXT =
+    "* Vendor library\n"
+    ".MODEL 1N34A D(IS=2.6u N=1.6 RS=1.2\n"
+    "* comment between continuation lines\n"
+    "+ CJO=0.5pF M=0.333) ; germanium\n"
+    ".subckt OPAMP 1 2 3\n"
+    ".model DX D(IS=1)\n"
+    ".ends\n"
+    ".model q2n5088 npn (Is=5.9f, Bf=1.4K, Vaf=62 Rb=10)\n"
+    ".model J201 NJF(VTO=-0.8 BETA=1.3m LAMBDA=0.02)\n"
+    ".model 1N34A D(IS=1)\n";
+
+static std::string writeLibrary() {
+    const std::string path = (std::filesystem::temp_directory_path() / "livespice_test_models.lib").string();
+    std::filesystem::remove(path + ".idx");
+    std::ofstream(path) << LIBRARY_TEXT;
+    return path;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+void testParseNumber(TestResults& results) {
+    struct Case { const char* text; double value; };
+    const Case cases[] = {{"4.7K", 4.7e3}, {"1MEG", 1e6}, {"10p", 10e-12}, {"2.5e-3V", 2.5e-3},
+                          {"3m", 3e-3}, {"0.5pF", 0.5e-12}, {"100", 100.0}};
+    for (const auto& c : cases) {
+        auto value = SpiceModelLibrary::parseNumber(c.text);
+        if (!value || !near(*value, c.value)) {
+            results.fail("parseNumber", c.text);
+            return;
+        }
+    }
+    if (SpiceModelLibrary::parseNumber("abc")) {
+        results.fail("parseNumber", "accepted \"abc\"");
+        return;
+    }
+    results.pass("SPICE numbers with scale suffixes and units");
+}
+
+void testIndexAndLookup(TestResults& results) {
+    const std::string path = writeLibrary();
+    SpiceModelLibrary library(path);
+    if (!library.isOpen() || !library.indexRebuilt()) {
+        results.fail("Index", "library not opened or index not built");
+        return;
+    }
+    if (library.size() != 3 || library.contains("DX") || !library.contains("1n34a")) {
+        results.fail("Index", "expected 1N34A, Q2N5088 and J201 only, got " + std::to_string(library.size()));
+        return;
+    }
+    results.pass("Top-level models indexed, subcircuit models skipped");
+
+    const auto diode = library.diode("1N34A");
+    if (diode && near(diode->Is, 2.6e-6f) && near(diode->CjZero, 0.5e-12f) && near(diode->m, 0.333f)) {
+        results.pass("Continuation lines joined; first definition wins");
+    } else {
+        results.fail("1N34A", diode ? "Is = " + std::to_string(diode->Is) : "not found");
+    }
+
+    const auto bjt = library.bjt("Q2N5088");
+    const auto fet = library.fet("J201");
+    if (bjt && near(bjt->Bf, 1400.0f) && near(bjt->Vat, 62.0f) && fet && near(fet->Kp, 2.6e-3f) &&
+        near(fet->Vef, 50.0f) && !library.diode("J201")) {
+        results.pass("BJT and JFET parameters mapped");
+    } else {
+        results.fail("Transistors", "unexpected characteristics");
+    }
+
+    SpiceModelLibrary reopened(path);
+    if (reopened.isOpen() && !reopened.indexRebuilt() && reopened.kind("J201") == SpiceModelLibrary::ModelKind::NJF) {
+        results.pass("Index reused while the library is unchanged");
+    } else {
+        results.fail("Index reuse", "index was rebuilt");
+    }
+
+    std::remove(path.c_str());
+    std::remove((path + ".idx").c_str());
+}
+
+void testRegistryResolvesUnknownParts(TestResults& results) {
+    const std::string path = writeLibrary();
+    if (!SpiceModelLibrary::registerLibrary(path)) {
+        results.fail("Registry", "cannot register " + path);
+        return;
+    }
+    const auto* part = Nonlinear::ComponentDB::getDiodeDB().find("1N34A");
+    const auto model = SpiceModelLibrary::findModelStatement("q2n5088");
+    if (part && near(part->Is, 2.6e-6f) && model && model->rfind("Q2N5088 NPN(IS=5.9f", 0) == 0 &&
+        SpiceModelLibrary::registryFingerprint() != 0) {
+        results.pass("Device database resolves parts from registered libraries");
+    } else {
+        results.fail("Registry", model ? *model : "model not found");
+    }
+}
+
+int main() {
+    std::cout << "SPICE Model Library Tests\n";
+    std::cout << std::string(80, '=') << "\n\n";
+
+    TestResults results;
+    testParseNumber(results);
+    testIndexAndLookup(results);
+    testRegistryResolvesUnknownParts(results);
+
+    results.summary();
+    return results.failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,152 @@
+#include "SpiceRawFile.h"
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace SpiceValidation;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void pass(const std::string& test) {
+        passed++;
+        std::cout << "✓ PASS: " << test << "\n";
+    }
+
+    void fail(const std::string& test, const std::string& reason) {
+        failed++;
+        std::cout << "✗ FAIL: " << test << " - " << reason << "\n";
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+static std::string tempPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+// Transient of v(2) = sin(2 pi 1k t), v(3) = 0.5 v(2) at uneven time steps, as ngspice writes it
+static std::string writeTransient(const char* name, size_t points, size_t writtenPoints, bool inlineFirstVariable) {
+    const std::string path = tempPath(name);
+    std::ofstream file(path, std::ios::binary);
+    file << "Title: * clipper\n"
+         << "Date: Thu Jan  1 00:00:00  2026\n"
+         << "Plotname: Transient Analysis\n"
+         << "Flags: real\n"
+         << "No. Variables: 3\n"
+         << "No. Points: " << points << "\n";
+    if (inlineFirstVariable) {
+        file << "Variables: 0\ttime\ttime\n";
+    } else {
+        file << "Variables:\n\t0\ttime\ttime\n";
+    }
+    file << "\t1\tv(2)\tvoltage\n"
+         << "\t2\tv(3)\tvoltage\n"
+         << "Binary:\n";
+    double t = 0.0;
+    for (size_t i = 0; i < writtenPoints; ++i) {
+        const double v = std::sin(2.0 * M_PI * 1000.0 * t);
+        const double record[3] = {t, v, 0.5 * v};
+        file.write(reinterpret_cast<const char*>(record), sizeof(record));
+        t += (i % 2 == 0) ? 3e-6 : 7e-6;
+    }
+    return path;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+void testTransientVectors(TestResults& results) {
+    const std::string path = writeTransient("livespice_test.raw", 2000, 2000, false);
+    SpiceRawFile raw(path);
+    if (!raw.isOpen()) {
+        results.fail("Open", raw.getError());
+        return;
+    }
+
+    const SampleView time = raw.scale();
+    const SampleView out = raw.vector("V(3)");
+    const SampleView node = raw.vector("2");
+    bool matches = raw.getPlotName() == "Transient Analysis" && raw.numPoints() == 2000 &&
+                   raw.getVariables().size() == 3 && out.size() == 2000 && node.size() == 2000;
+    for (size_t i = 0; matches && i < out.size(); ++i) {
+        matches = std::abs(out[i] - 0.5 * std::sin(2.0 * M_PI * 1000.0 * time[i])) < 1e-12 &&
+                  out[i] == 0.5 * node[i];
+    }
+    if (matches && raw.vector("v(9)").empty()) {
+        results.pass("Strided views over time, v(2) and v(3); names matched with or without v()");
+    } else {
+        results.fail("Vectors", "values do not match what was written");
+    }
+
+    // 10 ms at 48 kHz from 3/7 us steps (the run covers 10 ms)
+    const auto samples = resampleToRate(time, out, 48000.0f, 480);
+    double worst = 0.0;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        worst = std::max(worst, std::abs(samples[i] - 0.5 * std::sin(2.0 * M_PI * 1000.0 * i / 48000.0)));
+    }
+    if (samples.size() == 480 && worst < 2e-4) {   // Linear interpolation over 7 us steps
+        results.pass("Resampled onto 48 kHz, max error " + std::to_string(worst));
+    } else {
+        results.fail("Resample", "max error " + std::to_string(worst));
+    }
+    std::remove(path.c_str());
+}
+
+void testTruncatedAndInlineHeader(TestResults& results) {
+    const std::string path = writeTransient("livespice_test_cut.raw", 2000, 750, true);
+    SpiceRawFile raw(path);
+    if (raw.isOpen() && raw.numPoints() == 750 && raw.vector("v(2)").size() == 750) {
+        results.pass("Run cut short: 750 of 2000 declared points exposed");
+    } else {
+        results.fail("Truncated", raw.isOpen() ? std::to_string(raw.numPoints()) + " points" : raw.getError());
+    }
+    std::remove(path.c_str());
+}
+
+void testRejectsAscii(TestResults& results) {
+    const std::string path = tempPath("livespice_test_ascii.raw");
+    std::ofstream(path) << "Title: x\nPlotname: Transient Analysis\nFlags: real\nNo. Variables: 1\n"
+                           "No. Points: 1\nVariables:\n\t0\ttime\ttime\nValues:\n0\t0.0\n";
+    SpiceRawFile raw(path);
+    SpiceRawFile missing(tempPath("livespice_no_such.raw"));
+    if (!raw.isOpen() && !missing.isOpen() && raw.vector("time").empty()) {
+        results.pass("ASCII and missing raw files rejected: " + raw.getError());
+    } else {
+        results.fail("ASCII", "opened an ASCII raw file");
+    }
+    std::remove(path.c_str());
+}
+
+int main() {
+    std::cout << "SPICE Raw File Tests\n";
+    std::cout << std::string(80, '=') << "\n\n";
+
+    TestResults results;
+    testTransientVectors(results);
+    testTruncatedAndInlineHeader(results);
+    testRejectsAscii(results);
+
+    results.summary();
+    return results.failed == 0 ? 0 : 1;
+}
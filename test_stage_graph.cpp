@@ -0,0 +1,300 @@
+#include "StageGraph.h"
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+using namespace LiveSpiceDSP;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void pass(const std::string& test) {
+        passed++;
+        std::cout << "✓ PASS: " << test << "\n";
+    }
+
+    void fail(const std::string& test, const std::string& reason) {
+        failed++;
+        std::cout << "✗ FAIL: " << test << " - " << reason << "\n";
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+static const float PI = 3.14159265358979f;
+static const float SAMPLE_RATE = 48000.0f;
+
+/**
+ * Run a mono signal through the graph in 256-sample blocks
+ */
+static std::vector<float> render(StageGraph& graph, std::vector<float> signal) {
+    for (size_t offset = 0; offset < signal.size(); offset += 256) {
+        float* channel = signal.data() + offset;
+        graph.processBlock(&channel, 1, std::min<size_t>(256, signal.size() - offset));
+    }
+    return signal;
+}
+
+static std::vector<float> sine(float freq, float amplitude, size_t numSamples) {
+    std::vector<float> x(numSamples);
+    for (size_t n = 0; n < numSamples; ++n) x[n] = amplitude * std::sin(2.0f * PI * freq * float(n) / SAMPLE_RATE);
+    return x;
+}
+
+static float peak(const std::vector<float>& x, size_t start) {
+    float p = 0.0f;
+    for (size_t n = start; n < x.size(); ++n) p = std::max(p, std::abs(x[n]));
+    return p;
+}
+
+static StageNodeSpec node(StageNodeSpec::Kind kind, float gain = 1.0f, float frequency = 1000.0f, int control = -1,
+                          std::vector<int> inputs = {}) {
+    StageNodeSpec spec;
+    spec.kind = kind;
+    spec.gain = gain;
+    spec.frequency = frequency;
+    spec.control = control;
+    spec.inputs = std::move(inputs);
+    return spec;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+void testEmptyGraphPassesThrough(TestResults& results) {
+    StageGraph graph;
+    graph.build({}, SAMPLE_RATE, 1);
+    auto in = sine(440.0f, 0.5f, 1024);
+    auto out = render(graph, in);
+
+    if (out == in) results.pass("Empty graph passes through");
+    else results.fail("Empty graph passes through", "output differs from input");
+}
+
+void testFilterChain(TestResults& results) {
+    StageGraph graph;
+    graph.build({node(StageNodeSpec::Kind::HighPass, 1.0f, 72.0f),
+                 node(StageNodeSpec::Kind::LowPass, 1.0f, 2000.0f)}, SAMPLE_RATE, 1);
+
+    float passband = peak(render(graph, sine(500.0f, 1.0f, 9600)), 4800);
+    graph.reset();
+    float stopband = peak(render(graph, sine(16000.0f, 1.0f, 9600)), 4800);
+
+    if (passband > 0.9f && stopband < 0.05f) {
+        results.pass("High-pass into low-pass shapes the band");
+    } else {
+        results.fail("High-pass into low-pass shapes the band",
+                     "passband " + std::to_string(passband) + ", stopband " + std::to_string(stopband));
+    }
+}
+
+void testGainControl(TestResults& results) {
+    StageGraph graph;
+    graph.setControl(3, 0.5f);
+    graph.build({node(StageNodeSpec::Kind::Gain, 2.0f, 1000.0f, 3)}, SAMPLE_RATE, 1);
+
+    // Audio taper: 2 * 0.5^2 from the first sample
+    float half = peak(render(graph, sine(440.0f, 1.0f, 2048)), 0);
+
+    graph.setControl(3, 1.0f);
+    float full = peak(render(graph, sine(440.0f, 1.0f, 2048)), 256);
+
+    if (std::abs(half - 0.5f) < 1e-3f && std::abs(full - 2.0f) < 1e-3f) {
+        results.pass("Gain follows its control");
+    } else {
+        results.fail("Gain follows its control", "peaks " + std::to_string(half) + ", " + std::to_string(full));
+    }
+}
+
+void testDiodeClipperBounded(TestResults& results) {
+    StageGraph graph;
+    graph.build({node(StageNodeSpec::Kind::DiodeClipper, 50.0f)}, SAMPLE_RATE, 1);
+    float p = peak(render(graph, sine(220.0f, 1.0f, 4800)), 0);
+
+    if (std::isfinite(p) && p > 0.1f && p < 1.5f) results.pass("Diode clipper limits a driven signal");
+    else results.fail("Diode clipper limits a driven signal", "peak " + std::to_string(p));
+}
+
+void testBJTIdlesAtZero(TestResults& results) {
+    StageGraph graph;
+    graph.build({node(StageNodeSpec::Kind::BJTAmplifier)}, SAMPLE_RATE, 1);
+
+    float idle = peak(render(graph, std::vector<float>(1024, 0.0f)), 0);
+    auto out = render(graph, sine(440.0f, 0.001f, 4800));
+    float swing = peak(out, 0);
+
+    // Common emitter: inverting, gain well above unity around the bias point
+    bool inverting = out[24] < 0.0f;  // Input positive a quarter period in
+    if (idle < 1e-3f && swing > 0.001f && inverting) {
+        results.pass("BJT stage is biased at mid-supply and inverts");
+    } else {
+        results.fail("BJT stage is biased at mid-supply and inverts",
+                     "idle " + std::to_string(idle) + ", swing " + std::to_string(swing));
+    }
+}
+
+void testChannelsIndependent(TestResults& results) {
+    StageGraph graph;
+    graph.build({node(StageNodeSpec::Kind::LowPass, 1.0f, 1000.0f),
+                 node(StageNodeSpec::Kind::DiodeClipper, 10.0f)}, SAMPLE_RATE, 2);
+
+    auto left = sine(440.0f, 0.5f, 512);
+    std::vector<float> right(512, 0.0f);
+    float* channels[] = {left.data(), right.data()};
+    graph.processBlock(channels, 2, 512);
+
+    if (peak(left, 0) > 0.01f && peak(right, 0) == 0.0f) results.pass("Channels keep separate state");
+    else results.fail("Channels keep separate state", "silent channel picked up signal");
+}
+
+// Input gain, then a dry path and a clipped, low-passed wet path mixed at half level
+static std::vector<StageNodeSpec> wetDrySpecs() {
+    const int in = StageNodeSpec::GRAPH_INPUT;
+    return {node(StageNodeSpec::Kind::Gain, 2.0f, 1000.0f, -1, {in}),
+            node(StageNodeSpec::Kind::Gain, 1.0f, 1000.0f, -1, {0}),
+            node(StageNodeSpec::Kind::DiodeClipper, 20.0f, 1000.0f, -1, {0}),
+            node(StageNodeSpec::Kind::LowPass, 1.0f, 3000.0f, -1, {2}),
+            node(StageNodeSpec::Kind::Gain, 0.5f, 1000.0f, -1, {1, 3})};
+}
+
+void testBranchesMatchManualMix(TestResults& results) {
+    StageGraph graph;
+    graph.build(wetDrySpecs(), SAMPLE_RATE, 1, 100);  // Slices that straddle the 256-sample blocks
+
+    StageGraph wet;
+    wet.build({node(StageNodeSpec::Kind::Gain, 2.0f), node(StageNodeSpec::Kind::DiodeClipper, 20.0f),
+               node(StageNodeSpec::Kind::LowPass, 1.0f, 3000.0f)}, SAMPLE_RATE, 1);
+
+    auto in = sine(220.0f, 0.3f, 4096);
+    auto out = render(graph, in);
+    auto wetOut = render(wet, in);
+    float maxDiff = 0.0f;
+    for (size_t n = 0; n < in.size(); ++n) {
+        maxDiff = std::max(maxDiff, std::abs(out[n] - 0.5f * (2.0f * in[n] + wetOut[n])));
+    }
+
+    if (graph.getNumLevels() == 4 && maxDiff < 1e-6f) {
+        results.pass("Parallel branches sum into the mix node");
+    } else {
+        results.fail("Parallel branches sum into the mix node",
+                     std::to_string(graph.getNumLevels()) + " levels, max diff " + std::to_string(maxDiff));
+    }
+}
+
+void testThreadPoolMatchesSerial(TestResults& results) {
+    // Four clipped bands in parallel, summed: one wide level for the pool
+    const int in = StageNodeSpec::GRAPH_INPUT;
+    std::vector<StageNodeSpec> specs;
+    for (float f : {200.0f, 800.0f, 2400.0f, 6000.0f}) {
+        specs.push_back(node(StageNodeSpec::Kind::BandPass, 1.0f, f, -1, {in}));
+    }
+    for (int band = 0; band < 4; ++band) specs.push_back(node(StageNodeSpec::Kind::DiodeClipper, 10.0f, 1000.0f, -1, {band}));
+    specs.push_back(node(StageNodeSpec::Kind::Gain, 0.25f, 1000.0f, -1, {4, 5, 6, 7}));
+
+    StageGraph serial, parallel;
+    serial.build(specs, SAMPLE_RATE, 2);
+    parallel.build(specs, SAMPLE_RATE, 2);
+    RealtimeThreadPool pool(3);
+    parallel.setThreadPool(&pool);
+
+    auto left = sine(330.0f, 0.5f, 8192), right = sine(1100.0f, 0.4f, 8192);
+    auto left2 = left, right2 = right;
+    for (size_t offset = 0; offset < left.size(); offset += 128) {
+        float* a[] = {left.data() + offset, right.data() + offset};
+        float* b[] = {left2.data() + offset, right2.data() + offset};
+        serial.processBlock(a, 2, 128);
+        parallel.processBlock(b, 2, 128);
+    }
+
+    if (left == left2 && right == right2 && parallel.getNumLevels() == 3 && pool.getNumWorkers() == 3) {
+        results.pass("Thread pool renders bit-identical to serial");
+    } else {
+        results.fail("Thread pool renders bit-identical to serial", "outputs differ");
+    }
+}
+
+void testArenaConstruction(TestResults& results) {
+    // Objects die newest first on release; chained blocks merge into one
+    struct Tracked {
+        std::vector<int>* log;
+        int id;
+        Tracked(std::vector<int>* l, int i) : log(l), id(i) {}
+        ~Tracked() { log->push_back(id); }
+    };
+    std::vector<int> destroyed;
+    MonotonicArena arena(256);
+    arena.create<Tracked>(&destroyed, 1);
+    arena.createArray<float>(1000);  // Overflows the first block
+    arena.create<Tracked>(&destroyed, 2);
+    size_t blocks = arena.getNumBlocks();
+    arena.release();
+    arena.reserve(4000);
+    if (blocks > 1 && destroyed == std::vector<int>{2, 1} && arena.getNumBlocks() == 1 &&
+        reinterpret_cast<std::uintptr_t>(arena.createArray<double>(3)) % alignof(double) == 0) {
+        results.pass("Arena destroys newest first and merges its blocks");
+    } else {
+        results.fail("Arena destroys newest first and merges its blocks",
+                     std::to_string(blocks) + " blocks, " + std::to_string(destroyed.size()) + " destroyed");
+    }
+
+    // A graph lives in one block, and rebuilding it reuses that block
+    StageGraph graph;
+    graph.build(wetDrySpecs(), SAMPLE_RATE, 2, 256);
+    size_t footprint = graph.getFootprintBytes();
+    auto first = render(graph, sine(220.0f, 0.3f, 2048));
+    graph.build(wetDrySpecs(), SAMPLE_RATE, 2, 256);
+    auto second = render(graph, sine(220.0f, 0.3f, 2048));
+    if (footprint > 5 * 2 * 256 * sizeof(float) && graph.getFootprintBytes() == footprint && first == second) {
+        results.pass("Graph rebuilds into the same arena footprint (" + std::to_string(footprint) + " bytes)");
+    } else {
+        results.fail("Graph rebuilds into the same arena footprint",
+                     std::to_string(footprint) + " then " + std::to_string(graph.getFootprintBytes()) + " bytes");
+    }
+}
+
+int main() {
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "STAGE GRAPH TEST SUITE\n";
+    std::cout << std::string(80, '=') << "\n";
+
+    TestResults results;
+
+    std::cout << "\n=== TEST 1: Linear Nodes ===\n";
+    testEmptyGraphPassesThrough(results);
+    testFilterChain(results);
+    testGainControl(results);
+
+    std::cout << "\n=== TEST 2: Nonlinear Nodes ===\n";
+    testDiodeClipperBounded(results);
+    testBJTIdlesAtZero(results);
+    testChannelsIndependent(results);
+
+    std::cout << "\n=== TEST 3: Branching Graphs ===\n";
+    testBranchesMatchManualMix(results);
+    testThreadPoolMatchesSerial(results);
+
+    std::cout << "\n=== TEST 4: Arena Construction ===\n";
+    testArenaConstruction(results);
+
+    results.summary();
+
+    return results.failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,203 @@
+#include "StaticChain.h"
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <string>
+
+using namespace LiveSpiceDSP;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void pass(const std::string& test) {
+        passed++;
+        std::cout << "✓ PASS: " << test << "\n";
+    }
+
+    void fail(const std::string& test, const std::string& reason) {
+        failed++;
+        std::cout << "✗ FAIL: " << test << " - " << reason << "\n";
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+static const double PI = 3.14159265358979;
+static const double SAMPLE_RATE = 48000.0;
+
+static std::vector<float> sine(double freq, double amplitude, size_t numSamples) {
+    std::vector<float> x(numSamples);
+    for (size_t n = 0; n < numSamples; ++n) {
+        x[n] = static_cast<float>(amplitude * std::sin(2.0 * PI * freq * double(n) / SAMPLE_RATE));
+    }
+    return x;
+}
+
+static float peak(const std::vector<float>& x, size_t start) {
+    float p = 0.0f;
+    for (size_t n = start; n < x.size(); ++n) p = std::max(p, std::abs(x[n]));
+    return p;
+}
+
+// Value packs as the translator writes them into CircuitChain.h
+struct InputRC { static constexpr double R = 10000.0; static constexpr double C = 1e-6; };      // 15.9 Hz
+struct ToneRC { static constexpr double R = 10000.0; static constexpr double C = 1e-8; };       // 1.59 kHz
+struct Level { static constexpr double gain = 0.5; };
+struct D1 {
+    static constexpr double Is = 1.4e-14;
+    static constexpr double n = 1.06;
+    static constexpr double Vt = 0.026;
+    static constexpr double R = 10000.25;
+};
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+void testRCStagesMatchBilinear(TestResults& results) {
+    StaticRCHighPass<ToneRC> highPass;
+    StaticRCLowPass<ToneRC> lowPass;
+    highPass.prepare(SAMPLE_RATE);
+    lowPass.prepare(SAMPLE_RATE);
+
+    // Reference: the folded bilinear one-pole the generator emits
+    const double k = 2.0 * ToneRC::R * ToneRC::C * SAMPLE_RATE;
+    const float a1 = static_cast<float>((1.0 - k) / (1.0 + k));
+    const float hb0 = static_cast<float>(k / (1.0 + k)), lb0 = static_cast<float>(1.0 / (1.0 + k));
+    float hx1 = 0.0f, hy1 = 0.0f, lx1 = 0.0f, ly1 = 0.0f;
+
+    float worst = 0.0f;
+    for (float x : sine(700.0, 0.8, 2048)) {
+        const float hy = hb0 * x - hb0 * hx1 - a1 * hy1;
+        const float ly = lb0 * x + lb0 * lx1 - a1 * ly1;
+        hx1 = lx1 = x;
+        hy1 = hy;
+        ly1 = ly;
+        worst = std::max({worst, std::abs(highPass.process(x) - hy), std::abs(lowPass.process(x) - ly)});
+    }
+
+    if (worst < 1e-6f) results.pass("RC stages match the folded bilinear one-pole");
+    else results.fail("RC stages match the folded bilinear one-pole", "max error " + std::to_string(worst));
+}
+
+void testRCCutoff(TestResults& results) {
+    StaticRCLowPass<ToneRC> lowPass;
+    lowPass.prepare(SAMPLE_RATE);
+
+    const double fc = 1.0 / (2.0 * PI * ToneRC::R * ToneRC::C);
+    std::vector<float> signal = sine(fc, 1.0, 9600);
+    for (auto& x : signal) x = lowPass.process(x);
+    const float gain = peak(signal, 4800);
+
+    if (std::abs(gain - 0.7071f) < 0.02f) results.pass("Low-pass is -3 dB at 1/(2 pi RC)");
+    else results.fail("Low-pass is -3 dB at 1/(2 pi RC)", "gain " + std::to_string(gain));
+}
+
+void testDiodeClipperSolvesKirchhoff(TestResults& results) {
+    StaticDiodeClipper<D1> clipper;
+    const double nVt = D1::n * D1::Vt;
+
+    // Reference: bisect vin = v + R Is (exp(|v| / nVt) - 1) for the output voltage
+    double worst = 0.0;
+    for (double vin = -5.0; vin <= 5.0; vin += 0.01) {
+        const double target = std::abs(static_cast<float>(vin));
+        double lo = 0.0, hi = target;
+        for (int i = 0; i < 60; ++i) {
+            const double v = 0.5 * (lo + hi);
+            (v + D1::R * D1::Is * std::expm1(v / nVt) > target ? hi : lo) = v;
+        }
+        const double expected = (vin < 0.0 ? -0.5 : 0.5) * (lo + hi);
+        worst = std::max(worst, std::abs(clipper.process(static_cast<float>(vin)) - expected));
+    }
+    const float ceiling = clipper.process(5.0f);
+    const bool symmetric = clipper.process(-2.0f) == -clipper.process(2.0f);
+
+    // omega4 is the approximate Wright omega WDF::DiodePair uses (about 1 mV near the knee)
+    if (worst < 2e-3 && ceiling > 0.4f && ceiling < 0.8f && symmetric) {
+        results.pass("Diode clipper solves the series-resistor loop");
+    } else {
+        results.fail("Diode clipper solves the series-resistor loop",
+                     "error " + std::to_string(worst) + " V" + ", ceiling " + std::to_string(ceiling));
+    }
+}
+
+void testChainMatchesManualComposition(TestResults& results) {
+    using Chain = StaticChain<StaticRCHighPass<InputRC>, StaticDiodeClipper<D1>, StaticPassThrough,
+                              StaticRCLowPass<ToneRC>, StaticGain<Level>>;
+    static_assert(Chain::NUM_STAGES == 5, "one entry per stage");
+
+    Chain chain;
+    chain.prepare(SAMPLE_RATE);
+    StaticRCHighPass<InputRC> highPass;
+    StaticDiodeClipper<D1> clipper;
+    StaticRCLowPass<ToneRC> lowPass;
+    highPass.prepare(SAMPLE_RATE);
+    lowPass.prepare(SAMPLE_RATE);
+
+    std::vector<float> block = sine(220.0, 2.0, 4096);
+    std::vector<float> expected(block.size());
+    for (size_t n = 0; n < block.size(); ++n) {
+        expected[n] = 0.5f * lowPass.process(clipper.process(highPass.process(block[n])));
+    }
+    chain.processBlock(block.data(), block.size());
+
+    if (block == expected) results.pass("Chain equals its stages composed by hand");
+    else results.fail("Chain equals its stages composed by hand", "outputs differ");
+}
+
+void testResetAndRePrepare(TestResults& results) {
+    StaticChain<StaticRCHighPass<InputRC>, StaticRCLowPass<ToneRC>> chain;
+    chain.prepare(SAMPLE_RATE);
+
+    std::vector<float> first = sine(440.0, 1.0, 1024);
+    std::vector<float> second = first;
+    chain.processBlock(first.data(), first.size());
+    chain.reset();
+    chain.processBlock(second.data(), second.size());
+
+    // prepare() at a new rate recomputes the coefficients and clears the state
+    chain.prepare(192000.0);
+    const double k = 2.0 * ToneRC::R * ToneRC::C * 192000.0;
+    const float b0 = static_cast<float>(1.0 / (1.0 + k));
+    const bool rePrepared = chain.stage<1>().process(1.0f) == b0;
+
+    if (first == second && rePrepared) results.pass("reset() clears state, prepare() follows the rate");
+    else results.fail("reset() clears state, prepare() follows the rate", "state or coefficients stale");
+}
+
+int main() {
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "STATIC CHAIN TEST SUITE\n";
+    std::cout << std::string(80, '=') << "\n";
+
+    TestResults results;
+
+    std::cout << "\n=== TEST 1: Stages ===\n";
+    testRCStagesMatchBilinear(results);
+    testRCCutoff(results);
+    testDiodeClipperSolvesKirchhoff(results);
+
+    std::cout << "\n=== TEST 2: Chain ===\n";
+    testChainMatchesManualComposition(results);
+    testResetAndRePrepare(results);
+
+    results.summary();
+
+    return results.failed == 0 ? 0 : 1;
+}
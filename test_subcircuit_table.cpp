@@ -0,0 +1,163 @@
+#include "SubcircuitTable.h"
+#include "DiodeModels.h"
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <string>
+
+using namespace LiveSpiceDSP;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void pass(const std::string& test) {
+        passed++;
+        std::cout << "✓ PASS: " << test << "\n";
+    }
+
+    void fail(const std::string& test, const std::string& reason) {
+        failed++;
+        std::cout << "✗ FAIL: " << test << " - " << reason << "\n";
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+static const Nonlinear::DiodeCharacteristics SILICON = Nonlinear::DiodeCharacteristics::Si1N4148();
+
+// Largest |table - solve| over a dense input sweep (log-spaced, both signs) at each pot step
+template <typename Solve>
+static double sweepError(const SubcircuitTable& table, Solve solve, int potSteps) {
+    double worst = 0.0;
+    for (int p = 0; p <= potSteps; ++p) {
+        const double pot = potSteps > 0 ? double(p) / potSteps : 0.0;
+        for (int k = -4000; k <= 4000; ++k) {
+            const double x = std::copysign(10.0 * std::pow(1e-5, 1.0 - std::abs(k) / 4000.0), k);
+            const SubcircuitTable::Controls controls{{static_cast<float>(pot), 0.0f}};
+            worst = std::max(worst, std::abs(double(table.process(static_cast<float>(x), controls)) - solve(x, pot)));
+        }
+    }
+    return worst;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+void testDiodesToGround(TestResults& results) {
+    const DiodesToGroundClipper circuit;
+    const SubcircuitTable table = SubcircuitTable::diodesToGround(SILICON, circuit);
+    const double worst = sweepError(table, [&](double x, double) {
+        return SubcircuitTable::solveDiodesToGround(SILICON, circuit, x);
+    }, 0);
+
+    const bool clips = table.process(5.0f) > 0.5f && table.process(5.0f) < 0.8f
+        && std::abs(table.process(-5.0f) + table.process(5.0f)) < 1e-4f;
+    if (worst < 1e-3 && table.getMaxError() < 1e-3 && table.getLayout().numControls == 0 && clips) {
+        results.pass("Diodes to ground: 1D table within the 1 mV budget");
+    } else {
+        results.fail("Diodes to ground: 1D table within the 1 mV budget",
+                     "max error " + std::to_string(worst) + ", reported " + std::to_string(table.getMaxError()));
+    }
+}
+
+void testFeedbackClipperWithDrive(TestResults& results) {
+    const DiodeFeedbackClipper circuit;
+    const SubcircuitTable table = SubcircuitTable::diodeFeedback(SILICON, circuit);
+    const double worst = sweepError(table, [&](double x, double drive) {
+        return SubcircuitTable::solveDiodeFeedback(SILICON, circuit, x, drive);
+    }, 100);
+
+    // More drive, more gain below the knee; the rails hold at any setting
+    const float low = table.process(0.01f, {{0.0f, 0.0f}}), high = table.process(0.01f, {{1.0f, 0.0f}});
+    const bool drive = high > 2.0f * low && table.process(9.0f, {{1.0f, 0.0f}}) == 4.5f;
+    if (worst < 1.5e-3 && table.getMaxError() < 1e-3 && table.getLayout().numControls == 1 && drive) {
+        results.pass("Op-amp feedback clipper: input x drive table within budget, rails exact");
+    } else {
+        results.fail("Op-amp feedback clipper: input x drive table within budget, rails exact",
+                     "max error " + std::to_string(worst) + ", reported " + std::to_string(table.getMaxError()));
+    }
+}
+
+void testTwoPotsAndView(TestResults& results) {
+    DiodeFeedbackClipper circuit;
+    circuit.ground = {1000.0, 9000.0};
+    SubcircuitBudget budget;
+    budget.maxError = 2e-2;
+    const SubcircuitTable table = SubcircuitTable::diodeFeedback(SILICON, circuit, budget);
+    const SubcircuitTable view(table.getLayout(), table.getSamples(), table.getMaxError());
+
+    double worst = 0.0;
+    bool same = true;
+    for (float drive : {0.0f, 0.3f, 0.77f, 1.0f}) {
+        for (float ground : {0.0f, 0.5f, 0.9f}) {
+            for (double x = -6.0; x <= 6.0; x += 0.0013) {
+                const SubcircuitTable::Controls controls{{drive, ground}};
+                const float y = table.process(static_cast<float>(x), controls);
+                same = same && y == view.process(static_cast<float>(x), controls);
+                worst = std::max(worst, std::abs(y - SubcircuitTable::solveDiodeFeedback(SILICON, circuit, x, drive, ground)));
+            }
+        }
+    }
+
+    if (table.getLayout().numControls == 2 && worst < budget.maxError && same && view.getSamples() == table.getSamples()) {
+        results.pass("Two pots: 3D table within its budget; a view over its samples matches");
+    } else {
+        results.fail("Two pots: 3D table within its budget; a view over its samples matches",
+                     "max error " + std::to_string(worst) + ", view " + std::to_string(same));
+    }
+}
+
+void testBlockMatchesSamples(TestResults& results) {
+    DiodesToGroundClipper circuit;
+    circuit.series = {1000.0, 99000.0};
+    const SubcircuitTable table = SubcircuitTable::diodesToGround(SILICON, circuit);
+
+    std::vector<float> block(1000);
+    for (size_t n = 0; n < block.size(); ++n) {
+        block[n] = static_cast<float>(12.0 * std::sin(0.0131 * double(n)));   // Past the table range too
+    }
+    const SubcircuitTable::Controls controls{{0.37f, 0.0f}};
+    std::vector<float> expected(block.size());
+    for (size_t n = 0; n < block.size(); ++n) expected[n] = table.process(block[n], controls);
+    table.processBlock(block.data(), block.data(), block.size(), controls);
+
+    if (block == expected) results.pass("Block pass equals per-sample lookups in place");
+    else results.fail("Block pass equals per-sample lookups in place", "outputs differ");
+}
+
+int main() {
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "SUBCIRCUIT TABLE TEST SUITE\n";
+    std::cout << std::string(80, '=') << "\n";
+
+    TestResults results;
+
+    std::cout << "\n=== TEST 1: Accuracy ===\n";
+    testDiodesToGround(results);
+    testFeedbackClipperWithDrive(results);
+    testTwoPotsAndView(results);
+
+    std::cout << "\n=== TEST 2: Block pass ===\n";
+    testBlockMatchesSamples(results);
+
+    results.summary();
+
+    return results.failed == 0 ? 0 : 1;
+}
@@ -4,6 +4,8 @@
 #include <cmath>
 #include <cassert>
 #include <sstream>
+#include <vector>
+#include <stdexcept>
 
 using namespace LiveSpiceDSP;
 
@@ -176,6 +178,101 @@ void testToneStackTrebleControl(TestResults& results) {
     }
 }
 
+void testToneStackCoefficientCache(TestResults& results) {
+    {
+        ToneStackController a(48000.0f), b(48000.0f);
+        ToneStackController c(96000.0f);
+        size_t count = ToneStackController::cachedCoefficientTableCount();
+        auto shared = ToneStackController::acquireCoefficientTable(48000.0f);
+        
+        // 44.1k from earlier tests may still be alive; 48k and 96k must be
+        if (count >= 2 && ToneStackController::cachedCoefficientTableCount() == count) {
+            results.pass("Tone Stack: Coefficient Table Shared Per Sample Rate");
+        } else {
+            results.fail("Tone Stack: Coefficient Cache", "Table count " + std::to_string(count));
+        }
+        
+        auto direct = ToneStackController::designBand(ToneStackController::MID, 48000.0f, 3.5f);
+        auto cached = shared->bands[ToneStackController::MID][155];  // -12 + 155 * 0.1
+        if (almostEqual(direct.b0, cached.b0, 1e-5f) && almostEqual(direct.a1, cached.a1, 1e-5f)) {
+            results.pass("Tone Stack: Cached Coefficients Match Design");
+        } else {
+            results.fail("Tone Stack: Cached Coefficients", "Table entry differs from design");
+        }
+    }
+    
+    // Rate switch: standard-rate tables survive their last user, others do not
+    {
+        const ToneStackController::CoefficientTable* standard = nullptr;
+        std::weak_ptr<const ToneStackController::CoefficientTable> odd;
+        {
+            ToneStackController a(88200.0f), b(50000.0f);
+            standard = ToneStackController::acquireCoefficientTable(88200.0f).get();
+            odd = ToneStackController::acquireCoefficientTable(50000.0f);
+        }
+        ToneStackController back(88200.0f);
+        if (ToneStackController::acquireCoefficientTable(88200.0f).get() == standard && odd.expired()) {
+            results.pass("Tone Stack: Standard-Rate Table Kept Across Rate Switch");
+        } else {
+            results.fail("Tone Stack: Rate Switch", "88.2k table rebuilt or 50k table leaked");
+        }
+    }
+    
+    // Smoothed knob move vs. an instant coefficient switch on a 100Hz tone
+    ToneStackController smoothed(44100.0f), instant(44100.0f);
+    smoothed.setBassGain(12.0f);
+    instant.setBassGain(12.0f);
+    auto target = ToneStackController::designBand(ToneStackController::BASS, 44100.0f, -12.0f);
+    
+    float prevSmoothed = 0.0f, prevInstant = 0.0f;
+    float maxJumpSmoothed = 0.0f, maxJumpInstant = 0.0f;
+    const int switchAt = 2000;
+    bool rampObserved = false;
+    for (int i = 0; i < 4000; ++i) {
+        float x = 0.5f * std::sin(2.0f * 3.14159265f * 100.0f * i / 44100.0f);
+        if (i == switchAt) {
+            smoothed.setBassGain(-12.0f);
+            instant.getBassFilterBank().setStageCoefficients(0, target);
+            rampObserved = smoothed.isSmoothing();
+        }
+        float ys = smoothed.process(x), yi = instant.process(x);
+        if (i > switchAt - 100) {
+            maxJumpSmoothed = std::max(maxJumpSmoothed, std::abs(ys - prevSmoothed));
+            maxJumpInstant = std::max(maxJumpInstant, std::abs(yi - prevInstant));
+        }
+        prevSmoothed = ys;
+        prevInstant = yi;
+    }
+    
+    if (rampObserved && !smoothed.isSmoothing() && maxJumpSmoothed < maxJumpInstant) {
+        results.pass("Tone Stack: Knob Move Ramps Without Zipper Step");
+    } else {
+        results.fail("Tone Stack: Smoothing", "Smoothed jump " + std::to_string(maxJumpSmoothed) +
+                     " vs instant " + std::to_string(maxJumpInstant));
+    }
+    
+    // processBlock steps coefficients on the same chunk grid as process()
+    ToneStackController perSample(44100.0f), block(44100.0f);
+    std::vector<float> signal(1200), out(signal.size());
+    for (size_t i = 0; i < signal.size(); ++i) signal[i] = std::sin(0.02f * i);
+    perSample.process(0.0f);
+    block.process(0.0f);
+    perSample.setTrebleGain(9.0f);
+    block.setTrebleGain(9.0f);
+    block.processBlock(signal.data(), out.data(), 45);
+    block.processBlock(signal.data() + 45, out.data() + 45, signal.size() - 45);
+    float maxDiff = 0.0f;
+    for (size_t i = 0; i < signal.size(); ++i) {
+        maxDiff = std::max(maxDiff, std::abs(perSample.process(signal[i]) - out[i]));
+    }
+    
+    if (maxDiff == 0.0f) {
+        results.pass("Tone Stack: Smoothed processBlock == process()");
+    } else {
+        results.fail("Tone Stack: Smoothed processBlock", "Max difference " + std::to_string(maxDiff));
+    }
+}
+
 // ============================================================================
 // TEST 3: Biquad Cascading
 // ============================================================================
@@ -201,6 +298,43 @@ void testBiquadCascading(TestResults& results) {
     }
 }
 
+template <size_t N>
+float fixedVsDynamicDifference() {
+    BiquadFilterBank<N> fixed;
+    BiquadFilterBank dynamic(N);
+    for (size_t s = 0; s < N; ++s) {
+        auto coeff = BiquadFilter::designPeakFilter(44100.0f, 200.0f * (s + 1), 0.9f, 4.0f - 2.0f * s);
+        fixed.setStageCoefficients(s, coeff);
+        dynamic.setStageCoefficients(s, coeff);
+    }
+    
+    float maxDiff = 0.0f;
+    for (int i = 0; i < 500; ++i) {
+        float x = std::sin(0.05f * i) + 0.2f * std::sin(0.9f * i);
+        maxDiff = std::max(maxDiff, std::abs(fixed.process(x) - dynamic.process(x)));
+    }
+    return maxDiff;
+}
+
+void testFixedOrderFilterBank(TestResults& results) {
+    float maxDiff = std::max(std::max(fixedVsDynamicDifference<1>(), fixedVsDynamicDifference<2>()),
+                             std::max(fixedVsDynamicDifference<3>(), fixedVsDynamicDifference<4>()));
+    
+    if (maxDiff == 0.0f) {
+        results.pass("Biquad: BiquadFilterBank<1..4> == Runtime Bank");
+    } else {
+        results.fail("Biquad: Fixed-Order Bank", "Max difference " + std::to_string(maxDiff));
+    }
+    
+    // Inline storage: the bank is exactly its stages, no heap pointer
+    static_assert(BiquadFilterBank<3>::getNumStages() == 3, "stage count is compile-time");
+    if (sizeof(BiquadFilterBank<3>) == 3 * sizeof(BiquadFilter)) {
+        results.pass("Biquad: BiquadFilterBank<N> Stores Stages Inline");
+    } else {
+        results.fail("Biquad: Fixed-Order Bank", "Unexpected size " + std::to_string(sizeof(BiquadFilterBank<3>)));
+    }
+}
+
 // ============================================================================
 // TEST 4: Phase Response Analysis
 // ============================================================================
@@ -406,10 +540,449 @@ void testHighPassResponse(TestResults& results) {
     }
 }
 
+// ============================================================================
+// TEST 9: Block & SIMD Lane Processing
+// ============================================================================
+
+static std::vector<float> makeTestSignal(size_t numSamples) {
+    std::vector<float> signal(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        signal[i] = 0.6f * std::sin(0.031f * i) + 0.3f * std::sin(0.47f * i);
+    }
+    return signal;
+}
+
+void testBlockMatchesPerSample(TestResults& results) {
+    auto signal = makeTestSignal(1000);
+    
+    BiquadFilterBank perSample(3), block(3);
+    BiquadCoefficients stages[3] = {
+        BiquadFilter::designLowShelf(44100.0f, 120.0f, 0.707f, 6.0f),
+        BiquadFilter::designPeakFilter(44100.0f, 1000.0f, 0.707f, -4.0f),
+        BiquadFilter::designHighShelf(44100.0f, 4500.0f, 0.707f, 3.0f)
+    };
+    for (size_t s = 0; s < 3; ++s) {
+        perSample.setStageCoefficients(s, stages[s]);
+        block.setStageCoefficients(s, stages[s]);
+    }
+    
+    // Uneven block sizes so state carries across block boundaries
+    std::vector<float> blockOut(signal.size());
+    size_t pos = 0, sizes[] = {1, 63, 256, 7, 673};
+    for (size_t n : sizes) {
+        block.processBlock(signal.data() + pos, blockOut.data() + pos, n);
+        pos += n;
+    }
+    
+    float maxDiff = 0.0f;
+    for (size_t i = 0; i < signal.size(); ++i) {
+        maxDiff = std::max(maxDiff, std::abs(perSample.process(signal[i]) - blockOut[i]));
+    }
+    
+    if (maxDiff == 0.0f) {
+        results.pass("Block: FilterBank processBlock == process()");
+    } else {
+        results.fail("Block: FilterBank processBlock", "Max difference " + std::to_string(maxDiff));
+    }
+    
+    ToneStackController toneA(44100.0f), toneB(44100.0f);
+    toneA.setBassGain(5.0f);
+    toneB.setBassGain(5.0f);
+    toneA.setTrebleGain(-7.0f);
+    toneB.setTrebleGain(-7.0f);
+    std::vector<float> toneOut(signal.size());
+    toneB.processBlock(signal.data(), toneOut.data(), signal.size());
+    
+    maxDiff = 0.0f;
+    for (size_t i = 0; i < signal.size(); ++i) {
+        maxDiff = std::max(maxDiff, std::abs(toneA.process(signal[i]) - toneOut[i]));
+    }
+    
+    if (maxDiff == 0.0f) {
+        results.pass("Block: ToneStack processBlock == process()");
+    } else {
+        results.fail("Block: ToneStack processBlock", "Max difference " + std::to_string(maxDiff));
+    }
+}
+
+void testLaneBankMatchesScalar(TestResults& results) {
+    const size_t numFrames = 800;
+    BiquadCoefficients bands[4] = {
+        BiquadFilter::designLowPass(44100.0f, 300.0f),
+        BiquadFilter::designPeakFilter(44100.0f, 1000.0f, 1.0f, 6.0f),
+        BiquadFilter::designHighShelf(44100.0f, 4500.0f, 0.707f, -6.0f),
+        BiquadFilter::designHighPass(44100.0f, 2000.0f)
+    };
+    
+    BiquadLaneBank<4> lanes;
+    BiquadFilter scalar[4];
+    for (size_t l = 0; l < 4; ++l) {
+        lanes.setLaneCoefficients(l, bands[l]);
+        scalar[l].setCoefficients(bands[l]);
+    }
+    
+    // Multi-channel: a different signal per lane, interleaved
+    std::vector<float> interleaved(numFrames * 4), out(numFrames * 4);
+    for (size_t i = 0; i < numFrames; ++i) {
+        for (size_t l = 0; l < 4; ++l) {
+            interleaved[i * 4 + l] = std::sin(0.01f * (l + 1) * i) * (0.5f + 0.1f * l);
+        }
+    }
+    lanes.processBlock(interleaved.data(), out.data(), numFrames);
+    
+    float maxDiff = 0.0f;
+    for (size_t i = 0; i < numFrames; ++i) {
+        for (size_t l = 0; l < 4; ++l) {
+            maxDiff = std::max(maxDiff, std::abs(scalar[l].process(interleaved[i * 4 + l]) - out[i * 4 + l]));
+        }
+    }
+    
+    if (maxDiff < 1e-6f) {
+        results.pass("Lanes: Interleaved Channels Match Scalar Biquads");
+    } else {
+        results.fail("Lanes: Interleaved Channels", "Max difference " + std::to_string(maxDiff));
+    }
+    
+    // Parallel bands: one mono input split across lanes
+    lanes.reset();
+    for (auto& filter : scalar) filter.reset();
+    auto mono = makeTestSignal(numFrames);
+    lanes.processParallel(mono.data(), out.data(), numFrames);
+    
+    maxDiff = 0.0f;
+    for (size_t i = 0; i < numFrames; ++i) {
+        for (size_t l = 0; l < 4; ++l) {
+            maxDiff = std::max(maxDiff, std::abs(scalar[l].process(mono[i]) - out[i * 4 + l]));
+        }
+    }
+    
+    if (maxDiff < 1e-6f) {
+        results.pass("Lanes: Parallel Bands Match Scalar Biquads");
+    } else {
+        results.fail("Lanes: Parallel Bands", "Max difference " + std::to_string(maxDiff));
+    }
+}
+
+// ============================================================================
+// TEST 10: Batched Frequency Response
+// ============================================================================
+
+void testBatchedFrequencyResponse(TestResults& results) {
+    auto freqs = FrequencyResponseAnalyzer::generateLogSweep(20.0f, 20000.0f, 300);
+    auto coeff = BiquadFilter::designPeakFilter(44100.0f, 800.0f, 1.2f, 7.0f);
+    auto refMag = FrequencyResponseAnalyzer::getMagnitudeResponse(coeff, freqs, 44100.0f);
+    auto refPhase = FrequencyResponseAnalyzer::getPhaseResponse(coeff, freqs, 44100.0f);
+    
+    std::vector<float> mag(freqs.size()), phase(freqs.size());
+    FrequencyResponseAnalyzer::evaluateCascade(&coeff, 1, freqs.data(), freqs.size(), 44100.0f,
+                                               mag.data(), phase.data(), 1);
+    float maxMagErr = 0.0f, maxPhaseErr = 0.0f;
+    for (size_t i = 0; i < freqs.size(); ++i) {
+        maxMagErr = std::max(maxMagErr, std::abs(mag[i] - refMag[i]) / refMag[i]);
+        maxPhaseErr = std::max(maxPhaseErr, std::abs(phase[i] - refPhase[i]));
+    }
+    
+    if (maxMagErr < 1e-4f && maxPhaseErr < 1e-4f) {
+        results.pass("Batched Response: Single Stage Matches Analyzer");
+    } else {
+        results.fail("Batched Response: Single Stage", "Magnitude error " + std::to_string(maxMagErr) +
+                     ", phase error " + std::to_string(maxPhaseErr));
+    }
+    
+    // Tone stack = product of its three band responses
+    ToneStackController toneStack(44100.0f);
+    toneStack.setBassGain(6.0f);
+    toneStack.setMidGain(-4.0f);
+    toneStack.setTrebleGain(3.0f);
+    FrequencyResponseAnalyzer::evaluateToneStack(toneStack, freqs.data(), freqs.size(), mag.data(), nullptr);
+    auto bands = toneStack.getCascadeCoefficients();
+    maxMagErr = 0.0f;
+    for (size_t i = 0; i < freqs.size(); ++i) {
+        float expected = 1.0f;
+        for (const auto& band : bands) {
+            expected *= FrequencyResponseAnalyzer::getMagnitudeResponse(band, {freqs[i]}, 44100.0f)[0];
+        }
+        maxMagErr = std::max(maxMagErr, std::abs(mag[i] - expected) / expected);
+    }
+    
+    // Both float paths sit ~5e-4 from a double reference at 20Hz (denominator
+    // cancellation near DC), so allow for the difference between them
+    if (maxMagErr < 2e-3f) {
+        results.pass("Batched Response: Tone Stack = Product of Bands");
+    } else {
+        results.fail("Batched Response: Tone Stack", "Magnitude error " + std::to_string(maxMagErr));
+    }
+    
+    // Threaded sweep must equal the single-threaded result exactly
+    auto dense = FrequencyResponseAnalyzer::generateLogSweep(10.0f, 22000.0f, 20000);
+    BiquadFilterBank<3> bank;
+    bank.setStageCoefficients(0, bands[0]);
+    bank.setStageCoefficients(1, bands[1]);
+    bank.setStageCoefficients(2, bands[2]);
+    std::vector<float> magSerial(dense.size()), phaseSerial(dense.size());
+    std::vector<float> magThreaded(dense.size()), phaseThreaded(dense.size());
+    FrequencyResponseAnalyzer::evaluateBank(bank, dense.data(), dense.size(), 44100.0f,
+                                            magSerial.data(), phaseSerial.data(), 1);
+    FrequencyResponseAnalyzer::evaluateBank(bank, dense.data(), dense.size(), 44100.0f,
+                                            magThreaded.data(), phaseThreaded.data(), 4);
+    
+    if (magSerial == magThreaded && phaseSerial == phaseThreaded) {
+        results.pass("Batched Response: Threaded Sweep == Serial (20000 points)");
+    } else {
+        results.fail("Batched Response: Threaded Sweep", "Results differ from serial");
+    }
+}
+
+// ============================================================================
+// TEST 11: State-Space Engine (RC Networks)
+// ============================================================================
+
+template <size_t N>
+float stateSpaceVsBiquad(const LinearNetwork& network, const BiquadCoefficients& reference,
+                         float sampleRate) {
+    StateSpaceProcessor<N> processor;
+    processor.setContinuousModel(network.buildStateSpace(), sampleRate);
+    BiquadFilter biquad;
+    biquad.setCoefficients(reference);
+    
+    float maxDiff = 0.0f;
+    for (int i = 0; i < 2000; ++i) {
+        float x = (i < 500 ? 1.0f : 0.0f) + 0.3f * std::sin(0.07f * i);
+        maxDiff = std::max(maxDiff, std::abs(processor.process(x) - biquad.process(x)));
+    }
+    return maxDiff;
+}
+
+void testStateSpaceEngine(TestResults& results) {
+    const float fs = 44100.0f;
+    const double K = 2.0 * fs;
+    
+    // RC low-pass: H(s) = 1 / (1 + s tau)
+    {
+        const double R = 10000.0, C = 10e-9, tau = R * C;
+        LinearNetwork network;
+        network.addResistor(1, 2, R);
+        network.addCapacitor(2, LinearNetwork::GROUND, C);
+        network.setInputNode(1);
+        network.setOutputNode(2);
+        
+        double a0 = K * tau + 1.0;
+        BiquadCoefficients ref(float(1.0 / a0), float(1.0 / a0), 0.0f, float((1.0 - K * tau) / a0), 0.0f);
+        float diff = stateSpaceVsBiquad<1>(network, ref, fs);
+        if (diff < 1e-5f) {
+            results.pass("State Space: RC Low-Pass == Bilinear Reference");
+        } else {
+            results.fail("State Space: RC Low-Pass", "Max difference " + std::to_string(diff));
+        }
+    }
+    
+    // Coupling capacitor off the input: H(s) = s tau / (1 + s tau), D != 0
+    {
+        const double R = 1e6, C = 22e-9, tau = R * C;
+        LinearNetwork network;
+        network.addCapacitor(1, 2, C);
+        network.addResistor(2, LinearNetwork::GROUND, R);
+        network.setInputNode(1);
+        network.setOutputNode(2);
+        
+        double a0 = K * tau + 1.0;
+        BiquadCoefficients ref(float(K * tau / a0), float(-K * tau / a0), 0.0f, float((1.0 - K * tau) / a0), 0.0f);
+        float diff = stateSpaceVsBiquad<1>(network, ref, fs);
+        if (diff < 1e-5f) {
+            results.pass("State Space: Coupling-Cap High-Pass == Bilinear Reference");
+        } else {
+            results.fail("State Space: Coupling-Cap High-Pass", "Max difference " + std::to_string(diff));
+        }
+    }
+    
+    // Two-section RC ladder: H(s) = 1 / (a s^2 + b s + 1), run at order 4 (zero-padded)
+    {
+        const double R1 = 4700.0, C1 = 47e-9, R2 = 22000.0, C2 = 4.7e-9;
+        LinearNetwork network;
+        network.addResistor(1, 2, R1);
+        network.addCapacitor(2, LinearNetwork::GROUND, C1);
+        network.addResistor(2, 3, R2);
+        network.addCapacitor(3, LinearNetwork::GROUND, C2);
+        network.setInputNode(1);
+        network.setOutputNode(3);
+        
+        double a = R1 * C1 * R2 * C2, b = R1 * C1 + R2 * C2 + R1 * C2;
+        double d0 = a * K * K + b * K + 1.0;
+        BiquadCoefficients ref(float(1.0 / d0), float(2.0 / d0), float(1.0 / d0),
+                               float((2.0 - 2.0 * a * K * K) / d0), float((a * K * K - b * K + 1.0) / d0));
+        float diff = stateSpaceVsBiquad<4>(network, ref, fs);
+        if (network.getNumCapacitors() == 2 && diff < 1e-5f) {
+            results.pass("State Space: 2-Section RC Ladder == Bilinear Reference");
+        } else {
+            results.fail("State Space: RC Ladder", "Max difference " + std::to_string(diff));
+        }
+    }
+    
+    // Capacitor straight across the input source is a capacitor loop
+    {
+        LinearNetwork network;
+        network.addCapacitor(1, LinearNetwork::GROUND, 1e-9);
+        network.addResistor(1, LinearNetwork::GROUND, 1000.0);
+        network.setInputNode(1);
+        bool rejected = false;
+        try {
+            network.buildStateSpace();
+        } catch (const std::invalid_argument&) {
+            rejected = true;
+        }
+        if (rejected) {
+            results.pass("State Space: Capacitor Loop Rejected");
+        } else {
+            results.fail("State Space: Capacitor Loop", "Singular network accepted");
+        }
+    }
+}
+
 // ============================================================================
 // Main Test Suite
 // ============================================================================
 
+// ============================================================================
+// TEST 12: TPT State-Variable Filter
+// ============================================================================
+
+static float worstDbDifference(const BiquadCoefficients& a, const BiquadCoefficients& b, float sampleRate) {
+    auto freqs = FrequencyResponseAnalyzer::generateLogSweep(20.0f, 20000.0f, 200);
+    auto ma = FrequencyResponseAnalyzer::getMagnitudeResponse(a, freqs, sampleRate);
+    auto mb = FrequencyResponseAnalyzer::getMagnitudeResponse(b, freqs, sampleRate);
+    float worst = 0.0f;
+    for (size_t i = 0; i < freqs.size(); ++i) {
+        worst = std::max(worst, std::abs(20.0f * std::log10(ma[i] / mb[i])));
+    }
+    return worst;
+}
+
+void testSvfTanApproximation(TestResults& results) {
+    float worst = 0.0f;
+    for (float ratio = 0.0005f; ratio <= SVFFilter::MAX_CUTOFF_RATIO; ratio += 0.0005f) {
+        const double x = 3.14159265358979 * ratio;
+        worst = std::max(worst, static_cast<float>(std::abs(SVFFilter::tanApprox(static_cast<float>(x)) / std::tan(x) - 1.0)));
+    }
+    
+    if (worst < 1e-4f) {
+        results.pass("SVF: Pade tan() within 1e-4 up to 0.47 fs");
+    } else {
+        results.fail("SVF: Pade tan()", "Relative error " + std::to_string(worst));
+    }
+}
+
+void testSvfMatchesBiquadDesigns(TestResults& results) {
+    const float fs = 44100.0f;
+    struct Case { SVFFilter::Type type; float freq, q, gainDb; BiquadCoefficients reference; };
+    const Case cases[] = {
+        {SVFFilter::Type::LowPass, 10000.0f, 0.7071067812f, 0.0f, BiquadFilter::designLowPass(fs, 10000.0f)},
+        {SVFFilter::Type::HighPass, 80.0f, 0.7071067812f, 0.0f, BiquadFilter::designHighPass(fs, 80.0f)},
+        {SVFFilter::Type::LowShelf, 120.0f, 0.707f, 9.0f, BiquadFilter::designLowShelf(fs, 120.0f, 0.707f, 9.0f)},
+        {SVFFilter::Type::Bell, 1000.0f, 0.707f, -6.0f, BiquadFilter::designPeakFilter(fs, 1000.0f, 0.707f, -6.0f)},
+        {SVFFilter::Type::HighShelf, 4500.0f, 0.707f, 12.0f, BiquadFilter::designHighShelf(fs, 4500.0f, 0.707f, 12.0f)},
+        {SVFFilter::Type::Bell, 4500.0f, 1.414f, 4.0f, BiquadFilter::designPeakFilter(fs, 4500.0f, 1.414f, 4.0f)},
+    };
+    
+    float worst = 0.0f;
+    for (const auto& c : cases) {
+        SVFFilter svf(fs);
+        svf.setParameters(c.type, c.freq, c.q, c.gainDb);
+        worst = std::max(worst, worstDbDifference(svf.toBiquad(), c.reference, fs));
+    }
+    
+    if (worst < 0.01f) {
+        results.pass("SVF: Responses match the RBJ biquad designs");
+    } else {
+        results.fail("SVF: Responses vs RBJ designs", "Worst difference " + std::to_string(worst) + " dB");
+    }
+    
+    // The filter itself realises toBiquad()
+    SVFFilter svf(fs);
+    svf.setParameters(SVFFilter::Type::LowShelf, 120.0f, 0.707f, 9.0f);
+    BiquadFilter biquad;
+    biquad.setCoefficients(svf.toBiquad());
+    auto signal = makeTestSignal(2000);
+    float maxDiff = 0.0f;
+    for (float x : signal) maxDiff = std::max(maxDiff, std::abs(svf.process(x) - biquad.process(x)));
+    
+    if (maxDiff < 1e-4f) {
+        results.pass("SVF: process() matches its equivalent biquad");
+    } else {
+        results.fail("SVF: process() vs equivalent biquad", "Max difference " + std::to_string(maxDiff));
+    }
+}
+
+void testSvfPerSampleModulation(TestResults& results) {
+    const float fs = 44100.0f;
+    const size_t n = 44100;
+    std::vector<float> input(n), cutoff(n), swept(n);
+    for (size_t i = 0; i < n; ++i) {
+        const float t = static_cast<float>(i) / fs;
+        input[i] = 0.8f * std::sin(2.0f * 3.14159265f * 110.0f * t) + 0.2f * std::sin(2.0f * 3.14159265f * 1900.0f * t);
+        // 8 Hz sweep over 200 Hz..8 kHz: an auto-wah pushed hard
+        cutoff[i] = 200.0f * std::pow(40.0f, 0.5f + 0.5f * std::sin(2.0f * 3.14159265f * 8.0f * t));
+    }
+    
+    SVFFilter wah(fs), manual(fs);
+    wah.setParameters(SVFFilter::Type::BandPass, 1000.0f, 6.0f);
+    manual.setParameters(SVFFilter::Type::BandPass, 1000.0f, 6.0f);
+    wah.processBlock(input.data(), swept.data(), n, cutoff.data());
+    
+    float peak = 0.0f, maxDiff = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        manual.setCutoff(cutoff[i]);
+        maxDiff = std::max(maxDiff, std::abs(manual.process(input[i]) - swept[i]));
+        peak = std::max(peak, std::abs(swept[i]));
+    }
+    
+    // A band-pass peaks at unity gain; the sweep may ring a little on top, never blow up
+    if (std::isfinite(peak) && peak < 1.5f && maxDiff == 0.0f) {
+        results.pass("SVF: Per-sample cutoff sweep stays bounded");
+    } else {
+        results.fail("SVF: Per-sample cutoff sweep", "Peak " + std::to_string(peak) +
+                     ", block vs manual " + std::to_string(maxDiff));
+    }
+}
+
+void testToneStackSvfBands(TestResults& results) {
+    const float fs = 48000.0f;
+    ToneStackController biquad(fs), svf(fs);
+    svf.setBandImplementation(ToneStackController::BandImplementation::SVF);
+    for (auto* tone : {&biquad, &svf}) {
+        tone->setBassGain(6.0f);
+        tone->setMidGain(-3.0f);
+        tone->setTrebleGain(9.0f);
+    }
+    
+    auto a = biquad.getCascadeCoefficients(), b = svf.getCascadeCoefficients();
+    float worst = 0.0f;
+    for (size_t i = 0; i < 3; ++i) worst = std::max(worst, worstDbDifference(a[i], b[i], fs));
+    
+    // Gain ramps complete in dB and land on the same response
+    auto signal = makeTestSignal(1000);
+    std::vector<float> out(signal.size());
+    svf.processBlock(signal.data(), out.data(), signal.size());
+    svf.setTrebleGain(-9.0f);
+    biquad.setTrebleGain(-9.0f);
+    const bool ramping = svf.isSmoothing();
+    svf.processBlock(signal.data(), out.data(), signal.size());
+    biquad.processBlock(signal.data(), out.data(), signal.size());
+    const float rampedWorst = worstDbDifference(biquad.getCascadeCoefficients()[2], svf.getCascadeCoefficients()[2], fs);
+    
+    // setBandFrequency retunes an SVF band in place
+    svf.setBandFrequency(ToneStackController::MID, 2000.0f);
+    const auto moved = svf.getCascadeCoefficients()[1];
+    const float centreGain = FrequencyResponseAnalyzer::getMagnitudeResponse(moved, {2000.0f}, fs)[0];
+    
+    if (worst < 0.01f && ramping && !svf.isSmoothing() && rampedWorst < 0.01f
+        && std::abs(20.0f * std::log10(centreGain) + 3.0f) < 0.05f) {
+        results.pass("Tone Stack: SVF bands match biquad bands and sweep");
+    } else {
+        results.fail("Tone Stack: SVF bands", "Worst " + std::to_string(worst) + " dB, after ramp " +
+                     std::to_string(rampedWorst) + " dB, moved centre " + std::to_string(centreGain));
+    }
+}
+
 int main() {
     std::cout << "\n" << std::string(80, '=') << "\n";
     std::cout << "STATE-SPACE FILTERING TEST SUITE - PHASE 2\n";
@@ -428,10 +1001,12 @@ int main() {
     testToneStackBassControl(results);
     testToneStackMidControl(results);
     testToneStackTrebleControl(results);
+    testToneStackCoefficientCache(results);
     
     // Test 3: Cascading
     std::cout << "\n=== TEST 3: Biquad Cascading ===\n";
     testBiquadCascading(results);
+    testFixedOrderFilterBank(results);
     
     // Test 4: Phase Response
     std::cout << "\n=== TEST 4: Phase Response Analysis ===\n";
@@ -456,6 +1031,26 @@ int main() {
     std::cout << "\n=== TEST 8: High-Pass Filter ===\n";
     testHighPassResponse(results);
     
+    // Test 9: Block & SIMD Lanes
+    std::cout << "\n=== TEST 9: Block & SIMD Lane Processing ===\n";
+    testBlockMatchesPerSample(results);
+    testLaneBankMatchesScalar(results);
+    
+    // Test 10: Batched Frequency Response
+    std::cout << "\n=== TEST 10: Batched Frequency Response ===\n";
+    testBatchedFrequencyResponse(results);
+    
+    // Test 11: State-Space Engine
+    std::cout << "\n=== TEST 11: State-Space Engine (RC Networks) ===\n";
+    testStateSpaceEngine(results);
+    
+    // Test 12: TPT SVF
+    std::cout << "\n=== TEST 12: TPT State-Variable Filter ===\n";
+    testSvfTanApproximation(results);
+    testSvfMatchesBiquadDesigns(results);
+    testSvfPerSampleModulation(results);
+    testToneStackSvfBands(results);
+    
     results.summary();
     
     return results.failed == 0 ? 0 : 1;
@@ -0,0 +1,183 @@
+#define LIVESPICE_TRACE 1
+#include "TraceZones.h"
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace LiveSpiceDSP;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void pass(const std::string& test) {
+        passed++;
+        std::cout << "✓ PASS: " << test << "\n";
+    }
+
+    void fail(const std::string& test, const std::string& reason) {
+        failed++;
+        std::cout << "✗ FAIL: " << test << " - " << reason << "\n";
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+static size_t countOf(const std::string& text, const std::string& needle) {
+    size_t count = 0;
+    for (size_t at = text.find(needle); at != std::string::npos; at = text.find(needle, at + 1)) ++count;
+    return count;
+}
+
+// "ts" of the first event named name
+static double timestampOf(const std::string& trace, const std::string& name) {
+    const size_t event = trace.find("{\"name\": \"" + name + "\"");
+    if (event == std::string::npos) return -1.0;
+    return std::stod(trace.substr(trace.find("\"ts\": ", event) + 6));
+}
+
+static void spin(int iterations) {
+    volatile double x = 1.0;
+    for (int i = 0; i < iterations; ++i) x = x * 1.0000001 + 1e-9;
+}
+
+// Every test shares one allocation: 4 thread buffers of 64 events
+static const size_t MAX_THREADS = 4;
+static const size_t EVENTS = 64;
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+void testZonesAndCounters(TestResults& results) {
+    TraceSession::start(MAX_THREADS, EVENTS);
+    LIVESPICE_TRACE_THREAD("Main");
+    {
+        LIVESPICE_TRACE_ZONE("Outer");
+        spin(20000);
+        {
+            LIVESPICE_TRACE_ZONE("Inner");
+            spin(20000);
+        }
+        LIVESPICE_TRACE_COUNTER("Oversampling factor", 4);
+    }
+    TraceSession::stop();
+
+    const std::string trace = TraceSession::toChromeTrace();
+    const double outer = timestampOf(trace, "Outer"), inner = timestampOf(trace, "Inner");
+    const bool complete = countOf(trace, "\"ph\": \"X\"") == 2 && countOf(trace, "\"ph\": \"C\"") == 1
+        && trace.find("\"args\": {\"value\": 4}") != std::string::npos
+        && trace.find("\"args\": {\"name\": \"Main\"}") != std::string::npos;
+
+    // Zones are written as they close, so the inner zone comes first
+    if (complete && outer >= 0.0 && inner > outer && trace.find("Inner") < trace.find("Outer")) {
+        results.pass("Zones nest, counters and thread names are exported");
+    } else {
+        results.fail("Zones nest, counters and thread names are exported", trace);
+    }
+}
+
+void testThreadsGetOwnTracks(TestResults& results) {
+    TraceSession::start(MAX_THREADS, EVENTS);
+    auto work = [](const char* thread) {
+        LIVESPICE_TRACE_THREAD(thread);
+        for (int i = 0; i < 10; ++i) {
+            LIVESPICE_TRACE_ZONE("Stage");
+            spin(1000);
+        }
+    };
+    std::thread first(work, "Worker A"), second(work, "Worker B");
+    first.join();
+    second.join();
+    TraceSession::stop();
+
+    const std::string trace = TraceSession::toChromeTrace();
+    const bool tracks = countOf(trace, "\"name\": \"Stage\"") == 20
+        && trace.find("Worker A") != std::string::npos && trace.find("Worker B") != std::string::npos
+        && countOf(trace, "\"tid\": 2,") + countOf(trace, "\"tid\": 3,") == 22;
+
+    if (tracks && TraceSession::getDroppedEvents() == 0) results.pass("Each thread records into its own track");
+    else results.fail("Each thread records into its own track", trace);
+}
+
+void testFullBuffersDrop(TestResults& results) {
+    TraceSession::start(MAX_THREADS, EVENTS);
+    for (size_t i = 0; i < EVENTS + 36; ++i) {
+        LIVESPICE_TRACE_ZONE("Block");
+    }
+
+    // Main and two workers hold three buffers: one more thread fits, the next drops
+    std::thread fits([] { LIVESPICE_TRACE_ZONE("Late"); });
+    fits.join();
+    std::thread dropped([] { LIVESPICE_TRACE_ZONE("Too late"); });
+    dropped.join();
+    TraceSession::stop();
+
+    const std::string trace = TraceSession::toChromeTrace();
+    const size_t lost = TraceSession::getDroppedEvents();
+    if (countOf(trace, "\"name\": \"Block\"") == EVENTS && lost == 37 && trace.find("\"Late\"") != std::string::npos
+        && trace.find("Too late") == std::string::npos && trace.find("\"droppedEvents\": 37") != std::string::npos) {
+        results.pass("Full buffers and surplus threads drop and count events");
+    } else {
+        results.fail("Full buffers and surplus threads drop and count events", "dropped " + std::to_string(lost));
+    }
+}
+
+void testIdleSessionRecordsNothing(TestResults& results) {
+    TraceSession::start(MAX_THREADS, EVENTS);
+    TraceSession::stop();
+    {
+        LIVESPICE_TRACE_ZONE("After stop");
+        LIVESPICE_TRACE_COUNTER("After stop", 1.0);
+    }
+
+    // A zone opened before start() is dropped rather than given a bogus start
+    TraceSession::start(MAX_THREADS, EVENTS);
+    TraceSession::stop();
+    TraceZone open("Straddles");
+    TraceSession::start(MAX_THREADS, EVENTS);
+    TraceSession::stop();
+
+    const std::string trace = TraceSession::toChromeTrace();
+    if (trace.find("After stop") == std::string::npos && trace.find("Straddles") == std::string::npos
+        && TraceSession::write("/tmp/livespice_trace_test.json")) {
+        results.pass("Nothing is recorded outside a session");
+    } else {
+        results.fail("Nothing is recorded outside a session", trace);
+    }
+}
+
+int main() {
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "TRACE ZONES TEST SUITE\n";
+    std::cout << std::string(80, '=') << "\n";
+
+    TestResults results;
+
+    std::cout << "\n=== TEST 1: Recording ===\n";
+    testZonesAndCounters(results);
+    testThreadsGetOwnTracks(results);
+
+    std::cout << "\n=== TEST 2: Limits ===\n";
+    testFullBuffersDrop(results);
+    testIdleSessionRecordsNothing(results);
+
+    results.summary();
+
+    return results.failed == 0 ? 0 : 1;
+}
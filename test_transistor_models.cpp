@@ -0,0 +1,425 @@
+#include "TransistorModels.h"
+#include "DeviceTables.h"
+#include "TransistorStages.h"
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace Nonlinear;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void pass(const std::string& test) {
+        passed++;
+        std::cout << "✓ PASS: " << test << "\n";
+    }
+
+    void fail(const std::string& test, const std::string& reason) {
+        failed++;
+        std::cout << "✗ FAIL: " << test << " - " << reason << "\n";
+    }
+
+    void check(const std::string& test, bool condition, const std::string& reason) {
+        if (condition) pass(test);
+        else fail(test, reason);
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+/**
+ * Worst relative error of the table stage against std::exp over the
+ * active region, where Ic is large enough to matter
+ */
+static float maxActiveRegionError(const BJTCharacteristics& bjt) {
+    BJTAmplifierStage exact(bjt);
+    BJTAmplifierStage table(bjt);
+    table.setUseCurrentTable(true);
+
+    float worst = 0.0f;
+    for (float vbe = 0.4f; vbe <= 0.8f; vbe += 0.0013f) {
+        float ref = exact.processVbe(vbe);
+        float approx = table.processVbe(vbe);
+        worst = std::max(worst, std::abs(approx - ref) / ref);
+    }
+    return worst;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+void testStockTables(TestResults& results) {
+    std::cout << "\n--- Compile-Time BJT Tables ---\n";
+
+    BJTCurrentLUT n3904(BJTCharacteristics::TwoN3904());
+    BJTCurrentLUT n2222(BJTCharacteristics::TwoN2222());
+    results.check("2N3904 uses static table", n3904.isStaticTable() && n3904.getTable() == &kBJTTable_2N3904,
+                  "runtime table built for stock part");
+    results.check("2N2222 uses static table", n2222.isStaticTable() && n2222.getTable() == &kBJTTable_2N2222,
+                  "runtime table built for stock part");
+
+    // The constexpr exp must agree with the runtime library
+    const BJTCharacteristics bjt = BJTCharacteristics::TwoN3904();
+    double worst = 0.0;
+    for (int i = 0; i < BJTCurrentLUT::LUT_SIZE; ++i) {
+        float vbe = BJTCurrentLUT::VBE_MIN + float(i) / (BJTCurrentLUT::LUT_SIZE - 1) * (BJTCurrentLUT::VBE_MAX - BJTCurrentLUT::VBE_MIN);
+        double expected = bjt.Bf * bjt.Is * (std::exp(double(std::clamp(vbe / (bjt.nBE * bjt.Vt), -50.0f, 50.0f))) - 1.0);
+        worst = std::max(worst, std::abs(kBJTTable_2N3904[i] - expected) / (std::abs(expected) + 1e-30));
+    }
+    results.check("Static table matches std::exp", worst < 1e-5,
+                  "max relative error " + std::to_string(worst));
+}
+
+void testCustomFallback(TestResults& results) {
+    std::cout << "\n--- Runtime Fallback ---\n";
+
+    BJTCharacteristics custom = BJTCharacteristics::TwoN3904();
+    custom.Bf = 150.0f;
+    BJTCurrentLUT lut(custom);
+    results.check("Custom part builds own table", !lut.isStaticTable(), "matched a stock table");
+
+    // TwoN5088 has no static table either
+    BJTCurrentLUT n5088(BJTCharacteristics::TwoN5088());
+    results.check("Non-stock preset falls back", !n5088.isStaticTable(), "matched a stock table");
+
+    float err = maxActiveRegionError(custom);
+    results.check("Custom table accuracy", err < 0.01f, "max relative error " + std::to_string(err));
+}
+
+void testStageWithTable(TestResults& results) {
+    std::cout << "\n--- BJTAmplifierStage Table Path ---\n";
+
+    BJTAmplifierStage stage(BJTCharacteristics::TwoN2222());
+    results.check("Table path off by default", !stage.isUsingCurrentTable(), "enabled by default");
+
+    float err3904 = maxActiveRegionError(BJTCharacteristics::TwoN3904());
+    float err2222 = maxActiveRegionError(BJTCharacteristics::TwoN2222());
+    results.check("2N3904 table matches exact", err3904 < 0.01f, "max relative error " + std::to_string(err3904));
+    results.check("2N2222 table matches exact", err2222 < 0.01f, "max relative error " + std::to_string(err2222));
+
+    // Disabling restores the exact path bit for bit
+    BJTAmplifierStage exact(BJTCharacteristics::TwoN2222());
+    stage.setUseCurrentTable(true);
+    stage.setUseCurrentTable(false);
+    results.check("Disable restores exact path", stage.processVbe(0.65f) == exact.processVbe(0.65f),
+                  "output differs from exact stage");
+}
+
+/**
+ * Worst relative error of a surface against the exact stage over the
+ * active region and the full Vce span
+ */
+static float maxSurfaceError(const BJTCharacteristics& bjt, BJTOperatingSurface::Interpolation mode) {
+    BJTAmplifierStage exact(bjt);
+    BJTAmplifierStage surface(bjt);
+    surface.setUseOperatingSurface(true, mode);
+
+    float worst = 0.0f;
+    for (float vce = 0.0f; vce <= 9.0f; vce += 0.37f) {
+        for (float vbe = 0.4f; vbe <= 0.8f; vbe += 0.0013f) {
+            float ref = exact.processVbe(vbe, vce);
+            float approx = surface.processVbe(vbe, vce);
+            worst = std::max(worst, std::abs(approx - ref) / ref);
+        }
+    }
+    return worst;
+}
+
+void testOperatingSurface(TestResults& results) {
+    std::cout << "\n--- Ic(Vbe, Vce) Operating Surface ---\n";
+
+    using Interpolation = BJTOperatingSurface::Interpolation;
+    {
+        BJTAmplifierStage a(BJTCharacteristics::TwoN3904());
+        BJTAmplifierStage b(BJTCharacteristics::TwoN3904());
+        BJTAmplifierStage c(BJTCharacteristics::TwoN2222());
+        a.setUseOperatingSurface(true);
+        b.setUseOperatingSurface(true);
+        c.setUseOperatingSurface(true);
+        results.check("Identical stages share surface", BJTOperatingSurface::cachedSurfaceCount() == 2,
+                      std::to_string(BJTOperatingSurface::cachedSurfaceCount()) + " live surfaces");
+
+        auto s1 = BJTOperatingSurface::acquire(BJTCharacteristics::TwoN3904(), 9.0f, Interpolation::Bicubic);
+        auto s2 = BJTOperatingSurface::acquire(BJTCharacteristics::TwoN3904(), 9.0f, Interpolation::Bilinear);
+        results.check("Interpolation mode keys the cache", s1 != s2, "bilinear and bicubic shared a surface");
+
+        a.setUseOperatingSurface(false);
+        results.check("Disable releases the stage's surface", !a.isUsingOperatingSurface(), "surface still attached");
+    }
+    results.check("Surfaces released with last user", BJTOperatingSurface::cachedSurfaceCount() == 0,
+                  std::to_string(BJTOperatingSurface::cachedSurfaceCount()) + " live surfaces");
+
+    float bilinear = maxSurfaceError(BJTCharacteristics::TwoN3904(), Interpolation::Bilinear);
+    float bicubic = maxSurfaceError(BJTCharacteristics::TwoN3904(), Interpolation::Bicubic);
+    std::cout << "  bilinear max relative error " << bilinear << ", bicubic " << bicubic << "\n";
+    results.check("Bilinear surface accuracy", bilinear < 0.01f, "max relative error " + std::to_string(bilinear));
+    results.check("Bicubic surface accuracy", bicubic < 1e-3f && bicubic < bilinear,
+                  "max relative error " + std::to_string(bicubic));
+}
+
+/**
+ * Mean and worst absolute output difference between the map and the
+ * iterative solve. The 5-step solve has small steps where its iteration
+ * count changes; worst-case error sits at those steps.
+ */
+static void transferMapError(FETOverdriveStage& mapped, FETOverdriveStage& exact, float& mean, float& worst) {
+    double sum = 0.0;
+    int count = 0;
+    worst = 0.0f;
+    for (float vin = -6.0f; vin <= 6.0f; vin += 0.0031f, ++count) {
+        float err = std::abs(mapped.processInputVoltage(vin) - exact.processInputVoltage(vin));
+        worst = std::max(worst, err);
+        sum += err;
+    }
+    mean = float(sum / count);
+}
+
+void testFETTransferMap(TestResults& results) {
+    std::cout << "\n--- FET Cached Transfer Map ---\n";
+
+    FETOverdriveStage exact(FETCharacteristics::TwoN7000(), 1000.0f);
+    FETOverdriveStage mapped(FETCharacteristics::TwoN7000(), 1000.0f);
+    results.check("Transfer map off by default", !mapped.isUsingTransferMap(), "enabled by default");
+
+    mapped.setUseTransferMap(true);
+    float mean, worst;
+    transferMapError(mapped, exact, mean, worst);
+    results.check("Map matches iterative solve", mean < 1e-3f && worst < 0.1f,
+                  "mean " + std::to_string(mean) + " V, max " + std::to_string(worst) + " V");
+
+    // Bias change: old map stays active until a rebuild is published
+    mapped.setDrainResistance(2200.0f);
+    exact.setDrainResistance(2200.0f);
+    results.check("Bias change flags rebuild", mapped.needsTransferMapRebuild(), "map not marked stale");
+
+    bool first = mapped.rebuildTransferMap();
+    bool second = mapped.rebuildTransferMap();
+    results.check("Rebuild waits for pickup", first && !second, "second rebuild overwrote a pending map");
+
+    mapped.processInputVoltage(0.0f);
+    results.check("Audio thread picks up new map", !mapped.needsTransferMapRebuild(), "still using the old map");
+
+    transferMapError(mapped, exact, mean, worst);
+    results.check("New map matches new bias", mean < 1e-3f && worst < 0.1f,
+                  "mean " + std::to_string(mean) + " V, max " + std::to_string(worst) + " V");
+}
+
+void testSpecializedStages(TestResults& results) {
+    std::cout << "\n--- Compile-Time Specialized Stages ---\n";
+
+    BJTAmplifierStage runtimeBJT(BJTCharacteristics::TwoN3904());
+    TransistorClippingStageT<BJTPolarity::NPN> npn(BJTCharacteristics::TwoN3904());
+    TransistorClippingStageT<BJTPolarity::PNP> pnp(BJTCharacteristics::TwoN3904());
+    FETOverdriveStage runtimeFET(FETCharacteristics::TwoN7000(), 1000.0f);
+    FETOverdriveStageT<FETChannel::NMOS> nmos(FETCharacteristics::TwoN7000(), 1000.0f);
+    FETOverdriveStageT<FETChannel::PMOS> pmos(FETCharacteristics::TwoN7000(), 1000.0f);
+
+    float bjtErr = 0.0f, fetErr = 0.0f;
+    bool mirrored = true;
+    for (float vin = -3.0f; vin <= 3.0f; vin += 0.001f) {
+        bjtErr = std::max(bjtErr, std::abs(npn.processInputVoltage(vin) - runtimeBJT.processInputVoltage(vin)));
+        fetErr = std::max(fetErr, std::abs(nmos.processInputVoltage(vin) - runtimeFET.processInputVoltage(vin)));
+        mirrored = mirrored && pnp.processInputVoltage(vin) == -npn.processInputVoltage(-vin)
+                            && pmos.processInputVoltage(vin) == -nmos.processInputVoltage(-vin);
+    }
+    results.check("NPN matches BJTAmplifierStage", bjtErr < 1e-4f, "max difference " + std::to_string(bjtErr) + " V");
+    results.check("NMOS matches FETOverdriveStage", fetErr == 0.0f, "max difference " + std::to_string(fetErr) + " V");
+    results.check("PNP/PMOS are mirrored complements", mirrored, "complement symmetry broken");
+    results.check("AC-coupled output is zero at rest", npn.processSample(0.0f) == 0.0f && nmos.processSample(0.0f) == 0.0f,
+                  "quiescent offset left in output");
+
+    std::vector<float> input(257), block(257);
+    for (size_t i = 0; i < input.size(); ++i) input[i] = std::sin(0.05f * float(i));
+    npn.processBlock(input.data(), block.data(), input.size());
+    bool blockMatches = true;
+    for (size_t i = 0; i < input.size(); ++i) blockMatches = blockMatches && block[i] == npn.processSample(input[i]);
+    results.check("Block equals per-sample", blockMatches, "processBlock differs from processSample");
+
+    HybridTransistorDiodeStage runtimeHybrid(BJTCharacteristics::TwoN2222());
+    HybridTransistorDiodeStageT<BJTPolarity::NPN, FETChannel::NMOS> hybrid(BJTCharacteristics::TwoN2222());
+    float hybridErr = 0.0f;
+    for (float vin = -2.0f; vin <= 2.0f; vin += 0.01f) {
+        hybridErr = std::max(hybridErr, std::abs(hybrid.processBJTClipperCascade(vin) - runtimeHybrid.processBJTClipperCascade(vin)));
+        hybridErr = std::max(hybridErr, std::abs(hybrid.processFETOverdriveCascade(vin) - runtimeHybrid.processFETOverdriveCascade(vin)));
+    }
+    results.check("Hybrid matches runtime stage", hybridErr < 1e-5f, "max difference " + std::to_string(hybridErr));
+}
+
+void testOperatingPointCache(TestResults& results) {
+    std::cout << "\n--- Cached DC Operating Point ---\n";
+
+    BJTAmplifierStage a(BJTCharacteristics::TwoN3904());
+    results.check("Bias point zero before solve", a.getCurrentBiasPoint().Ic == 0.0f, "state not zero-initialised");
+
+    size_t before = BJTAmplifierStage::cachedOperatingPointCount();
+    const auto& op = a.solveOperatingPoint();
+    float settled = a.processInputVoltage(op.inputVoltage);
+    results.check("Output idles at mid-swing", std::abs(settled - op.outputVoltage) < 1e-3f,
+                  std::to_string(settled) + " V vs " + std::to_string(op.outputVoltage) + " V");
+    results.check("Device starts at operating point", a.getCurrentBiasPoint().Ic == op.device.Ic && op.device.Ic > 0.0f,
+                  "Ic " + std::to_string(op.device.Ic * 1000.0f) + " mA");
+
+    BJTAmplifierStage b(BJTCharacteristics::TwoN3904());
+    b.solveOperatingPoint();
+    BJTAmplifierStage c(BJTCharacteristics::TwoN3904(), 4700.0f);
+    c.solveOperatingPoint();
+    size_t solved = BJTAmplifierStage::cachedOperatingPointCount() - before;
+    results.check("Solved once per parameter set", solved == 2 && b.getOperatingPoint().inputVoltage == op.inputVoltage,
+                  std::to_string(solved) + " solves for 3 stages");
+
+    a.processInputVoltage(2.0f);
+    a.reset();
+    results.check("reset() returns to operating point", a.getCurrentBiasPoint().Ic == op.device.Ic,
+                  "Ic " + std::to_string(a.getCurrentBiasPoint().Ic));
+}
+
+/**
+ * Circle x^2 + y^2 = 4 meeting the line x = y, for the bare solver
+ */
+struct CircleLine {
+    using Vector = std::array<double, 2>;
+    using Matrix = std::array<double, 4>;
+    void evaluate(const Vector& x, Vector& f, Matrix* J) const {
+        f = {x[0] * x[0] + x[1] * x[1] - 4.0, x[0] - x[1]};
+        if (J) *J = {2.0 * x[0], 2.0 * x[1], 1.0, -1.0};
+    }
+    void limit(const Vector&, Vector&) const {}
+};
+
+/**
+ * Largest relative mismatch between a circuit's Jacobian and central differences
+ */
+template <typename Circuit>
+static double jacobianError(const Circuit& circuit, const typename Circuit::Vector& x) {
+    typename Circuit::Matrix J;
+    typename Circuit::Vector f;
+    circuit.evaluate(x, f, &J);
+    double worst = 0.0;
+    for (size_t c = 0; c < x.size(); ++c) {
+        auto hi = x, lo = x;
+        hi[c] += 1e-7;
+        lo[c] -= 1e-7;
+        typename Circuit::Vector fHi, fLo;
+        circuit.evaluate(hi, fHi, nullptr);
+        circuit.evaluate(lo, fLo, nullptr);
+        for (size_t r = 0; r < x.size(); ++r) {
+            const double numeric = (fHi[r] - fLo[r]) / 2e-7;
+            const double analytic = J[r * x.size() + c];
+            worst = std::max(worst, std::abs(numeric - analytic) / std::max(std::abs(analytic), 1e-6));
+        }
+    }
+    return worst;
+}
+
+void testCoupledSolver(TestResults& results) {
+    std::cout << "\n--- Coupled Newton Solver ---\n";
+
+    ChordNewtonSolver<2> solver;
+    CircleLine circleLine;
+    ChordNewtonSolver<2>::Vector x{1.0, 2.0};
+    const auto first = solver.solve(circleLine, x);
+    results.check("Newton finds the 2-unknown root", first.converged && std::abs(x[0] - std::sqrt(2.0)) < 1e-6
+                  && std::abs(x[1] - std::sqrt(2.0)) < 1e-6, "x = " + std::to_string(x[0]) + ", " + std::to_string(x[1]));
+    x = {1.40, 1.43};
+    const auto nearby = solver.solve(circleLine, x);
+    results.check("Chord reuses the stored factors for a nearby solve", nearby.converged && nearby.factorizations == 0,
+                  std::to_string(nearby.factorizations) + " factorizations");
+
+    // Analytical Jacobians agree with differences in and out of saturation / clipping
+    detail::BJTFeedbackClipperCircuit bjt;
+    bjt.Is = 1.4e-14;
+    bjt.Bf = 255.0;
+    bjt.Br = 6.4;
+    bjt.Vbq = 0.64;
+    bjt.Vcq = 2.1;
+    bjt.vin = 0.01;
+    detail::FETDegeneratedClipperCircuit fet;
+    fet.Vdq = 5.5;
+    fet.vin = 0.3;
+    double jacobianWorst = 0.0;
+    for (double vo : {-0.7, 0.0, 0.55}) {
+        jacobianWorst = std::max(jacobianWorst, jacobianError(bjt, {0.62, 2.5, vo}));
+        jacobianWorst = std::max(jacobianWorst, jacobianError(bjt, {0.7, 0.1, vo}));
+        jacobianWorst = std::max(jacobianWorst, jacobianError(fet, {0.4, 6.0, vo}));
+        jacobianWorst = std::max(jacobianWorst, jacobianError(fet, {0.6, 0.8, vo}));
+    }
+    results.check("Circuit Jacobians match finite differences", jacobianWorst < 1e-3,
+                  "worst relative error " + std::to_string(jacobianWorst));
+
+    // Coupled stage: settles at rest, solves every sample of a hard-driven sine
+    HybridTransistorDiodeStage stage(BJTCharacteristics::TwoN2222());
+    results.check("Hybrid stage defaults to the cascade", stage.getSolveMode() == HybridTransistorDiodeStage::SolveMode::Cascade,
+                  "coupled by default");
+    stage.setSolveMode(HybridTransistorDiodeStage::SolveMode::Coupled);
+    const bool rest = std::abs(stage.processBJTClipperCascade(0.0f)) < 1e-6f && std::abs(stage.processFETOverdriveCascade(0.0f)) < 1e-6f;
+    float peak = 0.0f;
+    for (int i = 0; i < 48000; ++i) {
+        const float vin = 0.5f * std::sin(2.0f * 3.14159265f * 220.0f * float(i) / 48000.0f);
+        peak = std::max(peak, std::abs(stage.processBJTClipperCascade(vin)));
+        peak = std::max(peak, std::abs(stage.processFETOverdriveCascade(vin)));
+    }
+    const auto& bjtStats = stage.getBJTSolverStats();
+    const auto& fetStats = stage.getFETSolverStats();
+    const double bjtIterations = double(bjtStats.iterations) / double(bjtStats.solves);
+    const double fetIterations = double(fetStats.iterations) / double(fetStats.solves);
+    std::cout << "  iterations/sample " << bjtIterations << " (BJT), " << fetIterations << " (FET); factorizations/sample "
+              << double(bjtStats.factorizations) / double(bjtStats.solves) << ", "
+              << double(fetStats.factorizations) / double(fetStats.solves) << "\n";
+    results.check("Coupled stage rests at zero", rest, "output offset at rest");
+    results.check("Coupled solve converges every sample", bjtStats.failures == 0 && fetStats.failures == 0
+                  && bjtIterations < 5.0 && fetIterations < 5.0,
+                  std::to_string(bjtStats.failures + fetStats.failures) + " failures");
+    results.check("Diode pair bounds the coupled output", peak > 0.5f && peak < 0.8f, "peak " + std::to_string(peak) + " V");
+
+    // The feedback is inside the solve: more feedback, less small-signal gain
+    float gains[3];
+    for (int setting = 0; setting < 3; ++setting) {
+        const float feedback = 0.5f * float(setting);
+        float level = 0.0f;
+        for (int i = 0; i < 4800; ++i) {
+            const float y = stage.processBJTClipperCascade(0.002f * std::sin(0.0288f * float(i)), feedback);
+            if (i >= 2400) level = std::max(level, std::abs(y));
+        }
+        gains[setting] = level / 0.002f;
+    }
+    results.check("Feedback lowers the coupled stage's gain", gains[0] > gains[1] && gains[1] > gains[2] && gains[2] > 1.0f,
+                  "gains " + std::to_string(gains[0]) + ", " + std::to_string(gains[1]) + ", " + std::to_string(gains[2]));
+}
+
+int main() {
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "TRANSISTOR MODELS - TEST SUITE\n";
+    std::cout << std::string(80, '=') << "\n";
+
+    TestResults results;
+    testStockTables(results);
+    testCustomFallback(results);
+    testStageWithTable(results);
+    testOperatingSurface(results);
+    testFETTransferMap(results);
+    testSpecializedStages(results);
+    testOperatingPointCache(results);
+    testCoupledSolver(results);
+
+    results.summary();
+    return results.failed == 0 ? 0 : 1;
+}
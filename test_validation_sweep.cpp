@@ -0,0 +1,213 @@
+#include "SpiceValidation.h"
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace SpiceValidation;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void pass(const std::string& test) {
+        passed++;
+        std::cout << "✓ PASS: " << test << "\n";
+    }
+
+    void fail(const std::string& test, const std::string& reason) {
+        failed++;
+        std::cout << "✗ FAIL: " << test << " - " << reason << "\n";
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+using Topology = SpiceValidator::Topology;
+
+static SpiceValidator::ValidationConfig sweepConfig(const std::string& dir) {
+    SpiceValidator::ValidationConfig config;
+    config.runNgspice = false;
+    config.generateReport = false;
+    config.outputDir = dir;
+    config.topologies = {Topology::BackToBack, Topology::Series, Topology::Parallel};
+    config.frequencies = {100.0f, 1000.0f, 5000.0f};
+    config.amplitudes = {0.05f, 0.5f, 2.0f};
+    config.duration = 0.02f;
+    config.jobs = 4;
+    return config;
+}
+
+static SpiceNetlistGenerator::DiodeCircuitSpec clipperSpec() {
+    SpiceNetlistGenerator::DiodeCircuitSpec spec;
+    spec.title = "Clipper";
+    spec.diodePartNumber = "1N4148";
+    spec.sourceResistance = 1000.0f;
+    spec.loadResistance = 100000.0f;
+    return spec;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+void testSignalGenerator(TestResults& results) {
+    using Signal = TestSignalGenerator;
+    Signal::SignalParams params;
+    params.sampleRate = 48000.0f;
+    params.duration = 2.0f;
+    params.frequency = 997.0f;
+    params.amplitude = 0.5f;
+
+    // Recursive oscillator against sin() in double over two seconds
+    const auto sine = Signal::generateSignal(Signal::SignalType::SineWave, params);
+    double worst = 0.0;
+    for (size_t n = 0; n < sine.size(); ++n) {
+        worst = std::max(worst, std::abs(sine[n] - 0.5 * std::sin(2.0 * M_PI * 997.0 * n / 48000.0)));
+    }
+    std::vector<float> buffer(1000);
+    Signal::generateSignal(Signal::SignalType::SineWave, params, buffer.data(), buffer.size());
+    const bool samePrefix = std::equal(buffer.begin(), buffer.end(), sine.begin());
+    if (sine.size() == 96000 && worst < 1e-6 && samePrefix) {
+        results.pass("Oscillator sine within " + std::to_string(worst) + " of sin(); caller buffer matches");
+    } else {
+        results.fail("Sine", "max error " + std::to_string(worst));
+    }
+
+    // Linear chirp: phase 2 pi (f0 t + (f1 - f0) t^2 / 2T)
+    params.duration = 1.0f;
+    params.startFreq = 20.0f;
+    params.endFreq = 20000.0f;
+    const auto chirp = Signal::generateSignal(Signal::SignalType::Chirp, params);
+    worst = 0.0;
+    for (size_t n = 0; n < chirp.size(); ++n) {
+        const double t = n / 48000.0;
+        worst = std::max(worst, std::abs(chirp[n] - 0.5 * std::sin(2.0 * M_PI * (20.0 * t + 0.5 * 19980.0 * t * t))));
+    }
+    if (worst < 1e-5) {
+        results.pass("Chirp sweeps 20 Hz to 20 kHz, max error " + std::to_string(worst));
+    } else {
+        results.fail("Chirp", "max error " + std::to_string(worst));
+    }
+
+    const auto first = Signal::cachedSignal(Signal::SignalType::SineWave, params);
+    const auto second = Signal::cachedSignal(Signal::SignalType::SineWave, params);
+    params.amplitude = 0.25f;
+    const auto other = Signal::cachedSignal(Signal::SignalType::SineWave, params);
+    if (first == second && first != other && first->size() == 48000) {
+        results.pass("Cached signals shared per (type, parameters)");
+    } else {
+        results.fail("Signal cache", "cached signals not shared or not keyed by amplitude");
+    }
+
+    const auto steps = Signal::generateStepSweep(0.1f, 0.3f, 0.1f, 48000.0f);
+    if (steps.size() == Signal::stepSweepLength(0.1f, 0.3f, 0.1f, 48000.0f) && steps.size() % 4800 == 0) {
+        results.pass("Step sweep: " + std::to_string(steps.size() / 4800) + " levels of 100 ms");
+    } else {
+        results.fail("Step sweep", std::to_string(steps.size()) + " samples");
+    }
+}
+
+void testSweepRunsEveryCase(TestResults& results) {
+    const std::string dir = (std::filesystem::temp_directory_path() / "livespice_validation_sweep").string();
+    std::filesystem::remove_all(dir);
+    auto config = sweepConfig(dir);
+
+    std::set<std::string> streamed;
+    config.onResult = [&](const ValidationMetrics& result) { streamed.insert(result.circuitName); };
+
+    const auto cases = SpiceValidator::buildSweep(clipperSpec(), config);
+    const auto metrics = SpiceValidator::runSweep(cases, config);
+
+    bool inOrder = metrics.size() == cases.size();
+    for (size_t i = 0; inOrder && i < cases.size(); ++i) {
+        inOrder = metrics[i].circuitName == cases[i].name;
+    }
+    if (cases.size() == 27 && inOrder && streamed.size() == cases.size()) {
+        results.pass("27 cases run on 4 workers, streamed and returned in case order");
+    } else {
+        results.fail("Sweep", std::to_string(streamed.size()) + " of " + std::to_string(cases.size()) + " streamed");
+    }
+
+    if (std::filesystem::exists(dir + "/case_000/case.cir") && std::filesystem::exists(dir + "/case_026/case.cir")) {
+        results.pass("Each case writes its netlist to its own directory");
+    } else {
+        results.fail("Working directories", "case netlists missing under " + dir);
+    }
+    std::filesystem::remove_all(dir);
+}
+
+void testDiodeStageClips(TestResults& results) {
+    const std::string dir = (std::filesystem::temp_directory_path() / "livespice_validation_stage").string();
+    auto config = sweepConfig(dir);
+    config.frequencies = {1000.0f};
+    config.generateNetlists = false;
+    auto spec = clipperSpec();
+    spec.topology = Topology::Parallel;
+
+    config.amplitudes = {0.05f};
+    const float quiet = SpiceValidator::validateDiodeStage(spec, config).thd;
+    config.amplitudes = {2.0f};
+    const float loud = SpiceValidator::validateDiodeStage(spec, config).thd;
+
+    // Shunt diode: barely conducting at 50 mV, clipping the positive half at 2 V
+    if (quiet < 1.0f && loud > 10.0f) {
+        results.pass("Shunt diode stage THD " + std::to_string(quiet) + "% at 50 mV, " + std::to_string(loud) + "% at 2 V");
+    } else {
+        results.fail("Diode stage", "THD " + std::to_string(quiet) + "% / " + std::to_string(loud) + "%");
+    }
+    std::filesystem::remove_all(dir);
+}
+
+void testSharedBackendFallsBack(TestResults& results) {
+    const std::string dir = (std::filesystem::temp_directory_path() / "livespice_validation_shared").string();
+    std::filesystem::remove_all(dir);
+    auto config = sweepConfig(dir);
+    config.runNgspice = true;
+    config.backend = SpiceValidator::SpiceBackend::SharedLibrary;
+    config.ngspiceLibrary = dir + "/no-such-libngspice.so";
+    config.generateNetlists = false;
+    config.topologies = {Topology::Parallel};
+
+    const auto metrics = SpiceValidator::runSweep(SpiceValidator::buildSweep(clipperSpec(), config), config);
+    bool fellBack = metrics.size() == 9 && !NgspiceShared::loadError().empty();
+    for (const auto& m : metrics) {
+        fellBack = fellBack && m.notes.find("libngspice not loaded") == 0 && m.thd > 0.0f;
+    }
+    if (fellBack && !std::filesystem::exists(dir)) {
+        results.pass("Missing libngspice: DSP-only metrics, nothing written to disk");
+    } else {
+        results.fail("Shared backend", metrics.empty() ? "no results" : metrics.front().notes);
+    }
+}
+
+int main() {
+    std::cout << "Validation Sweep Tests\n";
+    std::cout << std::string(80, '=') << "\n\n";
+
+    TestResults results;
+    testSignalGenerator(results);
+    testSweepRunsEveryCase(results);
+    testDiodeStageClips(results);
+    testSharedBackendFallsBack(results);
+
+    results.summary();
+    return results.failed == 0 ? 0 : 1;
+}
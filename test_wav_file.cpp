@@ -0,0 +1,166 @@
+#include "WavFile.h"
+#include <iostream>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace LiveSpice;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void check(const std::string& test, bool condition, const std::string& detail) {
+        if (condition) {
+            passed++;
+            std::cout << "✓ PASS: " << test << " (" << detail << ")\n";
+        } else {
+            failed++;
+            std::cout << "✗ FAIL: " << test << " - " << detail << "\n";
+        }
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+static std::vector<float> ramp(size_t length, float scale) {
+    std::vector<float> x(length);
+    for (size_t i = 0; i < length; ++i) x[i] = scale * std::sin(0.01f * (float)i);
+    return x;
+}
+
+static float maxError(const std::vector<float>& a, const std::vector<float>& b) {
+    float error = a.size() == b.size() ? 0.0f : 1e9f;
+    for (size_t i = 0; i < std::min(a.size(), b.size()); ++i) error = std::max(error, std::abs(a[i] - b[i]));
+    return error;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+static void testRoundTrip(TestResults& results) {
+    const std::string path = "test_wav_roundtrip.wav";
+    const auto left = ramp(10007, 0.9f);
+    const auto right = ramp(10007, -0.5f);
+
+    struct Case {
+        WavWriter::Format format;
+        const char* name;
+        int bits;
+        float tolerance;
+    };
+    for (const Case& c : {Case{WavWriter::Format::Float32, "float32", 32, 0.0f},
+                          Case{WavWriter::Format::Pcm16, "pcm16", 16, 1.0f / 16384.0f},
+                          Case{WavWriter::Format::Pcm24, "pcm24", 24, 1.0f / 4194304.0f}}) {
+        {
+            // Odd block sizes against a 7-frame buffer cross every flush boundary
+            WavWriter writer(path, 48000, 2, c.format, 7);
+            for (size_t start = 0; start < left.size(); start += 13) {
+                const float* block[] = {left.data() + start, right.data() + start};
+                writer.write(block, std::min<size_t>(13, left.size() - start));
+            }
+        }
+
+        WavReader reader(path);
+        std::vector<float> l(reader.numFrames()), r(reader.numFrames());
+        float* dest[] = {l.data(), r.data()};
+        reader.read(0, reader.numFrames(), dest);
+        float error = std::max(maxError(l, left), maxError(r, right));
+        results.check(std::string("Round trip ") + c.name,
+                      reader.isOpen() && reader.getSampleRate() == 48000 && reader.getNumChannels() == 2 &&
+                          reader.getBitsPerSample() == c.bits && reader.numFrames() == left.size() &&
+                          error <= c.tolerance,
+                      std::to_string(reader.numFrames()) + " frames, max error " + std::to_string(error));
+    }
+    std::remove(path.c_str());
+}
+
+static void testViews(TestResults& results) {
+    const std::string path = "test_wav_views.wav";
+    WavData data;
+    data.sampleRate = 44100;
+    data.channels = {ramp(5000, 0.25f), ramp(5000, 0.75f)};
+    writeWav(path, data);
+
+    WavReader reader(path);
+    auto view = reader.channel(1);
+    bool indexed = view.size() == 5000;
+    for (size_t i = 0; i < view.size(); i += 97) indexed &= view[i] == data.channels[1][i];
+    results.check("Channel view indexing", indexed, "strided, decoded on access");
+
+    // Streaming in blocks sees the same samples as one read
+    std::vector<float> block(333), streamed;
+    for (size_t start = 0;; start += block.size()) {
+        size_t n = view.read(start, block.size(), block.data());
+        if (n == 0) break;
+        streamed.insert(streamed.end(), block.begin(), block.begin() + (std::ptrdiff_t)n);
+    }
+    results.check("Block streaming", maxError(streamed, data.channels[1]) == 0.0f,
+                  std::to_string(streamed.size()) + " frames in 333-frame blocks");
+
+    std::vector<float> mono(5000);
+    reader.readMono(0, mono.size(), mono.data());
+    float error = 0.0f;
+    for (size_t i = 0; i < mono.size(); ++i)
+        error = std::max(error, std::abs(mono[i] - 0.5f * (data.channels[0][i] + data.channels[1][i])));
+    results.check("Mono mix", error < 1e-7f, "max error " + std::to_string(error));
+
+    WavData whole;
+    bool ok = readWav(path, whole);
+    results.check("readWav matches writeWav", ok && whole.sampleRate == 44100 &&
+                                                  maxError(whole.channels[0], data.channels[0]) == 0.0f,
+                  std::to_string(whole.numFrames()) + " frames");
+    std::remove(path.c_str());
+}
+
+static void testHeaders(TestResults& results) {
+    // Hand-built 8-bit mono file with an unknown chunk and a truncated data chunk
+    const std::string path = "test_wav_headers.wav";
+    std::string bytes = "RIFF";
+    bytes += std::string("\x00\x00\x00\x00", 4) + "WAVE";
+    bytes += "LIST" + std::string("\x03\x00\x00\x00", 4) + "abc" + std::string(1, '\0');
+    bytes += "fmt " + std::string("\x10\x00\x00\x00\x01\x00\x01\x00\x44\xAC\x00\x00\x44\xAC\x00\x00\x01\x00\x08\x00", 20);
+    bytes += "data" + std::string("\x10\x00\x00\x00", 4) + std::string("\x80\xC0\x40", 3);
+    std::ofstream(path, std::ios::binary).write(bytes.data(), (std::streamsize)bytes.size());
+
+    WavReader reader(path);
+    auto view = reader.channel(0);
+    results.check("8-bit, skipped chunk, truncated data",
+                  reader.isOpen() && reader.numFrames() == 3 && view[0] == 0.0f && view[1] == 0.5f && view[2] == -0.5f,
+                  reader.isOpen() ? std::to_string(reader.numFrames()) + " frames" : reader.getError());
+
+    WavReader missing("does_not_exist.wav");
+    results.check("Missing file reports error", !missing.isOpen() && !missing.getError().empty(), missing.getError());
+    std::remove(path.c_str());
+}
+
+int main() {
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "WAV FILE - TEST SUITE\n";
+    std::cout << std::string(80, '=') << "\n";
+
+    TestResults results;
+    testRoundTrip(results);
+    testViews(results);
+    testHeaders(results);
+
+    results.summary();
+    return results.failed == 0 ? 0 : 1;
+}
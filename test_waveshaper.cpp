@@ -0,0 +1,224 @@
+#include "Waveshaper.h"
+#include "DiodeModels.h"
+#include "third_party/livespice-components/DSPImplementations.h"
+#include <algorithm>
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <string>
+
+using namespace LiveSpiceDSP;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void pass(const std::string& test) {
+        passed++;
+        std::cout << "✓ PASS: " << test << "\n";
+    }
+
+    void fail(const std::string& test, const std::string& reason) {
+        failed++;
+        std::cout << "✗ FAIL: " << test << " - " << reason << "\n";
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+static const double PI = 3.14159265358979;
+static const double SAMPLE_RATE = 48000.0;
+
+static std::vector<float> sine(double freq, double amplitude, size_t numSamples) {
+    std::vector<float> x(numSamples);
+    for (size_t n = 0; n < numSamples; ++n) {
+        x[n] = static_cast<float>(amplitude * std::sin(2.0 * PI * freq * double(n) / SAMPLE_RATE));
+    }
+    return x;
+}
+
+// Power in DFT bin k (bin width SAMPLE_RATE / x.size())
+static double binPower(const std::vector<float>& x, size_t k) {
+    double re = 0.0, im = 0.0;
+    for (size_t n = 0; n < x.size(); ++n) {
+        const double phase = 2.0 * PI * double(k) * double(n) / double(x.size());
+        re += x[n] * std::cos(phase);
+        im -= x[n] * std::sin(phase);
+    }
+    return re * re + im * im;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+void testTanhAccuracy(TestResults& results) {
+    const WaveshaperTable table = WaveshaperTable::tanh();
+
+    double worst = 0.0;
+    for (double x = -10.0; x <= 10.0; x += 0.001) {
+        worst = std::max(worst, std::abs(double(table.process(static_cast<float>(x))) - std::tanh(x)));
+    }
+
+    if (worst < 1e-5) results.pass("Cubic tanh table within 1e-5");
+    else results.fail("Cubic tanh table within 1e-5", "max error " + std::to_string(worst));
+}
+
+void testBlockMatchesSamples(TestResults& results) {
+    const WaveshaperTable table = WaveshaperTable::softClip();
+    std::vector<float> block = sine(997.0, 3.0, 1000);
+    std::vector<float> expected(block.size());
+    for (size_t n = 0; n < block.size(); ++n) expected[n] = table.process(block[n]);
+    table.processBlock(block.data(), block.data(), block.size());
+
+    const bool flat = table.process(1.5f) == table.process(7.0f) && std::abs(table.process(1.5f) - 1.0f) < 1e-6f;
+    if (block == expected && flat) results.pass("Block pass equals per-sample lookups in place");
+    else results.fail("Block pass equals per-sample lookups in place", "outputs differ");
+}
+
+void testBakesSoftClipperProcessor(TestResults& results) {
+    SoftClipperProcessor clipper;
+    clipper.prepare(SoftClipperProcessor::SINE_SHAPED, 2.0, 0.5);
+    const WaveshaperTable table([&](double x) { return clipper.process(x); }, 1.0);
+
+    // The kinks at |x| = 0.75 are the only places the cubics smooth over
+    double worst = 0.0;
+    for (double x = -1.2; x <= 1.2; x += 0.0007) {
+        if (std::abs(std::abs(x) - 0.75) < 0.005) continue;
+        worst = std::max(worst, std::abs(table.process(static_cast<float>(x)) - clipper.process(x)));
+    }
+
+    if (worst < 1e-5) results.pass("SoftClipperProcessor curve bakes into a table");
+    else results.fail("SoftClipperProcessor curve bakes into a table", "max error " + std::to_string(worst));
+}
+
+void testDiodePairs(TestResults& results) {
+    const Nonlinear::DiodeLUT silicon(Nonlinear::DiodeCharacteristics::Si1N4148());
+    const WaveshaperTable symmetric = WaveshaperTable::diodePair(silicon, silicon);
+    const WaveshaperTable asymmetric = WaveshaperTable::diodePair(silicon, silicon, 10000.0, 1, 2);
+
+    const float ceiling = symmetric.process(5.0f);
+    const bool odd = std::abs(symmetric.process(-2.0f) + symmetric.process(2.0f)) < 1e-4f;
+    const float ratio = -asymmetric.process(-5.0f) / asymmetric.process(5.0f);
+    const bool linear = std::abs(symmetric.process(0.05f) - 0.05f) < 1e-3f;
+
+    if (ceiling > 0.4f && ceiling < 0.8f && odd && ratio > 1.8f && ratio < 2.2f && linear) {
+        results.pass("Diode pair tables clip at the drop, two in series clip twice as high");
+    } else {
+        results.fail("Diode pair tables clip at the drop, two in series clip twice as high",
+                     "ceiling " + std::to_string(ceiling) + ", ratio " + std::to_string(ratio));
+    }
+}
+
+void testAntiderivative(TestResults& results) {
+    const WaveshaperTable table = WaveshaperTable::tanh();
+
+    // d/dx log(cosh(x)) = tanh(x); past the range the held edge integrates linearly
+    double worst = 0.0;
+    for (double x = -7.9; x <= 7.9; x += 0.013) {
+        worst = std::max(worst, std::abs(table.antiderivative(x) - std::log(std::cosh(x))));
+    }
+    const double slope = table.antiderivative(12.0) - table.antiderivative(11.0);
+
+    if (worst < 1e-5 && std::abs(slope - table.process(8.0f)) < 1e-6) {
+        results.pass("Antiderivative is log(cosh) and extends with the edge value");
+    } else {
+        results.fail("Antiderivative is log(cosh) and extends with the edge value", "max error " + std::to_string(worst));
+    }
+}
+
+void testADAABlockMatchesSamples(TestResults& results) {
+    auto table = std::make_shared<const WaveshaperTable>(WaveshaperTable::tanh());
+    WaveshaperADAA perSample, block;
+    perSample.setTable(table);
+    block.setTable(table);
+
+    // Odd block sizes cross the internal chunk boundary; a held input hits the midpoint fallback
+    std::vector<float> x = sine(440.0, 4.0, 1000);
+    std::fill(x.begin() + 500, x.begin() + 520, 0.3f);
+    std::vector<float> expected(x.size());
+    for (size_t n = 0; n < x.size(); ++n) expected[n] = perSample.process(x[n]);
+    for (size_t start = 0; start < x.size(); start += 333) {
+        block.processBlock(x.data() + start, x.data() + start, std::min<size_t>(333, x.size() - start));
+    }
+
+    float worst = 0.0f;
+    for (size_t n = 0; n < x.size(); ++n) worst = std::max(worst, std::abs(x[n] - expected[n]));
+    const bool held = std::abs(x[510] - table->process(0.3f)) < 1e-6f;
+
+    WaveshaperADAA empty;
+    float passthrough = 0.25f;
+    empty.processBlock(&passthrough, &passthrough, 1);
+
+    if (worst < 1e-6f && held && passthrough == 0.25f) results.pass("ADAA block pass equals per-sample ADAA");
+    else results.fail("ADAA block pass equals per-sample ADAA", "max error " + std::to_string(worst));
+}
+
+void testADAAReducesAliasing(TestResults& results) {
+    // 2730 Hz: odd harmonics 3..7 sit below Nyquist, 9 and up fold back between them.
+    // First-order ADAA with closed-form log(cosh) manages about 5 dB here too
+    const size_t N = 4800;
+    const size_t fundamentalBin = 273;
+    const std::vector<float> input = sine(2730.0, 6.0, N);
+
+    auto table = std::make_shared<const WaveshaperTable>(WaveshaperTable::tanh());
+    WaveshaperADAA adaa;
+    adaa.setTable(table);
+    std::vector<float> naive(N), antialiased(N);
+    table->processBlock(input.data(), naive.data(), N);
+    adaa.processBlock(input.data(), antialiased.data(), N);
+
+    auto aliasRatio = [&](const std::vector<float>& y) {
+        double harmonic = 0.0, alias = 0.0;
+        for (size_t k = 1; k < N / 2; ++k) {
+            const bool isHarmonic = k % fundamentalBin == 0 && (k / fundamentalBin) % 2 == 1;
+            (isHarmonic ? harmonic : alias) += binPower(y, k);
+        }
+        return 10.0 * std::log10(alias / harmonic);
+    };
+    const double naiveDb = aliasRatio(naive), adaaDb = aliasRatio(antialiased);
+
+    if (adaaDb < naiveDb - 4.0) {
+        results.pass("ADAA lowers aliasing by more than 4 dB");
+    } else {
+        results.fail("ADAA lowers aliasing by more than 4 dB",
+                     "naive " + std::to_string(naiveDb) + " dB, ADAA " + std::to_string(adaaDb) + " dB");
+    }
+}
+
+int main() {
+    std::cout << "\n" << std::string(80, '=') << "\n";
+    std::cout << "WAVESHAPER TEST SUITE\n";
+    std::cout << std::string(80, '=') << "\n";
+
+    TestResults results;
+
+    std::cout << "\n=== TEST 1: Tables ===\n";
+    testTanhAccuracy(results);
+    testBlockMatchesSamples(results);
+    testBakesSoftClipperProcessor(results);
+    testDiodePairs(results);
+
+    std::cout << "\n=== TEST 2: ADAA ===\n";
+    testAntiderivative(results);
+    testADAABlockMatchesSamples(results);
+    testADAAReducesAliasing(results);
+
+    results.summary();
+
+    return results.failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+#include "WDF.h"
+#include "DKMethod.h"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+using namespace LiveSpiceDSP;
+
+// ============================================================================
+// Test Utilities
+// ============================================================================
+
+class TestResults {
+public:
+    int passed = 0;
+    int failed = 0;
+
+    void pass(const std::string& test) {
+        passed++;
+        std::cout << "✓ PASS: " << test << "\n";
+    }
+
+    void fail(const std::string& test, const std::string& reason) {
+        failed++;
+        std::cout << "✗ FAIL: " << test << " - " << reason << "\n";
+    }
+
+    void summary() {
+        std::cout << "\n" << std::string(80, '=') << "\n";
+        std::cout << "Tests Passed: " << passed << "/" << (passed + failed) << "\n";
+        if (failed == 0) {
+            std::cout << "✓ ALL TESTS PASSED\n";
+        } else {
+            std::cout << "✗ " << failed << " tests failed\n";
+        }
+        std::cout << std::string(80, '=') << "\n";
+    }
+};
+
+static const double PI = 3.14159265358979323846;
+static const double SAMPLE_RATE = 48000.0;
+
+// 1N4148
+static const double IS = 2.52e-9;
+static const double N_VT = 1.752 * 0.02585;
+
+/** Input -> 1k -> node with 22n and a diode pair (or one diode) to ground */
+struct Clipper {
+    WDF::ResistiveVoltageSource source{1000.0};
+    WDF::Capacitor cap{22e-9, SAMPLE_RATE};
+    WDF::Parallel<WDF::ResistiveVoltageSource, WDF::Capacitor> node{source, cap};
+};
+
+static DKNetwork clipperNetwork(bool pair) {
+    DKNetwork network;
+    network.setInput(1, DKNetwork::GROUND);
+    network.addResistor(1, 2, 1000.0);
+    network.addCapacitor(2, DKNetwork::GROUND, 22e-9);
+    network.addDiode(2, DKNetwork::GROUND, IS, 1.752);
+    if (pair) network.addDiode(DKNetwork::GROUND, 2, IS, 1.752);
+    network.setOutput(2);
+    return network;
+}
+
+// ============================================================================
+// Tests
+// ============================================================================
+
+void testRCLowPass(TestResults& results) {
+    // 10k into 15.9n: -3 dB at 1 kHz
+    WDF::ResistiveVoltageSource source{10000.0};
+    WDF::Capacitor cap{15.9155e-9, SAMPLE_RATE};
+    WDF::Series<WDF::ResistiveVoltageSource, WDF::Capacitor> loop{source, cap};
+
+    const int period = 48;
+    double peak = 0.0;
+    for (int n = 0; n < 40 * period; ++n) {
+        source.setVoltage(std::sin(2.0 * PI * 1000.0 * n / SAMPLE_RATE));
+        loop.reflected();
+        loop.incident(-loop.b);  // short circuit closes the loop
+        if (n >= 39 * period) peak = std::max(peak, std::fabs(cap.voltage()));
+    }
+    if (std::fabs(peak - 1.0 / std::sqrt(2.0)) < 0.01) {
+        results.pass("RC low-pass (-3 dB at fc)");
+    } else {
+        results.fail("RC low-pass", "corner gain " + std::to_string(peak));
+    }
+}
+
+void testDiodePairMatchesDK(TestResults& results) {
+    Clipper wdf;
+    WDF::DiodePair<decltype(wdf.node)> root{wdf.node, IS, N_VT};
+    DKProcessor<1, 2> dk;
+    dk.setModel(clipperNetwork(true).build(SAMPLE_RATE));
+
+    double worst = 0.0, peak = 0.0;
+    for (int n = 0; n < 4800; ++n) {
+        const double x = 5.0 * std::sin(2.0 * PI * 220.0 * n / SAMPLE_RATE);
+        wdf.source.setVoltage(x);
+        root.process();
+        const double y = dk.processSample(static_cast<float>(x));
+        worst = std::max(worst, std::fabs(root.voltage() - y));
+        peak = std::max(peak, std::fabs(root.voltage()));
+    }
+    if (worst < 5e-3 && peak > 0.5 && peak < 1.0) {
+        results.pass("Diode pair clipper matches the DK solver");
+    } else {
+        results.fail("Diode pair clipper", "max deviation " + std::to_string(worst) + ", peak " + std::to_string(peak));
+    }
+}
+
+void testSingleDiodeMatchesDK(TestResults& results) {
+    Clipper wdf;
+    WDF::Diode<decltype(wdf.node)> root{wdf.node, IS, N_VT};
+    DKProcessor<1, 1> dk;
+    dk.setModel(clipperNetwork(false).build(SAMPLE_RATE));
+
+    double worst = 0.0, lowest = 0.0;
+    for (int n = 0; n < 4800; ++n) {
+        const double x = 5.0 * std::sin(2.0 * PI * 220.0 * n / SAMPLE_RATE);
+        wdf.source.setVoltage(x);
+        root.process();
+        const double y = dk.processSample(static_cast<float>(x));
+        worst = std::max(worst, std::fabs(root.voltage() - y));
+        lowest = std::min(lowest, root.voltage());
+    }
+    if (worst < 5e-3 && lowest < -4.5) {
+        results.pass("Single diode clipper matches the DK solver (half-wave)");
+    } else {
+        results.fail("Single diode clipper", "max deviation " + std::to_string(worst) + ", lowest " + std::to_string(lowest));
+    }
+}
+
+void testResistanceChange(TestResults& results) {
+    // Divider 1k over a variable leg: changing the leg re-adapts the tree.
+    // The loop is closed by a short, so the leg sits at minus the source.
+    WDF::ResistiveVoltageSource source{1000.0};
+    WDF::Resistor leg{1000.0};
+    WDF::Series<WDF::ResistiveVoltageSource, WDF::Resistor> loop{source, leg};
+    source.setVoltage(1.0);
+
+    auto settle = [&]() {
+        loop.reflected();
+        loop.incident(-loop.b);
+        return leg.voltage();
+    };
+    const double half = settle();
+    leg.setResistance(3000.0);
+    const double threeQuarters = settle();
+    if (std::fabs(half + 0.5) < 1e-12 && std::fabs(threeQuarters + 0.75) < 1e-12 && std::fabs(loop.R - 4000.0) < 1e-9) {
+        results.pass("Resistance change propagates to the adaptor");
+    } else {
+        results.fail("Resistance change", std::to_string(half) + " / " + std::to_string(threeQuarters));
+    }
+}
+
+int main() {
+    std::cout << "Wave Digital Filter Tests\n";
+    std::cout << std::string(80, '=') << "\n\n";
+
+    TestResults results;
+    testRCLowPass(results);
+    testDiodePairMatchesDK(results);
+    testSingleDiodeMatchesDK(results);
+    testResistanceChange(results);
+
+    results.summary();
+    return results.failed == 0 ? 0 : 1;
+}
@@ -2,6 +2,8 @@
 #include <string>
 #include <cmath>
 #include <map>
+#include <array>
+#include <algorithm>
 
 namespace LiveSpiceComponents {
 
@@ -314,6 +316,21 @@ struct TriodeModel {
         return ip;
     }
     
+    // Same model in float with a pluggable math policy (any type with a
+    // static pow(float, float), e.g. LiveSpiceDSP::FastMath)
+    template <typename Math>
+    static inline float calculatePlateCurrentKoren(float vc, float vp, const TriodeModel& model) {
+        float numerator = float(model.mu) * vc + vp;
+        float denominator = float(model.mu * model.Kvb) + vp;
+        
+        if (denominator <= 0.0f) return 0.0f;
+        
+        float base = numerator / denominator;
+        if (base <= 0.0f) return 0.0f;
+        
+        return float(model.Kp) * Math::pow(base, float(model.gamma));
+    }
+    
     // Common tube models
     static TriodeModel getModel(const std::string& partNumber) {
         if (partNumber == "12AX7") {
@@ -334,6 +351,76 @@ struct TriodeModel {
     }
 };
 
+// Tabulated Koren plate current in float
+// base^gamma is tabulated on a sqrt-warped axis, s = sqrt(base / baseMax),
+// so points crowd toward cutoff where the curve bends hardest. Bases above
+// the table (vc > VC_MAX or vp > VP_MAX) fall back to std::pow.
+class KorenPlateCurrentTable {
+public:
+    static constexpr int TABLE_SIZE = 512;
+    static constexpr float VC_MAX = 10.0f;   // Grid-cathode (V)
+    static constexpr float VP_MAX = 600.0f;  // Plate-cathode (V)
+    
+    void prepare(const TriodeModel& model) {
+        mu = float(model.mu);
+        muKvb = float(model.mu * model.Kvb);
+        Kp = float(model.Kp);
+        gamma = float(model.gamma);
+        baseMax = (mu * VC_MAX + VP_MAX) / (muKvb + VP_MAX);
+        indexScale = float(TABLE_SIZE - 1);
+        for (int i = 0; i < TABLE_SIZE; ++i) {
+            double s = double(i) / (TABLE_SIZE - 1);
+            table[i] = float(model.Kp * std::pow(baseMax * s * s, model.gamma));
+        }
+    }
+    
+    float calculatePlateCurrent(float vc, float vp) const {
+        float denominator = muKvb + vp;
+        if (denominator <= 0.0f) return 0.0f;
+        
+        float base = (mu * vc + vp) / denominator;
+        if (base <= 0.0f) return 0.0f;
+        if (base >= baseMax) return Kp * std::pow(base, gamma);
+        
+        float x = std::sqrt(base / baseMax) * indexScale;
+        int i = std::min(int(x), TABLE_SIZE - 2);
+        float t = x - float(i);
+        return table[i] + t * (table[i + 1] - table[i]);
+    }
+    
+    // Error against the exact double formula over vc in [-VC_MAX, VC_MAX],
+    // vp in [0, VP_MAX]. Relative error is taken where Ip >= 1% of full scale.
+    struct ErrorReport {
+        double fullScale;      // Ip at (VC_MAX, VP_MAX)
+        double maxAbsError;    // Amps
+        double maxRelError;
+    };
+    
+    static ErrorReport measureError(const TriodeModel& model, int gridSteps = 400) {
+        KorenPlateCurrentTable fast;
+        fast.prepare(model);
+        ErrorReport report{TriodeModel::calculatePlateCurrentKoren(VC_MAX, VP_MAX, model), 0.0, 0.0};
+        for (int i = 0; i <= gridSteps; ++i) {
+            for (int j = 0; j <= gridSteps; ++j) {
+                float vc = -VC_MAX + 2.0f * VC_MAX * float(i) / gridSteps;
+                float vp = VP_MAX * float(j) / gridSteps;
+                double exact = TriodeModel::calculatePlateCurrentKoren(double(vc), double(vp), model);
+                double err = std::abs(fast.calculatePlateCurrent(vc, vp) - exact);
+                report.maxAbsError = std::max(report.maxAbsError, err);
+                if (exact >= 0.01 * report.fullScale) {
+                    report.maxRelError = std::max(report.maxRelError, err / exact);
+                }
+            }
+        }
+        return report;
+    }
+    
+private:
+    float mu = 0.0f, muKvb = 0.0f, Kp = 0.0f, gamma = 1.0f;
+    float baseMax = 1.0f, indexScale = 1.0f;
+    std::array<float, TABLE_SIZE> table{};
+};
+
 // ============================================================================
 // TRANSFORMER - IDEAL MODEL
 // ============================================================================
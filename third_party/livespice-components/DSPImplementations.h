@@ -1,168 +1,236 @@
 #pragma once
 #include <cmath>
-#include <array>
+#include <algorithm>
+#include <type_traits>
 #include "../livespice-components/ComponentModels.h"
 
 namespace LiveSpiceDSP {
 
 using namespace LiveSpiceComponents;
 
+// Processors are templates on the sample type. Component models stay in
+// double; everything a processor needs per sample is converted (and any
+// division or temperature term folded) in prepare(), so a float processor
+// runs entirely in float. The unprefixed names are the double versions.
+
 // ============================================================================
 // DSP RESISTOR PROCESSOR
 // ============================================================================
 
-class ResistorProcessor {
+template <typename SampleType>
+class BasicResistorProcessor {
+    static_assert(std::is_floating_point<SampleType>::value, "SampleType must be float or double");
+
 private:
-    double resistance = 1000.0;  // 1k Ohm default
-    double voltage = 0.0;
-    double current = 0.0;
+    SampleType resistance = SampleType(1000);  // 1k Ohm default
+    SampleType conductance = SampleType(1) / SampleType(1000);
+    SampleType voltage = 0;
+    SampleType current = 0;
 
 public:
     void prepare(double resistance) {
-        this->resistance = resistance;
+        this->resistance = static_cast<SampleType>(resistance);
+        conductance = static_cast<SampleType>(1.0 / resistance);
     }
 
-    void process(double inputVoltage) {
+    void process(SampleType inputVoltage) {
         voltage = inputVoltage;
-        current = ResistorModel::calculateCurrent(voltage, resistance);
+        current = voltage * conductance;   // Ohm's law, I = V / R
     }
 
-    double getVoltage() const { return voltage; }
-    double getCurrent() const { return current; }
-    double getResistance() const { return resistance; }
+    SampleType getVoltage() const { return voltage; }
+    SampleType getCurrent() const { return current; }
+    SampleType getResistance() const { return resistance; }
 };
 
 // ============================================================================
 // DSP CAPACITOR PROCESSOR
 // ============================================================================
 
-class CapacitorProcessor {
+template <typename SampleType>
+class BasicCapacitorProcessor {
 private:
-    double capacitance = 1e-6;  // 1µF default
-    double voltage = 0.0;
-    double current = 0.0;
-    double previousVoltage = 0.0;
-    double esr = 0.1;
+    SampleType capacitance = SampleType(1e-6);  // 1µF default
+    SampleType voltage = 0;
+    SampleType current = 0;
+    SampleType previousVoltage = 0;
+    SampleType esr = SampleType(0.1);
+    SampleType sampleRate = SampleType(48000);   // dV/dt = dV * sampleRate (no per-sample 1/dt)
 
 public:
-    void prepare(double cap, double seriesResistance = 0.1) {
-        capacitance = cap;
-        esr = seriesResistance;
-        voltage = 0.0;
-        previousVoltage = 0.0;
+    void prepare(double cap, double seriesResistance = 0.1, double rate = 0.0) {
+        capacitance = static_cast<SampleType>(cap);
+        esr = static_cast<SampleType>(seriesResistance);
+        if (rate > 0.0) sampleRate = static_cast<SampleType>(rate);
+        reset();
     }
 
-    void process(double inputVoltage, double sampleRate) {
-        double dt = 1.0 / sampleRate;
-        
+    // Discharge: back to rest, as after prepare()
+    void reset() {
+        voltage = 0;
+        current = 0;
+        previousVoltage = 0;
+    }
+
+    void setSampleRate(double rate) { sampleRate = static_cast<SampleType>(rate); }
+
+    void process(SampleType inputVoltage) {
         // dV/dt estimation
-        double dv_dt = (inputVoltage - previousVoltage) / dt;
-        
+        SampleType dv_dt = (inputVoltage - previousVoltage) * sampleRate;
+
         // Capacitive current: i = C * dV/dt
-        double capacitiveImpedance = 1.0 / (capacitance * dv_dt + 1e-10);
+        SampleType capacitiveImpedance = SampleType(1) / (capacitance * dv_dt + SampleType(1e-10));
         current = (inputVoltage - voltage) / (esr + capacitiveImpedance);
-        
+
         // Update voltage
         voltage = inputVoltage - (current * esr);
         previousVoltage = voltage;
     }
 
-    double getVoltage() const { return voltage; }
-    double getCurrent() const { return current; }
-    double getCapacitance() const { return capacitance; }
+    // Rate passed per call (older generated code); prefer prepare(..., rate)
+    void process(SampleType inputVoltage, double rate) {
+        sampleRate = static_cast<SampleType>(rate);
+        process(inputVoltage);
+    }
+
+    SampleType getVoltage() const { return voltage; }
+    SampleType getCurrent() const { return current; }
+    SampleType getCapacitance() const { return capacitance; }
 };
 
 // ============================================================================
 // DSP INDUCTOR PROCESSOR
 // ============================================================================
 
-class InductorProcessor {
+template <typename SampleType>
+class BasicInductorProcessor {
 private:
-    double inductance = 0.1;  // 100mH default
-    double dcResistance = 1.0;
-    double current = 0.0;
-    double previousCurrent = 0.0;
-    double voltage = 0.0;
+    SampleType inductance = SampleType(0.1);  // 100mH default
+    SampleType dcResistance = 1;
+    SampleType current = 0;
+    SampleType previousCurrent = 0;
+    SampleType voltage = 0;
+    double sampleRate = 0.0;
+    SampleType dtOverL = 0;          // dt / L (0 when L is 0)
+    SampleType inductanceRate = 0;   // L / dt
+
+    void setRate(double rate) {
+        sampleRate = rate;
+        const double dt = 1.0 / rate;
+        dtOverL = inductance > 0 ? static_cast<SampleType>(dt / static_cast<double>(inductance)) : SampleType(0);
+        inductanceRate = static_cast<SampleType>(static_cast<double>(inductance) * rate);
+    }
 
 public:
-    void prepare(double inductance, double dcR = 1.0) {
-        this->inductance = inductance;
-        this->dcResistance = dcR;
-        current = 0.0;
-        previousCurrent = 0.0;
+    void prepare(double inductance, double dcR = 1.0, double rate = 48000.0) {
+        this->inductance = static_cast<SampleType>(inductance);
+        this->dcResistance = static_cast<SampleType>(dcR);
+        reset();
+        setRate(rate);
     }
 
-    void process(double appliedVoltage, double sampleRate) {
-        double dt = 1.0 / sampleRate;
-        
+    void reset() {
+        current = 0;
+        previousCurrent = 0;
+        voltage = 0;
+    }
+
+    void process(SampleType appliedVoltage) {
         // V = L * dI/dt + I*R
         // Solve for current change: dI = (V - I*R) / L * dt
-        if (inductance > 0.0) {
-            double di_dt = (appliedVoltage - (current * dcResistance)) / inductance;
-            current += di_dt * dt;
-        }
-        
+        current += (appliedVoltage - (current * dcResistance)) * dtOverL;
+
         // Voltage across inductor: V = L * dI/dt
-        if (dt > 0.0) {
-            voltage = inductance * ((current - previousCurrent) / dt) + (current * dcResistance);
-        }
-        
+        voltage = inductanceRate * (current - previousCurrent) + (current * dcResistance);
+
         previousCurrent = current;
     }
 
-    double getVoltage() const { return voltage; }
-    double getCurrent() const { return current; }
-    double getInductance() const { return inductance; }
+    // Rate passed per call (older generated code); prefer prepare(..., rate)
+    void process(SampleType appliedVoltage, double rate) {
+        if (rate != sampleRate && rate > 0.0) setRate(rate);
+        process(appliedVoltage);
+    }
+
+    SampleType getVoltage() const { return voltage; }
+    SampleType getCurrent() const { return current; }
+    SampleType getInductance() const { return inductance; }
 };
 
 // ============================================================================
 // DSP DIODE PROCESSOR - SHOCKLEY EQUATION
 // ============================================================================
 
-class DiodeProcessor {
+template <typename SampleType>
+class BasicDiodeProcessor {
 private:
+    // exp() limit: e^100 overflows float, e^80 does not
+    static constexpr SampleType maxExponent = std::is_same<SampleType, float>::value ? SampleType(80) : SampleType(100);
+
     DiodeModel model;
-    double voltage = 0.0;
-    double current = 0.0;
+    SampleType voltage = 0;
+    SampleType current = 0;
     double temperature = 298.15;  // 25°C Kelvin
 
+    // From the model and temperature, set in prepare()
+    SampleType saturationCurrent = 0;
+    SampleType inverseNVt = 0;       // 1 / (n * Vt)
+    SampleType seriesResistance = 0;
+    SampleType nVt = 0;
+
+    void updateConstants() {
+        const double q = 1.602176634e-19;  // Coulomb's charge
+        const double k = 1.380649e-23;     // Boltzmann constant
+        const double thermalVoltage = k * temperature / q;
+        saturationCurrent = static_cast<SampleType>(model.IS);
+        nVt = static_cast<SampleType>(model.n * thermalVoltage);
+        inverseNVt = static_cast<SampleType>(1.0 / (model.n * thermalVoltage));
+        seriesResistance = static_cast<SampleType>(model.Rs);
+    }
+
+    SampleType shockley(SampleType v) const {
+        SampleType exponent = v * inverseNVt;
+        if (exponent > maxExponent) return saturationCurrent * std::exp(maxExponent);  // Prevent overflow
+        if (exponent < SampleType(-10)) return -saturationCurrent;  // Reverse saturation
+        return saturationCurrent * std::expm1(exponent);
+    }
+
 public:
+    BasicDiodeProcessor() { updateConstants(); }
+
     void prepare(const std::string& partNumber = "1N4148", double temp = 298.15) {
-        model = DiodeModel::getModel(partNumber);
-        temperature = temp;
-        voltage = 0.0;
-        current = 0.0;
+        prepare(DiodeModel::getModel(partNumber), temp);
     }
 
+    // Model already resolved (e.g. held in a plugin's shared state)
     void prepare(const DiodeModel& diodeModel, double temp = 298.15) {
         model = diodeModel;
         temperature = temp;
+        voltage = 0;
+        current = 0;
+        updateConstants();
     }
 
-    void process(double appliedVoltage) {
+    void process(SampleType appliedVoltage) {
         voltage = appliedVoltage;
-        
+
         // Shockley equation with series resistance iteration
         // I = IS * (exp(V/(n*Vt)) - 1), considering series resistance
-        current = DiodeModel::calculateCurrent(voltage, model.IS, model.n, temperature);
-        
+        current = shockley(voltage);
+
         // Apply series resistance feedback correction
         for (int i = 0; i < 3; ++i) {  // 3 iterations for convergence
-            double irsDrop = current * model.Rs;
-            double correctedVoltage = appliedVoltage - irsDrop;
-            current = DiodeModel::calculateCurrent(correctedVoltage, model.IS, model.n, temperature);
+            SampleType irsDrop = current * seriesResistance;
+            current = shockley(appliedVoltage - irsDrop);
         }
     }
 
-    double getVoltage() const { return voltage; }
-    double getCurrent() const { return current; }
-    double getDifferentialResistance() const {
+    SampleType getVoltage() const { return voltage; }
+    SampleType getCurrent() const { return current; }
+    SampleType getDifferentialResistance() const {
         // dI/dV for operating point
-        const double q = 1.602176634e-19;
-        const double k = 1.380649e-23;
-        double Vt = k * temperature / q;
-        double rd = (model.n * Vt) / (current + 1e-12);  // Avoid division by zero
-        return rd + model.Rs;
+        SampleType rd = nVt / (current + SampleType(1e-12));  // Avoid division by zero
+        return rd + seriesResistance;
     }
 };
 
@@ -170,50 +238,64 @@ public:
 // DSP BJT PROCESSOR - EBERS-MOLL MODEL
 // ============================================================================
 
-class BJTProcessor {
+template <typename SampleType>
+class BasicBJTProcessor {
 private:
     BJTModel model;
-    double vbe = 0.0;     // Base-emitter voltage
-    double vce = 0.0;     // Collector-emitter voltage
-    double ic = 0.0;      // Collector current
-    double ib = 0.0;      // Base current
-    double ie = 0.0;      // Emitter current
+    SampleType vbe = 0;     // Base-emitter voltage
+    SampleType vce = 0;     // Collector-emitter voltage
+    SampleType ic = 0;      // Collector current
+    SampleType ib = 0;      // Base current
+    SampleType ie = 0;      // Emitter current
     double temperature = 298.15;
-    
-    // Thermal voltage
-    const double q = 1.602176634e-19;
-    const double k = 1.380649e-23;
+
+    // From the model and temperature, set in prepare()
+    SampleType saturationCurrent = 0;
+    SampleType inverseVt = 0;        // 1 / Vt (ideality factor 1)
+    SampleType inverseEarly = 0;     // 1 / Vaf
+    SampleType inverseBeta = 0;      // 1 / Bf
+
+    void updateConstants() {
+        const double q = 1.602176634e-19;
+        const double k = 1.380649e-23;
+        saturationCurrent = static_cast<SampleType>(model.Is);
+        inverseVt = static_cast<SampleType>(q / (k * temperature));
+        inverseEarly = static_cast<SampleType>(1.0 / model.Vaf);
+        inverseBeta = static_cast<SampleType>(1.0 / model.Bf);
+    }
 
 public:
+    BasicBJTProcessor() { updateConstants(); }
+
     void prepare(const std::string& partNumber = "2N3904", double temp = 298.15) {
         model = BJTModel::getModel(partNumber);
         temperature = temp;
+        updateConstants();
     }
 
-    void process(double baseVoltage, double collectorVoltage, double emitterVoltage) {
+    void process(SampleType baseVoltage, SampleType collectorVoltage, SampleType emitterVoltage) {
         vbe = baseVoltage - emitterVoltage;
         vce = collectorVoltage - emitterVoltage;
-        
-        // Calculate collector current
-        ic = BJTModel::calculateCollectorCurrent(vbe, vce, model, temperature);
-        
+
         // Beta relationship: Ic = Beta * Ib
-        if (vbe > 0.4) {  // Forward bias threshold
-            ib = ic / model.Bf;
+        if (vbe > SampleType(0.4)) {  // Forward bias threshold
+            // Collector current: Ic = Is * (exp(Vbe/Vt) - 1) * (1 + Vce/Vaf)
+            ic = saturationCurrent * std::expm1(vbe * inverseVt) * (SampleType(1) + vce * inverseEarly);
+            ib = ic * inverseBeta;
         } else {
-            ic = 0.0;
-            ib = 0.0;
+            ic = 0;
+            ib = 0;
         }
-        
+
         // Kirchhoff's current law: Ie = Ic + Ib
         ie = ic + ib;
     }
 
-    double getCollectorCurrent() const { return ic; }
-    double getBaseCurrent() const { return ib; }
-    double getEmitterCurrent() const { return ie; }
-    double getVbe() const { return vbe; }
-    double getVce() const { return vce; }
+    SampleType getCollectorCurrent() const { return ic; }
+    SampleType getBaseCurrent() const { return ib; }
+    SampleType getEmitterCurrent() const { return ie; }
+    SampleType getVbe() const { return vbe; }
+    SampleType getVce() const { return vce; }
     double getBeta() const { return model.Bf; }
 };
 
@@ -221,139 +303,220 @@ public:
 // DSP JFET PROCESSOR - QUADRATIC MODEL
 // ============================================================================
 
-class JFETProcessor {
+template <typename SampleType>
+class BasicJFETProcessor {
 private:
     JFETModel model;
-    double vgs = 0.0;     // Gate-source voltage
-    double vds = 0.0;     // Drain-source voltage
-    double id = 0.0;      // Drain current
-    double gm = 0.0;      // Transconductance
+    SampleType vgs = 0;     // Gate-source voltage
+    SampleType vds = 0;     // Drain-source voltage
+    SampleType id = 0;      // Drain current
+    SampleType gm = 0;      // Transconductance
+
+    SampleType vto = 0, kp = 0, lambda = 0;   // From the model, set in prepare()
+
+    void updateConstants() {
+        vto = static_cast<SampleType>(model.Vto);
+        kp = static_cast<SampleType>(model.Kp);
+        lambda = static_cast<SampleType>(model.lambda);
+    }
 
 public:
+    BasicJFETProcessor() { updateConstants(); }
+
     void prepare(const std::string& partNumber = "2N5457") {
         model = JFETModel::getModel(partNumber);
+        updateConstants();
     }
 
-    void process(double gateVoltage, double sourceVoltage, double drainVoltage) {
+    void process(SampleType gateVoltage, SampleType sourceVoltage, SampleType drainVoltage) {
         vgs = gateVoltage - sourceVoltage;
         vds = drainVoltage - sourceVoltage;
-        
-        // Calculate drain current (Shichman-Hodges model)
-        id = JFETProcessor::calculateDrainCurrent(vgs, vds, model);
-        
+
+        // Drain current (Shichman-Hodges model): Id = Kp*(Vgs - Vto)^2*(1 + lambda*Vds)
         // Transconductance: gm = dId/dVgs = 2*Kp*(Vgs - Vto)*(1 + lambda*Vds)
-        double vov = vgs - model.Vto;
+        SampleType vov = vgs - vto;
         if (vov > 0) {
-            gm = 2.0 * model.Kp * vov * (1.0 + model.lambda * vds);
+            SampleType modulation = kp * (SampleType(1) + lambda * vds);
+            id = modulation * vov * vov;
+            gm = SampleType(2) * modulation * vov;
         } else {
-            gm = 0.0;
+            id = 0;
+            gm = 0;
         }
     }
 
     static double calculateDrainCurrent(double vgs, double vds, const JFETModel& model) {
         double vov = vgs - model.Vto;
         if (vov <= 0) return 0.0;
-        
+
         double id = model.Kp * vov * vov * (1.0 + model.lambda * vds);
         return id;
     }
 
-    double getDrainCurrent() const { return id; }
-    double getTransconductance() const { return gm; }
-    double getVgs() const { return vgs; }
-    double getVds() const { return vds; }
+    SampleType getDrainCurrent() const { return id; }
+    SampleType getTransconductance() const { return gm; }
+    SampleType getVgs() const { return vgs; }
+    SampleType getVds() const { return vds; }
 };
 
 // ============================================================================
 // DSP OP-AMP PROCESSOR - BEHAVIORAL MODEL
 // ============================================================================
 
-class OpAmpProcessor {
+template <typename SampleType>
+class BasicOpAmpProcessor {
 private:
     OpAmpModel model;
-    double outputVoltage = 0.0;
-    double voltage1 = 0.0;
-    double voltage2 = 0.0;
-    
-    // State for frequency response
-    std::array<double, 4> filterState = {0.0};
+    SampleType outputVoltage = 0;
+    SampleType voltage1 = 0;
+    SampleType voltage2 = 0;
+    SampleType gain = 0, maxOutput = 0, minOutput = 0;   // From the model, set in prepare()
+
+    // Block model, set in prepare(): open-loop pole and slew limit per sample
+    SampleType poleCoefficient = 1;   // One-pole smoothing toward Aol * (V+ - V-)
+    SampleType maxStep = 0;           // Slew rate / sample rate (V)
 
 public:
+    BasicOpAmpProcessor() { prepareModel(); }
+
     void prepare(const std::string& partNumber = "UA741", double sampleRate = 48000.0) {
-        model = OpAmpModel::getModel(partNumber);
-        // Initialize low-pass filter for bandwidth limiting
-        initializeLowPass(sampleRate, model.gainBW);
+        prepare(OpAmpModel::getModel(partNumber), sampleRate);
+    }
+
+    void prepare(const OpAmpModel& opAmpModel, double sampleRate) {
+        model = opAmpModel;
+        prepareModel();
+        // The open-loop response has its pole at GBW / Aol
+        initializeLowPass(sampleRate, model.gainBW / model.gain);
+        maxStep = static_cast<SampleType>(model.slewRate * 1e6 / sampleRate);   // Slew rate is V/µs
+        reset();
     }
 
-    void process(double nonInvertingInput, double invertingInput) {
+    void reset() { outputVoltage = 0; }
+
+    // Static open-loop gain with rail clipping, one sample at a time
+    void process(SampleType nonInvertingInput, SampleType invertingInput) {
         voltage1 = nonInvertingInput;
         voltage2 = invertingInput;
-        
+
         // Differential input
-        double vin = voltage1 - voltage2;
-        
+        SampleType vin = voltage1 - voltage2;
+
         // Open-loop gain applied with saturation
-        double output = vin * model.gain;
-        
-        // Apply slew rate limiting
-        double maxChange = model.slewRate * 1e-6;  // Per microsecond
-        
+        SampleType output = vin * gain;
+
         // Clamp to supply rails
-        outputVoltage = std::max(model.minOutput, std::min(model.maxOutput, output));
+        outputVoltage = std::max(minOutput, std::min(maxOutput, output));
+    }
+
+    /**
+     * Open-loop response over a block: gain-bandwidth as a one-pole toward
+     * Aol * (V+ - V-), then slew limiting (a clamp on the per-sample delta)
+     * and the rails. The gain pass vectorizes; the recurrence is min/max only.
+     * `output` may alias either input.
+     */
+    void processBlock(const SampleType* nonInverting, const SampleType* inverting, SampleType* output, int numSamples) {
+        for (int i = 0; i < numSamples; ++i) {
+            output[i] = gain * (nonInverting[i] - inverting[i]);
+        }
+
+        SampleType y = outputVoltage;
+        for (int i = 0; i < numSamples; ++i) {
+            const SampleType delta = poleCoefficient * (output[i] - y);
+            y += std::max(-maxStep, std::min(maxStep, delta));
+            y = std::max(minOutput, std::min(maxOutput, y));
+            output[i] = y;
+        }
+        outputVoltage = y;
+        if (numSamples > 0) {
+            voltage1 = nonInverting[numSamples - 1];
+            voltage2 = inverting[numSamples - 1];
+        }
     }
 
     void initializeLowPass(double sampleRate, double cutoff) {
-        // 1st order low-pass filter for frequency response
+        // 1st order low-pass filter for frequency response (impulse invariant)
         double wc = 2.0 * 3.14159265359 * cutoff;
-        double dt = 1.0 / sampleRate;
-        double a = wc * dt / (1.0 + wc * dt);
-        filterState[0] = a;
+        poleCoefficient = static_cast<SampleType>(-std::expm1(-wc / sampleRate));
     }
 
-    double getOutputVoltage() const { return outputVoltage; }
+    SampleType getOutputVoltage() const { return outputVoltage; }
     double getGain() const { return model.gain; }
     double getGainBW() const { return model.gainBW; }
     double getSlewRate() const { return model.slewRate; }
+
+private:
+    void prepareModel() {
+        gain = static_cast<SampleType>(model.gain);
+        maxOutput = static_cast<SampleType>(model.maxOutput);
+        minOutput = static_cast<SampleType>(model.minOutput);
+    }
 };
 
 // ============================================================================
 // DSP TRIODE PROCESSOR - KOREN MODEL
 // ============================================================================
 
-class TriodeProcessor {
+template <typename SampleType>
+class BasicTriodeProcessor {
+public:
+    enum KorenMode {
+        KOREN_EXACT,    // std::pow per sample (in SampleType)
+        KOREN_TABLE     // Float table lookup (KorenPlateCurrentTable)
+    };
+
 private:
+    struct StdMath {
+        static float pow(float base, float exponent) { return std::pow(base, exponent); }
+    };
+
     TriodeModel model;
-    double gridVoltage = 0.0;
-    double plateVoltage = 0.0;
-    double plateCurrent = 0.0;
-    double gridCurrent = 0.0;
+    KorenPlateCurrentTable korenTable;
+    KorenMode korenMode = KOREN_EXACT;
+    SampleType gridVoltage = 0;
+    SampleType plateVoltage = 0;
+    SampleType plateCurrent = 0;
+    SampleType gridCurrent = 0;
 
 public:
+    BasicTriodeProcessor() { korenTable.prepare(model); }
+
     void prepare(const std::string& partNumber = "12AX7") {
         model = TriodeModel::getModel(partNumber);
+        korenTable.prepare(model);
     }
 
-    void process(double cathodeVoltage, double gridVoltageApplied, double plateVoltageApplied) {
+    // Per-instance choice of plate current evaluation
+    void setKorenMode(KorenMode mode) { korenMode = mode; }
+    KorenMode getKorenMode() const { return korenMode; }
+
+    void process(SampleType cathodeVoltage, SampleType gridVoltageApplied, SampleType plateVoltageApplied) {
         // Voltages relative to cathode
         gridVoltage = gridVoltageApplied - cathodeVoltage;
         plateVoltage = plateVoltageApplied - cathodeVoltage;
-        
+
         // Calculate plate current using Koren model
-        plateCurrent = TriodeModel::calculatePlateCurrentKoren(gridVoltage, plateVoltage, model);
-        
+        if (korenMode == KOREN_TABLE) {
+            plateCurrent = korenTable.calculatePlateCurrent(float(gridVoltage), float(plateVoltage));
+        } else if constexpr (std::is_same<SampleType, float>::value) {
+            plateCurrent = TriodeModel::calculatePlateCurrentKoren<StdMath>(gridVoltage, plateVoltage, model);
+        } else {
+            plateCurrent = static_cast<SampleType>(TriodeModel::calculatePlateCurrentKoren(gridVoltage, plateVoltage, model));
+        }
+
         // Grid current (simplified - non-linear below cathode potential)
         if (gridVoltage > 0) {
             // Grid is positive relative to cathode - space charge limited
-            gridCurrent = plateCurrent * 0.01;  // Approx 1% of plate current
+            gridCurrent = plateCurrent * SampleType(0.01);  // Approx 1% of plate current
         } else {
-            gridCurrent = 0.0;  // Negative grid - no grid current
+            gridCurrent = 0;  // Negative grid - no grid current
         }
     }
 
-    double getPlateCurrent() const { return plateCurrent; }
-    double getGridCurrent() const { return gridCurrent; }
-    double getGridVoltage() const { return gridVoltage; }
-    double getPlateVoltage() const { return plateVoltage; }
+    SampleType getPlateCurrent() const { return plateCurrent; }
+    SampleType getGridCurrent() const { return gridCurrent; }
+    SampleType getGridVoltage() const { return gridVoltage; }
+    SampleType getPlateVoltage() const { return plateVoltage; }
     double getAmplificationFactor() const { return model.mu; }
 };
 
@@ -361,7 +524,8 @@ public:
 // DSP SOFT CLIPPER - COMMON IN GUITAR PEDALS
 // ============================================================================
 
-class SoftClipperProcessor {
+template <typename SampleType>
+class BasicSoftClipperProcessor {
 public:
     enum ClipType {
         TANH,           // Hyperbolic tangent
@@ -373,65 +537,71 @@ public:
 
 private:
     ClipType clipType = TANH;
-    double gainBefore = 1.0;
-    double gainAfter = 1.0;
-    DiodeModel diodeModel;
+    SampleType gainBefore = 1;
+    SampleType gainAfter = 1;
+    BasicDiodeProcessor<SampleType> diode1, diode2;   // Diode bridge, prepared once
 
 public:
     void prepare(ClipType type, double preGain = 1.0, double postGain = 1.0) {
         clipType = type;
-        gainBefore = preGain;
-        gainAfter = postGain;
+        gainBefore = static_cast<SampleType>(preGain);
+        gainAfter = static_cast<SampleType>(postGain);
+        diode1.prepare(DiodeModel());
+        diode2.prepare(DiodeModel());
     }
 
-    double process(double input) {
-        double boosted = input * gainBefore;
-        double clipped = 0.0;
-        
+    SampleType process(SampleType input) {
+        SampleType boosted = input * gainBefore;
+        SampleType clipped = 0;
+
         switch (clipType) {
             case TANH:
                 clipped = std::tanh(boosted);
                 break;
-                
+
             case SINE_SHAPED:
-                if (boosted > 1.5) {
-                    clipped = 1.0;
-                } else if (boosted < -1.5) {
-                    clipped = -1.0;
+                if (boosted > SampleType(1.5)) {
+                    clipped = 1;
+                } else if (boosted < SampleType(-1.5)) {
+                    clipped = -1;
                 } else {
-                    clipped = std::sin(boosted * 3.14159265359 / 3.0);
+                    clipped = std::sin(boosted * SampleType(3.14159265359 / 3.0));
                 }
                 break;
-                
+
             case DIODE_BRIDGE: {
                 // Diode bridge clipping (two diodes in series)
-                DiodeProcessor d1, d2;
-                d1.prepare(diodeModel);
-                d1.process(boosted);
-                double v1 = d1.getVoltage();
-                
-                d2.prepare(diodeModel);
-                d2.process(-boosted);
-                double v2 = d2.getVoltage();
-                
-                clipped = v1 - v2;
+                diode1.process(boosted);
+                diode2.process(-boosted);
+                clipped = diode1.getVoltage() - diode2.getVoltage();
                 break;
             }
-                
+
             case TUBE_SATURATE: {
                 // Tube soft saturation characteristic
-                double absInput = std::abs(boosted);
-                clipped = std::tanh(absInput) * (boosted / (absInput + 1e-10));
+                SampleType absInput = std::abs(boosted);
+                clipped = std::tanh(absInput) * (boosted / (absInput + SampleType(1e-10)));
                 break;
             }
-                
+
             case HARD_CLIP:
-                clipped = std::max(-1.0, std::min(1.0, boosted));
+                clipped = std::max(SampleType(-1), std::min(SampleType(1), boosted));
                 break;
         }
-        
+
         return clipped * gainAfter;
     }
 };
 
+// Double-precision processors (component mapper, legacy generated code)
+using ResistorProcessor = BasicResistorProcessor<double>;
+using CapacitorProcessor = BasicCapacitorProcessor<double>;
+using InductorProcessor = BasicInductorProcessor<double>;
+using DiodeProcessor = BasicDiodeProcessor<double>;
+using BJTProcessor = BasicBJTProcessor<double>;
+using JFETProcessor = BasicJFETProcessor<double>;
+using OpAmpProcessor = BasicOpAmpProcessor<double>;
+using TriodeProcessor = BasicTriodeProcessor<double>;
+using SoftClipperProcessor = BasicSoftClipperProcessor<double>;
+
 } // namespace LiveSpiceDSP